@@ -0,0 +1,378 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Benchmarks for performance critical operations, run as a pipeline
+// of stages on a unit cube mesh of tetrahedra:
+//
+//   mesh      mesh creation and facet creation
+//   dofmap    dofmap creation
+//   scatter   forward/reverse scatter of a vector
+//   assembly  matrix and vector assembly of a Poisson problem
+//   solve     CG solve (Jacobi preconditioned) of the Poisson problem
+//   io        XDMF output of the mesh and the solution
+//
+// Usage:
+//
+//   mpirun -np P dolfinx-bench [--scaling strong|weak] [--n N]
+//                              [--cells-per-rank C] [--degree K]
+//                              [--repeats R] [--pipeline STAGES]
+//                              [--json FILE]
+//
+// For strong scaling (default), N is the number of cells in each
+// direction of the mesh. For weak scaling, N is chosen such that the
+// mesh has approximately C cells per process. K (1, 2 or 3) is the
+// Lagrange element degree, R is the number of times each operation is
+// repeated and STAGES is a comma-separated list of the stages to run
+// (default all). Timings are registered with the DOLFINx timer and
+// reported using list_timings. If a file name is given, a scaling
+// report with the parameters, the problem size and the [MPI_MAX]
+// timing table is written to the file in JSON format. The reports of
+// a series of runs can be combined using run_scaling.py.
+
+#include "poisson.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <dolfinx.h>
+#include <dolfinx/common/Table.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/timing.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/la/preconditioners.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace dolfinx;
+using T = double;
+
+namespace
+{
+/// Pipeline stages, in the order in which they are run
+const std::array<std::string, 6> all_stages
+    = {"mesh", "dofmap", "scatter", "assembly", "solve", "io"};
+
+/// Benchmark parameters
+struct Parameters
+{
+  std::string scaling = "strong";
+  int n = 16;
+  int cells_per_rank = 100000;
+  int degree = 1;
+  int repeats = 5;
+  std::set<std::string> stages{all_stages.begin(), all_stages.end()};
+  std::string json;
+};
+
+/// Parse command line arguments
+Parameters parse_args(int argc, char* argv[])
+{
+  Parameters p;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    if (i + 1 == argc)
+      throw std::runtime_error("Missing value for argument " + arg);
+    std::string value = argv[++i];
+    if (arg == "--scaling")
+      p.scaling = value;
+    else if (arg == "--n")
+      p.n = std::stoi(value);
+    else if (arg == "--cells-per-rank")
+      p.cells_per_rank = std::stoi(value);
+    else if (arg == "--degree")
+      p.degree = std::stoi(value);
+    else if (arg == "--repeats")
+      p.repeats = std::stoi(value);
+    else if (arg == "--pipeline")
+    {
+      p.stages.clear();
+      std::stringstream ss(value);
+      for (std::string stage; std::getline(ss, stage, ',');)
+      {
+        if (std::ranges::find(all_stages, stage) == all_stages.end())
+          throw std::runtime_error("Unknown pipeline stage " + stage);
+        p.stages.insert(stage);
+      }
+    }
+    else if (arg == "--json")
+      p.json = value;
+    else
+      throw std::runtime_error("Unknown argument " + arg);
+  }
+
+  if (p.scaling != "strong" and p.scaling != "weak")
+    throw std::runtime_error("Scaling must be strong or weak.");
+  if (p.degree < 1 or p.degree > 3)
+    throw std::runtime_error("Element degree must be 1, 2 or 3.");
+
+  return p;
+}
+
+/// Number of cells in each direction of the mesh. For weak scaling,
+/// the mesh has 6 n^3 cells, which is approximately the number of
+/// cells per rank times the number of ranks.
+int num_cells_per_direction(const Parameters& p, int num_processes)
+{
+  if (p.scaling == "strong")
+    return p.n;
+
+  double cells = static_cast<double>(p.cells_per_rank) * num_processes;
+  return std::max(1, static_cast<int>(std::round(std::cbrt(cells / 6))));
+}
+
+/// Create a unit cube mesh of tetrahedra
+std::shared_ptr<mesh::Mesh<T>> create_mesh(MPI_Comm comm, int n)
+{
+  return std::make_shared<mesh::Mesh<T>>(mesh::create_box<T>(
+      comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {n, n, n},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+}
+
+/// Run the benchmark pipeline and return the problem size
+Table run(MPI_Comm comm, const Parameters& p, int n)
+{
+  auto has_stage = [&p](const std::string& stage)
+  { return p.stages.contains(stage); };
+
+  // Mesh creation
+  std::shared_ptr<mesh::Mesh<T>> mesh = create_mesh(comm, n);
+  if (has_stage("mesh"))
+  {
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: create_mesh");
+      mesh = create_mesh(comm, n);
+    }
+
+    // Facet creation (on a fresh mesh each time)
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      auto m = create_mesh(comm, n);
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: Topology::create_entities (facets)");
+      m->topology_mutable()->create_entities(2);
+    }
+  }
+
+  // Function space
+  auto element = std::make_shared<fem::FiniteElement<T>>(
+      basix::create_element<T>(basix::element::family::P,
+                               basix::cell::type::tetrahedron, p.degree,
+                               basix::element::lagrange_variant::unset,
+                               basix::element::dpc_variant::unset, false));
+  auto V = std::make_shared<fem::FunctionSpace<T>>(
+      fem::create_functionspace<T>(mesh, element));
+
+  // Dofmap creation (without the dofmap cache used by
+  // fem::create_functionspace)
+  if (has_stage("dofmap"))
+  {
+    fem::ElementDofLayout layout = fem::create_element_dof_layout(*element);
+    std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv
+        = element->needs_dof_permutations()
+              ? element->dof_permutation_fn(true, true)
+              : nullptr;
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: create_dofmap");
+      fem::create_dofmap(comm, layout, *mesh->topology_mutable(), permute_inv,
+                         nullptr);
+    }
+  }
+
+  // Forward and reverse scatter
+  if (has_stage("scatter"))
+  {
+    la::Vector<T> x(V->dofmap()->index_map, 1);
+    x.set(1.0);
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      MPI_Barrier(comm);
+      {
+        common::Timer timer("Bench: Scatterer::scatter_fwd");
+        x.scatter_fwd();
+      }
+      {
+        common::Timer timer("Bench: Scatterer::scatter_rev");
+        x.scatter_rev(std::plus<T>());
+      }
+    }
+  }
+
+  // Forms
+  std::array forms_a{form_poisson_a1, form_poisson_a2, form_poisson_a3};
+  std::array forms_L{form_poisson_L1, form_poisson_L2, form_poisson_L3};
+  auto kappa = std::make_shared<fem::Constant<T>>(2.0);
+  auto f = std::make_shared<fem::Function<T>>(V);
+  f->x()->set(1.0);
+  fem::Form<T> a = fem::create_form<T>(*forms_a[p.degree - 1], {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {});
+  fem::Form<T> L = fem::create_form<T>(
+      *forms_L[p.degree - 1], {V}, {{"f" + std::to_string(p.degree), f}},
+      {}, {}, {});
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<T> A(sp);
+  la::Vector<T> b(V->dofmap()->index_map, 1);
+  if (has_stage("assembly"))
+  {
+    // Matrix assembly
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      A.set(0.0);
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: assemble_matrix");
+      fem::assemble_matrix(A.mat_add_values(), a, {});
+      A.scatter_rev();
+    }
+
+    // Vector assembly
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      b.set(0.0);
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: assemble_vector");
+      fem::assemble_vector(b.mutable_array(), L);
+      b.scatter_rev(std::plus<T>());
+    }
+  }
+
+  // Solve with u = 0 on the boundary
+  auto u = std::make_shared<fem::Function<T>>(V);
+  int iterations = 0;
+  if (has_stage("solve"))
+  {
+    mesh->topology_mutable()->create_connectivity(2, 3);
+    std::vector facets = mesh::exterior_facet_indices(*mesh->topology());
+    std::vector bdofs = fem::locate_dofs_topological(
+        *mesh->topology_mutable(), *V->dofmap(), 2, facets);
+    fem::DirichletBC<T> bc(0.0, bdofs, V);
+
+    A.set(0.0);
+    fem::assemble_matrix(A.mat_add_values(), a, {bc});
+    A.scatter_rev();
+    fem::set_diagonal<T>(A.mat_set_values(), *V, {bc});
+
+    b.set(0.0);
+    fem::assemble_vector(b.mutable_array(), L);
+    fem::apply_lifting<T, T>(b.mutable_array(), {a}, {{bc}}, {}, T(1));
+    b.scatter_rev(std::plus<T>());
+    bc.set(b.mutable_array(), std::nullopt);
+
+    la::JacobiPreconditioner P(A);
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      u->x()->set(0.0);
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: solve (CG, Jacobi)");
+      auto info = la::cg(A, b, *u->x(), P, 1e-8, 0, 10000);
+      iterations = info.iterations;
+    }
+  }
+
+  // Output to bench_u.xdmf (XDMF requires a function of the same degree as the mesh)
+  if (has_stage("io"))
+  {
+    auto V1 = std::make_shared<fem::FunctionSpace<T>>(
+        fem::create_functionspace<T>(
+            mesh, std::make_shared<fem::FiniteElement<T>>(
+                      basix::create_element<T>(
+                          basix::element::family::P,
+                          basix::cell::type::tetrahedron, 1,
+                          basix::element::lagrange_variant::unset,
+                          basix::element::dpc_variant::unset, false))));
+    auto u1 = std::make_shared<fem::Function<T>>(V1);
+    u1->interpolate(*u);
+    for (int r = 0; r < p.repeats; ++r)
+    {
+      MPI_Barrier(comm);
+      common::Timer timer("Bench: XDMFFile::write");
+      io::XDMFFile file(comm, "bench_u.xdmf", "w");
+      file.write_mesh(*mesh);
+      file.write_function(*u1, 0.0);
+      file.close();
+    }
+  }
+
+  // Problem size
+  auto cell_map = mesh->topology()->index_map(3);
+  auto dof_map = V->dofmap()->index_map;
+  Table size("Size");
+  size.set("bench", "num_cells",
+           static_cast<double>(cell_map->size_global()));
+  size.set("bench", "num_dofs", static_cast<double>(dof_map->size_global()));
+  size.set("bench", "num_dofs_per_process",
+           static_cast<double>(dof_map->size_global())
+               / dolfinx::MPI::size(comm));
+  if (has_stage("solve"))
+    size.set("bench", "cg_iterations", iterations);
+
+  return size;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  init_logging(argc, argv);
+  MPI_Init(&argc, &argv);
+  {
+    MPI_Comm comm = MPI_COMM_WORLD;
+    const int num_processes = dolfinx::MPI::size(comm);
+    Parameters p = parse_args(argc, argv);
+    const int n = num_cells_per_direction(p, num_processes);
+    Table size = run(comm, p, n);
+
+    list_timings(comm);
+
+    // Write the scaling report to file
+    Table timings = timing_table().reduce(comm, Table::Reduction::max);
+    if (!p.json.empty() and dolfinx::MPI::rank(comm) == 0)
+    {
+      std::string pipeline;
+      for (auto& stage : all_stages)
+      {
+        if (p.stages.contains(stage))
+          pipeline += (pipeline.empty() ? "" : ",") + stage;
+      }
+
+      Table params("Parameters");
+      params.set("bench", "scaling", p.scaling);
+      params.set("bench", "num_processes", num_processes);
+      params.set("bench", "n", n);
+      if (p.scaling == "weak")
+        params.set("bench", "cells_per_rank", p.cells_per_rank);
+      params.set("bench", "degree", p.degree);
+      params.set("bench", "repeats", p.repeats);
+      params.set("bench", "pipeline", pipeline);
+
+      std::ofstream file(p.json);
+      file << "{\"parameters\": " << params.json()
+           << ", \"size\": " << size.json()
+           << ", \"timings\": " << timings.json() << "}" << std::endl;
+    }
+  }
+  MPI_Finalize();
+
+  return 0;
+}
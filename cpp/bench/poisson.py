@@ -0,0 +1,34 @@
+# Poisson forms on tetrahedra for element degrees 1, 2 and 3. The
+# forms for degree k are named a{k} and L{k}.
+
+from basix.ufl import element
+from ufl import (
+    Coefficient,
+    Constant,
+    FunctionSpace,
+    Mesh,
+    TestFunction,
+    TrialFunction,
+    dx,
+    grad,
+    inner,
+)
+
+coord_element = element("Lagrange", "tetrahedron", 1, shape=(3,))
+mesh = Mesh(coord_element)
+kappa = Constant(mesh)
+
+V1 = FunctionSpace(mesh, element("Lagrange", "tetrahedron", 1))
+u1, v1, f1 = TrialFunction(V1), TestFunction(V1), Coefficient(V1)
+a1 = kappa * inner(grad(u1), grad(v1)) * dx
+L1 = inner(f1, v1) * dx
+
+V2 = FunctionSpace(mesh, element("Lagrange", "tetrahedron", 2))
+u2, v2, f2 = TrialFunction(V2), TestFunction(V2), Coefficient(V2)
+a2 = kappa * inner(grad(u2), grad(v2)) * dx
+L2 = inner(f2, v2) * dx
+
+V3 = FunctionSpace(mesh, element("Lagrange", "tetrahedron", 3))
+u3, v3, f3 = TrialFunction(V3), TestFunction(V3), Coefficient(V3)
+a3 = kappa * inner(grad(u3), grad(v3)) * dx
+L3 = inner(f3, v3) * dx
@@ -0,0 +1,98 @@
+# Copyright (C) 2024 Garth N. Wells
+#
+# This file is part of DOLFINx (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Run dolfinx-bench for a series of process counts and combine the reports.
+
+Example (weak scaling with 200k cells per process):
+
+    python3 run_scaling.py --scaling weak --cells-per-rank 200000 \\
+        --np 1 2 4 8 --output weak.json
+
+Arguments that are not recognised are passed to dolfinx-bench, e.g.
+``--degree 2 --pipeline mesh,assembly``. The combined report has the
+reports of the runs and, for each timer, the parallel efficiency
+relative to the run with the fewest processes: ``t_1 p_1 / (t_p p)``
+for strong scaling and ``t_1 / t_p`` for weak scaling, where ``t`` is
+the [MPI_MAX] average time.
+"""
+
+import argparse
+import json
+import shlex
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+
+def run(args, extra, num_processes: int) -> dict:
+    """Run the benchmark on a number of processes and return its report."""
+    with tempfile.TemporaryDirectory() as tmp:
+        report = Path(tmp) / "report.json"
+        cmd = [
+            *shlex.split(args.mpirun),
+            "-np",
+            str(num_processes),
+            args.bench,
+            "--scaling",
+            args.scaling,
+            *(["--n", str(args.n)] if args.scaling == "strong" else []),
+            *(["--cells-per-rank", str(args.cells_per_rank)] if args.scaling == "weak" else []),
+            *extra,
+            "--json",
+            str(report),
+        ]
+        print(" ".join(cmd), flush=True)
+        subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+        return json.loads(report.read_text())
+
+
+def efficiency(reports: list[dict], scaling: str) -> dict[str, list[float]]:
+    """Parallel efficiency of each timer relative to the first report."""
+    base = reports[0]
+    p0 = base["parameters"]["bench"]["num_processes"]
+    eff = {}
+    for task, t0 in base["timings"].items():
+        values = []
+        for r in reports:
+            p = r["parameters"]["bench"]["num_processes"]
+            t = r["timings"].get(task, {}).get("avg", 0.0)
+            if t > 0:
+                values.append(t0["avg"] / t if scaling == "weak" else t0["avg"] * p0 / (t * p))
+            else:
+                values.append(float("nan"))
+        eff[task] = values
+    return eff
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--bench", default="./dolfinx-bench", help="benchmark executable")
+    parser.add_argument("--mpirun", default="mpirun", help="MPI launcher command")
+    parser.add_argument("--np", type=int, nargs="+", required=True, help="process counts")
+    parser.add_argument("--scaling", choices=["strong", "weak"], default="strong")
+    parser.add_argument("--n", type=int, default=32, help="cells per direction (strong)")
+    parser.add_argument(
+        "--cells-per-rank", type=int, default=100000, help="cells per process (weak)"
+    )
+    parser.add_argument("--output", default="scaling.json", help="combined report")
+    args, extra = parser.parse_known_args()
+
+    reports = [run(args, extra, p) for p in sorted(args.np)]
+    eff = efficiency(reports, args.scaling)
+
+    print(f"\n{args.scaling} scaling efficiency")
+    print(f"{'task':<50}" + "".join(f"{p:>10}" for p in sorted(args.np)))
+    for task, values in eff.items():
+        print(f"{task:<50}" + "".join(f"{v:>10.3f}" for v in values))
+
+    Path(args.output).write_text(
+        json.dumps({"scaling": args.scaling, "runs": reports, "efficiency": eff}, indent=2)
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -175,6 +175,63 @@ double assemble_vector1(const mesh::Geometry<T>& g, const fem::DofMap& dofmap,
   return la::squared_norm(b);
 }
 
+/// @brief Assemble a matrix operator using a batched lambda kernel
+/// function.
+///
+/// The kernel computes the element matrices for `N` cells per call,
+/// with data for the batch stored such that the kernel can vectorize
+/// across cells, which can improve performance for lightweight
+/// kernels.
+///
+/// @tparam T Scalar type.
+/// @tparam N Number of cells in a batch.
+/// @param g mesh geometry.
+/// @param dofmap dofmap.
+/// @param kernel Batched element kernel to execute.
+/// @param cells Cells to execute the kernel over.
+/// @return Frobenius norm squared of the matrix.
+template <std::floating_point T, int N>
+double assemble_matrix2(const mesh::Geometry<T>& g, const fem::DofMap& dofmap,
+                        auto kernel, std::span<const std::int32_t> cells)
+{
+  auto sp = la::SparsityPattern(dofmap.index_map->comm(),
+                                {dofmap.index_map, dofmap.index_map},
+                                {dofmap.index_map_bs(), dofmap.index_map_bs()});
+  fem::sparsitybuild::cells(sp, {cells, cells}, {dofmap, dofmap});
+  sp.finalize();
+  la::MatrixCSR<T> A(sp);
+  auto ident = [](auto, auto, auto, auto) {}; // DOF permutation not required
+  common::Timer timer("Assembler2 batched lambda (matrix)");
+  fem::impl::assemble_cells_batched<T, N>(
+      A.mat_add_values(), g.dofmap(), g.x(), cells, {dofmap.map(), 1, cells},
+      ident, {dofmap.map(), 1, cells}, ident, {}, {}, kernel,
+      std::span<const T>(), 0, {}, {}, {});
+  A.scatter_rev();
+  return A.squared_norm();
+}
+
+/// @brief Assemble a RHS vector using a batched lambda kernel function.
+///
+/// @tparam T Scalar type.
+/// @tparam N Number of cells in a batch.
+/// @param g mesh geometry.
+/// @param dofmap dofmap.
+/// @param kernel Batched element kernel to execute.
+/// @param cells Cells to execute the kernel over.
+/// @return l2 norm squared of the vector.
+template <std::floating_point T, int N>
+double assemble_vector2(const mesh::Geometry<T>& g, const fem::DofMap& dofmap,
+                        auto kernel, const std::vector<std::int32_t>& cells)
+{
+  la::Vector<T> b(dofmap.index_map, 1);
+  common::Timer timer("Assembler2 batched lambda (vector)");
+  fem::impl::assemble_cells_batched<T, N, 1>(
+      [](auto, auto, auto, auto) {}, b.mutable_array(), g.dofmap(), g.x(),
+      cells, {dofmap.map(), 1, cells}, kernel, {}, {}, 0, {});
+  b.scatter_rev(std::plus<T>());
+  return la::squared_norm(b);
+}
+
 /// @brief Assemble P1 mass matrix and a RHS vector using element kernel
 /// approaches.
 ///
@@ -269,6 +326,46 @@ void assemble(MPI_Comm comm)
   assemble_matrix1<T>(mesh->geometry(), *V->dofmap(), kernel_a, cells);
   assemble_vector1<T>(mesh->geometry(), *V->dofmap(), kernel_L, cells);
 
+  // Batched kernels compute the element tensors of N cells per call.
+  // Geometry for the batch is stored with the cell index running
+  // fastest, x[(3 * i + d) * N + c] for component d of node i of cell
+  // c, and the element tensor entry k of cell c is A[k * N + c].
+  constexpr int N = 8;
+  auto detJ_batch = [](const T* x, int c)
+  {
+    auto xb = [x, c](int i, int d) { return x[(3 * i + d) * N + c]; };
+    return std::abs((xb(0, 0) - xb(1, 0)) * (xb(2, 1) - xb(1, 1))
+                    - (xb(0, 1) - xb(1, 1)) * (xb(2, 0) - xb(1, 0)));
+  };
+
+  auto kernel_a_batched = [A_hat_b, detJ_batch](T* A, const T*, const T*,
+                                                const T* x)
+  {
+    std::array<T, N> scale;
+    for (int c = 0; c < N; ++c)
+      scale[c] = detJ_batch(x, c);
+    for (std::size_t k = 0; k < A_hat_b.size(); ++k)
+      for (int c = 0; c < N; ++c)
+        A[k * N + c] = scale[c] * A_hat_b[k];
+  };
+
+  auto kernel_L_batched
+      = [b_hat = b_ref<T>(phi, weights), detJ_batch](T* b, const T*, const T*,
+                                                       const T* x)
+  {
+    std::array<T, N> scale;
+    for (int c = 0; c < N; ++c)
+      scale[c] = detJ_batch(x, c);
+    for (std::size_t i = 0; i < b_hat.size(); ++i)
+      for (int c = 0; c < N; ++c)
+        b[i * N + c] = scale[c] * b_hat[i];
+  };
+
+  assemble_matrix2<T, N>(mesh->geometry(), *V->dofmap(), kernel_a_batched,
+                         cells);
+  assemble_vector2<T, N>(mesh->geometry(), *V->dofmap(), kernel_L_batched,
+                         cells);
+
   list_timings(comm);
 }
 
@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+/// Alignment of the blocks of an arena
+constexpr std::size_t block_alignment = alignof(std::max_align_t);
+
+/// Scratch resource of a thread (nullptr for the default resource)
+thread_local std::pmr::memory_resource* thread_scratch = nullptr;
+} // namespace
+
+//-----------------------------------------------------------------------------
+Arena::Arena(std::size_t size, std::pmr::memory_resource* upstream)
+    : _upstream(upstream)
+{
+  if (size > 0)
+    add_block(size);
+}
+//-----------------------------------------------------------------------------
+Arena::~Arena()
+{
+  for (auto [data, size] : _blocks)
+    _upstream->deallocate(data, size, block_alignment);
+}
+//-----------------------------------------------------------------------------
+void Arena::reset()
+{
+  if (_blocks.size() > 1)
+  {
+    std::size_t size = capacity();
+    for (auto [data, bsize] : _blocks)
+      _upstream->deallocate(data, bsize, block_alignment);
+    _blocks.clear();
+    add_block(size);
+  }
+  _offset = 0;
+}
+//-----------------------------------------------------------------------------
+std::size_t Arena::capacity() const
+{
+  std::size_t size = 0;
+  for (auto& b : _blocks)
+    size += b.size;
+  return size;
+}
+//-----------------------------------------------------------------------------
+std::size_t Arena::num_upstream_allocations() const
+{
+  return _num_upstream_allocations;
+}
+//-----------------------------------------------------------------------------
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  auto aligned_offset = [alignment](const Block& b, std::size_t offset)
+  {
+    auto p = reinterpret_cast<std::uintptr_t>(b.data) + offset;
+    return offset + (alignment - p % alignment) % alignment;
+  };
+
+  if (!_blocks.empty())
+  {
+    std::size_t offset = aligned_offset(_blocks.back(), _offset);
+    if (offset + bytes <= _blocks.back().size)
+    {
+      _offset = offset + bytes;
+      return _blocks.back().data + offset;
+    }
+  }
+
+  // Start a new block that is at least twice the size of the last
+  std::size_t size = _blocks.empty() ? 0 : 2 * _blocks.back().size;
+  add_block(std::max<std::size_t>({size, bytes + alignment, 4096}));
+  std::size_t offset = aligned_offset(_blocks.back(), 0);
+  _offset = offset + bytes;
+  return _blocks.back().data + offset;
+}
+//-----------------------------------------------------------------------------
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
+//-----------------------------------------------------------------------------
+void Arena::add_block(std::size_t size)
+{
+  _blocks.push_back(
+      {static_cast<std::byte*>(_upstream->allocate(size, block_alignment)),
+       size});
+  ++_num_upstream_allocations;
+}
+//-----------------------------------------------------------------------------
+std::pmr::memory_resource* common::scratch_resource()
+{
+  return thread_scratch ? thread_scratch : std::pmr::get_default_resource();
+}
+//-----------------------------------------------------------------------------
+ScratchScope::ScratchScope(std::pmr::memory_resource& resource)
+    : _previous(thread_scratch)
+{
+  thread_scratch = &resource;
+}
+//-----------------------------------------------------------------------------
+ScratchScope::~ScratchScope() { thread_scratch = _previous; }
+//-----------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace dolfinx::common
+{
+/// @brief Memory resource for temporary buffers that reuses its
+/// memory.
+///
+/// Memory is allocated from large blocks by advancing an offset, and
+/// deallocation does nothing. Arena::reset makes all memory available
+/// again. If the allocations since the last reset did not fit into the
+/// first block, the blocks are replaced by one block of their total
+/// size, so that after a warm-up cycle repeated cycles of allocations
+/// (e.g. of an assembly call) allocate no memory from
+/// the upstream resource.
+///
+/// An arena is not thread-safe. It is typically installed as the
+/// scratch resource of a thread with ScratchScope.
+class Arena : public std::pmr::memory_resource
+{
+public:
+  /// @brief Create an arena.
+  /// @param[in] size Initial size in bytes of the first block.
+  /// @param[in] upstream Resource that the blocks are allocated from.
+  explicit Arena(std::size_t size = 0,
+                 std::pmr::memory_resource* upstream
+                 = std::pmr::get_default_resource());
+
+  // Copy constructor (deleted)
+  Arena(const Arena&) = delete;
+
+  // Assignment operator (deleted)
+  Arena& operator=(const Arena&) = delete;
+
+  /// Destructor. Frees the blocks.
+  ~Arena();
+
+  /// @brief Make all memory of the arena available for allocation.
+  /// @pre No memory that was allocated from the arena is in use.
+  void reset();
+
+  /// @brief Total size in bytes of the blocks of the arena.
+  std::size_t capacity() const;
+
+  /// @brief Number of blocks allocated from the upstream resource since
+  /// the arena was created.
+  std::size_t num_upstream_allocations() const;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override;
+
+  // Allocate a block from the upstream resource
+  void add_block(std::size_t size);
+
+  struct Block
+  {
+    std::byte* data;
+    std::size_t size;
+  };
+
+  std::pmr::memory_resource* _upstream;
+
+  // Blocks, and the offset of the next free byte in the last block
+  std::vector<Block> _blocks;
+  std::size_t _offset = 0;
+
+  std::size_t _num_upstream_allocations = 0;
+};
+
+/// @brief The scratch memory resource of the calling thread.
+///
+/// Temporary buffers of the assemblers (element tensors, coordinate
+/// dofs and batch buffers) are allocated from this resource. It is
+/// std::pmr::get_default_resource(), unless a resource has been
+/// installed with ScratchScope.
+///
+/// @note The resource is set for each thread. Tasks that are executed
+/// on the thread pool (see common::thread_pool) use the resource of
+/// the worker thread.
+std::pmr::memory_resource* scratch_resource();
+
+/// @brief Install a scratch memory resource on the calling thread for
+/// the lifetime of the object.
+///
+/// Example of repeated assembly without memory allocation for
+/// temporaries after the first call:
+/// @code
+/// common::Arena arena;
+/// for (int step = 0; step < num_steps; ++step)
+/// {
+///   common::ScratchScope scope(arena);
+///   fem::assemble_matrix(A.mat_add_values(), a, bcs);
+///   arena.reset();
+/// }
+/// @endcode
+class ScratchScope
+{
+public:
+  /// @brief Install a resource.
+  /// @param[in] resource Resource. Must outlive the scope.
+  explicit ScratchScope(std::pmr::memory_resource& resource);
+
+  // Copy constructor (deleted)
+  ScratchScope(const ScratchScope&) = delete;
+
+  // Assignment operator (deleted)
+  ScratchScope& operator=(const ScratchScope&) = delete;
+
+  /// Destructor. Restores the previous resource.
+  ~ScratchScope();
+
+private:
+  std::pmr::memory_resource* _previous;
+};
+
+} // namespace dolfinx::common
@@ -6,6 +6,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "IndexMap.h"
+#include "memory.h"
 #include "sort.h"
 #include <algorithm>
 #include <cstdint>
@@ -850,6 +851,83 @@ common::create_sub_index_map(const IndexMap& imap,
                    submap_ghost_gidxs, submap_ghost_owners),
           std::move(sub_imap_to_imap)};
 }
+//-----------------------------------------------------------------------------
+std::vector<IndexMap> common::create_index_maps(
+    MPI_Comm comm, std::span<const std::int32_t> local_sizes,
+    std::span<const std::span<const std::int64_t>> ghosts,
+    std::span<const std::span<const int>> owners, int tag)
+{
+  assert(ghosts.size() == local_sizes.size());
+  assert(owners.size() == local_sizes.size());
+  const std::size_t num_maps = local_sizes.size();
+
+  // Source ranks of each map, and the union of the source ranks
+  std::vector<std::array<std::vector<int>, 2>> src_dest(num_maps);
+  std::vector<int> src;
+  for (std::size_t k = 0; k < num_maps; ++k)
+  {
+    std::vector<int>& src_k = src_dest[k][0];
+    src_k.assign(owners[k].begin(), owners[k].end());
+    std::ranges::sort(src_k);
+    auto [unique_end, range_end] = std::ranges::unique(src_k);
+    src_k.erase(unique_end, range_end);
+    src.insert(src.end(), src_k.begin(), src_k.end());
+  }
+  std::ranges::sort(src);
+  auto [unique_end, range_end] = std::ranges::unique(src);
+  src.erase(unique_end, range_end);
+
+  if (dolfinx::MPI::size(comm) > 1)
+  {
+    // Destination ranks of the union of the maps
+    std::vector<int> dest
+        = dolfinx::MPI::compute_graph_edges_nbx(comm, src, tag);
+    std::ranges::sort(dest);
+
+    // Send to each source rank a flag for each map, indicating if the
+    // caller ghosts indices of the map that are owned by the source
+    // rank
+    std::vector<std::uint8_t> send_flags(src.size() * num_maps, 0);
+    for (std::size_t k = 0; k < num_maps; ++k)
+    {
+      for (int r : src_dest[k][0])
+      {
+        auto it = std::ranges::lower_bound(src, r);
+        send_flags[std::distance(src.begin(), it) * num_maps + k] = 1;
+      }
+    }
+
+    MPI_Comm comm0;
+    int ierr = MPI_Dist_graph_create_adjacent(
+        comm, dest.size(), dest.data(), MPI_UNWEIGHTED, src.size(),
+        src.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm0);
+    dolfinx::MPI::check_error(comm, ierr);
+    std::vector<std::uint8_t> recv_flags(dest.size() * num_maps);
+    ierr = MPI_Neighbor_alltoall(send_flags.data(), num_maps, MPI_UINT8_T,
+                                 recv_flags.data(), num_maps, MPI_UINT8_T,
+                                 comm0);
+    dolfinx::MPI::check_error(comm, ierr);
+    ierr = MPI_Comm_free(&comm0);
+    dolfinx::MPI::check_error(comm, ierr);
+
+    // Destination ranks of each map (sorted since dest is sorted)
+    for (std::size_t i = 0; i < dest.size(); ++i)
+    {
+      for (std::size_t k = 0; k < num_maps; ++k)
+      {
+        if (recv_flags[i * num_maps + k])
+          src_dest[k][1].push_back(dest[i]);
+      }
+    }
+  }
+
+  std::vector<IndexMap> maps;
+  maps.reserve(num_maps);
+  for (std::size_t k = 0; k < num_maps; ++k)
+    maps.emplace_back(comm, local_sizes[k], src_dest[k], ghosts[k], owners[k]);
+
+  return maps;
+}
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -923,6 +1001,23 @@ IndexMap::IndexMap(MPI_Comm comm, std::int32_t local_size,
   dolfinx::MPI::check_error(_comm.comm(), ierr);
 }
 //-----------------------------------------------------------------------------
+IndexMap::IndexMap(MPI_Comm comm, std::array<std::int64_t, 2> local_range,
+                   std::int64_t size_global,
+                   const std::array<std::vector<int>, 2>& src_dest,
+                   std::span<const std::int64_t> ghosts,
+                   std::span<const int> owners)
+    : _local_range(local_range), _size_global(size_global), _comm(comm, true),
+      _ghosts(ghosts.begin(), ghosts.end()),
+      _owners(owners.begin(), owners.end()), _src(src_dest[0]),
+      _dest(src_dest[1])
+{
+  assert(ghosts.size() == owners.size());
+  assert(local_range[0] <= local_range[1]);
+  assert(local_range[1] <= size_global);
+  assert(std::ranges::is_sorted(src_dest[0]));
+  assert(std::ranges::is_sorted(src_dest[1]));
+}
+//-----------------------------------------------------------------------------
 std::array<std::int64_t, 2> IndexMap::local_range() const noexcept
 {
   return _local_range;
@@ -964,30 +1059,44 @@ void IndexMap::local_to_global(std::span<const std::int32_t> local,
 void IndexMap::global_to_local(std::span<const std::int64_t> global,
                                std::span<std::int32_t> local) const
 {
-  const std::int32_t local_size = _local_range[1] - _local_range[0];
-  std::vector<std::pair<std::int64_t, std::int32_t>> global_to_local(
-      _ghosts.size());
-  for (std::size_t i = 0; i < _ghosts.size(); ++i)
-    global_to_local[i] = {_ghosts[i], i + local_size};
+  // Convert owned indices, and collect the ghost queries
+  std::vector<std::pair<std::int64_t, std::int32_t>> queries;
+  for (std::size_t i = 0; i < global.size(); ++i)
+  {
+    const std::int64_t index = global[i];
+    if (index >= _local_range[0] and index < _local_range[1])
+      local[i] = index - _local_range[0];
+    else
+      queries.emplace_back(index, i);
+  }
 
-  std::ranges::sort(global_to_local);
-  std::ranges::transform(
-      global, local.begin(),
-      [range = _local_range,
-       &global_to_local](std::int64_t index) -> std::int32_t
-      {
-        if (index >= range[0] and index < range[1])
-          return index - range[0];
-        else
-        {
-          auto it = std::ranges::lower_bound(global_to_local, index,
-                                             std::ranges::less(),
-                                             [](auto e) { return e.first; });
-          return (it != global_to_local.end() and it->first == index)
-                     ? it->second
-                     : -1;
-        }
-      });
+  if (queries.empty())
+    return;
+
+  const std::vector<std::pair<std::int64_t, std::int32_t>>& ghosts
+      = ghost_lookup();
+  if (queries.size() < ghosts.size())
+  {
+    // Few queries: binary search for each
+    for (auto [index, i] : queries)
+    {
+      auto it = std::ranges::lower_bound(ghosts, index, std::ranges::less(),
+                                         [](auto e) { return e.first; });
+      local[i] = (it != ghosts.end() and it->first == index) ? it->second : -1;
+    }
+  }
+  else
+  {
+    // Many queries: sort the queries and merge with the ghosts
+    std::ranges::sort(queries);
+    auto it = ghosts.begin();
+    for (auto [index, i] : queries)
+    {
+      while (it != ghosts.end() and it->first < index)
+        ++it;
+      local[i] = (it != ghosts.end() and it->first == index) ? it->second : -1;
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int64_t> IndexMap::global_indices() const
@@ -1333,3 +1442,60 @@ std::array<double, 2> IndexMap::imbalance() const
   return imbalance;
 }
 //-----------------------------------------------------------------------------
+IndexMapStatistics IndexMap::statistics() const
+{
+  MPI_Comm comm = _comm.comm();
+  const int comm_size = dolfinx::MPI::size(comm);
+
+  // Ghost ratio
+  const std::int64_t size_local = _local_range[1] - _local_range[0];
+  const double ratio
+      = size_local > 0 ? static_cast<double>(_ghosts.size()) / size_local : 0;
+  std::array<double, 3> ghost_ratio;
+  MPI_Allreduce(&ratio, &ghost_ratio[0], 1, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(&ratio, &ghost_ratio[1], 1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(&ratio, &ghost_ratio[2], 1, MPI_DOUBLE, MPI_SUM, comm);
+  ghost_ratio[2] /= comm_size;
+
+  // Histograms of the number of source and destination ranks
+  std::array<std::int32_t, 2> max_degree
+      = {static_cast<std::int32_t>(_src.size()),
+         static_cast<std::int32_t>(_dest.size())};
+  MPI_Allreduce(MPI_IN_PLACE, max_degree.data(), 2, MPI_INT32_T, MPI_MAX,
+                comm);
+  std::vector<std::int32_t> histogram(max_degree[0] + max_degree[1] + 2, 0);
+  histogram[_src.size()] = 1;
+  histogram[max_degree[0] + 1 + _dest.size()] = 1;
+  MPI_Allreduce(MPI_IN_PLACE, histogram.data(), histogram.size(), MPI_INT32_T,
+                MPI_SUM, comm);
+
+  auto it = std::next(histogram.begin(), max_degree[0] + 1);
+  return {ghost_ratio, std::vector<std::int32_t>(histogram.begin(), it),
+          std::vector<std::int32_t>(it, histogram.end())};
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::pair<std::int64_t, std::int32_t>>&
+IndexMap::ghost_lookup() const
+{
+  std::call_once(*_ghost_lookup_flag,
+                 [this]()
+                 {
+                   const std::int32_t local_size
+                       = _local_range[1] - _local_range[0];
+                   _ghost_lookup.resize(_ghosts.size());
+                   for (std::size_t i = 0; i < _ghosts.size(); ++i)
+                     _ghost_lookup[i] = {_ghosts[i], i + local_size};
+                   std::ranges::sort(_ghost_lookup);
+                 });
+  return _ghost_lookup;
+}
+//-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> IndexMap::memory_usage() const
+{
+  return {{"ghosts", common::container_memory(_ghosts)},
+          {"owners", common::container_memory(_owners)},
+          {"ghost_lookup", common::container_memory(_ghost_lookup)},
+          {"neighbours", common::container_memory(_src)
+                             + common::container_memory(_dest)}};
+}
+//-----------------------------------------------------------------------------
@@ -7,10 +7,14 @@
 #pragma once
 
 #include "IndexMap.h"
+#include <array>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -27,6 +31,24 @@ enum class IndexMapOrder : bool
   any = false      ///< Allow arbitrary ordering of ghost indices in sub-maps
 };
 
+/// @brief Statistics of the ghost and neighbourhood structure of an
+/// IndexMap across processes, see IndexMap::statistics.
+struct IndexMapStatistics
+{
+  /// Minimum, maximum and average over processes of the number of
+  /// ghost indices divided by the number of owned indices (0 if a
+  /// process owns no indices)
+  std::array<double, 3> ghost_ratio;
+
+  /// `src_histogram[d]` is the number of processes with `d` source
+  /// ranks (ranks that own ghosts of the process)
+  std::vector<std::int32_t> src_histogram;
+
+  /// `dest_histogram[d]` is the number of processes with `d`
+  /// destination ranks (ranks that ghost indices owned by the process)
+  std::vector<std::int32_t> dest_histogram;
+};
+
 /// @brief Given a sorted vector of indices (local numbering, owned or
 /// ghost) and an index map, this function returns the indices owned by
 /// this process, including indices that might have been in the list of
@@ -84,6 +106,36 @@ std::pair<IndexMap, std::vector<std::int32_t>> create_sub_index_map(
     const IndexMap& imap, std::span<const std::int32_t> indices,
     IndexMapOrder order = IndexMapOrder::any, bool allow_owner_change = false);
 
+/// @brief Create several ghosted index maps on the same communicator,
+/// with a combined computation of the destination ranks.
+///
+/// The maps are the same as created by the IndexMap constructor that
+/// computes the destination ranks (ranks that ghost indices owned by
+/// the caller) from the ghost owners. That constructor requires a
+/// consensus (NBX) exchange for each map. Here the destination ranks
+/// of all maps are computed by one consensus exchange on the union of
+/// the source ranks of the maps, followed by one neighbourhood exchange
+/// of the maps that each source rank owns ghosts for. This is
+/// considerably cheaper at scale when several related maps are
+/// created, e.g. for entities of different types.
+///
+/// @note Collective
+///
+/// @param[in] comm MPI communicator that the index maps are
+/// distributed across.
+/// @param[in] local_sizes Local size (number of owned indices) of each
+/// map.
+/// @param[in] ghosts Global indices of the ghost entries of each map.
+/// @param[in] owners Owner rank (on `comm`) of each ghost of each map.
+/// @param[in] tag Tag used in non-blocking MPI calls in the consensus
+/// algorithm, see IndexMap::IndexMap.
+/// @return The index maps, in the order of `local_sizes`.
+std::vector<IndexMap> create_index_maps(
+    MPI_Comm comm, std::span<const std::int32_t> local_sizes,
+    std::span<const std::span<const std::int64_t>> ghosts,
+    std::span<const std::span<const int>> owners,
+    int tag = static_cast<int>(dolfinx::MPI::tag::consensus_nbx));
+
 /// This class represents the distribution index arrays across
 /// processes. An index array is a contiguous collection of `N+1`
 /// indices `[0, 1, . . ., N]` that are distributed across `M`
@@ -158,6 +210,29 @@ public:
            const std::array<std::vector<int>, 2>& src_dest,
            std::span<const std::int64_t> ghosts, std::span<const int> owners);
 
+  /// @brief Create an overlapping (ghosted) index map from its complete
+  /// data, e.g. data that has been read from a file.
+  ///
+  /// No data is communicated, apart from duplicating `comm`. The data
+  /// must be consistent across ranks, i.e. as returned by the member
+  /// functions of an index map on the same communicator.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] comm MPI communicator that the index map is distributed
+  /// across.
+  /// @param[in] local_range Range of global indices owned by the
+  /// caller.
+  /// @param[in] size_global Global size of the index map.
+  /// @param[in] src_dest Lists of [0] src and [1] dest ranks (see
+  /// IndexMap::src and IndexMap::dest).
+  /// @param[in] ghosts The global indices of ghost entries
+  /// @param[in] owners Owner rank (on `comm`) of each entry in `ghosts`
+  IndexMap(MPI_Comm comm, std::array<std::int64_t, 2> local_range,
+           std::int64_t size_global,
+           const std::array<std::vector<int>, 2>& src_dest,
+           std::span<const std::int64_t> ghosts, std::span<const int> owners);
+
   // Copy constructor
   IndexMap(const IndexMap& map) = delete;
 
@@ -200,6 +275,10 @@ public:
                        std::span<std::int64_t> global) const;
 
   /// @brief Compute local indices for array of global indices.
+  ///
+  /// Ghost indices are looked up in a sorted table of the ghosts,
+  /// which is created on the first call and kept by the map.
+  ///
   /// @param[in] global Global indices
   /// @param[out] local The local of the corresponding global index in
   /// 'global'. Returns -1 if the local index does not exist on this
@@ -272,6 +351,23 @@ public:
   /// element) and the imbalance in ghost indices (second element).
   std::array<double, 2> imbalance() const;
 
+  /// @brief Statistics of the ghost indices and of the neighbourhood
+  /// (source and destination ranks) across all processes.
+  ///
+  /// The ghost ratio and the number of neighbours determine the
+  /// communication volume and the number of messages of scatters based
+  /// on the map.
+  ///
+  /// @note This is a collective operation and must be called by all
+  /// processes in the communicator associated with the IndexMap.
+  ///
+  /// @return Statistics (the same on all processes).
+  IndexMapStatistics statistics() const;
+
+  /// @brief Memory (bytes) used by the map on this process, by member.
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const;
+
 private:
   // Range of indices (global) owned by this process
   std::array<std::int64_t, 2> _local_range;
@@ -293,5 +389,18 @@ private:
 
   // Set of ranks ghost owned indices
   std::vector<int> _dest;
+
+  // (global index, local index) of the ghosts, sorted by global index.
+  // Empty until created by ghost_lookup().
+  mutable std::vector<std::pair<std::int64_t, std::int32_t>> _ghost_lookup;
+
+  // Guards the creation of _ghost_lookup
+  std::unique_ptr<std::once_flag> _ghost_lookup_flag
+      = std::make_unique<std::once_flag>();
+
+  // Sorted (global index, local index) of the ghosts, created on the
+  // first call
+  const std::vector<std::pair<std::int64_t, std::int32_t>>&
+  ghost_lookup() const;
 };
 } // namespace dolfinx::common
@@ -6,7 +6,13 @@
 
 #include "MPI.h"
 #include <dolfinx/common/log.h>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+
+#if __has_include(<mpi-ext.h>)
+#include <mpi-ext.h>
+#endif
 
 //-----------------------------------------------------------------------------
 dolfinx::MPI::Comm::Comm(MPI_Comm comm, bool duplicate)
@@ -91,6 +97,108 @@ void dolfinx::MPI::check_error(MPI_Comm comm, int code)
   }
 }
 //-----------------------------------------------------------------------------
+bool dolfinx::MPI::device_aware()
+{
+#if defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+  if (MPIX_Query_cuda_support())
+    return true;
+#endif
+#if defined(MPIX_ROCM_AWARE_SUPPORT) && MPIX_ROCM_AWARE_SUPPORT
+  if (MPIX_Query_rocm_support())
+    return true;
+#endif
+  return false;
+}
+//-----------------------------------------------------------------------------
+int dolfinx::MPI::neighbor_alltoallv(const void* send_buffer,
+                                     std::span<const std::int64_t> send_counts,
+                                     std::span<const std::int64_t> send_disp,
+                                     void* recv_buffer,
+                                     std::span<const std::int64_t> recv_counts,
+                                     std::span<const std::int64_t> recv_disp,
+                                     MPI_Datatype type, MPI_Comm comm)
+{
+#if MPI_VERSION >= 4
+  std::vector<MPI_Count> scounts(send_counts.begin(), send_counts.end()),
+      rcounts(recv_counts.begin(), recv_counts.end());
+  std::vector<MPI_Aint> sdisp(send_disp.begin(), send_disp.end()),
+      rdisp(recv_disp.begin(), recv_disp.end());
+  scounts.reserve(1);
+  rcounts.reserve(1);
+  sdisp.reserve(1);
+  rdisp.reserve(1);
+  return MPI_Neighbor_alltoallv_c(send_buffer, scounts.data(), sdisp.data(),
+                                  type, recv_buffer, rcounts.data(),
+                                  rdisp.data(), type, comm);
+#else
+  // Check if the counts and displacements on all ranks fit in an int
+  auto fits = [](auto x)
+  {
+    return std::ranges::all_of(
+        x, [](auto c) { return c <= std::numeric_limits<int>::max(); });
+  };
+  int large = !(fits(send_counts) and fits(send_disp) and fits(recv_counts)
+                and fits(recv_disp));
+  int err = MPI_Allreduce(MPI_IN_PLACE, &large, 1, MPI_INT, MPI_LOR, comm);
+  if (err != MPI_SUCCESS)
+    return err;
+
+  if (!large)
+  {
+    std::vector<int> scounts(send_counts.begin(), send_counts.end()),
+        rcounts(recv_counts.begin(), recv_counts.end());
+    std::vector<int> sdisp(send_disp.begin(), send_disp.end()),
+        rdisp(recv_disp.begin(), recv_disp.end());
+    scounts.reserve(1);
+    rcounts.reserve(1);
+    sdisp.reserve(1);
+    rdisp.reserve(1);
+    return MPI_Neighbor_alltoallv(send_buffer, scounts.data(), sdisp.data(),
+                                  type, recv_buffer, rcounts.data(),
+                                  rdisp.data(), type, comm);
+  }
+
+  // Exchange the data with point-to-point messages of at most INT_MAX
+  // items. Messages between a pair of ranks are non-overtaking, so the
+  // pieces arrive in order.
+  int indegree, outdegree, weighted;
+  err = MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
+  if (err != MPI_SUCCESS)
+    return err;
+  std::vector<int> src(indegree), dest(outdegree);
+  err = MPI_Dist_graph_neighbors(comm, indegree, src.data(), MPI_UNWEIGHTED,
+                                 outdegree, dest.data(), MPI_UNWEIGHTED);
+  if (err != MPI_SUCCESS)
+    return err;
+
+  MPI_Aint lb, extent;
+  MPI_Type_get_extent(type, &lb, &extent);
+  constexpr std::int64_t max_count = std::numeric_limits<int>::max();
+  const int tag = static_cast<int>(tag::large_count);
+  std::vector<MPI_Request> requests;
+  for (int i = 0; i < indegree; ++i)
+  {
+    auto ptr = static_cast<char*>(recv_buffer) + recv_disp[i] * extent;
+    for (std::int64_t offset = 0; offset < recv_counts[i]; offset += max_count)
+    {
+      const int count = std::min(max_count, recv_counts[i] - offset);
+      MPI_Irecv(ptr + offset * extent, count, type, src[i], tag, comm,
+                &requests.emplace_back());
+    }
+  }
+  for (int i = 0; i < outdegree; ++i)
+  {
+    auto ptr = static_cast<const char*>(send_buffer) + send_disp[i] * extent;
+    for (std::int64_t offset = 0; offset < send_counts[i]; offset += max_count)
+    {
+      const int count = std::min(max_count, send_counts[i] - offset);
+      MPI_Isend(ptr + offset * extent, count, type, dest[i], tag, comm,
+                &requests.emplace_back());
+    }
+  }
+  return MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#endif
+}
 std::vector<int>
 dolfinx::MPI::compute_graph_edges_pcx(MPI_Comm comm, std::span<const int> edges)
 {
@@ -36,6 +36,7 @@ enum class tag : int
   consensus_pcx = 1200,
   consensus_pex = 1201,
   consensus_nbx = 1202,
+  large_count = 1203,
 };
 
 /// @brief A duplicate MPI communicator and manage lifetime of the
@@ -82,6 +83,15 @@ int size(MPI_Comm comm);
 /// @param[in] code Error code returned by an MPI function call.
 void check_error(MPI_Comm comm, int code);
 
+/// @brief Check if the MPI implementation can communicate GPU device
+/// memory directly (CUDA- or ROCm-aware MPI).
+///
+/// The check uses the Open MPI extension MPIX_Query_cuda_support and
+/// MPIX_Query_rocm_support, if available. Other implementations are
+/// reported as not device aware.
+/// @return `true` if device buffers can be passed to MPI.
+bool device_aware();
+
 /// @brief Return local range for the calling process, partitioning the
 /// global [0, N - 1] range across all ranks into partitions of almost
 /// equal size.
@@ -187,6 +197,38 @@ std::vector<int>
 compute_graph_edges_nbx(MPI_Comm comm, std::span<const int> edges,
                         int tag = static_cast<int>(tag::consensus_nbx));
 
+/// @brief Neighbourhood all-to-all exchange of variable-sized data
+/// with 64-bit counts and displacements.
+///
+/// The MPI-4 large-count routine `MPI_Neighbor_alltoallv_c` is used if
+/// it is available. Otherwise, `MPI_Neighbor_alltoallv` is used if the
+/// counts and displacements on all ranks fit in an `int`, and if not,
+/// the data is exchanged with point-to-point messages of at most
+/// `INT_MAX` items each.
+///
+/// @note Collective MPI operation
+/// @param[in] send_buffer Data to send.
+/// @param[in] send_counts Number of items to send to each destination
+/// rank of the neighbourhood communicator.
+/// @param[in] send_disp Offset (in items) of the data for each
+/// destination rank in `send_buffer`.
+/// @param[out] recv_buffer Buffer for the received data.
+/// @param[in] recv_counts Number of items to receive from each source
+/// rank.
+/// @param[in] recv_disp Offset (in items) of the data from each source
+/// rank in `recv_buffer`.
+/// @param[in] type MPI data type of an item.
+/// @param[in] comm Neighbourhood communicator (created with
+/// `MPI_Dist_graph_create_adjacent`).
+/// @return MPI error code.
+int neighbor_alltoallv(const void* send_buffer,
+                       std::span<const std::int64_t> send_counts,
+                       std::span<const std::int64_t> send_disp,
+                       void* recv_buffer,
+                       std::span<const std::int64_t> recv_counts,
+                       std::span<const std::int64_t> recv_disp,
+                       MPI_Datatype type, MPI_Comm comm);
+
 /// @brief Distribute row data to 'post office' ranks.
 ///
 /// This function takes row-wise data that is distributed across
@@ -265,6 +307,103 @@ std::vector<typename std::remove_reference_t<typename U::value_type>>
 distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
                 MPI_Comm comm1, const U& x, int shape1);
 
+/// @brief Row-wise data distribution started by
+/// MPI::distribute_data_begin, and completed by
+/// MPI::distribute_data_end.
+///
+/// The final exchange of rows is non-blocking. Other communication,
+/// including collectives on the same communicator, may be performed
+/// before the distribution is completed.
+template <typename T>
+struct DistributeDataRequest
+{
+  /// Create an empty request
+  DistributeDataRequest() = default;
+
+  // Copy constructor (deleted, the buffers are in use by MPI)
+  DistributeDataRequest(const DistributeDataRequest&) = delete;
+
+  /// Move constructor
+  DistributeDataRequest(DistributeDataRequest&&) = default;
+
+  // Assignment operator (deleted)
+  DistributeDataRequest& operator=(const DistributeDataRequest&) = delete;
+
+  /// Move assignment operator
+  DistributeDataRequest& operator=(DistributeDataRequest&&) = default;
+
+  /// Data for each requested index (row-major). Rows that are received
+  /// from other processes are set by MPI::distribute_data_end.
+  std::vector<T> data;
+
+  /// Number of columns
+  std::size_t shape1 = 0;
+
+  /// Request for the exchange of rows
+  MPI_Request request = MPI_REQUEST_NULL;
+
+  /// Send and receive buffers of the exchange
+  std::vector<T> send_buffer, recv_buffer;
+
+  /// Send and receive sizes and displacements (number of rows) of the
+  /// exchange
+  std::vector<std::int32_t> send_sizes, send_disp, recv_sizes, recv_disp;
+
+  /// Pairs of (row in `data`, row in `recv_buffer`) for received rows
+  std::vector<std::array<std::int32_t, 2>> unpack;
+};
+
+/// @brief Start the distribution of rows of a rectangular data array
+/// from post office ranks to ranks where they are required.
+///
+/// See MPI::distribute_from_postoffice. The distribution must be
+/// completed by MPI::distribute_data_end.
+///
+/// @note Collective
+template <typename U>
+DistributeDataRequest<
+    typename std::remove_reference_t<typename U::value_type>>
+distribute_from_postoffice_begin(MPI_Comm comm,
+                                 std::span<const std::int64_t> indices,
+                                 const U& x, std::array<std::int64_t, 2> shape,
+                                 std::int64_t rank_offset);
+
+/// @brief Start the distribution of rows of a rectangular data array
+/// to ranks where they are required.
+///
+/// See MPI::distribute_data. The distribution must be completed by
+/// MPI::distribute_data_end. The data array `x` and `indices` can be
+/// destroyed once this function returns.
+///
+/// @note Collective
+template <typename U>
+DistributeDataRequest<
+    typename std::remove_reference_t<typename U::value_type>>
+distribute_data_begin(MPI_Comm comm0, std::span<const std::int64_t> indices,
+                      MPI_Comm comm1, const U& x, int shape1);
+
+/// @brief Complete a distribution of data started by
+/// MPI::distribute_data_begin or
+/// MPI::distribute_from_postoffice_begin.
+///
+/// @note Not collective. Completing the distribution only waits for the
+/// messages of the calling process.
+///
+/// @param[in] request The pending distribution.
+/// @return The data for each requested index (row-major storage).
+template <typename T>
+std::vector<T> distribute_data_end(DistributeDataRequest<T>&& request)
+{
+  MPI_Wait(&request.request, MPI_STATUS_IGNORE);
+  const std::size_t shape1 = request.shape1;
+  for (auto [i, pos] : request.unpack)
+  {
+    std::copy_n(std::next(request.recv_buffer.begin(), shape1 * pos), shape1,
+                std::next(request.data.begin(), shape1 * i));
+  }
+  return std::move(request.data);
+}
+
 template <typename T>
 struct dependent_false : std::false_type
 {
@@ -324,7 +463,8 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
   assert(x.size() % shape[1] == 0);
   const std::int32_t shape0_local = x.size() / shape[1];
 
-  spdlog::debug("Sending data to post offices (distribute_to_postoffice)");
+  DOLFINX_LOG_DEBUG(
+      "Sending data to post offices (distribute_to_postoffice)");
 
   // Post office ranks will receive data from this rank
   std::vector<int> row_to_dest(shape0_local);
@@ -435,22 +575,30 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
       recv_disp.data(), MPI_INT64_T, neigh_comm);
   dolfinx::MPI::check_error(comm, err);
 
-  // Send/receive data (x)
+  // Send/receive data (x). The data is exchanged with 64-bit counts,
+  // since the number of values received by a post office may exceed
+  // INT_MAX.
   MPI_Datatype compound_type;
   MPI_Type_contiguous(shape[1], dolfinx::MPI::mpi_t<T>, &compound_type);
   MPI_Type_commit(&compound_type);
   std::vector<T> recv_buffer_data(shape[1] * recv_disp.back());
-  err = MPI_Neighbor_alltoallv(
-      send_buffer_data.data(), num_items_per_dest.data(), send_disp.data(),
-      compound_type, recv_buffer_data.data(), num_items_recv.data(),
-      recv_disp.data(), compound_type, neigh_comm);
+  {
+    std::vector<std::int64_t> send_counts(num_items_per_dest.begin(),
+                                          num_items_per_dest.end()),
+        recv_counts(num_items_recv.begin(), num_items_recv.end());
+    std::vector<std::int64_t> send_disp64(send_disp.begin(), send_disp.end()),
+        recv_disp64(recv_disp.begin(), recv_disp.end());
+    err = neighbor_alltoallv(send_buffer_data.data(), send_counts,
+                             send_disp64, recv_buffer_data.data(), recv_counts,
+                             recv_disp64, compound_type, neigh_comm);
+  }
   dolfinx::MPI::check_error(comm, err);
   err = MPI_Type_free(&compound_type);
   dolfinx::MPI::check_error(comm, err);
   err = MPI_Comm_free(&neigh_comm);
   dolfinx::MPI::check_error(comm, err);
 
-  spdlog::debug("Completed send data to post offices.");
+  DOLFINX_LOG_DEBUG("Completed send data to post offices.");
 
   // Convert to local indices
   const std::int64_t r0 = MPI::local_range(rank, shape[0], size)[0];
@@ -462,10 +610,12 @@ distribute_to_postoffice(MPI_Comm comm, const U& x,
 }
 //---------------------------------------------------------------------------
 template <typename U>
-std::vector<typename std::remove_reference_t<typename U::value_type>>
-distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
-                           const U& x, std::array<std::int64_t, 2> shape,
-                           std::int64_t rank_offset)
+DistributeDataRequest<
+    typename std::remove_reference_t<typename U::value_type>>
+distribute_from_postoffice_begin(MPI_Comm comm,
+                                 std::span<const std::int64_t> indices,
+                                 const U& x, std::array<std::int64_t, 2> shape,
+                                 std::int64_t rank_offset)
 {
   assert(rank_offset >= 0 or x.empty());
   using T = typename std::remove_reference_t<typename U::value_type>;
@@ -622,11 +772,22 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
   MPI_Type_contiguous(shape[1], dolfinx::MPI::mpi_t<T>, &compound_type0);
   MPI_Type_commit(&compound_type0);
 
-  std::vector<T> recv_buffer_data(shape[1] * send_disp.back());
-  err = MPI_Neighbor_alltoallv(
-      send_buffer_data.data(), num_items_recv.data(), recv_disp.data(),
-      compound_type0, recv_buffer_data.data(), num_items_per_src.data(),
-      send_disp.data(), compound_type0, neigh_comm0);
+  // Start the exchange. The buffers, sizes and displacements are held
+  // by the request until the exchange is complete. The datatype and
+  // communicator can be freed while the exchange is pending.
+  DistributeDataRequest<T> request;
+  request.shape1 = shape[1];
+  request.send_buffer = std::move(send_buffer_data);
+  request.send_sizes = std::move(num_items_recv);
+  request.send_disp = std::move(recv_disp);
+  request.recv_buffer.resize(shape[1] * send_disp.back());
+  request.recv_sizes = std::move(num_items_per_src);
+  request.recv_disp = std::move(send_disp);
+  err = MPI_Ineighbor_alltoallv(
+      request.send_buffer.data(), request.send_sizes.data(),
+      request.send_disp.data(), compound_type0, request.recv_buffer.data(),
+      request.recv_sizes.data(), request.recv_disp.data(), compound_type0,
+      neigh_comm0, &request.request);
   dolfinx::MPI::check_error(comm, err);
 
   err = MPI_Type_free(&compound_type0);
@@ -638,8 +799,10 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
   for (std::size_t i = 0; i < src_to_index.size(); ++i)
     index_pos_to_buffer[std::get<2>(src_to_index[i])] = i;
 
-  // Extra data to return
-  std::vector<T> x_new(shape[1] * indices.size());
+  // Extra data to return. Rows that are received are set when the
+  // exchange is complete.
+  std::vector<T>& x_new = request.data;
+  x_new.resize(shape[1] * indices.size());
   for (std::size_t i = 0; i < indices.size(); ++i)
   {
     const std::int64_t index = indices[i];
@@ -667,19 +830,29 @@ distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
         // In my received post
         std::int32_t pos = index_pos_to_buffer[i];
         assert(pos != -1);
-        std::copy_n(std::next(recv_buffer_data.begin(), shape[1] * pos),
-                    shape[1], std::next(x_new.begin(), shape[1] * i));
+        request.unpack.push_back({static_cast<std::int32_t>(i), pos});
       }
     }
   }
 
-  return x_new;
+  return request;
 }
 //---------------------------------------------------------------------------
 template <typename U>
 std::vector<typename std::remove_reference_t<typename U::value_type>>
-distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
-                MPI_Comm comm1, const U& x, int shape1)
+distribute_from_postoffice(MPI_Comm comm, std::span<const std::int64_t> indices,
+                           const U& x, std::array<std::int64_t, 2> shape,
+                           std::int64_t rank_offset)
+{
+  return distribute_data_end(
+      distribute_from_postoffice_begin(comm, indices, x, shape, rank_offset));
+}
+//---------------------------------------------------------------------------
+template <typename U>
+DistributeDataRequest<
+    typename std::remove_reference_t<typename U::value_type>>
+distribute_data_begin(MPI_Comm comm0, std::span<const std::int64_t> indices,
+                      MPI_Comm comm1, const U& x, int shape1)
 {
   assert(shape1 > 0);
   assert(x.size() % shape1 == 0);
@@ -705,8 +878,17 @@ distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
       throw std::runtime_error("Non-empty data on null MPI communicator");
   }
 
-  return distribute_from_postoffice(comm0, indices, x, {shape0, shape1},
-                                    rank_offset);
+  return distribute_from_postoffice_begin(comm0, indices, x,
+                                          {shape0, shape1}, rank_offset);
+}
+//---------------------------------------------------------------------------
+template <typename U>
+std::vector<typename std::remove_reference_t<typename U::value_type>>
+distribute_data(MPI_Comm comm0, std::span<const std::int64_t> indices,
+                MPI_Comm comm1, const U& x, int shape1)
+{
+  return distribute_data_end(
+      distribute_data_begin(comm0, indices, comm1, x, shape1));
 }
 //---------------------------------------------------------------------------
 
@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MappedFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAS_MMAP
+#endif
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+/// Throw an error with the description of an errno value appended
+[[noreturn]] void throw_errno(const std::string& msg, int err)
+{
+  throw std::runtime_error(msg + ": " + std::strerror(err));
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+MappedFile::MappedFile(std::filesystem::path filename, std::size_t size)
+    : _filename(std::move(filename)), _fd(-1), _data(nullptr), _size(size)
+{
+#ifdef HAS_MMAP
+  _fd = ::open(_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (_fd == -1)
+  {
+    const int err = errno;
+    throw_errno("Failed to open file " + _filename.string(), err);
+  }
+
+  if (::ftruncate(_fd, static_cast<off_t>(_size)) != 0)
+  {
+    const int err = errno;
+    ::close(_fd);
+    std::filesystem::remove(_filename);
+    throw_errno("Failed to resize file " + _filename.string(), err);
+  }
+
+  if (_size > 0)
+  {
+    void* ptr
+        = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (ptr == MAP_FAILED)
+    {
+      const int err = errno;
+      ::close(_fd);
+      std::filesystem::remove(_filename);
+      throw_errno("Failed to map file " + _filename.string(), err);
+    }
+    _data = static_cast<std::byte*>(ptr);
+  }
+#else
+  throw std::runtime_error(
+      "Memory-mapped files are not supported on this platform.");
+#endif
+}
+//-----------------------------------------------------------------------------
+MappedFile::MappedFile(MappedFile&& file) noexcept
+    : _filename(std::move(file._filename)), _fd(std::exchange(file._fd, -1)),
+      _data(std::exchange(file._data, nullptr)),
+      _size(std::exchange(file._size, 0))
+{
+}
+//-----------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+#ifdef HAS_MMAP
+  if (_data)
+    ::munmap(_data, _size);
+  if (_fd != -1)
+  {
+    ::close(_fd);
+    std::error_code ec;
+    std::filesystem::remove(_filename, ec);
+  }
+#endif
+}
+//-----------------------------------------------------------------------------
+void MappedFile::prefetch([[maybe_unused]] std::size_t offset,
+                          [[maybe_unused]] std::size_t count) const
+{
+#ifdef HAS_MMAP
+  if (offset >= _size or count == 0)
+    return;
+
+  // Advice must start on a page boundary
+  const std::size_t start = offset - offset % page_size();
+  count = std::min(count, _size - offset) + (offset - start);
+  ::posix_madvise(_data + start, count, POSIX_MADV_WILLNEED);
+#endif
+}
+//-----------------------------------------------------------------------------
+void MappedFile::release([[maybe_unused]] std::size_t offset,
+                         [[maybe_unused]] std::size_t count) const
+{
+#ifdef HAS_MMAP
+  if (offset >= _size or count == 0)
+    return;
+
+  const std::size_t start = offset - offset % page_size();
+  count = std::min(count, _size - offset) + (offset - start);
+  if (::msync(_data + start, count, MS_SYNC) != 0)
+  {
+    const int err = errno;
+    throw_errno("Failed to write mapped data to " + _filename.string(), err);
+  }
+
+  // Remove the pages from the mapping, and then drop the (clean) pages
+  // from the page cache
+#ifdef __linux__
+  ::madvise(_data + start, count, MADV_DONTNEED);
+  ::posix_fadvise(_fd, static_cast<off_t>(start), static_cast<off_t>(count),
+                  POSIX_FADV_DONTNEED);
+#else
+  ::posix_madvise(_data + start, count, POSIX_MADV_DONTNEED);
+#endif
+#endif
+}
+//-----------------------------------------------------------------------------
+std::size_t MappedFile::page_size()
+{
+#ifdef HAS_MMAP
+  return ::sysconf(_SC_PAGESIZE);
+#else
+  return 4096;
+#endif
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace dolfinx::common
+{
+/// @brief Scratch file that is mapped into memory.
+///
+/// The file is created (or truncated) when the object is created, and
+/// is removed when the object is destroyed. Pages of the mapping are
+/// read from and written to the file by the operating system on
+/// demand, which allows data that does not fit into memory to be
+/// accessed as an array.
+///
+/// @note Memory-mapped files are supported on POSIX systems only.
+class MappedFile
+{
+public:
+  /// @brief Create and map a file.
+  /// @param[in] filename Name of the file. An existing file with this
+  /// name is overwritten.
+  /// @param[in] size Size of the file in bytes.
+  MappedFile(std::filesystem::path filename, std::size_t size);
+
+  // Copy constructor (deleted)
+  MappedFile(const MappedFile&) = delete;
+
+  /// Move constructor
+  MappedFile(MappedFile&& file) noexcept;
+
+  /// Destructor. Unmaps and removes the file.
+  ~MappedFile();
+
+  // Assignment operator (deleted)
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Move assignment operator (deleted)
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  /// @brief Name of the file.
+  const std::filesystem::path& filename() const { return _filename; }
+
+  /// @brief The mapped data.
+  std::span<std::byte> data() { return {_data, _size}; }
+
+  /// @brief The mapped data (const version).
+  std::span<const std::byte> data() const { return {_data, _size}; }
+
+  /// @brief Start to read a range of the file into memory.
+  ///
+  /// The pages are read asynchronously by the operating system, and the
+  /// function returns without waiting for them.
+  ///
+  /// @param[in] offset Offset of the range in bytes.
+  /// @param[in] count Size of the range in bytes.
+  void prefetch(std::size_t offset, std::size_t count) const;
+
+  /// @brief Write a range to the file and release its pages from
+  /// memory.
+  ///
+  /// The data remains accessible, and is read from the file when it is
+  /// next accessed.
+  ///
+  /// @param[in] offset Offset of the range in bytes.
+  /// @param[in] count Size of the range in bytes.
+  void release(std::size_t offset, std::size_t count) const;
+
+  /// @brief Size of a memory page in bytes.
+  static std::size_t page_size();
+
+private:
+  std::filesystem::path _filename;
+  int _fd;
+  std::byte* _data;
+  std::size_t _size;
+};
+} // namespace dolfinx::common
@@ -0,0 +1,309 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MetricsExporter.h"
+#include "json.h"
+#include "load_metrics.h"
+#include "timing.h"
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+/// Resident memory (bytes) of the process, or -1 if not available
+double resident_memory()
+{
+#ifdef __linux__
+  std::ifstream file("/proc/self/statm");
+  std::size_t size, resident;
+  if (file >> size >> resident)
+    return static_cast<double>(resident) * sysconf(_SC_PAGESIZE);
+#endif
+  return -1;
+}
+
+/// Minimum, maximum, sum and count of a metric over processes
+struct Stats
+{
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+  double sum = 0;
+  int count = 0;
+};
+} // namespace
+
+//-----------------------------------------------------------------------------
+MetricsExporter::MetricsExporter(MPI_Comm comm, std::filesystem::path filename,
+                                 int interval)
+    : _comm(comm), _filename(std::move(filename)),
+      _interval(std::max(interval, 1))
+{
+  if (dolfinx::MPI::rank(_comm.comm()) == 0)
+    _writer = std::thread(&MetricsExporter::write_loop, this);
+}
+//-----------------------------------------------------------------------------
+MetricsExporter::~MetricsExporter()
+{
+  flush();
+  if (_writer.joinable())
+  {
+    {
+      std::scoped_lock lock(_mutex);
+      _stop = true;
+    }
+    _cv.notify_all();
+    _writer.join();
+  }
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::set(const std::string& name, double value)
+{
+  _user[name] = value;
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::update()
+{
+  progress(false);
+  if (++_count < _interval)
+    return;
+
+  _count = 0;
+  progress(true);
+  start();
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::flush()
+{
+  progress(true);
+  std::unique_lock lock(_mutex);
+  _cv.wait(lock, [this] { return !_text and !_writing; });
+}
+//-----------------------------------------------------------------------------
+int MetricsExporter::num_exports() const
+{
+  std::scoped_lock lock(_mutex);
+  return _num_exports;
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::start()
+{
+  // Metric names may have labels, in which case the statistic label is
+  // appended on export
+  _keys.clear();
+  _values.clear();
+  auto add = [this](const std::string& key, double value)
+  {
+    _keys += key;
+    _keys += '\0';
+    _values.push_back(value);
+  };
+
+  for (auto& [task, t] : dolfinx::timings())
+  {
+    const std::string label = "{task=\"" + json_escape(task) + "\"}";
+    add("timer_calls" + label, t.first);
+    add("timer_seconds" + label, t.second.count());
+  }
+
+  if (double mem = resident_memory(); mem >= 0)
+    add("memory_resident_bytes", mem);
+
+  LoadTimes load{};
+  for (const LoadTimes& step : common::load_step_times())
+    for (std::size_t i = 0; i < num_load_phases; ++i)
+      load[i] += step[i];
+  for (std::size_t i = 0; i < num_load_phases; ++i)
+  {
+    add("load_seconds{phase=\"" + std::string(load_phase_names[i]) + "\"}",
+        load[i]);
+  }
+
+  for (auto& [name, value] : _user)
+    add(name, value);
+
+  // Gather the sizes first, so that rank 0 can size the receive buffers
+  _sizes = {static_cast<int>(_keys.size()), static_cast<int>(_values.size())};
+  const int rank = dolfinx::MPI::rank(_comm.comm());
+  if (rank == 0)
+    _all_sizes.resize(2 * dolfinx::MPI::size(_comm.comm()));
+  _requests.resize(1);
+  MPI_Igather(_sizes.data(), 2, MPI_INT, _all_sizes.data(), 2, MPI_INT, 0,
+              _comm.comm(), _requests.data());
+  _stage = 1;
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::gather_data()
+{
+  std::vector<int> key_sizes, value_sizes, key_disp, value_disp;
+  if (dolfinx::MPI::rank(_comm.comm()) == 0)
+  {
+    const std::size_t size = _all_sizes.size() / 2;
+    key_sizes.resize(size);
+    value_sizes.resize(size);
+    for (std::size_t p = 0; p < size; ++p)
+    {
+      key_sizes[p] = _all_sizes[2 * p];
+      value_sizes[p] = _all_sizes[2 * p + 1];
+    }
+    key_disp.resize(size + 1, 0);
+    value_disp.resize(size + 1, 0);
+    std::partial_sum(key_sizes.begin(), key_sizes.end(),
+                     std::next(key_disp.begin()));
+    std::partial_sum(value_sizes.begin(), value_sizes.end(),
+                     std::next(value_disp.begin()));
+    _all_keys.resize(key_disp.back());
+    _all_values.resize(value_disp.back());
+  }
+
+  // The size and displacement arrays are only read when the operations
+  // are posted
+  _requests.resize(2);
+  MPI_Igatherv(_keys.data(), _sizes[0], MPI_CHAR, _all_keys.data(),
+               key_sizes.data(), key_disp.data(), MPI_CHAR, 0, _comm.comm(),
+               &_requests[0]);
+  MPI_Igatherv(_values.data(), _sizes[1], MPI_DOUBLE, _all_values.data(),
+               value_sizes.data(), value_disp.data(), MPI_DOUBLE, 0,
+               _comm.comm(), &_requests[1]);
+  _stage = 2;
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::finish()
+{
+  _stage = 0;
+  if (dolfinx::MPI::rank(_comm.comm()) != 0)
+  {
+    std::scoped_lock lock(_mutex);
+    ++_num_exports;
+    return;
+  }
+
+  // Reduce each metric over the processes that have it
+  std::map<std::string, Stats> stats;
+  std::string_view keys(_all_keys.data(), _all_keys.size());
+  std::size_t pos = 0;
+  for (double value : _all_values)
+  {
+    std::size_t end = keys.find('\0', pos);
+    Stats& s = stats[std::string(keys.substr(pos, end - pos))];
+    s.min = std::min(s.min, value);
+    s.max = std::max(s.max, value);
+    s.sum += value;
+    ++s.count;
+    pos = end + 1;
+  }
+
+  std::ostringstream text;
+  text.precision(std::numeric_limits<double>::max_digits10);
+  text << "# TYPE dolfinx_num_processes gauge\n"
+       << "dolfinx_num_processes " << _all_sizes.size() / 2 << "\n";
+  std::string family;
+  for (auto& [key, s] : stats)
+  {
+    const std::size_t brace = key.find('{');
+    const std::string name = "dolfinx_" + key.substr(0, brace);
+    const std::string labels
+        = brace == std::string::npos
+              ? "{"
+              : key.substr(brace, key.size() - brace - 1) + ",";
+    if (name != family)
+    {
+      text << "# TYPE " << name << " gauge\n";
+      family = name;
+    }
+    text << name << labels << "stat=\"min\"} " << s.min << "\n"
+         << name << labels << "stat=\"max\"} " << s.max << "\n"
+         << name << labels << "stat=\"avg\"} " << s.sum / s.count << "\n";
+  }
+
+  {
+    std::scoped_lock lock(_mutex);
+    _text = text.str();
+  }
+  _cv.notify_all();
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::progress(bool wait)
+{
+  while (_stage != 0)
+  {
+    int complete = 1;
+    if (wait)
+    {
+      MPI_Waitall(_requests.size(), _requests.data(), MPI_STATUSES_IGNORE);
+    }
+    else
+    {
+      MPI_Testall(_requests.size(), _requests.data(), &complete,
+                  MPI_STATUSES_IGNORE);
+    }
+
+    if (!complete)
+      return;
+    else if (_stage == 1)
+      gather_data();
+    else
+      finish();
+  }
+}
+//-----------------------------------------------------------------------------
+void MetricsExporter::write_loop()
+{
+  std::unique_lock lock(_mutex);
+  while (true)
+  {
+    _cv.wait(lock, [this] { return _text or _stop; });
+    if (!_text)
+      return;
+
+    std::string text = std::move(*_text);
+    _text.reset();
+    _writing = true;
+    lock.unlock();
+
+    bool written = false;
+
+    // Write to a temporary file and rename it, so that readers never
+    // see a partially written file
+    try
+    {
+      std::filesystem::path tmp = _filename;
+      tmp += ".tmp";
+      {
+        std::ofstream file(tmp, std::ios::trunc);
+        file << text;
+        if (!file)
+          throw std::runtime_error("Failed to write " + tmp.string());
+      }
+      std::filesystem::rename(tmp, _filename);
+      written = true;
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::error("Metrics export failed: {}", e.what());
+    }
+
+    lock.lock();
+    _writing = false;
+    if (written)
+      ++_num_exports;
+    _cv.notify_all();
+  }
+}
+//-----------------------------------------------------------------------------
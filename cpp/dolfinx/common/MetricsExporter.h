@@ -0,0 +1,159 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MPI.h"
+#include <array>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <mpi.h>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @file MetricsExporter.h
+/// @brief Periodic export of run-time metrics while a simulation runs.
+
+namespace dolfinx::common
+{
+/// @brief Periodic export of timer, memory and user metrics to a file
+/// in the Prometheus text exposition format.
+///
+/// The metrics of each process are
+/// - the number of calls and total time of each timed task (see
+///   dolfinx::timings),
+/// - the resident memory of the process (Linux only),
+/// - the total time in each load phase (see common::load_step_times),
+/// - and values set with MetricsExporter::set, e.g. scatter statistics.
+///
+/// Every `interval` calls of MetricsExporter::update, the metrics are
+/// gathered to rank 0 with non-blocking collectives, which are
+/// progressed by subsequent calls of update. Rank 0 then computes the
+/// minimum, maximum and average over processes of each metric, which
+/// a background thread writes to the file. The file is replaced
+/// atomically, so that it can be read at any time, e.g. by the
+/// Prometheus node exporter textfile collector or a sidecar that
+/// forwards it to an OpenTelemetry collector.
+///
+/// Only the thread that calls update communicates, so an MPI library
+/// with `MPI_THREAD_FUNNELED` support is sufficient.
+class MetricsExporter
+{
+public:
+  /// @brief Create an exporter.
+  /// @note Collective
+  /// @param[in] comm Communicator of the processes to export metrics
+  /// of (it is duplicated).
+  /// @param[in] filename File written on rank 0.
+  /// @param[in] interval Number of calls of MetricsExporter::update
+  /// between exports.
+  MetricsExporter(MPI_Comm comm, std::filesystem::path filename,
+                  int interval = 1);
+
+  // Copy constructor (deleted)
+  MetricsExporter(const MetricsExporter&) = delete;
+
+  // Assignment operator (deleted)
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+  /// @brief Destructor. Completes the pending export (see
+  /// MetricsExporter::flush).
+  /// @note Collective
+  ~MetricsExporter();
+
+  /// @brief Set a metric of the calling process.
+  ///
+  /// The value is exported as `dolfinx_<name>`, and is retained for
+  /// subsequent exports until set again.
+  ///
+  /// @param[in] name Metric name, which must be a valid Prometheus
+  /// metric name.
+  /// @param[in] value Value.
+  void set(const std::string& name, double value);
+
+  /// @brief Progress the pending export and, every `interval` calls,
+  /// start a new export.
+  ///
+  /// If the previous export has not completed when a new export is
+  /// started, it is completed first.
+  ///
+  /// @note Collective, must be called the same number of times on all
+  /// processes.
+  void update();
+
+  /// @brief Complete the pending export and wait until the file has
+  /// been written.
+  /// @note Collective
+  void flush();
+
+  /// Number of exports that have been written to the file on rank 0,
+  /// and number of completed exports on other ranks
+  int num_exports() const;
+
+private:
+  // Start gathering the metrics of the calling process to rank 0
+  void start();
+
+  // Post the gather of the metric data (after the sizes are known on
+  // rank 0)
+  void gather_data();
+
+  // Reduce the gathered metrics on rank 0 and pass them to the writer
+  void finish();
+
+  // Progress the pending export. Blocks until it completes if `wait` is
+  // true.
+  void progress(bool wait);
+
+  // Write the metrics on the background thread
+  void write_loop();
+
+  // Communicator
+  dolfinx::MPI::Comm _comm;
+
+  // Output file (rank 0)
+  std::filesystem::path _filename;
+
+  // Number of update calls between exports, and calls since the last
+  // export
+  int _interval, _count = 0;
+
+  // User metrics
+  std::map<std::string, double> _user;
+
+  // Stage of the pending export: 0 (none), 1 (gathering sizes) or 2
+  // (gathering data)
+  int _stage = 0;
+
+  // Requests of the pending export
+  std::vector<MPI_Request> _requests;
+
+  // Local metric names (separated by '\0') and values
+  std::string _keys;
+  std::vector<double> _values;
+  std::array<int, 2> _sizes;
+
+  // Gathered sizes, names and values (rank 0)
+  std::vector<int> _all_sizes;
+  std::vector<char> _all_keys;
+  std::vector<double> _all_values;
+
+  // Text to write, shared with the writer thread
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::optional<std::string> _text;
+  bool _writing = false, _stop = false;
+  int _num_exports = 0;
+
+  // Writer thread (rank 0)
+  std::thread _writer;
+};
+
+} // namespace dolfinx::common
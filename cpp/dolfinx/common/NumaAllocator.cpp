@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "NumaAllocator.h"
+#include "MPI.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAS_MMAP
+#endif
+
+using namespace dolfinx;
+
+namespace
+{
+/// Alignment of heap allocations (cache line)
+constexpr std::align_val_t alignment{64};
+
+/// True if an array is mapped from the operating system
+constexpr bool is_mapped([[maybe_unused]] std::size_t bytes)
+{
+#ifdef HAS_MMAP
+  return bytes >= common::NumaAllocator<std::byte>::threshold;
+#else
+  return false;
+#endif
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+void* common::impl::allocate_first_touch(std::size_t n, std::size_t size)
+{
+  const std::size_t bytes = n * size;
+  if (!is_mapped(bytes))
+    return ::operator new(bytes, alignment);
+
+#ifdef HAS_MMAP
+  void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+  ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+
+  // Write the first byte of each page from the thread that works on
+  // the page. A page that is shared by the ranges of two threads is
+  // placed by the first thread.
+  const std::size_t page = ::sysconf(_SC_PAGESIZE);
+  const int num_threads = common::num_threads();
+  auto data = static_cast<volatile std::byte*>(p);
+  common::thread_pool().run(
+      num_threads,
+      [&](int t)
+      {
+        auto [i0, i1] = dolfinx::MPI::local_range(t, n, num_threads);
+        std::size_t b0 = (i0 * size + page - 1) / page * page;
+        for (std::size_t b = b0; b < std::size_t(i1) * size; b += page)
+          data[b] = std::byte{0};
+      });
+  return p;
+#endif
+}
+//-----------------------------------------------------------------------------
+void common::impl::deallocate_first_touch(void* p, std::size_t n,
+                                          std::size_t size) noexcept
+{
+  const std::size_t bytes = n * size;
+  if (!is_mapped(bytes))
+    ::operator delete(p, alignment);
+#ifdef HAS_MMAP
+  else
+    ::munmap(p, bytes);
+#endif
+}
+//-----------------------------------------------------------------------------
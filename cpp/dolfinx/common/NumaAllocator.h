@@ -0,0 +1,114 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace dolfinx::common
+{
+namespace impl
+{
+/// @brief Allocate memory and distribute its pages over the threads of
+/// the process thread pool.
+///
+/// See common::NumaAllocator.
+///
+/// @param[in] n Number of elements.
+/// @param[in] size Size in bytes of an element.
+/// @return Pointer to the memory, aligned to at least 64 bytes.
+void* allocate_first_touch(std::size_t n, std::size_t size);
+
+/// @brief Free memory allocated by impl::allocate_first_touch.
+/// @param[in] p Pointer to the memory.
+/// @param[in] n Number of elements that were allocated.
+/// @param[in] size Size in bytes of an element.
+void deallocate_first_touch(void* p, std::size_t n, std::size_t size) noexcept;
+} // namespace impl
+
+/// @brief Allocator that places the memory of large arrays in the NUMA
+/// domains of the threads that work on it.
+///
+/// Operating systems place a page in the NUMA domain of the thread that
+/// first writes to it. If an array is allocated and initialised by one
+/// thread, all of its pages are in one domain, and threaded kernels on
+/// other sockets then access remote memory. Arrays of at least
+/// NumaAllocator::threshold bytes are therefore mapped directly from
+/// the operating system, and the pages are first written by the
+/// threads of the process thread pool (see common::thread_pool). Thread
+/// `t` of `p` = common::num_threads() threads writes the elements
+/// `dolfinx::MPI::local_range(t, n, p)`, which is the partition of the
+/// index range used by the threaded loops in DOLFINx. On Linux,
+/// transparent huge pages are requested for these arrays, which
+/// reduces TLB misses for bandwidth-bound kernels, e.g. SpMV.
+///
+/// Smaller arrays are allocated on the heap.
+///
+/// The allocator can be used with the containers of la::Vector and
+/// la::MatrixCSR, e.g. `la::Vector<double, std::vector<double,
+/// common::NumaAllocator<double>>>`.
+///
+/// @note The placement only persists if the threads are pinned to
+/// cores, e.g. with `OMP_PROC_BIND`-like settings of the MPI launcher.
+/// @note Memory is allocated with a call to the thread pool, and must
+/// therefore not be allocated from a task of the pool if the placement
+/// is required.
+///
+/// @tparam T Element type
+template <typename T>
+class NumaAllocator
+{
+public:
+  /// Element type
+  using value_type = T;
+
+  /// Size in bytes of arrays from which the memory is placed by first
+  /// touch and huge pages are used
+  static constexpr std::size_t threshold = 2 * 1024 * 1024;
+
+  /// Create an allocator
+  NumaAllocator() noexcept = default;
+
+  /// Create an allocator from an allocator of another type
+  template <typename U>
+  NumaAllocator(const NumaAllocator<U>&) noexcept
+  {
+  }
+
+  /// @brief Allocate memory.
+  /// @param[in] n Number of elements.
+  /// @return Pointer to the memory.
+  T* allocate(std::size_t n)
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T*>(impl::allocate_first_touch(n, sizeof(T)));
+  }
+
+  /// @brief Free memory.
+  /// @param[in] p Pointer to the memory.
+  /// @param[in] n Number of elements that were allocated.
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    impl::deallocate_first_touch(p, n, sizeof(T));
+  }
+
+  /// All allocators are equal
+  template <typename U>
+  bool operator==(const NumaAllocator<U>&) const noexcept
+  {
+    return true;
+  }
+};
+
+/// @brief std::vector with common::NumaAllocator.
+template <typename T>
+using numa_vector = std::vector<T, NumaAllocator<T>>;
+
+} // namespace dolfinx::common
@@ -10,6 +10,8 @@
 #include "MPI.h"
 #include "sort.h"
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mpi.h>
@@ -22,12 +24,199 @@ using namespace dolfinx;
 
 namespace dolfinx::common
 {
+/// @brief Communication statistics for the scatters performed by an
+/// object, e.g. a la::Vector.
+///
+/// Statistics are for the calling process.
+struct ScatterStatistics
+{
+  /// Number of scatters (forward and reverse)
+  std::int64_t num_scatters = 0;
+
+  /// Number of (non-empty) messages sent
+  std::int64_t num_messages = 0;
+
+  /// Number of bytes sent
+  std::int64_t num_bytes = 0;
+
+  /// Maximum number of neighbouring processes that data was sent to in
+  /// a scatter
+  int num_neighbors = 0;
+
+  /// Time (s) spent waiting for scatters to complete
+  double wait_time = 0;
+
+  /// @brief Add a scatter to the statistics.
+  /// @param[in] sizes Number of values sent to each neighbour.
+  /// @param[in] value_size Size (bytes) of a value.
+  void add(std::span<const int> sizes, std::size_t value_size)
+  {
+    num_scatters += 1;
+    num_messages += std::ranges::count_if(sizes, [](auto s) { return s > 0; });
+    num_bytes += value_size
+                 * std::accumulate(sizes.begin(), sizes.end(), std::int64_t(0));
+    num_neighbors = std::max<int>(num_neighbors, sizes.size());
+  }
+};
+
+/// @brief MPI shared-memory window for the exchange of scatter data
+/// between processes on the same shared-memory node.
+///
+/// Each process has a segment of the window for its packed send data.
+/// Processes on the same node read the data sent to them directly from
+/// the segment of the sending process. Created by
+/// Scatterer::create_shared_window.
+///
+/// @warning The window is freed by the destructor with `MPI_Win_free`,
+/// which is collective on the processes of the node. A window must
+/// therefore be destroyed on all processes of a node, in the same order
+/// relative to other windows and collective operations. Destroying it
+/// on only some of the processes deadlocks.
+///
+/// @tparam T Type of the scattered data.
+template <typename T>
+class ScatterWindow
+{
+public:
+  /// @brief Create a window.
+  /// @param[in] comm Node communicator (the window takes ownership).
+  /// @param[in] win Shared-memory window on `comm` (the window takes
+  /// ownership).
+  /// @param[in] buffer Segment of the calling process in the window.
+  /// @param[in] src_fwd Location of the data sent to the caller by
+  /// each source rank in a forward scatter, or `nullptr` if the source
+  /// rank is not on the node.
+  /// @param[in] dest_rev Location of the data sent to the caller by
+  /// each destination rank in a reverse scatter, or `nullptr` if the
+  /// destination rank is not on the node.
+  ScatterWindow(MPI_Comm comm, MPI_Win win, std::span<T> buffer,
+                std::vector<const T*> src_fwd, std::vector<const T*> dest_rev)
+      : _comm(comm), _win(win), _buffer(buffer), _src_fwd(std::move(src_fwd)),
+        _dest_rev(std::move(dest_rev))
+  {
+  }
+
+  // Copy constructor (deleted)
+  ScatterWindow(const ScatterWindow&) = delete;
+
+  // Assignment operator (deleted)
+  ScatterWindow& operator=(const ScatterWindow&) = delete;
+
+  /// @brief Destructor.
+  /// @note Collective on the processes of the node.
+  ~ScatterWindow()
+  {
+    if (_win != MPI_WIN_NULL)
+      MPI_Win_free(&_win);
+    if (_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&_comm);
+  }
+
+  /// @brief Segment of the window for the packed data to send. Its
+  /// size is the larger of Scatterer::local_buffer_size and
+  /// Scatterer::remote_buffer_size.
+  std::span<T> buffer() const { return _buffer; }
+
+  /// The MPI window (`MPI_WIN_NULL` for a serial scatterer)
+  MPI_Win window() const { return _win; }
+
+  /// @brief Location of the data sent by each source rank in a forward
+  /// scatter (`nullptr` for ranks that are not on the node).
+  std::span<const T* const> src_fwd() const { return _src_fwd; }
+
+  /// @brief Location of the data sent by each destination rank in a
+  /// reverse scatter (`nullptr` for ranks that are not on the node).
+  std::span<const T* const> dest_rev() const { return _dest_rev; }
+
+private:
+  MPI_Comm _comm;
+  MPI_Win _win;
+  std::span<T> _buffer;
+  std::vector<const T*> _src_fwd, _dest_rev;
+};
+
+namespace impl
+{
+/// @brief Compute the runs of consecutive indices in a list of
+/// indices.
+///
+/// @param[in] idx List of indices.
+/// @return Offsets `r` into `idx` of the runs, with `idx[r[k] + j] =
+/// idx[r[k]] + j` for `0 <= j < r[k + 1] - r[k]`. The size is the number
+/// of runs plus one.
+inline std::vector<std::int32_t>
+contiguous_runs(std::span<const std::int32_t> idx)
+{
+  std::vector<std::int32_t> runs(1, 0);
+  for (std::size_t i = 1; i < idx.size(); ++i)
+  {
+    if (idx[i] != idx[i - 1] + 1)
+      runs.push_back(i);
+  }
+  if (!idx.empty())
+    runs.push_back(idx.size());
+  return runs;
+}
+
+/// @brief Pack `out[i] = in[idx[i]]`, copying the runs of consecutive
+/// indices (see impl::contiguous_runs) as blocks.
+template <typename T>
+void pack_runs(std::span<const T> in, std::span<const std::int32_t> idx,
+               std::span<const std::int32_t> runs, std::span<T> out)
+{
+  for (std::size_t k = 0; k + 1 < runs.size(); ++k)
+  {
+    std::copy_n(std::next(in.begin(), idx[runs[k]]), runs[k + 1] - runs[k],
+                std::next(out.begin(), runs[k]));
+  }
+}
+
+/// @brief Unpack `out[idx[i]] = in[i]`, copying the runs of
+/// consecutive indices (see impl::contiguous_runs) as blocks.
+template <typename T>
+void unpack_runs(std::span<const T> in, std::span<const std::int32_t> idx,
+                 std::span<const std::int32_t> runs, std::span<T> out)
+{
+  for (std::size_t k = 0; k + 1 < runs.size(); ++k)
+  {
+    std::copy_n(std::next(in.begin(), runs[k]), runs[k + 1] - runs[k],
+                std::next(out.begin(), idx[runs[k]]));
+  }
+}
+
+/// @brief Unpack `out[idx[i]] = op(out[idx[i]], in[i])` over the runs
+/// of consecutive indices (see impl::contiguous_runs).
+template <typename T, typename BinaryOp>
+void unpack_runs(std::span<const T> in, std::span<const std::int32_t> idx,
+                 std::span<const std::int32_t> runs, std::span<T> out,
+                 BinaryOp op)
+{
+  for (std::size_t k = 0; k + 1 < runs.size(); ++k)
+  {
+    const T* src = in.data() + runs[k];
+    T* dest = out.data() + idx[runs[k]];
+    for (std::int32_t j = 0; j < runs[k + 1] - runs[k]; ++j)
+      dest[j] = op(dest[j], src[j]);
+  }
+}
+} // namespace impl
+
 /// @brief A Scatterer supports the MPI scattering and gathering of data
 /// that is associated with a common::IndexMap.
 ///
-/// Scatter and gather operations use MPI neighbourhood collectives.
-/// The implementation is designed for sparse communication patterns,
-/// as it typical of patterns based on an IndexMap.
+/// Scatter and gather operations use, depending on Scatterer::type,
+/// MPI neighbourhood collectives, non-blocking point-to-point messages,
+/// persistent point-to-point requests, or an MPI-3 shared-memory
+/// window for the processes on the same node combined with
+/// point-to-point messages between nodes. The implementation is
+/// designed for sparse communication patterns, as it typical of
+/// patterns based on an IndexMap.
+///
+/// The shared-memory scatters (Scatterer::type::shared) use a
+/// ScatterWindow (see Scatterer::create_shared_window) in place of the
+/// send buffer, and have their own overloads of the scatter functions.
+/// Creating and freeing a window, and every scatter through it, are
+/// collective on the processes of a node.
 template <class Allocator = std::allocator<std::int32_t>>
 class Scatterer
 {
@@ -35,11 +224,25 @@ public:
   /// The allocator type
   using allocator_type = Allocator;
 
-  /// Types of MPI communication pattern used by the Scatterer.
+  /// @brief Types of MPI communication pattern used by the Scatterer.
+  ///
+  /// With `shared`, the processes on a shared-memory node
+  /// (`MPI_COMM_TYPE_SHARED`) exchange data through an MPI-3
+  /// shared-memory window: each process packs its data into its segment
+  /// of the window, and the receiving processes on the same node copy
+  /// it directly from that segment. An `MPI_Win_fence` on the window at
+  /// the start and at the end of each scatter synchronises the
+  /// processes of the node, so that all of them must take part in every
+  /// scatter. Data for processes on other nodes is sent with
+  /// `MPI_Isend`/`MPI_Irecv`. The requests are created with
+  /// Scatterer::create_request_vector.
   enum class type
   {
-    neighbor, // use MPI neighborhood collectives
-    p2p       // use MPI Isend/Irecv for communication
+    neighbor,   // use MPI neighborhood collectives
+    p2p,        // use MPI Isend/Irecv for communication
+    persistent, // use persistent MPI Send_init/Recv_init requests
+    shared      // use a shared-memory window on a node, and Isend/Irecv
+                // between nodes
   };
 
   /// @brief Create a scatterer.
@@ -169,6 +372,18 @@ public:
     for (std::size_t i = 0; i < perm.size(); i++)
       for (int j = 0; j < _bs; j++)
         _remote_inds[i * _bs + j] = perm[i] * _bs + j;
+
+    // Runs of consecutive indices, kept if they are long enough on
+    // average for block copies to be faster than a gather/scatter
+    auto runs = [](std::span<const std::int32_t> idx)
+    {
+      std::vector<std::int32_t> r = impl::contiguous_runs(idx);
+      if (r.size() < 2 or 4 * (r.size() - 1) > idx.size())
+        r.clear();
+      return r;
+    };
+    _local_runs = runs(_local_inds);
+    _remote_runs = runs(_remote_inds);
   }
 
   /// @brief Start a non-blocking send of owned data to ranks that ghost
@@ -190,7 +405,12 @@ public:
   /// @param requests The MPI request handle for tracking the status of
   /// the non-blocking communication
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, either Scatterer::type::neighbor, Scatterer::type::p2p
+  /// or Scatterer::type::persistent (Scatterer::type::shared uses the
+  /// overload that takes a ScatterWindow). For
+  /// Scatterer::type::persistent, `requests` must have been created by
+  /// Scatterer::create_persistent_requests_fwd using `send_buffer` and
+  /// `recv_buffer`.
   template <typename T>
   void scatter_fwd_begin(std::span<const T> send_buffer,
                          std::span<T> recv_buffer,
@@ -231,6 +451,12 @@ public:
       }
       break;
     }
+    case type::persistent:
+    {
+      assert(requests.size() == _dest.size() + _src.size());
+      MPI_Startall(requests.size(), requests.data());
+      break;
+    }
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
@@ -273,7 +499,8 @@ public:
   /// @param[in] requests The MPI request handle for tracking the status
   /// of the send
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, either Scatterer::type::neighbor, Scatterer::type::p2p
+  /// or Scatterer::type::persistent.
   template <typename T, typename F>
     requires std::is_invocable_v<F, std::span<const T>,
                                  std::span<const std::int32_t>, std::span<T>>
@@ -341,25 +568,183 @@ public:
     std::vector<MPI_Request> requests(1, MPI_REQUEST_NULL);
     std::vector<T> local_buffer(local_buffer_size(), 0);
     std::vector<T> remote_buffer(remote_buffer_size(), 0);
-    auto pack_fn = [](auto&& in, auto&& idx, auto&& out)
+    auto pack_fn = [runs = local_runs()](auto&& in, auto&& idx, auto&& out)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
+      if (!runs.empty())
+        impl::pack_runs(in, std::span<const std::int32_t>(idx), runs, out);
+      else
+      {
+        for (std::size_t i = 0; i < idx.size(); ++i)
+          out[i] = in[idx[i]];
+      }
     };
     scatter_fwd_begin(local_data, std::span<T>(local_buffer),
                       std::span<T>(remote_buffer), pack_fn,
                       std::span<MPI_Request>(requests));
 
-    auto unpack_fn = [](auto&& in, auto&& idx, auto&& out, auto op)
+    auto unpack_fn
+        = [runs = remote_runs()](auto&& in, auto&& idx, auto&& out, auto op)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
+      if (!runs.empty())
+      {
+        impl::unpack_runs(in, std::span<const std::int32_t>(idx), runs, out,
+                          op);
+      }
+      else
+      {
+        for (std::size_t i = 0; i < idx.size(); ++i)
+          out[idx[i]] = op(out[idx[i]], in[i]);
+      }
     };
 
     scatter_fwd_end(std::span<const T>(remote_buffer), remote_data, unpack_fn,
                     std::span<MPI_Request>(requests));
   }
 
+  /// @brief Scatter data associated with a subset of the owned indices
+  /// to ghosting ranks.
+  ///
+  /// Only the data of marked (e.g. changed) owned indices is sent to
+  /// each neighbour, together with the positions of the indices in the
+  /// (dense) message to the neighbour. If the fraction of marked
+  /// indices in the message to a neighbour exceeds `threshold`, the
+  /// data of all indices is sent to the neighbour without positions, as
+  /// in Scatterer::scatter_fwd. Ghost data of unmarked indices is not
+  /// changed.
+  ///
+  /// @note Collective and blocking on the neighbourhood of the
+  /// scatterer. Requires host memory.
+  ///
+  /// @param[in] local_data All data associated with owned indices. Size
+  /// is `size_local()` from the IndexMap used to create the scatterer,
+  /// multiplied by the block size. The data for each index is blocked.
+  /// @param[in,out] remote_data Data associated with the ghost indices,
+  /// with the layout as in Scatterer::scatter_fwd. Entries of marked
+  /// indices are updated.
+  /// @param[in] marker Marker for each owned index (not blocked). The
+  /// data of indices with a non-zero marker is sent.
+  /// @param[in] threshold Fraction of marked indices in a message above
+  /// which the data of all indices is sent.
+  /// @return Number of values sent to each neighbour (destination
+  /// rank).
+  template <typename T>
+  std::vector<int> scatter_fwd_sparse(std::span<const T> local_data,
+                                      std::span<T> remote_data,
+                                      std::span<const std::int8_t> marker,
+                                      double threshold = 0.25) const
+  {
+    // Return early if there are no incoming or outgoing edges
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return {};
+
+    // Positions (in blocks) of the marked indices in the message to
+    // each neighbour. A count of -1 means that all data is sent.
+    std::vector<int> send_count(_dest.size());
+    std::vector<std::int32_t> send_pos;
+    for (std::size_t i = 0; i < _dest.size(); ++i)
+    {
+      const int num_blocks = _sizes_local[i] / _bs;
+      const std::size_t pos0 = send_pos.size();
+      for (int k = 0; k < num_blocks; ++k)
+      {
+        if (marker[_local_inds[_displs_local[i] + k * _bs] / _bs])
+          send_pos.push_back(k);
+      }
+
+      send_count[i] = send_pos.size() - pos0;
+      if (send_count[i] > threshold * num_blocks)
+      {
+        send_pos.resize(pos0);
+        send_count[i] = -1;
+      }
+    }
+
+    std::vector<int> recv_count(_src.size());
+    MPI_Neighbor_alltoall(send_count.data(), 1, MPI_INT, recv_count.data(), 1,
+                          MPI_INT, _comm0.comm());
+
+    // Message sizes and displacements for the positions and values
+    auto sizes = [bs = _bs](auto& count, auto& dense_sizes)
+    {
+      std::array<std::vector<int>, 4> s;
+      for (std::size_t i = 0; i < count.size(); ++i)
+      {
+        s[0].push_back(std::max(count[i], 0));
+        s[1].push_back(count[i] < 0 ? dense_sizes[i] : count[i] * bs);
+      }
+      for (int j = 0; j < 2; ++j)
+      {
+        s[j + 2].resize(count.size() + 1, 0);
+        std::partial_sum(s[j].begin(), s[j].end(), std::next(s[j + 2].begin()));
+      }
+      return s;
+    };
+    const auto [send_sizes_pos, send_sizes, send_displs_pos, send_displs]
+        = sizes(send_count, _sizes_local);
+    const auto [recv_sizes_pos, recv_sizes, recv_displs_pos, recv_displs]
+        = sizes(recv_count, _sizes_remote);
+
+    // Pack values
+    std::vector<T> send_buffer(send_displs.back());
+    for (std::size_t i = 0; i < _dest.size(); ++i)
+    {
+      auto it = std::next(send_buffer.begin(), send_displs[i]);
+      const std::int32_t* inds = _local_inds.data() + _displs_local[i];
+      if (send_count[i] < 0)
+      {
+        for (int k = 0; k < _sizes_local[i]; ++k)
+          *it++ = local_data[inds[k]];
+      }
+      else
+      {
+        for (int p = 0; p < send_count[i]; ++p)
+        {
+          const std::int32_t k = send_pos[send_displs_pos[i] + p];
+          for (int b = 0; b < _bs; ++b)
+            *it++ = local_data[inds[k * _bs + b]];
+        }
+      }
+    }
+
+    std::vector<std::int32_t> recv_pos(recv_displs_pos.back());
+    std::vector<T> recv_buffer(recv_displs.back());
+    std::array<MPI_Request, 2> requests;
+    MPI_Ineighbor_alltoallv(send_pos.data(), send_sizes_pos.data(),
+                            send_displs_pos.data(), MPI_INT32_T,
+                            recv_pos.data(), recv_sizes_pos.data(),
+                            recv_displs_pos.data(), MPI_INT32_T,
+                            _comm0.comm(), &requests[0]);
+    MPI_Ineighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                            send_displs.data(), dolfinx::MPI::mpi_t<T>,
+                            recv_buffer.data(), recv_sizes.data(),
+                            recv_displs.data(), dolfinx::MPI::mpi_t<T>,
+                            _comm0.comm(), &requests[1]);
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    // Unpack values
+    for (std::size_t j = 0; j < _src.size(); ++j)
+    {
+      auto it = std::next(recv_buffer.cbegin(), recv_displs[j]);
+      const std::int32_t* inds = _remote_inds.data() + _displs_remote[j];
+      if (recv_count[j] < 0)
+      {
+        for (int k = 0; k < _sizes_remote[j]; ++k)
+          remote_data[inds[k]] = *it++;
+      }
+      else
+      {
+        for (int p = 0; p < recv_count[j]; ++p)
+        {
+          const std::int32_t k = recv_pos[recv_displs_pos[j] + p];
+          for (int b = 0; b < _bs; ++b)
+            remote_data[inds[k * _bs + b]] = *it++;
+        }
+      }
+    }
+
+    return send_sizes;
+  }
+
   /// @brief Start a non-blocking send of ghost data to ranks that own
   /// the data.
   ///
@@ -385,7 +770,12 @@ public:
   /// @param requests The MPI request handle for tracking the status of
   /// the non-blocking communication
   /// @param[in] type The type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or Scatterer::type::p2p.
+  /// Scatterer, either Scatterer::type::neighbor, Scatterer::type::p2p
+  /// or Scatterer::type::persistent (Scatterer::type::shared uses the
+  /// overload that takes a ScatterWindow). For
+  /// Scatterer::type::persistent, `requests` must have been created by
+  /// Scatterer::create_persistent_requests_rev using `send_buffer` and
+  /// `recv_buffer`.
   template <typename T>
   void scatter_rev_begin(std::span<const T> send_buffer,
                          std::span<T> recv_buffer,
@@ -430,6 +820,12 @@ public:
       }
       break;
     }
+    case type::persistent:
+    {
+      assert(requests.size() == _dest.size() + _src.size());
+      MPI_Startall(requests.size(), requests.data());
+      break;
+    }
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
@@ -475,8 +871,8 @@ public:
   /// @param request MPI request handles for tracking the status of the
   /// non-blocking communication.
   /// @param[in] type Type of MPI communication pattern used by the
-  /// Scatterer, either Scatterer::type::neighbor or
-  /// Scatterer::type::p2p.
+  /// Scatterer, either Scatterer::type::neighbor, Scatterer::type::p2p
+  /// or Scatterer::type::persistent.
   template <typename T, typename F>
     requires std::is_invocable_v<F, std::span<const T>,
                                  std::span<const std::int32_t>, std::span<T>>
@@ -538,15 +934,29 @@ public:
   {
     std::vector<T> local_buffer(local_buffer_size(), 0);
     std::vector<T> remote_buffer(remote_buffer_size(), 0);
-    auto pack_fn = [](auto&& in, auto&& idx, auto&& out)
+    auto pack_fn = [runs = remote_runs()](auto&& in, auto&& idx, auto&& out)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
+      if (!runs.empty())
+        impl::pack_runs(in, std::span<const std::int32_t>(idx), runs, out);
+      else
+      {
+        for (std::size_t i = 0; i < idx.size(); ++i)
+          out[i] = in[idx[i]];
+      }
     };
-    auto unpack_fn = [](auto&& in, auto&& idx, auto&& out, auto op)
+    auto unpack_fn
+        = [runs = local_runs()](auto&& in, auto&& idx, auto&& out, auto op)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
+      if (!runs.empty())
+      {
+        impl::unpack_runs(in, std::span<const std::int32_t>(idx), runs, out,
+                          op);
+      }
+      else
+      {
+        for (std::size_t i = 0; i < idx.size(); ++i)
+          out[idx[i]] = op(out[idx[i]], in[i]);
+      }
     };
     std::vector<MPI_Request> request(1, MPI_REQUEST_NULL);
     scatter_rev_begin(remote_data, std::span<T>(remote_buffer),
@@ -556,6 +966,18 @@ public:
                     std::span<MPI_Request>(request));
   }
 
+  /// @brief Add the messages sent by a forward or reverse scatter to
+  /// communication statistics.
+  /// @tparam T Type of the scattered data.
+  /// @param[in,out] stats Statistics to update.
+  /// @param[in] forward `true` for a forward scatter (owner to ghosts)
+  /// and `false` for a reverse scatter.
+  template <typename T>
+  void add_statistics(ScatterStatistics& stats, bool forward) const
+  {
+    stats.add(forward ? _sizes_local : _sizes_remote, sizeof(T));
+  }
+
   /// @brief Size of buffer for local data (owned and shared) used in
   /// forward and reverse communication.
   /// @return The required buffer size
@@ -572,27 +994,53 @@ public:
   /// Return a vector of local indices (owned) used to pack/unpack local
   /// data. These indices are grouped by neighbor process (process for
   /// which an index is a ghost).
-  const std::vector<std::int32_t>& local_indices() const noexcept
+  const std::vector<std::int32_t, allocator_type>&
+  local_indices() const noexcept
   {
     return _local_inds;
   }
 
   /// Return a vector of remote indices (ghosts) used to pack/unpack ghost
   /// data. These indices are grouped by neighbor process (ghost owners).
-  const std::vector<std::int32_t>& remote_indices() const noexcept
+  const std::vector<std::int32_t, allocator_type>&
+  remote_indices() const noexcept
   {
     return _remote_inds;
   }
 
+  /// @brief Runs of consecutive indices in Scatterer::local_indices.
+  ///
+  /// Owned indices that are shared with other processes are often
+  /// consecutive, e.g. after a cache-friendly renumbering, in which
+  /// case the data can be packed and unpacked with block copies (see
+  /// impl::pack_runs).
+  ///
+  /// @return Offsets of the runs (see impl::contiguous_runs). Empty if
+  /// the mean run length is too short for block copies to pay off.
+  std::span<const std::int32_t> local_runs() const noexcept
+  {
+    return _local_runs;
+  }
+
+  /// @brief Runs of consecutive indices in Scatterer::remote_indices.
+  /// See Scatterer::local_runs.
+  std::span<const std::int32_t> remote_runs() const noexcept
+  {
+    return _remote_runs;
+  }
+
   /// @brief The number values (block size) to send per index in the
   /// common::IndexMap use to create the scatterer
   /// @return The block size
   int bs() const noexcept { return _bs; }
 
   /// @brief Create a vector of MPI_Requests for a given Scatterer::type
+  /// @note Requests for Scatterer::type::persistent are bound to
+  /// buffers and are created by Scatterer::create_persistent_requests_fwd
+  /// and Scatterer::create_persistent_requests_rev.
   /// @return A vector of MPI requests
   std::vector<MPI_Request> create_request_vector(Scatterer::type type
-                                                 = type::neighbor)
+                                                 = type::neighbor) const
   {
     std::vector<MPI_Request> requests;
     switch (type)
@@ -601,14 +1049,341 @@ public:
       requests = {MPI_REQUEST_NULL};
       break;
     case type::p2p:
+    case type::shared:
       requests.resize(_dest.size() + _src.size(), MPI_REQUEST_NULL);
       break;
+    case type::persistent:
+      throw std::runtime_error(
+          "Persistent requests must be created using "
+          "Scatterer::create_persistent_requests_fwd/rev");
     default:
       throw std::runtime_error("Scatter::type not recognized");
     }
     return requests;
   }
 
+  /// @brief Create persistent MPI requests for a forward scatter
+  /// (owner to ghost) between fixed buffers.
+  ///
+  /// The requests are set up once, and each call to
+  /// Scatterer::scatter_fwd_begin with Scatterer::type::persistent
+  /// restarts them. The buffers must remain valid, and must not be
+  /// reallocated, for the lifetime of the requests. The caller owns the
+  /// requests and must release them using `MPI_Request_free` when they
+  /// are no longer required.
+  ///
+  /// @param[in] send_buffer Buffer for the packed owned data. Size is
+  /// Scatterer::local_buffer_size.
+  /// @param[in] recv_buffer Buffer for the received ghost data. Size is
+  /// Scatterer::remote_buffer_size.
+  /// @return Inactive persistent requests.
+  template <typename T>
+  std::vector<MPI_Request>
+  create_persistent_requests_fwd(std::span<const T> send_buffer,
+                                 std::span<T> recv_buffer) const
+  {
+    std::vector<MPI_Request> requests(_dest.size() + _src.size(),
+                                      MPI_REQUEST_NULL);
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return requests;
+
+    assert(send_buffer.size() == _local_inds.size());
+    assert(recv_buffer.size() == _remote_inds.size());
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Recv_init(recv_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_t<T>, _src[i], 0, _comm0.comm(),
+                    &requests[i]);
+    }
+
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Send_init(send_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_t<T>, _dest[i], 0, _comm0.comm(),
+                    &requests[i + _src.size()]);
+    }
+
+    return requests;
+  }
+
+  /// @brief Create persistent MPI requests for a reverse scatter (ghost
+  /// to owner) between fixed buffers.
+  ///
+  /// See Scatterer::create_persistent_requests_fwd for the lifetime
+  /// requirements.
+  ///
+  /// @param[in] send_buffer Buffer for the packed ghost data. Size is
+  /// Scatterer::remote_buffer_size.
+  /// @param[in] recv_buffer Buffer for the received owned data. Size is
+  /// Scatterer::local_buffer_size.
+  /// @return Inactive persistent requests.
+  template <typename T>
+  std::vector<MPI_Request>
+  create_persistent_requests_rev(std::span<const T> send_buffer,
+                                 std::span<T> recv_buffer) const
+  {
+    std::vector<MPI_Request> requests(_dest.size() + _src.size(),
+                                      MPI_REQUEST_NULL);
+    if (_sizes_local.empty() and _sizes_remote.empty())
+      return requests;
+
+    assert(send_buffer.size() == _remote_inds.size());
+    assert(recv_buffer.size() == _local_inds.size());
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      MPI_Recv_init(recv_buffer.data() + _displs_local[i], _sizes_local[i],
+                    dolfinx::MPI::mpi_t<T>, _dest[i], 1, _comm0.comm(),
+                    &requests[i]);
+    }
+
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      MPI_Send_init(send_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                    dolfinx::MPI::mpi_t<T>, _src[i], 1, _comm0.comm(),
+                    &requests[i + _dest.size()]);
+    }
+
+    return requests;
+  }
+
+  /// @brief Create a shared-memory window for scatters with
+  /// Scatterer::type::shared.
+  ///
+  /// The processes are grouped by shared-memory node
+  /// (`MPI_COMM_TYPE_SHARED`). Data sent to a process on the same node
+  /// is read by the receiver directly from the window segment of the
+  /// sender, and data sent to a process on another node is sent using
+  /// `MPI_Isend`/`MPI_Irecv`.
+  ///
+  /// @note Collective
+  ///
+  /// @tparam T Type of the scattered data.
+  /// @return The window.
+  template <typename T>
+  std::unique_ptr<ScatterWindow<T>> create_shared_window() const
+  {
+    const std::size_t size
+        = std::max(_local_inds.size(), _remote_inds.size());
+    if (_comm0.comm() == MPI_COMM_NULL)
+    {
+      // Serial: no communication
+      assert(size == 0);
+      return std::make_unique<ScatterWindow<T>>(
+          MPI_COMM_NULL, MPI_WIN_NULL, std::span<T>(),
+          std::vector<const T*>(), std::vector<const T*>());
+    }
+
+    MPI_Comm comm;
+    int ierr = MPI_Comm_split_type(_comm0.comm(), MPI_COMM_TYPE_SHARED, 0,
+                                   MPI_INFO_NULL, &comm);
+    dolfinx::MPI::check_error(_comm0.comm(), ierr);
+    T* base = nullptr;
+    MPI_Win win;
+    ierr = MPI_Win_allocate_shared(size * sizeof(T), sizeof(T), MPI_INFO_NULL,
+                                   comm, &base, &win);
+    dolfinx::MPI::check_error(_comm0.comm(), ierr);
+
+    // Rank on the node of each neighbour (MPI_UNDEFINED if not on the
+    // node)
+    auto node_ranks = [comm, comm0 = _comm0.comm()](std::span<const int> r)
+    {
+      MPI_Group group0, group;
+      MPI_Comm_group(comm0, &group0);
+      MPI_Comm_group(comm, &group);
+      std::vector<int> ranks(r.size());
+      MPI_Group_translate_ranks(group0, r.size(), r.data(), group,
+                                ranks.data());
+      MPI_Group_free(&group0);
+      MPI_Group_free(&group);
+      return ranks;
+    };
+    const std::vector<int> src_node = node_ranks(_src);
+    const std::vector<int> dest_node = node_ranks(_dest);
+
+    // Receive the position in the send buffer of each neighbour of the
+    // data sent to the caller, for forward and reverse scatters
+    std::vector<int> src_offsets(_src.size()), dest_offsets(_dest.size());
+    ierr = MPI_Neighbor_alltoall(_displs_local.data(), 1, MPI_INT,
+                                 src_offsets.data(), 1, MPI_INT,
+                                 _comm0.comm());
+    dolfinx::MPI::check_error(_comm0.comm(), ierr);
+    ierr = MPI_Neighbor_alltoall(_displs_remote.data(), 1, MPI_INT,
+                                 dest_offsets.data(), 1, MPI_INT,
+                                 _comm1.comm());
+    dolfinx::MPI::check_error(_comm0.comm(), ierr);
+
+    auto location = [win](int rank, int offset) -> const T*
+    {
+      if (rank == MPI_UNDEFINED)
+        return nullptr;
+      MPI_Aint size;
+      int disp_unit;
+      T* ptr = nullptr;
+      MPI_Win_shared_query(win, rank, &size, &disp_unit, &ptr);
+      return ptr + offset;
+    };
+    std::vector<const T*> src_fwd(_src.size()), dest_rev(_dest.size());
+    for (std::size_t i = 0; i < _src.size(); ++i)
+      src_fwd[i] = location(src_node[i], src_offsets[i]);
+    for (std::size_t i = 0; i < _dest.size(); ++i)
+      dest_rev[i] = location(dest_node[i], dest_offsets[i]);
+
+    return std::make_unique<ScatterWindow<T>>(comm, win,
+                                              std::span<T>(base, size),
+                                              std::move(src_fwd),
+                                              std::move(dest_rev));
+  }
+
+  /// @brief Start a forward scatter using a shared-memory window.
+  ///
+  /// The owned data to send must have been packed into
+  /// ScatterWindow::buffer (in the layout given by
+  /// Scatterer::local_indices). Data from processes on the same node is
+  /// copied into `recv_buffer` by this function, and the communication
+  /// with other nodes is completed by Scatterer::scatter_fwd_end.
+  ///
+  /// @note Collective on the processes of a node, i.e. all processes on
+  /// a node must call this function with the window.
+  ///
+  /// @param[in] window Window created by
+  /// Scatterer::create_shared_window.
+  /// @param[out] recv_buffer Buffer for the received data. The position
+  /// of ghost entries in the buffer is given by
+  /// Scatterer::remote_indices.
+  /// @param[in] requests Requests, created by
+  /// Scatterer::create_request_vector with Scatterer::type::shared.
+  template <typename T>
+  void scatter_fwd_begin(const ScatterWindow<T>& window,
+                         std::span<T> recv_buffer,
+                         std::span<MPI_Request> requests) const
+  {
+    if (window.window() == MPI_WIN_NULL)
+      return;
+    assert(requests.size() == _dest.size() + _src.size());
+
+    // Make packed data of all processes on the node visible
+    MPI_Win_fence(0, window.window());
+    std::span<const T* const> src_fwd = window.src_fwd();
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      if (src_fwd[i])
+      {
+        std::copy_n(src_fwd[i], _sizes_remote[i],
+                    recv_buffer.data() + _displs_remote[i]);
+      }
+      else
+      {
+        MPI_Irecv(recv_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                  dolfinx::MPI::mpi_t<T>, _src[i], 0, _comm0.comm(),
+                  &requests[i]);
+      }
+    }
+
+    std::span<const T* const> dest_rev = window.dest_rev();
+    std::span<const T> send_buffer = window.buffer();
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      // A destination rank is on the node if it can read from the
+      // caller's segment
+      if (!dest_rev[i])
+      {
+        MPI_Isend(send_buffer.data() + _displs_local[i], _sizes_local[i],
+                  dolfinx::MPI::mpi_t<T>, _dest[i], 0, _comm0.comm(),
+                  &requests[i + _src.size()]);
+      }
+    }
+  }
+
+  /// @brief Complete a forward scatter started by
+  /// Scatterer::scatter_fwd_begin with a shared-memory window.
+  ///
+  /// After this call the window buffer can be re-used.
+  ///
+  /// @note Collective on the processes of a node.
+  ///
+  /// @param[in] window Window passed to Scatterer::scatter_fwd_begin.
+  /// @param[in] requests Requests passed to Scatterer::scatter_fwd_begin.
+  template <typename T>
+  void scatter_fwd_end(const ScatterWindow<T>& window,
+                       std::span<MPI_Request> requests) const
+  {
+    if (window.window() == MPI_WIN_NULL)
+      return;
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUS_IGNORE);
+
+    // Wait for processes on the node to complete reading
+    MPI_Win_fence(0, window.window());
+  }
+
+  /// @brief Start a reverse scatter using a shared-memory window.
+  ///
+  /// The ghost data to send must have been packed into
+  /// ScatterWindow::buffer (in the layout given by
+  /// Scatterer::remote_indices). See the forward version of
+  /// Scatterer::scatter_fwd_begin for a shared-memory window.
+  ///
+  /// @note Collective on the processes of a node.
+  ///
+  /// @param[in] window Window created by
+  /// Scatterer::create_shared_window.
+  /// @param[out] recv_buffer Buffer for the received data. The position
+  /// of the entries for owned indices is given by
+  /// Scatterer::local_indices.
+  /// @param[in] requests Requests, created by
+  /// Scatterer::create_request_vector with Scatterer::type::shared.
+  template <typename T>
+  void scatter_rev_begin(const ScatterWindow<T>& window,
+                         std::span<T> recv_buffer,
+                         std::span<MPI_Request> requests) const
+  {
+    if (window.window() == MPI_WIN_NULL)
+      return;
+    assert(requests.size() == _dest.size() + _src.size());
+
+    MPI_Win_fence(0, window.window());
+    std::span<const T* const> dest_rev = window.dest_rev();
+    for (std::size_t i = 0; i < _dest.size(); i++)
+    {
+      if (dest_rev[i])
+      {
+        std::copy_n(dest_rev[i], _sizes_local[i],
+                    recv_buffer.data() + _displs_local[i]);
+      }
+      else
+      {
+        MPI_Irecv(recv_buffer.data() + _displs_local[i], _sizes_local[i],
+                  dolfinx::MPI::mpi_t<T>, _dest[i], MPI_ANY_TAG,
+                  _comm0.comm(), &requests[i]);
+      }
+    }
+
+    std::span<const T* const> src_fwd = window.src_fwd();
+    std::span<const T> send_buffer = window.buffer();
+    for (std::size_t i = 0; i < _src.size(); i++)
+    {
+      if (!src_fwd[i])
+      {
+        MPI_Isend(send_buffer.data() + _displs_remote[i], _sizes_remote[i],
+                  dolfinx::MPI::mpi_t<T>, _src[i], 0, _comm0.comm(),
+                  &requests[i + _dest.size()]);
+      }
+    }
+  }
+
+  /// @brief Complete a reverse scatter started by
+  /// Scatterer::scatter_rev_begin with a shared-memory window.
+  ///
+  /// @note Collective on the processes of a node.
+  ///
+  /// @param[in] window Window passed to Scatterer::scatter_rev_begin.
+  /// @param[in] requests Requests passed to Scatterer::scatter_rev_begin.
+  template <typename T>
+  void scatter_rev_end(const ScatterWindow<T>& window,
+                       std::span<MPI_Request> requests) const
+  {
+    scatter_fwd_end(window, requests);
+  }
+
 private:
   // Block size
   int _bs;
@@ -641,6 +1416,10 @@ private:
   // grouped by neighbor process.
   std::vector<std::int32_t, allocator_type> _local_inds;
 
+  // Runs of consecutive indices in _remote_inds and _local_inds
+  // (empty if not used)
+  std::vector<std::int32_t> _remote_runs, _local_runs;
+
   // Number of local shared indices per neighbor process
   std::vector<int> _sizes_local;
 
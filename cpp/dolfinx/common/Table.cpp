@@ -6,10 +6,14 @@
 
 #include "Table.h"
 #include "MPI.h"
+#include "json.h"
 #include <array>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <sstream>
 #include <variant>
 
 namespace
@@ -213,7 +217,10 @@ std::string Table::str() const
     col_sizes[0] = std::max(col_sizes[0], _rows[i].size());
     for (std::size_t j = 0; j < _cols.size(); j++)
     {
-      const std::string value = to_str(get(_rows[i], _cols[j]));
+      // Missing entries, e.g. hardware counters for a task without
+      // recorded counters, are left blank
+      auto it = _values.find({_rows[i], _cols[j]});
+      const std::string value = it == _values.end() ? "" : to_str(it->second);
       tvalues[i].push_back(value);
       col_sizes[j + 1] = std::max(col_sizes[j + 1], value.size());
     }
@@ -280,3 +287,34 @@ std::string Table::str() const
   return s.str();
 }
 //-----------------------------------------------------------------------------
+std::string Table::json() const
+{
+  std::stringstream s;
+  s << std::setprecision(std::numeric_limits<double>::max_digits10);
+  s << "{";
+  for (std::size_t i = 0; i < _rows.size(); ++i)
+  {
+    s << (i == 0 ? "" : ", ") << common::json_quote(_rows[i]) << ": {";
+    bool first = true;
+    for (const std::string& col : _cols)
+    {
+      auto it = _values.find({_rows[i], col});
+      if (it == _values.end())
+        continue;
+
+      s << (first ? "" : ", ") << common::json_quote(col) << ": ";
+      first = false;
+      if (std::holds_alternative<int>(it->second))
+        s << std::get<int>(it->second);
+      else if (std::holds_alternative<double>(it->second))
+        common::json_number(s, std::get<double>(it->second));
+      else
+        s << common::json_quote(std::get<std::string>(it->second));
+    }
+    s << "}";
+  }
+  s << "}";
+
+  return s.str();
+}
+//-----------------------------------------------------------------------------
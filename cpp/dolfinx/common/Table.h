@@ -80,6 +80,15 @@ public:
   /// Return string representation of the table
   std::string str() const;
 
+  /// @brief Return JSON representation of the table.
+  ///
+  /// The table is represented as an object with a member for each row,
+  /// which is an object with a member for each column that has a value
+  /// in the row, e.g. `{"Foo": {"Assemble": 0.01, "Solve": 0.02}}`. The
+  /// table name is not included. Non-finite values are written as
+  /// `null`.
+  std::string json() const;
+
 private:
   // Row and column names
   std::vector<std::string> _rows, _cols;
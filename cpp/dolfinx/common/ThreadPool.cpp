@@ -0,0 +1,219 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+// True on a thread that is executing a task
+thread_local bool in_task = false;
+
+std::mutex pool_mutex;
+std::unique_ptr<ThreadPool> pool;
+int pool_size = std::max<int>(std::thread::hardware_concurrency(), 1);
+} // namespace
+
+//-----------------------------------------------------------------------------
+struct ThreadPool::Job
+{
+  Job(int num_tasks, const std::function<void(int)>& fn)
+      : num_tasks(num_tasks), fn(fn), errors(num_tasks)
+  {
+  }
+
+  // Claim and execute tasks until none are left. Returns true if the
+  // last task was completed by the caller.
+  bool execute()
+  {
+    bool last = false;
+    in_task = true;
+    for (int t = next++; t < num_tasks; t = next++)
+    {
+      try
+      {
+        fn(t);
+      }
+      catch (...)
+      {
+        errors[t] = std::current_exception();
+      }
+      last = ++num_done == num_tasks;
+    }
+    in_task = false;
+    return last;
+  }
+
+  const int num_tasks;
+  const std::function<void(int)>& fn;
+  std::vector<std::exception_ptr> errors;
+  std::atomic<int> next = 0;
+  std::atomic<int> num_done = 0;
+};
+//-----------------------------------------------------------------------------
+ThreadPool::ThreadPool(int num_threads) : _size(num_threads)
+{
+  if (num_threads < 1)
+    throw std::runtime_error("Number of threads must be at least 1.");
+}
+//-----------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+  {
+    std::scoped_lock lock(_mutex);
+    _stop = true;
+  }
+  _cv.notify_all();
+  for (std::thread& w : _workers)
+    w.join();
+  if (_background.joinable())
+    _background.join();
+}
+//-----------------------------------------------------------------------------
+int ThreadPool::size() const { return _size; }
+//-----------------------------------------------------------------------------
+void ThreadPool::run(int num_tasks, const std::function<void(int)>& fn)
+{
+  if (num_tasks < 1)
+    return;
+
+  // Execute on the calling thread if there is no parallelism, or if the
+  // pool is busy (e.g. nested calls)
+  std::unique_lock run_lock(_run_mutex, std::defer_lock);
+  if (num_tasks == 1 or _size == 1 or in_task or !run_lock.try_lock())
+  {
+    Job job(num_tasks, fn);
+    job.execute();
+    for (std::exception_ptr& e : job.errors)
+    {
+      if (e)
+        std::rethrow_exception(e);
+    }
+    return;
+  }
+
+  start_workers(num_tasks);
+  auto job = std::make_shared<Job>(num_tasks, fn);
+  {
+    std::scoped_lock lock(_mutex);
+    _job = job;
+    ++_generation;
+  }
+  _cv.notify_all();
+
+  // Execute tasks on this thread, and wait for the workers to complete
+  // their tasks
+  job->execute();
+  {
+    std::unique_lock lock(_mutex);
+    _done.wait(lock, [&job]() { return job->num_done == job->num_tasks; });
+    _job.reset();
+  }
+
+  for (std::exception_ptr& e : job->errors)
+  {
+    if (e)
+      std::rethrow_exception(e);
+  }
+}
+//-----------------------------------------------------------------------------
+std::future<void> ThreadPool::submit(std::function<void()> fn)
+{
+  std::packaged_task<void()> task(std::move(fn));
+  std::future<void> future = task.get_future();
+  {
+    std::scoped_lock lock(_mutex);
+    _queue.push_back(std::move(task));
+    if (!_background.joinable())
+    {
+      _background = std::thread(
+          [this]()
+          {
+            // Functions are treated as tasks, such that nested calls to
+            // run execute on this thread
+            in_task = true;
+            while (true)
+            {
+              std::packaged_task<void()> task;
+              {
+                std::unique_lock lock(_mutex);
+                _cv.wait(lock, [this]() { return _stop or !_queue.empty(); });
+                if (_queue.empty())
+                  return;
+                task = std::move(_queue.front());
+                _queue.pop_front();
+              }
+              task();
+            }
+          });
+    }
+  }
+  _cv.notify_all();
+  return future;
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::start_workers(int num_tasks)
+{
+  const std::size_t num_workers = std::min(num_tasks, _size) - 1;
+  while (_workers.size() < num_workers)
+    _workers.emplace_back([this]() { work(); });
+}
+//-----------------------------------------------------------------------------
+void ThreadPool::work()
+{
+  std::size_t generation = 0;
+  while (true)
+  {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock lock(_mutex);
+      _cv.wait(lock, [this, generation]()
+               { return _stop or (_job and _generation != generation); });
+      if (_stop)
+        return;
+      generation = _generation;
+      job = _job;
+    }
+
+    if (job->execute())
+    {
+      // Lock so that the notification is not lost if the calling thread
+      // is about to wait
+      std::scoped_lock lock(_mutex);
+      _done.notify_all();
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+ThreadPool& common::thread_pool()
+{
+  std::scoped_lock lock(pool_mutex);
+  if (!pool)
+    pool = std::make_unique<ThreadPool>(pool_size);
+  return *pool;
+}
+//-----------------------------------------------------------------------------
+void common::set_num_threads(int num_threads)
+{
+  if (num_threads < 1)
+    throw std::runtime_error("Number of threads must be at least 1.");
+  std::scoped_lock lock(pool_mutex);
+  pool_size = num_threads;
+  pool.reset();
+}
+//-----------------------------------------------------------------------------
+int common::num_threads()
+{
+  std::scoped_lock lock(pool_mutex);
+  return pool_size;
+}
+//-----------------------------------------------------------------------------
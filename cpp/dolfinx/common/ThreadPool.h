@@ -0,0 +1,142 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @file ThreadPool.h
+/// @brief Pool of worker threads for shared-memory parallelism on a
+/// process.
+///
+/// Functions that use threads (e.g. dolfinx::sort_by_perm and
+/// mesh::compute_entities) execute their tasks on the process thread
+/// pool, see common::thread_pool. The number of threads that execute
+/// tasks concurrently is bounded by the size of the pool, which is set
+/// by common::set_num_threads, so that concurrent use of threads does
+/// not oversubscribe the cores of a process.
+///
+/// Tasks must not call MPI functions. Only the thread that calls
+/// ThreadPool::run, which is usually the main thread, communicates.
+/// This makes the pool safe with `MPI_THREAD_FUNNELED`.
+
+namespace dolfinx::common
+{
+/// @brief Fixed-size pool of worker threads for fork-join execution of
+/// tasks.
+///
+/// The worker threads are started on first use. The thread that calls
+/// ThreadPool::run also executes tasks.
+class ThreadPool
+{
+public:
+  /// @brief Create a thread pool.
+  /// @param[in] num_threads Maximum number of threads that execute
+  /// tasks concurrently, including the calling thread. Must be at least
+  /// 1.
+  explicit ThreadPool(int num_threads);
+
+  // Copy constructor (deleted)
+  ThreadPool(const ThreadPool&) = delete;
+
+  // Assignment operator (deleted)
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Destructor. Stops and joins the worker threads.
+  ~ThreadPool();
+
+  /// Maximum number of threads that execute tasks concurrently,
+  /// including the calling thread
+  int size() const;
+
+  /// @brief Execute `fn(t)` for each task index `t` in `[0, num_tasks)`
+  /// and wait for all tasks to complete.
+  ///
+  /// Tasks are executed by at most ThreadPool::size threads, in no
+  /// particular order. If called from within a task, or while another
+  /// thread is executing tasks on the pool, the tasks are executed on
+  /// the calling thread. If tasks throw an exception, the exception of
+  /// the task with the lowest index is re-thrown on the calling thread
+  /// once all tasks have completed.
+  ///
+  /// @param[in] num_tasks Number of tasks.
+  /// @param[in] fn Function to execute for each task index.
+  void run(int num_tasks, const std::function<void(int)>& fn);
+
+  /// @brief Execute `fn` asynchronously.
+  ///
+  /// Submitted functions are executed in order of submission on a
+  /// background thread of the pool, which is started on first use. A
+  /// function that calls ThreadPool::run executes the tasks on the
+  /// background thread, so that it does not compete with the calling
+  /// thread for the workers. Exceptions are stored in the returned
+  /// future.
+  ///
+  /// @param[in] fn Function to execute. It must not call MPI functions.
+  /// @return Future that is ready when `fn` has completed.
+  std::future<void> submit(std::function<void()> fn);
+
+private:
+  // Tasks of a call to ThreadPool::run
+  struct Job;
+
+  // Start the workers to execute up to num_tasks tasks concurrently
+  void start_workers(int num_tasks);
+
+  // Worker thread loop
+  void work();
+
+  int _size;
+
+  // Guards _job, _generation and _stop, and is used with _cv and
+  // _done to signal workers and the calling thread
+  std::mutex _mutex;
+  std::condition_variable _cv, _done;
+  std::shared_ptr<Job> _job;
+  std::size_t _generation = 0;
+  bool _stop = false;
+
+  // Serialises calls to ThreadPool::run from different threads
+  std::mutex _run_mutex;
+
+  std::vector<std::thread> _workers;
+
+  // Submitted functions, guarded by _mutex, and the background thread
+  // that executes them
+  std::deque<std::packaged_task<void()>> _queue;
+  std::thread _background;
+};
+
+/// @brief The thread pool of the process.
+///
+/// The pool is created on first use, with the size set by
+/// common::set_num_threads (default
+/// `std::thread::hardware_concurrency()`).
+ThreadPool& thread_pool();
+
+/// @brief Set the maximum number of threads used on this process.
+///
+/// Replaces the process thread pool. Must not be called while the pool
+/// is executing tasks. When running several MPI processes per node, set
+/// the number of threads such that the product of the processes and
+/// threads per node does not exceed the number of cores.
+///
+/// @param[in] num_threads Number of threads, including the calling
+/// thread. Must be at least 1.
+void set_num_threads(int num_threads);
+
+/// @brief Maximum number of threads used on this process, see
+/// common::set_num_threads.
+int num_threads();
+
+} // namespace dolfinx::common
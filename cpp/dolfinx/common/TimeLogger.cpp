@@ -21,14 +21,16 @@ TimeLogger& TimeLogger::instance()
 
 //-----------------------------------------------------------------------------
 void TimeLogger::register_timing(
-    std::string task, std::chrono::duration<double, std::ratio<1>> time)
+    std::string task, std::chrono::duration<double, std::ratio<1>> time,
+    std::optional<HardwareCounters> counters)
 {
   // Print a message
   std::string line
       = "Elapsed time: " + std::to_string(time.count()) + " (" + task + ")";
-  spdlog::debug(line.c_str());
+  DOLFINX_LOG_DEBUG(line.c_str());
 
   // Store values for summary
+  std::scoped_lock lock(_mutex);
   if (auto it = _timings.find(task); it != _timings.end())
   {
     std::get<0>(it->second) += 1;
@@ -36,6 +38,13 @@ void TimeLogger::register_timing(
   }
   else
     _timings.insert({task, {1, time}});
+
+  if (counters)
+  {
+    auto [it, inserted] = _counters.insert({task, HardwareCounters{}});
+    for (std::size_t i = 0; i < counters->size(); ++i)
+      it->second[i] += (*counters)[i];
+  }
 }
 //-----------------------------------------------------------------------------
 void TimeLogger::list_timings(MPI_Comm comm, Table::Reduction reduction) const
@@ -54,6 +63,7 @@ Table TimeLogger::timing_table() const
 {
   // Generate log::timing table
   Table table("Summary of timings (s)");
+  std::scoped_lock lock(_mutex);
   for (auto& it : _timings)
   {
     std::string task = it.first;
@@ -61,6 +71,16 @@ Table TimeLogger::timing_table() const
     table.set(task, "reps", num_timings);
     table.set(task, "avg", time.count() / static_cast<double>(num_timings));
     table.set(task, "tot", time.count());
+    if (auto c = _counters.find(task); c != _counters.end())
+    {
+      // Stored as double values so that they are reduced across
+      // processes by Table::reduce
+      for (std::size_t i = 0; i < c->second.size(); ++i)
+      {
+        table.set(task, std::string(hardware_counter_names[i]),
+                  static_cast<double>(c->second[i]));
+      }
+    }
   }
 
   return table;
@@ -70,6 +90,7 @@ std::pair<int, std::chrono::duration<double, std::ratio<1>>>
 TimeLogger::timing(std::string task) const
 {
   // Find timing
+  std::scoped_lock lock(_mutex);
   auto it = _timings.find(task);
   if (it == _timings.end())
   {
@@ -84,6 +105,17 @@ std::map<std::string,
          std::pair<int, std::chrono::duration<double, std::ratio<1>>>>
 TimeLogger::timings() const
 {
+  std::scoped_lock lock(_mutex);
   return _timings;
 }
 //-----------------------------------------------------------------------------
+std::optional<HardwareCounters>
+TimeLogger::hardware_counters(std::string task) const
+{
+  std::scoped_lock lock(_mutex);
+  if (auto it = _counters.find(task); it != _counters.end())
+    return it->second;
+  else
+    return std::nullopt;
+}
+//-----------------------------------------------------------------------------
@@ -7,10 +7,13 @@
 #pragma once
 
 #include "Table.h"
+#include "hardware_counters.h"
 #include "timing.h"
 #include <chrono>
 #include <map>
 #include <mpi.h>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -19,7 +22,8 @@ namespace dolfinx::common
 /// @brief Time logger maintaining data collected by Timer, if registered.
 ///
 /// @note This is a monotstate, i.e. the data members are static and thus
-/// timings are aggregated into a single map.
+/// timings are aggregated into a single map. Timings may be registered
+/// and queried concurrently from several threads.
 class TimeLogger
 {
 public:
@@ -27,11 +31,20 @@ public:
   /// @return Unique time logger object.
   static TimeLogger& instance();
 
-  /// Register timing (for later summary)
+  /// @brief Register timing (for later summary).
+  /// @param[in] task Task name.
+  /// @param[in] wall Elapsed wall time.
+  /// @param[in] counters Change in the hardware counters, if recorded.
   void register_timing(std::string task,
-                       std::chrono::duration<double, std::ratio<1>> wall);
+                       std::chrono::duration<double, std::ratio<1>> wall,
+                       std::optional<HardwareCounters> counters
+                       = std::nullopt);
 
-  /// Return a summary of timings and tasks in a Table
+  /// @brief Return a summary of timings and tasks in a Table.
+  ///
+  /// Totals of the hardware counters (see
+  /// common::enable_hardware_counters) are added as columns for tasks
+  /// with recorded counters.
   Table timing_table() const;
 
   /// List a summary of timings and tasks. Reduction type is
@@ -52,6 +65,12 @@ public:
            std::pair<int, std::chrono::duration<double, std::ratio<1>>>>
   timings() const;
 
+  /// @brief Total of the recorded hardware counters for a task.
+  /// @param[in] task The task name.
+  /// @return Counter totals, or `std::nullopt` if no counters have been
+  /// recorded for the task.
+  std::optional<HardwareCounters> hardware_counters(std::string task) const;
+
 private:
   /// Constructor
   TimeLogger() = default;
@@ -70,5 +89,11 @@ private:
   std::map<std::string,
            std::pair<int, std::chrono::duration<double, std::ratio<1>>>>
       _timings;
+
+  // Total hardware counters for tasks with recorded counters
+  std::map<std::string, HardwareCounters> _counters;
+
+  // Lock for the timings and counters
+  mutable std::mutex _mutex;
 };
 } // namespace dolfinx::common
@@ -13,6 +13,7 @@
 #include <string>
 
 #include "TimeLogger.h"
+#include "hardware_counters.h"
 
 namespace dolfinx::common
 {
@@ -36,6 +37,10 @@ namespace dolfinx::common
 /// \endcode
 /// Registered elapsed times are logged when (1) the timer goes
 /// out-of-scope or (2) Timer::flush() is called.
+///
+/// If enabled (see common::enable_hardware_counters), the change in the
+/// hardware performance counters of the calling thread while the timer
+/// is running is also recorded and registered with the elapsed time.
 template <typename T = std::chrono::high_resolution_clock>
 class Timer
 {
@@ -57,7 +62,8 @@ public:
     if (_start_time.has_value() and _task.has_value())
     {
       _acc += T::now() - *_start_time;
-      TimeLogger::instance().register_timing(*_task, _acc);
+      add_counters();
+      TimeLogger::instance().register_timing(*_task, _acc, _counters_acc);
     }
   }
 
@@ -65,6 +71,8 @@ public:
   void start()
   {
     _acc = T::duration::zero();
+    _counters_acc = std::nullopt;
+    _counters_start = read_hardware_counters();
     _start_time = T::now();
   }
 
@@ -94,6 +102,7 @@ public:
     {
       _acc += T::now() - *_start_time;
       _start_time = std::nullopt;
+      add_counters();
     }
 
     return _acc;
@@ -105,9 +114,22 @@ public:
   void resume()
   {
     if (!_start_time.has_value())
+    {
+      _counters_start = read_hardware_counters();
       _start_time = T::now();
+    }
   }
 
+  /// @brief Change in the hardware counters while the timer was
+  /// running.
+  ///
+  /// If the timer is running, changes up to the last time the timer was
+  /// stopped are returned.
+  ///
+  /// @return Counter values, or `std::nullopt` if the counters were not
+  /// recorded.
+  std::optional<HardwareCounters> counters() const { return _counters_acc; }
+
   /// @brief Flush timer duration to the logger.
   ///
   /// An instance of a timer can be flushed to the logger only once.
@@ -122,18 +144,43 @@ public:
 
     if (_task.has_value())
     {
-      TimeLogger::instance().register_timing(*_task, _acc);
+      TimeLogger::instance().register_timing(*_task, _acc, _counters_acc);
       _task = std::nullopt;
     }
   }
 
 private:
+  // Add the change in the hardware counters since the timer was
+  // (re-)started
+  void add_counters()
+  {
+    if (!_counters_start)
+      return;
+    if (std::optional<HardwareCounters> c = read_hardware_counters(); c)
+    {
+      if (!_counters_acc)
+        _counters_acc = HardwareCounters{};
+      for (std::size_t i = 0; i < c->size(); ++i)
+        (*_counters_acc)[i] += (*c)[i] - (*_counters_start)[i];
+    }
+    _counters_start = std::nullopt;
+  }
+
   // Name of task to register in logger
   std::optional<std::string> _task;
 
   // Elapsed time offset
   T::duration _acc = T::duration::zero();
 
+  // Accumulated change in the hardware counters (std::nullopt if not
+  // recorded)
+  std::optional<HardwareCounters> _counters_acc;
+
+  // Hardware counters at start (std::nullopt if not recorded or the
+  // timer has been stopped). Read before the start time so that the
+  // timed region does not include reading the counters.
+  std::optional<HardwareCounters> _counters_start = read_hardware_counters();
+
   // Store start time (std::nullopt if timer has been stopped)
   std::optional<typename T::time_point> _start_time = T::now();
 };
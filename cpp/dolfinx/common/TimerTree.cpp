@@ -0,0 +1,320 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "TimerTree.h"
+#include "MPI.h"
+#include "json.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+/// Timed region in the tree of a thread
+struct Node
+{
+  std::string name;
+  std::int32_t parent;
+  std::vector<std::int32_t> children;
+  std::int64_t count = 0;
+  double total = 0;
+};
+
+/// A completed timed region, for tracing
+struct Event
+{
+  std::int32_t node;
+  double start;
+  double duration;
+};
+
+/// Timer tree of a thread. Only the owning thread modifies the tree
+/// while timing.
+struct ThreadProfile
+{
+  // Nodes, with the (unnamed) root at index 0
+  std::vector<Node> nodes{Node{"", -1, {}, 0, 0}};
+
+  // Innermost active region
+  std::int32_t current = 0;
+
+  // Recorded events
+  std::vector<Event> events;
+};
+
+// Separator of names in the path of a region
+constexpr char separator = '\x1f';
+
+// Profiles of all threads that have timed a region. Profiles are not
+// freed when a thread exits so that its timings are retained.
+std::mutex profiles_mutex;
+std::vector<std::unique_ptr<ThreadProfile>> profiles;
+
+std::atomic<bool> trace_enabled = false;
+
+// Reference time for events
+const std::chrono::steady_clock::time_point epoch
+    = std::chrono::steady_clock::now();
+
+/// Profile of the calling thread
+ThreadProfile& thread_profile()
+{
+  thread_local ThreadProfile* profile = nullptr;
+  if (!profile)
+  {
+    std::scoped_lock lock(profiles_mutex);
+    profiles.push_back(std::make_unique<ThreadProfile>());
+    profile = profiles.back().get();
+  }
+  return *profile;
+}
+
+/// Path of a node, i.e. the names from the root separated by
+/// `separator`
+std::string path(const ThreadProfile& p, std::int32_t node)
+{
+  std::string s = p.nodes[node].name;
+  for (std::int32_t n = p.nodes[node].parent; n > 0; n = p.nodes[n].parent)
+    s = p.nodes[n].name + separator + s;
+  return s;
+}
+
+void write_json(std::stringstream& s, const TimerTreeNode& node)
+{
+  s << "{\"name\": " << json_quote(node.name)
+    << ", \"count\": " << node.count << ", \"min\": ";
+  json_number(s, node.min);
+  s << ", \"max\": ";
+  json_number(s, node.max);
+  s << ", \"avg\": ";
+  json_number(s, node.avg);
+  s << ", \"children\": [";
+  for (std::size_t i = 0; i < node.children.size(); ++i)
+  {
+    s << (i == 0 ? "" : ", ");
+    write_json(s, node.children[i]);
+  }
+  s << "]}";
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+ScopedTimer::ScopedTimer(std::string_view name)
+{
+  ThreadProfile& p = thread_profile();
+  const std::vector<std::int32_t>& children = p.nodes[p.current].children;
+  auto it = std::ranges::find_if(children, [&p, name](auto c)
+                                 { return p.nodes[c].name == name; });
+  if (it != children.end())
+    _node = *it;
+  else
+  {
+    _node = p.nodes.size();
+    p.nodes.push_back(Node{std::string(name), p.current, {}, 0, 0});
+    p.nodes[p.current].children.push_back(_node);
+  }
+  p.current = _node;
+  _start = std::chrono::steady_clock::now();
+}
+//-----------------------------------------------------------------------------
+ScopedTimer::~ScopedTimer()
+{
+  const auto end = std::chrono::steady_clock::now();
+  const double elapsed = std::chrono::duration<double>(end - _start).count();
+  ThreadProfile& p = thread_profile();
+  Node& node = p.nodes[_node];
+  node.count += 1;
+  node.total += elapsed;
+  p.current = node.parent;
+  if (trace_enabled.load(std::memory_order_relaxed))
+  {
+    p.events.push_back(
+        {_node, std::chrono::duration<double>(_start - epoch).count(),
+         elapsed});
+  }
+}
+//-----------------------------------------------------------------------------
+TimerTreeNode common::timer_tree(MPI_Comm comm)
+{
+  // Merge the trees of the threads on this process, by path
+  std::map<std::string, std::pair<std::int64_t, double>> local;
+  {
+    std::scoped_lock lock(profiles_mutex);
+    for (auto& p : profiles)
+    {
+      for (std::size_t n = 1; n < p->nodes.size(); ++n)
+      {
+        auto& [count, total] = local[path(*p, n)];
+        count += p->nodes[n].count;
+        total += p->nodes[n].total;
+      }
+    }
+  }
+
+  // Pack data. Paths are separated by '\0'.
+  std::string paths;
+  std::vector<std::int64_t> counts;
+  std::vector<double> totals;
+  for (auto& [key, value] : local)
+  {
+    paths += key;
+    paths += '\0';
+    counts.push_back(value.first);
+    totals.push_back(value.second);
+  }
+
+  // Gather data from all processes
+  const int size = dolfinx::MPI::size(comm);
+  std::array<int, 2> sizes_local
+      = {static_cast<int>(paths.size()), static_cast<int>(counts.size())};
+  std::vector<int> sizes(2 * size);
+  MPI_Allgather(sizes_local.data(), 2, MPI_INT, sizes.data(), 2, MPI_INT,
+                comm);
+  std::vector<int> psizes(size), nsizes(size);
+  for (int r = 0; r < size; ++r)
+  {
+    psizes[r] = sizes[2 * r];
+    nsizes[r] = sizes[2 * r + 1];
+  }
+  std::vector<int> poffsets(size + 1, 0), noffsets(size + 1, 0);
+  std::partial_sum(psizes.begin(), psizes.end(), std::next(poffsets.begin()));
+  std::partial_sum(nsizes.begin(), nsizes.end(), std::next(noffsets.begin()));
+
+  std::string paths_all(poffsets.back(), '\0');
+  std::vector<std::int64_t> counts_all(noffsets.back());
+  std::vector<double> totals_all(noffsets.back());
+  MPI_Allgatherv(paths.data(), paths.size(), MPI_CHAR, paths_all.data(),
+                 psizes.data(), poffsets.data(), MPI_CHAR, comm);
+  MPI_Allgatherv(counts.data(), counts.size(), MPI_INT64_T, counts_all.data(),
+                 nsizes.data(), noffsets.data(), MPI_INT64_T, comm);
+  MPI_Allgatherv(totals.data(), totals.size(), MPI_DOUBLE, totals_all.data(),
+                 nsizes.data(), noffsets.data(), MPI_DOUBLE, comm);
+
+  // Reduce by path: (count, min, max, sum, number of processes)
+  struct Stats
+  {
+    std::int64_t count = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = 0;
+    double sum = 0;
+    int num_procs = 0;
+  };
+  std::map<std::string, Stats> global;
+  {
+    std::stringstream s(paths_all);
+    std::string key;
+    for (std::size_t i = 0; std::getline(s, key, '\0'); ++i)
+    {
+      Stats& stats = global[key];
+      stats.count += counts_all[i];
+      stats.min = std::min(stats.min, totals_all[i]);
+      stats.max = std::max(stats.max, totals_all[i]);
+      stats.sum += totals_all[i];
+      stats.num_procs += 1;
+    }
+  }
+
+  // Build the tree. A parent path precedes the paths of its children in
+  // the map.
+  TimerTreeNode root;
+  for (auto& [key, stats] : global)
+  {
+    TimerTreeNode* node = &root;
+    std::stringstream s(key);
+    std::string name;
+    while (std::getline(s, name, separator))
+    {
+      auto it = std::ranges::find_if(node->children, [&name](auto& c)
+                                     { return c.name == name; });
+      if (it == node->children.end())
+      {
+        node->children.push_back(TimerTreeNode{name, 0, 0, 0, 0, {}});
+        node = &node->children.back();
+      }
+      else
+        node = &*it;
+    }
+
+    // Processes that did not time the region contribute zero time
+    node->count = stats.count;
+    node->min = stats.num_procs < size ? 0 : stats.min;
+    node->max = stats.max;
+    node->avg = stats.sum / size;
+  }
+
+  return root;
+}
+//-----------------------------------------------------------------------------
+std::string common::timer_tree_json(MPI_Comm comm)
+{
+  TimerTreeNode root = common::timer_tree(comm);
+  std::stringstream s;
+  s << std::setprecision(std::numeric_limits<double>::max_digits10);
+  write_json(s, root);
+  return s.str();
+}
+//-----------------------------------------------------------------------------
+void common::enable_timer_trace(bool enable) { trace_enabled = enable; }
+//-----------------------------------------------------------------------------
+std::string common::timer_trace_json(MPI_Comm comm)
+{
+  // Events on this process, in microseconds
+  const int rank = dolfinx::MPI::rank(comm);
+  std::stringstream s;
+  s << std::fixed << std::setprecision(3);
+  {
+    std::scoped_lock lock(profiles_mutex);
+    for (std::size_t t = 0; t < profiles.size(); ++t)
+    {
+      const ThreadProfile& p = *profiles[t];
+      for (const Event& e : p.events)
+      {
+        s << ", {\"name\": " << json_quote(p.nodes[e.node].name)
+          << ", \"ph\": \"X\", \"ts\": " << 1e6 * e.start
+          << ", \"dur\": " << 1e6 * e.duration << ", \"pid\": " << rank
+          << ", \"tid\": " << t << "}";
+      }
+    }
+  }
+  const std::string events = s.str();
+
+  // Gather on rank 0
+  const int size = dolfinx::MPI::size(comm);
+  int num_chars = events.size();
+  std::vector<int> sizes(size);
+  MPI_Gather(&num_chars, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+  std::vector<int> offsets(size + 1, 0);
+  std::partial_sum(sizes.begin(), sizes.end(), std::next(offsets.begin()));
+  std::string events_all(offsets.back(), ' ');
+  MPI_Gatherv(events.data(), events.size(), MPI_CHAR, events_all.data(),
+              sizes.data(), offsets.data(), MPI_CHAR, 0, comm);
+  if (rank > 0)
+    return std::string();
+
+  // Remove the leading separator
+  if (!events_all.empty())
+    events_all.erase(0, 2);
+  return "{\"traceEvents\": [" + events_all + "]}";
+}
+//-----------------------------------------------------------------------------
+void common::reset_timer_tree()
+{
+  std::scoped_lock lock(profiles_mutex);
+  for (auto& p : profiles)
+    *p = ThreadProfile();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mpi.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @file TimerTree.h
+/// @brief Hierarchical, thread-aware timers.
+///
+/// A common::ScopedTimer times a region of code as a child of the
+/// enclosing ScopedTimer on the same thread, building a tree of timed
+/// regions. Each thread accumulates its own tree, so a timer does not
+/// take a lock or allocate (except the first time a region is entered
+/// from a given parent). The trees of all threads and ranks are merged
+/// when a report is created, see common::timer_tree.
+///
+/// Regions timed on a worker thread are roots of the worker thread
+/// tree, and are merged with the root regions of other threads.
+///
+/// @note The report functions must not be called while timed regions
+/// are active on other threads.
+
+namespace dolfinx::common
+{
+/// @brief Scoped timer for a region of code in the timer tree.
+///
+/// The basic usage is
+/// \code{.cpp}
+/// {
+///   ScopedTimer t("Assemble matrix");
+///   for (...)
+///   {
+///     ScopedTimer t1("Kernel");
+///     /* ... */
+///   }
+/// }
+/// \endcode
+/// which records the time, and number of calls, of "Kernel" as a child
+/// of "Assemble matrix".
+class ScopedTimer
+{
+public:
+  /// @brief Start timing a region.
+  /// @param[in] name Name of the region.
+  explicit ScopedTimer(std::string_view name);
+
+  // Copy constructor (deleted)
+  ScopedTimer(const ScopedTimer&) = delete;
+
+  // Assignment operator (deleted)
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  /// Stop timing and add the elapsed time to the region.
+  ~ScopedTimer();
+
+private:
+  // Node of the region in the tree of the calling thread
+  std::int32_t _node;
+
+  // Start time
+  std::chrono::steady_clock::time_point _start;
+};
+
+/// @brief Region in a timer tree with statistics across processes.
+struct TimerTreeNode
+{
+  /// Region name
+  std::string name;
+
+  /// Number of calls summed over threads and processes
+  std::int64_t count = 0;
+
+  /// Minimum over processes of the total time (s) on a process
+  double min = 0;
+
+  /// Maximum over processes of the total time (s) on a process
+  double max = 0;
+
+  /// Average over processes of the total time (s) on a process
+  double avg = 0;
+
+  /// Child regions
+  std::vector<TimerTreeNode> children;
+};
+
+/// @brief Merge the timer trees of all threads and processes.
+///
+/// Regions with the same path (sequence of names from the root) are
+/// merged. Times on a process are summed over its threads.
+///
+/// @note Collective
+///
+/// @param[in] comm Communicator to reduce over.
+/// @return Root of the tree (with an empty name). The root children are
+/// the top-level regions.
+TimerTreeNode timer_tree(MPI_Comm comm);
+
+/// @brief Timer tree (see common::timer_tree) in JSON format.
+/// @note Collective
+/// @param[in] comm Communicator to reduce over.
+/// @return Nested JSON objects with `name`, `count`, `min`, `max`,
+/// `avg` and `children` fields.
+std::string timer_tree_json(MPI_Comm comm);
+
+/// @brief Enable or disable recording of each timed region as an
+/// event for common::timer_trace_json.
+///
+/// Recording is off by default. Events are stored in memory on each
+/// thread until common::reset_timer_tree is called.
+///
+/// @param[in] enable Record events if `true`.
+void enable_timer_trace(bool enable);
+
+/// @brief Recorded timer events in the Chrome trace event format.
+///
+/// The result can be viewed with e.g. `chrome://tracing` or Perfetto.
+/// The process id of an event is the MPI rank and the thread id is the
+/// index of the thread (in order of its first timed region).
+///
+/// @note Collective
+///
+/// @param[in] comm Communicator to gather the events over.
+/// @return JSON trace on rank 0, and an empty string on other ranks.
+std::string timer_trace_json(MPI_Comm comm);
+
+/// @brief Clear the timer trees and events of all threads.
+/// @note Must not be called while timed regions are active.
+void reset_timer_tree();
+
+} // namespace dolfinx::common
@@ -92,6 +92,27 @@ consteval bool has_ptscotch()
 #endif
 }
 
+/// Return true if DOLFINx is compiled with C++ standard parallelism
+/// for linear algebra kernels
+consteval bool has_stdpar()
+{
+#ifdef HAS_STDPAR
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// Return true if DOLFINx is compiled with zlib
+consteval bool has_zlib()
+{
+#ifdef HAS_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
 /// Return true if DOLFINx supports UFCx kernels with arguments of type C99
 /// _Complex. When DOLFINx was built with MSVC this returns false. This
 /// returning false does not preclude using DOLFINx with kernels accepting
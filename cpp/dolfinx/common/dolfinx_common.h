@@ -10,9 +10,19 @@ namespace dolfinx::common
 
 // DOLFINx common
 
+#include <dolfinx/common/Arena.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MappedFile.h>
+#include <dolfinx/common/MetricsExporter.h>
+#include <dolfinx/common/NumaAllocator.h>
 #include <dolfinx/common/Table.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
+#include <dolfinx/common/TimerTree.h>
 #include <dolfinx/common/defines.h>
+#include <dolfinx/common/hardware_counters.h>
+#include <dolfinx/common/json.h>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/timing.h>
 #include <dolfinx/common/version.h>
@@ -8,4 +8,33 @@
  *
  * This is the documentation of the DOLFINx C++ interface.
  *
+ * \section thread_safety Thread safety
+ *
+ * Independent problems can be solved concurrently from several threads
+ * of a process, e.g. to run many small simulations per process without
+ * additional MPI ranks. The following is guaranteed:
+ *
+ * - Assembly (fem::assemble_scalar, fem::assemble_vector,
+ *   fem::assemble_matrix and variants), interpolation
+ *   (fem::Function::interpolate) and evaluation (fem::Function::eval)
+ *   may run concurrently on shared meshes, function spaces, forms and
+ *   coefficients, provided that each thread writes to a distinct
+ *   output (vector, matrix or Function) and that the shared objects
+ *   are not modified while they are in use.
+ * - Mesh data that is created on first use by these functions, i.e.
+ *   entities, connectivities and permutation data of a
+ *   mesh::Topology, is created once under a lock (see mesh::Topology).
+ *   Creation is collective on the mesh communicator, so that MPI must
+ *   be initialised with at least `MPI_THREAD_SERIALIZED`, or
+ *   `MPI_THREAD_MULTIPLE` if threads communicate on different
+ *   communicators concurrently, e.g. with a mesh per thread on
+ *   `MPI_COMM_SELF`.
+ * - The timing registry (common::TimeLogger), the element tabulation
+ *   caches, the thread pool (common::thread_pool) and the scratch
+ *   memory (common::scratch_resource, which is per thread) may be used
+ *   from several threads.
+ *
+ * Objects that are modified, e.g. a la::Vector that is assembled into
+ * or a Function that is interpolated into, must not be shared between
+ * threads without synchronisation.
  */
@@ -0,0 +1,136 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "hardware_counters.h"
+#include "log.h"
+#include <algorithm>
+#include <atomic>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+std::atomic<bool> counters_enabled = false;
+
+#ifdef __linux__
+/// Group of perf_event counters of a thread
+class CounterGroup
+{
+public:
+  CounterGroup()
+  {
+    constexpr std::array<std::uint64_t, num_hardware_counters> events
+        = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+           PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+           PERF_COUNT_HW_BRANCH_MISSES};
+    _fds.fill(-1);
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = events[i];
+      attr.disabled = i == 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      _fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1,
+                        i == 0 ? -1 : _fds[0], 0);
+      if (_fds[i] < 0)
+      {
+        spdlog::info("Hardware performance counters are not available.");
+        close_all();
+        return;
+      }
+    }
+
+    ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  CounterGroup(const CounterGroup&) = delete;
+  CounterGroup& operator=(const CounterGroup&) = delete;
+
+  ~CounterGroup() { close_all(); }
+
+  /// Read the counters
+  std::optional<HardwareCounters> read() const
+  {
+    if (_fds[0] < 0)
+      return std::nullopt;
+
+    // Layout (PERF_FORMAT_GROUP): number of counters, then the values
+    std::array<std::uint64_t, num_hardware_counters + 1> buffer;
+    if (::read(_fds[0], buffer.data(), sizeof(buffer))
+        != static_cast<ssize_t>(sizeof(buffer)))
+    {
+      return std::nullopt;
+    }
+
+    HardwareCounters values;
+    std::copy_n(std::next(buffer.begin()), values.size(), values.begin());
+    return values;
+  }
+
+private:
+  void close_all()
+  {
+    for (int& fd : _fds)
+    {
+      if (fd >= 0)
+        close(fd);
+      fd = -1;
+    }
+  }
+
+  std::array<int, num_hardware_counters> _fds;
+};
+
+/// Counters of the calling thread
+const CounterGroup& thread_counters()
+{
+  thread_local CounterGroup counters;
+  return counters;
+}
+#endif
+} // namespace
+
+//-----------------------------------------------------------------------------
+bool common::enable_hardware_counters(bool enable)
+{
+  counters_enabled = enable;
+  if (!enable)
+    return false;
+#ifdef __linux__
+  return thread_counters().read().has_value();
+#else
+  return false;
+#endif
+}
+//-----------------------------------------------------------------------------
+bool common::hardware_counters_enabled() { return counters_enabled; }
+//-----------------------------------------------------------------------------
+std::optional<HardwareCounters> common::read_hardware_counters()
+{
+  if (!counters_enabled.load(std::memory_order_relaxed))
+    return std::nullopt;
+#ifdef __linux__
+  return thread_counters().read();
+#else
+  return std::nullopt;
+#endif
+}
+//-----------------------------------------------------------------------------
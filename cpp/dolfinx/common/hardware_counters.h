@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/// @file hardware_counters.h
+/// @brief Hardware performance counters for timed regions.
+///
+/// When enabled, each common::Timer also records the change in a set
+/// of hardware performance counters of the calling thread, and the
+/// totals are reported with the timings, see dolfinx::timing_table.
+/// The counters are read using the Linux `perf_event` interface. They
+/// are not available on other platforms, or if access to performance
+/// events is restricted (see `/proc/sys/kernel/perf_event_paranoid`).
+
+namespace dolfinx::common
+{
+/// Number of hardware counters
+constexpr std::size_t num_hardware_counters = 5;
+
+/// @brief Names of the hardware counters, which are the column names
+/// in the timing table.
+///
+/// `llc-misses` is the number of last-level cache misses, an estimate
+/// of the memory traffic (multiply by the cache line size for bytes).
+constexpr std::array<std::string_view, num_hardware_counters>
+    hardware_counter_names
+    = {"cycles", "instructions", "llc-refs", "llc-misses", "branch-misses"};
+
+/// Values of the hardware counters
+using HardwareCounters = std::array<std::uint64_t, num_hardware_counters>;
+
+/// @brief Enable or disable recording of hardware counters by
+/// common::Timer.
+///
+/// Recording is disabled by default. The counters of a thread are
+/// opened the first time they are read on a thread.
+///
+/// @param[in] enable Record counters if `true`.
+/// @return `true` if the counters are available on the calling thread,
+/// otherwise `false` (timers will then not record counters).
+bool enable_hardware_counters(bool enable);
+
+/// @brief Check if recording of hardware counters by common::Timer is
+/// enabled.
+bool hardware_counters_enabled();
+
+/// @brief Read the hardware counters of the calling thread.
+/// @return Counter values, or `std::nullopt` if recording is disabled
+/// or the counters are not available.
+std::optional<HardwareCounters> read_hardware_counters();
+
+} // namespace dolfinx::common
@@ -0,0 +1,43 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "json.h"
+#include <cmath>
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+std::string common::json_escape(std::string_view s)
+{
+  std::string e;
+  e.reserve(s.size());
+  for (char c : s)
+  {
+    if (c == '\\' or c == '"')
+      e += {'\\', c};
+    else if (c == '\n')
+      e += "\\n";
+    else if (static_cast<unsigned char>(c) < 0x20)
+      e += ' ';
+    else
+      e += c;
+  }
+  return e;
+}
+//-----------------------------------------------------------------------------
+std::string common::json_quote(std::string_view s)
+{
+  return "\"" + json_escape(s) + "\"";
+}
+//-----------------------------------------------------------------------------
+void common::json_number(std::ostream& s, double x)
+{
+  if (std::isfinite(x))
+    s << x;
+  else
+    s << "null";
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,40 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/// @file json.h
+/// @brief Formatting of strings and numbers for JSON output.
+
+namespace dolfinx::common
+{
+/// @brief Escape a string for use in a JSON string.
+///
+/// Backslashes and double quotes are escaped, line feeds are written
+/// as `\n` and other control characters are replaced by a space. The
+/// result is therefore also a valid Prometheus label value.
+/// @param[in] s String.
+/// @return Escaped string, without enclosing quotes.
+std::string json_escape(std::string_view s);
+
+/// @brief Escape a string and enclose it in double quotes.
+/// @param[in] s String.
+/// @return JSON string.
+std::string json_quote(std::string_view s);
+
+/// @brief Write a number to a JSON stream.
+///
+/// JSON has no representation of non-finite numbers, so `NaN` and
+/// infinite values are written as `null`. Finite values are written
+/// with the format of the stream.
+/// @param[in,out] s Stream.
+/// @param[in] x Number.
+void json_number(std::ostream& s, double x);
+} // namespace dolfinx::common
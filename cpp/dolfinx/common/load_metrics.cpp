@@ -0,0 +1,126 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "load_metrics.h"
+#include "MPI.h"
+#include <atomic>
+#include <variant>
+
+using namespace dolfinx;
+using namespace dolfinx::common;
+
+namespace
+{
+std::atomic<bool> metrics_enabled = false;
+
+// Phase times of the current step, which may be added to by any thread
+std::array<std::atomic<double>, num_load_phases> current_times{};
+
+// Phase times of the completed steps
+std::vector<LoadTimes> steps;
+
+/// Phases with an active timer on the calling thread
+std::array<bool, num_load_phases>& active_timers()
+{
+  thread_local std::array<bool, num_load_phases> active{};
+  return active;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+void common::enable_load_metrics(bool enable) { metrics_enabled = enable; }
+//-----------------------------------------------------------------------------
+bool common::load_metrics_enabled() { return metrics_enabled; }
+//-----------------------------------------------------------------------------
+void common::add_load_time(LoadPhase phase, double t)
+{
+  if (metrics_enabled)
+    current_times[static_cast<int>(phase)] += t;
+}
+//-----------------------------------------------------------------------------
+ScopedLoadTimer::ScopedLoadTimer(LoadPhase phase) : _phase(-1)
+{
+  const int p = static_cast<int>(phase);
+  if (metrics_enabled and !active_timers()[p])
+  {
+    active_timers()[p] = true;
+    _phase = p;
+    _start = std::chrono::steady_clock::now();
+  }
+}
+//-----------------------------------------------------------------------------
+ScopedLoadTimer::~ScopedLoadTimer()
+{
+  if (_phase >= 0)
+  {
+    auto end = std::chrono::steady_clock::now();
+    current_times[_phase]
+        += std::chrono::duration<double>(end - _start).count();
+    active_timers()[_phase] = false;
+  }
+}
+//-----------------------------------------------------------------------------
+void common::end_load_step()
+{
+  if (!metrics_enabled)
+    return;
+
+  LoadTimes& t = steps.emplace_back();
+  for (std::size_t i = 0; i < num_load_phases; ++i)
+    t[i] = current_times[i].exchange(0);
+}
+//-----------------------------------------------------------------------------
+std::vector<LoadTimes> common::load_step_times() { return steps; }
+//-----------------------------------------------------------------------------
+Table common::load_imbalance_table(MPI_Comm comm)
+{
+  // Local times, with a row for each step and a total row
+  Table local("Load imbalance");
+  LoadTimes total{};
+  for (std::size_t s = 0; s < steps.size(); ++s)
+  {
+    for (std::size_t i = 0; i < num_load_phases; ++i)
+    {
+      local.set("step " + std::to_string(s), std::string(load_phase_names[i]),
+                steps[s][i]);
+      total[i] += steps[s][i];
+    }
+  }
+  for (std::size_t i = 0; i < num_load_phases; ++i)
+    local.set("total", std::string(load_phase_names[i]), total[i]);
+
+  Table max = local.reduce(comm, Table::Reduction::max);
+  Table avg = local.reduce(comm, Table::Reduction::average);
+  Table table("Load imbalance");
+  if (dolfinx::MPI::rank(comm) > 0)
+    return table;
+
+  auto add_row = [&](const std::string& row)
+  {
+    for (std::string_view phase : load_phase_names)
+    {
+      const std::string p(phase);
+      const double tmax = std::get<double>(max.get(row, p));
+      const double tavg = std::get<double>(avg.get(row, p));
+      table.set(row, p + " max", tmax);
+      table.set(row, p + " avg", tavg);
+      table.set(row, p + " max/avg", tavg > 0 ? tmax / tavg : 1.0);
+    }
+  };
+  for (std::size_t s = 0; s < steps.size(); ++s)
+    add_row("step " + std::to_string(s));
+  add_row("total");
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+void common::reset_load_metrics()
+{
+  steps.clear();
+  for (auto& t : current_times)
+    t = 0;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mpi.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @file load_metrics.h
+/// @brief Per-process time spent in the main phases of a simulation
+/// step, for detecting load imbalance.
+///
+/// When enabled, the time a process spends in
+/// - assembly (fem assemblers),
+/// - element kernels (`tabulate_tensor` calls, see fem::Form::kernel),
+/// - waiting for ghost scatters to complete (la::Vector), and
+/// - Krylov and eigenvalue solvers (see krylov.h and lobpcg.h)
+///
+/// is accumulated for the current step. common::end_load_step closes a
+/// step, and common::load_imbalance_table reports the maximum and
+/// average over processes of the times in each step. A ratio of the
+/// maximum to the average that is much larger than one points to a
+/// straggler process. The times of the steps on a process (see
+/// common::load_step_times) can be used as measured weights for
+/// repartitioning.
+///
+/// The phases overlap, e.g. kernel time is part of the assembly time
+/// and scatter waits within a solver are part of the solver time.
+/// Nested regions of the same phase on a thread are counted once.
+/// Times on a process are summed over its threads.
+
+namespace dolfinx::common
+{
+/// Phases of a step that are timed
+enum class LoadPhase : int
+{
+  assembly = 0, ///< Finite element assembly
+  kernel = 1,   ///< Element kernels
+  scatter = 2,  ///< Waiting for ghost scatters to complete
+  solver = 3    ///< Linear and eigenvalue solvers
+};
+
+/// Number of timed phases
+constexpr std::size_t num_load_phases = 4;
+
+/// Names of the phases, which are used in the load imbalance table
+constexpr std::array<std::string_view, num_load_phases> load_phase_names
+    = {"assembly", "kernel", "scatter wait", "solver"};
+
+/// Time (s) spent in each phase
+using LoadTimes = std::array<double, num_load_phases>;
+
+/// @brief Enable or disable recording of load metrics.
+///
+/// Recording is disabled by default. Enabling does not reset recorded
+/// steps, see common::reset_load_metrics.
+///
+/// @param[in] enable Record phase times if `true`.
+void enable_load_metrics(bool enable);
+
+/// @brief Check if recording of load metrics is enabled.
+bool load_metrics_enabled();
+
+/// @brief Add time to a phase of the current step.
+///
+/// Has no effect if recording is disabled.
+///
+/// @param[in] phase Phase.
+/// @param[in] t Time (s).
+void add_load_time(LoadPhase phase, double t);
+
+/// @brief Scoped timer that adds the elapsed time to a phase of the
+/// current step (see common::add_load_time).
+///
+/// If a timer of the same phase is active on the calling thread, the
+/// timer does not record, so that nested regions are counted once. The
+/// timer does nothing if recording is disabled when it is created.
+class ScopedLoadTimer
+{
+public:
+  /// @brief Start timing.
+  /// @param[in] phase Phase to add the time to.
+  explicit ScopedLoadTimer(LoadPhase phase);
+
+  // Copy constructor (deleted)
+  ScopedLoadTimer(const ScopedLoadTimer&) = delete;
+
+  // Assignment operator (deleted)
+  ScopedLoadTimer& operator=(const ScopedLoadTimer&) = delete;
+
+  /// Stop timing and add the elapsed time to the phase.
+  ~ScopedLoadTimer();
+
+private:
+  // Phase, or -1 if not recording
+  int _phase;
+
+  // Start time
+  std::chrono::steady_clock::time_point _start;
+};
+
+/// @brief Close the current step, i.e. store the phase times since the
+/// previous call and start a new step.
+///
+/// Has no effect if recording is disabled.
+///
+/// @note Must not be called while timed regions are active.
+void end_load_step();
+
+/// @brief Times in each phase of the completed steps on the calling
+/// process.
+/// @return Phase times for each step (see common::end_load_step).
+std::vector<LoadTimes> load_step_times();
+
+/// @brief Maximum and average over processes of the phase times of
+/// each completed step.
+///
+/// The table has a row for each step (`step <i>`) and a `total` row.
+/// For each phase the columns are the maximum (`<phase> max`) and
+/// average (`<phase> avg`) time over processes, and the ratio of the
+/// maximum to the average (`<phase> max/avg`, or 1 if the average is
+/// zero). The values are reduced using Table::reduce, and the table is
+/// returned on rank 0 (an empty table is returned on other ranks).
+///
+/// @note Collective. All processes must have completed the same number
+/// of steps.
+///
+/// @param[in] comm Communicator to reduce over.
+/// @return Load imbalance table on rank 0.
+Table load_imbalance_table(MPI_Comm comm);
+
+/// @brief Clear the recorded steps and the times of the current step.
+/// @note Must not be called while timed regions are active.
+void reset_load_metrics();
+
+} // namespace dolfinx::common
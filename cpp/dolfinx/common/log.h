@@ -6,10 +6,127 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <spdlog/spdlog.h>
 
+/// @def DOLFINX_LOG_LEVEL
+/// @brief Compile-time cutoff of the DOLFINX_LOG macros.
+///
+/// Messages of the DOLFINX_LOG macros with a level below the cutoff
+/// are removed at compile time, including the evaluation of their
+/// arguments. The value is one of the `SPDLOG_LEVEL_*` macros, and the
+/// default is `SPDLOG_LEVEL_INFO` if `NDEBUG` is defined (release
+/// builds) and `SPDLOG_LEVEL_TRACE` otherwise.
+#ifndef DOLFINX_LOG_LEVEL
+#ifdef NDEBUG
+#define DOLFINX_LOG_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define DOLFINX_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+/// @brief Log a message, see DOLFINX_LOG_LEVEL.
+///
+/// The message is formatted, and the arguments are evaluated, only if
+/// `level` (a `spdlog::level::level_enum` constant) is enabled at
+/// runtime.
+#define DOLFINX_LOG(level, ...)                                                \
+  do                                                                           \
+  {                                                                            \
+    if constexpr (static_cast<int>(level) >= DOLFINX_LOG_LEVEL)                \
+    {                                                                          \
+      if (spdlog::should_log(level))                                           \
+        spdlog::log(level, __VA_ARGS__);                                       \
+    }                                                                          \
+  } while (false)
+
+/// @brief Log a trace message, see DOLFINX_LOG.
+#define DOLFINX_LOG_TRACE(...) DOLFINX_LOG(spdlog::level::trace, __VA_ARGS__)
+
+/// @brief Log a debug message, see DOLFINX_LOG.
+#define DOLFINX_LOG_DEBUG(...) DOLFINX_LOG(spdlog::level::debug, __VA_ARGS__)
+
+/// @brief Log an info message, see DOLFINX_LOG.
+#define DOLFINX_LOG_INFO(...) DOLFINX_LOG(spdlog::level::info, __VA_ARGS__)
+
+/// @brief Log a message at most once per `interval` seconds from the
+/// call site, see DOLFINX_LOG.
+///
+/// The number of messages suppressed since the previous message is
+/// logged with the message. This is intended for instrumentation in
+/// loops.
+#define DOLFINX_LOG_RATE_LIMITED(level, interval, ...)                         \
+  do                                                                           \
+  {                                                                            \
+    if constexpr (static_cast<int>(level) >= DOLFINX_LOG_LEVEL)                \
+    {                                                                          \
+      static dolfinx::impl::LogRateLimiter dolfinx_log_limiter(interval);      \
+      if (spdlog::should_log(level))                                           \
+      {                                                                        \
+        if (std::int64_t n = dolfinx_log_limiter.acquire(); n > 0)             \
+        {                                                                      \
+          spdlog::log(level, "({} similar messages suppressed)", n);           \
+          spdlog::log(level, __VA_ARGS__);                                     \
+        }                                                                      \
+        else if (n == 0)                                                       \
+          spdlog::log(level, __VA_ARGS__);                                     \
+      }                                                                        \
+    }                                                                          \
+  } while (false)
+
 namespace dolfinx
 {
+namespace impl
+{
+/// @brief Rate limiter of a log call site, see
+/// DOLFINX_LOG_RATE_LIMITED.
+class LogRateLimiter
+{
+public:
+  /// @brief Create a rate limiter.
+  /// @param[in] interval Minimum time (s) between messages.
+  explicit LogRateLimiter(double interval)
+      : _interval(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(interval))
+                .count())
+  {
+  }
+
+  /// @brief Request to log a message.
+  /// @return Number of messages suppressed since the previous logged
+  /// message, or -1 if the message should be suppressed.
+  std::int64_t acquire()
+  {
+    const std::int64_t now
+        = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::int64_t next = _next.load(std::memory_order_relaxed);
+    if (now >= next
+        and _next.compare_exchange_strong(next, now + _interval,
+                                          std::memory_order_relaxed))
+    {
+      return _suppressed.exchange(0, std::memory_order_relaxed);
+    }
+    else
+    {
+      _suppressed.fetch_add(1, std::memory_order_relaxed);
+      return -1;
+    }
+  }
+
+private:
+  // Minimum time between messages (clock ticks)
+  std::int64_t _interval;
+
+  // Earliest time of the next message (clock ticks)
+  std::atomic<std::int64_t> _next{0};
+
+  // Number of suppressed messages
+  std::atomic<std::int64_t> _suppressed{0};
+};
+} // namespace impl
 
 /// @brief Optional initialisation of the logging backend.
 ///
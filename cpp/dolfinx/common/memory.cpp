@@ -0,0 +1,63 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "memory.h"
+#include "MPI.h"
+#include <array>
+#include <variant>
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+Table common::memory_table(
+    MPI_Comm comm,
+    const std::vector<
+        std::pair<std::string, std::map<std::string, std::size_t>>>& objects)
+{
+  constexpr double MiB = 1024.0 * 1024.0;
+
+  // Table of the memory on this process, with a row for the total of
+  // each object followed by rows for its members
+  std::vector<std::string> rows;
+  Table local("Memory usage [MiB]");
+  for (auto& [name, usage] : objects)
+  {
+    std::size_t total = 0;
+    for (auto& [member, bytes] : usage)
+      total += bytes;
+    rows.push_back(name);
+    local.set(name, "MiB", static_cast<double>(total) / MiB);
+    for (auto& [member, bytes] : usage)
+    {
+      rows.push_back(name + ": " + member);
+      local.set(rows.back(), "MiB", static_cast<double>(bytes) / MiB);
+    }
+  }
+
+  const std::array<std::pair<Table::Reduction, std::string>, 3> reductions
+      = {{{Table::Reduction::min, "min"},
+          {Table::Reduction::average, "avg"},
+          {Table::Reduction::max, "max"}}};
+  const int size = dolfinx::MPI::size(comm);
+  Table table(local.name);
+  for (auto& [reduction, col] : reductions)
+  {
+    Table t = local.reduce(comm, reduction);
+    if (dolfinx::MPI::rank(comm) > 0)
+      continue;
+    for (auto& row : rows)
+      table.set(row, col, t.get(row, "MiB"));
+  }
+
+  if (dolfinx::MPI::rank(comm) == 0)
+  {
+    for (auto& row : rows)
+      table.set(row, "sum", size * std::get<double>(table.get(row, "avg")));
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
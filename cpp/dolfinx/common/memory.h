@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Table.h"
+#include <cstddef>
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::common
+{
+/// @brief Memory (bytes) allocated for the data of a contiguous
+/// container.
+///
+/// The allocated capacity is used if the container reports it.
+template <typename Container>
+std::size_t container_memory(const Container& x)
+{
+  using T = typename Container::value_type;
+  if constexpr (requires { x.capacity(); })
+    return x.capacity() * sizeof(T);
+  else
+    return x.size() * sizeof(T);
+}
+
+/// @brief Create a table of the memory usage of objects, reduced over
+/// processes.
+///
+/// The memory usage of an object is a map from the names of its
+/// members to the memory (bytes) that they use on a process, e.g. as
+/// returned by mesh::Topology::memory_usage or
+/// la::MatrixCSR::memory_usage. The table has a row with the total
+/// memory of each object and a row for each member, and the min,
+/// average, max and sum of the memory in MiB over processes as columns.
+///
+/// Example:
+/// @code
+/// Table t = common::memory_table(
+///     comm, {{"Topology", topology.memory_usage()},
+///            {"Matrix", A.memory_usage()}});
+/// std::cout << t.str() << std::endl;
+/// @endcode
+///
+/// @note Collective.
+/// @pre The objects and their members are the same on all processes.
+/// @param[in] comm MPI communicator.
+/// @param[in] objects List of (object name, memory usage) pairs.
+/// @return Table of the memory usage. The table is empty on processes
+/// other than rank 0.
+Table memory_table(
+    MPI_Comm comm,
+    const std::vector<
+        std::pair<std::string, std::map<std::string, std::size_t>>>& objects);
+} // namespace dolfinx::common
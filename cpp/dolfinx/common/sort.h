@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include "ThreadPool.h"
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <numeric>
 #include <span>
 #include <type_traits>
@@ -64,11 +67,13 @@ struct __radix_sort
     if (range.size() <= 1)
       return;
 
-    T max_value = proj(*std::ranges::max_element(range, std::less{}, proj));
+    // The maximum value and the mask have the projected type, which can
+    // be wider than T (e.g. when computing a permutation)
+    I max_value = proj(*std::ranges::max_element(range, std::less{}, proj));
 
     // Sort N bits at a time
     constexpr I bucket_size = 1 << BITS;
-    T mask = (T(1) << BITS) - 1;
+    I mask = (I(1) << BITS) - 1;
 
     // Compute number of iterations, most significant digit (N bits) of
     // maxvalue
@@ -123,6 +128,150 @@ struct __radix_sort
 /// Radix sort
 inline constexpr __radix_sort radix_sort{};
 
+/// @brief Sort a vector of integers and remove duplicate entries.
+///
+/// @param[in,out] x The vector to sort. On return, `x` is sorted and
+/// holds each value once.
+template <typename T>
+  requires std::integral<T>
+void sort_unique(std::vector<T>& x)
+{
+  radix_sort(x);
+  auto [unique_end, range_end] = std::ranges::unique(x);
+  x.erase(unique_end, range_end);
+}
+
+namespace impl
+{
+/// @brief Keys that represent the rows of a 2D integer array as single
+/// unsigned integers, if the rows fit into 64 bits.
+///
+/// The entries of each column are shifted by the column minimum, and
+/// the columns are packed with the first column as the most significant
+/// bits. Comparing keys is then equivalent to comparing rows
+/// lexicographically.
+///
+/// @param[in] x The flattened 2D array.
+/// @param[in] shape1 The number of columns of `x`.
+/// @return Key for each row, or an empty vector if rows need more than
+/// 64 bits.
+template <typename T>
+std::vector<std::uint64_t> pack_rows(std::span<const T> x, std::size_t shape1)
+{
+  using U = std::make_unsigned_t<T>;
+  const std::size_t shape0 = x.size() / shape1;
+  std::vector<T> min(shape1, std::numeric_limits<T>::max());
+  std::vector<T> max(shape1, std::numeric_limits<T>::min());
+  for (std::size_t i = 0; i < shape0; ++i)
+  {
+    for (std::size_t j = 0; j < shape1; ++j)
+    {
+      min[j] = std::min(min[j], x[i * shape1 + j]);
+      max[j] = std::max(max[j], x[i * shape1 + j]);
+    }
+  }
+
+  std::vector<int> bits(shape1);
+  for (std::size_t j = 0; j < shape1; ++j)
+    bits[j] = std::bit_width(static_cast<U>(U(max[j]) - U(min[j])));
+  if (std::reduce(bits.begin(), bits.end(), 0) > 64)
+    return {};
+
+  std::vector<std::uint64_t> keys(shape0, 0);
+  for (std::size_t i = 0; i < shape0; ++i)
+  {
+    std::uint64_t key = 0;
+    for (std::size_t j = 0; j < shape1; ++j)
+    {
+      std::uint64_t v = static_cast<U>(U(x[i * shape1 + j]) - U(min[j]));
+      key = bits[j] < 64 ? (key << bits[j]) | v : v;
+    }
+    keys[i] = key;
+  }
+  return keys;
+}
+
+/// @brief Compute the permutation that sorts keys, using a parallel
+/// least significant digit radix sort.
+///
+/// The keys are split into `num_tasks` contiguous blocks. For each
+/// digit, a histogram of the digits of each block is computed, and the
+/// keys of each block are then moved to their sorted positions, with
+/// the blocks processed concurrently on common::thread_pool. The sort
+/// is stable.
+///
+/// @param[in] keys The keys to sort.
+/// @param[in] num_tasks Number of blocks.
+/// @return The permutation array such that `keys[perm[i]] <=
+/// keys[perm[i + 1]]`.
+template <int BITS = 8>
+std::vector<std::int32_t> radix_argsort(std::span<const std::uint64_t> keys,
+                                        std::size_t num_tasks)
+{
+  const std::size_t n = keys.size();
+  std::vector<std::int32_t> perm(n);
+  std::iota(perm.begin(), perm.end(), 0);
+  if (n <= 1)
+    return perm;
+
+  const std::uint64_t max_value = *std::ranges::max_element(keys);
+  const int num_digits = (std::bit_width(max_value) + BITS - 1) / BITS;
+  constexpr std::size_t bucket_size = 1 << BITS;
+  constexpr std::uint64_t mask = bucket_size - 1;
+
+  std::vector<std::size_t> offsets(num_tasks + 1);
+  for (std::size_t t = 0; t <= num_tasks; ++t)
+    offsets[t] = (t * n) / num_tasks;
+
+  // Position in the output for each (task, bucket)
+  std::vector<std::size_t> pos(num_tasks * bucket_size);
+  std::vector<std::int32_t> buffer(n);
+  for (int d = 0; d < num_digits; ++d)
+  {
+    const int shift = d * BITS;
+    auto digit = [&keys, shift](std::int32_t i)
+    { return (keys[i] >> shift) & mask; };
+
+    // Histogram of each block
+    common::thread_pool().run(
+        num_tasks,
+        [&](int t)
+        {
+          std::span<std::size_t> count(pos.data() + t * bucket_size,
+                                       bucket_size);
+          std::ranges::fill(count, 0);
+          for (std::size_t i = offsets[t]; i < offsets[t + 1]; ++i)
+            count[digit(perm[i])]++;
+        });
+
+    // Exclusive prefix sum, by bucket then by block
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < bucket_size; ++b)
+    {
+      for (std::size_t t = 0; t < num_tasks; ++t)
+      {
+        std::size_t c = pos[t * bucket_size + b];
+        pos[t * bucket_size + b] = offset;
+        offset += c;
+      }
+    }
+
+    // Move keys of each block into position
+    common::thread_pool().run(
+        num_tasks,
+        [&](int t)
+        {
+          std::span<std::size_t> p(pos.data() + t * bucket_size, bucket_size);
+          for (std::size_t i = offsets[t]; i < offsets[t + 1]; ++i)
+            buffer[p[digit(perm[i])]++] = perm[i];
+        });
+    std::swap(perm, buffer);
+  }
+
+  return perm;
+}
+} // namespace impl
+
 /// @brief Compute the permutation array that sorts a 2D array by row.
 ///
 /// @param[in] x The flattened 2D array to compute the permutation array
@@ -130,8 +279,10 @@ inline constexpr __radix_sort radix_sort{};
 /// @param[in] shape1 The number of columns of `x`.
 /// @return The permutation array such that `x[perm[i]] <= x[perm[i +1]].
 /// @pre `x.size()` must be a multiple of `shape1`.
-/// @note This function is suitable for small values of `shape1`. Each
-/// column of `x` is copied into an array that is then sorted.
+/// @note If the range of values of the rows fits into 64 bits, the
+/// rows are packed into single keys that are sorted in one pass.
+/// Otherwise, each column of `x` is copied into an array that is then
+/// sorted, which is suitable for small values of `shape1`.
 template <typename T, int BITS = 16>
 std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1)
 {
@@ -141,15 +292,32 @@ std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1)
   const std::size_t shape0 = x.size() / shape1;
   std::vector<std::int32_t> perm(shape0);
   std::iota(perm.begin(), perm.end(), 0);
+  if (shape0 <= 1)
+    return perm;
+
+  if (std::vector<std::uint64_t> keys = impl::pack_rows(x, shape1);
+      !keys.empty())
+  {
+    radix_sort(perm, [&keys](auto index) { return keys[index]; });
+    return perm;
+  }
 
   // Sort by each column, right to left. Col 0 has the most significant
-  // "digit".
-  std::vector<T> column(shape0);
+  // "digit". Values are shifted by the column minimum to sort negative
+  // values correctly.
+  using U = std::make_unsigned_t<T>;
+  std::vector<U> column(shape0);
   for (std::size_t i = 0; i < shape1; ++i)
   {
     int col = shape1 - 1 - i;
+    U min = std::numeric_limits<U>::max();
     for (std::size_t j = 0; j < shape0; ++j)
-      column[j] = x[j * shape1 + col];
+    {
+      column[j] = U(x[j * shape1 + col]) - U(std::numeric_limits<T>::min());
+      min = std::min(min, column[j]);
+    }
+    for (U& c : column)
+      c -= min;
 
     radix_sort(perm, [&column](auto index) { return column[index]; });
   }
@@ -157,4 +325,94 @@ std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1)
   return perm;
 }
 
+/// @brief Compute the permutation array that sorts a 2D array by row,
+/// using multiple threads.
+///
+/// The rows are split into `num_threads` contiguous blocks that are
+/// sorted concurrently using sort_by_perm(std::span<const T>,
+/// std::size_t). The sorted blocks are then merged pairwise, with the
+/// merges at each level performed concurrently. Since the radix sort
+/// and the merges are stable, the returned permutation is the same as
+/// the permutation computed by the serial version.
+///
+/// @param[in] x The flattened 2D array to compute the permutation array
+/// for.
+/// @param[in] shape1 The number of columns of `x`.
+/// @param[in] num_threads Number of blocks. The blocks are sorted and
+/// merged as tasks on common::thread_pool.
+/// @return The permutation array such that `x[perm[i]] <= x[perm[i +1]].
+/// @pre `x.size()` must be a multiple of `shape1`.
+template <typename T, int BITS = 16>
+std::vector<std::int32_t> sort_by_perm(std::span<const T> x, std::size_t shape1,
+                                       int num_threads)
+{
+  assert(shape1 > 0);
+  assert(x.size() % shape1 == 0);
+  const std::size_t shape0 = x.size() / shape1;
+  const std::size_t nt = std::clamp<std::size_t>(
+      std::max(num_threads, 1), 1, std::max<std::size_t>(shape0, 1));
+  if (nt == 1)
+    return sort_by_perm<T, BITS>(x, shape1);
+
+  // Sort rows that fit into 64 bits as single keys, with a parallel
+  // radix sort
+  if (std::vector<std::uint64_t> keys = impl::pack_rows(x, shape1);
+      !keys.empty())
+  {
+    return impl::radix_argsort(std::span<const std::uint64_t>(keys), nt);
+  }
+
+  // Row range of each block
+  std::vector<std::size_t> offsets(nt + 1);
+  for (std::size_t t = 0; t <= nt; ++t)
+    offsets[t] = (t * shape0) / nt;
+
+  // Sort blocks
+  std::vector<std::int32_t> perm(shape0);
+  common::thread_pool().run(
+      nt,
+      [&perm, &offsets, x, shape1](std::size_t t)
+      {
+        std::size_t r0 = offsets[t], r1 = offsets[t + 1];
+        std::vector<std::int32_t> p = sort_by_perm<T, BITS>(
+            x.subspan(r0 * shape1, (r1 - r0) * shape1), shape1);
+        std::ranges::transform(p, std::next(perm.begin(), r0),
+                               [r0](auto i) { return i + r0; });
+      });
+
+  // Merge sorted blocks pairwise
+  auto less = [x, shape1](auto i0, auto i1)
+  {
+    auto it0 = std::next(x.begin(), i0 * shape1);
+    auto it1 = std::next(x.begin(), i1 * shape1);
+    return std::lexicographical_compare(it0, std::next(it0, shape1), it1,
+                                        std::next(it1, shape1));
+  };
+  std::vector<std::int32_t> buffer(shape0);
+  for (std::size_t w = 1; w < nt; w *= 2)
+  {
+    const std::size_t num_merges = (nt + 2 * w - 1) / (2 * w);
+    common::thread_pool().run(
+        num_merges,
+        [&perm, &buffer, &offsets, &less, nt, w](std::size_t m)
+        {
+          const std::size_t b = 2 * w * m;
+          auto first = std::next(perm.begin(), offsets[b]);
+          auto last
+              = std::next(perm.begin(), offsets[std::min(b + 2 * w, nt)]);
+          auto out = std::next(buffer.begin(), offsets[b]);
+          if (b + w < nt)
+          {
+            auto mid = std::next(perm.begin(), offsets[b + w]);
+            std::merge(first, mid, mid, last, out, less);
+          }
+          else
+            std::copy(first, last, out);
+        });
+    std::swap(perm, buffer);
+  }
+
+  return perm;
+}
+
 } // namespace dolfinx
@@ -0,0 +1,234 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "assembler.h"
+#include "utils.h"
+#include <chrono>
+#include <concepts>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace dolfinx::fem
+{
+template <dolfinx::scalar T, std::floating_point U>
+class DirichletBC;
+template <dolfinx::scalar T, std::floating_point U>
+class Form;
+
+/// @brief Assembly of a vector that runs on the background thread of
+/// the process thread pool (see common::ThreadPool::submit), with the
+/// accumulation of ghost contributions on the owning ranks
+/// (`la::Vector::scatter_rev`) as a continuation on the calling thread.
+///
+/// The local assembly does not communicate, so that the calling thread
+/// can, e.g., progress a Krylov solve, a ghost scatter or I/O while the
+/// vector is assembled, e.g.
+///
+///     AsyncVectorAssembly assembly = fem::assemble_vector_async(b, L);
+///     // ... other work ...
+///     assembly.wait();
+///
+/// @tparam T Scalar type.
+template <dolfinx::scalar T>
+class AsyncVectorAssembly
+{
+public:
+  /// @brief Create a handle to a vector assembly.
+  /// @param[in] b The vector that is assembled. It must not be accessed
+  /// until the assembly is complete.
+  /// @param[in] local Future that is ready when the local assembly into
+  /// `b` is complete.
+  AsyncVectorAssembly(la::Vector<T>& b, std::future<void> local)
+      : _b(b), _local(std::move(local))
+  {
+  }
+
+  // The vector of a pending assembly can not be changed
+  AsyncVectorAssembly(const AsyncVectorAssembly&) = delete;
+  AsyncVectorAssembly(AsyncVectorAssembly&&) = delete;
+  AsyncVectorAssembly& operator=(const AsyncVectorAssembly&) = delete;
+  AsyncVectorAssembly& operator=(AsyncVectorAssembly&&) = delete;
+
+  /// @brief Destructor. Waits for the local assembly if it is pending.
+  /// @note The ghost contributions are not accumulated unless
+  /// AsyncVectorAssembly::wait has been called, since that is collective.
+  ~AsyncVectorAssembly()
+  {
+    if (_local.valid())
+      _local.wait();
+  }
+
+  /// @brief Start the reverse scatter if the local assembly is
+  /// complete, without blocking.
+  /// @note Collective MPI operation if the local assembly is complete
+  /// @return True if the local assembly is complete.
+  bool test()
+  {
+    if (_local.valid()
+        and _local.wait_for(std::chrono::seconds(0))
+                == std::future_status::ready)
+    {
+      start();
+    }
+    return !_local.valid();
+  }
+
+  /// @brief Complete the assembly.
+  ///
+  /// Waits for the local assembly, and accumulates the ghost
+  /// contributions on the owning ranks. Exceptions of the local
+  /// assembly are re-thrown.
+  ///
+  /// @note Collective MPI operation
+  void wait()
+  {
+    if (_local.valid())
+    {
+      _local.wait();
+      start();
+    }
+    if (_scattering)
+    {
+      _b.scatter_rev_end(std::plus<T>());
+      _scattering = false;
+    }
+  }
+
+private:
+  // Re-throw exceptions of the local assembly, and start the reverse
+  // scatter
+  void start()
+  {
+    _local.get();
+    _b.scatter_rev_begin();
+    _scattering = true;
+  }
+
+  la::Vector<T>& _b;
+  std::future<void> _local;
+  bool _scattering = false;
+};
+
+/// @brief Assemble a linear form into a distributed vector
+/// asynchronously.
+///
+/// The constants and coefficients are packed on the calling thread, and
+/// the local assembly is executed on the background thread of the
+/// process thread pool. The ghost contributions are accumulated on the
+/// owning ranks by AsyncVectorAssembly::wait.
+///
+/// @note Collective MPI operation on completion
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly. It must not be accessed until the assembly is
+/// complete.
+/// @param[in] L The linear form to assemble into `b`. It, and its
+/// coefficients, must not be changed until the assembly is complete.
+/// @return Handle to the assembly.
+template <dolfinx::scalar T, std::floating_point U>
+AsyncVectorAssembly<T> assemble_vector_async(la::Vector<T>& b,
+                                             const Form<T, U>& L)
+{
+  auto constants = std::make_shared<std::vector<T>>(pack_constants(L));
+  auto coefficients = std::make_shared<
+      std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>>(
+      allocate_coefficient_storage(L, true));
+  pack_coefficients(L, *coefficients);
+
+  std::future<void> local = common::thread_pool().submit(
+      [&b, &L, constants, coefficients]()
+      {
+        assemble_vector(b.mutable_array(), L, std::span<const T>(*constants),
+                        make_coefficients_span(*coefficients));
+      });
+  return AsyncVectorAssembly<T>(b, std::move(local));
+}
+
+/// @brief Assemble a bilinear form into a matrix asynchronously.
+///
+/// The constants and coefficients are packed on the calling thread, and
+/// the assembly is executed on the background thread of the process
+/// thread pool. The matrix is not zeroed or finalised, and the caller
+/// finalises it (e.g. `la::MatrixCSR::scatter_rev`) once the returned
+/// future is ready.
+///
+/// @param[in] mat_add The function for adding values into the matrix.
+/// It is called on the background thread.
+/// @param[in] a The bilinear form to assemble. It, and its
+/// coefficients, must not be changed until the assembly is complete.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+/// @return Future that is ready when the assembly is complete.
+/// Exceptions of the assembly are re-thrown by `std::future::get`.
+template <dolfinx::scalar T, std::floating_point U>
+std::future<void> assemble_matrix_async(
+    auto mat_add, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  auto constants = std::make_shared<std::vector<T>>(pack_constants(a));
+  auto coefficients = std::make_shared<
+      std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>>(
+      allocate_coefficient_storage(a, true));
+  pack_coefficients(a, *coefficients);
+
+  return common::thread_pool().submit(
+      [mat_add, &a, bcs, constants, coefficients]()
+      {
+        assemble_matrix(mat_add, a, std::span<const T>(*constants),
+                        make_coefficients_span(*coefficients), bcs);
+      });
+}
+
+/// @brief Assemble a functional into a scalar asynchronously.
+///
+/// The constants and coefficients are packed on the calling thread, and
+/// the assembly is executed on the background thread of the process
+/// thread pool.
+///
+/// @note Caller is responsible for accumulation across processes, e.g.
+/// with a fem::ScalarReduction.
+/// @param[in] M The functional to assemble. It, and its coefficients,
+/// must not be changed until the assembly is complete.
+/// @return Future of the contribution to the functional from the local
+/// process.
+template <dolfinx::scalar T, std::floating_point U>
+std::future<T> assemble_scalar_async(const Form<T, U>& M)
+{
+  auto constants = std::make_shared<std::vector<T>>(pack_constants(M));
+  auto coefficients = std::make_shared<
+      std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>>(
+      allocate_coefficient_storage(M, true));
+  pack_coefficients(M, *coefficients);
+
+  auto value = std::make_shared<std::promise<T>>();
+  std::future<T> future = value->get_future();
+  common::thread_pool().submit(
+      [&M, constants, coefficients, value]()
+      {
+        try
+        {
+          value->set_value(assemble_scalar(
+              M, std::span<const T>(*constants),
+              make_coefficients_span(*coefficients)));
+        }
+        catch (...)
+        {
+          value->set_exception(std::current_exception());
+        }
+      });
+  return future;
+}
+
+} // namespace dolfinx::fem
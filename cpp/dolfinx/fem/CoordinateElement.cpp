@@ -10,10 +10,39 @@
 #include <cmath>
 #include <dolfinx/common/math.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <numeric>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
+namespace
+{
+/// Average of the vertices of a reference cell
+template <std::floating_point T>
+std::array<T, 3> reference_midpoint(mesh::CellType cell)
+{
+  switch (cell)
+  {
+  case mesh::CellType::interval:
+    return {0.5, 0, 0};
+  case mesh::CellType::triangle:
+    return {T(1) / 3, T(1) / 3, 0};
+  case mesh::CellType::quadrilateral:
+    return {0.5, 0.5, 0};
+  case mesh::CellType::tetrahedron:
+    return {0.25, 0.25, 0.25};
+  case mesh::CellType::pyramid:
+    return {0.4, 0.4, 0.2};
+  case mesh::CellType::prism:
+    return {T(1) / 3, T(1) / 3, 0.5};
+  case mesh::CellType::hexahedron:
+    return {0.5, 0.5, 0.5};
+  default:
+    return {0, 0, 0};
+  }
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
 CoordinateElement<T>::CoordinateElement(
@@ -57,7 +86,10 @@ void CoordinateElement<T>::tabulate(int nd, std::span<const T> X,
                                     std::span<T> basis) const
 {
   assert(_element);
-  _element->tabulate(nd, X, shape, basis);
+  auto [tab, tshape] = _tabulation_cache->get(
+      nd, X, shape, [&]() { return _element->tabulate(nd, X, shape); });
+  assert(basis.size() == tab->size());
+  std::ranges::copy(*tab, basis.begin());
 }
 //--------------------------------------------------------------------------------
 template <std::floating_point T>
@@ -97,77 +129,120 @@ void CoordinateElement<T>::pull_back_nonaffine(mdspan2_t<T> X,
   assert(X.extent(0) == num_points);
   assert(X.extent(1) == tdim);
 
-  std::vector<T> dphi_b(tdim * num_xnodes);
-  mdspan2_t<T> dphi(dphi_b.data(), tdim, num_xnodes);
-
-  std::vector<T> Xk_b(tdim);
-  mdspan2_t<T> Xk(Xk_b.data(), 1, tdim);
+  using mdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
 
-  std::array<T, 3> xk = {0, 0, 0};
-  std::vector<T> dX(tdim);
-  std::vector<T> J_b(gdim * tdim);
-  mdspan2_t<T> J(J_b.data(), gdim, tdim);
+  // Work arrays for the points that are being iterated on. All points
+  // are advanced together so that the basis is tabulated once per
+  // Newton iteration, rather than once per point and iteration.
+  std::vector<T> Xk_b(num_points * tdim);
+  std::vector<T> xk_b(num_points * gdim);
+  std::vector<T> J_b(num_points * gdim * tdim);
   std::vector<T> K_b(tdim * gdim);
   mdspan2_t<T> K(K_b.data(), tdim, gdim);
+  std::vector<T> dX(tdim);
 
-  using mdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-      T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
-
-  const std::array<std::size_t, 4> bsize = _element->tabulate_shape(1, 1);
+  const std::array<std::size_t, 4> bsize
+      = _element->tabulate_shape(1, num_points);
   std::vector<T> basis_b(
       std::reduce(bsize.begin(), bsize.end(), 1, std::multiplies{}));
-  mdspan4_t basis(basis_b.data(), bsize);
-  std::vector<T> phi(basis.extent(2));
-  for (std::size_t p = 0; p < num_points; ++p)
+
+  // Compute xk = cell_geometry^T phi and J = cell_geometry^T dphi at
+  // the first n points in Xk
+  auto compute_geometry = [&](std::size_t n)
   {
-    std::ranges::fill(Xk_b, 0.0);
-    int k;
-    for (k = 0; k < maxit; ++k)
+    std::span<T> basis_n(basis_b.data(), (tdim + 1) * n * num_xnodes);
+    _element->tabulate(1, std::span<const T>(Xk_b.data(), n * tdim),
+                       {n, tdim}, basis_n);
+    mdspan4_t basis(basis_n.data(), tdim + 1, n, num_xnodes, 1);
+
+    std::fill_n(xk_b.begin(), n * gdim, 0);
+    std::fill_n(J_b.begin(), n * gdim * tdim, 0);
+    for (std::size_t p = 0; p < n; ++p)
     {
-      _element->tabulate(1, Xk_b, {1, tdim}, basis_b);
+      T* xk = xk_b.data() + p * gdim;
+      T* J = J_b.data() + p * gdim * tdim;
+      for (std::size_t i = 0; i < num_xnodes; ++i)
+      {
+        for (std::size_t j = 0; j < gdim; ++j)
+        {
+          const T c = cell_geometry(i, j);
+          xk[j] += c * basis(0, p, i, 0);
+          for (std::size_t k = 0; k < tdim; ++k)
+            J[j * tdim + k] += c * basis(k + 1, p, i, 0);
+        }
+      }
+    }
+  };
+
+  // Compute the inverse Jacobian K at the p-th point in Xk
+  auto compute_K = [&](std::size_t p)
+  {
+    mdspan2_t<const T> J(J_b.data() + p * gdim * tdim, gdim, tdim);
+    compute_jacobian_inverse(J, K);
+  };
+
+  // Compute dX = K (x_q - xk_p), where q is an input point and p is
+  // a point in Xk
+  auto compute_dX = [&](std::size_t q, std::size_t p)
+  {
+    std::ranges::fill(dX, 0);
+    for (std::size_t i = 0; i < tdim; ++i)
+      for (std::size_t j = 0; j < gdim; ++j)
+        dX[i] += K(i, j) * (x(q, j) - xk_b[p * gdim + j]);
+  };
+
+  // Initial guess from the affine approximation of the map at the
+  // reference cell midpoint Xm, i.e. X = Xm + K(Xm) (x - x(Xm))
+  const std::array<T, 3> Xm = reference_midpoint<T>(this->cell_shape());
+  std::copy_n(Xm.begin(), tdim, Xk_b.begin());
+  compute_geometry(1);
+  compute_K(0);
+  for (std::size_t q = 0; q < num_points; ++q)
+  {
+    compute_dX(q, 0);
+    for (std::size_t i = 0; i < tdim; ++i)
+      X(q, i) = Xm[i] + dX[i];
+  }
+
+  // Newton iterations for the points that have not yet converged
+  std::vector<std::size_t> active(num_points);
+  std::iota(active.begin(), active.end(), 0);
+  for (int k = 0; k < maxit and !active.empty(); ++k)
+  {
+    const std::size_t n = active.size();
+    for (std::size_t p = 0; p < n; ++p)
+      for (std::size_t i = 0; i < tdim; ++i)
+        Xk_b[p * tdim + i] = X(active[p], i);
 
-      // x = cell_geometry * phi
-      std::ranges::fill(xk, 0.0);
-      for (std::size_t i = 0; i < cell_geometry.extent(0); ++i)
-        for (std::size_t j = 0; j < cell_geometry.extent(1); ++j)
-          xk[j] += cell_geometry(i, j) * basis(0, 0, i, 0);
+    compute_geometry(n);
 
-      // Compute Jacobian, its inverse and determinant
-      std::ranges::fill(J_b, 0.0);
+    std::size_t num_active = 0;
+    for (std::size_t p = 0; p < n; ++p)
+    {
+      const std::size_t q = active[p];
+      compute_K(p);
+      compute_dX(q, p);
+
+      // Compute X += dX, and keep iterating on the point if norm(dX)
+      // is not below the tolerance
+      T dX_squared = 0;
       for (std::size_t i = 0; i < tdim; ++i)
-        for (std::size_t j = 0; j < basis.extent(2); ++j)
-          dphi(i, j) = basis(i + 1, 0, j, 0);
-
-      compute_jacobian(dphi, cell_geometry, J);
-      compute_jacobian_inverse(J, K);
-
-      // Compute dX = K * (x_p - x_k)
-      std::ranges::fill(dX, 0);
-      for (std::size_t i = 0; i < K.extent(0); ++i)
-        for (std::size_t j = 0; j < K.extent(1); ++j)
-          dX[i] += K(i, j) * (x(p, j) - xk[j]);
-
-      // Compute Xk += dX
-      std::ranges::transform(dX, Xk_b, Xk_b.begin(),
-                             [](auto a, auto b) { return a + b; });
-
-      // Compute norm(dX)
-      if (auto dX_squared
-          = std::transform_reduce(dX.cbegin(), dX.cend(), 0.0, std::plus{},
-                                  [](auto v) { return v * v; });
-          std::sqrt(dX_squared) < tol)
       {
-        break;
+        X(q, i) += dX[i];
+        dX_squared += dX[i] * dX[i];
       }
-    }
 
-    std::copy(Xk_b.cbegin(), std::next(Xk_b.cbegin(), tdim),
-              X.data_handle() + p * tdim);
-    if (k == maxit)
-    {
-      throw std::runtime_error(
-          "Newton method failed to converge for non-affine geometry");
+      if (std::sqrt(dX_squared) >= tol)
+        active[num_active++] = q;
     }
+    active.resize(num_active);
+  }
+
+  if (!active.empty())
+  {
+    throw std::runtime_error(
+        "Newton method failed to converge for non-affine geometry");
   }
 }
 //-----------------------------------------------------------------------------
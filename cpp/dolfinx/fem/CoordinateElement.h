@@ -7,6 +7,7 @@
 #pragma once
 
 #include "ElementDofLayout.h"
+#include "TabulationCache.h"
 #include <algorithm>
 #include <array>
 #include <basix/element-families.h>
@@ -90,6 +91,7 @@ public:
   /// @param[in] shape The shape of `X`.
   /// @param[out] basis The array to fill with the basis function
   /// values. The shape can be computed using `tabulate_shape`.
+  /// @note Recent tabulations are cached (see fem::TabulationCache).
   void tabulate(int nd, std::span<const T> X, std::array<std::size_t, 2> shape,
                 std::span<T> basis) const;
 
@@ -237,6 +239,12 @@ public:
   /// geometry nodes, gdim)`).
   /// @param [in] tol Tolerance for termination of Newton method.
   /// @param [in] maxit Maximum number of Newton iterations
+  /// @note The points are advanced together, with one tabulation of the
+  /// geometry basis per Newton iteration for the points that have not
+  /// converged. The initial guess is computed from the affine
+  /// approximation of the map at the reference cell midpoint. It is
+  /// therefore more efficient to pull back all points in a cell in one
+  /// call.
   /// @note If convergence is not achieved within `maxit`, the function
   /// throws a runtime error.
   void pull_back_nonaffine(mdspan2_t<T> X, mdspan2_t<const T> x,
@@ -266,5 +274,9 @@ private:
 
   // Basix Element
   std::shared_ptr<const basix::FiniteElement<T>> _element;
+
+  // Recent tabulations of the basis functions, shared by copies
+  std::shared_ptr<TabulationCache<T>> _tabulation_cache
+      = std::make_shared<TabulationCache<T>>();
 };
 } // namespace dolfinx::fem
@@ -10,11 +10,13 @@
 #include <algorithm>
 #include <array>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
-#include <map>
+#include <functional>
 #include <numeric>
 #include <utility>
 
@@ -150,15 +152,14 @@ get_remote_dofs(MPI_Comm comm, const common::IndexMap& map, int bs_map,
   const std::array<std::int64_t, 2> range = map.local_range();
   std::span ghosts = map.ghosts();
 
-  // Build map from ghost global index to local position
-  // NOTE: Should we use map here or just one vector with ghosts and
-  // std::distance?
-  std::vector<std::pair<std::int64_t, std::int32_t>> global_local_ghosts;
+  // Build sorted list of (ghost global index, local position) pairs,
+  // which is searched for the received ghost indices
+  std::vector<std::pair<std::int64_t, std::int32_t>> global_to_local;
+  global_to_local.reserve(ghosts.size());
   const std::int32_t local_size = range[1] - range[0];
   for (std::size_t i = 0; i < ghosts.size(); ++i)
-    global_local_ghosts.emplace_back(ghosts[i], i + local_size);
-  std::map<std::int64_t, std::int32_t> global_to_local(
-      global_local_ghosts.begin(), global_local_ghosts.end());
+    global_to_local.emplace_back(ghosts[i], i + local_size);
+  std::ranges::sort(global_to_local);
 
   MPI_Wait(&request, MPI_STATUS_IGNORE);
   std::vector<std::int32_t> dofs;
@@ -170,7 +171,9 @@ get_remote_dofs(MPI_Comm comm, const common::IndexMap& map, int bs_map,
       dofs.push_back(dof_global - bs_map * range[0]);
     else
     {
-      if (auto it = global_to_local.find(block); it != global_to_local.end())
+      auto it = std::ranges::lower_bound(global_to_local, block, std::less{},
+                                         [](auto& g) { return g.first; });
+      if (it != global_to_local.end() and it->first == block)
       {
         int offset = dof_global % bs_map;
         dofs.push_back(bs_map * it->second + offset);
@@ -186,7 +189,7 @@ get_remote_dofs(MPI_Comm comm, const common::IndexMap& map, int bs_map,
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t> fem::locate_dofs_topological(
     const mesh::Topology& topology, const DofMap& dofmap, int dim,
-    std::span<const std::int32_t> entities, bool remote)
+    std::span<const std::int32_t> entities, bool remote, int num_threads)
 {
   mesh::CellType cell_type = topology.cell_type();
 
@@ -200,55 +203,80 @@ std::vector<std::int32_t> fem::locate_dofs_topological(
         dofmap.element_dof_layout().entity_closure_dofs(dim, i));
   }
 
-  // Get cell index and local entity index
-  std::vector<std::pair<std::int32_t, int>> entity_indices
-      = find_local_entity_index(topology, entities, dim);
-
-  std::vector<std::int32_t> dofs;
-  dofs.reserve(entities.size()
-               * dofmap.element_dof_layout().num_entity_closure_dofs(dim));
-
   // V is a sub space we need to take the block size of the dofmap and
   // the index map into account as they can differ
   const int bs = dofmap.bs();
   const int element_bs = dofmap.element_dof_layout().block_size();
+  if (element_bs != bs and bs != 1)
+    throw std::runtime_error("Block size combination not supported");
 
-  // Iterate over marked facets
-  if (element_bs == bs)
+  // Collect the closure dofs of the entities [e0, e1)
+  auto collect_dofs = [&](std::size_t e0, std::size_t e1)
   {
-    // Work with blocks
-    for (auto [cell, entity_local_index] : entity_indices)
+    // Get cell index and local entity index
+    std::vector<std::pair<std::int32_t, int>> entity_indices
+        = find_local_entity_index(topology, entities.subspan(e0, e1 - e0),
+                                  dim);
+
+    std::vector<std::int32_t> dofs;
+    dofs.reserve((e1 - e0)
+                 * dofmap.element_dof_layout().num_entity_closure_dofs(dim)
+                 * (element_bs / bs));
+    if (element_bs == bs)
     {
-      // Get cell dofmap and loop over entity dofs
-      auto cell_dofs = dofmap.cell_dofs(cell);
-      for (int index : entity_dofs[entity_local_index])
-        dofs.push_back(cell_dofs[index]);
+      // Work with blocks
+      for (auto [cell, entity_local_index] : entity_indices)
+      {
+        // Get cell dofmap and loop over entity dofs
+        auto cell_dofs = dofmap.cell_dofs(cell);
+        for (int index : entity_dofs[entity_local_index])
+          dofs.push_back(cell_dofs[index]);
+      }
     }
-  }
-  else if (bs == 1)
-  {
-    // Space is not blocked, unroll dofs
-    for (auto [cell, entity_local_index] : entity_indices)
+    else
     {
-      // Get cell dofmap and loop over facet dofs and 'unpack' blocked
-      // dofs
-      std::span<const std::int32_t> cell_dofs = dofmap.cell_dofs(cell);
-      for (int index : entity_dofs[entity_local_index])
+      // Space is not blocked, unroll dofs
+      for (auto [cell, entity_local_index] : entity_indices)
       {
-        for (int k = 0; k < element_bs; ++k)
+        // Get cell dofmap and loop over facet dofs and 'unpack' blocked
+        // dofs
+        std::span<const std::int32_t> cell_dofs = dofmap.cell_dofs(cell);
+        for (int index : entity_dofs[entity_local_index])
         {
-          const std::div_t pos = std::div(element_bs * index + k, bs);
-          dofs.push_back(bs * cell_dofs[pos.quot] + pos.rem);
+          for (int k = 0; k < element_bs; ++k)
+          {
+            const std::div_t pos = std::div(element_bs * index + k, bs);
+            dofs.push_back(bs * cell_dofs[pos.quot] + pos.rem);
+          }
         }
       }
     }
+
+    return dofs;
+  };
+
+  // Iterate over marked entities, with each thread collecting the dofs
+  // of a contiguous block of entities
+  std::vector<std::int32_t> dofs;
+  if (num_threads > 1)
+  {
+    std::vector<std::vector<std::int32_t>> thread_dofs(num_threads);
+    common::thread_pool().run(
+        num_threads,
+        [&](int t)
+        {
+          auto [e0, e1]
+              = dolfinx::MPI::local_range(t, entities.size(), num_threads);
+          thread_dofs[t] = collect_dofs(e0, e1);
+        });
+    for (auto& d : thread_dofs)
+      dofs.insert(dofs.end(), d.begin(), d.end());
   }
   else
-    throw std::runtime_error("Block size combination not supported");
+    dofs = collect_dofs(0, entities.size());
 
-  // TODO: is removing duplicates at this point worth the effort?
   // Remove duplicates
-  std::ranges::sort(dofs);
+  dolfinx::radix_sort(dofs);
   auto [unique_end, range_end] = std::ranges::unique(dofs);
   dofs.erase(unique_end, range_end);
 
@@ -296,7 +324,7 @@ std::vector<std::int32_t> fem::locate_dofs_topological(
 std::array<std::vector<std::int32_t>, 2> fem::locate_dofs_topological(
     const mesh::Topology& topology,
     std::array<std::reference_wrapper<const DofMap>, 2> dofmaps, const int dim,
-    std::span<const std::int32_t> entities, bool remote)
+    std::span<const std::int32_t> entities, bool remote, int num_threads)
 {
   // Get dofmaps
   const DofMap& dofmap0 = dofmaps.at(0).get();
@@ -318,41 +346,70 @@ std::array<std::vector<std::int32_t>, 2> fem::locate_dofs_topological(
 
   const std::array bs = {dofmap0.bs(), dofmap1.bs()};
 
-  // Get cell index and local entity index
-  std::vector<std::pair<std::int32_t, int>> entity_indices
-      = find_local_entity_index(topology, entities, dim);
-
-  // Iterate over marked facets
+  // Collect the closure dofs of the entities [e0, e1) in both spaces
   const int element_bs = dofmap0.element_dof_layout().block_size();
-  std::array<std::vector<std::int32_t>, 2> bc_dofs;
-  bc_dofs[0].reserve(entities.size()
-                     * dofmap0.element_dof_layout().num_entity_closure_dofs(dim)
-                     * element_bs);
-  bc_dofs[1].reserve(entities.size()
-                     * dofmap0.element_dof_layout().num_entity_closure_dofs(dim)
-                     * element_bs);
-  for (auto [cell, entity_local_index] : entity_indices)
+  auto collect_dofs = [&](std::size_t e0, std::size_t e1)
   {
-    // Get cell dofmap
-    std::span<const std::int32_t> cell_dofs0 = dofmap0.cell_dofs(cell);
-    std::span<const std::int32_t> cell_dofs1 = dofmap1.cell_dofs(cell);
-    assert(bs[0] * cell_dofs0.size() == bs[1] * cell_dofs1.size());
-
-    // Loop over facet dofs and 'unpack' blocked dofs
-    for (int index : entity_dofs[entity_local_index])
+    // Get cell index and local entity index
+    std::vector<std::pair<std::int32_t, int>> entity_indices
+        = find_local_entity_index(topology, entities.subspan(e0, e1 - e0),
+                                  dim);
+
+    std::array<std::vector<std::int32_t>, 2> bc_dofs;
+    const std::size_t num_dofs
+        = (e1 - e0) * dofmap0.element_dof_layout().num_entity_closure_dofs(dim)
+          * element_bs;
+    bc_dofs[0].reserve(num_dofs);
+    bc_dofs[1].reserve(num_dofs);
+    for (auto [cell, entity_local_index] : entity_indices)
     {
-      for (int k = 0; k < element_bs; ++k)
+      // Get cell dofmap
+      std::span<const std::int32_t> cell_dofs0 = dofmap0.cell_dofs(cell);
+      std::span<const std::int32_t> cell_dofs1 = dofmap1.cell_dofs(cell);
+      assert(bs[0] * cell_dofs0.size() == bs[1] * cell_dofs1.size());
+
+      // Loop over facet dofs and 'unpack' blocked dofs
+      for (int index : entity_dofs[entity_local_index])
       {
-        const int local_pos = element_bs * index + k;
-        const std::div_t pos0 = std::div(local_pos, bs[0]);
-        const std::div_t pos1 = std::div(local_pos, bs[1]);
-        std::int32_t dof_index0 = bs[0] * cell_dofs0[pos0.quot] + pos0.rem;
-        std::int32_t dof_index1 = bs[1] * cell_dofs1[pos1.quot] + pos1.rem;
-        bc_dofs[0].push_back(dof_index0);
-        bc_dofs[1].push_back(dof_index1);
+        for (int k = 0; k < element_bs; ++k)
+        {
+          const int local_pos = element_bs * index + k;
+          const std::div_t pos0 = std::div(local_pos, bs[0]);
+          const std::div_t pos1 = std::div(local_pos, bs[1]);
+          std::int32_t dof_index0 = bs[0] * cell_dofs0[pos0.quot] + pos0.rem;
+          std::int32_t dof_index1 = bs[1] * cell_dofs1[pos1.quot] + pos1.rem;
+          bc_dofs[0].push_back(dof_index0);
+          bc_dofs[1].push_back(dof_index1);
+        }
       }
     }
+
+    return bc_dofs;
+  };
+
+  // Iterate over marked entities, with each thread collecting the dofs
+  // of a contiguous block of entities
+  std::array<std::vector<std::int32_t>, 2> bc_dofs;
+  if (num_threads > 1)
+  {
+    std::vector<std::array<std::vector<std::int32_t>, 2>> thread_dofs(
+        num_threads);
+    common::thread_pool().run(
+        num_threads,
+        [&](int t)
+        {
+          auto [e0, e1]
+              = dolfinx::MPI::local_range(t, entities.size(), num_threads);
+          thread_dofs[t] = collect_dofs(e0, e1);
+        });
+    for (auto& d : thread_dofs)
+    {
+      for (std::size_t b = 0; b < 2; ++b)
+        bc_dofs[b].insert(bc_dofs[b].end(), d[b].begin(), d[b].end());
+    }
   }
+  else
+    bc_dofs = collect_dofs(0, entities.size());
 
   // TODO: is removing duplicates at this point worth the effort?
   // Remove duplicates
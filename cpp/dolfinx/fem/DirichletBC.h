@@ -50,12 +50,15 @@ namespace dolfinx::fem
 /// @return Array of DOF index blocks (local to the MPI rank) in the
 /// space V. The array uses the block size of the dofmap associated
 /// with V.
+/// @param[in] num_threads Number of threads used to collect the dofs
+/// of the entities. The entities are divided into contiguous blocks,
+/// one per thread.
 /// @pre The topology cell->entity and entity->cell connectivity must
 /// have been computed before calling this function.
 std::vector<std::int32_t>
 locate_dofs_topological(const mesh::Topology& topology, const DofMap& dofmap,
                         int dim, std::span<const std::int32_t> entities,
-                        bool remote = true);
+                        bool remote = true, int num_threads = 1);
 
 /// @brief Find degrees-of-freedom which belong to the provided mesh
 /// entities (topological).
@@ -81,12 +84,16 @@ locate_dofs_topological(const mesh::Topology& topology, const DofMap& dofmap,
 /// V[0] and V[1]. The array[0](i) entry is the DOF index in the space
 /// V[0] and array[1](i) is the corresponding DOF entry in the space
 /// V[1]. The returned dofs are 'unrolled', i.e. block size = 1.
+/// @param[in] num_threads Number of threads used to collect the dofs
+/// of the entities. The entities are divided into contiguous blocks,
+/// one per thread.
 /// @pre The topology cell->entity and entity->cell connectivity must
 /// have been computed before calling this function.
 std::array<std::vector<std::int32_t>, 2> locate_dofs_topological(
     const mesh::Topology& topology,
     std::array<std::reference_wrapper<const DofMap>, 2> dofmaps, int dim,
-    std::span<const std::int32_t> entities, bool remote = true);
+    std::span<const std::int32_t> entities, bool remote = true,
+    int num_threads = 1);
 
 /// @brief Find degrees of freedom whose geometric coordinate is true
 /// for the provided marking function.
@@ -137,6 +144,85 @@ std::vector<std::int32_t> locate_dofs_geometrical(const FunctionSpace<T>& V,
   return dofs;
 }
 
+/// @brief Find degrees of freedom of a set of candidate cells whose
+/// geometric coordinate is true for the provided marking function.
+///
+/// Only the coordinates of the dofs of the candidate cells are computed
+/// and passed to the marking function, which is much cheaper than
+/// locating the dofs of the whole space if the marked dofs lie in a
+/// small part of the mesh. The candidate cells are usually found with
+/// a spatial query, e.g. the cells that collide with a bounding box of
+/// the region of interest (see geometry::compute_collisions), or the
+/// cells of the boundary facets.
+///
+/// @param[in] V The function (sub)space on which degrees of freedom
+/// will be located.
+/// @param[in] marker_fn Function marking tabulated degrees of freedom
+/// @param[in] cells Candidate cells (local to the process). Degrees of
+/// freedom that are not in a candidate cell are not marked.
+/// @return Array of DOF index blocks (local to the MPI rank) in the
+/// space V. The array uses the block size of the dofmap associated
+/// with V.
+template <std::floating_point T, typename U>
+std::vector<std::int32_t>
+locate_dofs_geometrical(const FunctionSpace<T>& V, U marker_fn,
+                        std::span<const std::int32_t> cells)
+{
+  assert(V.element());
+  if (V.element()->is_mixed())
+  {
+    throw std::runtime_error(
+        "Cannot locate dofs geometrically for mixed space. Use subspaces.");
+  }
+
+  // Dofs of the candidate cells
+  std::shared_ptr<const DofMap> dofmap = V.dofmap();
+  assert(dofmap);
+  std::vector<std::int32_t> cell_dofs;
+  cell_dofs.reserve(cells.size() * dofmap->map().extent(1));
+  for (std::int32_t c : cells)
+  {
+    std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+    cell_dofs.insert(cell_dofs.end(), dofs.begin(), dofs.end());
+  }
+  std::ranges::sort(cell_dofs);
+  auto [unique_end, range_end] = std::ranges::unique(cell_dofs);
+  cell_dofs.erase(unique_end, range_end);
+
+  // Compute coordinates of the candidate dofs
+  const std::vector<T> dof_coordinates
+      = V.tabulate_dof_coordinates(true, cells);
+  const std::size_t num_dofs = dof_coordinates.size() / 3;
+  std::vector<T> x_b(3 * cell_dofs.size());
+  for (std::size_t j = 0; j < 3; ++j)
+  {
+    for (std::size_t i = 0; i < cell_dofs.size(); ++i)
+    {
+      x_b[j * cell_dofs.size() + i]
+          = dof_coordinates[j * num_dofs + cell_dofs[i]];
+    }
+  }
+
+  using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const T,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+          std::size_t, 3, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>;
+
+  // Compute marker for each candidate dof coordinate
+  cmdspan3x_t x(x_b.data(), 3, cell_dofs.size());
+  const std::vector<std::int8_t> marked_dofs = marker_fn(x);
+
+  std::vector<std::int32_t> dofs;
+  dofs.reserve(std::count(marked_dofs.begin(), marked_dofs.end(), true));
+  for (std::size_t i = 0; i < marked_dofs.size(); ++i)
+  {
+    if (marked_dofs[i])
+      dofs.push_back(cell_dofs[i]);
+  }
+
+  return dofs;
+}
+
 /// Finds degrees of freedom whose geometric coordinate is true for the
 /// provided marking function.
 ///
@@ -282,6 +368,35 @@ private:
     return dofs_unrolled;
   }
 
+  /// Compute the cells (local indices, including ghosts) that have at
+  /// least one degree-of-freedom in `dofs` (unrolled).
+  static std::vector<std::int32_t>
+  compute_cells(const DofMap& dofmap, std::span<const std::int32_t> dofs)
+  {
+    const int bs = dofmap.bs();
+    auto map = dofmap.index_map;
+    assert(map);
+    std::vector<std::int8_t> marker(
+        dofmap.index_map_bs() * (map->size_local() + map->num_ghosts()),
+        false);
+    for (std::int32_t d : dofs)
+      marker[d] = true;
+
+    std::vector<std::int32_t> cells;
+    auto dofs_c = dofmap.map();
+    for (std::size_t c = 0; c < dofs_c.extent(0); ++c)
+    {
+      bool has_bc = false;
+      for (std::size_t j = 0; j < dofs_c.extent(1) and !has_bc; ++j)
+        for (int k = 0; k < bs; ++k)
+          has_bc = has_bc or marker[bs * dofs_c(c, j) + k];
+      if (has_bc)
+        cells.push_back(c);
+    }
+
+    return cells;
+  }
+
 public:
   /// @brief Create a representation of a Dirichlet boundary condition
   /// constrained by a scalar- or vector-valued constant.
@@ -361,6 +476,8 @@ public:
       _owned_indices0 *= bs;
       _dofs0 = unroll_dofs(_dofs0, bs);
     }
+
+    _cells = compute_cells(*_function_space->dofmap(), _dofs0);
   }
 
   /// @brief Create a representation of a Dirichlet boundary condition
@@ -391,6 +508,8 @@ public:
       _owned_indices0 *= bs;
       _dofs0 = unroll_dofs(_dofs0, bs);
     }
+
+    _cells = compute_cells(*_function_space->dofmap(), _dofs0);
   }
 
   /// @brief Create a representation of a Dirichlet boundary condition
@@ -422,7 +541,8 @@ public:
             V_g_dofs[0])),
         _dofs1_g(std::forward<typename std::remove_reference_t<X>::value_type>(
             V_g_dofs[1])),
-        _owned_indices0(num_owned(*_function_space->dofmap(), _dofs0))
+        _owned_indices0(num_owned(*_function_space->dofmap(), _dofs0)),
+        _cells(compute_cells(*_function_space->dofmap(), _dofs0))
   {
   }
 
@@ -471,6 +591,17 @@ public:
     return {_dofs0, _owned_indices0};
   }
 
+  /// @brief Cells that have at least one degree-of-freedom constrained
+  /// by the boundary condition.
+  ///
+  /// The cells are computed when the boundary condition is created and
+  /// are used to restrict the cells that are visited when applying
+  /// lifting.
+  ///
+  /// @return Sorted cell indices (local, including ghosts) of the mesh
+  /// of the constrained function space.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
   /// @brief Set entries in an array that are constrained by Dirichlet
   /// boundary conditions.
   ///
@@ -504,12 +635,14 @@ public:
           std::is_same_v<std::invoke_result_t<decltype(set_fn), std::int32_t>,
                          T>);
 
-      std::int32_t x_size = x.size();
-      for (std::size_t i = 0; i < _dofs0.size(); ++i)
-      {
-        if (_dofs0[i] < x_size)
-          x[_dofs0[i]] = set_fn(i);
-      }
+      // _dofs0 is sorted, so the dofs that are in x are a leading
+      // range. Looping over the range without a branch allows the
+      // gather/scatter to be vectorised.
+      const std::size_t num_dofs = std::distance(
+          _dofs0.begin(), std::ranges::lower_bound(
+                              _dofs0, static_cast<std::int32_t>(x.size())));
+      for (std::size_t i = 0; i < num_dofs; ++i)
+        x[_dofs0[i]] = set_fn(i);
     };
 
     if (alpha == T(0)) // Optimisation for when alpha == 0
@@ -555,7 +688,20 @@ public:
       auto g = std::get<std::shared_ptr<const Constant<T>>>(_g);
       const std::vector<T>& value = g->value;
       std::int32_t bs = _function_space->dofmap()->bs();
-      if (x0)
+      if (bs == 1)
+      {
+        // Avoid the modulo in the index computation for scalar spaces
+        const T v = value.front();
+        if (x0)
+        {
+          assert(x.size() <= x0->size());
+          apply([x0 = *x0, v, alpha, &dofs0 = _dofs0](std::int32_t i) -> T
+                { return alpha * (v - x0[dofs0[i]]); });
+        }
+        else
+          apply([v = alpha * v](std::int32_t) -> T { return v; });
+      }
+      else if (x0)
       {
         assert(x.size() <= x0->size());
         apply(
@@ -611,5 +757,8 @@ private:
 
   // The first _owned_indices in _dofs are owned by this process
   std::int32_t _owned_indices0 = -1;
+
+  // Cells with at least one constrained degree-of-freedom
+  std::vector<std::int32_t> _cells;
 };
 } // namespace dolfinx::fem
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Topology.h>
@@ -46,9 +47,7 @@ fem::DofMap build_collapsed_dofmap(const DofMap& dofmap_view,
   std::vector<std::int32_t> dofs_view(dofs_view_md.data_handle(),
                                       dofs_view_md.data_handle()
                                           + dofs_view_md.size());
-  dolfinx::radix_sort(dofs_view);
-  auto [unique_end, range_end] = std::ranges::unique(dofs_view);
-  dofs_view.erase(unique_end, range_end);
+  dolfinx::sort_unique(dofs_view);
 
   // Get block size
   int bs_view = dofmap_view.index_map_bs();
@@ -285,3 +284,16 @@ DofMap::map() const
 //-----------------------------------------------------------------------------
 int DofMap::index_map_bs() const { return _index_map_bs; }
 //-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> DofMap::memory_usage() const
+{
+  std::map<std::string, std::size_t> usage
+      = {{"dofmap", common::container_memory(_dofmap)}};
+  std::size_t& map = usage["index map"];
+  if (index_map)
+  {
+    for (auto [member, bytes] : index_map->memory_usage())
+      map += bytes;
+  }
+  return usage;
+}
+//-----------------------------------------------------------------------------
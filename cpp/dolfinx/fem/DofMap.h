@@ -17,9 +17,11 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/ordering.h>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mpi.h>
 #include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -101,7 +103,11 @@ public:
         _shape1(_element_dof_layout.num_dofs()
                 * _element_dof_layout.block_size() / _bs)
   {
-    // Do nothing
+    // Detect dofs that are numbered contiguously by cell, e.g. for
+    // discontinuous elements (see fem::create_dofmap)
+    _contiguous = true;
+    for (std::size_t i = 0; i < _dofmap.size() and _contiguous; ++i)
+      _contiguous = _dofmap[i] == static_cast<std::int32_t>(i);
   }
 
   // Copy constructor
@@ -135,6 +141,17 @@ public:
   /// @brief Return the block size for the dofmap
   int bs() const noexcept;
 
+  /// @brief Whether the dofs of each cell are a contiguous block,
+  /// numbered by cell.
+  ///
+  /// If true, the dofs of cell `c` are `c * n + i` for `0 <= i < n`,
+  /// where `n = map().extent(1)`, so that the values of a cell are the
+  /// contiguous block `[c * n * bs(), (c + 1) * n * bs())` of a vector.
+  /// This is the case for dofmaps of discontinuous elements created by
+  /// fem::create_dofmap. Assemblers and coefficient packing copy the
+  /// blocks directly, without indirection through the dofmap.
+  bool contiguous() const noexcept { return _contiguous; }
+
   /// @brief Extract subdofmap component
   /// @param[in] component The component indices
   /// @return The dofmap for the component
@@ -172,6 +189,11 @@ public:
   /// @brief Block size associated with the index_map
   int index_map_bs() const;
 
+  /// @brief Memory (bytes) used by the dofmap on this process, by
+  /// member. The index map is included.
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const;
+
 private:
   // Block size for the IndexMap
   int _index_map_bs = -1;
@@ -187,5 +209,8 @@ private:
 
   // Number of columns in _dofmap
   int _shape1 = -1;
+
+  // True if _dofmap[i] == i
+  bool _contiguous = false;
 };
 } // namespace dolfinx::fem
@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "DofMapCache.h"
+#include "ElementDofLayout.h"
+#include <algorithm>
+#include <cassert>
+#include <dolfinx/mesh/Topology.h>
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<const fem::DofMap>
+fem::DofMapCache::dofmap(std::shared_ptr<const mesh::Topology> topology,
+                         const std::string& signature,
+                         const ElementDofLayout& layout,
+                         const std::function<DofMap()>& create)
+{
+  assert(topology);
+  std::scoped_lock lock(_mutex);
+  std::pair key(topology.get(), signature);
+  if (auto it = _dofmaps.find(key); it != _dofmaps.end())
+  {
+    // The address of a destroyed topology may be reused by a new
+    // topology, so the topology of the entry is checked
+    std::shared_ptr<const DofMap> dofmap = it->second.dofmap.lock();
+    if (dofmap and it->second.topology.lock() == topology)
+    {
+      if (dofmap->element_dof_layout() == layout)
+        return dofmap;
+      else
+        return std::make_shared<const DofMap>(create());
+    }
+  }
+
+  // Remove the entries of destroyed topologies and dofmaps
+  std::erase_if(_dofmaps,
+                [](auto& e) {
+                  return e.second.topology.expired()
+                         or e.second.dofmap.expired();
+                });
+
+  auto dofmap = std::make_shared<const DofMap>(create());
+  _dofmaps.insert_or_assign(key, dofmap_t{topology, dofmap});
+  return dofmap;
+}
+//-----------------------------------------------------------------------------
+std::pair<std::shared_ptr<const fem::DofMap>,
+          std::shared_ptr<const std::vector<std::int32_t>>>
+fem::DofMapCache::collapsed(
+    std::shared_ptr<const DofMap> root, const std::vector<int>& component,
+    const std::function<std::pair<DofMap, std::vector<std::int32_t>>()>&
+        collapse)
+{
+  assert(root);
+  std::scoped_lock lock(_mutex);
+  std::pair key(root.get(), component);
+  if (auto it = _collapsed.find(key); it != _collapsed.end())
+  {
+    std::shared_ptr<const collapsed_data_t> data = it->second.data.lock();
+    if (data and it->second.root.lock() == root)
+      return {std::shared_ptr<const DofMap>(data, &data->dofmap),
+              std::shared_ptr<const std::vector<std::int32_t>>(data,
+                                                               &data->dofs)};
+  }
+
+  // Remove the entries of destroyed dofmaps
+  std::erase_if(_collapsed, [](auto& e)
+                { return e.second.root.expired() or e.second.data.expired(); });
+
+  auto [dofmap, dofs] = collapse();
+  auto data = std::make_shared<const collapsed_data_t>(std::move(dofmap),
+                                                       std::move(dofs));
+  _collapsed.insert_or_assign(key, collapsed_t{root, data});
+  return {std::shared_ptr<const DofMap>(data, &data->dofmap),
+          std::shared_ptr<const std::vector<std::int32_t>>(data, &data->dofs)};
+}
+//-----------------------------------------------------------------------------
+void fem::DofMapCache::clear()
+{
+  std::scoped_lock lock(_mutex);
+  _dofmaps.clear();
+  _collapsed.clear();
+}
+//-----------------------------------------------------------------------------
+std::size_t fem::DofMapCache::size() const
+{
+  std::scoped_lock lock(_mutex);
+  return std::ranges::count_if(_dofmaps, [](auto& e)
+                               { return !e.second.dofmap.expired(); })
+         + std::ranges::count_if(_collapsed, [](auto& e)
+                                 { return !e.second.data.expired(); });
+}
+//-----------------------------------------------------------------------------
+fem::DofMapCache& fem::dofmap_cache()
+{
+  static DofMapCache cache;
+  return cache;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+class Topology;
+}
+
+namespace dolfinx::fem
+{
+class ElementDofLayout;
+
+/// @brief Cache of the dofmaps of elements on mesh topologies, and of
+/// collapsed sub-dofmaps.
+///
+/// Building a dofmap requires a traversal of the topology and a
+/// parallel numbering of the dofs, which is repeated for every function
+/// space with the same element on the same mesh. The cache stores one
+/// dofmap per topology and element signature (see
+/// FiniteElement::signature), so that the function spaces share the
+/// dofmap, and its index map, and therefore also data that is created
+/// from the dofmap such as sparsity patterns. It is used by
+/// fem::create_functionspace. The collapsed dofmaps of subspaces are
+/// cached on the dofmap of the root space and the component, and are
+/// used by FunctionSpace::collapse.
+///
+/// The cache holds only weak references to the topologies and dofmaps.
+/// A cached dofmap is shared only while a function space (or another
+/// user) holds it, and entries are discarded once the dofmap, or the
+/// topology (or root dofmap), is destroyed. The cache therefore does not
+/// extend the lifetime of dofmaps, and does not own index maps or MPI
+/// communicators.
+///
+/// @warning The dofmaps are not rebuilt if the topology is modified
+/// after an entry is created. Call DofMapCache::clear if the topology
+/// is changed.
+///
+/// @note The cache is thread-safe.
+class DofMapCache
+{
+public:
+  /// Create an empty cache
+  DofMapCache() = default;
+
+  /// @brief Get the dofmap of an element on a topology, creating it if
+  /// it is not in the cache.
+  ///
+  /// A cached dofmap is returned only if its element dof layout is
+  /// equal to `layout`. Otherwise a new dofmap is created, which is not
+  /// cached.
+  /// @param[in] topology Mesh topology.
+  /// @param[in] signature Signature of the element.
+  /// @param[in] layout Dof layout of the element.
+  /// @param[in] create Function that creates the dofmap.
+  /// @return The dofmap.
+  std::shared_ptr<const DofMap>
+  dofmap(std::shared_ptr<const mesh::Topology> topology,
+         const std::string& signature, const ElementDofLayout& layout,
+         const std::function<DofMap()>& create);
+
+  /// @brief Get the collapsed dofmap of a subspace, collapsing it if
+  /// it is not in the cache.
+  /// @param[in] root Dofmap of the root space of the subspace.
+  /// @param[in] component Component of the subspace with respect to
+  /// the root space.
+  /// @param[in] collapse Function that collapses the sub-dofmap, and
+  /// returns the collapsed dofmap and the map from collapsed to
+  /// sub-dofmap dofs.
+  /// @return The collapsed dofmap and the map from collapsed to
+  /// sub-dofmap dofs.
+  std::pair<std::shared_ptr<const DofMap>,
+            std::shared_ptr<const std::vector<std::int32_t>>>
+  collapsed(std::shared_ptr<const DofMap> root,
+            const std::vector<int>& component,
+            const std::function<
+                std::pair<DofMap, std::vector<std::int32_t>>()>& collapse);
+
+  /// Remove all entries
+  void clear();
+
+  /// Number of entries with a dofmap that is in use
+  std::size_t size() const;
+
+private:
+  // Dofmap of (topology, element signature)
+  struct dofmap_t
+  {
+    std::weak_ptr<const mesh::Topology> topology;
+    std::weak_ptr<const DofMap> dofmap;
+  };
+
+  // Collapsed dofmap and the map from collapsed to sub-dofmap dofs,
+  // which are handed out as aliases of the bundle so that the entry is
+  // alive while either is in use
+  struct collapsed_data_t
+  {
+    DofMap dofmap;
+    std::vector<std::int32_t> dofs;
+  };
+
+  // Collapsed dofmap of (root dofmap, component)
+  struct collapsed_t
+  {
+    std::weak_ptr<const DofMap> root;
+    std::weak_ptr<const collapsed_data_t> data;
+  };
+
+  mutable std::mutex _mutex;
+  std::map<std::pair<const mesh::Topology*, std::string>, dofmap_t>
+      _dofmaps;
+  std::map<std::pair<const DofMap*, std::vector<int>>, collapsed_t>
+      _collapsed;
+};
+
+/// @brief Cache of dofmaps shared by all function spaces.
+DofMapCache& dofmap_cache();
+} // namespace dolfinx::fem
@@ -7,10 +7,13 @@
 #pragma once
 
 #include "Constant.h"
+#include "DofMap.h"
 #include "Function.h"
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <functional>
@@ -145,29 +148,164 @@ public:
 
   /// @brief Evaluate Expression on cells or facets.
   ///
+  /// The kernel writes the values of each entity directly into its row
+  /// of `values`, so rows of a larger caller-owned array can be
+  /// filled, e.g. with `vshape[1]` larger than the number of values
+  /// per entity.
+  ///
   /// @param[in] mesh Cells on which to evaluate the Expression.
   /// @param[in] entities List of entities to evaluate the expression
   /// on. This could be either a list of cells or a list of (cell, local
-  /// @param[out] values A 2D array to store the result. Caller is
-  /// responsible for correct sizing which should be `(num_cells,
-  /// num_points * value_size * num_all_argument_dofs columns)`.
   /// facet index) tuples. Array is flattened per entity.
+  /// @param[out] values A 2D array to store the result. Caller is
+  /// responsible for correct sizing, which should be at least
+  /// `(num_entities, num_points * value_size * num_all_argument_dofs)`.
+  /// Entries beyond the values of each entity in a row are not
+  /// modified.
   /// @param[in] vshape The shape of `values` (row-major storage).
+  /// @param[in] num_threads Number of threads used to pack the
+  /// coefficients and to evaluate the Expression. The entities are
+  /// divided into `num_threads` contiguous blocks.
   void eval(const mesh::Mesh<geometry_type>& mesh,
             std::span<const std::int32_t> entities,
-            std::span<scalar_type> values,
-            std::array<std::size_t, 2> vshape) const
+            std::span<scalar_type> values, std::array<std::size_t, 2> vshape,
+            int num_threads = 1) const
+  {
+    const std::size_t num_entities = entities.size() / estride(mesh);
+    const std::size_t num_values = this->num_values();
+    if (vshape[0] < num_entities or vshape[1] < num_values
+        or values.size() < vshape[0] * vshape[1])
+    {
+      throw std::runtime_error("Array for Expression values is too small.");
+    }
+
+    eval_entities(
+        mesh, entities, num_threads,
+        [&](std::size_t e, std::span<scalar_type>)
+        { return values.subspan(e * vshape[1], num_values); },
+        [](std::size_t, std::span<const scalar_type>)
+        {
+          // Values are evaluated in place
+        });
+  }
+
+  /// @brief Evaluate Expression on cells and write the values directly
+  /// to the degree-of-freedom array of a Function.
+  ///
+  /// The values of the Expression on a cell are written to the
+  /// degrees-of-freedom of the cell in the (block size unrolled)
+  /// dofmap order, without an intermediate array for all cells. This
+  /// is the interpolation of the Expression into spaces where the
+  /// degrees-of-freedom are the values at the evaluation points, i.e.
+  /// spaces with identity interpolation and identity maps and without
+  /// dof transformations, such as quadrature spaces.
+  ///
+  /// @param[in] mesh Mesh on which to evaluate the Expression.
+  /// @param[in] entities Cells of `mesh` to evaluate the Expression on.
+  /// @param[out] u Degree-of-freedom array to write values to.
+  /// @param[in] dofmap Dofmap for `u`. The number of degrees-of-freedom
+  /// per cell (including the block size) must be equal to the number of
+  /// Expression values per cell.
+  /// @param[in] cells Cells of the mesh of `dofmap` to write values on,
+  /// where `cells[i]` is the same cell as `entities[i]`.
+  /// @param[in] num_threads Number of threads used to pack the
+  /// coefficients and to evaluate the Expression.
+  void eval(const mesh::Mesh<geometry_type>& mesh,
+            std::span<const std::int32_t> entities, std::span<scalar_type> u,
+            const DofMap& dofmap, std::span<const std::int32_t> cells,
+            int num_threads = 1) const
+  {
+    if (estride(mesh) != 1)
+      throw std::runtime_error("Expression must be evaluated on cells.");
+    if (cells.size() != entities.size())
+      throw std::runtime_error("Cells lists have different lengths.");
+    const int bs = dofmap.bs();
+    if (std::size_t(dofmap.element_dof_layout().num_dofs() * bs)
+        != num_values())
+    {
+      throw std::runtime_error(
+          "Number of dofs per cell not equal to number of Expression values.");
+    }
+
+    eval_entities(
+        mesh, entities, num_threads,
+        [](std::size_t, std::span<scalar_type> buffer) { return buffer; },
+        [&](std::size_t e, std::span<const scalar_type> values)
+        {
+          std::span<const std::int32_t> dofs = dofmap.cell_dofs(cells[e]);
+          for (std::size_t i = 0; i < dofs.size(); ++i)
+            for (int k = 0; k < bs; ++k)
+              u[bs * dofs[i] + k] = values[bs * i + k];
+        });
+  }
+
+  /// @brief Get function for tabulate_expression.
+  /// @return fn Function to tabulate expression.
+  const std::function<void(scalar_type*, const scalar_type*, const scalar_type*,
+                           const geometry_type*, const int*, const uint8_t*)>&
+  get_tabulate_expression() const
+  {
+    return _fn;
+  }
+
+  /// @brief Get value size
+  /// @return The value size.
+  int value_size() const
+  {
+    return std::reduce(_value_shape.begin(), _value_shape.end(), 1,
+                       std::multiplies{});
+  }
+
+  /// @brief Get value shape.
+  /// @return The value shape.
+  const std::vector<std::size_t>& value_shape() const { return _value_shape; }
+
+  /// @brief Evaluation points on the reference cell.
+  /// @return Evaluation points.
+  std::pair<std::vector<geometry_type>, std::array<std::size_t, 2>> X() const
+  {
+    return _x_ref;
+  }
+
+private:
+  // Number of entries per entity in the list of entities
+  std::size_t estride(const mesh::Mesh<geometry_type>& mesh) const
   {
-    std::size_t estride;
     if (mesh.topology()->dim() == _x_ref.second[1])
-      estride = 1;
+      return 1;
     else if (mesh.topology()->dim() == _x_ref.second[1] + 1)
-      estride = 2;
+      return 2;
     else
       throw std::runtime_error("Invalid dimension of evaluation points.");
+  }
+
+  // Number of values of the Expression per entity
+  std::size_t num_values() const
+  {
+    std::size_t num_argument_dofs = 1;
+    if (_argument_function_space)
+    {
+      auto dofmap = _argument_function_space->dofmap();
+      num_argument_dofs
+          = dofmap->element_dof_layout().num_dofs() * dofmap->bs();
+    }
+    return _x_ref.second[0] * value_size() * num_argument_dofs;
+  }
+
+  // Evaluate the Expression on entities. For entity `e`, the kernel
+  // writes to the span returned by `target(e, buffer)`, where `buffer`
+  // is a thread-local array of size num_values(), and the values are
+  // then passed to `store(e, values)`.
+  template <typename F, typename G>
+  void eval_entities(const mesh::Mesh<geometry_type>& mesh,
+                     std::span<const std::int32_t> entities, int num_threads,
+                     F&& target, G&& store) const
+  {
+    const std::size_t estride = this->estride(mesh);
 
     // Prepare coefficients and constants
-    auto [coeffs, cstride] = pack_coefficients(*this, entities, estride);
+    auto [coeffs, cstride]
+        = pack_coefficients(*this, entities, estride, num_threads);
     std::vector<scalar_type> constant_data = pack_constants(*this);
     auto fn = this->get_tabulate_expression();
 
@@ -178,12 +316,8 @@ public:
     auto& cmap = mesh.geometry().cmap();
 
     std::size_t num_dofs_g = cmap.dim();
-    auto x_g = mesh.geometry().x();
-
-    // Create data structures used in evaluation
-    std::vector<geometry_type> coord_dofs(3 * num_dofs_g);
+    mesh::NodeCoordinates<geometry_type> x_g = mesh.geometry().coordinates();
 
-    int num_argument_dofs = 1;
     std::span<const std::uint32_t> cell_info;
     std::function<void(std::span<scalar_type>, std::span<const std::uint32_t>,
                        std::int32_t, int)>
@@ -196,10 +330,7 @@ public:
 
     if (_argument_function_space)
     {
-      num_argument_dofs
-          = _argument_function_space->dofmap()->element_dof_layout().num_dofs();
       auto element = _argument_function_space->element();
-      num_argument_dofs *= _argument_function_space->dofmap()->bs();
       assert(element);
       if (element->needs_dof_transformations())
       {
@@ -224,61 +355,50 @@ public:
       { return entities.data() + 2 * idx + 1; };
     }
 
-    // Iterate over cells and 'assemble' into values
-    int size0 = _x_ref.second[0] * value_size();
-    std::vector<scalar_type> values_local(size0 * num_argument_dofs, 0);
-    for (std::size_t e = 0; e < entities.size() / estride; ++e)
+    const std::size_t num_entities = entities.size() / estride;
+    const int size0 = _x_ref.second[0] * value_size();
+    const std::size_t num_values = this->num_values();
+    auto eval_block = [&](std::size_t e0, std::size_t e1)
     {
-      std::int32_t entity = entities[e * estride];
-      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          x_dofmap, entity, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+      // Create data structures used in evaluation
+      std::vector<geometry_type> coord_dofs(3 * num_dofs_g);
+      std::vector<scalar_type> buffer(num_values);
+      for (std::size_t e = e0; e < e1; ++e)
       {
-        std::copy_n(std::next(x_g.begin(), 3 * x_dofs[i]), 3,
-                    std::next(coord_dofs.begin(), 3 * i));
+        std::int32_t entity = entities[e * estride];
+        auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            x_dofmap, entity, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        x_g.copy(x_dofs, coord_dofs.data());
+
+        const scalar_type* coeff_cell = coeffs.data() + e * cstride;
+        const int* entity_index = get_entity_index(entities, e);
+
+        std::span<scalar_type> values_e = target(e, std::span(buffer));
+        std::ranges::fill(values_e, 0);
+        _fn(values_e.data(), coeff_cell, constant_data.data(),
+            coord_dofs.data(), entity_index, nullptr);
+        post_dof_transform(values_e, cell_info, entity, size0);
+        store(e, std::span<const scalar_type>(values_e));
       }
+    };
 
-      const scalar_type* coeff_cell = coeffs.data() + e * cstride;
-      const int* entity_index = get_entity_index(entities, e);
-
-      std::ranges::fill(values_local, 0);
-      _fn(values_local.data(), coeff_cell, constant_data.data(),
-          coord_dofs.data(), entity_index, nullptr);
-      post_dof_transform(values_local, cell_info, e, size0);
-      for (std::size_t j = 0; j < values_local.size(); ++j)
-        values[e * vshape[1] + j] = values_local[j];
+    if (num_threads < 2)
+    {
+      eval_block(0, num_entities);
+    }
+    else
+    {
+      common::thread_pool().run(
+          num_threads,
+          [&](int t)
+          {
+            auto [e0, e1]
+                = dolfinx::MPI::local_range(t, num_entities, num_threads);
+            eval_block(e0, e1);
+          });
     }
   }
 
-  /// @brief Get function for tabulate_expression.
-  /// @return fn Function to tabulate expression.
-  const std::function<void(scalar_type*, const scalar_type*, const scalar_type*,
-                           const geometry_type*, const int*, const uint8_t*)>&
-  get_tabulate_expression() const
-  {
-    return _fn;
-  }
-
-  /// @brief Get value size
-  /// @return The value size.
-  int value_size() const
-  {
-    return std::reduce(_value_shape.begin(), _value_shape.end(), 1,
-                       std::multiplies{});
-  }
-
-  /// @brief Get value shape.
-  /// @return The value shape.
-  const std::vector<std::size_t>& value_shape() const { return _value_shape; }
-
-  /// @brief Evaluation points on the reference cell.
-  /// @return Evaluation points.
-  std::pair<std::vector<geometry_type>, std::array<std::size_t, 2>> X() const
-  {
-    return _x_ref;
-  }
-
-private:
   // Function space for Argument
   std::shared_ptr<const FunctionSpace<geometry_type>> _argument_function_space;
 
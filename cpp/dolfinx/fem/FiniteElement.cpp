@@ -11,8 +11,11 @@
 #include <basix/interpolation.h>
 #include <basix/polyset.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <functional>
 #include <numeric>
+#include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -82,6 +85,30 @@ _extract_sub_element(const FiniteElement<T>& finite_element,
   return _extract_sub_element(*sub_element, sub_component);
 }
 
+/// @brief String of a list of sizes, e.g. `(2,2)`.
+std::string _to_string(std::span<const std::size_t> x)
+{
+  std::string s = "(";
+  for (std::size_t i = 0; i < x.size(); ++i)
+    s += (i == 0 ? "" : ",") + std::to_string(x[i]);
+  return s + ")";
+}
+
+/// @brief String of the number of dofs on each entity, for each entity
+/// dimension, e.g. `((1,1,1)(0,0,0)(0))` for a P1 triangle.
+std::string _to_string(const std::vector<std::vector<std::vector<int>>>& x)
+{
+  std::string s = "(";
+  for (auto& entities : x)
+  {
+    std::vector<std::size_t> sizes;
+    for (auto& dofs : entities)
+      sizes.push_back(dofs.size());
+    s += _to_string(sizes);
+  }
+  return s + ")";
+}
+
 int _compute_block_size(std::optional<std::vector<std::size_t>> value_shape,
                         bool symmetric)
 {
@@ -152,11 +179,27 @@ FiniteElement<T>::FiniteElement(
     family = "Discontinuous Lagrange";
     break;
   default:
-    family = "unknown";
+    family = "family " + std::to_string(static_cast<int>(element.family()));
     break;
   }
 
-  _signature = "Basix element " + family + " " + std::to_string(_bs);
+  // The signature identifies the element, and is used to share the
+  // dofmaps of elements (see fem::DofMapCache). Elements of the same
+  // family and degree, e.g. custom elements, are distinguished by the
+  // value shape, the number of dofs on each entity and the Basix hash.
+  _signature = "Basix element " + family + " "
+               + mesh::to_string(_cell_type) + " "
+               + std::to_string(element.degree()) + " "
+               + std::to_string(static_cast<int>(element.lagrange_variant()))
+               + " " + std::to_string(static_cast<int>(element.dpc_variant()))
+               + (element.discontinuous() ? " discontinuous " : " ")
+               + std::to_string(_bs) + (_symmetric ? " symmetric" : "")
+               + " shape " + _to_string(*_value_shape) + " dofs "
+               + _to_string(_entity_dofs) + " hash "
+               + std::to_string(element.hash());
+
+  if (_needs_dof_transformations)
+    compute_entity_transformations();
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
@@ -258,6 +301,95 @@ FiniteElement<T>::FiniteElement(mesh::CellType cell_type,
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
+void FiniteElement<T>::compute_entity_transformations()
+{
+  assert(_element);
+  const std::size_t dim = _element->dim();
+  const int tdim = mesh::cell_dim(_cell_type);
+
+  // Sub-entities with transformations, and the position and mask of
+  // their bits in the cell permutation data. Faces (3D) use three bits
+  // each, followed by one bit for each edge.
+  std::vector<EntityTransformation> transformations;
+  const int num_faces = tdim == 3 ? _entity_dofs[2].size() : 0;
+  for (int f = 0; f < num_faces; ++f)
+    transformations.push_back({_entity_dofs[2][f], 3 * f, 7, {}});
+  if (tdim > 1)
+  {
+    for (std::size_t e = 0; e < _entity_dofs[1].size(); ++e)
+    {
+      transformations.push_back(
+          {_entity_dofs[1][e], 3 * num_faces + static_cast<int>(e), 1, {}});
+    }
+  }
+  std::erase_if(transformations, [](auto& et) { return et.dofs.empty(); });
+
+  // Compute the transformations by applying the Basix transformations
+  // to the columns of the identity for the DOFs of each sub-entity
+  std::vector<T> data;
+  for (EntityTransformation& et : transformations)
+  {
+    const std::size_t k = et.dofs.size();
+    if (k > max_entity_dofs)
+      return;
+
+    for (int t = 0; t < 4; ++t)
+    {
+      et.matrices[t].resize(et.mask + 1);
+      for (std::uint32_t state = 1; state <= et.mask; ++state)
+      {
+        data.assign(dim * k, 0);
+        for (std::size_t c = 0; c < k; ++c)
+          data[et.dofs[c] * k + c] = 1;
+
+        std::span<T> u(data);
+        const std::uint32_t cell_permutation = state << et.shift;
+        switch (static_cast<doftransform>(t))
+        {
+        case doftransform::standard:
+          _element->T_apply(u, k, cell_permutation);
+          break;
+        case doftransform::transpose:
+          _element->Tt_apply(u, k, cell_permutation);
+          break;
+        case doftransform::inverse:
+          _element->Tinv_apply(u, k, cell_permutation);
+          break;
+        case doftransform::inverse_transpose:
+          _element->Tt_inv_apply(u, k, cell_permutation);
+          break;
+        }
+
+        // Extract the (k, k) block, and check that the transformation
+        // does not change other DOFs
+        std::vector<T> M(k * k);
+        for (std::size_t r = 0; r < k; ++r)
+        {
+          std::copy_n(std::next(data.begin(), et.dofs[r] * k), k,
+                      std::next(M.begin(), r * k));
+          std::fill_n(std::next(data.begin(), et.dofs[r] * k), k, 0);
+        }
+        if (std::ranges::any_of(data, [](auto x) { return x != 0; }))
+        {
+          spdlog::info("DOF transformations are not local to sub-entities "
+                       "and are not precomputed.");
+          return;
+        }
+
+        bool identity = true;
+        for (std::size_t r = 0; r < k; ++r)
+          for (std::size_t c = 0; c < k; ++c)
+            identity = identity and M[r * k + c] == (r == c ? 1 : 0);
+        if (!identity)
+          et.matrices[t][state] = std::move(M);
+      }
+    }
+  }
+
+  _entity_transformations = std::move(transformations);
+}
+//-----------------------------------------------------------------------------
+template <std::floating_point T>
 bool FiniteElement<T>::operator==(const FiniteElement& e) const
 {
   if (!_element or !e._element)
@@ -367,7 +499,10 @@ void FiniteElement<T>::tabulate(std::span<T> values, std::span<const T> X,
                                 int order) const
 {
   assert(_element);
-  _element->tabulate(order, X, shape, values);
+  auto [tab, tshape] = _tabulation_cache->get(
+      order, X, shape, [&]() { return _element->tabulate(order, X, shape); });
+  assert(values.size() == tab->size());
+  std::ranges::copy(*tab, values.begin());
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
@@ -376,7 +511,9 @@ FiniteElement<T>::tabulate(std::span<const T> X,
                            std::array<std::size_t, 2> shape, int order) const
 {
   assert(_element);
-  return _element->tabulate(order, X, shape);
+  auto [tab, tshape] = _tabulation_cache->get(
+      order, X, shape, [&]() { return _element->tabulate(order, X, shape); });
+  return {*tab, tshape};
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
@@ -404,8 +541,8 @@ FiniteElement<T>::extract_sub_element(const std::vector<int>& component) const
 {
   // Recursively extract sub element
   auto sub_finite_element = _extract_sub_element(*this, component);
-  spdlog::debug("Extracted finite element for sub-system: {}",
-                sub_finite_element->signature().c_str());
+  DOLFINX_LOG_DEBUG("Extracted finite element for sub-system: {}",
+                    sub_finite_element->signature().c_str());
   return sub_finite_element;
 }
 //-----------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "TabulationCache.h"
 #include "traits.h"
 #include <array>
 #include <basix/finite-element.h>
@@ -259,6 +260,7 @@ public:
   /// @param[in] shape Shape of `X`.
   /// @param[in] order Number of derivatives (up to and including
   /// this order) to tabulate for.
+  /// @note Recent tabulations are cached (see fem::TabulationCache).
   void tabulate(std::span<geometry_type> values,
                 std::span<const geometry_type> X,
                 std::array<std::size_t, 2> shape, int order) const;
@@ -273,6 +275,7 @@ public:
   /// @param[in] order Number of derivatives (up to and including this
   /// order) to tabulate for.
   /// @return Basis function values and array shape (row-major storage).
+  /// @note Recent tabulations are cached (see fem::TabulationCache).
   std::pair<std::vector<geometry_type>, std::array<std::size_t, 4>>
   tabulate(std::span<const geometry_type> X, std::array<std::size_t, 2> shape,
            int order) const;
@@ -660,7 +663,11 @@ public:
   void T_apply(std::span<U> data, std::uint32_t cell_permutation, int n) const
   {
     assert(_element);
-    _element->T_apply(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::standard, data,
+                                      cell_permutation, n, false))
+    {
+      _element->T_apply(data, n, cell_permutation);
+    }
   }
 
   /// @brief Apply the inverse transpose of the operator applied by
@@ -677,7 +684,11 @@ public:
                     int n) const
   {
     assert(_element);
-    _element->Tt_inv_apply(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::inverse_transpose, data,
+                                      cell_permutation, n, false))
+    {
+      _element->Tt_inv_apply(data, n, cell_permutation);
+    }
   }
 
   /// @brief Apply the transpose of the operator applied by T_apply().
@@ -693,7 +704,11 @@ public:
   void Tt_apply(std::span<U> data, std::uint32_t cell_permutation, int n) const
   {
     assert(_element);
-    _element->Tt_apply(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::transpose, data,
+                                      cell_permutation, n, false))
+    {
+      _element->Tt_apply(data, n, cell_permutation);
+    }
   }
 
   /// @brief Apply the inverse of the operator applied by T_apply().
@@ -709,7 +724,11 @@ public:
                   int n) const
   {
     assert(_element);
-    _element->Tinv_apply(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::inverse, data,
+                                      cell_permutation, n, false))
+    {
+      _element->Tinv_apply(data, n, cell_permutation);
+    }
   }
 
   /// @brief Right(post)-apply the operator applied by T_apply().
@@ -725,7 +744,11 @@ public:
                      int n) const
   {
     assert(_element);
-    _element->T_apply_right(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::standard, data,
+                                      cell_permutation, n, true))
+    {
+      _element->T_apply_right(data, n, cell_permutation);
+    }
   }
 
   /// @brief Right(post)-apply the inverse of the operator applied by
@@ -742,7 +765,11 @@ public:
                         int n) const
   {
     assert(_element);
-    _element->Tinv_apply_right(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::inverse, data,
+                                      cell_permutation, n, true))
+    {
+      _element->Tinv_apply_right(data, n, cell_permutation);
+    }
   }
 
   /// @brief Right(post)-apply the transpose of the operator applied by
@@ -759,7 +786,11 @@ public:
                       int n) const
   {
     assert(_element);
-    _element->Tt_apply_right(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::transpose, data,
+                                      cell_permutation, n, true))
+    {
+      _element->Tt_apply_right(data, n, cell_permutation);
+    }
   }
 
   /// @brief Right(post)-apply the transpose inverse of the operator
@@ -776,7 +807,11 @@ public:
                           int n) const
   {
     assert(_element);
-    _element->Tt_inv_apply_right(data, n, cell_permutation);
+    if (!apply_entity_transformations(doftransform::inverse_transpose, data,
+                                      cell_permutation, n, true))
+    {
+      _element->Tt_inv_apply_right(data, n, cell_permutation);
+    }
   }
 
   /// @brief Permute indices associated with degree-of-freedoms on the
@@ -835,6 +870,80 @@ public:
   dof_permutation_fn(bool inverse = false, bool scalar_element = false) const;
 
 private:
+  // Apply the precomputed transformations of the sub-entity DOFs (see
+  // _entity_transformations). Returns false, without modifying data,
+  // if the transformations are not available for this data.
+  template <typename U>
+  bool apply_entity_transformations(doftransform ttype, std::span<U> data,
+                                    std::uint32_t cell_permutation, int n,
+                                    bool right) const
+  {
+    if (_entity_transformations.empty()
+        or data.size() != std::size_t(n) * _element->dim())
+    {
+      return false;
+    }
+
+    using X = scalar_value_type_t<U>;
+    const std::size_t dim = _element->dim();
+    std::array<U, max_entity_dofs> w;
+    for (const EntityTransformation& et : _entity_transformations)
+    {
+      const std::uint32_t state = (cell_permutation >> et.shift) & et.mask;
+      const std::vector<geometry_type>& M
+          = et.matrices[static_cast<int>(ttype)][state];
+      if (M.empty())
+        continue;
+
+      // data has shape (dim, n) (left application) or (n, dim) (right
+      // application), and M has shape (k, k)
+      const std::size_t k = et.dofs.size();
+      for (int j = 0; j < n; ++j)
+      {
+        const std::size_t stride = right ? 1 : n;
+        U* d = right ? data.data() + j * dim : data.data() + j;
+        for (std::size_t r = 0; r < k; ++r)
+        {
+          U wr = 0;
+          for (std::size_t c = 0; c < k; ++c)
+          {
+            const geometry_type m = right ? M[c * k + r] : M[r * k + c];
+            wr += static_cast<X>(m) * d[et.dofs[c] * stride];
+          }
+          w[r] = wr;
+        }
+        for (std::size_t r = 0; r < k; ++r)
+          d[et.dofs[r] * stride] = w[r];
+      }
+    }
+
+    return true;
+  }
+
+  // Maximum number of DOFs of a sub-entity for which transformations
+  // are precomputed
+  static constexpr std::size_t max_entity_dofs = 64;
+
+  // Transformation of the DOFs of a sub-entity (edge or face) for each
+  // state of the bits of the sub-entity in the cell permutation data
+  struct EntityTransformation
+  {
+    // DOFs of the sub-entity
+    std::vector<int> dofs;
+
+    // Position and mask of the bits of the sub-entity
+    int shift;
+    std::uint32_t mask;
+
+    // For each doftransform type and state, the row-major (k, k)
+    // transformation of the k sub-entity DOFs. Empty if the
+    // transformation is the identity.
+    std::array<std::vector<std::vector<geometry_type>>, 4> matrices;
+  };
+
+  // Precompute _entity_transformations
+  void compute_entity_transformations();
+
   // Value shape. For blocked elements this is larger than
   // _reference_value_shape. For non-blocked 'primal' elements it is
   // equal to _reference_value_shape. For mixed elements, it is
@@ -872,12 +981,23 @@ private:
   bool _needs_dof_permutations;
   bool _needs_dof_transformations;
 
+  // Transformations of the DOFs of the sub-entities, precomputed for
+  // each permutation state of a sub-entity so that applying the
+  // transformations of a cell does not decode the cell permutation
+  // data for the Basix base transformations. Empty if the element does
+  // not need transformations, or if they cannot be precomputed.
+  std::vector<EntityTransformation> _entity_transformations;
+
   std::vector<std::vector<std::vector<int>>> _entity_dofs;
   std::vector<std::vector<std::vector<int>>> _entity_closure_dofs;
 
   // Quadrature points of a quadrature element (0 dimensional array for
   // all elements except quadrature elements)
   std::pair<std::vector<geometry_type>, std::array<std::size_t, 2>> _points;
+
+  // Recent tabulations of the basis functions
+  std::unique_ptr<TabulationCache<geometry_type>> _tabulation_cache
+      = std::make_unique<TabulationCache<geometry_type>>();
 };
 
 } // namespace dolfinx::fem
@@ -10,16 +10,22 @@
 #include "traits.h"
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/load_metrics.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::fem
@@ -225,6 +231,59 @@ public:
     // Store entity maps
     for (auto [msh, map] : entity_maps)
       _entity_maps.insert({msh, std::vector(map.begin(), map.end())});
+
+    // Map the entities of each integral to the mesh of each entity map
+    // once, rather than in every assembly and coefficient packing
+    for (auto& [msh, map] : _entity_maps)
+    {
+      for (auto type : {IntegralType::cell, IntegralType::exterior_facet,
+                        IntegralType::interior_facet})
+      {
+        for (auto& itg : _integrals[static_cast<std::size_t>(type)])
+        {
+          if (std::optional<std::vector<std::int32_t>> e
+              = map_entities(type, itg.entities, *msh, map))
+          {
+            _mapped_domains.insert({{type, itg.id, msh.get()}, std::move(*e)});
+          }
+        }
+      }
+    }
+
+    // Build the macro-element dofmaps of the interior facet integrals
+    // for each argument once, rather than concatenating the dofs of the
+    // two cells of a facet in every assembly
+    for (auto& itg :
+         _integrals[static_cast<std::size_t>(IntegralType::interior_facet)])
+    {
+      for (int k = 0; k < rank(); ++k)
+      {
+        const mesh::Mesh<geometry_type>& msh = *_function_spaces[k]->mesh();
+        if (&msh != _mesh.get()
+            and !_mapped_domains.contains(
+                {IntegralType::interior_facet, itg.id, &msh}))
+        {
+          continue;
+        }
+
+        std::span<const std::int32_t> facets
+            = domain(IntegralType::interior_facet, itg.id, msh);
+        auto dofs = _function_spaces[k]->dofmap()->map();
+        const std::size_t num_dofs = dofs.extent(1);
+        std::vector<std::int32_t> mdofs(facets.size() / 2 * num_dofs);
+        for (std::size_t f = 0; f < facets.size() / 4; ++f)
+        {
+          for (int j = 0; j < 2; ++j)
+          {
+            const std::int32_t c = facets[4 * f + 2 * j];
+            assert(c >= 0);
+            std::copy_n(dofs.data_handle() + c * num_dofs, num_dofs,
+                        std::next(mdofs.begin(), (2 * f + j) * num_dofs));
+          }
+        }
+        _macro_dofmaps.insert({{itg.id, k}, std::move(mdofs)});
+      }
+    }
   }
 
   /// Copy constructor
@@ -262,7 +321,9 @@ public:
   /// type.
   /// @param[in] type Integral type.
   /// @param[in] i Domain identifier (index).
-  /// @return Function to call for `tabulate_tensor`.
+  /// @return Function to call for `tabulate_tensor`. If load metrics
+  /// are enabled (see common::enable_load_metrics), the function adds
+  /// the time of each call to the kernel phase.
   std::function<void(scalar_type*, const scalar_type*, const scalar_type*,
                      const geometry_type*, const int*, const uint8_t*)>
   kernel(IntegralType type, int i) const
@@ -270,10 +331,44 @@ public:
     const auto& integrals = _integrals[static_cast<std::size_t>(type)];
     auto it = std::ranges::lower_bound(integrals, i, std::less<>{},
                                        [](const auto& a) { return a.id; });
-    if (it != integrals.end() and it->id == i)
+    if (it == integrals.end() or it->id != i)
+      throw std::runtime_error("No kernel for requested domain index.");
+
+    if (!common::load_metrics_enabled())
       return it->kernel;
     else
+    {
+      // Time the kernel calls (see common::load_metrics_enabled)
+      return [kernel = it->kernel](auto... args)
+      {
+        common::ScopedLoadTimer t(common::LoadPhase::kernel);
+        kernel(args...);
+      };
+    }
+  }
+
+  /// @brief Replace the kernel function for integral `i` on given
+  /// domain type.
+  ///
+  /// The kernel must compute the same element tensor as the kernel it
+  /// replaces, e.g. a hand-optimised variant of a generated kernel
+  /// (see fem::KernelRegistry).
+  ///
+  /// @param[in] type Integral type.
+  /// @param[in] i Domain identifier (index).
+  /// @param[in] kernel The new kernel.
+  void set_kernel(
+      IntegralType type, int i,
+      std::function<void(scalar_type*, const scalar_type*, const scalar_type*,
+                         const geometry_type*, const int*, const uint8_t*)>
+          kernel)
+  {
+    auto& integrals = _integrals[static_cast<std::size_t>(type)];
+    auto it = std::ranges::lower_bound(integrals, i, std::less<>{},
+                                       [](const auto& a) { return a.id; });
+    if (it == integrals.end() or it->id != i)
       throw std::runtime_error("No kernel for requested domain index.");
+    it->kernel = std::move(kernel);
   }
 
   /// @brief Get types of integrals in the form.
@@ -358,114 +453,52 @@ public:
       throw std::runtime_error("No mesh entities for requested domain index.");
   }
 
-  /// @brief Compute the list of entity indices in `mesh` for the ith
+  /// @brief Get the list of entity indices in `mesh` for the ith
   /// integral (kernel) of a given type (i.e. cell, exterior facet, or
   /// interior facet).
   ///
+  /// The entities in the mesh of each entity map are computed when the
+  /// form is created.
+  ///
   /// @param type Integral type.
   /// @param i Integral ID, i.e. the (sub)domain index.
   /// @param mesh The mesh the entities are numbered with respect to.
   /// @return List of active entities in `mesh` for the given integral.
-  std::vector<std::int32_t> domain(IntegralType type, int i,
-                                   const mesh::Mesh<geometry_type>& mesh) const
+  std::span<const std::int32_t>
+  domain(IntegralType type, int i, const mesh::Mesh<geometry_type>& mesh) const
   {
-    // Hack to avoid passing shared pointer to this function
-    std::shared_ptr<const mesh::Mesh<geometry_type>> msh_ptr(
-        &mesh, [](const mesh::Mesh<geometry_type>*) {});
+    if (&mesh == _mesh.get())
+      return domain(type, i);
 
-    std::span<const std::int32_t> entities = domain(type, i);
-    if (msh_ptr == _mesh)
-      return std::vector(entities.begin(), entities.end());
-    else
+    auto it = _mapped_domains.find({type, i, &mesh});
+    if (it == _mapped_domains.end())
     {
-      std::span<const std::int32_t> entity_map = _entity_maps.at(msh_ptr);
-      std::vector<std::int32_t> mapped_entities;
-      mapped_entities.reserve(entities.size());
-      switch (type)
-      {
-      case IntegralType::cell:
-      {
-        std::ranges::transform(entities, std::back_inserter(mapped_entities),
-                               [&entity_map](auto e) { return entity_map[e]; });
-        break;
-      }
-      case IntegralType::exterior_facet:
-      {
-        // Get the codimension of the mesh
-        const int tdim = _mesh->topology()->dim();
-        const int codim = tdim - mesh.topology()->dim();
-        assert(codim >= 0);
-        if (codim == 0)
-        {
-          for (std::size_t i = 0; i < entities.size(); i += 2)
-          {
-            // Add cell and the local facet index
-            mapped_entities.insert(mapped_entities.end(),
-                                   {entity_map[entities[i]], entities[i + 1]});
-          }
-        }
-        else if (codim == 1)
-        {
-          // In this case, the entity maps take facets in (`_mesh`) to cells in
-          // `mesh`, so we need to get the facet number from the (cell,
-          // local_facet pair) first.
-          auto c_to_f = _mesh->topology()->connectivity(tdim, tdim - 1);
-          assert(c_to_f);
-          for (std::size_t i = 0; i < entities.size(); i += 2)
-          {
-            // Get the facet index
-            const std::int32_t facet
-                = c_to_f->links(entities[i])[entities[i + 1]];
-            // Add cell and the local facet index
-            mapped_entities.insert(mapped_entities.end(),
-                                   {entity_map[facet], entities[i + 1]});
-          }
-        }
-        else
-          throw std::runtime_error("Codimension > 1 not supported.");
-
-        break;
-      }
-      case IntegralType::interior_facet:
-      {
-        // Get the codimension of the mesh
-        const int tdim = _mesh->topology()->dim();
-        const int codim = tdim - mesh.topology()->dim();
-        assert(codim >= 0);
-        if (codim == 0)
-        {
-          for (std::size_t i = 0; i < entities.size(); i += 2)
-          {
-            // Add cell and the local facet index
-            mapped_entities.insert(mapped_entities.end(),
-                                   {entity_map[entities[i]], entities[i + 1]});
-          }
-        }
-        else if (codim == 1)
-        {
-          // In this case, the entity maps take facets in (`_mesh`) to cells in
-          // `mesh`, so we need to get the facet number from the (cell,
-          // local_facet pair) first.
-          auto c_to_f = _mesh->topology()->connectivity(tdim, tdim - 1);
-          assert(c_to_f);
-          for (std::size_t i = 0; i < entities.size(); i += 2)
-          {
-            // Get the facet index
-            const std::int32_t facet
-                = c_to_f->links(entities[i])[entities[i + 1]];
-            // Add cell and the local facet index
-            mapped_entities.insert(mapped_entities.end(),
-                                   {entity_map[facet], entities[i + 1]});
-          }
-        }
-        break;
-      }
-      default:
-        throw std::runtime_error("Integral type not supported.");
-      }
-
-      return mapped_entities;
+      throw std::runtime_error(
+          "No mesh entities for requested domain index and mesh.");
     }
+    return it->second;
+  }
+
+  /// @brief Get the macro-element dofmap of the ith interior facet
+  /// integral for a form argument.
+  ///
+  /// For each facet of the integration domain, the dofs of the first
+  /// cell are followed by the dofs of the second cell in the dofmap of
+  /// the argument, i.e. the data has row-major layout with
+  /// `shape=(num_facets, 2 * num_cell_dofs)`. The dofmaps are computed
+  /// when the form is created.
+  ///
+  /// @param[in] i Integral ID, i.e. (sub)domain index.
+  /// @param[in] arg Argument index (0 for the test function, 1 for the
+  /// trial function).
+  /// @return Macro-element dofmap, or an empty span if it is not
+  /// available.
+  std::span<const std::int32_t> macro_dofmap(int i, int arg) const
+  {
+    auto it = _macro_dofmaps.find({i, arg});
+    if (it == _macro_dofmaps.end())
+      return {};
+    return it->second;
   }
 
   /// @brief Access coefficients.
@@ -527,9 +560,76 @@ private:
   // True if permutation data needs to be passed into these integrals
   bool _needs_facet_permutations;
 
+  // Compute the entities in `mesh` of a list of integration entities
+  // of a given type, with the entity map from the mesh of the form to
+  // `mesh`. Returns std::nullopt if the codimension of `mesh` is not
+  // supported.
+  std::optional<std::vector<std::int32_t>>
+  map_entities(IntegralType type, std::span<const std::int32_t> entities,
+               const mesh::Mesh<geometry_type>& mesh,
+               std::span<const std::int32_t> entity_map) const
+  {
+    std::vector<std::int32_t> mapped_entities;
+    mapped_entities.reserve(entities.size());
+    if (type == IntegralType::cell)
+    {
+      std::ranges::transform(entities, std::back_inserter(mapped_entities),
+                             [&entity_map](auto e) { return entity_map[e]; });
+      return mapped_entities;
+    }
+
+    // Get the codimension of the mesh
+    const int tdim = _mesh->topology()->dim();
+    const int codim = tdim - mesh.topology()->dim();
+    assert(codim >= 0);
+    if (codim == 0)
+    {
+      for (std::size_t i = 0; i < entities.size(); i += 2)
+      {
+        // Add cell and the local facet index
+        mapped_entities.insert(mapped_entities.end(),
+                               {entity_map[entities[i]], entities[i + 1]});
+      }
+    }
+    else if (codim == 1)
+    {
+      // In this case, the entity maps take facets in (`_mesh`) to cells
+      // in `mesh`, so we need to get the facet number from the (cell,
+      // local_facet pair) first.
+      auto c_to_f = _mesh->topology()->connectivity(tdim, tdim - 1);
+      if (!c_to_f)
+      {
+        throw std::runtime_error(
+            "Topology cell-to-facet connectivity has not been computed.");
+      }
+      for (std::size_t i = 0; i < entities.size(); i += 2)
+      {
+        // Get the facet index
+        const std::int32_t facet = c_to_f->links(entities[i])[entities[i + 1]];
+        // Add cell and the local facet index
+        mapped_entities.insert(mapped_entities.end(),
+                               {entity_map[facet], entities[i + 1]});
+      }
+    }
+    else
+      return std::nullopt;
+
+    return mapped_entities;
+  }
+
   // Entity maps (see Form documentation)
   std::map<std::shared_ptr<const mesh::Mesh<geometry_type>>,
            std::vector<std::int32_t>>
       _entity_maps;
+
+  // Entities of each integral in the mesh of each entity map. The key
+  // is (integral type, integral ID, mesh).
+  std::map<std::tuple<IntegralType, int, const mesh::Mesh<geometry_type>*>,
+           std::vector<std::int32_t>>
+      _mapped_domains;
+
+  // Macro-element dofmaps of the interior facet integrals. The key is
+  // (integral ID, argument index).
+  std::map<std::pair<int, int>, std::vector<std::int32_t>> _macro_dofmaps;
 }; // namespace dolfinx::fem
 } // namespace dolfinx::fem
@@ -153,6 +153,8 @@ public:
 
   /// @brief Interpolate an expression f(x) on the whole domain.
   /// @param[in] f Expression to be interpolated.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// expansion coefficients from the values of `f`.
   void
   interpolate(const std::function<
               std::pair<std::vector<value_type>, std::vector<std::size_t>>(
@@ -160,7 +162,8 @@ public:
                       const geometry_type,
                       MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
                           std::size_t, 3,
-                          MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>)>& f)
+                          MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>)>& f,
+              int num_threads = 1)
   {
     assert(_function_space);
     assert(_function_space->mesh());
@@ -169,12 +172,19 @@ public:
     assert(cmap);
     std::vector<std::int32_t> cells(cmap->size_local() + cmap->num_ghosts(), 0);
     std::iota(cells.begin(), cells.end(), 0);
-    interpolate(f, cells);
+    interpolate(f, cells, num_threads);
   }
 
   /// @brief Interpolate an expression f(x) over a set of cells.
+  ///
+  /// @note The interpolation points and geometry data are computed on
+  /// each call. Use fem::Interpolator when the same space is
+  /// interpolated into repeatedly.
+  ///
   /// @param[in] f Expression function to be interpolated.
   /// @param[in] cells Cells to interpolate on.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// expansion coefficients from the values of `f`.
   void interpolate(
       const std::function<
           std::pair<std::vector<value_type>, std::vector<std::size_t>>(
@@ -183,7 +193,7 @@ public:
                   MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
                       std::size_t, 3,
                       MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>)>& f,
-      std::span<const std::int32_t> cells)
+      std::span<const std::int32_t> cells, int num_threads = 1)
   {
     assert(_function_space);
     assert(_function_space->element());
@@ -233,15 +243,17 @@ public:
       _fshape = {fshape[0], fshape[1]};
 
     fem::interpolate(*this, std::span<const value_type>(fx.data(), fx.size()),
-                     _fshape, cells);
+                     _fshape, cells, num_threads);
   }
 
   /// @brief Interpolate a Function over all cells.
   ///
   /// @param[in] u Function to be interpolated.
+  /// @param[in] num_threads Number of threads.
   /// @pre The mesh associated with `this` and the mesh associated with
   /// `u` must be the same mesh::Mesh.
-  void interpolate(const Function<value_type, geometry_type>& u)
+  void interpolate(const Function<value_type, geometry_type>& u,
+                   int num_threads = 1)
   {
     assert(_function_space);
     assert(_function_space->mesh());
@@ -250,7 +262,7 @@ public:
     assert(cmap);
     std::vector<std::int32_t> cells(cmap->size_local() + cmap->num_ghosts(), 0);
     std::iota(cells.begin(), cells.end(), 0);
-    interpolate(u, cells, cells);
+    interpolate(u, cells, cells, num_threads);
   }
 
   /// @brief Interpolate a Function over a subset of cells.
@@ -269,21 +281,25 @@ public:
   /// This argument can be empty when `this` and `u0` share the same
   /// mesh. Otherwise the length of `cells` and the length of `cells0`
   /// must be the same.
+  /// @param[in] num_threads Number of threads.
   void interpolate(const Function<value_type, geometry_type>& u0,
                    std::span<const std::int32_t> cells0,
-                   std::span<const std::int32_t> cells1 = {})
+                   std::span<const std::int32_t> cells1 = {},
+                   int num_threads = 1)
   {
     if (cells1.empty())
       cells1 = cells0;
-    fem::interpolate(*this, cells1, u0, cells0);
+    fem::interpolate(*this, cells1, u0, cells0, num_threads);
   }
 
   /// @brief Interpolate an Expression on all cells.
   ///
   /// @param[in] e Expression to be interpolated.
+  /// @param[in] num_threads Number of threads.
   /// @pre If a mesh is associated with Function coefficients of `e`, it
   /// must be the same as the mesh::Mesh associated with `this`.
-  void interpolate(const Expression<value_type, geometry_type>& e)
+  void interpolate(const Expression<value_type, geometry_type>& e,
+                   int num_threads = 1)
   {
     assert(_function_space);
     assert(_function_space->mesh());
@@ -292,7 +308,7 @@ public:
     assert(cmap);
     std::vector<std::int32_t> cells(cmap->size_local() + cmap->num_ghosts(), 0);
     std::iota(cells.begin(), cells.end(), 0);
-    interpolate(e, cells);
+    interpolate(e, cells, {}, num_threads);
   }
 
   /// @brief Interpolate an Expression over a subset of cells.
@@ -311,9 +327,12 @@ public:
   /// This argument can be empty when `this` and `u0` share the same
   /// mesh. Otherwise the length of `cells` and the length of
   /// `cells0` must be the same.
+  /// @param[in] num_threads Number of threads used to evaluate the
+  /// Expression and to compute the expansion coefficients.
   void interpolate(const Expression<value_type, geometry_type>& e0,
                    std::span<const std::int32_t> cells0,
-                   std::span<const std::int32_t> cells1 = {})
+                   std::span<const std::int32_t> cells1 = {},
+                   int num_threads = 1)
   {
     // Extract mesh
     const mesh::Mesh<geometry_type>* mesh0 = nullptr;
@@ -381,6 +400,21 @@ public:
       }
     }
 
+    // If the degrees-of-freedom are the values at the interpolation
+    // points, in the Expression value ordering (e.g. quadrature
+    // spaces), evaluate the Expression directly into the dof array
+    if (auto element = _function_space->element();
+        element->interpolation_ident() and element->map_ident()
+        and !element->needs_dof_transformations()
+        and !_function_space->symmetric()
+        and element->block_size() == static_cast<int>(value_size))
+    {
+      assert(_function_space->dofmap());
+      e0.eval(*mesh0, cells0, _x->mutable_array(), *_function_space->dofmap(),
+              cells1, num_threads);
+      return;
+    }
+
     // Array to hold evaluated Expression
     std::size_t num_cells = cells0.size();
     std::size_t num_points = e0.X().second[0];
@@ -391,7 +425,8 @@ public:
         f(fdata.data(), num_cells, num_points, value_size);
 
     // Evaluate Expression at points
-    e0.eval(*mesh0, cells0, fdata, {num_cells, num_points * value_size});
+    e0.eval(*mesh0, cells0, fdata, {num_cells, num_points * value_size},
+            num_threads);
 
     // Reshape evaluated data to fit interpolate.
     // Expression returns matrix of shape (num_cells, num_points *
@@ -410,7 +445,8 @@ public:
     // Interpolate values into appropriate space
     fem::interpolate(*this,
                      std::span<const value_type>(fdata1.data(), fdata1.size()),
-                     {value_size, num_cells * num_points}, cells1);
+                     {value_size, num_cells * num_points}, cells1,
+                     num_threads);
   }
 
   /// @brief Interpolate a Function defined on a different mesh.
@@ -450,9 +486,6 @@ public:
     assert(x.size() == xshape[0] * xshape[1]);
     assert(u.size() == ushape[0] * ushape[1]);
 
-    // TODO: This could be easily made more efficient by exploiting
-    // points being ordered by the cell to which they belong.
-
     if (xshape[0] != cells.size())
     {
       throw std::runtime_error(
@@ -480,7 +513,7 @@ public:
     // Get geometry data
     auto x_dofmap = mesh->geometry().dofmap();
     const std::size_t num_dofs_g = cmap.dim();
-    auto x_g = mesh->geometry().x();
+    mesh::NodeCoordinates<geometry_type> x_g = mesh->geometry().coordinates();
 
     // Get element
     auto element = _function_space->element();
@@ -557,6 +590,45 @@ public:
     impl::mdspan_t<geometry_type, 3> K(K_b.data(), xshape[0], tdim, gdim);
     std::vector<geometry_type> detJ(xshape[0]);
     std::vector<geometry_type> det_scratch(2 * gdim * tdim);
+    std::shared_ptr<const mesh::GeometryJacobians<geometry_type>> jacobians
+        = mesh->geometry().jacobians();
+
+    // Pull back the points to the reference cell in the non-affine case.
+    // Consecutive points in the same cell are pulled back together.
+    if (!cmap.is_affine())
+    {
+      std::vector<geometry_type> xr_b;
+      for (std::size_t p0 = 0; p0 < cells.size();)
+      {
+        const std::int32_t cell_index = cells[p0];
+        std::size_t p1 = p0 + 1;
+        while (p1 < cells.size() and cells[p1] == cell_index)
+          ++p1;
+
+        if (cell_index >= 0)
+        {
+          auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+              x_dofmap, cell_index,
+              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          for (std::size_t i = 0; i < num_dofs_g; ++i)
+            for (std::size_t j = 0; j < gdim; ++j)
+              coord_dofs(i, j) = x_g(x_dofs[i], j);
+
+          xr_b.resize((p1 - p0) * gdim);
+          for (std::size_t p = p0; p < p1; ++p)
+            for (std::size_t j = 0; j < gdim; ++j)
+              xr_b[(p - p0) * gdim + j] = x[p * xshape[1] + j];
+
+          cmap.pull_back_nonaffine(
+              impl::mdspan_t<geometry_type, 2>(Xb.data() + p0 * tdim,
+                                               p1 - p0, tdim),
+              impl::mdspan_t<const geometry_type, 2>(xr_b.data(), p1 - p0,
+                                                     gdim),
+              coord_dofs);
+        }
+        p0 = p1;
+      }
+    }
 
     // Prepare geometry data in each cell
     for (std::size_t p = 0; p < cells.size(); ++p)
@@ -572,11 +644,8 @@ public:
           x_dofmap, cell_index, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
       assert(x_dofs.size() == num_dofs_g);
       for (std::size_t i = 0; i < num_dofs_g; ++i)
-      {
-        const int pos = 3 * x_dofs[i];
         for (std::size_t j = 0; j < gdim; ++j)
-          coord_dofs(i, j) = x_g[pos + j];
-      }
+          coord_dofs(i, j) = x_g(x_dofs[i], j);
 
       for (std::size_t j = 0; j < gdim; ++j)
         xp(0, j) = x[p * xshape[1] + j];
@@ -598,21 +667,35 @@ public:
       // Compute reference coordinates X, and J, detJ and K
       if (cmap.is_affine())
       {
-        CoordinateElement<geometry_type>::compute_jacobian(dphi0, coord_dofs,
-                                                           _J);
-        CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
+        if (jacobians)
+        {
+          // Copy the Jacobian data cached on the geometry
+          const std::size_t i = jacobians->index(cell_index, 0);
+          std::copy_n(jacobians->J.data() + i * gdim * tdim, gdim * tdim,
+                      J_b.data() + p * gdim * tdim);
+          std::copy_n(jacobians->K.data() + i * tdim * gdim, tdim * gdim,
+                      K_b.data() + p * tdim * gdim);
+          detJ[p] = jacobians->detJ[i];
+        }
+        else
+        {
+          CoordinateElement<geometry_type>::compute_jacobian(dphi0,
+                                                             coord_dofs, _J);
+          CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
+          detJ[p]
+              = CoordinateElement<geometry_type>::compute_jacobian_determinant(
+                  _J, det_scratch);
+        }
         std::array<geometry_type, 3> x0 = {0, 0, 0};
         for (std::size_t i = 0; i < coord_dofs.extent(1); ++i)
           x0[i] += coord_dofs(0, i);
         CoordinateElement<geometry_type>::pull_back_affine(Xp, _K, x0, xp);
-        detJ[p]
-            = CoordinateElement<geometry_type>::compute_jacobian_determinant(
-                _J, det_scratch);
       }
       else
       {
-        // Pull-back physical point xp to reference coordinate Xp
-        cmap.pull_back_nonaffine(Xp, xp, coord_dofs);
+        // Reference coordinate Xp has been computed above
+        for (std::size_t j = 0; j < tdim; ++j)
+          Xpb[j] = X(p, j);
         cmap.tabulate(1, std::span(Xpb.data(), tdim), {1, tdim}, phi_b);
         CoordinateElement<geometry_type>::compute_jacobian(dphi, coord_dofs,
                                                            _J);
@@ -8,6 +8,7 @@
 
 #include "CoordinateElement.h"
 #include "DofMap.h"
+#include "DofMapCache.h"
 #include "FiniteElement.h"
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -20,6 +21,8 @@
 #include <dolfinx/mesh/Topology.h>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <span>
 #include <vector>
 
 namespace dolfinx::fem
@@ -45,7 +48,8 @@ public:
                 std::shared_ptr<const FiniteElement<geometry_type>> element,
                 std::shared_ptr<const DofMap> dofmap)
       : _mesh(mesh), _element(element), _dofmap(dofmap),
-        _id(boost::uuids::random_generator()()), _root_space_id(_id)
+        _root_dofmap(dofmap), _id(boost::uuids::random_generator()()),
+        _root_space_id(_id)
   {
     // Do nothing
   }
@@ -93,8 +97,9 @@ public:
     // Create new sub space
     FunctionSpace sub_space(_mesh, element, dofmap);
 
-    // Set root space id and component w.r.t. root
+    // Set root space id, dofmap and component w.r.t. root
     sub_space._root_space_id = _root_space_id;
+    sub_space._root_dofmap = _root_dofmap;
     sub_space._component = _component;
     sub_space._component.insert(sub_space._component.end(), component.begin(),
                                 component.end());
@@ -129,20 +134,23 @@ public:
 
   /// Collapse a subspace and return a new function space and a map from
   /// new to old dofs
+  ///
+  /// The collapsed dofmap is shared by the collapsed spaces of all
+  /// subspaces with the same root space and component (see
+  /// fem::DofMapCache).
   /// @return The new function space and a map from new to old dofs
   std::pair<FunctionSpace, std::vector<std::int32_t>> collapse() const
   {
     if (_component.empty())
       throw std::runtime_error("Function space is not a subspace");
 
-    // Create collapsed DofMap
-    auto [_collapsed_dofmap, collapsed_dofs]
-        = _dofmap->collapse(_mesh->comm(), *_mesh->topology());
-    auto collapsed_dofmap
-        = std::make_shared<DofMap>(std::move(_collapsed_dofmap));
+    // Get collapsed DofMap
+    auto [collapsed_dofmap, collapsed_dofs] = dofmap_cache().collapsed(
+        _root_dofmap, _component, [this]()
+        { return _dofmap->collapse(_mesh->comm(), *_mesh->topology()); });
 
     return {FunctionSpace(_mesh, _element, collapsed_dofmap),
-            std::move(collapsed_dofs)};
+            *collapsed_dofs};
   }
 
   /// @brief Get the component with respect to the root superspace.
@@ -171,6 +179,32 @@ public:
   /// if `transpose` is false, and otherwise the returned data is
   /// transposed. Storage is row-major.
   std::vector<geometry_type> tabulate_dof_coordinates(bool transpose) const
+  {
+    assert(_mesh);
+    auto map = _mesh->topology()->index_map(_mesh->topology()->dim());
+    assert(map);
+    std::vector<std::int32_t> cells(map->size_local() + map->num_ghosts());
+    std::iota(cells.begin(), cells.end(), 0);
+    return tabulate_dof_coordinates(transpose, cells);
+  }
+
+  /// @brief Tabulate the physical coordinates of the dofs of a set of
+  /// cells.
+  ///
+  /// The returned array has the layout of
+  /// FunctionSpace::tabulate_dof_coordinates(bool) const. Only the
+  /// coordinates of the dofs of `cells` are computed, and the other
+  /// entries are zero.
+  ///
+  /// @param[in] transpose If false the returned data has shape
+  /// `(num_points, 3)`, otherwise it is transposed and has shape `(3,
+  /// num_points)`.
+  /// @param[in] cells Cells (local to the process) to compute the dof
+  /// coordinates of.
+  /// @return The dof coordinates.
+  std::vector<geometry_type>
+  tabulate_dof_coordinates(bool transpose,
+                           std::span<const std::int32_t> cells) const
   {
     if (!_component.empty())
     {
@@ -189,7 +223,6 @@ public:
     assert(_mesh);
     assert(_element);
     const std::size_t gdim = _mesh->geometry().dim();
-    const int tdim = _mesh->topology()->dim();
 
     // Get dofmap local size
     assert(_dofmap);
@@ -219,7 +252,7 @@ public:
     // Prepare cell geometry
     auto x_dofmap = _mesh->geometry().dofmap();
     const std::size_t num_dofs_g = cmap.dim();
-    std::span<const geometry_type> x_g = _mesh->geometry().x();
+    mesh::NodeCoordinates<geometry_type> x_g = _mesh->geometry().coordinates();
 
     // Array to hold coordinates to return
     const std::size_t shape_c0 = transpose ? 3 : num_dofs;
@@ -240,10 +273,6 @@ public:
     std::vector<geometry_type> coordinate_dofs_b(num_dofs_g * gdim);
     mdspan2_t coordinate_dofs(coordinate_dofs_b.data(), num_dofs_g, gdim);
 
-    auto map = _mesh->topology()->index_map(tdim);
-    assert(map);
-    const int num_cells = map->size_local() + map->num_ghosts();
-
     std::span<const std::uint32_t> cell_info;
     if (_element->needs_dof_transformations())
     {
@@ -267,14 +296,14 @@ public:
         = _element->template dof_transformation_fn<geometry_type>(
             doftransform::standard);
 
-    for (int c = 0; c < num_cells; ++c)
+    for (std::int32_t c : cells)
     {
       // Extract cell geometry 'dofs'
       auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
           x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
       for (std::size_t i = 0; i < x_dofs.size(); ++i)
         for (std::size_t j = 0; j < gdim; ++j)
-          coordinate_dofs(i, j) = x_g[3 * x_dofs[i] + j];
+          coordinate_dofs(i, j) = x_g(x_dofs[i], j);
 
       // Tabulate dof coordinates on cell
       cmap.push_forward(x, coordinate_dofs, phi);
@@ -327,6 +356,9 @@ private:
   // The dofmap
   std::shared_ptr<const DofMap> _dofmap;
 
+  // The dofmap of the root space
+  std::shared_ptr<const DofMap> _root_dofmap;
+
   // The component w.r.t. to root space
   std::vector<int> _component;
 
@@ -0,0 +1,340 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "DofMap.h"
+#include "traits.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Cell geometry factors of an affine simplex mesh.
+///
+/// For an affine (degree 1 simplex) coordinate map the Jacobian is
+/// constant on each cell. This class computes, for each cell, the
+/// determinant (pseudo-determinant if `gdim > tdim`) of the Jacobian
+/// `J` and the symmetric matrix `G = K K^T`, where `K` is the inverse
+/// (pseudo-inverse if `gdim > tdim`) of `J`. The factors of a cell are
+/// stored contiguously as
+///
+///     [detJ, G(0, 0), G(0, 1), ..., G(0, tdim - 1), G(1, 1), ...]
+///
+/// i.e. the determinant is followed by the upper triangle of `G` in
+/// row-major order. The cell stride is `1 + tdim * (tdim + 1) / 2`.
+///
+/// The factors can be passed to cell kernels in place of the cell
+/// node coordinates (see assemble_matrix_geometry_factors and
+/// assemble_vector_geometry_factors). For the stiffness matrix of a
+/// P1 Laplacian this removes the computation of the Jacobian, its
+/// inverse and its determinant from the kernel, which is then only a
+/// small dense product.
+///
+/// The Jacobian data cached on the mesh geometry is used if it has
+/// been created (see mesh::Geometry::create_jacobians). A copy of the
+/// mesh coordinates is kept when the factors are computed.
+/// GeometryFactors::update re-computes the factors if the mesh
+/// coordinates (mesh::Geometry::x) have changed.
+///
+/// @tparam U Geometry type.
+template <std::floating_point U>
+class GeometryFactors
+{
+  template <typename X, std::size_t d>
+  using mdspan_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      X, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, d>>;
+
+public:
+  /// @brief Compute the geometry factors on a set of cells.
+  /// @param[in] mesh The mesh. Its coordinate map must be affine.
+  /// @param[in] cells Cells to compute the factors on.
+  GeometryFactors(std::shared_ptr<const mesh::Mesh<U>> mesh,
+                  std::vector<std::int32_t> cells)
+      : _mesh(mesh), _cells(std::move(cells))
+  {
+    assert(_mesh);
+    if (!_mesh->geometry().cmap().is_affine())
+    {
+      throw std::runtime_error(
+          "GeometryFactors requires an affine coordinate map.");
+    }
+
+    _factors.resize(_cells.size() * stride());
+    update();
+  }
+
+  /// @brief Compute the geometry factors on all local (owned and ghost)
+  /// cells of a mesh.
+  /// @param[in] mesh The mesh. Its coordinate map must be affine.
+  explicit GeometryFactors(std::shared_ptr<const mesh::Mesh<U>> mesh)
+      : GeometryFactors(mesh, [&mesh]()
+                        {
+                          auto map = mesh->topology()->index_map(
+                              mesh->topology()->dim());
+                          assert(map);
+                          std::vector<std::int32_t> cells(
+                              map->size_local() + map->num_ghosts());
+                          std::iota(cells.begin(), cells.end(), 0);
+                          return cells;
+                        }())
+  {
+  }
+
+  /// @brief Re-compute the geometry factors if the mesh coordinates
+  /// have changed since the factors were last computed.
+  /// @return True if the factors were re-computed.
+  bool update()
+  {
+    std::span<const U> x_g = _mesh->geometry().x();
+    if (!_x.empty() and std::ranges::equal(x_g, _x))
+      return false;
+
+    const mesh::Geometry<U>& geometry = _mesh->geometry();
+    const CoordinateElement<U>& cmap = geometry.cmap();
+    auto x_dofmap = geometry.dofmap();
+    mesh::NodeCoordinates<U> xg = geometry.coordinates();
+    const std::size_t gdim = geometry.dim();
+    const std::size_t tdim = _mesh->topology()->dim();
+    const std::size_t num_dofs_g = cmap.dim();
+
+    // Tabulate the coordinate element basis derivatives at the
+    // reference cell origin. The derivatives are constant on the cell.
+    const std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, 1);
+    std::vector<U> phi_b(std::reduce(phi_shape.begin(), phi_shape.end(), 1,
+                                     std::multiplies{}));
+    mdspan_t<const U, 4> phi(phi_b.data(), phi_shape);
+    std::vector<U> X(tdim, 0);
+    cmap.tabulate(1, X, {1, tdim}, phi_b);
+    auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        phi, std::pair(std::size_t(1), tdim + 1), 0,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+    mdspan_t<U, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+    std::vector<U> J_b(gdim * tdim);
+    mdspan_t<U, 2> J(J_b.data(), gdim, tdim);
+    std::vector<U> K_b(tdim * gdim);
+    mdspan_t<U, 2> K(K_b.data(), tdim, gdim);
+    std::vector<U> det_scratch(2 * gdim * tdim);
+    const std::size_t cstride = stride();
+    std::shared_ptr<const mesh::GeometryJacobians<U>> jacobians
+        = geometry.jacobians();
+    for (std::size_t c = 0; c < _cells.size(); ++c)
+    {
+      std::span<U> g(_factors.data() + c * cstride, cstride);
+      mdspan_t<const U, 2> Kc = K;
+      if (jacobians)
+      {
+        // Use the Jacobian data cached on the geometry
+        const std::size_t i = jacobians->index(_cells[c], 0);
+        Kc = mdspan_t<const U, 2>(jacobians->K.data() + i * tdim * gdim,
+                                  tdim, gdim);
+        g[0] = jacobians->detJ[i];
+      }
+      else
+      {
+        auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            x_dofmap, _cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        for (std::size_t i = 0; i < num_dofs_g; ++i)
+          for (std::size_t j = 0; j < gdim; ++j)
+            coord_dofs(i, j) = xg(x_dofs[i], j);
+
+        std::ranges::fill(J_b, 0);
+        cmap.compute_jacobian(dphi, coord_dofs, J);
+        cmap.compute_jacobian_inverse(J, K);
+        g[0] = cmap.compute_jacobian_determinant(J, det_scratch);
+      }
+
+      std::size_t pos = 1;
+      for (std::size_t i = 0; i < tdim; ++i)
+      {
+        for (std::size_t j = i; j < tdim; ++j)
+        {
+          U G_ij = 0;
+          for (std::size_t k = 0; k < gdim; ++k)
+            G_ij += Kc(i, k) * Kc(j, k);
+          g[pos++] = G_ij;
+        }
+      }
+    }
+
+    _x.assign(x_g.begin(), x_g.end());
+    return true;
+  }
+
+  /// @brief Geometry factors of all cells.
+  /// @return Factors, `shape=(num_cells, stride())`.
+  std::span<const U> factors() const { return _factors; }
+
+  /// @brief Geometry factors of the `i`th cell in
+  /// GeometryFactors::cells.
+  std::span<const U> factors(std::size_t i) const
+  {
+    return std::span(_factors).subspan(i * stride(), stride());
+  }
+
+  /// @brief Number of factors for each cell.
+  std::size_t stride() const
+  {
+    const std::size_t tdim = _mesh->topology()->dim();
+    return 1 + tdim * (tdim + 1) / 2;
+  }
+
+  /// @brief Cells on which the factors are computed.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// @brief The mesh.
+  std::shared_ptr<const mesh::Mesh<U>> mesh() const { return _mesh; }
+
+private:
+  // The mesh
+  std::shared_ptr<const mesh::Mesh<U>> _mesh;
+
+  // Cells
+  std::vector<std::int32_t> _cells;
+
+  // Geometry factors, shape=(num_cells, stride)
+  std::vector<U> _factors;
+
+  // Mesh coordinates when the factors were last computed
+  std::vector<U> _x;
+};
+
+/// @brief Assemble a matrix with a cell kernel that takes the cell
+/// geometry factors in place of the cell node coordinates.
+///
+/// The kernel is called as `kernel(Ae, constants, g)` for each cell in
+/// GeometryFactors::cells, where `Ae` is the zeroed element matrix,
+/// with shape `(bs0 * num_dofs0, bs1 * num_dofs1)`, and `g` the
+/// factors of the cell. Rows and columns of the element matrix that
+/// are marked in `bc0` and `bc1` are zeroed before the element matrix
+/// is added. Diagonal entries for boundary condition dofs are not
+/// inserted.
+///
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in] g Geometry factors.
+/// @param[in] dofmap0 Dofmap for the rows. It must be defined on the
+/// mesh of `g` and not require dof transformations.
+/// @param[in] dofmap1 Dofmap for the columns. It must be defined on
+/// the mesh of `g` and not require dof transformations.
+/// @param[in] kernel The cell kernel.
+/// @param[in] constants Constant data passed to the kernel.
+/// @param[in] bc0 Boundary condition markers for the rows. Can be
+/// empty.
+/// @param[in] bc1 Boundary condition markers for the columns. Can be
+/// empty.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_geometry_factors(
+    la::MatSet<T> auto mat_add, const GeometryFactors<U>& g,
+    const DofMap& dofmap0, const DofMap& dofmap1,
+    std::invocable<T*, const T*, const U*> auto kernel,
+    std::span<const T> constants, std::span<const std::int8_t> bc0 = {},
+    std::span<const std::int8_t> bc1 = {})
+{
+  auto dmap0 = dofmap0.map();
+  auto dmap1 = dofmap1.map();
+  const int bs0 = dofmap0.bs();
+  const int bs1 = dofmap1.bs();
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  std::vector<T> Ae(ndim0 * ndim1);
+
+  std::span<const std::int32_t> cells = g.cells();
+  for (std::size_t k = 0; k < cells.size(); ++k)
+  {
+    std::int32_t c = cells[k];
+    std::ranges::fill(Ae, 0);
+    kernel(Ae.data(), constants.data(), g.factors(k).data());
+
+    auto dofs0 = std::span(dmap0.data_handle() + c * num_dofs0, num_dofs0);
+    auto dofs1 = std::span(dmap1.data_handle() + c * num_dofs1, num_dofs1);
+    if (!bc0.empty())
+    {
+      for (int i = 0; i < num_dofs0; ++i)
+      {
+        for (int b = 0; b < bs0; ++b)
+        {
+          if (bc0[bs0 * dofs0[i] + b])
+          {
+            const int row = bs0 * i + b;
+            std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+          }
+        }
+      }
+    }
+
+    if (!bc1.empty())
+    {
+      for (int j = 0; j < num_dofs1; ++j)
+      {
+        for (int b = 0; b < bs1; ++b)
+        {
+          if (bc1[bs1 * dofs1[j] + b])
+          {
+            const int col = bs1 * j + b;
+            for (int row = 0; row < ndim0; ++row)
+              Ae[row * ndim1 + col] = 0;
+          }
+        }
+      }
+    }
+
+    mat_add(dofs0, dofs1, Ae);
+  }
+}
+
+/// @brief Assemble a vector with a cell kernel that takes the cell
+/// geometry factors in place of the cell node coordinates.
+///
+/// The kernel is called as `kernel(be, constants, g)` for each cell in
+/// GeometryFactors::cells, where `be` is the zeroed element vector, of
+/// size `bs * num_dofs`, and `g` the factors of the cell.
+///
+/// @param[in,out] b The vector to assemble into. It is not zeroed.
+/// @param[in] g Geometry factors.
+/// @param[in] dofmap Dofmap. It must be defined on the mesh of `g` and
+/// not require dof transformations.
+/// @param[in] kernel The cell kernel.
+/// @param[in] constants Constant data passed to the kernel.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_geometry_factors(
+    std::span<T> b, const GeometryFactors<U>& g, const DofMap& dofmap,
+    std::invocable<T*, const T*, const U*> auto kernel,
+    std::span<const T> constants)
+{
+  auto dmap = dofmap.map();
+  const int bs = dofmap.bs();
+  const int num_dofs = dmap.extent(1);
+  std::vector<T> be(bs * num_dofs);
+
+  std::span<const std::int32_t> cells = g.cells();
+  for (std::size_t k = 0; k < cells.size(); ++k)
+  {
+    std::ranges::fill(be, 0);
+    kernel(be.data(), constants.data(), g.factors(k).data());
+    auto dofs = std::span(dmap.data_handle() + cells[k] * num_dofs, num_dofs);
+    for (int i = 0; i < num_dofs; ++i)
+      for (int j = 0; j < bs; ++j)
+        b[bs * dofs[i] + j] += be[bs * i + j];
+  }
+}
+} // namespace dolfinx::fem
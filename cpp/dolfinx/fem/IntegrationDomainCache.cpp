@@ -0,0 +1,186 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "IntegrationDomainCache.h"
+#include "utils.h"
+#include <algorithm>
+#include <cassert>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/utils.h>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Compute the integration entities of all owned cells, exterior
+/// facets or interior facets of a topology
+std::vector<std::int32_t> compute_default_domain(const mesh::Topology& topology,
+                                                 fem::IntegralType type)
+{
+  const int tdim = topology.dim();
+  if (type == fem::IntegralType::cell)
+  {
+    assert(topology.index_map(tdim));
+    std::vector<std::int32_t> cells(topology.index_map(tdim)->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+    return cells;
+  }
+
+  auto f_to_c = topology.connectivity(tdim - 1, tdim);
+  if (!f_to_c)
+  {
+    throw std::runtime_error(
+        "Topology facet-to-cell connectivity has not been computed.");
+  }
+  auto c_to_f = topology.connectivity(tdim, tdim - 1);
+  if (!c_to_f)
+  {
+    throw std::runtime_error(
+        "Topology cell-to-facet connectivity has not been computed.");
+  }
+
+  std::vector<std::int32_t> entities;
+  switch (type)
+  {
+  case fem::IntegralType::exterior_facet:
+  {
+    const std::vector<std::int32_t> bfacets
+        = mesh::exterior_facet_indices(topology);
+    entities.reserve(2 * bfacets.size());
+    for (std::int32_t f : bfacets)
+    {
+      // There will only be one pair for an exterior facet integral
+      auto pair = fem::impl::get_cell_facet_pairs<1>(f, f_to_c->links(f),
+                                                     *c_to_f);
+      entities.insert(entities.end(), pair.begin(), pair.end());
+    }
+    break;
+  }
+  case fem::IntegralType::interior_facet:
+  {
+    // Create indicator for interprocess facets
+    assert(topology.index_map(tdim - 1));
+    std::int32_t num_facets = topology.index_map(tdim - 1)->size_local();
+    std::vector<std::int8_t> interprocess_marker(
+        num_facets + topology.index_map(tdim - 1)->num_ghosts(), 0);
+    std::ranges::for_each(topology.interprocess_facets(),
+                          [&interprocess_marker](auto f)
+                          { interprocess_marker[f] = 1; });
+
+    entities.reserve(4 * num_facets);
+    for (std::int32_t f = 0; f < num_facets; ++f)
+    {
+      if (f_to_c->num_links(f) == 2)
+      {
+        auto pairs = fem::impl::get_cell_facet_pairs<2>(f, f_to_c->links(f),
+                                                        *c_to_f);
+        entities.insert(entities.end(), pairs.begin(), pairs.end());
+      }
+      else if (interprocess_marker[f])
+      {
+        throw std::runtime_error(
+            "Cannot compute interior facet integral over interprocess "
+            "facet. Please use ghost mode shared facet when creating the "
+            "mesh");
+      }
+    }
+
+    // Order the facets by their first ('+') cell, so that facets of a
+    // cell are assembled consecutively and the cell data is reused.
+    // The sort is stable, and the restrictions are not changed.
+    std::vector<std::int32_t> perm(entities.size() / 4);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::stable_sort(perm, [&entities](auto p0, auto p1)
+                             { return entities[4 * p0] < entities[4 * p1]; });
+    std::vector<std::int32_t> sorted(entities.size());
+    for (std::size_t k = 0; k < perm.size(); ++k)
+    {
+      std::copy_n(std::next(entities.begin(), 4 * perm[k]), 4,
+                  std::next(sorted.begin(), 4 * k));
+    }
+    entities = std::move(sorted);
+    break;
+  }
+  default:
+    throw std::runtime_error("Integral type not supported.");
+  }
+
+  return entities;
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>>
+fem::IntegrationDomainCache::default_domain(
+    std::shared_ptr<const mesh::Topology> topology, IntegralType type)
+{
+  assert(topology);
+  return get({topology.get(), 0, type, -1}, topology,
+             [&topology, type]()
+             { return compute_default_domain(*topology, type); });
+}
+//-----------------------------------------------------------------------------
+void fem::IntegrationDomainCache::clear()
+{
+  std::scoped_lock lock(_mutex);
+  _entries.clear();
+}
+//-----------------------------------------------------------------------------
+std::size_t fem::IntegrationDomainCache::size() const
+{
+  std::scoped_lock lock(_mutex);
+  return _entries.size();
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>>
+fem::IntegrationDomainCache::tagged_domain(
+    std::shared_ptr<const mesh::Topology> topology, std::uint64_t tags_id,
+    IntegralType type, std::int64_t value,
+    std::function<std::vector<std::int32_t>()> entities)
+{
+  assert(topology);
+  return get({topology.get(), tags_id, type, value}, topology,
+             [&topology, type, &entities]()
+             {
+               return compute_integration_domains(type, *topology,
+                                                  entities());
+             });
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>>
+fem::IntegrationDomainCache::get(
+    const key_t& key, std::shared_ptr<const mesh::Topology> topology,
+    std::function<std::vector<std::int32_t>()> compute)
+{
+  std::scoped_lock lock(_mutex);
+  if (auto it = _entries.find(key); it != _entries.end())
+  {
+    // The address of a destroyed topology may be reused by a new
+    // topology, so the topology of the entry is checked
+    if (it->second.topology.lock() == topology)
+      return it->second.entities;
+  }
+
+  // Remove the entries of destroyed topologies
+  std::erase_if(_entries,
+                [](auto& e) { return e.second.topology.expired(); });
+
+  auto entities
+      = std::make_shared<const std::vector<std::int32_t>>(compute());
+  _entries.insert_or_assign(key, entry_t{topology, entities});
+  return entities;
+}
+//-----------------------------------------------------------------------------
+fem::IntegrationDomainCache& fem::integration_domain_cache()
+{
+  static IntegrationDomainCache cache;
+  return cache;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+class Topology;
+template <typename T>
+class MeshTags;
+} // namespace dolfinx::mesh
+
+namespace dolfinx::fem
+{
+/// @brief Cache of the integration entities of mesh topologies and
+/// mesh tags.
+///
+/// The integration entities of a domain are the cells for cell
+/// integrals, the (cell, local facet) pairs for exterior facet
+/// integrals and the pairs of (cell, local facet) pairs for interior
+/// facet integrals (see fem::compute_integration_domains). Computing
+/// them requires facet-to-cell look-ups, which are repeated for every
+/// form over the same domain. The cache stores the entities of each
+/// domain once, keyed on the topology, the mesh tags (with the tag
+/// value) and the integral type, so that forms on the same domain
+/// share the computation. The default domains are used by
+/// fem::create_form_factory for integrals with id `-1`.
+///
+/// Entries hold a weak reference to the topology and are discarded when
+/// the topology is destroyed.
+///
+/// @warning The entities are not recomputed if the topology is modified
+/// after an entry is created. Call IntegrationDomainCache::clear if the
+/// topology is changed.
+///
+/// @note The cache is thread-safe.
+class IntegrationDomainCache
+{
+public:
+  /// Create an empty cache
+  IntegrationDomainCache() = default;
+
+  /// @brief Integration entities of the default domain (all owned
+  /// cells, exterior facets or interior facets) of a topology.
+  ///
+  /// Interior facets are ordered by their first ('+') cell, so that
+  /// the facets of a cell are assembled consecutively.
+  /// @pre For facet integrals, the facets and the facet-to-cell and
+  /// cell-to-facet connectivity of the topology must have been
+  /// computed.
+  /// @param[in] topology Mesh topology.
+  /// @param[in] type Integral type.
+  /// @return List of integration entity data.
+  std::shared_ptr<const std::vector<std::int32_t>>
+  default_domain(std::shared_ptr<const mesh::Topology> topology,
+                 IntegralType type);
+
+  /// @brief Integration entities of the entities with a given tag
+  /// value.
+  /// @pre See fem::compute_integration_domains.
+  /// @param[in] tags Mesh tags of cells (for cell integrals) or facets.
+  /// @param[in] type Integral type.
+  /// @param[in] value Tag value of the domain.
+  /// @return List of integration entity data.
+  template <std::integral T>
+  std::shared_ptr<const std::vector<std::int32_t>>
+  domain(const mesh::MeshTags<T>& tags, IntegralType type, T value)
+  {
+    return tagged_domain(tags.topology(), tags.id(), type, value,
+                         [&tags, value]() { return tags.find(value); });
+  }
+
+  /// Remove all entries
+  void clear();
+
+  /// Number of entries
+  std::size_t size() const;
+
+private:
+  // Get the entities of a tagged domain, computing them from the
+  // tagged entities if the domain is not in the cache
+  std::shared_ptr<const std::vector<std::int32_t>>
+  tagged_domain(std::shared_ptr<const mesh::Topology> topology,
+                std::uint64_t tags_id, IntegralType type, std::int64_t value,
+                std::function<std::vector<std::int32_t>()> entities);
+
+  // Key (topology, tags id, integral type, tag value). The tags id of
+  // a default domain is 0.
+  using key_t = std::tuple<const mesh::Topology*, std::uint64_t,
+                           IntegralType, std::int64_t>;
+
+  // Get an entry, computing it if it is not in the cache
+  std::shared_ptr<const std::vector<std::int32_t>>
+  get(const key_t& key, std::shared_ptr<const mesh::Topology> topology,
+      std::function<std::vector<std::int32_t>()> compute);
+
+  struct entry_t
+  {
+    // Topology of the entry, which is used to detect entries of
+    // destroyed topologies, since the address may be reused
+    std::weak_ptr<const mesh::Topology> topology;
+
+    // Integration entities
+    std::shared_ptr<const std::vector<std::int32_t>> entities;
+  };
+
+  mutable std::mutex _mutex;
+  std::map<key_t, entry_t> _entries;
+};
+
+/// @brief Cache of integration entities shared by all forms.
+IntegrationDomainCache& integration_domain_cache();
+} // namespace dolfinx::fem
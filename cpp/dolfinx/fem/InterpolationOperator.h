@@ -0,0 +1,126 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include "discreteoperators.h"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+namespace dolfinx::fem
+{
+/// @brief Interpolation between finite element spaces on the same mesh
+/// as a distributed sparse operator.
+///
+/// Interpolation of a Function in a space `V0` into a space `V1` on the
+/// same mesh (see Function::interpolate(const Function&, int)) is
+/// linear in the expansion coefficients. This class builds the matrix
+/// of this linear map once (see fem::create_interpolation_matrix), and
+/// each application is a sparse matrix-vector product. This avoids
+/// re-computing the element interpolation matrices, the dof
+/// transformations and the cell-wise insertion when functions are
+/// repeatedly interpolated between the same spaces, e.g. from a P2 to a
+/// P1 space, or from a Nédélec to a discontinuous Lagrange space, for
+/// output at each time step.
+///
+/// @note The result is the same as Function::interpolate when the
+/// interpolated functions are continuous in the sense of the
+/// degrees-of-freedom of `V1`. Otherwise, each degree-of-freedom takes
+/// its value from one of the cells that contains it.
+///
+/// @tparam T Scalar type of the functions.
+/// @tparam U Geometry type of the mesh.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class InterpolationOperator
+{
+public:
+  /// Scalar type of the functions
+  using value_type = T;
+
+  /// Geometry type of the mesh
+  using geometry_type = U;
+
+  /// @brief Create the interpolation operator.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] V0 Space to interpolate from.
+  /// @param[in] V1 Space to interpolate into. It must be on the same
+  /// mesh as `V0`.
+  /// @param[in] num_threads Number of threads used to build the matrix.
+  InterpolationOperator(std::shared_ptr<const FunctionSpace<U>> V0,
+                        std::shared_ptr<const FunctionSpace<U>> V1,
+                        int num_threads = 1)
+      : _V0(V0), _V1(V1), _A(build(*V0, *V1, num_threads)),
+        _x(V0->dofmap()->index_map, V0->dofmap()->index_map_bs())
+  {
+  }
+
+  /// @brief Interpolate a Function.
+  ///
+  /// @note Collective
+  ///
+  /// @param[out] u Function to interpolate into. It must be in the
+  /// space `V1` of the operator.
+  /// @param[in] v Function to interpolate. It must be in the space `V0`
+  /// of the operator.
+  void apply(Function<T, U>& u, const Function<T, U>& v)
+  {
+    if (u.function_space() != _V1 or v.function_space() != _V0)
+    {
+      throw std::runtime_error(
+          "Functions are not in the spaces of the interpolation operator.");
+    }
+
+    // Copy the owned coefficients of v, since the ghost values are
+    // updated by the product
+    const std::int32_t size_local = _x.index_map()->size_local() * _x.bs();
+    std::copy_n(v.x()->array().begin(), size_local,
+                _x.mutable_array().begin());
+
+    std::shared_ptr<la::Vector<T>> y = u.x();
+    std::fill_n(y->mutable_array().begin(),
+                y->index_map()->size_local() * y->bs(), T(0));
+    _A.mult(_x, *y);
+    y->scatter_fwd();
+  }
+
+  /// @brief The interpolation matrix. Rows are distributed as `V1` and
+  /// columns as `V0`.
+  const la::MatrixCSR<T>& matrix() const { return _A; }
+
+private:
+  static la::MatrixCSR<T> build(const FunctionSpace<U>& V0,
+                                const FunctionSpace<U>& V1,
+                                int num_threads)
+  {
+    if (V0.mesh() != V1.mesh())
+      throw std::runtime_error("Spaces must be on the same mesh.");
+    return create_interpolation_matrix<T>(V0, V1, num_threads);
+  }
+
+  // Spaces to interpolate from (V0) and into (V1)
+  std::shared_ptr<const FunctionSpace<U>> _V0, _V1;
+
+  // Interpolation matrix
+  la::MatrixCSR<T> _A;
+
+  // Work vector, with the layout of the coefficients of V0
+  la::Vector<T> _x;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,261 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "FiniteElement.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include "interpolate.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Interpolation of expressions f(x) into a finite element space
+/// on a fixed set of cells, with cached cell geometry.
+///
+/// Function::interpolate with a callable computes the physical
+/// interpolation points (see fem::interpolation_coords) and, for
+/// elements that are not mapped by the identity (e.g. Piola mapped
+/// elements), the Jacobian of the geometry map at these points, on
+/// every call. This class computes these once when it is created.
+/// Repeated interpolation, e.g. of a time-dependent source term at each
+/// time step, then only evaluates the expression and applies the
+/// interpolation operator.
+///
+/// If the mesh geometry changes, Interpolator::update_geometry must be
+/// called.
+///
+/// @tparam T Scalar type of the functions.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class Interpolator
+{
+  template <typename X, std::size_t d>
+  using mdspan_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      X, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, d>>;
+  using x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+          std::size_t, 3, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>;
+
+public:
+  /// Scalar type of the functions
+  using value_type = T;
+
+  /// Geometry type of the mesh
+  using geometry_type = U;
+
+  /// @brief Create an interpolator for a space on a set of cells.
+  /// @param[in] V Space to interpolate into.
+  /// @param[in] cells Cells on which to interpolate.
+  Interpolator(std::shared_ptr<const FunctionSpace<U>> V,
+               std::vector<std::int32_t> cells)
+      : _V(V), _cells(std::move(cells))
+  {
+    assert(_V);
+    assert(_V->element());
+    assert(_V->mesh());
+    update_geometry();
+  }
+
+  /// @brief Create an interpolator for a space on all cells (owned and
+  /// ghost) of its mesh.
+  /// @param[in] V Space to interpolate into.
+  explicit Interpolator(std::shared_ptr<const FunctionSpace<U>> V)
+      : Interpolator(V, all_cells(*V))
+  {
+  }
+
+  /// @brief Re-compute the cached interpolation points and Jacobian
+  /// data.
+  ///
+  /// This must be called if the mesh geometry has changed.
+  void update_geometry()
+  {
+    const FiniteElement<U>& element = *_V->element();
+    const mesh::Geometry<U>& geometry = _V->mesh()->geometry();
+    _x = interpolation_coords<U>(element, geometry, _cells);
+
+    _J.clear();
+    _K.clear();
+    _detJ.clear();
+    if (element.map_ident())
+      return;
+
+    // Jacobian data at the interpolation points, which is required to
+    // pull back the values of Piola mapped elements
+    const CoordinateElement<U>& cmap = geometry.cmap();
+    auto x_dofmap = geometry.dofmap();
+    mesh::NodeCoordinates<U> x_g = geometry.coordinates();
+    const std::size_t gdim = geometry.dim();
+    const std::size_t tdim = _V->mesh()->topology()->dim();
+    const std::size_t num_dofs_g = cmap.dim();
+
+    const auto [X, Xshape] = element.interpolation_points();
+    const std::size_t np = Xshape[0];
+    const std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, np);
+    std::vector<U> phi_b(std::reduce(phi_shape.begin(), phi_shape.end(), 1,
+                                     std::multiplies{}));
+    mdspan_t<const U, 4> phi(phi_b.data(), phi_shape);
+    cmap.tabulate(1, X, Xshape, phi_b);
+
+    const std::size_t num_cells = _cells.size();
+    _J.assign(num_cells * np * gdim * tdim, 0);
+    _K.resize(num_cells * np * tdim * gdim);
+    _detJ.resize(num_cells * np);
+    mdspan_t<U, 4> J(_J.data(), num_cells, np, gdim, tdim);
+    mdspan_t<U, 4> K(_K.data(), num_cells, np, tdim, gdim);
+
+    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+    mdspan_t<U, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+    std::vector<U> det_scratch(2 * gdim * tdim);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, _cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = x_g(x_dofs[i], j);
+
+      for (std::size_t p = 0; p < np; ++p)
+      {
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(std::size_t(1), tdim + 1), p,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+        auto Jp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, c, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian(dphi, coord_dofs, Jp);
+        auto Kp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, c, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian_inverse(Jp, Kp);
+        _detJ[c * np + p] = cmap.compute_jacobian_determinant(Jp, det_scratch);
+      }
+    }
+  }
+
+  /// @brief Physical coordinates of the interpolation points.
+  /// @return Coordinates (`shape=(3, num_points)`), ordered as for
+  /// fem::interpolation_coords.
+  x_t x() const { return x_t(_x.data(), 3, _x.size() / 3); }
+
+  /// @brief Interpolate an evaluated expression.
+  /// @param[out] u Function to interpolate into. Its space must have the
+  /// same element and mesh as the space of the interpolator.
+  /// @param[in] f Values of the expression at the points Interpolator::x
+  /// (`shape=(value_size, num_points)`, row-major).
+  /// @param[in] fshape Shape of `f`.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// expansion coefficients from the values of `f`.
+  void interpolate(Function<T, U>& u, std::span<const T> f,
+                   std::array<std::size_t, 2> fshape,
+                   int num_threads = 1) const
+  {
+    auto V = u.function_space();
+    assert(V);
+    if (V != _V
+        and (V->mesh() != _V->mesh() or *V->element() != *_V->element()))
+    {
+      throw std::runtime_error(
+          "Function space is incompatible with the interpolator.");
+    }
+
+    if (fshape[1] != _x.size() / 3)
+      throw std::runtime_error("Interpolation data has the wrong shape.");
+
+    impl::interpolate(u, f, fshape, std::span<const std::int32_t>(_cells),
+                      num_threads, std::span<const U>(_J),
+                      std::span<const U>(_K), std::span<const U>(_detJ));
+  }
+
+  /// @brief Interpolate an expression f(x).
+  /// @param[out] u Function to interpolate into. Its space must have the
+  /// same element and mesh as the space of the interpolator.
+  /// @param[in] f Expression to be interpolated. It is evaluated at the
+  /// points Interpolator::x, and returns the values and their shape as
+  /// for Function::interpolate.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// expansion coefficients from the values of `f`.
+  void interpolate(
+      Function<T, U>& u,
+      const std::function<
+          std::pair<std::vector<T>, std::vector<std::size_t>>(x_t)>& f,
+      int num_threads = 1) const
+  {
+    const auto [fx, fshape] = f(x());
+    std::array<std::size_t, 2> _fshape;
+    if (fshape.size() == 1)
+      _fshape = {1, fshape[0]};
+    else if (fshape.size() == 2)
+      _fshape = {fshape[0], fshape[1]};
+    else
+      throw std::runtime_error("Expected 1D or 2D array of data");
+
+    if (_fshape[0] != std::size_t(_V->element()->value_size()))
+    {
+      throw std::runtime_error(
+          "Data returned by callable has wrong shape(0) size");
+    }
+
+    interpolate(u, std::span<const T>(fx.data(), fx.size()), _fshape,
+                num_threads);
+  }
+
+  /// @brief The space that is interpolated into.
+  std::shared_ptr<const FunctionSpace<U>> function_space() const
+  {
+    return _V;
+  }
+
+  /// @brief Cells on which the interpolation is performed.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+private:
+  // Indices of all cells (owned and ghost) of the mesh of V
+  static std::vector<std::int32_t> all_cells(const FunctionSpace<U>& V)
+  {
+    assert(V.mesh());
+    auto topology = V.mesh()->topology();
+    assert(topology);
+    auto map = topology->index_map(topology->dim());
+    assert(map);
+    std::vector<std::int32_t> cells(map->size_local() + map->num_ghosts());
+    std::iota(cells.begin(), cells.end(), 0);
+    return cells;
+  }
+
+  // Space that is interpolated into
+  std::shared_ptr<const FunctionSpace<U>> _V;
+
+  // Cells to interpolate on
+  std::vector<std::int32_t> _cells;
+
+  // Physical interpolation points (shape=(3, num_points))
+  std::vector<U> _x;
+
+  // Jacobian, inverse and determinant at the interpolation points of
+  // each cell (empty if the element map is the identity)
+  std::vector<U> _J, _K, _detJ;
+};
+} // namespace dolfinx::fem
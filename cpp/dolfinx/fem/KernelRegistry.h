@@ -0,0 +1,363 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/types.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Registry of alternative implementations (variants) of the
+/// kernels of a Form, with selection of the fastest variant by timing.
+///
+/// A generated kernel can have, e.g., hand-vectorised, batched or
+/// device variants, and which is fastest depends on the machine. The
+/// variants of an integral are registered with KernelRegistry::add, and
+/// KernelRegistry::tune times each variant on a sample of the
+/// integration entities and sets the fastest as the kernel of the form
+/// (see Form::set_kernel). Choices are stored by a key that identifies
+/// the form, and can be saved to a file so that later runs on the same
+/// machine start on the tuned choice without timing:
+///
+///     KernelRegistry<double> registry;
+///     registry.add(IntegralType::cell, -1, "generated",
+///                  a.kernel(IntegralType::cell, -1));
+///     registry.add(IntegralType::cell, -1, "simd", simd_kernel);
+///     registry.load("kernels.txt");
+///     registry.tune(a, "poisson_a");
+///     registry.save("kernels.txt");
+///
+/// @note The tuned choices depend on the machine, so a file should be
+/// used per machine (type).
+/// @tparam T Scalar type of the form.
+/// @tparam U Geometry type of the form.
+template <dolfinx::scalar T, std::floating_point U = scalar_value_type_t<T>>
+class KernelRegistry
+{
+public:
+  /// Kernel function type
+  using kernel_type = std::function<void(T*, const T*, const T*, const U*,
+                                         const int*, const std::uint8_t*)>;
+
+  /// @brief Register a kernel variant of an integral.
+  /// @param[in] type Integral type.
+  /// @param[in] id Domain identifier (index) of the integral.
+  /// @param[in] name Name of the variant. It must be unique for the
+  /// integral and must not contain whitespace.
+  /// @param[in] kernel Kernel that computes the same element tensor as
+  /// the other variants of the integral.
+  void add(IntegralType type, int id, const std::string& name,
+           kernel_type kernel)
+  {
+    if (!valid_name(name))
+      throw std::runtime_error("Invalid kernel variant name.");
+    auto& v = _variants[{type, id}];
+    if (std::ranges::any_of(v, [&name](auto& k) { return k.first == name; }))
+      throw std::runtime_error("Kernel variant already registered.");
+    v.emplace_back(name, std::move(kernel));
+  }
+
+  /// @brief Names of the registered variants of an integral.
+  /// @param[in] type Integral type.
+  /// @param[in] id Domain identifier (index) of the integral.
+  /// @return Variant names, in the order they were registered.
+  std::vector<std::string> variants(IntegralType type, int id) const
+  {
+    std::vector<std::string> names;
+    if (auto it = _variants.find({type, id}); it != _variants.end())
+    {
+      std::ranges::transform(it->second, std::back_inserter(names),
+                             [](auto& k) { return k.first; });
+    }
+    return names;
+  }
+
+  /// @brief Chosen variant of an integral of a form.
+  /// @param[in] key Key of the form.
+  /// @param[in] type Integral type.
+  /// @param[in] id Domain identifier (index) of the integral.
+  /// @return Name of the chosen variant, or `std::nullopt` if the
+  /// integral has not been tuned.
+  std::optional<std::string> choice(const std::string& key, IntegralType type,
+                                    int id) const
+  {
+    if (auto it = _choices.find({key, type, id}); it != _choices.end())
+      return it->second;
+    else
+      return std::nullopt;
+  }
+
+  /// @brief Set the fastest variant as the kernel of each integral of
+  /// a form that has registered variants.
+  ///
+  /// Integrals with a stored choice (see KernelRegistry::load) for a
+  /// registered variant are not timed. Otherwise each variant is
+  /// executed once to warm up and then `num_repeats` times over a
+  /// sample of the integration entities, and the variant with the
+  /// lowest time is chosen. Timings are reduced to the maximum over the
+  /// processes, so all processes choose the same variant.
+  ///
+  /// @note Collective MPI operation over the communicator of the mesh
+  /// of the form. The same variants must be registered on all
+  /// processes.
+  /// @param[in,out] form The form. The kernels of the tuned integrals
+  /// are replaced.
+  /// @param[in] key Key that identifies the form, e.g. its name. It
+  /// must not contain whitespace.
+  /// @param[in] num_samples Maximum number of entities per integral on
+  /// which the variants are timed.
+  /// @param[in] num_repeats Number of timed executions of each variant.
+  /// @return Map from a form `(integral_type, domain_id)` pair to the
+  /// name of the chosen variant.
+  std::map<std::pair<IntegralType, int>, std::string>
+  tune(Form<T, U>& form, const std::string& key,
+       std::size_t num_samples = 256, int num_repeats = 3)
+  {
+    if (!valid_name(key))
+      throw std::runtime_error("Invalid form key.");
+
+    // Integrals of the form with variants, and whether they need to be
+    // timed on any process
+    std::vector<std::pair<IntegralType, int>> integrals;
+    std::vector<std::int8_t> timed;
+    for (auto& [itg, v] : _variants)
+    {
+      std::vector<int> ids = form.integral_ids(itg.first);
+      if (v.empty() or std::ranges::find(ids, itg.second) == ids.end())
+        continue;
+      integrals.push_back(itg);
+      std::optional<std::string> name = choice(key, itg.first, itg.second);
+      timed.push_back(!name or find(v, *name) == v.end());
+    }
+
+    MPI_Comm comm = form.mesh()->comm();
+    MPI_Allreduce(MPI_IN_PLACE, timed.data(), timed.size(), MPI_INT8_T,
+                  MPI_MAX, comm);
+
+    // Time the variants of the integrals that need it
+    std::vector<double> times;
+    for (std::size_t k = 0; k < integrals.size(); ++k)
+    {
+      if (timed[k])
+      {
+        auto [type, id] = integrals[k];
+        std::vector<double> t = time_variants(
+            form, type, id, _variants[integrals[k]], num_samples, num_repeats);
+        times.insert(times.end(), t.begin(), t.end());
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, times.data(), times.size(), MPI_DOUBLE,
+                  MPI_MAX, comm);
+
+    std::map<std::pair<IntegralType, int>, std::string> chosen;
+    auto t = times.begin();
+    for (std::size_t k = 0; k < integrals.size(); ++k)
+    {
+      auto [type, id] = integrals[k];
+      auto& v = _variants[integrals[k]];
+      if (timed[k])
+      {
+        auto t1 = std::next(t, v.size());
+        std::size_t fastest = std::distance(t, std::min_element(t, t1));
+        _choices[{key, type, id}] = v[fastest].first;
+        t = t1;
+      }
+
+      const std::string& name = _choices.at({key, type, id});
+      form.set_kernel(type, id, find(v, name)->second);
+      chosen.insert({integrals[k], name});
+    }
+
+    return chosen;
+  }
+
+  /// @brief Load stored choices from a file written by
+  /// KernelRegistry::save.
+  ///
+  /// Choices in the file replace stored choices with the same key and
+  /// integral. A file that does not exist is ignored.
+  /// @param[in] filename Name of the file.
+  void load(const std::filesystem::path& filename)
+  {
+    std::ifstream file(filename);
+    if (!file)
+      return;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+      if (line.empty() or line.front() == '#')
+        continue;
+      std::istringstream s(line);
+      std::string key, name;
+      int type, id;
+      if (!(s >> key >> type >> id >> name) or type < 0 or type > 3)
+      {
+        throw std::runtime_error("Invalid line in kernel choice file: "
+                                 + line);
+      }
+      _choices[{key, static_cast<IntegralType>(type), id}] = name;
+    }
+  }
+
+  /// @brief Save the stored choices to a file.
+  ///
+  /// Each line of the file is a choice, `<key> <integral type> <domain
+  /// id> <variant name>`.
+  /// @note Since the choices are the same on all processes after
+  /// KernelRegistry::tune, this is typically called on one process.
+  /// @param[in] filename Name of the file. It is overwritten.
+  void save(const std::filesystem::path& filename) const
+  {
+    std::ofstream file(filename);
+    if (!file)
+      throw std::runtime_error("Could not open kernel choice file.");
+    file << "# key integral_type domain_id variant\n";
+    for (auto& [c, name] : _choices)
+    {
+      auto& [key, type, id] = c;
+      file << key << " " << static_cast<int>(type) << " " << id << " "
+           << name << "\n";
+    }
+  }
+
+private:
+  using variant_list = std::vector<std::pair<std::string, kernel_type>>;
+
+  static bool valid_name(const std::string& name)
+  {
+    return !name.empty()
+           and std::ranges::none_of(
+               name, [](unsigned char c) { return std::isspace(c); });
+  }
+
+  static typename variant_list::const_iterator find(const variant_list& v,
+                                           const std::string& name)
+  {
+    return std::ranges::find(v, name, [](auto& k) { return k.first; });
+  }
+
+  // Time (in seconds) of each variant of an integral on a sample of
+  // its entities on this process
+  static std::vector<double> time_variants(const Form<T, U>& form,
+                                           IntegralType type, int id,
+                                           const variant_list& variants,
+                                           std::size_t num_samples,
+                                           int num_repeats)
+  {
+    std::shared_ptr<const mesh::Mesh<U>> mesh = form.mesh();
+    assert(mesh);
+    const mesh::Geometry<U>& geometry = mesh->geometry();
+    auto x_dofmap = geometry.dofmap();
+    mesh::NodeCoordinates<U> x = geometry.coordinates();
+
+    // Entity data of each integration entity, and the number of cells
+    // an entity is integrated over
+    const int stride = type == IntegralType::cell             ? 1
+                       : type == IntegralType::interior_facet ? 4
+                                                              : 2;
+    const int num_cells = type == IntegralType::interior_facet ? 2 : 1;
+    std::span<const std::int32_t> entities = form.domain(type, id);
+    const std::size_t num_entities = entities.size() / stride;
+    const std::size_t ns = std::min(num_entities, num_samples);
+
+    // Element tensor
+    std::size_t size = 1;
+    for (auto& V : form.function_spaces())
+      size *= num_cells * V->dofmap()->map().extent(1) * V->dofmap()->bs();
+    std::vector<T> Ae(size);
+
+    // Gather the geometry, local entity indices and coefficients of the
+    // sampled entities, which are evenly spaced over the entities
+    auto [coeffs, cstride] = allocate_coefficient_storage(form, type, id);
+    pack_coefficients(form, type, id, std::span<T>(coeffs), cstride);
+    const std::vector<T> constants = pack_constants(form);
+    const std::size_t cdofs_size = num_cells * 3 * x_dofmap.extent(1);
+    std::vector<U> cdofs(ns * cdofs_size);
+    std::vector<int> local(ns * 2, 0);
+    std::vector<const T*> c(ns, coeffs.data());
+    for (std::size_t s = 0; s < ns; ++s)
+    {
+      std::size_t e = s * num_entities / ns;
+      for (int j = 0; j < num_cells; ++j)
+      {
+        std::int32_t cell
+            = entities[e * stride + (type == IntegralType::cell ? 0 : 2 * j)];
+        auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        x.copy(x_dofs, cdofs.data() + s * cdofs_size
+                           + j * 3 * x_dofmap.extent(1));
+        if (type != IntegralType::cell)
+          local[2 * s + j] = entities[e * stride + 2 * j + 1];
+      }
+      if (!coeffs.empty())
+        c[s] = coeffs.data() + e * num_cells * cstride;
+    }
+
+    // Permutation data does not change the cost of a kernel
+    const std::array<std::uint8_t, 2> perm = {0, 0};
+
+    std::vector<double> times;
+    for (auto& [name, kernel] : variants)
+    {
+      auto run = [&]()
+      {
+        for (std::size_t s = 0; s < ns; ++s)
+        {
+          std::ranges::fill(Ae, T(0));
+          kernel(Ae.data(), c[s], constants.data(),
+                 cdofs.data() + s * cdofs_size, local.data() + 2 * s,
+                 perm.data());
+        }
+      };
+
+      run();
+      double t = std::numeric_limits<double>::max();
+      for (int r = 0; r < num_repeats; ++r)
+      {
+        common::Timer timer;
+        timer.start();
+        run();
+        t = std::min(t, timer.stop().count());
+      }
+      times.push_back(ns > 0 ? t : 0);
+    }
+
+    return times;
+  }
+
+  // Variants of each (integral_type, domain_id)
+  std::map<std::pair<IntegralType, int>, variant_list> _variants;
+
+  // Chosen variant of each (key, integral_type, domain_id)
+  std::map<std::tuple<std::string, IntegralType, int>, std::string> _choices;
+};
+} // namespace dolfinx::fem
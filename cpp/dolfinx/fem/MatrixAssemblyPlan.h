@@ -0,0 +1,229 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DirichletBC.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assembler.h"
+#include "utils.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+
+/// @brief Assembly plan for repeated assembly of a bilinear form into
+/// a matrix with a fixed sparsity.
+///
+/// The plan records, for each integration entity of the form, the
+/// positions in the matrix value array of every entry of the element
+/// matrix. The boundary condition dof markers are also computed once
+/// when the plan is created. Assembly with a plan adds the element
+/// matrices directly at the recorded positions, which avoids searching
+/// for the column indices of each entry on every assembly.
+///
+/// A plan is valid for as long as the integration domains of the form,
+/// the dofmaps, the boundary conditions and the sparsity of the matrix
+/// that the plan was created for are unchanged. Coefficient and
+/// constant values may change between assemblies.
+///
+/// @note Assembly with a plan is serial on each rank since the
+/// positions are recorded in the order of entity traversal.
+///
+/// @tparam T Scalar type of the form and matrix.
+/// @tparam U Geometry type of the form.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class MatrixAssemblyPlan
+{
+public:
+  /// @brief Create an assembly plan.
+  ///
+  /// @note Users will normally call fem::create_matrix_assembly_plan.
+  ///
+  /// @param[in] a Bilinear form to be assembled.
+  /// @param[in] dof_marker0 Boundary condition markers for the rows.
+  /// @param[in] dof_marker1 Boundary condition markers for the columns.
+  /// @param[in] positions Positions in the matrix value array of each
+  /// entry of each element matrix, in the order that the element
+  /// matrices are computed by fem::assemble_matrix.
+  MatrixAssemblyPlan(std::shared_ptr<const Form<T, U>> a,
+                     std::vector<std::int8_t> dof_marker0,
+                     std::vector<std::int8_t> dof_marker1,
+                     std::vector<std::int64_t> positions)
+      : _a(a), _dof_marker0(std::move(dof_marker0)),
+        _dof_marker1(std::move(dof_marker1)), _positions(std::move(positions))
+  {
+    assert(_a);
+  }
+
+  /// @brief Assemble the bilinear form into a matrix value array.
+  ///
+  /// The value array is not zeroed, and ghost rows are not
+  /// communicated.
+  ///
+  /// @param[in,out] A Value array of the matrix that the plan was
+  /// created for, e.g. la::MatrixCSR::values().
+  /// @param[in] constants Constants that appear in the form.
+  /// @param[in] coefficients Coefficients that appear in the form.
+  void assemble(std::span<T> A, std::span<const T> constants,
+                const std::map<std::pair<IntegralType, int>,
+                               std::pair<std::span<const T>, int>>&
+                    coefficients) const
+  {
+    std::size_t offset = 0;
+    auto mat_add = [&](std::span<const std::int32_t>,
+                       std::span<const std::int32_t>,
+                       std::span<const T> Ae) -> int
+    {
+      if (offset + Ae.size() > _positions.size())
+        throw std::runtime_error("Assembly plan does not match form.");
+      const std::int64_t* pos = _positions.data() + offset;
+      for (std::size_t k = 0; k < Ae.size(); ++k)
+      {
+        assert(pos[k] < (std::int64_t)A.size());
+        A[pos[k]] += Ae[k];
+      }
+      offset += Ae.size();
+      return 0;
+    };
+
+    fem::assemble_matrix(mat_add, *_a, constants, coefficients,
+                         std::span<const std::int8_t>(_dof_marker0),
+                         std::span<const std::int8_t>(_dof_marker1));
+    if (offset != _positions.size())
+      throw std::runtime_error("Assembly plan does not match form.");
+  }
+
+  /// @brief Assemble the bilinear form into a matrix value array.
+  ///
+  /// Constants and coefficients are packed before assembly. The value
+  /// array is not zeroed, and ghost rows are not communicated.
+  ///
+  /// @param[in,out] A Value array of the matrix that the plan was
+  /// created for, e.g. la::MatrixCSR::values().
+  void assemble(std::span<T> A) const
+  {
+    const std::vector<T> constants = pack_constants(*_a);
+    auto coefficients = allocate_coefficient_storage(*_a);
+    pack_coefficients(*_a, coefficients);
+    assemble(A, std::span(constants), make_coefficients_span(coefficients));
+  }
+
+  /// @brief The bilinear form that the plan assembles.
+  std::shared_ptr<const Form<T, U>> form() const { return _a; }
+
+  /// @brief Boundary condition markers for the rows.
+  std::span<const std::int8_t> dof_marker0() const { return _dof_marker0; }
+
+  /// @brief Boundary condition markers for the columns.
+  std::span<const std::int8_t> dof_marker1() const { return _dof_marker1; }
+
+  /// @brief Positions in the matrix value array of the element matrix
+  /// entries.
+  std::span<const std::int64_t> positions() const { return _positions; }
+
+private:
+  // Bilinear form
+  std::shared_ptr<const Form<T, U>> _a;
+
+  // Boundary condition markers
+  std::vector<std::int8_t> _dof_marker0, _dof_marker1;
+
+  // Value array positions of the element matrix entries
+  std::vector<std::int64_t> _positions;
+};
+
+/// @brief Create a plan for repeated assembly of a bilinear form into
+/// a la::MatrixCSR.
+///
+/// The element matrices are computed once to record the positions of
+/// their entries in the matrix. The matrix values are not modified.
+///
+/// @tparam BS0 Row block size of the data, as used with
+/// la::MatrixCSR::mat_add_values.
+/// @tparam BS1 Column block size of the data, as used with
+/// la::MatrixCSR::mat_add_values.
+/// @tparam F Form type.
+/// @tparam Mat Matrix type.
+/// @param[in] a Bilinear form to be assembled.
+/// @param[in] A Matrix to assemble into. Its sparsity must contain all
+/// entries of the form.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+/// @return Assembly plan.
+template <int BS0 = 1, int BS1 = 1, typename F, typename Mat>
+MatrixAssemblyPlan<typename F::scalar_type, typename F::geometry_type>
+create_matrix_assembly_plan(
+    std::shared_ptr<F> a, const Mat& A,
+    const std::vector<std::reference_wrapper<const DirichletBC<
+        typename F::scalar_type, typename F::geometry_type>>>& bcs)
+{
+  using T = typename F::scalar_type;
+  using U = typename F::geometry_type;
+  assert(a);
+
+  // Build dof markers
+  auto map0 = a->function_spaces().at(0)->dofmap()->index_map;
+  auto map1 = a->function_spaces().at(1)->dofmap()->index_map;
+  auto bs0 = a->function_spaces().at(0)->dofmap()->index_map_bs();
+  auto bs1 = a->function_spaces().at(1)->dofmap()->index_map_bs();
+  std::vector<std::int8_t> dof_marker0, dof_marker1;
+  assert(map0);
+  std::int32_t dim0 = bs0 * (map0->size_local() + map0->num_ghosts());
+  assert(map1);
+  std::int32_t dim1 = bs1 * (map1->size_local() + map1->num_ghosts());
+  for (std::size_t k = 0; k < bcs.size(); ++k)
+  {
+    assert(bcs[k].get().function_space());
+    if (a->function_spaces().at(0)->contains(*bcs[k].get().function_space()))
+    {
+      dof_marker0.resize(dim0, false);
+      bcs[k].get().mark_dofs(dof_marker0);
+    }
+
+    if (a->function_spaces().at(1)->contains(*bcs[k].get().function_space()))
+    {
+      dof_marker1.resize(dim1, false);
+      bcs[k].get().mark_dofs(dof_marker1);
+    }
+  }
+
+  // Record the positions of the element matrix entries
+  std::vector<std::int64_t> positions;
+  auto mat_positions = [&A, &positions](std::span<const std::int32_t> rows,
+                                        std::span<const std::int32_t> cols,
+                                        std::span<const T> Ae) -> int
+  {
+    std::size_t offset = positions.size();
+    positions.resize(offset + Ae.size());
+    A.template value_positions<BS0, BS1>(
+        rows, cols, std::span(positions).subspan(offset, Ae.size()));
+    return 0;
+  };
+
+  const std::vector<T> constants = pack_constants(*a);
+  auto coefficients = allocate_coefficient_storage(*a);
+  pack_coefficients(*a, coefficients);
+  fem::assemble_matrix(mat_positions, *a, std::span(constants),
+                       make_coefficients_span(coefficients),
+                       std::span<const std::int8_t>(dof_marker0),
+                       std::span<const std::int8_t>(dof_marker1));
+
+  return MatrixAssemblyPlan<T, U>(a, std::move(dof_marker0),
+                                  std::move(dof_marker1),
+                                  std::move(positions));
+}
+
+} // namespace dolfinx::fem
@@ -0,0 +1,361 @@
+// Copyright (C) 2024 Jørgen S. Dokken and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include "PointEvaluator.h"
+#include "interpolate.h"
+#include <algorithm>
+#include <basix/mdspan.hpp>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Interpolation between finite element spaces on different
+/// (non-matching) meshes as a distributed sparse operator.
+///
+/// Interpolation of a Function `v` on one mesh into a space on another
+/// mesh (see fem::interpolate(Function<T, U>&, const Function<T, U>&,
+/// std::span<const std::int32_t>, const
+/// geometry::PointOwnershipData<U>&)) is linear in the expansion
+/// coefficients of `v`. This class computes the matrix of this linear
+/// map once. The rows of the matrix are the (local) expansion
+/// coefficients that are interpolated into, and the columns are the
+/// expansion coefficients of `v`. Applying the operator is a ghost
+/// update of the coefficients of `v` followed by a local sparse
+/// matrix-vector product. This is much cheaper than
+/// fem::interpolate when functions are repeatedly interpolated
+/// between the same spaces, e.g. to couple solvers at each time step.
+///
+/// @tparam T Scalar type of the functions.
+/// @tparam U Geometry type of the meshes.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class NonMatchingInterpolator
+{
+public:
+  /// Scalar type of the functions
+  using value_type = T;
+
+  /// Geometry type of the meshes
+  using geometry_type = U;
+
+  /// @brief Create the interpolation operator.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] V0 Space to interpolate into.
+  /// @param[in] V1 Space to interpolate from. The mesh can differ from
+  /// the mesh of `V0`, but must have the same communicator.
+  /// @param[in] cells Cells indices relative to the mesh of `V0`
+  /// that will be interpolated into.
+  /// @param[in] interpolation_data Data required for associating the
+  /// interpolation points of `V0` with cells of the mesh of `V1`. This
+  /// is computed by fem::create_interpolation_data.
+  NonMatchingInterpolator(std::shared_ptr<const FunctionSpace<U>> V0,
+                          std::shared_ptr<const FunctionSpace<U>> V1,
+                          std::span<const std::int32_t> cells,
+                          const geometry::PointOwnershipData<U>&
+                              interpolation_data)
+      : _V0(V0), _V1(V1)
+  {
+    assert(V0);
+    assert(V1);
+    auto mesh0 = V0->mesh();
+    assert(mesh0);
+    MPI_Comm comm = mesh0->comm();
+    {
+      auto mesh1 = V1->mesh();
+      assert(mesh1);
+      int result;
+      MPI_Comm_compare(comm, mesh1->comm(), &result);
+      if (result == MPI_UNEQUAL)
+      {
+        throw std::runtime_error("Interpolation on different meshes is only "
+                                 "supported on the same communicator.");
+      }
+    }
+
+    auto element0 = V0->element();
+    assert(element0);
+    const std::size_t value_size = element0->value_size();
+    if (V1->element()->value_size() != int(value_size))
+      throw std::runtime_error("Value sizes of the spaces do not match.");
+
+    // Weights of the values at the points owned by this process, with
+    // the global index and owning rank of the expansion coefficients
+    // that each weight is applied to
+    std::shared_ptr<const DofMap> dofmap1 = V1->dofmap();
+    assert(dofmap1);
+    std::shared_ptr<const common::IndexMap> map1 = dofmap1->index_map;
+    assert(map1);
+    const int bs1 = dofmap1->index_map_bs();
+    const std::size_t num_cell_dofs1 = dofmap1->map().extent(1) * bs1;
+
+    const std::vector<U>& recv_points = interpolation_data.dest_points;
+    const std::size_t num_recv = recv_points.size() / 3;
+    const std::size_t weights_size = value_size * num_cell_dofs1;
+    std::vector<T> weights(num_recv * weights_size, 0);
+    std::vector<std::int64_t> cols(num_recv * num_cell_dofs1, 0);
+    std::vector<std::int32_t> owners(num_recv * num_cell_dofs1, -1);
+    {
+      PointEvaluator<T, U> evaluator(V1, recv_points, {num_recv, 3},
+                                     interpolation_data.dest_cells);
+      const int rank = dolfinx::MPI::rank(comm);
+      const std::int32_t size_local1 = map1->size_local();
+      const std::vector<std::int64_t> global1 = map1->global_indices();
+      std::span<const int> ghost_owners1 = map1->owners();
+      for (std::size_t q = 0; q < num_recv; ++q)
+      {
+        std::span<const std::int32_t> dofs
+            = dofmap1->cell_dofs(interpolation_data.dest_cells[q]);
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+        {
+          for (int k = 0; k < bs1; ++k)
+          {
+            const std::size_t pos = q * num_cell_dofs1 + i * bs1 + k;
+            cols[pos] = bs1 * global1[dofs[i]] + k;
+            owners[pos] = dofs[i] < size_local1
+                              ? rank
+                              : ghost_owners1[dofs[i] - size_local1];
+          }
+        }
+
+        std::span<T> w(weights.data() + q * weights_size, weights_size);
+        evaluator.for_each_weight(
+            q, [w, num_cell_dofs1](std::size_t i, std::size_t j, U wij)
+            { w[i * num_cell_dofs1 + j] += wij; });
+      }
+    }
+
+    // Send the weights to the processes that interpolate
+    const std::vector<int>& dest_ranks = interpolation_data.src_owner;
+    std::span<const int> src_ranks = interpolation_data.dest_owners;
+    const std::size_t num_points = dest_ranks.size();
+    std::vector<T> point_weights(num_points * weights_size);
+    std::vector<std::int64_t> point_cols(num_points * num_cell_dofs1);
+    std::vector<std::int32_t> point_owners(num_points * num_cell_dofs1);
+    impl::scatter_values(
+        comm, src_ranks, dest_ranks,
+        impl::mdspan_t<const T, 2>(weights.data(), num_recv, weights_size),
+        std::span(point_weights));
+    impl::scatter_values(comm, src_ranks, dest_ranks,
+                         impl::mdspan_t<const std::int64_t, 2>(
+                             cols.data(), num_recv, num_cell_dofs1),
+                         std::span(point_cols));
+    impl::scatter_values(comm, src_ranks, dest_ranks,
+                         impl::mdspan_t<const std::int32_t, 2>(
+                             owners.data(), num_recv, num_cell_dofs1),
+                         std::span(point_owners));
+
+    // Compute the local interpolation operator of each cell by
+    // interpolating unit values at each interpolation point and value
+    // component. The interpolation operator is applied cell-wise, so
+    // all cells are computed at once. An expansion coefficient that is
+    // shared by cells is set by the last cell in `cells`.
+    const std::size_t num_cell_points
+        = element0->interpolation_points().second[0];
+    if (num_points != cells.size() * num_cell_points)
+    {
+      throw std::runtime_error(
+          "Interpolation data does not match the interpolation points.");
+    }
+
+    std::shared_ptr<const DofMap> dofmap0 = V0->dofmap();
+    assert(dofmap0);
+    const int bs0 = dofmap0->bs();
+    Function<T, U> probe(V0);
+    std::span<const T> probe_x = probe.x()->array();
+    std::vector<std::int32_t> writer(probe_x.size(), -1);
+    for (std::size_t c = 0; c < cells.size(); ++c)
+    {
+      for (std::int32_t dof : dofmap0->cell_dofs(cells[c]))
+        for (int k = 0; k < bs0; ++k)
+          writer[bs0 * dof + k] = c;
+    }
+
+    for (std::size_t i = 0; i < writer.size(); ++i)
+    {
+      if (writer[i] >= 0)
+        _rows.push_back(i);
+    }
+
+    const std::size_t num_probes = value_size * num_cell_points;
+    std::vector<T> Pi(_rows.size() * num_probes);
+    std::vector<T> f(value_size * num_points);
+    for (std::size_t k = 0; k < num_probes; ++k)
+    {
+      const std::size_t j = k / num_cell_points, p = k % num_cell_points;
+      std::ranges::fill(f, 0);
+      for (std::size_t c = 0; c < cells.size(); ++c)
+        f[j * num_points + c * num_cell_points + p] = 1;
+      fem::interpolate<T>(probe, f, {value_size, num_points}, cells);
+      for (std::size_t r = 0; r < _rows.size(); ++r)
+        Pi[r * num_probes + k] = probe_x[_rows[r]];
+    }
+
+    // Compute the rows of the operator, with global column indices
+    std::vector<std::pair<std::int64_t, T>> row_entries;
+    std::vector<std::int64_t> row_cols;
+    std::vector<std::pair<std::int64_t, std::int32_t>> col_owners;
+    std::vector<T> row_values;
+    std::vector<std::int64_t> row_offsets(1, 0);
+    for (std::size_t r = 0; r < _rows.size(); ++r)
+    {
+      row_entries.clear();
+      const std::size_t c = writer[_rows[r]];
+      for (std::size_t k = 0; k < num_probes; ++k)
+      {
+        const T pi = Pi[r * num_probes + k];
+        const std::size_t j = k / num_cell_points, p = k % num_cell_points;
+        const std::size_t point = c * num_cell_points + p;
+        if (pi == T(0) or dest_ranks[point] < 0)
+          continue;
+
+        for (std::size_t l = 0; l < num_cell_dofs1; ++l)
+        {
+          if (T w = point_weights[point * weights_size + j * num_cell_dofs1
+                                  + l];
+              w != T(0))
+          {
+            const std::size_t pos = point * num_cell_dofs1 + l;
+            row_entries.emplace_back(point_cols[pos], pi * w);
+            col_owners.emplace_back(point_cols[pos], point_owners[pos]);
+          }
+        }
+      }
+
+      // Sum duplicate entries
+      std::ranges::sort(row_entries, [](auto& a, auto& b)
+                        { return a.first < b.first; });
+      for (auto it = row_entries.begin(); it != row_entries.end();)
+      {
+        auto it1 = std::find_if(it, row_entries.end(),
+                                [col = it->first](auto& e)
+                                { return e.first != col; });
+        row_cols.push_back(it->first);
+        row_values.push_back(std::accumulate(
+            it, it1, T(0), [](T s, auto& e) { return s + e.second; }));
+        it = it1;
+      }
+      row_offsets.push_back(row_cols.size());
+    }
+
+    // Create column index map. The owned columns are the owned
+    // expansion coefficients of V1.
+    const std::int32_t size_local = bs1 * map1->size_local();
+    const std::int64_t offset = bs1 * map1->local_range()[0];
+    std::ranges::sort(col_owners);
+    auto [unique_end, range_end] = std::ranges::unique(col_owners);
+    col_owners.erase(unique_end, range_end);
+    std::vector<std::int64_t> ghosts;
+    std::vector<int> ghost_owners;
+    for (auto [col, owner] : col_owners)
+    {
+      if (col < offset or col >= offset + size_local)
+      {
+        ghosts.push_back(col);
+        ghost_owners.push_back(owner);
+      }
+    }
+    _x = std::make_unique<la::Vector<T>>(
+        std::make_shared<common::IndexMap>(comm, size_local, ghosts,
+                                           ghost_owners),
+        1);
+
+    // Convert column indices to local indices
+    _offsets.assign(row_offsets.begin(), row_offsets.end());
+    _values = std::move(row_values);
+    _cols.resize(row_cols.size());
+    std::ranges::transform(
+        row_cols, _cols.begin(),
+        [&ghosts, offset, size_local](std::int64_t col) -> std::int32_t
+        {
+          if (col >= offset and col < offset + size_local)
+            return col - offset;
+          auto it = std::ranges::lower_bound(ghosts, col);
+          assert(it != ghosts.end() and *it == col);
+          return size_local + std::distance(ghosts.begin(), it);
+        });
+  }
+
+  /// @brief Interpolate a function into another function.
+  ///
+  /// The result is the same as fem::interpolate(Function<T, U>&, const
+  /// Function<T, U>&, std::span<const std::int32_t>, const
+  /// geometry::PointOwnershipData<U>&) with the cells and interpolation
+  /// data that the operator was created with. Expansion coefficients of
+  /// `u` that are not interpolated into are unchanged.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in,out] u Function to interpolate into.
+  /// @param[in] v Function to interpolate from.
+  void apply(Function<T, U>& u, const Function<T, U>& v)
+  {
+    if (u.function_space() != _V0 or v.function_space() != _V1)
+    {
+      throw std::runtime_error(
+          "Functions are not in the spaces of the interpolation operator.");
+    }
+
+    // Update ghost values of the coefficients of v
+    std::span<const T> x1 = v.x()->array();
+    std::span<T> x = _x->mutable_array();
+    const std::int32_t size_local = _x->index_map()->size_local();
+    std::copy_n(x1.begin(), size_local, x.begin());
+    _x->scatter_fwd();
+
+    std::span<T> y = u.x()->mutable_array();
+    for (std::size_t r = 0; r < _rows.size(); ++r)
+    {
+      T s = 0;
+      for (std::int64_t j = _offsets[r]; j < _offsets[r + 1]; ++j)
+        s += _values[j] * x[_cols[j]];
+      y[_rows[r]] = s;
+    }
+  }
+
+  /// @brief Number of stored entries of the operator on this process.
+  std::size_t num_nonzeros() const { return _values.size(); }
+
+private:
+  // Spaces to interpolate into (0) and from (1)
+  std::shared_ptr<const FunctionSpace<U>> _V0, _V1;
+
+  // Position of each row in the coefficient array of the functions in
+  // V0 (including ghosts)
+  std::vector<std::int32_t> _rows;
+
+  // Operator in compressed row storage, with local column indices
+  // relative to the index map of _x
+  std::vector<std::int64_t> _offsets;
+  std::vector<std::int32_t> _cols;
+  std::vector<T> _values;
+
+  // Coefficients of the function to interpolate from, with the ghost
+  // entries required by the operator
+  std::unique_ptr<la::Vector<T>> _x;
+};
+
+} // namespace dolfinx::fem
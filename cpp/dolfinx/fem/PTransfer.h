@@ -0,0 +1,202 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "FunctionSpace.h"
+#include <algorithm>
+#include <array>
+#include <basix/interpolation.h>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Matrix-free transfer operators between Lagrange spaces of
+/// different degree on the same mesh, for p-multigrid.
+///
+/// The prolongation `P` from a coarse space `V0` (e.g. degree `p/2`)
+/// to a fine space `V1` (e.g. degree `p`) is the interpolation of `V0`
+/// into `V1`, and the restriction is its transpose `P^T`. Both are
+/// applied cell-wise with the element interpolation matrix, which is
+/// the only matrix that is stored. No global matrix or sparsity pattern
+/// is created (cf. fem::InterpolationOperator), and each application
+/// requires a single scatter of the coarse vector (forward for the
+/// prolongation, reverse for the restriction).
+///
+/// The spaces must have the same block size and elements that do not
+/// need dof transformations, which is the case for Lagrange elements.
+///
+/// @tparam T Scalar type of the vectors.
+/// @tparam U Geometry type of the mesh.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class PTransfer
+{
+public:
+  /// Scalar type of the vectors
+  using value_type = T;
+
+  /// @brief Create the transfer operators.
+  /// @param[in] V0 Coarse space.
+  /// @param[in] V1 Fine space. It must be on the same mesh as `V0`.
+  PTransfer(std::shared_ptr<const FunctionSpace<U>> V0,
+            std::shared_ptr<const FunctionSpace<U>> V1)
+      : _V0(V0), _V1(V1)
+  {
+    assert(_V0);
+    assert(_V1);
+    if (_V0->mesh() != _V1->mesh())
+      throw std::runtime_error("Spaces must be on the same mesh.");
+
+    auto e0 = _V0->element();
+    auto e1 = _V1->element();
+    assert(e0);
+    assert(e1);
+    if (e0->is_mixed() or e1->is_mixed())
+      throw std::runtime_error("Mixed spaces are not supported.");
+    if (e0->block_size() != e1->block_size())
+      throw std::runtime_error("Spaces must have the same block size.");
+    if (e0->needs_dof_transformations() or e1->needs_dof_transformations())
+    {
+      throw std::runtime_error(
+          "Elements that need dof transformations are not supported.");
+    }
+
+    // Element interpolation matrix of the scalar elements, shape
+    // (num_dofs1, num_dofs0)
+    const auto [data, shape] = basix::compute_interpolation_operator<U>(
+        e0->basix_element(), e1->basix_element());
+    _num_dofs = {shape[1], shape[0]};
+    _Pe.assign(data.begin(), data.end());
+
+    // Mark the first cell of each owned dof of V1, such that the
+    // restriction gathers each owned fine dof once
+    auto dofmap1 = _V1->dofmap();
+    auto dofs1 = dofmap1->map();
+    const std::int32_t size_local1 = dofmap1->index_map->size_local();
+    std::vector<std::int8_t> visited(size_local1, false);
+    _first.resize(dofs1.size(), false);
+    for (std::size_t c = 0; c < dofs1.extent(0); ++c)
+    {
+      for (std::size_t i = 0; i < dofs1.extent(1); ++i)
+      {
+        if (std::int32_t dof = dofs1(c, i);
+            dof < size_local1 and !visited[dof])
+        {
+          visited[dof] = true;
+          _first[c * dofs1.extent(1) + i] = true;
+        }
+      }
+    }
+  }
+
+  /// @brief Compute `x1 = P x0` (prolongation).
+  ///
+  /// @note Collective
+  ///
+  /// @param[in,out] x0 Coarse vector. Ghost values are updated.
+  /// @param[out] x1 Fine vector. Owned and ghost entries are set.
+  void prolongation(la::Vector<T>& x0, la::Vector<T>& x1) const
+  {
+    x0.scatter_fwd();
+
+    const int bs = _V0->dofmap()->bs();
+    auto dofs0 = _V0->dofmap()->map();
+    auto dofs1 = _V1->dofmap()->map();
+    std::span<const T> _x0 = x0.array();
+    std::span<T> _x1 = x1.mutable_array();
+    for (std::size_t c = 0; c < dofs0.extent(0); ++c)
+    {
+      for (std::size_t i = 0; i < _num_dofs[1]; ++i)
+      {
+        const std::int32_t dof1 = dofs1(c, i);
+        for (int k = 0; k < bs; ++k)
+        {
+          T v = 0;
+          for (std::size_t j = 0; j < _num_dofs[0]; ++j)
+            v += _Pe[i * _num_dofs[0] + j] * _x0[dofs0(c, j) * bs + k];
+          _x1[dof1 * bs + k] = v;
+        }
+      }
+    }
+  }
+
+  /// @brief Compute `x0 = P^T x1` (restriction).
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] x1 Fine vector. Only owned entries are used.
+  /// @param[out] x0 Coarse vector. Owned entries are complete on
+  /// return.
+  void restriction(const la::Vector<T>& x1, la::Vector<T>& x0) const
+  {
+    std::ranges::fill(x0.mutable_array(), 0);
+
+    const int bs = _V0->dofmap()->bs();
+    auto dofs0 = _V0->dofmap()->map();
+    auto dofs1 = _V1->dofmap()->map();
+    std::span<const T> _x1 = x1.array();
+    std::span<T> _x0 = x0.mutable_array();
+    for (std::size_t c = 0; c < dofs0.extent(0); ++c)
+    {
+      for (std::size_t i = 0; i < _num_dofs[1]; ++i)
+      {
+        if (!_first[c * _num_dofs[1] + i])
+          continue;
+        const std::int32_t dof1 = dofs1(c, i);
+        for (std::size_t j = 0; j < _num_dofs[0]; ++j)
+        {
+          const T p = _Pe[i * _num_dofs[0] + j];
+          const std::int32_t dof0 = dofs0(c, j);
+          for (int k = 0; k < bs; ++k)
+            _x0[dof0 * bs + k] += p * _x1[dof1 * bs + k];
+        }
+      }
+    }
+
+    x0.scatter_rev(std::plus<T>());
+  }
+
+  /// @brief The coarse space.
+  std::shared_ptr<const FunctionSpace<U>> coarse_space() const
+  {
+    return _V0;
+  }
+
+  /// @brief The fine space.
+  std::shared_ptr<const FunctionSpace<U>> fine_space() const { return _V1; }
+
+  /// @brief The element interpolation matrix (row-major), with shape
+  /// `(num fine element dofs, num coarse element dofs)` for the scalar
+  /// elements.
+  std::span<const T> element_matrix() const { return _Pe; }
+
+private:
+  // Coarse (V0) and fine (V1) spaces
+  std::shared_ptr<const FunctionSpace<U>> _V0, _V1;
+
+  // Number of dofs of the scalar coarse and fine elements
+  std::array<std::size_t, 2> _num_dofs;
+
+  // Element interpolation matrix
+  std::vector<T> _Pe;
+
+  // True for the (cell, fine dof) pairs at which an owned fine dof is
+  // restricted
+  std::vector<std::int8_t> _first;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,137 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include "Function.h"
+#include "assembler.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+
+/// @brief Packed coefficients of a Form that are re-used between
+/// assemblies.
+///
+/// The packed coefficient arrays are allocated once, and are re-packed
+/// in place by PackedCoefficients::update. A coefficient is re-packed
+/// only if the values of its degree-of-freedom vector differ from the
+/// values when it was last packed. A copy of the values of each
+/// coefficient is kept to detect changes. This is useful for
+/// nonlinear problems where a form is assembled on every iteration but
+/// only some of the coefficients change, e.g. when an unchanged
+/// material parameter appears next to the current solution.
+///
+/// The packed coefficients are valid for as long as the integration
+/// domains of the form and the dofmaps of the coefficients are
+/// unchanged.
+///
+/// @tparam T Scalar type of the form.
+/// @tparam U Geometry type of the form.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class PackedCoefficients
+{
+public:
+  /// @brief Allocate storage for, and pack, the coefficients of a form.
+  /// @param[in] form The form.
+  /// @param[in] num_threads Number of threads used to pack each
+  /// coefficient.
+  explicit PackedCoefficients(std::shared_ptr<const Form<T, U>> form,
+                              int num_threads = 1)
+      : _form(form), _num_threads(num_threads),
+        _coeffs(allocate_coefficient_storage(*form)),
+        _values(form->coefficients().size()),
+        _packed(form->coefficients().size(), false)
+  {
+    update();
+  }
+
+  /// @brief Re-pack the coefficients whose values have changed since
+  /// they were last packed.
+  /// @return Number of coefficients that were re-packed.
+  int update()
+  {
+    const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
+        = _form->coefficients();
+    std::map<IntegralType, std::vector<std::int8_t>> active;
+    for (auto& [key, val] : _coeffs)
+    {
+      active.try_emplace(key.first,
+                         impl::active_coefficients(*_form, key.first));
+    }
+
+    int num_packed = 0;
+    for (std::size_t i = 0; i < coefficients.size(); ++i)
+    {
+      std::span<const T> x = coefficients[i]->x()->array();
+      if (_packed[i] and std::ranges::equal(x, _values[i]))
+        continue;
+
+      for (auto& [key, val] : _coeffs)
+      {
+        if (active.at(key.first)[i])
+        {
+          impl::pack_coefficient(*_form, key.first, key.second, i,
+                                 std::span<T>(val.first), val.second,
+                                 _num_threads);
+        }
+      }
+
+      _values[i].assign(x.begin(), x.end());
+      _packed[i] = true;
+      ++num_packed;
+    }
+
+    return num_packed;
+  }
+
+  /// @brief Mark all coefficients for re-packing on the next call to
+  /// PackedCoefficients::update.
+  ///
+  /// This is required if the degree-of-freedom values are unchanged but
+  /// the packed data has changed in another way, e.g. the mesh topology
+  /// entity permutations were re-computed.
+  void reset() { std::ranges::fill(_packed, false); }
+
+  /// @brief The packed coefficients, in the format that is passed to
+  /// the assemblers.
+  std::map<std::pair<IntegralType, int>, std::pair<std::span<const T>, int>>
+  coefficients() const
+  {
+    return make_coefficients_span(_coeffs);
+  }
+
+  /// @brief The form whose coefficients are packed.
+  std::shared_ptr<const Form<T, U>> form() const { return _form; }
+
+private:
+  // The form
+  std::shared_ptr<const Form<T, U>> _form;
+
+  // Number of threads used for packing
+  int _num_threads;
+
+  // Packed coefficients for each (integral type, domain id)
+  std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
+      _coeffs;
+
+  // Values of each coefficient when it was last packed
+  std::vector<std::vector<T>> _values;
+
+  // True if a coefficient has been packed
+  std::vector<std::int8_t> _packed;
+};
+
+} // namespace dolfinx::fem
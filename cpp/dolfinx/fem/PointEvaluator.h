@@ -0,0 +1,466 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Evaluation of finite element functions at a fixed set of
+/// points.
+///
+/// The reference coordinates of the points and the (pushed forward)
+/// values of the basis functions at each point are computed once when
+/// the evaluator is created. Evaluating a function is then a small
+/// dense product of the cell expansion coefficients with the cached
+/// basis values for each point. This is efficient when functions in the
+/// same space are evaluated repeatedly at the same points, e.g. probes
+/// that are evaluated at every time step.
+///
+/// The evaluator is valid for as long as the mesh geometry is
+/// unchanged.
+///
+/// @tparam T Scalar type of the functions.
+/// @tparam U Geometry type of the mesh.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class PointEvaluator
+{
+public:
+  /// Scalar type of the functions
+  using value_type = T;
+
+  /// Geometry type of the mesh
+  using geometry_type = U;
+
+  /// @brief Create an evaluator for functions in a space at points.
+  ///
+  /// @param[in] V Function space of the functions to evaluate.
+  /// @param[in] x Coordinates of the points. It has shape
+  /// `(num_points, 3)` and storage is row-major.
+  /// @param[in] xshape Shape of `x`.
+  /// @param[in] cells Cell indices such that `cells[i]` is the index of
+  /// the cell that contains the point x(i). Negative cell indices can
+  /// be passed, in which case the corresponding point is ignored.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// reference coordinates and basis values.
+  PointEvaluator(std::shared_ptr<const FunctionSpace<geometry_type>> V,
+                 std::span<const geometry_type> x,
+                 std::array<std::size_t, 2> xshape,
+                 std::span<const std::int32_t> cells, int num_threads = 1)
+      : _function_space(V), _cells(cells.begin(), cells.end())
+  {
+    assert(_function_space);
+    assert(x.size() == xshape[0] * xshape[1]);
+    if (xshape[0] != cells.size())
+    {
+      throw std::runtime_error(
+          "Number of points and number of cells must be equal.");
+    }
+
+    auto mesh = _function_space->mesh();
+    assert(mesh);
+    const std::size_t gdim = mesh->geometry().dim();
+    const std::size_t tdim = mesh->topology()->dim();
+    const CoordinateElement<geometry_type>& cmap = mesh->geometry().cmap();
+    auto x_dofmap = mesh->geometry().dofmap();
+    const std::size_t num_dofs_g = cmap.dim();
+    mesh::NodeCoordinates<U> x_g = mesh->geometry().coordinates();
+
+    auto element = _function_space->element();
+    assert(element);
+    const int num_sub_elements = element->num_sub_elements();
+    _bs_element = element->block_size();
+    if (num_sub_elements > 1 and num_sub_elements != _bs_element)
+    {
+      throw std::runtime_error("PointEvaluator is not supported for mixed "
+                               "elements. Extract subspaces.");
+    }
+    _reference_value_size = element->reference_value_size();
+    _space_dimension = element->space_dimension() / _bs_element;
+    _value_size = element->value_size();
+    _symmetric = element->symmetric();
+
+    std::span<const std::uint32_t> cell_info;
+    if (element->needs_dof_transformations())
+    {
+      mesh->topology_mutable()->create_entity_permutations();
+      cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+    }
+
+    // Evaluate geometry basis at point (0, 0, 0) on the reference
+    // cell. Used in affine case.
+    std::array<std::size_t, 4> phi0_shape = cmap.tabulate_shape(1, 1);
+    std::vector<geometry_type> phi0_b(std::reduce(
+        phi0_shape.begin(), phi0_shape.end(), 1, std::multiplies{}));
+    impl::mdspan_t<const geometry_type, 4> phi0(phi0_b.data(), phi0_shape);
+    cmap.tabulate(1, std::vector<geometry_type>(tdim), {1, tdim}, phi0_b);
+    auto dphi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        phi0, std::pair(1, tdim + 1), 0,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+    using xu_t = impl::mdspan_t<geometry_type, 2>;
+    using xU_t = impl::mdspan_t<const geometry_type, 2>;
+    using xJ_t = impl::mdspan_t<const geometry_type, 2>;
+    using xK_t = impl::mdspan_t<const geometry_type, 2>;
+    auto push_forward_fn
+        = element->basix_element().template map_fn<xu_t, xU_t, xJ_t, xK_t>();
+    auto apply_dof_transformation
+        = element->template dof_transformation_fn<geometry_type>(
+            doftransform::standard);
+
+    const std::size_t num_basis_values
+        = _space_dimension * _reference_value_size;
+    _basis.resize(xshape[0] * num_basis_values, 0);
+
+    // Compute reference coordinates and basis values for a block of
+    // points
+    auto compute_basis = [&](std::size_t p0, std::size_t p1)
+    {
+      const std::size_t np = p1 - p0;
+      std::vector<geometry_type> coord_dofs_b(num_dofs_g * gdim);
+      impl::mdspan_t<geometry_type, 2> coord_dofs(coord_dofs_b.data(),
+                                                  num_dofs_g, gdim);
+      std::vector<geometry_type> xp_b(1 * gdim);
+      impl::mdspan_t<geometry_type, 2> xp(xp_b.data(), 1, gdim);
+
+      // Data structure for evaluating geometry basis at specific
+      // points. Used in non-affine case.
+      std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, 1);
+      std::vector<geometry_type> phi_b(std::reduce(
+          phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
+      impl::mdspan_t<const geometry_type, 4> phi(phi_b.data(), phi_shape);
+      auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          phi, std::pair(1, tdim + 1), 0,
+          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+      // Reference coordinates and geometry data for each point in the
+      // block
+      std::vector<geometry_type> Xb(np * tdim, 0);
+      impl::mdspan_t<geometry_type, 2> X(Xb.data(), np, tdim);
+      std::vector<geometry_type> J_b(np * gdim * tdim);
+      impl::mdspan_t<geometry_type, 3> J(J_b.data(), np, gdim, tdim);
+      std::vector<geometry_type> K_b(np * tdim * gdim);
+      impl::mdspan_t<geometry_type, 3> K(K_b.data(), np, tdim, gdim);
+      std::vector<geometry_type> detJ(np);
+      std::vector<geometry_type> det_scratch(2 * gdim * tdim);
+
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        const std::int32_t cell_index = _cells[p];
+        if (cell_index < 0)
+          continue;
+
+        // Get cell geometry (coordinate dofs)
+        auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            x_dofmap, cell_index, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        for (std::size_t i = 0; i < num_dofs_g; ++i)
+          for (std::size_t j = 0; j < gdim; ++j)
+            coord_dofs(i, j) = x_g(x_dofs[i], j);
+
+        for (std::size_t j = 0; j < gdim; ++j)
+          xp(0, j) = x[p * xshape[1] + j];
+
+        const std::size_t q = p - p0;
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, q, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, q, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+
+        std::array<geometry_type, 3> Xpb = {0, 0, 0};
+        MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+            geometry_type,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+                std::size_t, 1, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>
+            Xp(Xpb.data(), 1, tdim);
+
+        // Compute reference coordinates X, and J, detJ and K
+        if (cmap.is_affine())
+        {
+          CoordinateElement<geometry_type>::compute_jacobian(dphi0, coord_dofs,
+                                                             _J);
+          CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
+          std::array<geometry_type, 3> x0 = {0, 0, 0};
+          for (std::size_t i = 0; i < coord_dofs.extent(1); ++i)
+            x0[i] += coord_dofs(0, i);
+          CoordinateElement<geometry_type>::pull_back_affine(Xp, _K, x0, xp);
+        }
+        else
+        {
+          cmap.pull_back_nonaffine(Xp, xp, coord_dofs);
+          cmap.tabulate(1, std::span(Xpb.data(), tdim), {1, tdim}, phi_b);
+          CoordinateElement<geometry_type>::compute_jacobian(dphi, coord_dofs,
+                                                             _J);
+          CoordinateElement<geometry_type>::compute_jacobian_inverse(_J, _K);
+        }
+        detJ[q]
+            = CoordinateElement<geometry_type>::compute_jacobian_determinant(
+                _J, det_scratch);
+
+        for (std::size_t j = 0; j < tdim; ++j)
+          X(q, j) = Xpb[j];
+      }
+
+      // Tabulate basis on reference element
+      std::vector<geometry_type> ref_values_b(np * num_basis_values);
+      impl::mdspan_t<const geometry_type, 4> ref_values(
+          ref_values_b.data(), 1, np, _space_dimension, _reference_value_size);
+      element->tabulate(ref_values_b, Xb, {np, tdim}, 0);
+
+      // Permute the reference basis function values to account for
+      // the cell's orientation, and push forward to the physical cell
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        const std::int32_t cell_index = _cells[p];
+        if (cell_index < 0)
+          continue;
+
+        const std::size_t q = p - p0;
+        apply_dof_transformation(
+            std::span(ref_values_b.data() + q * num_basis_values,
+                      num_basis_values),
+            cell_info, cell_index, _reference_value_size);
+
+        auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            ref_values, 0, q, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, q, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, q, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        xu_t basis_values(_basis.data() + p * num_basis_values,
+                          _space_dimension, _reference_value_size);
+        push_forward_fn(basis_values, _U, _J, detJ[q], _K);
+      }
+    };
+
+    impl::for_each_block(xshape[0], num_threads, compute_basis);
+  }
+
+  /// @brief Number of points.
+  std::size_t num_points() const { return _cells.size(); }
+
+  /// @brief Number of values at each point, i.e. the second dimension
+  /// of the array of values computed by eval().
+  std::size_t value_size() const { return _value_size; }
+
+  /// @brief Cell that contains each point. A negative index indicates
+  /// that the point is not in a cell on this process.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// @brief Apply a function to the weights of the values at a point.
+  ///
+  /// The value `i` of a function at point `p` is the sum of `w *
+  /// coefficients[j]` over the calls `fn(i, j, w)`, where
+  /// `coefficients` are the expansion coefficients of the function on
+  /// the cell that contains the point, ordered as in
+  /// DofMap::cell_dofs with the block size of the dofmap unrolled.
+  ///
+  /// @param[in] p Point index. The point must be in a cell on this
+  /// process.
+  /// @param[in] fn Function called as `fn(i, j, w)` for each weight.
+  template <typename F>
+  void for_each_weight(std::size_t p, F&& fn) const
+  {
+    assert(_cells[p] >= 0);
+    impl::mdspan_t<const geometry_type, 2> basis_values(
+        _basis.data() + p * _space_dimension * _reference_value_size,
+        _space_dimension, _reference_value_size);
+    if (_symmetric)
+    {
+      // Size of tensor for symmetric elements
+      int matrix_size = 0;
+      while (std::size_t(matrix_size * matrix_size) < _value_size)
+        ++matrix_size;
+
+      int row = 0;
+      int rowstart = 0;
+      for (int k = 0; k < _bs_element; ++k)
+      {
+        if (k - rowstart > row)
+        {
+          row++;
+          rowstart = k;
+        }
+        for (std::size_t i = 0; i < _space_dimension; ++i)
+        {
+          for (std::size_t j = 0; j < _reference_value_size; ++j)
+          {
+            const std::size_t c = _bs_element * i + k;
+            fn(j * _bs_element + row * matrix_size + k - rowstart, c,
+               basis_values(i, j));
+            if (k - rowstart != row)
+            {
+              fn(j * _bs_element + row + matrix_size * (k - rowstart), c,
+                 basis_values(i, j));
+            }
+          }
+        }
+      }
+    }
+    else
+    {
+      for (int k = 0; k < _bs_element; ++k)
+      {
+        for (std::size_t i = 0; i < _space_dimension; ++i)
+        {
+          for (std::size_t j = 0; j < _reference_value_size; ++j)
+            fn(j * _bs_element + k, _bs_element * i + k, basis_values(i, j));
+        }
+      }
+    }
+  }
+
+  /// @brief Evaluate a function at the points.
+  ///
+  /// @param[in] v Expansion coefficients (including ghost entries) of
+  /// a function in the space that the evaluator was created for.
+  /// @param[out] u Values at the points. It has shape `(num_points(),
+  /// value_size())` and storage is row-major. Values for points with a
+  /// negative cell index are zero.
+  /// @param[in] num_threads Number of threads. The points are divided
+  /// between the threads.
+  void eval(std::span<const value_type> v, std::span<value_type> u,
+            int num_threads = 1) const
+  {
+    if (u.size() != _cells.size() * _value_size)
+    {
+      throw std::runtime_error(
+          "Size of array for Function values does not match the number of "
+          "points.");
+    }
+
+    std::shared_ptr<const DofMap> dofmap = _function_space->dofmap();
+    assert(dofmap);
+    const int bs_dof = dofmap->bs();
+    auto eval_block = [&](std::size_t p0, std::size_t p1)
+    {
+      std::vector<value_type> coefficients(_space_dimension * _bs_element);
+      std::ranges::fill(u.subspan(p0 * _value_size, (p1 - p0) * _value_size),
+                        0.0);
+      for (std::size_t p = p0; p < p1; ++p)
+      {
+        const std::int32_t cell_index = _cells[p];
+        if (cell_index < 0)
+          continue;
+
+        std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell_index);
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < bs_dof; ++k)
+            coefficients[bs_dof * i + k] = v[bs_dof * dofs[i] + k];
+
+        std::span<value_type> up = u.subspan(p * _value_size, _value_size);
+        for_each_weight(p, [&up, &coefficients](std::size_t i, std::size_t j,
+                                                geometry_type w)
+                        { up[i] += coefficients[j] * w; });
+      }
+    };
+
+    impl::for_each_block(_cells.size(), num_threads, eval_block);
+  }
+
+  /// @brief Evaluate a function at the points.
+  ///
+  /// @param[in] f Function to evaluate. It must be in the space that
+  /// the evaluator was created for.
+  /// @param[out] u Values at the points. See eval(std::span<const
+  /// value_type>, std::span<value_type>, int) const.
+  /// @param[in] num_threads Number of threads.
+  void eval(const Function<value_type, geometry_type>& f,
+            std::span<value_type> u, int num_threads = 1) const
+  {
+    if (f.function_space() != _function_space)
+    {
+      throw std::runtime_error(
+          "Function is not in the space of the PointEvaluator.");
+    }
+    eval(f.x()->array(), u, num_threads);
+  }
+
+private:
+  // Function space
+  std::shared_ptr<const FunctionSpace<geometry_type>> _function_space;
+
+  // Cell containing each point
+  std::vector<std::int32_t> _cells;
+
+  // Basis function values at each point, pushed forward to the
+  // physical cell, with shape (num_points, space_dimension,
+  // reference_value_size)
+  std::vector<geometry_type> _basis;
+
+  // Element data
+  int _bs_element = 1;
+  std::size_t _space_dimension = 0, _reference_value_size = 0,
+              _value_size = 0;
+  bool _symmetric = false;
+};
+
+/// @brief Create a PointEvaluator, locating the cells that contain the
+/// points.
+///
+/// The first local cell (owned or ghost) that collides with each point
+/// is used. Points that are not in a cell on this process are given a
+/// negative cell index and are ignored.
+///
+/// @param[in] V Function space of the functions to evaluate.
+/// @param[in] x Coordinates of the points. It has shape
+/// `(num_points, 3)` and storage is row-major.
+/// @param[in] num_threads Number of threads used to compute the
+/// reference coordinates and basis values.
+/// @return Point evaluator.
+template <dolfinx::scalar T, std::floating_point U>
+PointEvaluator<T, U>
+create_point_evaluator(std::shared_ptr<const FunctionSpace<U>> V,
+                       std::span<const U> x, int num_threads = 1)
+{
+  assert(V);
+  auto mesh = V->mesh();
+  assert(mesh);
+  const int tdim = mesh->topology()->dim();
+  geometry::BoundingBoxTree<U> tree(*mesh, tdim);
+  graph::AdjacencyList<std::int32_t> candidates
+      = geometry::compute_collisions(tree, x);
+  graph::AdjacencyList<std::int32_t> colliding
+      = geometry::compute_colliding_cells(*mesh, candidates, x);
+
+  std::vector<std::int32_t> cells(colliding.num_nodes(), -1);
+  for (std::int32_t p = 0; p < colliding.num_nodes(); ++p)
+  {
+    if (auto c = colliding.links(p); !c.empty())
+      cells[p] = c.front();
+  }
+
+  return PointEvaluator<T, U>(V, x, {cells.size(), 3}, cells, num_threads);
+}
+
+} // namespace dolfinx::fem
@@ -0,0 +1,276 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "Expression.h"
+#include "Function.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/types.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Storage for an Expression evaluated at its points on a set of
+/// cells, with cached cell geometry.
+///
+/// The cell geometry data (cell node coordinates, and at each point the
+/// physical coordinates, Jacobian, its inverse and its determinant) is
+/// computed when the object is created and is re-used by each call to
+/// QuadratureData::eval. This avoids re-computing the geometry when an
+/// Expression is evaluated repeatedly on a fixed mesh, e.g. stresses at
+/// quadrature points in each iteration of a plasticity solver. The
+/// cached geometry is also available to user code, e.g. for
+/// constitutive models and history variables stored per point.
+///
+/// If the mesh geometry changes, QuadratureData::update_geometry must be
+/// called. The Jacobian data cached on the mesh geometry at the
+/// Expression points is used if it has been created (see
+/// mesh::Geometry::create_jacobians).
+///
+/// @tparam T Scalar type of the Expression.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class QuadratureData
+{
+  template <typename X, std::size_t d>
+  using mdspan_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      X, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, d>>;
+
+public:
+  /// @brief Create storage for an Expression on a set of cells.
+  /// @param[in] e The Expression. It must not have an Argument, and its
+  /// points must be on the reference cell of `mesh`.
+  /// @param[in] mesh The mesh.
+  /// @param[in] cells Cells on which the Expression is evaluated.
+  QuadratureData(std::shared_ptr<const Expression<T, U>> e,
+                 std::shared_ptr<const mesh::Mesh<U>> mesh,
+                 std::vector<std::int32_t> cells)
+      : _expression(e), _mesh(mesh), _cells(std::move(cells))
+  {
+    assert(_expression);
+    assert(_mesh);
+    if (_expression->argument_function_space())
+    {
+      throw std::runtime_error(
+          "QuadratureData does not support Expressions with an Argument.");
+    }
+
+    if (_expression->X().second[1]
+        != static_cast<std::size_t>(_mesh->topology()->dim()))
+    {
+      throw std::runtime_error("Invalid dimension of evaluation points.");
+    }
+
+    _values.resize(_cells.size() * num_points() * _expression->value_size());
+    _coeffs.resize(_cells.size() * _expression->coefficient_offsets().back());
+    update_geometry();
+  }
+
+  /// @brief Re-compute the cached cell geometry data.
+  ///
+  /// This must be called if the mesh geometry has changed.
+  void update_geometry()
+  {
+    const mesh::Geometry<U>& geometry = _mesh->geometry();
+    const CoordinateElement<U>& cmap = geometry.cmap();
+    auto x_dofmap = geometry.dofmap();
+    mesh::NodeCoordinates<U> x_g = geometry.coordinates();
+    const std::size_t gdim = geometry.dim();
+    const std::size_t tdim = _mesh->topology()->dim();
+    const std::size_t num_dofs_g = cmap.dim();
+    const std::size_t np = num_points();
+
+    // Tabulate the coordinate element basis and its first derivatives
+    // at the points
+    auto [X, Xshape] = _expression->X();
+    const std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, np);
+    std::vector<U> phi_b(std::reduce(phi_shape.begin(), phi_shape.end(), 1,
+                                     std::multiplies{}));
+    mdspan_t<const U, 4> phi(phi_b.data(), phi_shape);
+    cmap.tabulate(1, X, Xshape, phi_b);
+    auto phi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        phi, 0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+    const std::size_t num_cells = _cells.size();
+    _coordinate_dofs.resize(num_cells * 3 * num_dofs_g);
+    _x.resize(num_cells * np * gdim);
+    _J.assign(num_cells * np * gdim * tdim, 0);
+    _K.resize(num_cells * np * tdim * gdim);
+    _detJ.resize(num_cells * np);
+    mdspan_t<U, 4> J(_J.data(), num_cells, np, gdim, tdim);
+    mdspan_t<U, 4> K(_K.data(), num_cells, np, tdim, gdim);
+
+    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+    mdspan_t<U, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+    std::vector<U> det_scratch(2 * gdim * tdim);
+    std::shared_ptr<const mesh::GeometryJacobians<U>> jacobians
+        = geometry.jacobians(X);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      // Copy the cell node coordinates, in the layout expected by the
+      // Expression kernel and as a (num_dofs_g, gdim) array
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, _cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      x_g.copy(x_dofs, _coordinate_dofs.data() + 3 * c * num_dofs_g);
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = x_g(x_dofs[i], j);
+
+      // Physical coordinates of the points
+      mdspan_t<U, 2> x(_x.data() + c * np * gdim, np, gdim);
+      cmap.push_forward(x, coord_dofs, phi0);
+
+      // Jacobian, its inverse and its determinant at the points
+      if (jacobians)
+      {
+        // Copy the Jacobian data cached on the geometry
+        for (std::size_t p = 0; p < np; ++p)
+        {
+          const std::size_t i = jacobians->index(_cells[c], p);
+          std::copy_n(jacobians->J.data() + i * gdim * tdim, gdim * tdim,
+                      _J.data() + (c * np + p) * gdim * tdim);
+          std::copy_n(jacobians->K.data() + i * tdim * gdim, tdim * gdim,
+                      _K.data() + (c * np + p) * tdim * gdim);
+          _detJ[c * np + p] = jacobians->detJ[i];
+        }
+        continue;
+      }
+
+      for (std::size_t p = 0; p < np; ++p)
+      {
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(std::size_t(1), tdim + 1), p,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+        auto Jp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, c, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian(dphi, coord_dofs, Jp);
+        auto Kp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, c, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian_inverse(Jp, Kp);
+        _detJ[c * np + p] = cmap.compute_jacobian_determinant(Jp, det_scratch);
+      }
+    }
+  }
+
+  /// @brief Evaluate the Expression at the points on all cells.
+  ///
+  /// The coefficients and constants of the Expression are packed, and
+  /// the cached cell geometry is used. The result is available from
+  /// QuadratureData::values.
+  void eval()
+  {
+    const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
+        = _expression->coefficients();
+    const std::vector<int> offsets = _expression->coefficient_offsets();
+    const int cstride = offsets.back();
+    for (std::size_t i = 0; i < coefficients.size(); ++i)
+    {
+      impl::pack_coefficient_entity(
+          std::span(_coeffs), cstride, *coefficients[i],
+          impl::get_cell_orientation_info(*coefficients[i]), _cells, 1,
+          [](auto entity) { return entity.front(); }, offsets[i]);
+    }
+    const std::vector<T> constants = pack_constants(*_expression);
+
+    const auto& fn = _expression->get_tabulate_expression();
+    const std::size_t num_dofs_g = _mesh->geometry().cmap().dim();
+    const std::size_t vstride = num_points() * _expression->value_size();
+    std::ranges::fill(_values, 0);
+    for (std::size_t c = 0; c < _cells.size(); ++c)
+    {
+      fn(_values.data() + c * vstride, _coeffs.data() + c * cstride,
+         constants.data(), _coordinate_dofs.data() + c * 3 * num_dofs_g,
+         nullptr, nullptr);
+    }
+  }
+
+  /// @brief Values of the Expression from the last call to
+  /// QuadratureData::eval.
+  /// @return Values, `shape=(num_cells, num_points, value_size)`.
+  std::span<const T> values() const { return _values; }
+
+  /// @brief Shape of the array returned by QuadratureData::values.
+  std::array<std::size_t, 3> values_shape() const
+  {
+    return {_cells.size(), num_points(),
+            static_cast<std::size_t>(_expression->value_size())};
+  }
+
+  /// @brief Cells on which the Expression is evaluated.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// @brief Number of evaluation points on each cell.
+  std::size_t num_points() const { return _expression->X().second[0]; }
+
+  /// @brief Physical coordinates of the points.
+  /// @return Coordinates, `shape=(num_cells, num_points, gdim)`.
+  std::span<const U> x() const { return _x; }
+
+  /// @brief Jacobian of the coordinate map at the points.
+  /// @return Jacobians, `shape=(num_cells, num_points, gdim, tdim)`.
+  std::span<const U> J() const { return _J; }
+
+  /// @brief Inverse (pseudo-inverse if `gdim > tdim`) of the Jacobian
+  /// of the coordinate map at the points.
+  /// @return Inverse Jacobians, `shape=(num_cells, num_points, tdim,
+  /// gdim)`.
+  std::span<const U> K() const { return _K; }
+
+  /// @brief Determinant (pseudo-determinant if `gdim > tdim`) of the
+  /// Jacobian at the points.
+  /// @return Determinants, `shape=(num_cells, num_points)`.
+  std::span<const U> detJ() const { return _detJ; }
+
+  /// @brief The Expression.
+  std::shared_ptr<const Expression<T, U>> expression() const
+  {
+    return _expression;
+  }
+
+  /// @brief The mesh.
+  std::shared_ptr<const mesh::Mesh<U>> mesh() const { return _mesh; }
+
+private:
+  // The Expression
+  std::shared_ptr<const Expression<T, U>> _expression;
+
+  // The mesh
+  std::shared_ptr<const mesh::Mesh<U>> _mesh;
+
+  // Cells to evaluate on
+  std::vector<std::int32_t> _cells;
+
+  // Cell node coordinates, shape=(num_cells, num_dofs_g, 3)
+  std::vector<U> _coordinate_dofs;
+
+  // Geometry at points
+  std::vector<U> _x, _J, _K, _detJ;
+
+  // Packed coefficients, shape=(num_cells, cstride)
+  std::vector<T> _coeffs;
+
+  // Evaluated values, shape=(num_cells, num_points, value_size)
+  std::vector<T> _values;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,87 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <mpi.h>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Sum of the local contributions to functionals across
+/// processes with one non-blocking reduction.
+///
+/// The values of all functionals are summed with a single
+/// `MPI_Iallreduce`, which is started when the reduction is created.
+/// Computation can be overlapped with the communication, and the sums
+/// are available after ScalarReduction::wait, e.g.
+///
+///     ScalarReduction sum(mesh->comm(), fem::assemble_scalars(M));
+///     // ... other work ...
+///     std::span<const T> values = sum.wait();
+///
+/// @tparam T Scalar type.
+template <dolfinx::scalar T>
+class ScalarReduction
+{
+public:
+  /// @brief Start the reduction.
+  /// @param[in] comm Communicator to sum the values over. It must remain
+  /// valid until the reduction is complete.
+  /// @param[in] values Local contribution to each functional. The
+  /// number of values must be the same on all processes.
+  /// @note Collective MPI operation
+  ScalarReduction(MPI_Comm comm, std::vector<T> values)
+      : _values(std::move(values))
+  {
+    MPI_Iallreduce(MPI_IN_PLACE, _values.data(), _values.size(),
+                   dolfinx::MPI::mpi_t<T>, MPI_SUM, comm, &_request);
+  }
+
+  // The buffer of a pending reduction can not be moved
+  ScalarReduction(const ScalarReduction&) = delete;
+  ScalarReduction(ScalarReduction&&) = delete;
+  ScalarReduction& operator=(const ScalarReduction&) = delete;
+  ScalarReduction& operator=(ScalarReduction&&) = delete;
+
+  /// Destructor. Completes the reduction if it is pending.
+  ~ScalarReduction()
+  {
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_request, MPI_STATUS_IGNORE);
+  }
+
+  /// @brief Check if the reduction is complete, without blocking.
+  /// @return True if the sums are available.
+  bool test()
+  {
+    int flag = 1;
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Test(&_request, &flag, MPI_STATUS_IGNORE);
+    return flag;
+  }
+
+  /// @brief Complete the reduction.
+  /// @return Sum over all processes of each functional.
+  std::span<const T> wait()
+  {
+    if (_request != MPI_REQUEST_NULL)
+      MPI_Wait(&_request, MPI_STATUS_IGNORE);
+    return _values;
+  }
+
+private:
+  // Local values, and the sums when the reduction is complete
+  std::vector<T> _values;
+
+  // MPI request of the reduction
+  MPI_Request _request = MPI_REQUEST_NULL;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,661 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DirichletBC.h"
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assembler.h"
+#include "traits.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+namespace impl
+{
+/// @brief Compute the LU factorisation with partial pivoting of a
+/// dense matrix in place.
+///
+/// On return `A` holds `L` (unit diagonal, not stored) and `U` such
+/// that `P A = L U`, where row `i` of `P A` is row `perm[i]` of `A`.
+///
+/// @param[in,out] A Row-major matrix, `shape=(n, n)`.
+/// @param[out] perm Row permutation, `size=n`.
+template <dolfinx::scalar T>
+void lu_factor(std::span<T> A, std::span<std::int32_t> perm)
+{
+  const std::size_t n = perm.size();
+  assert(A.size() == n * n);
+  std::iota(perm.begin(), perm.end(), 0);
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    std::size_t p = k;
+    for (std::size_t i = k + 1; i < n; ++i)
+    {
+      if (std::abs(A[i * n + k]) > std::abs(A[p * n + k]))
+        p = i;
+    }
+
+    if (A[p * n + k] == T(0))
+      throw std::runtime_error("Singular matrix in LU factorisation.");
+
+    if (p != k)
+    {
+      std::swap_ranges(std::next(A.begin(), k * n),
+                       std::next(A.begin(), (k + 1) * n),
+                       std::next(A.begin(), p * n));
+      std::swap(perm[k], perm[p]);
+    }
+
+    for (std::size_t i = k + 1; i < n; ++i)
+    {
+      const T l = A[i * n + k] / A[k * n + k];
+      A[i * n + k] = l;
+      for (std::size_t j = k + 1; j < n; ++j)
+        A[i * n + j] -= l * A[k * n + j];
+    }
+  }
+}
+
+/// @brief Solve `A x = b` or `A^T x = b` in place using the LU
+/// factorisation computed by lu_factor.
+///
+/// @param[in] LU LU factors, `shape=(n, n)`.
+/// @param[in] perm Row permutation, `size=n`.
+/// @param[in,out] b Right-hand side on input, solution on output.
+/// @param[in] transpose If true, solve `A^T x = b`.
+/// @param[in] w Working memory, `size=n`.
+template <dolfinx::scalar T>
+void lu_solve(std::span<const T> LU, std::span<const std::int32_t> perm,
+              std::span<T> b, bool transpose, std::span<T> w)
+{
+  const std::size_t n = perm.size();
+  if (!transpose)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      w[i] = b[perm[i]];
+      for (std::size_t j = 0; j < i; ++j)
+        w[i] -= LU[i * n + j] * w[j];
+    }
+    for (std::size_t i = n; i-- > 0;)
+    {
+      for (std::size_t j = i + 1; j < n; ++j)
+        w[i] -= LU[i * n + j] * w[j];
+      w[i] /= LU[i * n + i];
+    }
+    std::copy_n(w.begin(), n, b.begin());
+  }
+  else
+  {
+    // A^T = U^T L^T P
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      w[i] = b[i];
+      for (std::size_t j = 0; j < i; ++j)
+        w[i] -= LU[j * n + i] * w[j];
+      w[i] /= LU[i * n + i];
+    }
+    for (std::size_t i = n; i-- > 0;)
+    {
+      for (std::size_t j = i + 1; j < n; ++j)
+        w[i] -= LU[j * n + i] * w[j];
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      b[perm[i]] = w[i];
+  }
+}
+} // namespace impl
+
+/// @brief Static condensation of cell-local degrees-of-freedom of a 2x2
+/// block system.
+///
+/// For the block system
+///
+///     [A00 A01] [u0]   [b0]
+///     [A10 A11] [u1] = [b1]
+///
+/// where the degrees-of-freedom of `u0` are local to a cell (e.g. a
+/// discontinuous space), `A00` is block diagonal with one dense block
+/// per cell. The `u0` degrees-of-freedom are eliminated cell by cell,
+/// and only the Schur complement system
+///
+///     (A11 - A10 A00^{-1} A01) u1 = b1 - A10 A00^{-1} b0
+///
+/// is assembled. After the condensed system has been solved, `u0` is
+/// recovered cell by cell by StaticCondensation::back_substitute.
+///
+/// The element matrices of the four blocks on a cell are computed
+/// together, the element matrix of `A00` is factorised, and the Schur
+/// complement element matrix is computed before it is added to the
+/// global matrix. The LU factors of the `A00` element matrices and the
+/// element matrices `A00^{-1} A01` and `A10 A00^{-1}` are stored for
+/// the assembly of the right-hand side and for back-substitution.
+///
+/// The sparsity pattern of the condensed matrix is the sparsity
+/// pattern of `A11`, e.g. from fem::create_sparsity_pattern.
+///
+/// @note All forms must be defined on the same mesh as their function
+/// spaces and have cell integrals only.
+///
+/// @tparam T Scalar type.
+/// @tparam U Geometry type.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+class StaticCondensation
+{
+  // Form with the positions in its integration domains of each cell
+  struct FormData
+  {
+    std::shared_ptr<const Form<T, U>> form;
+    std::vector<int> ids;
+    std::vector<std::vector<std::int32_t>> pos;
+  };
+
+public:
+  /// @brief Create the static condensation of a block system and
+  /// compute the condensed element matrices.
+  /// @param[in] a Bilinear forms of the blocks, `a[i][j]` has test
+  /// space `V_i` and trial space `V_j`. The degrees-of-freedom of `V_0`
+  /// must each belong to one cell only. `a[0][1]` and `a[1][0]` can be
+  /// `nullptr`.
+  /// @param[in] L Linear forms of the blocks, `L[i]` has test space
+  /// `V_i`. Either can be `nullptr`.
+  StaticCondensation(
+      std::array<std::array<std::shared_ptr<const Form<T, U>>, 2>, 2> a,
+      std::array<std::shared_ptr<const Form<T, U>>, 2> L = {nullptr,
+                                                            nullptr})
+  {
+    if (!a[0][0] or !a[1][1])
+      throw std::runtime_error("Diagonal blocks are required.");
+
+    _V = {a[0][0]->function_spaces().at(0), a[1][1]->function_spaces().at(0)};
+    _mesh = a[0][0]->mesh();
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      for (std::size_t j = 0; j < 2; ++j)
+      {
+        if (a[i][j])
+        {
+          if (a[i][j]->function_spaces().at(0) != _V[i]
+              or a[i][j]->function_spaces().at(1) != _V[j])
+          {
+            throw std::runtime_error("Incompatible block function spaces.");
+          }
+          _a[i][j] = init(a[i][j]);
+        }
+      }
+
+      if (L[i])
+      {
+        if (L[i]->function_spaces().at(0) != _V[i])
+          throw std::runtime_error("Incompatible block function spaces.");
+        _L[i] = init(L[i]);
+      }
+    }
+
+    // Cells on which the element matrices are computed
+    std::vector<std::int8_t> marker(num_cells(), false);
+    for (auto& d : {_a[0][0], _a[0][1], _a[1][0], _a[1][1], _L[0], _L[1]})
+    {
+      if (d.form)
+      {
+        for (int i : d.form->integral_ids(IntegralType::cell))
+          for (std::int32_t c : d.form->domain(IntegralType::cell, i))
+            marker[c] = true;
+      }
+    }
+    for (std::size_t c = 0; c < marker.size(); ++c)
+    {
+      if (marker[c])
+        _cells.push_back(c);
+    }
+
+    // Check that the V_0 degrees-of-freedom are local to a cell
+    std::shared_ptr<const DofMap> dofmap0 = _V[0]->dofmap();
+    std::vector<std::int8_t> dof_count(
+        dofmap0->index_map->size_local() + dofmap0->index_map->num_ghosts(),
+        0);
+    for (std::int32_t c : _cells)
+    {
+      for (std::int32_t dof : dofmap0->cell_dofs(c))
+      {
+        if (dof_count[dof]++ > 0)
+        {
+          throw std::runtime_error(
+              "Condensed degrees-of-freedom must be local to a cell.");
+        }
+      }
+    }
+
+    update();
+  }
+
+  /// @brief Re-compute the condensed element matrices.
+  ///
+  /// This must be called if the coefficients or constants of the
+  /// bilinear forms have changed.
+  void update()
+  {
+    const std::size_t n0 = ndim(0);
+    const std::size_t n1 = ndim(1);
+    const std::size_t num = _cells.size();
+    _LU.resize(num * n0 * n0);
+    _perm.resize(num * n0);
+    _X.resize(num * n0 * n1);
+    _Y.resize(num * n1 * n0);
+    _S.resize(num * n1 * n1);
+
+    std::array<std::array<std::vector<T>, 2>, 2> constants;
+    std::array<std::array<std::map<std::pair<IntegralType, int>,
+                                   std::pair<std::vector<T>, int>>,
+                          2>,
+               2>
+        coeffs;
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      for (std::size_t j = 0; j < 2; ++j)
+      {
+        if (_a[i][j].form)
+        {
+          constants[i][j] = pack_constants(*_a[i][j].form);
+          coeffs[i][j] = allocate_coefficient_storage(*_a[i][j].form);
+          pack_coefficients(*_a[i][j].form, coeffs[i][j]);
+        }
+      }
+    }
+
+    std::vector<T> A01(n0 * n1), A10(n1 * n0), w(n0);
+    std::vector<U> coordinate_dofs;
+    for (std::size_t k = 0; k < num; ++k)
+    {
+      std::int32_t c = _cells[k];
+      copy_coordinate_dofs(c, coordinate_dofs);
+      std::span<T> LU(_LU.data() + k * n0 * n0, n0 * n0);
+      std::span<T> S(_S.data() + k * n1 * n1, n1 * n1);
+      tabulate(_a[0][0], constants[0][0], coeffs[0][0], c, coordinate_dofs,
+               LU);
+      tabulate(_a[0][1], constants[0][1], coeffs[0][1], c, coordinate_dofs,
+               A01);
+      tabulate(_a[1][0], constants[1][0], coeffs[1][0], c, coordinate_dofs,
+               A10);
+      tabulate(_a[1][1], constants[1][1], coeffs[1][1], c, coordinate_dofs,
+               S);
+
+      std::span<std::int32_t> perm(_perm.data() + k * n0, n0);
+      impl::lu_factor<T>(LU, perm);
+
+      // X = A00^{-1} A01, computed column by column
+      std::span<T> X(_X.data() + k * n0 * n1, n0 * n1);
+      std::vector<T> col(n0);
+      for (std::size_t j = 0; j < n1; ++j)
+      {
+        for (std::size_t i = 0; i < n0; ++i)
+          col[i] = A01[i * n1 + j];
+        impl::lu_solve<T>(LU, perm, col, false, w);
+        for (std::size_t i = 0; i < n0; ++i)
+          X[i * n1 + j] = col[i];
+      }
+
+      // Y = A10 A00^{-1}, computed row by row from A00^T Y^T = A10^T
+      std::span<T> Y(_Y.data() + k * n1 * n0, n1 * n0);
+      std::copy(A10.begin(), A10.end(), Y.begin());
+      for (std::size_t i = 0; i < n1; ++i)
+        impl::lu_solve<T>(LU, perm, Y.subspan(i * n0, n0), true, w);
+
+      // S = A11 - A10 X
+      for (std::size_t i = 0; i < n1; ++i)
+        for (std::size_t l = 0; l < n0; ++l)
+          for (std::size_t j = 0; j < n1; ++j)
+            S[i * n1 + j] -= A10[i * n0 + l] * X[l * n1 + j];
+    }
+  }
+
+  /// @brief Assemble the condensed matrix `A11 - A10 A00^{-1} A01`.
+  ///
+  /// The matrix must already be initialised. It is not zeroed or
+  /// finalised.
+  ///
+  /// @param[in] mat_add The function for adding values into the matrix.
+  /// @param[in] bcs Boundary conditions on `V_1`. For boundary
+  /// condition dofs the row and column are zeroed. The diagonal entry
+  /// is not set.
+  void assemble_matrix(
+      la::MatSet<T> auto mat_add,
+      const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs
+      = {}) const
+  {
+    const std::vector<std::int8_t> bc1 = bc_markers(bcs);
+    std::shared_ptr<const DofMap> dofmap1 = _V[1]->dofmap();
+    const int bs1 = dofmap1->bs();
+    const std::size_t n1 = ndim(1);
+    std::vector<T> Se(n1 * n1);
+    for (std::size_t k = 0; k < _cells.size(); ++k)
+    {
+      std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(_cells[k]);
+      std::copy_n(std::next(_S.begin(), k * n1 * n1), n1 * n1, Se.begin());
+      if (!bc1.empty())
+      {
+        for (std::size_t i = 0; i < n1; ++i)
+        {
+          if (bc1[bs1 * dofs1[i / bs1] + i % bs1])
+          {
+            std::fill_n(std::next(Se.begin(), i * n1), n1, 0);
+            for (std::size_t j = 0; j < n1; ++j)
+              Se[j * n1 + i] = 0;
+          }
+        }
+      }
+
+      mat_add(dofs1, dofs1, Se);
+    }
+  }
+
+  /// @brief Assemble the condensed right-hand side
+  /// `b1 - A10 A00^{-1} b0`.
+  ///
+  /// Boundary conditions on `V_1` are applied by lifting with the
+  /// condensed matrix, i.e. `b <- b - S g` where `g` holds the boundary
+  /// condition values. The entries of `b` for boundary condition dofs
+  /// are not set, see DirichletBC::set. The element vectors of `b0` are
+  /// stored for StaticCondensation::back_substitute.
+  ///
+  /// @note Caller is responsible for the reverse scatter of `b`.
+  /// @param[in,out] b Vector to assemble into, with the layout of `V_1`.
+  /// It is not zeroed.
+  /// @param[in] bcs Boundary conditions on `V_1`.
+  void assemble_vector(
+      std::span<T> b,
+      const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs
+      = {})
+  {
+    const std::size_t n0 = ndim(0);
+    const std::size_t n1 = ndim(1);
+    _z0.assign(_cells.size() * n0, 0);
+
+    std::array<std::vector<T>, 2> constants;
+    std::array<std::map<std::pair<IntegralType, int>,
+                        std::pair<std::vector<T>, int>>,
+               2>
+        coeffs;
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      if (_L[i].form)
+      {
+        constants[i] = pack_constants(*_L[i].form);
+        coeffs[i] = allocate_coefficient_storage(*_L[i].form);
+        pack_coefficients(*_L[i].form, coeffs[i]);
+      }
+    }
+
+    // Boundary condition markers and values
+    const std::vector<std::int8_t> bc1 = bc_markers(bcs);
+    std::vector<T> g;
+    if (!bc1.empty())
+    {
+      g.assign(bc1.size(), 0);
+      for (const DirichletBC<T, U>& bc : bcs)
+      {
+        if (_V[1]->contains(*bc.function_space()))
+          bc.set(g, std::nullopt);
+      }
+    }
+
+    std::shared_ptr<const DofMap> dofmap1 = _V[1]->dofmap();
+    const int bs1 = dofmap1->bs();
+    std::vector<T> be1(n1), w(n0);
+    std::vector<U> coordinate_dofs;
+    for (std::size_t k = 0; k < _cells.size(); ++k)
+    {
+      std::int32_t c = _cells[k];
+      copy_coordinate_dofs(c, coordinate_dofs);
+      std::span<T> z0(_z0.data() + k * n0, n0);
+      tabulate(_L[0], constants[0], coeffs[0], c, coordinate_dofs, z0);
+      tabulate(_L[1], constants[1], coeffs[1], c, coordinate_dofs, be1);
+
+      // be1 <- be1 - Y b0, and z0 = A00^{-1} b0
+      std::span<const T> Y(_Y.data() + k * n1 * n0, n1 * n0);
+      for (std::size_t i = 0; i < n1; ++i)
+        for (std::size_t j = 0; j < n0; ++j)
+          be1[i] -= Y[i * n0 + j] * z0[j];
+      impl::lu_solve<T>(std::span<const T>(_LU.data() + k * n0 * n0, n0 * n0),
+                        std::span<const std::int32_t>(_perm.data() + k * n0,
+                                                      n0),
+                        z0, false, w);
+
+      std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(c);
+      if (!bc1.empty())
+      {
+        // Lifting: be1 <- be1 - S g
+        std::span<const T> S(_S.data() + k * n1 * n1, n1 * n1);
+        for (std::size_t j = 0; j < n1; ++j)
+        {
+          const std::int32_t dof = bs1 * dofs1[j / bs1] + j % bs1;
+          if (bc1[dof])
+          {
+            for (std::size_t i = 0; i < n1; ++i)
+              be1[i] -= S[i * n1 + j] * g[dof];
+          }
+        }
+      }
+
+      for (std::size_t i = 0; i < n1; ++i)
+        b[bs1 * dofs1[i / bs1] + i % bs1] += be1[i];
+    }
+  }
+
+  /// @brief Recover the condensed degrees-of-freedom,
+  /// `u0 = A00^{-1} (b0 - A01 u1)`.
+  ///
+  /// `b0` is the right-hand side from the last call to
+  /// StaticCondensation::assemble_vector. If it has not been called,
+  /// `b0` is zero.
+  ///
+  /// @param[in] u1 Solution of the condensed system, with the layout of
+  /// `V_1`. The entries for all degrees-of-freedom of the cells,
+  /// including ghosts, must be up to date.
+  /// @param[out] u0 Condensed degrees-of-freedom, with the layout of
+  /// `V_0`. The entries of all cells (owned and ghost) are set.
+  void back_substitute(std::span<const T> u1, std::span<T> u0) const
+  {
+    const std::size_t n0 = ndim(0);
+    const std::size_t n1 = ndim(1);
+    std::shared_ptr<const DofMap> dofmap0 = _V[0]->dofmap();
+    std::shared_ptr<const DofMap> dofmap1 = _V[1]->dofmap();
+    const int bs0 = dofmap0->bs();
+    const int bs1 = dofmap1->bs();
+    for (std::size_t k = 0; k < _cells.size(); ++k)
+    {
+      std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(_cells[k]);
+      std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(_cells[k]);
+      std::span<const T> X(_X.data() + k * n0 * n1, n0 * n1);
+      for (std::size_t i = 0; i < n0; ++i)
+      {
+        T u = _z0.empty() ? T(0) : _z0[k * n0 + i];
+        for (std::size_t j = 0; j < n1; ++j)
+          u -= X[i * n1 + j] * u1[bs1 * dofs1[j / bs1] + j % bs1];
+        u0[bs0 * dofs0[i / bs0] + i % bs0] = u;
+      }
+    }
+  }
+
+  /// @brief Cells (local indices) on which the system is condensed.
+  std::span<const std::int32_t> cells() const { return _cells; }
+
+  /// @brief The function spaces `V_0` (condensed) and `V_1`.
+  std::array<std::shared_ptr<const FunctionSpace<U>>, 2>
+  function_spaces() const
+  {
+    return _V;
+  }
+
+private:
+  // Positions in the integration domains of a form of each cell
+  FormData init(std::shared_ptr<const Form<T, U>> form) const
+  {
+    if (form->mesh() != _mesh)
+      throw std::runtime_error("Forms must have the same mesh.");
+    for (auto& V : form->function_spaces())
+    {
+      if (V->mesh() != _mesh)
+        throw std::runtime_error("Function spaces must be on the form mesh.");
+    }
+    for (auto type : {IntegralType::exterior_facet,
+                      IntegralType::interior_facet, IntegralType::vertex})
+    {
+      if (form->num_integrals(type) > 0)
+      {
+        throw std::runtime_error(
+            "Static condensation supports cell integrals only.");
+      }
+    }
+
+    FormData d{form, form->integral_ids(IntegralType::cell), {}};
+    for (int i : d.ids)
+    {
+      std::vector<std::int32_t>& pos = d.pos.emplace_back(num_cells(), -1);
+      std::span<const std::int32_t> cells = form->domain(IntegralType::cell, i);
+      for (std::size_t k = 0; k < cells.size(); ++k)
+        pos[cells[k]] = k;
+    }
+    return d;
+  }
+
+  // Number of local (owned and ghost) cells
+  std::int32_t num_cells() const
+  {
+    auto map = _mesh->topology()->index_map(_mesh->topology()->dim());
+    assert(map);
+    return map->size_local() + map->num_ghosts();
+  }
+
+  // Size of the element tensor dimension of V_i
+  std::size_t ndim(int i) const
+  {
+    std::shared_ptr<const DofMap> dofmap = _V[i]->dofmap();
+    return dofmap->bs() * dofmap->map().extent(1);
+  }
+
+  // Boundary condition markers for V_1. Empty if no condition applies.
+  std::vector<std::int8_t> bc_markers(
+      const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+      const
+  {
+    std::shared_ptr<const DofMap> dofmap1 = _V[1]->dofmap();
+    std::vector<std::int8_t> markers;
+    for (const DirichletBC<T, U>& bc : bcs)
+    {
+      if (_V[1]->contains(*bc.function_space()))
+      {
+        markers.resize(dofmap1->index_map_bs()
+                           * (dofmap1->index_map->size_local()
+                              + dofmap1->index_map->num_ghosts()),
+                       false);
+        bc.mark_dofs(markers);
+      }
+    }
+    return markers;
+  }
+
+  // Copy the node coordinates of a cell
+  void copy_coordinate_dofs(
+      std::int32_t c, std::vector<U>& coordinate_dofs) const
+  {
+    auto x_dofmap = _mesh->geometry().dofmap();
+    coordinate_dofs.resize(3 * x_dofmap.extent(1));
+    _mesh->geometry().coordinates().copy(
+        std::span(&x_dofmap(c, 0), x_dofmap.extent(1)),
+        coordinate_dofs.data());
+  }
+
+  // Compute the element tensor of a form on a cell. The tensor is zero
+  // if the form is not set.
+  void tabulate(
+      const FormData& d, std::span<const T> constants,
+      const std::map<std::pair<IntegralType, int>,
+                     std::pair<std::vector<T>, int>>& coeffs,
+      std::int32_t c,
+      std::span<const U> coordinate_dofs,
+      std::span<T> Ae) const
+  {
+    std::ranges::fill(Ae, 0);
+    if (!d.form)
+      return;
+
+    for (std::size_t i = 0; i < d.ids.size(); ++i)
+    {
+      const std::int32_t p = d.pos[i][c];
+      if (p < 0)
+        continue;
+      auto& [w, cstride] = coeffs.at({IntegralType::cell, d.ids[i]});
+      auto kernel = d.form->kernel(IntegralType::cell, d.ids[i]);
+      kernel(Ae.data(), w.data() + p * cstride, constants.data(),
+             coordinate_dofs.data(), nullptr, nullptr);
+    }
+
+    // Apply the dof transformations
+    std::array<std::size_t, 2> n = {ndim(0), ndim(1)};
+    auto space_index = [&](auto& V) { return V == _V[0] ? 0 : 1; };
+    std::span<const std::uint32_t> cell_info;
+    auto& spaces = d.form->function_spaces();
+    if (std::ranges::any_of(
+            spaces, [](auto& V)
+            { return V->element()->needs_dof_transformations(); }))
+    {
+      _mesh->topology_mutable()->create_entity_permutations();
+      cell_info = std::span(_mesh->topology()->get_cell_permutation_info());
+    }
+
+    const std::size_t ncols
+        = spaces.size() == 2 ? n[space_index(spaces[1])] : 1;
+    spaces[0]->element()->template dof_transformation_fn<T>(
+        doftransform::standard)(Ae, cell_info, c, ncols);
+    if (spaces.size() == 2)
+    {
+      spaces[1]->element()->template dof_transformation_right_fn<T>(
+          doftransform::transpose)(Ae, cell_info, c, n[space_index(spaces[0])]);
+    }
+  }
+
+  // Function spaces V_0 and V_1
+  std::array<std::shared_ptr<const FunctionSpace<U>>, 2> _V;
+
+  // The mesh
+  std::shared_ptr<const mesh::Mesh<U>> _mesh;
+
+  // Bilinear and linear forms of the blocks
+  std::array<std::array<FormData, 2>, 2> _a;
+  std::array<FormData, 2> _L;
+
+  // Cells on which the system is condensed
+  std::vector<std::int32_t> _cells;
+
+  // Per cell: LU factors and row permutation of A00, A00^{-1} A01,
+  // A10 A00^{-1}, the condensed matrix and A00^{-1} b0
+  std::vector<T> _LU;
+  std::vector<std::int32_t> _perm;
+  std::vector<T> _X, _Y, _S, _z0;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,501 @@
+// Copyright (C) 2024 Igor A. Baratta and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "CoordinateElement.h"
+#include "DofMap.h"
+#include "FiniteElement.h"
+#include "FunctionSpace.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <basix/mdspan.hpp>
+#include <basix/quadrature.h>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/math.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+namespace impl
+{
+/// @brief Apply a matrix along one axis of a batch of rank-3 tensors.
+///
+/// Computes `out(.., i, ..) = M(i, l) in(.., l, ..)` where the contracted
+/// index `l` is the `axis` index of `in`. The tensors are stored
+/// row-major with the batch index innermost, i.e. entry `(i0, i1, i2)`
+/// of batch member `b` is at `((i0 * d1 + i1) * d2 + i2) * N + b`.
+///
+/// @tparam N Batch size.
+/// @param[in] M Matrix (row-major) of shape `(m, n)`.
+/// @param[in] m Number of rows of `M`.
+/// @param[in] n Number of columns of `M`.
+/// @param[in] axis Axis of `in` to contract.
+/// @param[in] dims Shape of `in`. `dims[axis]` must be equal to `n`.
+/// @param[in] in Input tensors.
+/// @param[in,out] out Output tensors, with shape `dims` except that
+/// the size of `axis` is `m`.
+/// @param[in] accumulate If true, the result is added to `out`,
+/// otherwise `out` is overwritten.
+template <int N, typename T>
+void contract_axis(std::span<const T> M, std::size_t m, std::size_t n,
+                   int axis, std::array<std::size_t, 3> dims,
+                   std::span<const T> in, std::span<T> out, bool accumulate)
+{
+  assert(dims[axis] == n);
+  std::size_t pre = 1;
+  for (int a = 0; a < axis; ++a)
+    pre *= dims[a];
+  std::size_t post = N;
+  for (int a = axis + 1; a < 3; ++a)
+    post *= dims[a];
+
+  for (std::size_t p = 0; p < pre; ++p)
+  {
+    const T* in_p = in.data() + p * n * post;
+    T* out_p = out.data() + p * m * post;
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      T* o = out_p + i * post;
+      if (!accumulate)
+        std::fill_n(o, post, 0);
+      for (std::size_t l = 0; l < n; ++l)
+      {
+        const T w = M[i * n + l];
+        const T* x = in_p + l * post;
+        for (std::size_t s = 0; s < post; ++s)
+          o[s] += w * x[s];
+      }
+    }
+  }
+}
+} // namespace impl
+
+/// @brief Matrix-free operator for Lagrange elements on quadrilateral
+/// and hexahedral cells using sum factorization.
+///
+/// The operator computes the action of the bilinear form
+/// \f[
+///   a(u, v) = \int_{\Omega} c_0 u v + c_1 \nabla u \cdot \nabla v \,
+///   {\rm d}x
+/// \f]
+/// on a vector. The tensor-product structure of the element and of a
+/// Gauss-Jacobi quadrature rule is used to evaluate the element action
+/// with one-dimensional contractions, which costs \f$O(p^{d+1})\f$ per
+/// cell rather than the \f$O(p^{2d})\f$ of a full element tensor.
+/// Geometric factors are computed when the operator is created.
+///
+/// Cells are processed in batches of `N` cells, with the batch index
+/// innermost in all work arrays such that the contractions vectorize
+/// across cells. The ghost update of the input vector is overlapped with
+/// the computation on cells whose degrees-of-freedom are all owned.
+///
+/// @note Dirichlet boundary conditions are not applied by the
+/// operator.
+///
+/// @tparam T Scalar type.
+/// @tparam N Number of cells in a batch.
+template <std::floating_point T, int N = 8>
+class SumFactorizedOperator
+{
+public:
+  /// @brief Create a sum-factorized operator.
+  /// @param[in] V Function space. Must be a scalar Lagrange space on a
+  /// mesh of quadrilateral or hexahedral cells, with the geometric
+  /// dimension equal to the topological dimension.
+  /// @param[in] c0 Coefficient of the mass term.
+  /// @param[in] c1 Coefficient of the stiffness term.
+  /// @param[in] qdegree Degree of the one-dimensional quadrature rule.
+  /// If negative, twice the element degree is used.
+  SumFactorizedOperator(std::shared_ptr<const FunctionSpace<T>> V, T c0,
+                        T c1, int qdegree = -1)
+      : _V(V)
+  {
+    assert(_V);
+    auto mesh = _V->mesh();
+    assert(mesh);
+    auto element = _V->element();
+    assert(element);
+
+    mesh::CellType cell_type = mesh->topology()->cell_type();
+    if (cell_type != mesh::CellType::quadrilateral
+        and cell_type != mesh::CellType::hexahedron)
+    {
+      throw std::runtime_error(
+          "Sum factorization requires quadrilateral or hexahedral cells.");
+    }
+
+    const basix::FiniteElement<T>& e = element->basix_element();
+    if (e.family() != basix::element::family::P
+        or element->value_size() != 1 or _V->dofmap()->bs() != 1)
+    {
+      throw std::runtime_error(
+          "Sum factorization requires a scalar Lagrange element.");
+    }
+
+    _tdim = mesh->topology()->dim();
+    if (mesh->geometry().dim() != _tdim)
+    {
+      throw std::runtime_error("Sum factorization requires the geometric "
+                               "and topological dimensions to be equal.");
+    }
+
+    // Create one-dimensional element and quadrature rule
+    const int degree = e.degree();
+    basix::FiniteElement<T> e1 = basix::create_element<T>(
+        basix::element::family::P, basix::cell::type::interval, degree,
+        e.lagrange_variant(), basix::element::dpc_variant::unset, false);
+    if (qdegree < 0)
+      qdegree = 2 * degree;
+    auto [qpts, qwts] = basix::quadrature::make_quadrature<T>(
+        basix::quadrature::type::gauss_jacobi, basix::cell::type::interval,
+        basix::polyset::type::standard, qdegree);
+
+    _nd = e1.dim();
+    _nq = qwts.size();
+
+    // Tabulate one-dimensional basis and derivatives at quadrature
+    // points
+    auto [tab, tshape] = e1.tabulate(1, qpts, {_nq, 1});
+    assert(tshape[1] == _nq and tshape[2] == _nd);
+    _B.resize(_nq * _nd);
+    _D.resize(_nq * _nd);
+    _Bt.resize(_nd * _nq);
+    _Dt.resize(_nd * _nq);
+    for (std::size_t q = 0; q < _nq; ++q)
+    {
+      for (std::size_t i = 0; i < _nd; ++i)
+      {
+        _B[q * _nd + i] = _Bt[i * _nq + q] = tab[q * _nd + i];
+        _D[q * _nd + i] = _Dt[i * _nq + q] = tab[(_nq + q) * _nd + i];
+      }
+    }
+
+    // Map from tensor-product dof index to element dof by matching
+    // the element nodes with the one-dimensional nodes
+    const auto& [p1, p1shape] = e1.points();
+    auto [pts, pshape] = element->interpolation_points();
+    assert(pshape[1] == (std::size_t)_tdim);
+    if (pshape[0] != (_tdim == 2 ? _nd * _nd : _nd * _nd * _nd))
+    {
+      throw std::runtime_error(
+          "Element does not have a tensor-product structure.");
+    }
+    _perm.resize(pshape[0]);
+    for (std::size_t d = 0; d < pshape[0]; ++d)
+    {
+      std::size_t t = 0;
+      for (int a = 0; a < _tdim; ++a)
+      {
+        auto it = std::ranges::find_if(
+            p1, [x = pts[d * _tdim + a]](auto p)
+            { return std::abs(p - x) < 1.0e-10; });
+        if (it == p1.end())
+        {
+          throw std::runtime_error(
+              "Element does not have a tensor-product structure.");
+        }
+        t = t * _nd + std::distance(p1.begin(), it);
+      }
+      _perm[t] = d;
+    }
+
+    // Tensor-product quadrature points and weights
+    const std::size_t nqt = num_qpoints();
+    std::vector<T> X(nqt * _tdim);
+    std::vector<T> weights(nqt, 1);
+    for (std::size_t q = 0; q < nqt; ++q)
+    {
+      std::size_t r = q;
+      for (int a = _tdim - 1; a >= 0; --a)
+      {
+        X[q * _tdim + a] = qpts[r % _nq];
+        weights[q] *= qwts[r % _nq];
+        r /= _nq;
+      }
+    }
+
+    // Tabulate coordinate element derivatives at quadrature points
+    const CoordinateElement<T>& cmap = mesh->geometry().cmap();
+    std::array<std::size_t, 4> cshape = cmap.tabulate_shape(1, nqt);
+    std::vector<T> phi(
+        std::reduce(cshape.begin(), cshape.end(), 1, std::multiplies{}));
+    cmap.tabulate(1, X, {nqt, (std::size_t)_tdim}, phi);
+    const std::size_t num_xdofs = cshape[2];
+
+    // Sort owned cells into those whose dofs are all owned and those
+    // that have ghost dofs
+    const DofMap& dofmap = *_V->dofmap();
+    const std::int32_t num_owned_dofs = dofmap.index_map->size_local();
+    const std::int32_t num_cells
+        = mesh->topology()->index_map(_tdim)->size_local();
+    std::vector<std::int32_t> cells0, cells1;
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      std::span<const std::int32_t> dofs = dofmap.cell_dofs(c);
+      if (std::ranges::all_of(dofs, [num_owned_dofs](auto dof)
+                              { return dof < num_owned_dofs; }))
+      {
+        cells0.push_back(c);
+      }
+      else
+        cells1.push_back(c);
+    }
+
+    // Create batches of cells. The last batch of each group is padded
+    // with copies of its final cell.
+    auto add_batches = [&](std::span<const std::int32_t> cells)
+    {
+      for (std::size_t c0 = 0; c0 < cells.size(); c0 += N)
+      {
+        std::size_t nb = std::min<std::size_t>(N, cells.size() - c0);
+        _batch_size.push_back(nb);
+        for (std::size_t b = 0; b < N; ++b)
+          _batch_cells.push_back(cells[c0 + std::min(b, nb - 1)]);
+      }
+    };
+    add_batches(cells0);
+    _num_interior_batches = _batch_size.size();
+    add_batches(cells1);
+
+    // Compute geometric factors (c0 w |J|, c1 w |J| K K^T) at each
+    // quadrature point of each cell. Layout is (batch, point,
+    // component, cell in batch).
+    using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+    const std::size_t ncomp = num_components();
+    auto x_dofmap = mesh->geometry().dofmap();
+    mesh::NodeCoordinates<T> x = mesh->geometry().coordinates();
+    _G.resize(_batch_cells.size() * nqt * ncomp);
+    std::vector<T> J_b(_tdim * _tdim), K_b(_tdim * _tdim);
+    mdspan2_t J(J_b.data(), _tdim, _tdim), K(K_b.data(), _tdim, _tdim);
+    for (std::size_t k = 0; k < _batch_cells.size(); ++k)
+    {
+      const std::size_t batch = k / N, b = k % N;
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, _batch_cells[k],
+          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t q = 0; q < nqt; ++q)
+      {
+        // J(i, j) = sum_l x_l(i) dphi_l/dX_j
+        std::ranges::fill(J_b, 0);
+        for (int j = 0; j < _tdim; ++j)
+        {
+          const T* dphi = phi.data() + ((j + 1) * nqt + q) * num_xdofs;
+          for (std::size_t l = 0; l < num_xdofs; ++l)
+            for (int i = 0; i < _tdim; ++i)
+              J(i, j) += x(x_dofs[l], i) * dphi[l];
+        }
+        math::inv(J, K);
+        const T wdetJ = weights[q] * std::abs(math::det(J));
+
+        T* G = _G.data() + ((batch * nqt + q) * ncomp) * N + b;
+        G[0] = c0 * wdetJ;
+        for (int i = 0; i < _tdim; ++i)
+        {
+          for (int j = 0; j < _tdim; ++j)
+          {
+            T Gij = 0;
+            for (int l = 0; l < _tdim; ++l)
+              Gij += K(i, l) * K(j, l);
+            G[(1 + i * _tdim + j) * N] = c1 * wdetJ * Gij;
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief Compute `y = A x`.
+  ///
+  /// The ghost values of `x` are updated, and ghost contributions to
+  /// `y` are accumulated on the owning ranks such that the owned
+  /// entries of `y` are complete on return.
+  ///
+  /// @param[in,out] x Input vector. Ghost values are updated.
+  /// @param[out] y Output vector.
+  void operator()(la::Vector<T>& x, la::Vector<T>& y) const
+  {
+    std::ranges::fill(y.mutable_array(), 0);
+
+    const std::size_t n = std::max(_nd, _nq);
+    std::size_t size = N;
+    for (int i = 0; i < _tdim; ++i)
+      size *= n;
+    std::array<std::vector<T>, 8> w;
+    std::ranges::for_each(w, [size](auto& wi) { wi.resize(size); });
+
+    x.scatter_fwd_begin();
+    for (std::size_t k = 0; k < _num_interior_batches; ++k)
+      apply_batch(k, x.array(), y.mutable_array(), w);
+    x.scatter_fwd_end();
+    for (std::size_t k = _num_interior_batches; k < _batch_size.size(); ++k)
+      apply_batch(k, x.array(), y.mutable_array(), w);
+
+    y.scatter_rev(std::plus<T>());
+  }
+
+  /// @brief The function space of the operator.
+  std::shared_ptr<const FunctionSpace<T>> function_space() const
+  {
+    return _V;
+  }
+
+  /// @brief Number of one-dimensional quadrature points.
+  std::size_t num_qpoints_1d() const { return _nq; }
+
+private:
+  // Number of quadrature points on a cell
+  std::size_t num_qpoints() const
+  {
+    std::size_t nqt = 1;
+    for (int i = 0; i < _tdim; ++i)
+      nqt *= _nq;
+    return nqt;
+  }
+
+  // Number of geometric factor components at a quadrature point
+  std::size_t num_components() const { return 1 + _tdim * _tdim; }
+
+  // Compute the action of the operator on cell batch k and add to y
+  void apply_batch(std::size_t k, std::span<const T> x, std::span<T> y,
+                   std::array<std::vector<T>, 8>& w) const
+  {
+    const DofMap& dofmap = *_V->dofmap();
+    const std::size_t ndt = _perm.size();
+    std::span<const std::int32_t> cells(_batch_cells.data() + k * N, N);
+
+    // Gather cell dofs
+    std::span<T> u(w[0]);
+    for (std::size_t b = 0; b < N; ++b)
+    {
+      std::span<const std::int32_t> dofs = dofmap.cell_dofs(cells[b]);
+      for (std::size_t t = 0; t < ndt; ++t)
+        u[t * N + b] = x[dofs[_perm[t]]];
+    }
+
+    // Evaluate value (w[1]) and gradient (w[2], ...) at quadrature
+    // points
+    const std::size_t nd = _nd, nq = _nq;
+    std::span<const T> B(_B), D(_D), Bt(_Bt), Dt(_Dt);
+    if (_tdim == 2)
+    {
+      impl::contract_axis<N, T>(B, nq, nd, 1, {nd, nd, 1}, u, w[5], false);
+      impl::contract_axis<N, T>(D, nq, nd, 1, {nd, nd, 1}, u, w[6], false);
+      impl::contract_axis<N, T>(B, nq, nd, 0, {nd, nq, 1}, w[5], w[1], false);
+      impl::contract_axis<N, T>(D, nq, nd, 0, {nd, nq, 1}, w[5], w[2], false);
+      impl::contract_axis<N, T>(B, nq, nd, 0, {nd, nq, 1}, w[6], w[3], false);
+    }
+    else
+    {
+      impl::contract_axis<N, T>(B, nq, nd, 2, {nd, nd, nd}, u, w[5], false);
+      impl::contract_axis<N, T>(D, nq, nd, 2, {nd, nd, nd}, u, w[6], false);
+      impl::contract_axis<N, T>(B, nq, nd, 1, {nd, nd, nq}, w[5], w[7], false);
+      impl::contract_axis<N, T>(B, nq, nd, 0, {nd, nq, nq}, w[7], w[1], false);
+      impl::contract_axis<N, T>(D, nq, nd, 0, {nd, nq, nq}, w[7], w[2], false);
+      impl::contract_axis<N, T>(D, nq, nd, 1, {nd, nd, nq}, w[5], w[7], false);
+      impl::contract_axis<N, T>(B, nq, nd, 0, {nd, nq, nq}, w[7], w[3], false);
+      impl::contract_axis<N, T>(B, nq, nd, 1, {nd, nd, nq}, w[6], w[7], false);
+      impl::contract_axis<N, T>(B, nq, nd, 0, {nd, nq, nq}, w[7], w[4], false);
+    }
+
+    // Apply geometric factors at quadrature points
+    const std::size_t nqt = num_qpoints();
+    const std::size_t ncomp = num_components();
+    const T* G = _G.data() + k * nqt * ncomp * N;
+    std::array<T, 3> du;
+    for (std::size_t q = 0; q < nqt; ++q)
+    {
+      const T* Gq = G + q * ncomp * N;
+      for (std::size_t b = 0; b < N; ++b)
+      {
+        const std::size_t qb = q * N + b;
+        w[1][qb] *= Gq[b];
+        for (int i = 0; i < _tdim; ++i)
+          du[i] = w[2 + i][qb];
+        for (int i = 0; i < _tdim; ++i)
+        {
+          T v = 0;
+          for (int j = 0; j < _tdim; ++j)
+            v += Gq[(1 + i * _tdim + j) * N + b] * du[j];
+          w[2 + i][qb] = v;
+        }
+      }
+    }
+
+    // Integrate against test functions (transpose of the evaluation)
+    if (_tdim == 2)
+    {
+      impl::contract_axis<N, T>(Bt, nd, nq, 0, {nq, nq, 1}, w[1], w[5], false);
+      impl::contract_axis<N, T>(Dt, nd, nq, 0, {nq, nq, 1}, w[2], w[5], true);
+      impl::contract_axis<N, T>(Bt, nd, nq, 0, {nq, nq, 1}, w[3], w[6], false);
+      impl::contract_axis<N, T>(Bt, nd, nq, 1, {nd, nq, 1}, w[5], u, false);
+      impl::contract_axis<N, T>(Dt, nd, nq, 1, {nd, nq, 1}, w[6], u, true);
+    }
+    else
+    {
+      impl::contract_axis<N, T>(Bt, nd, nq, 0, {nq, nq, nq}, w[1], w[7], false);
+      impl::contract_axis<N, T>(Dt, nd, nq, 0, {nq, nq, nq}, w[2], w[7], true);
+      impl::contract_axis<N, T>(Bt, nd, nq, 1, {nd, nq, nq}, w[7], w[5], false);
+      impl::contract_axis<N, T>(Bt, nd, nq, 0, {nq, nq, nq}, w[3], w[7], false);
+      impl::contract_axis<N, T>(Dt, nd, nq, 1, {nd, nq, nq}, w[7], w[5], true);
+      impl::contract_axis<N, T>(Bt, nd, nq, 0, {nq, nq, nq}, w[4], w[7], false);
+      impl::contract_axis<N, T>(Bt, nd, nq, 1, {nd, nq, nq}, w[7], w[6], false);
+      impl::contract_axis<N, T>(Bt, nd, nq, 2, {nd, nd, nq}, w[5], u, false);
+      impl::contract_axis<N, T>(Dt, nd, nq, 2, {nd, nd, nq}, w[6], u, true);
+    }
+
+    // Scatter cell contributions, skipping padding cells
+    for (std::size_t b = 0; b < _batch_size[k]; ++b)
+    {
+      std::span<const std::int32_t> dofs = dofmap.cell_dofs(cells[b]);
+      for (std::size_t t = 0; t < ndt; ++t)
+        y[dofs[_perm[t]]] += u[t * N + b];
+    }
+  }
+
+  // Function space
+  std::shared_ptr<const FunctionSpace<T>> _V;
+
+  // Topological dimension
+  int _tdim;
+
+  // Number of one-dimensional dofs and quadrature points
+  std::size_t _nd, _nq;
+
+  // One-dimensional basis (B) and derivatives (D) at quadrature points,
+  // shape (nq, nd), and their transposes
+  std::vector<T> _B, _D, _Bt, _Dt;
+
+  // Element dof for each tensor-product dof index
+  std::vector<std::int32_t> _perm;
+
+  // Cells of each batch (padded), and the number of cells in each
+  // batch
+  std::vector<std::int32_t> _batch_cells;
+  std::vector<std::size_t> _batch_size;
+
+  // Number of batches of cells with only owned dofs. These batches come
+  // first.
+  std::size_t _num_interior_batches;
+
+  // Geometric factors
+  std::vector<T> _G;
+};
+
+} // namespace dolfinx::fem
@@ -0,0 +1,151 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Bounded cache of the tabulated basis functions of an element,
+/// keyed by derivative order and point set.
+///
+/// Expressions, interpolation and function evaluation often tabulate
+/// an element repeatedly at the same reference points, which is costly
+/// for high-degree elements. The cache keeps the most recently used
+/// tabulations. Point sets are compared by value, so that a hash
+/// collision can not return the wrong tabulation. Tabulations at a
+/// single point, e.g. in the Newton iterations of a pull-back, are
+/// cheap and rarely repeated, and are not cached. It is safe to use the
+/// cache from several threads.
+///
+/// @tparam T Floating point type of the points and tabulated values.
+template <std::floating_point T>
+class TabulationCache
+{
+public:
+  /// @brief Create a cache.
+  /// @param[in] max_entries Maximum number of tabulations to keep.
+  /// @param[in] max_size Maximum number of values of a tabulation that
+  /// is kept. Larger tabulations are not cached.
+  explicit TabulationCache(std::size_t max_entries = 8,
+                           std::size_t max_size = 1 << 22)
+      : _max_entries(max_entries), _max_size(max_size)
+  {
+  }
+
+  /// @brief Tabulated values at points `X`, computed by `tabulate` if
+  /// they are not in the cache.
+  /// @param[in] order Derivative order.
+  /// @param[in] X Reference points (row-major storage).
+  /// @param[in] shape Shape of `X`.
+  /// @param[in] tabulate Function that returns the tabulated values
+  /// and their shape if they are not cached.
+  /// @return Tabulated values and their shape.
+  template <typename F>
+  std::pair<std::shared_ptr<const std::vector<T>>, std::array<std::size_t, 4>>
+  get(int order, std::span<const T> X, std::array<std::size_t, 2> shape,
+      F&& tabulate)
+  {
+    if (shape[0] < 2)
+    {
+      auto [values, vshape] = tabulate();
+      return {std::make_shared<const std::vector<T>>(std::move(values)),
+              vshape};
+    }
+
+    const std::size_t key = hash(order, X);
+    {
+      std::scoped_lock lock(_mutex);
+      auto it = std::ranges::find_if(
+          _entries,
+          [&](const Entry& e)
+          {
+            return e.key == key and e.order == order and e.xshape == shape
+                   and std::ranges::equal(e.X, X);
+          });
+      if (it != _entries.end())
+      {
+        // Move to the front (most recently used)
+        _entries.splice(_entries.begin(), _entries, it);
+        ++_num_hits;
+        return {it->values, it->shape};
+      }
+    }
+
+    // Tabulate without holding the lock
+    auto [values, vshape] = tabulate();
+    auto v = std::make_shared<const std::vector<T>>(std::move(values));
+    if (v->size() <= _max_size and _max_entries > 0)
+    {
+      std::scoped_lock lock(_mutex);
+      _entries.push_front(
+          {key, order, shape, std::vector<T>(X.begin(), X.end()), v, vshape});
+      if (_entries.size() > _max_entries)
+        _entries.pop_back();
+    }
+    return {v, vshape};
+  }
+
+  /// Number of tabulations that were found in the cache
+  std::size_t num_hits() const
+  {
+    std::scoped_lock lock(_mutex);
+    return _num_hits;
+  }
+
+  /// Number of tabulations that are cached
+  std::size_t size() const
+  {
+    std::scoped_lock lock(_mutex);
+    return _entries.size();
+  }
+
+  /// Remove all tabulations
+  void clear()
+  {
+    std::scoped_lock lock(_mutex);
+    _entries.clear();
+  }
+
+private:
+  struct Entry
+  {
+    std::size_t key;
+    int order;
+    std::array<std::size_t, 2> xshape;
+    std::vector<T> X;
+    std::shared_ptr<const std::vector<T>> values;
+    std::array<std::size_t, 4> shape;
+  };
+
+  static std::size_t hash(int order, std::span<const T> X)
+  {
+    std::size_t h = std::hash<std::string_view>()(std::string_view(
+        reinterpret_cast<const char*>(X.data()), X.size_bytes()));
+    return h ^ (std::hash<int>()(order) + 0x9e3779b9 + (h << 6) + (h >> 2));
+  }
+
+  std::size_t _max_entries, _max_size;
+
+  mutable std::mutex _mutex;
+
+  // Most recently used first
+  std::list<Entry> _entries;
+  std::size_t _num_hits = 0;
+};
+} // namespace dolfinx::fem
@@ -0,0 +1,146 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "DofMap.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "traits.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief A cell integral over cells of one type of a mixed-topology
+/// mesh.
+///
+/// The cells of each type of a mixed-topology mesh are stored
+/// contiguously, with a geometry dofmap (see mesh::Geometry::dofmap(int))
+/// and a dofmap for each space (see fem::create_dofmaps) per type.
+template <dolfinx::scalar T>
+struct CellTypeIntegral
+{
+  /// Index of the cell type in `mesh::Topology::entity_types(tdim)`
+  int type;
+
+  /// Kernel for cells of the type
+  std::function<void(T*, const T*, const T*, const scalar_value_type_t<T>*,
+                     const int*, const std::uint8_t*)>
+      kernel;
+
+  /// Cells to integrate over, indexed within the cell type
+  std::span<const std::int32_t> cells;
+
+  /// Dofmaps of the test and trial spaces for the cell type. The trial
+  /// dofmap is not used for linear forms.
+  std::array<std::shared_ptr<const DofMap>, 2> dofmaps;
+
+  /// Packed coefficients of the cells, shape `(cells.size(), cstride)`
+  std::span<const T> coeffs = {};
+
+  /// Number of coefficient values per cell
+  int cstride = 0;
+};
+} // namespace dolfinx::fem
+
+namespace dolfinx::fem::impl
+{
+/// @brief Order of the integrals, grouped by cell type such that the
+/// geometry and dofmap data of one type are traversed together.
+template <dolfinx::scalar T>
+std::vector<std::size_t>
+cell_type_order(std::span<const CellTypeIntegral<T>> integrals)
+{
+  std::vector<std::size_t> order(integrals.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, std::ranges::less(),
+                           [&integrals](std::size_t i)
+                           { return integrals[i].type; });
+  return order;
+}
+
+/// @brief Assemble cell integrals over the cell types of a
+/// mixed-topology mesh into a matrix.
+///
+/// Each integral is executed as one batch over its cells, with element
+/// buffers and a kernel loop specialised to the dimensions of its cell
+/// type (see impl::assemble_cells_dispatch).
+///
+/// @param[in] mat_set Function that accumulates values into a matrix.
+/// @param[in] geometry Mesh geometry.
+/// @param[in] x Mesh geometry coordinates.
+/// @param[in] integrals Integrals over the cell types.
+/// @param[in] constants Packed constants.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary
+/// conditions.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_cell_types(
+    la::MatSet<T> auto mat_set, const mesh::Geometry<U>& geometry,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const CellTypeIntegral<T>> integrals,
+    std::span<const T> constants, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  // Dof transformations are not supported on mixed-topology meshes
+  auto P = [](std::span<T>, std::span<const std::uint32_t>, std::int32_t,
+              int) {};
+  for (std::size_t k : cell_type_order(integrals))
+  {
+    const CellTypeIntegral<T>& itg = integrals[k];
+    assert(itg.kernel);
+    assert(itg.dofmaps[0] and itg.dofmaps[1]);
+    assemble_cells_dispatch(
+        mat_set, geometry.dofmap(itg.type), x, itg.cells,
+        {itg.dofmaps[0]->map(), itg.dofmaps[0]->bs(), itg.cells}, P,
+        {itg.dofmaps[1]->map(), itg.dofmaps[1]->bs(), itg.cells}, P, bc0,
+        bc1, itg.kernel, itg.coeffs, itg.cstride, constants, {}, {});
+  }
+}
+
+/// @brief Assemble cell integrals over the cell types of a
+/// mixed-topology mesh into a vector.
+///
+/// @param[in,out] b Vector to assemble into.
+/// @param[in] geometry Mesh geometry.
+/// @param[in] x Mesh geometry coordinates.
+/// @param[in] integrals Integrals over the cell types.
+/// @param[in] constants Packed constants.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_cell_types(
+    std::span<T> b, const mesh::Geometry<U>& geometry,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const CellTypeIntegral<T>> integrals,
+    std::span<const T> constants)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  auto P = [](std::span<T>, std::span<const std::uint32_t>, std::int32_t,
+              int) {};
+  for (std::size_t k : cell_type_order(integrals))
+  {
+    const CellTypeIntegral<T>& itg = integrals[k];
+    assert(itg.kernel);
+    assert(itg.dofmaps[0]);
+    assemble_cells_bs(P, b, geometry.dofmap(itg.type), x, itg.cells,
+                      {itg.dofmaps[0]->map(), itg.dofmaps[0]->bs(), itg.cells},
+                      itg.kernel, constants, itg.coeffs, itg.cstride, {});
+  }
+}
+} // namespace dolfinx::fem::impl
@@ -0,0 +1,439 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "traits.h"
+#include "utils.h"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem
+{
+/// @brief Function that computes the positions in the value array of a
+/// matrix of the entries of a dense block with rows `rows` and columns
+/// `cols`, e.g. la::MatrixCSR::value_positions.
+template <typename F>
+concept MatPositions
+    = std::invocable<F, std::span<const std::int32_t>,
+                     std::span<const std::int32_t>, std::span<std::int64_t>>;
+} // namespace dolfinx::fem
+
+namespace dolfinx::fem::impl
+{
+/// @brief Coefficients of the samples of an ensemble for the cell
+/// integral `id` of a form.
+/// @return Coefficients of each sample and the coefficient stride.
+template <dolfinx::scalar T>
+std::pair<std::vector<std::span<const T>>, int> ensemble_cell_coefficients(
+    std::span<const std::map<std::pair<IntegralType, int>,
+                             std::pair<std::span<const T>, int>>>
+        coefficients,
+    int id, std::size_t num_cells)
+{
+  std::vector<std::span<const T>> c;
+  int cstride = 0;
+  for (auto& coeffs : coefficients)
+  {
+    auto& [_c, _cstride] = coeffs.at({IntegralType::cell, id});
+    if (pack_cells_deferred(_c, _cstride, num_cells))
+    {
+      throw std::runtime_error(
+          "Cell coefficients must be packed for ensemble assembly.");
+    }
+    c.push_back(_c);
+    cstride = _cstride;
+  }
+  return {std::move(c), cstride};
+}
+
+/// @brief Execute a kernel over cells for each sample of an ensemble
+/// and accumulate the results in a vector with interleaved samples.
+///
+/// The geometry and dofs of a cell are gathered once for all samples.
+/// The value of sample `s` at (unrolled) dof `i` is `b[i * ns + s]`,
+/// where `ns = coeffs.size()` is the number of samples, such that the
+/// cell vectors of the samples are accumulated with unit stride.
+///
+/// @param P0 Function that applies transformation P0.b in-place to
+/// transform test degrees-of-freedom.
+/// @param b Vector with interleaved samples to accumulate into.
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh).
+/// @param dofmap Test function (row) degree-of-freedom data holding the
+/// (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param kernel Kernel function to execute over each cell.
+/// @param constants The constant data, shared by the samples.
+/// @param coeffs The coefficient data of each sample, of shape
+/// `(cells.size(), cstride)`.
+/// @param cstride Coefficient stride.
+/// @param cell_info0 The cell permutation information for the test
+/// function mesh.
+template <dolfinx::scalar T>
+void assemble_cells_ensemble(
+    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
+    FEkernel<T> auto kernel, std::span<const T> constants,
+    std::span<const std::span<const T>> coeffs, int cstride,
+    std::span<const std::uint32_t> cell_info0)
+{
+  if (cells.empty() or coeffs.empty())
+    return;
+
+  const auto [dmap, bs, cells0] = dofmap;
+  const std::size_t ns = coeffs.size();
+  const std::size_t ndim = bs * dmap.extent(1);
+
+  // Element vectors of all samples, shape (ns, ndim)
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+  std::pmr::vector<T> be(ns * ndim, common::scratch_resource());
+  for (std::size_t index = 0; index < cells.size(); ++index)
+  {
+    std::int32_t c = cells[index];
+    std::int32_t c0 = cells0[index];
+
+    // Get cell coordinates/geometry once for all samples
+    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    x.copy(x_dofs, coordinate_dofs.data());
+
+    // Tabulate the cell vector of each sample
+    std::ranges::fill(be, 0);
+    for (std::size_t s = 0; s < ns; ++s)
+    {
+      std::span<T> _be(be.data() + s * ndim, ndim);
+      kernel(_be.data(), coeffs[s].data() + index * cstride,
+             constants.data(), coordinate_dofs.data(), nullptr, nullptr);
+      P0(_be, cell_info0, c0, 1);
+    }
+
+    // Scatter the cell vectors, with the samples of a dof contiguous
+    auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        dmap, c0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+    {
+      for (int k = 0; k < bs; ++k)
+      {
+        const std::size_t j = bs * i + k;
+        T* bj = b.data() + (bs * dofs[i] + k) * ns;
+        for (std::size_t s = 0; s < ns; ++s)
+          bj[s] += be[s * ndim + j];
+      }
+    }
+  }
+}
+
+/// @brief Execute a kernel over cells for each sample of an ensemble
+/// and accumulate the results in the values of matrices that share a
+/// sparsity pattern, with interleaved samples.
+///
+/// The geometry, dofs and positions of the entries in the matrix of a
+/// cell are computed once for all samples. The value of sample `s` at
+/// position `p` in the value array of the matrix is `A[p * ns + s]`,
+/// where `ns = coeffs.size()` is the number of samples.
+///
+/// @param mat_pos Function that computes the positions of the entries
+/// of an element matrix in the value array.
+/// @param A Matrix values with interleaved samples.
+/// See impl::assemble_cells (matrix) for the other arguments.
+template <dolfinx::scalar T>
+void assemble_cells_ensemble(
+    MatPositions auto mat_pos, std::span<T> A, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
+    std::span<const std::span<const T>> coeffs, int cstride,
+    std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1)
+{
+  if (cells.empty() or coeffs.empty())
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+  const std::size_t ns = coeffs.size();
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  const std::size_t size = ndim0 * ndim1;
+
+  // Element matrices of all samples, shape (ns, ndim0 * ndim1)
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+  std::pmr::vector<T> Ae(ns * size, common::scratch_resource());
+  std::pmr::vector<std::int64_t> pos(size, common::scratch_resource());
+  std::pmr::vector<std::int8_t> zero0(ndim0, common::scratch_resource());
+  std::pmr::vector<std::int8_t> zero1(ndim1, common::scratch_resource());
+  for (std::size_t index = 0; index < cells.size(); ++index)
+  {
+    std::int32_t c = cells[index];
+    std::int32_t c0 = cells0[index];
+    std::int32_t c1 = cells1[index];
+
+    // Get cell coordinates/geometry once for all samples
+    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    x.copy(x_dofs, coordinate_dofs.data());
+
+    // Rows and columns with essential bcs
+    auto dofs0 = std::span(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
+    auto dofs1 = std::span(dmap1.data_handle() + c1 * num_dofs1, num_dofs1);
+    bool has_bc = false;
+    for (int i = 0; i < num_dofs0; ++i)
+    {
+      for (int k = 0; k < bs0; ++k)
+      {
+        zero0[bs0 * i + k] = !bc0.empty() and bc0[bs0 * dofs0[i] + k];
+        has_bc = has_bc or zero0[bs0 * i + k];
+      }
+    }
+    for (int j = 0; j < num_dofs1; ++j)
+    {
+      for (int k = 0; k < bs1; ++k)
+      {
+        zero1[bs1 * j + k] = !bc1.empty() and bc1[bs1 * dofs1[j] + k];
+        has_bc = has_bc or zero1[bs1 * j + k];
+      }
+    }
+
+    // Tabulate the element matrix of each sample
+    std::ranges::fill(Ae, 0);
+    for (std::size_t s = 0; s < ns; ++s)
+    {
+      std::span<T> _Ae(Ae.data() + s * size, size);
+      kernel(_Ae.data(), coeffs[s].data() + index * cstride,
+             constants.data(), coordinate_dofs.data(), nullptr, nullptr);
+      P0(_Ae, cell_info0, c0, ndim1);
+      P1T(_Ae, cell_info1, c1, ndim0);
+      if (has_bc)
+      {
+        for (int row = 0; row < ndim0; ++row)
+          for (int col = 0; col < ndim1; ++col)
+            if (zero0[row] or zero1[col])
+              _Ae[row * ndim1 + col] = 0;
+      }
+    }
+
+    // Locate the entries in the sparsity once, and scatter the element
+    // matrices with the samples of an entry contiguous
+    mat_pos(dofs0, dofs1, std::span<std::int64_t>(pos));
+    for (std::size_t k = 0; k < size; ++k)
+    {
+      T* Ak = A.data() + pos[k] * ns;
+      for (std::size_t s = 0; s < ns; ++s)
+        Ak[s] += Ae[s * size + k];
+    }
+  }
+}
+
+/// @brief Assemble a linear form for an ensemble of coefficient
+/// samples into a vector with interleaved samples.
+///
+/// Cell integrals are assembled for all samples with one traversal of
+/// the cells. Facet integrals are assembled sample by sample.
+///
+/// @param[in,out] b Vector with interleaved samples (see
+/// assemble_cells_ensemble). It is not zeroed.
+/// @param[in] L Linear form.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants of `L`, shared by the samples.
+/// @param[in] coefficients Packed coefficients of `L` for each sample.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_ensemble(
+    std::span<T> b, const Form<T, U>& L, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    std::span<const std::map<std::pair<IntegralType, int>,
+                             std::pair<std::span<const T>, int>>>
+        coefficients)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  const std::size_t ns = coefficients.size();
+  if (ns == 0)
+    return;
+  if (b.size() % ns != 0)
+    throw std::runtime_error("Vector size is not a multiple of samples.");
+
+  auto mesh0 = L.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto element = L.function_spaces().at(0)->element();
+  assert(element);
+  std::shared_ptr<const fem::DofMap> dofmap
+      = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+
+  fem::DofTransformKernel<T> auto P0
+      = element->template dof_transformation_fn<T>(doftransform::standard);
+
+  std::span<const std::uint32_t> cell_info0;
+  if (element->needs_dof_transformations() or L.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+  }
+
+  for (int i : L.integral_ids(IntegralType::cell))
+  {
+    auto fn = L.kernel(IntegralType::cell, i);
+    assert(fn);
+    std::span<const std::int32_t> cells = L.domain(IntegralType::cell, i);
+    auto [coeffs, cstride]
+        = ensemble_cell_coefficients(coefficients, i, cells.size());
+    impl::assemble_cells_ensemble(
+        P0, b, x_dofmap, x, cells,
+        {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)}, fn, constants,
+        std::span<const std::span<const T>>(coeffs), cstride, cell_info0);
+  }
+
+  if (L.num_integrals(IntegralType::exterior_facet) > 0
+      or L.num_integrals(IntegralType::interior_facet) > 0)
+  {
+    std::vector<T> bs_(b.size() / ns);
+    for (std::size_t s = 0; s < ns; ++s)
+    {
+      std::ranges::fill(bs_, 0);
+      assemble_vector_facets(P0, std::span<T>(bs_), L, x_dofmap, x,
+                             constants, coefficients[s], cell_info0);
+      for (std::size_t j = 0; j < bs_.size(); ++j)
+        b[j * ns + s] += bs_[j];
+    }
+  }
+}
+
+/// @brief Assemble a bilinear form for an ensemble of coefficient
+/// samples into the values of matrices that share a sparsity pattern,
+/// with interleaved samples.
+///
+/// Cell integrals are assembled for all samples with one traversal of
+/// the cells, locating each element matrix in the sparsity once. Facet
+/// integrals are assembled sample by sample.
+///
+/// @param[in] mat_pos Function that computes the positions of the
+/// entries of an element matrix in the value array.
+/// @param[in,out] A Matrix values with interleaved samples (see
+/// assemble_cells_ensemble). They are not zeroed.
+/// @param[in] a Bilinear form.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants of `a`, shared by the samples.
+/// @param[in] coefficients Packed coefficients of `a` for each sample.
+/// @param[in] bc0 Boundary condition markers for the rows.
+/// @param[in] bc1 Boundary condition markers for the columns.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_ensemble(
+    MatPositions auto mat_pos, std::span<T> A, const Form<T, U>& a,
+    mdspan2_t x_dofmap, mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    std::span<const std::map<std::pair<IntegralType, int>,
+                             std::pair<std::span<const T>, int>>>
+        coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  const std::size_t ns = coefficients.size();
+  if (ns == 0)
+    return;
+  if (A.size() % ns != 0)
+    throw std::runtime_error("Matrix size is not a multiple of samples.");
+
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh0);
+  assert(mesh1);
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  auto dofs1 = dofmap1->map();
+  const int bs1 = dofmap1->bs();
+
+  auto element0 = a.function_spaces().at(0)->element();
+  auto element1 = a.function_spaces().at(1)->element();
+  assert(element0);
+  assert(element1);
+  fem::DofTransformKernel<T> auto P0
+      = element0->template dof_transformation_fn<T>(doftransform::standard);
+  fem::DofTransformKernel<T> auto P1T
+      = element1->template dof_transformation_right_fn<T>(
+          doftransform::transpose);
+
+  std::span<const std::uint32_t> cell_info0, cell_info1;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations() or a.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    auto fn = a.kernel(IntegralType::cell, i);
+    assert(fn);
+    std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+    auto [coeffs, cstride]
+        = ensemble_cell_coefficients(coefficients, i, cells.size());
+    impl::assemble_cells_ensemble(
+        mat_pos, A, x_dofmap, x, cells,
+        {dofs0, bs0, a.domain(IntegralType::cell, i, *mesh0)}, P0,
+        {dofs1, bs1, a.domain(IntegralType::cell, i, *mesh1)}, P1T, bc0, bc1,
+        fn, std::span<const std::span<const T>>(coeffs), cstride, constants,
+        cell_info0, cell_info1);
+  }
+
+  for (std::size_t s = 0; s < ns; ++s)
+  {
+    std::vector<std::int64_t> pos;
+    auto mat_set = [&](std::span<const std::int32_t> rows,
+                       std::span<const std::int32_t> cols,
+                       std::span<const T> Ae) -> int
+    {
+      pos.resize(Ae.size());
+      mat_pos(rows, cols, std::span(pos));
+      for (std::size_t k = 0; k < Ae.size(); ++k)
+        A[pos[k] * ns + s] += Ae[k];
+      return 0;
+    };
+    assemble_matrix_facets(mat_set, a, x_dofmap, x, constants,
+                           coefficients[s], bc0, bc1, P0, P1T, cell_info0,
+                           cell_info1, 1);
+  }
+}
+} // namespace dolfinx::fem::impl
@@ -0,0 +1,287 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_scalar_impl.h"
+#include "assemble_vector_impl.h"
+#include "traits.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::fem::impl
+{
+/// @brief Assemble a bilinear form into a matrix, a linear form into a
+/// vector and a functional into a scalar with one traversal of the
+/// cells of each cell integration domain.
+///
+/// Cell integrals of the forms with the same domain id and the same
+/// cells are assembled together. The cells are traversed in blocks of
+/// `block_size` cells and the cell kernels of all forms are executed
+/// for a block before moving to the next block. The geometry, dofmap
+/// and coefficient data of a block is therefore read from memory once
+/// and is in cache when the kernels of the second and later forms are
+/// executed. Other cell integrals and all facet integrals are
+/// assembled form by form.
+///
+/// @param[in] mat_set The function for adding values into the matrix.
+/// @param[in] a The bilinear form. Can be `nullptr`.
+/// @param[in] bc0 Boundary condition markers for the rows of the
+/// matrix.
+/// @param[in] bc1 Boundary condition markers for the columns of the
+/// matrix.
+/// @param[in,out] b The vector to assemble `L` into. It is not zeroed.
+/// @param[in] L The linear form. Can be `nullptr`.
+/// @param[in] M The functional. Can be `nullptr`.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants of `a`, `L` and `M`.
+/// @param[in] coefficients Packed coefficients of `a`, `L` and `M`.
+/// See for_each_cell_block for cell integral coefficients that are
+/// packed during assembly.
+/// @param[in] block_size Number of cells in a block.
+/// @return The contribution of the local process to `M`.
+template <dolfinx::scalar T, std::floating_point U>
+T assemble_fused(
+    la::MatSet<T> auto mat_set, const Form<T, U>* a,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    std::span<T> b, const Form<T, U>* L, const Form<T, U>* M,
+    mdspan2_t x_dofmap, mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    const std::array<std::span<const T>, 3>& constants,
+    const std::array<std::map<std::pair<IntegralType, int>,
+                              std::pair<std::span<const T>, int>>,
+                     3>& coefficients,
+    std::size_t block_size)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  const std::array<const Form<T, U>*, 3> forms = {a, L, M};
+  std::shared_ptr<const mesh::Mesh<U>> mesh;
+  for (const Form<T, U>* form : forms)
+  {
+    if (form and !mesh)
+      mesh = form->mesh();
+    else if (form and form->mesh() != mesh)
+      throw std::runtime_error("Forms must have the same mesh.");
+  }
+
+  T value(0);
+  if (!mesh)
+    return value;
+
+  // Function that assembles the cells [k0, k1) of a cell integral
+  // domain, given the packed coefficients of the cells
+  using block_fn
+      = std::function<void(std::size_t, std::size_t, std::span<const T>)>;
+
+  // Create the cell block functions and assemble the facet integrals
+  // of each form
+  std::array<std::map<int, block_fn>, 3> cell_fns;
+  if (a)
+  {
+    auto mesh0 = a->function_spaces().at(0)->mesh();
+    auto mesh1 = a->function_spaces().at(1)->mesh();
+    assert(mesh0);
+    assert(mesh1);
+    std::shared_ptr<const fem::DofMap> dofmap0
+        = a->function_spaces().at(0)->dofmap();
+    std::shared_ptr<const fem::DofMap> dofmap1
+        = a->function_spaces().at(1)->dofmap();
+    assert(dofmap0);
+    assert(dofmap1);
+    auto element0 = a->function_spaces().at(0)->element();
+    auto element1 = a->function_spaces().at(1)->element();
+    assert(element0);
+    assert(element1);
+    fem::DofTransformKernel<T> auto P0
+        = element0->template dof_transformation_fn<T>(doftransform::standard);
+    fem::DofTransformKernel<T> auto P1T
+        = element1->template dof_transformation_right_fn<T>(
+            doftransform::transpose);
+
+    std::span<const std::uint32_t> cell_info0, cell_info1;
+    if (element0->needs_dof_transformations()
+        or element1->needs_dof_transformations()
+        or a->needs_facet_permutations())
+    {
+      mesh0->topology_mutable()->create_entity_permutations();
+      mesh1->topology_mutable()->create_entity_permutations();
+      cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+      cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+    }
+
+    for (int i : a->integral_ids(IntegralType::cell))
+    {
+      cell_fns[0][i]
+          = [&, P0, P1T, cell_info0, cell_info1, dofs0 = dofmap0->map(),
+             bs0 = dofmap0->bs(), dofs1 = dofmap1->map(),
+             bs1 = dofmap1->bs(), kernel = a->kernel(IntegralType::cell, i),
+             cstride = coefficients[0].at({IntegralType::cell, i}).second,
+             cells = a->domain(IntegralType::cell, i),
+             cells0 = a->domain(IntegralType::cell, i, *mesh0),
+             cells1 = a->domain(IntegralType::cell, i, *mesh1)](
+                std::size_t k0, std::size_t k1, std::span<const T> c)
+      {
+        const std::size_t n = k1 - k0;
+        impl::assemble_cells(mat_set, x_dofmap, x, cells.subspan(k0, n),
+                             {dofs0, bs0, cells0.subspan(k0, n)}, P0,
+                             {dofs1, bs1, cells1.subspan(k0, n)}, P1T, bc0,
+                             bc1, kernel, c, cstride, constants[0], cell_info0,
+                             cell_info1, {});
+      };
+    }
+
+    assemble_matrix_facets(mat_set, *a, x_dofmap, x, constants[0],
+                           coefficients[0], bc0, bc1, P0, P1T, cell_info0,
+                           cell_info1, 1);
+  }
+
+  if (L)
+  {
+    auto mesh0 = L->function_spaces().at(0)->mesh();
+    assert(mesh0);
+    std::shared_ptr<const fem::DofMap> dofmap
+        = L->function_spaces().at(0)->dofmap();
+    assert(dofmap);
+    auto element = L->function_spaces().at(0)->element();
+    assert(element);
+    fem::DofTransformKernel<T> auto P0
+        = element->template dof_transformation_fn<T>(doftransform::standard);
+
+    std::span<const std::uint32_t> cell_info0;
+    if (element->needs_dof_transformations() or L->needs_facet_permutations())
+    {
+      mesh0->topology_mutable()->create_entity_permutations();
+      cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    }
+
+    for (int i : L->integral_ids(IntegralType::cell))
+    {
+      cell_fns[1][i]
+          = [&, P0, cell_info0, dofs = dofmap->map(), bs = dofmap->bs(),
+             kernel = L->kernel(IntegralType::cell, i),
+             cstride = coefficients[1].at({IntegralType::cell, i}).second,
+             cells = L->domain(IntegralType::cell, i),
+             cells0 = L->domain(IntegralType::cell, i, *mesh0)](
+                std::size_t k0, std::size_t k1, std::span<const T> c)
+      {
+        const std::size_t n = k1 - k0;
+        impl::assemble_cells_bs(P0, b, x_dofmap, x, cells.subspan(k0, n),
+                                {dofs, bs, cells0.subspan(k0, n)}, kernel,
+                                constants[1], c, cstride, cell_info0);
+      };
+    }
+
+    assemble_vector_facets(P0, b, *L, x_dofmap, x, constants[1],
+                           coefficients[1], cell_info0);
+  }
+
+  if (M)
+  {
+    for (int i : M->integral_ids(IntegralType::cell))
+    {
+      cell_fns[2][i]
+          = [&, kernel = M->kernel(IntegralType::cell, i),
+             cstride = coefficients[2].at({IntegralType::cell, i}).second,
+             cells = M->domain(IntegralType::cell, i)](
+                std::size_t k0, std::size_t k1, std::span<const T> c)
+      {
+        value += impl::assemble_cells(x_dofmap, x, cells.subspan(k0, k1 - k0),
+                                      kernel, constants[2], c, cstride);
+      };
+    }
+
+    value += assemble_scalar_facets(*M, x_dofmap, x, constants[2],
+                                    coefficients[2]);
+  }
+
+  // Cell integral domain ids of all forms
+  std::vector<int> ids;
+  for (auto& fns : cell_fns)
+    for (auto& [i, fn] : fns)
+      ids.push_back(i);
+  std::ranges::sort(ids);
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  for (int i : ids)
+  {
+    // Forms with a cell integral with id i
+    std::vector<std::size_t> group;
+    for (std::size_t k = 0; k < forms.size(); ++k)
+    {
+      if (cell_fns[k].contains(i))
+        group.push_back(k);
+    }
+
+    std::span<const std::int32_t> cells
+        = forms[group.front()]->domain(IntegralType::cell, i);
+    bool fused = std::ranges::all_of(
+        group, [&](auto k)
+        { return std::ranges::equal(forms[k]->domain(IntegralType::cell, i),
+                                    cells); });
+    if (!fused or group.size() == 1)
+    {
+      for (std::size_t k : group)
+      {
+        auto& [coeffs, cstride] = coefficients[k].at({IntegralType::cell, i});
+        for_each_cell_block(*forms[k], i, coeffs, cstride, cell_fns[k][i]);
+      }
+      continue;
+    }
+
+    // Packers and buffers for coefficients that are packed by block
+    std::array<std::optional<CellCoefficientPacker<T, U>>, 3> packers;
+    std::array<std::vector<T>, 3> buffers;
+    for (std::size_t k : group)
+    {
+      auto& [coeffs, cstride] = coefficients[k].at({IntegralType::cell, i});
+      if (pack_cells_deferred(coeffs, cstride, cells.size()))
+      {
+        packers[k].emplace(*forms[k], i);
+        buffers[k].resize(std::min(block_size, cells.size()) * cstride);
+      }
+    }
+
+    // Execute the kernels of all forms block-by-block
+    for (std::size_t k0 = 0; k0 < cells.size(); k0 += block_size)
+    {
+      const std::size_t k1 = std::min(k0 + block_size, cells.size());
+      for (std::size_t k : group)
+      {
+        auto& [coeffs, cstride] = coefficients[k].at({IntegralType::cell, i});
+        std::span<const T> c;
+        if (packers[k])
+        {
+          std::span<T> _c = std::span(buffers[k]).first((k1 - k0) * cstride);
+          (*packers[k])(k0, k1, _c);
+          c = _c;
+        }
+        else
+          c = coeffs.subspan(k0 * cstride, (k1 - k0) * cstride);
+        cell_fns[k][i](k0, k1, c);
+      }
+    }
+  }
+
+  return value;
+}
+} // namespace dolfinx::fem::impl
@@ -12,13 +12,25 @@
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
+#include <dolfinx/common/Arena.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/coloring.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <tuple>
 #include <vector>
 
@@ -57,10 +69,22 @@ using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
 /// mesh
 /// @param cell_info1 The cell permutation information for the trial function
 /// mesh
-template <dolfinx::scalar T>
+/// @param positions Positions in `cells` of the cells to execute the
+/// kernel over. If empty, the kernel is executed over all cells.
+/// @tparam ND Number of dofs per cell of the test and trial spaces,
+/// if known at compile time (-1 otherwise).
+/// @tparam BS Block size of the test and trial dofmaps, if known at
+/// compile time (-1 otherwise).
+/// @tparam NX Number of geometry dofs per cell, if known at compile
+/// time (-1 otherwise).
+/// @note If `ND`, `BS` and `NX` are all set, the element tensor and
+/// coordinate buffers are arrays with a size known at compile time, and
+/// the loops over the dofs have fixed trip counts. The test and trial
+/// spaces must then have the same number of dofs and block size.
+template <dolfinx::scalar T, int ND = -1, int BS = -1, int NX = -1>
 void assemble_cells(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
     std::span<const std::int32_t> cells,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -69,28 +93,50 @@ void assemble_cells(
     std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
     std::span<const T> coeffs, int cstride, std::span<const T> constants,
     std::span<const std::uint32_t> cell_info0,
-    std::span<const std::uint32_t> cell_info1)
+    std::span<const std::uint32_t> cell_info1,
+    std::span<const std::int32_t> positions = {})
 {
   if (cells.empty())
     return;
 
-  const auto [dmap0, bs0, cells0] = dofmap0;
-  const auto [dmap1, bs1, cells1] = dofmap1;
+  const auto [dmap0, _bs0, cells0] = dofmap0;
+  const auto [dmap1, _bs1, cells1] = dofmap1;
 
-  // Iterate over active cells
-  const int num_dofs0 = dmap0.extent(1);
-  const int num_dofs1 = dmap1.extent(1);
+  // Dimensions, which are constants if the element is fixed
+  constexpr bool fixed = ND > 0 and BS > 0 and NX > 0;
+  const int num_dofs0 = fixed ? ND : static_cast<int>(dmap0.extent(1));
+  const int num_dofs1 = fixed ? ND : static_cast<int>(dmap1.extent(1));
+  const int bs0 = fixed ? BS : _bs0;
+  const int bs1 = fixed ? BS : _bs1;
+  const int num_xdofs = fixed ? NX : static_cast<int>(x_dofmap.extent(1));
+  assert(num_dofs0 == (int)dmap0.extent(1) and bs0 == _bs0);
+  assert(num_dofs1 == (int)dmap1.extent(1) and bs1 == _bs1);
+  assert(num_xdofs == (int)x_dofmap.extent(1));
   const int ndim0 = bs0 * num_dofs0;
   const int ndim1 = bs1 * num_dofs1;
-  std::vector<T> Ae(ndim0 * ndim1);
-  std::span<T> _Ae(Ae);
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+
+  // Element buffers, on the stack for a fixed element
+  using X = scalar_value_type_t<T>;
+  std::array<T, fixed ? ND * BS * ND * BS : 0> Ae_fixed;
+  std::array<X, fixed ? 3 * NX : 0> cdofs_fixed;
+  std::pmr::vector<T> Ae_dynamic(fixed ? 0 : ndim0 * ndim1,
+                                 common::scratch_resource());
+  std::pmr::vector<X> cdofs_dynamic(fixed ? 0 : 3 * num_xdofs,
+                                    common::scratch_resource());
+  std::span<T> Ae(fixed ? Ae_fixed.data() : Ae_dynamic.data(),
+                  ndim0 * ndim1);
+  std::span<X> coordinate_dofs(
+      fixed ? cdofs_fixed.data() : cdofs_dynamic.data(), 3 * num_xdofs);
 
   // Iterate over active cells
   assert(cells0.size() == cells.size());
   assert(cells1.size() == cells.size());
-  for (std::size_t index = 0; index < cells.size(); ++index)
+  const std::size_t num_cells
+      = positions.empty() ? cells.size() : positions.size();
+  for (std::size_t k = 0; k < num_cells; ++k)
   {
+    const std::size_t index = positions.empty() ? k : positions[k];
+
     // Cell index in integration domain mesh (c), test function mesh
     // (c0) and trial function mesh (c1)
     std::int32_t c = cells[index];
@@ -98,13 +144,8 @@ void assemble_cells(
     std::int32_t c1 = cells1[index];
 
     // Get cell coordinates/geometry
-    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    const std::int32_t* x_dofs = x_dofmap.data_handle() + c * num_xdofs;
+    x.copy(std::span(x_dofs, num_xdofs), coordinate_dofs.data());
 
     // Tabulate tensor
     std::ranges::fill(Ae, 0);
@@ -112,8 +153,8 @@ void assemble_cells(
            coordinate_dofs.data(), nullptr, nullptr);
 
     // Compute A = P_0 \tilde{A} P_1^T (dof transformation)
-    P0(_Ae, cell_info0, c0, ndim1);  // B = P0 \tilde{A}
-    P1T(_Ae, cell_info1, c1, ndim0); // A =  B P1_T
+    P0(Ae, cell_info0, c0, ndim1);  // B = P0 \tilde{A}
+    P1T(Ae, cell_info1, c1, ndim0); // A =  B P1_T
 
     // Zero rows/columns for essential bcs
     auto dofs0 = std::span(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
@@ -156,6 +197,230 @@ void assemble_cells(
   }
 }
 
+/// @brief Number of dofs per cell, dofmap block size and number of
+/// geometry dofs per cell of an element for which assemble_cells is
+/// compiled with fixed dimensions.
+template <int ND, int BS, int NX>
+struct FixedCellDims
+{
+};
+
+/// Elements for which assemble_cells is compiled with fixed dimensions:
+/// scalar and vector P1 and P2 on affine triangles and tetrahedra, and
+/// Q1 and scalar Q2 on trilinear hexahedra.
+using fixed_cell_dims_t
+    = std::tuple<FixedCellDims<3, 1, 3>, FixedCellDims<3, 2, 3>,
+                 FixedCellDims<6, 1, 3>, FixedCellDims<6, 2, 3>,
+                 FixedCellDims<4, 1, 4>, FixedCellDims<4, 3, 4>,
+                 FixedCellDims<10, 1, 4>, FixedCellDims<10, 3, 4>,
+                 FixedCellDims<8, 1, 8>, FixedCellDims<8, 3, 8>,
+                 FixedCellDims<27, 1, 8>>;
+
+/// @brief Execute kernel over cells and accumulate result in matrix,
+/// using a version of assemble_cells with fixed dimensions if the
+/// element is in fixed_cell_dims_t.
+///
+/// The arguments are the same as for assemble_cells.
+template <dolfinx::scalar T>
+void assemble_cells_dispatch(
+    la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernel<T> auto kernel,
+    std::span<const T> coeffs, int cstride, std::span<const T> constants,
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1,
+    std::span<const std::int32_t> positions = {})
+{
+  const int num_dofs = std::get<0>(dofmap0).extent(1);
+  const int bs = std::get<1>(dofmap0);
+  const int num_xdofs = x_dofmap.extent(1);
+  const bool same_layout = num_dofs == (int)std::get<0>(dofmap1).extent(1)
+                           and bs == std::get<1>(dofmap1);
+
+  auto assemble = [&]<int ND, int BS, int NX>(FixedCellDims<ND, BS, NX>)
+  {
+    assemble_cells<T, ND, BS, NX>(mat_set, x_dofmap, x, cells, dofmap0, P0,
+                                  dofmap1, P1T, bc0, bc1, kernel, coeffs,
+                                  cstride, constants, cell_info0, cell_info1,
+                                  positions);
+  };
+
+  auto match = [&]<int ND, int BS, int NX>(FixedCellDims<ND, BS, NX> dims)
+  {
+    if (!same_layout or num_dofs != ND or bs != BS or num_xdofs != NX)
+      return false;
+    assemble(dims);
+    return true;
+  };
+
+  bool fixed = std::apply([&](auto... dims) { return (match(dims) or ...); },
+                          fixed_cell_dims_t{});
+  if (!fixed)
+    assemble(FixedCellDims<-1, -1, -1>{});
+}
+
+/// @brief Execute a batched kernel over cells and accumulate result in
+/// matrix.
+///
+/// Geometry and coefficient data for `N` cells at a time are gathered
+/// into structure-of-arrays buffers and the kernel is called once per
+/// batch (see fem::FEkernelBatched for the data layout). If the number
+/// of cells is not a multiple of `N`, the last batch is padded with
+/// copies of its final cell and the element tensors of the padding
+/// cells are discarded.
+///
+/// @tparam T Matrix/form scalar type.
+/// @tparam N Number of cells in a batch.
+/// @param mat_set Function that accumulates computed entries into a
+/// matrix.
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh) to execute
+/// the kernel over. These are the indices into the geometry dofmap.
+/// @param dofmap0 Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param P0 Function that applies transformation P_0 A in-place to
+/// transform test degrees-of-freedom.
+/// @param dofmap1 Trial function (column) degree-of-freedom data
+/// holding the (0) dofmap, (1) dofmap block size and (2) dofmap cell
+/// indices.
+/// @param P1T Function that applies transformation A P_1^T in-place to
+/// transform trial degrees-of-freedom.
+/// @param bc0 Marker for rows with Dirichlet boundary conditions applied
+/// @param bc1 Marker for columns with Dirichlet boundary conditions applied
+/// @param kernel Batched kernel function to execute over each batch of
+/// cells.
+/// @param coeffs The coefficient data array of shape (cells.size(), cstride),
+/// flattened into row-major format.
+/// @param cstride The coefficient stride
+/// @param constants The constant data
+/// @param cell_info0 The cell permutation information for the test function
+/// mesh
+/// @param cell_info1 The cell permutation information for the trial function
+/// mesh
+template <dolfinx::scalar T, int N>
+void assemble_cells_batched(
+    la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
+    fem::DofTransformKernel<T> auto P0,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap1,
+    fem::DofTransformKernel<T> auto P1T, std::span<const std::int8_t> bc0,
+    std::span<const std::int8_t> bc1, FEkernelBatched<T> auto kernel,
+    std::span<const T> coeffs, int cstride, std::span<const T> constants,
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1)
+{
+  static_assert(N > 0);
+  if (cells.empty())
+    return;
+
+  const auto [dmap0, bs0, cells0] = dofmap0;
+  const auto [dmap1, bs1, cells1] = dofmap1;
+
+  const int num_dofs0 = dmap0.extent(1);
+  const int num_dofs1 = dmap1.extent(1);
+  const int ndim0 = bs0 * num_dofs0;
+  const int ndim1 = bs1 * num_dofs1;
+  const std::size_t num_xdofs = x_dofmap.extent(1);
+
+  // Batch (structure-of-arrays) buffers
+  std::pmr::vector<T> A_batch(ndim0 * ndim1 * N, common::scratch_resource());
+  std::pmr::vector<T> coeffs_batch(cstride * N, common::scratch_resource());
+  std::pmr::vector<scalar_value_type_t<T>> x_batch(
+      3 * num_xdofs * N, common::scratch_resource());
+
+  // Element tensor for a single cell
+  std::pmr::vector<T> Ae(ndim0 * ndim1, common::scratch_resource());
+  std::span<T> _Ae(Ae);
+
+  assert(cells0.size() == cells.size());
+  assert(cells1.size() == cells.size());
+  for (std::size_t index0 = 0; index0 < cells.size(); index0 += N)
+  {
+    const int num_cells = std::min<std::size_t>(N, cells.size() - index0);
+
+    // Pack geometry and coefficients for the batch. Padding cells
+    // repeat the last cell of the batch.
+    for (int b = 0; b < N; ++b)
+    {
+      const std::size_t index = index0 + std::min(b, num_cells - 1);
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[index], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+        for (int d = 0; d < 3; ++d)
+          x_batch[(3 * i + d) * N + b] = x(x_dofs[i], d);
+      for (int k = 0; k < cstride; ++k)
+        coeffs_batch[k * N + b] = coeffs[index * cstride + k];
+    }
+
+    // Tabulate tensors for the batch
+    std::ranges::fill(A_batch, 0);
+    kernel(A_batch.data(), coeffs_batch.data(), constants.data(),
+           x_batch.data());
+
+    for (int b = 0; b < num_cells; ++b)
+    {
+      const std::size_t index = index0 + b;
+      std::int32_t c0 = cells0[index];
+      std::int32_t c1 = cells1[index];
+
+      // Unpack element tensor for cell
+      for (std::size_t k = 0; k < Ae.size(); ++k)
+        Ae[k] = A_batch[k * N + b];
+
+      // Compute A = P_0 \tilde{A} P_1^T (dof transformation)
+      P0(_Ae, cell_info0, c0, ndim1);  // B = P0 \tilde{A}
+      P1T(_Ae, cell_info1, c1, ndim0); // A =  B P1_T
+
+      // Zero rows/columns for essential bcs
+      auto dofs0 = std::span(dmap0.data_handle() + c0 * num_dofs0, num_dofs0);
+      auto dofs1 = std::span(dmap1.data_handle() + c1 * num_dofs1, num_dofs1);
+
+      if (!bc0.empty())
+      {
+        for (int i = 0; i < num_dofs0; ++i)
+        {
+          for (int k = 0; k < bs0; ++k)
+          {
+            if (bc0[bs0 * dofs0[i] + k])
+            {
+              // Zero row bs0 * i + k
+              const int row = bs0 * i + k;
+              std::fill_n(std::next(Ae.begin(), ndim1 * row), ndim1, 0);
+            }
+          }
+        }
+      }
+
+      if (!bc1.empty())
+      {
+        for (int j = 0; j < num_dofs1; ++j)
+        {
+          for (int k = 0; k < bs1; ++k)
+          {
+            if (bc1[bs1 * dofs1[j] + k])
+            {
+              // Zero column bs1 * j + k
+              const int col = bs1 * j + k;
+              for (int row = 0; row < ndim0; ++row)
+                Ae[row * ndim1 + col] = 0;
+            }
+          }
+        }
+      }
+
+      mat_set(dofs0, dofs1, Ae);
+    }
+  }
+}
+
 /// @brief Execute kernel over exterior facets and accumulate result in
 /// a matrix.
 /// @tparam T Matrix/form scalar type.
@@ -191,10 +456,13 @@ void assemble_cells(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
+/// @param[in] positions Positions of the facets to execute the kernel
+/// over, i.e. position `p` refers to `facets[2 * p]` and `facets[2 * p
+/// + 1]`. If empty, the kernel is executed over all facets.
 template <dolfinx::scalar T>
 void assemble_exterior_facets(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -204,27 +472,37 @@ void assemble_exterior_facets(
     std::span<const T> coeffs, int cstride, std::span<const T> constants,
     std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1,
-    std::span<const std::uint8_t> perms)
+    std::span<const std::uint8_t> perms,
+    std::span<const std::int32_t> positions = {},
+    std::span<const std::int32_t> macro_dofs0 = {},
+    std::span<const std::int32_t> macro_dofs1 = {})
 {
   if (facets.empty())
     return;
 
   const auto [dmap0, bs0, facets0] = dofmap0;
   const auto [dmap1, bs1, facets1] = dofmap1;
+  assert(macro_dofs0.empty() or 2 * macro_dofs0.size() % facets.size() == 0);
+  assert(macro_dofs1.empty() or 2 * macro_dofs1.size() % facets.size() == 0);
 
   // Data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
   const int num_dofs0 = dmap0.extent(1);
   const int num_dofs1 = dmap1.extent(1);
   const int ndim0 = bs0 * num_dofs0;
   const int ndim1 = bs1 * num_dofs1;
-  std::vector<T> Ae(ndim0 * ndim1);
+  std::pmr::vector<T> Ae(ndim0 * ndim1, common::scratch_resource());
   std::span<T> _Ae(Ae);
   assert(facets.size() % 2 == 0);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
-  for (std::size_t index = 0; index < facets.size(); index += 2)
+  const std::size_t num_facets
+      = positions.empty() ? facets.size() / 2 : positions.size();
+  for (std::size_t k = 0; k < num_facets; ++k)
   {
+    const std::size_t index = 2 * (positions.empty() ? k : positions[k]);
+
     // Cell in the integration domain, local facet index relative to the
     // integration domain cell, and cells in the test and trial function
     // meshes
@@ -236,11 +514,7 @@ void assemble_exterior_facets(
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     // Permutations
     std::uint8_t perm
@@ -330,10 +604,18 @@ void assemble_exterior_facets(
 /// function mesh.
 /// @param[in] perms Facet permutation integer. Empty if facet
 /// permutations are not required.
+/// @param[in] positions Positions of the facets to execute the kernel
+/// over, i.e. position `p` refers to `facets[4 * p]` to `facets[4 * p
+/// + 3]`. If empty, the kernel is executed over all facets.
+/// @param[in] macro_dofs0 Macro-element test function dofmap of the
+/// facets (see Form::macro_dofmap). If empty, the dofs of the two cells
+/// of each facet are concatenated during assembly.
+/// @param[in] macro_dofs1 Macro-element trial function dofmap of the
+/// facets.
 template <dolfinx::scalar T>
 void assemble_interior_facets(
     la::MatSet<T> auto mat_set, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<const DofMap&, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -343,32 +625,74 @@ void assemble_interior_facets(
     std::span<const T> coeffs, int cstride, std::span<const int> offsets,
     std::span<const T> constants, std::span<const std::uint32_t> cell_info0,
     std::span<const std::uint32_t> cell_info1,
-    std::span<const std::uint8_t> perms)
+    std::span<const std::uint8_t> perms,
+    std::span<const std::int32_t> positions = {},
+    std::span<const std::int32_t> macro_dofs0 = {},
+    std::span<const std::int32_t> macro_dofs1 = {})
 {
   if (facets.empty())
     return;
 
   const auto [dmap0, bs0, facets0] = dofmap0;
   const auto [dmap1, bs1, facets1] = dofmap1;
+  assert(macro_dofs0.empty() or 2 * macro_dofs0.size() % facets.size() == 0);
+  assert(macro_dofs1.empty() or 2 * macro_dofs1.size() % facets.size() == 0);
 
   // Data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  std::pmr::vector<X> coordinate_dofs(
+      2 * x_dofmap.extent(1) * 3, common::scratch_resource());
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
 
-  std::vector<T> Ae, be;
-  std::vector<T> coeff_array(2 * offsets.back());
+  std::pmr::vector<T> Ae(common::scratch_resource());
+  std::pmr::vector<T> be(common::scratch_resource());
+  std::pmr::vector<T> coeff_array(
+      2 * offsets.back(), common::scratch_resource());
   assert(offsets.back() == cstride);
 
-  // Temporaries for joint dofmaps
-  std::vector<std::int32_t> dmapjoint0, dmapjoint1;
+  // Temporaries for joint dofmaps, if the macro-element dofmaps are not
+  // given
+  std::vector<std::int32_t> _dmapjoint0, _dmapjoint1;
+  auto joint_dofs = [](std::span<const std::int32_t> macro_dofs,
+                       std::size_t f, std::span<const std::int32_t> dofs0,
+                       std::span<const std::int32_t> dofs1,
+                       std::vector<std::int32_t>& joint)
+  {
+    const std::size_t n = dofs0.size() + dofs1.size();
+    if (!macro_dofs.empty())
+      return macro_dofs.subspan(f * n, n);
+    joint.resize(n);
+    std::ranges::copy(dofs0, joint.begin());
+    std::ranges::copy(dofs1, std::next(joint.begin(), dofs0.size()));
+    return std::span<const std::int32_t>(joint);
+  };
+
+  // Copy the geometry of a cell, unless it is the cell of the previous
+  // copy
+  auto copy_geometry = [&](std::int32_t c, std::int32_t& c_prev,
+                           std::span<X> cdofs)
+  {
+    if (c == c_prev)
+      return;
+    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    x.copy(x_dofs, cdofs.data());
+    c_prev = c;
+  };
+
   assert(facets.size() % 4 == 0);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
-  for (std::size_t index = 0; index < facets.size(); index += 4)
+  const std::size_t num_facets
+      = positions.empty() ? facets.size() / 4 : positions.size();
+  std::array<std::int32_t, 2> cells_prev = {-1, -1};
+  for (std::size_t k = 0; k < num_facets; ++k)
   {
+    const std::size_t f = positions.empty() ? k : positions[k];
+    const std::size_t index = 4 * f;
+
     // Cells in integration domain,  test function domain and trial
     // function domain
     std::array cells{facets[index], facets[index + 2]};
@@ -378,36 +702,21 @@ void assemble_interior_facets(
     // Local facets indices
     std::array local_facet{facets[index + 1], facets[index + 3]};
 
-    // Get cell geometry
-    auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
-    }
-    auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
-    }
+    // Get cell geometry. Facets are often ordered by cell, in which
+    // case the geometry of a cell is reused.
+    copy_geometry(cells[0], cells_prev[0], cdofs0);
+    copy_geometry(cells[1], cells_prev[1], cdofs1);
 
     // Get dof maps for cells and pack
     std::span<const std::int32_t> dmap0_cell0 = dmap0.cell_dofs(cells0[0]);
     std::span<const std::int32_t> dmap0_cell1 = dmap0.cell_dofs(cells0[1]);
-    dmapjoint0.resize(dmap0_cell0.size() + dmap0_cell1.size());
-    std::ranges::copy(dmap0_cell0, dmapjoint0.begin());
-    std::ranges::copy(dmap0_cell1,
-                      std::next(dmapjoint0.begin(), dmap0_cell0.size()));
+    std::span<const std::int32_t> dmapjoint0 = joint_dofs(
+        macro_dofs0, f, dmap0_cell0, dmap0_cell1, _dmapjoint0);
 
     std::span<const std::int32_t> dmap1_cell0 = dmap1.cell_dofs(cells1[0]);
     std::span<const std::int32_t> dmap1_cell1 = dmap1.cell_dofs(cells1[1]);
-    dmapjoint1.resize(dmap1_cell0.size() + dmap1_cell1.size());
-    std::ranges::copy(dmap1_cell0, dmapjoint1.begin());
-    std::ranges::copy(dmap1_cell1,
-                      std::next(dmapjoint1.begin(), dmap1_cell0.size()));
+    std::span<const std::int32_t> dmapjoint1 = joint_dofs(
+        macro_dofs1, f, dmap1_cell0, dmap1_cell1, _dmapjoint1);
 
     const int num_rows = bs0 * dmapjoint0.size();
     const int num_cols = bs1 * dmapjoint1.size();
@@ -485,22 +794,220 @@ void assemble_interior_facets(
   }
 }
 
+/// @brief Colour integration entities such that no two entities with
+/// the same colour share a test function (row) degree-of-freedom.
+///
+/// Entities of the same colour add to disjoint matrix rows, and can
+/// therefore be assembled concurrently without locking.
+///
+/// @param[in] dofmap0 Test function dofmap.
+/// @param[in] entities0 Integration entity data in the test function
+/// mesh with `stride` values per entity, i.e. `(cell)` for cells,
+/// `(cell, local_facet)` for exterior facets and `(cell0, local_facet0,
+/// cell1, local_facet1)` for interior facets.
+/// @param[in] stride Number of values per entity in `entities0`.
+/// @param[in] num_cells Number of cells attached to each entity. The
+/// values per entity are split evenly between the cells, with the cell
+/// index first.
+/// @return Entity positions (links) for each colour (node).
+inline graph::AdjacencyList<std::int32_t>
+color_entities(mdspan2_t dofmap0, std::span<const std::int32_t> entities0,
+               int stride, int num_cells)
+{
+  assert(entities0.size() % stride == 0);
+  const std::size_t num_entities = entities0.size() / stride;
+  const std::size_t num_dofs = dofmap0.extent(1);
+  const int cell_stride = stride / num_cells;
+
+  // Row dofs for each entity. Entities that are not attached to a cell
+  // in the test function mesh are padded with the dofs of the first
+  // cell.
+  std::vector<std::int32_t> dofs;
+  dofs.reserve(num_entities * num_cells * num_dofs);
+  for (std::size_t e = 0; e < num_entities; ++e)
+  {
+    for (int j = 0; j < num_cells; ++j)
+    {
+      std::int32_t c = entities0[e * stride + j * cell_stride];
+      if (c < 0)
+        c = entities0[e * stride];
+      assert(c >= 0);
+      auto cell_dofs
+          = std::span(dofmap0.data_handle() + c * num_dofs, num_dofs);
+      dofs.insert(dofs.end(), cell_dofs.begin(), cell_dofs.end());
+    }
+  }
+
+  return graph::color_classes(
+      graph::compute_shared_link_coloring(graph::regular_adjacency_list(
+          std::move(dofs), num_cells * num_dofs)));
+}
+
+/// @brief Execute a function concurrently over the entities of each
+/// colour.
+///
+/// Colours are processed in turn. The entity positions of a colour are
+/// split into `num_threads` contiguous blocks and `fn` is called on each
+/// non-empty block as a task on the process thread pool (see
+/// common::thread_pool). An exception thrown by `fn` is re-thrown on
+/// the calling thread once all tasks for the colour have completed.
+///
+/// @param[in] colors Entity positions (links) for each colour (node).
+/// @param[in] num_threads Number of blocks per colour.
+/// @param[in] fn Function called with a block of entity positions.
+template <typename F>
+void parallel_for_colors(const graph::AdjacencyList<std::int32_t>& colors,
+                         int num_threads, F fn)
+{
+  assert(num_threads > 0);
+  for (std::int32_t c = 0; c < colors.num_nodes(); ++c)
+  {
+    std::span<const std::int32_t> positions = colors.links(c);
+    common::thread_pool().run(
+        num_threads,
+        [&fn, positions, num_threads](int t)
+        {
+          auto [p0, p1]
+              = dolfinx::MPI::local_range(t, positions.size(), num_threads);
+          if (p1 > p0)
+            fn(positions.subspan(p0, p1 - p0));
+        });
+  }
+}
+
+/// @brief Assemble the exterior and interior facet integrals of a
+/// bilinear form into a matrix.
+///
+/// See impl::assemble_matrix for a description of the arguments.
+/// @param[in] P0 Function that applies the transformation to the test
+/// degrees-of-freedom.
+/// @param[in] P1T Function that applies the transpose transformation to
+/// the trial degrees-of-freedom.
+/// @param[in] cell_info0 The cell permutation information for the test
+/// function mesh.
+/// @param[in] cell_info1 The cell permutation information for the trial
+/// function mesh.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_facets(
+    la::MatSet<T> auto mat_set, const Form<T, U>& a, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    fem::DofTransformKernel<T> auto P0, fem::DofTransformKernel<T> auto P1T,
+    std::span<const std::uint32_t> cell_info0,
+    std::span<const std::uint32_t> cell_info1, int num_threads)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh1);
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  auto dofs1 = dofmap1->map();
+  const int bs1 = dofmap1->bs();
+
+  std::span<const std::uint8_t> perms;
+  if (a.needs_facet_permutations())
+  {
+    mesh->topology_mutable()->create_facet_permutations();
+    perms = std::span(mesh->topology()->get_facet_permutations());
+  }
+
+  mesh::CellType cell_type = mesh->topology()->cell_type();
+  int num_facets_per_cell
+      = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
+  for (int i : a.integral_ids(IntegralType::exterior_facet))
+  {
+    auto fn = a.kernel(IntegralType::exterior_facet, i);
+    assert(fn);
+    auto& [coeffs, cstride]
+        = coefficients.at({IntegralType::exterior_facet, i});
+    std::span<const std::int32_t> facets0
+        = a.domain(IntegralType::exterior_facet, i, *mesh0);
+    std::span<const std::int32_t> facets1
+        = a.domain(IntegralType::exterior_facet, i, *mesh1);
+    auto assemble = [&](std::span<const std::int32_t> positions)
+    {
+      impl::assemble_exterior_facets(
+          mat_set, x_dofmap, x, num_facets_per_cell,
+          a.domain(IntegralType::exterior_facet, i), {dofs0, bs0, facets0}, P0,
+          {dofs1, bs1, facets1}, P1T, bc0, bc1, fn, coeffs, cstride,
+          constants, cell_info0, cell_info1, perms, positions);
+    };
+
+    if (num_threads > 1)
+    {
+      parallel_for_colors(color_entities(dofs0, facets0, 2, 1), num_threads,
+                          assemble);
+    }
+    else
+      assemble({});
+  }
+
+  for (int i : a.integral_ids(IntegralType::interior_facet))
+  {
+    const std::vector<int> c_offsets = a.coefficient_offsets();
+    auto fn = a.kernel(IntegralType::interior_facet, i);
+    assert(fn);
+    auto& [coeffs, cstride]
+        = coefficients.at({IntegralType::interior_facet, i});
+    std::span<const std::int32_t> facets0
+        = a.domain(IntegralType::interior_facet, i, *mesh0);
+    std::span<const std::int32_t> facets1
+        = a.domain(IntegralType::interior_facet, i, *mesh1);
+    auto assemble = [&](std::span<const std::int32_t> positions)
+    {
+      impl::assemble_interior_facets(
+          mat_set, x_dofmap, x, num_facets_per_cell,
+          a.domain(IntegralType::interior_facet, i), {*dofmap0, bs0, facets0},
+          P0, {*dofmap1, bs1, facets1}, P1T, bc0, bc1, fn, coeffs, cstride,
+          c_offsets, constants, cell_info0, cell_info1, perms, positions,
+          a.macro_dofmap(i, 0), a.macro_dofmap(i, 1));
+    };
+
+    if (num_threads > 1)
+    {
+      parallel_for_colors(color_entities(dofs0, facets0, 4, 2), num_threads,
+                          assemble);
+    }
+    else
+      assemble({});
+  }
+}
+
 /// The matrix A must already be initialised. The matrix may be a proxy,
 /// i.e. a view into a larger matrix, and assembly is performed using
 /// local indices. Rows (bc0) and columns (bc1) with Dirichlet
 /// conditions are zeroed. Markers (bc0 and bc1) can be empty if no bcs
 /// are applied. Matrix is not finalised.
+///
+/// If `num_threads > 1`, the integration entities of each integral are
+/// coloured such that entities of the same colour do not share a row,
+/// and the entities of each colour are assembled concurrently. In this
+/// case `mat_set` must be safe to call concurrently for disjoint sets of
+/// rows, which is the case for la::MatrixCSR but is not in general
+/// the case for other matrix backends, e.g. PETSc.
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     la::MatSet<T> auto mat_set, const Form<T, U>& a, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, std::span<const T> constants,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
-    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    int num_threads = 1)
 {
-  // Integration domain mesh
-  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
-  assert(mesh);
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
 
   // Test function mesh
   auto mesh0 = a.function_spaces().at(0)->mesh();
@@ -548,52 +1055,212 @@ void assemble_matrix(
     auto fn = a.kernel(IntegralType::cell, i);
     assert(fn);
     auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
-    impl::assemble_cells(
-        mat_set, x_dofmap, x, a.domain(IntegralType::cell, i),
-        {dofs0, bs0, a.domain(IntegralType::cell, i, *mesh0)}, P0,
-        {dofs1, bs1, a.domain(IntegralType::cell, i, *mesh1)}, P1T, bc0, bc1,
-        fn, coeffs, cstride, constants, cell_info0, cell_info1);
+    std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+    std::span<const std::int32_t> cells0
+        = a.domain(IntegralType::cell, i, *mesh0);
+    std::span<const std::int32_t> cells1
+        = a.domain(IntegralType::cell, i, *mesh1);
+    if (num_threads > 1)
+    {
+      // The coloured cells are not contiguous, so coefficients that are
+      // not packed are packed for all cells
+      std::vector<T> _coeffs;
+      std::span<const T> c = coeffs;
+      if (pack_cells_deferred(coeffs, cstride, cells.size()))
+      {
+        CellCoefficientPacker<T, U> pack(a, i);
+        _coeffs.resize(cells.size() * cstride);
+        pack(0, cells.size(), _coeffs);
+        c = _coeffs;
+      }
+
+      parallel_for_colors(
+          color_entities(dofs0, cells0, 1, 1), num_threads,
+          [&](std::span<const std::int32_t> positions)
+          {
+            impl::assemble_cells_dispatch(
+                mat_set, x_dofmap, x, cells, {dofs0, bs0, cells0}, P0,
+                {dofs1, bs1, cells1}, P1T, bc0, bc1, fn, c, cstride,
+                constants, cell_info0, cell_info1, positions);
+          });
+    }
+    else
+    {
+      for_each_cell_block(
+          a, i, coeffs, cstride,
+          [&](std::size_t k0, std::size_t k1, std::span<const T> c)
+          {
+            std::size_t n = k1 - k0;
+            impl::assemble_cells_dispatch(
+                mat_set, x_dofmap, x, cells.subspan(k0, n),
+                {dofs0, bs0, cells0.subspan(k0, n)}, P0,
+                {dofs1, bs1, cells1.subspan(k0, n)}, P1T, bc0, bc1,
+                fn, c, cstride, constants, cell_info0, cell_info1, {});
+          });
+    }
   }
 
-  std::span<const std::uint8_t> perms;
-  if (a.needs_facet_permutations())
+  assemble_matrix_facets(mat_set, a, x_dofmap, x, constants, coefficients,
+                         bc0, bc1, P0, P1T, cell_info0, cell_info1,
+                         num_threads);
+}
+
+/// @brief Assemble the owned rows of the cell integrals of a bilinear
+/// form into a matrix, computing the element matrices of the ghost
+/// cells locally (owner-computes assembly).
+///
+/// The element matrices of the owned cells use the packed
+/// `coefficients`, and the coefficients of the ghost cells are packed
+/// by this function. Only the rows of an element matrix that are owned
+/// by this process are passed to `mat_set`.
+///
+/// See impl::assemble_matrix for a description of the arguments.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_owned(
+    la::MatSet<T> auto mat_set, const Form<T, U>& a, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  for (auto& V : a.function_spaces())
   {
-    mesh->topology_mutable()->create_entity_permutations();
-    perms = std::span(mesh->topology()->get_facet_permutations());
+    if (V->mesh() != mesh)
+    {
+      throw std::runtime_error("Owner-computes assembly requires the "
+                               "arguments to be defined on the form mesh.");
+    }
   }
 
-  mesh::CellType cell_type = mesh->topology()->cell_type();
-  int num_facets_per_cell
-      = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
-  for (int i : a.integral_ids(IntegralType::exterior_facet))
+  for (IntegralType type : a.integral_types())
   {
-    auto fn = a.kernel(IntegralType::exterior_facet, i);
-    assert(fn);
-    auto& [coeffs, cstride]
-        = coefficients.at({IntegralType::exterior_facet, i});
-    impl::assemble_exterior_facets(
-        mat_set, x_dofmap, x, num_facets_per_cell,
-        a.domain(IntegralType::exterior_facet, i),
-        {dofs0, bs0, a.domain(IntegralType::exterior_facet, i, *mesh0)}, P0,
-        {dofs1, bs1, a.domain(IntegralType::exterior_facet, i, *mesh1)}, P1T,
-        bc0, bc1, fn, coeffs, cstride, constants, cell_info0, cell_info1,
-        perms);
+    if (type != IntegralType::cell)
+    {
+      throw std::runtime_error(
+          "Owner-computes assembly supports cell integrals only.");
+    }
   }
 
-  for (int i : a.integral_ids(IntegralType::interior_facet))
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  auto dofs1 = dofmap1->map();
+  const int bs1 = dofmap1->bs();
+
+  auto element0 = a.function_spaces().at(0)->element();
+  assert(element0);
+  auto element1 = a.function_spaces().at(1)->element();
+  assert(element1);
+  fem::DofTransformKernel<T> auto P0
+      = element0->template dof_transformation_fn<T>(doftransform::standard);
+  fem::DofTransformKernel<T> auto P1T
+      = element1->template dof_transformation_right_fn<T>(
+          doftransform::transpose);
+
+  std::span<const std::uint32_t> cell_info;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations() or a.needs_facet_permutations())
   {
-    const std::vector<int> c_offsets = a.coefficient_offsets();
-    auto fn = a.kernel(IntegralType::interior_facet, i);
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+  }
+
+  // Ghost cells, which are not in the default integration domain
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  std::vector<std::int32_t> ghosts(cell_map->num_ghosts());
+  std::iota(ghosts.begin(), ghosts.end(), cell_map->size_local());
+
+  // Pass only the owned rows of an element matrix to mat_set. The rows
+  // of the element matrix of a (block) row are contiguous.
+  const std::int32_t num_owned = dofmap0->index_map->size_local();
+  std::vector<std::int32_t> rows_owned;
+  std::vector<T> Ae_owned;
+  auto mat_set_owned
+      = [&](std::span<const std::int32_t> rows,
+            std::span<const std::int32_t> cols, std::span<const T> Ae)
+  {
+    if (std::ranges::all_of(rows, [num_owned](auto r)
+                            { return r < num_owned; }))
+    {
+      return mat_set(rows, cols, Ae);
+    }
+
+    const std::size_t stride = Ae.size() / rows.size();
+    rows_owned.clear();
+    Ae_owned.clear();
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      if (rows[i] < num_owned)
+      {
+        rows_owned.push_back(rows[i]);
+        auto it = std::next(Ae.begin(), i * stride);
+        Ae_owned.insert(Ae_owned.end(), it, std::next(it, stride));
+      }
+    }
+    return mat_set(std::span<const std::int32_t>(rows_owned), cols,
+                   std::span<const T>(Ae_owned));
+  };
+
+  const std::vector<int> offsets = a.coefficient_offsets();
+  const std::vector<std::int8_t> active
+      = active_coefficients(a, IntegralType::cell);
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    if (i != -1)
+    {
+      throw std::runtime_error("Owner-computes assembly supports the "
+                               "default cell integration domain only.");
+    }
+
+    auto fn = a.kernel(IntegralType::cell, i);
     assert(fn);
-    auto& [coeffs, cstride]
-        = coefficients.at({IntegralType::interior_facet, i});
-    impl::assemble_interior_facets(
-        mat_set, x_dofmap, x, num_facets_per_cell,
-        a.domain(IntegralType::interior_facet, i),
-        {*dofmap0, bs0, a.domain(IntegralType::interior_facet, i, *mesh0)}, P0,
-        {*dofmap1, bs1, a.domain(IntegralType::interior_facet, i, *mesh1)}, P1T,
-        bc0, bc1, fn, coeffs, cstride, c_offsets, constants, cell_info0,
-        cell_info1, perms);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+
+    // Owned cells
+    std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+    for_each_cell_block(
+        a, i, coeffs, cstride,
+        [&](std::size_t k0, std::size_t k1, std::span<const T> c)
+        {
+          std::span<const std::int32_t> cells_k = cells.subspan(k0, k1 - k0);
+          impl::assemble_cells_dispatch(
+              mat_set_owned, x_dofmap, x, cells_k, {dofs0, bs0, cells_k}, P0,
+              {dofs1, bs1, cells_k}, P1T, bc0, bc1, fn, c, cstride,
+              constants, cell_info, cell_info);
+        });
+
+    // Ghost cells
+    std::vector<T> c(ghosts.size() * cstride);
+    for (std::size_t k = 0; k < active.size(); ++k)
+    {
+      if (!active[k])
+        continue;
+      const Function<T, U>& u = *a.coefficients()[k];
+      if (u.function_space()->mesh() != mesh)
+      {
+        throw std::runtime_error("Owner-computes assembly requires the "
+                                 "coefficients to be defined on the form "
+                                 "mesh.");
+      }
+      pack_coefficient_entity(
+          std::span(c), cstride, u, get_cell_orientation_info(u), ghosts, 1,
+          [](auto entity) { return entity.front(); }, offsets[k]);
+    }
+    impl::assemble_cells_dispatch(
+        mat_set_owned, x_dofmap, x, ghosts, {dofs0, bs0, ghosts}, P0,
+        {dofs1, bs1, ghosts}, P1T, bc0, bc1, fn, std::span<const T>(c),
+        cstride, constants, cell_info, cell_info);
   }
 }
 
@@ -11,18 +11,29 @@
 #include "FunctionSpace.h"
 #include "utils.h"
 #include <algorithm>
+#include <cstdint>
+#include <dolfinx/common/Arena.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/load_metrics.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
+#include <functional>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::fem::impl
 {
 /// Assemble functional over cells
 template <dolfinx::scalar T>
-T assemble_cells(mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
+T assemble_cells(mdspan2_t x_dofmap,
+                 mesh::NodeCoordinates<scalar_value_type_t<T>> x,
                  std::span<const std::int32_t> cells, FEkernel<T> auto fn,
                  std::span<const T> constants, std::span<const T> coeffs,
                  int cstride)
@@ -32,7 +43,8 @@ T assemble_cells(mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
     return value;
 
   // Create data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
 
   // Iterate over all cells
   for (std::size_t index = 0; index < cells.size(); ++index)
@@ -42,11 +54,7 @@ T assemble_cells(mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     const T* coeff_cell = coeffs.data() + index * cstride;
     fn(&value, coeff_cell, constants.data(), coordinate_dofs.data(), nullptr,
@@ -59,7 +67,7 @@ T assemble_cells(mdspan2_t x_dofmap, std::span<const scalar_value_type_t<T>> x,
 /// Execute kernel over exterior facets and accumulate result
 template <dolfinx::scalar T>
 T assemble_exterior_facets(mdspan2_t x_dofmap,
-                           std::span<const scalar_value_type_t<T>> x,
+                           mesh::NodeCoordinates<scalar_value_type_t<T>> x,
                            int num_facets_per_cell,
                            std::span<const std::int32_t> facets,
                            FEkernel<T> auto fn, std::span<const T> constants,
@@ -71,7 +79,8 @@ T assemble_exterior_facets(mdspan2_t x_dofmap,
     return value;
 
   // Create data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
 
   // Iterate over all facets
   assert(facets.size() % 2 == 0);
@@ -83,11 +92,7 @@ T assemble_exterior_facets(mdspan2_t x_dofmap,
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     // Permutations
     std::uint8_t perm
@@ -103,7 +108,7 @@ T assemble_exterior_facets(mdspan2_t x_dofmap,
 /// Assemble functional over interior facets
 template <dolfinx::scalar T>
 T assemble_interior_facets(mdspan2_t x_dofmap,
-                           std::span<const scalar_value_type_t<T>> x,
+                           mesh::NodeCoordinates<scalar_value_type_t<T>> x,
                            int num_facets_per_cell,
                            std::span<const std::int32_t> facets,
                            FEkernel<T> auto fn, std::span<const T> constants,
@@ -117,12 +122,14 @@ T assemble_interior_facets(mdspan2_t x_dofmap,
 
   // Create data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  std::pmr::vector<X> coordinate_dofs(
+      2 * x_dofmap.extent(1) * 3, common::scratch_resource());
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
 
-  std::vector<T> coeff_array(2 * offsets.back());
+  std::pmr::vector<T> coeff_array(
+      2 * offsets.back(), common::scratch_resource());
   assert(offsets.back() == cstride);
 
   // Iterate over all facets
@@ -136,18 +143,10 @@ T assemble_interior_facets(mdspan2_t x_dofmap,
     // Get cell geometry
     auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
-    }
+    x.copy(x_dofs0, cdofs0.data());
     auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
-    }
+    x.copy(x_dofs1, cdofs1.data());
 
     std::array perm
         = perms.empty()
@@ -162,11 +161,12 @@ T assemble_interior_facets(mdspan2_t x_dofmap,
   return value;
 }
 
-/// Assemble functional into an scalar with provided mesh geometry.
+/// Assemble the exterior and interior facet integrals of a functional
 template <dolfinx::scalar T, std::floating_point U>
-T assemble_scalar(
+T assemble_scalar_facets(
     const fem::Form<T, U>& M, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, std::span<const T> constants,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients)
 {
@@ -174,20 +174,10 @@ T assemble_scalar(
   assert(mesh);
 
   T value = 0;
-  for (int i : M.integral_ids(IntegralType::cell))
-  {
-    auto fn = M.kernel(IntegralType::cell, i);
-    assert(fn);
-    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
-    std::span<const std::int32_t> cells = M.domain(IntegralType::cell, i);
-    value += impl::assemble_cells(x_dofmap, x, cells, fn, constants, coeffs,
-                                  cstride);
-  }
-
   std::span<const std::uint8_t> perms;
   if (M.needs_facet_permutations())
   {
-    mesh->topology_mutable()->create_entity_permutations();
+    mesh->topology_mutable()->create_facet_permutations();
     perms = std::span(mesh->topology()->get_facet_permutations());
   }
 
@@ -222,4 +212,260 @@ T assemble_scalar(
   return value;
 }
 
+/// Assemble functional into an scalar with provided mesh geometry.
+template <dolfinx::scalar T, std::floating_point U>
+T assemble_scalar(
+    const fem::Form<T, U>& M, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  T value = 0;
+  for (int i : M.integral_ids(IntegralType::cell))
+  {
+    auto fn = M.kernel(IntegralType::cell, i);
+    assert(fn);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    std::span<const std::int32_t> cells = M.domain(IntegralType::cell, i);
+    for_each_cell_block(
+        M, i, coeffs, cstride,
+        [&](std::size_t k0, std::size_t k1, std::span<const T> c)
+        {
+          value += impl::assemble_cells(x_dofmap, x, cells.subspan(k0, k1 - k0),
+                                        fn, constants, c, cstride);
+        });
+  }
+
+  value += assemble_scalar_facets(M, x_dofmap, x, constants, coefficients);
+  return value;
+}
+
+/// @brief Assemble several functionals with one traversal of each
+/// integration domain.
+///
+/// Cell and exterior facet integrals of the functionals with the same
+/// integration entities are grouped. The entities of a group are
+/// traversed once, in blocks of `block_size` entities, and for each
+/// entity the geometry is gathered once and the kernels of all
+/// integrals of the group are executed. Interior facet integrals are
+/// assembled functional by functional.
+///
+/// @param[in] M The functionals. They must have the same mesh.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants of each functional.
+/// @param[in] coefficients Packed coefficients of each functional. See
+/// for_each_cell_block for cell integral coefficients that are packed
+/// during assembly.
+/// @param[in] block_size Number of entities in a block.
+/// @return The contribution of the local process to each functional.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<T> assemble_scalars(
+    const std::vector<std::reference_wrapper<const Form<T, U>>>& M,
+    mdspan2_t x_dofmap, mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    const std::vector<std::span<const T>>& constants,
+    const std::vector<std::map<std::pair<IntegralType, int>,
+                               std::pair<std::span<const T>, int>>>&
+        coefficients,
+    std::size_t block_size)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  std::vector<T> values(M.size(), 0);
+  if (M.empty())
+    return values;
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = M.front().get().mesh();
+  assert(mesh);
+  if (!std::ranges::all_of(M, [&mesh](auto& form)
+                           { return form.get().mesh() == mesh; }))
+  {
+    throw std::runtime_error("Functionals must have the same mesh.");
+  }
+
+  // Integral (functional index, domain id)
+  using integral_t = std::pair<std::size_t, int>;
+
+  // Group the integrals of a type by integration entities
+  auto create_groups = [&M](IntegralType type)
+  {
+    std::vector<std::span<const std::int32_t>> domains;
+    std::vector<std::vector<integral_t>> groups;
+    for (std::size_t k = 0; k < M.size(); ++k)
+    {
+      for (int i : M[k].get().integral_ids(type))
+      {
+        std::span<const std::int32_t> e = M[k].get().domain(type, i);
+        auto it = std::ranges::find_if(
+            domains, [e](auto d)
+            { return d.data() == e.data() or std::ranges::equal(d, e); });
+        if (it == domains.end())
+        {
+          domains.push_back(e);
+          groups.emplace_back(1, integral_t(k, i));
+        }
+        else
+          groups[std::distance(domains.begin(), it)].emplace_back(k, i);
+      }
+    }
+    return std::pair(std::move(domains), std::move(groups));
+  };
+
+  using kernel_t = std::function<void(T*, const T*, const T*,
+                                      const scalar_value_type_t<T>*,
+                                      const int*, const std::uint8_t*)>;
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+
+  // Copy the coordinates of a cell
+  auto copy_geometry = [&](std::int32_t c)
+  {
+    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    x.copy(x_dofs, coordinate_dofs.data());
+  };
+
+  // Cell integrals
+  {
+    auto [domains, groups] = create_groups(IntegralType::cell);
+    for (std::size_t g = 0; g < groups.size(); ++g)
+    {
+      std::span<const std::int32_t> cells = domains[g];
+      const std::vector<integral_t>& group = groups[g];
+
+      // Kernels, and packers for coefficients that are packed by block
+      std::vector<kernel_t> kernels;
+      std::vector<std::pair<std::span<const T>, int>> coeffs;
+      std::vector<std::optional<CellCoefficientPacker<T, U>>> packers(
+          group.size());
+      std::vector<std::vector<T>> buffers(group.size());
+      for (std::size_t j = 0; j < group.size(); ++j)
+      {
+        auto [k, i] = group[j];
+        kernels.push_back(M[k].get().kernel(IntegralType::cell, i));
+        assert(kernels.back());
+        coeffs.push_back(coefficients[k].at({IntegralType::cell, i}));
+        const int cstride = coeffs.back().second;
+        if (pack_cells_deferred(coeffs, cstride, cells.size()))
+        {
+          packers[j].emplace(M[k].get(), i);
+          buffers[j].resize(std::min(block_size, cells.size()) * cstride);
+        }
+      }
+
+      std::vector<std::span<const T>> c(group.size());
+      for (std::size_t k0 = 0; k0 < cells.size(); k0 += block_size)
+      {
+        const std::size_t k1 = std::min(k0 + block_size, cells.size());
+        for (std::size_t j = 0; j < group.size(); ++j)
+        {
+          auto& [_coeffs, cstride] = coeffs[j];
+          if (packers[j])
+          {
+            std::span<T> _c
+                = std::span(buffers[j]).first((k1 - k0) * cstride);
+            (*packers[j])(k0, k1, _c);
+            c[j] = _c;
+          }
+          else
+            c[j] = _coeffs.subspan(k0 * cstride, (k1 - k0) * cstride);
+        }
+
+        for (std::size_t index = k0; index < k1; ++index)
+        {
+          copy_geometry(cells[index]);
+          for (std::size_t j = 0; j < group.size(); ++j)
+          {
+            std::size_t k = group[j].first;
+            const int cstride = coeffs[j].second;
+            kernels[j](&values[k], c[j].data() + (index - k0) * cstride,
+                       constants[k].data(), coordinate_dofs.data(), nullptr,
+                       nullptr);
+          }
+        }
+      }
+    }
+  }
+
+  // Exterior facet integrals
+  {
+    std::span<const std::uint8_t> perms;
+    if (std::ranges::any_of(M, [](auto& form)
+                            { return form.get().needs_facet_permutations(); }))
+    {
+      mesh->topology_mutable()->create_facet_permutations();
+      perms = std::span(mesh->topology()->get_facet_permutations());
+    }
+
+    mesh::CellType cell_type = mesh->topology()->cell_type();
+    const int num_facets_per_cell
+        = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
+    auto [domains, groups] = create_groups(IntegralType::exterior_facet);
+    for (std::size_t g = 0; g < groups.size(); ++g)
+    {
+      std::span<const std::int32_t> facets = domains[g];
+      const std::vector<integral_t>& group = groups[g];
+      std::vector<kernel_t> kernels;
+      std::vector<std::pair<std::span<const T>, int>> c;
+      for (auto [k, i] : group)
+      {
+        kernels.push_back(M[k].get().kernel(IntegralType::exterior_facet, i));
+        assert(kernels.back());
+        c.push_back(coefficients[k].at({IntegralType::exterior_facet, i}));
+      }
+
+      assert(facets.size() % 2 == 0);
+      for (std::size_t index = 0; index < facets.size(); index += 2)
+      {
+        std::int32_t cell = facets[index];
+        std::int32_t local_facet = facets[index + 1];
+        copy_geometry(cell);
+        std::uint8_t perm
+            = perms.empty() ? 0
+                            : perms[cell * num_facets_per_cell + local_facet];
+        for (std::size_t j = 0; j < group.size(); ++j)
+        {
+          std::size_t k = group[j].first;
+          auto& [coeffs, cstride] = c[j];
+          kernels[j](&values[k], coeffs.data() + index / 2 * cstride,
+                     constants[k].data(), coordinate_dofs.data(),
+                     &local_facet, &perm);
+        }
+      }
+    }
+  }
+
+  // Interior facet integrals
+  for (std::size_t k = 0; k < M.size(); ++k)
+  {
+    const Form<T, U>& form = M[k].get();
+    std::span<const std::uint8_t> perms;
+    if (form.needs_facet_permutations())
+    {
+      mesh->topology_mutable()->create_facet_permutations();
+      perms = std::span(mesh->topology()->get_facet_permutations());
+    }
+
+    mesh::CellType cell_type = mesh->topology()->cell_type();
+    const int num_facets_per_cell
+        = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
+    for (int i : form.integral_ids(IntegralType::interior_facet))
+    {
+      auto fn = form.kernel(IntegralType::interior_facet, i);
+      assert(fn);
+      auto& [coeffs, cstride]
+          = coefficients[k].at({IntegralType::interior_facet, i});
+      values[k] += impl::assemble_interior_facets(
+          x_dofmap, x, num_facets_per_cell,
+          form.domain(IntegralType::interior_facet, i), fn, constants[k],
+          coeffs, cstride, form.coefficient_offsets(), perms);
+    }
+  }
+
+  return values;
+}
+
 } // namespace dolfinx::fem::impl
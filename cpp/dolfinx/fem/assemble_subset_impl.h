@@ -0,0 +1,374 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Form.h"
+#include "FunctionSpace.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "traits.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace dolfinx::fem::impl
+{
+/// @brief Integration entities of an integral that are attached to
+/// marked cells, with their packed coefficients.
+template <dolfinx::scalar T>
+struct EntitySubset
+{
+  /// Entities in the integration domain mesh, flattened
+  std::vector<std::int32_t> entities;
+
+  /// Entities in the test function mesh, flattened
+  std::vector<std::int32_t> entities0;
+
+  /// Entities in the trial function mesh, flattened. Empty for linear
+  /// forms.
+  std::vector<std::int32_t> entities1;
+
+  /// Packed coefficients of the entities
+  std::vector<T> coeffs;
+};
+
+/// @brief Extract the integration entities of an integral that are
+/// attached to a marked cell.
+///
+/// An entity is selected if one of its cells (in the integration
+/// domain mesh) is marked. An interior facet is selected if either of
+/// its two cells is marked.
+///
+/// @param[in] form The form.
+/// @param[in] type Integral type.
+/// @param[in] id Integral domain id.
+/// @param[in] coeffs Packed coefficients of the integral. Cell integral
+/// coefficients that are packed during assembly (see
+/// pack_cells_deferred) are packed for the selected cells only.
+/// @param[in] cstride Number of coefficient values per cell.
+/// @param[in] cell_marker Marker for each cell of the integration
+/// domain mesh.
+/// @return The selected entities and their coefficients.
+template <dolfinx::scalar T, std::floating_point U>
+EntitySubset<T> marked_entities(const Form<T, U>& form, IntegralType type,
+                                int id, std::span<const T> coeffs,
+                                int cstride,
+                                std::span<const std::int8_t> cell_marker)
+{
+  // Number of values per entity in the flattened entity arrays
+  const int estride = type == IntegralType::cell             ? 1
+                      : type == IntegralType::exterior_facet ? 2
+                                                             : 4;
+
+  // Number of coefficient values per entity
+  const int wstride = type == IntegralType::interior_facet ? 2 * cstride
+                                                           : cstride;
+
+  std::span<const std::int32_t> entities = form.domain(type, id);
+  const std::size_t num_entities = entities.size() / estride;
+  std::vector<std::int32_t> positions;
+  for (std::size_t p = 0; p < num_entities; ++p)
+  {
+    if (cell_marker[entities[estride * p]]
+        or (estride == 4 and cell_marker[entities[estride * p + 2]]))
+    {
+      positions.push_back(p);
+    }
+  }
+
+  auto gather = [&positions, estride](std::span<const std::int32_t> e)
+  {
+    std::vector<std::int32_t> sub(positions.size() * estride);
+    for (std::size_t k = 0; k < positions.size(); ++k)
+    {
+      std::copy_n(std::next(e.begin(), estride * positions[k]), estride,
+                  std::next(sub.begin(), estride * k));
+    }
+    return sub;
+  };
+
+  EntitySubset<T> subset;
+  subset.entities = gather(entities);
+  auto mesh0 = form.function_spaces().at(0)->mesh();
+  subset.entities0 = gather(form.domain(type, id, *mesh0));
+  if (form.rank() > 1)
+  {
+    auto mesh1 = form.function_spaces().at(1)->mesh();
+    subset.entities1 = gather(form.domain(type, id, *mesh1));
+  }
+
+  subset.coeffs.resize(positions.size() * wstride);
+  if (type == IntegralType::cell
+      and pack_cells_deferred(coeffs, cstride, num_entities))
+  {
+    CellCoefficientPacker<T, U> pack(form, id);
+    for (std::size_t k = 0; k < positions.size(); ++k)
+    {
+      pack(positions[k], positions[k] + 1,
+           std::span(subset.coeffs).subspan(k * wstride, wstride));
+    }
+  }
+  else
+  {
+    for (std::size_t k = 0; k < positions.size(); ++k)
+    {
+      std::copy_n(std::next(coeffs.begin(), wstride * positions[k]), wstride,
+                  std::next(subset.coeffs.begin(), wstride * k));
+    }
+  }
+
+  return subset;
+}
+
+/// @brief Kernel that scales the element tensor computed by a kernel.
+/// @param[in] kernel The kernel.
+/// @param[in] size Size of the element tensor.
+/// @param[in] scale Scale factor.
+template <dolfinx::scalar T, typename K>
+auto scaled_kernel(K kernel, std::size_t size, T scale)
+{
+  return [kernel, size, scale](T* A, const T* w, const T* c,
+                               const scalar_value_type_t<T>* x,
+                               const int* entity, const std::uint8_t* perm)
+  {
+    kernel(A, w, c, x, entity, perm);
+    if (scale != T(1))
+      std::for_each(A, A + size, [scale](auto& v) { v *= scale; });
+  };
+}
+
+/// @brief Assemble the contributions to a matrix from the integration
+/// entities that are attached to a set of marked cells.
+///
+/// See fem::assemble_matrix_subset.
+///
+/// @param[in] mat_set The function for adding values into the matrix.
+/// @param[in] a The bilinear form.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants of `a`.
+/// @param[in] coefficients Packed coefficients of `a`.
+/// @param[in] bc0 Boundary condition markers for the rows.
+/// @param[in] bc1 Boundary condition markers for the columns.
+/// @param[in] cell_marker Marker for each cell of the integration
+/// domain mesh.
+/// @param[in] scale Scale factor applied to the element matrices.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_subset(
+    la::MatSet<T> auto mat_set, const Form<T, U>& a, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> bc0, std::span<const std::int8_t> bc1,
+    std::span<const std::int8_t> cell_marker, T scale)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  auto mesh0 = a.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto mesh1 = a.function_spaces().at(1)->mesh();
+  assert(mesh1);
+  std::shared_ptr<const fem::DofMap> dofmap0
+      = a.function_spaces().at(0)->dofmap();
+  std::shared_ptr<const fem::DofMap> dofmap1
+      = a.function_spaces().at(1)->dofmap();
+  assert(dofmap0);
+  assert(dofmap1);
+  auto dofs0 = dofmap0->map();
+  const int bs0 = dofmap0->bs();
+  auto dofs1 = dofmap1->map();
+  const int bs1 = dofmap1->bs();
+  const std::size_t ndim0 = bs0 * dofs0.extent(1);
+  const std::size_t ndim1 = bs1 * dofs1.extent(1);
+
+  auto element0 = a.function_spaces().at(0)->element();
+  assert(element0);
+  auto element1 = a.function_spaces().at(1)->element();
+  assert(element1);
+  fem::DofTransformKernel<T> auto P0
+      = element0->template dof_transformation_fn<T>(doftransform::standard);
+  fem::DofTransformKernel<T> auto P1T
+      = element1->template dof_transformation_right_fn<T>(
+          doftransform::transpose);
+
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element0->needs_dof_transformations()
+      or element1->needs_dof_transformations() or a.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+
+  std::span<const std::uint8_t> perms;
+  if (a.needs_facet_permutations())
+  {
+    mesh->topology_mutable()->create_facet_permutations();
+    perms = std::span(mesh->topology()->get_facet_permutations());
+  }
+
+  for (int i : a.integral_ids(IntegralType::cell))
+  {
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    EntitySubset<T> s = marked_entities(a, IntegralType::cell, i, coeffs,
+                                        cstride, cell_marker);
+    impl::assemble_cells(
+        mat_set, x_dofmap, x, s.entities, {dofs0, bs0, s.entities0}, P0,
+        {dofs1, bs1, s.entities1}, P1T, bc0, bc1,
+        scaled_kernel(a.kernel(IntegralType::cell, i), ndim0 * ndim1, scale),
+        std::span<const T>(s.coeffs), cstride, constants, cell_info0,
+        cell_info1);
+  }
+
+  mesh::CellType cell_type = mesh->topology()->cell_type();
+  int num_facets_per_cell
+      = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
+  for (int i : a.integral_ids(IntegralType::exterior_facet))
+  {
+    auto& [coeffs, cstride]
+        = coefficients.at({IntegralType::exterior_facet, i});
+    EntitySubset<T> s = marked_entities(a, IntegralType::exterior_facet, i,
+                                        coeffs, cstride, cell_marker);
+    impl::assemble_exterior_facets(
+        mat_set, x_dofmap, x, num_facets_per_cell, s.entities,
+        {dofs0, bs0, s.entities0}, P0, {dofs1, bs1, s.entities1}, P1T, bc0,
+        bc1,
+        scaled_kernel(a.kernel(IntegralType::exterior_facet, i),
+                      ndim0 * ndim1, scale),
+        std::span<const T>(s.coeffs), cstride, constants, cell_info0,
+        cell_info1, perms);
+  }
+
+  for (int i : a.integral_ids(IntegralType::interior_facet))
+  {
+    const std::vector<int> c_offsets = a.coefficient_offsets();
+    auto& [coeffs, cstride]
+        = coefficients.at({IntegralType::interior_facet, i});
+    EntitySubset<T> s = marked_entities(a, IntegralType::interior_facet, i,
+                                        coeffs, cstride, cell_marker);
+    impl::assemble_interior_facets(
+        mat_set, x_dofmap, x, num_facets_per_cell, s.entities,
+        {*dofmap0, bs0, s.entities0}, P0, {*dofmap1, bs1, s.entities1}, P1T,
+        bc0, bc1,
+        scaled_kernel(a.kernel(IntegralType::interior_facet, i),
+                      4 * ndim0 * ndim1, scale),
+        std::span<const T>(s.coeffs), cstride, c_offsets, constants,
+        cell_info0, cell_info1, perms);
+  }
+}
+
+/// @brief Assemble the contributions to a vector from the integration
+/// entities that are attached to a set of marked cells.
+///
+/// See fem::assemble_vector_subset.
+///
+/// @param[in,out] b The vector to assemble into. It is not zeroed.
+/// @param[in] L The linear form.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants of `L`.
+/// @param[in] coefficients Packed coefficients of `L`.
+/// @param[in] cell_marker Marker for each cell of the integration
+/// domain mesh.
+/// @param[in] scale Scale factor applied to the element vectors.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_subset(
+    std::span<T> b, const Form<T, U>& L, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::int8_t> cell_marker, T scale)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  auto mesh0 = L.function_spaces().at(0)->mesh();
+  assert(mesh0);
+  auto element = L.function_spaces().at(0)->element();
+  assert(element);
+  std::shared_ptr<const fem::DofMap> dofmap
+      = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+  const std::size_t ndim = bs * dofs.extent(1);
+
+  fem::DofTransformKernel<T> auto P0
+      = element->template dof_transformation_fn<T>(doftransform::standard);
+
+  std::span<const std::uint32_t> cell_info0;
+  if (element->needs_dof_transformations() or L.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+  }
+
+  std::span<const std::uint8_t> perms;
+  if (L.needs_facet_permutations())
+  {
+    mesh->topology_mutable()->create_facet_permutations();
+    perms = std::span(mesh->topology()->get_facet_permutations());
+  }
+
+  for (int i : L.integral_ids(IntegralType::cell))
+  {
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    EntitySubset<T> s = marked_entities(L, IntegralType::cell, i, coeffs,
+                                        cstride, cell_marker);
+    impl::assemble_cells_bs(
+        P0, b, x_dofmap, x, s.entities, {dofs, bs, s.entities0},
+        scaled_kernel(L.kernel(IntegralType::cell, i), ndim, scale),
+        constants, std::span<const T>(s.coeffs), cstride, cell_info0);
+  }
+
+  mesh::CellType cell_type = mesh->topology()->cell_type();
+  int num_facets_per_cell
+      = mesh::cell_num_entities(cell_type, mesh->topology()->dim() - 1);
+  for (int i : L.integral_ids(IntegralType::exterior_facet))
+  {
+    auto& [coeffs, cstride]
+        = coefficients.at({IntegralType::exterior_facet, i});
+    EntitySubset<T> s = marked_entities(L, IntegralType::exterior_facet, i,
+                                        coeffs, cstride, cell_marker);
+    impl::assemble_exterior_facets(
+        P0, b, x_dofmap, x, num_facets_per_cell, s.entities,
+        {dofs, bs, s.entities0},
+        scaled_kernel(L.kernel(IntegralType::exterior_facet, i), ndim,
+                      scale),
+        constants, std::span<const T>(s.coeffs), cstride, cell_info0, perms);
+  }
+
+  for (int i : L.integral_ids(IntegralType::interior_facet))
+  {
+    auto& [coeffs, cstride]
+        = coefficients.at({IntegralType::interior_facet, i});
+    EntitySubset<T> s = marked_entities(L, IntegralType::interior_facet, i,
+                                        coeffs, cstride, cell_marker);
+    impl::assemble_interior_facets(
+        P0, b, x_dofmap, x, num_facets_per_cell, s.entities,
+        {*dofmap, bs, s.entities0},
+        scaled_kernel(L.kernel(IntegralType::interior_facet, i), 2 * ndim,
+                      scale),
+        constants, std::span<const T>(s.coeffs), cstride, cell_info0, perms);
+  }
+}
+} // namespace dolfinx::fem::impl
@@ -14,14 +14,19 @@
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
 #include <cstdint>
+#include <dolfinx/common/Arena.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <vector>
@@ -74,7 +79,7 @@ using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
 template <dolfinx::scalar T, int _bs0 = -1, int _bs1 = -1>
 void _lift_bc_cells(
     std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, FEkernel<T> auto kernel,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, FEkernel<T> auto kernel,
     std::span<const std::int32_t> cells,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -94,8 +99,10 @@ void _lift_bc_cells(
   assert(_bs1 < 0 or _bs1 == bs1);
 
   // Data structures used in bc application
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> Ae, be;
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+  std::pmr::vector<T> Ae(common::scratch_resource());
+  std::pmr::vector<T> be(common::scratch_resource());
   assert(cells0.size() == cells.size());
   assert(cells1.size() == cells.size());
   for (std::size_t index = 0; index < cells.size(); ++index)
@@ -146,11 +153,7 @@ void _lift_bc_cells(
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     // Size data structure for assembly
     auto dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
@@ -261,7 +264,7 @@ void _lift_bc_cells(
 template <dolfinx::scalar T, int _bs = -1>
 void _lift_bc_exterior_facets(
     std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, int num_facets_per_cell,
     FEkernel<T> auto kernel, std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -280,8 +283,10 @@ void _lift_bc_exterior_facets(
   const auto [dmap1, bs1, facets1] = dofmap1;
 
   // Data structures used in bc application
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> Ae, be;
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+  std::pmr::vector<T> Ae(common::scratch_resource());
+  std::pmr::vector<T> be(common::scratch_resource());
   assert(facets.size() % 2 == 0);
   assert(facets0.size() == facets.size());
   assert(facets1.size() == facets.size());
@@ -321,11 +326,7 @@ void _lift_bc_exterior_facets(
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     // Size data structure for assembly
     auto dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
@@ -410,7 +411,7 @@ void _lift_bc_exterior_facets(
 template <dolfinx::scalar T, int _bs = -1>
 void _lift_bc_interior_facets(
     std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, int num_facets_per_cell,
     FEkernel<T> auto kernel, std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap0,
     fem::DofTransformKernel<T> auto P0,
@@ -430,11 +431,13 @@ void _lift_bc_interior_facets(
 
   // Data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  std::pmr::vector<X> coordinate_dofs(
+      2 * x_dofmap.extent(1) * 3, common::scratch_resource());
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
-  std::vector<T> Ae, be;
+  std::pmr::vector<T> Ae(common::scratch_resource());
+  std::pmr::vector<T> be(common::scratch_resource());
 
   // Temporaries for joint dofmaps
   std::vector<std::int32_t> dmapjoint0, dmapjoint1;
@@ -459,18 +462,10 @@ void _lift_bc_interior_facets(
     // Get cell geometry
     auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
-    }
+    x.copy(x_dofs0, cdofs0.data());
     auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
-    }
+    x.copy(x_dofs1, cdofs1.data());
 
     // Get dof maps for cells and pack
     auto dmap0_cell0
@@ -629,15 +624,18 @@ void _lift_bc_interior_facets(
 /// @param cstride The coefficient stride
 /// @param cell_info0 The cell permutation information for the test function
 /// mesh
+/// @param contiguous True if the dofs of each cell are a contiguous
+/// block (see DofMap::contiguous), in which case the cell vectors are
+/// added to the blocks directly.
 template <dolfinx::scalar T, int _bs = -1>
 void assemble_cells(
     fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
     std::span<const std::int32_t> cells,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto kernel, std::span<const T> constants,
     std::span<const T> coeffs, int cstride,
-    std::span<const std::uint32_t> cell_info0)
+    std::span<const std::uint32_t> cell_info0, bool contiguous = false)
 {
   if (cells.empty())
     return;
@@ -646,8 +644,9 @@ void assemble_cells(
   assert(_bs < 0 or _bs == bs);
 
   // Create data structures used in assembly
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> be(bs * dmap.extent(1));
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+  std::pmr::vector<T> be(bs * dmap.extent(1), common::scratch_resource());
   std::span<T> _be(be);
 
   // Iterate over active cells
@@ -660,11 +659,7 @@ void assemble_cells(
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     // Tabulate vector for cell
     std::ranges::fill(be, 0);
@@ -673,6 +668,14 @@ void assemble_cells(
     P0(_be, cell_info0, c0, 1);
 
     // Scatter cell vector to 'global' vector array
+    if (contiguous)
+    {
+      std::span<T> bc = b.subspan(bs * dmap(c0, 0), be.size());
+      for (std::size_t i = 0; i < be.size(); ++i)
+        bc[i] += be[i];
+      continue;
+    }
+
     auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         dmap, c0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
     if constexpr (_bs > 0)
@@ -690,6 +693,153 @@ void assemble_cells(
   }
 }
 
+/// @brief Execute kernel over cells and accumulate result in vector,
+/// using a compile-time block size for common block sizes.
+///
+/// See impl::assemble_cells for a description of the arguments.
+template <dolfinx::scalar T>
+void assemble_cells_bs(
+    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
+    FEkernel<T> auto kernel, std::span<const T> constants,
+    std::span<const T> coeffs, int cstride,
+    std::span<const std::uint32_t> cell_info0, bool contiguous = false)
+{
+  const int bs = std::get<1>(dofmap);
+  if (bs == 1)
+  {
+    impl::assemble_cells<T, 1>(P0, b, x_dofmap, x, cells, dofmap, kernel,
+                               constants, coeffs, cstride, cell_info0,
+                               contiguous);
+  }
+  else if (bs == 3)
+  {
+    impl::assemble_cells<T, 3>(P0, b, x_dofmap, x, cells, dofmap, kernel,
+                               constants, coeffs, cstride, cell_info0,
+                               contiguous);
+  }
+  else
+  {
+    impl::assemble_cells(P0, b, x_dofmap, x, cells, dofmap, kernel, constants,
+                         coeffs, cstride, cell_info0, contiguous);
+  }
+}
+
+/// @brief Execute a batched kernel over cells and accumulate result in
+/// vector.
+///
+/// Geometry and coefficient data for `N` cells at a time are gathered
+/// into structure-of-arrays buffers and the kernel is called once per
+/// batch (see fem::FEkernelBatched for the data layout). If the number
+/// of cells is not a multiple of `N`, the last batch is padded with
+/// copies of its final cell and the element vectors of the padding
+/// cells are discarded.
+///
+/// @tparam T  The scalar type
+/// @tparam N Number of cells in a batch.
+/// @tparam _bs The block size of the form test function dof map. If
+/// less than zero the block size is determined at runtime. If `_bs` is
+/// positive the block size is used as a compile-time constant, which
+/// has performance benefits.
+/// @param P0 Function that applies transformation P0.b in-place to
+/// transform test degrees-of-freedom.
+/// @param b The vector to accumulate into
+/// @param x_dofmap Dofmap for the mesh geometry.
+/// @param x Mesh geometry (coordinates).
+/// @param cells Cell indices (in the integration domain mesh) to execute
+/// the kernel over. These are the indices into the geometry dofmap.
+/// @param dofmap Test function (row) degree-of-freedom data holding
+/// the (0) dofmap, (1) dofmap block size and (2) dofmap cell indices.
+/// @param kernel Batched kernel function to execute over each batch of
+/// cells.
+/// @param constants The constant data
+/// @param coeffs The coefficient data array of shape (cells.size(), cstride),
+/// flattened into row-major format.
+/// @param cstride The coefficient stride
+/// @param cell_info0 The cell permutation information for the test function
+/// mesh
+template <dolfinx::scalar T, int N, int _bs = -1>
+void assemble_cells_batched(
+    fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const std::int32_t> cells,
+    std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
+    FEkernelBatched<T> auto kernel, std::span<const T> constants,
+    std::span<const T> coeffs, int cstride,
+    std::span<const std::uint32_t> cell_info0)
+{
+  static_assert(N > 0);
+  if (cells.empty())
+    return;
+
+  const auto [dmap, bs, cells0] = dofmap;
+  assert(_bs < 0 or _bs == bs);
+
+  // Batch (structure-of-arrays) buffers
+  const std::size_t num_xdofs = x_dofmap.extent(1);
+  std::pmr::vector<T> b_batch(
+      bs * dmap.extent(1) * N, common::scratch_resource());
+  std::pmr::vector<T> coeffs_batch(cstride * N, common::scratch_resource());
+  std::pmr::vector<scalar_value_type_t<T>> x_batch(
+      3 * num_xdofs * N, common::scratch_resource());
+
+  // Element vector for a single cell
+  std::pmr::vector<T> be(bs * dmap.extent(1), common::scratch_resource());
+  std::span<T> _be(be);
+
+  for (std::size_t index0 = 0; index0 < cells.size(); index0 += N)
+  {
+    const int num_cells = std::min<std::size_t>(N, cells.size() - index0);
+
+    // Pack geometry and coefficients for the batch. Padding cells
+    // repeat the last cell of the batch.
+    for (int j = 0; j < N; ++j)
+    {
+      const std::size_t index = index0 + std::min(j, num_cells - 1);
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells[index], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < x_dofs.size(); ++i)
+        for (int d = 0; d < 3; ++d)
+          x_batch[(3 * i + d) * N + j] = x(x_dofs[i], d);
+      for (int k = 0; k < cstride; ++k)
+        coeffs_batch[k * N + j] = coeffs[index * cstride + k];
+    }
+
+    // Tabulate vectors for the batch
+    std::ranges::fill(b_batch, 0);
+    kernel(b_batch.data(), coeffs_batch.data(), constants.data(),
+           x_batch.data());
+
+    for (int j = 0; j < num_cells; ++j)
+    {
+      std::int32_t c0 = cells0[index0 + j];
+
+      // Unpack element vector for cell
+      for (std::size_t k = 0; k < be.size(); ++k)
+        be[k] = b_batch[k * N + j];
+      P0(_be, cell_info0, c0, 1);
+
+      // Scatter cell vector to 'global' vector array
+      auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          dmap, c0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      if constexpr (_bs > 0)
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < _bs; ++k)
+            b[_bs * dofs[i] + k] += be[_bs * i + k];
+      }
+      else
+      {
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < bs; ++k)
+            b[bs * dofs[i] + k] += be[bs * i + k];
+      }
+    }
+  }
+}
+
 /// @brief Execute kernel over cells and accumulate result in vector.
 /// @tparam T The scalar type
 /// @tparam _bs The block size of the form test function dof map. If
@@ -718,7 +868,7 @@ void assemble_cells(
 template <dolfinx::scalar T, int _bs = -1>
 void assemble_exterior_facets(
     fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<mdspan2_t, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto fn, std::span<const T> constants,
@@ -735,8 +885,9 @@ void assemble_exterior_facets(
   // FIXME: Add proper interface for num_dofs
   // Create data structures used in assembly
   const int num_dofs = dmap.extent(1);
-  std::vector<scalar_value_type_t<T>> coordinate_dofs(3 * x_dofmap.extent(1));
-  std::vector<T> be(bs * num_dofs);
+  std::pmr::vector<scalar_value_type_t<T>> coordinate_dofs(
+      3 * x_dofmap.extent(1), common::scratch_resource());
+  std::pmr::vector<T> be(bs * num_dofs, common::scratch_resource());
   std::span<T> _be(be);
   assert(facets.size() % 2 == 0);
   assert(facets0.size() == facets.size());
@@ -751,11 +902,7 @@ void assemble_exterior_facets(
     // Get cell coordinates/geometry
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs[i]), 3,
-                  std::next(coordinate_dofs.begin(), 3 * i));
-    }
+    x.copy(x_dofs, coordinate_dofs.data());
 
     // Permutations
     std::uint8_t perm
@@ -814,7 +961,7 @@ void assemble_exterior_facets(
 template <dolfinx::scalar T, int _bs = -1>
 void assemble_interior_facets(
     fem::DofTransformKernel<T> auto P0, std::span<T> b, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, int num_facets_per_cell,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x, int num_facets_per_cell,
     std::span<const std::int32_t> facets,
     std::tuple<const DofMap&, int, std::span<const std::int32_t>> dofmap,
     FEkernel<T> auto fn, std::span<const T> constants,
@@ -830,14 +977,29 @@ void assemble_interior_facets(
 
   // Create data structures used in assembly
   using X = scalar_value_type_t<T>;
-  std::vector<X> coordinate_dofs(2 * x_dofmap.extent(1) * 3);
+  std::pmr::vector<X> coordinate_dofs(
+      2 * x_dofmap.extent(1) * 3, common::scratch_resource());
   std::span<X> cdofs0(coordinate_dofs.data(), x_dofmap.extent(1) * 3);
   std::span<X> cdofs1(coordinate_dofs.data() + x_dofmap.extent(1) * 3,
                       x_dofmap.extent(1) * 3);
-  std::vector<T> be;
+  std::pmr::vector<T> be(common::scratch_resource());
+
+  // Copy the geometry of a cell, unless it is the cell of the previous
+  // copy
+  auto copy_geometry = [&](std::int32_t c, std::int32_t& c_prev,
+                           std::span<X> cdofs)
+  {
+    if (c == c_prev)
+      return;
+    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+        x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+    x.copy(x_dofs, cdofs.data());
+    c_prev = c;
+  };
 
   assert(facets.size() % 4 == 0);
   assert(facets0.size() == facets.size());
+  std::array<std::int32_t, 2> cells_prev = {-1, -1};
   for (std::size_t index = 0; index < facets.size(); index += 4)
   {
     // Cells in integration domain and test function domain meshes
@@ -848,21 +1010,10 @@ void assemble_interior_facets(
     std::array<std::int32_t, 2> local_facet{facets[index + 1],
                                             facets[index + 3]};
 
-    // Get cell geometry
-    auto x_dofs0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[0], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs0.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs0[i]), 3,
-                  std::next(cdofs0.begin(), 3 * i));
-    }
-    auto x_dofs1 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells[1], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < x_dofs1.size(); ++i)
-    {
-      std::copy_n(std::next(x.begin(), 3 * x_dofs1[i]), 3,
-                  std::next(cdofs1.begin(), 3 * i));
-    }
+    // Get cell geometry. Facets are often ordered by cell, in which
+    // case the geometry of a cell is reused.
+    copy_geometry(cells[0], cells_prev[0], cdofs0);
+    copy_geometry(cells[1], cells_prev[1], cdofs1);
 
     // Get dofmaps for cells
     std::span<const std::int32_t> dmap0 = dmap.cell_dofs(cells0[0]);
@@ -908,6 +1059,40 @@ void assemble_interior_facets(
   }
 }
 
+/// @brief Find the cells in an integration domain that have a
+/// constrained trial degree-of-freedom.
+/// @param[in] cells1 Trial function mesh cell of each entry in the
+/// integration domain.
+/// @param[in] bc_cells1 Sorted trial function mesh cells that have a
+/// constrained degree-of-freedom.
+/// @return Sorted positions in `cells1` of the cells in `bc_cells1`.
+inline std::vector<std::int32_t>
+bc_cell_positions(std::span<const std::int32_t> cells1,
+                  std::span<const std::int32_t> bc_cells1)
+{
+  std::vector<std::int32_t> pos;
+  if (std::ranges::is_sorted(cells1))
+  {
+    // Typically far fewer cells have a bc than are in the domain
+    for (std::int32_t c : bc_cells1)
+    {
+      auto it = std::ranges::lower_bound(cells1, c);
+      if (it != cells1.end() and *it == c)
+        pos.push_back(std::distance(cells1.begin(), it));
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < cells1.size(); ++i)
+    {
+      if (std::ranges::binary_search(bc_cells1, cells1[i]))
+        pos.push_back(i);
+    }
+  }
+
+  return pos;
+}
+
 /// Modify RHS vector to account for boundary condition such that:
 ///
 /// b <- b - alpha * A.(x_bc - x0)
@@ -921,17 +1106,21 @@ void assemble_interior_facets(
 /// @param[in] bc_values1 The boundary condition 'values'
 /// @param[in] bc_markers1 The indices (columns of A, rows of x) to
 /// which bcs belong
+/// @param[in] bc_cells1 Sorted cells of the trial function mesh that
+/// have a constrained degree-of-freedom. Only these cells are visited
+/// for cell integrals.
 /// @param[in] x0 The array used in the lifting, typically a 'current
 /// solution' in a Newton method
 /// @param[in] alpha Scaling to apply
 template <dolfinx::scalar T, std::floating_point U>
 void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
-             std::span<const scalar_value_type_t<T>> x,
+             mesh::NodeCoordinates<scalar_value_type_t<T>> x,
              std::span<const T> constants,
              const std::map<std::pair<IntegralType, int>,
                             std::pair<std::span<const T>, int>>& coefficients,
              std::span<const T> bc_values1,
-             std::span<const std::int8_t> bc_markers1, std::span<const T> x0,
+             std::span<const std::int8_t> bc_markers1,
+             std::span<const std::int32_t> bc_cells1, std::span<const T> x0,
              T alpha)
 {
   // Integration domain mesh
@@ -980,40 +1169,72 @@ void lift_bc(std::span<T> b, const Form<T, U>& a, mdspan2_t x_dofmap,
     auto kernel = a.kernel(IntegralType::cell, i);
     assert(kernel);
     auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+
+    // Restrict the integration domain to the cells with a constrained
+    // trial degree-of-freedom
     std::span<const std::int32_t> cells = a.domain(IntegralType::cell, i);
+    std::span<const std::int32_t> cells0
+        = a.domain(IntegralType::cell, i, *mesh0);
+    std::span<const std::int32_t> cells1
+        = a.domain(IntegralType::cell, i, *mesh1);
+    const std::vector<std::int32_t> pos = bc_cell_positions(cells1, bc_cells1);
+    std::vector<std::int32_t> cells_bc(pos.size()), cells0_bc(pos.size()),
+        cells1_bc(pos.size());
+    std::vector<T> coeffs_bc(pos.size() * cstride);
+    for (std::size_t k = 0; k < pos.size(); ++k)
+    {
+      cells_bc[k] = cells[pos[k]];
+      cells0_bc[k] = cells0[pos[k]];
+      cells1_bc[k] = cells1[pos[k]];
+    }
+
+    if (pack_cells_deferred(coeffs, cstride, cells.size()))
+    {
+      CellCoefficientPacker<T, U> pack(a, i);
+      for (std::size_t k = 0; k < pos.size(); ++k)
+      {
+        pack(pos[k], pos[k] + 1,
+             std::span(coeffs_bc).subspan(k * cstride, cstride));
+      }
+    }
+    else
+    {
+      for (std::size_t k = 0; k < pos.size(); ++k)
+      {
+        std::copy_n(std::next(coeffs.begin(), pos[k] * cstride), cstride,
+                    std::next(coeffs_bc.begin(), k * cstride));
+      }
+    }
+
     if (bs0 == 1 and bs1 == 1)
     {
-      _lift_bc_cells<T, 1, 1>(
-          b, x_dofmap, x, kernel, cells,
-          {dofmap0, bs0, a.domain(IntegralType::cell, i, *mesh0)}, P0,
-          {dofmap1, bs1, a.domain(IntegralType::cell, i, *mesh1)}, P1T,
-          constants, coeffs, cstride, cell_info0, cell_info1, bc_values1,
-          bc_markers1, x0, alpha);
+      _lift_bc_cells<T, 1, 1>(b, x_dofmap, x, kernel, cells_bc,
+                              {dofmap0, bs0, cells0_bc}, P0,
+                              {dofmap1, bs1, cells1_bc}, P1T, constants,
+                              coeffs_bc, cstride, cell_info0, cell_info1,
+                              bc_values1, bc_markers1, x0, alpha);
     }
     else if (bs0 == 3 and bs1 == 3)
     {
-      _lift_bc_cells<T, 3, 3>(
-          b, x_dofmap, x, kernel, cells,
-          {dofmap0, bs0, a.domain(IntegralType::cell, i, *mesh0)}, P0,
-          {dofmap1, bs1, a.domain(IntegralType::cell, i, *mesh1)}, P1T,
-          constants, coeffs, cstride, cell_info0, cell_info1, bc_values1,
-          bc_markers1, x0, alpha);
+      _lift_bc_cells<T, 3, 3>(b, x_dofmap, x, kernel, cells_bc,
+                              {dofmap0, bs0, cells0_bc}, P0,
+                              {dofmap1, bs1, cells1_bc}, P1T, constants,
+                              coeffs_bc, cstride, cell_info0, cell_info1,
+                              bc_values1, bc_markers1, x0, alpha);
     }
     else
     {
-      _lift_bc_cells(b, x_dofmap, x, kernel, cells,
-                     {dofmap0, bs0, a.domain(IntegralType::cell, i, *mesh0)},
-                     P0,
-                     {dofmap1, bs1, a.domain(IntegralType::cell, i, *mesh1)},
-                     P1T, constants, coeffs, cstride, cell_info0, cell_info1,
-                     bc_values1, bc_markers1, x0, alpha);
+      _lift_bc_cells(b, x_dofmap, x, kernel, cells_bc,
+                     {dofmap0, bs0, cells0_bc}, P0, {dofmap1, bs1, cells1_bc},
+                     P1T, constants, coeffs_bc, cstride, cell_info0,
+                     cell_info1, bc_values1, bc_markers1, x0, alpha);
     }
   }
 
   std::span<const std::uint8_t> perms;
   if (a.needs_facet_permutations())
   {
-    mesh->topology_mutable()->create_entity_permutations();
+    mesh->topology_mutable()->create_facet_permutations();
     perms = std::span(mesh->topology()->get_facet_permutations());
   }
 
@@ -1105,7 +1326,7 @@ void apply_lifting(
       if (!mesh)
         throw std::runtime_error("Unable to extract a mesh.");
       mdspan2_t x_dofmap = mesh->geometry().dofmap();
-      auto x = mesh->geometry().x();
+      auto x = mesh->geometry().coordinates();
 
       assert(a[j]->get().function_spaces().at(0));
       auto V1 = a[j]->get().function_spaces()[1];
@@ -1116,27 +1337,40 @@ void apply_lifting(
       const int crange = bs1 * (map1->size_local() + map1->num_ghosts());
       bc_markers1.assign(crange, false);
       bc_values1.assign(crange, 0);
+      std::vector<std::int32_t> bc_cells1;
       for (auto& bc : bcs1[j])
       {
         bc.get().mark_dofs(bc_markers1);
         bc.get().set(bc_values1, std::nullopt, 1);
+        std::span<const std::int32_t> cells = bc.get().cells();
+        bc_cells1.insert(bc_cells1.end(), cells.begin(), cells.end());
+      }
+      if (bcs1[j].size() > 1)
+      {
+        std::ranges::sort(bc_cells1);
+        auto [unique_end, range_end] = std::ranges::unique(bc_cells1);
+        bc_cells1.erase(unique_end, range_end);
       }
 
       if (!x0.empty())
       {
         lift_bc<T>(b, a[j]->get(), x_dofmap, x, constants[j], coeffs[j],
-                   bc_values1, bc_markers1, x0[j], alpha);
+                   bc_values1, bc_markers1, bc_cells1, x0[j], alpha);
       }
       else
       {
         lift_bc<T>(b, a[j]->get(), x_dofmap, x, constants[j], coeffs[j],
-                   bc_values1, bc_markers1, std::span<const T>(), alpha);
+                   bc_values1, bc_markers1, bc_cells1, std::span<const T>(),
+                   alpha);
       }
     }
   }
 }
 
-/// @brief Assemble linear form into a vector.
+/// @brief Assemble the exterior and interior facet integrals of a
+/// linear form into a vector.
+/// @param[in] P0 Function that applies the transformation to the test
+/// degrees-of-freedom.
 /// @param[in,out] b The vector to be assembled. It will not be zeroed
 /// before assembly.
 /// @param[in] L Linear forms to assemble into b.
@@ -1144,73 +1378,31 @@ void apply_lifting(
 /// @param[in] x Mesh coordinates.
 /// @param[in] constants Packed constants that appear in `L`.
 /// @param[in] coefficients Packed coefficients that appear in `L`.
+/// @param[in] cell_info0 The cell permutation information for the test
+/// function mesh.
 template <dolfinx::scalar T, std::floating_point U>
-void assemble_vector(
-    std::span<T> b, const Form<T, U>& L, mdspan2_t x_dofmap,
-    std::span<const scalar_value_type_t<T>> x, std::span<const T> constants,
+void assemble_vector_facets(
+    fem::DofTransformKernel<T> auto P0, std::span<T> b, const Form<T, U>& L,
+    mdspan2_t x_dofmap, mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
-                   std::pair<std::span<const T>, int>>& coefficients)
+                   std::pair<std::span<const T>, int>>& coefficients,
+    std::span<const std::uint32_t> cell_info0)
 {
-  // Integration domain mesh
   std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
   assert(mesh);
-
-  // Test function mesh
   auto mesh0 = L.function_spaces().at(0)->mesh();
   assert(mesh0);
-
-  // Get dofmap data
-  assert(L.function_spaces().at(0));
-  auto element = L.function_spaces().at(0)->element();
-  assert(element);
   std::shared_ptr<const fem::DofMap> dofmap
       = L.function_spaces().at(0)->dofmap();
   assert(dofmap);
   auto dofs = dofmap->map();
   const int bs = dofmap->bs();
 
-  fem::DofTransformKernel<T> auto P0
-      = element->template dof_transformation_fn<T>(doftransform::standard);
-
-  std::span<const std::uint32_t> cell_info0;
-  if (element->needs_dof_transformations() or L.needs_facet_permutations())
-  {
-    mesh0->topology_mutable()->create_entity_permutations();
-    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
-  }
-
-  for (int i : L.integral_ids(IntegralType::cell))
-  {
-    auto fn = L.kernel(IntegralType::cell, i);
-    assert(fn);
-    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
-    std::span<const std::int32_t> cells = L.domain(IntegralType::cell, i);
-    if (bs == 1)
-    {
-      impl::assemble_cells<T, 1>(
-          P0, b, x_dofmap, x, cells,
-          {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)}, fn, constants,
-          coeffs, cstride, cell_info0);
-    }
-    else if (bs == 3)
-    {
-      impl::assemble_cells<T, 3>(
-          P0, b, x_dofmap, x, cells,
-          {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)}, fn, constants,
-          coeffs, cstride, cell_info0);
-    }
-    else
-    {
-      impl::assemble_cells(P0, b, x_dofmap, x, cells,
-                           {dofs, bs, L.domain(IntegralType::cell, i, *mesh0)},
-                           fn, constants, coeffs, cstride, cell_info0);
-    }
-  }
-
   std::span<const std::uint8_t> perms;
   if (L.needs_facet_permutations())
   {
-    mesh->topology_mutable()->create_entity_permutations();
+    mesh->topology_mutable()->create_facet_permutations();
     perms = std::span(mesh->topology()->get_facet_permutations());
   }
 
@@ -1280,6 +1472,75 @@ void assemble_vector(
   }
 }
 
+/// @brief Assemble linear form into a vector.
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L Linear forms to assemble into b.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants that appear in `L`.
+/// @param[in] coefficients Packed coefficients that appear in `L`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector(
+    std::span<T> b, const Form<T, U>& L, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  // Integration domain mesh
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+
+  // Test function mesh
+  auto mesh0 = L.function_spaces().at(0)->mesh();
+  assert(mesh0);
+
+  // Get dofmap data
+  assert(L.function_spaces().at(0));
+  auto element = L.function_spaces().at(0)->element();
+  assert(element);
+  std::shared_ptr<const fem::DofMap> dofmap
+      = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+
+  fem::DofTransformKernel<T> auto P0
+      = element->template dof_transformation_fn<T>(doftransform::standard);
+
+  std::span<const std::uint32_t> cell_info0;
+  if (element->needs_dof_transformations() or L.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+  }
+
+  for (int i : L.integral_ids(IntegralType::cell))
+  {
+    auto fn = L.kernel(IntegralType::cell, i);
+    assert(fn);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    std::span<const std::int32_t> cells = L.domain(IntegralType::cell, i);
+    std::span<const std::int32_t> cells0
+        = L.domain(IntegralType::cell, i, *mesh0);
+    for_each_cell_block(
+        L, i, coeffs, cstride,
+        [&](std::size_t k0, std::size_t k1, std::span<const T> c)
+        {
+          impl::assemble_cells_bs(
+              P0, b, x_dofmap, x, cells.subspan(k0, k1 - k0),
+              {dofs, bs, cells0.subspan(k0, k1 - k0)}, fn, constants, c,
+              cstride, cell_info0, dofmap->contiguous());
+        });
+  }
+
+  assemble_vector_facets(P0, b, L, x_dofmap, x, constants, coefficients,
+                         cell_info0);
+}
+
 /// @brief Assemble linear form into a vector
 /// @param[in,out] b The vector to be assembled. It will not be zeroed
 /// before assembly.
@@ -1292,17 +1553,217 @@ void assemble_vector(
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients)
 {
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
   std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
   assert(mesh);
   if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
-    assemble_vector(b, L, mesh->geometry().dofmap(), mesh->geometry().x(),
-                    constants, coefficients);
+  {
+    assemble_vector(b, L, mesh->geometry().dofmap(),
+                    mesh->geometry().coordinates(), constants, coefficients);
+  }
   else
   {
     auto x = mesh->geometry().x();
     std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
-    assemble_vector(b, L, mesh->geometry().dofmap(), _x, constants,
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    assemble_vector(b, L, mesh->geometry().dofmap(), xg, constants,
                     coefficients);
   }
 }
+/// @brief Assemble a linear form into a distributed vector and
+/// accumulate the ghost contributions on the owning ranks, with the
+/// communication overlapped with assembly.
+///
+/// Cells with degrees-of-freedom in the ghost region of the vector,
+/// and all facet integrals, are assembled first. The reverse scatter of
+/// the ghost values is then started, and the remaining (interior) cells,
+/// which only have owned degrees-of-freedom, are assembled while the
+/// messages are in flight. On return the owned entries of `b` hold the
+/// assembled values, i.e. the result is the same as assemble_vector
+/// followed by `b.scatter_rev(std::plus<T>())`.
+///
+/// @note Collective MPI operation
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly. Its index map must be the test function space
+/// index map.
+/// @param[in] L Linear form to assemble into b.
+/// @param[in] x_dofmap Mesh geometry dofmap.
+/// @param[in] x Mesh coordinates.
+/// @param[in] constants Packed constants that appear in `L`.
+/// @param[in] coefficients Packed coefficients that appear in `L`.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_overlap(
+    la::Vector<T>& b, const Form<T, U>& L, mdspan2_t x_dofmap,
+    mesh::NodeCoordinates<scalar_value_type_t<T>> x,
+    std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  // Test function mesh
+  auto mesh0 = L.function_spaces().at(0)->mesh();
+  assert(mesh0);
+
+  // Get dofmap data
+  auto element = L.function_spaces().at(0)->element();
+  assert(element);
+  std::shared_ptr<const fem::DofMap> dofmap
+      = L.function_spaces().at(0)->dofmap();
+  assert(dofmap);
+  auto dofs = dofmap->map();
+  const int bs = dofmap->bs();
+  if (b.bs() != bs
+      or b.index_map()->size_local() != dofmap->index_map->size_local())
+  {
+    throw std::runtime_error("Vector is incompatible with the linear form.");
+  }
+  const std::int32_t num_owned = dofmap->index_map->size_local();
+
+  fem::DofTransformKernel<T> auto P0
+      = element->template dof_transformation_fn<T>(doftransform::standard);
+
+  std::span<const std::uint32_t> cell_info0;
+  if (element->needs_dof_transformations() or L.needs_facet_permutations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+  }
+
+  // Assemble cells with ghost dofs. The coefficients of these cells are
+  // copied, and the ranges of interior cells are recorded.
+  std::span<T> _b = b.mutable_array();
+  std::vector<std::int32_t> ids = L.integral_ids(IntegralType::cell);
+  std::vector<std::vector<std::array<std::size_t, 2>>> interior(ids.size());
+  for (std::size_t n = 0; n < ids.size(); ++n)
+  {
+    const int i = ids[n];
+    auto fn = L.kernel(IntegralType::cell, i);
+    assert(fn);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    std::span<const std::int32_t> cells = L.domain(IntegralType::cell, i);
+    std::span<const std::int32_t> cells0
+        = L.domain(IntegralType::cell, i, *mesh0);
+
+    std::optional<CellCoefficientPacker<T, U>> pack;
+    if (pack_cells_deferred(coeffs, cstride, cells.size()))
+      pack.emplace(L, i);
+
+    std::vector<std::int32_t> bcells, bcells0;
+    std::vector<T> bcoeffs;
+    for (std::size_t k = 0; k < cells.size(); ++k)
+    {
+      bool ghosted = false;
+      for (std::size_t j = 0; j < dofs.extent(1); ++j)
+        ghosted = ghosted or dofs(cells0[k], j) >= num_owned;
+
+      if (ghosted)
+      {
+        bcells.push_back(cells[k]);
+        bcells0.push_back(cells0[k]);
+        if (pack)
+        {
+          bcoeffs.resize(bcoeffs.size() + cstride);
+          (*pack)(k, k + 1, std::span(bcoeffs).last(cstride));
+        }
+        else
+        {
+          bcoeffs.insert(bcoeffs.end(),
+                         std::next(coeffs.begin(), k * cstride),
+                         std::next(coeffs.begin(), (k + 1) * cstride));
+        }
+      }
+      else if (interior[n].empty() or interior[n].back()[1] != k)
+        interior[n].push_back({k, k + 1});
+      else
+        interior[n].back()[1] = k + 1;
+    }
+
+    impl::assemble_cells_bs(P0, _b, x_dofmap, x, bcells,
+                            {dofs, bs, bcells0}, fn, constants,
+                            std::span<const T>(bcoeffs), cstride, cell_info0);
+  }
+
+  // Facets may have ghost dofs and are assembled before communication
+  assemble_vector_facets(P0, _b, L, x_dofmap, x, constants, coefficients,
+                         cell_info0);
+
+  // Send ghost contributions to owners
+  b.scatter_rev_begin();
+
+  // Assemble interior cells while messages are in flight
+  for (std::size_t n = 0; n < ids.size(); ++n)
+  {
+    const int i = ids[n];
+    auto fn = L.kernel(IntegralType::cell, i);
+    auto& [coeffs, cstride] = coefficients.at({IntegralType::cell, i});
+    std::span<const std::int32_t> cells = L.domain(IntegralType::cell, i);
+    std::span<const std::int32_t> cells0
+        = L.domain(IntegralType::cell, i, *mesh0);
+    for_each_cell_block(
+        L, i, coeffs, cstride,
+        [&](std::size_t p0, std::size_t p1, std::span<const T> c)
+        {
+          // Assemble the interior cell ranges that overlap [p0, p1)
+          for (auto [k0, k1] : interior[n])
+          {
+            k0 = std::max(k0, p0);
+            k1 = std::min(k1, p1);
+            if (k0 >= k1)
+              continue;
+            impl::assemble_cells_bs(
+                P0, _b, x_dofmap, x, cells.subspan(k0, k1 - k0),
+                {dofs, bs, cells0.subspan(k0, k1 - k0)}, fn,
+                constants,
+                c.subspan((k0 - p0) * cstride, (k1 - k0) * cstride), cstride,
+                cell_info0);
+          }
+        });
+  }
+
+  // Accumulate received ghost contributions
+  b.scatter_rev_end(std::plus<T>());
+}
+
+/// @brief Assemble a linear form into a distributed vector, with the
+/// reverse scatter overlapped with assembly.
+///
+/// See assemble_vector_overlap(la::Vector<T>&, const Form<T, U>&,
+/// mdspan2_t, std::span<const scalar_value_type_t<T>>, std::span<const
+/// T>, const std::map<std::pair<IntegralType, int>,
+/// std::pair<std::span<const T>, int>>&).
+///
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in] constants Packed constants that appear in `L`
+/// @param[in] coefficients Packed coefficients that appear in `L`
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_overlap(
+    la::Vector<T>& b, const Form<T, U>& L, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::assembly);
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    assemble_vector_overlap(b, L, mesh->geometry().dofmap(),
+                            mesh->geometry().coordinates(), constants,
+                            coefficients);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    assemble_vector_overlap(b, L, mesh->geometry().dofmap(), xg, constants,
+                            coefficients);
+  }
+}
 } // namespace dolfinx::fem::impl
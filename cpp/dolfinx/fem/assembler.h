@@ -6,17 +6,30 @@
 
 #pragma once
 
+#include "ScalarReduction.h"
+#include "assemble_cell_types_impl.h"
+#include "assemble_ensemble_impl.h"
+#include "assemble_fused_impl.h"
 #include "assemble_matrix_impl.h"
 #include "assemble_scalar_impl.h"
+#include "assemble_subset_impl.h"
 #include "assemble_vector_impl.h"
 #include "traits.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::fem
@@ -69,13 +82,16 @@ T assemble_scalar(
   if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
   {
     return impl::assemble_scalar(M, mesh->geometry().dofmap(),
-                                 mesh->geometry().x(), constants, coefficients);
+                                 mesh->geometry().coordinates(), constants,
+                                 coefficients);
   }
   else
   {
     auto x = mesh->geometry().x();
     std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
-    return impl::assemble_scalar(M, mesh->geometry().dofmap(), _x, constants,
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    return impl::assemble_scalar(M, mesh->geometry().dofmap(), xg, constants,
                                  coefficients);
   }
 }
@@ -89,12 +105,75 @@ template <dolfinx::scalar T, std::floating_point U>
 T assemble_scalar(const Form<T, U>& M)
 {
   const std::vector<T> constants = pack_constants(M);
-  auto coefficients = allocate_coefficient_storage(M);
+  auto coefficients = allocate_coefficient_storage(M, true);
   pack_coefficients(M, coefficients);
   return assemble_scalar(M, std::span(constants),
                          make_coefficients_span(coefficients));
 }
 
+/// @brief Assemble functionals into scalars with one traversal of the
+/// mesh.
+///
+/// This is equivalent to calling assemble_scalar for each functional,
+/// but cell and exterior facet integrals of the functionals that have
+/// the same integration entities are assembled together, with one
+/// traversal of the entities. The local values can be summed across
+/// processes with one (non-blocking) reduction using a
+/// fem::ScalarReduction.
+///
+/// The functionals must have the same mesh.
+///
+/// @note Caller is responsible for accumulation across processes.
+/// @param[in] M The functionals to assemble.
+/// @param[in] block_size Number of entities in a block. The
+/// coefficients of cell integrals are packed by block during assembly.
+/// @return The contribution to each functional from the local process.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<T>
+assemble_scalars(const std::vector<std::reference_wrapper<const Form<T, U>>>& M,
+                 std::size_t block_size = 64)
+{
+  if (M.empty())
+    return {};
+
+  std::vector<std::vector<T>> constants;
+  std::vector<std::map<std::pair<IntegralType, int>,
+                       std::pair<std::vector<T>, int>>>
+      coeffs;
+  for (const Form<T, U>& form : M)
+  {
+    constants.push_back(pack_constants(form));
+    coeffs.push_back(allocate_coefficient_storage(form, true));
+    pack_coefficients(form, coeffs.back());
+  }
+
+  const std::vector<std::span<const T>> _constants(constants.begin(),
+                                                   constants.end());
+  std::vector<std::map<std::pair<IntegralType, int>,
+                       std::pair<std::span<const T>, int>>>
+      _coeffs;
+  std::ranges::transform(coeffs, std::back_inserter(_coeffs),
+                         [](auto& c) { return make_coefficients_span(c); });
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = M.front().get().mesh();
+  assert(mesh);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    return impl::assemble_scalars(M, mesh->geometry().dofmap(),
+                                  mesh->geometry().coordinates(), _constants,
+                                  _coeffs, block_size);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    return impl::assemble_scalars(M, mesh->geometry().dofmap(), xg,
+                                  _constants, _coeffs, block_size);
+  }
+}
+
 // -- Vectors ----------------------------------------------------------------
 
 /// @brief Assemble linear form into a vector.
@@ -123,13 +202,57 @@ void assemble_vector(
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_vector(std::span<T> b, const Form<T, U>& L)
 {
-  auto coefficients = allocate_coefficient_storage(L);
+  auto coefficients = allocate_coefficient_storage(L, true);
   pack_coefficients(L, coefficients);
   const std::vector<T> constants = pack_constants(L);
   assemble_vector(b, L, std::span(constants),
                   make_coefficients_span(coefficients));
 }
 
+/// @brief Assemble linear form into a distributed vector and
+/// accumulate ghost contributions on the owning ranks.
+///
+/// This is equivalent to assemble_vector followed by
+/// `b.scatter_rev(std::plus<T>())`, but the reverse scatter is
+/// started once the cells with ghost degrees-of-freedom have been
+/// assembled and completes while the remaining cells are assembled.
+///
+/// The caller supplies the form constants and coefficients for this
+/// version, which has efficiency benefits if the data can be re-used
+/// for multiple calls.
+///
+/// @note Collective MPI operation
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear forms to assemble into b
+/// @param[in] constants The constants that appear in `L`
+/// @param[in] coefficients The coefficients that appear in `L`
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_overlap(
+    la::Vector<T>& b, const Form<T, U>& L, std::span<const T> constants,
+    const std::map<std::pair<IntegralType, int>,
+                   std::pair<std::span<const T>, int>>& coefficients)
+{
+  impl::assemble_vector_overlap(b, L, constants, coefficients);
+}
+
+/// @brief Assemble linear form into a distributed vector and
+/// accumulate ghost contributions on the owning ranks, with the
+/// communication overlapped with assembly.
+/// @note Collective MPI operation
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+/// before assembly.
+/// @param[in] L The linear forms to assemble into b
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_overlap(la::Vector<T>& b, const Form<T, U>& L)
+{
+  auto coefficients = allocate_coefficient_storage(L, true);
+  pack_coefficients(L, coefficients);
+  const std::vector<T> constants = pack_constants(L);
+  assemble_vector_overlap(b, L, std::span(constants),
+                          make_coefficients_span(coefficients));
+}
+
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
 
@@ -194,7 +317,7 @@ void apply_lifting(
   {
     if (_a)
     {
-      auto coefficients = allocate_coefficient_storage(_a->get());
+      auto coefficients = allocate_coefficient_storage(_a->get(), true);
       pack_coefficients(_a->get(), coefficients);
       coeffs.push_back(coefficients);
       constants.push_back(pack_constants(_a->get()));
@@ -219,6 +342,50 @@ void apply_lifting(
 
 // -- Matrices ---------------------------------------------------------------
 
+namespace impl
+{
+/// @brief Mark the row (0) and column (1) degrees-of-freedom of a
+/// bilinear form that are constrained by Dirichlet boundary
+/// conditions.
+///
+/// The marker arrays are empty if no boundary condition applies to the
+/// test (0) or trial (1) function space.
+template <dolfinx::scalar T, std::floating_point U>
+std::array<std::vector<std::int8_t>, 2> bc_dof_markers(
+    const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  // Index maps for dof ranges
+  auto map0 = a.function_spaces().at(0)->dofmap()->index_map;
+  auto map1 = a.function_spaces().at(1)->dofmap()->index_map;
+  auto bs0 = a.function_spaces().at(0)->dofmap()->index_map_bs();
+  auto bs1 = a.function_spaces().at(1)->dofmap()->index_map_bs();
+
+  std::vector<std::int8_t> dof_marker0, dof_marker1;
+  assert(map0);
+  std::int32_t dim0 = bs0 * (map0->size_local() + map0->num_ghosts());
+  assert(map1);
+  std::int32_t dim1 = bs1 * (map1->size_local() + map1->num_ghosts());
+  for (std::size_t k = 0; k < bcs.size(); ++k)
+  {
+    assert(bcs[k].get().function_space());
+    if (a.function_spaces().at(0)->contains(*bcs[k].get().function_space()))
+    {
+      dof_marker0.resize(dim0, false);
+      bcs[k].get().mark_dofs(dof_marker0);
+    }
+
+    if (a.function_spaces().at(1)->contains(*bcs[k].get().function_space()))
+    {
+      dof_marker1.resize(dim1, false);
+      bcs[k].get().mark_dofs(dof_marker1);
+    }
+  }
+
+  return {std::move(dof_marker0), std::move(dof_marker1)};
+}
+} // namespace impl
+
 /// @brief Assemble bilinear form into a matrix. Matrix must already be
 /// initialised. Does not zero or finalise the matrix.
 /// @param[in] mat_add The function for adding values into the matrix
@@ -231,6 +398,9 @@ void apply_lifting(
 /// @param[in] dof_marker1 Boundary condition markers for the columns.
 /// If bc[i] is true then rows i in A will be zeroed. The index i is a
 /// local index.
+/// @param[in] num_threads Number of threads to use for assembly. If
+/// greater than one, `mat_add` must be safe to call concurrently for
+/// disjoint sets of rows (see impl::assemble_matrix).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     la::MatSet<T> auto mat_add, const Form<T, U>& a,
@@ -238,7 +408,7 @@ void assemble_matrix(
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
     std::span<const std::int8_t> dof_marker0,
-    std::span<const std::int8_t> dof_marker1)
+    std::span<const std::int8_t> dof_marker1, int num_threads = 1)
 
 {
   std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
@@ -246,15 +416,17 @@ void assemble_matrix(
   if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
   {
     impl::assemble_matrix(mat_add, a, mesh->geometry().dofmap(),
-                          mesh->geometry().x(), constants, coefficients,
-                          dof_marker0, dof_marker1);
+                          mesh->geometry().coordinates(), constants,
+                          coefficients, dof_marker0, dof_marker1, num_threads);
   }
   else
   {
     auto x = mesh->geometry().x();
     std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
-    impl::assemble_matrix(mat_add, a, mesh->geometry().dofmap(), _x, constants,
-                          coefficients, dof_marker0, dof_marker1);
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    impl::assemble_matrix(mat_add, a, mesh->geometry().dofmap(), xg, constants,
+                          coefficients, dof_marker0, dof_marker1, num_threads);
   }
 }
 
@@ -265,44 +437,23 @@ void assemble_matrix(
 /// @param[in] coefficients Coefficients that appear in `a`
 /// @param[in] bcs Boundary conditions to apply. For boundary condition
 ///  dofs the row and column are zeroed. The diagonal  entry is not set.
+/// @param[in] num_threads Number of threads to use for assembly. If
+/// greater than one, `mat_add` must be safe to call concurrently for
+/// disjoint sets of rows (see impl::assemble_matrix).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     auto mat_add, const Form<T, U>& a, std::span<const T> constants,
     const std::map<std::pair<IntegralType, int>,
                    std::pair<std::span<const T>, int>>& coefficients,
-    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
 {
-  // Index maps for dof ranges
-  auto map0 = a.function_spaces().at(0)->dofmap()->index_map;
-  auto map1 = a.function_spaces().at(1)->dofmap()->index_map;
-  auto bs0 = a.function_spaces().at(0)->dofmap()->index_map_bs();
-  auto bs1 = a.function_spaces().at(1)->dofmap()->index_map_bs();
-
   // Build dof markers
-  std::vector<std::int8_t> dof_marker0, dof_marker1;
-  assert(map0);
-  std::int32_t dim0 = bs0 * (map0->size_local() + map0->num_ghosts());
-  assert(map1);
-  std::int32_t dim1 = bs1 * (map1->size_local() + map1->num_ghosts());
-  for (std::size_t k = 0; k < bcs.size(); ++k)
-  {
-    assert(bcs[k].get().function_space());
-    if (a.function_spaces().at(0)->contains(*bcs[k].get().function_space()))
-    {
-      dof_marker0.resize(dim0, false);
-      bcs[k].get().mark_dofs(dof_marker0);
-    }
-
-    if (a.function_spaces().at(1)->contains(*bcs[k].get().function_space()))
-    {
-      dof_marker1.resize(dim1, false);
-      bcs[k].get().mark_dofs(dof_marker1);
-    }
-  }
+  auto [dof_marker0, dof_marker1] = impl::bc_dof_markers(a, bcs);
 
   // Assemble
   assemble_matrix(mat_add, a, constants, coefficients, dof_marker0,
-                  dof_marker1);
+                  dof_marker1, num_threads);
 }
 
 /// Assemble bilinear form into a matrix
@@ -310,19 +461,23 @@ void assemble_matrix(
 /// @param[in] a The bilinear from to assemble
 /// @param[in] bcs Boundary conditions to apply. For boundary condition
 ///  dofs the row and column are zeroed. The diagonal  entry is not set.
+/// @param[in] num_threads Number of threads to use for assembly. If
+/// greater than one, `mat_add` must be safe to call concurrently for
+/// disjoint sets of rows (see impl::assemble_matrix).
 template <dolfinx::scalar T, std::floating_point U>
 void assemble_matrix(
     auto mat_add, const Form<T, U>& a,
-    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    int num_threads = 1)
 {
   // Prepare constants and coefficients
   const std::vector<T> constants = pack_constants(a);
-  auto coefficients = allocate_coefficient_storage(a);
+  auto coefficients = allocate_coefficient_storage(a, true);
   pack_coefficients(a, coefficients);
 
   // Assemble
   assemble_matrix(mat_add, a, std::span(constants),
-                  make_coefficients_span(coefficients), bcs);
+                  make_coefficients_span(coefficients), bcs, num_threads);
 }
 
 /// @brief Assemble bilinear form into a matrix. Matrix must already be
@@ -343,7 +498,7 @@ void assemble_matrix(auto mat_add, const Form<T, U>& a,
 {
   // Prepare constants and coefficients
   const std::vector<T> constants = pack_constants(a);
-  auto coefficients = allocate_coefficient_storage(a);
+  auto coefficients = allocate_coefficient_storage(a, true);
   pack_coefficients(a, coefficients);
 
   // Assemble
@@ -405,4 +560,678 @@ void set_diagonal(
     }
   }
 }
+
+namespace impl
+{
+/// @brief Assemble the diagonal or the row sums of a bilinear form into
+/// a vector (see fem::assemble_diagonal and fem::assemble_lumped).
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_diagonal(
+    la::Vector<T>& d, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    T diagonal, bool lumped, int num_threads)
+{
+  if (a.rank() != 2)
+    throw std::runtime_error("Form must be a bilinear form.");
+  std::shared_ptr<const FunctionSpace<U>> V = a.function_spaces().at(0);
+  std::shared_ptr<const DofMap> dofmap = V->dofmap();
+  if (d.index_map() != dofmap->index_map or d.bs() != dofmap->bs())
+    throw std::runtime_error("Vector does not match the test space.");
+  if (!lumped and a.function_spaces().at(1)->dofmap() != dofmap)
+  {
+    throw std::runtime_error(
+        "Diagonal assembly requires the same test and trial space.");
+  }
+
+  // Ghost entries are used to accumulate contributions for the owners
+  const int bs = d.bs();
+  const std::size_t num_owned = d.index_map()->size_local() * bs;
+  std::span<T> x = d.mutable_array();
+  std::fill(std::next(x.begin(), num_owned), x.end(), T(0));
+
+  // Keep the diagonal or the row sums of the element matrices. A dof
+  // can appear more than once in the rows and columns of an interior
+  // facet matrix, so all matching entries are added.
+  auto mat_add = [x, bs, lumped](std::span<const std::int32_t> rows,
+                                 std::span<const std::int32_t> cols,
+                                 std::span<const T> Ae)
+  {
+    const std::size_t ncols = cols.size() * bs;
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      for (int k = 0; k < bs; ++k)
+      {
+        const T* Ae_row = Ae.data() + (i * bs + k) * ncols;
+        T& xi = x[rows[i] * bs + k];
+        if (lumped)
+          xi = std::accumulate(Ae_row, Ae_row + ncols, xi);
+        else
+        {
+          for (std::size_t j = 0; j < cols.size(); ++j)
+          {
+            if (cols[j] == rows[i])
+              xi += Ae_row[j * bs + k];
+          }
+        }
+      }
+    }
+    return 0;
+  };
+  assemble_matrix(mat_add, a, bcs, num_threads);
+  d.scatter_rev(std::plus<T>());
+
+  // Set the value of owned boundary condition dofs
+  for (auto& bc : bcs)
+  {
+    if (V->contains(*bc.get().function_space()))
+    {
+      auto [dofs, range] = bc.get().dof_indices();
+      for (std::int32_t dof : dofs.first(range))
+        x[dof] = diagonal;
+    }
+  }
+
+  d.scatter_fwd();
+}
+} // namespace impl
+
+/// @brief Assemble the diagonal of the matrix of a bilinear form into
+/// a vector, without storing the matrix.
+///
+/// The element matrices are computed as for assemble_matrix, but only
+/// their diagonal entries are kept. The diagonal is used for Jacobi
+/// and Chebyshev smoothers of matrix-free operators. Contributions to
+/// ghost entries are accumulated on the owning processes, and the ghost
+/// entries are updated with the owned values.
+///
+/// @note Collective MPI operation
+/// @param[in,out] d Vector to assemble into. Must have the index map
+/// and block size of the test space. The owned values of `d` are not
+/// zeroed before assembly.
+/// @param[in] a Bilinear form with the same test and trial space.
+/// @param[in] bcs Boundary conditions. For boundary condition dofs the
+/// rows and columns of the matrix are zeroed, and the diagonal is set
+/// to `diagonal`.
+/// @param[in] diagonal Value of the diagonal for boundary condition
+/// dofs.
+/// @param[in] num_threads Number of threads to use for assembly.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_diagonal(
+    la::Vector<T>& d, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs
+    = {},
+    T diagonal = 1.0, int num_threads = 1)
+{
+  impl::assemble_diagonal(d, a, bcs, diagonal, false, num_threads);
+}
+
+/// @brief Assemble the row sums of the matrix of a bilinear form into a
+/// vector, without storing the matrix.
+///
+/// For a mass matrix, this is the lumped mass matrix used for explicit
+/// dynamics. The element matrices are computed as for assemble_matrix
+/// and summed over the columns of each row. Contributions to ghost
+/// entries are accumulated on the owning processes, and the ghost
+/// entries are updated with the owned values.
+///
+/// @note Collective MPI operation
+/// @param[in,out] d Vector to assemble into. Must have the index map
+/// and block size of the test space. The owned values of `d` are not
+/// zeroed before assembly.
+/// @param[in] a Bilinear form.
+/// @param[in] bcs Boundary conditions. For boundary condition dofs the
+/// rows and columns of the matrix are zeroed, and the row sum is set
+/// to `diagonal`.
+/// @param[in] diagonal Value of the row sum for boundary condition
+/// dofs.
+/// @param[in] num_threads Number of threads to use for assembly.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_lumped(
+    la::Vector<T>& d, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs
+    = {},
+    T diagonal = 1.0, int num_threads = 1)
+{
+  impl::assemble_diagonal(d, a, bcs, diagonal, true, num_threads);
+}
+
+// -- Fused assembly ---------------------------------------------------------
+
+/// @brief Assemble a bilinear form into a matrix, a linear form into a
+/// vector and a functional into a scalar with one traversal of the mesh
+/// cells.
+///
+/// This is equivalent to calling assemble_matrix, assemble_vector and
+/// assemble_scalar for the forms, but cell integrals of the forms that
+/// have the same integration domain are assembled together in blocks
+/// of cells. The mesh geometry, dofmap and coefficient data of a block
+/// of cells is then read from memory once for all forms. The
+/// coefficients of cell integrals are packed by block during assembly.
+///
+/// The forms must have the same mesh. Any of the forms can be
+/// `nullptr`.
+///
+/// @note Caller is responsible for accumulation of the scalar across
+/// processes, and for the reverse scatter of `b`.
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in] a The bilinear form to assemble.
+/// @param[in] bcs Boundary conditions to apply to the matrix. For
+/// boundary condition dofs the row and column are zeroed. The diagonal
+/// entry is not set.
+/// @param[in,out] b The vector to assemble `L` into. It will not be
+/// zeroed before assembly.
+/// @param[in] L The linear form to assemble.
+/// @param[in] M The functional to assemble.
+/// @param[in] block_size Number of cells in a block.
+/// @return The contribution to the functional from the local process.
+template <dolfinx::scalar T, std::floating_point U>
+T assemble_fused(
+    la::MatSet<T> auto mat_add, const Form<T, U>* a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    std::span<T> b, const Form<T, U>* L, const Form<T, U>* M,
+    std::size_t block_size = 64)
+{
+  const std::array<const Form<T, U>*, 3> forms = {a, L, M};
+  std::array<std::vector<T>, 3> constants;
+  std::array<std::map<std::pair<IntegralType, int>,
+                      std::pair<std::vector<T>, int>>,
+             3>
+      coeffs;
+  std::shared_ptr<const mesh::Mesh<U>> mesh;
+  for (std::size_t k = 0; k < forms.size(); ++k)
+  {
+    if (forms[k])
+    {
+      mesh = forms[k]->mesh();
+      constants[k] = pack_constants(*forms[k]);
+      coeffs[k] = allocate_coefficient_storage(*forms[k], true);
+      pack_coefficients(*forms[k], coeffs[k]);
+    }
+  }
+
+  if (!mesh)
+    return T(0);
+
+  std::array<std::vector<std::int8_t>, 2> bc_markers;
+  if (a)
+    bc_markers = impl::bc_dof_markers(*a, bcs);
+
+  const std::array<std::span<const T>, 3> _constants
+      = {constants[0], constants[1], constants[2]};
+  const std::array<std::map<std::pair<IntegralType, int>,
+                            std::pair<std::span<const T>, int>>,
+                   3>
+      _coeffs = {make_coefficients_span(coeffs[0]),
+                 make_coefficients_span(coeffs[1]),
+                 make_coefficients_span(coeffs[2])};
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    return impl::assemble_fused(
+        mat_add, a, bc_markers[0], bc_markers[1], b, L, M,
+        mesh->geometry().dofmap(), mesh->geometry().coordinates(), _constants,
+        _coeffs, block_size);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    return impl::assemble_fused(mat_add, a, bc_markers[0], bc_markers[1], b,
+                                L, M, mesh->geometry().dofmap(), xg,
+                                _constants, _coeffs, block_size);
+  }
+}
+
+// -- Ensembles of coefficient samples ---------------------------------------
+
+namespace impl
+{
+/// @brief Pack the coefficients of a form for each sample of an
+/// ensemble.
+/// @param[in] form The form.
+/// @param[in] samples Functions of each sample, in the order of the
+/// coefficients of the form.
+/// @return Packed coefficients of each sample.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<
+    std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>>
+pack_ensemble_coefficients(
+    const Form<T, U>& form,
+    const std::vector<std::vector<std::shared_ptr<const Function<T, U>>>>&
+        samples)
+{
+  std::vector<
+      std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>>
+      coeffs;
+  for (auto& functions : samples)
+  {
+    coeffs.push_back(allocate_coefficient_storage(form));
+    pack_coefficients(form, functions, coeffs.back());
+  }
+  return coeffs;
+}
+} // namespace impl
+
+/// @brief Assemble a linear form for an ensemble of coefficient
+/// samples, e.g. for uncertainty quantification.
+///
+/// The samples share the mesh, dofmaps and constants of the form and
+/// differ in the values of the coefficients. The cell integrals are
+/// assembled for all samples with one traversal of the cells, with the
+/// geometry and dofs of a cell gathered once, and the kernel executed
+/// for each sample. The vectors of the samples are interleaved, i.e.
+/// the value of sample `s` at (unrolled) dof `i` is `b[i * ns + s]`,
+/// where `ns` is the number of samples, such that the cell vectors of
+/// the samples are accumulated with unit stride.
+///
+/// @param[in,out] b Vector with interleaved samples, of size `ns * n`,
+/// where `n` is the local (owned and ghost) size of the test space. It
+/// is not zeroed.
+/// @param[in] L The linear form.
+/// @param[in] constants Packed constants of `L`, shared by the samples.
+/// @param[in] coefficients Packed coefficients of `L` for each sample.
+/// The coefficients of cell integrals must be packed.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_ensemble(
+    std::span<T> b, const Form<T, U>& L, std::span<const T> constants,
+    std::span<const std::map<std::pair<IntegralType, int>,
+                             std::pair<std::span<const T>, int>>>
+        coefficients)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_vector_ensemble(b, L, mesh->geometry().dofmap(),
+                                   mesh->geometry().coordinates(), constants,
+                                   coefficients);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    impl::assemble_vector_ensemble(b, L, mesh->geometry().dofmap(), xg,
+                                   constants, coefficients);
+  }
+}
+
+/// @brief Assemble a linear form for an ensemble of coefficient
+/// samples (see assemble_vector_ensemble).
+/// @param[in,out] b Vector with interleaved samples. It is not zeroed.
+/// @param[in] L The linear form.
+/// @param[in] samples Functions of each sample, in the order of the
+/// coefficients of `L` (see fem::pack_coefficients).
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_ensemble(
+    std::span<T> b, const Form<T, U>& L,
+    const std::vector<std::vector<std::shared_ptr<const Function<T, U>>>>&
+        samples)
+{
+  const std::vector<T> constants = pack_constants(L);
+  auto coeffs = impl::pack_ensemble_coefficients(L, samples);
+  std::vector<std::map<std::pair<IntegralType, int>,
+                       std::pair<std::span<const T>, int>>>
+      _coeffs;
+  std::ranges::transform(coeffs, std::back_inserter(_coeffs),
+                         [](auto& c) { return make_coefficients_span(c); });
+  assemble_vector_ensemble(b, L, std::span<const T>(constants),
+                           std::span(std::as_const(_coeffs)));
+}
+
+/// @brief Assemble a bilinear form for an ensemble of coefficient
+/// samples into matrices that share a sparsity pattern.
+///
+/// The samples share the mesh, dofmaps, constants and boundary
+/// conditions of the form and differ in the values of the
+/// coefficients. The cell integrals are assembled for all samples with
+/// one traversal of the cells, and each element matrix is located in
+/// the sparsity pattern once for all samples. The values of the
+/// matrices are interleaved, i.e. the value of sample `s` at position
+/// `p` of the value array of `A` (la::MatrixCSR::values) is
+/// `values[p * ns + s]`, where `ns` is the number of samples.
+///
+/// @tparam BS0 Row block size of the data, as used with
+/// la::MatrixCSR::mat_add_values.
+/// @tparam BS1 Column block size of the data, as used with
+/// la::MatrixCSR::mat_add_values.
+/// @param[in,out] values Matrix values with interleaved samples, of
+/// size `ns * A.values().size()`. They are not zeroed.
+/// @param[in] A Matrix with the sparsity pattern of the samples. Its
+/// values are not used.
+/// @param[in] a The bilinear form.
+/// @param[in] constants Packed constants of `a`, shared by the samples.
+/// @param[in] coefficients Packed coefficients of `a` for each sample.
+/// The coefficients of cell integrals must be packed.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+template <int BS0 = 1, int BS1 = 1, dolfinx::scalar T, std::floating_point U,
+          typename Mat>
+void assemble_matrix_ensemble(
+    std::span<T> values, const Mat& A, const Form<T, U>& a,
+    std::span<const T> constants,
+    std::span<const std::map<std::pair<IntegralType, int>,
+                             std::pair<std::span<const T>, int>>>
+        coefficients,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  auto [bc0, bc1] = impl::bc_dof_markers(a, bcs);
+  auto mat_pos = [&A](std::span<const std::int32_t> rows,
+                      std::span<const std::int32_t> cols,
+                      std::span<std::int64_t> pos)
+  { A.template value_positions<BS0, BS1>(rows, cols, pos); };
+
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_matrix_ensemble(
+        mat_pos, values, a, mesh->geometry().dofmap(),
+        mesh->geometry().coordinates(), constants, coefficients,
+        std::span<const std::int8_t>(bc0), std::span<const std::int8_t>(bc1));
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    impl::assemble_matrix_ensemble(
+        mat_pos, values, a, mesh->geometry().dofmap(), xg, constants,
+        coefficients, std::span<const std::int8_t>(bc0),
+        std::span<const std::int8_t>(bc1));
+  }
+}
+
+/// @brief Assemble a bilinear form for an ensemble of coefficient
+/// samples into matrices that share a sparsity pattern (see
+/// assemble_matrix_ensemble).
+/// @param[in,out] values Matrix values with interleaved samples. They
+/// are not zeroed.
+/// @param[in] A Matrix with the sparsity pattern of the samples.
+/// @param[in] a The bilinear form.
+/// @param[in] samples Functions of each sample, in the order of the
+/// coefficients of `a` (see fem::pack_coefficients).
+/// @param[in] bcs Boundary conditions to apply.
+template <int BS0 = 1, int BS1 = 1, dolfinx::scalar T, std::floating_point U,
+          typename Mat>
+void assemble_matrix_ensemble(
+    std::span<T> values, const Mat& A, const Form<T, U>& a,
+    const std::vector<std::vector<std::shared_ptr<const Function<T, U>>>>&
+        samples,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  const std::vector<T> constants = pack_constants(a);
+  auto coeffs = impl::pack_ensemble_coefficients(a, samples);
+  std::vector<std::map<std::pair<IntegralType, int>,
+                       std::pair<std::span<const T>, int>>>
+      _coeffs;
+  std::ranges::transform(coeffs, std::back_inserter(_coeffs),
+                         [](auto& c) { return make_coefficients_span(c); });
+  assemble_matrix_ensemble<BS0, BS1>(values, A, a,
+                                     std::span<const T>(constants),
+                                     std::span(std::as_const(_coeffs)), bcs);
+}
+
+// -- Assembly over a subset of cells ----------------------------------------
+
+namespace impl
+{
+/// @brief Create a marker for the local (owned and ghost) cells of a
+/// mesh that are in a list of cells.
+template <std::floating_point U>
+std::vector<std::int8_t> mark_cells(const mesh::Mesh<U>& mesh,
+                                    std::span<const std::int32_t> cells)
+{
+  auto map = mesh.topology()->index_map(mesh.topology()->dim());
+  assert(map);
+  std::vector<std::int8_t> marker(map->size_local() + map->num_ghosts(),
+                                  false);
+  for (std::int32_t c : cells)
+    marker[c] = true;
+  return marker;
+}
+} // namespace impl
+
+/// @brief Add the contributions of the integration entities attached to
+/// a set of cells to a matrix.
+///
+/// The cell integrals over the cells in `cells`, and the facet
+/// integrals over facets attached to a cell in `cells`, are assembled
+/// with the element matrices multiplied by `scale`. This supports
+/// incremental re-assembly when the coefficients change only on a
+/// small set of cells: with `scale = -1` before the coefficients are
+/// updated the old contributions are subtracted, and with `scale = 1`
+/// after the update the new contributions are added. The cost is
+/// proportional to the number of cells in `cells`, except for the
+/// packing of facet integral coefficients, which are packed for all
+/// facets of the integration domain.
+///
+/// @note The matrix must already be initialised and is not finalised.
+/// Diagonal entries for boundary condition dofs are not changed.
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in] a The bilinear form.
+/// @param[in] cells Cells of the integration domain mesh.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed.
+/// @param[in] scale Scale factor applied to the element matrices.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_subset(
+    la::MatSet<T> auto mat_add, const Form<T, U>& a,
+    std::span<const std::int32_t> cells,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs,
+    T scale = 1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  const std::vector<T> constants = pack_constants(a);
+  auto coefficients = allocate_coefficient_storage(a, true);
+  pack_coefficients(a, coefficients);
+  auto [bc0, bc1] = impl::bc_dof_markers(a, bcs);
+  const std::vector<std::int8_t> marker = impl::mark_cells(*mesh, cells);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_matrix_subset(mat_add, a, mesh->geometry().dofmap(),
+                                 mesh->geometry().coordinates(),
+                                 std::span(constants),
+                                 make_coefficients_span(coefficients), bc0,
+                                 bc1, marker, scale);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    impl::assemble_matrix_subset(mat_add, a, mesh->geometry().dofmap(), xg,
+                                 std::span(constants),
+                                 make_coefficients_span(coefficients), bc0,
+                                 bc1, marker, scale);
+  }
+}
+
+/// @brief Add the contributions of the integration entities attached to
+/// a set of cells to a vector.
+///
+/// See assemble_matrix_subset for the entities that are assembled and
+/// the use for incremental re-assembly.
+///
+/// @note Boundary condition lifting is not applied.
+/// @param[in,out] b The vector to assemble into. It is not zeroed.
+/// @param[in] L The linear form.
+/// @param[in] cells Cells of the integration domain mesh.
+/// @param[in] scale Scale factor applied to the element vectors.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_subset(std::span<T> b, const Form<T, U>& L,
+                            std::span<const std::int32_t> cells,
+                            T scale = 1)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = L.mesh();
+  assert(mesh);
+  const std::vector<T> constants = pack_constants(L);
+  auto coefficients = allocate_coefficient_storage(L, true);
+  pack_coefficients(L, coefficients);
+  const std::vector<std::int8_t> marker = impl::mark_cells(*mesh, cells);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_vector_subset(b, L, mesh->geometry().dofmap(),
+                                 mesh->geometry().coordinates(),
+                                 std::span(constants),
+                                 make_coefficients_span(coefficients), marker,
+                                 scale);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    impl::assemble_vector_subset(b, L, mesh->geometry().dofmap(), xg,
+                                 std::span(constants),
+                                 make_coefficients_span(coefficients), marker,
+                                 scale);
+  }
+}
+
+// -- Assembly over the cell types of a mixed-topology mesh ------------------
+
+/// @brief Add cell integrals over the cell types of a mixed-topology
+/// mesh to a matrix.
+///
+/// The cells of each type are stored contiguously, and each integral
+/// in `integrals` is assembled as one batch with a kernel loop that is
+/// specialised to the element dimensions of its cell type. Integrals
+/// are executed grouped by cell type.
+///
+/// @note The matrix is not zeroed or finalised. Dof transformations
+/// are not applied.
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in] mesh The mesh.
+/// @param[in] integrals Cell integrals over the cell types of `mesh`.
+/// @param[in] constants Packed constants, shared by all integrals.
+/// @param[in] bc0 Marker for rows with Dirichlet boundary conditions,
+/// or empty.
+/// @param[in] bc1 Marker for columns with Dirichlet boundary
+/// conditions, or empty.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_cell_types(la::MatSet<T> auto mat_add,
+                                const mesh::Mesh<U>& mesh,
+                                std::span<const CellTypeIntegral<T>> integrals,
+                                std::span<const T> constants,
+                                std::span<const std::int8_t> bc0 = {},
+                                std::span<const std::int8_t> bc1 = {})
+{
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_matrix_cell_types(mat_add, mesh.geometry(),
+                                     mesh.geometry().coordinates(), integrals,
+                                     constants, bc0, bc1);
+  }
+  else
+  {
+    auto x = mesh.geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh.geometry().x_stride());
+    impl::assemble_matrix_cell_types(mat_add, mesh.geometry(), xg, integrals,
+                                     constants, bc0, bc1);
+  }
+}
+
+/// @brief Add cell integrals over the cell types of a mixed-topology
+/// mesh to a vector.
+///
+/// See assemble_matrix_cell_types.
+///
+/// @param[in,out] b The vector to assemble into. It is not zeroed.
+/// @param[in] mesh The mesh.
+/// @param[in] integrals Cell integrals over the cell types of `mesh`.
+/// @param[in] constants Packed constants, shared by all integrals.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_vector_cell_types(std::span<T> b, const mesh::Mesh<U>& mesh,
+                                std::span<const CellTypeIntegral<T>> integrals,
+                                std::span<const T> constants)
+{
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_vector_cell_types(b, mesh.geometry(),
+                                     mesh.geometry().coordinates(), integrals,
+                                     constants);
+  }
+  else
+  {
+    auto x = mesh.geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh.geometry().x_stride());
+    impl::assemble_vector_cell_types(b, mesh.geometry(), xg, integrals,
+                                     constants);
+  }
+}
+
+// -- Owner-computes assembly ------------------------------------------------
+
+/// @brief Assemble the owned rows of a bilinear form into a matrix
+/// without communication (owner-computes assembly).
+///
+/// Standard assembly computes the element matrices of the owned cells
+/// and adds entries to ghost rows, which are sent to the owning
+/// processes by la::MatrixCSR::scatter_rev. Here each process computes
+/// the element matrices of its owned and ghost cells and adds only the
+/// entries of its owned rows, so that the owned rows are complete
+/// without a reverse scatter. This trades the kernel evaluations on
+/// the ghost cells for the storage of the ghost rows and the reverse
+/// communication.
+///
+/// The matrix should be created from the pattern of
+/// create_sparsity_pattern_owned, and la::MatrixCSR::scatter_rev is
+/// not called after assembly (la::MatrixCSR::add_accumulated is called
+/// instead if the values are added with a different scalar type).
+///
+/// @pre Every cell that contains a degree-of-freedom owned by this
+/// process is a local (owned or ghost) cell. In general, this requires
+/// a mesh created with mesh::GhostMode::shared_vertex.
+/// mesh::GhostMode::shared_facet is sufficient if degrees-of-freedom
+/// are shared by cells through facets only (e.g. Crouzeix-Raviart or
+/// discontinuous spaces).
+/// @pre The ghost values of the coefficients are up to date.
+///
+/// @param[in] mat_add The function for adding values into the matrix.
+/// @param[in] a The bilinear form, with cell integrals over the
+/// default integration domain only.
+/// @param[in] bcs Boundary conditions to apply. For boundary condition
+/// dofs the row and column are zeroed. The diagonal entry is not set.
+template <dolfinx::scalar T, std::floating_point U>
+void assemble_matrix_owned(
+    la::MatSet<T> auto mat_add, const Form<T, U>& a,
+    const std::vector<std::reference_wrapper<const DirichletBC<T, U>>>& bcs)
+{
+  std::shared_ptr<const mesh::Mesh<U>> mesh = a.mesh();
+  assert(mesh);
+  const std::vector<T> constants = pack_constants(a);
+  auto coefficients = allocate_coefficient_storage(a, true);
+  pack_coefficients(a, coefficients);
+  auto [bc0, bc1] = impl::bc_dof_markers(a, bcs);
+  if constexpr (std::is_same_v<U, scalar_value_type_t<T>>)
+  {
+    impl::assemble_matrix_owned(mat_add, a, mesh->geometry().dofmap(),
+                                mesh->geometry().coordinates(),
+                                std::span(constants),
+                                make_coefficients_span(coefficients), bc0,
+                                bc1);
+  }
+  else
+  {
+    auto x = mesh->geometry().x();
+    std::vector<scalar_value_type_t<T>> _x(x.begin(), x.end());
+    const mesh::NodeCoordinates<scalar_value_type_t<T>> xg(
+        _x, mesh->geometry().x_stride());
+    impl::assemble_matrix_owned(mat_add, a, mesh->geometry().dofmap(), xg,
+                                std::span(constants),
+                                make_coefficients_span(coefficients), bc0,
+                                bc1);
+  }
+}
 } // namespace dolfinx::fem
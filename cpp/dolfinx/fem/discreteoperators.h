@@ -6,22 +6,257 @@
 
 #pragma once
 
+#include "CoordinateElement.h"
 #include "DofMap.h"
 #include "FiniteElement.h"
 #include "FunctionSpace.h"
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/math.h>
+#include <dolfinx/la/MatrixCSR.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace dolfinx::fem
 {
 
+namespace impl
+{
+/// @brief Compute the element matrix of the discrete gradient operator
+/// on the reference cell.
+/// @param[in] e0 Lagrange element to interpolate the gradient from
+/// @param[in] e1 Nédélec (first kind) element to interpolate into
+/// @param[in] tdim Topological dimension of the cell
+/// @return Element matrix (row-major), `shape=(e1 space dimension, e0
+/// space dimension)`
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<T> discrete_gradient_element(const FiniteElement<U>& e0,
+                                         const FiniteElement<U>& e1, int tdim)
+{
+  using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
+
+  // Check elements
+  if (e0.map_type() != basix::maps::type::identity)
+    throw std::runtime_error("Wrong finite element space for V0.");
+  if (e0.block_size() != 1)
+    throw std::runtime_error("Block size is greater than 1 for V0.");
+  if (e0.reference_value_size() != 1)
+    throw std::runtime_error("Wrong value size for V0.");
+
+  if (e1.map_type() != basix::maps::type::covariantPiola)
+    throw std::runtime_error("Wrong finite element space for V1.");
+  if (e1.block_size() != 1)
+    throw std::runtime_error("Block size is greater than 1 for V1.");
+
+  // Get V0 (H(curl)) space interpolation points
+  const auto [X, Xshape] = e1.interpolation_points();
+
+  // Tabulate first order derivatives of Lagrange space at H(curl)
+  // interpolation points
+  const int ndofs0 = e0.space_dimension();
+  std::vector<U> phi0_b((tdim + 1) * Xshape[0] * ndofs0 * 1);
+  cmdspan4_t phi0(phi0_b.data(), tdim + 1, Xshape[0], ndofs0, 1);
+  e0.tabulate(phi0_b, X, Xshape, 1);
+
+  // Reshape lagrange basis derivatives as a matrix of shape (tdim *
+  // num_points, num_dofs_per_cell)
+  cmdspan2_t dphi_reshaped(
+      phi0_b.data() + phi0.extent(3) * phi0.extent(2) * phi0.extent(1),
+      tdim * phi0.extent(1), phi0.extent(2));
+
+  // Build the element interpolation matrix
+  std::vector<T> Ab(e1.space_dimension() * ndofs0);
+  {
+    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
+        A(Ab.data(), e1.space_dimension(), ndofs0);
+    const auto [Pi, shape] = e1.interpolation_operator();
+    cmdspan2_t _Pi(Pi.data(), shape);
+    math::dot(_Pi, dphi_reshaped, A);
+  }
+
+  // Clamp values
+  std::ranges::transform(Ab, Ab.begin(),
+                         [atol = 1e-14](auto x)
+                         { return std::abs(x) < atol ? T(0) : x; });
+
+  return Ab;
+}
+
+/// @brief Create the CSR matrix of a discrete operator from its element
+/// matrices.
+///
+/// The rows of a discrete operator are the same on every cell that
+/// contains the row degree-of-freedom. Each owned row is therefore
+/// taken from the element matrix of one cell, and the matrix is built
+/// directly in CSR format without a sparsity pattern or a reverse
+/// scatter. The element matrices are computed, and the rows filled, in
+/// parallel by threads that each operate on a disjoint set of cells.
+///
+/// @param[in] dofmap0 Dofmap of the space of the columns
+/// @param[in] dofmap1 Dofmap of the space of the rows
+/// @param[in] num_cells Number of local cells (owned and ghost)
+/// @param[in] tabulate Function called as `tabulate(cells, insert)` to
+/// compute the element matrices on `cells`, calling `insert(c, Ae)`
+/// with the element matrix `Ae` (row-major, `shape=(dofmap1 cell size,
+/// dofmap0 cell size)`, unrolled for the block sizes) of each cell
+/// `c`. It is called from multiple threads if `num_threads > 1`.
+/// @param[in] drop_zeros If true, blocks of entries that are all zero
+/// are not stored.
+/// @param[in] num_threads Number of threads
+/// @param[in] cells0 Cell of `dofmap0` for each cell of `dofmap1`, if
+/// the dofmaps are on different meshes. If empty, the column dofs of
+/// cell `c` are taken from cell `c` of `dofmap0`.
+/// @return The operator matrix, with block sizes of the dofmaps
+template <dolfinx::scalar T>
+la::MatrixCSR<T>
+create_operator_matrix(const DofMap& dofmap0, const DofMap& dofmap1,
+                       std::int32_t num_cells, auto&& tabulate,
+                       bool drop_zeros, int num_threads,
+                       std::span<const std::int32_t> cells0 = {})
+{
+  auto map0 = dofmap0.index_map;
+  auto map1 = dofmap1.index_map;
+  assert(map0 and map1);
+  const int bs0 = dofmap0.bs();
+  const int bs1 = dofmap1.bs();
+  assert(bs0 == dofmap0.index_map_bs() and bs1 == dofmap1.index_map_bs());
+  const std::size_t bs2 = bs0 * bs1;
+  const std::size_t ndofs0 = dofmap0.map().extent(1);
+  const std::size_t ndofs1 = dofmap1.map().extent(1);
+  const std::int32_t num_rows = map1->size_local();
+
+  // Assign each owned row to the first cell that contains it
+  std::vector<std::int32_t> row_cell(num_rows, -1);
+  std::vector<std::int32_t> cells;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    bool has_rows = false;
+    for (std::int32_t dof : dofmap1.cell_dofs(c))
+    {
+      if (dof < num_rows and row_cell[dof] < 0)
+      {
+        row_cell[dof] = c;
+        has_rows = true;
+      }
+    }
+    if (has_rows)
+      cells.push_back(c);
+  }
+  assert(std::ranges::find(row_cell, -1) == row_cell.end());
+
+  // Each row has the (sorted) column dofs of its cell
+  std::vector<std::int32_t> cols(num_rows * ndofs0);
+  std::vector<T> data(cols.size() * bs2);
+  auto insert = [&](std::int32_t c, std::span<const T> Ae)
+  {
+    std::span<const std::int32_t> dofs0
+        = dofmap0.cell_dofs(cells0.empty() ? c : cells0[c]);
+    std::span<const std::int32_t> dofs1 = dofmap1.cell_dofs(c);
+    std::array<std::int32_t, 64> perm_b;
+    std::vector<std::int32_t> perm_v;
+    std::span<std::int32_t> perm;
+    if (ndofs0 <= perm_b.size())
+      perm = std::span(perm_b.data(), ndofs0);
+    else
+    {
+      perm_v.resize(ndofs0);
+      perm = perm_v;
+    }
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::sort(perm, [&dofs0](auto a, auto b)
+                      { return dofs0[a] < dofs0[b]; });
+
+    const std::size_t ncols = ndofs0 * bs0;
+    for (std::size_t i = 0; i < ndofs1; ++i)
+    {
+      const std::int32_t row = dofs1[i];
+      if (row >= num_rows or row_cell[row] != c)
+        continue;
+      for (std::size_t j = 0; j < ndofs0; ++j)
+      {
+        const std::size_t pos = row * ndofs0 + j;
+        cols[pos] = dofs0[perm[j]];
+        for (int k1 = 0; k1 < bs1; ++k1)
+        {
+          for (int k0 = 0; k0 < bs0; ++k0)
+          {
+            data[pos * bs2 + k1 * bs0 + k0]
+                = Ae[(i * bs1 + k1) * ncols + perm[j] * bs0 + k0];
+          }
+        }
+      }
+    }
+  };
+
+  if (num_threads < 2)
+    tabulate(std::span<const std::int32_t>(cells), insert);
+  else
+  {
+    common::thread_pool().run(
+        num_threads,
+        [&](int t)
+        {
+          auto [c0, c1]
+              = dolfinx::MPI::local_range(t, cells.size(), num_threads);
+          tabulate(std::span<const std::int32_t>(cells).subspan(c0, c1 - c0),
+                   insert);
+        });
+  }
+
+  // Row offsets (ghost rows are empty)
+  std::vector<std::int64_t> row_ptr(num_rows + map1->num_ghosts() + 1);
+  if (drop_zeros)
+  {
+    std::size_t k = 0;
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      for (std::size_t j = i * ndofs0; j < (i + 1) * ndofs0; ++j)
+      {
+        auto block = std::span(data).subspan(j * bs2, bs2);
+        if (std::ranges::any_of(block, [](auto x) { return x != T(0); }))
+        {
+          if (k != j)
+          {
+            cols[k] = cols[j];
+            std::ranges::copy(block, std::next(data.begin(), k * bs2));
+          }
+          ++k;
+        }
+      }
+      row_ptr[i + 1] = k;
+    }
+    cols.resize(k);
+    data.resize(k * bs2);
+  }
+  else
+  {
+    for (std::int32_t i = 0; i < num_rows; ++i)
+      row_ptr[i + 1] = (i + 1) * ndofs0;
+  }
+  std::fill(std::next(row_ptr.begin(), num_rows + 1), row_ptr.end(),
+            row_ptr[num_rows]);
+
+  return la::MatrixCSR<T>({map1, map0}, {bs1, bs0}, std::move(cols),
+                          std::move(row_ptr), std::move(data));
+}
+} // namespace impl
+
 /// @brief Assemble a discrete gradient operator.
 ///
 /// The discrete gradient operator \f$A\f$ interpolates the gradient of
@@ -64,42 +299,10 @@ void discrete_gradient(mesh::Topology& topology,
   auto& e1 = V1.first.get();
   const DofMap& dofmap1 = V1.second.get();
 
-  using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
-  using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-      U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
-  using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
-
-  // Check elements
-  if (e0.map_type() != basix::maps::type::identity)
-    throw std::runtime_error("Wrong finite element space for V0.");
-  if (e0.block_size() != 1)
-    throw std::runtime_error("Block size is greater than 1 for V0.");
-  if (e0.reference_value_size() != 1)
-    throw std::runtime_error("Wrong value size for V0.");
-
-  if (e1.map_type() != basix::maps::type::covariantPiola)
-    throw std::runtime_error("Wrong finite element space for V1.");
-  if (e1.block_size() != 1)
-    throw std::runtime_error("Block size is greater than 1 for V1.");
-
-  // Get V0 (H(curl)) space interpolation points
-  const auto [X, Xshape] = e1.interpolation_points();
-
-  // Tabulate first order derivatives of Lagrange space at H(curl)
-  // interpolation points
+  // Build the element interpolation matrix
   const int ndofs0 = e0.space_dimension();
   const int tdim = topology.dim();
-  std::vector<U> phi0_b((tdim + 1) * Xshape[0] * ndofs0 * 1);
-  cmdspan4_t phi0(phi0_b.data(), tdim + 1, Xshape[0], ndofs0, 1);
-  e0.tabulate(phi0_b, X, Xshape, 1);
-
-  // Reshape lagrange basis derivatives as a matrix of shape (tdim *
-  // num_points, num_dofs_per_cell)
-  cmdspan2_t dphi_reshaped(
-      phi0_b.data() + phi0.extent(3) * phi0.extent(2) * phi0.extent(1),
-      tdim * phi0.extent(1), phi0.extent(2));
+  std::vector<T> Ab = impl::discrete_gradient_element<T>(e0, e1, tdim);
 
   // Get inverse DOF transform function
   auto apply_inverse_dof_transform = e1.template dof_transformation_fn<T>(
@@ -110,19 +313,6 @@ void discrete_gradient(mesh::Topology& topology,
   const std::vector<std::uint32_t>& cell_info
       = topology.get_cell_permutation_info();
 
-  // Create element kernel function
-
-  // Build the element interpolation matrix
-  std::vector<T> Ab(e1.space_dimension() * ndofs0);
-  {
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
-        A(Ab.data(), e1.space_dimension(), ndofs0);
-    const auto [Pi, shape] = e1.interpolation_operator();
-    cmdspan2_t _Pi(Pi.data(), shape);
-    math::dot(_Pi, dphi_reshaped, A);
-  }
-
   // Insert local interpolation matrix for each cell
   auto cell_map = topology.index_map(tdim);
   assert(cell_map);
@@ -136,24 +326,26 @@ void discrete_gradient(mesh::Topology& topology,
   }
 }
 
-/// @brief Assemble an interpolation operator matrix.
-///
-/// The interpolation operator \f$A\f$ interpolates a function in the
-/// space \f$V_0\f$ into a space \f$V_1\f$. If \f$u_0\f$ is the
-/// degree-of-freedom vector associated with \f$V_0\f$, then the
-/// degree-of-freedom vector \f$u_1\f$ for the interpolated function in
-/// \f$V_1\f$ is given by \f$u_1=Au_0\f$.
-///
-/// @note The sparsity pattern for a discrete operator can be
-/// initialised using sparsitybuild::cells. The space `V1` should be
-/// used for the rows of the sparsity pattern, `V0` for the columns.
+namespace impl
+{
+/// @brief Compute the element matrices of the interpolation operator
+/// from `V0` into `V1` on a list of cells.
 ///
 /// @param[in] V0 The space to interpolate from
 /// @param[in] V1 The space to interpolate to
-/// @param[in] mat_set A functor that sets values in a matrix
+/// @param[in] cell_info Cell permutation information. Can be empty if
+/// the elements do not need dof transformations.
+/// @param[in] cells Cells (local indices) to compute the element
+/// matrices on
+/// @param[in] fn Function called as `fn(c, Ab)` with the element matrix
+/// `Ab` (row-major, `shape=(V1 space dimension, V0 space dimension)`)
+/// of each cell `c`
 template <dolfinx::scalar T, std::floating_point U>
-void interpolation_matrix(const FunctionSpace<U>& V0,
-                          const FunctionSpace<U>& V1, auto&& mat_set)
+void interpolation_element_matrices(const FunctionSpace<U>& V0,
+                                    const FunctionSpace<U>& V1,
+                                    std::span<const std::uint32_t> cell_info,
+                                    std::span<const std::int32_t> cells,
+                                    auto&& fn)
 {
   // Get mesh
   auto mesh = V0.mesh();
@@ -169,19 +361,6 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   std::shared_ptr<const FiniteElement<U>> e1 = V1.element();
   assert(e1);
 
-  std::span<const std::uint32_t> cell_info;
-  if (e1->needs_dof_transformations() or e0->needs_dof_transformations())
-  {
-    mesh->topology_mutable()->create_entity_permutations();
-    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
-  }
-
-  // Get dofmaps
-  auto dofmap0 = V0.dofmap();
-  assert(dofmap0);
-  auto dofmap1 = V1.dofmap();
-  assert(dofmap1);
-
   // Get block sizes and dof transformation operators
   const int bs0 = e0->block_size();
   const int bs1 = e1->block_size();
@@ -202,7 +381,7 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   const CoordinateElement<U>& cmap = mesh->geometry().cmap();
   auto x_dofmap = mesh->geometry().dofmap();
   const std::size_t num_dofs_g = cmap.dim();
-  std::span<const U> x_g = mesh->geometry().x();
+  mesh::NodeCoordinates<U> x_g = mesh->geometry().coordinates();
 
   using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
@@ -288,11 +467,8 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
   std::vector<T> Ab(space_dim0 * space_dim1);
   std::vector<T> local1(space_dim1);
 
-  // Iterate over mesh and interpolate on each cell
-  auto cell_map = mesh->topology()->index_map(tdim);
-  assert(cell_map);
-  std::int32_t num_cells = cell_map->size_local();
-  for (std::int32_t c = 0; c < num_cells; ++c)
+  // Iterate over cells and interpolate on each cell
+  for (std::int32_t c : cells)
   {
     // Get cell geometry (coordinate dofs)
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
@@ -300,7 +476,7 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
     for (std::size_t i = 0; i < x_dofs.size(); ++i)
     {
       for (std::size_t j = 0; j < gdim; ++j)
-        coord_dofs(i, j) = x_g[3 * x_dofs[i] + j];
+        coord_dofs(i, j) = x_g(x_dofs[i], j);
     }
 
     // Compute Jacobians and reference points for current cell
@@ -404,8 +580,330 @@ void interpolation_matrix(const FunctionSpace<U>& V0,
     }
 
     apply_inverse_dof_transform1(Ab, cell_info, c, space_dim0);
-    mat_set(dofmap1->cell_dofs(c), dofmap0->cell_dofs(c), Ab);
+    fn(c, std::span<const T>(Ab));
+  }
+}
+} // namespace impl
+
+/// @brief Assemble an interpolation operator matrix.
+///
+/// The interpolation operator \f$A\f$ interpolates a function in the
+/// space \f$V_0\f$ into a space \f$V_1\f$. If \f$u_0\f$ is the
+/// degree-of-freedom vector associated with \f$V_0\f$, then the
+/// degree-of-freedom vector \f$u_1\f$ for the interpolated function in
+/// \f$V_1\f$ is given by \f$u_1=Au_0\f$.
+///
+/// @note The sparsity pattern for a discrete operator can be
+/// initialised using sparsitybuild::cells. The space `V1` should be
+/// used for the rows of the sparsity pattern, `V0` for the columns.
+///
+/// @param[in] V0 The space to interpolate from
+/// @param[in] V1 The space to interpolate to
+/// @param[in] mat_set A functor that sets values in a matrix
+template <dolfinx::scalar T, std::floating_point U>
+void interpolation_matrix(const FunctionSpace<U>& V0,
+                          const FunctionSpace<U>& V1, auto&& mat_set)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  std::span<const std::uint32_t> cell_info;
+  if (V1.element()->needs_dof_transformations()
+      or V0.element()->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+  }
+
+  // Iterate over owned cells and insert the element matrices
+  auto dofmap0 = V0.dofmap();
+  assert(dofmap0);
+  auto dofmap1 = V1.dofmap();
+  assert(dofmap1);
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  std::vector<std::int32_t> cells(cell_map->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  impl::interpolation_element_matrices<T>(
+      V0, V1, cell_info, cells, [&](std::int32_t c, std::span<const T> Ab)
+      { mat_set(dofmap1->cell_dofs(c), dofmap0->cell_dofs(c), Ab); });
+}
+
+/// @brief Create the discrete gradient operator matrix.
+///
+/// See discrete_gradient for the operator. The matrix is built
+/// directly in CSR format from the mesh topology: each owned row (a
+/// degree-of-freedom of `V1`) is computed on one cell and has the
+/// non-zero columns of the `V0` degrees-of-freedom of the cell, e.g.
+/// two columns per edge for the lowest order spaces. This avoids
+/// building a sparsity pattern and communicating ghost rows.
+///
+/// @param[in] V0 Lagrange space to interpolate the gradient from
+/// @param[in] V1 Nédélec (first kind) space to interpolate into
+/// @param[in] num_threads Number of threads used to compute the
+/// element matrices and fill the matrix
+/// @return The discrete gradient matrix. Rows are distributed as `V1`
+/// and columns as `V0`.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+la::MatrixCSR<T> create_discrete_gradient(const FunctionSpace<U>& V0,
+                                          const FunctionSpace<U>& V1,
+                                          int num_threads = 1)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  std::shared_ptr<mesh::Topology> topology = mesh->topology_mutable();
+  auto e0 = V0.element();
+  assert(e0);
+  auto e1 = V1.element();
+  assert(e1);
+  const int tdim = topology->dim();
+  const std::vector<T> Ab = impl::discrete_gradient_element<T>(*e0, *e1, tdim);
+  const int ndofs0 = e0->space_dimension();
+
+  auto apply_inverse_dof_transform = e1->template dof_transformation_fn<T>(
+      doftransform::inverse_transpose, false);
+  topology->create_entity_permutations();
+  const std::vector<std::uint32_t>& cell_info
+      = topology->get_cell_permutation_info();
+
+  auto cell_map = topology->index_map(tdim);
+  assert(cell_map);
+  return impl::create_operator_matrix<T>(
+      *V0.dofmap(), *V1.dofmap(),
+      cell_map->size_local() + cell_map->num_ghosts(),
+      [&](std::span<const std::int32_t> cells, auto&& insert)
+      {
+        std::vector<T> Ae(Ab.size());
+        for (std::int32_t c : cells)
+        {
+          std::ranges::copy(Ab, Ae.begin());
+          apply_inverse_dof_transform(Ae, cell_info, c, ndofs0);
+          insert(c, std::span<const T>(Ae));
+        }
+      },
+      true, num_threads);
+}
+
+/// @brief Create an interpolation operator matrix.
+///
+/// See interpolation_matrix for the operator. The matrix is built
+/// directly in CSR format: each owned row (a degree-of-freedom of `V1`)
+/// is computed on one cell and has the columns of the `V0`
+/// degrees-of-freedom of the cell. This avoids building a sparsity
+/// pattern and communicating ghost rows.
+///
+/// @note If the interpolated functions are not continuous across cells
+/// in the sense of the degrees-of-freedom of `V1`, e.g. from a
+/// discontinuous space into a continuous space, a row is taken from
+/// one of the cells that contain it.
+///
+/// @param[in] V0 The space to interpolate from
+/// @param[in] V1 The space to interpolate to
+/// @param[in] num_threads Number of threads used to compute the
+/// element matrices and fill the matrix
+/// @return The interpolation matrix. Rows are distributed as `V1` and
+/// columns as `V0`, with the block sizes of the dofmaps.
+template <dolfinx::scalar T, std::floating_point U>
+la::MatrixCSR<T> create_interpolation_matrix(const FunctionSpace<U>& V0,
+                                             const FunctionSpace<U>& V1,
+                                             int num_threads = 1)
+{
+  auto mesh = V0.mesh();
+  assert(mesh);
+  std::span<const std::uint32_t> cell_info;
+  if (V1.element()->needs_dof_transformations()
+      or V0.element()->needs_dof_transformations())
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
   }
+
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  return impl::create_operator_matrix<T>(
+      *V0.dofmap(), *V1.dofmap(),
+      cell_map->size_local() + cell_map->num_ghosts(),
+      [&](std::span<const std::int32_t> cells, auto&& insert)
+      {
+        impl::interpolation_element_matrices<T>(V0, V1, cell_info, cells,
+                                                insert);
+      },
+      false, num_threads);
+}
+
+/// @brief Create the prolongation matrix from a space on a mesh to a
+/// space on a refinement of the mesh.
+///
+/// The prolongation operator \f$P\f$ interpolates a function in the
+/// space \f$V_0\f$ on a (coarse) mesh into the space \f$V_1\f$ on a
+/// mesh created by refining the coarse mesh. If \f$u_0\f$ is the
+/// degree-of-freedom vector of a function in \f$V_0\f$, then
+/// \f$u_1=Pu_0\f$ is the degree-of-freedom vector of the same function
+/// in \f$V_1\f$. The transpose \f$P^{T}\f$ is the restriction
+/// operator, and can be applied using la::MatrixCSR::mult_transpose.
+/// These are the transfer operators between successive levels of a
+/// geometric multigrid method, see refinement::MeshHierarchy.
+///
+/// The interpolation points of `V1` on a fine cell are mapped into the
+/// parent cell, so no point location is required. The matrix is built
+/// directly in CSR format, see create_interpolation_matrix.
+///
+/// @pre The fine mesh is a refinement of the coarse mesh that has not
+/// been re-distributed, i.e. the parent of each fine cell is on the
+/// same process.
+///
+/// @param[in] V0 Lagrange space on the coarse mesh
+/// @param[in] V1 Lagrange space on the fine mesh, with the same block
+/// size as `V0`
+/// @param[in] parent_cells Parent cell (local index in the coarse
+/// mesh) of each cell of the fine mesh, e.g. computed by
+/// refinement::refine with refinement::Option::parent_cell.
+/// @param[in] num_threads Number of threads used to compute the
+/// element matrices and fill the matrix
+/// @return The prolongation matrix. Rows are distributed as `V1` and
+/// columns as `V0`, with the block sizes of the dofmaps.
+template <dolfinx::scalar T,
+          std::floating_point U = dolfinx::scalar_value_type_t<T>>
+la::MatrixCSR<T>
+create_prolongation_matrix(const FunctionSpace<U>& V0,
+                           const FunctionSpace<U>& V1,
+                           std::span<const std::int32_t> parent_cells,
+                           int num_threads = 1)
+{
+  auto mesh0 = V0.mesh();
+  assert(mesh0);
+  auto mesh1 = V1.mesh();
+  assert(mesh1);
+  std::shared_ptr<const FiniteElement<U>> e0 = V0.element();
+  assert(e0);
+  std::shared_ptr<const FiniteElement<U>> e1 = V1.element();
+  assert(e1);
+
+  for (auto& e : {e0, e1})
+  {
+    if (!e->interpolation_ident() or !e->map_ident()
+        or e->needs_dof_transformations()
+        or e->reference_value_size() != e->block_size())
+    {
+      throw std::runtime_error(
+          "Prolongation matrix is supported for Lagrange spaces only.");
+    }
+  }
+  const int bs = e0->block_size();
+  if (e1->block_size() != bs)
+    throw std::runtime_error("Spaces must have the same block size.");
+
+  const CoordinateElement<U>& cmap0 = mesh0->geometry().cmap();
+  const CoordinateElement<U>& cmap1 = mesh1->geometry().cmap();
+  if (!cmap0.is_affine() or !cmap1.is_affine())
+    throw std::runtime_error("Prolongation matrix requires affine meshes.");
+
+  const int tdim = mesh1->topology()->dim();
+  const std::size_t gdim = mesh1->geometry().dim();
+  auto cell_map1 = mesh1->topology()->index_map(tdim);
+  assert(cell_map1);
+  const std::int32_t num_cells1
+      = cell_map1->size_local() + cell_map1->num_ghosts();
+  if (parent_cells.size() != static_cast<std::size_t>(num_cells1))
+  {
+    throw std::runtime_error(
+        "Number of parent cells does not match the fine mesh.");
+  }
+
+  const std::size_t dim0 = e0->space_dimension() / bs;
+  const std::size_t dim1 = e1->space_dimension() / bs;
+
+  using mdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
+  using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 4>>;
+
+  // Fine geometry basis at the interpolation points of V1
+  const auto [X1, Xshape] = e1->interpolation_points();
+  assert(Xshape[0] == dim1);
+  std::array<std::size_t, 4> phi1_shape = cmap1.tabulate_shape(0, Xshape[0]);
+  std::vector<U> phi1_b(
+      std::reduce(phi1_shape.begin(), phi1_shape.end(), 1, std::multiplies{}));
+  cmap1.tabulate(0, X1, Xshape, phi1_b);
+  cmdspan2_t phi1(phi1_b.data(), phi1_shape[1], phi1_shape[2]);
+
+  // Derivatives of the coarse geometry basis (constant on affine cells)
+  std::array<std::size_t, 4> phi0_shape = cmap0.tabulate_shape(1, 1);
+  std::vector<U> phi0_b(
+      std::reduce(phi0_shape.begin(), phi0_shape.end(), 1, std::multiplies{}));
+  cmap0.tabulate(1, std::vector<U>(tdim), {1, std::size_t(tdim)}, phi0_b);
+  cmdspan4_t phi0(phi0_b.data(), phi0_shape);
+  auto dphi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+      phi0, std::pair(1, tdim + 1), 0,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+  auto x_dofmap0 = mesh0->geometry().dofmap();
+  auto x_dofmap1 = mesh1->geometry().dofmap();
+  mesh::NodeCoordinates<U> x_g0 = mesh0->geometry().coordinates();
+  mesh::NodeCoordinates<U> x_g1 = mesh1->geometry().coordinates();
+
+  return impl::create_operator_matrix<T>(
+      *V0.dofmap(), *V1.dofmap(), num_cells1,
+      [&](std::span<const std::int32_t> cells, auto&& insert)
+      {
+        std::vector<U> coord_dofs0_b(cmap0.dim() * gdim);
+        mdspan2_t coord_dofs0(coord_dofs0_b.data(), cmap0.dim(), gdim);
+        std::vector<U> coord_dofs1_b(cmap1.dim() * gdim);
+        mdspan2_t coord_dofs1(coord_dofs1_b.data(), cmap1.dim(), gdim);
+        std::vector<U> x_b(Xshape[0] * gdim);
+        mdspan2_t x(x_b.data(), Xshape[0], gdim);
+        std::vector<U> X0_b(Xshape[0] * tdim);
+        mdspan2_t X0(X0_b.data(), Xshape[0], tdim);
+        std::vector<U> J_b(gdim * tdim);
+        mdspan2_t J(J_b.data(), gdim, tdim);
+        std::vector<U> K_b(tdim * gdim);
+        mdspan2_t K(K_b.data(), tdim, gdim);
+        std::vector<U> basis_b(Xshape[0] * dim0);
+        std::vector<T> Ae(dim1 * bs * dim0 * bs, 0);
+        for (std::int32_t c : cells)
+        {
+          const std::int32_t p = parent_cells[c];
+          for (std::size_t i = 0; i < coord_dofs0.extent(0); ++i)
+          {
+            for (std::size_t j = 0; j < gdim; ++j)
+              coord_dofs0(i, j) = x_g0(x_dofmap0(p, i), j);
+          }
+          for (std::size_t i = 0; i < coord_dofs1.extent(0); ++i)
+          {
+            for (std::size_t j = 0; j < gdim; ++j)
+              coord_dofs1(i, j) = x_g1(x_dofmap1(c, i), j);
+          }
+
+          // Map the interpolation points of the fine cell to the
+          // reference coordinates of the parent cell
+          CoordinateElement<U>::push_forward(x, coord_dofs1, phi1);
+          std::ranges::fill(J_b, 0);
+          CoordinateElement<U>::compute_jacobian(dphi0, coord_dofs0, J);
+          CoordinateElement<U>::compute_jacobian_inverse(J, K);
+          std::array<U, 3> x0 = {0, 0, 0};
+          for (std::size_t i = 0; i < gdim; ++i)
+            x0[i] = coord_dofs0(0, i);
+          CoordinateElement<U>::pull_back_affine(X0, K, x0, x);
+
+          // Coarse basis at the points, unrolled for the block size
+          e0->tabulate(basis_b, X0_b, {Xshape[0], std::size_t(tdim)}, 0);
+          for (std::size_t i = 0; i < dim1; ++i)
+          {
+            for (std::size_t j = 0; j < dim0; ++j)
+            {
+              U v = basis_b[i * dim0 + j];
+              if (std::abs(v) < 1e-12)
+                v = 0;
+              for (int k = 0; k < bs; ++k)
+                Ae[(i * bs + k) * dim0 * bs + j * bs + k] = v;
+            }
+          }
+          insert(c, std::span<const T>(Ae));
+        }
+      },
+      true, num_threads, parent_cells);
 }
 
 } // namespace dolfinx::fem
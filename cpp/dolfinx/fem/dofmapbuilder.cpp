@@ -11,10 +11,12 @@
 #include <cstdlib>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <numeric>
@@ -36,6 +38,32 @@ struct dofmap_t
 };
 //-----------------------------------------------------------------------------
 
+/// @brief Call `fn(t, i0, i1)` on each thread `t` for contiguous
+/// blocks `[i0, i1)` of `[0, n)`, one block per thread.
+///
+/// If `num_threads < 2`, `fn(0, 0, n)` is called on the calling thread.
+/// Otherwise the blocks are executed as tasks on the process thread pool
+/// (see common::thread_pool). An exception thrown by `fn` is re-thrown
+/// on the calling thread once all tasks have completed.
+template <typename F>
+void parallel_for(int num_threads, std::int64_t n, F&& fn)
+{
+  if (num_threads < 2)
+  {
+    fn(0, std::int64_t(0), n);
+    return;
+  }
+
+  common::thread_pool().run(
+      num_threads,
+      [&fn, n, num_threads](int t)
+      {
+        auto [i0, i1] = dolfinx::MPI::local_range(t, n, num_threads);
+        fn(t, i0, i1);
+      });
+}
+//-----------------------------------------------------------------------------
+
 /// Build a graph for owned dofs and apply graph reordering function with
 /// multiple dofmaps. The dofmaps are 2D arrays, of fixed width, stored in
 /// `dofmap_t` format. The dofmaps all refer to dof indices in the same range
@@ -46,85 +74,104 @@ struct dofmap_t
 /// to new indices that are ordered such that owned indices are [0,
 /// owned_size)
 /// @param[in] reorder_fn The graph reordering function to apply
+/// @param[in] num_threads Number of threads used to build the graph
 /// @return Map from original_to_contiguous[i] to new index after
 /// reordering
 std::vector<int>
 reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
               const std::vector<int>& original_to_contiguous,
               const std::function<std::vector<int>(
-                  const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+                  const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+              int num_threads)
 {
-  std::vector<std::int32_t> graph_data, graph_offsets;
+  // Offset of the cells of each dofmap in a combined cell numbering
+  std::vector<std::int32_t> cell_offsets = {0};
+  for (const auto& dofmap : dofmaps)
+  {
+    cell_offsets.push_back(cell_offsets.back()
+                           + dofmap.array.size() / dofmap.width);
+  }
 
-  // Compute maximum number of graph out edges edges per dof
-  std::vector<int> num_edges(owned_size);
+  // Build owned node -> cells (combined numbering) map
+  std::vector<std::int32_t> node_cells_offsets(owned_size + 1, 0);
   for (const auto& dofmap : dofmaps)
   {
-    std::size_t num_cells = dofmap.array.size() / dofmap.width;
-    std::vector<std::int32_t> node_temp;
-    for (std::size_t cell = 0; cell < num_cells; ++cell)
+    for (std::int32_t dof : dofmap.array)
     {
-      node_temp.clear();
-      for (std::int32_t i = 0; i < dofmap.width; ++i)
-      {
-        std::int32_t node
-            = original_to_contiguous[dofmap.array[cell * dofmap.width + i]];
-        if (node < owned_size)
-          node_temp.push_back(node);
-      }
-      for (std::int32_t node : node_temp)
-        num_edges[node] += node_temp.size() - 1;
+      if (std::int32_t node = original_to_contiguous[dof]; node < owned_size)
+        ++node_cells_offsets[node + 1];
     }
   }
-
-  // Compute adjacency list with duplicate edges
-  std::vector<std::int32_t> offsets(num_edges.size() + 1, 0);
-  std::partial_sum(num_edges.begin(), num_edges.end(),
-                   std::next(offsets.begin(), 1));
-  std::vector<std::int32_t> edges(offsets.back());
-  for (const auto& dofmap : dofmaps)
+  std::partial_sum(node_cells_offsets.begin(), node_cells_offsets.end(),
+                   node_cells_offsets.begin());
+  std::vector<std::int32_t> node_cells(node_cells_offsets.back());
   {
-    std::size_t num_cells = dofmap.array.size() / dofmap.width;
-    std::vector<std::int32_t> node_temp;
-
-    for (std::size_t cell = 0; cell < num_cells; ++cell)
+    std::vector<std::int32_t> pos(node_cells_offsets.begin(),
+                                  std::prev(node_cells_offsets.end()));
+    for (std::size_t i = 0; i < dofmaps.size(); ++i)
     {
-      node_temp.clear();
-      for (std::int32_t i = 0; i < dofmap.width; ++i)
-      {
-        std::int32_t node
-            = original_to_contiguous[dofmap.array[cell * dofmap.width + i]];
-        if (node < owned_size)
-          node_temp.push_back(node);
-      }
-
-      for (std::size_t i = 0; i < node_temp.size(); ++i)
+      const dofmap_t& dofmap = dofmaps[i];
+      for (std::size_t j = 0; j < dofmap.array.size(); ++j)
       {
-        std::int32_t node_0 = node_temp[i];
-        for (std::size_t j = i + 1; j < node_temp.size(); ++j)
+        if (std::int32_t node = original_to_contiguous[dofmap.array[j]];
+            node < owned_size)
         {
-          std::int32_t node_1 = node_temp[j];
-          edges[offsets[node_0]++] = node_1;
-          edges[offsets[node_1]++] = node_0;
+          node_cells[pos[node]++] = cell_offsets[i] + j / dofmap.width;
         }
       }
     }
   }
 
-  // Eliminate duplicate edges and create AdjacencyList
-  graph_offsets.resize(num_edges.size() + 1, 0);
-  std::int32_t current_offset = 0;
-  for (std::size_t i = 0; i < num_edges.size(); ++i)
+  // Compute the (sorted, unique) owned neighbours of each node. Each
+  // thread computes the neighbours for a contiguous range of nodes.
+  const int nt = std::max(num_threads, 1);
+  std::vector<std::vector<std::int32_t>> thread_data(nt);
+  std::vector<std::vector<std::int32_t>> thread_num_edges(nt);
+  parallel_for(
+      nt, owned_size,
+      [&](int t, std::int64_t n0, std::int64_t n1)
+      {
+        std::vector<std::int32_t>& data = thread_data[t];
+        std::vector<std::int32_t>& num_edges = thread_num_edges[t];
+        std::vector<std::int32_t> edges;
+        for (std::int64_t node = n0; node < n1; ++node)
+        {
+          edges.clear();
+          for (std::int32_t k = node_cells_offsets[node];
+               k < node_cells_offsets[node + 1]; ++k)
+          {
+            const std::int32_t c = node_cells[k];
+            const std::size_t i
+                = std::distance(cell_offsets.begin(),
+                                std::ranges::upper_bound(cell_offsets, c))
+                  - 1;
+            const dofmap_t& dofmap = dofmaps[i];
+            auto dofs = std::span(dofmap.array)
+                            .subspan((c - cell_offsets[i]) * dofmap.width,
+                                     dofmap.width);
+            for (std::int32_t dof : dofs)
+            {
+              std::int32_t node1 = original_to_contiguous[dof];
+              if (node1 < owned_size and node1 != node)
+                edges.push_back(node1);
+            }
+          }
+          std::ranges::sort(edges);
+          auto last = std::ranges::unique(edges).begin();
+          data.insert(data.end(), edges.begin(), last);
+          num_edges.push_back(std::distance(edges.begin(), last));
+        }
+      });
+
+  // Create AdjacencyList
+  std::vector<std::int32_t> graph_data, graph_offsets = {0};
+  graph_offsets.reserve(owned_size + 1);
+  for (int t = 0; t < nt; ++t)
   {
-    auto range_begin = std::next(edges.begin(), current_offset);
-    auto edge_range = std::ranges::subrange(
-        range_begin, std::next(range_begin, num_edges[i]));
-    std::ranges::sort(edge_range);
-    auto it = std::ranges::unique(edge_range).begin();
-
-    graph_data.insert(graph_data.end(), range_begin, it);
-    graph_offsets[i + 1] = graph_offsets[i] + std::distance(range_begin, it);
-    current_offset += num_edges[i];
+    graph_data.insert(graph_data.end(), thread_data[t].begin(),
+                      thread_data[t].end());
+    for (std::int32_t n : thread_num_edges[t])
+      graph_offsets.push_back(graph_offsets.back() + n);
   }
 
   // Re-order graph and return re-odering
@@ -140,6 +187,8 @@ reorder_owned(const std::vector<dofmap_t>& dofmaps, std::int32_t owned_size,
 /// @param [in] mesh The mesh to build the dofmap on
 /// @param [in] topology The mesh topology
 /// @param [in] element_dof_layout The layout of dofs on each cell type
+/// @param [in] num_threads Number of threads used to number the dofs of
+/// the cells
 /// @return Returns: * dofmaps for each cell type (local to the process)
 ///                  * local-to-global map for each local dof
 ///                  * local-to-entity map for each local dof
@@ -152,7 +201,8 @@ std::tuple<std::vector<dofmap_t>, std::vector<std::int64_t>,
            std::vector<std::shared_ptr<const common::IndexMap>>, std::int64_t>
 build_basic_dofmaps(
     const mesh::Topology& topology,
-    const std::vector<fem::ElementDofLayout>& element_dof_layouts)
+    const std::vector<fem::ElementDofLayout>& element_dof_layouts,
+    int num_threads)
 {
   // Start timer for dofmap initialization
   common::Timer t0("Init dofmap from element dofmap");
@@ -261,57 +311,63 @@ build_basic_dofmaps(
     dofs[i].array.resize(num_cells * dofmap_width);
     spdlog::info("Cell type: {} dofmap: {}x{}", i, num_cells, dofmap_width);
 
-    std::int32_t dofmap_offset = 0;
-    for (std::int32_t c = 0; c < num_cells; ++c)
-    {
-      // Wrap dofs for cell c
-      std::span<std::int32_t> dofs_c(dofs[i].array.data() + dofmap_offset,
-                                     dofmap_width);
-      dofmap_offset += dofmap_width;
-
-      // Iterate over required entities for this element, dimension and type
-      for (std::size_t k = 0; k < required_dim_et.size(); ++k)
-      {
-        // Get dimension d and entity type et
-        std::size_t d = required_dim_et[k].first;
-        std::size_t et = required_dim_et[k].second;
-        mesh::CellType e_type = topology.entity_types(d)[et];
-
-        const std::vector<std::vector<int>>& e_dofs_d = entity_dofs[d];
-
-        // Iterate over each entity of current dimension d and type et
-        std::span<const std::int32_t> c_to_e
-            = d < D ? topology.connectivity({D, i}, {d, et})->links(c)
-                    : std::span<const std::int32_t>(&c, 1);
-
-        int w = 0;
-        for (std::size_t e = 0; e < e_dofs_d.size(); ++e)
+    // Each cell is numbered independently, so cells are divided between
+    // threads
+    parallel_for(
+        num_threads, num_cells,
+        [&](int, std::int64_t c0, std::int64_t c1)
         {
-          // Skip entities of wrong type (e.g. for facets of prism)
-          // Use separate connectivity index 'w' which only advances for
-          // correct entities
-          if (mesh::cell_entity_type(cell_type, d, e) == e_type)
+          for (std::int32_t c = c0; c < c1; ++c)
           {
-            const std::vector<int>& e_dofs_d_e = e_dofs_d[e];
-            std::size_t num_entity_dofs = e_dofs_d_e.size();
-            assert((int)num_entity_dofs == num_entity_dofs_et[k]);
-            std::int32_t e_index_local = c_to_e[w];
-            ++w;
-
-            // Loop over dofs belonging to entity e of dimension d (d, e)
-            // d: topological dimension
-            // e: local entity index
-            // dof_local: local index of dof at (d, e)
-            for (std::size_t j = 0; j < num_entity_dofs; ++j)
+            // Wrap dofs for cell c
+            std::span<std::int32_t> dofs_c(
+                dofs[i].array.data() + c * dofmap_width, dofmap_width);
+
+            // Iterate over required entities for this element, dimension
+            // and type
+            for (std::size_t k = 0; k < required_dim_et.size(); ++k)
             {
-              int dof_local = e_dofs_d_e[j];
-              dofs_c[dof_local] = local_entity_offsets[k]
-                                  + num_entity_dofs * e_index_local + j;
+              // Get dimension d and entity type et
+              std::size_t d = required_dim_et[k].first;
+              std::size_t et = required_dim_et[k].second;
+              mesh::CellType e_type = topology.entity_types(d)[et];
+
+              const std::vector<std::vector<int>>& e_dofs_d = entity_dofs[d];
+
+              // Iterate over each entity of current dimension d and type et
+              std::span<const std::int32_t> c_to_e
+                  = d < D ? topology.connectivity({D, i}, {d, et})->links(c)
+                          : std::span<const std::int32_t>(&c, 1);
+
+              int w = 0;
+              for (std::size_t e = 0; e < e_dofs_d.size(); ++e)
+              {
+                // Skip entities of wrong type (e.g. for facets of prism)
+                // Use separate connectivity index 'w' which only advances for
+                // correct entities
+                if (mesh::cell_entity_type(cell_type, d, e) == e_type)
+                {
+                  const std::vector<int>& e_dofs_d_e = e_dofs_d[e];
+                  std::size_t num_entity_dofs = e_dofs_d_e.size();
+                  assert((int)num_entity_dofs == num_entity_dofs_et[k]);
+                  std::int32_t e_index_local = c_to_e[w];
+                  ++w;
+
+                  // Loop over dofs belonging to entity e of dimension d (d, e)
+                  // d: topological dimension
+                  // e: local entity index
+                  // dof_local: local index of dof at (d, e)
+                  for (std::size_t j = 0; j < num_entity_dofs; ++j)
+                  {
+                    int dof_local = e_dofs_d_e[j];
+                    dofs_c[dof_local] = local_entity_offsets[k]
+                                        + num_entity_dofs * e_index_local + j;
+                  }
+                }
+              }
             }
           }
-        }
-      }
-    }
+        });
   }
 
   spdlog::info("Global index computation");
@@ -339,18 +395,24 @@ build_basic_dofmaps(
     assert(map);
     std::vector<std::int64_t> global_indices = map->global_indices();
 
-    for (std::size_t e_index = 0; e_index < global_indices.size(); ++e_index)
-    {
-      auto e_index_global = global_indices[e_index];
-      for (std::int32_t count = 0; count < num_entity_dofs; ++count)
-      {
-        std::int32_t dof
-            = local_entity_offsets[k] + num_entity_dofs * e_index + count;
-        local_to_global[dof]
-            = global_entity_offsets + num_entity_dofs * e_index_global + count;
-        dof_entity[dof] = {k, e_index};
-      }
-    }
+    parallel_for(
+        num_threads, global_indices.size(),
+        [&](int, std::int64_t e0, std::int64_t e1)
+        {
+          for (std::int32_t e_index = e0; e_index < e1; ++e_index)
+          {
+            auto e_index_global = global_indices[e_index];
+            for (std::int32_t count = 0; count < num_entity_dofs; ++count)
+            {
+              std::int32_t dof = local_entity_offsets[k]
+                                 + num_entity_dofs * e_index + count;
+              local_to_global[dof] = global_entity_offsets
+                                     + num_entity_dofs * e_index_global
+                                     + count;
+              dof_entity[dof] = {k, e_index};
+            }
+          }
+        });
     global_entity_offsets += num_entity_dofs * map->size_global();
     global_start += num_entity_dofs * map->local_range()[0];
   }
@@ -376,6 +438,8 @@ build_basic_dofmaps(
 /// `dof_entity`.
 /// @param [in] reorder_fn Graph reordering function that is applied for
 /// dof re-ordering
+/// @param [in] num_threads Number of threads used to build the graph
+/// for re-ordering
 /// @return The pair (old-to-new local index map, M), where M is the
 /// number of dofs owned by this process
 std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
@@ -383,7 +447,8 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
     const std::vector<std::pair<std::int8_t, std::int32_t>>& dof_entity,
     const std::vector<std::shared_ptr<const common::IndexMap>>& index_maps,
     const std::function<std::vector<int>(
-        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+    int num_threads)
 {
   common::Timer t0("Compute dof reordering map");
 
@@ -439,7 +504,7 @@ std::pair<std::vector<std::int32_t>, std::int32_t> compute_reordering_map(
 
     // Apply graph reordering to owned dofs
     const std::vector<int> node_remap = reorder_owned(
-        dofmaps, owned_size, original_to_contiguous, reorder_fn);
+        dofmaps, owned_size, original_to_contiguous, reorder_fn, num_threads);
     std::ranges::transform(
         original_to_contiguous, original_to_contiguous.begin(),
         [&node_remap, owned_size](auto index)
@@ -619,7 +684,8 @@ fem::build_dofmap_data(
     MPI_Comm comm, const mesh::Topology& topology,
     const std::vector<ElementDofLayout>& element_dof_layouts,
     const std::function<std::vector<int>(
-        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn)
+        const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+    int num_threads)
 {
   common::Timer t0("Build dofmap data");
 
@@ -629,14 +695,14 @@ fem::build_dofmap_data(
   // i is associated with.
   const auto [node_graphs, local_to_global0, dof_entity0, topo_index_maps,
               offset]
-      = build_basic_dofmaps(topology, element_dof_layouts);
+      = build_basic_dofmaps(topology, element_dof_layouts, num_threads);
 
   spdlog::info("Got {} index_maps", topo_index_maps.size());
 
   // Build re-ordering map for data locality and get number of owned
   // nodes
   const auto [old_to_new, num_owned] = compute_reordering_map(
-      node_graphs, dof_entity0, topo_index_maps, reorder_fn);
+      node_graphs, dof_entity0, topo_index_maps, reorder_fn, num_threads);
 
   spdlog::info("Get global indices");
 
@@ -657,11 +723,15 @@ fem::build_dofmap_data(
     const std::vector<std::int32_t>& node_graphs_i = node_graphs[i].array;
     dofmaps[i].resize(node_graphs_i.size());
     std::vector<std::int32_t>& dofmaps_i = dofmaps[i];
-    for (std::size_t j = 0; j < node_graphs_i.size(); ++j)
-    {
-      std::int32_t old_node = node_graphs_i[j];
-      dofmaps_i[j] = old_to_new[old_node];
-    }
+    parallel_for(num_threads, node_graphs_i.size(),
+                 [&](int, std::int64_t j0, std::int64_t j1)
+                 {
+                   for (std::int64_t j = j0; j < j1; ++j)
+                   {
+                     std::int32_t old_node = node_graphs_i[j];
+                     dofmaps_i[j] = old_to_new[old_node];
+                   }
+                 });
   }
 
   return {std::move(index_map), element_dof_layouts.front().block_size(),
@@ -38,12 +38,17 @@ class ElementDofLayout;
 /// @param[in] element_dof_layouts The element dof layouts for each cell
 /// type in `topology`.
 /// @param[in] reorder_fn Graph reordering function that is applied to
-/// the dofmaps
+/// the owned dofs, e.g. graph::reorder_gps or graph::reorder_rcm. If
+/// empty, the dofs are numbered in the order they are first visited when
+/// iterating over the cells.
+/// @param[in] num_threads Number of threads used to number the dofs on
+/// each cell and to build the graph for re-ordering
 /// @return The index map, block size, and dofmaps for each element type
 std::tuple<common::IndexMap, int, std::vector<std::vector<std::int32_t>>>
 build_dofmap_data(MPI_Comm comm, const mesh::Topology& topology,
                   const std::vector<ElementDofLayout>& element_dof_layouts,
                   const std::function<std::vector<int>(
-                      const graph::AdjacencyList<std::int32_t>&)>& reorder_fn);
+                      const graph::AdjacencyList<std::int32_t>&)>& reorder_fn,
+                  int num_threads = 1);
 
 } // namespace dolfinx::fem
@@ -10,13 +10,30 @@ namespace dolfinx::fem
 
 // DOLFINx fem interface
 
+#include <dolfinx/fem/AsyncAssembly.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DirichletBC.h>
 #include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/DofMapCache.h>
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/GeometryFactors.h>
+#include <dolfinx/fem/IntegrationDomainCache.h>
+#include <dolfinx/fem/InterpolationOperator.h>
+#include <dolfinx/fem/Interpolator.h>
+#include <dolfinx/fem/KernelRegistry.h>
+#include <dolfinx/fem/MatrixAssemblyPlan.h>
+#include <dolfinx/fem/NonMatchingInterpolator.h>
+#include <dolfinx/fem/PackedCoefficients.h>
+#include <dolfinx/fem/PointEvaluator.h>
+#include <dolfinx/fem/PTransfer.h>
+#include <dolfinx/fem/QuadratureData.h>
+#include <dolfinx/fem/ScalarReduction.h>
+#include <dolfinx/fem/StaticCondensation.h>
+#include <dolfinx/fem/SumFactorizedOperator.h>
+#include <dolfinx/fem/TabulationCache.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/discreteoperators.h>
 #include <dolfinx/fem/sparsitybuild.h>
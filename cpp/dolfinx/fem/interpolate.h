@@ -15,10 +15,15 @@
 #include <basix/mdspan.hpp>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/geometry/utils.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <dolfinx/mesh/rebalance.h>
 #include <functional>
+#include <limits>
 #include <numeric>
 #include <ranges>
 #include <span>
@@ -55,7 +60,7 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
   // Get geometry data and the element coordinate map
   const std::size_t gdim = geometry.dim();
   auto x_dofmap = geometry.dofmap();
-  std::span<const T> x_g = geometry.x();
+  mesh::NodeCoordinates<T> x_g = geometry.coordinates();
 
   const CoordinateElement<T>& cmap = geometry.cmap();
   const std::size_t num_dofs_g = cmap.dim();
@@ -85,10 +90,8 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
     for (std::size_t i = 0; i < x_dofs.size(); ++i)
-    {
-      std::copy_n(std::next(x_g.begin(), 3 * x_dofs[i]), gdim,
-                  std::next(coordinate_dofs.begin(), i * gdim));
-    }
+      for (std::size_t j = 0; j < gdim; ++j)
+        coordinate_dofs[i * gdim + j] = x_g(x_dofs[i], j);
 
     // Push forward coordinates (X -> x)
     for (std::size_t p = 0; p < Xshape[0]; ++p)
@@ -121,10 +124,12 @@ std::vector<T> interpolation_coords(const fem::FiniteElement<T>& element,
 /// @param[in] cells Indices of the cells in the mesh on which to
 /// interpolate. Should be the same as the list of cells used when
 /// calling \ref interpolation_coords.
+/// @param[in] num_threads Number of threads. The cells are divided
+/// into `num_threads` contiguous blocks.
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate(Function<T, U>& u, std::span<const T> f,
                  std::array<std::size_t, 2> fshape,
-                 std::span<const std::int32_t> cells);
+                 std::span<const std::int32_t> cells, int num_threads = 1);
 
 namespace impl
 {
@@ -152,7 +157,7 @@ using mdspan_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
 /// @pre It is required that src_ranks are sorted.
 /// @note `dest_ranks` can contain repeated entries.
 /// @note `dest_ranks` might contain -1 (no process owns the point).
-template <dolfinx::scalar T>
+template <typename T>
 void scatter_values(MPI_Comm comm, std::span<const std::int32_t> src_ranks,
                     std::span<const std::int32_t> dest_ranks,
                     mdspan_t<const T, 2> send_values, std::span<T> recv_values)
@@ -334,6 +339,110 @@ void interpolation_apply(U&& Pi, V&& data, std::span<T> coeffs, int bs)
   }
 }
 
+/// @brief Apply an interpolation operator to the data of a block of
+/// cells.
+///
+/// Computes `coeffs(c, i) = sum_j Pi(i, j) data(c, j)` for each cell
+/// `c`, i.e. the matrix product `coeffs = data Pi^T`. Each row of `Pi`
+/// is applied to all cells in the block, rather than applying the
+/// whole of `Pi` cell-by-cell.
+///
+/// @param[in] Pi The interpolation matrix (shape = (num dofs,
+/// num_points * value_size)).
+/// @param[in] data Function evaluations for each cell (shape =
+/// (num_cells, num_points * value_size)), ordered for each cell as the
+/// columns of `Pi`.
+/// @param[out] coeffs The degrees of freedom for each cell (shape =
+/// (num_cells, num dofs)).
+template <MDSpan U, MDSpan V, MDSpan W>
+void interpolation_apply_cells(U&& Pi, V&& data, W&& coeffs)
+{
+  using T = typename std::remove_cvref_t<W>::value_type;
+  using X = typename dolfinx::scalar_value_type_t<T>;
+  assert(data.extent(1) == Pi.extent(1));
+  assert(coeffs.extent(0) == data.extent(0));
+  assert(coeffs.extent(1) == Pi.extent(0));
+  for (std::size_t i = 0; i < Pi.extent(0); ++i)
+  {
+    for (std::size_t c = 0; c < data.extent(0); ++c)
+    {
+      T acc = 0;
+      for (std::size_t j = 0; j < Pi.extent(1); ++j)
+        acc += static_cast<X>(Pi(i, j)) * data(c, j);
+      coeffs(c, i) = acc;
+    }
+  }
+}
+
+/// @brief Compute the expansion coefficients of a Function on blocks
+/// of cells, and set them in the coefficient array of the Function.
+///
+/// The callable `kernel(c0, c1, values)` computes the coefficients on
+/// the cells `cells[c0:c1]`, and stores them in `values` (shape = (c1
+/// - c0, ndofs)) in the (block size unrolled) cell dof order of
+/// `dofmap`. It is called concurrently for different blocks, so its
+/// work arrays must be local to each call. Coefficients are set in
+/// `coeffs` by the calling thread, in cell order, so the result does
+/// not depend on the number of threads.
+///
+/// @param[out] coeffs Coefficient array of the Function.
+/// @param[in] dofmap Dofmap of the Function.
+/// @param[in] cells Cells to compute the coefficients on.
+/// @param[in] ndofs Number of (block size unrolled) dofs per cell.
+/// @param[in] num_threads Number of threads. The cells are divided
+/// into `num_threads` contiguous blocks.
+/// @param[in] kernel Function that computes the coefficients on a
+/// block of cells.
+template <dolfinx::scalar T, typename F>
+void interpolate_cells(std::span<T> coeffs, const DofMap& dofmap,
+                       std::span<const std::int32_t> cells,
+                       std::size_t ndofs, int num_threads, F&& kernel)
+{
+  // Number of cells computed by a call to the kernel
+  constexpr std::size_t block_size = 32;
+
+  const int bs = dofmap.bs();
+  auto scatter = [&](std::size_t c0, std::size_t c1, std::span<const T> values)
+  {
+    for (std::size_t c = c0; c < c1; ++c)
+    {
+      std::span<const std::int32_t> dofs = dofmap.cell_dofs(cells[c]);
+      std::span<const T> v = values.subspan((c - c0) * ndofs, ndofs);
+      for (std::size_t i = 0; i < dofs.size(); ++i)
+        for (int k = 0; k < bs; ++k)
+          coeffs[bs * dofs[i] + k] = v[bs * i + k];
+    }
+  };
+
+  if (num_threads < 2)
+  {
+    std::vector<T> values(block_size * ndofs);
+    for (std::size_t c0 = 0; c0 < cells.size(); c0 += block_size)
+    {
+      const std::size_t c1 = std::min(c0 + block_size, cells.size());
+      kernel(c0, c1, std::span(values));
+      scatter(c0, c1, values);
+    }
+  }
+  else
+  {
+    std::vector<T> values(cells.size() * ndofs);
+    common::thread_pool().run(
+        num_threads,
+        [&](int t)
+        {
+          auto [p0, p1]
+              = dolfinx::MPI::local_range(t, cells.size(), num_threads);
+          for (std::size_t c0 = p0; c0 < std::size_t(p1); c0 += block_size)
+          {
+            const std::size_t c1 = std::min(c0 + block_size, std::size_t(p1));
+            kernel(c0, c1, std::span(values).subspan(c0 * ndofs));
+          }
+        });
+    scatter(0, cells.size(), values);
+  }
+}
+
 /// @brief Interpolate from one finite element Function to another on
 /// the same mesh.
 ///
@@ -350,13 +459,16 @@ void interpolation_apply(U&& Pi, V&& data, std::span<T> coeffs, int bs)
 /// *same* cell but in the mesh associated with `u0`. `cells0` and
 /// `cells1` have be the same size.
 ///
+/// @param[in] num_threads Number of threads.
+///
 /// @pre fem::Functions `u1` and `u0` must share the same mesh and the
 /// elements must share the same basis function map. Neither is checked
 /// by the function.
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate_same_map(Function<T, U>& u1, const Function<T, U>& u0,
                           std::span<const std::int32_t> cells1,
-                          std::span<const std::int32_t> cells0)
+                          std::span<const std::int32_t> cells0,
+                          int num_threads = 1)
 {
   auto V0 = u0.function_space();
   assert(V0);
@@ -396,7 +508,6 @@ void interpolate_same_map(Function<T, U>& u1, const Function<T, U>& u0,
   auto dofmap0 = V0->dofmap();
 
   // Get block sizes and dof transformation operators
-  const int bs1 = dofmap1->bs();
   const int bs0 = dofmap0->bs();
   auto apply_dof_transformation = element0->template dof_transformation_fn<T>(
       doftransform::transpose, false);
@@ -404,39 +515,42 @@ void interpolate_same_map(Function<T, U>& u1, const Function<T, U>& u0,
       = element1->template dof_transformation_fn<T>(
           doftransform::inverse_transpose, false);
 
-  // Create working array
-  std::vector<T> local0(element0->space_dimension());
-  std::vector<T> local1(element1->space_dimension());
-
   // Create interpolation operator
   const auto [i_m, im_shape]
       = element1->create_interpolation_operator(*element0);
+  mdspan_t<const U, 2> Pi(i_m.data(), im_shape);
 
-  // Iterate over mesh and interpolate on each cell
-  using X = typename dolfinx::scalar_value_type_t<T>;
-  for (std::size_t c = 0; c < cells0.size(); c++)
+  // Iterate over blocks of cells, and interpolate on each block
+  const std::size_t ndofs0 = element0->space_dimension();
+  const std::size_t ndofs1 = element1->space_dimension();
+  auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values)
   {
     // Pack and transform cell dofs to reference ordering
-    std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(cells0[c]);
-    for (std::size_t i = 0; i < dofs0.size(); ++i)
-      for (int k = 0; k < bs0; ++k)
-        local0[bs0 * i + k] = u0_array[bs0 * dofs0[i] + k];
-
-    apply_dof_transformation(local0, cell_info0, cells0[c], 1);
-
-    // FIXME: Get compile-time ranges from Basix
-    // Apply interpolation operator
-    std::ranges::fill(local1, 0);
-    for (std::size_t i = 0; i < im_shape[0]; ++i)
-      for (std::size_t j = 0; j < im_shape[1]; ++j)
-        local1[i] += static_cast<X>(i_m[im_shape[1] * i + j]) * local0[j];
-
-    apply_inverse_dof_transform(local1, cell_info1, cells1[c], 1);
-    std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(cells1[c]);
-    for (std::size_t i = 0; i < dofs1.size(); ++i)
-      for (int k = 0; k < bs1; ++k)
-        u1_array[bs1 * dofs1[i] + k] = local1[bs1 * i + k];
-  }
+    std::vector<T> local0((c1 - c0) * ndofs0);
+    for (std::size_t c = c0; c < c1; ++c)
+    {
+      std::span<T> _local0(local0.data() + (c - c0) * ndofs0, ndofs0);
+      std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(cells0[c]);
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
+        for (int k = 0; k < bs0; ++k)
+          _local0[bs0 * i + k] = u0_array[bs0 * dofs0[i] + k];
+      apply_dof_transformation(_local0, cell_info0, cells0[c], 1);
+    }
+
+    // Apply interpolation operator to all cells in the block
+    interpolation_apply_cells(
+        Pi, mdspan_t<const T, 2>(local0.data(), c1 - c0, ndofs0),
+        mdspan_t<T, 2>(values.data(), c1 - c0, ndofs1));
+
+    for (std::size_t c = c0; c < c1; ++c)
+    {
+      apply_inverse_dof_transform(values.subspan((c - c0) * ndofs1, ndofs1),
+                                  cell_info1, cells1[c], 1);
+    }
+  };
+
+  interpolate_cells(u1_array, *dofmap1, cells1, ndofs1, num_threads,
+                    kernel);
 }
 
 /// @brief Interpolate from one finite element Function to another on
@@ -451,13 +565,15 @@ void interpolate_same_map(Function<T, U>& u1, const Function<T, U>& u0,
 /// @param[in] cells1 Cells to interpolate on.
 /// @param[in] u0 Function to interpolate from.
 /// @param[in] cells0 Equivalent cell in `u0` for each cell in `u1`.
+/// @param[in] num_threads Number of threads.
 /// @pre The functions `u1` and `u0` must share the same mesh. This is
 /// not checked by the function.
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate_nonmatching_maps(Function<T, U>& u1,
                                   std::span<const std::int32_t> cells1,
                                   const Function<T, U>& u0,
-                                  std::span<const std::int32_t> cells0)
+                                  std::span<const std::int32_t> cells0,
+                                  int num_threads = 1)
 {
   // Get mesh
   auto V0 = u0.function_space();
@@ -513,7 +629,7 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   const CoordinateElement<U>& cmap = mesh0->geometry().cmap();
   auto x_dofmap = mesh0->geometry().dofmap();
   const std::size_t num_dofs_g = cmap.dim();
-  std::span<const U> x_g = mesh0->geometry().x();
+  mesh::NodeCoordinates<U> x_g = mesh0->geometry().coordinates();
 
   // Evaluate coordinate map basis at reference interpolation points
   const std::array<std::size_t, 4> phi_shape
@@ -529,35 +645,6 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   mdspan_t<const U, 4> basis_derivatives_reference0(
       _basis_derivatives_reference0.data(), b0shape);
 
-  // Create working arrays
-  std::vector<T> local1(element1->space_dimension());
-  std::vector<T> coeffs0(element0->space_dimension());
-
-  std::vector<U> basis0_b(Xshape[0] * dim0 * value_size0);
-  impl::mdspan_t<U, 3> basis0(basis0_b.data(), Xshape[0], dim0, value_size0);
-
-  std::vector<U> basis_reference0_b(Xshape[0] * dim0 * value_size_ref0);
-  impl::mdspan_t<U, 3> basis_reference0(basis_reference0_b.data(), Xshape[0],
-                                        dim0, value_size_ref0);
-
-  std::vector<T> values0_b(Xshape[0] * 1 * V1->element()->value_size());
-  impl::mdspan_t<T, 3> values0(values0_b.data(), Xshape[0], 1,
-                               V1->element()->value_size());
-
-  std::vector<T> mapped_values_b(Xshape[0] * 1 * V1->element()->value_size());
-  impl::mdspan_t<T, 3> mapped_values0(mapped_values_b.data(), Xshape[0], 1,
-                                      V1->element()->value_size());
-
-  std::vector<U> coord_dofs_b(num_dofs_g * gdim);
-  impl::mdspan_t<U, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
-
-  std::vector<U> J_b(Xshape[0] * gdim * tdim);
-  impl::mdspan_t<U, 3> J(J_b.data(), Xshape[0], gdim, tdim);
-  std::vector<U> K_b(Xshape[0] * tdim * gdim);
-  impl::mdspan_t<U, 3> K(K_b.data(), Xshape[0], tdim, gdim);
-  std::vector<U> detJ(Xshape[0]);
-  std::vector<U> det_scratch(2 * gdim * tdim);
-
   // Get interpolation operator
   const auto [_Pi_1, pi_shape] = element1->interpolation_operator();
   impl::mdspan_t<const U, 2> Pi_1(_Pi_1.data(), pi_shape);
@@ -574,137 +661,186 @@ void interpolate_nonmatching_maps(Function<T, U>& u1,
   auto pull_back_fn1
       = element1->basix_element().template map_fn<V_t, v_t, K_t, J_t>();
 
-  // Iterate over mesh and interpolate on each cell
+  // Iterate over blocks of cells and interpolate on each cell
   std::span<const T> array0 = u0.x()->array();
   std::span<T> array1 = u1.x()->mutable_array();
-  for (std::size_t c = 0; c < cells0.size(); c++)
+  const std::size_t ndofs1 = element1->space_dimension();
+  const std::size_t num_points = Xshape[0];
+  auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values1)
   {
-    // Get cell geometry (coordinate dofs)
-    auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        x_dofmap, cells0[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    for (std::size_t i = 0; i < num_dofs_g; ++i)
-    {
-      const int pos = 3 * x_dofs[i];
-      for (std::size_t j = 0; j < gdim; ++j)
-        coord_dofs(i, j) = x_g[pos + j];
-    }
+    // Create working arrays
+    std::vector<T> coeffs0(element0->space_dimension());
 
-    // Compute Jacobians and reference points for current cell
-    std::ranges::fill(J_b, 0);
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
-    {
-      auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          phi, std::pair(1, tdim + 1), p,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+    std::vector<U> basis0_b(num_points * dim0 * value_size0);
+    impl::mdspan_t<U, 3> basis0(basis0_b.data(), num_points, dim0, value_size0);
 
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      cmap.compute_jacobian(dphi, coord_dofs, _J);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      cmap.compute_jacobian_inverse(_J, _K);
-      detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
-    }
+    std::vector<U> basis_reference0_b(num_points * dim0 * value_size_ref0);
+    impl::mdspan_t<U, 3> basis_reference0(basis_reference0_b.data(), num_points,
+                                          dim0, value_size_ref0);
 
-    // Copy evaluated basis on reference, apply DOF transformations, and
-    // push forward to physical element
-    for (std::size_t k0 = 0; k0 < basis_reference0.extent(0); ++k0)
-      for (std::size_t k1 = 0; k1 < basis_reference0.extent(1); ++k1)
-        for (std::size_t k2 = 0; k2 < basis_reference0.extent(2); ++k2)
-          basis_reference0(k0, k1, k2)
-              = basis_derivatives_reference0(0, k0, k1, k2);
+    std::vector<T> values0_b(num_points * 1 * V1->element()->value_size());
+    impl::mdspan_t<T, 3> values0(values0_b.data(), num_points, 1,
+                                 V1->element()->value_size());
 
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
-    {
-      apply_dof_transformation0(
-          std::span(basis_reference0_b.data() + p * dim0 * value_size_ref0,
-                    dim0 * value_size_ref0),
-          cell_info0, cells0[c], value_size_ref0);
-    }
+    std::vector<T> mapped_values_b(num_points * 1
+                                   * V1->element()->value_size());
+    impl::mdspan_t<T, 3> mapped_values0(mapped_values_b.data(), num_points, 1,
+                                        V1->element()->value_size());
 
-    for (std::size_t i = 0; i < basis0.extent(0); ++i)
-    {
-      auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          basis0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          basis_reference0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      push_forward_fn0(_u, _U, _J, detJ[i], _K);
-    }
+    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+    impl::mdspan_t<U, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
 
-    // Copy expansion coefficients for v into local array
-    const int dof_bs0 = dofmap0->bs();
-    std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(cells0[c]);
-    for (std::size_t i = 0; i < dofs0.size(); ++i)
-      for (int k = 0; k < dof_bs0; ++k)
-        coeffs0[dof_bs0 * i + k] = array0[dof_bs0 * dofs0[i] + k];
+    std::vector<U> J_b(num_points * gdim * tdim);
+    impl::mdspan_t<U, 3> J(J_b.data(), num_points, gdim, tdim);
+    std::vector<U> K_b(num_points * tdim * gdim);
+    impl::mdspan_t<U, 3> K(K_b.data(), num_points, tdim, gdim);
+    std::vector<U> detJ(num_points);
+    std::vector<U> det_scratch(2 * gdim * tdim);
 
-    // Evaluate v at the interpolation points (physical space values)
-    using X = typename dolfinx::scalar_value_type_t<T>;
-    for (std::size_t p = 0; p < Xshape[0]; ++p)
+    for (std::size_t c = c0; c < c1; c++)
     {
-      for (int k = 0; k < bs0; ++k)
+      // Get cell geometry (coordinate dofs)
+      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, cells0[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = x_g(x_dofs[i], j);
+
+      // Compute Jacobians and reference points for current cell
+      std::ranges::fill(J_b, 0);
+      for (std::size_t p = 0; p < num_points; ++p)
+      {
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(1, tdim + 1), p,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian(dphi, coord_dofs, _J);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian_inverse(_J, _K);
+        detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
+      }
+
+      // Copy evaluated basis on reference, apply DOF transformations, and
+      // push forward to physical element
+      for (std::size_t k0 = 0; k0 < basis_reference0.extent(0); ++k0)
+        for (std::size_t k1 = 0; k1 < basis_reference0.extent(1); ++k1)
+          for (std::size_t k2 = 0; k2 < basis_reference0.extent(2); ++k2)
+            basis_reference0(k0, k1, k2)
+                = basis_derivatives_reference0(0, k0, k1, k2);
+
+      for (std::size_t p = 0; p < num_points; ++p)
+      {
+        apply_dof_transformation0(
+            std::span(basis_reference0_b.data() + p * dim0 * value_size_ref0,
+                      dim0 * value_size_ref0),
+            cell_info0, cells0[c], value_size_ref0);
+      }
+
+      for (std::size_t i = 0; i < basis0.extent(0); ++i)
+      {
+        auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            basis0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            basis_reference0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        push_forward_fn0(_u, _U, _J, detJ[i], _K);
+      }
+
+      // Copy expansion coefficients for v into local array
+      const int dof_bs0 = dofmap0->bs();
+      std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(cells0[c]);
+      for (std::size_t i = 0; i < dofs0.size(); ++i)
+        for (int k = 0; k < dof_bs0; ++k)
+          coeffs0[dof_bs0 * i + k] = array0[dof_bs0 * dofs0[i] + k];
+
+      // Evaluate v at the interpolation points (physical space values)
+      using X = typename dolfinx::scalar_value_type_t<T>;
+      for (std::size_t p = 0; p < num_points; ++p)
       {
-        for (std::size_t j = 0; j < value_size0; ++j)
+        for (int k = 0; k < bs0; ++k)
         {
-          T acc = 0;
-          for (std::size_t i = 0; i < dim0; ++i)
-            acc += coeffs0[bs0 * i + k] * static_cast<X>(basis0(p, i, j));
-          values0(p, 0, j * bs0 + k) = acc;
+          for (std::size_t j = 0; j < value_size0; ++j)
+          {
+            T acc = 0;
+            for (std::size_t i = 0; i < dim0; ++i)
+              acc += coeffs0[bs0 * i + k] * static_cast<X>(basis0(p, i, j));
+            values0(p, 0, j * bs0 + k) = acc;
+          }
         }
       }
-    }
 
-    // Pull back the physical values to the u reference
-    for (std::size_t i = 0; i < values0.extent(0); ++i)
-    {
-      auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          values0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          mapped_values0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-          MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+      // Pull back the physical values to the u reference
+      for (std::size_t i = 0; i < values0.extent(0); ++i)
+      {
+        auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            values0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            mapped_values0, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        pull_back_fn1(_U, _u, _K, 1.0 / detJ[i], _J);
+      }
+
+      auto values = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          mapped_values0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0,
           MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      pull_back_fn1(_U, _u, _K, 1.0 / detJ[i], _J);
+      std::span<T> local1 = values1.subspan((c - c0) * ndofs1, ndofs1);
+      interpolation_apply(Pi_1, values, local1, bs1);
+      apply_inverse_dof_transform1(local1, cell_info1, cells1[c], 1);
     }
+  };
 
-    auto values = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-        mapped_values0, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0,
-        MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    interpolation_apply(Pi_1, values, std::span(local1), bs1);
-    apply_inverse_dof_transform1(local1, cell_info1, cells1[c], 1);
-
-    // Copy local coefficients to the correct position in u dof array
-    const int dof_bs1 = dofmap1->bs();
-    std::span<const std::int32_t> dofs1 = dofmap1->cell_dofs(c);
-    for (std::size_t i = 0; i < dofs1.size(); ++i)
-      for (int k = 0; k < dof_bs1; ++k)
-        array1[dof_bs1 * dofs1[i] + k] = local1[dof_bs1 * i + k];
-  }
+  interpolate_cells(array1, *dofmap1, cells1, ndofs1, num_threads, kernel);
 }
 
-//----------------------------------------------------------------------------
-} // namespace impl
-
+/// @brief Interpolate an evaluated expression f(x) in a finite element
+/// space, optionally with precomputed geometry data.
+///
+/// See fem::interpolate(Function<T, U>&, std::span<const T>,
+/// std::array<std::size_t, 2>, std::span<const std::int32_t>, int).
+///
+/// @param[out] u Function object to interpolate into.
+/// @param[in] f Evaluation of the function `f(x)` at the physical
+/// points `x` given by \ref interpolation_coords.
+/// @param[in] fshape Shape of `f`.
+/// @param[in] cells Indices of the cells in the mesh on which to
+/// interpolate.
+/// @param[in] num_threads Number of threads.
+/// @param[in] J Jacobians of the geometry map at the interpolation
+/// points of each cell in `cells` (`shape=(cells.size(), num_points,
+/// gdim, tdim)`). Only used if the element is not mapped by the
+/// identity. If empty, the Jacobian data is computed.
+/// @param[in] K Inverse Jacobians (`shape=(cells.size(), num_points,
+/// tdim, gdim)`).
+/// @param[in] detJ Jacobian determinants (`shape=(cells.size(),
+/// num_points)`).
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate(Function<T, U>& u, std::span<const T> f,
                  std::array<std::size_t, 2> fshape,
-                 std::span<const std::int32_t> cells)
+                 std::span<const std::int32_t> cells, int num_threads,
+                 std::span<const U> J, std::span<const U> K,
+                 std::span<const U> detJ)
 {
+  using cmdspan3_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>;
   using cmdspan2_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const U, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
   using cmdspan4_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
@@ -750,14 +886,15 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
   // Get dofmap
   const auto dofmap = u.function_space()->dofmap();
   assert(dofmap);
-  const int dofmap_bs = dofmap->bs();
 
-  // Loop over cells and compute interpolation dofs
+  // Loop over blocks of cells and compute interpolation dofs. The dofs
+  // of each cell are computed in the (block size unrolled) dofmap
+  // order, with dof i * element_bs + k for scalar dof i of block k.
   const int num_scalar_dofs = element->space_dimension() / element_bs;
   const int value_size = u.function_space()->element()->reference_value_size();
+  const std::size_t ndofs = element->space_dimension();
 
   std::span<T> coeffs = u.x()->mutable_array();
-  std::vector<T> _coeffs(num_scalar_dofs);
 
   // This assumes that any element with an identity interpolation matrix
   // is a point evaluation
@@ -777,67 +914,72 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
       while (matrix_size * matrix_size < fshape[0])
         ++matrix_size;
 
-      // Loop over cells
-      for (std::size_t c = 0; c < cells.size(); ++c)
+      auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values)
       {
-        // The entries of a symmetric matrix are numbered (for an
-        // example 4x4 element):
-        //  0 * * *
-        //  1 2 * *
-        //  3 4 5 *
-        //  6 7 8 9
-        // The loop extracts these elements. In this loop, row is the
-        // row of this matrix, and (k - rowstart) is the column
-        std::size_t row = 0;
-        std::size_t rowstart = 0;
-        const std::int32_t cell = cells[c];
-        std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-        for (int k = 0; k < element_bs; ++k)
+        std::vector<T> _coeffs(num_scalar_dofs);
+        for (std::size_t c = c0; c < c1; ++c)
         {
-          if (k - rowstart > row)
-          {
-            ++row;
-            rowstart = k;
-          }
-
-          // num_scalar_dofs is the number of interpolation points per
-          // cell in this case (interpolation matrix is identity)
-          std::copy_n(
-              std::next(f.begin(), (row * matrix_size + k - rowstart) * f_shape1
-                                       + c * num_scalar_dofs),
-              num_scalar_dofs, _coeffs.begin());
-          apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-          for (int i = 0; i < num_scalar_dofs; ++i)
+          // The entries of a symmetric matrix are numbered (for an
+          // example 4x4 element):
+          //  0 * * *
+          //  1 2 * *
+          //  3 4 5 *
+          //  6 7 8 9
+          // The loop extracts these elements. In this loop, row is the
+          // row of this matrix, and (k - rowstart) is the column
+          std::size_t row = 0;
+          std::size_t rowstart = 0;
+          const std::int32_t cell = cells[c];
+          std::span<T> cell_values = values.subspan((c - c0) * ndofs, ndofs);
+          for (int k = 0; k < element_bs; ++k)
           {
-            const int dof = i * element_bs + k;
-            std::div_t pos = std::div(dof, dofmap_bs);
-            coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+            if (k - rowstart > row)
+            {
+              ++row;
+              rowstart = k;
+            }
+
+            // num_scalar_dofs is the number of interpolation points per
+            // cell in this case (interpolation matrix is identity)
+            std::copy_n(std::next(f.begin(),
+                                  (row * matrix_size + k - rowstart) * f_shape1
+                                      + c * num_scalar_dofs),
+                        num_scalar_dofs, _coeffs.begin());
+            apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell,
+                                                   1);
+            for (int i = 0; i < num_scalar_dofs; ++i)
+              cell_values[i * element_bs + k] = _coeffs[i];
           }
         }
-      }
+      };
+      impl::interpolate_cells(coeffs, *dofmap, cells, ndofs, num_threads,
+                              kernel);
     }
     else
     {
-      // Loop over cells
-      for (std::size_t c = 0; c < cells.size(); ++c)
+      auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values)
       {
-        const std::int32_t cell = cells[c];
-        std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-        for (int k = 0; k < element_bs; ++k)
+        std::vector<T> _coeffs(num_scalar_dofs);
+        for (std::size_t c = c0; c < c1; ++c)
         {
-          // num_scalar_dofs is the number of interpolation points per
-          // cell in this case (interpolation matrix is identity)
-          std::copy_n(std::next(f.begin(), k * f_shape1 + c * num_scalar_dofs),
-                      num_scalar_dofs, _coeffs.begin());
-          apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-          for (int i = 0; i < num_scalar_dofs; ++i)
+          const std::int32_t cell = cells[c];
+          std::span<T> cell_values = values.subspan((c - c0) * ndofs, ndofs);
+          for (int k = 0; k < element_bs; ++k)
           {
-            const int dof = i * element_bs + k;
-            std::div_t pos = std::div(dof, dofmap_bs);
-            coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+            // num_scalar_dofs is the number of interpolation points per
+            // cell in this case (interpolation matrix is identity)
+            std::copy_n(
+                std::next(f.begin(), k * f_shape1 + c * num_scalar_dofs),
+                num_scalar_dofs, _coeffs.begin());
+            apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell,
+                                                   1);
+            for (int i = 0; i < num_scalar_dofs; ++i)
+              cell_values[i * element_bs + k] = _coeffs[i];
           }
         }
-      }
+      };
+      impl::interpolate_cells(coeffs, *dofmap, cells, ndofs, num_threads,
+                              kernel);
     }
   }
   else if (element->map_ident())
@@ -870,37 +1012,49 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
         = element->template dof_transformation_fn<T>(
             doftransform::inverse_transpose, true);
 
-    // Loop over cells
-    std::vector<T> ref_data_b(num_interp_points);
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
-               std::size_t, MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent, 1>>
-        ref_data(ref_data_b.data(), num_interp_points, 1);
-    for (std::size_t c = 0; c < cells.size(); ++c)
+    auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values)
     {
-      const std::int32_t cell = cells[c];
-      std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-      for (int k = 0; k < element_bs; ++k)
+      // Gather the data for each (cell, block) pair, and apply the
+      // interpolation operator to all pairs together
+      const std::size_t num_rows = (c1 - c0) * element_bs;
+      const std::size_t n = num_interp_points / element_vs;
+      std::vector<T> data_b(num_rows * num_interp_points);
+      std::vector<T> dofs_b(num_rows * num_scalar_dofs);
+      for (std::size_t c = c0; c < c1; ++c)
       {
-        for (int i = 0; i < element_vs; ++i)
+        for (int k = 0; k < element_bs; ++k)
         {
-          std::copy_n(
-              std::next(f.begin(), (i + k) * f_shape1
-                                       + c * num_interp_points / element_vs),
-              num_interp_points / element_vs,
-              std::next(ref_data_b.begin(),
-                        i * num_interp_points / element_vs));
+          const std::size_t r = (c - c0) * element_bs + k;
+          for (int i = 0; i < element_vs; ++i)
+          {
+            std::copy_n(std::next(f.begin(), (i + k) * f_shape1 + c * n), n,
+                        std::next(data_b.begin(),
+                                  r * num_interp_points + i * n));
+          }
         }
-        impl::interpolation_apply(Pi, ref_data, std::span(_coeffs), 1);
-        apply_inv_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
-        for (int i = 0; i < num_scalar_dofs; ++i)
+      }
+      impl::interpolation_apply_cells(
+          Pi, impl::mdspan_t<const T, 2>(data_b.data(), num_rows,
+                                         num_interp_points),
+          impl::mdspan_t<T, 2>(dofs_b.data(), num_rows, num_scalar_dofs));
+
+      for (std::size_t c = c0; c < c1; ++c)
+      {
+        std::span<T> cell_values = values.subspan((c - c0) * ndofs, ndofs);
+        for (int k = 0; k < element_bs; ++k)
         {
-          const int dof = i * element_bs + k;
-          std::div_t pos = std::div(dof, dofmap_bs);
-          coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+          const std::size_t r = (c - c0) * element_bs + k;
+          std::span<T> _coeffs(dofs_b.data() + r * num_scalar_dofs,
+                               num_scalar_dofs);
+          apply_inv_transpose_dof_transformation(_coeffs, cell_info,
+                                                 cells[c], 1);
+          for (int i = 0; i < num_scalar_dofs; ++i)
+            cell_values[i * element_bs + k] = _coeffs[i];
         }
       }
-    }
+    };
+    impl::interpolate_cells(coeffs, *dofmap, cells, ndofs, num_threads,
+                            kernel);
   }
   else
   {
@@ -926,32 +1080,13 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
     // Get geometry data
     auto x_dofmap = mesh->geometry().dofmap();
     const int num_dofs_g = cmap.dim();
-    std::span<const U> x_g = mesh->geometry().x();
-
-    // Create data structures for Jacobian info
-    std::vector<U> J_b(Xshape[0] * gdim * tdim);
-    mdspan3_t J(J_b.data(), Xshape[0], gdim, tdim);
-    std::vector<U> K_b(Xshape[0] * tdim * gdim);
-    mdspan3_t K(K_b.data(), Xshape[0], tdim, gdim);
-    std::vector<U> detJ(Xshape[0]);
-    std::vector<U> det_scratch(2 * gdim * tdim);
-
-    std::vector<U> coord_dofs_b(num_dofs_g * gdim);
-    mdspan2_t coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+    mesh::NodeCoordinates<U> x_g = mesh->geometry().coordinates();
+    const std::size_t num_points = Xshape[0];
     const std::size_t value_size_ref = element->reference_value_size();
-    std::vector<T> ref_data_b(Xshape[0] * 1 * value_size_ref);
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
-        ref_data(ref_data_b.data(), Xshape[0], 1, value_size_ref);
-
-    std::vector<T> _vals_b(Xshape[0] * 1 * value_size);
-    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
-        T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
-        _vals(_vals_b.data(), Xshape[0], 1, value_size);
 
     // Tabulate 1st derivative of shape functions at interpolation
     // coords
-    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, Xshape[0]);
+    std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, num_points);
     std::vector<U> phi_b(
         std::reduce(phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
     cmdspan4_t phi(phi_b.data(), phi_shape);
@@ -970,6 +1105,7 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
     // Get interpolation operator
     const auto [_Pi, pi_shape] = element->interpolation_operator();
     cmdspan2_t Pi(_Pi.data(), pi_shape);
+    assert(Pi.extent(1) == num_points * value_size_ref);
 
     using u_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
         const T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>;
@@ -982,84 +1118,389 @@ void interpolate(Function<T, U>& u, std::span<const T> f,
     auto pull_back_fn
         = element->basix_element().template map_fn<U_t, u_t, J_t, K_t>();
 
-    for (std::size_t c = 0; c < cells.size(); ++c)
+    const bool precomputed = !J.empty();
+    if (precomputed
+        and (J.size() != cells.size() * num_points * gdim * tdim
+             or K.size() != J.size()
+             or detJ.size() != cells.size() * num_points))
     {
-      const std::int32_t cell = cells[c];
-      auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-          x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      for (int i = 0; i < num_dofs_g; ++i)
-      {
-        const int pos = 3 * x_dofs[i];
-        for (int j = 0; j < gdim; ++j)
-          coord_dofs(i, j) = x_g[pos + j];
-      }
-
-      // Compute J, detJ and K
-      std::ranges::fill(J_b, 0);
-      for (std::size_t p = 0; p < Xshape[0]; ++p)
-      {
-        auto _dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            dphi, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, p,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        cmap.compute_jacobian(_dphi, coord_dofs, _J);
-        auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        cmap.compute_jacobian_inverse(_J, _K);
-        detJ[p] = cmap.compute_jacobian_determinant(_J, det_scratch);
-      }
+      throw std::runtime_error("Jacobian data has the wrong size.");
+    }
 
-      std::span<const std::int32_t> dofs = dofmap->cell_dofs(cell);
-      for (int k = 0; k < element_bs; ++k)
+    auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values)
+    {
+      // Create data structures for Jacobian info
+      std::vector<U> J_b(precomputed ? 0 : num_points * gdim * tdim);
+      std::vector<U> K_b(precomputed ? 0 : num_points * tdim * gdim);
+      std::vector<U> detJ_b(precomputed ? 0 : num_points);
+      std::vector<U> det_scratch(2 * gdim * tdim);
+
+      std::vector<U> coord_dofs_b(num_dofs_g * gdim);
+      mdspan2_t coord_dofs(coord_dofs_b.data(), num_dofs_g, gdim);
+      std::vector<T> ref_data_b(num_points * 1 * value_size_ref);
+      MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+          T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
+          ref_data(ref_data_b.data(), num_points, 1, value_size_ref);
+
+      std::vector<T> _vals_b(num_points * 1 * value_size);
+      MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+          T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 3>>
+          _vals(_vals_b.data(), num_points, 1, value_size);
+
+      // Pulled back data for each (cell, block) pair, ordered as the
+      // columns of the interpolation operator
+      const std::size_t num_rows = (c1 - c0) * element_bs;
+      std::vector<T> data_b(num_rows * Pi.extent(1));
+      std::vector<T> dofs_b(num_rows * num_scalar_dofs);
+
+      for (std::size_t c = c0; c < c1; ++c)
       {
-        // Extract computed expression values for element block k
-        for (int m = 0; m < value_size; ++m)
+        std::span<const U> detJ_c;
+        cmdspan3_t J_c, K_c;
+        if (precomputed)
         {
-          for (std::size_t k0 = 0; k0 < Xshape[0]; ++k0)
+          const std::size_t offset = c * num_points * gdim * tdim;
+          J_c = cmdspan3_t(J.data() + offset, num_points, gdim, tdim);
+          K_c = cmdspan3_t(K.data() + offset, num_points, tdim, gdim);
+          detJ_c = detJ.subspan(c * num_points, num_points);
+        }
+        else
+        {
+          auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+              x_dofmap, cells[c], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+          for (int i = 0; i < num_dofs_g; ++i)
+            for (int j = 0; j < gdim; ++j)
+              coord_dofs(i, j) = x_g(x_dofs[i], j);
+
+          // Compute J, detJ and K
+          mdspan3_t _J(J_b.data(), num_points, gdim, tdim);
+          mdspan3_t _K(K_b.data(), num_points, tdim, gdim);
+          std::ranges::fill(J_b, 0);
+          for (std::size_t p = 0; p < num_points; ++p)
           {
-            _vals(k0, 0, m)
-                = f[f_shape1 * (k * value_size + m) + c * Xshape[0] + k0];
+            auto _dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                dphi, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, p,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            auto Jp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                _J, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            cmap.compute_jacobian(_dphi, coord_dofs, Jp);
+            auto Kp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                _K, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            cmap.compute_jacobian_inverse(Jp, Kp);
+            detJ_b[p] = cmap.compute_jacobian_determinant(Jp, det_scratch);
           }
+          J_c = _J;
+          K_c = _K;
+          detJ_c = detJ_b;
         }
 
-        // Get element degrees of freedom for block
-        for (std::size_t i = 0; i < Xshape[0]; ++i)
+        for (int k = 0; k < element_bs; ++k)
         {
-          auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              _vals, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              ref_data, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              K, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-              J, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
-              MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-          pull_back_fn(_U, _u, _K, 1.0 / detJ[i], _J);
+          // Extract computed expression values for element block k
+          for (int m = 0; m < value_size; ++m)
+          {
+            for (std::size_t k0 = 0; k0 < num_points; ++k0)
+            {
+              _vals(k0, 0, m)
+                  = f[f_shape1 * (k * value_size + m) + c * num_points + k0];
+            }
+          }
+
+          // Pull back the values to the reference cell
+          for (std::size_t i = 0; i < num_points; ++i)
+          {
+            auto _u = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                _vals, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            auto _U = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                ref_data, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            auto _K = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                K_c, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            auto _J = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+                J_c, i, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+                MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+            pull_back_fn(_U, _u, _K, 1.0 / detJ_c[i], _J);
+          }
+
+          // Store the reference values, ordered by component and then
+          // by point
+          T* data = data_b.data() + ((c - c0) * element_bs + k) * Pi.extent(1);
+          for (std::size_t m = 0; m < value_size_ref; ++m)
+            for (std::size_t p = 0; p < num_points; ++p)
+              data[m * num_points + p] = ref_data(p, 0, m);
         }
+      }
 
-        auto ref = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
-            ref_data, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0,
-            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-        impl::interpolation_apply(Pi, ref, std::span(_coeffs), element_bs);
-        apply_inverse_transpose_dof_transformation(_coeffs, cell_info, cell, 1);
+      // Get element degrees of freedom for all (cell, block) pairs
+      impl::interpolation_apply_cells(
+          Pi, impl::mdspan_t<const T, 2>(data_b.data(), num_rows, Pi.extent(1)),
+          impl::mdspan_t<T, 2>(dofs_b.data(), num_rows, num_scalar_dofs));
 
-        // Copy interpolation dofs into coefficient vector
-        assert(_coeffs.size() == num_scalar_dofs);
-        for (int i = 0; i < num_scalar_dofs; ++i)
+      for (std::size_t c = c0; c < c1; ++c)
+      {
+        std::span<T> cell_values = values.subspan((c - c0) * ndofs, ndofs);
+        for (int k = 0; k < element_bs; ++k)
         {
-          const int dof = i * element_bs + k;
-          std::div_t pos = std::div(dof, dofmap_bs);
-          coeffs[dofmap_bs * dofs[pos.quot] + pos.rem] = _coeffs[i];
+          const std::size_t r = (c - c0) * element_bs + k;
+          std::span<T> _coeffs(dofs_b.data() + r * num_scalar_dofs,
+                               num_scalar_dofs);
+          apply_inverse_transpose_dof_transformation(_coeffs, cell_info,
+                                                     cells[c], 1);
+          for (int i = 0; i < num_scalar_dofs; ++i)
+            cell_values[i * element_bs + k] = _coeffs[i];
         }
       }
+    };
+    impl::interpolate_cells(coeffs, *dofmap, cells, ndofs, num_threads,
+                            kernel);
+  }
+}
+//----------------------------------------------------------------------------
+
+/// @brief Interpolate a Function into a space on a nested mesh, with
+/// candidate cells of the mesh of the Function known for each cell.
+///
+/// The interpolation points of each cell `cells1[c]` of the mesh of
+/// `u1` are mapped to the reference coordinates of the candidate cells
+/// `cells0[offsets0[c]:offsets0[c + 1]]` of the mesh of `u0`, and `u0`
+/// is evaluated at each point in the candidate cell that contains it
+/// (the closest candidate if no candidate contains the point). No point
+/// search is performed. This is used to transfer Functions between a
+/// mesh and a refinement of the mesh, see fem::prolong and
+/// fem::inject.
+///
+/// @param[out] u1 Function to interpolate into.
+/// @param[in] cells1 Cells of the mesh of `u1` to interpolate on.
+/// @param[in] u0 Function to interpolate from.
+/// @param[in] offsets0 Offsets into `cells0` of the candidate cells of
+/// each cell in `cells1` (size `cells1.size() + 1`).
+/// @param[in] cells0 Candidate cells of the mesh of `u0`.
+/// @param[in] num_threads Number of threads.
+/// @pre The candidate cells of a cell cover the interpolation points of
+/// the cell.
+template <dolfinx::scalar T, std::floating_point U>
+void interpolate_nested(Function<T, U>& u1,
+                        std::span<const std::int32_t> cells1,
+                        const Function<T, U>& u0,
+                        std::span<const std::int32_t> offsets0,
+                        std::span<const std::int32_t> cells0, int num_threads)
+{
+  auto V0 = u0.function_space();
+  assert(V0);
+  auto V1 = u1.function_space();
+  assert(V1);
+  auto mesh0 = V0->mesh();
+  assert(mesh0);
+  auto mesh1 = V1->mesh();
+  assert(mesh1);
+  auto element0 = V0->element();
+  assert(element0);
+  auto element1 = V1->element();
+  assert(element1);
+  assert(offsets0.size() == cells1.size() + 1);
+
+  for (auto& e : {element0, element1})
+  {
+    if (e->is_mixed() or !e->map_ident()
+        or (e->block_size() > 1
+            and e->reference_value_size() != e->block_size()))
+    {
+      throw std::runtime_error("Transfer between nested meshes is supported "
+                               "for elements with an identity map only.");
     }
   }
+  const std::size_t value_size = element0->reference_value_size();
+  if (element1->reference_value_size() != int(value_size))
+    throw std::runtime_error("Elements have different value sizes.");
+
+  const CoordinateElement<U>& cmap0 = mesh0->geometry().cmap();
+  const CoordinateElement<U>& cmap1 = mesh1->geometry().cmap();
+  const int tdim = mesh0->topology()->dim();
+  const std::size_t gdim = mesh0->geometry().dim();
+  const bool simplex = mesh::is_simplex(mesh0->topology()->cell_type());
+  auto x_dofmap0 = mesh0->geometry().dofmap();
+  auto x_dofmap1 = mesh1->geometry().dofmap();
+  mesh::NodeCoordinates<U> x_g0 = mesh0->geometry().coordinates();
+  mesh::NodeCoordinates<U> x_g1 = mesh1->geometry().coordinates();
+
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element1->needs_dof_transformations()
+      or element0->needs_dof_transformations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+  auto apply_dof_transformation = element0->template dof_transformation_fn<T>(
+      doftransform::transpose, false);
+  auto apply_inverse_dof_transform
+      = element1->template dof_transformation_fn<T>(
+          doftransform::inverse_transpose, false);
+
+  auto dofmap0 = V0->dofmap();
+  assert(dofmap0);
+  auto dofmap1 = V1->dofmap();
+  assert(dofmap1);
+  const int bs0 = dofmap0->bs();
+  const int ebs0 = element0->block_size();
+  const int ebs1 = element1->block_size();
+  const std::size_t ndofs0 = element0->space_dimension();
+  const std::size_t ndofs1 = element1->space_dimension();
+  const std::size_t dim0 = ndofs0 / ebs0;
+  const std::size_t vs0 = value_size / ebs0;
+
+  // Interpolation operator and points of u1, and the geometry basis of
+  // the mesh of u1 at the points
+  const auto [X1, Xshape] = element1->interpolation_points();
+  const std::size_t num_points = Xshape[0];
+  const auto [Pi_b, Pi_shape] = element1->interpolation_operator();
+  mdspan_t<const U, 2> Pi(Pi_b.data(), Pi_shape);
+  std::array<std::size_t, 4> phi1_shape = cmap1.tabulate_shape(0, num_points);
+  std::vector<U> phi1_b(
+      std::reduce(phi1_shape.begin(), phi1_shape.end(), 1, std::multiplies{}));
+  cmap1.tabulate(0, X1, Xshape, phi1_b);
+  mdspan_t<const U, 2> phi1(phi1_b.data(), phi1_shape[1], phi1_shape[2]);
+
+  // Derivatives of the geometry basis of the mesh of u0, which are
+  // constant on affine cells
+  std::array<std::size_t, 4> phi0_shape = cmap0.tabulate_shape(1, 1);
+  std::vector<U> phi0_b(
+      std::reduce(phi0_shape.begin(), phi0_shape.end(), 1, std::multiplies{}));
+  cmap0.tabulate(1, std::vector<U>(tdim), {1, std::size_t(tdim)}, phi0_b);
+  mdspan_t<const U, 4> phi0(phi0_b.data(), phi0_shape);
+  auto dphi0 = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+      phi0, std::pair(1, tdim + 1), 0,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+
+  // Distance of a reference point outside of the reference cell
+  auto distance = [simplex, tdim](auto&& X, std::size_t p)
+  {
+    U d = 0, sum = 0;
+    for (int i = 0; i < tdim; ++i)
+    {
+      d = std::max(d, -X(p, i));
+      d = simplex ? d : std::max(d, X(p, i) - 1);
+      sum += X(p, i);
+    }
+    return simplex ? std::max(d, sum - 1) : d;
+  };
+
+  std::span<const T> u0_array = u0.x()->array();
+  auto kernel = [&](std::size_t c0, std::size_t c1, std::span<T> values)
+  {
+    std::vector<U> coord_dofs0_b(cmap0.dim() * gdim);
+    mdspan_t<U, 2> coord_dofs0(coord_dofs0_b.data(), cmap0.dim(), gdim);
+    std::vector<U> coord_dofs1_b(cmap1.dim() * gdim);
+    mdspan_t<U, 2> coord_dofs1(coord_dofs1_b.data(), cmap1.dim(), gdim);
+    std::vector<U> x_b(num_points * gdim);
+    mdspan_t<U, 2> x(x_b.data(), num_points, gdim);
+    std::vector<U> X_b(num_points * tdim);
+    mdspan_t<U, 2> X(X_b.data(), num_points, tdim);
+    std::vector<U> X0_b(num_points * tdim);
+    mdspan_t<U, 2> X0(X0_b.data(), num_points, tdim);
+    std::vector<U> J_b(gdim * tdim);
+    mdspan_t<U, 2> J(J_b.data(), gdim, tdim);
+    std::vector<U> K_b(tdim * gdim);
+    mdspan_t<U, 2> K(K_b.data(), tdim, gdim);
+    std::vector<U> dist(num_points);
+    std::vector<std::size_t> owner(num_points);
+    std::vector<U> basis_b(num_points * dim0 * vs0);
+    mdspan_t<const U, 3> basis(basis_b.data(), num_points, dim0, vs0);
+    std::vector<T> data_b(num_points * value_size);
+    mdspan_t<T, 2> data(data_b.data(), num_points, value_size);
+    std::vector<T> local0;
+    for (std::size_t c = c0; c < c1; ++c)
+    {
+      // Physical interpolation points of the cell
+      for (std::size_t i = 0; i < coord_dofs1.extent(0); ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs1(i, j) = x_g1(x_dofmap1(cells1[c], i), j);
+      CoordinateElement<U>::push_forward(x, coord_dofs1, phi1);
+
+      // Map the points to each candidate cell, and keep the candidate
+      // that each point is closest to
+      std::span<const std::int32_t> candidates
+          = cells0.subspan(offsets0[c], offsets0[c + 1] - offsets0[c]);
+      assert(!candidates.empty());
+      local0.resize(candidates.size() * ndofs0);
+      std::ranges::fill(dist, std::numeric_limits<U>::max());
+      for (std::size_t k = 0; k < candidates.size(); ++k)
+      {
+        const std::int32_t p = candidates[k];
+        for (std::size_t i = 0; i < coord_dofs0.extent(0); ++i)
+          for (std::size_t j = 0; j < gdim; ++j)
+            coord_dofs0(i, j) = x_g0(x_dofmap0(p, i), j);
+        if (cmap0.is_affine())
+        {
+          std::ranges::fill(J_b, 0);
+          CoordinateElement<U>::compute_jacobian(dphi0, coord_dofs0, J);
+          CoordinateElement<U>::compute_jacobian_inverse(J, K);
+          std::array<U, 3> xp = {0, 0, 0};
+          for (std::size_t i = 0; i < gdim; ++i)
+            xp[i] = coord_dofs0(0, i);
+          CoordinateElement<U>::pull_back_affine(X, K, xp, x);
+        }
+        else
+          cmap0.pull_back_nonaffine(X, x, coord_dofs0);
+
+        for (std::size_t q = 0; q < num_points; ++q)
+        {
+          if (U d = candidates.size() > 1 ? distance(X, q) : 0; d < dist[q])
+          {
+            dist[q] = d;
+            owner[q] = k;
+            for (int i = 0; i < tdim; ++i)
+              X0(q, i) = X(q, i);
+          }
+        }
+
+        // Pack and transform the cell dofs to reference ordering
+        std::span<T> _local0(local0.data() + k * ndofs0, ndofs0);
+        std::span<const std::int32_t> dofs0 = dofmap0->cell_dofs(p);
+        for (std::size_t i = 0; i < dofs0.size(); ++i)
+          for (int b = 0; b < bs0; ++b)
+            _local0[bs0 * i + b] = u0_array[bs0 * dofs0[i] + b];
+        apply_dof_transformation(_local0, cell_info0, p, 1);
+      }
+
+      // Evaluate u0 at the points
+      element0->tabulate(basis_b, X0_b, {num_points, std::size_t(tdim)}, 0);
+      std::ranges::fill(data_b, 0);
+      for (std::size_t q = 0; q < num_points; ++q)
+      {
+        std::span<const T> _local0(local0.data() + owner[q] * ndofs0,
+                                   ndofs0);
+        for (std::size_t i = 0; i < dim0; ++i)
+          for (int b = 0; b < ebs0; ++b)
+            for (std::size_t m = 0; m < vs0; ++m)
+              data(q, b * vs0 + m) += basis(q, i, m) * _local0[ebs0 * i + b];
+      }
+
+      std::span<T> _values = values.subspan((c - c0) * ndofs1, ndofs1);
+      interpolation_apply(Pi, data, _values, ebs1);
+      apply_inverse_dof_transform(_values, cell_info1, cells1[c], 1);
+    }
+  };
+
+  interpolate_cells(u1.x()->mutable_array(), *dofmap1, cells1, ndofs1,
+                    num_threads, kernel);
+}
+//----------------------------------------------------------------------------
+} // namespace impl
+
+template <dolfinx::scalar T, std::floating_point U>
+void interpolate(Function<T, U>& u, std::span<const T> f,
+                 std::array<std::size_t, 2> fshape,
+                 std::span<const std::int32_t> cells, int num_threads)
+{
+  impl::interpolate(u, f, fshape, cells, num_threads, std::span<const U>(),
+                    std::span<const U>(), std::span<const U>());
 }
 
 /// @brief Generate data needed to interpolate finite element Functions
@@ -1188,9 +1629,12 @@ void interpolate(Function<T, U>& u, const Function<T, U>& v,
 /// the mesh associated with `u1`, then `cells0[i]` is the index of the
 /// *same* cell but in the mesh associated with `u0`. `cells0` and
 /// `cells1` must be the same size.
+/// @param[in] num_threads Number of threads. The cells are divided
+/// into `num_threads` contiguous blocks.
 template <dolfinx::scalar T, std::floating_point U>
 void interpolate(Function<T, U>& u1, std::span<const std::int32_t> cells1,
-                 const Function<T, U>& u0, std::span<const std::int32_t> cells0)
+                 const Function<T, U>& u0, std::span<const std::int32_t> cells0,
+                 int num_threads = 1)
 {
   if (cells0.size() != cells1.size())
     throw std::runtime_error("Length of cell lists do not match.");
@@ -1268,13 +1712,231 @@ void interpolate(Function<T, U>& u1, std::span<const std::int32_t> cells1,
     else if (element1->map_type() == element0->map_type())
     {
       // Different elements, same basis function map type
-      impl::interpolate_same_map(u1, u0, cells1, cells0);
+      impl::interpolate_same_map(u1, u0, cells1, cells0, num_threads);
     }
     else
     {
       //  Different elements with different maps for basis functions
-      impl::interpolate_nonmatching_maps(u1, cells1, u0, cells0);
+      impl::interpolate_nonmatching_maps(u1, cells1, u0, cells0,
+                                         num_threads);
     }
   }
 }
+
+/// @brief Move a finite element Function to a mesh created by
+/// mesh::rebalance.
+///
+/// The degree-of-freedom values of each owned cell of the mesh of `u0`
+/// are sent to the processes that the cell has been moved to, and
+/// are set for the same cell of the mesh of `u1`, including ghost
+/// cells. The values are moved in the reference ordering of the
+/// element, so that elements that need dof transformations are
+/// supported.
+///
+/// @note Collective
+///
+/// @param[out] u1 Function on the mesh returned by mesh::rebalance.
+/// @param[in] u0 Function on the mesh that was rebalanced.
+/// @param[in] dest Destination ranks for each owned cell of the mesh
+/// of `u0`, as returned by mesh::rebalance.
+/// @pre The function spaces of `u0` and `u1` must use the same
+/// element and have the same block size.
+template <dolfinx::scalar T, std::floating_point U>
+void migrate(Function<T, U>& u1, const Function<T, U>& u0,
+             const graph::AdjacencyList<std::int32_t>& dest)
+{
+  auto V0 = u0.function_space();
+  assert(V0);
+  auto V1 = u1.function_space();
+  assert(V1);
+  auto mesh0 = V0->mesh();
+  assert(mesh0);
+  auto mesh1 = V1->mesh();
+  assert(mesh1);
+  auto element0 = V0->element();
+  assert(element0);
+  auto element1 = V1->element();
+  assert(element1);
+  if (*element0 != *element1)
+    throw std::runtime_error("Functions must use the same element.");
+
+  std::span<const std::uint32_t> cell_info0;
+  std::span<const std::uint32_t> cell_info1;
+  if (element0->needs_dof_transformations())
+  {
+    mesh0->topology_mutable()->create_entity_permutations();
+    cell_info0 = std::span(mesh0->topology()->get_cell_permutation_info());
+    mesh1->topology_mutable()->create_entity_permutations();
+    cell_info1 = std::span(mesh1->topology()->get_cell_permutation_info());
+  }
+
+  auto dofmap0 = V0->dofmap();
+  auto dofmap1 = V1->dofmap();
+  const int bs = dofmap0->bs();
+  if (dofmap1->bs() != bs)
+    throw std::runtime_error("Functions must have the same block size.");
+  const std::size_t num_cell_dofs
+      = bs * dofmap0->element_dof_layout().num_dofs();
+
+  auto apply_dof_transformation = element0->template dof_transformation_fn<T>(
+      doftransform::transpose, false);
+  auto apply_inverse_dof_transform
+      = element1->template dof_transformation_fn<T>(
+          doftransform::inverse_transpose, false);
+
+  // Pack and transform dofs of owned cells to reference ordering
+  const int tdim = mesh0->topology()->dim();
+  const std::int32_t num_cells0
+      = mesh0->topology()->index_map(tdim)->size_local();
+  std::span<const T> u0_array = u0.x()->array();
+  std::vector<T> data0(num_cells0 * num_cell_dofs);
+  for (std::int32_t c = 0; c < num_cells0; ++c)
+  {
+    std::span<T> local(data0.data() + c * num_cell_dofs, num_cell_dofs);
+    std::span<const std::int32_t> dofs = dofmap0->cell_dofs(c);
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+      for (int k = 0; k < bs; ++k)
+        local[bs * i + k] = u0_array[bs * dofs[i] + k];
+    apply_dof_transformation(local, cell_info0, c, 1);
+  }
+
+  std::vector<T> data1
+      = mesh::migrate_cell_data<T>(*mesh0->topology(), *mesh1->topology(),
+                                   dest, data0, num_cell_dofs);
+
+  // Transform and set dofs of the cells of the new mesh
+  std::span<T> u1_array = u1.x()->mutable_array();
+  for (std::size_t c = 0; c < data1.size() / num_cell_dofs; ++c)
+  {
+    std::span<T> local(data1.data() + c * num_cell_dofs, num_cell_dofs);
+    apply_inverse_dof_transform(local, cell_info1, c, 1);
+    std::span<const std::int32_t> dofs = dofmap1->cell_dofs(c);
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+      for (int k = 0; k < bs; ++k)
+        u1_array[bs * dofs[i] + k] = local[bs * i + k];
+  }
+}
+
+/// @brief Prolong a Function to a refinement of its mesh.
+///
+/// The Function `u0` on a (coarse) mesh is interpolated into the space
+/// of `u1` on a mesh created by refining the coarse mesh, e.g. to
+/// transfer the state of a simulation after adaptive refinement. The
+/// interpolation points of each fine cell are mapped into its parent
+/// cell and `u0` is evaluated directly in the parent cell, so no global
+/// point search (fem::create_interpolation_data) is required. The
+/// result is the same as interpolation of `u0` into the space of `u1`.
+///
+/// The work is local to each process, followed by an update of the
+/// ghost values of `u1`.
+///
+/// @note Collective
+///
+/// @param[out] u1 Function on the fine mesh.
+/// @param[in] u0 Function on the coarse mesh. Its ghost values must be
+/// up-to-date.
+/// @param[in] parent_cells Parent cell (local index in the coarse mesh)
+/// of each cell of the fine mesh, e.g. computed by refinement::refine
+/// with refinement::Option::parent_cell.
+/// @param[in] num_threads Number of threads.
+/// @pre The fine mesh has not been re-distributed, i.e. the parent of
+/// each fine cell is on the same process.
+/// @pre The elements use the identity map (e.g. Lagrange elements) and
+/// have the same value size.
+template <dolfinx::scalar T, std::floating_point U>
+void prolong(Function<T, U>& u1, const Function<T, U>& u0,
+             std::span<const std::int32_t> parent_cells, int num_threads = 1)
+{
+  auto mesh1 = u1.function_space()->mesh();
+  assert(mesh1);
+  auto cell_map1 = mesh1->topology()->index_map(mesh1->topology()->dim());
+  assert(cell_map1);
+  const std::int32_t num_cells1
+      = cell_map1->size_local() + cell_map1->num_ghosts();
+  if (parent_cells.size() != static_cast<std::size_t>(num_cells1))
+  {
+    throw std::runtime_error(
+        "Number of parent cells does not match the fine mesh.");
+  }
+
+  // Each fine cell has its parent as the only candidate cell
+  std::vector<std::int32_t> cells1(num_cells1);
+  std::iota(cells1.begin(), cells1.end(), 0);
+  std::vector<std::int32_t> offsets(num_cells1 + 1);
+  std::iota(offsets.begin(), offsets.end(), 0);
+  impl::interpolate_nested(u1, cells1, u0, offsets, parent_cells,
+                           num_threads);
+  u1.x()->scatter_fwd();
+}
+
+/// @brief Restrict a Function on a refinement of a mesh to the mesh by
+/// interpolation (injection).
+///
+/// The Function `u1` on a (fine) mesh created by refining a coarse mesh
+/// is interpolated into the space of `u0` on the coarse mesh, e.g. to
+/// transfer the state of a simulation after coarsening. Each
+/// interpolation point of a coarse cell is evaluated in the child cell
+/// that contains it, so no global point search is required.
+///
+/// Coarse cells without children on this process (ghost cells) are
+/// skipped, and their dofs are set by the ghost update of `u0`.
+///
+/// @note Collective
+///
+/// @param[out] u0 Function on the coarse mesh.
+/// @param[in] u1 Function on the fine mesh.
+/// @param[in] parent_cells Parent cell (local index in the coarse mesh)
+/// of each cell of the fine mesh.
+/// @param[in] num_threads Number of threads.
+/// @pre See fem::prolong.
+template <dolfinx::scalar T, std::floating_point U>
+void inject(Function<T, U>& u0, const Function<T, U>& u1,
+            std::span<const std::int32_t> parent_cells, int num_threads = 1)
+{
+  auto mesh0 = u0.function_space()->mesh();
+  assert(mesh0);
+  auto mesh1 = u1.function_space()->mesh();
+  assert(mesh1);
+  const int tdim = mesh0->topology()->dim();
+  auto cell_map0 = mesh0->topology()->index_map(tdim);
+  assert(cell_map0);
+  auto cell_map1 = mesh1->topology()->index_map(tdim);
+  assert(cell_map1);
+  const std::int32_t num_cells0
+      = cell_map0->size_local() + cell_map0->num_ghosts();
+  if (parent_cells.size()
+      != std::size_t(cell_map1->size_local() + cell_map1->num_ghosts()))
+  {
+    throw std::runtime_error(
+        "Number of parent cells does not match the fine mesh.");
+  }
+
+  // Children of each coarse cell
+  std::vector<std::int32_t> offsets(num_cells0 + 1, 0);
+  for (std::int32_t p : parent_cells)
+    ++offsets[p + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> children(parent_cells.size());
+  {
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (std::size_t c = 0; c < parent_cells.size(); ++c)
+      children[pos[parent_cells[c]]++] = c;
+  }
+
+  // Coarse cells with children, with the children as candidate cells
+  std::vector<std::int32_t> cells0;
+  std::vector<std::int32_t> child_offsets = {0};
+  for (std::int32_t p = 0; p < num_cells0; ++p)
+  {
+    if (offsets[p + 1] > offsets[p])
+    {
+      cells0.push_back(p);
+      child_offsets.push_back(offsets[p + 1]);
+    }
+  }
+
+  impl::interpolate_nested(u0, cells0, u1, child_offsets, children,
+                           num_threads);
+  u0.x()->scatter_fwd();
+}
 } // namespace dolfinx::fem
@@ -8,10 +8,16 @@
 
 #ifdef HAS_PETSC
 
+#include "DirichletBC.h"
 #include "Form.h"
 #include "assembler.h"
 #include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <concepts>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/petsc.h>
 #include <functional>
 #include <map>
@@ -19,14 +25,11 @@
 #include <petscmat.h>
 #include <petscvec.h>
 #include <span>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
-namespace dolfinx::common
-{
-class IndexMap;
-}
-
 namespace dolfinx::fem
 {
 template <dolfinx::scalar T, std::floating_point U>
@@ -50,111 +53,41 @@ Mat create_matrix(const Form<PetscScalar, T>& a,
   return la::petsc::create_matrix(a.mesh()->comm(), pattern, type);
 }
 
-/// @brief Initialise a monolithic matrix for an array of bilinear
-/// forms.
-/// @param[in] a Rectangular array of bilinear forms. The `a(i, j)` form
-/// will correspond to the `(i, j)` block in the returned matrix
+/// @brief Initialise a monolithic matrix from the sparsity pattern of
+/// a block system.
+///
+/// The pattern can be kept and the matrix re-created from it, e.g. when
+/// the matrix is rebuilt with a different type or after the values of
+/// a matrix with the same layout have been discarded, without building
+/// the pattern again.
+///
+/// @param[in] pattern Finalised sparsity pattern of the block system
+/// (see fem::create_sparsity_pattern_block).
 /// @param[in] type The type of PETSc Mat. If empty the PETSc default is
 /// used.
-/// @return A sparse matrix  with a layout and sparsity that matches the
-/// bilinear forms. The caller is responsible for destroying the Mat
-/// object.
-template <std::floating_point T>
-Mat create_matrix_block(
-    const std::vector<std::vector<const Form<PetscScalar, T>*>>& a,
-    std::string type = std::string())
+/// @return A sparse matrix with the layout and sparsity of the pattern,
+/// and a local-to-global map that numbers the local indices block by
+/// block (field0, field1, field2, etc), i.e. ghosts of field0 appear
+/// before owned indices of field1. The caller is responsible for
+/// destroying the Mat object.
+inline Mat create_matrix_block(const la::SparsityPattern& pattern,
+                               std::string type = std::string())
 {
-  // Extract and check row/column ranges
-  std::array<std::vector<std::shared_ptr<const FunctionSpace<T>>>, 2> V
-      = fem::common_function_spaces(extract_function_spaces(a));
-  std::array<std::vector<int>, 2> bs_dofs;
-  for (std::size_t i = 0; i < 2; ++i)
-  {
-    for (auto& _V : V[i])
-      bs_dofs[i].push_back(_V->dofmap()->bs());
-  }
-
-  // Build sparsity pattern for each block
-  std::shared_ptr<const mesh::Mesh<T>> mesh;
-  std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>> patterns(
-      V[0].size());
-  for (std::size_t row = 0; row < V[0].size(); ++row)
-  {
-    for (std::size_t col = 0; col < V[1].size(); ++col)
-    {
-      if (const Form<PetscScalar, T>* form = a[row][col]; form)
-      {
-        patterns[row].push_back(std::make_unique<la::SparsityPattern>(
-            create_sparsity_pattern(*form)));
-        if (!mesh)
-          mesh = form->mesh();
-      }
-      else
-        patterns[row].push_back(nullptr);
-    }
-  }
-
-  if (!mesh)
-    throw std::runtime_error("Could not find a Mesh.");
-
-  // Compute offsets for the fields
-  std::array<std::vector<std::pair<
-                 std::reference_wrapper<const common::IndexMap>, int>>,
-             2>
-      maps;
-  for (std::size_t d = 0; d < 2; ++d)
-  {
-    for (auto& space : V[d])
-    {
-      maps[d].emplace_back(*space->dofmap()->index_map,
-                           space->dofmap()->index_map_bs());
-    }
-  }
-
-  // Create merged sparsity pattern
-  std::vector<std::vector<const la::SparsityPattern*>> p(V[0].size());
-  for (std::size_t row = 0; row < V[0].size(); ++row)
-    for (std::size_t col = 0; col < V[1].size(); ++col)
-      p[row].push_back(patterns[row][col].get());
-
-  la::SparsityPattern pattern(mesh->comm(), p, maps, bs_dofs);
-  pattern.finalize();
-
-  // FIXME: Add option to pass customised local-to-global map to PETSc
-  // Mat constructor
-
   // Initialise matrix
-  Mat A = la::petsc::create_matrix(mesh->comm(), pattern, type);
+  Mat A = la::petsc::create_matrix(pattern.comm(), pattern, type);
 
-  // Create row and column local-to-global maps (field0, field1, field2,
-  // etc), i.e. ghosts of field0 appear before owned indices of field1
+  // Create row and column local-to-global maps from the local indices
+  // of the blocks in the pattern
   std::array<std::vector<PetscInt>, 2> _maps;
   for (int d = 0; d < 2; ++d)
   {
-    // TODO: Index map concatenation has already been computed inside
-    // the SparsityPattern constructor, but we also need it here to
-    // build the PETSc local-to-global map. Compute outside and pass
-    // into SparsityPattern constructor.
-    // TODO: avoid concatenating the same maps twice in case that V[0]
-    // == V[1].
-
-    const std::vector<
-        std::pair<std::reference_wrapper<const common::IndexMap>, int>>& map
-        = maps[d];
-    std::vector<PetscInt>& _map = _maps[d];
-
-    // Concatenate the block index map in the row and column directions
-    const auto [rank_offset, local_offset, ghosts, _]
-        = common::stack_index_maps(map);
-    for (std::size_t f = 0; f < map.size(); ++f)
+    std::shared_ptr<const common::IndexMap> map = pattern.index_map(d);
+    std::vector<std::int64_t> global;
+    for (const std::vector<std::int32_t>& indices : pattern.block_indices(d))
     {
-      auto offset = local_offset[f];
-      const common::IndexMap& imap = map[f].first.get();
-      int bs = map[f].second;
-      for (std::int32_t i = 0; i < bs * imap.size_local(); ++i)
-        _map.push_back(i + rank_offset + offset);
-      for (std::int32_t i = 0; i < bs * imap.num_ghosts(); ++i)
-        _map.push_back(ghosts[f][i]);
+      global.resize(indices.size());
+      map->local_to_global(indices, global);
+      _maps[d].insert(_maps[d].end(), global.begin(), global.end());
     }
   }
 
@@ -163,7 +96,7 @@ Mat create_matrix_block(
   ISLocalToGlobalMappingCreate(MPI_COMM_SELF, 1, _maps[0].size(),
                                _maps[0].data(), PETSC_COPY_VALUES,
                                &petsc_local_to_global0);
-  if (V[0] == V[1])
+  if (_maps[0] == _maps[1])
   {
     MatSetLocalToGlobalMapping(A, petsc_local_to_global0,
                                petsc_local_to_global0);
@@ -185,6 +118,31 @@ Mat create_matrix_block(
   return A;
 }
 
+/// @brief Initialise a monolithic matrix for an array of bilinear
+/// forms.
+///
+/// The sparsity pattern of all blocks is built in one pattern (see
+/// fem::create_sparsity_pattern_block). To re-create the matrix without
+/// building the pattern again, build and keep the pattern and use
+/// create_matrix_block(const la::SparsityPattern&, std::string).
+///
+/// @param[in] a Rectangular array of bilinear forms. The `a(i, j)` form
+/// will correspond to the `(i, j)` block in the returned matrix
+/// @param[in] type The type of PETSc Mat. If empty the PETSc default is
+/// used.
+/// @return A sparse matrix  with a layout and sparsity that matches the
+/// bilinear forms. The caller is responsible for destroying the Mat
+/// object.
+template <std::floating_point T>
+Mat create_matrix_block(
+    const std::vector<std::vector<const Form<PetscScalar, T>*>>& a,
+    std::string type = std::string())
+{
+  la::SparsityPattern pattern = fem::create_sparsity_pattern_block(a);
+  pattern.finalize();
+  return create_matrix_block(pattern, type);
+}
+
 /// @brief Create nested (MatNest) matrix.
 ///
 /// @note The caller is responsible for destroying the Mat object.
@@ -201,7 +159,10 @@ Mat create_matrix_nest(
   if (!types.empty())
     _types = types;
 
-  // Loop over each form and create matrix
+  // Build the sparsity patterns of all blocks together, and create the
+  // matrix of each form
+  std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>> patterns
+      = create_sparsity_patterns(a);
   int rows = a.size();
   int cols = a.front().size();
   std::vector<Mat> mats(rows * cols, nullptr);
@@ -212,7 +173,10 @@ Mat create_matrix_nest(
     {
       if (const Form<PetscScalar, T>* form = a[i][j]; form)
       {
-        mats[i * cols + j] = create_matrix(*form, _types[i][j]);
+        patterns[i][j]->finalize();
+        mats[i * cols + j] = la::petsc::create_matrix(
+            form->mesh()->comm(), *patterns[i][j], _types[i][j]);
+        patterns[i][j].reset();
         mesh = form->mesh();
       }
     }
@@ -238,6 +202,246 @@ Mat create_matrix_nest(
   return A;
 }
 
+/// @brief Assembler of a bilinear form into a PETSc matrix using
+/// coordinate (COO) insertion.
+///
+/// The row and column indices of every entry of every element matrix
+/// are computed once, when the assembler is created, and are registered
+/// with a PETSc matrix by MatSetPreallocationCOOLocal (see
+/// MatrixAssemblerCOO::create_matrix). Each assembly computes the
+/// element matrices into a flat array of values, in the same order, and
+/// passes the array to MatSetValuesCOO. This avoids the search for the
+/// position of each entry that is performed by MatSetValuesLocal, and
+/// allows the values to be set for matrices that are stored on a
+/// device (e.g. `aijcusparse` and `aijkokkos` matrices).
+///
+/// The assembler is valid for as long as the integration domains of the
+/// form, the dofmaps and the boundary conditions are unchanged.
+/// Coefficient and constant values may change between assemblies.
+///
+/// @tparam T Geometry type of the form.
+template <std::floating_point T>
+class MatrixAssemblerCOO
+{
+public:
+  /// @brief Create an assembler.
+  ///
+  /// The element matrices are computed once to record the indices of
+  /// their entries.
+  ///
+  /// @param[in] a Bilinear form to assemble.
+  /// @param[in] bcs Boundary conditions to apply. For boundary
+  /// condition dofs the row and column are zeroed. If the test and
+  /// trial spaces of the form are the same, a value is set on the
+  /// diagonal for the owned boundary condition dofs (see
+  /// MatrixAssemblerCOO::assemble).
+  MatrixAssemblerCOO(
+      std::shared_ptr<const Form<PetscScalar, T>> a,
+      const std::vector<
+          std::reference_wrapper<const DirichletBC<PetscScalar, T>>>& bcs)
+      : _a(a), _num_diagonal(0)
+  {
+    assert(_a);
+    auto [dof_marker0, dof_marker1] = impl::bc_dof_markers(*_a, bcs);
+    _dof_marker0 = std::move(dof_marker0);
+    _dof_marker1 = std::move(dof_marker1);
+
+    // Record the (local) row and column of each element matrix entry,
+    // in the order that the element matrices are computed
+    auto V0 = _a->function_spaces().at(0);
+    auto V1 = _a->function_spaces().at(1);
+    const int bs0 = V0->dofmap()->bs();
+    const int bs1 = V1->dofmap()->bs();
+    auto mat_indices = [&](std::span<const std::int32_t> rows,
+                           std::span<const std::int32_t> cols,
+                           std::span<const PetscScalar>) -> int
+    {
+      for (std::int32_t r : rows)
+        for (int k0 = 0; k0 < bs0; ++k0)
+          for (std::int32_t c : cols)
+            for (int k1 = 0; k1 < bs1; ++k1)
+            {
+              _rows.push_back(r * bs0 + k0);
+              _cols.push_back(c * bs1 + k1);
+            }
+      return 0;
+    };
+
+    const std::vector<PetscScalar> constants = pack_constants(*_a);
+    auto coefficients = allocate_coefficient_storage(*_a);
+    pack_coefficients(*_a, coefficients);
+    fem::assemble_matrix(mat_indices, *_a, std::span(constants),
+                         make_coefficients_span(coefficients),
+                         std::span<const std::int8_t>(_dof_marker0),
+                         std::span<const std::int8_t>(_dof_marker1));
+
+    // Append the diagonal entries of the owned boundary condition dofs
+    if (V0 == V1)
+    {
+      for (auto& bc : bcs)
+      {
+        if (V0->contains(*bc.get().function_space()))
+        {
+          const auto [dofs, range] = bc.get().dof_indices();
+          for (std::int32_t dof : dofs.first(range))
+          {
+            _rows.push_back(dof);
+            _cols.push_back(dof);
+            ++_num_diagonal;
+          }
+        }
+      }
+    }
+
+    _values.resize(_rows.size());
+  }
+
+  /// @brief Create a matrix and register the indices of the entries.
+  ///
+  /// @param[in] type The PETSc matrix type to create. If empty the PETSc
+  /// default is used.
+  /// @return A sparse matrix with a layout and sparsity that matches the
+  /// bilinear form. The caller is responsible for destroying the Mat
+  /// object.
+  Mat create_matrix(std::string type = std::string()) const
+  {
+    auto V0 = _a->function_spaces().at(0);
+    auto V1 = _a->function_spaces().at(1);
+    const std::array maps = {V0->dofmap()->index_map, V1->dofmap()->index_map};
+    const std::array bs
+        = {V0->dofmap()->index_map_bs(), V1->dofmap()->index_map_bs()};
+
+    Mat A;
+    PetscErrorCode ierr = MatCreate(_a->mesh()->comm(), &A);
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatCreate");
+    if (!type.empty())
+      MatSetType(A, type.c_str());
+    ierr = MatSetSizes(A, bs[0] * maps[0]->size_local(),
+                       bs[1] * maps[1]->size_local(),
+                       bs[0] * maps[0]->size_global(),
+                       bs[1] * maps[1]->size_global());
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatSetSizes");
+    ierr = MatSetFromOptions(A);
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatSetFromOptions");
+    ierr = MatSetBlockSizes(A, bs[0], bs[1]);
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatSetBlockSizes");
+
+    // Local-to-global maps, which are required to register local
+    // indices
+    std::array<ISLocalToGlobalMapping, 2> local_to_global;
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      const std::vector map = maps[i]->global_indices();
+      const std::vector<PetscInt> _map(map.begin(), map.end());
+      ierr = ISLocalToGlobalMappingCreate(MPI_COMM_SELF, bs[i], _map.size(),
+                                          _map.data(), PETSC_COPY_VALUES,
+                                          &local_to_global[i]);
+      if (ierr != 0)
+        la::petsc::error(ierr, __FILE__, "ISLocalToGlobalMappingCreate");
+    }
+    ierr = MatSetLocalToGlobalMapping(A, local_to_global[0],
+                                      local_to_global[1]);
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatSetLocalToGlobalMapping");
+    for (auto& map : local_to_global)
+      ISLocalToGlobalMappingDestroy(&map);
+
+    // PETSc overwrites the index arrays
+    std::vector<PetscInt> rows = _rows, cols = _cols;
+    ierr = MatSetPreallocationCOOLocal(A, rows.size(), rows.data(),
+                                       cols.data());
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatSetPreallocationCOOLocal");
+
+    return A;
+  }
+
+  /// @brief Assemble the bilinear form into a matrix.
+  ///
+  /// The values of the matrix are replaced by the assembled values. The
+  /// matrix is assembled (in the PETSc sense) on return, and entries in
+  /// ghost rows are communicated to the owning process.
+  ///
+  /// @param[in,out] A Matrix created by
+  /// MatrixAssemblerCOO::create_matrix.
+  /// @param[in] constants Constants that appear in the form.
+  /// @param[in] coefficients Coefficients that appear in the form.
+  /// @param[in] diagonal Value to set on the diagonal for rows with a
+  /// boundary condition applied.
+  void assemble(Mat A, std::span<const PetscScalar> constants,
+                const std::map<std::pair<IntegralType, int>,
+                               std::pair<std::span<const PetscScalar>, int>>&
+                    coefficients,
+                PetscScalar diagonal = 1.0)
+  {
+    // Copy the element matrices into the value array
+    const std::size_t size = _values.size() - _num_diagonal;
+    std::size_t offset = 0;
+    auto mat_values = [&](std::span<const std::int32_t>,
+                          std::span<const std::int32_t>,
+                          std::span<const PetscScalar> Ae) -> int
+    {
+      if (offset + Ae.size() > size)
+        throw std::runtime_error("COO assembler does not match form.");
+      std::ranges::copy(Ae, std::next(_values.begin(), offset));
+      offset += Ae.size();
+      return 0;
+    };
+
+    fem::assemble_matrix(mat_values, *_a, constants, coefficients,
+                         std::span<const std::int8_t>(_dof_marker0),
+                         std::span<const std::int8_t>(_dof_marker1));
+    if (offset != size)
+      throw std::runtime_error("COO assembler does not match form.");
+    std::fill(std::next(_values.begin(), size), _values.end(), diagonal);
+
+    PetscErrorCode ierr = MatSetValuesCOO(A, _values.data(), INSERT_VALUES);
+    if (ierr != 0)
+      la::petsc::error(ierr, __FILE__, "MatSetValuesCOO");
+  }
+
+  /// @brief Assemble the bilinear form into a matrix.
+  ///
+  /// Constants and coefficients are packed before assembly.
+  ///
+  /// @param[in,out] A Matrix created by
+  /// MatrixAssemblerCOO::create_matrix.
+  /// @param[in] diagonal Value to set on the diagonal for rows with a
+  /// boundary condition applied.
+  void assemble(Mat A, PetscScalar diagonal = 1.0)
+  {
+    const std::vector<PetscScalar> constants = pack_constants(*_a);
+    auto coefficients = allocate_coefficient_storage(*_a);
+    pack_coefficients(*_a, coefficients);
+    assemble(A, std::span(constants), make_coefficients_span(coefficients),
+             diagonal);
+  }
+
+  /// @brief Number of registered entries, including duplicates.
+  std::size_t num_entries() const { return _rows.size(); }
+
+private:
+  // Bilinear form
+  std::shared_ptr<const Form<PetscScalar, T>> _a;
+
+  // Boundary condition markers
+  std::vector<std::int8_t> _dof_marker0, _dof_marker1;
+
+  // Local row and column indices of the entries. The element matrix
+  // entries are followed by the boundary condition diagonal entries.
+  std::vector<PetscInt> _rows, _cols;
+
+  // Number of boundary condition diagonal entries
+  std::size_t _num_diagonal;
+
+  // Values of the entries
+  std::vector<PetscScalar> _values;
+};
+
 /// Initialise monolithic vector. Vector is not zeroed.
 ///
 /// The caller is responsible for destroying the Mat object
@@ -7,54 +7,275 @@
 #include "sparsitybuild.h"
 #include "DofMap.h"
 #include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <stdexcept>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::fem;
 
+namespace
+{
+/// @brief Range of rows of each pattern that a thread inserts into.
+std::vector<std::array<std::int32_t, 2>>
+row_ranges(std::span<la::SparsityPattern* const> patterns, int t,
+           int num_threads)
+{
+  std::vector<std::array<std::int32_t, 2>> ranges;
+  ranges.reserve(patterns.size());
+  for (const la::SparsityPattern* p : patterns)
+  {
+    assert(p);
+    auto map = p->index_map(0);
+    assert(map);
+    const std::int32_t num_rows = map->size_local() + map->num_ghosts();
+    auto [r0, r1] = dolfinx::MPI::local_range(t, num_rows, num_threads);
+    ranges.push_back({static_cast<std::int32_t>(r0),
+                      static_cast<std::int32_t>(r1)});
+  }
+  return ranges;
+}
+
+/// @brief Insert `rows x cols` into a pattern, restricted to the rows
+/// in `range`.
+void insert(la::SparsityPattern& pattern, std::span<const std::int32_t> rows,
+            std::span<const std::int32_t> cols,
+            std::array<std::int32_t, 2> range, bool filter,
+            std::vector<std::int32_t>& buffer)
+{
+  if (!filter)
+    pattern.insert(rows, cols);
+  else
+  {
+    buffer.clear();
+    std::ranges::copy_if(rows, std::back_inserter(buffer),
+                         [range](auto r)
+                         { return r >= range[0] and r < range[1]; });
+    pattern.insert(buffer, cols);
+  }
+}
+
+/// @brief Map the dofs of a cell, with block size `bs`, to local
+/// indices of a block system pattern.
+void block_dofs(std::span<const std::int32_t> dofs, int bs,
+                std::span<const std::int32_t> indices,
+                std::vector<std::int32_t>& out)
+{
+  out.resize(bs * dofs.size());
+  for (std::size_t i = 0; i < dofs.size(); ++i)
+    for (int k = 0; k < bs; ++k)
+      out[bs * i + k] = indices[bs * dofs[i] + k];
+}
+
+/// @brief Check that the block data has consistent sizes, and return
+/// the number of entries in each list of cells.
+std::size_t check_blocks(
+    std::span<la::SparsityPattern* const> patterns,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps)
+{
+  if (patterns.size() != cells.size() or patterns.size() != dofmaps.size())
+    throw std::runtime_error("Inconsistent number of sparsity blocks.");
+
+  const std::size_t n = cells.empty() ? 0 : cells.front()[0].size();
+  for (auto& c : cells)
+  {
+    if (c[0].size() != n or c[1].size() != n)
+    {
+      throw std::runtime_error(
+          "Sparsity blocks must have the same number of cells.");
+    }
+  }
+  return n;
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 void sparsitybuild::cells(
     la::SparsityPattern& pattern,
     std::array<std::span<const std::int32_t>, 2> cells,
-    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps)
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_threads)
 {
   assert(cells[0].size() == cells[1].size());
-  const DofMap& map0 = dofmaps[0].get();
-  const DofMap& map1 = dofmaps[1].get();
-  for (std::size_t i = 0; i < cells[0].size(); ++i)
-    pattern.insert(map0.cell_dofs(cells[0][i]), map1.cell_dofs(cells[1][i]));
+  std::array<la::SparsityPattern*, 1> patterns{&pattern};
+  sparsitybuild::cells(patterns, std::span(&cells, 1), std::span(&dofmaps, 1),
+                       num_threads);
+}
+//-----------------------------------------------------------------------------
+void sparsitybuild::cells(
+    std::span<la::SparsityPattern* const> patterns,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    int num_threads)
+{
+  const std::size_t num_cells = check_blocks(patterns, cells, dofmaps);
+  common::thread_pool().run(
+      std::max(num_threads, 1),
+      [&](int t)
+      {
+        auto ranges = row_ranges(patterns, t, num_threads);
+        std::vector<std::int32_t> rows;
+        for (std::size_t i = 0; i < num_cells; ++i)
+        {
+          for (std::size_t b = 0; b < patterns.size(); ++b)
+          {
+            const DofMap& map0 = dofmaps[b][0].get();
+            const DofMap& map1 = dofmaps[b][1].get();
+            insert(*patterns[b], map0.cell_dofs(cells[b][0][i]),
+                   map1.cell_dofs(cells[b][1][i]), ranges[b],
+                   num_threads > 1, rows);
+          }
+        }
+      });
+}
+//-----------------------------------------------------------------------------
+void sparsitybuild::cells(
+    la::SparsityPattern& pattern,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> indices,
+    int num_threads)
+{
+  std::vector<la::SparsityPattern*> patterns(cells.size(), &pattern);
+  const std::size_t num_cells = check_blocks(patterns, cells, dofmaps);
+  if (indices.size() != cells.size())
+    throw std::runtime_error("Inconsistent number of sparsity blocks.");
+  common::thread_pool().run(
+      std::max(num_threads, 1),
+      [&](int t)
+      {
+        std::array<la::SparsityPattern*, 1> p{&pattern};
+        auto range = row_ranges(p, t, num_threads).front();
+        std::vector<std::int32_t> rows, cols, buffer;
+        for (std::size_t i = 0; i < num_cells; ++i)
+        {
+          for (std::size_t b = 0; b < cells.size(); ++b)
+          {
+            const DofMap& map0 = dofmaps[b][0].get();
+            const DofMap& map1 = dofmaps[b][1].get();
+            block_dofs(map0.cell_dofs(cells[b][0][i]), map0.bs(),
+                       indices[b][0], rows);
+            block_dofs(map1.cell_dofs(cells[b][1][i]), map1.bs(),
+                       indices[b][1], cols);
+            insert(pattern, rows, cols, range, num_threads > 1, buffer);
+          }
+        }
+      });
 }
 //-----------------------------------------------------------------------------
 void sparsitybuild::interior_facets(
     la::SparsityPattern& pattern,
     std::array<std::span<const std::int32_t>, 2> cells,
-    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps)
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_threads)
 {
-  std::span<const std::int32_t> cells0 = cells[0];
-  std::span<const std::int32_t> cells1 = cells[1];
-  assert(cells0.size() == cells1.size());
-  const DofMap& dofmap0 = dofmaps[0];
-  const DofMap& dofmap1 = dofmaps[1];
+  assert(cells[0].size() == cells[1].size());
+  std::array<la::SparsityPattern*, 1> patterns{&pattern};
+  sparsitybuild::interior_facets(patterns, std::span(&cells, 1),
+                                 std::span(&dofmaps, 1), num_threads);
+}
+//-----------------------------------------------------------------------------
+void sparsitybuild::interior_facets(
+    std::span<la::SparsityPattern* const> patterns,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    int num_threads)
+{
+  const std::size_t num_cells = check_blocks(patterns, cells, dofmaps);
+  common::thread_pool().run(
+      std::max(num_threads, 1),
+      [&](int t)
+      {
+        auto ranges = row_ranges(patterns, t, num_threads);
+        std::vector<std::int32_t> macro_dofs0, macro_dofs1, rows;
 
-  // Iterate over facets
-  std::vector<std::int32_t> macro_dofs0, macro_dofs1;
-  for (std::size_t f = 0; f < cells[0].size(); f += 2)
-  {
-    // Test function dofs (sparsity pattern rows)
-    auto dofs00 = dofmap0.cell_dofs(cells0[f]);
-    auto dofs01 = dofmap0.cell_dofs(cells0[f + 1]);
-    macro_dofs0.resize(dofs00.size() + dofs01.size());
-    std::ranges::copy(dofs00, macro_dofs0.begin());
-    std::ranges::copy(dofs01, std::next(macro_dofs0.begin(), dofs00.size()));
-
-    // Trial function dofs (sparsity pattern columns)
-    auto dofs10 = dofmap1.cell_dofs(cells1[f]);
-    auto dofs11 = dofmap1.cell_dofs(cells1[f + 1]);
-    macro_dofs1.resize(dofs10.size() + dofs11.size());
-    std::ranges::copy(dofs10, macro_dofs1.begin());
-    std::ranges::copy(dofs11, std::next(macro_dofs1.begin(), dofs10.size()));
-
-    pattern.insert(macro_dofs0, macro_dofs1);
-  }
+        // Iterate over facets
+        for (std::size_t f = 0; f < num_cells; f += 2)
+        {
+          for (std::size_t b = 0; b < patterns.size(); ++b)
+          {
+            std::span<const std::int32_t> cells0 = cells[b][0];
+            std::span<const std::int32_t> cells1 = cells[b][1];
+            const DofMap& dofmap0 = dofmaps[b][0];
+            const DofMap& dofmap1 = dofmaps[b][1];
+
+            // Test function dofs (sparsity pattern rows)
+            auto dofs00 = dofmap0.cell_dofs(cells0[f]);
+            auto dofs01 = dofmap0.cell_dofs(cells0[f + 1]);
+            macro_dofs0.resize(dofs00.size() + dofs01.size());
+            std::ranges::copy(dofs00, macro_dofs0.begin());
+            std::ranges::copy(dofs01,
+                              std::next(macro_dofs0.begin(), dofs00.size()));
+
+            // Trial function dofs (sparsity pattern columns)
+            auto dofs10 = dofmap1.cell_dofs(cells1[f]);
+            auto dofs11 = dofmap1.cell_dofs(cells1[f + 1]);
+            macro_dofs1.resize(dofs10.size() + dofs11.size());
+            std::ranges::copy(dofs10, macro_dofs1.begin());
+            std::ranges::copy(dofs11,
+                              std::next(macro_dofs1.begin(), dofs10.size()));
+
+            insert(*patterns[b], macro_dofs0, macro_dofs1, ranges[b],
+                   num_threads > 1, rows);
+          }
+        }
+      });
+}
+//-----------------------------------------------------------------------------
+void sparsitybuild::interior_facets(
+    la::SparsityPattern& pattern,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> indices,
+    int num_threads)
+{
+  std::vector<la::SparsityPattern*> patterns(cells.size(), &pattern);
+  const std::size_t num_cells = check_blocks(patterns, cells, dofmaps);
+  if (indices.size() != cells.size())
+    throw std::runtime_error("Inconsistent number of sparsity blocks.");
+  common::thread_pool().run(
+      std::max(num_threads, 1),
+      [&](int t)
+      {
+        std::array<la::SparsityPattern*, 1> p{&pattern};
+        auto range = row_ranges(p, t, num_threads).front();
+        std::vector<std::int32_t> rows, cols, dofs, buffer;
+
+        // Map the dofs of the two cells of a facet to the pattern
+        auto macro_dofs = [&dofs](const DofMap& dofmap, std::int32_t c0,
+                                  std::int32_t c1,
+                                  std::span<const std::int32_t> indices,
+                                  std::vector<std::int32_t>& out)
+        {
+          auto dofs0 = dofmap.cell_dofs(c0);
+          auto dofs1 = dofmap.cell_dofs(c1);
+          dofs.resize(dofs0.size() + dofs1.size());
+          std::ranges::copy(dofs0, dofs.begin());
+          std::ranges::copy(dofs1, std::next(dofs.begin(), dofs0.size()));
+          block_dofs(dofs, dofmap.bs(), indices, out);
+        };
+
+        // Iterate over facets
+        for (std::size_t f = 0; f < num_cells; f += 2)
+        {
+          for (std::size_t b = 0; b < cells.size(); ++b)
+          {
+            macro_dofs(dofmaps[b][0], cells[b][0][f], cells[b][0][f + 1],
+                       indices[b][0], rows);
+            macro_dofs(dofmaps[b][1], cells[b][1][f], cells[b][1][f + 1],
+                       indices[b][1], cols);
+            insert(pattern, rows, cols, range, num_threads > 1, buffer);
+          }
+        }
+      });
 }
 //-----------------------------------------------------------------------------
@@ -21,6 +21,10 @@ namespace dolfinx::fem
 class DofMap;
 
 /// Support for building sparsity patterns from degree-of-freedom maps.
+///
+/// The functions insert into the pattern in its current mode, i.e. they
+/// count the entries of each row during the counting pass of a
+/// two-pass build (see la::SparsityPattern::begin_count).
 namespace sparsitybuild
 {
 /// @brief Iterate over cells and insert entries into sparsity pattern.
@@ -34,10 +38,59 @@ namespace sparsitybuild
 /// @param cells Lists of cells to iterate over. `cells[0]` and
 /// `cells[1]` must have the same size.
 /// @param dofmaps Dofmaps to used in building the sparsity pattern.
+/// @param num_threads Number of threads. Each thread inserts the
+/// entries of a range of rows.
 /// @note The sparsity pattern is not finalised.
 void cells(la::SparsityPattern& pattern,
            std::array<std::span<const std::int32_t>, 2> cells,
-           std::array<std::reference_wrapper<const DofMap>, 2> dofmaps);
+           std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+           int num_threads = 1);
+
+/// @brief Iterate over cells and insert entries into the sparsity
+/// patterns of the blocks of a block system.
+///
+/// For each block `b`, inserts the entries as for
+/// `cells(*patterns[b], cells[b], dofmaps[b])`, but with one traversal
+/// of the cells for all blocks. The `i`th cell of each block is visited
+/// together, so all lists of cells must have the same size.
+///
+/// @param patterns Sparsity pattern of each block.
+/// @param cells Lists of cells to iterate over for each block.
+/// @param dofmaps Dofmaps of each block.
+/// @param num_threads Number of threads. Each thread inserts the
+/// entries of a range of rows of each pattern.
+/// @note The sparsity patterns are not finalised.
+void cells(
+    std::span<la::SparsityPattern* const> patterns,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    int num_threads = 1);
+
+/// @brief Iterate over cells and insert the entries of the blocks of a
+/// block system into a single (monolithic) sparsity pattern.
+///
+/// For each block `b`, inserts the entries as for
+/// `cells(pattern, cells[b], dofmaps[b])`, with the (unblocked) dof
+/// indices of the test and trial dofmaps mapped to local indices of the
+/// pattern by `indices[b][0]` and `indices[b][1]`, respectively (see
+/// la::SparsityPattern::block_indices).
+///
+/// @param pattern Sparsity pattern of the block system.
+/// @param cells Lists of cells to iterate over for each block.
+/// @param dofmaps Dofmaps of each block.
+/// @param indices Local index in `pattern` of each unblocked row and
+/// column dof of each block.
+/// @param num_threads Number of threads. Each thread inserts the
+/// entries of a range of rows.
+/// @note The sparsity pattern is not finalised.
+void cells(
+    la::SparsityPattern& pattern,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> indices,
+    int num_threads = 1);
 
 /// @brief Iterate over interior facets and insert entries into sparsity
 /// pattern.
@@ -51,12 +104,63 @@ void cells(la::SparsityPattern& pattern,
 /// list of `(cell0, cell1)` pairs for each interior facet to index into
 /// `dofmap[i]`. `cells[0]` and `cells[1]` must have the same size.
 /// @param[in] dofmaps Dofmaps to use in building the sparsity pattern.
+/// @param[in] num_threads Number of threads. Each thread inserts the
+/// entries of a range of rows.
 ///
 /// @note The sparsity pattern is not finalised.
 void interior_facets(
     la::SparsityPattern& pattern,
     std::array<std::span<const std::int32_t>, 2> cells,
-    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps);
+    std::array<std::reference_wrapper<const DofMap>, 2> dofmaps,
+    int num_threads = 1);
+
+/// @brief Iterate over interior facets and insert entries into the
+/// sparsity patterns of the blocks of a block system.
+///
+/// For each block `b`, inserts the entries as for
+/// `interior_facets(*patterns[b], cells[b], dofmaps[b])`, but with one
+/// traversal of the facets for all blocks. All lists of cells must have
+/// the same size.
+///
+/// @param[in,out] patterns Sparsity pattern of each block.
+/// @param[in] cells Cells attached to each facet for each block.
+/// @param[in] dofmaps Dofmaps of each block.
+/// @param[in] num_threads Number of threads. Each thread inserts the
+/// entries of a range of rows of each pattern.
+///
+/// @note The sparsity patterns are not finalised.
+void interior_facets(
+    std::span<la::SparsityPattern* const> patterns,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    int num_threads = 1);
+
+/// @brief Iterate over interior facets and insert the entries of the
+/// blocks of a block system into a single (monolithic) sparsity
+/// pattern.
+///
+/// For each block `b`, inserts the entries as for
+/// `interior_facets(pattern, cells[b], dofmaps[b])`, with dof indices
+/// mapped to local indices of the pattern by `indices[b]` (see
+/// sparsitybuild::cells).
+///
+/// @param[in,out] pattern Sparsity pattern of the block system.
+/// @param[in] cells Cells attached to each facet for each block.
+/// @param[in] dofmaps Dofmaps of each block.
+/// @param[in] indices Local index in `pattern` of each unblocked row
+/// and column dof of each block.
+/// @param[in] num_threads Number of threads. Each thread inserts the
+/// entries of a range of rows.
+///
+/// @note The sparsity pattern is not finalised.
+void interior_facets(
+    la::SparsityPattern& pattern,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> cells,
+    std::span<const std::array<std::reference_wrapper<const DofMap>, 2>>
+        dofmaps,
+    std::span<const std::array<std::span<const std::int32_t>, 2>> indices,
+    int num_threads = 1);
 
 } // namespace sparsitybuild
 } // namespace dolfinx::fem
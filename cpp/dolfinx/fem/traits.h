@@ -29,4 +29,23 @@ concept FEkernel = std::is_invocable_v<U, T*, const T*, const T*,
                                        const scalar_value_type_t<T>*,
                                        const int*, const std::uint8_t*>;
 
+/// @brief Batched finite element cell kernel concept.
+///
+/// A batched kernel computes the element tensors for a batch of `N`
+/// cells in one call, `kernel(A, w, c, coordinate_dofs)`. Data for the
+/// batch is stored in structure-of-arrays layout with the cell index in
+/// the batch running fastest, i.e. for cell `b` in the batch:
+///
+/// - element tensor entry `k`: `A[k * N + b]`,
+/// - coefficient entry `k`: `w[k * N + b]`,
+/// - component `d` of geometry node `i`: `coordinate_dofs[(3 * i + d) * N
+///   + b]`.
+///
+/// Constants `c` are shared by all cells in the batch. The layout allows
+/// a kernel to vectorize across the cells of a batch.
+template <class U, class T>
+concept FEkernelBatched
+    = std::is_invocable_v<U, T*, const T*, const T*,
+                          const scalar_value_type_t<T>*>;
+
 } // namespace dolfinx::fem
@@ -22,20 +22,74 @@
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/topologycomputation.h>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <ufcx.h>
 
 using namespace dolfinx;
 
+namespace
+{
+/// Create the dofmap of a discontinuous element, with the dofs of each
+/// cell numbered contiguously by cell. The index map of the dofs is
+/// the cell index map, with each cell expanded to its dofs.
+fem::DofMap create_discontinuous_dofmap(MPI_Comm comm,
+                                        const fem::ElementDofLayout& layout,
+                                        const mesh::Topology& topology)
+{
+  const int D = topology.dim();
+  auto cell_map = topology.index_map(D);
+  assert(cell_map);
+  const std::int64_t ndofs = layout.num_dofs();
+
+  std::array<std::int64_t, 2> range = cell_map->local_range();
+  std::ranges::transform(range, range.begin(),
+                         [ndofs](auto r) { return r * ndofs; });
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  ghosts.reserve(cell_map->num_ghosts() * ndofs);
+  owners.reserve(cell_map->num_ghosts() * ndofs);
+  for (std::int32_t i = 0; i < cell_map->num_ghosts(); ++i)
+  {
+    for (std::int64_t j = 0; j < ndofs; ++j)
+    {
+      ghosts.push_back(cell_map->ghosts()[i] * ndofs + j);
+      owners.push_back(cell_map->owners()[i]);
+    }
+  }
+
+  std::array<std::vector<int>, 2> src_dest
+      = {std::vector(cell_map->src().begin(), cell_map->src().end()),
+         std::vector(cell_map->dest().begin(), cell_map->dest().end())};
+  auto index_map = std::make_shared<common::IndexMap>(
+      comm, range, cell_map->size_global() * ndofs, src_dest, ghosts, owners);
+
+  std::vector<std::int32_t> dofmap(
+      (cell_map->size_local() + cell_map->num_ghosts()) * ndofs);
+  std::iota(dofmap.begin(), dofmap.end(), 0);
+  const int bs = layout.block_size();
+  return fem::DofMap(layout, index_map, bs, std::move(dofmap), bs);
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 fem::DofMap fem::create_dofmap(
     MPI_Comm comm, const ElementDofLayout& layout, mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn)
+        reorder_fn,
+    int num_threads)
 {
-  // Create required mesh entities
   const int D = topology.dim();
+
+  // Number the dofs of discontinuous elements by cell
+  bool discontinuous = !permute_inv;
+  for (int d = 0; d < D; ++d)
+    discontinuous = discontinuous and layout.num_entity_dofs(d) == 0;
+  if (discontinuous)
+    return create_discontinuous_dofmap(comm, layout, topology);
+
+  // Create required mesh entities
   for (int d = 0; d < D; ++d)
   {
     if (layout.num_entity_dofs(d) > 0)
@@ -43,7 +97,7 @@ fem::DofMap fem::create_dofmap(
   }
 
   auto [_index_map, bs, dofmaps]
-      = build_dofmap_data(comm, topology, {layout}, reorder_fn);
+      = build_dofmap_data(comm, topology, {layout}, reorder_fn, num_threads);
   auto index_map = std::make_shared<common::IndexMap>(std::move(_index_map));
 
   // If the element's DOF transformations are permutations, permute the
@@ -70,7 +124,8 @@ std::vector<fem::DofMap> fem::create_dofmaps(
     mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn)
+        reorder_fn,
+    int num_threads)
 {
   std::int32_t D = topology.dim();
   assert(layouts.size() == topology.entity_types(D).size());
@@ -83,7 +138,7 @@ std::vector<fem::DofMap> fem::create_dofmaps(
   }
 
   auto [_index_map, bs, dofmaps]
-      = build_dofmap_data(comm, topology, layouts, reorder_fn);
+      = build_dofmap_data(comm, topology, layouts, reorder_fn, num_threads);
   auto index_map = std::make_shared<common::IndexMap>(std::move(_index_map));
 
   // If the element's DOF transformations are permutations, permute the
@@ -224,6 +279,46 @@ fem::compute_integration_domains(fem::IntegralType integral_type,
   }
   }
 
+  // Place the entries for which all cells are interior to the process
+  // (see mesh::Topology::cell_ranges) first, preserving the order
+  // within the interior and boundary entries
+  if (const std::int32_t num_interior = topology.cell_ranges()[1];
+      num_interior > 0)
+  {
+    std::size_t stride = 1, cell_stride = 1;
+    if (integral_type == IntegralType::exterior_facet)
+      stride = cell_stride = 2;
+    else if (integral_type == IntegralType::interior_facet)
+    {
+      stride = 4;
+      cell_stride = 2;
+    }
+
+    auto interior = [&](std::size_t e)
+    {
+      for (std::size_t j = 0; j < stride; j += cell_stride)
+        if (entity_data[e * stride + j] >= num_interior)
+          return false;
+      return true;
+    };
+
+    const std::size_t num_entries = entity_data.size() / stride;
+    std::vector<std::int32_t> data;
+    data.reserve(entity_data.size());
+    for (bool b : {true, false})
+    {
+      for (std::size_t e = 0; e < num_entries; ++e)
+      {
+        if (interior(e) == b)
+        {
+          auto it = std::next(entity_data.begin(), e * stride);
+          data.insert(data.end(), it, std::next(it, stride));
+        }
+      }
+    }
+    entity_data = std::move(data);
+  }
+
   return entity_data;
 }
 //-----------------------------------------------------------------------------
@@ -9,21 +9,27 @@
 #include "Constant.h"
 #include "CoordinateElement.h"
 #include "DofMap.h"
+#include "DofMapCache.h"
 #include "ElementDofLayout.h"
 #include "Expression.h"
 #include "Form.h"
 #include "Function.h"
 #include "FunctionSpace.h"
+#include "IntegrationDomainCache.h"
 #include "sparsitybuild.h"
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <set>
@@ -53,6 +59,36 @@ namespace dolfinx::fem
 {
 namespace impl
 {
+/// @brief Call a function for blocks of the range `[0, n)`, with each
+/// block executed as a task on the process thread pool (see
+/// common::thread_pool).
+///
+/// An exception thrown by `fn` is re-thrown on the calling thread once
+/// all tasks have completed.
+///
+/// @param[in] n Size of the range.
+/// @param[in] num_threads Number of blocks.
+/// @param[in] fn Function called with the first and one past the last
+/// index of a block.
+template <typename F>
+void for_each_block(std::size_t n, int num_threads, F&& fn)
+{
+  if (num_threads < 2)
+  {
+    fn(std::size_t(0), n);
+    return;
+  }
+
+  common::thread_pool().run(num_threads,
+                            [&fn, n, num_threads](int t)
+                            {
+                              auto [p0, p1] = dolfinx::MPI::local_range(
+                                  t, n, num_threads);
+                              if (p1 > p0)
+                                fn(std::size_t(p0), std::size_t(p1));
+                            });
+}
+
 /// Helper function to get an array of of (cell, local_facet) pairs
 /// corresponding to a given facet index.
 /// @param[in] f Facet index
@@ -99,6 +135,11 @@ get_cell_facet_pairs(std::int32_t f, std::span<const std::int32_t> cells,
 /// @note Owned mesh entities only are returned. Ghost entities are not
 /// included.
 ///
+/// @note The entries for which all cells are interior to the process
+/// (see mesh::Topology::cell_ranges) precede the other entries, so that
+/// an integral over the interior entries can be computed while ghost
+/// data is communicated.
+///
 /// @pre For facet integrals, the topology facet-to-cell and
 /// cell-to-facet connectivity must be computed before calling this
 /// function.
@@ -143,50 +184,36 @@ extract_function_spaces(const std::vector<std::vector<const Form<T, U>*>>& a)
   return spaces;
 }
 
-/// @brief Create a sparsity pattern for a given form.
-/// @note The pattern is not finalised, i.e. the caller is responsible
-/// for calling SparsityPattern::assemble.
-/// @param[in] a A bilinear form
-/// @return The corresponding sparsity pattern
-template <dolfinx::scalar T, std::floating_point U>
-la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a)
+namespace impl
 {
-  if (a.rank() != 2)
-  {
-    throw std::runtime_error(
-        "Cannot create sparsity pattern. Form is not a bilinear.");
-  }
-
-  // Get dof maps and mesh
-  std::array<std::reference_wrapper<const DofMap>, 2> dofmaps{
-      *a.function_spaces().at(0)->dofmap(),
-      *a.function_spaces().at(1)->dofmap()};
-  std::shared_ptr mesh = a.mesh();
-  assert(mesh);
-
-  std::shared_ptr mesh0 = a.function_spaces().at(0)->mesh();
-  assert(mesh0);
-  std::shared_ptr mesh1 = a.function_spaces().at(1)->mesh();
-  assert(mesh1);
+/// @brief An integration domain that is shared by blocks of a block
+/// system of bilinear forms.
+struct SparsityDomain
+{
+  /// Integral type
+  IntegralType type;
 
-  const std::set<IntegralType> types = a.integral_types();
-  if (types.find(IntegralType::interior_facet) != types.end()
-      or types.find(IntegralType::exterior_facet) != types.end())
-  {
-    // FIXME: cleanup these calls? Some of the happen internally again.
-    int tdim = mesh->topology()->dim();
-    mesh->topology_mutable()->create_entities(tdim - 1);
-    mesh->topology_mutable()->create_connectivity(tdim - 1, tdim);
-  }
+  /// Cells of the domain in the meshes of the test and trial spaces
+  std::array<std::vector<std::int32_t>, 2> cells;
 
-  common::Timer t0("Build sparsity");
+  /// `(row, col)` index of each block with the domain
+  std::vector<std::array<std::size_t, 2>> blocks;
 
-  // Get common::IndexMaps for each dimension
-  const std::array index_maps{dofmaps[0].get().index_map,
-                              dofmaps[1].get().index_map};
-  const std::array bs
-      = {dofmaps[0].get().index_map_bs(), dofmaps[1].get().index_map_bs()};
+  /// Test and trial dofmaps of each block
+  std::vector<std::array<std::reference_wrapper<const DofMap>, 2>> dofmaps;
+};
 
+/// @brief Group the integration domains of a block system of bilinear
+/// forms, such that blocks whose forms have the same integration domain
+/// (same integral type and cells) are built in one traversal of the
+/// domain.
+/// @param[in] a Rectangular array of bilinear forms. Null forms are
+/// permitted.
+/// @return The integration domains.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<SparsityDomain>
+sparsity_domains(const std::vector<std::vector<const Form<T, U>*>>& a)
+{
   auto extract_cells = [](std::span<const std::int32_t> facets)
   {
     assert(facets.size() % 2 == 0);
@@ -197,50 +224,357 @@ la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a)
     return cells;
   };
 
-  // Create and build sparsity pattern
-  la::SparsityPattern pattern(mesh->comm(), index_maps, bs);
-  for (auto type : types)
+  std::vector<SparsityDomain> domains;
+  for (std::size_t row = 0; row < a.size(); ++row)
   {
-    std::vector<int> ids = a.integral_ids(type);
-    switch (type)
+    for (std::size_t col = 0; col < a[row].size(); ++col)
     {
-    case IntegralType::cell:
-      for (int id : ids)
+      const Form<T, U>* form = a[row][col];
+      if (!form)
+        continue;
+
+      if (form->rank() != 2)
       {
-        sparsitybuild::cells(
-            pattern, {a.domain(type, id, *mesh0), a.domain(type, id, *mesh1)},
-            {{dofmaps[0], dofmaps[1]}});
+        throw std::runtime_error(
+            "Cannot create sparsity pattern. Form is not a bilinear.");
       }
-      break;
-    case IntegralType::interior_facet:
-      for (int id : ids)
+
+      // Get dof maps and mesh
+      std::array<std::reference_wrapper<const DofMap>, 2> dofmaps{
+          *form->function_spaces().at(0)->dofmap(),
+          *form->function_spaces().at(1)->dofmap()};
+      std::shared_ptr mesh = form->mesh();
+      assert(mesh);
+
+      std::shared_ptr mesh0 = form->function_spaces().at(0)->mesh();
+      assert(mesh0);
+      std::shared_ptr mesh1 = form->function_spaces().at(1)->mesh();
+      assert(mesh1);
+
+      const std::set<IntegralType> types = form->integral_types();
+      if (types.find(IntegralType::interior_facet) != types.end()
+          or types.find(IntegralType::exterior_facet) != types.end())
+      {
+        // FIXME: cleanup these calls? Some of the happen internally
+        // again.
+        int tdim = mesh->topology()->dim();
+        mesh->topology_mutable()->create_entities(tdim - 1);
+        mesh->topology_mutable()->create_connectivity(tdim - 1, tdim);
+      }
+
+      // Add the cells of each integral domain, for the mesh of each
+      // function space, to the domains
+      for (auto type : types)
       {
-        sparsitybuild::interior_facets(
-            pattern,
-            {extract_cells(a.domain(type, id, *mesh0)),
-             extract_cells(a.domain(type, id, *mesh1))},
-            {{dofmaps[0], dofmaps[1]}});
+        for (int id : form->integral_ids(type))
+        {
+          std::span<const std::int32_t> e0 = form->domain(type, id, *mesh0);
+          std::span<const std::int32_t> e1 = form->domain(type, id, *mesh1);
+          std::array<std::vector<std::int32_t>, 2> cells;
+          switch (type)
+          {
+          case IntegralType::cell:
+            cells = {std::vector(e0.begin(), e0.end()),
+                     std::vector(e1.begin(), e1.end())};
+            break;
+          case IntegralType::interior_facet:
+          case IntegralType::exterior_facet:
+            cells = {extract_cells(e0), extract_cells(e1)};
+            break;
+          default:
+            throw std::runtime_error("Unsupported integral type");
+          }
+
+          auto it = std::ranges::find_if(
+              domains, [type, &cells](const SparsityDomain& d)
+              { return d.type == type and d.cells == cells; });
+          if (it == domains.end())
+          {
+            domains.push_back({type, std::move(cells), {}, {}});
+            it = std::prev(domains.end());
+          }
+          it->blocks.push_back({row, col});
+          it->dofmaps.push_back(dofmaps);
+        }
       }
-      break;
-    case IntegralType::exterior_facet:
-      for (int id : ids)
+    }
+  }
+
+  return domains;
+}
+} // namespace impl
+
+/// @brief Create the sparsity patterns of the blocks of a block system
+/// of bilinear forms.
+///
+/// The patterns are built in two passes over the integration domains:
+/// the first pass counts the entries of each row and the second pass
+/// inserts the entries into a single preallocated array (see
+/// la::SparsityPattern::begin_count). Blocks whose forms have the same
+/// integration domain (same integral type and cells) are built in one
+/// traversal of the domain.
+///
+/// @note The patterns are not finalised, i.e. the caller is responsible
+/// for calling SparsityPattern::finalize.
+/// @param[in] a Rectangular array of bilinear forms. Null forms are
+/// permitted.
+/// @param[in] num_threads Number of threads used to insert the entries
+/// of the patterns.
+/// @return The sparsity pattern for each block, and `nullptr` for
+/// blocks with null forms.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>>
+create_sparsity_patterns(const std::vector<std::vector<const Form<T, U>*>>& a,
+                         int num_threads = 1)
+{
+  const std::vector<impl::SparsityDomain> domains = impl::sparsity_domains(a);
+
+  std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>> patterns(
+      a.size());
+  for (std::size_t row = 0; row < a.size(); ++row)
+  {
+    for (const Form<T, U>* form : a[row])
+    {
+      if (!form)
+        patterns[row].push_back(nullptr);
+      else
       {
-        sparsitybuild::cells(pattern,
-                             {extract_cells(a.domain(type, id, *mesh0)),
-                              extract_cells(a.domain(type, id, *mesh1))},
-                             {{dofmaps[0], dofmaps[1]}});
+        // Get common::IndexMaps for each dimension
+        const DofMap& dofmap0 = *form->function_spaces().at(0)->dofmap();
+        const DofMap& dofmap1 = *form->function_spaces().at(1)->dofmap();
+        patterns[row].push_back(std::make_unique<la::SparsityPattern>(
+            form->mesh()->comm(),
+            std::array{dofmap0.index_map, dofmap1.index_map},
+            std::array{dofmap0.index_map_bs(), dofmap1.index_map_bs()}));
       }
-      break;
-    default:
-      throw std::runtime_error("Unsupported integral type");
     }
   }
 
+  common::Timer t0("Build sparsity");
+
+  auto insert_entries = [&domains, &patterns, num_threads]()
+  {
+    for (const impl::SparsityDomain& d : domains)
+    {
+      std::vector<la::SparsityPattern*> p;
+      for (auto [row, col] : d.blocks)
+        p.push_back(patterns[row][col].get());
+      std::vector<std::array<std::span<const std::int32_t>, 2>> cells(
+          p.size(), {d.cells[0], d.cells[1]});
+      if (d.type == IntegralType::interior_facet)
+        sparsitybuild::interior_facets(p, cells, d.dofmaps, num_threads);
+      else
+        sparsitybuild::cells(p, cells, d.dofmaps, num_threads);
+    }
+  };
+
+  // Build the sparsity patterns. A two-pass build is used: the first
+  // pass counts the entries of each row and the second pass inserts the
+  // entries into storage allocated for all rows.
+  for (auto& patterns_row : patterns)
+  {
+    for (auto& p : patterns_row)
+    {
+      if (p)
+        p->begin_count();
+    }
+  }
+  insert_entries();
+  for (auto& patterns_row : patterns)
+  {
+    for (auto& p : patterns_row)
+    {
+      if (p)
+        p->allocate();
+    }
+  }
+  insert_entries();
+
+  t0.stop();
+
+  return patterns;
+}
+
+/// @brief Create the sparsity pattern of a block system of bilinear
+/// forms as a single (monolithic) pattern.
+///
+/// The index maps of the test and trial spaces are stacked (see
+/// common::stack_index_maps), and the entries of all blocks are
+/// inserted directly into the stacked pattern, with the blocks that
+/// share an integration domain built in one traversal of the domain.
+/// Unlike stacking the patterns of the blocks (see
+/// create_sparsity_patterns and the la::SparsityPattern block
+/// constructor), the entries are not stored per block and copied. The
+/// local indices of a block in the pattern are given by
+/// la::SparsityPattern::block_indices.
+///
+/// @note The pattern is not finalised, i.e. the caller is responsible
+/// for calling SparsityPattern::finalize.
+/// @param[in] a Rectangular array of bilinear forms. Null forms are
+/// permitted, but each block row and column must have a form.
+/// @param[in] num_threads Number of threads used to insert the entries
+/// of the pattern.
+/// @return The sparsity pattern of the block system.
+template <dolfinx::scalar T, std::floating_point U>
+la::SparsityPattern create_sparsity_pattern_block(
+    const std::vector<std::vector<const Form<T, U>*>>& a, int num_threads = 1)
+{
+  // Extract and check row/column ranges
+  std::array<std::vector<std::shared_ptr<const FunctionSpace<U>>>, 2> V
+      = common_function_spaces(extract_function_spaces(a));
+  std::array<std::vector<std::pair<
+                 std::reference_wrapper<const common::IndexMap>, int>>,
+             2>
+      maps;
+  for (std::size_t d = 0; d < 2; ++d)
+  {
+    for (auto& space : V[d])
+    {
+      maps[d].emplace_back(*space->dofmap()->index_map,
+                           space->dofmap()->index_map_bs());
+    }
+  }
+
+  la::SparsityPattern pattern(V[0].front()->mesh()->comm(), maps);
+  const std::vector<impl::SparsityDomain> domains = impl::sparsity_domains(a);
+
+  common::Timer t0("Build sparsity");
+
+  auto insert_entries = [&domains, &pattern, num_threads]()
+  {
+    for (const impl::SparsityDomain& d : domains)
+    {
+      std::vector<std::array<std::span<const std::int32_t>, 2>> cells(
+          d.blocks.size(), {d.cells[0], d.cells[1]});
+      std::vector<std::array<std::span<const std::int32_t>, 2>> indices;
+      for (auto [row, col] : d.blocks)
+      {
+        indices.push_back(
+            {pattern.block_indices(0)[row], pattern.block_indices(1)[col]});
+      }
+      if (d.type == IntegralType::interior_facet)
+      {
+        sparsitybuild::interior_facets(pattern, cells, d.dofmaps, indices,
+                                       num_threads);
+      }
+      else
+        sparsitybuild::cells(pattern, cells, d.dofmaps, indices, num_threads);
+    }
+  };
+
+  // Two-pass build (count and then fill), as in create_sparsity_patterns
+  pattern.begin_count();
+  insert_entries();
+  pattern.allocate();
+  insert_entries();
+
   t0.stop();
 
   return pattern;
 }
 
+/// @brief Create a sparsity pattern for a given form.
+///
+/// See create_sparsity_patterns() for how the pattern is built.
+///
+/// @note The pattern is not finalised, i.e. the caller is responsible
+/// for calling SparsityPattern::finalize.
+/// @param[in] a A bilinear form
+/// @param[in] num_threads Number of threads used to insert the entries
+/// of the pattern.
+/// @return The corresponding sparsity pattern
+template <dolfinx::scalar T, std::floating_point U>
+la::SparsityPattern create_sparsity_pattern(const Form<T, U>& a,
+                                            int num_threads = 1)
+{
+  std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>> patterns
+      = create_sparsity_patterns<T, U>({{&a}}, num_threads);
+  return std::move(*patterns.front().front());
+}
+
+/// @brief Create the sparsity pattern of the owned rows of a bilinear
+/// form for owner-computes assembly (see assemble_matrix_owned).
+///
+/// The entries of all local (owned and ghost) cells are inserted into
+/// the owned rows only. The ghost rows of the pattern are empty, so
+/// that a matrix created from the pattern has no storage for ghost
+/// rows.
+///
+/// @note The pattern is not finalised, i.e. the caller is responsible
+/// for calling SparsityPattern::finalize.
+/// @param[in] a A bilinear form with cell integrals over the default
+/// integration domain only.
+/// @return The sparsity pattern of the owned rows.
+template <dolfinx::scalar T, std::floating_point U>
+la::SparsityPattern create_sparsity_pattern_owned(const Form<T, U>& a)
+{
+  if (a.rank() != 2)
+  {
+    throw std::runtime_error(
+        "Cannot create sparsity pattern. Form is not a bilinear.");
+  }
+
+  std::shared_ptr mesh = a.mesh();
+  assert(mesh);
+  if (a.function_spaces().at(0)->mesh() != mesh
+      or a.function_spaces().at(1)->mesh() != mesh)
+  {
+    throw std::runtime_error("Owner-computes sparsity pattern requires the "
+                             "arguments to be defined on the form mesh.");
+  }
+
+  for (IntegralType type : a.integral_types())
+  {
+    if (type != IntegralType::cell)
+    {
+      throw std::runtime_error(
+          "Owner-computes sparsity pattern supports cell integrals only.");
+    }
+  }
+
+  for (int id : a.integral_ids(IntegralType::cell))
+  {
+    if (id != -1)
+    {
+      throw std::runtime_error("Owner-computes sparsity pattern supports the "
+                               "default cell integration domain only.");
+    }
+  }
+
+  const DofMap& dofmap0 = *a.function_spaces().at(0)->dofmap();
+  const DofMap& dofmap1 = *a.function_spaces().at(1)->dofmap();
+  la::SparsityPattern pattern(
+      mesh->comm(), {dofmap0.index_map, dofmap1.index_map},
+      {dofmap0.index_map_bs(), dofmap1.index_map_bs()});
+
+  auto cell_map = mesh->topology()->index_map(mesh->topology()->dim());
+  assert(cell_map);
+  const std::int32_t num_cells
+      = cell_map->size_local() + cell_map->num_ghosts();
+  const std::int32_t num_owned = dofmap0.index_map->size_local();
+  std::vector<std::int32_t> rows;
+  auto insert_entries = [&]()
+  {
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      rows.clear();
+      std::ranges::copy_if(dofmap0.cell_dofs(c), std::back_inserter(rows),
+                           [num_owned](auto r) { return r < num_owned; });
+      pattern.insert(rows, dofmap1.cell_dofs(c));
+    }
+  };
+
+  if (!a.integral_ids(IntegralType::cell).empty())
+  {
+    pattern.begin_count();
+    insert_entries();
+    pattern.allocate();
+    insert_entries();
+  }
+
+  return pattern;
+}
+
 /// Create an ElementDofLayout from a FiniteElement
 template <std::floating_point T>
 ElementDofLayout create_element_dof_layout(const fem::FiniteElement<T>& element,
@@ -283,12 +617,21 @@ ElementDofLayout create_element_dof_layout(const fem::FiniteElement<T>& element,
 /// @param[in] permute_inv Function to un-permute dofs. `nullptr`
 /// when transformation is not required.
 /// @param[in] reorder_fn Graph reordering function called on the dofmap
+/// @param[in] num_threads Number of threads used to build the dofmap
 /// @return A new dof map
+///
+/// @note For a discontinuous element, i.e. an element with all dofs
+/// associated with the cell interior and no dof permutations, the dofs
+/// are numbered by cell without building a dof graph (see
+/// DofMap::contiguous), and `reorder_fn` is not used. The dofs then
+/// follow the (reordered) cell numbering. The index map of the dofs is
+/// created from the cell index map without communication.
 DofMap create_dofmap(
     MPI_Comm comm, const ElementDofLayout& layout, mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn);
+        reorder_fn,
+    int num_threads = 1);
 
 /// @brief Create a set of dofmaps on a given topology
 /// @param[in] comm MPI communicator
@@ -297,6 +640,7 @@ DofMap create_dofmap(
 /// @param[in] permute_inv Function to un-permute dofs. `nullptr`
 /// when transformation is not required.
 /// @param[in] reorder_fn Graph reordering function called on the dofmaps
+/// @param[in] num_threads Number of threads used to build the dofmap
 /// @return The list of new dof maps
 /// @note The number of layouts must match the number of cell types in the
 /// topology
@@ -305,7 +649,8 @@ std::vector<DofMap> create_dofmaps(
     mesh::Topology& topology,
     std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv,
     std::function<std::vector<int>(const graph::AdjacencyList<std::int32_t>&)>
-        reorder_fn);
+        reorder_fn,
+    int num_threads = 1);
 
 /// Get the name of each coefficient in a UFC form
 /// @param[in] ufcx_form The UFC form
@@ -404,6 +749,8 @@ Form<T, U> create_form_factory(
     mesh->topology_mutable()->create_connectivity(tdim - 1, tdim);
     mesh->topology_mutable()->create_connectivity(tdim, tdim - 1);
   }
+  if (num_integrals_type[exterior_facet] > 0)
+    mesh->topology_mutable()->create_boundary_entities(tdim - 1);
 
   // Get list of integral IDs, and load tabulate tensor into memory for
   // each
@@ -413,7 +760,6 @@ Form<T, U> create_form_factory(
 
   // Attach cell kernels
   bool needs_facet_permutations = false;
-  std::vector<std::int32_t> default_cells;
   {
     std::span<const int> ids(ufcx_form.form_integral_ids
                                  + integral_offsets[cell],
@@ -469,10 +815,10 @@ Form<T, U> create_form_factory(
       if (id == -1)
       {
         // Default kernel, operates on all (owned) cells
-        assert(topology->index_map(tdim));
-        default_cells.resize(topology->index_map(tdim)->size_local(), 0);
-        std::iota(default_cells.begin(), default_cells.end(), 0);
-        itg.first->second.emplace_back(id, k, default_cells, active_coeffs);
+        std::shared_ptr<const std::vector<std::int32_t>> cells
+            = integration_domain_cache().default_domain(topology,
+                                                        IntegralType::cell);
+        itg.first->second.emplace_back(id, k, *cells, active_coeffs);
       }
       else if (sd != subdomains.end())
       {
@@ -490,7 +836,6 @@ Form<T, U> create_form_factory(
   }
 
   // Attach exterior facet kernels
-  std::vector<std::int32_t> default_facets_ext;
   {
     std::span<const int> ids(ufcx_form.form_integral_ids
                                  + integral_offsets[exterior_facet],
@@ -536,25 +881,13 @@ Form<T, U> create_form_factory(
       assert(k);
 
       // Build list of entities to assembler over
-      const std::vector bfacets = mesh::exterior_facet_indices(*topology);
-      auto f_to_c = topology->connectivity(tdim - 1, tdim);
-      assert(f_to_c);
-      auto c_to_f = topology->connectivity(tdim, tdim - 1);
-      assert(c_to_f);
       if (id == -1)
       {
         // Default kernel, operates on all (owned) exterior facets
-        default_facets_ext.reserve(2 * bfacets.size());
-        for (std::int32_t f : bfacets)
-        {
-          // There will only be one pair for an exterior facet integral
-          auto pair
-              = impl::get_cell_facet_pairs<1>(f, f_to_c->links(f), *c_to_f);
-          default_facets_ext.insert(default_facets_ext.end(), pair.begin(),
-                                    pair.end());
-        }
-        itg.first->second.emplace_back(id, k, default_facets_ext,
-                                       active_coeffs);
+        std::shared_ptr<const std::vector<std::int32_t>> facets
+            = integration_domain_cache().default_domain(
+                topology, IntegralType::exterior_facet);
+        itg.first->second.emplace_back(id, k, *facets, active_coeffs);
       }
       else if (sd != subdomains.end())
       {
@@ -572,28 +905,12 @@ Form<T, U> create_form_factory(
   }
 
   // Attach interior facet kernels
-  std::vector<std::int32_t> default_facets_int;
   {
     std::span<const int> ids(ufcx_form.form_integral_ids
                                  + integral_offsets[interior_facet],
                              num_integrals_type[interior_facet]);
     auto itg = integrals.insert({IntegralType::interior_facet, {}});
     auto sd = subdomains.find(IntegralType::interior_facet);
-
-    // Create indicator for interprocess facets
-    std::vector<std::int8_t> interprocess_marker;
-    if (num_integrals_type[interior_facet] > 0)
-    {
-      assert(topology->index_map(tdim - 1));
-      const std::vector<std::int32_t>& interprocess_facets
-          = topology->interprocess_facets();
-      std::int32_t num_facets = topology->index_map(tdim - 1)->size_local()
-                                + topology->index_map(tdim - 1)->num_ghosts();
-      interprocess_marker.resize(num_facets, 0);
-      std::ranges::for_each(interprocess_facets, [&interprocess_marker](auto f)
-                            { interprocess_marker[f] = 1; });
-    }
-
     for (int i = 0; i < num_integrals_type[interior_facet]; ++i)
     {
       const int id = ids[i];
@@ -633,35 +950,13 @@ Form<T, U> create_form_factory(
       assert(k);
 
       // Build list of entities to assembler over
-      auto f_to_c = topology->connectivity(tdim - 1, tdim);
-      assert(f_to_c);
-      auto c_to_f = topology->connectivity(tdim, tdim - 1);
-      assert(c_to_f);
       if (id == -1)
       {
         // Default kernel, operates on all (owned) interior facets
-        assert(topology->index_map(tdim - 1));
-        std::int32_t num_facets = topology->index_map(tdim - 1)->size_local();
-        default_facets_int.reserve(4 * num_facets);
-        for (std::int32_t f = 0; f < num_facets; ++f)
-        {
-          if (f_to_c->num_links(f) == 2)
-          {
-            auto pairs
-                = impl::get_cell_facet_pairs<2>(f, f_to_c->links(f), *c_to_f);
-            default_facets_int.insert(default_facets_int.end(), pairs.begin(),
-                                      pairs.end());
-          }
-          else if (interprocess_marker[f])
-          {
-            throw std::runtime_error(
-                "Cannot compute interior facet integral over interprocess "
-                "facet. Please use ghost mode shared facet when creating the "
-                "mesh");
-          }
-        }
-        itg.first->second.emplace_back(id, k, default_facets_int,
-                                       active_coeffs);
+        std::shared_ptr<const std::vector<std::int32_t>> facets
+            = integration_domain_cache().default_domain(
+                topology, IntegralType::interior_facet);
+        itg.first->second.emplace_back(id, k, *facets, active_coeffs);
       }
       else if (sd != subdomains.end())
       {
@@ -789,6 +1084,11 @@ Form<T, U> create_form(
 }
 
 /// @brief NEW Create a function space from a fem::FiniteElement.
+///
+/// If no reordering function is given, the dofmap is shared with existing
+/// function spaces with the same element on the same mesh topology
+/// (see fem::DofMapCache).
+/// @note Collective MPI operation
 template <std::floating_point T>
 FunctionSpace<T> create_functionspace(
     std::shared_ptr<mesh::Mesh<T>> mesh,
@@ -812,8 +1112,17 @@ FunctionSpace<T> create_functionspace(
   std::function<void(std::span<std::int32_t>, std::uint32_t)> permute_inv
       = e->needs_dof_permutations() ? e->dof_permutation_fn(true, true)
                                     : nullptr;
-  auto dofmap = std::make_shared<const DofMap>(create_dofmap(
-      mesh->comm(), layout, *mesh->topology(), permute_inv, reorder_fn));
+  auto create = [&]()
+  {
+    return create_dofmap(mesh->comm(), layout, *mesh->topology(), permute_inv,
+                         reorder_fn);
+  };
+
+  // A dofmap with a custom reordering is not shared
+  std::shared_ptr<const DofMap> dofmap
+      = reorder_fn ? std::make_shared<const DofMap>(create())
+                   : dofmap_cache().dofmap(mesh->topology(), e->signature(),
+                                           layout, create);
 
   return FunctionSpace(mesh, e, dofmap);
 }
@@ -838,13 +1147,30 @@ get_cell_orientation_info(const Function<T, U>& coefficient)
   return cell_info;
 }
 
-/// Pack a single coefficient for a single cell
-template <int _bs, dolfinx::scalar T>
-void pack(std::span<T> coeffs, std::int32_t cell, int bs, std::span<const T> v,
+/// @brief Pack a single coefficient for a single cell.
+///
+/// The values of `v` are converted to the scalar type of `coeffs`.
+template <int _bs, dolfinx::scalar T, dolfinx::scalar S>
+void pack(std::span<T> coeffs, std::int32_t cell, int bs, std::span<const S> v,
           std::span<const std::uint32_t> cell_info, const DofMap& dofmap,
           auto transform)
 {
   auto dofs = dofmap.cell_dofs(cell);
+  if (dofmap.contiguous())
+  {
+    // The values of the cell are a contiguous block of v
+    std::span<const S> vc = v.subspan(bs * dofs.front(), bs * dofs.size());
+    if constexpr (std::is_same_v<T, S>)
+      std::ranges::copy(vc, coeffs.begin());
+    else
+    {
+      std::ranges::transform(vc, coeffs.begin(),
+                             [](auto x) { return static_cast<T>(x); });
+    }
+    transform(coeffs, cell_info, cell, 1);
+    return;
+  }
+
   for (std::size_t i = 0; i < dofs.size(); ++i)
   {
     if constexpr (_bs < 0)
@@ -852,7 +1178,7 @@ void pack(std::span<T> coeffs, std::int32_t cell, int bs, std::span<const T> v,
       const int pos_c = bs * i;
       const int pos_v = bs * dofs[i];
       for (int k = 0; k < bs; ++k)
-        coeffs[pos_c + k] = v[pos_v + k];
+        coeffs[pos_c + k] = static_cast<T>(v[pos_v + k]);
     }
     else
     {
@@ -860,7 +1186,7 @@ void pack(std::span<T> coeffs, std::int32_t cell, int bs, std::span<const T> v,
       const int pos_c = _bs * i;
       const int pos_v = _bs * dofs[i];
       for (int k = 0; k < _bs; ++k)
-        coeffs[pos_c + k] = v[pos_v + k];
+        coeffs[pos_c + k] = static_cast<T>(v[pos_v + k]);
     }
   }
 
@@ -880,7 +1206,8 @@ concept FetchCells = requires(F&& f, std::span<const std::int32_t> v) {
 /// @param[out] c Coefficient to be packed.
 /// @param[in] cstride Total number of coefficient values to pack for
 /// each entity.
-/// @param[in] u Function to extract coefficient data from.
+/// @param[in] u Function to extract coefficient data from. The values
+/// are converted to the scalar type of `c`.
 /// @param[in] cell_info Array of bytes describing which transformation
 /// has to be applied on the cell to map it to the reference element.
 /// @param[in] entities Set of active entities.
@@ -888,16 +1215,18 @@ concept FetchCells = requires(F&& f, std::span<const std::int32_t> v) {
 /// @param[in] fetch_cells Function that fetches the cell index for an
 /// entity in active_entities.
 /// @param[in] offset The offset for c.
-template <dolfinx::scalar T, std::floating_point U>
+/// @param[in] num_threads Number of threads. The entities are divided
+/// into contiguous blocks, one per thread.
+template <dolfinx::scalar T, dolfinx::scalar S, std::floating_point U>
 void pack_coefficient_entity(std::span<T> c, int cstride,
-                             const Function<T, U>& u,
+                             const Function<S, U>& u,
                              std::span<const std::uint32_t> cell_info,
                              std::span<const std::int32_t> entities,
                              std::size_t estride, FetchCells auto&& fetch_cells,
-                             std::int32_t offset)
+                             std::int32_t offset, int num_threads = 1)
 {
   // Read data from coefficient Function u
-  std::span<const T> v = u.x()->array();
+  std::span<const S> v = u.x()->array();
   const DofMap& dofmap = *u.function_space()->dofmap();
   auto element = u.function_space()->element();
   assert(element);
@@ -908,55 +1237,307 @@ void pack_coefficient_entity(std::span<T> c, int cstride,
   auto transformation
       = element->template dof_transformation_fn<T>(doftransform::transpose);
   const int bs = dofmap.bs();
-  switch (bs)
+
+  // Pack the entities [e0, e1)
+  auto pack_block = [&]<int _bs>(std::size_t e0, std::size_t e1)
   {
-  case 1:
-    for (std::size_t e = 0; e < entities.size(); e += estride)
+    for (std::size_t e = e0; e < e1; ++e)
     {
-      auto entity = entities.subspan(e, estride);
+      auto entity = entities.subspan(e * estride, estride);
       if (std::int32_t cell = fetch_cells(entity); cell >= 0)
       {
-        auto cell_coeff
-            = c.subspan((e / estride) * cstride + offset, space_dim);
-        pack<1>(cell_coeff, cell, bs, v, cell_info, dofmap, transformation);
+        auto cell_coeff = c.subspan(e * cstride + offset, space_dim);
+        pack<_bs>(cell_coeff, cell, bs, v, cell_info, dofmap, transformation);
       }
     }
-    break;
-  case 2:
-    for (std::size_t e = 0; e < entities.size(); e += estride)
+  };
+
+  for_each_block(entities.size() / estride, num_threads,
+                 [&](std::size_t e0, std::size_t e1)
+                 {
+                   switch (bs)
+                   {
+                   case 1:
+                     pack_block.template operator()<1>(e0, e1);
+                     break;
+                   case 2:
+                     pack_block.template operator()<2>(e0, e1);
+                     break;
+                   case 3:
+                     pack_block.template operator()<3>(e0, e1);
+                     break;
+                   default:
+                     pack_block.template operator()<-1>(e0, e1);
+                     break;
+                   }
+                 });
+}
+
+/// @brief Indicator for the coefficients of a form that are active in
+/// integrals of a given type.
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<std::int8_t> active_coefficients(const Form<T, U>& form,
+                                             IntegralType integral_type)
+{
+  std::vector<std::int8_t> active(form.coefficients().size(), false);
+  for (std::size_t i = 0; i < form.num_integrals(integral_type); ++i)
+  {
+    for (auto idx : form.active_coeffs(integral_type, i))
+      active[idx] = true;
+  }
+  return active;
+}
+
+/// @brief Pack one coefficient of a Form for a given integral type and
+/// domain id, reading the coefficient data from a Function that may
+/// differ in scalar type from the form.
+///
+/// The integration entities and the layout of the packed data are
+/// those of the form coefficient, and the values are read from `v`
+/// and converted to the scalar type of the form.
+/// @pre `v` has the same element and the same dofmap layout, on a mesh
+/// with the same cell numbering, as the form coefficient.
+/// @param[in] form The Form
+/// @param[in] integral_type Type of integral
+/// @param[in] id The id of the integration domain
+/// @param[in] coeff Index of the coefficient in the form
+/// @param[in] v Function to read the coefficient data from
+/// @param[in,out] c The coefficient array
+/// @param[in] cstride The coefficient stride
+/// @param[in] num_threads Number of threads
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar S,
+          std::floating_point V>
+void pack_coefficient(const Form<T, U>& form, IntegralType integral_type,
+                      int id, std::size_t coeff, const Function<S, V>& v,
+                      std::span<T> c, int cstride, int num_threads)
+{
+  const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
+      = form.coefficients();
+  const std::vector<int> offsets = form.coefficient_offsets();
+  const Function<T, U>& u = *coefficients[coeff];
+  auto mesh = u.function_space()->mesh();
+  assert(mesh);
+  if (static_cast<const void*>(&u) != static_cast<const void*>(&v))
+  {
+    const DofMap& dofmap_u = *u.function_space()->dofmap();
+    const DofMap& dofmap_v = *v.function_space()->dofmap();
+    if (v.function_space()->element()->space_dimension()
+            != u.function_space()->element()->space_dimension()
+        or dofmap_v.bs() != dofmap_u.bs()
+        or dofmap_v.map().extent(0) != dofmap_u.map().extent(0))
     {
-      auto entity = entities.subspan(e, estride);
-      if (std::int32_t cell = fetch_cells(entity); cell >= 0)
-      {
-        auto cell_coeff
-            = c.subspan((e / estride) * cstride + offset, space_dim);
-        pack<2>(cell_coeff, cell, bs, v, cell_info, dofmap, transformation);
-      }
+      throw std::runtime_error(
+          "Coefficient data is incompatible with form coefficient.");
     }
-    break;
-  case 3:
-    for (std::size_t e = 0; e < entities.size(); e += estride)
+  }
+
+  std::span<const std::uint32_t> cell_info = get_cell_orientation_info(v);
+  switch (integral_type)
+  {
+  case IntegralType::cell:
+  {
+    // Other integrals in the form might have coefficients defined over
+    // entities of codim > 0, which don't make sense for cell integrals, so
+    // don't pack them.
+    if (const int codim
+        = form.mesh()->topology()->dim() - mesh->topology()->dim();
+        codim > 0)
     {
-      auto entity = entities.subspan(e, estride);
-      if (std::int32_t cell = fetch_cells(entity); cell >= 0)
-      {
-        auto cell_coeff = c.subspan(e / estride * cstride + offset, space_dim);
-        pack<3>(cell_coeff, cell, bs, v, cell_info, dofmap, transformation);
-      }
+      throw std::runtime_error("Should not be packing coefficients with "
+                               "codim>0 in a cell integral");
     }
+
+    std::span<const std::int32_t> cells
+        = form.domain(IntegralType::cell, id, *mesh);
+    pack_coefficient_entity(
+        c, cstride, v, cell_info, cells, 1,
+        [](auto entity) { return entity.front(); }, offsets[coeff],
+        num_threads);
+    break;
+  }
+  case IntegralType::exterior_facet:
+  {
+    std::span<const std::int32_t> facets
+        = form.domain(IntegralType::exterior_facet, id, *mesh);
+    pack_coefficient_entity(
+        c, cstride, v, cell_info, facets, 2,
+        [](auto entity) { return entity.front(); }, offsets[coeff],
+        num_threads);
+    break;
+  }
+  case IntegralType::interior_facet:
+  {
+    std::span<const std::int32_t> facets
+        = form.domain(IntegralType::interior_facet, id, *mesh);
+
+    // Pack coefficient ['+']
+    pack_coefficient_entity(
+        c, 2 * cstride, v, cell_info, facets, 4,
+        [](auto entity) { return entity[0]; }, 2 * offsets[coeff],
+        num_threads);
+
+    // Pack coefficient ['-']
+    pack_coefficient_entity(
+        c, 2 * cstride, v, cell_info, facets, 4,
+        [](auto entity) { return entity[2]; },
+        offsets[coeff] + offsets[coeff + 1], num_threads);
     break;
+  }
   default:
-    for (std::size_t e = 0; e < entities.size(); e += estride)
+    throw std::runtime_error(
+        "Could not pack coefficient. Integral type not supported.");
+  }
+}
+
+/// @brief Pack one coefficient of a Form for a given integral type and
+/// domain id.
+/// @param[in] form The Form
+/// @param[in] integral_type Type of integral
+/// @param[in] id The id of the integration domain
+/// @param[in] coeff Index of the coefficient in the form
+/// @param[in,out] c The coefficient array
+/// @param[in] cstride The coefficient stride
+/// @param[in] num_threads Number of threads
+template <dolfinx::scalar T, std::floating_point U>
+void pack_coefficient(const Form<T, U>& form, IntegralType integral_type,
+                      int id, std::size_t coeff, std::span<T> c, int cstride,
+                      int num_threads)
+{
+  assert(form.coefficients()[coeff]);
+  pack_coefficient(form, integral_type, id, coeff, *form.coefficients()[coeff],
+                   c, cstride, num_threads);
+}
+
+/// @brief Packs the coefficients of a cell integral for ranges of the
+/// cells in the integration domain.
+///
+/// This is used by the assemblers to pack the coefficients of a cell
+/// integral in small blocks of cells as they are assembled, rather
+/// than for all cells in the integration domain before assembly.
+template <dolfinx::scalar T, std::floating_point U>
+class CellCoefficientPacker
+{
+public:
+  /// @brief Create a packer for a cell integral.
+  /// @param[in] form The form. It must outlive the packer.
+  /// @param[in] id The id of the integration domain.
+  CellCoefficientPacker(const Form<T, U>& form, int id)
+      : _form(form), _offsets(form.coefficient_offsets())
+  {
+    const std::vector<std::int8_t> active
+        = active_coefficients(form, IntegralType::cell);
+    for (std::size_t i = 0; i < active.size(); ++i)
     {
-      auto entity = entities.subspan(e, estride);
-      if (std::int32_t cell = fetch_cells(entity); cell >= 0)
+      if (!active[i])
+        continue;
+
+      const Function<T, U>& u = *form.coefficients()[i];
+      auto mesh = u.function_space()->mesh();
+      assert(mesh);
+      if (form.mesh()->topology()->dim() > mesh->topology()->dim())
       {
-        auto cell_coeff
-            = c.subspan((e / estride) * cstride + offset, space_dim);
-        pack<-1>(cell_coeff, cell, bs, v, cell_info, dofmap, transformation);
+        throw std::runtime_error("Should not be packing coefficients with "
+                                 "codim>0 in a cell integral");
       }
+
+      _coeffs.push_back(i);
+      _cell_info.push_back(get_cell_orientation_info(u));
+      _cells.push_back(form.domain(IntegralType::cell, id, *mesh));
     }
-    break;
+  }
+
+  /// @brief Pack the coefficients for the cells `[k0, k1)` of the
+  /// integration domain.
+  /// @param[in] k0 Position of the first cell in the integration
+  /// domain.
+  /// @param[in] k1 Position one past the last cell in the integration
+  /// domain.
+  /// @param[out] c Array of shape `(k1 - k0, cstride)` to pack the
+  /// coefficients into. Entries for coefficients that are not used by
+  /// cell integrals are not set.
+  void operator()(std::size_t k0, std::size_t k1, std::span<T> c) const
+  {
+    for (std::size_t n = 0; n < _coeffs.size(); ++n)
+    {
+      pack_coefficient_entity(
+          c, _offsets.back(), *_form.coefficients()[_coeffs[n]],
+          _cell_info[n], _cells[n].subspan(k0, k1 - k0), 1,
+          [](auto entity) { return entity.front(); }, _offsets[_coeffs[n]]);
+    }
+  }
+
+  /// @brief Number of coefficient values per cell.
+  int cstride() const { return _offsets.back(); }
+
+private:
+  // The form
+  const Form<T, U>& _form;
+
+  // Offset of each coefficient in the packed array for a cell
+  std::vector<int> _offsets;
+
+  // Indices of the coefficients that are used by cell integrals
+  std::vector<std::size_t> _coeffs;
+
+  // Cell permutation information for each coefficient
+  std::vector<std::span<const std::uint32_t>> _cell_info;
+
+  // Integration domain cells in the mesh of each coefficient
+  std::vector<std::span<const std::int32_t>> _cells;
+};
+
+/// @brief Check if the coefficients of a cell integral have not been
+/// packed, and are packed by the assembler in blocks of cells.
+/// @param[in] coeffs Packed coefficients of the cell integral.
+/// @param[in] cstride Number of coefficient values per cell.
+/// @param[in] num_cells Number of cells in the integration domain.
+/// @return True if the coefficients are packed during assembly.
+template <dolfinx::scalar T>
+bool pack_cells_deferred(std::span<const T> coeffs, int cstride,
+                         std::size_t num_cells)
+{
+  return coeffs.empty() and cstride > 0 and num_cells > 0;
+}
+
+/// @brief Execute a function over blocks of cells of a cell integral
+/// with the packed coefficients of each block.
+///
+/// If the coefficients are packed, i.e. `coeffs` has `cstride` values
+/// for each cell in the integration domain, `fn` is called once for all
+/// cells. Otherwise the coefficients are packed for blocks of at most
+/// `block_size` cells, and `fn` is called for each block. The packed
+/// coefficients of a block remain in cache while the block is
+/// assembled.
+///
+/// @param[in] form The form.
+/// @param[in] id The id of the integration domain.
+/// @param[in] coeffs Packed coefficients of the integral, or an empty
+/// array if the coefficients are to be packed by blocks.
+/// @param[in] cstride Number of coefficient values per cell.
+/// @param[in] fn Function called as `fn(k0, k1, c)`, where `[k0, k1)`
+/// is the range of positions in the integration domain and `c` are the
+/// packed coefficients for the cells in the range.
+/// @param[in] block_size Maximum number of cells in a block.
+template <dolfinx::scalar T, std::floating_point U>
+void for_each_cell_block(const Form<T, U>& form, int id,
+                         std::span<const T> coeffs, int cstride, auto&& fn,
+                         std::size_t block_size = 512)
+{
+  const std::size_t num_cells = form.domain(IntegralType::cell, id).size();
+  if (!pack_cells_deferred(coeffs, cstride, num_cells))
+  {
+    fn(std::size_t(0), num_cells, coeffs);
+    return;
+  }
+
+  CellCoefficientPacker<T, U> pack(form, id);
+  std::vector<T> c(std::min(block_size, num_cells) * cstride);
+  for (std::size_t k0 = 0; k0 < num_cells; k0 += block_size)
+  {
+    const std::size_t k1 = std::min(k0 + block_size, num_cells);
+    std::span<T> _c = std::span(c).first((k1 - k0) * cstride);
+    pack(k0, k1, _c);
+    fn(k0, k1, std::span<const T>(_c));
   }
 }
 
@@ -967,11 +1548,15 @@ void pack_coefficient_entity(std::span<T> c, int cstride,
 /// @param[in] form The Form
 /// @param[in] integral_type Type of integral
 /// @param[in] id The id of the integration domain
+/// @param[in] defer_cells If true, no storage is allocated for cell
+/// integrals. The assemblers then pack the coefficients of cell
+/// integrals in small blocks of cells during assembly, which avoids
+/// storing the packed coefficients for all cells.
 /// @return A storage container and the column stride
 template <dolfinx::scalar T, std::floating_point U>
 std::pair<std::vector<T>, int>
 allocate_coefficient_storage(const Form<T, U>& form, IntegralType integral_type,
-                             int id)
+                             int id, bool defer_cells = false)
 {
   // Get form coefficient offsets and dofmaps
   const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
@@ -984,7 +1569,9 @@ allocate_coefficient_storage(const Form<T, U>& form, IntegralType integral_type,
   {
     cstride = offsets.back();
     num_entities = form.domain(integral_type, id).size();
-    if (integral_type == IntegralType::exterior_facet
+    if (integral_type == IntegralType::cell and defer_cells)
+      num_entities = 0;
+    else if (integral_type == IntegralType::exterior_facet
         or integral_type == IntegralType::interior_facet)
     {
       num_entities /= 2;
@@ -996,11 +1583,14 @@ allocate_coefficient_storage(const Form<T, U>& form, IntegralType integral_type,
 
 /// @brief Allocate memory for packed coefficients of a Form.
 /// @param[in] form The Form
+/// @param[in] defer_cells If true, no storage is allocated for cell
+/// integrals, see allocate_coefficient_storage(const Form<T, U>&,
+/// IntegralType, int, bool).
 /// @return Map from a form `(integral_type, domain_id)` pair to a
 /// `(coeffs, cstride)` pair
 template <dolfinx::scalar T, std::floating_point U>
 std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>
-allocate_coefficient_storage(const Form<T, U>& form)
+allocate_coefficient_storage(const Form<T, U>& form, bool defer_cells = false)
 {
   std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>> coeffs;
   for (auto integral_type : form.integral_types())
@@ -1009,7 +1599,7 @@ allocate_coefficient_storage(const Form<T, U>& form)
     {
       coeffs.emplace_hint(
           coeffs.end(), std::pair(integral_type, id),
-          allocate_coefficient_storage(form, integral_type, id));
+          allocate_coefficient_storage(form, integral_type, id, defer_cells));
     }
   }
 
@@ -1021,132 +1611,27 @@ allocate_coefficient_storage(const Form<T, U>& form)
 /// @param[in] form The Form
 /// @param[in] integral_type Type of integral
 /// @param[in] id The id of the integration domain
-/// @param[in,out] c The coefficient array
+/// @param[in,out] c The coefficient array. If empty, nothing is
+/// packed, e.g. for cell integrals that are packed during assembly.
 /// @param[in] cstride The coefficient stride
+/// @param[in] num_threads Number of threads used to pack each
+/// coefficient
 template <dolfinx::scalar T, std::floating_point U>
 void pack_coefficients(const Form<T, U>& form, IntegralType integral_type,
-                       int id, std::span<T> c, int cstride)
+                       int id, std::span<T> c, int cstride,
+                       int num_threads = 1)
 {
-  // Get form coefficient offsets and dofmaps
-  const std::vector<std::shared_ptr<const Function<T, U>>>& coefficients
-      = form.coefficients();
-  const std::vector<int> offsets = form.coefficient_offsets();
+  if (c.empty())
+    return;
 
-  // Indicator for packing coefficients
-  std::vector<int> active_coefficient(coefficients.size(), 0);
-  if (!coefficients.empty())
+  const std::vector<std::int8_t> active
+      = impl::active_coefficients(form, integral_type);
+  for (std::size_t coeff = 0; coeff < active.size(); ++coeff)
   {
-    switch (integral_type)
-    {
-    case IntegralType::cell:
+    if (active[coeff])
     {
-      // Get indicator for all coefficients that are active in cell
-      // integrals
-      for (std::size_t i = 0; i < form.num_integrals(IntegralType::cell); ++i)
-      {
-        for (auto idx : form.active_coeffs(IntegralType::cell, i))
-          active_coefficient[idx] = 1;
-      }
-
-      // Iterate over coefficients
-      for (std::size_t coeff = 0; coeff < coefficients.size(); ++coeff)
-      {
-        if (!active_coefficient[coeff])
-          continue;
-
-        // Get coefficient mesh
-        auto mesh = coefficients[coeff]->function_space()->mesh();
-        assert(mesh);
-
-        // Other integrals in the form might have coefficients defined over
-        // entities of codim > 0, which don't make sense for cell integrals, so
-        // don't pack them.
-        if (const int codim
-            = form.mesh()->topology()->dim() - mesh->topology()->dim();
-            codim > 0)
-        {
-          throw std::runtime_error("Should not be packing coefficients with "
-                                   "codim>0 in a cell integral");
-        }
-
-        std::vector<std::int32_t> cells
-            = form.domain(IntegralType::cell, id, *mesh);
-        std::span<const std::uint32_t> cell_info
-            = impl::get_cell_orientation_info(*coefficients[coeff]);
-        impl::pack_coefficient_entity(
-            c, cstride, *coefficients[coeff], cell_info, cells, 1,
-            [](auto entity) { return entity.front(); }, offsets[coeff]);
-      }
-      break;
-    }
-    case IntegralType::exterior_facet:
-    {
-      // Get indicator for all coefficients that are active in exterior
-      // facet integrals
-      for (std::size_t i = 0;
-           i < form.num_integrals(IntegralType::exterior_facet); ++i)
-      {
-        for (auto idx : form.active_coeffs(IntegralType::exterior_facet, i))
-          active_coefficient[idx] = 1;
-      }
-
-      // Iterate over coefficients
-      for (std::size_t coeff = 0; coeff < coefficients.size(); ++coeff)
-      {
-        if (!active_coefficient[coeff])
-          continue;
-
-        auto mesh = coefficients[coeff]->function_space()->mesh();
-        std::vector<std::int32_t> facets
-            = form.domain(IntegralType::exterior_facet, id, *mesh);
-        std::span<const std::uint32_t> cell_info
-            = impl::get_cell_orientation_info(*coefficients[coeff]);
-        impl::pack_coefficient_entity(
-            c, cstride, *coefficients[coeff], cell_info, facets, 2,
-            [](auto entity) { return entity.front(); }, offsets[coeff]);
-      }
-      break;
-    }
-    case IntegralType::interior_facet:
-    {
-      // Get indicator for all coefficients that are active in interior
-      // facet integrals
-      for (std::size_t i = 0;
-           i < form.num_integrals(IntegralType::interior_facet); ++i)
-      {
-        for (auto idx : form.active_coeffs(IntegralType::interior_facet, i))
-          active_coefficient[idx] = 1;
-      }
-
-      // Iterate over coefficients
-      for (std::size_t coeff = 0; coeff < coefficients.size(); ++coeff)
-      {
-        if (!active_coefficient[coeff])
-          continue;
-
-        auto mesh = coefficients[coeff]->function_space()->mesh();
-        std::vector<std::int32_t> facets
-            = form.domain(IntegralType::interior_facet, id, *mesh);
-
-        std::span<const std::uint32_t> cell_info
-            = impl::get_cell_orientation_info(*coefficients[coeff]);
-
-        // Pack coefficient ['+']
-        impl::pack_coefficient_entity(
-            c, 2 * cstride, *coefficients[coeff], cell_info, facets, 4,
-            [](auto entity) { return entity[0]; }, 2 * offsets[coeff]);
-
-        // Pack coefficient ['-']
-        impl::pack_coefficient_entity(
-            c, 2 * cstride, *coefficients[coeff], cell_info, facets, 4,
-            [](auto entity) { return entity[2]; },
-            offsets[coeff] + offsets[coeff + 1]);
-      }
-      break;
-    }
-    default:
-      throw std::runtime_error(
-          "Could not pack coefficient. Integral type not supported.");
+      impl::pack_coefficient(form, integral_type, id, coeff, c, cstride,
+                             num_threads);
     }
   }
 }
@@ -1262,13 +1747,76 @@ Expression<T, U> create_expression(
 /// being integrated over and cstride is the number of coefficient data
 /// entries per integration entity. `coeffs` is flattened into row-major
 /// layout.
+/// @param[in] num_threads Number of threads used to pack each
+/// coefficient.
 template <dolfinx::scalar T, std::floating_point U>
 void pack_coefficients(const Form<T, U>& form,
                        std::map<std::pair<IntegralType, int>,
-                                std::pair<std::vector<T>, int>>& coeffs)
+                                std::pair<std::vector<T>, int>>& coeffs,
+                       int num_threads = 1)
 {
   for (auto& [key, val] : coeffs)
-    pack_coefficients<T>(form, key.first, key.second, val.first, val.second);
+  {
+    pack_coefficients<T>(form, key.first, key.second, val.first, val.second,
+                         num_threads);
+  }
+}
+
+/// @brief Pack coefficients of a Form from Functions of a different
+/// scalar type.
+///
+/// The coefficient data is read from `coefficients` in place of the
+/// coefficients of the form, and is converted to the scalar type of the
+/// form as it is packed. This allows a form with kernels of reduced
+/// precision, e.g. to assemble a preconditioner in single precision, to
+/// be used with the double precision Functions of a solver without
+/// storing converted copies of the Functions. The coefficients of the
+/// form define the layout of the packed data and must be set.
+///
+/// @pre Each Function in `coefficients` has the same element and dofmap
+/// layout as the corresponding coefficient of the form, on a mesh with
+/// the same cell numbering.
+/// @param[in] form The Form
+/// @param[in] coefficients Functions to read the coefficient data from,
+/// in the order of the coefficients of the form.
+/// @param[in,out] coeffs A map from an (integral_type, domain_id) pair
+/// to a (coeffs, cstride) pair, as in fem::pack_coefficients.
+/// @param[in] num_threads Number of threads used to pack each
+/// coefficient.
+template <dolfinx::scalar T, std::floating_point U, dolfinx::scalar S,
+          std::floating_point V>
+void pack_coefficients(
+    const Form<T, U>& form,
+    const std::vector<std::shared_ptr<const Function<S, V>>>& coefficients,
+    std::map<std::pair<IntegralType, int>, std::pair<std::vector<T>, int>>&
+        coeffs,
+    int num_threads = 1)
+{
+  if (coefficients.size() != form.coefficients().size())
+  {
+    throw std::runtime_error(
+        "Number of Functions does not match number of form coefficients.");
+  }
+
+  for (auto& [key, val] : coeffs)
+  {
+    auto& [c, cstride] = val;
+    if (c.empty())
+      continue;
+
+    const std::vector<std::int8_t> active
+        = impl::active_coefficients(form, key.first);
+    for (std::size_t coeff = 0; coeff < active.size(); ++coeff)
+    {
+      if (active[coeff])
+      {
+        assert(coefficients[coeff]);
+        impl::pack_coefficient(form, key.first, key.second, coeff,
+                               *coefficients[coeff], std::span<T>(c), cstride,
+                               num_threads);
+      }
+    }
+  }
 }
 
 /// @brief Pack coefficients of a Expression u for a give list of active
@@ -1278,11 +1826,14 @@ void pack_coefficients(const Form<T, U>& form,
 /// @param[in] entities A list of active entities
 /// @param[in] estride Stride for each entity in active entities (1 for cells, 2
 /// for facets)
+/// @param[in] num_threads Number of threads used to pack each
+/// coefficient
 /// @return A pair of the form (coeffs, cstride)
 template <dolfinx::scalar T, std::floating_point U>
 std::pair<std::vector<T>, int>
 pack_coefficients(const Expression<T, U>& e,
-                  std::span<const std::int32_t> entities, std::size_t estride)
+                  std::span<const std::int32_t> entities, std::size_t estride,
+                  int num_threads = 1)
 {
   // Get form coefficient offsets and dofmaps
   const std::vector<std::shared_ptr<const Function<T, U>>>& coeffs
@@ -1302,7 +1853,7 @@ pack_coefficients(const Expression<T, U>& e,
 
       impl::pack_coefficient_entity(
           std::span(c), cstride, *coeffs[coeff], cell_info, entities, estride,
-          [](auto entity) { return entity[0]; }, offsets[coeff]);
+          [](auto entity) { return entity[0]; }, offsets[coeff], num_threads);
     }
   }
   return {std::move(c), cstride};
@@ -11,6 +11,7 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/mesh/utils.h>
 #include <mpi.h>
 #include <optional>
@@ -23,37 +24,53 @@ namespace dolfinx::geometry
 namespace impl_bb
 {
 //-----------------------------------------------------------------------------
-// Compute bounding box of mesh entity. The bounding box is defined by (lower
-// left corner, top right corner). Storage flattened row-major
+// Compute bounding boxes of mesh entities. A bounding box is defined
+// by (lower left corner, top right corner), and is extended by padding
+// in each direction.
 template <std::floating_point T>
-std::array<T, 6> compute_bbox_of_entity(const mesh::Mesh<T>& mesh, int dim,
-                                        std::int32_t index)
+std::vector<std::array<T, 6>>
+compute_bbox_of_entities(const mesh::Mesh<T>& mesh, int dim,
+                         std::span<const std::int32_t> entities, T padding)
 {
-  // Get the geometrical indices for the mesh entity
-  std::span<const T> xg = mesh.geometry().x();
+  std::vector<std::array<T, 6>> bboxes(entities.size());
+  if (entities.empty())
+    return bboxes;
 
-  // FIXME: return of small dynamic array is expensive
-  std::span<const std::int32_t> entity(&index, 1);
+  // Get the geometrical indices for the mesh entities
+  mesh::NodeCoordinates<T> xg = mesh.geometry().coordinates();
   const std::vector<std::int32_t> vertex_indices
-      = mesh::entities_to_geometry(mesh, dim, entity, false);
+      = mesh::entities_to_geometry(mesh, dim, entities, false);
+  const std::size_t num_vertices = vertex_indices.size() / entities.size();
 
-  std::array<T, 6> b;
-  auto b0 = std::span(b).template subspan<0, 3>();
-  auto b1 = std::span(b).template subspan<3, 3>();
-  std::copy_n(std::next(xg.begin(), 3 * vertex_indices.front()), 3, b0.begin());
-  std::copy_n(std::next(xg.begin(), 3 * vertex_indices.front()), 3, b1.begin());
-
-  // Compute min and max over vertices
-  for (std::int32_t local_vertex : vertex_indices)
+  for (std::size_t e = 0; e < entities.size(); ++e)
   {
+    std::span<const std::int32_t> vertices(
+        vertex_indices.data() + e * num_vertices, num_vertices);
+
+    std::array<T, 6>& b = bboxes[e];
+    auto b0 = std::span(b).template subspan<0, 3>();
+    auto b1 = std::span(b).template subspan<3, 3>();
+    xg.copy(vertices.first(1), b0.data());
+    xg.copy(vertices.first(1), b1.data());
+
+    // Compute min and max over vertices
+    for (std::int32_t local_vertex : vertices)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        b0[j] = std::min(b0[j], xg(local_vertex, j));
+        b1[j] = std::max(b1[j], xg(local_vertex, j));
+      }
+    }
+
     for (std::size_t j = 0; j < 3; ++j)
     {
-      b0[j] = std::min(b0[j], xg[3 * local_vertex + j]);
-      b1[j] = std::max(b1[j], xg[3 * local_vertex + j]);
+      b0[j] -= padding;
+      b1[j] += padding;
     }
   }
 
-  return b;
+  return bboxes;
 }
 //-----------------------------------------------------------------------------
 // Compute bounding box of bounding boxes. Each bounding box is defined as a
@@ -76,6 +93,56 @@ std::array<T, 6> compute_bbox_of_bboxes(
 
   return b;
 }
+//-----------------------------------------------------------------------------
+// Call fn(i0, i1) for blocks of the range [0, n), with each block
+// executed as a task on the process thread pool. Exceptions thrown by
+// fn are re-thrown on the calling thread.
+template <typename F>
+void for_each_block(std::size_t n, int num_threads, F&& fn)
+{
+  if (num_threads < 2)
+  {
+    fn(std::size_t(0), n);
+    return;
+  }
+
+  common::thread_pool().run(
+      num_threads,
+      [&fn, n, num_threads](int t)
+      {
+        auto [i0, i1] = dolfinx::MPI::local_range(t, n, num_threads);
+        fn(std::size_t(i0), std::size_t(i1));
+      });
+}
+//-----------------------------------------------------------------------------
+// Compute the bounding box of a list of leaf bounding boxes, and
+// partition the list about its midpoint along the longest axis of the
+// bounding box
+template <std::floating_point T>
+std::array<T, 6> split_leaves(
+    std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes)
+{
+  // Compute bounding box of all bounding boxes
+  std::array b = compute_bbox_of_bboxes<T>(leaf_bboxes);
+
+  // Sort bounding boxes along longest axis
+  std::array<T, 3> b_diff;
+  std::transform(std::next(b.cbegin(), 3), b.cend(), b.cbegin(),
+                 b_diff.begin(), std::minus<T>());
+  const std::size_t axis = std::distance(
+      b_diff.begin(), std::max_element(b_diff.begin(), b_diff.end()));
+
+  auto middle = std::next(leaf_bboxes.begin(), leaf_bboxes.size() / 2);
+  std::nth_element(leaf_bboxes.begin(), middle, leaf_bboxes.end(),
+                   [axis](auto& p0, auto& p1) -> bool
+                   {
+                     auto x0 = p0.first[axis] + p0.first[3 + axis];
+                     auto x1 = p1.first[axis] + p1.first[3 + axis];
+                     return x0 < x1;
+                   });
+
+  return b;
+}
 //------------------------------------------------------------------------------
 template <std::floating_point T>
 std::int32_t _build_from_leaf(
@@ -97,24 +164,9 @@ std::int32_t _build_from_leaf(
   }
   else
   {
-    // Compute bounding box of all bounding boxes
-    std::array b = compute_bbox_of_bboxes<T>(leaf_bboxes);
-
-    // Sort bounding boxes along longest axis
-    std::array<T, 3> b_diff;
-    std::transform(std::next(b.cbegin(), 3), b.cend(), b.cbegin(),
-                   b_diff.begin(), std::minus<T>());
-    const std::size_t axis = std::distance(
-        b_diff.begin(), std::max_element(b_diff.begin(), b_diff.end()));
-
-    auto middle = std::next(leaf_bboxes.begin(), leaf_bboxes.size() / 2);
-    std::nth_element(leaf_bboxes.begin(), middle, leaf_bboxes.end(),
-                     [axis](auto& p0, auto& p1) -> bool
-                     {
-                       auto x0 = p0.first[axis] + p0.first[3 + axis];
-                       auto x1 = p1.first[axis] + p1.first[3 + axis];
-                       return x0 < x1;
-                     });
+    // Compute bounding box of all bounding boxes and sort bounding
+    // boxes along longest axis
+    std::array b = split_leaves<T>(leaf_bboxes);
 
     // Split bounding boxes into two groups and call recursively
     assert(!leaf_bboxes.empty());
@@ -131,14 +183,134 @@ std::int32_t _build_from_leaf(
     return bboxes.size() / 2 - 1;
   }
 }
+//------------------------------------------------------------------------------
+// Build tree from leaves, with the subtrees below a depth of about
+// log2(num_threads) built concurrently on the process thread pool. The
+// tree is the same as the tree built by _build_from_leaf.
+template <std::floating_point T>
+std::int32_t _build_from_leaf_parallel(
+    std::span<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes,
+    std::vector<int>& bboxes, std::vector<T>& bbox_coordinates,
+    int num_threads)
+{
+  // Build small subtrees serially
+  constexpr std::size_t min_size = 1024;
+  auto is_split = [](std::size_t size, int num_threads)
+  { return num_threads >= 2 and size >= min_size; };
+  if (!is_split(leaf_bboxes.size(), num_threads))
+    return _build_from_leaf(leaf_bboxes, bboxes, bbox_coordinates);
+
+  // Part of the leaves, which is either split in two parts (children)
+  // about the midpoint of its bounding box b, or is built serially
+  // into (bboxes, coordinates) with node indices relative to the first
+  // node of the part
+  struct part_t
+  {
+    std::span<std::pair<std::array<T, 6>, std::int32_t>> leaves;
+    int num_threads;
+    std::array<T, 6> b;
+    std::array<std::size_t, 2> children = {0, 0};
+    std::vector<int> bboxes;
+    std::vector<T> coordinates;
+  };
+
+  // Split the parts level by level, with the parts of a level split
+  // concurrently. Children are stored after their parent.
+  std::vector<part_t> parts = {{leaf_bboxes, num_threads}};
+  std::vector<std::size_t> level = {0};
+  while (!level.empty())
+  {
+    common::thread_pool().run(level.size(),
+                              [&parts, &level](int i)
+                              {
+                                part_t& p = parts[level[i]];
+                                p.b = split_leaves<T>(p.leaves);
+                              });
+
+    std::vector<std::size_t> next;
+    for (std::size_t i : level)
+    {
+      auto leaves = parts[i].leaves;
+      const int nt = parts[i].num_threads;
+      const std::size_t part = leaves.size() / 2;
+      parts[i].children = {parts.size(), parts.size() + 1};
+      parts.push_back({leaves.first(part), nt / 2});
+      parts.push_back({leaves.last(leaves.size() - part), nt - nt / 2});
+      for (std::size_t c : parts[i].children)
+      {
+        if (is_split(parts[c].leaves.size(), parts[c].num_threads))
+          next.push_back(c);
+      }
+    }
+    level = std::move(next);
+  }
+
+  // Build the parts that are not split, concurrently
+  std::vector<std::size_t> serial;
+  for (std::size_t i = 0; i < parts.size(); ++i)
+    if (parts[i].children[0] == 0)
+      serial.push_back(i);
+  common::thread_pool().run(serial.size(),
+                            [&parts, &serial](int i)
+                            {
+                              part_t& p = parts[serial[i]];
+                              _build_from_leaf(p.leaves, p.bboxes,
+                                               p.coordinates);
+                            });
+
+  // Append the subtrees of the split parts, in the same order as
+  // _build_from_leaf. Children follow their parent, so the parts are
+  // assembled in reverse order. Indices of leaves (entity indices) are
+  // not offset.
+  for (std::size_t i = parts.size(); i-- > 0;)
+  {
+    part_t& p = parts[i];
+    if (p.children[0] == 0)
+      continue;
+
+    std::vector<int>& out = i == 0 ? bboxes : p.bboxes;
+    std::vector<T>& out_coordinates = i == 0 ? bbox_coordinates : p.coordinates;
+    std::array<std::int32_t, 2> sub_root;
+    for (std::size_t k = 0; k < 2; ++k)
+    {
+      part_t& c = parts[p.children[k]];
+      const std::int32_t offset = out.size() / 2;
+      for (std::size_t j = 0; j < c.bboxes.size(); j += 2)
+      {
+        std::int32_t c0 = c.bboxes[j], c1 = c.bboxes[j + 1];
+        if (c0 != c1)
+        {
+          c0 += offset;
+          c1 += offset;
+        }
+        out.push_back(c0);
+        out.push_back(c1);
+      }
+      out_coordinates.insert(out_coordinates.end(), c.coordinates.begin(),
+                             c.coordinates.end());
+      sub_root[k] = out.size() / 2 - 1;
+      c.bboxes = std::vector<int>();
+      c.coordinates = std::vector<T>();
+    }
+
+    // Store bounding box data. Note that root box will be added last.
+    out.push_back(sub_root[0]);
+    out.push_back(sub_root[1]);
+    std::copy_n(p.b.begin(), 6, std::back_inserter(out_coordinates));
+  }
+
+  return bboxes.size() / 2 - 1;
+}
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
 std::pair<std::vector<std::int32_t>, std::vector<T>> build_from_leaf(
-    std::vector<std::pair<std::array<T, 6>, std::int32_t>>& leaf_bboxes)
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>>& leaf_bboxes,
+    int num_threads = 1)
 {
   std::vector<std::int32_t> bboxes;
   std::vector<T> bbox_coordinates;
-  impl_bb::_build_from_leaf<T>(leaf_bboxes, bboxes, bbox_coordinates);
+  impl_bb::_build_from_leaf_parallel<T>(leaf_bboxes, bboxes, bbox_coordinates,
+                                        num_threads);
   return {std::move(bboxes), std::move(bbox_coordinates)};
 }
 //-----------------------------------------------------------------------------
@@ -165,9 +337,16 @@ _build_from_point(std::span<std::pair<std::array<T, 3>, std::int32_t>> points,
   }
 
   // Compute bounding box of all points
-  auto [min, max] = std::ranges::minmax_element(points);
-  std::array<T, 3> b0 = min->first;
-  std::array<T, 3> b1 = max->first;
+  std::array<T, 3> b0 = points[0].first;
+  std::array<T, 3> b1 = points[0].first;
+  for (auto& [x, _] : points)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      b0[j] = std::min(b0[j], x[j]);
+      b1[j] = std::max(b1[j], x[j]);
+    }
+  }
 
   // Sort bounding boxes along longest axis
   std::array<T, 3> b_diff;
@@ -230,11 +409,14 @@ public:
   /// computed for all local entities (including ghosts) of the given `tdim`.
   /// @param[in] padding Value to pad (extend) the the bounding box of
   /// each entity by.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// bounding boxes of the entities and to build the tree. The tree is
+  /// the same for any number of threads.
   BoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim,
                   std::optional<std::span<const std::int32_t>> entities
                   = std::nullopt,
-                  double padding = 0)
-      : _tdim(tdim)
+                  double padding = 0, int num_threads = 1)
+      : _tdim(tdim), _padding(padding)
   {
     // Initialize entities of given dimension if they don't exist
     mesh.topology_mutable()->create_entities(tdim);
@@ -262,22 +444,23 @@ public:
     mesh.topology_mutable()->create_connectivity(tdim, mesh.topology()->dim());
 
     // Create bounding boxes for all mesh entities (leaves)
-    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes;
-    leaf_bboxes.reserve(entities_span.size());
-    for (std::int32_t e : entities_span)
-    {
-      std::array<T, 6> b = impl_bb::compute_bbox_of_entity(mesh, tdim, e);
-      std::transform(b.cbegin(), std::next(b.cbegin(), 3), b.begin(),
-                     [padding](auto x) { return x - padding; });
-      std::transform(std::next(b.begin(), 3), b.end(), std::next(b.begin(), 3),
-                     [padding](auto x) { return x + padding; });
-      leaf_bboxes.emplace_back(b, e);
-    }
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes(
+        entities_span.size());
+    impl_bb::for_each_block(
+        entities_span.size(), num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          std::span<const std::int32_t> e = entities_span.subspan(i0, i1 - i0);
+          std::vector<std::array<T, 6>> b
+              = impl_bb::compute_bbox_of_entities<T>(mesh, tdim, e, padding);
+          for (std::size_t i = 0; i < e.size(); ++i)
+            leaf_bboxes[i0 + i] = {b[i], e[i]};
+        });
 
     // Recursively build the bounding box tree from the leaves
     if (!leaf_bboxes.empty())
       std::tie(_bboxes, _bbox_coordinates)
-          = impl_bb::build_from_leaf(leaf_bboxes);
+          = impl_bb::build_from_leaf(leaf_bboxes, num_threads);
 
     spdlog::info("Computed bounding box tree with {} nodes for {} entities",
                  num_bboxes(), entities_span.size());
@@ -299,6 +482,23 @@ public:
                  num_bboxes(), points.size());
   }
 
+  /// @brief Create a tree for a set of boxes.
+  /// @param[in] leaf_bboxes Boxes `{x_min, y_min, z_min, x_max, y_max,
+  /// z_max}`, with the index that is returned for a box by searches of
+  /// the tree.
+  /// @param[in] num_threads Number of threads used to build the tree.
+  explicit BoundingBoxTree(
+      std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaf_bboxes,
+      int num_threads = 1)
+      : _tdim(0)
+  {
+    if (!leaf_bboxes.empty())
+    {
+      std::tie(_bboxes, _bbox_coordinates)
+          = impl_bb::build_from_leaf(leaf_bboxes, num_threads);
+    }
+  }
+
   /// Move constructor
   BoundingBoxTree(BoundingBoxTree&& tree) = default;
 
@@ -393,6 +593,75 @@ public:
     return {_bboxes[2 * node], _bboxes[2 * node + 1]};
   }
 
+  /// @brief Update the bounding boxes after the mesh geometry has
+  /// changed.
+  ///
+  /// The bounding boxes of the leaves are recomputed from the mesh
+  /// geometry, and the bounding boxes of the other nodes are updated
+  /// bottom-up. The structure of the tree is unchanged, which is
+  /// cheaper than building a new tree. For large deformations the
+  /// boxes of the nodes can overlap more than in a new tree, which
+  /// makes queries more expensive.
+  ///
+  /// @pre The tree was created for entities of `mesh` and the mesh
+  /// topology has not changed.
+  ///
+  /// @param[in] mesh Mesh that the tree was created for, with changed
+  /// geometry.
+  /// @param[in] num_threads Number of threads used to compute the
+  /// bounding boxes of the leaves.
+  void refit(const mesh::Mesh<T>& mesh, int num_threads = 1)
+  {
+    if (!_padding)
+    {
+      throw std::runtime_error(
+          "Only bounding box trees created for mesh entities can be refit.");
+    }
+
+    // Update leaves
+    const std::int32_t num_nodes = num_bboxes();
+    std::vector<std::int32_t> leaves, entities;
+    for (std::int32_t n = 0; n < num_nodes; ++n)
+    {
+      if (auto [c0, c1] = bbox(n); c0 == c1)
+      {
+        leaves.push_back(n);
+        entities.push_back(c0);
+      }
+    }
+
+    impl_bb::for_each_block(
+        leaves.size(), num_threads,
+        [&](std::size_t i0, std::size_t i1)
+        {
+          std::vector<std::array<T, 6>> b = impl_bb::compute_bbox_of_entities(
+              mesh, _tdim, std::span(entities).subspan(i0, i1 - i0),
+              *_padding);
+          for (std::size_t i = 0; i < b.size(); ++i)
+          {
+            std::ranges::copy(b[i], std::next(_bbox_coordinates.begin(),
+                                              6 * leaves[i0 + i]));
+          }
+        });
+
+    // Update other nodes bottom-up. Children have a lower index than
+    // their parent.
+    for (std::int32_t n = 0; n < num_nodes; ++n)
+    {
+      if (auto [c0, c1] = bbox(n); c0 != c1)
+      {
+        std::span<T, 6> b(_bbox_coordinates.data() + 6 * n, 6);
+        std::span<const T, 6> b0(_bbox_coordinates.data() + 6 * c0, 6);
+        std::span<const T, 6> b1(_bbox_coordinates.data() + 6 * c1, 6);
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+          b[j] = std::min(b0[j], b1[j]);
+          b[j + 3] = std::max(b0[j + 3], b1[j + 3]);
+        }
+      }
+    }
+  }
+
 private:
   // Constructor
   BoundingBoxTree(std::vector<std::int32_t>&& bboxes,
@@ -405,6 +674,10 @@ private:
   // Topological dimension of leaf entities
   int _tdim;
 
+  // Padding of the entity bounding boxes. Only set for trees created
+  // for mesh entities.
+  std::optional<T> _padding;
+
   // Print out recursively, for debugging
   void tree_print(std::stringstream& s, std::int32_t i) const
   {
@@ -0,0 +1,357 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
+#include <mpi.h>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Uniform background grid of axis-aligned bounding boxes.
+///
+/// The bounding box of the boxes is divided into a grid of equally
+/// sized buckets, with about one bucket per box, and each box is
+/// stored in all buckets that it overlaps. Finding the boxes that
+/// contain a point requires a single bucket lookup and a test against
+/// the boxes of the bucket, which for quasi-uniform meshes is cheaper
+/// than the traversal of a BoundingBoxTree. For meshes with strongly
+/// varying cell sizes a bucket can hold many boxes, and
+/// BoundingBoxTree should be preferred.
+///
+/// The bounding boxes are stored with the tolerance that is used for
+/// point queries on BoundingBoxTree already applied, so point queries
+/// return the same entities as for the tree.
+///
+/// @tparam T Geometry type
+template <std::floating_point T>
+class CellGrid
+{
+public:
+  /// @brief Create a grid for a list of bounding boxes.
+  /// @param[in] bboxes Bounding boxes (lower corner, upper corner),
+  /// each with the index of the entity that it bounds.
+  /// @param[in] tdim Topological dimension of the entities.
+  explicit CellGrid(
+      std::span<const std::pair<std::array<T, 6>, std::int32_t>> bboxes,
+      int tdim = 0)
+      : _tdim(tdim)
+  {
+    build(bboxes);
+  }
+
+  /// @brief Create a grid for the bounding boxes of mesh entities.
+  ///
+  /// See BoundingBoxTree(const mesh::Mesh<T>&, int,
+  /// std::optional<std::span<const std::int32_t>>, double, int).
+  ///
+  /// @param[in] mesh Mesh for building the grid.
+  /// @param[in] tdim Topological dimension of the mesh entities.
+  /// @param[in] entities Entity indices (local to process). If
+  /// `std::nullopt`, all local entities (including ghosts) are used.
+  /// @param[in] padding Value to pad (extend) the bounding box of each
+  /// entity by.
+  CellGrid(const mesh::Mesh<T>& mesh, int tdim,
+           std::optional<std::span<const std::int32_t>> entities
+           = std::nullopt,
+           double padding = 0)
+      : _tdim(tdim)
+  {
+    if (tdim < 0 or tdim > mesh.topology()->dim())
+    {
+      throw std::runtime_error(
+          "Dimension must be non-negative and less than or "
+          "equal to the topological dimension of the mesh");
+    }
+
+    mesh.topology_mutable()->create_entities(tdim);
+    mesh.topology_mutable()->create_connectivity(tdim, mesh.topology()->dim());
+
+    std::vector<std::int32_t> range;
+    if (!entities)
+    {
+      auto map = mesh.topology()->index_map(tdim);
+      assert(map);
+      range.resize(map->size_local() + map->num_ghosts());
+      std::iota(range.begin(), range.end(), 0);
+      entities = std::span<const std::int32_t>(range);
+    }
+
+    std::vector<std::array<T, 6>> b = impl_bb::compute_bbox_of_entities<T>(
+        mesh, tdim, *entities, padding);
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> bboxes(b.size());
+    for (std::size_t i = 0; i < b.size(); ++i)
+      bboxes[i] = {b[i], (*entities)[i]};
+    build(bboxes);
+
+    spdlog::info("Computed cell grid with {}x{}x{} buckets for {} entities",
+                 _shape[0], _shape[1], _shape[2], b.size());
+  }
+
+  /// @brief Create a grid of the bounding boxes of the grids on all
+  /// processes (collective).
+  ///
+  /// This can be used to find the processes that a point might collide
+  /// with, see BoundingBoxTree::create_global_tree. The entity of a box
+  /// is the rank of the process. Processes with an empty grid have no
+  /// box.
+  ///
+  /// @param[in] comm MPI communicator for collective communication.
+  /// @return Grid where each box represents a process.
+  CellGrid create_global_grid(MPI_Comm comm) const
+  {
+    constexpr T max = std::numeric_limits<T>::max();
+    std::array<T, 6> send_bbox = {max, max, max, -max, -max, -max};
+    if (num_entities() > 0)
+      send_bbox = _domain;
+
+    const int size = dolfinx::MPI::size(comm);
+    std::vector<T> recv_bbox(6 * size);
+    MPI_Allgather(send_bbox.data(), 6, dolfinx::MPI::mpi_t<T>,
+                  recv_bbox.data(), 6, dolfinx::MPI::mpi_t<T>, comm);
+
+    std::vector<std::pair<std::array<T, 6>, std::int32_t>> bboxes;
+    for (int r = 0; r < size; ++r)
+    {
+      std::array<T, 6> b;
+      std::copy_n(std::next(recv_bbox.begin(), 6 * r), 6, b.begin());
+      if (b[0] <= b[3])
+        bboxes.push_back({b, r});
+    }
+
+    return CellGrid(bboxes, _tdim);
+  }
+
+  /// Number of entities (boxes) in the grid
+  std::int32_t num_entities() const { return _entities.size(); }
+
+  /// Topological dimension of the entities
+  int tdim() const { return _tdim; }
+
+  /// Number of buckets in each direction
+  std::array<std::int32_t, 3> shape() const { return _shape; }
+
+  /// @brief Bucket that contains a point.
+  /// @param[in] x The point.
+  /// @return Index of the bucket, or -1 if the point is outside of the
+  /// grid.
+  std::int32_t bucket(std::span<const T, 3> x) const
+  {
+    if (_entities.empty())
+      return -1;
+
+    std::array<std::int32_t, 3> idx;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      if (x[j] < _x0[j] or x[j] > _x1[j])
+        return -1;
+      idx[j] = index(j, x[j]);
+    }
+
+    return (idx[2] * _shape[1] + idx[1]) * _shape[0] + idx[0];
+  }
+
+  /// @brief Boxes that overlap a bucket.
+  /// @param[in] bucket Bucket index.
+  /// @return Positions of the boxes in the list that the grid was
+  /// created from, in ascending order.
+  std::span<const std::int32_t> boxes(std::int32_t bucket) const
+  {
+    return std::span(_boxes.data() + _offsets[bucket],
+                     _offsets[bucket + 1] - _offsets[bucket]);
+  }
+
+  /// @brief Bounding box of a box, including the point query tolerance.
+  /// @param[in] i Position of the box.
+  /// @return Bounding box (lower corner, upper corner).
+  std::span<const T, 6> get_bbox(std::int32_t i) const
+  {
+    return std::span<const T, 6>(_bboxes.data() + 6 * i, 6);
+  }
+
+  /// @brief Index of the entity that a box bounds.
+  /// @param[in] i Position of the box.
+  std::int32_t entity(std::int32_t i) const { return _entities[i]; }
+
+private:
+  // Bucket index in direction j of a coordinate inside the grid
+  std::int32_t index(std::size_t j, T x) const
+  {
+    auto i = static_cast<std::int32_t>((x - _x0[j]) * _scale[j]);
+    return std::clamp(i, 0, _shape[j] - 1);
+  }
+
+  void build(std::span<const std::pair<std::array<T, 6>, std::int32_t>> bboxes)
+  {
+    const std::size_t n = bboxes.size();
+    _offsets.assign(1, 0);
+    if (n == 0)
+      return;
+
+    // Store boxes, with the tolerance used by point queries on
+    // BoundingBoxTree applied
+    constexpr T rtol = 1e-14;
+    constexpr T max = std::numeric_limits<T>::max();
+    _bboxes.resize(6 * n);
+    _entities.resize(n);
+    _domain = {max, max, max, -max, -max, -max};
+    _x0 = {max, max, max};
+    _x1 = {-max, -max, -max};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      auto& [b, e] = bboxes[i];
+      _entities[i] = e;
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        T eps = rtol * (b[j + 3] - b[j]);
+        _bboxes[6 * i + j] = b[j] - eps;
+        _bboxes[6 * i + j + 3] = b[j + 3] + eps;
+        _domain[j] = std::min(_domain[j], b[j]);
+        _domain[j + 3] = std::max(_domain[j + 3], b[j + 3]);
+        _x0[j] = std::min(_x0[j], _bboxes[6 * i + j]);
+        _x1[j] = std::max(_x1[j], _bboxes[6 * i + j + 3]);
+      }
+    }
+
+    // Choose cubic buckets with about one box per bucket, over the
+    // directions in which the grid has a non-zero extent
+    std::array<T, 3> L;
+    std::ranges::transform(_x1, _x0, L.begin(), std::minus<T>());
+    const T Lmax = std::ranges::max(L);
+    double volume = 1;
+    int dim = 0;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      if (L[j] > rtol * Lmax)
+      {
+        volume *= L[j];
+        ++dim;
+      }
+    }
+    const double h = dim > 0 ? std::pow(volume / n, 1.0 / dim) : 0;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      _shape[j] = 1;
+      _scale[j] = 0;
+      if (L[j] > rtol * Lmax)
+      {
+        _shape[j] = static_cast<std::int32_t>(
+            std::clamp<double>(std::ceil(L[j] / h), 1, n));
+        _scale[j] = _shape[j] / L[j];
+      }
+    }
+
+    // Range of buckets overlapped by each box
+    auto range = [this](std::size_t i)
+    {
+      std::array<std::int32_t, 6> r;
+      for (std::size_t j = 0; j < 3; ++j)
+      {
+        r[j] = index(j, _bboxes[6 * i + j]);
+        r[j + 3] = index(j, _bboxes[6 * i + j + 3]);
+      }
+      return r;
+    };
+    auto for_each_bucket = [this](const std::array<std::int32_t, 6>& r,
+                                  auto&& fn)
+    {
+      for (std::int32_t k = r[2]; k <= r[5]; ++k)
+        for (std::int32_t j = r[1]; j <= r[4]; ++j)
+          for (std::int32_t i = r[0]; i <= r[3]; ++i)
+            fn((k * _shape[1] + j) * _shape[0] + i);
+    };
+
+    // Count the boxes of each bucket, and then fill the buckets
+    _offsets.assign(_shape[0] * _shape[1] * _shape[2] + 1, 0);
+    for (std::size_t i = 0; i < n; ++i)
+      for_each_bucket(range(i), [this](auto b) { ++_offsets[b + 1]; });
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+    _boxes.resize(_offsets.back());
+    std::vector<std::int32_t> pos(_offsets.begin(), std::prev(_offsets.end()));
+    for (std::size_t i = 0; i < n; ++i)
+      for_each_bucket(range(i), [&](auto b) { _boxes[pos[b]++] = i; });
+  }
+
+  // Topological dimension of the entities
+  int _tdim;
+
+  // Entity of each box
+  std::vector<std::int32_t> _entities;
+
+  // Bounding boxes, with tolerance, shape (num_entities, 6)
+  std::vector<T> _bboxes;
+
+  // Bounding box of the (input) boxes
+  std::array<T, 6> _domain = {};
+
+  // Lower and upper corner of the grid, and number of buckets per unit
+  // length in each direction
+  std::array<T, 3> _x0 = {}, _x1 = {}, _scale = {};
+
+  // Number of buckets in each direction
+  std::array<std::int32_t, 3> _shape = {0, 0, 0};
+
+  // Boxes of each bucket
+  std::vector<std::int32_t> _offsets, _boxes;
+};
+
+/// @brief Compute collisions between points and the boxes of a grid.
+///
+/// The result is the same as for compute_collisions(const
+/// BoundingBoxTree<T>&, std::span<const T>) with a tree created for the
+/// same entities, except for the order of the entities of a point. Use
+/// geometry::compute_colliding_cells for exact tests against the
+/// cells.
+///
+/// @param[in] grid The grid
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @return For each point, the entities whose bounding boxes collide
+/// with the point, in the order of the boxes in the grid.
+template <std::floating_point T>
+graph::AdjacencyList<std::int32_t>
+compute_collisions(const CellGrid<T>& grid, std::span<const T> points)
+{
+  const std::size_t num_points = points.size() / 3;
+  std::vector<std::int32_t> entities, offsets(num_points + 1, 0);
+  entities.reserve(num_points);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    std::span<const T, 3> x(points.data() + 3 * p, 3);
+    if (std::int32_t bucket = grid.bucket(x); bucket >= 0)
+    {
+      for (std::int32_t i : grid.boxes(bucket))
+      {
+        std::span<const T, 6> b = grid.get_bbox(i);
+        if ((x[0] >= b[0]) & (x[1] >= b[1]) & (x[2] >= b[2]) & (x[0] <= b[3])
+            & (x[1] <= b[4]) & (x[2] <= b[5]))
+        {
+          entities.push_back(grid.entity(i));
+        }
+      }
+    }
+
+    offsets[p + 1] = entities.size();
+  }
+
+  return graph::AdjacencyList(std::move(entities), std::move(offsets));
+}
+
+} // namespace dolfinx::geometry
@@ -0,0 +1,529 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Location of points that move by small amounts between
+/// updates, by walking through the mesh from the cells found in the
+/// previous update.
+///
+/// For each point, the search starts at the cell that contained the
+/// point in the previous update, on the process that owns the cell. On
+/// meshes with affine simplex cells, the search steps from a cell to
+/// the neighbour across the facet opposite the vertex with the most
+/// negative barycentric coordinate of the point, until the cell that
+/// contains the point is reached. A point that moves by less than a
+/// cell size is found in a few steps, rather than by a search of the
+/// bounding box trees. If the walk reaches a facet on the boundary of
+/// the local part of the mesh, or a ghost cell, the point is handed to
+/// the process on the other side, which continues the walk. On other
+/// meshes, the previous cell is tested before the trees are searched.
+///
+/// Points without a previous cell, and points for which the walk fails
+/// (e.g. at the boundary of a non-convex domain), are located with the
+/// bounding box tree of the owned cells on the process of the walk, and
+/// then by determine_point_ownership().
+///
+/// The ownership data after an update has the same layout as the data
+/// computed by determine_point_ownership() (see PointOwnership). Points
+/// on a facet shared by cells on different processes may be assigned
+/// to a different owner.
+///
+/// @tparam T Mesh geometry floating type.
+template <std::floating_point T>
+class PointLocator
+{
+public:
+  /// @brief Create a point locator for a mesh, with no points.
+  ///
+  /// The facets of the mesh, and the facet-to-cell and cell-to-facet
+  /// connectivities, are created if they do not exist.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] mesh The mesh. The mesh geometry must not change after
+  /// the object has been created.
+  /// @param[in] padding Amount of absolute padding of bounding boxes of
+  /// the mesh, see determine_point_ownership().
+  /// @param[in] max_steps Maximum number of cells a walk visits on one
+  /// process before the point is located with the bounding box trees.
+  /// @param[in] max_handoffs Maximum number of times a walk is handed
+  /// to another process before the point is located with the bounding
+  /// box trees.
+  PointLocator(std::shared_ptr<const mesh::Mesh<T>> mesh, T padding = 0,
+               int max_steps = 256, int max_handoffs = 8)
+      : _mesh(mesh), _tree(*mesh, mesh->topology()->dim(),
+                           owned_cells(*mesh), padding),
+        _global_tree(_tree.create_global_tree(mesh->comm())),
+        _max_steps(max_steps), _max_handoffs(max_handoffs)
+  {
+    const int tdim = mesh->topology()->dim();
+    mesh->topology_mutable()->create_entities(tdim - 1);
+    mesh->topology_mutable()->create_connectivity(tdim - 1, tdim);
+    mesh->topology_mutable()->create_connectivity(tdim, tdim - 1);
+
+    // Process on the other side of each facet on the boundary of the
+    // local part of the mesh
+    auto f_to_c = mesh->topology()->connectivity(tdim - 1, tdim);
+    auto facet_map = mesh->topology()->index_map(tdim - 1);
+    const std::int32_t num_owned = facet_map->size_local();
+    _facet_ranks.assign(num_owned + facet_map->num_ghosts(), -1);
+    const graph::AdjacencyList<int> dest = facet_map->index_to_dest_ranks();
+    for (std::size_t f = 0; f < _facet_ranks.size(); ++f)
+    {
+      if (f_to_c->num_links(f) != 1)
+        continue;
+      if (std::int32_t(f) >= num_owned)
+        _facet_ranks[f] = facet_map->owners()[f - num_owned];
+      else if (!dest.links(f).empty())
+        _facet_ranks[f] = dest.links(f).front();
+    }
+  }
+
+  /// @brief Locate a new set of points.
+  ///
+  /// The walk for point `i` starts from the cell that contained point
+  /// `i` in the previous update. If the number of points changes, all
+  /// points are located with the bounding box trees.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] points Points to locate (`shape=(num_points, 3)`).
+  /// Storage is row-major.
+  /// @return Point ownership data, see determine_point_ownership().
+  const PointOwnershipData<T>& update(std::span<const T> points)
+  {
+    MPI_Comm comm = _mesh->comm();
+    const int rank = dolfinx::MPI::rank(comm);
+    const int tdim = _mesh->topology()->dim();
+    auto cell_map = _mesh->topology()->index_map(tdim);
+    const std::int64_t cell_offset = cell_map->local_range()[0];
+
+    const std::size_t num_points = points.size() / 3;
+    if (num_points != _seeds.size())
+      _seeds.assign(num_points, {-1, -1});
+
+    // Send points with a previous owner to the owner, starting from the
+    // previous cell
+    std::vector<std::int32_t> unknown;
+    std::vector<std::pair<int, Item>> send;
+    for (std::size_t i = 0; i < num_points; ++i)
+    {
+      auto [r, c] = _seeds[i];
+      if (r < 0)
+        unknown.push_back(i);
+      else
+      {
+        Item item{{points[3 * i], points[3 * i + 1], points[3 * i + 2]},
+                  rank, std::int32_t(i), c, 0};
+        send.push_back({r, item});
+      }
+    }
+    std::vector<Item> work = exchange(comm, send).second;
+
+    // Walk, handing points that leave the local part of the mesh to the
+    // process on the other side
+    std::vector<Item> located;
+    std::vector<std::pair<int, Result>> results;
+    for (int round = 0; round <= _max_handoffs; ++round)
+    {
+      std::vector<std::pair<int, Item>> handoff;
+      for (const Item& item : work)
+      {
+        auto [status, index] = walk(item);
+        if (status == Status::found)
+        {
+          located.push_back(item);
+          located.back().start = index;
+          results.push_back({item.src, {item.index, index + cell_offset}});
+        }
+        else if (status == Status::ghost and round < _max_handoffs)
+        {
+          std::size_t g = index - cell_map->size_local();
+          Item next = item;
+          next.start = cell_map->ghosts()[g];
+          next.kind = 0;
+          handoff.push_back({cell_map->owners()[g], next});
+        }
+        else if (status == Status::exit and round < _max_handoffs)
+        {
+          Item next = item;
+          std::int32_t f = index;
+          _mesh->topology()->index_map(tdim - 1)->local_to_global(
+              std::span(&f, 1), std::span(&next.start, 1));
+          next.kind = 1;
+          handoff.push_back({_facet_ranks[index], next});
+        }
+        else
+          results.push_back({item.src, {item.index, -1}});
+      }
+
+      std::int64_t num_handoff = handoff.size();
+      MPI_Allreduce(MPI_IN_PLACE, &num_handoff, 1, MPI_INT64_T, MPI_SUM,
+                    comm);
+      if (num_handoff == 0)
+        break;
+      work = exchange(comm, handoff).second;
+    }
+
+    // Return the owning process and cell of each located point to the
+    // process of the point
+    std::vector<int> src_owner(num_points, -1);
+    {
+      auto [owners, recv] = exchange(comm, results);
+      for (std::size_t k = 0; k < recv.size(); ++k)
+      {
+        auto [i, cell] = recv[k];
+        if (cell >= 0)
+        {
+          src_owner[i] = owners[k];
+          _seeds[i] = {owners[k], cell};
+        }
+        else
+          unknown.push_back(i);
+      }
+    }
+    std::ranges::sort(unknown);
+    _num_searched = unknown.size();
+
+    // Locate the remaining points with the bounding box trees
+    std::vector<T> unknown_points(3 * unknown.size());
+    for (std::size_t k = 0; k < unknown.size(); ++k)
+    {
+      std::copy_n(std::next(points.begin(), 3 * unknown[k]), 3,
+                  std::next(unknown_points.begin(), 3 * k));
+    }
+    PointOwnershipData<T> data = determine_point_ownership<T>(
+        *_mesh, unknown_points, _tree, _global_tree);
+
+    // Send the indices of the points located by the trees to their
+    // owners, in the order of the points on each process. The owner
+    // cell is not known to the process of the point, so the next walk
+    // on the owner starts from the trees.
+    std::vector<std::pair<int, std::int32_t>> owned_indices;
+    for (std::size_t k = 0; k < unknown.size(); ++k)
+    {
+      std::int32_t i = unknown[k];
+      src_owner[i] = data.src_owner[k];
+      _seeds[i] = {data.src_owner[k], -1};
+      if (data.src_owner[k] >= 0)
+        owned_indices.push_back({data.src_owner[k], i});
+    }
+    auto [index_src, indices] = exchange(comm, owned_indices);
+    std::map<int, std::vector<std::int32_t>> src_indices;
+    for (std::size_t k = 0; k < indices.size(); ++k)
+      src_indices[index_src[k]].push_back(indices[k]);
+
+    // Ownership data, sorted by source process and index on the source
+    std::vector<std::tuple<int, std::int32_t, std::array<T, 3>, std::int32_t>>
+        entries;
+    for (const Item& item : located)
+      entries.push_back(
+          {item.src, item.index, item.x, std::int32_t(item.start)});
+    std::map<int, std::size_t> pos;
+    for (std::size_t k = 0; k < data.dest_owners.size(); ++k)
+    {
+      int src = data.dest_owners[k];
+      std::array<T, 3> x;
+      std::copy_n(std::next(data.dest_points.begin(), 3 * k), 3, x.begin());
+      entries.push_back(
+          {src, src_indices.at(src).at(pos[src]++), x, data.dest_cells[k]});
+    }
+    std::ranges::sort(entries);
+
+    _data.src_owner = std::move(src_owner);
+    _data.dest_owners.resize(entries.size());
+    _data.dest_points.resize(3 * entries.size());
+    _data.dest_cells.resize(entries.size());
+    _dest_indices.resize(entries.size());
+    for (std::size_t k = 0; k < entries.size(); ++k)
+    {
+      auto& [src, idx, x, cell] = entries[k];
+      _data.dest_owners[k] = src;
+      _dest_indices[k] = idx;
+      std::ranges::copy(x, std::next(_data.dest_points.begin(), 3 * k));
+      _data.dest_cells[k] = cell;
+    }
+
+    return _data;
+  }
+
+  /// @brief Point ownership data from the most recent update.
+  const PointOwnershipData<T>& data() const { return _data; }
+
+  /// @brief Index of each point in PointOwnershipData::dest_points in
+  /// the list of points on the process that sent it.
+  std::span<const std::int32_t> dest_indices() const
+  {
+    return _dest_indices;
+  }
+
+  /// @brief Number of points on this process that were not located by
+  /// a walk in the most recent update, and were located with the
+  /// global bounding box tree.
+  std::int32_t num_searched() const { return _num_searched; }
+
+private:
+  // A point to locate, with the process and index of the point on the
+  // process that sent it, and the entity to start from. The start is
+  // a global cell index (kind 0, -1 if not known) or a global facet
+  // index (kind 1).
+  struct Item
+  {
+    std::array<T, 3> x;
+    int src;
+    std::int32_t index;
+    std::int64_t start;
+    std::int8_t kind;
+  };
+
+  // Index of a point on the process that sent it, and the global index
+  // of the containing cell (-1 if not found)
+  struct Result
+  {
+    std::int32_t index;
+    std::int64_t cell;
+  };
+
+  // Outcome of a walk
+  enum class Status : std::int8_t
+  {
+    found, // Point is in an owned cell
+    ghost, // Point is in a ghost cell
+    exit,  // Walk left the local part of the mesh through a facet
+    fail   // Point was not found
+  };
+
+  // Owned cells of a mesh
+  static std::vector<std::int32_t> owned_cells(const mesh::Mesh<T>& mesh)
+  {
+    const int tdim = mesh.topology()->dim();
+    std::vector<std::int32_t> cells(
+        mesh.topology()->index_map(tdim)->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+    return cells;
+  }
+
+  // Send data to processes. Returns the received data and the process
+  // that sent each entry. Received data is ordered by the sending
+  // process, and in the order it was sent.
+  template <typename V>
+  static std::pair<std::vector<int>, std::vector<V>>
+  exchange(MPI_Comm comm, std::vector<std::pair<int, V>> data)
+  {
+    std::ranges::stable_sort(data, std::less<>(),
+                             [](auto& d) { return d.first; });
+    std::vector<int> dest;
+    std::vector<int> send_sizes;
+    for (auto& d : data)
+    {
+      if (dest.empty() or dest.back() != d.first)
+      {
+        dest.push_back(d.first);
+        send_sizes.push_back(0);
+      }
+      send_sizes.back() += sizeof(V);
+    }
+    std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
+    std::ranges::sort(src);
+
+    MPI_Comm neigh_comm;
+    MPI_Dist_graph_create_adjacent(
+        comm, src.size(), src.data(), MPI_UNWEIGHTED, dest.size(),
+        dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm);
+
+    std::vector<int> recv_sizes(src.size());
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+    MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                          MPI_INT, neigh_comm);
+
+    std::vector<int> send_offsets(dest.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_offsets.begin()));
+    std::vector<int> recv_offsets(src.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_offsets.begin()));
+
+    std::vector<V> send_buffer;
+    send_buffer.reserve(data.size());
+    for (auto& d : data)
+      send_buffer.push_back(d.second);
+    std::vector<V> recv_buffer(recv_offsets.back() / sizeof(V));
+    MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                           send_offsets.data(), MPI_BYTE, recv_buffer.data(),
+                           recv_sizes.data(), recv_offsets.data(), MPI_BYTE,
+                           neigh_comm);
+    MPI_Comm_free(&neigh_comm);
+
+    std::vector<int> recv_src(recv_buffer.size());
+    for (std::size_t i = 0; i < src.size(); ++i)
+    {
+      std::fill(std::next(recv_src.begin(), recv_offsets[i] / sizeof(V)),
+                std::next(recv_src.begin(), recv_offsets[i + 1] / sizeof(V)),
+                src[i]);
+    }
+
+    return {std::move(recv_src), std::move(recv_buffer)};
+  }
+
+  // First owned cell that contains a point, found with the bounding box
+  // tree of the owned cells
+  std::int32_t search(const std::array<T, 3>& x) const
+  {
+    graph::AdjacencyList<std::int32_t> candidates
+        = compute_collisions<T>(_tree, std::span<const T>(x));
+    return compute_first_colliding_cell(*_mesh, candidates.links(0), x,
+                                        10 * std::numeric_limits<T>::epsilon());
+  }
+
+  // Walk from the start of an item to the cell that contains the point.
+  // Returns the outcome and the local index of the cell (found, ghost)
+  // or facet (exit).
+  std::pair<Status, std::int32_t> walk(const Item& item) const
+  {
+    const mesh::Topology& topology = *_mesh->topology();
+    const int tdim = topology.dim();
+    auto cell_map = topology.index_map(tdim);
+    const std::int32_t num_owned = cell_map->size_local();
+
+    // Local start cell, if known
+    std::int32_t c = -1;
+    if (item.kind == 0 and item.start >= 0)
+      c = item.start - cell_map->local_range()[0];
+    else if (item.kind == 1)
+    {
+      std::int32_t f;
+      topology.index_map(tdim - 1)->global_to_local(
+          std::span(&item.start, 1), std::span(&f, 1));
+      if (f >= 0)
+        c = topology.connectivity(tdim - 1, tdim)->links(f).front();
+    }
+
+    auto found = [num_owned](std::int32_t c)
+    {
+      return std::pair(c < num_owned ? Status::found : Status::ghost, c);
+    };
+    auto search_owned = [this, &item]()
+    {
+      std::int32_t c = search(item.x);
+      return std::pair(c >= 0 ? Status::found : Status::fail, c);
+    };
+
+    if (c < 0)
+      return search_owned();
+
+    const mesh::Geometry<T>& geometry = _mesh->geometry();
+    if (!geometry.cmap().is_affine())
+    {
+      // Test the start cell only
+      if (compute_first_colliding_cell(
+              *_mesh, std::span(&c, 1), item.x,
+              10 * std::numeric_limits<T>::epsilon())
+          == c)
+      {
+        return found(c);
+      }
+      else
+        return search_owned();
+    }
+
+    // Walk across the facet opposite the vertex with the most negative
+    // barycentric coordinate. Facet i of a simplex is opposite vertex i.
+    auto x_dofmap = geometry.dofmap();
+    mesh::NodeCoordinates<T> x = geometry.coordinates();
+    auto c_to_f = topology.connectivity(tdim, tdim - 1);
+    auto f_to_c = topology.connectivity(tdim - 1, tdim);
+    const T tol = -1000 * std::numeric_limits<T>::epsilon();
+    std::array<T, 12> v;
+    std::array<T, 4> lambda;
+    std::array<T, 3> X;
+    for (int step = 0; step < _max_steps; ++step)
+    {
+      auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+          x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+      x.copy(dofs, v.data());
+      pull_back_affine_simplex<T>(std::span<const T, 3>(item.x),
+                                  std::span<const T>(v.data(), 3 * (tdim + 1)),
+                                  std::span<T>(X.data(), tdim), 0);
+      lambda[0] = 1;
+      for (int i = 0; i < tdim; ++i)
+      {
+        lambda[i + 1] = X[i];
+        lambda[0] -= X[i];
+      }
+
+      auto it = std::min_element(lambda.begin(),
+                                 std::next(lambda.begin(), tdim + 1));
+      if (*it >= tol)
+        return found(c);
+
+      std::int32_t f = c_to_f->links(c)[std::distance(lambda.begin(), it)];
+      auto cells = f_to_c->links(f);
+      if (cells.size() == 2)
+        c = cells[0] == c ? cells[1] : cells[0];
+      else if (_facet_ranks[f] >= 0)
+        return {Status::exit, f};
+      else
+        return search_owned();
+    }
+
+    return search_owned();
+  }
+
+  // The mesh
+  std::shared_ptr<const mesh::Mesh<T>> _mesh;
+
+  // Bounding box tree of the owned cells, and the global tree
+  BoundingBoxTree<T> _tree, _global_tree;
+
+  // Maximum number of walk steps on a process, and of handoffs
+  int _max_steps, _max_handoffs;
+
+  // Process on the other side of each facet on the boundary of the
+  // local part of the mesh (-1 for other facets)
+  std::vector<int> _facet_ranks;
+
+  // Owning process and global index of the cell of each point in the
+  // most recent update. The cell is -1 if it is not known, and the
+  // process is -1 if the point was not found.
+  std::vector<std::pair<int, std::int64_t>> _seeds;
+
+  // Ownership data
+  PointOwnershipData<T> _data;
+
+  // Index of each destination point on the source process
+  std::vector<std::int32_t> _dest_indices;
+
+  // Number of points located with the global tree in the most recent
+  // update
+  std::int32_t _num_searched = 0;
+};
+
+} // namespace dolfinx::geometry
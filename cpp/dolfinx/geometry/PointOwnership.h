@@ -0,0 +1,301 @@
+// Copyright (C) 2024 Jørgen S. Dokken and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Point ownership for a set of points that changes between
+/// updates.
+///
+/// The bounding box trees of the mesh, including the global tree, are
+/// created once, and the ownership of the points is stored between
+/// calls to update(). Only points that have moved since the previous
+/// update are sent to candidate processes to determine their owner.
+/// The owners of points that have not moved are not recomputed. This
+/// is cheaper than calling determine_point_ownership() when a small
+/// fraction of the points move, e.g. when tracking particles, and
+/// avoids creating the global bounding box tree for repeated calls.
+///
+/// The ownership data after an update is the same as the ownership
+/// data computed by determine_point_ownership() for all points.
+///
+/// @tparam T Mesh geometry floating type.
+template <std::floating_point T>
+class PointOwnership
+{
+public:
+  /// @brief Create point ownership data for a mesh, with no points.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] mesh The mesh. The mesh geometry must not change
+  /// after the object has been created.
+  /// @param[in] padding Amount of absolute padding of bounding boxes of
+  /// the mesh, see determine_point_ownership().
+  PointOwnership(std::shared_ptr<const mesh::Mesh<T>> mesh, T padding)
+      : _mesh(mesh), _tree(*mesh, mesh->topology()->dim(),
+                           owned_cells(*mesh), padding),
+        _global_tree(_tree.create_global_tree(mesh->comm()))
+  {
+  }
+
+  /// @brief Update the ownership data for a new set of points.
+  ///
+  /// Points that are unchanged since the previous call keep their
+  /// owner. If the number of points changes, the ownership of all
+  /// points is recomputed.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] points Points to check for collision (`shape=(num_points,
+  /// 3)`). Storage is row-major.
+  /// @return Point ownership data, see determine_point_ownership().
+  const PointOwnershipData<T>& update(std::span<const T> points)
+  {
+    MPI_Comm comm = _mesh->comm();
+    const std::size_t num_points = points.size() / 3;
+    const std::size_t num_points_old = _points.size() / 3;
+
+    // Points that have moved, and old points that are no longer owned
+    // by their previous owner
+    std::vector<std::int32_t> moved, removed;
+    if (num_points == num_points_old)
+    {
+      for (std::size_t i = 0; i < num_points; ++i)
+      {
+        if (!std::equal(std::next(points.begin(), 3 * i),
+                        std::next(points.begin(), 3 * (i + 1)),
+                        std::next(_points.begin(), 3 * i)))
+        {
+          moved.push_back(i);
+          if (_data.src_owner[i] >= 0)
+            removed.push_back(i);
+        }
+      }
+    }
+    else
+    {
+      moved.resize(num_points);
+      std::iota(moved.begin(), moved.end(), 0);
+      for (std::size_t i = 0; i < num_points_old; ++i)
+      {
+        if (_data.src_owner[i] >= 0)
+          removed.push_back(i);
+      }
+    }
+
+    _num_updated = moved.size();
+    _points.assign(points.begin(), points.end());
+
+    // Return early if no points have moved on any process
+    std::int64_t num_changed = moved.size() + removed.size();
+    MPI_Allreduce(MPI_IN_PLACE, &num_changed, 1, MPI_INT64_T, MPI_SUM, comm);
+    if (num_changed == 0)
+    {
+      _data.src_owner.resize(num_points);
+      return _data;
+    }
+
+    // Determine owners of the moved points
+    std::vector<T> moved_points(3 * moved.size());
+    for (std::size_t i = 0; i < moved.size(); ++i)
+    {
+      std::copy_n(std::next(points.begin(), 3 * moved[i]), 3,
+                  std::next(moved_points.begin(), 3 * i));
+    }
+    PointOwnershipData<T> data = determine_point_ownership<T>(
+        *_mesh, moved_points, _tree, _global_tree);
+
+    // Ranks to notify of removed (old owners) and added (new owners)
+    // points, with removed point indices and added point indices to
+    // send to each rank. Indices are ascending for each rank.
+    std::vector<std::array<std::int32_t, 3>> notices;
+    notices.reserve(removed.size() + moved.size());
+    for (std::int32_t i : removed)
+      notices.push_back({_data.src_owner[i], 0, i});
+    for (std::size_t i = 0; i < moved.size(); ++i)
+    {
+      if (int owner = data.src_owner[i]; owner >= 0)
+        notices.push_back({owner, 1, moved[i]});
+    }
+    std::ranges::sort(notices);
+
+    std::vector<int> dest;
+    for (auto& n : notices)
+    {
+      if (dest.empty() or dest.back() != n[0])
+        dest.push_back(n[0]);
+    }
+    std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
+    std::ranges::sort(src);
+
+    // Pack number of removed points, followed by removed and added
+    // point indices, for each destination rank
+    std::vector<std::int32_t> send_sizes(dest.size(), 0);
+    std::vector<std::int32_t> send_buffer;
+    send_buffer.reserve(notices.size() + dest.size());
+    for (auto it = notices.begin(); it != notices.end();)
+    {
+      auto it1 = std::find_if(it, notices.end(),
+                              [r = (*it)[0]](auto& n) { return n[0] != r; });
+      auto itr = std::find_if(it, it1, [](auto& n) { return n[1] == 1; });
+      send_buffer.push_back(std::distance(it, itr));
+      std::transform(it, it1, std::back_inserter(send_buffer),
+                     [](auto& n) { return n[2]; });
+      std::size_t d = std::distance(
+          dest.begin(), std::ranges::lower_bound(dest, (*it)[0]));
+      send_sizes[d] = std::distance(it, it1) + 1;
+      it = it1;
+    }
+
+    MPI_Comm neigh_comm;
+    MPI_Dist_graph_create_adjacent(
+        comm, src.size(), src.data(), MPI_UNWEIGHTED, dest.size(),
+        dest.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &neigh_comm);
+
+    std::vector<std::int32_t> recv_sizes(src.size());
+    send_sizes.reserve(1);
+    recv_sizes.reserve(1);
+    MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T,
+                          recv_sizes.data(), 1, MPI_INT32_T, neigh_comm);
+
+    std::vector<std::int32_t> send_offsets(dest.size() + 1, 0);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     std::next(send_offsets.begin()));
+    std::vector<std::int32_t> recv_offsets(src.size() + 1, 0);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     std::next(recv_offsets.begin()));
+    std::vector<std::int32_t> recv_buffer(recv_offsets.back());
+    MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                           send_offsets.data(), MPI_INT32_T,
+                           recv_buffer.data(), recv_sizes.data(),
+                           recv_offsets.data(), MPI_INT32_T, neigh_comm);
+    MPI_Comm_free(&neigh_comm);
+
+    // Owned points as (source rank, index on source rank) and position
+    // in the ownership data, with points that have been removed
+    // dropped and moved points added
+    std::vector<std::pair<int, std::int32_t>> removed_keys;
+    std::vector<std::array<std::int32_t, 4>> entries;
+    std::size_t pos_new = 0;
+    for (std::size_t i = 0; i < src.size(); ++i)
+    {
+      std::span<const std::int32_t> buffer(
+          recv_buffer.data() + recv_offsets[i],
+          recv_offsets[i + 1] - recv_offsets[i]);
+      std::int32_t num_removed = buffer.front();
+      for (std::int32_t idx : buffer.subspan(1, num_removed))
+        removed_keys.push_back({src[i], idx});
+
+      // Moved points owned by this process from src[i], in the same
+      // order as in the ownership data
+      for (std::int32_t idx : buffer.subspan(1 + num_removed))
+      {
+        while (data.dest_owners[pos_new] != src[i])
+          ++pos_new;
+        entries.push_back({src[i], idx, 1, std::int32_t(pos_new++)});
+      }
+    }
+
+    std::ranges::sort(removed_keys);
+    for (std::size_t i = 0; i < _data.dest_owners.size(); ++i)
+    {
+      std::pair<int, std::int32_t> key(_data.dest_owners[i], _dest_indices[i]);
+      if (!std::ranges::binary_search(removed_keys, key))
+        entries.push_back({key.first, key.second, 0, std::int32_t(i)});
+    }
+
+    // Sort by source rank and index on the source, which is the order of
+    // determine_point_ownership
+    std::ranges::sort(entries);
+
+    PointOwnershipData<T> new_data;
+    new_data.src_owner = std::move(_data.src_owner);
+    new_data.src_owner.resize(num_points, -1);
+    for (std::size_t i = 0; i < moved.size(); ++i)
+      new_data.src_owner[moved[i]] = data.src_owner[i];
+
+    _dest_indices.resize(entries.size());
+    new_data.dest_owners.resize(entries.size());
+    new_data.dest_points.resize(3 * entries.size());
+    new_data.dest_cells.resize(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+      auto [rank, idx, is_new, pos] = entries[i];
+      const PointOwnershipData<T>& d = is_new ? data : _data;
+      new_data.dest_owners[i] = rank;
+      _dest_indices[i] = idx;
+      std::copy_n(std::next(d.dest_points.begin(), 3 * pos), 3,
+                  std::next(new_data.dest_points.begin(), 3 * i));
+      new_data.dest_cells[i] = d.dest_cells[pos];
+    }
+
+    _data = std::move(new_data);
+    return _data;
+  }
+
+  /// @brief Point ownership data from the most recent update.
+  const PointOwnershipData<T>& data() const { return _data; }
+
+  /// @brief Index of each point in PointOwnershipData::dest_points in
+  /// the list of points on the process that sent it.
+  std::span<const std::int32_t> dest_indices() const
+  {
+    return _dest_indices;
+  }
+
+  /// @brief Number of points on this process that were sent to
+  /// candidate processes in the most recent update.
+  std::int32_t num_updated() const { return _num_updated; }
+
+private:
+  // Owned cells of a mesh
+  static std::vector<std::int32_t> owned_cells(const mesh::Mesh<T>& mesh)
+  {
+    const int tdim = mesh.topology()->dim();
+    std::vector<std::int32_t> cells(
+        mesh.topology()->index_map(tdim)->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+    return cells;
+  }
+
+  // The mesh
+  std::shared_ptr<const mesh::Mesh<T>> _mesh;
+
+  // Bounding box tree of the owned cells, and the global tree
+  BoundingBoxTree<T> _tree, _global_tree;
+
+  // Points from the most recent update
+  std::vector<T> _points;
+
+  // Ownership data
+  PointOwnershipData<T> _data;
+
+  // Index of each destination point on the source process
+  std::vector<std::int32_t> _dest_indices;
+
+  // Number of points sent in the most recent update
+  std::int32_t _num_updated = 0;
+};
+
+} // namespace dolfinx::geometry
@@ -0,0 +1,299 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BoundingBoxTree.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dolfinx::geometry
+{
+/// @brief Axis-aligned bounding box tree with `W` children per node.
+///
+/// The tree is created by collapsing a binary BoundingBoxTree: the
+/// child with the largest surface area is repeatedly replaced by its
+/// children until a node has `W` children. The bounding boxes of the
+/// children of a node are stored contiguously in structure-of-arrays
+/// layout, i.e. the lower `x` coordinate of all `W` children, then the
+/// lower `y` coordinate, etc. A point can then be tested against all
+/// children of a node with `W`-wide vector operations, and the tree
+/// has about `log2(W)` times fewer levels than the binary tree.
+///
+/// The bounding boxes are stored with the tolerance that is used for
+/// point queries on BoundingBoxTree already applied, so queries return
+/// the same entities as for the binary tree, in the same order.
+///
+/// @tparam T Geometry type
+/// @tparam W Number of children per node, typically the SIMD width
+template <std::floating_point T, int W = 4>
+class WideBoundingBoxTree
+{
+  static_assert(W >= 2, "Nodes must have at least two children.");
+
+public:
+  /// @brief Create a wide tree from a binary bounding box tree.
+  /// @param[in] tree Binary bounding box tree.
+  explicit WideBoundingBoxTree(const BoundingBoxTree<T>& tree)
+      : _tdim(tree.tdim())
+  {
+    if (tree.num_bboxes() == 0)
+      return;
+
+    const std::int32_t root = tree.num_bboxes() - 1;
+    if (auto b = tree.bbox(root); b[0] == b[1])
+    {
+      // Tree with a single leaf
+      std::int32_t node = add_node();
+      set_child(node, 0, leaf(b[1]), tree.get_bbox(root));
+      _depth = 1;
+    }
+    else
+      build(tree, root, 1);
+  }
+
+  /// @brief Create a wide tree for mesh entities.
+  ///
+  /// See BoundingBoxTree(const mesh::Mesh<T>&, int,
+  /// std::optional<std::span<const std::int32_t>>, double).
+  ///
+  /// @param[in] mesh Mesh for building the bounding box tree.
+  /// @param[in] tdim Topological dimension of the mesh entities.
+  /// @param[in] entities Entity indices (local to process). If
+  /// `std::nullopt`, all local entities (including ghosts) are used.
+  /// @param[in] padding Value to pad (extend) the bounding box of each
+  /// entity by.
+  WideBoundingBoxTree(const mesh::Mesh<T>& mesh, int tdim,
+                      std::optional<std::span<const std::int32_t>> entities
+                      = std::nullopt,
+                      double padding = 0)
+      : WideBoundingBoxTree(BoundingBoxTree<T>(mesh, tdim, entities, padding))
+  {
+  }
+
+  /// Number of nodes
+  std::int32_t num_nodes() const { return _children.size() / W; }
+
+  /// Number of levels in the tree
+  int depth() const { return _depth; }
+
+  /// Topological dimension of leaf entities
+  int tdim() const { return _tdim; }
+
+  /// @brief Children of a node.
+  ///
+  /// A non-negative child is the index of a node. A leaf is encoded as
+  /// `-(e + 2)`, where `e` is the index of the entity that the leaf
+  /// bounds, see is_leaf() and entity(). Unused children are -1.
+  ///
+  /// @param[in] node Node index.
+  /// @return The `W` children of the node.
+  std::span<const std::int32_t, W> children(std::int32_t node) const
+  {
+    return std::span<const std::int32_t, W>(_children.data() + W * node, W);
+  }
+
+  /// @brief Bounding boxes of the children of a node.
+  ///
+  /// Storage is `(6, W)`, row-major, with rows (xmin, ymin, zmin, xmax,
+  /// ymax, zmax). The boxes of unused children are empty.
+  ///
+  /// @param[in] node Node index.
+  /// @return Bounding boxes of the children.
+  std::span<const T, 6 * W> bboxes(std::int32_t node) const
+  {
+    return std::span<const T, 6 * W>(_bboxes.data() + 6 * W * node, 6 * W);
+  }
+
+  /// @brief Check if a child is a leaf.
+  static constexpr bool is_leaf(std::int32_t child) { return child < -1; }
+
+  /// @brief Entity index of a leaf child.
+  static constexpr std::int32_t entity(std::int32_t child)
+  {
+    return -child - 2;
+  }
+
+private:
+  static constexpr std::int32_t leaf(std::int32_t e) { return -e - 2; }
+
+  // Add a node with unused children and return its index
+  std::int32_t add_node()
+  {
+    constexpr T max = std::numeric_limits<T>::max();
+    std::int32_t node = num_nodes();
+    _children.insert(_children.end(), W, -1);
+    _bboxes.insert(_bboxes.end(), 3 * W, max);
+    _bboxes.insert(_bboxes.end(), 3 * W, -max);
+    return node;
+  }
+
+  // Set child of a node, with bounding box b = (lower corner, upper
+  // corner)
+  void set_child(std::int32_t node, int i, std::int32_t child,
+                 const std::array<T, 6>& b)
+  {
+    // Apply the tolerance used by point queries on BoundingBoxTree
+    constexpr T rtol = 1e-14;
+    _children[W * node + i] = child;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      T eps = rtol * (b[j + 3] - b[j]);
+      _bboxes[6 * W * node + j * W + i] = b[j] - eps;
+      _bboxes[6 * W * node + (j + 3) * W + i] = b[j + 3] + eps;
+    }
+  }
+
+  // Create the wide node for an (internal) node of the binary tree
+  std::int32_t build(const BoundingBoxTree<T>& tree, std::int32_t node,
+                     int level)
+  {
+    auto is_leaf_b = [&tree](std::int32_t n)
+    {
+      auto b = tree.bbox(n);
+      return b[0] == b[1];
+    };
+    auto area = [&tree](std::int32_t n)
+    {
+      std::array<T, 6> b = tree.get_bbox(n);
+      T dx = b[3] - b[0], dy = b[4] - b[1], dz = b[5] - b[2];
+      return dx * dy + dy * dz + dz * dx;
+    };
+
+    // Collapse binary nodes, keeping the left-to-right order of the
+    // children
+    std::vector<std::int32_t> nodes;
+    nodes.reserve(W);
+    auto [c0, c1] = tree.bbox(node);
+    nodes.push_back(c0);
+    nodes.push_back(c1);
+    while (nodes.size() < std::size_t(W))
+    {
+      auto it = nodes.end();
+      T amax = -1;
+      for (auto n = nodes.begin(); n != nodes.end(); ++n)
+      {
+        if (!is_leaf_b(*n))
+        {
+          if (T a = area(*n); a > amax)
+          {
+            amax = a;
+            it = n;
+          }
+        }
+      }
+
+      if (it == nodes.end())
+        break;
+
+      auto [l, r] = tree.bbox(*it);
+      *it = r;
+      nodes.insert(it, l);
+    }
+
+    _depth = std::max(_depth, level);
+    std::int32_t wnode = add_node();
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      std::int32_t child = is_leaf_b(nodes[i])
+                               ? leaf(tree.bbox(nodes[i])[1])
+                               : build(tree, nodes[i], level + 1);
+      set_child(wnode, i, child, tree.get_bbox(nodes[i]));
+    }
+
+    return wnode;
+  }
+
+  // Topological dimension of leaf entities
+  int _tdim;
+
+  // Number of levels
+  int _depth = 0;
+
+  // Children of each node, shape (num_nodes, W)
+  std::vector<std::int32_t> _children;
+
+  // Bounding boxes of the children of each node, shape (num_nodes,
+  // 6, W)
+  std::vector<T> _bboxes;
+};
+
+/// @brief Compute collisions between points and leaf bounding boxes
+/// of a wide bounding box tree.
+///
+/// See compute_collisions(const BoundingBoxTree<T>&, std::span<const
+/// T>). The result is the same as for the binary tree that `tree` was
+/// created from.
+///
+/// @param[in] tree The bounding box tree
+/// @param[in] points The points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @return For each point, the bounding box leaves that collide with
+/// the point.
+template <std::floating_point T, int W>
+graph::AdjacencyList<std::int32_t>
+compute_collisions(const WideBoundingBoxTree<T, W>& tree,
+                   std::span<const T> points)
+{
+  const std::size_t num_points = points.size() / 3;
+  std::vector<std::int32_t> entities, offsets(num_points + 1, 0);
+  if (tree.num_nodes() == 0)
+    return graph::AdjacencyList(std::move(entities), std::move(offsets));
+
+  entities.reserve(num_points);
+  std::vector<std::int32_t> stack;
+  stack.reserve(tree.depth() * W);
+  for (std::size_t p = 0; p < num_points; ++p)
+  {
+    const std::array<T, 3> x
+        = {points[3 * p], points[3 * p + 1], points[3 * p + 2]};
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+      std::int32_t next = stack.back();
+      stack.pop_back();
+      if (WideBoundingBoxTree<T, W>::is_leaf(next))
+      {
+        entities.push_back(WideBoundingBoxTree<T, W>::entity(next));
+        continue;
+      }
+
+      // Test point against the boxes of all children. The loop has no
+      // branches and can be vectorized.
+      std::span<const T, 6 * W> b = tree.bboxes(next);
+      std::array<bool, W> hit;
+      for (int i = 0; i < W; ++i)
+      {
+        hit[i] = (x[0] >= b[i]) & (x[1] >= b[W + i]) & (x[2] >= b[2 * W + i])
+                 & (x[0] <= b[3 * W + i]) & (x[1] <= b[4 * W + i])
+                 & (x[2] <= b[5 * W + i]);
+      }
+
+      // Push children in reverse order so that they are visited left
+      // to right
+      std::span<const std::int32_t, W> children = tree.children(next);
+      for (int i = W - 1; i >= 0; --i)
+      {
+        if (hit[i])
+          stack.push_back(children[i]);
+      }
+    }
+
+    offsets[p + 1] = entities.size();
+  }
+
+  return graph::AdjacencyList(std::move(entities), std::move(offsets));
+}
+
+} // namespace dolfinx::geometry
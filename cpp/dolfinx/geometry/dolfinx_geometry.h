@@ -10,4 +10,8 @@ namespace dolfinx::geometry
 // DOLFINx geometry interface
 
 #include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/CellGrid.h>
 #include <dolfinx/geometry/gjk.h>
+#include <dolfinx/geometry/PointLocator.h>
+#include <dolfinx/geometry/PointOwnership.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
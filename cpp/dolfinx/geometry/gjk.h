@@ -8,11 +8,13 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <concepts>
 #include <dolfinx/common/math.h>
 #include <limits>
 #include <numeric>
 #include <span>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -240,6 +242,87 @@ std::array<T, 3> support(std::span<const T> bd, std::array<T, 3> v)
 
   return {bd[3 * i], bd[3 * i + 1], bd[3 * i + 2]};
 }
+
+/// @brief Closest point to `x` on the triangle `abc`.
+///
+/// See Ericson, Real-Time Collision Detection (2004), Section 5.1.5.
+/// Returns `false` if the triangle is degenerate.
+template <std::floating_point T>
+bool closest_point_triangle(const std::array<T, 3>& x, std::span<const T, 3> a,
+                            std::span<const T, 3> b, std::span<const T, 3> c,
+                            std::array<T, 3>& p)
+{
+  auto dot = [](auto& u, auto& v)
+  { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; };
+  auto diff = [](auto& u, auto& v) -> std::array<T, 3>
+  { return {u[0] - v[0], u[1] - v[1], u[2] - v[2]}; };
+  auto combine = [&p, a](const std::array<T, 3>& u, T s,
+                         const std::array<T, 3>& w, T t)
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+      p[i] = a[i] + s * u[i] + t * w[i];
+  };
+
+  const std::array ab = diff(b, a), ac = diff(c, a), ax = diff(x, a);
+
+  // Vertex region a
+  const T d1 = dot(ab, ax), d2 = dot(ac, ax);
+  if (d1 <= 0 and d2 <= 0)
+  {
+    std::ranges::copy(a, p.begin());
+    return true;
+  }
+
+  // Vertex region b
+  const std::array bx = diff(x, b);
+  const T d3 = dot(ab, bx), d4 = dot(ac, bx);
+  if (d3 >= 0 and d4 <= d3)
+  {
+    std::ranges::copy(b, p.begin());
+    return true;
+  }
+
+  // Edge region ab
+  const T vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 and d1 >= 0 and d3 <= 0)
+  {
+    combine(ab, d1 / (d1 - d3), ac, 0);
+    return true;
+  }
+
+  // Vertex region c
+  const std::array cx = diff(x, c);
+  const T d5 = dot(ab, cx), d6 = dot(ac, cx);
+  if (d6 >= 0 and d5 <= d6)
+  {
+    std::ranges::copy(c, p.begin());
+    return true;
+  }
+
+  // Edge region ac
+  const T vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 and d2 >= 0 and d6 <= 0)
+  {
+    combine(ab, 0, ac, d2 / (d2 - d6));
+    return true;
+  }
+
+  // Edge region bc
+  const T va = d3 * d6 - d5 * d4;
+  if (va <= 0 and (d4 - d3) >= 0 and (d5 - d6) >= 0)
+  {
+    const T w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    combine(ab, 1 - w, ac, w);
+    return true;
+  }
+
+  // Face region
+  const T denom = va + vb + vc;
+  if (denom <= 0)
+    return false;
+  combine(ab, vb / denom, ac, vc / denom);
+  return true;
+}
 } // namespace impl_gjk
 
 /// @brief Compute the distance between two convex bodies p and q, each
@@ -315,4 +398,148 @@ std::array<T, 3> compute_distance_gjk(std::span<const T> p,
   return v;
 }
 
+/// @brief Compute the shortest vector from a simplex to a point.
+///
+/// Computes the same vector as compute_distance_gjk(x, s), using the
+/// closed-form solution for the closest point on a simplex. This is
+/// several times faster than the GJK iteration, and does not allocate
+/// memory.
+///
+/// @param[in] x The point, shape `(3,)`.
+/// @param[in] s Vertices of the simplex (a point, interval, triangle
+/// or tetrahedron), shape `(num_vertices, 3)` with `num_vertices <=
+/// 4`. Row-major storage.
+/// @return Shortest vector from the simplex to `x`.
+/// @note The GJK algorithm is used for degenerate simplices.
+template <std::floating_point T>
+std::array<T, 3> compute_distance_point_simplex(std::span<const T> x,
+                                                std::span<const T> s)
+{
+  assert(x.size() == 3);
+  assert(s.size() % 3 == 0);
+  const std::array<T, 3> p = {x[0], x[1], x[2]};
+  auto vertex = [s](std::size_t i)
+  { return std::span<const T, 3>(s.data() + 3 * i, 3); };
+  auto vector_to = [&p](const std::array<T, 3>& q) -> std::array<T, 3>
+  { return {p[0] - q[0], p[1] - q[1], p[2] - q[2]}; };
+
+  switch (s.size() / 3)
+  {
+  case 1:
+    return {p[0] - s[0], p[1] - s[1], p[2] - s[2]};
+  case 2:
+  {
+    auto a = vertex(0), b = vertex(1);
+    std::array ab = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const T ab2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+    if (ab2 == 0)
+      return {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    T t = ((p[0] - a[0]) * ab[0] + (p[1] - a[1]) * ab[1]
+           + (p[2] - a[2]) * ab[2])
+          / ab2;
+    t = std::clamp<T>(t, 0, 1);
+    return vector_to({a[0] + t * ab[0], a[1] + t * ab[1], a[2] + t * ab[2]});
+  }
+  case 3:
+  {
+    std::array<T, 3> q;
+    if (!impl_gjk::closest_point_triangle<T>(p, vertex(0), vertex(1),
+                                             vertex(2), q))
+    {
+      return compute_distance_gjk<T>(x, s);
+    }
+    return vector_to(q);
+  }
+  case 4:
+  {
+    // Closest point on the faces that have the point on the outside,
+    // see Ericson, Real-Time Collision Detection (2004), Section 5.1.6
+    constexpr std::array<std::array<int, 4>, 4> faces
+        = {{{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}}};
+    T dmin = std::numeric_limits<T>::max();
+    std::array<T, 3> vmin = {0, 0, 0};
+    for (auto [i0, i1, i2, i3] : faces)
+    {
+      auto a = vertex(i0), b = vertex(i1), c = vertex(i2), d = vertex(i3);
+      const std::array ab = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      const std::array ac = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+      const std::array n = math::cross(ab, ac);
+      const T sign_x = n[0] * (p[0] - a[0]) + n[1] * (p[1] - a[1])
+                       + n[2] * (p[2] - a[2]);
+      const T sign_d = n[0] * (d[0] - a[0]) + n[1] * (d[1] - a[1])
+                       + n[2] * (d[2] - a[2]);
+      if (sign_d == 0)
+        return compute_distance_gjk<T>(x, s);
+
+      if (sign_x * sign_d < 0)
+      {
+        std::array<T, 3> q;
+        if (!impl_gjk::closest_point_triangle<T>(p, a, b, c, q))
+          return compute_distance_gjk<T>(x, s);
+        const std::array v = vector_to(q);
+        if (T d2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2]; d2 < dmin)
+        {
+          dmin = d2;
+          vmin = v;
+        }
+      }
+    }
+
+    // vmin is zero if the point is inside the tetrahedron
+    return vmin;
+  }
+  default:
+    throw std::runtime_error("Number of simplex vertices not supported.");
+  }
+}
+
+
+/// @brief Compute the shortest vectors between pairs of convex bodies.
+///
+/// The bodies `p[i]` and `q[i]` are defined by sets of points, with
+/// the same number of points for all bodies in `p` and for all bodies
+/// in `q`. When each body in `p` is a single point and each body in `q`
+/// is a simplex, the closed-form solution
+/// (compute_distance_point_simplex) is used. Otherwise, the GJK
+/// algorithm (compute_distance_gjk) is used for each pair.
+///
+/// @param[in] p Points of the bodies `p`, shape `(num_bodies,
+/// num_points_p, 3)`. Row-major storage.
+/// @param[in] num_points_p Number of points of each body `p[i]`.
+/// @param[in] q Points of the bodies `q`, shape `(num_bodies,
+/// num_points_q, 3)`. Row-major storage.
+/// @param[in] num_points_q Number of points of each body `q[i]`.
+/// @param[in] simplices If `true`, the points of each body `q[i]` are
+/// the vertices of a simplex (at most 4 points). One to three points
+/// always define a simplex.
+/// @return Shortest vector between each pair of bodies (the vector from
+/// `q[i]` to `p[i]`), shape `(num_bodies, 3)`.
+template <std::floating_point T>
+std::vector<T> compute_distances_gjk(std::span<const T> p,
+                                     std::size_t num_points_p,
+                                     std::span<const T> q,
+                                     std::size_t num_points_q,
+                                     bool simplices = false)
+{
+  assert(num_points_p > 0 and num_points_q > 0);
+  const std::size_t num_bodies = p.size() / (3 * num_points_p);
+  assert(q.size() == 3 * num_points_q * num_bodies);
+
+  std::vector<T> v(3 * num_bodies);
+  const bool closed_form
+      = num_points_p == 1
+        and (num_points_q <= 3 or (simplices and num_points_q == 4));
+  for (std::size_t i = 0; i < num_bodies; ++i)
+  {
+    std::span<const T> pi = p.subspan(3 * num_points_p * i, 3 * num_points_p);
+    std::span<const T> qi = q.subspan(3 * num_points_q * i, 3 * num_points_q);
+    std::array<T, 3> vi = closed_form
+                              ? compute_distance_point_simplex<T>(pi, qi)
+                              : compute_distance_gjk<T>(pi, qi);
+    std::ranges::copy(vi, std::next(v.begin(), 3 * i));
+  }
+
+  return v;
+}
+
 } // namespace dolfinx::geometry
@@ -10,11 +10,17 @@
 #include "gjk.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cmath>
 #include <concepts>
 #include <cstdint>
 #include <deque>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/utils.h>
 #include <map>
 #include <numeric>
 #include <span>
@@ -56,8 +62,12 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
   const int tdim = mesh.topology()->dim();
   const mesh::Geometry<T>& geometry = mesh.geometry();
 
-  std::span<const T> geom_dofs = geometry.x();
+  mesh::NodeCoordinates<T> geom_dofs = geometry.coordinates();
   auto x_dofmap = geometry.dofmap();
+
+  // Entities of affine simplex cells are simplices, and the closest
+  // point can be computed directly
+  const bool affine = geometry.cmap().is_affine();
   std::vector<T> shortest_vectors;
   shortest_vectors.reserve(3 * entities.size());
   if (dim == tdim)
@@ -71,14 +81,13 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
           x_dofmap, entities[e], MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
       std::vector<T> nodes(3 * dofs.size());
       for (std::size_t i = 0; i < dofs.size(); ++i)
-      {
-        const std::int32_t pos = 3 * dofs[i];
         for (std::size_t j = 0; j < 3; ++j)
-          nodes[3 * i + j] = geom_dofs[pos + j];
-      }
+          nodes[3 * i + j] = geom_dofs(dofs[i], j);
 
       std::array<T, 3> d
-          = compute_distance_gjk<T>(points.subspan(3 * e, 3), nodes);
+          = affine ? compute_distance_point_simplex<T>(points.subspan(3 * e, 3),
+                                                       nodes)
+                   : compute_distance_gjk<T>(points.subspan(3 * e, 3), nodes);
       shortest_vectors.insert(shortest_vectors.end(), d.begin(), d.end());
     }
   }
@@ -112,14 +121,13 @@ std::vector<T> shortest_vector(const mesh::Mesh<T>& mesh, int dim,
               dim, local_cell_entity);
       std::vector<T> nodes(3 * entity_dofs.size());
       for (std::size_t i = 0; i < entity_dofs.size(); i++)
-      {
-        const std::int32_t pos = 3 * dofs[entity_dofs[i]];
         for (std::size_t j = 0; j < 3; ++j)
-          nodes[3 * i + j] = geom_dofs[pos + j];
-      }
+          nodes[3 * i + j] = geom_dofs(dofs[entity_dofs[i]], j);
 
       std::array<T, 3> d
-          = compute_distance_gjk<T>(points.subspan(3 * e, 3), nodes);
+          = affine ? compute_distance_point_simplex<T>(points.subspan(3 * e, 3),
+                                                       nodes)
+                   : compute_distance_gjk<T>(points.subspan(3 * e, 3), nodes);
       shortest_vectors.insert(shortest_vectors.end(), d.begin(), d.end());
     }
   }
@@ -414,6 +422,622 @@ void _compute_collisions_tree(const geometry::BoundingBoxTree<T>& A,
   // the logic is easier to follow.
 }
 
+/// @brief Compute collisions with tree, with subtrees searched
+/// concurrently.
+///
+/// The search is split into independent pairs of subtrees by expanding
+/// the pairs of colliding nodes breadth-first. The pairs are expanded in
+/// place, so that they are in the order of the serial (depth-first)
+/// search. The pairs are searched by `num_threads` threads, each with
+/// its own output buffer, and the buffers are merged in the order of
+/// the pairs. The result is the same as for _compute_collisions_tree.
+template <std::floating_point T>
+void _compute_collisions_tree_parallel(const geometry::BoundingBoxTree<T>& A,
+                                       const geometry::BoundingBoxTree<T>& B,
+                                       int num_threads,
+                                       std::vector<std::int32_t>& entities)
+{
+  // Pair of nodes to search, or pair of colliding leaves (entities)
+  struct Task
+  {
+    std::int32_t a, b;
+    bool leaves;
+  };
+
+  // Expand the pairs of nodes until there are enough tasks to balance
+  // the threads
+  std::vector<Task> tasks = {{A.num_bboxes() - 1, B.num_bboxes() - 1, false}};
+  const std::size_t min_tasks = 16 * num_threads;
+  bool expanded = true;
+  while (expanded and tasks.size() < min_tasks)
+  {
+    expanded = false;
+    std::vector<Task> next;
+    next.reserve(2 * tasks.size());
+    for (const Task& t : tasks)
+    {
+      if (t.leaves)
+      {
+        next.push_back(t);
+        continue;
+      }
+
+      expanded = true;
+      if (!bbox_in_bbox<T>(A.get_bbox(t.a), B.get_bbox(t.b)))
+        continue;
+
+      // Descend as in _compute_collisions_tree
+      const std::array<std::int32_t, 2> bbox_A = A.bbox(t.a);
+      const std::array<std::int32_t, 2> bbox_B = B.bbox(t.b);
+      const bool is_leaf_A = is_leaf(bbox_A);
+      const bool is_leaf_B = is_leaf(bbox_B);
+      if (is_leaf_A and is_leaf_B)
+        next.push_back({bbox_A[1], bbox_B[1], true});
+      else if (!is_leaf_A and (is_leaf_B or t.a > t.b))
+      {
+        next.push_back({bbox_A[0], t.b, false});
+        next.push_back({bbox_A[1], t.b, false});
+      }
+      else
+      {
+        next.push_back({t.a, bbox_B[0], false});
+        next.push_back({t.a, bbox_B[1], false});
+      }
+    }
+    tasks = std::move(next);
+  }
+
+  // Search the pairs, with the tasks distributed dynamically over the
+  // threads. The range of the output buffer of each task is recorded.
+  std::vector<std::vector<std::int32_t>> buffers(num_threads);
+  std::vector<std::array<std::size_t, 3>> ranges(tasks.size());
+  std::atomic<std::size_t> next_task = 0;
+  common::thread_pool().run(
+      num_threads,
+      [&](int thread)
+      {
+        std::vector<std::int32_t>& buffer = buffers[thread];
+        for (std::size_t i = next_task++; i < tasks.size(); i = next_task++)
+        {
+          const Task& t = tasks[i];
+          const std::size_t begin = buffer.size();
+          if (t.leaves)
+          {
+            buffer.push_back(t.a);
+            buffer.push_back(t.b);
+          }
+          else
+            _compute_collisions_tree(A, B, t.a, t.b, buffer);
+          ranges[i] = {std::size_t(thread), begin, buffer.size()};
+        }
+      });
+
+  // Merge the buffers in the order of the tasks
+  std::size_t size = entities.size();
+  for (auto& buffer : buffers)
+    size += buffer.size();
+  entities.reserve(size);
+  for (auto [thread, begin, end] : ranges)
+  {
+    entities.insert(entities.end(), std::next(buffers[thread].begin(), begin),
+                    std::next(buffers[thread].begin(), end));
+  }
+}
+
+/// Compute the leaf nodes of a tree that collide with a box
+/// @param[in] tree The bounding box tree
+/// @param[in] b The box
+/// @return Indices of the colliding leaf nodes
+template <std::floating_point T>
+std::vector<std::int32_t>
+_compute_leaf_nodes_bbox(const geometry::BoundingBoxTree<T>& tree,
+                         std::span<const T, 6> b)
+{
+  std::vector<std::int32_t> nodes;
+  std::vector<std::int32_t> stack = {tree.num_bboxes() - 1};
+  while (!stack.empty())
+  {
+    const std::int32_t node = stack.back();
+    stack.pop_back();
+    if (!bbox_in_bbox<T>(tree.get_bbox(node), b))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox))
+      nodes.push_back(node);
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+  return nodes;
+}
+
+/// Compute the leaves of a tree that collide with a box
+/// @param[in] tree The bounding box tree
+/// @param[in] b The box
+/// @param[in, out] entities The list of colliding entities (local to
+/// process)
+template <std::floating_point T>
+void _compute_collisions_bbox(const geometry::BoundingBoxTree<T>& tree,
+                              std::span<const T, 6> b,
+                              std::vector<std::int32_t>& entities)
+{
+  std::vector<std::int32_t> stack = {tree.num_bboxes() - 1};
+  while (!stack.empty())
+  {
+    const std::int32_t node = stack.back();
+    stack.pop_back();
+    const std::array<T, 6> node_box = tree.get_bbox(node);
+    if (!bbox_in_bbox<T>(node_box, b))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox))
+      entities.push_back(bbox[1]);
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+}
+
+/// @brief Compute the `k` leaves of a tree that are closest to a point.
+///
+/// Ties in the distance are broken by the leaf entity index, so the
+/// result does not depend on the structure of the tree.
+///
+/// @param[in] tree The bounding box tree
+/// @param[in] p The point
+/// @param[in] k Number of leaves to find
+/// @param[in, out] nearest (squared distance, entity) pairs of the
+/// closest leaves, sorted by distance. Used as a max-heap during the
+/// search.
+/// @param[in, out] stack Work array for the traversal
+template <std::floating_point T>
+void _compute_nearest_leaves(
+    const geometry::BoundingBoxTree<T>& tree, std::span<const T, 3> p,
+    std::size_t k, std::vector<std::pair<T, std::int32_t>>& nearest,
+    std::vector<std::pair<T, std::int32_t>>& stack)
+{
+  nearest.clear();
+  if (k == 0)
+    return;
+
+  auto r2 = [&tree, p](std::int32_t node) -> T
+  { return compute_squared_distance_bbox<T>(tree.get_bbox(node), p); };
+
+  const std::int32_t root = tree.num_bboxes() - 1;
+  stack.assign(1, {r2(root), root});
+  while (!stack.empty())
+  {
+    auto [d2, node] = stack.back();
+    stack.pop_back();
+
+    // Skip nodes that are further away than the kth closest leaf
+    if (nearest.size() == k and d2 > nearest.front().first)
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox))
+    {
+      const std::pair<T, std::int32_t> leaf(d2, bbox[1]);
+      if (nearest.size() < k)
+      {
+        nearest.push_back(leaf);
+        std::ranges::push_heap(nearest);
+      }
+      else if (leaf < nearest.front())
+      {
+        std::ranges::pop_heap(nearest);
+        nearest.back() = leaf;
+        std::ranges::push_heap(nearest);
+      }
+    }
+    else
+    {
+      // Visit the closer child first
+      std::pair<T, std::int32_t> c0(r2(bbox[0]), bbox[0]);
+      std::pair<T, std::int32_t> c1(r2(bbox[1]), bbox[1]);
+      if (c1.first < c0.first)
+        std::swap(c0, c1);
+      stack.push_back(c1);
+      stack.push_back(c0);
+    }
+  }
+
+  std::ranges::sort_heap(nearest);
+}
+
+/// @brief Compute the leaves of a tree within a distance of a point.
+/// @param[in] tree The bounding box tree
+/// @param[in] p The point
+/// @param[in] r2 Squared search radius
+/// @param[in, out] entities The list of leaf entities within the
+/// radius
+/// @param[in, out] stack Work array for the traversal
+template <std::floating_point T>
+void _compute_leaves_in_radius(const geometry::BoundingBoxTree<T>& tree,
+                               std::span<const T, 3> p, T r2,
+                               std::vector<std::int32_t>& entities,
+                               std::vector<std::int32_t>& stack)
+{
+  stack.assign(1, tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const std::int32_t node = stack.back();
+    stack.pop_back();
+    if (compute_squared_distance_bbox<T>(tree.get_bbox(node), p) > r2)
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox))
+      entities.push_back(bbox[1]);
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+}
+
+/// @brief Pull back a point to the reference cell of an affine
+/// simplex, and compute the squared distance from the point to the
+/// simplex.
+///
+/// The reference coordinates are computed with the inverse Jacobian of
+/// the simplex. The barycentric coordinates of the point bound the
+/// distance from below, and give the distance directly if the
+/// projection of the point onto the simplex lies inside the simplex.
+/// The closed-form distance (compute_distance_point_simplex) is only
+/// computed for points that are outside of, but within a squared
+/// distance `tol` of, the simplex, or if the simplex is degenerate.
+///
+/// @param[in] x The point.
+/// @param[in] v Vertex coordinates of the simplex (`shape=(tdim + 1,
+/// 3)`). Storage is row-major.
+/// @param[out] X Reference coordinates of the point (`shape=(tdim,)`).
+/// Zero if the simplex is degenerate.
+/// @param[in] tol Squared distance below which the distance is
+/// computed exactly.
+/// @return Squared distance from the point to the simplex if it is
+/// less than `tol`, otherwise a value that is at least `tol` and at
+/// most the squared distance.
+template <std::floating_point T>
+T pull_back_affine_simplex(std::span<const T, 3> x, std::span<const T> v,
+                           std::span<T> X, T tol)
+{
+  assert(v.size() % 3 == 0 and v.size() <= 12);
+  const std::size_t tdim = v.size() / 3 - 1;
+  assert(X.size() == tdim);
+  auto sub = [](auto a, auto b) -> std::array<T, 3>
+  { return {a[0] - b[0], a[1] - b[1], a[2] - b[2]}; };
+  auto dot = [](auto a, auto b) -> T
+  { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+  auto cross = [](auto a, auto b) -> std::array<T, 3>
+  {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+            a[0] * b[1] - a[1] * b[0]};
+  };
+
+  // Edges from the first vertex (columns of the Jacobian)
+  auto vertex = [v](std::size_t i)
+  { return std::span<const T, 3>(v.data() + 3 * i, 3); };
+  std::array<std::array<T, 3>, 3> e{};
+  for (std::size_t i = 0; i < tdim; ++i)
+    e[i] = sub(vertex(i + 1), vertex(0));
+
+  // Rows of the (pseudo-)inverse Jacobian K, i.e. the gradients of the
+  // reference coordinates
+  std::array<std::array<T, 3>, 3> K{};
+  T scale = 0;
+  switch (tdim)
+  {
+  case 0:
+    break;
+  case 1:
+    K[0] = e[0];
+    scale = dot(e[0], e[0]);
+    break;
+  case 2:
+  {
+    std::array<T, 3> n = cross(e[0], e[1]);
+    K[0] = cross(e[1], n);
+    K[1] = cross(n, e[0]);
+    scale = dot(n, n);
+    break;
+  }
+  case 3:
+    K[0] = cross(e[1], e[2]);
+    K[1] = cross(e[2], e[0]);
+    K[2] = cross(e[0], e[1]);
+    scale = dot(e[0], K[0]);
+    break;
+  }
+
+  auto squared_distance = [x, v]()
+  {
+    std::array<T, 3> d = compute_distance_point_simplex<T>(x, v);
+    return d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+  };
+
+  if (tdim > 0 and (scale == 0 or !std::isfinite(scale)))
+  {
+    std::ranges::fill(X, 0);
+    return squared_distance();
+  }
+
+  // Reference coordinates X = K (x - v0), and the component of x - v0
+  // that is normal to the simplex
+  const std::array<T, 3> r = sub(x, vertex(0));
+  std::array<T, 3> normal = r;
+  for (std::size_t i = 0; i < tdim; ++i)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+      K[i][j] /= scale;
+    X[i] = dot(K[i], r);
+    for (std::size_t j = 0; j < 3; ++j)
+      normal[j] -= X[i] * e[i][j];
+  }
+  const T d2_normal = dot(normal, normal);
+
+  // The distance within the plane of the simplex is at least the
+  // distance to the half-space of each non-negative barycentric
+  // coordinate, -lambda_i / |grad lambda_i|
+  T d2_plane = 0;
+  auto bound = [&d2_plane, &dot](T lambda, const std::array<T, 3>& g)
+  {
+    if (lambda < 0)
+      d2_plane = std::max(d2_plane, lambda * lambda / dot(g, g));
+  };
+  T lambda0 = 1;
+  std::array<T, 3> g0 = {0, 0, 0};
+  for (std::size_t i = 0; i < tdim; ++i)
+  {
+    bound(X[i], K[i]);
+    lambda0 -= X[i];
+    g0 = sub(g0, K[i]);
+  }
+  if (tdim > 0)
+    bound(lambda0, g0);
+
+  if (d2_plane == 0 or d2_normal + d2_plane >= tol)
+    return d2_normal + d2_plane;
+  else
+    return squared_distance();
+}
+
+/// @brief Entities of a set of cells that evaluate to true for a
+/// geometric marking function at all of their vertices.
+///
+/// The marker is evaluated only at the vertices of `cells`.
+///
+/// @param[in] mesh The mesh
+/// @param[in] dim Topological dimension of the entities
+/// @param[in] cells Sorted cell indices
+/// @param[in] marker Marking function
+/// @param[in] boundary If `true`, only entities attached to an owned
+/// exterior facet of one of the `cells` are considered
+/// @return Sorted list of marked entities
+template <std::floating_point T, mesh::MarkerFn<T> U>
+std::vector<std::int32_t>
+locate_cell_entities(const mesh::Mesh<T>& mesh, int dim,
+                     std::span<const std::int32_t> cells, U marker,
+                     bool boundary)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  mesh.topology_mutable()->create_connectivity(tdim, 0);
+  auto c_to_v = topology->connectivity(tdim, 0);
+  assert(c_to_v);
+
+  // Vertices of the cells and their geometry nodes
+  auto x_dofmap = mesh.geometry().dofmap();
+  std::vector<std::array<std::int32_t, 2>> vertex_to_node;
+  for (std::int32_t c : cells)
+  {
+    auto vertices = c_to_v->links(c);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+      vertex_to_node.push_back({vertices[i], x_dofmap(c, i)});
+  }
+  std::ranges::sort(vertex_to_node);
+  auto [unique_end, range_end] = std::ranges::unique(vertex_to_node);
+  vertex_to_node.erase(unique_end, range_end);
+
+  // Run marker function on the vertex coordinates
+  mesh::NodeCoordinates<T> x_nodes = mesh.geometry().coordinates();
+  const std::size_t num_vertices = vertex_to_node.size();
+  std::vector<T> xdata(3 * num_vertices);
+  for (std::size_t i = 0; i < num_vertices; ++i)
+    for (std::size_t j = 0; j < 3; ++j)
+      xdata[j * num_vertices + i] = x_nodes(vertex_to_node[i][1], j);
+  MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const T, MDSPAN_IMPL_STANDARD_NAMESPACE::extents<
+                   std::size_t, 3,
+                   MDSPAN_IMPL_STANDARD_NAMESPACE::dynamic_extent>>
+      x(xdata.data(), 3, num_vertices);
+  const std::vector<std::int8_t> marked = marker(x);
+  if (marked.size() != num_vertices)
+    throw std::runtime_error("Length of array of markers is wrong.");
+
+  // Candidate entities
+  std::vector<std::int32_t> entities;
+  if (boundary)
+  {
+    mesh.topology_mutable()->create_entities(tdim - 1);
+    mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
+    mesh.topology_mutable()->create_connectivity(tdim, tdim - 1);
+    mesh.topology_mutable()->create_connectivity(tdim - 1, dim);
+    auto f_to_c = topology->connectivity(tdim - 1, tdim);
+    auto c_to_f = topology->connectivity(tdim, tdim - 1);
+    auto f_to_e = topology->connectivity(tdim - 1, dim);
+    assert(f_to_c and c_to_f and f_to_e);
+    const std::int32_t num_owned_facets
+        = topology->index_map(tdim - 1)->size_local();
+    const std::vector<std::int32_t>& ip_facets
+        = topology->interprocess_facets();
+    for (std::int32_t c : cells)
+    {
+      for (std::int32_t f : c_to_f->links(c))
+      {
+        if (f < num_owned_facets and f_to_c->num_links(f) == 1
+            and !std::ranges::binary_search(ip_facets, f))
+        {
+          auto e = f_to_e->links(f);
+          entities.insert(entities.end(), e.begin(), e.end());
+        }
+      }
+    }
+  }
+  else if (dim == tdim)
+    entities.assign(cells.begin(), cells.end());
+  else
+  {
+    mesh.topology_mutable()->create_entities(dim);
+    mesh.topology_mutable()->create_connectivity(tdim, dim);
+    auto c_to_e = topology->connectivity(tdim, dim);
+    assert(c_to_e);
+    for (std::int32_t c : cells)
+    {
+      auto e = c_to_e->links(c);
+      entities.insert(entities.end(), e.begin(), e.end());
+    }
+  }
+  {
+    std::ranges::sort(entities);
+    auto [unique_end, range_end] = std::ranges::unique(entities);
+    entities.erase(unique_end, range_end);
+  }
+
+  // Keep entities with all vertices marked
+  mesh.topology_mutable()->create_connectivity(dim, 0);
+  auto e_to_v = topology->connectivity(dim, 0);
+  assert(e_to_v);
+  std::erase_if(
+      entities,
+      [&](std::int32_t e)
+      {
+        for (std::int32_t v : e_to_v->links(e))
+        {
+          auto it = std::ranges::lower_bound(
+              vertex_to_node, v, std::less{},
+              [](auto& vn) { return vn[0]; });
+          assert(it != vertex_to_node.end() and (*it)[0] == v);
+          if (!marked[std::distance(vertex_to_node.begin(), it)])
+            return true;
+        }
+        return false;
+      });
+
+  return entities;
+}
+
+/// @brief Compute which cells collide with a point, and optionally the
+/// reference coordinates of the point in the colliding cells.
+///
+/// See geometry::compute_colliding_cells. Affine simplex cells are
+/// tested using the reference coordinates of the points, see
+/// pull_back_affine_simplex.
+///
+/// @param[in] mesh The mesh
+/// @param[in] candidate_cells Candidate colliding cells for each point
+/// @param[in] points Points (`shape=(num_points, 3)`). Storage is
+/// row-major.
+/// @param[in] pull_back If `true`, compute the reference coordinates.
+/// @return For each point, the cells that collide with the point, and
+/// if `pull_back` is true, the reference coordinates of the point in
+/// each colliding cell (`shape=(num_collisions, tdim)`).
+template <std::floating_point T>
+std::pair<graph::AdjacencyList<std::int32_t>, std::vector<T>>
+compute_colliding_cells(
+    const mesh::Mesh<T>& mesh,
+    const graph::AdjacencyList<std::int32_t>& candidate_cells,
+    std::span<const T> points, bool pull_back)
+{
+  const mesh::Geometry<T>& geometry = mesh.geometry();
+  const fem::CoordinateElement<T>& cmap = geometry.cmap();
+  auto x_dofmap = geometry.dofmap();
+  mesh::NodeCoordinates<T> x_g = geometry.coordinates();
+  const std::size_t num_nodes = x_dofmap.extent(1);
+  const std::size_t tdim = mesh.topology()->dim();
+  const std::size_t gdim = geometry.dim();
+  constexpr T eps2 = 1e-12;
+
+  std::vector<std::int32_t> offsets = {0};
+  offsets.reserve(candidate_cells.num_nodes() + 1);
+  std::vector<std::int32_t> colliding_cells;
+  std::vector<T> X;
+  std::vector<T> coordinate_dofs(3 * num_nodes);
+  std::array<T, 3> Xp;
+  if (cmap.is_affine())
+  {
+    assert(num_nodes == tdim + 1);
+    for (std::int32_t i = 0; i < candidate_cells.num_nodes(); i++)
+    {
+      std::span<const T, 3> xp(points.data() + 3 * i, 3);
+      for (std::int32_t c : candidate_cells.links(i))
+      {
+        for (std::size_t j = 0; j < num_nodes; ++j)
+          for (std::size_t k = 0; k < 3; ++k)
+            coordinate_dofs[3 * j + k] = x_g(x_dofmap(c, j), k);
+
+        T d2 = pull_back_affine_simplex<T>(
+            xp, coordinate_dofs, std::span(Xp.data(), tdim), eps2);
+        if (d2 < eps2)
+        {
+          colliding_cells.push_back(c);
+          if (pull_back)
+            X.insert(X.end(), Xp.begin(), std::next(Xp.begin(), tdim));
+        }
+      }
+
+      offsets.push_back(colliding_cells.size());
+    }
+  }
+  else
+  {
+    using mdspan2_t = typename fem::CoordinateElement<T>::template mdspan2_t<T>;
+    using cmdspan2_t =
+        typename fem::CoordinateElement<T>::template mdspan2_t<const T>;
+    for (std::int32_t i = 0; i < candidate_cells.num_nodes(); i++)
+    {
+      auto cells = candidate_cells.links(i);
+      std::vector<T> _point(3 * cells.size());
+      for (std::size_t j = 0; j < cells.size(); ++j)
+        for (std::size_t k = 0; k < 3; ++k)
+          _point[3 * j + k] = points[3 * i + k];
+
+      std::vector distances_sq = squared_distance<T>(mesh, tdim, cells, _point);
+      for (std::size_t j = 0; j < cells.size(); j++)
+      {
+        if (distances_sq[j] < eps2)
+        {
+          colliding_cells.push_back(cells[j]);
+          if (pull_back)
+          {
+            // Cell geometry, with gdim components
+            for (std::size_t k = 0; k < num_nodes; ++k)
+              for (std::size_t l = 0; l < gdim; ++l)
+                coordinate_dofs[gdim * k + l] = x_g(x_dofmap(cells[j], k), l);
+            cmap.pull_back_nonaffine(
+                mdspan2_t(Xp.data(), 1, tdim),
+                cmdspan2_t(points.data() + 3 * i, 1, gdim),
+                cmdspan2_t(coordinate_dofs.data(), num_nodes, gdim));
+            X.insert(X.end(), Xp.begin(), std::next(Xp.begin(), tdim));
+          }
+        }
+      }
+
+      offsets.push_back(colliding_cells.size());
+    }
+  }
+
+  return {graph::AdjacencyList(std::move(colliding_cells), std::move(offsets)),
+          std::move(X)};
+}
 } // namespace impl
 
 /// @brief Create a bounding box tree for the midpoints of a subset of
@@ -447,23 +1071,213 @@ BoundingBoxTree<T> create_midpoint_tree(const mesh::Mesh<T>& mesh, int tdim,
 /// @brief Compute all collisions between two bounding box trees.
 /// @param[in] tree0 First BoundingBoxTree
 /// @param[in] tree1 Second BoundingBoxTree
+/// @param[in] num_threads Number of threads used for the search. The
+/// result is the same for any number of threads.
 /// @return List of pairs of intersecting box indices from each tree,
 /// flattened as a vector of size num_intersections*2
 template <std::floating_point T>
 std::vector<std::int32_t> compute_collisions(const BoundingBoxTree<T>& tree0,
-                                             const BoundingBoxTree<T>& tree1)
+                                             const BoundingBoxTree<T>& tree1,
+                                             int num_threads = 1)
 {
-  // Call recursive find function
   std::vector<std::int32_t> entities;
   if (tree0.num_bboxes() > 0 and tree1.num_bboxes() > 0)
   {
-    impl::_compute_collisions_tree(tree0, tree1, tree0.num_bboxes() - 1,
-                                   tree1.num_bboxes() - 1, entities);
+    if (num_threads > 1)
+    {
+      impl::_compute_collisions_tree_parallel(tree0, tree1, num_threads,
+                                              entities);
+    }
+    else
+    {
+      // Call recursive find function
+      impl::_compute_collisions_tree(tree0, tree1, tree0.num_bboxes() - 1,
+                                     tree1.num_bboxes() - 1, entities);
+    }
   }
 
   return entities;
 }
 
+/// @brief Compute all collisions between the leaves of two distributed
+/// bounding box trees, e.g. of two bodies in contact or of overlapping
+/// meshes.
+///
+/// The root boxes of `tree1` on all ranks are gathered in a global tree
+/// (see BoundingBoxTree::create_global_tree). Each rank sends to the
+/// ranks whose `tree1` root box collides with its `tree0` root box only
+/// the leaf boxes of `tree0` in that root box, i.e. the parts of
+/// `tree0` that overlap the remote partition. The receiving rank builds
+/// a tree from the boxes, searches it against its `tree1` and returns
+/// the colliding pairs.
+///
+/// @note Collective MPI operation
+/// @param[in] comm MPI communicator
+/// @param[in] tree0 Tree on this rank, e.g. of the entities of one body
+/// @param[in] tree1 Tree on this rank, e.g. of the entities of the other
+/// body
+/// @param[in] num_threads Number of threads used for the local searches
+/// @return Colliding leaves, flattened as a vector of size
+/// `num_intersections*3`, where each collision is `(entity of tree0 on
+/// this rank, rank, entity of tree1 on rank)`. The collisions are
+/// sorted.
+template <std::floating_point T>
+std::vector<std::int32_t> compute_collisions(MPI_Comm comm,
+                                             const BoundingBoxTree<T>& tree0,
+                                             const BoundingBoxTree<T>& tree1,
+                                             int num_threads = 1)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Root box of tree1 on each rank
+  const BoundingBoxTree<T> global_tree = tree1.create_global_tree(comm);
+  std::vector<std::array<T, 6>> root_boxes(size);
+  for (std::int32_t n = 0; n < global_tree.num_bboxes(); ++n)
+  {
+    if (std::array bbox = global_tree.bbox(n); impl::is_leaf(bbox))
+      root_boxes[bbox[1]] = global_tree.get_bbox(n);
+  }
+
+  // Ranks, other than this rank, whose tree1 collides with tree0
+  std::vector<std::int32_t> out_ranks;
+  if (tree0.num_bboxes() > 0)
+  {
+    out_ranks = compute_collisions(global_tree,
+                                   tree0.get_bbox(tree0.num_bboxes() - 1));
+    std::erase(out_ranks, rank);
+  }
+  std::vector in_ranks = dolfinx::MPI::compute_graph_edges_nbx(comm, out_ranks);
+  std::ranges::sort(in_ranks);
+
+  // Pack the leaf boxes of tree0 that collide with the root box of tree1
+  // on each destination rank
+  std::vector<std::int32_t> send_entities, send_sizes, send_offsets(1, 0);
+  std::vector<T> send_boxes;
+  for (std::int32_t r : out_ranks)
+  {
+    for (std::int32_t node :
+         impl::_compute_leaf_nodes_bbox(tree0, std::span(root_boxes[r])))
+    {
+      send_entities.push_back(tree0.bbox(node)[1]);
+      std::array b = tree0.get_bbox(node);
+      send_boxes.insert(send_boxes.end(), b.begin(), b.end());
+    }
+    send_sizes.push_back(send_entities.size() - send_offsets.back());
+    send_offsets.push_back(send_entities.size());
+  }
+
+  // Send the boxes
+  MPI_Comm forward_comm;
+  MPI_Dist_graph_create_adjacent(
+      comm, in_ranks.size(), in_ranks.data(), MPI_UNWEIGHTED, out_ranks.size(),
+      out_ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false, &forward_comm);
+  std::vector<std::int32_t> recv_sizes(in_ranks.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T, recv_sizes.data(),
+                        1, MPI_INT32_T, forward_comm);
+  std::vector<std::int32_t> recv_offsets(in_ranks.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_offsets.begin()));
+
+  std::vector<std::int32_t> send_sizes6(send_sizes.size()),
+      send_offsets6(send_offsets.size()), recv_sizes6(recv_sizes.size()),
+      recv_offsets6(recv_offsets.size());
+  auto times6 = [](auto x) { return 6 * x; };
+  std::ranges::transform(send_sizes, send_sizes6.begin(), times6);
+  std::ranges::transform(send_offsets, send_offsets6.begin(), times6);
+  std::ranges::transform(recv_sizes, recv_sizes6.begin(), times6);
+  std::ranges::transform(recv_offsets, recv_offsets6.begin(), times6);
+  std::vector<T> recv_boxes(recv_offsets6.back());
+  MPI_Neighbor_alltoallv(send_boxes.data(), send_sizes6.data(),
+                         send_offsets6.data(), dolfinx::MPI::mpi_t<T>,
+                         recv_boxes.data(), recv_sizes6.data(),
+                         recv_offsets6.data(), dolfinx::MPI::mpi_t<T>,
+                         forward_comm);
+  MPI_Comm_free(&forward_comm);
+
+  // Search the received boxes, identified by their position in
+  // recv_boxes, against tree1
+  std::vector<std::pair<std::array<T, 6>, std::int32_t>> leaves(
+      recv_boxes.size() / 6);
+  for (std::size_t i = 0; i < leaves.size(); ++i)
+  {
+    std::copy_n(std::next(recv_boxes.begin(), 6 * i), 6,
+                leaves[i].first.begin());
+    leaves[i].second = i;
+  }
+  const std::vector<std::int32_t> remote_collisions = compute_collisions(
+      BoundingBoxTree<T>(std::move(leaves), num_threads), tree1, num_threads);
+
+  // Pack the collisions (position in the data from the source, entity
+  // of tree1) for each source rank
+  std::vector<std::int32_t> reply_sizes(in_ranks.size(), 0);
+  for (std::size_t i = 0; i < remote_collisions.size(); i += 2)
+  {
+    auto it = std::ranges::upper_bound(recv_offsets, remote_collisions[i]);
+    reply_sizes[std::distance(recv_offsets.begin(), it) - 1] += 2;
+  }
+  std::vector<std::int32_t> reply_offsets(in_ranks.size() + 1, 0);
+  std::partial_sum(reply_sizes.begin(), reply_sizes.end(),
+                   std::next(reply_offsets.begin()));
+  std::vector<std::int32_t> reply(reply_offsets.back());
+  {
+    std::vector<std::int32_t> pos(reply_offsets.begin(),
+                                  std::prev(reply_offsets.end()));
+    for (std::size_t i = 0; i < remote_collisions.size(); i += 2)
+    {
+      auto it = std::ranges::upper_bound(recv_offsets, remote_collisions[i]);
+      const std::size_t src = std::distance(recv_offsets.begin(), it) - 1;
+      reply[pos[src]++] = remote_collisions[i] - recv_offsets[src];
+      reply[pos[src]++] = remote_collisions[i + 1];
+    }
+  }
+
+  // Return the collisions to the ranks that sent the boxes
+  MPI_Comm reverse_comm;
+  MPI_Dist_graph_create_adjacent(
+      comm, out_ranks.size(), out_ranks.data(), MPI_UNWEIGHTED,
+      in_ranks.size(), in_ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+      &reverse_comm);
+  std::vector<std::int32_t> result_sizes(out_ranks.size());
+  reply_sizes.reserve(1);
+  result_sizes.reserve(1);
+  MPI_Neighbor_alltoall(reply_sizes.data(), 1, MPI_INT32_T,
+                        result_sizes.data(), 1, MPI_INT32_T, reverse_comm);
+  std::vector<std::int32_t> result_offsets(out_ranks.size() + 1, 0);
+  std::partial_sum(result_sizes.begin(), result_sizes.end(),
+                   std::next(result_offsets.begin()));
+  std::vector<std::int32_t> results(result_offsets.back());
+  MPI_Neighbor_alltoallv(reply.data(), reply_sizes.data(),
+                         reply_offsets.data(), MPI_INT32_T, results.data(),
+                         result_sizes.data(), result_offsets.data(),
+                         MPI_INT32_T, reverse_comm);
+  MPI_Comm_free(&reverse_comm);
+
+  // Collisions on this rank, and collisions with other ranks
+  std::vector<std::array<std::int32_t, 3>> collisions;
+  const std::vector<std::int32_t> local
+      = compute_collisions(tree0, tree1, num_threads);
+  for (std::size_t i = 0; i < local.size(); i += 2)
+    collisions.push_back({local[i], rank, local[i + 1]});
+  for (std::size_t j = 0; j < out_ranks.size(); ++j)
+  {
+    for (std::int32_t i = result_offsets[j]; i < result_offsets[j + 1]; i += 2)
+    {
+      collisions.push_back({send_entities[send_offsets[j] + results[i]],
+                            out_ranks[j], results[i + 1]});
+    }
+  }
+  std::ranges::sort(collisions);
+
+  std::vector<std::int32_t> entities;
+  entities.reserve(3 * collisions.size());
+  for (auto& c : collisions)
+    entities.insert(entities.end(), c.begin(), c.end());
+  return entities;
+}
+
 /// @brief Compute collisions between points and leaf bounding boxes.
 ///
 /// Bounding boxes can overlap, therefore points can collide with more
@@ -499,6 +1313,94 @@ compute_collisions(const BoundingBoxTree<T>& tree, std::span<const T> points)
   }
 }
 
+/// @brief Compute collisions between a box and leaf bounding boxes.
+/// @param[in] tree The bounding box tree
+/// @param[in] box The box `{x_min, y_min, z_min, x_max, y_max, z_max}`
+/// @return Sorted list of the leaves (entities) that collide with the
+/// box.
+template <std::floating_point T>
+std::vector<std::int32_t> compute_collisions(const BoundingBoxTree<T>& tree,
+                                             const std::array<T, 6>& box)
+{
+  std::vector<std::int32_t> entities;
+  if (tree.num_bboxes() > 0)
+    impl::_compute_collisions_bbox(tree, std::span(box), entities);
+  std::ranges::sort(entities);
+  return entities;
+}
+
+/// @brief Compute indices of the mesh entities in a box that evaluate
+/// to true for a geometric marking function.
+///
+/// Computes the same entities as mesh::locate_entities, but the marker
+/// is evaluated only at the vertices of the cells that collide with
+/// `box`, which are found using `tree`. The cost depends on the number
+/// of cells that collide with the box rather than the size of the
+/// mesh, so a tree can be re-used to locate many small regions.
+///
+/// @pre The marker evaluates to false for points outside of `box`.
+///
+/// @param[in] tree Bounding box tree for the cells of `mesh`.
+/// @param[in] mesh Mesh to mark entities on.
+/// @param[in] dim Topological dimension of the entities to be
+/// considered.
+/// @param[in] box Box that contains all marked points, `{x_min, y_min,
+/// z_min, x_max, y_max, z_max}`.
+/// @param[in] marker Marking function, returns `true` for a point that
+/// is 'marked', and `false` otherwise.
+/// @returns Sorted list of marked entity indices, including any ghost
+/// indices (indices local to the process).
+template <std::floating_point T, mesh::MarkerFn<T> U>
+std::vector<std::int32_t> locate_entities(const BoundingBoxTree<T>& tree,
+                                          const mesh::Mesh<T>& mesh, int dim,
+                                          const std::array<T, 6>& box,
+                                          U marker)
+{
+  if (tree.tdim() != mesh.topology()->dim())
+    throw std::runtime_error("Bounding box tree must be built for cells.");
+  std::vector<std::int32_t> cells = compute_collisions(tree, box);
+  return impl::locate_cell_entities(mesh, dim, cells, marker, false);
+}
+
+/// @brief Compute indices of the mesh entities in a box that are
+/// attached to an owned boundary facet and evaluate to true for a
+/// geometric marking function.
+///
+/// Computes the same entities as mesh::locate_entities_boundary, but
+/// the marker is evaluated only at the vertices of the cells that
+/// collide with `box`, which are found using `tree`.
+///
+/// @pre The marker evaluates to false for points outside of `box`.
+///
+/// @param[in] tree Bounding box tree for the cells of `mesh`.
+/// @param[in] mesh Mesh to mark entities on.
+/// @param[in] dim Topological dimension of the entities to be
+/// considered. Must be less than the topological dimension of the mesh.
+/// @param[in] box Box that contains all marked points, `{x_min, y_min,
+/// z_min, x_max, y_max, z_max}`.
+/// @param[in] marker Marking function, returns `true` for a point that
+/// is 'marked', and `false` otherwise.
+/// @returns Sorted list of marked entity indices (indices local to the
+/// process).
+template <std::floating_point T, mesh::MarkerFn<T> U>
+std::vector<std::int32_t>
+locate_entities_boundary(const BoundingBoxTree<T>& tree,
+                         const mesh::Mesh<T>& mesh, int dim,
+                         const std::array<T, 6>& box, U marker)
+{
+  const int tdim = mesh.topology()->dim();
+  if (dim == tdim)
+  {
+    throw std::runtime_error(
+        "Cannot use geometry::locate_entities_boundary (boundary) for "
+        "cells.");
+  }
+  if (tree.tdim() != tdim)
+    throw std::runtime_error("Bounding box tree must be built for cells.");
+  std::vector<std::int32_t> cells = compute_collisions(tree, box);
+  return impl::locate_cell_entities(mesh, dim, cells, marker, true);
+}
+
 /// @brief Given a set of cells, find the first one that collides with a
 /// point.
 ///
@@ -526,24 +1428,32 @@ std::int32_t compute_first_colliding_cell(const mesh::Mesh<T>& mesh,
   else
   {
     const mesh::Geometry<T>& geometry = mesh.geometry();
-    std::span<const T> geom_dofs = geometry.x();
+    mesh::NodeCoordinates<T> geom_dofs = geometry.coordinates();
     auto x_dofmap = geometry.dofmap();
     const std::size_t num_nodes = x_dofmap.extent(1);
+    const bool affine = geometry.cmap().is_affine();
     std::vector<T> coordinate_dofs(num_nodes * 3);
+    std::array<T, 3> X;
     for (auto cell : cells)
     {
       auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
           x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-      for (std::size_t i = 0; i < num_nodes; ++i)
+      geom_dofs.copy(dofs, coordinate_dofs.data());
+
+      T d2;
+      if (affine)
       {
-        std::copy_n(std::next(geom_dofs.begin(), 3 * dofs[i]), 3,
-                    std::next(coordinate_dofs.begin(), 3 * i));
+        d2 = impl::pull_back_affine_simplex<T>(
+            point, coordinate_dofs, std::span(X.data(), num_nodes - 1), tol);
       }
-
-      std::array<T, 3> shortest_vector
-          = compute_distance_gjk<T>(point, coordinate_dofs);
-      T d2 = std::reduce(shortest_vector.begin(), shortest_vector.end(), T(0),
+      else
+      {
+        std::array<T, 3> shortest_vector
+            = compute_distance_gjk<T>(point, coordinate_dofs);
+        d2 = std::reduce(shortest_vector.begin(), shortest_vector.end(), T(0),
                          [](auto d, auto e) { return d + e * e; });
+      }
+
       if (d2 < tol)
         return cell;
     }
@@ -610,10 +1520,143 @@ compute_closest_entity(const BoundingBoxTree<T>& tree,
   return entities;
 }
 
+/// @brief Compute the `k` nearest neighbours in a tree of points.
+///
+/// The distance to a leaf is the distance to its bounding box, which
+/// for a tree created from a point cloud (see
+/// BoundingBoxTree::BoundingBoxTree and geometry::create_midpoint_tree)
+/// is the distance to the point. Points of the tree at the same
+/// distance are ordered by their index.
+///
+/// @param[in] tree Bounding box tree of points
+/// @param[in] points Points to find the neighbours of
+/// (`shape=(num_points, 3)`). Storage is row-major.
+/// @param[in] k Number of neighbours to find for each point
+/// @param[in] num_threads Number of threads used for the search. The
+/// result is the same for any number of threads.
+/// @return For each point, the indices of the `min(k,
+/// num_tree_points)` nearest tree points, sorted by distance.
+template <std::floating_point T>
+graph::AdjacencyList<std::int32_t>
+compute_nearest_neighbors(const BoundingBoxTree<T>& tree,
+                          std::span<const T> points, int k,
+                          int num_threads = 1)
+{
+  if (k < 0)
+    throw std::runtime_error("Number of neighbours must be non-negative.");
+
+  const std::size_t num_points = points.size() / 3;
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+  if (tree.num_bboxes() == 0 or k == 0)
+    return graph::AdjacencyList(std::vector<std::int32_t>(),
+                                std::move(offsets));
+
+  // The number of leaves is bounded by the number of nodes, so that
+  // every point has the same number of neighbours
+  const std::size_t num_leaves = (tree.num_bboxes() + 1) / 2;
+  const std::size_t n = std::min<std::size_t>(k, num_leaves);
+  std::vector<std::int32_t> entities(n * num_points);
+  for (std::size_t p = 0; p < offsets.size(); ++p)
+    offsets[p] = n * p;
+  auto search = [&](std::size_t p0, std::size_t p1)
+  {
+    std::vector<std::pair<T, std::int32_t>> nearest, stack;
+    nearest.reserve(n + 1);
+    for (std::size_t p = p0; p < p1; ++p)
+    {
+      impl::_compute_nearest_leaves(
+          tree, std::span<const T, 3>(points.data() + 3 * p, 3), n, nearest,
+          stack);
+      assert(nearest.size() == n);
+      std::ranges::transform(nearest, std::next(entities.begin(), n * p),
+                             [](auto& e) { return e.second; });
+    }
+  };
+
+  if (num_threads > 1)
+  {
+    common::thread_pool().run(
+        num_threads,
+        [&search, num_points, num_threads](int t)
+        {
+          auto [p0, p1] = dolfinx::MPI::local_range(t, num_points, num_threads);
+          search(p0, p1);
+        });
+  }
+  else
+    search(0, num_points);
+
+  return graph::AdjacencyList(std::move(entities), std::move(offsets));
+}
+
+/// @brief Compute the points of a tree within a distance of each point
+/// in a set.
+///
+/// The distance to a leaf is the distance to its bounding box, which
+/// for a tree created from a point cloud is the distance to the point.
+///
+/// @param[in] tree Bounding box tree of points
+/// @param[in] points Points to search around (`shape=(num_points,
+/// 3)`). Storage is row-major.
+/// @param[in] radius Search radius
+/// @param[in] num_threads Number of threads used for the search. The
+/// result is the same for any number of threads.
+/// @return For each point, the sorted indices of the tree points with
+/// distance less than or equal to `radius` from the point.
+template <std::floating_point T>
+graph::AdjacencyList<std::int32_t>
+compute_points_in_radius(const BoundingBoxTree<T>& tree,
+                         std::span<const T> points, T radius,
+                         int num_threads = 1)
+{
+  const std::size_t num_points = points.size() / 3;
+  if (tree.num_bboxes() == 0)
+  {
+    return graph::AdjacencyList(std::vector<std::int32_t>(),
+                                std::vector<std::int32_t>(num_points + 1, 0));
+  }
+
+  // Search blocks of points, storing the number of neighbours of each
+  // point and the neighbours of each block
+  const int num_blocks = std::max(num_threads, 1);
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+  std::vector<std::vector<std::int32_t>> block_entities(num_blocks);
+  auto search = [&](int b)
+  {
+    auto [p0, p1] = dolfinx::MPI::local_range(b, num_points, num_blocks);
+    std::vector<std::int32_t>& entities = block_entities[b];
+    std::vector<std::int32_t> stack;
+    for (std::size_t p = p0; p < std::size_t(p1); ++p)
+    {
+      const std::size_t e0 = entities.size();
+      impl::_compute_leaves_in_radius(
+          tree, std::span<const T, 3>(points.data() + 3 * p, 3),
+          radius * radius, entities, stack);
+      std::sort(std::next(entities.begin(), e0), entities.end());
+      offsets[p + 1] = entities.size() - e0;
+    }
+  };
+
+  if (num_blocks > 1)
+    common::thread_pool().run(num_blocks, search);
+  else
+    search(0);
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> entities;
+  entities.reserve(offsets.back());
+  for (auto& e : block_entities)
+    entities.insert(entities.end(), e.begin(), e.end());
+
+  return graph::AdjacencyList(std::move(entities), std::move(offsets));
+}
+
 /// @brief Compute which cells collide with a point.
 ///
 /// @note Uses the GJK algorithm, see geometry::compute_distance_gjk for
-/// details.
+/// details. Affine simplex cells are tested using the reference
+/// coordinates of the point, and the distance is only computed for
+/// points that are close to the boundary of a cell.
 ///
 /// @note `candidate_cells` can for instance be found by using
 /// geometry::compute_collisions between a bounding box tree and the set
@@ -631,75 +1674,59 @@ graph::AdjacencyList<std::int32_t> compute_colliding_cells(
     const graph::AdjacencyList<std::int32_t>& candidate_cells,
     std::span<const T> points)
 {
-  std::vector<std::int32_t> offsets = {0};
-  offsets.reserve(candidate_cells.num_nodes() + 1);
-  std::vector<std::int32_t> colliding_cells;
-  constexpr T eps2 = 1e-12;
-  const int tdim = mesh.topology()->dim();
-  for (std::int32_t i = 0; i < candidate_cells.num_nodes(); i++)
-  {
-    auto cells = candidate_cells.links(i);
-    std::vector<T> _point(3 * cells.size());
-    for (std::size_t j = 0; j < cells.size(); ++j)
-      for (std::size_t k = 0; k < 3; ++k)
-        _point[3 * j + k] = points[3 * i + k];
-
-    std::vector distances_sq = squared_distance<T>(mesh, tdim, cells, _point);
-    for (std::size_t j = 0; j < cells.size(); j++)
-      if (distances_sq[j] < eps2)
-        colliding_cells.push_back(cells[j]);
-
-    offsets.push_back(colliding_cells.size());
-  }
+  return impl::compute_colliding_cells(mesh, candidate_cells, points, false)
+      .first;
+}
 
-  return graph::AdjacencyList(std::move(colliding_cells), std::move(offsets));
+/// @brief Compute which cells collide with a point, and the reference
+/// coordinates of the point in each colliding cell.
+///
+/// See geometry::compute_colliding_cells. For affine simplex cells the
+/// reference coordinates are computed in the collision test, so no
+/// separate pull-back (fem::CoordinateElement::pull_back_affine) is
+/// required. For other cells the reference coordinates are computed
+/// with fem::CoordinateElement::pull_back_nonaffine.
+///
+/// @param[in] mesh The mesh
+/// @param[in] candidate_cells List of candidate colliding cells for the
+/// ith point in `points`
+/// @param[in] points Points to check for collision (`shape=(num_points,
+/// 3)`). Storage is row-major.
+/// @return For each point, the cells that collide with the point, and
+/// the reference coordinates of the point in each colliding cell
+/// (`shape=(num_collisions, tdim)`, in the order of the cells in the
+/// adjacency list). Storage is row-major.
+template <std::floating_point T>
+std::pair<graph::AdjacencyList<std::int32_t>, std::vector<T>>
+compute_colliding_cells_pull_back(
+    const mesh::Mesh<T>& mesh,
+    const graph::AdjacencyList<std::int32_t>& candidate_cells,
+    std::span<const T> points)
+{
+  return impl::compute_colliding_cells(mesh, candidate_cells, points, true);
 }
 
 /// @brief Given a set of points, determine which process is colliding,
-/// using the GJK algorithm on cells to determine collisions.
+/// using bounding box trees that have already been created.
 ///
-/// @todo This docstring is unclear. Needs fixing.
+/// See determine_point_ownership(const mesh::Mesh<T>&, std::span<const
+/// T>, T). Creating the trees is collective and can dominate the cost
+/// when ownership is determined repeatedly for the same mesh.
 ///
 /// @param[in] mesh The mesh
 /// @param[in] points Points to check for collision (`shape=(num_points,
 /// 3)`). Storage is row-major.
-/// @param[in] padding Amount of absolute padding of bounding boxes of the mesh.
-/// Each bounding box of the mesh is padded with this amount, to increase
-/// the number of candidates, avoiding rounding errors in determining the owner
-/// of a point if the point is on the surface of a cell in the mesh.
-/// @return Tuple `(src_owner, dest_owner, dest_points, dest_cells)`,
-/// where src_owner is a list of ranks corresponding to the input
-/// points. dest_owner is a list of ranks corresponding to dest_points,
-/// the points that this process owns. dest_cells contains the
-/// corresponding cell for each entry in dest_points.
-///
-/// @note `dest_owner` is sorted
-/// @note Returns -1 if no colliding process is found
-/// @note dest_points is flattened row-major, shape `(dest_owner.size(),
-/// 3)`
-/// @note Only looks through cells owned by the process
-/// @note A large padding value can increase the runtime of the function by
-/// orders of magnitude, because for non-colliding cells
-/// one has to determine the closest cell among all processes with an
-/// intersecting bounding box, which is an expensive operation to perform.
+/// @param[in] bb Bounding box tree for the owned cells of `mesh`.
+/// @param[in] global_bbtree Global bounding box tree created from `bb`
+/// with BoundingBoxTree::create_global_tree.
+/// @return Point ownership data.
 template <std::floating_point T>
-PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
-                                                std::span<const T> points,
-                                                T padding)
+PointOwnershipData<T> determine_point_ownership(
+    const mesh::Mesh<T>& mesh, std::span<const T> points,
+    const BoundingBoxTree<T>& bb, const BoundingBoxTree<T>& global_bbtree)
 {
   MPI_Comm comm = mesh.comm();
 
-  // Create a global bounding-box tree to find candidate processes with
-  // cells that could collide with the points
-  const int tdim = mesh.topology()->dim();
-  auto cell_map = mesh.topology()->index_map(tdim);
-  const std::int32_t num_cells = cell_map->size_local();
-  // NOTE: Should we send the cells in as input?
-  std::vector<std::int32_t> cells(num_cells, 0);
-  std::iota(cells.begin(), cells.end(), 0);
-  BoundingBoxTree bb(mesh, tdim, cells, padding);
-  BoundingBoxTree global_bbtree = bb.create_global_tree(comm);
-
   // Compute collisions:
   // For each point in `points` get the processes it should be sent to
   graph::AdjacencyList collisions = compute_collisions(global_bbtree, points);
@@ -776,8 +1803,9 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
 
   // Get mesh geometry for closest entity
   const mesh::Geometry<T>& geometry = mesh.geometry();
-  std::span<const T> geom_dofs = geometry.x();
+  mesh::NodeCoordinates<T> geom_dofs = geometry.coordinates();
   auto x_dofmap = geometry.dofmap();
+  const bool affine = geometry.cmap().is_affine();
 
   // Compute candidate cells for collisions (and extrapolation)
   const graph::AdjacencyList<std::int32_t> candidate_collisions
@@ -879,13 +1907,12 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
             x_dofmap, cell, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
         std::vector<T> nodes(3 * dofs.size());
         for (std::size_t j = 0; j < dofs.size(); ++j)
-        {
-          const int pos = 3 * dofs[j];
           for (std::size_t k = 0; k < 3; ++k)
-            nodes[3 * j + k] = geom_dofs[pos + k];
-        }
-        const std::array<T, 3> d = compute_distance_gjk<T>(
-            std::span<const T>(point.data(), point.size()), nodes);
+            nodes[3 * j + k] = geom_dofs(dofs[j], k);
+        std::span<const T> x(point.data(), point.size());
+        const std::array<T, 3> d
+            = affine ? compute_distance_point_simplex<T>(x, nodes)
+                     : compute_distance_gjk<T>(x, nodes);
         if (T current_distance = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
             current_distance < shortest_distance)
         {
@@ -979,4 +2006,49 @@ PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
                                .dest_cells = std::move(owned_recv_cells)};
 }
 
+/// @brief Given a set of points, determine which process is colliding,
+/// using the GJK algorithm on cells to determine collisions.
+///
+/// @todo This docstring is unclear. Needs fixing.
+///
+/// @param[in] mesh The mesh
+/// @param[in] points Points to check for collision (`shape=(num_points,
+/// 3)`). Storage is row-major.
+/// @param[in] padding Amount of absolute padding of bounding boxes of the mesh.
+/// Each bounding box of the mesh is padded with this amount, to increase
+/// the number of candidates, avoiding rounding errors in determining the owner
+/// of a point if the point is on the surface of a cell in the mesh.
+/// @return Tuple `(src_owner, dest_owner, dest_points, dest_cells)`,
+/// where src_owner is a list of ranks corresponding to the input
+/// points. dest_owner is a list of ranks corresponding to dest_points,
+/// the points that this process owns. dest_cells contains the
+/// corresponding cell for each entry in dest_points.
+///
+/// @note `dest_owner` is sorted
+/// @note Returns -1 if no colliding process is found
+/// @note dest_points is flattened row-major, shape `(dest_owner.size(),
+/// 3)`
+/// @note Only looks through cells owned by the process
+/// @note A large padding value can increase the runtime of the function by
+/// orders of magnitude, because for non-colliding cells
+/// one has to determine the closest cell among all processes with an
+/// intersecting bounding box, which is an expensive operation to perform.
+template <std::floating_point T>
+PointOwnershipData<T> determine_point_ownership(const mesh::Mesh<T>& mesh,
+                                                std::span<const T> points,
+                                                T padding)
+{
+  // Create a global bounding-box tree to find candidate processes with
+  // cells that could collide with the points
+  const int tdim = mesh.topology()->dim();
+  auto cell_map = mesh.topology()->index_map(tdim);
+  const std::int32_t num_cells = cell_map->size_local();
+  // NOTE: Should we send the cells in as input?
+  std::vector<std::int32_t> cells(num_cells, 0);
+  std::iota(cells.begin(), cells.end(), 0);
+  BoundingBoxTree bb(mesh, tdim, cells, padding);
+  BoundingBoxTree global_bbtree = bb.create_global_tree(mesh.comm());
+  return determine_point_ownership(mesh, points, bb, global_bbtree);
+}
+
 } // namespace dolfinx::geometry
@@ -9,9 +9,13 @@
 #include <cassert>
 #include <concepts>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -22,6 +26,11 @@ namespace dolfinx::graph
 /// contiguous list of nodes [0, 1, 2, ..., n) it stores the connected
 /// nodes. The representation is strictly local, i.e. it is not parallel
 /// aware.
+///
+/// A list in which every node has the same number of links (a constant
+/// degree list, see graph::regular_adjacency_list) does not store
+/// offsets. The links of a node are then found by strided access, and
+/// the offsets are only created if AdjacencyList::offsets is called.
 template <typename T>
 class AdjacencyList
 {
@@ -29,10 +38,11 @@ public:
   /// Construct trivial adjacency list where each of the n nodes is
   /// connected to itself
   /// @param [in] n Number of nodes
-  explicit AdjacencyList(const std::int32_t n) : _array(n), _offsets(n + 1)
+  explicit AdjacencyList(const std::int32_t n)
+      : _array(n), _num_nodes(n), _degree(1),
+        _offsets_flag(std::make_unique<std::once_flag>())
   {
     std::iota(_array.begin(), _array.end(), 0);
-    std::iota(_offsets.begin(), _offsets.end(), 0);
   }
 
   /// Construct adjacency list from arrays of data
@@ -69,37 +79,110 @@ public:
       _array.insert(_array.end(), e.begin(), e.end());
   }
 
+  /// @brief Construct a constant degree adjacency list, see
+  /// graph::regular_adjacency_list.
+  /// @param [in] data Adjacency array
+  /// @param [in] num_nodes Number of nodes
+  /// @param [in] degree Number of links of each node
+  template <typename U>
+    requires std::is_convertible_v<std::remove_cvref_t<U>, std::vector<T>>
+  AdjacencyList(U&& data, std::int32_t num_nodes, std::int32_t degree)
+      : _array(std::forward<U>(data)), _num_nodes(num_nodes), _degree(degree),
+        _offsets_flag(std::make_unique<std::once_flag>())
+  {
+    if (static_cast<std::size_t>(num_nodes) * degree != _array.size())
+    {
+      throw std::runtime_error(
+          "Incompatible data size and degree for constant degree "
+          "AdjacencyList");
+    }
+  }
+
   /// Copy constructor
-  AdjacencyList(const AdjacencyList& list) = default;
+  AdjacencyList(const AdjacencyList& list)
+      : _array(list._array), _offsets(list._offsets),
+        _num_nodes(list._num_nodes), _degree(list._degree),
+        _offsets_flag(list._offsets_flag ? std::make_unique<std::once_flag>()
+                                         : nullptr)
+  {
+  }
 
   /// Move constructor
-  AdjacencyList(AdjacencyList&& list) = default;
+  AdjacencyList(AdjacencyList&& list) noexcept
+      : _array(std::move(list._array)), _offsets(std::move(list._offsets)),
+        _num_nodes(std::exchange(list._num_nodes, 0)),
+        _degree(std::exchange(list._degree, -1)),
+        _offsets_flag(std::move(list._offsets_flag))
+  {
+  }
 
   /// Destructor
   ~AdjacencyList() = default;
 
   /// Assignment operator
-  AdjacencyList& operator=(const AdjacencyList& list) = default;
+  AdjacencyList& operator=(const AdjacencyList& list)
+  {
+    *this = AdjacencyList(list);
+    return *this;
+  }
 
   /// Move assignment operator
-  AdjacencyList& operator=(AdjacencyList&& list) = default;
+  AdjacencyList& operator=(AdjacencyList&& list) noexcept
+  {
+    _array = std::move(list._array);
+    _offsets = std::move(list._offsets);
+    _num_nodes = std::exchange(list._num_nodes, 0);
+    _degree = std::exchange(list._degree, -1);
+    _offsets_flag = std::move(list._offsets_flag);
+    return *this;
+  }
 
   /// Equality operator
   /// @return True is the adjacency lists are equal
   bool operator==(const AdjacencyList& list) const
   {
-    return this->_array == list._array and this->_offsets == list._offsets;
+    if (this->_degree >= 0 and list._degree >= 0)
+    {
+      return this->_array == list._array
+             and this->_num_nodes == list._num_nodes;
+    }
+    else
+      return this->_array == list._array and this->offsets() == list.offsets();
   }
 
   /// Get the number of nodes
   /// @return The number of nodes in the adjacency list
-  std::int32_t num_nodes() const { return _offsets.size() - 1; }
+  std::int32_t num_nodes() const
+  {
+    if (_degree >= 0)
+      return _num_nodes;
+    else
+      return static_cast<std::int32_t>(_offsets.size()) - 1;
+  }
+
+  /// @brief Number of links of every node, for a constant degree list.
+  /// @return The degree, or `std::nullopt` if nodes can have different
+  /// numbers of links.
+  /// @note For a constant degree list, `array()` is a row-major
+  /// `(num_nodes(), degree())` array.
+  std::optional<std::int32_t> degree() const
+  {
+    if (_degree >= 0)
+      return _degree;
+    else
+      return std::nullopt;
+  }
 
   /// Number of connections for given node
   /// @param [in] node Node index
   /// @return The number of outgoing links (edges) from the node
   int num_links(std::size_t node) const
   {
+    if (_degree >= 0)
+    {
+      assert(node < static_cast<std::size_t>(_num_nodes));
+      return _degree;
+    }
     assert((node + 1) < _offsets.size());
     return _offsets[node + 1] - _offsets[node];
   }
@@ -110,6 +193,8 @@ public:
   /// AdjacencyList::num_links(node).
   std::span<T> links(std::size_t node)
   {
+    if (_degree >= 0)
+      return std::span<T>(_array.data() + node * _degree, _degree);
     return std::span<T>(_array.data() + _offsets[node],
                         _offsets[node + 1] - _offsets[node]);
   }
@@ -120,6 +205,8 @@ public:
   /// AdjacencyList:num_links(node).
   std::span<const T> links(std::size_t node) const
   {
+    if (_degree >= 0)
+      return std::span<const T>(_array.data() + node * _degree, _degree);
     return std::span<const T>(_array.data() + _offsets[node],
                               _offsets[node + 1] - _offsets[node]);
   }
@@ -128,13 +215,41 @@ public:
   const std::vector<T>& array() const { return _array; }
 
   /// Return contiguous array of links for all nodes
+  /// @note For a constant degree list, the size of the array must not
+  /// be changed.
   std::vector<T>& array() { return _array; }
 
-  /// Offset for each node in array() (const version)
-  const std::vector<std::int32_t>& offsets() const { return _offsets; }
+  /// @brief Offset for each node in array() (const version).
+  /// @note For a constant degree list, the offsets are created on the
+  /// first call.
+  const std::vector<std::int32_t>& offsets() const
+  {
+    if (_degree >= 0)
+    {
+      std::call_once(*_offsets_flag,
+                     [this]()
+                     {
+                       if (_offsets.empty())
+                       {
+                         _offsets.resize(_num_nodes + 1);
+                         for (std::int32_t i = 0; i <= _num_nodes; ++i)
+                           _offsets[i] = i * _degree;
+                       }
+                     });
+    }
+    return _offsets;
+  }
 
-  /// Offset for each node in array()
-  std::vector<std::int32_t>& offsets() { return _offsets; }
+  /// @brief Offset for each node in array().
+  /// @note A constant degree list becomes a list with variable degree,
+  /// since the offsets may be modified by the caller.
+  std::vector<std::int32_t>& offsets()
+  {
+    std::as_const(*this).offsets();
+    _degree = -1;
+    _offsets_flag.reset();
+    return _offsets;
+  }
 
   /// Informal string representation (pretty-print)
   /// @return String representation of the adjacency list
@@ -143,7 +258,7 @@ public:
     std::stringstream s;
     s << "<AdjacencyList> with " + std::to_string(this->num_nodes()) + " nodes"
       << std::endl;
-    for (std::size_t e = 0; e < _offsets.size() - 1; ++e)
+    for (std::int32_t e = 0; e < this->num_nodes(); ++e)
     {
       s << "  " << e << ": [";
       for (auto link : this->links(e))
@@ -157,8 +272,17 @@ private:
   // Connections for all entities stored as a contiguous array
   std::vector<T> _array;
 
-  // Position of first connection for each entity (using local index)
-  std::vector<std::int32_t> _offsets;
+  // Position of first connection for each entity (using local index).
+  // Empty for a constant degree list until created by offsets().
+  mutable std::vector<std::int32_t> _offsets;
+
+  // Number of nodes and links per node for a constant degree list
+  // (_degree = -1 if the degree is not constant)
+  std::int32_t _num_nodes = 0;
+  std::int32_t _degree = -1;
+
+  // Guards the creation of _offsets for a constant degree list
+  std::unique_ptr<std::once_flag> _offsets_flag;
 };
 
 /// @private Deduction
@@ -194,11 +318,8 @@ regular_adjacency_list(U&& data, int degree)
   }
 
   std::int32_t num_nodes = degree == 0 ? data.size() : data.size() / degree;
-  std::vector<std::int32_t> offsets(num_nodes + 1, 0);
-  for (std::size_t i = 1; i < offsets.size(); ++i)
-    offsets[i] = offsets[i - 1] + degree;
   return AdjacencyList<typename std::decay_t<U>::value_type>(
-      std::forward<U>(data), std::move(offsets));
+      std::forward<U>(data), num_nodes, degree);
 }
 
 } // namespace dolfinx::graph
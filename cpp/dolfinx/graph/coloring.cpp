@@ -0,0 +1,223 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "coloring.h"
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/log.h>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using namespace dolfinx;
+
+namespace
+{
+// Return the smallest colour c for which forbidden[c] != n, and extend
+// forbidden if all colours are forbidden
+std::int32_t smallest_color(std::vector<std::int32_t>& forbidden,
+                            std::int32_t n)
+{
+  auto it = std::ranges::find_if(forbidden, [n](auto m) { return m != n; });
+  std::int32_t c = std::distance(forbidden.begin(), it);
+  if (it == forbidden.end())
+    forbidden.push_back(std::numeric_limits<std::int32_t>::max());
+  return c;
+}
+
+// Pseudo-random priority of a global index (splitmix64)
+std::uint64_t priority(std::int64_t index)
+{
+  std::uint64_t z = static_cast<std::uint64_t>(index) + 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  return z ^ (z >> 31);
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::compute_shared_link_coloring(
+    const graph::AdjacencyList<std::int32_t>& graph)
+{
+  const std::int32_t num_nodes = graph.num_nodes();
+  const std::vector<std::int32_t>& links = graph.array();
+  if (num_nodes == 0)
+    return {};
+
+  // Build transpose (link -> nodes)
+  const std::int32_t num_links
+      = links.empty() ? 0 : *std::ranges::max_element(links) + 1;
+  std::vector<std::int32_t> offsets(num_links + 1, 0);
+  for (std::int32_t l : links)
+    ++offsets[l + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> nodes(offsets.back());
+  {
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (std::int32_t n = 0; n < num_nodes; ++n)
+      for (std::int32_t l : graph.links(n))
+        nodes[pos[l]++] = n;
+  }
+
+  // Greedy colouring. forbidden[c] == n marks colour c as used by a
+  // node that shares a link with node n.
+  std::vector<std::int32_t> colors(num_nodes, -1);
+  std::vector<std::int32_t> forbidden;
+  for (std::int32_t n = 0; n < num_nodes; ++n)
+  {
+    for (std::int32_t l : graph.links(n))
+    {
+      for (std::int32_t k = offsets[l]; k < offsets[l + 1]; ++k)
+      {
+        if (std::int32_t c = colors[nodes[k]]; c >= 0)
+          forbidden[c] = n;
+      }
+    }
+
+    colors[n] = smallest_color(forbidden, n);
+  }
+
+  return colors;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+graph::compute_greedy_coloring(const graph::AdjacencyList<std::int32_t>& graph,
+                               int distance)
+{
+  if (distance != 1 and distance != 2)
+    throw std::runtime_error("Colouring distance must be 1 or 2.");
+
+  // forbidden[c] == n marks colour c as used by a node within distance
+  // links of node n
+  const std::int32_t num_nodes = graph.num_nodes();
+  std::vector<std::int32_t> colors(num_nodes, -1);
+  std::vector<std::int32_t> forbidden;
+  for (std::int32_t n = 0; n < num_nodes; ++n)
+  {
+    for (std::int32_t m : graph.links(n))
+    {
+      if (std::int32_t c = colors[m]; c >= 0 and m != n)
+        forbidden[c] = n;
+      if (distance == 2)
+      {
+        for (std::int32_t k : graph.links(m))
+        {
+          if (std::int32_t c = colors[k]; c >= 0 and k != n)
+            forbidden[c] = n;
+        }
+      }
+    }
+
+    colors[n] = smallest_color(forbidden, n);
+  }
+
+  return colors;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::compute_jones_plassmann_coloring(
+    const graph::AdjacencyList<std::int32_t>& graph,
+    const common::IndexMap& map)
+{
+  common::Timer timer("Jones-Plassmann colouring");
+
+  const std::int32_t size_local = map.size_local();
+  const std::int32_t size = size_local + map.num_ghosts();
+  if (graph.num_nodes() != size_local)
+  {
+    throw std::runtime_error(
+        "Number of graph nodes must equal the number of owned indices.");
+  }
+
+  // Priority of each index, with ties broken by the global index
+  std::vector<std::pair<std::uint64_t, std::int64_t>> weights(size);
+  {
+    std::vector<std::int32_t> local(size);
+    std::iota(local.begin(), local.end(), 0);
+    std::vector<std::int64_t> global(size);
+    map.local_to_global(local, global);
+    std::ranges::transform(global, weights.begin(), [](auto g)
+                           { return std::pair(priority(g), g); });
+  }
+
+  // Owned nodes in order of decreasing priority
+  std::vector<std::int32_t> order(size_local);
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::sort(order, std::greater<>(),
+                    [&weights](auto n) { return weights[n]; });
+
+  common::Scatterer<> scatterer(map, 1);
+  std::vector<std::int32_t> colors(size, -1);
+  std::vector<std::int32_t> forbidden;
+  std::int64_t num_uncolored = size_local;
+  int num_rounds = 0;
+  MPI_Allreduce(MPI_IN_PLACE, &num_uncolored, 1, MPI_INT64_T, MPI_SUM,
+                map.comm());
+  while (num_uncolored > 0)
+  {
+    // Colour the nodes whose neighbours of higher priority are
+    // coloured. Owned neighbours of higher priority have been visited,
+    // so only ghosts delay a node to a later round.
+    auto waits_for = [&colors, &weights](std::int32_t n, std::int32_t m)
+    { return m != n and colors[m] < 0 and weights[m] > weights[n]; };
+    std::size_t num_delayed = 0;
+    for (std::int32_t n : order)
+    {
+      auto links = graph.links(n);
+      if (std::ranges::any_of(links, [&](auto m) { return waits_for(n, m); }))
+      {
+        order[num_delayed++] = n;
+        continue;
+      }
+
+      for (std::int32_t m : links)
+      {
+        if (std::int32_t c = colors[m]; c >= 0 and m != n)
+        {
+          if (c >= static_cast<std::int32_t>(forbidden.size()))
+            forbidden.resize(c + 1, std::numeric_limits<std::int32_t>::max());
+          forbidden[c] = n;
+        }
+      }
+      colors[n] = smallest_color(forbidden, n);
+    }
+    order.resize(num_delayed);
+
+    // Update ghost colours
+    scatterer.scatter_fwd(
+        std::span<const std::int32_t>(colors.data(), size_local),
+        std::span(std::next(colors.begin(), size_local), colors.end()));
+
+    num_uncolored = order.size();
+    MPI_Allreduce(MPI_IN_PLACE, &num_uncolored, 1, MPI_INT64_T, MPI_SUM,
+                  map.comm());
+    ++num_rounds;
+  }
+
+  spdlog::info("Jones-Plassmann colouring: {} rounds", num_rounds);
+  return colors;
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+graph::color_classes(const std::vector<std::int32_t>& colors)
+{
+  const std::int32_t num_colors
+      = colors.empty() ? 0 : *std::ranges::max_element(colors) + 1;
+  std::vector<std::int32_t> offsets(num_colors + 1, 0);
+  for (std::int32_t c : colors)
+    ++offsets[c + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<std::int32_t> data(offsets.back());
+  std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+  for (std::size_t n = 0; n < colors.size(); ++n)
+    data[pos[colors[n]]++] = n;
+
+  return graph::AdjacencyList<std::int32_t>(std::move(data),
+                                            std::move(offsets));
+}
+//-----------------------------------------------------------------------------
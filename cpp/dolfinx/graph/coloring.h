@@ -0,0 +1,100 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "AdjacencyList.h"
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx::common
+{
+class IndexMap;
+}
+
+namespace dolfinx::graph
+{
+/// @brief Compute a greedy colouring of the nodes of a graph such that
+/// no two nodes with the same colour share a link.
+///
+/// The nodes `i` and `j` receive different colours if
+/// `graph.links(i)` and `graph.links(j)` have a common entry. A
+/// typical use is colouring mesh entities (nodes) by their
+/// degrees-of-freedom (links) so that entities of the same colour can
+/// be processed concurrently without write conflicts. This is a partial
+/// distance-2 colouring of the bipartite graph (nodes, links).
+///
+/// Nodes are visited in order and each is assigned the smallest colour
+/// not used by any node it shares a link with.
+///
+/// @param[in] graph Graph to colour. Link indices must be non-negative.
+/// @return Colour of each node. Colours are contiguous and start from
+/// zero.
+std::vector<std::int32_t>
+compute_shared_link_coloring(const AdjacencyList<std::int32_t>& graph);
+
+/// @brief Compute a greedy distance-1 or distance-2 colouring of the
+/// nodes of a graph.
+///
+/// For `distance == 1`, linked nodes receive different colours, e.g.
+/// rows of a matrix for a multicolour Gauss-Seidel smoother. For
+/// `distance == 2`, nodes that are linked or share a neighbour receive
+/// different colours.
+///
+/// Nodes are visited in order and each is assigned the smallest colour
+/// not used by a node within `distance` links. Self-links are ignored.
+///
+/// @param[in] graph Graph to colour. The graph must be symmetric.
+/// @param[in] distance Colouring distance, 1 or 2.
+/// @return Colour of each node. Colours are contiguous and start from
+/// zero.
+std::vector<std::int32_t>
+compute_greedy_coloring(const AdjacencyList<std::int32_t>& graph,
+                        int distance = 1);
+
+/// @brief Compute a distributed distance-1 colouring of the nodes of a
+/// graph using the Jones-Plassmann algorithm.
+///
+/// The nodes of `graph` are the indices owned by this process in `map`,
+/// and links are local indices in `map`, i.e. links to indices
+/// `>= map.size_local()` are ghosts. Linked nodes receive different
+/// colours, including across process boundaries.
+///
+/// Each index is given a pseudo-random priority computed from its
+/// global index. A node is coloured, with the smallest colour not used
+/// by its neighbours, once all neighbours of higher priority are
+/// coloured. Locally, nodes are processed in order of decreasing
+/// priority so that dependencies between owned nodes are resolved
+/// without communication, and ghost colours are updated after each
+/// sweep. See M. T. Jones and P. E. Plassmann, *A Parallel Graph
+/// Coloring Heuristic*, SIAM J. Sci. Comput., 14(3): 654-669, 1993,
+/// https://doi.org/10.1137/0914041.
+///
+/// A distance-2 colouring is computed by passing the graph of
+/// distance-2 neighbours, which requires a ghost layer such that the
+/// distance-2 neighbours of owned nodes are known locally.
+///
+/// @note Collective over the communicator of `map`.
+///
+/// @param[in] graph Graph to colour. The graph must be symmetric across
+/// processes: if owned node `i` links ghost `j`, the owner of `j` must
+/// have the global index of `i` as a link of `j`.
+/// @param[in] map Index map for the nodes and links of `graph`.
+/// @return Colour of each index in `map`, owned followed by ghosts.
+/// Colours are contiguous across processes and start from zero.
+std::vector<std::int32_t>
+compute_jones_plassmann_coloring(const AdjacencyList<std::int32_t>& graph,
+                                 const common::IndexMap& map);
+
+/// @brief Group nodes by colour.
+/// @param[in] colors Colour of each node, e.g. as computed by
+/// graph::compute_shared_link_coloring.
+/// @return Adjacency list where the links of node `c` are the nodes
+/// with colour `c`, in ascending order.
+AdjacencyList<std::int32_t>
+color_classes(const std::vector<std::int32_t>& colors);
+
+} // namespace dolfinx::graph
@@ -8,9 +8,12 @@
 #include "AdjacencyList.h"
 #include <algorithm>
 #include <cstdint>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <functional>
 #include <limits>
+#include <numeric>
 #include <span>
 
 using namespace dolfinx;
@@ -82,12 +85,11 @@ int max_level_width(const graph::AdjacencyList<int>& levels)
   return wmax;
 }
 //-----------------------------------------------------------------------------
-// Create a level structure from graph, rooted at node s
+// Create a level structure from graph, rooted at node s. This function
+// is called concurrently from threads, so it must not use timers.
 graph::AdjacencyList<int>
 create_level_structure(const graph::AdjacencyList<int>& graph, int s)
 {
-  common::Timer t("GPS: create_level_structure");
-
   // Note: int8 is often faster than bool
   std::vector<std::int8_t> labelled(graph.num_nodes(), false);
   labelled[s] = true;
@@ -96,9 +98,8 @@ create_level_structure(const graph::AdjacencyList<int>& graph, int s)
   int l = 0;
 
   std::vector<int> level_offsets = {0};
-  level_offsets.reserve(graph.offsets().size());
   std::vector<int> level_structure = {s};
-  level_structure.reserve(graph.array().size());
+  level_structure.reserve(graph.num_nodes());
   while (static_cast<int>(level_structure.size()) > level_offsets.back())
   {
     level_offsets.push_back(level_structure.size());
@@ -156,6 +157,13 @@ gps_reorder_unlabelled(const graph::AdjacencyList<std::int32_t>& graph,
   bool done = false;
   int u = 0;
   std::vector<int> S;
+
+  // Level structures are created concurrently in batches of the pool
+  // size. Each level structure has size n, which bounds the memory
+  // used.
+  common::ThreadPool& pool = common::thread_pool();
+  const std::size_t batch_size = pool.size();
+  std::vector<graph::AdjacencyList<int>> lstmp;
   while (!done)
   {
     // Sort final level S of Lv into increasing degree order
@@ -168,26 +176,35 @@ gps_reorder_unlabelled(const graph::AdjacencyList<std::int32_t>& graph,
     done = true;
 
     // C. Generate level structures rooted at vertices s in S selected
-    // in order of increasing degree.
-    for (int s : S)
+    // in order of increasing degree. The level structures of a batch of
+    // vertices are created concurrently and then inspected in order,
+    // which gives the same result as the serial algorithm.
+    common::Timer t("GPS: create_level_structure");
+    for (std::size_t b0 = 0; done and b0 < S.size(); b0 += batch_size)
     {
-      graph::AdjacencyList<int> lstmp = create_level_structure(graph, s);
-      if (lstmp.num_nodes() > lv.num_nodes())
+      const std::size_t b1 = std::min(b0 + batch_size, S.size());
+      lstmp.resize(b1 - b0, graph::AdjacencyList<int>(0));
+      pool.run(b1 - b0, [&](int i)
+               { lstmp[i] = create_level_structure(graph, S[b0 + i]); });
+      for (std::size_t i = 0; i < lstmp.size(); ++i)
       {
-        // Found a deeper level structure, so restart
-        v = s;
-        lv = lstmp;
-        done = false;
-        break;
-      }
+        if (lstmp[i].num_nodes() > lv.num_nodes())
+        {
+          // Found a deeper level structure, so restart
+          v = S[b0 + i];
+          lv = std::move(lstmp[i]);
+          done = false;
+          break;
+        }
 
-      //  D. Let u be the vertex of S whose associated level structure
-      //  has smallest width
-      if (int w = max_level_width(lstmp); w < w_min)
-      {
-        w_min = w;
-        u = s;
-        lu = lstmp;
+        //  D. Let u be the vertex of S whose associated level structure
+        //  has smallest width
+        if (int w = max_level_width(lstmp[i]); w < w_min)
+        {
+          w_min = w;
+          u = S[b0 + i];
+          lu = std::move(lstmp[i]);
+        }
       }
     }
   }
@@ -284,15 +301,16 @@ gps_reorder_unlabelled(const graph::AdjacencyList<std::int32_t>& graph,
   labelled[v] = true;
 
   // Temporary work vectors
-  std::vector<std::int8_t> in_level;
+  std::vector<std::int8_t> in_level(n, false);
   std::vector<int> rv_next;
   std::vector<int> nbr, nbr_next;
   std::vector<int> nrem;
 
   for (const std::vector<int>& lslevel : ls)
   {
-    // Mark all nodes of the current level
-    in_level.assign(n, false);
+    // Mark all nodes of the current level. Only the marks of the level
+    // are reset afterwards, since resetting all n marks for each level
+    // is quadratic for long, thin graphs.
     for (int w : lslevel)
       in_level[w] = true;
 
@@ -348,6 +366,9 @@ gps_reorder_unlabelled(const graph::AdjacencyList<std::int32_t>& graph,
 
     // Insert already-labelled nodes of next level
     rv.insert(rv.end(), rv_next.begin(), rv_next.end());
+
+    for (int w : lslevel)
+      in_level[w] = false;
   }
 
   return rv;
@@ -380,3 +401,69 @@ graph::reorder_gps(const graph::AdjacencyList<std::int32_t>& graph)
   return r;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+graph::reorder_rcm(const graph::AdjacencyList<std::int32_t>& graph)
+{
+  common::Timer t("RCM: reorder");
+
+  const std::int32_t n = graph.num_nodes();
+  std::vector<std::int8_t> labelled(n, false);
+  std::vector<std::int32_t> order;
+  order.reserve(n);
+
+  // Repeat for each disconnected part of the graph, starting from the
+  // unlabelled node of lowest degree
+  std::vector<std::int32_t> nodes(n);
+  std::iota(nodes.begin(), nodes.end(), 0);
+  std::ranges::stable_sort(nodes, std::less<>(), [&graph](auto v)
+                           { return graph.num_links(v); });
+  for (std::int32_t s : nodes)
+  {
+    if (labelled[s])
+      continue;
+
+    // Find a pseudo-peripheral node by moving to a node of minimum
+    // degree in the last level while the eccentricity increases
+    graph::AdjacencyList<int> ls = create_level_structure(graph, s);
+    while (true)
+    {
+      auto last = ls.links(ls.num_nodes() - 1);
+      int v = *std::ranges::min_element(
+          last, std::less<>(), [&graph](auto w) { return graph.num_links(w); });
+      graph::AdjacencyList<int> lv = create_level_structure(graph, v);
+      if (lv.num_nodes() <= ls.num_nodes())
+        break;
+      s = v;
+      ls = std::move(lv);
+    }
+
+    // Breadth-first traversal, adding neighbours by increasing degree
+    std::size_t head = order.size();
+    order.push_back(s);
+    labelled[s] = true;
+    for (; head < order.size(); ++head)
+    {
+      const std::size_t first = order.size();
+      for (std::int32_t w : graph.links(order[head]))
+      {
+        if (!labelled[w])
+        {
+          labelled[w] = true;
+          order.push_back(w);
+        }
+      }
+      std::stable_sort(std::next(order.begin(), first), order.end(),
+                       [&graph](auto w0, auto w1)
+                       { return graph.num_links(w0) < graph.num_links(w1); });
+    }
+  }
+
+  // Reverse the ordering
+  assert(static_cast<std::int32_t>(order.size()) == n);
+  std::vector<std::int32_t> r(n);
+  for (std::int32_t i = 0; i < n; ++i)
+    r[order[i]] = n - 1 - i;
+
+  return r;
+}
+//-----------------------------------------------------------------------------
@@ -20,10 +20,33 @@ class AdjacencyList;
 /// Bandwidth and Profile of a Sparse Matrix*, SIAM Journal on Numerical
 /// Analysis, 13(2): 236-250, 1976, https://doi.org/10.1137/0713023.
 ///
+/// The level structures rooted at the candidate endpoints of the
+/// pseudo-diameter are computed concurrently on the process thread
+/// pool (see common::set_num_threads). The re-ordering does not depend
+/// on the number of threads.
+///
 /// @param[in] graph The graph to compute a re-ordering for
 /// @return Reordering array `map`, where `map[i]` is the new index of
 /// node `i`
 std::vector<std::int32_t>
 reorder_gps(const graph::AdjacencyList<std::int32_t>& graph);
 
+/// @brief Re-order a graph using the reverse Cuthill-McKee algorithm.
+///
+/// Each connected component is traversed breadth-first from a
+/// pseudo-peripheral node, visiting the neighbours of a node in order of
+/// increasing degree, and the resulting ordering is reversed. See
+/// *Computer Solution of Large Sparse Positive Definite Systems*, A.
+/// George and J. W. H. Liu, Prentice-Hall, 1981.
+///
+/// Reverse Cuthill-McKee is cheaper to compute than
+/// Gibbs-Poole-Stockmeyer (reorder_gps), but typically gives a slightly
+/// larger bandwidth.
+///
+/// @param[in] graph The graph to compute a re-ordering for
+/// @return Reordering array `map`, where `map[i]` is the new index of
+/// node `i`
+std::vector<std::int32_t>
+reorder_rcm(const graph::AdjacencyList<std::int32_t>& graph);
+
 } // namespace dolfinx::graph
@@ -8,26 +8,231 @@
 #include "AdjacencyList.h"
 #include "partitioners.h"
 #include <algorithm>
+#include <cmath>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <map>
 #include <memory>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
 
 using namespace dolfinx;
 
+namespace
+{
+/// @brief Send the rows of a row-major array to destination ranks.
+/// @param[in] comm MPI communicator.
+/// @param[in] buffer Rows to send (row-major storage), sorted by
+/// destination rank.
+/// @param[in] shape1 Number of columns of `buffer`.
+/// @param[in] dest Destination rank of each row (sorted).
+/// @return Received rows (row-major storage) and the source rank of
+/// each received row. The rows are ordered by source rank, and rows
+/// from the same source are in the order that they were sent.
+std::pair<std::vector<std::int64_t>, std::vector<int>>
+send_rows(MPI_Comm comm, std::span<const std::int64_t> buffer,
+          std::size_t shape1, std::span<const int> dest)
+{
+  assert(std::ranges::is_sorted(dest));
+
+  // Build list of unique dest ranks and count number of rows to send to
+  // each dest (by neighbourhood rank)
+  std::vector<int> ranks;
+  std::vector<std::int32_t> num_items_per_dest;
+  for (auto it = dest.begin(); it != dest.end();)
+  {
+    auto it1 = std::upper_bound(it, dest.end(), *it);
+    ranks.push_back(*it);
+    num_items_per_dest.push_back(std::distance(it, it1));
+    it = it1;
+  }
+
+  // Determine source ranks. Sort ranks to make distribution
+  // deterministic.
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+
+  // Create neighbourhood communicator
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+
+  // Send number of rows to receivers
+  std::vector<int> num_items_recv(src.size());
+  num_items_per_dest.reserve(1);
+  num_items_recv.reserve(1);
+  MPI_Neighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
+                        num_items_recv.data(), 1, MPI_INT, neigh_comm);
+
+  // Compute send and receive displacements. A rank may receive more
+  // than INT_MAX rows, e.g. when gathering a large mesh, so 64-bit
+  // counts and displacements are used.
+  std::vector<std::int64_t> send_counts(num_items_per_dest.begin(),
+                                        num_items_per_dest.end());
+  std::vector<std::int64_t> recv_counts(num_items_recv.begin(),
+                                        num_items_recv.end());
+  std::vector<std::int64_t> send_disp(send_counts.size() + 1, 0);
+  std::partial_sum(send_counts.begin(), send_counts.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int64_t> recv_disp(recv_counts.size() + 1, 0);
+  std::partial_sum(recv_counts.begin(), recv_counts.end(),
+                   std::next(recv_disp.begin()));
+
+  // Send/receive rows
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(shape1, MPI_INT64_T, &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<std::int64_t> recv_buffer(shape1 * recv_disp.back());
+  int err = dolfinx::MPI::neighbor_alltoallv(
+      buffer.data(), send_counts, send_disp, recv_buffer.data(), recv_counts,
+      recv_disp, compound_type, neigh_comm);
+  dolfinx::MPI::check_error(comm, err);
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm);
+
+  std::vector<int> src_ranks(recv_disp.back());
+  for (std::size_t p = 0; p < src.size(); ++p)
+  {
+    std::fill(std::next(src_ranks.begin(), recv_disp[p]),
+              std::next(src_ranks.begin(), recv_disp[p + 1]), src[p]);
+  }
+
+  return {std::move(recv_buffer), std::move(src_ranks)};
+}
+
+/// @brief Stable sort of the rows of a row-major array by a key.
+/// @param[in,out] x Rows (row-major storage).
+/// @param[in] shape1 Number of columns of `x`.
+/// @param[in,out] key Key of each row. It is sorted on return.
+void sort_rows(std::vector<std::int64_t>& x, std::size_t shape1,
+               std::vector<int>& key)
+{
+  std::vector<std::int32_t> perm(key.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [&key](auto a, auto b)
+                           { return key[a] < key[b]; });
+  std::vector<std::int64_t> x1(x.size());
+  std::vector<int> key1(key.size());
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    std::copy_n(std::next(x.begin(), perm[i] * shape1), shape1,
+                std::next(x1.begin(), i * shape1));
+    key1[i] = key[perm[i]];
+  }
+  x = std::move(x1);
+  key = std::move(key1);
+}
+
+/// @brief Send the rows of a row-major array to destination ranks,
+/// directly or through an intermediate rank (see
+/// graph::build::routing).
+///
+/// The received data is the same as for graph::build::routing::direct.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] buffer Rows to send (row-major storage), sorted by
+/// destination rank.
+/// @param[in] shape1 Number of columns of `buffer`.
+/// @param[in] dest Destination rank of each row (sorted).
+/// @param[in] route Routing of the rows.
+/// @return Received rows (row-major storage) and the source rank of
+/// each received row, see send_rows.
+std::pair<std::vector<std::int64_t>, std::vector<int>>
+exchange_rows(MPI_Comm comm, std::span<const std::int64_t> buffer,
+              std::size_t shape1, std::span<const int> dest,
+              graph::build::routing route)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const int q = std::ceil(std::sqrt(static_cast<double>(size)));
+  if (route == graph::build::routing::automatic)
+  {
+    int num_dest = 0;
+    for (auto it = dest.begin(); it != dest.end();
+         it = std::upper_bound(it, dest.end(), *it))
+    {
+      ++num_dest;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &num_dest, 1, MPI_INT, MPI_MAX, comm);
+    route = num_dest > 2 * q ? graph::build::routing::two_phase
+                             : graph::build::routing::direct;
+  }
+
+  if (route == graph::build::routing::direct)
+    return send_rows(comm, buffer, shape1, dest);
+
+  spdlog::info("Send rows with two-phase routing");
+
+  // Append the source and destination rank to each row, and compute
+  // the intermediate rank in the row of this rank and the column of the
+  // destination. If the intermediate rank does not exist (last row of
+  // the grid), the row is sent directly.
+  const std::size_t num_rows = dest.size();
+  const std::size_t shape1_r = shape1 + 2;
+  std::vector<std::int64_t> rows(shape1_r * num_rows);
+  std::vector<int> mid(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i)
+  {
+    std::copy_n(std::next(buffer.begin(), i * shape1), shape1,
+                std::next(rows.begin(), i * shape1_r));
+    rows[i * shape1_r + shape1] = rank;
+    rows[i * shape1_r + shape1 + 1] = dest[i];
+    int m = (rank / q) * q + dest[i] % q;
+    mid[i] = m < size ? m : dest[i];
+  }
+
+  // Send rows to the intermediate ranks
+  sort_rows(rows, shape1_r, mid);
+  auto [rows1, src1] = send_rows(comm, rows, shape1_r, mid);
+  rows = std::vector<std::int64_t>();
+
+  // Forward the rows to the destination ranks
+  std::vector<int> dest1(rows1.size() / shape1_r);
+  for (std::size_t i = 0; i < dest1.size(); ++i)
+    dest1[i] = rows1[i * shape1_r + shape1 + 1];
+  sort_rows(rows1, shape1_r, dest1);
+  auto [rows2, src2] = send_rows(comm, rows1, shape1_r, dest1);
+  rows1 = std::vector<std::int64_t>();
+
+  // Order the received rows by source rank and remove the appended
+  // ranks. All rows from a source rank are received through the same
+  // intermediate rank, so the order of the rows of a source is
+  // retained.
+  std::vector<int> src(rows2.size() / shape1_r);
+  for (std::size_t i = 0; i < src.size(); ++i)
+    src[i] = rows2[i * shape1_r + shape1];
+  sort_rows(rows2, shape1_r, src);
+  std::vector<std::int64_t> recv_buffer(shape1 * src.size());
+  for (std::size_t i = 0; i < src.size(); ++i)
+  {
+    std::copy_n(std::next(rows2.begin(), i * shape1_r), shape1,
+                std::next(recv_buffer.begin(), i * shape1));
+  }
+
+  return {std::move(recv_buffer), std::move(src)};
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 graph::AdjacencyList<std::int32_t>
 graph::partition_graph(MPI_Comm comm, int nparts,
                        const AdjacencyList<std::int64_t>& local_graph,
-                       bool ghosting)
+                       bool ghosting,
+                       std::span<const std::int32_t> node_weights)
 {
 #if HAS_PARMETIS
-  return graph::parmetis::partitioner()(comm, nparts, local_graph, ghosting);
+  return graph::parmetis::partitioner()(comm, nparts, local_graph, ghosting,
+                                        node_weights);
 #elif HAS_PTSCOTCH
-  return graph::scotch::partitioner()(comm, nparts, local_graph, ghosting);
+  return graph::scotch::partitioner()(comm, nparts, local_graph, ghosting,
+                                      node_weights);
 #elif HAS_KAHIP
-  return graph::kahip::partitioner()(comm, nparts, local_graph, ghosting);
+  return graph::kahip::partitioner()(comm, nparts, local_graph, ghosting,
+                                     node_weights);
 #else
 // Should never reach this point
 #endif
@@ -37,7 +242,8 @@ std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 graph::build::distribute(MPI_Comm comm,
                          const graph::AdjacencyList<std::int64_t>& list,
-                         const graph::AdjacencyList<std::int32_t>& destinations)
+                         const graph::AdjacencyList<std::int32_t>& destinations,
+                         routing route)
 {
   common::Timer timer("Distribute AdjacencyList nodes to destination ranks");
 
@@ -76,132 +282,69 @@ graph::build::distribute(MPI_Comm comm,
   }
   std::ranges::sort(dest_to_index);
 
-  // Build list of unique dest ranks and count number of rows to send to
-  // each dest (by neighbourhood rank)
-  std::vector<int> dest;
-  std::vector<std::int32_t> num_items_per_dest;
-  {
-    auto it = dest_to_index.begin();
-    while (it != dest_to_index.end())
-    {
-      // Store global rank and find iterator to next global rank
-      dest.push_back(it->front());
-      auto it1
-          = std::find_if(it, dest_to_index.end(),
-                         [r = dest.back()](auto idx) { return idx[0] != r; });
-
-      // Store number of items for current rank
-      num_items_per_dest.push_back(std::distance(it, it1));
-
-      // Advance iterator
-      it = it1;
-    }
-  }
-
-  // Determine source ranks. Sort ranks to make distribution
-  // deterministic.
-  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
-  std::ranges::sort(src);
-
-  // Create neighbourhood communicator
-  MPI_Comm neigh_comm;
-  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
-                                 dest.size(), dest.data(), MPI_UNWEIGHTED,
-                                 MPI_INFO_NULL, false, &neigh_comm);
-
-  // Send number of nodes to receivers
-  std::vector<int> num_items_recv(src.size());
-  num_items_per_dest.reserve(1);
-  num_items_recv.reserve(1);
-  MPI_Request request_size;
-  MPI_Ineighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
-                         num_items_recv.data(), 1, MPI_INT, neigh_comm,
-                         &request_size);
-
-  // Compute send displacements
-  std::vector<std::int32_t> send_disp(num_items_per_dest.size() + 1, 0);
-  std::partial_sum(num_items_per_dest.begin(), num_items_per_dest.end(),
-                   std::next(send_disp.begin()));
-
   // Pack send buffer
-  std::vector<std::int64_t> send_buffer(buffer_shape1 * send_disp.back(), -1);
+  std::vector<std::int64_t> send_buffer(buffer_shape1 * dest_to_index.size(),
+                                        -1);
+  std::vector<int> dest(dest_to_index.size());
+  for (std::size_t i = 0; i < dest_to_index.size(); ++i)
   {
-    assert(send_disp.back() == (std::int32_t)dest_to_index.size());
-    for (std::size_t i = 0; i < dest_to_index.size(); ++i)
-    {
-      const std::array<int, 3>& dest_data = dest_to_index[i];
-      const std::size_t pos = dest_data[1];
-
-      std::span b(send_buffer.data() + i * buffer_shape1, buffer_shape1);
-      auto row = list.links(pos);
-      std::ranges::copy(row, b.begin());
-
-      auto info = b.last(3);
-      info[0] = row.size();          // Number of edges for node
-      info[1] = dest_data[2];        // Owning rank
-      info[2] = pos + offset_global; // Original global index
-    }
+    const std::array<int, 3>& dest_data = dest_to_index[i];
+    dest[i] = dest_data[0];
+    const std::size_t pos = dest_data[1];
+
+    std::span b(send_buffer.data() + i * buffer_shape1, buffer_shape1);
+    auto row = list.links(pos);
+    std::ranges::copy(row, b.begin());
+
+    auto info = b.last(3);
+    info[0] = row.size();          // Number of edges for node
+    info[1] = dest_data[2];        // Owning rank
+    info[2] = pos + offset_global; // Original global index
   }
 
-  // Prepare receive displacement
-  MPI_Wait(&request_size, MPI_STATUS_IGNORE);
-  std::vector<std::int32_t> recv_disp(num_items_recv.size() + 1, 0);
-  std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
-                   std::next(recv_disp.begin()));
-
-  // Send/receive data facet
-  MPI_Datatype compound_type;
-  MPI_Type_contiguous(buffer_shape1, MPI_INT64_T, &compound_type);
-  MPI_Type_commit(&compound_type);
-  std::vector<std::int64_t> recv_buffer(buffer_shape1 * recv_disp.back());
-  MPI_Neighbor_alltoallv(send_buffer.data(), num_items_per_dest.data(),
-                         send_disp.data(), compound_type, recv_buffer.data(),
-                         num_items_recv.data(), recv_disp.data(), compound_type,
-                         neigh_comm);
-  MPI_Type_free(&compound_type);
-  MPI_Comm_free(&neigh_comm);
+  // Send/receive data
+  auto [recv_buffer, recv_src]
+      = exchange_rows(comm, send_buffer, buffer_shape1, dest, route);
 
   // Unpack receive buffer
+  const std::size_t num_recv = recv_src.size();
   std::vector<int> src_ranks, src_ranks1, ghost_index_owner;
-  src_ranks.reserve(recv_disp.back());
-  src_ranks1.reserve(recv_disp.back());
+  src_ranks.reserve(num_recv);
+  src_ranks1.reserve(num_recv);
 
   std::vector<std::int64_t> data, data1;
-  data.reserve((buffer_shape1 - 3) * recv_disp.back());
-  data1.reserve((buffer_shape1 - 3) * recv_disp.back());
+  data.reserve((buffer_shape1 - 3) * num_recv);
+  data1.reserve((buffer_shape1 - 3) * num_recv);
 
   std::vector<std::int32_t> offsets{0}, offsets1{0};
-  offsets.reserve(recv_disp.back());
-  offsets1.reserve(recv_disp.back());
+  offsets.reserve(num_recv);
+  offsets1.reserve(num_recv);
 
   std::vector<std::int64_t> global_indices, global_indices1;
-  global_indices.reserve(recv_disp.back());
-  global_indices1.reserve(recv_disp.back());
-  for (std::size_t p = 0; p < recv_disp.size() - 1; ++p)
+  global_indices.reserve(num_recv);
+  global_indices1.reserve(num_recv);
+  for (std::size_t i = 0; i < num_recv; ++i)
   {
-    const int src_rank = src[p];
-    for (std::int32_t i = recv_disp[p]; i < recv_disp[p + 1]; ++i)
+    const int src_rank = recv_src[i];
+    std::span row(recv_buffer.data() + i * buffer_shape1, buffer_shape1);
+    auto info = row.last(3);
+    std::size_t num_edges = info[0];
+    std::int64_t orig_global_index = info[2];
+    auto edges = row.first(num_edges);
+    if (int owner = info[1]; owner == rank)
     {
-      std::span row(recv_buffer.data() + i * buffer_shape1, buffer_shape1);
-      auto info = row.last(3);
-      std::size_t num_edges = info[0];
-      std::int64_t orig_global_index = info[2];
-      auto edges = row.first(num_edges);
-      if (int owner = info[1]; owner == rank)
-      {
-        data.insert(data.end(), edges.begin(), edges.end());
-        offsets.push_back(offsets.back() + num_edges);
-        src_ranks.push_back(src_rank);
-        global_indices.push_back(orig_global_index);
-      }
-      else
-      {
-        data1.insert(data1.end(), edges.begin(), edges.end());
-        offsets1.push_back(offsets1.back() + info[0]);
-        src_ranks1.push_back(src_rank);
-        global_indices1.push_back(orig_global_index);
-        ghost_index_owner.push_back(info[1]);
-      }
+      data.insert(data.end(), edges.begin(), edges.end());
+      offsets.push_back(offsets.back() + num_edges);
+      src_ranks.push_back(src_rank);
+      global_indices.push_back(orig_global_index);
+    }
+    else
+    {
+      data1.insert(data1.end(), edges.begin(), edges.end());
+      offsets1.push_back(offsets1.back() + info[0]);
+      src_ranks1.push_back(src_rank);
+      global_indices1.push_back(orig_global_index);
+      ghost_index_owner.push_back(info[1]);
     }
   }
 
@@ -229,7 +372,8 @@ std::tuple<std::vector<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 graph::build::distribute(MPI_Comm comm, std::span<const std::int64_t> list,
                          std::array<std::size_t, 2> shape,
-                         const graph::AdjacencyList<std::int32_t>& destinations)
+                         const graph::AdjacencyList<std::int32_t>& destinations,
+                         routing route)
 {
   common::Timer timer(
       "Distribute fixed-degree adjacency list to destination ranks");
@@ -260,120 +404,56 @@ graph::build::distribute(MPI_Comm comm, std::span<const std::int64_t> list,
   }
   std::ranges::sort(dest_to_index);
 
-  // Build list of unique dest ranks and count number of rows to send to
-  // each dest (by neighbourhood rank)
-  std::vector<int> dest;
-  std::vector<std::int32_t> num_items_per_dest;
-  {
-    auto it = dest_to_index.begin();
-    while (it != dest_to_index.end())
-    {
-      // Store global rank and find iterator to next global rank
-      dest.push_back(it->front());
-      auto it1
-          = std::find_if(it, dest_to_index.end(),
-                         [r = dest.back()](auto& idx) { return idx[0] != r; });
-
-      // Store number of items for current rank
-      num_items_per_dest.push_back(std::distance(it, it1));
-
-      // Advance iterator
-      it = it1;
-    }
-  }
-
-  // Determine source ranks. Sort ranks to make distribution
-  // deterministic.
-  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
-  std::ranges::sort(src);
-
-  // Create neighbourhood communicator
-  MPI_Comm neigh_comm;
-  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
-                                 dest.size(), dest.data(), MPI_UNWEIGHTED,
-                                 MPI_INFO_NULL, false, &neigh_comm);
-
-  // Send number of nodes to receivers
-  std::vector<int> num_items_recv(src.size());
-  num_items_per_dest.reserve(1);
-  num_items_recv.reserve(1);
-  MPI_Request request_size;
-  MPI_Ineighbor_alltoall(num_items_per_dest.data(), 1, MPI_INT,
-                         num_items_recv.data(), 1, MPI_INT, neigh_comm,
-                         &request_size);
-
-  // Compute send displacements
-  std::vector<std::int32_t> send_disp(num_items_per_dest.size() + 1, 0);
-  std::partial_sum(num_items_per_dest.begin(), num_items_per_dest.end(),
-                   std::next(send_disp.begin()));
-
   // Pack send buffer
-  std::vector<std::int64_t> send_buffer(buffer_shape1 * send_disp.back(), -1);
+  std::vector<std::int64_t> send_buffer(buffer_shape1 * dest_to_index.size(),
+                                        -1);
+  std::vector<int> dest(dest_to_index.size());
+  for (std::size_t i = 0; i < dest_to_index.size(); ++i)
   {
-    assert(send_disp.back() == (std::int32_t)dest_to_index.size());
-    for (std::size_t i = 0; i < dest_to_index.size(); ++i)
-    {
-      std::array<int, 3> dest_data = dest_to_index[i];
-      const std::size_t pos = dest_data[1];
+    std::array<int, 3> dest_data = dest_to_index[i];
+    dest[i] = dest_data[0];
+    const std::size_t pos = dest_data[1];
 
-      std::span b(send_buffer.data() + i * buffer_shape1, buffer_shape1);
-      std::span row(list.data() + pos * shape[1], shape[1]);
-      std::ranges::copy(row, b.begin());
+    std::span b(send_buffer.data() + i * buffer_shape1, buffer_shape1);
+    std::span row(list.data() + pos * shape[1], shape[1]);
+    std::ranges::copy(row, b.begin());
 
-      auto info = b.last(2);
-      info[0] = dest_data[2];        // Owning rank
-      info[1] = pos + offset_global; // Original global index
-    }
+    auto info = b.last(2);
+    info[0] = dest_data[2];        // Owning rank
+    info[1] = pos + offset_global; // Original global index
   }
 
-  // Prepare receive displacement
-  MPI_Wait(&request_size, MPI_STATUS_IGNORE);
-  std::vector<std::int32_t> recv_disp(num_items_recv.size() + 1, 0);
-  std::partial_sum(num_items_recv.begin(), num_items_recv.end(),
-                   std::next(recv_disp.begin()));
-
-  // Send/receive data facet
-  MPI_Datatype compound_type;
-  MPI_Type_contiguous(buffer_shape1, MPI_INT64_T, &compound_type);
-  MPI_Type_commit(&compound_type);
-  std::vector<std::int64_t> recv_buffer(buffer_shape1 * recv_disp.back());
-  MPI_Neighbor_alltoallv(send_buffer.data(), num_items_per_dest.data(),
-                         send_disp.data(), compound_type, recv_buffer.data(),
-                         num_items_recv.data(), recv_disp.data(), compound_type,
-                         neigh_comm);
-  MPI_Type_free(&compound_type);
-  MPI_Comm_free(&neigh_comm);
+  // Send/receive data
+  auto [recv_buffer, recv_src]
+      = exchange_rows(comm, send_buffer, buffer_shape1, dest, route);
 
-  spdlog::debug("Received {} data on {} [{}]", recv_disp.back(), rank,
-                shape[1]);
+  DOLFINX_LOG_DEBUG("Received {} data on {} [{}]", recv_src.size(), rank,
+                    shape[1]);
 
   // Unpack receive buffer
   std::vector<std::int64_t> data, data1;
   std::vector<int> ghost_index_owner;
   std::vector<std::int64_t> global_indices, global_indices1;
   std::vector<int> src_ranks, src_ranks1;
-  for (std::size_t p = 0; p < recv_disp.size() - 1; ++p)
+  for (std::size_t q = 0; q < recv_src.size(); ++q)
   {
-    int src_rank = src[p];
-    for (std::int32_t q = recv_disp[p]; q < recv_disp[p + 1]; ++q)
+    int src_rank = recv_src[q];
+    std::span row(recv_buffer.data() + q * buffer_shape1, buffer_shape1);
+    auto info = row.last(2);
+    std::int64_t orig_global_index = info[1];
+    auto edges = row.first(shape[1]);
+    if (int owner = info[0]; owner == rank)
     {
-      std::span row(recv_buffer.data() + q * buffer_shape1, buffer_shape1);
-      auto info = row.last(2);
-      std::int64_t orig_global_index = info[1];
-      auto edges = row.first(shape[1]);
-      if (int owner = info[0]; owner == rank)
-      {
-        data.insert(data.end(), edges.begin(), edges.end());
-        global_indices.push_back(orig_global_index);
-        src_ranks.push_back(src_rank);
-      }
-      else
-      {
-        data1.insert(data1.end(), edges.begin(), edges.end());
-        global_indices1.push_back(orig_global_index);
-        ghost_index_owner.push_back(owner);
-        src_ranks1.push_back(src_rank);
-      }
+      data.insert(data.end(), edges.begin(), edges.end());
+      global_indices.push_back(orig_global_index);
+      src_ranks.push_back(src_rank);
+    }
+    else
+    {
+      data1.insert(data1.end(), edges.begin(), edges.end());
+      global_indices1.push_back(orig_global_index);
+      ghost_index_owner.push_back(owner);
+      src_ranks1.push_back(src_rank);
     }
   }
 
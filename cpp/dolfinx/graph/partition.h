@@ -27,9 +27,13 @@ namespace dolfinx::graph
 /// @param[in] local_graph Node connectivity graph
 /// @param[in] ghosting Flag to enable ghosting of the output node
 /// distribution
+/// @param[in] node_weights Weight of each node in `local_graph`. If
+/// empty on all processes, all nodes have the same weight. The
+/// partitions balance the sum of the node weights.
 /// @return Destination rank for each input node
 using partition_fn = std::function<graph::AdjacencyList<std::int32_t>(
-    MPI_Comm, int, const AdjacencyList<std::int64_t>&, bool)>;
+    MPI_Comm, int, const AdjacencyList<std::int64_t>&, bool,
+    std::span<const std::int32_t>)>;
 
 /// @brief Partition graph across processes using the default graph
 /// partitioner.
@@ -40,16 +44,38 @@ using partition_fn = std::function<graph::AdjacencyList<std::int32_t>(
 /// @param[in] local_graph Node connectivity graph.
 /// @param[in] ghosting Flag to enable ghosting of the output node
 /// distribution.
+/// @param[in] node_weights Weight of each node in `local_graph`, or
+/// empty for nodes with the same weight.
 /// @return Destination rank for each input node.
 AdjacencyList<std::int32_t>
 partition_graph(MPI_Comm comm, int nparts,
-                const AdjacencyList<std::int64_t>& local_graph, bool ghosting);
+                const AdjacencyList<std::int64_t>& local_graph, bool ghosting,
+                std::span<const std::int32_t> node_weights = {});
 
 /// Tools for distributed graphs
 ///
 /// @todo Add a function that sends data to the 'owner'
 namespace build
 {
+/// @brief Routing of the data that is sent by graph::build::distribute.
+///
+/// With two-phase routing, the ranks are arranged in a grid with
+/// `ceil(sqrt(size))` columns. Data is first sent to the rank in the
+/// row of the sender and the column of the destination, which forwards
+/// it to the destination. Each rank then communicates with
+/// `O(sqrt(size))` ranks, instead of up to `size` ranks when data is
+/// sent directly, at the cost of sending the data twice. This is
+/// beneficial when the initial distribution of the data is unrelated
+/// to the destinations, e.g. when reading a mesh on a very large
+/// number of ranks. Automatic routing uses two-phase routing if a rank
+/// sends data to more than `2 ceil(sqrt(size))` ranks.
+enum class routing
+{
+  automatic, ///< Two-phase routing if a rank sends to many ranks
+  direct,    ///< Send data directly to the destination ranks
+  two_phase  ///< Route data through an intermediate rank
+};
+
 /// @brief Distribute adjacency list nodes to destination ranks.
 ///
 /// The global index of each node is assumed to be the local index plus
@@ -59,6 +85,8 @@ namespace build
 /// @param[in] list The adjacency list to distribute
 /// @param[in] destinations Destination ranks for the ith node in the
 /// adjacency list. The first rank is the 'owner' of the node.
+/// @param[in] route Routing of the data to the destination ranks. The
+/// returned data does not depend on the routing.
 /// @return
 /// 1. Received adjacency list for this process
 /// 2. Source ranks for each node in the adjacency list
@@ -67,7 +95,8 @@ namespace build
 std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 distribute(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& list,
-           const graph::AdjacencyList<std::int32_t>& destinations);
+           const graph::AdjacencyList<std::int32_t>& destinations,
+           routing route = routing::automatic);
 
 /// @brief Distribute fixed size nodes to destination ranks.
 ///
@@ -80,6 +109,8 @@ distribute(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& list,
 /// @param[in] shape Shape `(num_nodes, degree)` of `list`.
 /// @param[in] destinations Destination ranks for the ith node (row) of
 /// `list`. The first rank is the 'owner' of the node.
+/// @param[in] route Routing of the data to the destination ranks. The
+/// returned data does not depend on the routing.
 /// @return
 /// 1. Received adjacency list on this process. The array shape is
 /// (num_nodes, degree). Storage is row-major.
@@ -90,7 +121,8 @@ std::tuple<std::vector<std::int64_t>, std::vector<int>,
            std::vector<std::int64_t>, std::vector<int>>
 distribute(MPI_Comm comm, std::span<const std::int64_t> list,
            std::array<std::size_t, 2> shape,
-           const graph::AdjacencyList<std::int32_t>& destinations);
+           const graph::AdjacencyList<std::int32_t>& destinations,
+           routing route = routing::automatic);
 
 /// @brief Take a set of distributed input global indices, including
 /// ghosts, and determine the new global indices after remapping.
@@ -6,13 +6,21 @@
 
 #include "partitioners.h"
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <set>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #ifdef HAS_PTSCOTCH
@@ -37,6 +45,35 @@ using namespace dolfinx;
 
 namespace
 {
+/// @brief Check graph node weights, and determine if node weights are
+/// used.
+///
+/// @note Collective
+///
+/// @param[in] comm The communicator
+/// @param[in] graph The graph that is partitioned
+/// @param[in] node_weights Weights of the (local) nodes of `graph`
+/// @return True if node weights are provided on any process
+[[maybe_unused]] bool
+check_node_weights(MPI_Comm comm,
+                   const graph::AdjacencyList<std::int64_t>& graph,
+                   std::span<const std::int32_t> node_weights)
+{
+  if (!node_weights.empty()
+      and node_weights.size() != std::size_t(graph.num_nodes()))
+  {
+    throw std::runtime_error("Number of node weights does not match number of "
+                             "graph nodes.");
+  }
+
+  int weighted = !node_weights.empty();
+  MPI_Allreduce(MPI_IN_PLACE, &weighted, 1, MPI_INT, MPI_MAX, comm);
+  if (weighted and node_weights.empty() and graph.num_nodes() > 0)
+    throw std::runtime_error("Node weights are missing on a process.");
+
+  return weighted;
+}
+//-----------------------------------------------------------------------------
 /// @todo Is it un-documented that the owning rank must come first in
 /// reach list of edges?
 ///
@@ -304,6 +341,46 @@ std::vector<int> refine(MPI_Comm comm, const graph::AdjacencyList<T>& adj_graph)
   //-----------------------------------------------------------------------------
 }
 #endif
+
+/// Convert grid coordinates to the 'transpose' of the Hilbert index
+/// (J. Skilling, Programming the Hilbert curve, AIP Conference
+/// Proceedings 707, 381, 2004, https://doi.org/10.1063/1.1751381).
+/// @param[in,out] X Grid coordinates, each with `b` bits.
+/// @param[in] b Number of bits per coordinate.
+/// @param[in] n Number of coordinates.
+void axes_to_transpose(std::array<std::uint32_t, 3>& X, int b, int n)
+{
+  const std::uint32_t M = std::uint32_t(1) << (b - 1);
+
+  // Inverse undo
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    const std::uint32_t P = Q - 1;
+    for (int i = 0; i < n; ++i)
+    {
+      if (X[i] & Q)
+        X[0] ^= P;
+      else
+      {
+        std::uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < n; ++i)
+    X[i] ^= X[i - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+  {
+    if (X[n - 1] & Q)
+      t ^= Q - 1;
+  }
+  for (int i = 0; i < n; ++i)
+    X[i] ^= t;
+}
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -311,13 +388,16 @@ std::vector<int> refine(MPI_Comm comm, const graph::AdjacencyList<T>& adj_graph)
 graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
                                                double imbalance, int seed)
 {
-  return [imbalance, strategy, seed](MPI_Comm comm, int nparts,
-                                     const AdjacencyList<std::int64_t>& graph,
-                                     bool ghosting)
+  return [imbalance, strategy, seed](
+             MPI_Comm comm, int nparts,
+             const AdjacencyList<std::int64_t>& graph, bool ghosting,
+             std::span<const std::int32_t> node_weights)
   {
     spdlog::info("Compute graph partition using PT-SCOTCH");
     common::Timer timer("Compute graph partition (SCOTCH)");
 
+    const bool weighted = check_node_weights(comm, graph, node_weights);
+
     std::int64_t offset_global = 0;
     const std::int64_t num_owned = graph.num_nodes();
     MPI_Request request_offset_scan;
@@ -339,14 +419,16 @@ graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
     if (err != 0)
       throw std::runtime_error("Error initializing SCOTCH graph");
 
-    // FIXME: If the nodes have weights but this rank has no nodes, then
-    //        SCOTCH may deadlock since vload.data() will be nullptr on
-    //        this rank but not null on all other ranks.
-    // Handle node weights (disabled for now)
-    std::vector<SCOTCH_Num> node_weights;
+    // Node weights. If the nodes have weights but this rank has no
+    // nodes, SCOTCH may deadlock if vload.data() is nullptr on this rank
+    // but not on other ranks, so storage is reserved to get a non-null
+    // pointer.
     std::vector<SCOTCH_Num> vload;
-    if (!node_weights.empty())
+    if (weighted)
+    {
+      vload.reserve(std::max<std::size_t>(1, node_weights.size()));
       vload.assign(node_weights.begin(), node_weights.end());
+    }
 
     // Set seed and reset SCOTCH random number generator to produce
     // deterministic partitions on repeated calls
@@ -358,8 +440,9 @@ graph::partition_fn graph::scotch::partitioner(graph::scotch::strategy strategy,
     common::Timer timer1("SCOTCH: call SCOTCH_dgraphBuild");
     err = SCOTCH_dgraphBuild(
         &dgrafdat, baseval, graph.num_nodes(), graph.num_nodes(),
-        vertloctab.data(), nullptr, vload.data(), nullptr, edgeloctab.size(),
-        edgeloctab.size(), edgeloctab.data(), nullptr, nullptr);
+        vertloctab.data(), nullptr, weighted ? vload.data() : nullptr,
+        nullptr, edgeloctab.size(), edgeloctab.size(), edgeloctab.data(),
+        nullptr, nullptr);
     if (err != 0)
       throw std::runtime_error("Error building SCOTCH graph");
     timer1.stop();
@@ -518,11 +601,14 @@ graph::partition_fn graph::parmetis::partitioner(double imbalance,
 {
   return [imbalance, options](MPI_Comm comm, idx_t nparts,
                               const graph::AdjacencyList<std::int64_t>& graph,
-                              bool ghosting)
+                              bool ghosting,
+                              std::span<const std::int32_t> node_weights)
   {
     spdlog::info("Compute graph partition using ParMETIS");
     common::Timer timer("Compute graph partition (ParMETIS)");
 
+    const bool weighted = check_node_weights(comm, graph, node_weights);
+
     if (nparts == 1 and dolfinx::MPI::size(comm) == 1)
     {
       // Nothing to be partitioned
@@ -564,8 +650,8 @@ graph::partition_fn graph::parmetis::partitioner(double imbalance,
       // Options and data for ParMETIS
       std::array<idx_t, 3> opts = {options[0], options[1], options[2]};
       idx_t ncon = 1;
-      idx_t* elmwgt = nullptr;
-      idx_t wgtflag(0), edgecut(0), numflag(0);
+      std::vector<idx_t> vwgt(node_weights.begin(), node_weights.end());
+      idx_t wgtflag(weighted ? 2 : 0), edgecut(0), numflag(0);
       std::vector<real_t> tpwgts(ncon * nparts,
                                  1.0 / static_cast<real_t>(nparts));
       real_t ubvec = static_cast<real_t>(imbalance);
@@ -573,9 +659,10 @@ graph::partition_fn graph::parmetis::partitioner(double imbalance,
       // Partition
       common::Timer timer1("ParMETIS: call ParMETIS_V3_PartKway");
       int err = ParMETIS_V3_PartKway(
-          node_disp.data(), offsets.data(), array.data(), elmwgt, nullptr,
-          &wgtflag, &numflag, &ncon, &nparts, tpwgts.data(), &ubvec,
-          opts.data(), &edgecut, part.data(), &pcomm);
+          node_disp.data(), offsets.data(), array.data(),
+          weighted ? vwgt.data() : nullptr, nullptr, &wgtflag, &numflag,
+          &ncon, &nparts, tpwgts.data(), &ubvec, opts.data(), &edgecut,
+          part.data(), &pcomm);
       if (err != METIS_OK)
       {
         throw std::runtime_error("ParMETIS_V3_PartKway failed. Error code: "
@@ -602,6 +689,101 @@ graph::partition_fn graph::parmetis::partitioner(double imbalance,
   };
 }
 //-----------------------------------------------------------------------------
+graph::partition_fn
+graph::parmetis::adaptive_partitioner(double itr, double imbalance,
+                                      std::array<int, 2> options)
+{
+  return [itr, imbalance,
+          options](MPI_Comm comm, idx_t nparts,
+                   const graph::AdjacencyList<std::int64_t>& graph,
+                   bool ghosting, std::span<const std::int32_t> node_weights)
+  {
+    spdlog::info("Compute graph repartition using ParMETIS");
+    common::Timer timer("Compute graph repartition (ParMETIS)");
+
+    const int rank = dolfinx::MPI::rank(comm);
+    if (nparts != dolfinx::MPI::size(comm))
+    {
+      throw std::runtime_error("ParMETIS adaptive repartitioning requires "
+                               "one part per rank.");
+    }
+
+    const bool weighted = check_node_weights(comm, graph, node_weights);
+
+    if (nparts == 1)
+    {
+      // Nothing to be partitioned
+      return regular_adjacency_list(
+          std::vector<std::int32_t>(graph.num_nodes(), 0), 1);
+    }
+
+    // Note: ParMETIS fails (crashes) if a rank does not have any graph
+    // data, so the communicator is split such that only ranks that have
+    // data take part. The current partition is therefore passed
+    // explicitly ('uncoupled' mode) using the ranks of comm.
+    MPI_Comm pcomm = MPI_COMM_NULL;
+    {
+      int color = graph.num_nodes() > 0 ? 1 : MPI_UNDEFINED;
+      int ierr = MPI_Comm_split(comm, color, rank, &pcomm);
+      dolfinx::MPI::check_error(comm, ierr);
+    }
+
+    std::vector<idx_t> part(graph.num_nodes(), rank);
+    if (pcomm == MPI_COMM_NULL)
+      return regular_adjacency_list(std::vector<int>(), 1);
+
+    // Build adjacency list data
+    const int psize = dolfinx::MPI::size(pcomm);
+    const idx_t num_local_nodes = graph.num_nodes();
+    std::vector<idx_t> node_disp(psize + 1, 0);
+    MPI_Allgather(&num_local_nodes, 1, dolfinx::MPI::mpi_t<idx_t>,
+                  node_disp.data() + 1, 1, dolfinx::MPI::mpi_t<idx_t>, pcomm);
+    std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+    std::vector<idx_t> array(graph.array().begin(), graph.array().end());
+    std::vector<idx_t> offsets(graph.offsets().begin(),
+                               graph.offsets().end());
+
+    // Options and data for ParMETIS
+    std::array<idx_t, 4> opts
+        = {1, options[0], options[1], PARMETIS_PSR_UNCOUPLED};
+    idx_t ncon = 1;
+    std::vector<idx_t> vwgt(node_weights.begin(), node_weights.end());
+    idx_t wgtflag(weighted ? 2 : 0), edgecut(0), numflag(0);
+    std::vector<real_t> tpwgts(ncon * nparts,
+                               1.0 / static_cast<real_t>(nparts));
+    real_t ubvec = static_cast<real_t>(imbalance);
+    real_t ipc2redist = static_cast<real_t>(itr);
+
+    // Repartition
+    common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
+    int err = ParMETIS_V3_AdaptiveRepart(
+        node_disp.data(), offsets.data(), array.data(),
+        weighted ? vwgt.data() : nullptr, nullptr, nullptr, &wgtflag,
+        &numflag, &ncon, &nparts, tpwgts.data(), &ubvec, &ipc2redist,
+        opts.data(), &edgecut, part.data(), &pcomm);
+    if (err != METIS_OK)
+    {
+      MPI_Comm_free(&pcomm);
+      throw std::runtime_error("ParMETIS_V3_AdaptiveRepart failed. Error code: "
+                               + std::to_string(err));
+    }
+
+    if (ghosting)
+    {
+      graph::AdjacencyList<int> dest
+          = compute_destination_ranks(pcomm, graph, node_disp, part);
+      MPI_Comm_free(&pcomm);
+      return dest;
+    }
+    else
+    {
+      MPI_Comm_free(&pcomm);
+      return regular_adjacency_list(std::vector<int>(part.begin(), part.end()),
+                                    1);
+    }
+  };
+}
+//-----------------------------------------------------------------------------
 #endif
 
 #ifdef HAS_KAHIP
@@ -613,7 +795,8 @@ graph::partition_fn graph::kahip::partitioner(int mode, int seed,
 {
   return [mode, seed, imbalance, suppress_output](
              MPI_Comm comm, int nparts,
-             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting)
+             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting,
+             std::span<const std::int32_t> node_weights)
   {
     spdlog::info("Compute graph partition using (parallel) KaHIP");
 
@@ -622,9 +805,18 @@ graph::partition_fn graph::kahip::partitioner(int mode, int seed,
 
     common::Timer timer("Compute graph partition (KaHIP)");
 
-    // Graph does not have vertex or adjacency weights, so we use null
-    // pointers as arguments
-    T *vwgt(nullptr), *adjcwgt(nullptr);
+    // Graph does not have adjacency weights, so we use a null pointer
+    // as argument. A null pointer for the vertex weights gives unit
+    // weights.
+    const bool weighted = check_node_weights(comm, graph, node_weights);
+    std::vector<T> node_wgt;
+    if (weighted)
+    {
+      node_wgt.reserve(std::max<std::size_t>(1, node_weights.size()));
+      node_wgt.assign(node_weights.begin(), node_weights.end());
+    }
+    T* vwgt = weighted ? node_wgt.data() : nullptr;
+    T* adjcwgt = nullptr;
 
     // Build adjacency list data
     common::Timer timer1("KaHIP: build adjacency data");
@@ -663,3 +855,497 @@ graph::partition_fn graph::kahip::partitioner(int mode, int seed,
 }
 //----------------------------------------------------------------------------
 #endif
+//-----------------------------------------------------------------------------
+std::vector<std::uint64_t>
+graph::sfc::compute_keys(std::span<const double> x, int gdim,
+                         std::array<double, 3> x0, std::array<double, 3> x1,
+                         graph::sfc::curve c)
+{
+  if (gdim < 1 or gdim > 3)
+    throw std::runtime_error("Space-filling curves require 1 <= gdim <= 3.");
+  assert(x.size() % gdim == 0);
+
+  // Number of bits per coordinate and grid scaling
+  const int b = std::min(32, 64 / gdim);
+  const double nmax = std::ldexp(1.0, b) - 1.0;
+  std::array<double, 3> scale = {0, 0, 0};
+  for (int j = 0; j < gdim; ++j)
+  {
+    if (x1[j] > x0[j])
+      scale[j] = nmax / (x1[j] - x0[j]);
+  }
+
+  std::vector<std::uint64_t> keys(x.size() / gdim);
+  for (std::size_t p = 0; p < keys.size(); ++p)
+  {
+    std::array<std::uint32_t, 3> X = {0, 0, 0};
+    for (int j = 0; j < gdim; ++j)
+    {
+      double q = std::clamp((x[p * gdim + j] - x0[j]) * scale[j], 0.0, nmax);
+      X[j] = static_cast<std::uint32_t>(q);
+    }
+
+    if (c == curve::hilbert)
+      axes_to_transpose(X, b, gdim);
+
+    // Interleave the coordinate bits, most significant first
+    std::uint64_t key = 0;
+    for (int k = b - 1; k >= 0; --k)
+      for (int j = 0; j < gdim; ++j)
+        key = (key << 1) | ((X[j] >> k) & 1);
+    keys[p] = key;
+  }
+
+  return keys;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::uint64_t>
+graph::sfc::compute_splitting_keys(MPI_Comm comm, int nparts,
+                                   std::span<const std::uint64_t> keys)
+{
+  if (nparts < 1)
+    throw std::runtime_error("Number of parts must be positive.");
+
+  std::vector<std::uint64_t> sorted_keys(keys.begin(), keys.end());
+  std::ranges::sort(sorted_keys);
+
+  // Number of keys preceding each split
+  std::int64_t num_local = keys.size(), num_global = 0;
+  MPI_Allreduce(&num_local, &num_global, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::vector<std::int64_t> targets(nparts - 1);
+  for (int p = 0; p < nparts - 1; ++p)
+    targets[p] = (num_global * (p + 1)) / nparts;
+
+  // Find, for each split, the smallest key such that at least `target`
+  // keys are less than or equal to it. The bounds are the same on all
+  // ranks, so all ranks perform the same number of iterations.
+  std::vector<std::uint64_t> lo(nparts - 1, 0),
+      hi(nparts - 1, std::numeric_limits<std::uint64_t>::max());
+  std::vector<std::int64_t> counts(nparts - 1);
+  while (lo != hi)
+  {
+    for (int p = 0; p < nparts - 1; ++p)
+    {
+      std::uint64_t mid = lo[p] + (hi[p] - lo[p]) / 2;
+      counts[p] = std::distance(sorted_keys.begin(),
+                                std::ranges::upper_bound(sorted_keys, mid));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, counts.data(), counts.size(), MPI_INT64_T,
+                  MPI_SUM, comm);
+    for (int p = 0; p < nparts - 1; ++p)
+    {
+      std::uint64_t mid = lo[p] + (hi[p] - lo[p]) / 2;
+      if (counts[p] >= targets[p])
+        hi[p] = mid;
+      else
+        lo[p] = mid + 1;
+    }
+  }
+
+  return lo;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> graph::sfc::partition(MPI_Comm comm, int nparts,
+                                                std::span<const double> x,
+                                                int gdim, graph::sfc::curve c)
+{
+  common::Timer timer("Compute space-filling curve partition");
+  if (nparts < 1)
+    throw std::runtime_error("Number of parts must be positive.");
+  if (gdim < 1 or gdim > 3)
+    throw std::runtime_error("Space-filling curves require 1 <= gdim <= 3.");
+
+  // Compute global bounding box
+  std::array<double, 6> box;
+  std::fill_n(box.begin(), 6, -std::numeric_limits<double>::max());
+  for (std::size_t p = 0; p < x.size() / gdim; ++p)
+  {
+    for (int j = 0; j < gdim; ++j)
+    {
+      box[j] = std::max(box[j], -x[p * gdim + j]);
+      box[3 + j] = std::max(box[3 + j], x[p * gdim + j]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, box.data(), box.size(), MPI_DOUBLE, MPI_MAX,
+                comm);
+  std::vector<std::uint64_t> keys = compute_keys(
+      x, gdim, {-box[0], -box[1], -box[2]}, {box[3], box[4], box[5]}, c);
+
+  std::vector<std::uint64_t> lo = compute_splitting_keys(comm, nparts, keys);
+
+  // Destination is the number of splits below the key
+  std::vector<std::int32_t> part(keys.size());
+  std::ranges::transform(keys, part.begin(),
+                         [&lo](auto k) -> std::int32_t
+                         {
+                           return std::distance(
+                               lo.begin(), std::ranges::lower_bound(lo, k));
+                         });
+
+  return part;
+}
+//-----------------------------------------------------------------------------
+graph::partition_fn
+graph::hierarchical::partitioner(graph::partition_fn partfn)
+{
+  return [partfn](MPI_Comm comm, int nparts,
+                  const graph::AdjacencyList<std::int64_t>& graph,
+                  bool ghosting, std::span<const std::int32_t> node_weights)
+             -> graph::AdjacencyList<std::int32_t>
+  {
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+
+    // Split the communicator into the ranks of each (shared memory)
+    // compute node
+    MPI_Comm node_comm = MPI_COMM_NULL;
+    int ierr = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank,
+                                   MPI_INFO_NULL, &node_comm);
+    dolfinx::MPI::check_error(comm, ierr);
+    const int node_rank = dolfinx::MPI::rank(node_comm);
+    const int node_size = dolfinx::MPI::size(node_comm);
+
+    // Number the nodes by the rank of their first rank on a
+    // communicator of the first ranks
+    std::array<int, 2> node_data = {0, 0};
+    {
+      MPI_Comm leader_comm = MPI_COMM_NULL;
+      ierr = MPI_Comm_split(comm, node_rank == 0 ? 0 : MPI_UNDEFINED, rank,
+                            &leader_comm);
+      dolfinx::MPI::check_error(comm, ierr);
+      if (leader_comm != MPI_COMM_NULL)
+      {
+        node_data = {dolfinx::MPI::rank(leader_comm),
+                     dolfinx::MPI::size(leader_comm)};
+        MPI_Comm_free(&leader_comm);
+      }
+      MPI_Bcast(node_data.data(), 2, MPI_INT, 0, node_comm);
+    }
+    auto [node, num_nodes] = node_data;
+
+    // Largest and (minus the) smallest number of ranks on a node
+    std::array<int, 2> node_sizes = {node_size, -node_size};
+    MPI_Allreduce(MPI_IN_PLACE, node_sizes.data(), 2, MPI_INT, MPI_MAX,
+                  comm);
+    if (nparts != size or num_nodes == 1 or node_sizes[0] == 1
+        or node_sizes[0] != -node_sizes[1])
+    {
+      spdlog::info("Node structure not supported by hierarchical "
+                   "partitioning. Partitioning across all ranks.");
+      MPI_Comm_free(&node_comm);
+      return partfn(comm, nparts, graph, ghosting, node_weights);
+    }
+
+    spdlog::info("Compute hierarchical graph partition ({} nodes with {} "
+                 "ranks)",
+                 num_nodes, node_size);
+    common::Timer timer("Compute graph partition (hierarchical)");
+
+    const bool weighted = check_node_weights(comm, graph, node_weights);
+
+    // Rank on comm of each rank (node_rank) of each node (row-major)
+    std::vector<int> ranks(size);
+    {
+      std::array<int, 2> id = {node, node_rank};
+      std::vector<int> ids(2 * size);
+      MPI_Allgather(id.data(), 2, MPI_INT, ids.data(), 2, MPI_INT, comm);
+      for (int r = 0; r < size; ++r)
+        ranks[ids[2 * r] * node_size + ids[2 * r + 1]] = r;
+    }
+
+    // Level 1: Partition the graph across the nodes
+    const std::int32_t num_local = graph.num_nodes();
+    std::vector<std::int32_t> node_part(num_local);
+    {
+      graph::AdjacencyList<std::int32_t> part
+          = partfn(comm, num_nodes, graph, false, node_weights);
+      for (std::int32_t i = 0; i < num_local; ++i)
+        node_part[i] = part.links(i).front();
+    }
+
+    // Send the graph nodes of each part to the ranks of the node. The
+    // nodes are sent in contiguous blocks to preserve locality.
+    std::vector<std::int32_t> dest0(num_local);
+    {
+      std::vector<std::int32_t> count(num_nodes, 0), pos(num_nodes, 0);
+      for (std::int32_t k : node_part)
+        ++count[k];
+      for (std::int32_t i = 0; i < num_local; ++i)
+      {
+        std::int32_t k = node_part[i];
+        std::int64_t j = (std::int64_t(pos[k]++) * node_size) / count[k];
+        dest0[i] = ranks[k * node_size + j];
+      }
+    }
+    auto [graph1, src, original_idx, ghost_owners] = graph::build::distribute(
+        comm, graph, graph::regular_adjacency_list(std::move(dest0), 1));
+    const std::int64_t num_local1 = graph1.num_nodes();
+
+    // Index of the received graph nodes on the node
+    std::int64_t node_offset = 0;
+    MPI_Exscan(&num_local1, &node_offset, 1, MPI_INT64_T, MPI_SUM,
+               node_comm);
+
+    // Send the index on the node of the received graph nodes back to
+    // the sending ranks, and store (node, index on node) of the owned
+    // graph nodes
+    std::int64_t offset = 0;
+    std::int64_t num_owned = num_local;
+    MPI_Exscan(&num_owned, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+    const graph::AdjacencyList<std::int32_t> src_ranks
+        = graph::regular_adjacency_list(src, 1);
+    std::vector<std::int64_t> local_idx(2 * num_local);
+    {
+      std::vector<std::int64_t> data(2 * num_local1);
+      for (std::int64_t i = 0; i < num_local1; ++i)
+        data[2 * i] = original_idx[i], data[2 * i + 1] = node_offset + i;
+      std::vector<std::int64_t> recv_data = std::get<0>(
+          graph::build::distribute(comm, data, {std::size_t(num_local1), 2},
+                                   src_ranks));
+      for (std::size_t i = 0; i < recv_data.size(); i += 2)
+      {
+        std::int64_t v = recv_data[i] - offset;
+        local_idx[2 * v] = node_part[v];
+        local_idx[2 * v + 1] = recv_data[i + 1];
+      }
+    }
+
+    // Get (node, index on node) of the edges of the received graph
+    // nodes, and build the subgraph of the node
+    std::vector<std::int64_t> edges(graph1.array().begin(),
+                                    graph1.array().end());
+    std::ranges::sort(edges);
+    auto [unique_end, range_end] = std::ranges::unique(edges);
+    edges.erase(unique_end, range_end);
+    const std::vector<std::int64_t> edge_idx
+        = dolfinx::MPI::distribute_data(comm, edges, comm, local_idx, 2);
+    std::vector<std::int64_t> array;
+    std::vector<std::int32_t> offsets(1, 0);
+    for (std::int64_t i = 0; i < num_local1; ++i)
+    {
+      for (std::int64_t e : graph1.links(i))
+      {
+        auto it = std::ranges::lower_bound(edges, e);
+        assert(it != edges.end() and *it == e);
+        std::size_t pos = std::distance(edges.begin(), it);
+        if (edge_idx[2 * pos] == node)
+          array.push_back(edge_idx[2 * pos + 1]);
+      }
+      offsets.push_back(array.size());
+    }
+    const graph::AdjacencyList<std::int64_t> subgraph(std::move(array),
+                                                      std::move(offsets));
+
+    std::vector<std::int32_t> weights1;
+    if (weighted)
+    {
+      weights1 = dolfinx::MPI::distribute_data(comm, original_idx, comm,
+                                               node_weights, 1);
+    }
+
+    // Level 2: Partition the subgraph across the ranks of the node, and
+    // send the destination ranks back to the sending ranks
+    std::vector<std::int32_t> dest(num_local);
+    {
+      graph::AdjacencyList<std::int32_t> part
+          = partfn(node_comm, node_size, subgraph, false, weights1);
+      std::vector<std::int64_t> data(2 * num_local1);
+      for (std::int64_t i = 0; i < num_local1; ++i)
+      {
+        data[2 * i] = original_idx[i];
+        data[2 * i + 1] = ranks[node * node_size + part.links(i).front()];
+      }
+      std::vector<std::int64_t> recv_data = std::get<0>(
+          graph::build::distribute(comm, data, {std::size_t(num_local1), 2},
+                                   src_ranks));
+      for (std::size_t i = 0; i < recv_data.size(); i += 2)
+        dest[recv_data[i] - offset] = recv_data[i + 1];
+    }
+
+    MPI_Comm_free(&node_comm);
+
+    if (ghosting)
+      return graph::extend_destination_ranks(comm, graph, dest);
+    else
+      return graph::regular_adjacency_list(std::move(dest), 1);
+  };
+}
+//-----------------------------------------------------------------------------
+graph::partition_fn graph::diffusion::partitioner(double imbalance,
+                                                  int max_iterations)
+{
+  return [imbalance, max_iterations](
+             MPI_Comm comm, int nparts,
+             const graph::AdjacencyList<std::int64_t>& graph, bool ghosting,
+             std::span<const std::int32_t> node_weights)
+  {
+    spdlog::info("Compute graph repartition by diffusion");
+    common::Timer timer("Compute graph repartition (diffusion)");
+
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+    if (nparts != size)
+    {
+      throw std::runtime_error("Diffusive repartitioning requires one part "
+                               "per rank.");
+    }
+
+    const bool weighted = check_node_weights(comm, graph, node_weights);
+    auto weight = [weighted, node_weights](std::int32_t i) -> double
+    { return weighted ? node_weights[i] : 1.0; };
+
+    // Global index range of the nodes on each rank
+    const std::int64_t num_nodes = graph.num_nodes();
+    std::vector<std::int64_t> node_disp(size + 1, 0);
+    MPI_Allgather(&num_nodes, 1, MPI_INT64_T, node_disp.data() + 1, 1,
+                  MPI_INT64_T, comm);
+    std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+    const std::int64_t range0 = node_disp[rank];
+    const std::int64_t range1 = node_disp[rank + 1];
+
+    // Ranks (parts) that share an edge with this rank. The
+    // neighbourhood is made symmetric in case the graph is not.
+    std::vector<int> nbrs;
+    for (std::int64_t e : graph.array())
+    {
+      if (e < range0 or e >= range1)
+      {
+        auto it = std::ranges::upper_bound(node_disp, e);
+        nbrs.push_back(std::distance(node_disp.begin(), it) - 1);
+      }
+    }
+    std::ranges::sort(nbrs);
+    nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+    {
+      std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, nbrs);
+      nbrs.insert(nbrs.end(), src.begin(), src.end());
+      std::ranges::sort(nbrs);
+      nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+    }
+
+    MPI_Comm nbr_comm;
+    MPI_Dist_graph_create_adjacent(comm, nbrs.size(), nbrs.data(),
+                                   MPI_UNWEIGHTED, nbrs.size(), nbrs.data(),
+                                   MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                   &nbr_comm);
+
+    // Diffusion coefficient for each neighbour, which is bounded by the
+    // number of neighbours of both parts for the diffusion to be stable
+    const int degree = nbrs.size();
+    std::vector<int> nbr_degree(nbrs.size());
+    nbr_degree.reserve(1);
+    MPI_Neighbor_allgather(&degree, 1, MPI_INT, nbr_degree.data(), 1, MPI_INT,
+                           nbr_comm);
+    std::vector<double> alpha(nbrs.size());
+    for (std::size_t j = 0; j < nbrs.size(); ++j)
+      alpha[j] = 1.0 / (1.0 + std::max(degree, nbr_degree[j]));
+
+    double load = 0;
+    for (std::int32_t i = 0; i < graph.num_nodes(); ++i)
+      load += weight(i);
+    double average = load;
+    MPI_Allreduce(MPI_IN_PLACE, &average, 1, MPI_DOUBLE, MPI_SUM, comm);
+    average /= size;
+
+    // Diffuse the load between neighbouring parts, accumulating the load
+    // flow[j] that is to be moved to neighbour j
+    std::vector<double> flow(nbrs.size(), 0), nbr_load(nbrs.size());
+    nbr_load.reserve(1);
+    int it = 0;
+    for (; it < max_iterations; ++it)
+    {
+      double max_load = load;
+      MPI_Allreduce(MPI_IN_PLACE, &max_load, 1, MPI_DOUBLE, MPI_MAX, comm);
+      if (max_load <= imbalance * average)
+        break;
+
+      MPI_Neighbor_allgather(&load, 1, MPI_DOUBLE, nbr_load.data(), 1,
+                             MPI_DOUBLE, nbr_comm);
+      double dload = 0;
+      for (std::size_t j = 0; j < nbrs.size(); ++j)
+      {
+        double f = alpha[j] * (load - nbr_load[j]);
+        flow[j] += f;
+        dload -= f;
+      }
+      load += dload;
+    }
+    MPI_Comm_free(&nbr_comm);
+    spdlog::info("Graph load diffusion iterations: {}", it);
+
+    // Move the load to each neighbour, starting with the largest, by
+    // growing a region from the nodes that have the most edges to the
+    // neighbour
+    std::vector<std::int32_t> part(graph.num_nodes(), rank);
+    std::vector<std::size_t> order(nbrs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, std::greater<>(),
+                      [&flow](auto j) { return flow[j]; });
+    for (std::size_t j : order)
+    {
+      double remaining = flow[j];
+      if (remaining <= 0)
+        break;
+
+      // Nodes on the boundary with the neighbour, sorted by the number
+      // of edges to the neighbour
+      const std::int64_t r0 = node_disp[nbrs[j]];
+      const std::int64_t r1 = node_disp[nbrs[j] + 1];
+      std::vector<std::pair<std::int32_t, std::int32_t>> boundary;
+      for (std::int32_t i = 0; i < graph.num_nodes(); ++i)
+      {
+        if (part[i] == rank)
+        {
+          auto links = graph.links(i);
+          std::int32_t count = std::ranges::count_if(
+              links, [r0, r1](auto e) { return e >= r0 and e < r1; });
+          if (count > 0)
+            boundary.emplace_back(-count, i);
+        }
+      }
+      std::ranges::sort(boundary);
+
+      std::vector<std::int32_t> queue;
+      std::ranges::transform(boundary, std::back_inserter(queue),
+                             [](auto& b) { return b.second; });
+      for (std::size_t q = 0; q < queue.size() and remaining > 0; ++q)
+      {
+        // Move the node if it brings the moved load closer to the flow
+        const std::int32_t i = queue[q];
+        const double w = weight(i);
+        if (part[i] != rank or w >= 2 * remaining)
+          continue;
+
+        part[i] = nbrs[j];
+        remaining -= w;
+        for (std::int64_t e : graph.links(i))
+        {
+          if (e >= range0 and e < range1 and part[e - range0] == rank)
+            queue.push_back(e - range0);
+        }
+      }
+    }
+
+    if (ghosting)
+      return graph::extend_destination_ranks(comm, graph, part);
+    else
+      return graph::regular_adjacency_list(std::move(part), 1);
+  };
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t>
+graph::extend_destination_ranks(MPI_Comm comm,
+                                const graph::AdjacencyList<std::int64_t>& graph,
+                                std::span<const std::int32_t> part)
+{
+  assert(static_cast<std::int32_t>(part.size()) == graph.num_nodes());
+  const int size = dolfinx::MPI::size(comm);
+  const std::int64_t num_nodes = graph.num_nodes();
+  std::vector<std::int64_t> node_disp(size + 1, 0);
+  MPI_Allgather(&num_nodes, 1, MPI_INT64_T, node_disp.data() + 1, 1,
+                MPI_INT64_T, comm);
+  std::partial_sum(node_disp.begin(), node_disp.end(), node_disp.begin());
+  std::vector<std::int64_t> dest(part.begin(), part.end());
+  return compute_destination_ranks(comm, graph, node_disp, dest);
+}
+//-----------------------------------------------------------------------------
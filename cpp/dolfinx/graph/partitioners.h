@@ -8,6 +8,10 @@
 
 #include "partition.h"
 #include <array>
+#include <cstdint>
+#include <mpi.h>
+#include <span>
+#include <vector>
 
 namespace dolfinx::graph
 {
@@ -58,6 +62,25 @@ namespace parmetis
 graph::partition_fn partitioner(double imbalance = 1.02,
                                 std::array<int, 3> options = {1, 0, 5});
 
+/// @brief Create a graph repartitioning function that uses the ParMETIS
+/// adaptive repartitioner (`ParMETIS_V3_AdaptiveRepart`).
+///
+/// The current distribution of the graph is the initial partition,
+/// i.e. the current part of a node is the rank that it is on. The
+/// repartitioner computes a balanced partition that trades the edge
+/// cut against the number of nodes that are moved from their current
+/// part. The number of parts must be equal to the number of ranks.
+///
+/// @param[in] itr Ratio of the inter-process communication time to the
+/// data redistribution time. Large values favour a small edge cut and
+/// small values favour a small migration volume. See ParMETIS manual
+/// for details.
+/// @param[in] imbalance Imbalance tolerance.
+/// @param[in] options The ParMETIS debug level and random seed.
+graph::partition_fn adaptive_partitioner(double itr = 1000,
+                                         double imbalance = 1.02,
+                                         std::array<int, 2> options = {0, 5});
+
 #endif
 } // namespace parmetis
 
@@ -80,4 +103,154 @@ graph::partition_fn partitioner(int mode = 1, int seed = 1,
 #endif
 } // namespace kahip
 
+/// Geometric partitioning along space-filling curves
+namespace sfc
+{
+/// @brief Space-filling curve types.
+enum class curve
+{
+  hilbert, ///< Hilbert curve
+  morton   ///< Morton (Z-order) curve
+};
+
+/// @brief Compute the position (key) of points along a space-filling
+/// curve.
+///
+/// The bounding box `[x0, x1]` is divided into a uniform grid with
+/// `2^b` cells in each direction, where `b = min(32, 64 / gdim)`, and
+/// each point is assigned the curve index of the grid cell that
+/// contains it. Points outside of the box are clamped to the box.
+///
+/// @param[in] x Point coordinates, shape `(num_points, gdim)` and
+/// row-major storage.
+/// @param[in] gdim Geometric dimension of the points (1, 2 or 3).
+/// @param[in] x0 Lower corner of the bounding box.
+/// @param[in] x1 Upper corner of the bounding box.
+/// @param[in] c The space-filling curve.
+/// @return Key for each point.
+std::vector<std::uint64_t> compute_keys(std::span<const double> x, int gdim,
+                                        std::array<double, 3> x0,
+                                        std::array<double, 3> x1, curve c);
+
+/// @brief Compute keys that divide distributed space-filling curve
+/// keys into segments with an equal number of keys.
+///
+/// The splitting keys are found by a parallel bisection, which
+/// requires a fixed number of reductions of size `nparts` and no
+/// communication of the keys. A key `k` belongs to part `p` if `p` is
+/// the number of splitting keys that are less than `k`.
+///
+/// @note Collective function
+/// @param[in] comm MPI communicator that the keys are distributed
+/// across.
+/// @param[in] nparts Number of parts.
+/// @param[in] keys Keys on this process.
+/// @return The `nparts - 1` splitting keys (sorted).
+std::vector<std::uint64_t>
+compute_splitting_keys(MPI_Comm comm, int nparts,
+                       std::span<const std::uint64_t> keys);
+
+/// @brief Partition distributed points by dividing a space-filling
+/// curve through the points into segments with an equal number of
+/// points.
+///
+/// The splitting keys between segments are found by a parallel
+/// bisection on the curve keys, which requires a fixed number of
+/// reductions of size `nparts` and no sorting or communication of the
+/// points. Parts are balanced up to points that share a key.
+///
+/// @note Collective function
+/// @param[in] comm MPI communicator that the points are distributed
+/// across.
+/// @param[in] nparts Number of parts.
+/// @param[in] x Point coordinates on this process, shape `(num_points,
+/// gdim)` and row-major storage.
+/// @param[in] gdim Geometric dimension of the points (1, 2 or 3).
+/// @param[in] c The space-filling curve.
+/// @return The destination part for each point on this process.
+std::vector<std::int32_t> partition(MPI_Comm comm, int nparts,
+                                    std::span<const double> x, int gdim,
+                                    curve c = curve::hilbert);
+} // namespace sfc
+
+/// Node-aware (two-level) partitioning
+namespace hierarchical
+{
+/// @brief Create a graph partitioning function that partitions a graph
+/// first across the (shared memory) compute nodes and then across the
+/// ranks of each node.
+///
+/// The graph is partitioned by `partfn` into one part per node, which
+/// minimises the number of cut edges between nodes. The nodes of each
+/// part are sent to the ranks of the node, and the subgraph of the
+/// node is partitioned by `partfn` across the ranks of the node. Since
+/// communication between ranks on the same node is typically much
+/// cheaper than between nodes, the partition reduces the cost of ghost
+/// updates compared to a single-level partition.
+///
+/// The nodes are identified with `MPI_Comm_split_type` and
+/// `MPI_COMM_TYPE_SHARED`. If the number of parts is not equal to the
+/// number of ranks, if there is only one node or one rank per node, or
+/// if the nodes have different numbers of ranks, the graph is
+/// partitioned by `partfn` across all ranks.
+///
+/// @param[in] partfn Graph partitioning function that is used on each
+/// level.
+/// @return A graph partitioning function
+graph::partition_fn partitioner(graph::partition_fn partfn
+                                = &graph::partition_graph);
+} // namespace hierarchical
+
+/// Incremental repartitioning by diffusion of the load imbalance
+namespace diffusion
+{
+/// @brief Create a graph repartitioning function that balances the
+/// current partition of a graph with a small number of moved nodes.
+///
+/// The current distribution of the graph is the initial partition,
+/// i.e. the current part of a node is the rank that it is on. The load
+/// (sum of node weights) of each part is diffused between parts that
+/// share an edge until the largest load is within `imbalance` of the
+/// average, which gives the load to move between neighbouring parts.
+/// Each load is moved by growing a region of nodes from the boundary
+/// with the neighbouring part. Only nodes close to part boundaries are
+/// moved, so the migration volume is much smaller than for a partition
+/// computed from scratch, but the edge cut is not optimised. This
+/// suits small changes of the graph or of the node weights, e.g. after
+/// adaptive refinement.
+///
+/// The number of parts must be equal to the number of ranks. Parts
+/// that do not share an edge with another part are not balanced. Nodes
+/// are moved at most once, so if the load that passes through a part
+/// exceeds its own load, the partition is only partially balanced and
+/// the repartitioning can be repeated after the nodes are moved.
+///
+/// @param[in] imbalance Allowed ratio of the largest to the average
+/// load.
+/// @param[in] max_iterations Maximum number of diffusion iterations.
+/// @return A graph partitioning function
+graph::partition_fn partitioner(double imbalance = 1.02,
+                                int max_iterations = 200);
+} // namespace diffusion
+
+/// @brief Add the destination ranks of ghost nodes to a partition of a
+/// distributed graph.
+///
+/// A node is ghosted on the destination rank of every node that it is
+/// connected to.
+///
+/// @note Collective function
+/// @param[in] comm MPI communicator that the graph is distributed
+/// across.
+/// @param[in] graph Graph, using global indices for the edges. The
+/// global index of a local node is its local index plus the number of
+/// nodes on lower ranks.
+/// @param[in] part The destination rank for each local node.
+/// @return Destination ranks for each local node. The first rank for
+/// each node is the owner.
+graph::AdjacencyList<std::int32_t>
+extend_destination_ranks(MPI_Comm comm,
+                         const graph::AdjacencyList<std::int64_t>& graph,
+                         std::span<const std::int32_t> part);
+
 } // namespace dolfinx::graph
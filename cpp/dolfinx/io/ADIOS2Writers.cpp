@@ -8,6 +8,8 @@
 
 #include "ADIOS2Writers.h"
 #include "cells.h"
+#include <array>
+#include <charconv>
 #include <pugixml.hpp>
 #include <string>
 #include <vector>
@@ -17,11 +19,13 @@ using namespace dolfinx::io;
 
 //-----------------------------------------------------------------------------
 ADIOS2Writer::ADIOS2Writer(MPI_Comm comm, const std::filesystem::path& filename,
-                           std::string tag, std::string engine)
+                           std::string tag, std::string engine,
+                           const adios2::Params& params)
     : _adios(std::make_unique<adios2::ADIOS>(comm)),
       _io(std::make_unique<adios2::IO>(_adios->DeclareIO(tag)))
 {
   _io->SetEngine(engine);
+  _io->SetParameters(params);
   _engine = std::make_unique<adios2::Engine>(
       _io->Open(filename, adios2::Mode::Write));
 }
@@ -37,6 +41,15 @@ void ADIOS2Writer::close()
     _engine->Close();
 }
 //-----------------------------------------------------------------------------
+VTXCompression VTXCompression::lossy(std::string type, double tolerance)
+{
+  // Shortest representation that reads back as the same value
+  std::array<char, 32> buffer;
+  auto [end, ec] = std::to_chars(buffer.begin(), buffer.end(), tolerance);
+  assert(ec == std::errc());
+  return {std::move(type), {{"accuracy", std::string(buffer.begin(), end)}}};
+}
+//-----------------------------------------------------------------------------
 std::stringstream
 io::impl_vtx::create_vtk_schema(const std::vector<std::string>& point_data,
                                 const std::vector<std::string>& cell_data)
@@ -22,6 +22,7 @@
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <mpi.h>
 #include <string>
@@ -61,8 +62,11 @@ protected:
   /// @param[in] tag The ADIOS2 object name
   /// @param[in] engine ADIOS2 engine type. See
   /// https://adios2.readthedocs.io/en/latest/engines/engines.html.
+  /// @param[in] params ADIOS2 engine parameters, which are set before
+  /// the engine is opened.
   ADIOS2Writer(MPI_Comm comm, const std::filesystem::path& filename,
-               std::string tag, std::string engine);
+               std::string tag, std::string engine,
+               const adios2::Params& params = {});
 
   /// @brief Move constructor
   ADIOS2Writer(ADIOS2Writer&& writer) = default;
@@ -158,6 +162,30 @@ extract_common_mesh(const typename adios2_writer::U<T>& u)
 
 } // namespace impl_adios2
 
+/// @brief Compression of the data of a Function that is written by
+/// VTXWriter.
+///
+/// The data is compressed by an ADIOS2 operator when it is written, see
+/// https://adios2.readthedocs.io/en/latest/components/components.html#operator.
+/// ADIOS2 must be built with support for the operator. The mesh is not
+/// compressed.
+struct VTXCompression
+{
+  /// ADIOS2 operator type, e.g. `"zfp"`, `"sz"`, `"mgard"` or `"blosc"`
+  std::string type;
+
+  /// Operator parameters, e.g. `{{"accuracy", "1e-6"}}` for ZFP with
+  /// an absolute error bound
+  adios2::Params params = {};
+
+  /// @brief Lossy compression with a bound on the absolute error.
+  /// @param[in] type Operator type, `"zfp"`, `"sz"` or `"mgard"`.
+  /// @param[in] tolerance Bound on the absolute error of each value.
+  /// @return Compression with the parameter `"accuracy"` set to
+  /// `tolerance`.
+  static VTXCompression lossy(std::string type, double tolerance);
+};
+
 /// @privatesection
 namespace impl_vtx
 {
@@ -202,10 +230,20 @@ extract_function_names(const typename adios2_writer::U<T>& u)
 /// @param[in] io ADIOS2 io object.
 /// @param[in] engine ADIOS2 engine object.
 /// @param[in] u Function to write.
+/// @param[in] compression Compression of the data. No compression if
+/// `nullptr`.
 template <typename T, std::floating_point X>
 void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
-                    const fem::Function<T, X>& u)
+                    const fem::Function<T, X>& u,
+                    const VTXCompression* compression = nullptr)
 {
+  // Attach the compression operator when a variable is first defined
+  auto compress = [compression](auto& var)
+  {
+    if (compression and var.Operations().empty())
+      var.AddOperation(compression->type, compression->params);
+  };
+
   // Get function data array and information about layout
   assert(u.x());
   std::span<const T> u_vector = u.x()->array();
@@ -239,6 +277,7 @@ void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
 
     adios2::Variable output = impl_adios2::define_variable<T>(
         io, u.name, {}, {}, {num_dofs, num_comp});
+    compress(output);
     engine.Put(output, data.data(), adios2::Mode::Sync);
   }
   else
@@ -253,6 +292,7 @@ void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
 
     adios2::Variable output_real = impl_adios2::define_variable<U>(
         io, u.name + impl_adios2::field_ext[0], {}, {}, {num_dofs, num_comp});
+    compress(output_real);
     engine.Put(output_real, data.data(), adios2::Mode::Sync);
 
     std::ranges::fill(data, 0);
@@ -261,6 +301,7 @@ void vtx_write_data(adios2::IO& io, adios2::Engine& engine,
         data[i * num_comp + j] = std::imag(u_vector[i * index_map_bs + j]);
     adios2::Variable output_imag = impl_adios2::define_variable<U>(
         io, u.name + impl_adios2::field_ext[1], {}, {}, {num_dofs, num_comp});
+    compress(output_imag);
     engine.Put(output_imag, data.data(), adios2::Mode::Sync);
   }
 }
@@ -278,6 +319,11 @@ void vtx_write_mesh(adios2::IO& io, adios2::Engine& engine,
   assert(topology);
 
   // "Put" geometry
+  if (geometry.x_stride() != 3)
+  {
+    throw std::runtime_error(
+        "Cannot write a geometry with coordinate stride other than three.");
+  }
   std::shared_ptr<const common::IndexMap> x_map = geometry.index_map();
   std::uint32_t num_vertices = x_map->size_local() + x_map->num_ghosts();
   adios2::Variable local_geometry = impl_adios2::define_variable<T>(
@@ -412,11 +458,74 @@ enum class VTXMeshPolicy
           ///< written to file
 };
 
+/// Write policy
+enum class VTXWritePolicy
+{
+  sync,  ///< Data is written to file before VTXWriter::write returns
+  async, ///< Data is staged and written to file by a background thread
+  stream ///< Data is sent to connected readers by the SST engine, without
+         ///< writing to file and without waiting for readers
+};
+
+/// @privatesection
+namespace impl_vtx
+{
+/// Maximum number of steps that are queued for readers with
+/// VTXWritePolicy::stream
+constexpr int stream_queue_limit = 2;
+
+/// Engine parameters for a write policy
+inline adios2::Params write_params(const std::string& engine,
+                                   VTXWritePolicy policy)
+{
+  switch (policy)
+  {
+  case VTXWritePolicy::sync:
+    return {};
+  case VTXWritePolicy::async:
+    if (engine != "BP5")
+    {
+      throw std::runtime_error(
+          "Asynchronous VTX output requires the BP5 engine.");
+    }
+    return {{"AsyncWrite", "Guided"}};
+  case VTXWritePolicy::stream:
+    if (engine != "SST")
+      throw std::runtime_error("Streaming VTX output requires the SST engine.");
+
+    // Do not wait for readers to connect, and discard the oldest steps
+    // rather than block when readers fall behind
+    return {{"RendezvousReaderCount", "0"},
+            {"QueueLimit", std::to_string(stream_queue_limit)},
+            {"QueueFullPolicy", "Discard"}};
+  default:
+    throw std::runtime_error("Unknown VTX write policy.");
+  }
+}
+} // namespace impl_vtx
+
 /// @brief Writer for meshes and functions using the ADIOS2 VTX format,
 /// see
 /// https://adios2.readthedocs.io/en/latest/ecosystem/visualization.html#using-vtk-and-paraview.
 ///
 /// The output files can be visualized using ParaView.
+///
+/// With VTXWritePolicy::async, the data for a step is copied into
+/// staging buffers that are managed and re-used by ADIOS2, and
+/// VTXWriter::write returns without waiting for the data to reach the
+/// file system. Functions and the mesh may be modified as soon as
+/// VTXWriter::write returns. Pending data is written at the latest when
+/// the next step is written or the writer is closed.
+///
+/// With VTXWritePolicy::stream, steps are sent over the network to
+/// readers (e.g. ParaView Catalyst or an analysis code) by the ADIOS2
+/// SST engine, and nothing is written to disk. The writer does not wait
+/// for readers to connect, and readers may connect and disconnect at any
+/// step. At most impl_vtx::stream_queue_limit steps are queued for
+/// readers that fall behind. When the queue is full, the oldest step is
+/// discarded so that VTXWriter::write does not block. The mesh is sent
+/// with every step, irrespective of the mesh policy, so that readers
+/// that connect later receive it.
 template <std::floating_point T>
 class VTXWriter : public ADIOS2Writer
 {
@@ -429,13 +538,20 @@ public:
   /// @param[in] filename Name of output file.
   /// @param[in] mesh Mesh to write.
   /// @param[in] engine ADIOS2 engine type.
+  /// @param[in] write_policy Controls if data is written to file
+  /// before VTXWriter::write returns, asynchronously, or streamed to
+  /// readers. Asynchronous output requires the `"BP5"` engine and
+  /// streaming requires the `"SST"` engine.
   /// @note This format supports arbitrary degree meshes.
   /// @note The mesh geometry can be updated between write steps but the
   /// topology should not be changed between write steps.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             std::shared_ptr<const mesh::Mesh<T>> mesh,
-            std::string engine = "BPFile")
-      : ADIOS2Writer(comm, filename, "VTX mesh writer", engine), _mesh(mesh),
+            std::string engine = "BPFile",
+            VTXWritePolicy write_policy = VTXWritePolicy::sync)
+      : ADIOS2Writer(comm, filename, "VTX mesh writer", engine,
+                     impl_vtx::write_params(engine, write_policy)),
+        _mesh(mesh),
         _mesh_reuse_policy(VTXMeshPolicy::update), _is_piecewise_constant(false)
   {
     // Define VTK scheme attribute for mesh
@@ -457,17 +573,44 @@ public:
   /// @param[in] mesh_policy Controls if the mesh is written to file at
   /// the first time step only or is re-written (updated) at each time
   /// step.
+  /// @param[in] write_policy Controls if data is written to file
+  /// before VTXWriter::write returns, asynchronously, or streamed to
+  /// readers. Asynchronous output requires the `"BP5"` engine and
+  /// streaming requires the `"SST"` engine.
+  /// @param[in] compression Compression of the data of functions, keyed
+  /// by the function name. Functions that are not in the map are not
+  /// compressed.
   /// @note This format supports arbitrary degree meshes.
   VTXWriter(MPI_Comm comm, const std::filesystem::path& filename,
             const typename adios2_writer::U<T>& u, std::string engine,
-            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update)
-      : ADIOS2Writer(comm, filename, "VTX function writer", engine),
+            VTXMeshPolicy mesh_policy = VTXMeshPolicy::update,
+            VTXWritePolicy write_policy = VTXWritePolicy::sync,
+            std::map<std::string, VTXCompression> compression = {})
+      : ADIOS2Writer(comm, filename, "VTX function writer", engine,
+                     impl_vtx::write_params(engine, write_policy)),
         _mesh(impl_adios2::extract_common_mesh<T>(u)),
-        _mesh_reuse_policy(mesh_policy), _u(u), _is_piecewise_constant(false)
+        _mesh_reuse_policy(write_policy == VTXWritePolicy::stream
+                               ? VTXMeshPolicy::update
+                               : mesh_policy),
+        _u(u), _is_piecewise_constant(false),
+        _compression(std::move(compression))
   {
     if (u.empty())
       throw std::runtime_error("VTXWriter fem::Function list is empty.");
 
+    // Check that each compressed function is written
+    std::vector<std::string> names;
+    for (auto& v : _u)
+      names.push_back(std::visit([](auto& u) { return u->name; }, v));
+    for (auto& [name, c] : _compression)
+    {
+      if (std::ranges::find(names, name) == names.end())
+      {
+        throw std::runtime_error("No function with name '" + name
+                                 + "' to compress in VTXWriter.");
+      }
+    }
+
     // Extract space from first function
     auto V0 = std::visit([](auto& u) { return u->function_space().get(); },
                          u.front());
@@ -592,8 +735,12 @@ public:
       {
         for (auto& v : _u)
         {
-          std::visit([&](auto& u)
-                     { impl_vtx::vtx_write_data(*_io, *_engine, *u); }, v);
+          std::visit(
+              [&](auto& u) {
+                impl_vtx::vtx_write_data(*_io, *_engine, *u,
+                                         compression(u->name));
+              },
+              v);
         }
       }
     }
@@ -627,8 +774,12 @@ public:
       // Write function data for each function to file
       for (auto& v : _u)
       {
-        std::visit([&](auto& u)
-                   { impl_vtx::vtx_write_data(*_io, *_engine, *u); }, v);
+        std::visit(
+            [&](auto& u) {
+              impl_vtx::vtx_write_data(*_io, *_engine, *u,
+                                       compression(u->name));
+            },
+            v);
       }
     }
 
@@ -636,6 +787,14 @@ public:
   }
 
 private:
+  // Compression of the function with a given name (nullptr if not
+  // compressed)
+  const VTXCompression* compression(const std::string& name) const
+  {
+    auto it = _compression.find(name);
+    return it == _compression.end() ? nullptr : &it->second;
+  }
+
   std::shared_ptr<const mesh::Mesh<T>> _mesh;
   adios2_writer::U<T> _u;
 
@@ -647,6 +806,9 @@ private:
 
   // Special handling of piecewise constant functions
   bool _is_piecewise_constant;
+
+  // Compression of function data, keyed by function name
+  std::map<std::string, VTXCompression> _compression;
 };
 
 /// Type deduction
@@ -5,7 +5,12 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "HDF5Interface.h"
+#include <algorithm>
 #include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -49,11 +54,67 @@ bool has_group(hid_t handle, const std::string& group_name)
   return object_info.type == H5O_TYPE_GROUP;
 }
 
+/// Create (or re-create) an attribute of the object at `path` and write
+/// its value. The data space `space_id` is closed.
+void create_attribute(hid_t handle, const std::string& path,
+                      const std::string& name, hid_t space_id, hid_t type_id,
+                      const void* value)
+{
+  const hid_t obj_id = H5Oopen(handle, path.c_str(), H5P_DEFAULT);
+  if (obj_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 object " + path + ".");
+
+  if (htri_t exists = H5Aexists(obj_id, name.c_str()); exists < 0)
+    throw std::runtime_error("Failed to check existence of HDF5 attribute.");
+  else if (exists > 0 and H5Adelete(obj_id, name.c_str()) < 0)
+    throw std::runtime_error("Failed to delete HDF5 attribute.");
+
+  const hid_t attr_id = H5Acreate2(obj_id, name.c_str(), type_id, space_id,
+                                   H5P_DEFAULT, H5P_DEFAULT);
+  if (attr_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 attribute " + name + ".");
+  if (H5Awrite(attr_id, type_id, value) < 0)
+    throw std::runtime_error("Failed to write HDF5 attribute " + name + ".");
+
+  if (H5Aclose(attr_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 attribute.");
+  if (H5Sclose(space_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 attribute data space.");
+  if (H5Oclose(obj_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 object.");
+}
+
+/// Event set and buffers of the asynchronous operations on a file
+struct AsyncState
+{
+  hid_t es_id;
+  std::vector<std::shared_ptr<const void>> buffers;
+};
+
+/// Asynchronous state of the files for which asynchronous operations
+/// are enabled, keyed by file handle
+std::mutex async_mutex;
+std::map<hid_t, AsyncState> async_files;
+
+/// Wait for the operations in an event set to complete
+void wait_event_set([[maybe_unused]] hid_t es_id)
+{
+#if H5_VERSION_GE(1, 14, 0)
+  std::size_t num_in_progress = 0;
+  hbool_t failed = false;
+  if (H5ESwait(es_id, H5ES_WAIT_FOREVER, &num_in_progress, &failed) < 0)
+    throw std::runtime_error("Failed to wait for HDF5 event set.");
+  if (failed)
+    throw std::runtime_error("Asynchronous HDF5 operation failed.");
+#endif
+}
 } // namespace
 
 //-----------------------------------------------------------------------------
-hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
-                          const std::string& mode, bool use_mpi_io)
+hid_t io::hdf5::open_file(
+    MPI_Comm comm, const std::filesystem::path& filename,
+    const std::string& mode, bool use_mpi_io,
+    const std::vector<std::pair<std::string, std::string>>& mpi_io_hints)
 {
   // Set parallel access with communicator
   const hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
@@ -62,6 +123,8 @@ hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
   {
     MPI_Info info;
     MPI_Info_create(&info);
+    for (auto& [key, value] : mpi_io_hints)
+      MPI_Info_set(info, key.c_str(), value.c_str());
     if (H5Pset_fapl_mpio(plist_id, comm, info) < 0)
       throw std::runtime_error("Call to H5Pset_fapl_mpio unsuccessful");
     MPI_Info_free(&info);
@@ -118,16 +181,156 @@ hid_t io::hdf5::open_file(MPI_Comm comm, const std::filesystem::path& filename,
 //-----------------------------------------------------------------------------
 void io::hdf5::close_file(hid_t handle)
 {
+  set_async(handle, false);
   if (H5Fclose(handle) < 0)
     throw std::runtime_error("Failed to close HDF5 file.");
 }
 //-----------------------------------------------------------------------------
 void io::hdf5::flush_file(hid_t handle)
 {
+  wait(handle);
   if (H5Fflush(handle, H5F_SCOPE_GLOBAL) < 0)
     throw std::runtime_error("Failed to flush HDF5 file.");
 }
 //-----------------------------------------------------------------------------
+bool io::hdf5::set_async(hid_t handle, bool async)
+{
+  if (!async)
+  {
+    std::unique_lock lock(async_mutex);
+    auto it = async_files.find(handle);
+    if (it == async_files.end())
+      return false;
+
+    AsyncState state = std::move(it->second);
+    async_files.erase(it);
+    lock.unlock();
+
+    wait_event_set(state.es_id);
+#if H5_VERSION_GE(1, 14, 0)
+    if (H5ESclose(state.es_id) < 0)
+      throw std::runtime_error("Failed to close HDF5 event set.");
+#endif
+    return false;
+  }
+
+#if H5_VERSION_GE(1, 14, 0)
+  if (event_set(handle) != event_set_none)
+    return true;
+
+  // Operations are only asynchronous with the async VOL connector. With
+  // other connectors, e.g. the native connector, queued operations
+  // complete before they return and copying the data is a waste.
+  std::array<char, 64> name{};
+  if (H5VLget_connector_name(handle, name.data(), name.size()) < 0)
+    throw std::runtime_error("Failed to get HDF5 VOL connector name.");
+  if (std::string(name.data()) != "async")
+  {
+    spdlog::info("HDF5 file does not use the async VOL connector (\"{}\"). "
+                 "Operations are blocking.",
+                 name.data());
+    return false;
+  }
+
+  const hid_t es_id = H5EScreate();
+  if (es_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 event set.");
+  std::scoped_lock lock(async_mutex);
+  async_files.insert({handle, {es_id, {}}});
+  return true;
+#else
+  spdlog::info("Asynchronous HDF5 operations require HDF5 >= 1.14. "
+               "Operations are blocking.");
+  return false;
+#endif
+}
+//-----------------------------------------------------------------------------
+hid_t io::hdf5::event_set(hid_t handle)
+{
+  std::scoped_lock lock(async_mutex);
+  auto it = async_files.find(handle);
+  return it == async_files.end() ? event_set_none : it->second.es_id;
+}
+//-----------------------------------------------------------------------------
+void io::hdf5::wait(hid_t handle)
+{
+  hid_t es_id;
+  {
+    std::scoped_lock lock(async_mutex);
+    auto it = async_files.find(handle);
+    if (it == async_files.end())
+      return;
+    es_id = it->second.es_id;
+  }
+
+  wait_event_set(es_id);
+
+  std::scoped_lock lock(async_mutex);
+  if (auto it = async_files.find(handle); it != async_files.end())
+    it->second.buffers.clear();
+}
+//-----------------------------------------------------------------------------
+void io::hdf5::impl::retain(hid_t handle, std::shared_ptr<const void> buffer)
+{
+  std::scoped_lock lock(async_mutex);
+  if (auto it = async_files.find(handle); it != async_files.end())
+    it->second.buffers.push_back(std::move(buffer));
+}
+//-----------------------------------------------------------------------------
+hid_t io::hdf5::impl::create_dataset(hid_t handle, const std::string& path,
+                                     hid_t type_id, hid_t space_id,
+                                     hid_t dcpl_id,
+                                     [[maybe_unused]] hid_t es_id)
+{
+#if H5_VERSION_GE(1, 14, 0)
+  if (es_id != event_set_none)
+  {
+    return H5Dcreate_async(handle, path.c_str(), type_id, space_id,
+                           H5P_DEFAULT, dcpl_id, H5P_DEFAULT, es_id);
+  }
+#endif
+  return H5Dcreate2(handle, path.c_str(), type_id, space_id, H5P_DEFAULT,
+                    dcpl_id, H5P_DEFAULT);
+}
+//-----------------------------------------------------------------------------
+herr_t io::hdf5::impl::write(hid_t dset_id, hid_t type_id, hid_t mem_space_id,
+                             hid_t file_space_id, hid_t dxpl_id,
+                             const void* buf, [[maybe_unused]] hid_t es_id)
+{
+#if H5_VERSION_GE(1, 14, 0)
+  if (es_id != event_set_none)
+  {
+    return H5Dwrite_async(dset_id, type_id, mem_space_id, file_space_id,
+                          dxpl_id, buf, es_id);
+  }
+#endif
+  return H5Dwrite(dset_id, type_id, mem_space_id, file_space_id, dxpl_id, buf);
+}
+//-----------------------------------------------------------------------------
+herr_t io::hdf5::impl::read(hid_t dset_id, hid_t type_id, hid_t mem_space_id,
+                            hid_t file_space_id, hid_t dxpl_id, void* buf,
+                            [[maybe_unused]] hid_t es_id)
+{
+#if H5_VERSION_GE(1, 14, 0)
+  if (es_id != event_set_none)
+  {
+    return H5Dread_async(dset_id, type_id, mem_space_id, file_space_id,
+                         dxpl_id, buf, es_id);
+  }
+#endif
+  return H5Dread(dset_id, type_id, mem_space_id, file_space_id, dxpl_id, buf);
+}
+//-----------------------------------------------------------------------------
+herr_t io::hdf5::impl::close_dataset(hid_t dset_id,
+                                     [[maybe_unused]] hid_t es_id)
+{
+#if H5_VERSION_GE(1, 14, 0)
+  if (es_id != event_set_none)
+    return H5Dclose_async(dset_id, es_id);
+#endif
+  return H5Dclose(dset_id);
+}
+//-----------------------------------------------------------------------------
 std::filesystem::path io::hdf5::get_filename(hid_t handle)
 {
   // Get length of filename
@@ -198,6 +401,32 @@ void io::hdf5::add_group(hid_t handle, const std::string& group_name)
   }
 }
 //-----------------------------------------------------------------------------
+void io::hdf5::set_attribute(hid_t handle, const std::string& path,
+                             const std::string& name,
+                             const std::vector<std::int64_t>& value)
+{
+  const hsize_t size = value.size();
+  const hid_t space_id = H5Screate_simple(1, &size, nullptr);
+  if (space_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 attribute data space.");
+  create_attribute(handle, path, name, space_id, H5T_NATIVE_INT64,
+                   value.data());
+}
+//-----------------------------------------------------------------------------
+void io::hdf5::set_attribute(hid_t handle, const std::string& path,
+                             const std::string& name, const std::string& value)
+{
+  const hid_t type_id = H5Tcopy(H5T_C_S1);
+  if (H5Tset_size(type_id, std::max<std::size_t>(value.size(), 1)) < 0)
+    throw std::runtime_error("Failed to set size of HDF5 string type.");
+  const hid_t space_id = H5Screate(H5S_SCALAR);
+  if (space_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 attribute data space.");
+  create_attribute(handle, path, name, space_id, type_id, value.c_str());
+  if (H5Tclose(type_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 string type.");
+}
+//-----------------------------------------------------------------------------
 std::vector<std::int64_t>
 io::hdf5::get_dataset_shape(hid_t handle, const std::string& dataset_path)
 {
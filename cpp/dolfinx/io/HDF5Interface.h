@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <chrono>
@@ -13,9 +14,11 @@
 #include <dolfinx/common/log.h>
 #include <filesystem>
 #include <hdf5.h>
+#include <memory>
 #include <mpi.h>
 #include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::io::hdf5
@@ -29,6 +32,8 @@ hid_t hdf5_type()
     return H5T_NATIVE_FLOAT;
   else if constexpr (std::is_same_v<T, double>)
     return H5T_NATIVE_DOUBLE;
+  else if constexpr (std::is_same_v<T, std::uint8_t>)
+    return H5T_NATIVE_UINT8;
   else if constexpr (std::is_same_v<T, std::int32_t>)
     return H5T_NATIVE_INT32;
   else if constexpr (std::is_same_v<T, std::uint32_t>)
@@ -50,22 +55,111 @@ hid_t hdf5_type()
   }
 }
 
+/// @brief Storage layout and filter options for writing a dataset.
+struct DatasetOptions
+{
+  /// Number of rows (extent of the first dimension) in each chunk. If
+  /// 0, the dataset is stored contiguously unless compression is
+  /// requested. If negative, or if compression is requested with 0, a
+  /// chunk size between 1024 and 1048576 rows is chosen automatically.
+  std::int64_t chunk_size = 0;
+
+  /// Deflate (gzip) compression level in [0, 9]. 0 disables
+  /// compression. Compressed parallel writes use collective I/O and
+  /// require HDF5 >= 1.10.2.
+  int compression_level = 0;
+
+  /// Apply the byte shuffle filter before compression
+  bool shuffle = true;
+};
+
 /// Open HDF5 and return file descriptor
 /// @param[in] comm MPI communicator
 /// @param[in] filename Name of the HDF5 file to open
 /// @param[in] mode Mode in which to open the file (w, r, a)
 /// @param[in] use_mpi_io True if MPI-IO should be used
-hid_t open_file(MPI_Comm comm, const std::filesystem::path& filename,
-                const std::string& mode, bool use_mpi_io);
-
-/// Close HDF5 file
+/// @param[in] mpi_io_hints (key, value) MPI-IO hints, e.g.
+/// `{"romio_cb_write", "enable"}` or `{"cb_buffer_size", "16777216"}`
+/// to control collective buffering. Ignored if `use_mpi_io` is false.
+hid_t open_file(
+    MPI_Comm comm, const std::filesystem::path& filename,
+    const std::string& mode, bool use_mpi_io,
+    const std::vector<std::pair<std::string, std::string>>& mpi_io_hints
+    = {});
+
+/// Close HDF5 file, after completing outstanding asynchronous
+/// operations (see set_async)
 /// @param[in] handle HDF5 file handle
 void close_file(hid_t handle);
 
-/// Flush data to file to improve data integrity after interruption
+/// Flush data to file to improve data integrity after interruption.
+/// Outstanding asynchronous operations are completed first.
 /// @param[in] handle HDF5 file handle
 void flush_file(hid_t handle);
 
+/// Event set identifier for blocking operations
+#if H5_VERSION_GE(1, 13, 0)
+inline constexpr hid_t event_set_none = H5ES_NONE;
+#else
+inline constexpr hid_t event_set_none = 0;
+#endif
+
+/// @brief Enable or disable asynchronous dataset operations on a file.
+///
+/// Asynchronous operations use the HDF5 async VOL connector
+/// (https://github.com/hpc-io/vol-async), which is selected at run time
+/// with the environment variables `HDF5_VOL_CONNECTOR="async
+/// under_vol=0;under_info={}"` and `HDF5_PLUGIN_PATH`, and requires MPI
+/// to be initialised with `MPI_THREAD_MULTIPLE`. When enabled,
+/// write_dataset copies the data to a buffer and returns once the write
+/// has been queued, and the reads of several datasets can be queued
+/// together (see read_dataset). Outstanding operations are completed by
+/// wait, flush_file and close_file.
+///
+/// @param[in] handle HDF5 file handle
+/// @param[in] async True to enable asynchronous operations
+/// @return True if asynchronous operations are enabled. It is false if
+/// the file does not use the async VOL connector or HDF5 is older than
+/// 1.14, in which case all operations are blocking.
+bool set_async(hid_t handle, bool async);
+
+/// @brief Event set that holds the asynchronous operations on a file.
+/// @param[in] handle HDF5 file handle
+/// @return The event set, or `event_set_none` if asynchronous
+/// operations are not enabled for the file.
+hid_t event_set(hid_t handle);
+
+/// @brief Wait for the outstanding asynchronous operations on a file to
+/// complete and release their buffers.
+///
+/// An exception is raised if an operation failed.
+///
+/// @param[in] handle HDF5 file handle
+void wait(hid_t handle);
+
+namespace impl
+{
+/// Keep a buffer alive until the outstanding asynchronous operations on
+/// a file have completed
+void retain(hid_t handle, std::shared_ptr<const void> buffer);
+
+/// Create a dataset (H5Dcreate2), queued in event set `es_id`
+hid_t create_dataset(hid_t handle, const std::string& path, hid_t type_id,
+                     hid_t space_id, hid_t dcpl_id, hid_t es_id);
+
+/// Write a dataset (H5Dwrite), queued in event set `es_id`
+herr_t write(hid_t dset_id, hid_t type_id, hid_t mem_space_id,
+             hid_t file_space_id, hid_t dxpl_id, const void* buf,
+             hid_t es_id);
+
+/// Read a dataset (H5Dread), queued in event set `es_id`
+herr_t read(hid_t dset_id, hid_t type_id, hid_t mem_space_id,
+            hid_t file_space_id, hid_t dxpl_id, void* buf, hid_t es_id);
+
+/// Close a dataset (H5Dclose), queued in event set `es_id`
+herr_t close_dataset(hid_t dset_id, hid_t es_id);
+} // namespace impl
+
 /// Get filename
 /// @param[in] handle HDF5 file handle
 /// return The filename
@@ -109,6 +203,25 @@ bool get_mpi_atomicity(hid_t handle);
 /// @param[in] dataset_path Data set path to add
 void add_group(hid_t handle, const std::string& dataset_path);
 
+/// @brief Set an attribute of a group or dataset, replacing an
+/// existing attribute with the same name.
+/// @param[in] handle HDF5 file handle
+/// @param[in] path Path of the group or dataset
+/// @param[in] name Name of the attribute
+/// @param[in] value Value of the attribute (one-dimensional array)
+void set_attribute(hid_t handle, const std::string& path,
+                   const std::string& name,
+                   const std::vector<std::int64_t>& value);
+
+/// @brief Set a string attribute of a group or dataset, replacing an
+/// existing attribute with the same name.
+/// @param[in] handle HDF5 file handle
+/// @param[in] path Path of the group or dataset
+/// @param[in] name Name of the attribute
+/// @param[in] value Value of the attribute (fixed-length ASCII string)
+void set_attribute(hid_t handle, const std::string& path,
+                   const std::string& name, const std::string& value);
+
 /// Write data to existing HDF file as defined by range blocks on each
 /// process
 /// @param[in] file_handle HDF5 file handle
@@ -118,12 +231,14 @@ void add_group(hid_t handle, const std::string& dataset_path);
 /// @param[in] range The local range on this processor
 /// @param[in] global_size The global shape shape of the array
 /// @param[in] use_mpi_io True if MPI-IO should be used
-/// @param[in] use_chunking True if chunking should be used
+/// @param[in] options Chunking and compression options
+/// @note If asynchronous operations are enabled for the file (see
+/// set_async), the data is copied and the write is queued.
 template <typename T>
 void write_dataset(hid_t file_handle, const std::string& dataset_path,
                    const T* data, std::array<std::int64_t, 2> range,
                    const std::vector<int64_t>& global_size, bool use_mpi_io,
-                   bool use_chunking)
+                   const DatasetOptions& options = {})
 {
   // Data rank
   const int rank = global_size.size();
@@ -141,6 +256,19 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   std::vector<hsize_t> count(global_size.begin(), global_size.end());
   count[0] = range[1] - range[0];
 
+  // Queued writes read from a copy of the data, which is kept until the
+  // write has completed
+  const hid_t es_id = event_set(file_handle);
+  if (es_id != event_set_none)
+  {
+    auto buffer = std::make_shared<std::vector<T>>(
+        data, data
+                  + std::reduce(count.begin(), count.end(), hsize_t(1),
+                                std::multiplies{}));
+    data = buffer->data();
+    impl::retain(file_handle, std::move(buffer));
+  }
+
   // Data offsets
   std::vector<hsize_t> offset(rank, 0);
   offset[0] = range[0];
@@ -153,20 +281,47 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   if (filespace0 == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 data space");
 
-  // Set chunking parameters
+  // Set chunking and filter parameters. Chunks cannot be larger than
+  // the (fixed) dataset dimensions, and empty datasets are not chunked.
+  const bool compress = options.compression_level > 0;
+  const bool use_chunking = (options.chunk_size != 0 or compress)
+                            and std::ranges::all_of(dimsf, [](auto d)
+                                                    { return d > 0; });
   hid_t chunking_properties;
   if (use_chunking)
   {
-    // Set chunk size and limit to 1kB min/1MB max
-    hsize_t chunk_size = dimsf[0] / 2;
-    if (chunk_size > 1048576)
-      chunk_size = 1048576;
-    if (chunk_size < 1024)
-      chunk_size = 1024;
-
-    hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
+    if (options.compression_level > 9)
+      throw std::runtime_error("HDF5 compression level must be in [0, 9].");
+#if !H5_VERSION_GE(1, 10, 2)
+    if (compress and use_mpi_io)
+    {
+      throw std::runtime_error(
+          "Parallel HDF5 compression requires HDF5 >= 1.10.2.");
+    }
+#endif
+
+    // Use requested chunk size or limit to 1kB min/1MB max
+    hsize_t chunk_size;
+    if (options.chunk_size > 0)
+      chunk_size = options.chunk_size;
+    else
+      chunk_size = std::clamp<hsize_t>(dimsf[0] / 2, 1024, 1048576);
+
+    std::vector<hsize_t> chunk_dims = dimsf;
+    chunk_dims[0] = std::min(chunk_size, dimsf[0]);
     chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
-    H5Pset_chunk(chunking_properties, rank, chunk_dims);
+    if (H5Pset_chunk(chunking_properties, rank, chunk_dims.data()) < 0)
+      throw std::runtime_error("Failed to set HDF5 chunk size.");
+
+    if (compress)
+    {
+      if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+        throw std::runtime_error("HDF5 deflate filter is not available.");
+      if (options.shuffle and H5Pset_shuffle(chunking_properties) < 0)
+        throw std::runtime_error("Failed to set HDF5 shuffle filter.");
+      if (H5Pset_deflate(chunking_properties, options.compression_level) < 0)
+        throw std::runtime_error("Failed to set HDF5 deflate filter.");
+    }
   }
   else
     chunking_properties = H5P_DEFAULT;
@@ -177,23 +332,19 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
 
   // Create global dataset (using dataset_path)
   const hid_t dset_id
-      = H5Dcreate2(file_handle, dataset_path.c_str(), h5type, filespace0,
-                   H5P_DEFAULT, chunking_properties, H5P_DEFAULT);
+      = impl::create_dataset(file_handle, dataset_path, h5type, filespace0,
+                             chunking_properties, es_id);
   if (dset_id == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 global dataset.");
 
-  // Close global data space
-  if (herr_t status = H5Sclose(filespace0); status < 0)
-    throw std::runtime_error("Failed to close HDF5 global data space.");
-
   // Create a local data space
   const hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
   if (memspace == H5I_INVALID_HID)
     throw std::runtime_error("Failed to create HDF5 local data space.");
 
-  // Create a file dataspace within the global space - a hyperslab
-  const hid_t filespace1 = H5Dget_space(dset_id);
-  herr_t status = H5Sselect_hyperslab(filespace1, H5S_SELECT_SET, offset.data(),
+  // Select the hyperslab of this process in the global data space,
+  // which avoids querying the (possibly queued) dataset
+  herr_t status = H5Sselect_hyperslab(filespace0, H5S_SELECT_SET, offset.data(),
                                       nullptr, count.data(), nullptr);
   if (status < 0)
     throw std::runtime_error("Failed to create HDF5 dataspace.");
@@ -211,7 +362,8 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   }
 
   // Write local dataset into selected hyperslab
-  if (H5Dwrite(dset_id, h5type, memspace, filespace1, plist_id, data) < 0)
+  if (impl::write(dset_id, h5type, memspace, filespace0, plist_id, data, es_id)
+      < 0)
   {
     throw std::runtime_error(
         "Failed to write HDF5 local dataset into hyperslab.");
@@ -225,12 +377,12 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
   }
 
   // Close dataset collectively
-  if (H5Dclose(dset_id) < 0)
+  if (impl::close_dataset(dset_id, es_id) < 0)
     throw std::runtime_error("Failed to close HDF5 dataset.");
 
-  // Close hyperslab
-  if (H5Sclose(filespace1) < 0)
-    throw std::runtime_error("Failed to close HDF5 hyperslab.");
+  // Close global data space
+  if (H5Sclose(filespace0) < 0)
+    throw std::runtime_error("Failed to close HDF5 global data space.");
 
   // Close local dataset
   if (H5Sclose(memspace) < 0)
@@ -241,6 +393,138 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
     throw std::runtime_error("Failed to release HDF5 file-access template.");
 }
 
+/// @brief Append rows to a dataset as defined by range blocks on each
+/// process.
+///
+/// The dataset is created if it does not exist. It is chunked and has
+/// an unlimited first dimension, so that it can be extended by later
+/// calls, e.g. to add the data for a time step.
+///
+/// @param[in] file_handle HDF5 file handle
+/// @param[in] dataset_path Path for the dataset in the HDF5 file
+/// @param[in] data Rows to be appended, flattened into 1D vector
+///   (row-major storage)
+/// @param[in] range The local range of the appended rows on this
+/// processor, counted from the first appended row
+/// @param[in] global_size The global shape of the appended rows. The
+/// second dimension must be the same for all calls.
+/// @param[in] use_mpi_io True if MPI-IO should be used
+/// @return Number of rows in the dataset before the rows were appended
+template <typename T>
+std::int64_t append_dataset(hid_t file_handle, const std::string& dataset_path,
+                            const T* data, std::array<std::int64_t, 2> range,
+                            const std::vector<int64_t>& global_size,
+                            bool use_mpi_io)
+{
+  const int rank = global_size.size();
+  assert(rank != 0);
+  if (rank > 2)
+  {
+    throw std::runtime_error("Cannot append to HDF5 dataset. "
+                             "Only rank 1 and rank 2 dataset are supported");
+  }
+
+  const hid_t h5type = hdf5::hdf5_type<T>();
+
+  hid_t dset_id;
+  if (!has_dataset(file_handle, dataset_path))
+  {
+    // Create an empty dataset that can grow in the first dimension
+    std::vector<hsize_t> dims(global_size.begin(), global_size.end());
+    std::vector<hsize_t> max_dims = dims;
+    dims[0] = 0;
+    max_dims[0] = H5S_UNLIMITED;
+    const hid_t filespace
+        = H5Screate_simple(rank, dims.data(), max_dims.data());
+    if (filespace == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to create HDF5 data space");
+
+    std::vector<hsize_t> chunk_dims = max_dims;
+    chunk_dims[0] = std::clamp<hsize_t>(global_size[0], 1024, 1048576);
+    const hid_t chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
+    if (H5Pset_chunk(chunking_properties, rank, chunk_dims.data()) < 0)
+      throw std::runtime_error("Failed to set HDF5 chunk size.");
+
+    const std::string group_name(dataset_path, 0, dataset_path.rfind('/'));
+    add_group(file_handle, group_name);
+    dset_id = H5Dcreate2(file_handle, dataset_path.c_str(), h5type, filespace,
+                         H5P_DEFAULT, chunking_properties, H5P_DEFAULT);
+    if (dset_id == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to create HDF5 global dataset.");
+
+    if (H5Pclose(chunking_properties) < 0)
+      throw std::runtime_error("Failed to close HDF5 chunking properties.");
+    if (H5Sclose(filespace) < 0)
+      throw std::runtime_error("Failed to close HDF5 global data space.");
+  }
+  else
+    dset_id = open_dataset(file_handle, dataset_path);
+
+  // Get current shape and check that the appended rows are compatible
+  std::vector<hsize_t> dims(rank);
+  {
+    const hid_t filespace = H5Dget_space(dset_id);
+    if (filespace == H5I_INVALID_HID)
+      throw std::runtime_error("Failed to open HDF5 data space.");
+    if (H5Sget_simple_extent_ndims(filespace) != rank)
+      throw std::runtime_error("Rank of appended HDF5 data does not match.");
+    H5Sget_simple_extent_dims(filespace, dims.data(), nullptr);
+    if (H5Sclose(filespace) < 0)
+      throw std::runtime_error("Failed to close HDF5 data space.");
+  }
+  if (rank == 2 and dims[1] != static_cast<hsize_t>(global_size[1]))
+    throw std::runtime_error("Shape of appended HDF5 data does not match.");
+  const std::int64_t num_rows = dims[0];
+
+  // Extend dataset (collective)
+  dims[0] += global_size[0];
+  if (H5Dset_extent(dset_id, dims.data()) < 0)
+    throw std::runtime_error("Failed to extend HDF5 dataset.");
+
+  // Select the local rows in the extended dataset
+  std::vector<hsize_t> count = dims;
+  count[0] = range[1] - range[0];
+  std::vector<hsize_t> offset(rank, 0);
+  offset[0] = num_rows + range[0];
+  const hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
+  if (memspace == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to create HDF5 local data space.");
+  const hid_t filespace = H5Dget_space(dset_id);
+  if (H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset.data(), nullptr,
+                          count.data(), nullptr)
+      < 0)
+  {
+    throw std::runtime_error("Failed to create HDF5 dataspace.");
+  }
+
+  const hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+  if (use_mpi_io)
+  {
+    if (H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE) < 0)
+    {
+      throw std::runtime_error(
+          "Failed to set HDF5 data transfer property list.");
+    }
+  }
+
+  if (H5Dwrite(dset_id, h5type, memspace, filespace, plist_id, data) < 0)
+  {
+    throw std::runtime_error(
+        "Failed to write HDF5 local dataset into hyperslab.");
+  }
+
+  if (H5Pclose(plist_id) < 0)
+    throw std::runtime_error("Failed to release HDF5 file-access template.");
+  if (H5Sclose(filespace) < 0)
+    throw std::runtime_error("Failed to close HDF5 hyperslab.");
+  if (H5Sclose(memspace) < 0)
+    throw std::runtime_error("Failed to close local HDF5 dataset.");
+  if (H5Dclose(dset_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 dataset.");
+
+  return num_rows;
+}
+
 /// Read data from a HDF5 dataset "dataset_path" as defined by range blocks on
 /// each process.
 ///
@@ -248,11 +532,15 @@ void write_dataset(hid_t file_handle, const std::string& dataset_path,
 /// @param[in] dset_id HDF5 file handle.
 /// @param[in] range The local range on this processor.
 /// @param[in] allow_cast If true, allow casting from HDF5 type to type `T`.
+/// @param[in] es_id Event set in which the read is queued (see
+/// event_set), or `event_set_none` for a blocking read. If queued, the
+/// values are available once the event set has completed (see wait),
+/// and the dataset must be closed with a queued close.
 /// @return Flattened 1D array of values. If range = {-1, -1}, then all data
 /// is read on this process.
 template <typename T>
 std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
-                            bool allow_cast)
+                            bool allow_cast, hid_t es_id = event_set_none)
 {
   auto timer_start = std::chrono::system_clock::now();
 
@@ -323,12 +611,12 @@ std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
 
   // Create local data to read into
   std::vector<T> data(
-      std::reduce(count.begin(), count.end(), 1, std::multiplies{}));
+      std::reduce(count.begin(), count.end(), hsize_t(1), std::multiplies{}));
 
   // Read data on each process
   hid_t h5type = hdf5::hdf5_type<T>();
-  if (herr_t status
-      = H5Dread(dset_id, h5type, memspace, dataspace, H5P_DEFAULT, data.data());
+  if (herr_t status = impl::read(dset_id, h5type, memspace, dataspace,
+                                 H5P_DEFAULT, data.data(), es_id);
       status < 0)
   {
     throw std::runtime_error("Failed to read HDF5 data.");
@@ -342,10 +630,13 @@ std::vector<T> read_dataset(hid_t dset_id, std::array<std::int64_t, 2> range,
   if (herr_t status = H5Sclose(memspace); status < 0)
     throw std::runtime_error("Failed to close HDF5 memory space.");
 
-  auto timer_end = std::chrono::system_clock::now();
-  std::chrono::duration<double> dt = (timer_end - timer_start);
-  double data_rate = data.size() * sizeof(T) / (1e6 * dt.count());
-  spdlog::info("HDF5 Read data rate: {} MB/s", data_rate);
+  if (es_id == event_set_none)
+  {
+    auto timer_end = std::chrono::system_clock::now();
+    std::chrono::duration<double> dt = (timer_end - timer_start);
+    double data_rate = data.size() * sizeof(T) / (1e6 * dt.count());
+    spdlog::info("HDF5 Read data rate: {} MB/s", data_rate);
+  }
 
   return data;
 }
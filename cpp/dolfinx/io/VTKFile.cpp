@@ -9,6 +9,7 @@
 #include "vtk_utils.h"
 #include "xdmf_utils.h"
 #include <algorithm>
+#include <bit>
 #include <concepts>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
@@ -20,11 +21,19 @@
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <filesystem>
+#include <fstream>
 #include <iterator>
+#include <memory>
+#include <numeric>
 #include <pugixml.hpp>
 #include <span>
 #include <sstream>
 #include <string>
+#include <vector>
+
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace dolfinx;
 
@@ -63,11 +72,163 @@ std::stringstream container_to_string(const T& x, int precision)
 {
   std::stringstream s;
   s.precision(precision);
-  std::ranges::for_each(x, [&s](auto e) { s << e << " "; });
+  std::ranges::for_each(x,
+                        [&s](auto e)
+                        {
+                          // Write 8-bit integers as numbers, not characters
+                          if constexpr (sizeof(e) == 1)
+                            s << static_cast<int>(e) << " ";
+                          else
+                            s << e << " ";
+                        });
   return s;
 }
 //----------------------------------------------------------------------------
 
+/// Data for the `AppendedData` section of a .vtu file. Each data array
+/// is a UInt64 header followed by the (possibly compressed) array
+/// bytes.
+struct AppendedData
+{
+  /// zlib compression of the data arrays
+  bool compress = false;
+
+  /// Raw data of all arrays
+  std::vector<char> bytes;
+};
+//----------------------------------------------------------------------------
+
+/// Append a data array to the appended data section
+template <typename T>
+void append_raw(AppendedData& appended, std::span<const T> values)
+{
+  auto append_bytes = [&bytes = appended.bytes](const void* data,
+                                                std::size_t size)
+  {
+    const char* c = static_cast<const char*>(data);
+    bytes.insert(bytes.end(), c, c + size);
+  };
+
+  const std::uint64_t num_bytes = values.size_bytes();
+  if (!appended.compress)
+  {
+    append_bytes(&num_bytes, sizeof(num_bytes));
+    append_bytes(values.data(), num_bytes);
+  }
+  else
+  {
+#ifdef HAS_ZLIB
+    // Compress in blocks. The header is [num_blocks, block size, size
+    // of the last block (0 if it is full), compressed size of each
+    // block]
+    constexpr std::uint64_t block_size = 1 << 15;
+    const std::uint64_t num_blocks = (num_bytes + block_size - 1) / block_size;
+    std::vector<std::uint64_t> header(3 + num_blocks);
+    header[0] = num_blocks;
+    header[1] = block_size;
+    header[2] = num_bytes % block_size;
+
+    const Bytef* src = reinterpret_cast<const Bytef*>(values.data());
+    std::vector<char> buffer;
+    for (std::uint64_t b = 0; b < num_blocks; ++b)
+    {
+      const std::uint64_t offset = b * block_size;
+      const uLong size = std::min(block_size, num_bytes - offset);
+      const std::size_t pos = buffer.size();
+      uLongf compressed_size = compressBound(size);
+      buffer.resize(pos + compressed_size);
+      int err = compress2(reinterpret_cast<Bytef*>(buffer.data() + pos),
+                          &compressed_size, src + offset, size,
+                          Z_DEFAULT_COMPRESSION);
+      if (err != Z_OK)
+        throw std::runtime_error("zlib compression of VTK data failed.");
+      buffer.resize(pos + compressed_size);
+      header[3 + b] = compressed_size;
+    }
+
+    append_bytes(header.data(), header.size() * sizeof(std::uint64_t));
+    append_bytes(buffer.data(), buffer.size());
+#else
+    throw std::runtime_error("DOLFINx has not been built with zlib.");
+#endif
+  }
+}
+//----------------------------------------------------------------------------
+
+/// @brief Set the values of a DataArray node.
+///
+/// If `appended` is null the values are written as ASCII text.
+/// Otherwise they are added to `appended` and the node references them
+/// by offset.
+template <typename T>
+void set_data(pugi::xml_node& node, std::span<const T> values,
+              AppendedData* appended)
+{
+  if (appended)
+  {
+    node.append_attribute("format") = "appended";
+    node.append_attribute("offset") = appended->bytes.size();
+    append_raw(*appended, values);
+  }
+  else
+  {
+    node.append_attribute("format") = "ascii";
+    node.append_child(pugi::node_pcdata)
+        .set_value(container_to_string(values, 16).str().c_str());
+  }
+}
+//----------------------------------------------------------------------------
+
+/// Create the VTKFile node of a .vtu file
+pugi::xml_node create_vtu_node(pugi::xml_document& xml_vtu,
+                               const AppendedData* appended)
+{
+  pugi::xml_node vtk_node = xml_vtu.append_child("VTKFile");
+  vtk_node.append_attribute("type") = "UnstructuredGrid";
+  vtk_node.append_attribute("version") = "2.2";
+  if (appended)
+  {
+    vtk_node.append_attribute("byte_order")
+        = std::endian::native == std::endian::little ? "LittleEndian"
+                                                     : "BigEndian";
+    vtk_node.append_attribute("header_type") = "UInt64";
+    if (appended->compress)
+      vtk_node.append_attribute("compressor") = "vtkZLibDataCompressor";
+  }
+  return vtk_node;
+}
+//----------------------------------------------------------------------------
+
+/// @brief Save a .vtu file.
+///
+/// Raw binary data cannot be stored in an XML text node, so the
+/// `AppendedData` section is written directly to the file before the
+/// closing VTKFile tag.
+void save_vtu(const pugi::xml_document& xml_vtu, const AppendedData* appended,
+              const std::filesystem::path& filename)
+{
+  if (!appended)
+  {
+    xml_vtu.save_file(filename.c_str(), "  ");
+    return;
+  }
+
+  std::ostringstream ss;
+  xml_vtu.save(ss, "  ");
+  const std::string xml = ss.str();
+  const std::size_t pos = xml.rfind("</VTKFile>");
+  assert(pos != std::string::npos);
+
+  std::ofstream file(filename, std::ios::binary);
+  file.write(xml.data(), pos);
+  file << "  <AppendedData encoding=\"raw\">\n    _";
+  file.write(appended->bytes.data(), appended->bytes.size());
+  file << "\n  </AppendedData>\n";
+  file.write(xml.data() + pos, xml.size() - pos);
+}
+//----------------------------------------------------------------------------
+
+
 void add_pvtu_mesh(pugi::xml_node& node)
 {
   // -- Cell data (PCellData)
@@ -109,15 +270,19 @@ void add_pvtu_mesh(pugi::xml_node& node)
 }
 //----------------------------------------------------------------------------
 
+
 /// Add float data to a pugixml node
 /// @param[in] name The name of the data array
 /// @param[in] num_components An array indicating the value shape of `values`
 /// @param[in] values The data array to add
 /// @param[in,out] data_node The XML node to add data to
+/// @param[in,out] appended Appended data section, or null for ASCII
+/// output
 template <typename T>
 void add_data_float(const std::string& name,
                     std::span<const std::size_t> num_components,
-                    std::span<const T> values, pugi::xml_node& node)
+                    std::span<const T> values, pugi::xml_node& node,
+                    AppendedData* appended)
 {
   static_assert(std::is_floating_point_v<T>, "Scalar must be a float");
 
@@ -127,12 +292,9 @@ void add_data_float(const std::string& name,
   pugi::xml_node field_node = node.append_child("DataArray");
   field_node.append_attribute("type") = type.c_str();
   field_node.append_attribute("Name") = name.c_str();
-  field_node.append_attribute("format") = "ascii";
   if (!num_components.empty())
     field_node.append_attribute("NumberOfComponents") = num_components.front();
-
-  field_node.append_child(pugi::node_pcdata)
-      .set_value(container_to_string(values, 16).str().c_str());
+  set_data(field_node, values, appended);
 }
 //----------------------------------------------------------------------------
 
@@ -144,23 +306,26 @@ void add_data_float(const std::string& name,
 /// @param[in] num_components An array indicating the value shape of `values`
 /// @param[in] values The data array to add
 /// @param[in,out] data_node The XML node to add data to
+/// @param[in,out] appended Appended data section, or null for ASCII
+/// output
 template <typename T>
 void add_data(const std::string& name,
               std::span<const std::size_t> num_components,
-              std::span<const T> values, pugi::xml_node& node)
+              std::span<const T> values, pugi::xml_node& node,
+              AppendedData* appended)
 {
   if constexpr (std::is_scalar_v<T>)
-    add_data_float(name, num_components, values, node);
+    add_data_float(name, num_components, values, node, appended);
   else
   {
     using U = typename T::value_type;
     std::vector<U> v(values.size());
     std::ranges::transform(values, v.begin(), [](auto x) { return x.real(); });
     add_data_float(name + field_ext[0], num_components, std::span<const U>(v),
-                   node);
+                   node, appended);
     std::ranges::transform(values, v.begin(), [](auto x) { return x.imag(); });
     add_data_float(name + field_ext[1], num_components, std::span<const U>(v),
-                   node);
+                   node, appended);
   }
 }
 //----------------------------------------------------------------------------
@@ -177,6 +342,8 @@ void add_data(const std::string& name,
 /// @param[in] celltype The cell type
 /// @param[in] tdim Topological dimension of the cells
 /// @param[in,out] piece_node The XML node to add data to
+/// @param[in,out] appended Appended data section, or null for ASCII
+/// output
 template <typename U>
 void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
               std::span<const std::int64_t> x_id,
@@ -184,7 +351,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
               std::span<const std::int64_t> cells,
               std::array<std::size_t, 2> cshape,
               const common::IndexMap& cellmap, mesh::CellType celltype,
-              int tdim, pugi::xml_node& piece_node)
+              int tdim, pugi::xml_node& piece_node, AppendedData* appended)
 {
   // -- Add geometry (points)
 
@@ -192,9 +359,13 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node x_node = points_node.append_child("DataArray");
   x_node.append_attribute("type") = "Float64";
   x_node.append_attribute("NumberOfComponents") = "3";
-  x_node.append_attribute("format") = "ascii";
-  x_node.append_child(pugi::node_pcdata)
-      .set_value(container_to_string(x, 16).str().c_str());
+  if constexpr (std::is_same_v<U, double>)
+    set_data(x_node, x, appended);
+  else
+  {
+    std::vector<double> x64(x.begin(), x.end());
+    set_data(x_node, std::span<const double>(x64), appended);
+  }
 
   // -- Add topology (cells)
 
@@ -202,36 +373,29 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node connectivity_node = cells_node.append_child("DataArray");
   connectivity_node.append_attribute("type") = "Int32";
   connectivity_node.append_attribute("Name") = "connectivity";
-  connectivity_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    std::ranges::for_each(cells, [&ss](auto& v) { ss << v << " "; });
-    connectivity_node.append_child(pugi::node_pcdata)
-        .set_value(ss.str().c_str());
+    std::vector<std::int32_t> connectivity(cells.begin(), cells.end());
+    set_data(connectivity_node, std::span<const std::int32_t>(connectivity),
+             appended);
   }
 
   pugi::xml_node offsets_node = cells_node.append_child("DataArray");
   offsets_node.append_attribute("type") = "Int32";
   offsets_node.append_attribute("Name") = "offsets";
-  offsets_node.append_attribute("format") = "ascii";
   {
-    std::stringstream ss;
-    int num_nodes = cshape[1];
+    std::vector<std::int32_t> offsets(cshape[0]);
     for (std::size_t i = 0; i < cshape[0]; ++i)
-      ss << (i + 1) * num_nodes << " ";
-    offsets_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+      offsets[i] = (i + 1) * cshape[1];
+    set_data(offsets_node, std::span<const std::int32_t>(offsets), appended);
   }
 
   pugi::xml_node type_node = cells_node.append_child("DataArray");
   type_node.append_attribute("type") = "Int8";
   type_node.append_attribute("Name") = "types";
-  type_node.append_attribute("format") = "ascii";
-  int vtk_celltype = io::cells::get_vtk_cell_type(celltype, tdim);
   {
-    std::stringstream ss;
-    for (std::size_t c = 0; c < cshape[0]; ++c)
-      ss << vtk_celltype << " ";
-    type_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::int8_t> types(
+        cshape[0], io::cells::get_vtk_cell_type(celltype, tdim));
+    set_data(type_node, std::span<const std::int8_t>(types), appended);
   }
 
   // Ghost cell markers
@@ -240,16 +404,14 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node ghost_cell_node = cells_data_node.append_child("DataArray");
   ghost_cell_node.append_attribute("type") = "UInt8";
   ghost_cell_node.append_attribute("Name") = "vtkGhostType";
-  ghost_cell_node.append_attribute("format") = "ascii";
   ghost_cell_node.append_attribute("RangeMin") = "0";
   ghost_cell_node.append_attribute("RangeMax") = "1";
   {
-    std::stringstream ss;
-    for (std::int32_t c = 0; c < cellmap.size_local(); ++c)
-      ss << 0 << " ";
-    for (std::size_t c = cellmap.size_local(); c < cshape[0]; ++c)
-      ss << 1 << " ";
-    ghost_cell_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+    std::vector<std::uint8_t> ghosts(cshape[0], 0);
+    std::fill(std::next(ghosts.begin(), cellmap.size_local()), ghosts.end(),
+              1);
+    set_data(ghost_cell_node, std::span<const std::uint8_t>(ghosts),
+             appended);
   }
 
   // Original cell IDs
@@ -257,15 +419,11 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   cell_id_node.append_attribute("type") = "Int64";
   cell_id_node.append_attribute("IdType") = "1";
   cell_id_node.append_attribute("Name") = "vtkOriginalCellIds";
-  cell_id_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    const std::int64_t cell_offset = cellmap.local_range()[0];
-    for (std::int32_t c = 0; c < cellmap.size_local(); ++c)
-      ss << cell_offset + c << " ";
-    std::ranges::for_each(cellmap.ghosts(),
-                          [&ss](auto& idx) { ss << idx << " "; });
-    cell_id_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
+  {
+    std::vector<std::int64_t> ids(cellmap.size_local());
+    std::iota(ids.begin(), ids.end(), cellmap.local_range()[0]);
+    ids.insert(ids.end(), cellmap.ghosts().begin(), cellmap.ghosts().end());
+    set_data(cell_id_node, std::span<const std::int64_t>(ids), appended);
   }
 
   auto [min_idx, max_idx] = cellmap.local_range();
@@ -287,12 +445,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   point_id_node.append_attribute("type") = "Int64";
   point_id_node.append_attribute("IdType") = "1";
   point_id_node.append_attribute("Name") = "vtkOriginalPointIds";
-  point_id_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::ranges::for_each(x_id, [&ss](auto idx) { ss << idx << " "; });
-    point_id_node.append_child(pugi::node_pcdata).set_value(ss.str().c_str());
-  }
+  set_data(point_id_node, x_id, appended);
   if (!x_id.empty())
   {
     auto [min, max] = std::ranges::minmax_element(x_id);
@@ -304,13 +457,7 @@ void add_mesh(std::span<const U> x, std::array<std::size_t, 2> /*xshape*/,
   pugi::xml_node point_ghost_node = points_data_node.append_child("DataArray");
   point_ghost_node.append_attribute("type") = "UInt8";
   point_ghost_node.append_attribute("Name") = "vtkGhostType";
-  point_ghost_node.append_attribute("format") = "ascii";
-  {
-    std::stringstream ss;
-    std::ranges::for_each(x_ghost, [&ss](int ghost) { ss << ghost << " "; });
-    point_ghost_node.append_child(pugi::node_pcdata)
-        .set_value(ss.str().c_str());
-  }
+  set_data(point_ghost_node, x_ghost, appended);
   if (!x_ghost.empty())
   {
     auto [min, max] = std::ranges::minmax_element(x_ghost);
@@ -323,7 +470,8 @@ template <dolfinx::scalar T, std::floating_point U>
 void write_function(
     const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
     double time, pugi::xml_document* xml_doc,
-    const std::filesystem::path& filename)
+    const std::filesystem::path& filename, io::VTKFile::Encoding encoding,
+    io::VTKFile::Compression compression)
 {
   if (!xml_doc)
     throw std::runtime_error("VTKFile has been closed");
@@ -396,10 +544,14 @@ void write_function(
   const std::string counter_str = get_counter(xml_collections, "DataSet");
 
   // Create a VTU XML object
+  std::unique_ptr<AppendedData> appended;
+  if (encoding == io::VTKFile::Encoding::appended)
+  {
+    appended = std::make_unique<AppendedData>(
+        AppendedData{compression == io::VTKFile::Compression::zlib, {}});
+  }
   pugi::xml_document xml_vtu;
-  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
-  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
-  vtk_node_vtu.append_attribute("version") = "2.2";
+  pugi::xml_node vtk_node_vtu = create_vtu_node(xml_vtu, appended.get());
   pugi::xml_node grid_node_vtu = vtk_node_vtu.append_child("UnstructuredGrid");
 
   auto topology0 = mesh0->topology();
@@ -419,6 +571,11 @@ void write_function(
         mesh0->geometry().dofmap(), topology0->cell_type());
     cells.assign(tmp.begin(), tmp.end());
     const mesh::Geometry<U>& geometry = mesh0->geometry();
+    if (geometry.x_stride() != 3)
+    {
+      throw std::runtime_error("Cannot write a geometry with coordinate "
+                               "stride other than three.");
+    }
     x.assign(geometry.x().begin(), geometry.x().end());
     xshape = {geometry.x().size() / 3, 3};
     x_id = geometry.input_global_indices();
@@ -444,7 +601,7 @@ void write_function(
   int tdim = topology0->dim();
   add_mesh<U>(x, xshape, x_id, x_ghost, cells, cshape,
               *topology0->index_map(tdim), cell_type, topology0->dim(),
-              piece_node);
+              piece_node, appended.get());
 
   // FIXME: is this actually setting the first?
   // Set last scalar/vector/tensor Functions in u to be the 'active'
@@ -506,7 +663,7 @@ void write_function(
       }
 
       add_data(_u.get().name, std::span<const std::size_t>(component_vector),
-               std::span<const T>(data), data_node);
+               std::span<const T>(data), data_node, appended.get());
     }
     else
     {
@@ -540,14 +697,14 @@ void write_function(
         if (mesh0->geometry().dim() == 3)
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   _u.get().x()->array(), data_node);
+                   _u.get().x()->array(), data_node, appended.get());
         else
         {
           // Pad with zeros and then add
           auto data = pad_data(*V, _u.get().x()->array());
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(data), data_node);
+                   std::span<const T>(data), data_node, appended.get());
         }
       }
       else if (*e == *element0)
@@ -583,14 +740,14 @@ void write_function(
         if (mesh0->geometry().dim() == 3)
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(u), data_node);
+                   std::span<const T>(u), data_node, appended.get());
         else
         {
           // Pad with zeros and then add
           auto data = pad_data(*V, _u.get().x()->array());
           add_data(_u.get().name,
                    std::span<const std::size_t>(component_vector),
-                   std::span<const T>(data), data_node);
+                   std::span<const T>(data), data_node, appended.get());
         }
       }
       else
@@ -616,7 +773,7 @@ void write_function(
   std::filesystem::path vtu = create_vtu_path(mpi_rank);
   if (vtu.has_parent_path())
     std::filesystem::create_directories(vtu.parent_path());
-  xml_vtu.save_file(vtu.c_str(), "  ");
+  save_vtu(xml_vtu, appended.get(), vtu);
 
   // -- Create a PVTU XML object on rank 0
   std::filesystem::path p_pvtu = filename.parent_path() / filename.stem();
@@ -715,9 +872,21 @@ void write_function(
 
 //----------------------------------------------------------------------------
 io::VTKFile::VTKFile(MPI_Comm comm, const std::filesystem::path& filename,
-                     const std::string&)
-    : _filename(filename), _comm(comm)
+                     const std::string&, Encoding encoding,
+                     Compression compression)
+    : _filename(filename), _comm(comm), _encoding(encoding),
+      _compression(compression)
 {
+  if (compression != Compression::none and encoding != Encoding::appended)
+  {
+    throw std::runtime_error(
+        "VTKFile compression requires appended data encoding.");
+  }
+#ifndef HAS_ZLIB
+  if (compression == Compression::zlib)
+    throw std::runtime_error("DOLFINx has not been built with zlib.");
+#endif
+
   _pvd_xml = std::make_unique<pugi::xml_document>();
   assert(_pvd_xml);
   pugi::xml_node vtk_node = _pvd_xml->append_child("VTKFile");
@@ -793,10 +962,14 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
                                  + topology->index_map(tdim)->num_ghosts();
 
   // Create a VTU XML object
+  std::unique_ptr<AppendedData> appended;
+  if (_encoding == io::VTKFile::Encoding::appended)
+  {
+    appended = std::make_unique<AppendedData>(
+        AppendedData{_compression == io::VTKFile::Compression::zlib, {}});
+  }
   pugi::xml_document xml_vtu;
-  pugi::xml_node vtk_node_vtu = xml_vtu.append_child("VTKFile");
-  vtk_node_vtu.append_attribute("type") = "UnstructuredGrid";
-  vtk_node_vtu.append_attribute("version") = "2.2";
+  pugi::xml_node vtk_node_vtu = create_vtu_node(xml_vtu, appended.get());
   pugi::xml_node grid_node_vtu = vtk_node_vtu.append_child("UnstructuredGrid");
 
   // Add "Piece" node and required metadata
@@ -807,6 +980,11 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
   mesh::CellType cell_type = topology->cell_type();
 
   // Add mesh data to "Piece" node
+  if (geometry.x_stride() != 3)
+  {
+    throw std::runtime_error(
+        "Cannot write a geometry with coordinate stride other than three.");
+  }
   const auto [cells, cshape]
       = extract_vtk_connectivity(mesh.geometry().dofmap(), cell_type);
   std::array<std::size_t, 2> xshape = {geometry.x().size() / 3, 3};
@@ -814,7 +992,7 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
   std::fill(std::next(x_ghost.begin(), xmap->size_local()), x_ghost.end(), 1);
   add_mesh(geometry.x(), xshape, geometry.input_global_indices(), x_ghost,
            cells, cshape, *topology->index_map(tdim), cell_type,
-           topology->dim(), piece_node);
+           topology->dim(), piece_node, appended.get());
 
   // Create filepath for a .vtu file
   auto create_vtu_path = [file_root = _filename.parent_path(),
@@ -831,7 +1009,7 @@ void io::VTKFile::write(const mesh::Mesh<U>& mesh, double time)
   std::filesystem::path vtu = create_vtu_path(mpi_rank);
   if (vtu.has_parent_path())
     std::filesystem::create_directories(vtu.parent_path());
-  xml_vtu.save_file(vtu.c_str(), "  ");
+  save_vtu(xml_vtu, appended.get(), vtu);
 
   // Create a PVTU XML object on rank 0
   std::filesystem::path p_pvtu = _filename.parent_path() / _filename.stem();
@@ -876,7 +1054,8 @@ void io::VTKFile::write(
     const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
     double time)
 {
-  write_function<T, U>(u, time, _pvd_xml.get(), _filename);
+  write_function<T, U>(u, time, _pvd_xml.get(), _filename, _encoding,
+                       _compression);
 }
 //-----------------------------------------------------------------------------
 // Instantiation for different types
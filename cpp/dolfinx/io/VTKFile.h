@@ -42,13 +42,40 @@ namespace dolfinx::io
 /// be isoparametic, i.e. the geometry and the finite element functions
 /// must be defined using the same basis.
 ///
+/// Data arrays in the `.vtu` files are written either as ASCII text or
+/// as raw binary data in an appended data section, which is
+/// considerably faster to write and smaller on disk. Appended data can
+/// optionally be zlib compressed.
+///
 /// @warning This format is not suitable for checkpointing.
 class VTKFile
 {
 public:
-  /// Create VTK file
+  /// Data array encoding
+  enum class Encoding
+  {
+    ascii,   ///< Plain text, inline in the XML
+    appended ///< Raw binary, in the `AppendedData` section
+  };
+
+  /// Compression of appended binary data
+  enum class Compression
+  {
+    none,
+    zlib
+  };
+
+  /// @brief Create VTK file.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the `.pvd` file.
+  /// @param[in] file_mode File mode.
+  /// @param[in] encoding Encoding of the data arrays.
+  /// @param[in] compression Compression of the data arrays. Requires
+  /// `Encoding::appended`, and zlib compression requires DOLFINx to be
+  /// built with zlib.
   VTKFile(MPI_Comm comm, const std::filesystem::path& filename,
-          const std::string& file_mode);
+          const std::string& file_mode, Encoding encoding = Encoding::ascii,
+          Compression compression = Compression::none);
 
   /// Destructor
   ~VTKFile();
@@ -92,5 +119,9 @@ private:
 
   // MPI communicator
   dolfinx::MPI::Comm _comm;
+
+  // Data array encoding and compression
+  Encoding _encoding;
+  Compression _compression;
 };
 } // namespace dolfinx::io
@@ -0,0 +1,415 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "VTKHDFFile.h"
+#include "HDF5Interface.h"
+#include "cells.h"
+#include "vtk_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace dolfinx;
+
+namespace
+{
+/// String suffix for real and complex components of a vector-valued
+/// field
+constexpr std::array field_ext = {"_real", "_imag"};
+
+/// Root group of the VTKHDF data
+const std::string root = "/VTKHDF";
+
+//----------------------------------------------------------------------------
+template <typename T>
+bool is_cellwise(const fem::FiniteElement<T>& e)
+{
+  return e.space_dimension() / e.block_size() == 1;
+}
+//----------------------------------------------------------------------------
+
+/// Number of components of the data array of a function. Vectors and
+/// tensors are padded to 3D to ensure that they can be visualised
+/// correctly in ParaView.
+template <typename T>
+int num_components(const fem::FiniteElement<T>& e)
+{
+  std::span<const std::size_t> value_shape = e.value_shape();
+  const int rank = value_shape.size();
+  int num_comp = std::reduce(value_shape.begin(), value_shape.end(), 1,
+                             std::multiplies{});
+  if (num_comp < std::pow(3, rank))
+    num_comp = std::pow(3, rank);
+  return num_comp;
+}
+//----------------------------------------------------------------------------
+
+/// Names of the data arrays of a function
+template <dolfinx::scalar T, std::floating_point U>
+std::vector<std::string> data_names(const fem::Function<T, U>& u)
+{
+  if constexpr (std::is_scalar_v<T>)
+    return {u.name};
+  else
+    return {u.name + field_ext[0], u.name + field_ext[1]};
+}
+//----------------------------------------------------------------------------
+
+} // namespace
+
+//----------------------------------------------------------------------------
+io::VTKHDFFile::VTKHDFFile(MPI_Comm comm, const std::filesystem::path& filename,
+                           bool reuse_mesh)
+    : _comm(comm), _h5_id(-1), _mpi_io(dolfinx::MPI::size(comm) > 1),
+      _reuse_mesh(reuse_mesh), _num_steps(0), _grid_offsets({0, 0, 0, 0})
+{
+  _h5_id = hdf5::open_file(_comm.comm(), filename, "w", _mpi_io);
+  hdf5::add_group(_h5_id, root + "/Steps");
+  hdf5::set_attribute(_h5_id, root, "Version", std::vector<std::int64_t>{2, 0});
+  hdf5::set_attribute(_h5_id, root, "Type", "UnstructuredGrid");
+  hdf5::set_attribute(_h5_id, root + "/Steps", "NSteps",
+                      std::vector<std::int64_t>{0});
+}
+//----------------------------------------------------------------------------
+io::VTKHDFFile::~VTKHDFFile() { close(); }
+//----------------------------------------------------------------------------
+void io::VTKHDFFile::close()
+{
+  if (_h5_id > 0)
+    hdf5::close_file(_h5_id);
+  _h5_id = -1;
+}
+//----------------------------------------------------------------------------
+void io::VTKHDFFile::flush()
+{
+  if (_h5_id <= 0)
+    throw std::runtime_error("VTKHDFFile has already been closed");
+  hdf5::flush_file(_h5_id);
+}
+//----------------------------------------------------------------------------
+template <std::floating_point U>
+void io::VTKHDFFile::write(const mesh::Mesh<U>& mesh, double time)
+{
+  if (_h5_id <= 0)
+    throw std::runtime_error("VTKHDFFile has already been closed");
+  check_data_names({}, {});
+
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  const std::size_t num_cells = topology->index_map(tdim)->size_local();
+  const auto [cells, cshape] = io::extract_vtk_connectivity(
+      mesh.geometry().dofmap(), topology->cell_type());
+  if (mesh.geometry().x_stride() != 3)
+  {
+    throw std::runtime_error(
+        "Cannot write a geometry with coordinate stride other than three.");
+  }
+  write_grid(mesh.geometry().x(), cells, {num_cells, cshape[1]},
+             cells::get_vtk_cell_type(topology->cell_type(), tdim));
+
+  // A grid written for a mesh is not re-used by the next time step,
+  // since the mesh geometry may have changed
+  _grid.reset();
+
+  write_step(time, {}, {});
+}
+//----------------------------------------------------------------------------
+template <dolfinx::scalar T, std::floating_point U>
+void io::VTKHDFFile::write(
+    const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
+    double t)
+{
+  if (_h5_id <= 0)
+    throw std::runtime_error("VTKHDFFile has already been closed");
+  if (u.empty())
+    return;
+
+  // Extract the first function space with pointwise data. If no
+  // pointwise functions, take first FunctionSpace.
+  auto V0 = u.front().get().function_space();
+  assert(V0);
+  for (auto& v : u)
+  {
+    auto V = v.get().function_space();
+    assert(V);
+    if (!is_cellwise(*V->element()))
+    {
+      V0 = V;
+      break;
+    }
+  }
+
+  // Check compatibility for all functions
+  auto mesh0 = V0->mesh();
+  assert(mesh0);
+  auto element0 = V0->element();
+  for (auto& v : u)
+  {
+    auto V = v.get().function_space();
+    assert(V);
+    if (V->mesh() != mesh0)
+    {
+      throw std::runtime_error(
+          "All Functions written to VTKHDF file must share the same Mesh.");
+    }
+
+    if (!V->component().empty())
+      throw std::runtime_error("Cannot write sub-Functions to VTKHDF file.");
+
+    auto e = V->element();
+    assert(e);
+    if (!e->interpolation_ident())
+    {
+      throw std::runtime_error("Only Lagrange functions are supported. "
+                               "Interpolate Functions before output.");
+    }
+
+    if (!is_cellwise(*e) and *e != *element0)
+    {
+      throw std::runtime_error("All point-wise Functions written to VTKHDF "
+                               "file must have same element.");
+    }
+  }
+
+  // Check that the data arrays are the same as for previous time steps
+  std::vector<std::string> point_data, cell_data;
+  for (auto& v : u)
+  {
+    std::vector<std::string>& names
+        = is_cellwise(*v.get().function_space()->element()) ? cell_data
+                                                            : point_data;
+    std::ranges::copy(data_names(v.get()), std::back_inserter(names));
+  }
+  check_data_names(point_data, cell_data);
+
+  auto topology = mesh0->topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  const std::int32_t num_cells = topology->index_map(tdim)->size_local();
+  const std::int8_t vtk_type
+      = cells::get_vtk_cell_type(topology->cell_type(), tdim);
+
+  // Write points and cells, using the nodes of the first point-wise
+  // space or the mesh geometry. The grid of the previous time step is
+  // re-used if it was written for the same object.
+  std::shared_ptr<const void> grid;
+  if (is_cellwise(*element0))
+    grid = mesh0;
+  else
+    grid = V0;
+  if (!_reuse_mesh or _grid.lock() != grid)
+  {
+    if (is_cellwise(*element0))
+    {
+      if (mesh0->geometry().x_stride() != 3)
+      {
+        throw std::runtime_error("Cannot write a geometry with coordinate "
+                                 "stride other than three.");
+      }
+      const auto [cells, cshape] = io::extract_vtk_connectivity(
+          mesh0->geometry().dofmap(), topology->cell_type());
+      write_grid(mesh0->geometry().x(), cells,
+                 {std::size_t(num_cells), cshape[1]}, vtk_type);
+    }
+    else
+    {
+      const auto [x, xshape, x_id, x_ghost, cells, cshape]
+          = io::vtk_mesh_from_space(*V0);
+      write_grid(std::span<const U>(x), cells,
+                 {std::size_t(num_cells), cshape[1]}, vtk_type);
+    }
+    _grid = grid;
+  }
+
+  // Pack the real or imaginary part of the point-wise or cell-wise
+  // values of a function into a padded array and append it to the
+  // data of the file
+  using X = scalar_value_type_t<T>;
+  std::vector<std::int64_t> point_offsets, cell_offsets;
+  auto write_function = [&](const fem::Function<T, U>& v, auto part,
+                            const std::string& name)
+  {
+    auto V = v.function_space();
+    auto dofmap = V->dofmap();
+    assert(dofmap);
+    const int bs = dofmap->bs();
+    const int num_comp = num_components(*V->element());
+    const int num_cols = V->element()->value_shape().empty() ? 0 : num_comp;
+    std::span<const T> values = v.x()->array();
+
+    if (is_cellwise(*V->element()))
+    {
+      std::vector<X> data(num_cells * num_comp, 0);
+      for (std::int32_t c = 0; c < num_cells; ++c)
+      {
+        const std::int32_t dof = dofmap->cell_dofs(c).front();
+        for (int k = 0; k < bs; ++k)
+          data[c * num_comp + k] = part(values[dof * bs + k]);
+      }
+      cell_offsets.push_back(append(root + "/CellData/" + name, data.data(),
+                                    num_cells, num_cols));
+    }
+    else
+    {
+      // Map the dofs of V to the nodes of V0, cell-by-cell
+      auto dofmap0 = V0->dofmap();
+      const std::int32_t num_nodes = dofmap0->index_map->size_local()
+                                     + dofmap0->index_map->num_ghosts();
+      std::vector<X> data(num_nodes * num_comp, 0);
+      const std::int32_t num_cells_all = dofmap->map().extent(0);
+      for (std::int32_t c = 0; c < num_cells_all; ++c)
+      {
+        auto dofs0 = dofmap0->cell_dofs(c);
+        auto dofs = dofmap->cell_dofs(c);
+        for (std::size_t i = 0; i < dofs.size(); ++i)
+          for (int k = 0; k < bs; ++k)
+            data[dofs0[i] * num_comp + k] = part(values[dofs[i] * bs + k]);
+      }
+      point_offsets.push_back(append(root + "/PointData/" + name,
+                                     data.data(), num_nodes, num_cols));
+    }
+  };
+
+  for (auto& v : u)
+  {
+    std::vector<std::string> names = data_names(v.get());
+    write_function(v.get(), [](auto x) { return std::real(x); }, names[0]);
+    if constexpr (!std::is_scalar_v<T>)
+      write_function(v.get(), [](auto x) { return std::imag(x); }, names[1]);
+  }
+
+  write_step(t, point_offsets, cell_offsets);
+}
+//----------------------------------------------------------------------------
+template <std::floating_point U>
+void io::VTKHDFFile::write_grid(std::span<const U> x,
+                                std::span<const std::int64_t> cells,
+                                std::array<std::size_t, 2> cshape,
+                                std::int8_t cell_type)
+{
+  // Each process writes a partition with its own (local) point
+  // numbering
+  const std::int64_t num_points = x.size() / 3;
+  const std::int64_t num_cells = cshape[0];
+  const std::int64_t num_ids = cshape[0] * cshape[1];
+  const std::int64_t part
+      = append(root + "/NumberOfPoints", &num_points, 1, 0);
+  append(root + "/NumberOfCells", &num_cells, 1, 0);
+  append(root + "/NumberOfConnectivityIds", &num_ids, 1, 0);
+
+  const std::int64_t point_offset
+      = append(root + "/Points", x.data(), num_points, 3);
+
+  std::vector<std::uint8_t> types(num_cells, cell_type);
+  const std::int64_t cell_offset
+      = append(root + "/Types", types.data(), num_cells, 0);
+
+  std::vector<std::int64_t> offsets(num_cells + 1);
+  for (std::size_t c = 0; c < offsets.size(); ++c)
+    offsets[c] = c * cshape[1];
+  append(root + "/Offsets", offsets.data(), num_cells + 1, 0);
+  const std::int64_t id_offset
+      = append(root + "/Connectivity", cells.data(), num_ids, 0);
+
+  _grid_offsets = {part, point_offset, cell_offset, id_offset};
+}
+//----------------------------------------------------------------------------
+template <typename T>
+std::int64_t io::VTKHDFFile::append(const std::string& path, const T* data,
+                                    std::int64_t num_rows, int num_cols)
+{
+  MPI_Comm comm = _comm.comm();
+  std::int64_t offset = 0;
+  MPI_Exscan(&num_rows, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+  if (dolfinx::MPI::rank(comm) == 0)
+    offset = 0;
+  std::int64_t size = 0;
+  MPI_Allreduce(&num_rows, &size, 1, MPI_INT64_T, MPI_SUM, comm);
+
+  std::vector<std::int64_t> shape = {size};
+  if (num_cols > 0)
+    shape.push_back(num_cols);
+  return hdf5::append_dataset(_h5_id, path, data, {offset, offset + num_rows},
+                              shape, _mpi_io);
+}
+//----------------------------------------------------------------------------
+void io::VTKHDFFile::write_step(double t,
+                                const std::vector<std::int64_t>& point_offsets,
+                                const std::vector<std::int64_t>& cell_offsets)
+{
+  // Values for the time step are written by rank 0
+  const std::string steps = root + "/Steps/";
+  const std::int64_t n = dolfinx::MPI::rank(_comm.comm()) == 0 ? 1 : 0;
+  auto append_value = [&](const std::string& name, auto value)
+  { append(steps + name, &value, n, 0); };
+
+  append_value("Values", t);
+  append_value("PartOffsets", _grid_offsets[0]);
+  append_value("NumberOfParts",
+               std::int64_t(dolfinx::MPI::size(_comm.comm())));
+  append_value("PointOffsets", _grid_offsets[1]);
+  append_value("CellOffsets", _grid_offsets[2]);
+  append_value("ConnectivityIdOffsets", _grid_offsets[3]);
+  for (std::size_t i = 0; i < _point_data.size(); ++i)
+    append_value("PointDataOffsets/" + _point_data[i], point_offsets[i]);
+  for (std::size_t i = 0; i < _cell_data.size(); ++i)
+    append_value("CellDataOffsets/" + _cell_data[i], cell_offsets[i]);
+
+  ++_num_steps;
+  hdf5::set_attribute(_h5_id, root + "/Steps", "NSteps",
+                      std::vector<std::int64_t>{_num_steps});
+}
+//----------------------------------------------------------------------------
+void io::VTKHDFFile::check_data_names(
+    const std::vector<std::string>& point_data,
+    const std::vector<std::string>& cell_data)
+{
+  if (_num_steps == 0)
+  {
+    _point_data = point_data;
+    _cell_data = cell_data;
+  }
+  else if (point_data != _point_data or cell_data != _cell_data)
+  {
+    throw std::runtime_error("The data arrays written to a VTKHDF file must "
+                             "be the same at each time step.");
+  }
+}
+//----------------------------------------------------------------------------
+// Instantiation for different types
+/// @cond
+template void io::VTKHDFFile::write(const mesh::Mesh<float>&, double);
+template void io::VTKHDFFile::write(const mesh::Mesh<double>&, double);
+template void io::VTKHDFFile::write(
+    const std::vector<
+        std::reference_wrapper<const fem::Function<float, float>>>&,
+    double);
+template void io::VTKHDFFile::write(
+    const std::vector<
+        std::reference_wrapper<const fem::Function<double, double>>>&,
+    double);
+template void
+io::VTKHDFFile::write(const std::vector<std::reference_wrapper<
+                          const fem::Function<std::complex<float>, float>>>&,
+                      double);
+template void
+io::VTKHDFFile::write(const std::vector<std::reference_wrapper<
+                          const fem::Function<std::complex<double>, double>>>&,
+                      double);
+/// @endcond
+//----------------------------------------------------------------------------
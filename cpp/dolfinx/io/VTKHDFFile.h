@@ -0,0 +1,153 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <filesystem>
+#include <functional>
+#include <hdf5.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace dolfinx::fem
+{
+template <dolfinx::scalar T, std::floating_point U>
+class Function;
+}
+
+namespace dolfinx::mesh
+{
+template <std::floating_point T>
+class Mesh;
+}
+
+namespace dolfinx::io
+{
+
+/// @brief Output of meshes and functions in the VTKHDF format.
+///
+/// The VTKHDF format stores an unstructured grid and all of its time
+/// steps in a single HDF5 file, which is read natively by ParaView
+/// (>= 5.12). Each process writes its owned cells as a partition of
+/// the grid, and all data is written with collective HDF5 calls. This
+/// avoids the large number of small files created by VTKFile for long
+/// runs on many processes.
+///
+/// The points and cells of a time step are written only if they change
+/// (see VTKHDFFile::write), and otherwise are shared with the previous
+/// time step.
+///
+/// Isoparametric meshes of arbitrary degree are supported. For finite
+/// element functions, cell-based (DG0) and Lagrange (point-based)
+/// functions can be saved.
+///
+/// @warning This format is not suitable for checkpointing.
+class VTKHDFFile
+{
+public:
+  /// @brief Create a VTKHDF file.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the file (usually with extension
+  /// `.vtkhdf`). An existing file is overwritten.
+  /// @param[in] reuse_mesh If true, the points and cells are shared by
+  /// consecutive time steps with functions from the same space. If
+  /// false, they are written at every time step, e.g. for a moving
+  /// mesh.
+  VTKHDFFile(MPI_Comm comm, const std::filesystem::path& filename,
+             bool reuse_mesh = true);
+
+  /// Destructor
+  ~VTKHDFFile();
+
+  /// Close file
+  void close();
+
+  /// Flushes data to disk
+  void flush();
+
+  /// @brief Write a mesh as a new time step. Supports arbitrary order
+  /// Lagrange isoparametric cells.
+  /// @param[in] mesh Mesh to write to file.
+  /// @param[in] time Time parameter to associate with `mesh`.
+  template <std::floating_point U>
+  void write(const mesh::Mesh<U>& mesh, double time = 0.0);
+
+  /// @brief Write finite element functions as a new time step.
+  ///
+  /// @pre Functions in `u` cannot be sub-Functions. Extract
+  /// sub-Functions before output.
+  ///
+  /// @pre All Functions in `u` with point-wise data must use the same
+  /// element type (up to the block size) and the element must be
+  /// (discontinuous) Lagrange. Interpolate fem::Function before output
+  /// if required.
+  ///
+  /// @pre The names of the Functions must be the same at every time
+  /// step.
+  ///
+  /// @param[in] u List of functions to write to file.
+  /// @param[in] t Time parameter to associate with `u`.
+  /// @pre All Functions in `u` must share the same mesh.
+  template <dolfinx::scalar T, std::floating_point U = scalar_value_type_t<T>>
+  void
+  write(const std::vector<std::reference_wrapper<const fem::Function<T, U>>>& u,
+        double t);
+
+private:
+  // Write points and cells of the partition on this process, and keep
+  // the offsets of the grid
+  template <std::floating_point U>
+  void write_grid(std::span<const U> x, std::span<const std::int64_t> cells,
+                  std::array<std::size_t, 2> cshape, std::int8_t cell_type);
+
+  // Append the rows of this process to a dataset, and return the
+  // number of rows in the dataset before they were appended
+  template <typename T>
+  std::int64_t append(const std::string& path, const T* data,
+                      std::int64_t num_rows, int num_cols);
+
+  // Write the entries of the 'Steps' group for a new time step, with
+  // the offsets of the data arrays of the step
+  void write_step(double t, const std::vector<std::int64_t>& point_offsets,
+                  const std::vector<std::int64_t>& cell_offsets);
+
+  // Set the names of data arrays of the file at the first time step,
+  // and check them at later time steps
+  void check_data_names(const std::vector<std::string>& point_data,
+                        const std::vector<std::string>& cell_data);
+
+  // MPI communicator
+  dolfinx::MPI::Comm _comm;
+
+  // HDF5 file handle
+  hid_t _h5_id;
+
+  // True if MPI-IO is used
+  bool _mpi_io;
+
+  // Share points and cells between time steps
+  bool _reuse_mesh;
+
+  // Number of time steps
+  std::int64_t _num_steps;
+
+  // Offsets (part, point, cell, connectivity) of the last written grid
+  std::array<std::int64_t, 4> _grid_offsets;
+
+  // Object (function space or mesh) of the last written grid
+  std::weak_ptr<const void> _grid;
+
+  // Names of the point and cell data arrays of each time step
+  std::vector<std::string> _point_data, _cell_data;
+};
+} // namespace dolfinx::io
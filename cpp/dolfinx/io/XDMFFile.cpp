@@ -9,13 +9,18 @@
 #include "xdmf_function.h"
 #include "xdmf_mesh.h"
 #include "xdmf_utils.h"
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/utils.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/partitioners.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/graphbuild.h>
 #include <dolfinx/mesh/utils.h>
 #include <filesystem>
 #include <pugixml.hpp>
@@ -23,9 +28,54 @@
 using namespace dolfinx;
 using namespace dolfinx::io;
 
+namespace
+{
+/// @brief Compute a hash of the mesh data that is written to file,
+/// i.e. the owned geometry nodes and the geometry dofmap.
+/// @note Collective
+template <std::floating_point U>
+std::size_t mesh_hash(const mesh::Mesh<U>& mesh)
+{
+  const mesh::Geometry<U>& geometry = mesh.geometry();
+  auto map = geometry.index_map();
+  assert(map);
+  std::span<const U> x
+      = geometry.x().first(geometry.x_stride() * map->size_local());
+  auto dofmap = geometry.dofmap();
+  std::span<const std::int32_t> dofs(dofmap.data_handle(), dofmap.size());
+
+  std::size_t hash = boost::hash_range(x.begin(), x.end());
+  boost::hash_combine(hash, boost::hash_range(dofs.begin(), dofs.end()));
+  return common::hash_global(mesh.comm(), hash);
+}
+
+/// @brief Create a cell partitioner that keeps each cell on the calling
+/// process, and adds ghost destinations if requested.
+mesh::CellPartitionFunction keep_cells_partitioner(mesh::GhostMode mode)
+{
+  return [mode](MPI_Comm comm, int, const std::vector<mesh::CellType>& types,
+                const std::vector<std::span<const std::int64_t>>& cells)
+  {
+    const int num_vertices = mesh::num_cell_vertices(types.front());
+    std::vector<std::int32_t> part(cells.front().size() / num_vertices,
+                                   dolfinx::MPI::rank(comm));
+    if (mode == mesh::GhostMode::none)
+      return graph::regular_adjacency_list(std::move(part), 1);
+    else
+    {
+      const graph::AdjacencyList dual_graph
+          = mesh::build_dual_graph(comm, types, cells);
+      return graph::extend_destination_ranks(comm, dual_graph, part);
+    }
+  };
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
-XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
-                   std::string file_mode, Encoding encoding)
+XDMFFile::XDMFFile(
+    MPI_Comm comm, const std::filesystem::path& filename,
+    std::string file_mode, Encoding encoding,
+    const std::vector<std::pair<std::string, std::string>>& mpi_io_hints)
     : _comm(comm), _filename(filename), _file_mode(file_mode),
       _xml_doc(new pugi::xml_document), _encoding(encoding)
 {
@@ -42,8 +92,8 @@ XDMFFile::XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
     const std::filesystem::path hdf5_filename
         = xdmf_utils::get_hdf5_filename(_filename);
     const bool mpi_io = dolfinx::MPI::size(_comm.comm()) > 1 ? true : false;
-    _h5_id
-        = io::hdf5::open_file(_comm.comm(), hdf5_filename, file_mode, mpi_io);
+    _h5_id = io::hdf5::open_file(_comm.comm(), hdf5_filename, file_mode,
+                                 mpi_io, mpi_io_hints);
     assert(_h5_id > 0);
     spdlog::info("Opened HDF5 file with id \"{}\"", _h5_id);
   }
@@ -138,23 +188,66 @@ void XDMFFile::close()
   _h5_id = -1;
 }
 //-----------------------------------------------------------------------------
+void XDMFFile::flush()
+{
+  if (_h5_id > 0)
+    io::hdf5::flush_file(_h5_id);
+}
+//-----------------------------------------------------------------------------
+bool XDMFFile::set_async(bool async)
+{
+  if (_h5_id <= 0)
+    return false;
+
+  // Use asynchronous operations only if they are available on all
+  // processes, since the collective writes must match
+  int enabled = io::hdf5::set_async(_h5_id, async);
+  MPI_Allreduce(MPI_IN_PLACE, &enabled, 1, MPI_INT, MPI_LAND, _comm.comm());
+  if (!enabled)
+    io::hdf5::set_async(_h5_id, false);
+  return enabled;
+}
+//-----------------------------------------------------------------------------
 template <std::floating_point U>
-void XDMFFile::write_mesh(const mesh::Mesh<U>& mesh, std::string xpath)
+void XDMFFile::write_mesh(const mesh::Mesh<U>& mesh, std::string xpath,
+                          const io::hdf5::DatasetOptions& options)
 {
   pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
   if (!node)
     throw std::runtime_error("XML node '" + xpath + "' not found.");
 
+  // A mesh that has already been written to the same location is not
+  // written again, e.g. when the mesh is written with the functions at
+  // each time step. Functions reference the existing Grid.
+  const std::size_t hash = mesh_hash(mesh);
+  const std::string key = xpath + "/" + mesh.name;
+  if (auto it = _mesh_hashes.find(key); it != _mesh_hashes.end())
+  {
+    if (it->second != hash)
+    {
+      throw std::runtime_error("Mesh '" + mesh.name
+                               + "' has changed since it was written to '"
+                               + xpath + "'. Use a different mesh name.");
+    }
+
+    spdlog::info("Mesh \"{}\" is unchanged and has already been written.",
+                 mesh.name);
+    return;
+  }
+
   // Add the mesh Grid to the domain
-  xdmf_mesh::add_mesh(_comm.comm(), node, _h5_id, mesh, mesh.name);
+  xdmf_mesh::add_mesh(_comm.comm(), node, _h5_id, mesh, mesh.name, options);
+  _mesh_hashes.insert({key, hash});
 
   // Save XML file (on process 0 only)
   if (MPI::rank(_comm.comm()) == 0)
     _xml_doc->save_file(_filename.c_str(), "  ");
 }
 /// @cond
-template void XDMFFile::write_mesh(const mesh::Mesh<double>&, std::string);
-template void XDMFFile::write_mesh(const mesh::Mesh<float>&, std::string);
+template void XDMFFile::write_mesh(const mesh::Mesh<double>&, std::string,
+                                   const io::hdf5::DatasetOptions&);
+template void XDMFFile::write_mesh(const mesh::Mesh<float>&, std::string,
+                                   const io::hdf5::DatasetOptions&);
 /// @endcond
 //-----------------------------------------------------------------------------
 void XDMFFile::write_geometry(const mesh::Geometry<double>& geometry,
@@ -181,9 +274,93 @@ void XDMFFile::write_geometry(const mesh::Geometry<double>& geometry,
 //-----------------------------------------------------------------------------
 mesh::Mesh<double>
 XDMFFile::read_mesh(const fem::CoordinateElement<double>& element,
-                    mesh::GhostMode mode, std::string name,
-                    std::string xpath) const
+                    mesh::GhostMode mode, std::string name, std::string xpath,
+                    std::int64_t chunk_size) const
 {
+  if (_encoding == Encoding::HDF5)
+  {
+    pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
+    if (!node)
+      throw std::runtime_error("XML node '" + xpath + "' not found.");
+    pugi::xml_node grid_node
+        = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
+    if (!grid_node)
+      throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+
+    // If the mesh was written on the same number of processes, read the
+    // cells and nodes that each process owned and skip repartitioning
+    if (auto ranges
+        = xdmf_mesh::read_partition(_comm.comm(), _h5_id, grid_node))
+    {
+      spdlog::info("Read mesh \"{}\" with stored partition", name);
+      auto [cells, cshape, x, xshape] = xdmf_mesh::read_mesh_data(
+          _comm.comm(), _h5_id, grid_node, *ranges);
+      const std::vector<double>& _x = std::get<std::vector<double>>(x);
+      mesh::Mesh<double> mesh = mesh::create_mesh(
+          _comm.comm(), _comm.comm(), cells, element, _comm.comm(), _x,
+          xshape,
+          mode == mesh::GhostMode::none ? nullptr
+                                        : keep_cells_partitioner(mode));
+      mesh.name = name;
+      return mesh;
+    }
+
+    // Otherwise, compute the partition from the stored partition
+    if (chunk_size <= 0)
+    {
+      if (auto owners
+          = xdmf_mesh::read_cell_owners(_comm.comm(), _h5_id, grid_node))
+      {
+        auto& [range, dest, num_parts] = *owners;
+        spdlog::info("Read mesh \"{}\" with stored partition of {} "
+                     "processes",
+                     name, num_parts);
+        auto [cells, cshape, x, xshape] = xdmf_mesh::read_mesh_data(
+            _comm.comm(), _h5_id, grid_node, {range, {0, 0}});
+        const std::vector<double>& _x = std::get<std::vector<double>>(x);
+        mesh::Mesh<double> mesh = mesh::create_mesh(
+            _comm.comm(), _comm.comm(), cells, element, _comm.comm(), _x,
+            xshape,
+            mesh::create_stored_cell_partitioner(mode, std::move(dest),
+                                                 num_parts));
+        mesh.name = name;
+        return mesh;
+      }
+    }
+  }
+
+  // Read and distribute the cells in chunks, and then create the mesh
+  // from the distributed cells without repartitioning
+  if (chunk_size > 0 and _encoding == Encoding::HDF5)
+  {
+    pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
+    if (!node)
+      throw std::runtime_error("XML node '" + xpath + "' not found.");
+    pugi::xml_node grid_node
+        = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
+    if (!grid_node)
+      throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+
+    spdlog::info("Read mesh \"{}\" in chunks of {} cells", name, chunk_size);
+    auto [x, xshape]
+        = xdmf_mesh::read_geometry_data(_comm.comm(), _h5_id, grid_node);
+    const std::vector<double>& _x = std::get<std::vector<double>>(x);
+    auto [cells, cshape, file_idx] = xdmf_mesh::read_topology_data_chunked(
+        _comm.comm(), _h5_id, grid_node, _x, xshape[1], chunk_size);
+    mesh::Mesh<double> mesh = mesh::create_mesh(
+        _comm.comm(), _comm.comm(), cells, element, _comm.comm(), _x, xshape,
+        keep_cells_partitioner(mode));
+
+    // Replace the original cell indices, which refer to the positions of
+    // the distributed cells, by the cell indices in the file
+    std::vector<std::int64_t>& idx
+        = mesh.topology_mutable()->original_cell_index.front();
+    idx = dolfinx::MPI::distribute_data(_comm.comm(), idx, _comm.comm(),
+                                        file_idx, 1);
+    mesh.name = name;
+    return mesh;
+  }
+
   // Read mesh data
   auto [cells, cshape] = XDMFFile::read_topology_data(name, xpath);
   auto [x, xshape] = XDMFFile::read_geometry_data(name, xpath);
@@ -231,7 +408,8 @@ XDMFFile::read_geometry_data(std::string name, std::string xpath) const
 //-----------------------------------------------------------------------------
 template <dolfinx::scalar T, std::floating_point U>
 void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
-                              std::string mesh_xpath)
+                              std::string mesh_xpath,
+                              const io::hdf5::DatasetOptions& options)
 {
   assert(_xml_doc);
 
@@ -276,7 +454,7 @@ void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
   assert(time_node);
 
   // Add the mesh Grid to the domain
-  xdmf_function::add_function(_comm.comm(), u, t, grid_node, _h5_id);
+  xdmf_function::add_function(_comm.comm(), u, t, grid_node, _h5_id, options);
 
   // Save XML file (on process 0 only)
   if (dolfinx::MPI::rank(_comm.comm()) == 0)
@@ -286,15 +464,19 @@ void XDMFFile::write_function(const fem::Function<T, U>& u, double t,
 // Instantiation for different types
 /// @cond
 template void XDMFFile::write_function(const fem::Function<float, float>&,
-                                       double, std::string);
+                                       double, std::string,
+                                       const io::hdf5::DatasetOptions&);
 template void XDMFFile::write_function(const fem::Function<double, double>&,
-                                       double, std::string);
+                                       double, std::string,
+                                       const io::hdf5::DatasetOptions&);
 template void
 XDMFFile::write_function(const fem::Function<std::complex<float>, float>&,
-                         double, std::string);
+                         double, std::string,
+                         const io::hdf5::DatasetOptions&);
 template void
 XDMFFile::write_function(const fem::Function<std::complex<double>, double>&,
-                         double, std::string);
+                         double, std::string,
+                         const io::hdf5::DatasetOptions&);
 /// @endcond
 //-----------------------------------------------------------------------------
 template <std::floating_point T>
@@ -347,8 +529,6 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
   if (!grid_node)
     throw std::runtime_error("<Grid> with name '" + name + "' not found.");
 
-  const auto [entities, eshape] = read_topology_data(name, xpath);
-
   pugi::xml_node values_data_node
       = grid_node.child("Attribute").child("DataItem");
   if (attribute_name)
@@ -365,12 +545,24 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
     else
       values_data_node = attribute_node.child("DataItem");
   }
-  const std::vector values = xdmf_utils::get_dataset<std::int32_t>(
-      _comm.comm(), values_data_node, _h5_id);
 
   const std::pair<std::string, int> cell_type_str
       = xdmf_utils::get_cell_type(grid_node.child("Topology"));
   mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
+  const int dim = mesh::cell_dim(cell_type);
+
+  // If the cell and local entity index of each entity are stored (see
+  // xdmf_mesh::add_meshtags), distribute the tags by cell
+  if (auto tags = xdmf_mesh::read_meshtags_by_cell(
+          _comm.comm(), _h5_id, values_data_node, mesh, dim))
+  {
+    tags->name = name;
+    return *tags;
+  }
+
+  const auto [entities, eshape] = read_topology_data(name, xpath);
+  const std::vector values = xdmf_utils::get_dataset<std::int32_t>(
+      _comm.comm(), values_data_node, _h5_id);
 
   // Permute entities from VTK to DOLFINx ordering
   std::vector<std::int64_t> entities1 = io::cells::apply_permutation(
@@ -385,18 +577,16 @@ XDMFFile::read_meshtags(const mesh::Mesh<double>& mesh, std::string name,
           *mesh.topology(), mesh.geometry().input_global_indices(),
           mesh.geometry().index_map()->size_global(),
           mesh.geometry().cmap().create_dof_layout(), mesh.geometry().dofmap(),
-          mesh::cell_dim(cell_type), entities_span, values);
+          dim, entities_span, values);
 
   spdlog::info("XDMF create meshtags");
   std::size_t num_vertices_per_entity = mesh::cell_num_entities(
-      mesh::cell_entity_type(mesh.topology()->cell_type(),
-                             mesh::cell_dim(cell_type), 0),
-      0);
+      mesh::cell_entity_type(mesh.topology()->cell_type(), dim, 0), 0);
   const graph::AdjacencyList<std::int32_t> entities_adj
       = graph::regular_adjacency_list(std::move(entities_values.first),
                                       num_vertices_per_entity);
   mesh::MeshTags meshtags = mesh::create_meshtags(
-      mesh.topology(), mesh::cell_dim(cell_type), entities_adj,
+      mesh.topology(), dim, entities_adj,
       std::span<const std::int32_t>(entities_values.second));
   meshtags.name = name;
 
@@ -8,9 +8,11 @@
 
 #include "HDF5Interface.h"
 #include <concepts>
+#include <cstdint>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -65,9 +67,19 @@ public:
     ASCII
   };
 
-  /// Constructor
+  /// @brief Constructor.
+  /// @param[in] comm MPI communicator.
+  /// @param[in] filename Name of the XDMF file.
+  /// @param[in] file_mode File mode (r, w, a).
+  /// @param[in] encoding File encoding.
+  /// @param[in] mpi_io_hints (key, value) MPI-IO hints for the HDF5
+  /// file, e.g. collective buffering settings. Used only for parallel
+  /// HDF5 encoded files.
   XDMFFile(MPI_Comm comm, const std::filesystem::path& filename,
-           std::string file_mode, Encoding encoding = Encoding::HDF5);
+           std::string file_mode, Encoding encoding = Encoding::HDF5,
+           const std::vector<std::pair<std::string, std::string>>&
+               mpi_io_hints
+           = {});
 
   /// Move constructor
   XDMFFile(XDMFFile&&) = default;
@@ -77,17 +89,52 @@ public:
 
   /// Close the file
   ///
-  /// This closes open underlying HDF5 file. In ASCII mode the XML file
-  /// is closed each time it is written to or read from, so close() has
-  /// no effect.
+  /// This closes open underlying HDF5 file, after waiting for
+  /// outstanding asynchronous writes. In ASCII mode the XML file is
+  /// closed each time it is written to or read from, so close() has no
+  /// effect.
   void close();
 
-  /// Save Mesh
+  /// @brief Flush the HDF5 file, after waiting for outstanding
+  /// asynchronous writes.
+  ///
+  /// @note Collective
+  void flush();
+
+  /// @brief Enable or disable asynchronous HDF5 operations.
+  ///
+  /// When enabled, the HDF5 datasets of mesh, function and mesh tag
+  /// writes are copied to buffers and the writes are queued, so that
+  /// the write functions return before the data is written. The data
+  /// is written by the time flush() or close() return. The topology and
+  /// geometry datasets of a mesh (and the entities and values of mesh
+  /// tags) are read together. See io::hdf5::set_async for the
+  /// requirements.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] async True to enable asynchronous operations.
+  /// @return True if asynchronous operations are enabled, which
+  /// requires the HDF5 async VOL connector.
+  bool set_async(bool async);
+
+  /// @brief Save Mesh.
+  ///
+  /// If the same (unchanged) mesh has already been written to `xpath`
+  /// by this object, e.g. when the mesh is written at each step of a
+  /// time series, the mesh data is not written again. An exception is
+  /// raised if a mesh with the same name has changed.
+  ///
+  /// @note Collective
+  ///
   /// @param[in] mesh
   /// @param[in] xpath XPath where Mesh Grid will be written
+  /// @param[in] options HDF5 chunking and compression options for the
+  /// topology and geometry datasets
   template <std::floating_point U>
   void write_mesh(const mesh::Mesh<U>& mesh,
-                  std::string xpath = "/Xdmf/Domain");
+                  std::string xpath = "/Xdmf/Domain",
+                  const io::hdf5::DatasetOptions& options = {});
 
   /// Save Geometry
   /// @param[in] geometry
@@ -97,16 +144,38 @@ public:
                       std::string xpath = "/Xdmf/Domain");
 
   /// Read Mesh
+  ///
+  /// If the mesh was written on the same number of processes, each
+  /// process reads the cells and geometry nodes that it owned when the
+  /// mesh was written and the cells are not repartitioned. If it was
+  /// written on a different number of processes, the partition is
+  /// computed from the stored partition (see
+  /// mesh::create_stored_cell_partitioner), which avoids a graph
+  /// partition if the mesh is read on fewer processes.
+  ///
+  /// If `chunk_size` is positive and the data is stored in HDF5, the
+  /// cells are read in chunks of `chunk_size` cells and each chunk is
+  /// sent to its destination process as it is read. The destinations
+  /// are computed by a space-filling curve partition of the cell
+  /// midpoints (see xdmf_mesh::read_topology_data_chunked), and the
+  /// mesh is created from the received cells without a graph
+  /// partition. This bounds the memory use when reading very large
+  /// meshes, at the cost of a partition with more shared facets.
+  ///
   /// @param[in] element Element that describes the geometry of a cell
   /// @param[in] mode The type of ghosting/halo to use for the mesh when
   /// distributed in parallel
   /// @param[in] name
   /// @param[in] xpath XPath where Mesh Grid is located
+  /// @param[in] chunk_size Number of cells to read at a time on each
+  /// process. If zero, all cells of a process are read at once and
+  /// partitioned with the default graph partitioner.
   /// @return A Mesh distributed on the same communicator as the
   ///   XDMFFile
   mesh::Mesh<double> read_mesh(const fem::CoordinateElement<double>& element,
                                mesh::GhostMode mode, std::string name,
-                               std::string xpath = "/Xdmf/Domain") const;
+                               std::string xpath = "/Xdmf/Domain",
+                               std::int64_t chunk_size = 0) const;
 
   /// Read Topology data for Mesh
   /// @param[in] name Name of the mesh (Grid)
@@ -147,10 +216,13 @@ public:
   /// @param[in] t Time stamp to associate with `u`.
   /// @param[in] mesh_xpath XPath for a Grid under which `u` will be
   /// inserted.
+  /// @param[in] options HDF5 chunking and compression options for the
+  /// function value datasets.
   template <dolfinx::scalar T, std::floating_point U = scalar_value_type_t<T>>
   void write_function(const fem::Function<T, U>& u, double t,
                       std::string mesh_xpath
-                      = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]");
+                      = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]",
+                      const io::hdf5::DatasetOptions& options = {});
 
   /// Write MeshTags
   /// @param[in] meshtags
@@ -164,6 +236,15 @@ public:
                       std::string xpath = "/Xdmf/Domain");
 
   /// Read MeshTags
+  ///
+  /// Tags that were written by XDMFFile::write_meshtags to a file with
+  /// HDF5 encoding are distributed using the cell and the local index
+  /// in the cell of each entity, which avoids communicating and
+  /// matching entity vertices. This requires that `mesh` was read from
+  /// the mesh that is written to the same file, and that the
+  /// cell-to-entity connectivity has been created. Otherwise, tagged
+  /// entities are identified by their vertices.
+  ///
   /// @param[in] mesh Mesh that the input data is defined on
   /// @param[in] name Name of the grid node in the xml-scheme of the
   /// XDMF-file. E.g. "Material" in Grid Name="Material"
@@ -210,6 +291,9 @@ private:
   std::unique_ptr<pugi::xml_document> _xml_doc;
 
   Encoding _encoding;
+
+  // Hash of the meshes written to file, keyed by "xpath/name"
+  std::map<std::string, std::size_t> _mesh_hashes;
 };
 
 } // namespace dolfinx::io
@@ -0,0 +1,390 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "HDF5Interface.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <complex>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/types.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <filesystem>
+#include <hdf5.h>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// @file checkpointing.h
+/// @brief Checkpoint/restart of finite element Functions.
+///
+/// A Function is stored in a HDF5 file as its degree-of-freedom values
+/// on each cell, ordered by the original (input) index of the cell,
+/// together with the cell permutation data needed for elements that
+/// require dof transformations. No interpolation is performed, so
+/// a Function is restored exactly. The data can be read on any number
+/// of processes, for a mesh that has been created from the same input
+/// mesh as the mesh that the Function was written on.
+
+namespace dolfinx::io::checkpointing
+{
+namespace impl
+{
+/// @brief Number of (real-valued) entries stored per cell for a
+/// function space.
+template <std::floating_point U>
+std::size_t row_width(const fem::FunctionSpace<U>& V, bool is_complex)
+{
+  auto dofmap = V.dofmap();
+  assert(dofmap);
+  const std::size_t num_cell_dofs
+      = dofmap->bs() * dofmap->element_dof_layout().num_dofs();
+  return is_complex ? 2 * num_cell_dofs : num_cell_dofs;
+}
+
+/// @brief Original (input) index of each owned cell of a mesh.
+template <std::floating_point U>
+std::span<const std::int64_t> original_cell_index(const mesh::Mesh<U>& mesh)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  if (topology->original_cell_index.size() != 1)
+  {
+    throw std::runtime_error(
+        "Checkpointing is supported for single cell type meshes only.");
+  }
+
+  const std::int32_t num_cells
+      = topology->index_map(topology->dim())->size_local();
+  const std::vector<std::int64_t>& idx = topology->original_cell_index.front();
+  if (idx.size() < static_cast<std::size_t>(num_cells))
+    throw std::runtime_error("Mesh does not have original cell indices.");
+  return std::span(idx.data(), num_cells);
+}
+
+/// @brief Group in a HDF5 file for a named checkpoint.
+inline std::string group(const std::string& name)
+{
+  return "/Checkpoint/" + name;
+}
+} // namespace impl
+
+/// @brief Write a Function to a HDF5 checkpoint file.
+///
+/// The degree-of-freedom values of each owned cell are sent to the
+/// process that writes the block of rows containing the original index
+/// of the cell, so that the row index in the file is the original cell
+/// index and the file layout is independent of the number of
+/// processes. Values are stored as they are on the cell, i.e. without
+/// dof transformations applied. For elements that need dof
+/// transformations, the cell permutation data is written alongside.
+/// Complex values are stored as interleaved real and imaginary parts.
+///
+/// @note Collective on the mesh communicator.
+///
+/// @param[in] filename Name of the HDF5 file.
+/// @param[in] u Function to write.
+/// @param[in] name Name of the checkpoint in the file.
+/// @param[in] mode File mode. Use `"w"` to create a new file and `"a"`
+/// to add to an existing file.
+template <dolfinx::scalar T, std::floating_point U>
+void write_function(const std::filesystem::path& filename,
+                    const fem::Function<T, U>& u, const std::string& name,
+                    const std::string& mode = "w")
+{
+  using S = dolfinx::scalar_value_type_t<T>;
+  constexpr bool is_complex = !std::is_same_v<S, T>;
+
+  auto V = u.function_space();
+  assert(V);
+  auto mesh = V->mesh();
+  assert(mesh);
+  auto element = V->element();
+  assert(element);
+  auto dofmap = V->dofmap();
+  assert(dofmap);
+
+  std::span<const std::uint32_t> cell_info;
+  const bool needs_transformations = element->needs_dof_transformations();
+  if (needs_transformations)
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+  }
+
+  MPI_Comm comm = mesh->comm();
+  const int size = dolfinx::MPI::size(comm);
+  const int tdim = mesh->topology()->dim();
+  const std::int64_t num_cells_global
+      = mesh->topology()->index_map(tdim)->size_global();
+  std::span<const std::int64_t> cell_idx = impl::original_cell_index(*mesh);
+  const int bs = dofmap->bs();
+  const std::size_t width = impl::row_width(*V, is_complex);
+
+  // Sort (destination rank, cell) pairs by destination rank, where the
+  // destination writes the row for the original cell index
+  std::vector<std::array<std::int32_t, 2>> dest_to_cell(cell_idx.size());
+  for (std::size_t c = 0; c < cell_idx.size(); ++c)
+  {
+    dest_to_cell[c]
+        = {dolfinx::MPI::index_owner(size, cell_idx[c], num_cells_global),
+           static_cast<std::int32_t>(c)};
+  }
+  std::ranges::sort(dest_to_cell);
+
+  // Pack original index, permutation data and dof values of each cell
+  std::span<const T> x = u.x()->array();
+  std::vector<int> ranks;
+  std::vector<std::int32_t> send_sizes;
+  std::vector<std::int64_t> send_idx;
+  std::vector<std::uint32_t> send_info;
+  std::vector<S> send_data;
+  send_idx.reserve(dest_to_cell.size());
+  send_info.reserve(dest_to_cell.size());
+  send_data.reserve(dest_to_cell.size() * width);
+  for (auto [r, c] : dest_to_cell)
+  {
+    if (ranks.empty() or ranks.back() != r)
+    {
+      ranks.push_back(r);
+      send_sizes.push_back(0);
+    }
+    ++send_sizes.back();
+    send_idx.push_back(cell_idx[c]);
+    send_info.push_back(needs_transformations ? cell_info[c] : 0);
+    for (std::int32_t dof : dofmap->cell_dofs(c))
+    {
+      for (int k = 0; k < bs; ++k)
+      {
+        if constexpr (is_complex)
+        {
+          send_data.push_back(x[bs * dof + k].real());
+          send_data.push_back(x[bs * dof + k].imag());
+        }
+        else
+          send_data.push_back(x[bs * dof + k]);
+      }
+    }
+  }
+
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+
+  std::vector<std::int32_t> recv_sizes(src.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T, recv_sizes.data(),
+                        1, MPI_INT32_T, neigh_comm);
+  std::vector<std::int32_t> send_disp(send_sizes.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int32_t> recv_disp(recv_sizes.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+
+  std::vector<std::int64_t> recv_idx(recv_disp.back());
+  MPI_Neighbor_alltoallv(send_idx.data(), send_sizes.data(), send_disp.data(),
+                         MPI_INT64_T, recv_idx.data(), recv_sizes.data(),
+                         recv_disp.data(), MPI_INT64_T, neigh_comm);
+  std::vector<std::uint32_t> recv_info(recv_disp.back());
+  MPI_Neighbor_alltoallv(send_info.data(), send_sizes.data(), send_disp.data(),
+                         MPI_UINT32_T, recv_info.data(), recv_sizes.data(),
+                         recv_disp.data(), MPI_UINT32_T, neigh_comm);
+
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(width, dolfinx::MPI::mpi_t<S>, &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<S> recv_data(recv_disp.back() * width);
+  MPI_Neighbor_alltoallv(send_data.data(), send_sizes.data(), send_disp.data(),
+                         compound_type, recv_data.data(), recv_sizes.data(),
+                         recv_disp.data(), compound_type, neigh_comm);
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm);
+
+  // Order received rows by original cell index. Each index in the
+  // range of this rank is received exactly once.
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), num_cells_global, size);
+  if (recv_idx.size() != static_cast<std::size_t>(range[1] - range[0]))
+    throw std::runtime_error("Inconsistent original cell indices.");
+  std::vector<S> values(recv_data.size());
+  std::vector<std::uint32_t> perms(recv_info.size());
+  for (std::size_t i = 0; i < recv_idx.size(); ++i)
+  {
+    const std::int64_t pos = recv_idx[i] - range[0];
+    assert(pos >= 0 and pos < range[1] - range[0]);
+    std::copy_n(std::next(recv_data.begin(), i * width), width,
+                std::next(values.begin(), pos * width));
+    perms[pos] = recv_info[i];
+  }
+
+  const bool use_mpi_io = size > 1;
+  hid_t h5_id = hdf5::open_file(comm, filename, mode, use_mpi_io);
+  const std::string group = impl::group(name);
+  hdf5::write_dataset(h5_id, group + "/values", values.data(), range,
+                      {num_cells_global, static_cast<std::int64_t>(width)},
+                      use_mpi_io);
+  if (needs_transformations)
+  {
+    hdf5::write_dataset(h5_id, group + "/cell_permutations", perms.data(),
+                        range, {num_cells_global}, use_mpi_io);
+  }
+  hdf5::close_file(h5_id);
+}
+
+/// @brief Read a Function from a HDF5 checkpoint file written by
+/// write_function.
+///
+/// Each process reads a contiguous block of rows of the file, and the
+/// rows for the owned cells of the mesh of `u` are then fetched by
+/// their original cell index in a single redistribution. If the cell
+/// permutation data of a cell differs from the data at the time of
+/// writing, the dof transformations of the element are used to map the
+/// values to the new cell orientation. Ghost values are updated.
+///
+/// @note Collective on the mesh communicator.
+///
+/// @param[in] filename Name of the HDF5 file.
+/// @param[in,out] u Function to read values into.
+/// @param[in] name Name of the checkpoint in the file.
+/// @pre The mesh of `u` must have been created from the same input
+/// mesh as the mesh that the checkpoint was written on, and `u` must
+/// use the same element.
+template <dolfinx::scalar T, std::floating_point U>
+void read_function(const std::filesystem::path& filename,
+                   fem::Function<T, U>& u, const std::string& name)
+{
+  using S = dolfinx::scalar_value_type_t<T>;
+  constexpr bool is_complex = !std::is_same_v<S, T>;
+
+  auto V = u.function_space();
+  assert(V);
+  auto mesh = V->mesh();
+  assert(mesh);
+  auto element = V->element();
+  assert(element);
+  auto dofmap = V->dofmap();
+  assert(dofmap);
+
+  std::span<const std::uint32_t> cell_info;
+  const bool needs_transformations = element->needs_dof_transformations();
+  if (needs_transformations)
+  {
+    mesh->topology_mutable()->create_entity_permutations();
+    cell_info = std::span(mesh->topology()->get_cell_permutation_info());
+  }
+
+  MPI_Comm comm = mesh->comm();
+  const int size = dolfinx::MPI::size(comm);
+  const int tdim = mesh->topology()->dim();
+  const std::int64_t num_cells_global
+      = mesh->topology()->index_map(tdim)->size_global();
+  std::span<const std::int64_t> cell_idx = impl::original_cell_index(*mesh);
+  const int bs = dofmap->bs();
+  const std::size_t width = impl::row_width(*V, is_complex);
+
+  // Read a contiguous block of rows on each rank
+  const bool use_mpi_io = size > 1;
+  hid_t h5_id = hdf5::open_file(comm, filename, "r", use_mpi_io);
+  const std::string group = impl::group(name);
+  if (!hdf5::has_dataset(h5_id, group + "/values"))
+  {
+    hdf5::close_file(h5_id);
+    throw std::runtime_error("Checkpoint \"" + name + "\" not found in file.");
+  }
+
+  const std::vector<std::int64_t> shape
+      = hdf5::get_dataset_shape(h5_id, group + "/values");
+  if (shape.size() != 2 or shape[0] != num_cells_global
+      or shape[1] != static_cast<std::int64_t>(width))
+  {
+    hdf5::close_file(h5_id);
+    throw std::runtime_error(
+        "Checkpoint data does not match the mesh or function space.");
+  }
+
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), num_cells_global, size);
+  hid_t dset_id = hdf5::open_dataset(h5_id, group + "/values");
+  std::vector<S> values = hdf5::read_dataset<S>(dset_id, range, false);
+  if (H5Dclose(dset_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 dataset.");
+
+  std::vector<std::uint32_t> perms;
+  if (needs_transformations)
+  {
+    dset_id = hdf5::open_dataset(h5_id, group + "/cell_permutations");
+    perms = hdf5::read_dataset<std::uint32_t>(dset_id, range, false);
+    if (H5Dclose(dset_id) < 0)
+      throw std::runtime_error("Failed to close HDF5 dataset.");
+  }
+  hdf5::close_file(h5_id);
+
+  // Fetch the rows for the owned cells by original cell index
+  std::vector<S> cell_values
+      = dolfinx::MPI::distribute_data(comm, cell_idx, comm, values, width);
+  std::vector<std::uint32_t> cell_perms;
+  if (needs_transformations)
+  {
+    cell_perms
+        = dolfinx::MPI::distribute_data(comm, cell_idx, comm, perms, 1);
+  }
+
+  auto apply_dof_transformation = element->template dof_transformation_fn<T>(
+      fem::doftransform::transpose, false);
+  auto apply_inverse_dof_transform
+      = element->template dof_transformation_fn<T>(
+          fem::doftransform::inverse_transpose, false);
+
+  // Set dof values of each owned cell, mapping values to the current
+  // cell orientation if it has changed
+  const std::size_t num_cell_dofs = is_complex ? width / 2 : width;
+  std::vector<T> local(num_cell_dofs);
+  std::span<T> x = u.x()->mutable_array();
+  for (std::size_t c = 0; c < cell_idx.size(); ++c)
+  {
+    std::span<const S> row(cell_values.data() + c * width, width);
+    for (std::size_t i = 0; i < num_cell_dofs; ++i)
+    {
+      if constexpr (is_complex)
+        local[i] = T(row[2 * i], row[2 * i + 1]);
+      else
+        local[i] = row[i];
+    }
+
+    if (needs_transformations and cell_perms[c] != cell_info[c])
+    {
+      apply_dof_transformation(local, std::span(&cell_perms[c], 1), 0, 1);
+      apply_inverse_dof_transform(local, cell_info, c, 1);
+    }
+
+    std::span<const std::int32_t> dofs = dofmap->cell_dofs(c);
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+      for (int k = 0; k < bs; ++k)
+        x[bs * dofs[i] + k] = local[bs * i + k];
+  }
+
+  u.x()->scatter_fwd();
+}
+} // namespace dolfinx::io::checkpointing
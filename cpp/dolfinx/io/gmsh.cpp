@@ -0,0 +1,588 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "gmsh.h"
+#include "cells.h"
+#include "xdmf_utils.h"
+#include <algorithm>
+#include <array>
+#include <basix/finite-element.h>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Cell type, degree and number of nodes of Gmsh element types, see
+/// https://gmsh.info/doc/texinfo/gmsh.html#MSH-file-format
+struct ElementType
+{
+  mesh::CellType cell;
+  int degree;
+  int num_nodes;
+};
+
+ElementType element_type(int type)
+{
+  switch (type)
+  {
+  case 1:
+    return {mesh::CellType::interval, 1, 2};
+  case 2:
+    return {mesh::CellType::triangle, 1, 3};
+  case 3:
+    return {mesh::CellType::quadrilateral, 1, 4};
+  case 4:
+    return {mesh::CellType::tetrahedron, 1, 4};
+  case 5:
+    return {mesh::CellType::hexahedron, 1, 8};
+  case 8:
+    return {mesh::CellType::interval, 2, 3};
+  case 9:
+    return {mesh::CellType::triangle, 2, 6};
+  case 10:
+    return {mesh::CellType::quadrilateral, 2, 9};
+  case 11:
+    return {mesh::CellType::tetrahedron, 2, 10};
+  case 12:
+    return {mesh::CellType::hexahedron, 2, 27};
+  case 15:
+    return {mesh::CellType::point, 0, 1};
+  case 21:
+    return {mesh::CellType::triangle, 3, 10};
+  case 26:
+    return {mesh::CellType::interval, 3, 4};
+  case 29:
+    return {mesh::CellType::tetrahedron, 3, 20};
+  case 36:
+    return {mesh::CellType::quadrilateral, 3, 16};
+  case 92:
+    return {mesh::CellType::hexahedron, 3, 64};
+  default:
+    throw std::runtime_error("Unsupported Gmsh element type "
+                             + std::to_string(type) + ".");
+  }
+}
+
+/// A node or element block of a MSH file
+struct Block
+{
+  int dim;    // Dimension of the Gmsh entity
+  int entity; // Tag of the Gmsh entity
+  int width;  // Values per node (coordinates) or element (nodes)
+  std::int64_t size;     // Number of nodes or elements
+  std::streamoff offset; // File position of the block data
+};
+
+/// Section headers of a MSH file
+struct Header
+{
+  // Physical group of each (dimension, entity tag)
+  std::map<std::array<int, 2>, int> physical;
+  std::vector<Block> nodes;
+  std::vector<Block> elements;
+};
+
+template <typename T>
+T read(std::istream& f)
+{
+  T v;
+  if (!f.read(reinterpret_cast<char*>(&v), sizeof(T)))
+    throw std::runtime_error("Failed to read Gmsh file.");
+  return v;
+}
+
+template <typename T>
+void read(std::istream& f, std::span<T> v)
+{
+  if (!f.read(reinterpret_cast<char*>(v.data()), v.size_bytes()))
+    throw std::runtime_error("Failed to read Gmsh file.");
+}
+
+/// Read the format, entities and the node and element block headers of
+/// a binary MSH 4.1 file. Other sections are skipped.
+Header read_header(std::istream& f)
+{
+  Header h;
+  bool has_format = false;
+  std::string line;
+  while (std::getline(f, line))
+  {
+    if (!line.empty() and line.back() == '\r')
+      line.pop_back();
+
+    if (line == "$MeshFormat")
+    {
+      double version = 0;
+      int file_type = 0, data_size = 0;
+      f >> version >> file_type >> data_size;
+      if (version < 4.1 or version >= 5)
+        throw std::runtime_error("Only Gmsh MSH 4.1 files are supported.");
+      if (file_type != 1)
+        throw std::runtime_error("Only binary Gmsh MSH files are supported.");
+      if (data_size != sizeof(std::size_t))
+        throw std::runtime_error("Unsupported Gmsh data size.");
+      f.get();
+      if (read<int>(f) != 1)
+        throw std::runtime_error("Gmsh file has a different byte order.");
+      has_format = true;
+    }
+    else if (line == "$Entities")
+    {
+      std::array<std::size_t, 4> num;
+      for (std::size_t& n : num)
+        n = read<std::size_t>(f);
+      for (int dim = 0; dim < 4; ++dim)
+      {
+        for (std::size_t i = 0; i < num[dim]; ++i)
+        {
+          const int tag = read<int>(f);
+          f.seekg((dim == 0 ? 3 : 6) * sizeof(double), std::ios::cur);
+          std::vector<int> physical(read<std::size_t>(f));
+          read(f, std::span(physical));
+          if (!physical.empty())
+            h.physical[{dim, tag}] = physical.front();
+          if (dim > 0)
+            f.seekg(read<std::size_t>(f) * sizeof(int), std::ios::cur);
+        }
+      }
+    }
+    else if (line == "$Nodes")
+    {
+      const std::size_t num_blocks = read<std::size_t>(f);
+      f.seekg(3 * sizeof(std::size_t), std::ios::cur);
+      for (std::size_t i = 0; i < num_blocks; ++i)
+      {
+        Block b;
+        b.dim = read<int>(f);
+        b.entity = read<int>(f);
+        b.width = read<int>(f) ? 3 + b.dim : 3;
+        b.size = read<std::size_t>(f);
+        b.offset = f.tellg();
+        h.nodes.push_back(b);
+        f.seekg(b.size * (sizeof(std::size_t) + b.width * sizeof(double)),
+                std::ios::cur);
+      }
+    }
+    else if (line == "$Elements")
+    {
+      const std::size_t num_blocks = read<std::size_t>(f);
+      f.seekg(3 * sizeof(std::size_t), std::ios::cur);
+      for (std::size_t i = 0; i < num_blocks; ++i)
+      {
+        Block b;
+        b.dim = read<int>(f);
+        b.entity = read<int>(f);
+        b.width = read<int>(f);
+        b.size = read<std::size_t>(f);
+        b.offset = f.tellg();
+        h.elements.push_back(b);
+        const int num_nodes = element_type(b.width).num_nodes;
+        f.seekg(b.size * (1 + num_nodes) * sizeof(std::size_t),
+                std::ios::cur);
+      }
+    }
+  }
+
+  if (!has_format)
+    throw std::runtime_error("Gmsh file has no $MeshFormat section.");
+  f.clear();
+  return h;
+}
+
+/// Read the rows `[r0, r1)` of the elements in a list of blocks of the
+/// same element type, numbering the elements consecutively through the
+/// blocks. Returns the node tags of the elements and the physical group
+/// of each element (-1 if an element has no group).
+std::pair<std::vector<std::int64_t>, std::vector<std::int32_t>>
+read_elements(std::istream& f, std::span<const Block> blocks,
+              const std::map<std::array<int, 2>, int>& physical,
+              std::array<std::int64_t, 2> range)
+{
+  std::vector<std::int64_t> nodes;
+  std::vector<std::int32_t> values;
+  std::vector<std::size_t> buffer;
+  std::int64_t b0 = 0;
+  for (const Block& b : blocks)
+  {
+    const std::int64_t b1 = b0 + b.size;
+    const std::int64_t i0 = std::max(b0, range[0]);
+    const std::int64_t i1 = std::min(b1, range[1]);
+    if (i0 < i1)
+    {
+      const int num_nodes = element_type(b.width).num_nodes;
+      buffer.resize((i1 - i0) * (1 + num_nodes));
+      f.seekg(b.offset + (i0 - b0) * (1 + num_nodes) * sizeof(std::size_t));
+      read(f, std::span(buffer));
+
+      // Discard the element tags
+      for (std::int64_t e = 0; e < i1 - i0; ++e)
+      {
+        auto row = std::next(buffer.begin(), e * (1 + num_nodes) + 1);
+        nodes.insert(nodes.end(), row, std::next(row, num_nodes));
+      }
+
+      auto it = physical.find({b.dim, b.entity});
+      values.insert(values.end(), i1 - i0,
+                    it == physical.end() ? -1 : it->second);
+    }
+    b0 = b1;
+  }
+
+  return {std::move(nodes), std::move(values)};
+}
+
+/// Read the rows `[r0, r1)` of the nodes in a list of node blocks.
+/// Returns the node tags and the first `gdim` coordinates.
+std::pair<std::vector<std::int64_t>, std::vector<double>>
+read_nodes(std::istream& f, std::span<const Block> blocks, int gdim,
+           std::array<std::int64_t, 2> range)
+{
+  std::vector<std::int64_t> tags;
+  std::vector<double> x;
+  std::vector<std::size_t> tag_buffer;
+  std::vector<double> x_buffer;
+  std::int64_t b0 = 0;
+  for (const Block& b : blocks)
+  {
+    const std::int64_t b1 = b0 + b.size;
+    const std::int64_t i0 = std::max(b0, range[0]);
+    const std::int64_t i1 = std::min(b1, range[1]);
+    if (i0 < i1)
+    {
+      tag_buffer.resize(i1 - i0);
+      f.seekg(b.offset + (i0 - b0) * sizeof(std::size_t));
+      read(f, std::span(tag_buffer));
+      tags.insert(tags.end(), tag_buffer.begin(), tag_buffer.end());
+
+      x_buffer.resize((i1 - i0) * b.width);
+      f.seekg(b.offset + b.size * sizeof(std::size_t)
+              + (i0 - b0) * b.width * sizeof(double));
+      read(f, std::span(x_buffer));
+      for (std::int64_t n = 0; n < i1 - i0; ++n)
+      {
+        auto row = std::next(x_buffer.begin(), n * b.width);
+        x.insert(x.end(), row, std::next(row, gdim));
+      }
+    }
+    b0 = b1;
+  }
+
+  return {std::move(tags), std::move(x)};
+}
+
+/// @brief Number the nodes in order of their tags.
+///
+/// Each node is sent to the post office rank for its tag, where the
+/// nodes are sorted by tag and numbered consecutively. Returns (0) the
+/// coordinates of the nodes in the post office ordering, which is the
+/// node distribution used to create the mesh, and (1) the new index
+/// for each tag in the block of tags that the caller is the post
+/// office for (-1 for tags that are not used).
+std::pair<std::vector<double>, std::vector<std::int64_t>>
+number_nodes(MPI_Comm comm, std::span<const std::int64_t> tags,
+             std::span<const double> x, int gdim,
+             std::array<std::int64_t, 2> tag_range)
+{
+  const int size = dolfinx::MPI::size(comm);
+  const std::int64_t num_tags = tag_range[1] - tag_range[0];
+
+  // Sort (destination rank, node) pairs by destination rank
+  std::vector<std::array<std::int64_t, 2>> dest_to_node(tags.size());
+  for (std::size_t i = 0; i < tags.size(); ++i)
+  {
+    dest_to_node[i]
+        = {dolfinx::MPI::index_owner(size, tags[i] - tag_range[0], num_tags),
+           static_cast<std::int64_t>(i)};
+  }
+  std::ranges::sort(dest_to_node);
+
+  std::vector<int> ranks;
+  std::vector<std::int32_t> send_sizes;
+  std::vector<std::int64_t> send_tags;
+  std::vector<double> send_x;
+  send_tags.reserve(tags.size());
+  send_x.reserve(x.size());
+  for (auto [r, i] : dest_to_node)
+  {
+    if (ranks.empty() or ranks.back() != r)
+    {
+      ranks.push_back(r);
+      send_sizes.push_back(0);
+    }
+    ++send_sizes.back();
+    send_tags.push_back(tags[i]);
+    send_x.insert(send_x.end(), std::next(x.begin(), i * gdim),
+                  std::next(x.begin(), (i + 1) * gdim));
+  }
+
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+
+  std::vector<std::int32_t> recv_sizes(src.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T, recv_sizes.data(),
+                        1, MPI_INT32_T, neigh_comm);
+  std::vector<std::int32_t> send_disp(send_sizes.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int32_t> recv_disp(recv_sizes.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+
+  std::vector<std::int64_t> recv_tags(recv_disp.back());
+  MPI_Neighbor_alltoallv(send_tags.data(), send_sizes.data(), send_disp.data(),
+                         MPI_INT64_T, recv_tags.data(), recv_sizes.data(),
+                         recv_disp.data(), MPI_INT64_T, neigh_comm);
+
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(gdim, MPI_DOUBLE, &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<double> recv_x(recv_disp.back() * gdim);
+  MPI_Neighbor_alltoallv(send_x.data(), send_sizes.data(), send_disp.data(),
+                         compound_type, recv_x.data(), recv_sizes.data(),
+                         recv_disp.data(), compound_type, neigh_comm);
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm);
+
+  // Number received nodes by tag
+  std::vector<std::int32_t> perm(recv_tags.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::sort(perm, [&recv_tags](auto a, auto b)
+                    { return recv_tags[a] < recv_tags[b]; });
+
+  std::int64_t offset = 0;
+  const std::int64_t num_nodes = perm.size();
+  MPI_Exscan(&num_nodes, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+
+  const std::array<std::int64_t, 2> block = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), num_tags, size);
+  std::vector<std::int64_t> index(block[1] - block[0], -1);
+  std::vector<double> x1(recv_x.size());
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    std::int64_t pos = recv_tags[perm[i]] - tag_range[0] - block[0];
+    if (index[pos] != -1)
+      throw std::runtime_error("Duplicate node tag in Gmsh file.");
+    index[pos] = offset + i;
+    std::copy_n(std::next(recv_x.begin(), perm[i] * gdim), gdim,
+                std::next(x1.begin(), i * gdim));
+  }
+
+  return {std::move(x1), std::move(index)};
+}
+
+/// Replace node tags by node indices, using the index blocks computed
+/// by number_nodes.
+void tags_to_indices(MPI_Comm comm, std::span<std::int64_t> nodes,
+                     std::span<const std::int64_t> index,
+                     std::int64_t min_tag)
+{
+  std::vector<std::int64_t> tags(nodes.begin(), nodes.end());
+  std::ranges::sort(tags);
+  auto [unique_end, range_end] = std::ranges::unique(tags);
+  tags.erase(unique_end, range_end);
+
+  std::vector<std::int64_t> keys(tags.size());
+  std::ranges::transform(tags, keys.begin(),
+                         [min_tag](auto t) { return t - min_tag; });
+  const std::vector<std::int64_t> idx
+      = dolfinx::MPI::distribute_data(comm, keys, comm, index, 1);
+
+  for (std::int64_t& n : nodes)
+  {
+    auto it = std::ranges::lower_bound(tags, n);
+    assert(it != tags.end() and *it == n);
+    n = idx[std::distance(tags.begin(), it)];
+    if (n < 0)
+      throw std::runtime_error("Gmsh element refers to a missing node.");
+  }
+}
+
+/// Blocks of elements of the given dimension, which must be of the same
+/// element type. If `physical_only`, blocks of entities without a
+/// physical group are excluded.
+std::vector<Block> select_blocks(const Header& h, int dim, bool physical_only)
+{
+  std::vector<Block> blocks;
+  for (const Block& b : h.elements)
+  {
+    if (b.dim == dim
+        and (!physical_only or h.physical.contains({b.dim, b.entity})))
+    {
+      if (!blocks.empty() and blocks.front().width != b.width)
+        throw std::runtime_error("Mixed Gmsh element types are not "
+                                 "supported.");
+      blocks.push_back(b);
+    }
+  }
+  return blocks;
+}
+
+/// Total number of elements in a list of blocks
+std::int64_t num_elements(std::span<const Block> blocks)
+{
+  return std::accumulate(blocks.begin(), blocks.end(), std::int64_t(0),
+                         [](auto n, auto& b) { return n + b.size; });
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::tuple<mesh::Mesh<double>, mesh::MeshTags<std::int32_t>,
+           mesh::MeshTags<std::int32_t>>
+io::gmsh::read_mesh(MPI_Comm comm, const std::filesystem::path& filename,
+                    int gdim, mesh::GhostMode mode)
+{
+  common::Timer timer("Gmsh: read mesh");
+  if (gdim < 1 or gdim > 3)
+    throw std::runtime_error("Geometric dimension must be 1, 2 or 3.");
+
+  std::ifstream f(filename, std::ios::binary);
+  if (!f)
+    throw std::runtime_error("Failed to open Gmsh file " + filename.string());
+  const Header h = read_header(f);
+  if (h.nodes.empty() or h.elements.empty())
+    throw std::runtime_error("Gmsh file has no nodes or elements.");
+
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Read a range of the nodes and number them by tag
+  const std::int64_t num_nodes_file = num_elements(h.nodes);
+  auto [node_tags, x0] = read_nodes(
+      f, h.nodes, gdim, dolfinx::MPI::local_range(rank, num_nodes_file, size));
+  std::array<std::int64_t, 2> tag_range
+      = {std::numeric_limits<std::int64_t>::max(), 0};
+  for (std::int64_t t : node_tags)
+  {
+    tag_range[0] = std::min(tag_range[0], t);
+    tag_range[1] = std::max(tag_range[1], t + 1);
+  }
+  tag_range[0] = -tag_range[0];
+  MPI_Allreduce(MPI_IN_PLACE, tag_range.data(), 2, MPI_INT64_T, MPI_MAX,
+                comm);
+  tag_range[0] = -tag_range[0];
+  auto [x, node_index] = number_nodes(comm, node_tags, x0, gdim, tag_range);
+  node_tags = std::vector<std::int64_t>();
+  x0 = std::vector<double>();
+
+  // Cells are the elements of the highest dimension
+  const int tdim = std::ranges::max_element(h.elements, {}, &Block::dim)->dim;
+  if (tdim < 1)
+    throw std::runtime_error("Gmsh file has no cells.");
+  const std::vector<Block> cell_blocks = select_blocks(h, tdim, false);
+  const ElementType cell_type = element_type(cell_blocks.front().width);
+  const std::int64_t num_cells = num_elements(cell_blocks);
+  auto [cells, cell_values]
+      = read_elements(f, cell_blocks, h.physical,
+                      dolfinx::MPI::local_range(rank, num_cells, size));
+  tags_to_indices(comm, cells, node_index, tag_range[0]);
+  cells = io::cells::apply_permutation(
+      cells, {cell_values.size(), std::size_t(cell_type.num_nodes)},
+      io::cells::perm_gmsh(cell_type.cell, cell_type.num_nodes));
+
+  // Facets are the elements of dimension tdim - 1 in a physical group
+  const std::vector<Block> facet_blocks = select_blocks(h, tdim - 1, true);
+  const std::int64_t num_facets = num_elements(facet_blocks);
+  std::vector<std::int64_t> facets;
+  std::vector<std::int32_t> facet_values;
+  int num_facet_nodes = 0;
+  if (num_facets > 0)
+  {
+    const ElementType facet_type = element_type(facet_blocks.front().width);
+    num_facet_nodes = facet_type.num_nodes;
+    std::tie(facets, facet_values)
+        = read_elements(f, facet_blocks, h.physical,
+                        dolfinx::MPI::local_range(rank, num_facets, size));
+    tags_to_indices(comm, facets, node_index, tag_range[0]);
+    facets = io::cells::apply_permutation(
+        facets, {facet_values.size(), std::size_t(num_facet_nodes)},
+        io::cells::perm_gmsh(facet_type.cell, num_facet_nodes));
+  }
+  f.close();
+
+  // Create the mesh
+  spdlog::info("Create mesh from Gmsh file with {} cells", num_cells);
+  fem::CoordinateElement<double> cmap(
+      cell_type.cell, cell_type.degree,
+      basix::element::lagrange_variant::equispaced);
+  const std::array<std::size_t, 2> xshape
+      = {x.size() / gdim, static_cast<std::size_t>(gdim)};
+  mesh::Mesh<double> mesh
+      = mesh::create_mesh(comm, cells, cmap, x, xshape, mode);
+  cells = std::vector<std::int64_t>();
+  auto topology = mesh.topology_mutable();
+
+  // Tag the cells by their original (file) index
+  std::vector<std::int32_t> cell_indices, cell_tags;
+  {
+    const std::vector<std::int32_t> values = dolfinx::MPI::distribute_data(
+        comm, topology->original_cell_index.front(), comm, cell_values, 1);
+    for (std::size_t c = 0; c < values.size(); ++c)
+    {
+      if (values[c] >= 0)
+      {
+        cell_indices.push_back(c);
+        cell_tags.push_back(values[c]);
+      }
+    }
+  }
+  mesh::MeshTags<std::int32_t> cell_meshtags(topology, tdim,
+                                             std::move(cell_indices),
+                                             std::move(cell_tags));
+  cell_meshtags.name = "Cell tags";
+
+  // Tag the facets
+  std::vector<std::int32_t> facet_entities, facet_tags;
+  if (num_facets > 0)
+  {
+    MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+        const std::int64_t,
+        MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>>
+        facets_span(facets.data(), facet_values.size(), num_facet_nodes);
+    std::tie(facet_entities, facet_tags)
+        = io::xdmf_utils::distribute_entity_data<std::int32_t>(
+            *topology, mesh.geometry().input_global_indices(),
+            mesh.geometry().index_map()->size_global(),
+            mesh.geometry().cmap().create_dof_layout(),
+            mesh.geometry().dofmap(), tdim - 1, facets_span, facet_values);
+  }
+
+  topology->create_entities(tdim - 1);
+  topology->create_connectivity(tdim - 1, tdim);
+  const int num_facet_vertices = mesh::num_cell_vertices(
+      mesh::cell_entity_type(cell_type.cell, tdim - 1, 0));
+  mesh::MeshTags<std::int32_t> facet_meshtags = mesh::create_meshtags(
+      std::shared_ptr<const mesh::Topology>(topology), tdim - 1,
+      graph::regular_adjacency_list(std::move(facet_entities),
+                                    num_facet_vertices),
+      std::span<const std::int32_t>(facet_tags));
+  facet_meshtags.name = "Facet tags";
+
+  return {std::move(mesh), std::move(cell_meshtags),
+          std::move(facet_meshtags)};
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <mpi.h>
+#include <tuple>
+
+/// @file gmsh.h
+/// @brief Reading of meshes in the Gmsh MSH file format.
+
+namespace dolfinx::io::gmsh
+{
+/// @brief Read a mesh and the physical groups of its cells and facets
+/// from a binary Gmsh MSH 4.1 file.
+///
+/// All processes open the file and read the section headers, which
+/// give the file position of each node and element block. Each process
+/// then reads a contiguous range of the nodes and of the elements
+/// directly from the file, so no data is read on one process and
+/// scattered. The nodes are numbered by their Gmsh tags, which need
+/// not be contiguous.
+///
+/// The elements of the highest dimension in the file are the cells of
+/// the mesh, and must be of one type. Cells and facets are tagged with
+/// the first physical group of their Gmsh entity. Cells that are not
+/// in a physical group are part of the mesh but are not tagged, and
+/// facets that are not in a physical group are not read.
+///
+/// @note Collective function
+///
+/// @param[in] comm Communicator to create the mesh on.
+/// @param[in] filename Name of the MSH file.
+/// @param[in] gdim Geometric dimension of the mesh. Node coordinates
+/// beyond `gdim` are discarded.
+/// @param[in] mode Type of cell ghosting/overlap.
+/// @return (0) The mesh, (1) cell tags and (2) facet tags.
+std::tuple<mesh::Mesh<double>, mesh::MeshTags<std::int32_t>,
+           mesh::MeshTags<std::int32_t>>
+read_mesh(MPI_Comm comm, const std::filesystem::path& filename, int gdim,
+          mesh::GhostMode mode = mesh::GhostMode::none);
+} // namespace dolfinx::io::gmsh
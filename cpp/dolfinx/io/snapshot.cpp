@@ -0,0 +1,287 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "snapshot.h"
+#include <algorithm>
+#include <array>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <optional>
+#include <utility>
+
+using namespace dolfinx;
+using namespace dolfinx::io;
+
+namespace
+{
+// Identifier at the start of each snapshot file
+constexpr std::array<char, 8> magic = {'D', 'O', 'L', 'F', 'S', 'N', 'A', 'P'};
+
+// Version of the snapshot format
+constexpr std::int32_t version = 1;
+
+/// Write an adjacency list, keeping a constant degree list compact
+void write_adjacency_list(std::ostream& s,
+                          const graph::AdjacencyList<std::int32_t>& list)
+{
+  const std::int32_t degree = list.degree().value_or(-1);
+  snapshot::impl::write_value<std::int32_t>(s, degree);
+  snapshot::impl::write_value<std::int32_t>(s, list.num_nodes());
+  snapshot::impl::write_array<std::int32_t>(s, list.array());
+  if (degree < 0)
+    snapshot::impl::write_array<std::int32_t>(s, list.offsets());
+}
+
+/// Read an adjacency list written by write_adjacency_list
+std::shared_ptr<graph::AdjacencyList<std::int32_t>>
+read_adjacency_list(std::istream& s)
+{
+  const auto degree = snapshot::impl::read_value<std::int32_t>(s);
+  const auto num_nodes = snapshot::impl::read_value<std::int32_t>(s);
+  std::vector<std::int32_t> array
+      = snapshot::impl::read_array<std::int32_t>(s);
+  if (degree < 0)
+  {
+    std::vector<std::int32_t> offsets
+        = snapshot::impl::read_array<std::int32_t>(s);
+    return std::make_shared<graph::AdjacencyList<std::int32_t>>(
+        std::move(array), std::move(offsets));
+  }
+  else
+  {
+    return std::make_shared<graph::AdjacencyList<std::int32_t>>(
+        std::move(array), num_nodes, degree);
+  }
+}
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::filesystem::path
+snapshot::impl::filename(const std::filesystem::path& filename, int rank)
+{
+  std::filesystem::path f = filename;
+  f += "." + std::to_string(rank);
+  return f;
+}
+//-----------------------------------------------------------------------------
+void snapshot::impl::write_header(std::ostream& s, MPI_Comm comm,
+                                  std::size_t value_size)
+{
+  s.write(magic.data(), magic.size());
+  write_value<std::int32_t>(s, version);
+  write_value<std::int32_t>(s, dolfinx::MPI::size(comm));
+  write_value<std::int32_t>(s, dolfinx::MPI::rank(comm));
+  write_value<std::int32_t>(s, value_size);
+}
+//-----------------------------------------------------------------------------
+void snapshot::impl::read_header(std::istream& s, MPI_Comm comm,
+                                 std::size_t value_size)
+{
+  std::array<char, 8> m;
+  s.read(m.data(), m.size());
+  if (!s or m != magic)
+    throw std::runtime_error("File is not a mesh snapshot.");
+  if (read_value<std::int32_t>(s) != version)
+    throw std::runtime_error("Unsupported mesh snapshot version.");
+
+  const int size = read_value<std::int32_t>(s);
+  const int rank = read_value<std::int32_t>(s);
+  if (size != dolfinx::MPI::size(comm) or rank != dolfinx::MPI::rank(comm))
+  {
+    throw std::runtime_error("Mesh snapshot was written by rank "
+                             + std::to_string(rank) + " of "
+                             + std::to_string(size) + " processes.");
+  }
+
+  if (read_value<std::int32_t>(s) != static_cast<std::int32_t>(value_size))
+    throw std::runtime_error("Mesh snapshot has a different value type.");
+}
+//-----------------------------------------------------------------------------
+void snapshot::impl::write_index_map(std::ostream& s,
+                                     const common::IndexMap& map)
+{
+  write_value(s, map.local_range());
+  write_value<std::int64_t>(s, map.size_global());
+  write_array(s, map.ghosts());
+  write_array(s, map.owners());
+  write_array(s, map.src());
+  write_array(s, map.dest());
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const common::IndexMap>
+snapshot::impl::read_index_map(std::istream& s, MPI_Comm comm)
+{
+  auto local_range = read_value<std::array<std::int64_t, 2>>(s);
+  auto size_global = read_value<std::int64_t>(s);
+  std::vector<std::int64_t> ghosts = read_array<std::int64_t>(s);
+  std::vector<int> owners = read_array<int>(s);
+  std::array<std::vector<int>, 2> src_dest
+      = {read_array<int>(s), read_array<int>(s)};
+  return std::make_shared<common::IndexMap>(comm, local_range, size_global,
+                                            src_dest, ghosts, owners);
+}
+//-----------------------------------------------------------------------------
+void snapshot::impl::write_topology(std::ostream& s,
+                                    const mesh::Topology& topology)
+{
+  const int tdim = topology.dim();
+  std::vector<std::int32_t> cell_types;
+  for (mesh::CellType cell : topology.entity_types(tdim))
+    cell_types.push_back(static_cast<int>(cell));
+  write_array<std::int32_t>(s, cell_types);
+
+  // Index maps of each entity type (nullptr if the entities have not
+  // been created)
+  for (int d = 0; d <= tdim; ++d)
+  {
+    auto maps = topology.index_maps(d);
+    write_value<std::int32_t>(s, maps.size());
+    for (auto& map : maps)
+    {
+      write_value<std::int8_t>(s, map != nullptr);
+      if (map)
+        write_index_map(s, *map);
+    }
+  }
+
+  // Connectivities between entity types, apart from the vertex-vertex
+  // connectivity that is created by the Topology constructor
+  std::vector<std::array<std::int8_t, 4>> conn;
+  for (int d0 = 0; d0 <= tdim; ++d0)
+  {
+    const int n0 = topology.entity_types(d0).size();
+    for (int i0 = 0; i0 < n0; ++i0)
+    {
+      for (int d1 = 0; d1 <= tdim; ++d1)
+      {
+        const int n1 = topology.entity_types(d1).size();
+        for (int i1 = 0; i1 < n1; ++i1)
+        {
+          if ((d0 > 0 or d1 > 0) and topology.connectivity({d0, i0}, {d1, i1}))
+          {
+            conn.push_back({static_cast<std::int8_t>(d0),
+                            static_cast<std::int8_t>(i0),
+                            static_cast<std::int8_t>(d1),
+                            static_cast<std::int8_t>(i1)});
+          }
+        }
+      }
+    }
+  }
+
+  write_value<std::int32_t>(s, conn.size());
+  for (auto [d0, i0, d1, i1] : conn)
+  {
+    write_value(s, std::array{d0, i0, d1, i1});
+    write_adjacency_list(s, *topology.connectivity({d0, i0}, {d1, i1}));
+  }
+
+  write_value<std::int32_t>(s, topology.original_cell_index.size());
+  for (auto& idx : topology.original_cell_index)
+    write_array<std::int64_t>(s, idx);
+
+  for (std::size_t i = 0; i < cell_types.size(); ++i)
+    write_value<std::int32_t>(s, topology.cell_ranges(i)[1]);
+
+  const std::size_t num_facet_types
+      = tdim > 0 ? topology.entity_types(tdim - 1).size() : 0;
+  for (std::size_t i = 0; i < num_facet_types; ++i)
+    write_array<std::int32_t>(s, topology.interprocess_facets(i));
+
+  auto [facet_permutations, cell_permutations]
+      = topology.entity_permutations();
+  write_array(s, facet_permutations);
+  write_array(s, cell_permutations);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<mesh::Topology>
+snapshot::impl::read_topology(std::istream& s, MPI_Comm comm)
+{
+  std::vector<mesh::CellType> cell_types;
+  for (std::int32_t cell : read_array<std::int32_t>(s))
+    cell_types.push_back(static_cast<mesh::CellType>(cell));
+  if (cell_types.empty())
+    throw std::runtime_error("Mesh snapshot has no cell types.");
+  const int tdim = mesh::cell_dim(cell_types.front());
+
+  std::vector<std::vector<std::shared_ptr<const common::IndexMap>>> maps(
+      tdim + 1);
+  for (int d = 0; d <= tdim; ++d)
+  {
+    const int n = read_value<std::int32_t>(s);
+    for (int i = 0; i < n; ++i)
+    {
+      if (read_value<std::int8_t>(s))
+        maps[d].push_back(read_index_map(s, comm));
+      else
+        maps[d].push_back(nullptr);
+    }
+  }
+
+  const int num_conn = read_value<std::int32_t>(s);
+  std::vector<std::pair<std::array<std::int8_t, 4>,
+                        std::shared_ptr<graph::AdjacencyList<std::int32_t>>>>
+      conn;
+  for (int k = 0; k < num_conn; ++k)
+  {
+    auto e = read_value<std::array<std::int8_t, 4>>(s);
+    conn.emplace_back(e, read_adjacency_list(s));
+  }
+
+  std::vector<std::vector<std::int64_t>> original_cell_index(
+      read_value<std::int32_t>(s));
+  for (auto& idx : original_cell_index)
+    idx = read_array<std::int64_t>(s);
+
+  // Create the topology from the cell-vertex connectivities
+  std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>> cells(
+      cell_types.size());
+  for (auto& [e, c] : conn)
+  {
+    if (e[0] == tdim and e[2] == 0)
+      cells.at(e[1]) = c;
+  }
+  if (maps[0].empty() or !maps[0].front()
+      or std::ranges::any_of(cells, [](auto& c) { return !c; }))
+  {
+    throw std::runtime_error("Mesh snapshot has no cell-vertex topology.");
+  }
+
+  auto topology = std::make_shared<mesh::Topology>(
+      comm, cell_types, maps[0].front(), maps[tdim], cells,
+      original_cell_index.empty()
+          ? std::nullopt
+          : std::optional<std::vector<std::vector<std::int64_t>>>(
+                std::move(original_cell_index)));
+
+  for (int d = 1; d < tdim; ++d)
+  {
+    for (std::size_t i = 0; i < maps[d].size(); ++i)
+    {
+      if (maps[d][i])
+        topology->set_index_map(d, i, maps[d][i]);
+    }
+  }
+
+  for (auto& [e, c] : conn)
+    topology->set_connectivity(c, {e[0], e[1]}, {e[2], e[3]});
+
+  for (std::size_t i = 0; i < cell_types.size(); ++i)
+    topology->set_num_interior_cells(i, read_value<std::int32_t>(s));
+
+  const std::size_t num_facet_types
+      = tdim > 0 ? topology->entity_types(tdim - 1).size() : 0;
+  for (std::size_t i = 0; i < num_facet_types; ++i)
+    topology->set_interprocess_facets(i, read_array<std::int32_t>(s));
+
+  std::vector<std::uint8_t> facet_permutations = read_array<std::uint8_t>(s);
+  std::vector<std::uint32_t> cell_permutations = read_array<std::uint32_t>(s);
+  topology->set_entity_permutations(std::move(facet_permutations),
+                                    std::move(cell_permutations));
+
+  return topology;
+}
+//-----------------------------------------------------------------------------
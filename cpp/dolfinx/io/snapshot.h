@@ -0,0 +1,252 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <basix/finite-element.h>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mpi.h>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// @file snapshot.h
+/// @brief Binary snapshots of distributed meshes.
+///
+/// A snapshot stores the complete local data of a mesh on each process
+/// in a binary file per process: the index maps (including the
+/// neighbourhood ranks), all connectivities that have been created, the
+/// entity permutation data, the inter-process facets and the geometry.
+/// A mesh is restored from a snapshot on the same number of processes
+/// without the (parallel) computation of the topology, entities, index
+/// maps and permutations, and without communication apart from
+/// duplicating communicators. This suits applications that restart
+/// repeatedly with the same mesh.
+///
+/// The files are not portable between platforms with different byte
+/// order or type sizes. Boundary entities (see
+/// mesh::Topology::create_boundary_entities) are not stored.
+
+namespace dolfinx::io::snapshot
+{
+namespace impl
+{
+/// @brief Write a value to a binary stream.
+template <typename V>
+  requires std::is_trivially_copyable_v<V>
+void write_value(std::ostream& s, const V& v)
+{
+  s.write(reinterpret_cast<const char*>(&v), sizeof(V));
+}
+
+/// @brief Read a value from a binary stream.
+template <typename V>
+  requires std::is_trivially_copyable_v<V>
+V read_value(std::istream& s)
+{
+  V v;
+  s.read(reinterpret_cast<char*>(&v), sizeof(V));
+  if (!s)
+    throw std::runtime_error("Unexpected end of mesh snapshot.");
+  return v;
+}
+
+/// @brief Write an array (size and values) to a binary stream.
+template <typename V>
+  requires std::is_trivially_copyable_v<V>
+void write_array(std::ostream& s, std::span<const V> a)
+{
+  write_value<std::uint64_t>(s, a.size());
+  s.write(reinterpret_cast<const char*>(a.data()), a.size() * sizeof(V));
+}
+
+/// @brief Read an array written by write_array from a binary stream.
+template <typename V>
+  requires std::is_trivially_copyable_v<V>
+std::vector<V> read_array(std::istream& s)
+{
+  std::vector<V> a(read_value<std::uint64_t>(s));
+  s.read(reinterpret_cast<char*>(a.data()), a.size() * sizeof(V));
+  if (!s)
+    throw std::runtime_error("Unexpected end of mesh snapshot.");
+  return a;
+}
+
+/// @brief Name of the snapshot file of a process.
+/// @param[in] filename Name of the snapshot.
+/// @param[in] rank Rank of the process.
+/// @return `filename` with the suffix `.<rank>`.
+std::filesystem::path filename(const std::filesystem::path& filename,
+                               int rank);
+
+/// @brief Write the header of a snapshot file.
+/// @param[in] s Stream to write to.
+/// @param[in] comm Communicator of the mesh.
+/// @param[in] value_size Size of the geometry value type in bytes.
+void write_header(std::ostream& s, MPI_Comm comm, std::size_t value_size);
+
+/// @brief Read and check the header of a snapshot file.
+///
+/// An exception is raised if the file is not a snapshot, was written by
+/// a different rank or number of processes, or for a different
+/// geometry value type.
+/// @param[in] s Stream to read from.
+/// @param[in] comm Communicator of the mesh.
+/// @param[in] value_size Size of the geometry value type in bytes.
+void read_header(std::istream& s, MPI_Comm comm, std::size_t value_size);
+
+/// @brief Write an index map to a binary stream.
+void write_index_map(std::ostream& s, const common::IndexMap& map);
+
+/// @brief Read an index map written by write_index_map.
+/// @note Collective
+std::shared_ptr<const common::IndexMap> read_index_map(std::istream& s,
+                                                       MPI_Comm comm);
+
+/// @brief Write a topology to a binary stream.
+void write_topology(std::ostream& s, const mesh::Topology& topology);
+
+/// @brief Read a topology written by write_topology.
+/// @note Collective
+std::shared_ptr<mesh::Topology> read_topology(std::istream& s,
+                                              MPI_Comm comm);
+} // namespace impl
+
+/// @brief Write a snapshot of a mesh.
+///
+/// Each process writes the file `filename.<rank>`. To store the entities,
+/// connectivities and permutations that are required after a restart,
+/// they should be created before the snapshot is written.
+///
+/// @param[in] filename Name of the snapshot.
+/// @param[in] mesh Mesh to write.
+template <std::floating_point T>
+void write(const std::filesystem::path& filename, const mesh::Mesh<T>& mesh)
+{
+  const int rank = dolfinx::MPI::rank(mesh.comm());
+  std::ofstream s(impl::filename(filename, rank),
+                  std::ios::binary | std::ios::trunc);
+  if (!s)
+  {
+    throw std::runtime_error("Unable to open mesh snapshot file "
+                             + impl::filename(filename, rank).string());
+  }
+
+  impl::write_header(s, mesh.comm(), sizeof(T));
+  impl::write_array<char>(s, mesh.name);
+
+  auto topology = mesh.topology();
+  assert(topology);
+  impl::write_topology(s, *topology);
+
+  const mesh::Geometry<T>& geometry = mesh.geometry();
+  impl::write_value<std::int32_t>(s, geometry.dim());
+  assert(geometry.index_map());
+  impl::write_index_map(s, *geometry.index_map());
+  const std::size_t num_cmaps = topology->entity_types(topology->dim()).size();
+  for (std::size_t i = 0; i < num_cmaps; ++i)
+  {
+    const fem::CoordinateElement<T>& cmap = geometry.cmap(i);
+    impl::write_value<std::int32_t>(s, static_cast<int>(cmap.cell_shape()));
+    impl::write_value<std::int32_t>(s, cmap.degree());
+    impl::write_value<std::int32_t>(s, static_cast<int>(cmap.variant()));
+    auto dofmap = geometry.dofmap(i);
+    impl::write_array<std::int32_t>(
+        s, std::span(dofmap.data_handle(), dofmap.size()));
+  }
+
+  // Coordinates are stored with three components per point
+  mesh::NodeCoordinates<T> x = geometry.coordinates();
+  impl::write_value<std::int32_t>(s, x.stride);
+  std::vector<T> x3(3 * (x.x.size() / x.stride));
+  for (std::size_t i = 0; i < x3.size() / 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      x3[3 * i + j] = x(i, j);
+  impl::write_array<T>(s, x3);
+  impl::write_array<std::int64_t>(s, geometry.input_global_indices());
+
+  if (!s)
+  {
+    throw std::runtime_error("Failed to write mesh snapshot file "
+                             + impl::filename(filename, rank).string());
+  }
+}
+
+/// @brief Read a mesh from a snapshot.
+///
+/// The snapshot must have been written by write on the same number of
+/// processes, and each process reads the file of its rank. The
+/// topology, index maps, connectivities, permutations and geometry are
+/// restored as written, without recomputation.
+///
+/// @note Collective
+///
+/// @param[in] comm Communicator to create the mesh on.
+/// @param[in] filename Name of the snapshot.
+/// @return The mesh.
+template <std::floating_point T>
+mesh::Mesh<T> read(MPI_Comm comm, const std::filesystem::path& filename)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  std::ifstream s(impl::filename(filename, rank), std::ios::binary);
+  if (!s)
+  {
+    throw std::runtime_error("Unable to open mesh snapshot file "
+                             + impl::filename(filename, rank).string());
+  }
+
+  impl::read_header(s, comm, sizeof(T));
+  const std::vector<char> name = impl::read_array<char>(s);
+
+  std::shared_ptr<mesh::Topology> topology = impl::read_topology(s, comm);
+
+  const int gdim = impl::read_value<std::int32_t>(s);
+  std::shared_ptr<const common::IndexMap> index_map
+      = impl::read_index_map(s, comm);
+  const std::size_t num_cmaps = topology->entity_types(topology->dim()).size();
+  std::vector<fem::CoordinateElement<T>> cmaps;
+  std::vector<std::vector<std::int32_t>> dofmaps;
+  for (std::size_t i = 0; i < num_cmaps; ++i)
+  {
+    auto cell_type
+        = static_cast<mesh::CellType>(impl::read_value<std::int32_t>(s));
+    const int degree = impl::read_value<std::int32_t>(s);
+    auto variant = static_cast<basix::element::lagrange_variant>(
+        impl::read_value<std::int32_t>(s));
+    cmaps.emplace_back(cell_type, degree, variant);
+    dofmaps.push_back(impl::read_array<std::int32_t>(s));
+  }
+
+  const int stride = impl::read_value<std::int32_t>(s);
+  std::vector<T> x = impl::read_array<T>(s);
+  std::vector<std::int64_t> input_global_indices
+      = impl::read_array<std::int64_t>(s);
+
+  mesh::Geometry<T> geometry(index_map, dofmaps, cmaps, std::move(x), gdim,
+                             std::move(input_global_indices));
+  if (stride != 3)
+    geometry.set_x_stride(stride);
+
+  mesh::Mesh<T> mesh(comm, topology, std::move(geometry));
+  mesh.name = std::string(name.begin(), name.end());
+  return mesh;
+}
+} // namespace dolfinx::io::snapshot
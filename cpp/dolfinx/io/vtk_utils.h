@@ -90,7 +90,7 @@ tabulate_lagrange_dof_coordinates(const fem::FunctionSpace<T>& V)
 
   // Prepare cell geometry
   auto dofmap_x = mesh->geometry().dofmap();
-  std::span<const T> x_g = mesh->geometry().x();
+  mesh::NodeCoordinates<T> x_g = mesh->geometry().coordinates();
   const std::size_t num_dofs_g = cmap.dim();
 
   std::span<const std::uint32_t> cell_info;
@@ -137,7 +137,7 @@ tabulate_lagrange_dof_coordinates(const fem::FunctionSpace<T>& V)
     // Extract cell geometry
     for (std::size_t i = 0; i < dofmap_x.extent(1); ++i)
       for (std::size_t j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g[3 * dofmap_x(c, i) + j];
+        coordinate_dofs(i, j) = x_g(dofmap_x(c, i), j);
 
     // Tabulate dof coordinates on cell
     cmap.push_forward(x, coordinate_dofs, phi);
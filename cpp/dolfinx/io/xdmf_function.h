@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "HDF5Interface.h"
 #include <complex>
 #include <concepts>
 #include <dolfinx/common/types.h>
@@ -29,9 +30,11 @@ class Function;
 namespace io::xdmf_function
 {
 
-/// Write a fem::Function to XDMF
+/// Write a fem::Function to XDMF. `options` sets the HDF5 chunking and
+/// compression of the function value datasets.
 template <dolfinx::scalar T, std::floating_point U>
 void add_function(MPI_Comm comm, const fem::Function<T, U>& u, double t,
-                  pugi::xml_node& xml_node, const hid_t h5_id);
+                  pugi::xml_node& xml_node, const hid_t h5_id,
+                  const io::hdf5::DatasetOptions& options = {});
 } // namespace io::xdmf_function
 } // namespace dolfinx
@@ -7,24 +7,233 @@
 #include "xdmf_mesh.h"
 #include "cells.h"
 #include "xdmf_utils.h"
+#include <algorithm>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/graph/partitioners.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <limits>
+#include <numeric>
 #include <pugixml.hpp>
+#include <string>
 #include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
 
+namespace
+{
+/// @brief Send rows of a chunk of cells to destination ranks.
+///
+/// Row `i` of `cells` is sent, together with its global index `i +
+/// offset`, to rank `dest[i]`. The received rows and global indices
+/// are appended to `cells1` and `idx1`.
+void send_cells(MPI_Comm comm, std::span<const std::int64_t> cells,
+                std::size_t shape1, std::span<const std::int32_t> dest,
+                std::int64_t offset, std::vector<std::int64_t>& cells1,
+                std::vector<std::int64_t>& idx1)
+{
+  // Sort (destination rank, row) pairs by destination rank
+  std::vector<std::array<std::int32_t, 2>> dest_to_row(dest.size());
+  for (std::size_t i = 0; i < dest.size(); ++i)
+    dest_to_row[i] = {dest[i], static_cast<std::int32_t>(i)};
+  std::ranges::sort(dest_to_row);
+
+  // Pack global index followed by the row
+  std::vector<int> ranks;
+  std::vector<std::int32_t> send_sizes;
+  std::vector<std::int64_t> send_data;
+  send_data.reserve(dest.size() * (shape1 + 1));
+  for (auto [r, i] : dest_to_row)
+  {
+    if (ranks.empty() or ranks.back() != r)
+    {
+      ranks.push_back(r);
+      send_sizes.push_back(0);
+    }
+    ++send_sizes.back();
+    send_data.push_back(i + offset);
+    send_data.insert(send_data.end(), std::next(cells.begin(), i * shape1),
+                     std::next(cells.begin(), (i + 1) * shape1));
+  }
+
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+
+  std::vector<std::int32_t> recv_sizes(src.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T, recv_sizes.data(),
+                        1, MPI_INT32_T, neigh_comm);
+  std::vector<std::int32_t> send_disp(send_sizes.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int32_t> recv_disp(recv_sizes.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(shape1 + 1, MPI_INT64_T, &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<std::int64_t> recv_data(recv_disp.back() * (shape1 + 1));
+  MPI_Neighbor_alltoallv(send_data.data(), send_sizes.data(), send_disp.data(),
+                         compound_type, recv_data.data(), recv_sizes.data(),
+                         recv_disp.data(), compound_type, neigh_comm);
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm);
+
+  for (std::size_t i = 0; i < recv_data.size(); i += shape1 + 1)
+  {
+    idx1.push_back(recv_data[i]);
+    cells1.insert(cells1.end(), std::next(recv_data.begin(), i + 1),
+                  std::next(recv_data.begin(), i + 1 + shape1));
+  }
+}
+
+/// Read a block of rows of a HDF5 dataset. If an event set is given,
+/// the read is queued in it.
+template <typename T>
+std::vector<T> read_rows(hid_t h5_id, const std::string& path,
+                         std::array<std::int64_t, 2> range,
+                         hid_t es_id = io::hdf5::event_set_none)
+{
+  hid_t dset_id = io::hdf5::open_dataset(h5_id, path);
+  if (dset_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 dataset " + path + ".");
+  std::vector<T> data;
+  if (range[1] > range[0])
+    data = io::hdf5::read_dataset<T>(dset_id, range, true, es_id);
+  if (io::hdf5::impl::close_dataset(dset_id, es_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 dataset " + path + ".");
+  return data;
+}
+
+/// Read geometry data (see xdmf_mesh::read_geometry_data). If an event
+/// set is given, the read is queued in it.
+/// @return Geometry data and geometric dimension.
+std::pair<std::vector<double>, std::size_t>
+geometry_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node,
+              std::array<std::int64_t, 2> range, hid_t es_id)
+{
+  // Get geometry node
+  pugi::xml_node geometry_node = node.child("Geometry");
+  assert(geometry_node);
+
+  // Determine geometric dimension
+  pugi::xml_attribute geometry_type_attr
+      = geometry_node.attribute("GeometryType");
+  assert(geometry_type_attr);
+  std::size_t gdim = 0;
+  const std::string geometry_type = geometry_type_attr.value();
+  if (geometry_type == "XY")
+    gdim = 2;
+  else if (geometry_type == "XYZ")
+    gdim = 3;
+  else
+  {
+    throw std::runtime_error(
+        "Cannot determine geometric dimension. GeometryType \"" + geometry_type
+        + "\" in XDMF file is unknown or unsupported");
+  }
+
+  // Get number of points from Geometry dataitem node
+  pugi::xml_node geometry_data_node = geometry_node.child("DataItem");
+  assert(geometry_data_node);
+  const std::vector gdims = xdmf_utils::get_dataset_shape(geometry_data_node);
+  assert(gdims.size() == 2);
+  assert(gdims[1] == (int)gdim);
+
+  // Read geometry data
+  return {xdmf_utils::get_dataset<double>(comm, geometry_data_node, h5_id,
+                                          range, es_id),
+          gdim};
+}
+
+/// Read topology data in VTK ordering (see
+/// xdmf_mesh::read_topology_data). If an event set is given, the read is
+/// queued in it.
+/// @return Topology data, cell type and number of nodes per cell.
+std::tuple<std::vector<std::int64_t>, mesh::CellType, std::size_t>
+topology_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node,
+              std::array<std::int64_t, 2> range, hid_t es_id)
+{
+  // Get topology node
+  pugi::xml_node topology_node = node.child("Topology");
+  assert(topology_node);
+
+  // Get cell type
+  const std::pair<std::string, int> cell_type_str
+      = xdmf_utils::get_cell_type(topology_node);
+
+  // Get toplogical dimensions
+  mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
+
+  // Get topology dataset node
+  pugi::xml_node topology_data_node = topology_node.child("DataItem");
+  assert(topology_data_node);
+  const std::vector tdims = xdmf_utils::get_dataset_shape(topology_data_node);
+  const std::size_t npoint_per_cell = tdims[1];
+
+  // Read topology data
+  return {xdmf_utils::get_dataset<std::int64_t>(comm, topology_data_node,
+                                                h5_id, range, es_id),
+          cell_type, npoint_per_cell};
+}
+
+/// Permute cells from VTK to DOLFINx ordering
+std::pair<std::vector<std::int64_t>, std::array<std::size_t, 2>>
+permute_cells(std::span<const std::int64_t> topology_data,
+              mesh::CellType cell_type, std::size_t npoint_per_cell)
+{
+  const std::size_t num_local_cells = topology_data.size() / npoint_per_cell;
+  std::array<std::size_t, 2> shape = {num_local_cells, npoint_per_cell};
+  std::vector<std::int64_t> cells = io::cells::apply_permutation(
+      topology_data, shape, io::cells::perm_vtk(cell_type, shape[1]));
+  return {std::move(cells), shape};
+}
+
+/// @brief Path of the HDF5 dataset that stores the partition of a mesh
+/// (see xdmf_mesh::add_mesh). No value is returned if the mesh is not
+/// stored in HDF5 or the partition is not stored.
+std::optional<std::string> partition_path(hid_t h5_id,
+                                          const pugi::xml_node& node)
+{
+  pugi::xml_node topology_data_node = node.child("Topology").child("DataItem");
+  assert(topology_data_node);
+  if (h5_id <= 0
+      or topology_data_node.attribute("Format").as_string()
+             != std::string("HDF"))
+  {
+    return std::nullopt;
+  }
+
+  // The partition is stored next to the topology dataset
+  std::string path = xdmf_utils::get_hdf5_paths(topology_data_node)[1];
+  path = path.substr(0, path.rfind('/')) + std::string("/partition");
+  if (!io::hdf5::has_dataset(h5_id, path))
+    return std::nullopt;
+  return path;
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 template <std::floating_point U>
 void xdmf_mesh::add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node,
                                   hid_t h5_id, std::string path_prefix,
                                   const mesh::Topology& topology,
                                   const mesh::Geometry<U>& geometry, int dim,
-                                  std::span<const std::int32_t> entities)
+                                  std::span<const std::int32_t> entities,
+                                  const io::hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding topology data to node {}", xml_node.path('/'));
 
@@ -153,13 +362,14 @@ void xdmf_mesh::add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node,
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
   xdmf_utils::add_data_item(topology_node, h5_id, h5_path,
                             std::span<const std::int64_t>(topology_data),
-                            offset, shape, number_type, use_mpi_io);
+                            offset, shape, number_type, use_mpi_io, options);
 }
 //-----------------------------------------------------------------------------
 template <std::floating_point U>
 void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
                                   hid_t h5_id, std::string path_prefix,
-                                  const mesh::Geometry<U>& geometry)
+                                  const mesh::Geometry<U>& geometry,
+                                  const io::hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding geometry data to node \"{}\"", xml_node.path('/'));
   auto map = geometry.index_map();
@@ -181,20 +391,17 @@ void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
   // Increase 1D to 2D because XDMF has no "X" geometry, use "XY"
   const int width = (gdim == 1) ? 2 : gdim;
 
-  std::span<const U> _x = geometry.x();
+  mesh::NodeCoordinates<U> _x = geometry.coordinates();
 
   int num_values = num_points_local * width;
   std::vector<U> x(num_values, 0.0);
-
-  if (width == 3)
-    std::copy_n(_x.data(), num_values, x.begin());
+  if (width == 3 and _x.stride == 3)
+    std::copy_n(_x.x.data(), num_values, x.begin());
   else
   {
     for (int i = 0; i < num_points_local; ++i)
-    {
-      std::copy_n(std::next(_x.begin(), 3 * i), gdim,
-                  std::next(x.begin(), width * i));
-    }
+      for (int j = 0; j < gdim; ++j)
+        x[width * i + j] = _x(i, j);
   }
 
   // Add geometry DataItem node
@@ -207,12 +414,13 @@ void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
   xdmf_utils::add_data_item(geometry_node, h5_id, h5_path,
                             std::span<const U>(x), offset, shape, "",
-                            use_mpi_io);
+                            use_mpi_io, options);
 }
 //----------------------------------------------------------------------------
 template <std::floating_point U>
 void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
-                         const mesh::Mesh<U>& mesh, const std::string& name)
+                         const mesh::Mesh<U>& mesh, const std::string& name,
+                         const io::hdf5::DatasetOptions& options)
 {
   spdlog::info("Adding mesh to node \"{}\"", xml_node.path('/'));
 
@@ -236,90 +444,351 @@ void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 
   add_topology_data(comm, grid_node, h5_id, path_prefix, *mesh.topology(),
                     mesh.geometry(), tdim,
-                    std::span<std::int32_t>(cells.data(), num_cells));
+                    std::span<std::int32_t>(cells.data(), num_cells), options);
 
   // Add geometry node and attributes (including writing data)
-  add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry());
+  add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry(),
+                    options);
+
+  // Store offsets of the owned cells and nodes of each process, which
+  // permits the mesh to be read back without repartitioning
+  if (h5_id > 0)
+  {
+    const int rank = dolfinx::MPI::rank(comm);
+    const int size = dolfinx::MPI::size(comm);
+    auto map_g = mesh.geometry().index_map();
+    assert(map_g);
+    std::vector<std::int64_t> offsets
+        = {map->local_range()[0], map_g->local_range()[0]};
+    std::array<std::int64_t, 2> range = {rank, rank + 1};
+    if (rank == size - 1)
+    {
+      offsets.insert(offsets.end(), {map->size_global(), map_g->size_global()});
+      range[1] += 1;
+    }
+    io::hdf5::write_dataset(h5_id, path_prefix + std::string("/partition"),
+                            offsets.data(), range, {size + 1, 2}, size > 1);
+  }
 }
 /// @cond
 template void xdmf_mesh::add_mesh(MPI_Comm, pugi::xml_node&, hid_t,
-                                  const mesh::Mesh<float>&, const std::string&);
+                                  const mesh::Mesh<float>&, const std::string&,
+                                  const io::hdf5::DatasetOptions&);
 template void xdmf_mesh::add_mesh(MPI_Comm, pugi::xml_node&, hid_t,
                                   const mesh::Mesh<double>&,
-                                  const std::string&);
+                                  const std::string&,
+                                  const io::hdf5::DatasetOptions&);
 /// @endcond
 //----------------------------------------------------------------------------
 std::pair<std::variant<std::vector<float>, std::vector<double>>,
           std::array<std::size_t, 2>>
 xdmf_mesh::read_geometry_data(MPI_Comm comm, hid_t h5_id,
-                              const pugi::xml_node& node)
+                              const pugi::xml_node& node,
+                              std::array<std::int64_t, 2> range)
 {
-  // Get geometry node
-  pugi::xml_node geometry_node = node.child("Geometry");
-  assert(geometry_node);
+  auto [x, gdim]
+      = geometry_data(comm, h5_id, node, range, io::hdf5::event_set_none);
+  std::array<std::size_t, 2> shape = {x.size() / gdim, gdim};
+  return {std::move(x), shape};
+}
+//----------------------------------------------------------------------------
+std::pair<std::vector<std::int64_t>, std::array<std::size_t, 2>>
+xdmf_mesh::read_topology_data(MPI_Comm comm, hid_t h5_id,
+                              const pugi::xml_node& node,
+                              std::array<std::int64_t, 2> range)
+{
+  auto [data, cell_type, npoint_per_cell]
+      = topology_data(comm, h5_id, node, range, io::hdf5::event_set_none);
+  return permute_cells(data, cell_type, npoint_per_cell);
+}
+//----------------------------------------------------------------------------
+std::tuple<std::vector<std::int64_t>, std::array<std::size_t, 2>,
+           std::variant<std::vector<float>, std::vector<double>>,
+           std::array<std::size_t, 2>>
+xdmf_mesh::read_mesh_data(MPI_Comm comm, hid_t h5_id,
+                          const pugi::xml_node& node,
+                          std::array<std::array<std::int64_t, 2>, 2> ranges)
+{
+  // Issue both reads before waiting for either
+  const hid_t es_id = h5_id > 0 ? io::hdf5::event_set(h5_id)
+                                : io::hdf5::event_set_none;
+  auto [data, cell_type, npoint_per_cell]
+      = topology_data(comm, h5_id, node, ranges[0], es_id);
+  auto [x, gdim] = geometry_data(comm, h5_id, node, ranges[1], es_id);
+  if (es_id != io::hdf5::event_set_none)
+    io::hdf5::wait(h5_id);
+
+  auto [cells, cshape] = permute_cells(data, cell_type, npoint_per_cell);
+  std::array<std::size_t, 2> xshape = {x.size() / gdim, gdim};
+  return {std::move(cells), cshape, std::move(x), xshape};
+}
+//----------------------------------------------------------------------------
+std::optional<std::array<std::array<std::int64_t, 2>, 2>>
+xdmf_mesh::read_partition(MPI_Comm comm, hid_t h5_id,
+                          const pugi::xml_node& node)
+{
+  std::optional<std::string> path = partition_path(h5_id, node);
+  if (!path)
+    return std::nullopt;
+
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  std::vector<std::int64_t> shape = io::hdf5::get_dataset_shape(h5_id, *path);
+  if (shape.size() != 2 or shape[0] != size + 1 or shape[1] != 2)
+    return std::nullopt;
+
+  hid_t dset_id = io::hdf5::open_dataset(h5_id, *path);
+  if (dset_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 partition dataset.");
+  std::vector<std::int64_t> offsets
+      = io::hdf5::read_dataset<std::int64_t>(dset_id, {rank, rank + 2}, true);
+  if (H5Dclose(dset_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 partition dataset.");
+
+  // A rank with no cells would request the default range when reading
+  // the data, so fall back to repartitioning
+  std::array<std::array<std::int64_t, 2>, 2> ranges
+      = {{{offsets[0], offsets[2]}, {offsets[1], offsets[3]}}};
+  int empty = ranges[0][0] == ranges[0][1] or ranges[1][0] == ranges[1][1];
+  MPI_Allreduce(MPI_IN_PLACE, &empty, 1, MPI_INT, MPI_LOR, comm);
+  if (empty)
+    return std::nullopt;
+
+  return ranges;
+}
+//----------------------------------------------------------------------------
+std::optional<std::tuple<std::array<std::int64_t, 2>,
+                         std::vector<std::int32_t>, int>>
+xdmf_mesh::read_cell_owners(MPI_Comm comm, hid_t h5_id,
+                            const pugi::xml_node& node)
+{
+  std::optional<std::string> path = partition_path(h5_id, node);
+  if (!path)
+    return std::nullopt;
+
+  std::vector<std::int64_t> shape = io::hdf5::get_dataset_shape(h5_id, *path);
+  if (shape.size() != 2 or shape[0] < 2 or shape[1] != 2)
+    return std::nullopt;
+
+  // Read the offsets of the cells and nodes of all processes
+  std::vector<std::int64_t> offsets
+      = read_rows<std::int64_t>(h5_id, *path, {0, shape[0]});
+  std::vector<std::int64_t> cell_offsets(shape[0]);
+  for (std::size_t i = 0; i < cell_offsets.size(); ++i)
+    cell_offsets[i] = offsets[2 * i];
+
+  // Owner of each cell in the range of cells read by this process
+  std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), cell_offsets.back(), dolfinx::MPI::size(comm));
+  std::vector<std::int32_t> owners;
+  owners.reserve(range[1] - range[0]);
+  auto it = cell_offsets.begin();
+  for (std::int64_t c = range[0]; c < range[1]; ++c)
+  {
+    it = std::upper_bound(it, cell_offsets.end(), c);
+    owners.push_back(std::distance(cell_offsets.begin(), it) - 1);
+  }
 
-  // Determine geometric dimension
-  pugi::xml_attribute geometry_type_attr
-      = geometry_node.attribute("GeometryType");
-  assert(geometry_type_attr);
-  std::size_t gdim = 0;
-  const std::string geometry_type = geometry_type_attr.value();
-  if (geometry_type == "XY")
-    gdim = 2;
-  else if (geometry_type == "XYZ")
-    gdim = 3;
-  else
+  return std::tuple(range, std::move(owners), int(shape[0] - 1));
+}
+//----------------------------------------------------------------------------
+std::optional<mesh::MeshTags<std::int32_t>>
+xdmf_mesh::read_meshtags_by_cell(MPI_Comm comm, hid_t h5_id,
+                                 const pugi::xml_node& values_node,
+                                 const mesh::Mesh<double>& mesh, int dim)
+{
+  assert(values_node);
+  if (h5_id <= 0
+      or values_node.attribute("Format").as_string() != std::string("HDF"))
   {
-    throw std::runtime_error(
-        "Cannot determine geometric dimension. GeometryType \"" + geometry_type
-        + "\" in XDMF file is unknown or unsupported");
+    return std::nullopt;
   }
 
-  // Get number of points from Geometry dataitem node
-  pugi::xml_node geometry_data_node = geometry_node.child("DataItem");
-  assert(geometry_data_node);
-  const std::vector gdims = xdmf_utils::get_dataset_shape(geometry_data_node);
-  assert(gdims.size() == 2);
-  assert(gdims[1] == (int)gdim);
+  // The cell-entity data is stored next to the values dataset
+  const std::string values_path = xdmf_utils::get_hdf5_paths(values_node)[1];
+  const std::string path = values_path.substr(0, values_path.rfind('/'))
+                           + std::string("/cell_entity");
+  if (!io::hdf5::has_dataset(h5_id, path))
+    return std::nullopt;
+
+  std::shared_ptr<const mesh::Topology> topology = mesh.topology();
+  const int tdim = topology->dim();
+  const std::int32_t num_cells = topology->index_map(tdim)->size_local();
+  int valid = (dim == tdim or topology->connectivity(tdim, dim))
+              and topology->original_cell_index.size() == 1
+              and topology->original_cell_index.front().size()
+                      >= std::size_t(num_cells);
+  MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, comm);
+  if (!valid)
+    return std::nullopt;
+
+  std::vector<std::int64_t> shape = io::hdf5::get_dataset_shape(h5_id, path);
+  if (shape.size() != 2 or shape[1] != 2
+      or io::hdf5::get_dataset_shape(h5_id, values_path).front() != shape[0])
+  {
+    throw std::runtime_error("Mesh tag cell-entity data has the wrong shape.");
+  }
 
-  // Read geometry data
-  std::vector geometry_data
-      = xdmf_utils::get_dataset<double>(comm, geometry_data_node, h5_id);
-  const std::size_t num_local_nodes = geometry_data.size() / gdim;
-  std::array<std::size_t, 2> shape = {num_local_nodes, gdim};
-  return {std::move(geometry_data), shape};
+  // Read the same block of entities and values, then distribute by cell
+  spdlog::info("XDMF read meshtags by cell");
+  const std::array<std::int64_t, 2> range = dolfinx::MPI::local_range(
+      dolfinx::MPI::rank(comm), shape[0], dolfinx::MPI::size(comm));
+  const hid_t es_id = io::hdf5::event_set(h5_id);
+  const std::vector cell_entities
+      = read_rows<std::int64_t>(h5_id, path, range, es_id);
+  const std::vector values
+      = read_rows<std::int32_t>(h5_id, values_path, range, es_id);
+  if (es_id != io::hdf5::event_set_none)
+    io::hdf5::wait(h5_id);
+
+  auto [indices, tag_values] = xdmf_utils::distribute_cell_entity_data(
+      *topology, topology->original_cell_index.front(), dim, cell_entities,
+      values);
+  return mesh::MeshTags<std::int32_t>(topology, dim, std::move(indices),
+                                      std::move(tag_values));
 }
 //----------------------------------------------------------------------------
-std::pair<std::vector<std::int64_t>, std::array<std::size_t, 2>>
-xdmf_mesh::read_topology_data(MPI_Comm comm, hid_t h5_id,
-                              const pugi::xml_node& node)
+std::tuple<std::vector<std::int64_t>, std::array<std::size_t, 2>,
+           std::vector<std::int64_t>>
+xdmf_mesh::read_topology_data_chunked(MPI_Comm comm, hid_t h5_id,
+                                      const pugi::xml_node& node,
+                                      std::span<const double> x, int gdim,
+                                      std::int64_t chunk_size)
 {
-  // Get topology node
+  if (chunk_size < 1)
+    throw std::runtime_error("Chunk size must be positive.");
+
   pugi::xml_node topology_node = node.child("Topology");
   assert(topology_node);
-
-  // Get cell type
   const std::pair<std::string, int> cell_type_str
       = xdmf_utils::get_cell_type(topology_node);
-
-  // Get toplogical dimensions
   mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
 
-  // Get topology dataset node
   pugi::xml_node topology_data_node = topology_node.child("DataItem");
   assert(topology_data_node);
-  const std::vector tdims = xdmf_utils::get_dataset_shape(topology_data_node);
-  const std::size_t npoint_per_cell = tdims[1];
+  if (h5_id <= 0
+      or topology_data_node.attribute("Format").as_string()
+             != std::string("HDF"))
+  {
+    throw std::runtime_error(
+        "Chunked reading of topology data requires HDF5 storage.");
+  }
 
-  // Read topology data
-  std::vector<std::int64_t> topology_data
-      = xdmf_utils::get_dataset<std::int64_t>(comm, topology_data_node, h5_id);
-  const std::size_t num_local_cells = topology_data.size() / npoint_per_cell;
+  const std::string path = xdmf_utils::get_hdf5_paths(topology_data_node)[1];
+  const std::vector<std::int64_t> shape
+      = io::hdf5::get_dataset_shape(h5_id, path);
+  if (shape.size() != 2)
+  {
+    throw std::runtime_error(
+        "Chunked reading of topology data requires a rank 2 dataset.");
+  }
+  const std::size_t num_nodes = shape[1];
+  const int num_vertices = mesh::num_cell_vertices(cell_type);
+  const std::vector<std::uint16_t> perm
+      = io::cells::perm_vtk(cell_type, num_nodes);
+
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const std::array<std::int64_t, 2> range
+      = dolfinx::MPI::local_range(rank, shape[0], size);
+  std::int64_t num_chunks = (range[1] - range[0] + chunk_size - 1) / chunk_size;
+  MPI_Allreduce(MPI_IN_PLACE, &num_chunks, 1, MPI_INT64_T, MPI_MAX, comm);
+
+  // Global bounding box of the geometry nodes
+  std::array<double, 6> box;
+  std::fill_n(box.begin(), 6, -std::numeric_limits<double>::max());
+  for (std::size_t p = 0; p < x.size() / gdim; ++p)
+  {
+    for (int j = 0; j < gdim; ++j)
+    {
+      box[j] = std::max(box[j], -x[p * gdim + j]);
+      box[3 + j] = std::max(box[3 + j], x[p * gdim + j]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, box.data(), box.size(), MPI_DOUBLE, MPI_MAX,
+                comm);
 
-  //  Permute cells from VTK to DOLFINx ordering
-  std::array<std::size_t, 2> shape = {num_local_cells, npoint_per_cell};
-  std::vector<std::int64_t> cells = io::cells::apply_permutation(
-      topology_data, shape, io::cells::perm_vtk(cell_type, shape[1]));
-  return {std::move(cells), shape};
+  hid_t dset_id = io::hdf5::open_dataset(h5_id, path);
+  if (dset_id == H5I_INVALID_HID)
+    throw std::runtime_error("Failed to open HDF5 topology dataset.");
+
+  // Read chunk `i` of the block of this rank, in DOLFINx ordering. Reads
+  // are independent, so ranks with no cells in a chunk skip the read.
+  auto read_chunk = [&](std::int64_t i) -> std::vector<std::int64_t>
+  {
+    const std::int64_t c0 = std::min(range[0] + i * chunk_size, range[1]);
+    const std::int64_t c1 = std::min(c0 + chunk_size, range[1]);
+    if (c0 == c1)
+      return {};
+    std::vector<std::int64_t> cells
+        = io::hdf5::read_dataset<std::int64_t>(dset_id, {c0, c1}, true);
+    return io::cells::apply_permutation(
+        cells, {cells.size() / num_nodes, num_nodes}, perm);
+  };
+
+  // First pass: compute the curve key of the midpoint of each cell
+  std::vector<std::uint64_t> keys;
+  keys.reserve(range[1] - range[0]);
+  for (std::int64_t i = 0; i < num_chunks; ++i)
+  {
+    const std::vector<std::int64_t> cells = read_chunk(i);
+    const std::size_t num_cells = cells.size() / num_nodes;
+
+    // Get coordinates of the cell vertices
+    std::vector<std::int64_t> vertices;
+    vertices.reserve(num_cells * num_vertices);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      vertices.insert(vertices.end(), std::next(cells.begin(), c * num_nodes),
+                      std::next(cells.begin(), c * num_nodes + num_vertices));
+    }
+    std::ranges::sort(vertices);
+    auto [unique_end, range_end] = std::ranges::unique(vertices);
+    vertices.erase(unique_end, range_end);
+    const std::vector<double> coords
+        = dolfinx::MPI::distribute_data(comm, vertices, comm, x, gdim);
+
+    std::vector<double> midpoints(num_cells * gdim, 0);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      for (int v = 0; v < num_vertices; ++v)
+      {
+        auto it = std::ranges::lower_bound(vertices, cells[c * num_nodes + v]);
+        std::size_t pos = std::distance(vertices.begin(), it);
+        for (int j = 0; j < gdim; ++j)
+          midpoints[c * gdim + j] += coords[pos * gdim + j] / num_vertices;
+      }
+    }
+
+    const std::vector<std::uint64_t> k = graph::sfc::compute_keys(
+        midpoints, gdim, {-box[0], -box[1], -box[2]},
+        {box[3], box[4], box[5]}, graph::sfc::curve::hilbert);
+    keys.insert(keys.end(), k.begin(), k.end());
+  }
+
+  const std::vector<std::uint64_t> splits
+      = graph::sfc::compute_splitting_keys(comm, size, keys);
+
+  // Second pass: send the cells of each chunk to their destination
+  std::vector<std::int64_t> cells1, idx1;
+  for (std::int64_t i = 0; i < num_chunks; ++i)
+  {
+    const std::vector<std::int64_t> cells = read_chunk(i);
+    const std::size_t num_cells = cells.size() / num_nodes;
+    const std::int64_t c0 = std::min(i * chunk_size, range[1] - range[0]);
+    std::vector<std::int32_t> dest(num_cells);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      dest[c] = std::distance(splits.begin(),
+                              std::ranges::lower_bound(splits, keys[c0 + c]));
+    }
+    send_cells(comm, cells, num_nodes, dest, range[0] + c0, cells1, idx1);
+  }
+
+  if (H5Dclose(dset_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 topology dataset.");
+
+  std::array<std::size_t, 2> shape1 = {idx1.size(), num_nodes};
+  return {std::move(cells1), shape1, std::move(idx1)};
 }
 //----------------------------------------------------------------------------
@@ -11,13 +11,16 @@
 #include <array>
 #include <concepts>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <hdf5.h>
 #include <mpi.h>
+#include <optional>
 #include <pugixml.hpp>
 #include <span>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -46,10 +49,12 @@ namespace io::xdmf_mesh
 /// Add Mesh to xml node
 ///
 /// Creates new Grid with Topology and Geometry xml nodes for mesh. In
-/// HDF file data is stored under path prefix.
+/// HDF file data is stored under path prefix. `options` sets the HDF5
+/// chunking and compression of the topology and geometry datasets.
 template <std::floating_point U>
 void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
-              const mesh::Mesh<U>& mesh, const std::string& path_prefix);
+              const mesh::Mesh<U>& mesh, const std::string& path_prefix,
+              const io::hdf5::DatasetOptions& options = {});
 
 /// Add Topology xml node
 /// @param[in] comm
@@ -61,17 +66,20 @@ void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 /// @param[in] cell_dim Dimension of mesh entities to save
 /// @param[in] entities Local-to-process indices of mesh entities
 /// whose topology will be saved. This is used to save subsets of Mesh.
+/// @param[in] options HDF5 chunking and compression options
 template <std::floating_point U>
 void add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
                        std::string path_prefix, const mesh::Topology& topology,
                        const mesh::Geometry<U>& geometry, int cell_dim,
-                       std::span<const std::int32_t> entities);
+                       std::span<const std::int32_t> entities,
+                       const io::hdf5::DatasetOptions& options = {});
 
 /// Add Geometry xml node
 template <std::floating_point U>
 void add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
                        std::string path_prefix,
-                       const mesh::Geometry<U>& geometry);
+                       const mesh::Geometry<U>& geometry,
+                       const io::hdf5::DatasetOptions& options = {});
 
 /// @brief Read geometry (coordinate) data.
 ///
@@ -79,9 +87,16 @@ void add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node, hid_t h5_id,
 /// array holding the coordinates (row-major storage) and (1) the shape
 /// of the coordinate array. The shape is `(num_nodes, geometric
 /// dimension)`.
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] node Grid XML node.
+/// @param[in] range Range of nodes to read on this process. If `{0, 0}`,
+/// the nodes are divided evenly across processes.
 std::pair<std::variant<std::vector<float>, std::vector<double>>,
           std::array<std::size_t, 2>>
-read_geometry_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
+read_geometry_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node,
+                   std::array<std::int64_t, 2> range = {0, 0});
 
 /// @brief Read topology (cell connectivity) data.
 ///
@@ -89,8 +104,133 @@ read_geometry_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
 /// the 'nodes' of cell `i`. The returned data is (0) an array holding
 /// the topology data (row-major storage) and (1) the shape of the
 /// topology array. The shape is `(num_cells, num_nodes_per_cell)`
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] node Grid XML node.
+/// @param[in] range Range of cells to read on this process. If `{0, 0}`,
+/// the cells are divided evenly across processes.
 std::pair<std::vector<std::int64_t>, std::array<std::size_t, 2>>
-read_topology_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
+read_topology_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node,
+                   std::array<std::int64_t, 2> range = {0, 0});
+
+/// @brief Read the topology and geometry data of a mesh.
+///
+/// The reads of the topology and geometry datasets are issued together
+/// if asynchronous HDF5 operations are enabled for the file (see
+/// io::hdf5::set_async).
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] node Grid XML node.
+/// @param[in] ranges Range of cells and range of nodes to read on this
+/// process (see read_topology_data and read_geometry_data).
+/// @returns (0) Topology data and (1) its shape, as returned by
+/// read_topology_data, and (2) geometry data and (3) its shape, as
+/// returned by read_geometry_data.
+std::tuple<std::vector<std::int64_t>, std::array<std::size_t, 2>,
+           std::variant<std::vector<float>, std::vector<double>>,
+           std::array<std::size_t, 2>>
+read_mesh_data(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node,
+               std::array<std::array<std::int64_t, 2>, 2> ranges);
+
+/// @brief Read topology data in chunks and send each cell to the
+/// process that it is assigned to by a space-filling curve partition of
+/// the cell midpoints.
+///
+/// Each process reads its block of cells from the HDF5 file in chunks
+/// of `chunk_size` cells, and the curve keys of the chunk midpoints
+/// are computed. After the splitting keys have been computed, the
+/// chunks are read again and sent to their destination processes as
+/// they are read. Apart from the chunk buffers, only one key per cell
+/// and the received cells are held in memory, so that the peak memory
+/// use does not depend on the size of the read blocks.
+///
+/// @note Collective function
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] node Grid XML node.
+/// @param[in] x Geometry data on this process, as returned by
+/// read_geometry_data.
+/// @param[in] gdim Geometric dimension, i.e. the number of columns of
+/// `x`.
+/// @param[in] chunk_size Number of cells to read at a time.
+/// @returns (0) Received cells in DOLFINx ordering (row-major storage),
+/// (1) the shape of the cell array and (2) the index of each received
+/// cell in the file.
+std::tuple<std::vector<std::int64_t>, std::array<std::size_t, 2>,
+           std::vector<std::int64_t>>
+read_topology_data_chunked(MPI_Comm comm, hid_t h5_id,
+                           const pugi::xml_node& node,
+                           std::span<const double> x, int gdim,
+                           std::int64_t chunk_size);
+
+/// @brief Read the distribution of mesh cells and geometry nodes across
+/// processes at the time the mesh was written.
+///
+/// A mesh that is written with xdmf_mesh::add_mesh to an HDF5 file
+/// stores the owned cells and nodes of each process as contiguous
+/// blocks, and records the block offsets. If the mesh is read on the
+/// same number of processes, each process can read its own blocks and
+/// repartitioning can be skipped.
+///
+/// @note Collective function
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] node Grid XML node.
+/// @return Range of (0) cells and (1) geometry nodes written by the
+/// process with the same rank as the caller. No value is returned if
+/// the partition is not stored, was written on a different number of
+/// processes or has a process with no cells.
+std::optional<std::array<std::array<std::int64_t, 2>, 2>>
+read_partition(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
+
+/// @brief Read the process that owned each cell at the time the mesh
+/// was written, for the cells that are read by the caller.
+///
+/// The cells are divided evenly across processes in the order of the
+/// file, as in xdmf_mesh::read_topology_data. The owners are determined
+/// from the partition that is stored by xdmf_mesh::add_mesh (see
+/// xdmf_mesh::read_partition), and can be used to create the mesh from
+/// the stored partition when it is read on a different number of
+/// processes (see mesh::create_stored_cell_partitioner).
+///
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] node Grid XML node.
+/// @return (0) Range of cells in the file that are read by the caller,
+/// (1) the rank of the owner of each cell in the range when the mesh
+/// was written and (2) the number of processes that the mesh was
+/// written on. No value is returned if the partition is not stored.
+std::optional<std::tuple<std::array<std::int64_t, 2>,
+                         std::vector<std::int32_t>, int>>
+read_cell_owners(MPI_Comm comm, hid_t h5_id, const pugi::xml_node& node);
+
+/// @brief Read mesh tags using the cell and local entity index of each
+/// tagged entity.
+///
+/// Mesh tags that are written with xdmf_mesh::add_meshtags to an HDF5
+/// file store the cell and the local index in the cell of each entity,
+/// with the cells indexed as written by xdmf_mesh::add_mesh. The tags
+/// are distributed by the original (input) index of the cells (see
+/// xdmf_utils::distribute_cell_entity_data), without matching entity
+/// vertices.
+///
+/// @note Collective function
+/// @param[in] comm MPI communicator.
+/// @param[in] h5_id HDF5 file handle.
+/// @param[in] values_node DataItem XML node of the tag values.
+/// @param[in] mesh Mesh that the tags are defined on. It must have been
+/// read from the cells written with xdmf_mesh::add_mesh.
+/// @param[in] dim Topological dimension of the tagged entities.
+/// @return The mesh tags. No value is returned if the cell and local
+/// entity indices are not stored, the mesh has no original cell
+/// indices or the cell-to-entity connectivity has not been created.
+std::optional<mesh::MeshTags<std::int32_t>>
+read_meshtags_by_cell(MPI_Comm comm, hid_t h5_id,
+                      const pugi::xml_node& values_node,
+                      const mesh::Mesh<double>& mesh, int dim);
 
 /// Add mesh tags to XDMF file
 template <typename T, std::floating_point U>
@@ -139,6 +279,54 @@ void add_meshtags(MPI_Comm comm, const mesh::MeshTags<T>& meshtags,
       attribute_node, h5_id, path_prefix + std::string("/Values"),
       std::span<const T>(meshtags.values().data(), num_active_entities), offset,
       {global_num_values, 1}, "", use_mpi_io);
+
+  // Store the cell and the local index of the entity in the cell for
+  // each entity, which permits the tags to be read without matching the
+  // entity vertices (see xdmf_utils::distribute_cell_entity_data).
+  // Cells are indexed as written by add_mesh.
+  if (h5_id > 0)
+  {
+    const mesh::Topology& topology = *meshtags.topology();
+    const int tdim = topology.dim();
+    auto cell_map = topology.index_map(tdim);
+    assert(cell_map);
+    std::vector<std::int32_t> cells;
+    std::vector<std::int64_t> cell_entities;
+    cell_entities.reserve(2 * num_active_entities);
+    if (dim == tdim)
+    {
+      cells.assign(meshtags.indices().begin(),
+                   std::next(meshtags.indices().begin(), num_active_entities));
+      cell_entities.resize(2 * num_active_entities, 0);
+    }
+    else
+    {
+      auto e_to_c = topology.connectivity(dim, tdim);
+      auto c_to_e = topology.connectivity(tdim, dim);
+      assert(e_to_c);
+      assert(c_to_e);
+      for (std::int32_t i = 0; i < num_active_entities; ++i)
+      {
+        std::int32_t e = meshtags.indices()[i];
+        std::int32_t c = e_to_c->links(e).front();
+        auto entities = c_to_e->links(c);
+        auto it = std::ranges::find(entities, e);
+        assert(it != entities.end());
+        std::int64_t local_e = std::distance(entities.begin(), it);
+        cells.push_back(c);
+        cell_entities.insert(cell_entities.end(), {0, local_e});
+      }
+    }
+
+    std::vector<std::int64_t> cells_g(cells.size());
+    cell_map->local_to_global(cells, cells_g);
+    for (std::size_t i = 0; i < cells_g.size(); ++i)
+      cell_entities[2 * i] = cells_g[i];
+    io::hdf5::write_dataset(h5_id, path_prefix + std::string("/cell_entity"),
+                            cell_entities.data(),
+                            {offset, offset + num_local},
+                            {global_num_values, 2}, use_mpi_io);
+  }
 }
 } // namespace io::xdmf_mesh
 } // namespace dolfinx
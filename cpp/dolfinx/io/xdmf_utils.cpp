@@ -15,6 +15,7 @@
 #include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/la/Vector.h>
 #include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -22,6 +23,7 @@
 #include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
 #include <filesystem>
+#include <limits>
 #include <map>
 #include <pugixml.hpp>
 #include <span>
@@ -636,6 +638,157 @@ xdmf_utils::distribute_entity_data(
                          entities_data, std::span(entities_values));
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, std::vector<std::int32_t>>
+xdmf_utils::distribute_cell_entity_data(
+    const mesh::Topology& topology,
+    std::span<const std::int64_t> original_cell_index, int entity_dim,
+    std::span<const std::int64_t> cell_entities,
+    std::span<const std::int32_t> data)
+{
+  assert(cell_entities.size() == 2 * data.size());
+  spdlog::info("XDMF distribute cell entity data");
+
+  MPI_Comm comm = topology.comm();
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+  const int tdim = topology.dim();
+  auto c_to_e = topology.connectivity(tdim, entity_dim);
+  if (entity_dim < tdim and !c_to_e)
+    throw std::runtime_error("Mesh is missing cell-entity connectivity.");
+  std::shared_ptr<const common::IndexMap> map_e
+      = topology.index_map(entity_dim);
+  assert(map_e);
+  const std::int32_t num_cells = topology.index_map(tdim)->size_local();
+  assert(original_cell_index.size() >= std::size_t(num_cells));
+  const int num_cell_entities
+      = mesh::cell_num_entities(topology.cell_type(), entity_dim);
+
+  // Number of cells in the input numbering
+  std::int64_t num_cells_g = -1;
+  {
+    std::int64_t max_idx = -1;
+    for (std::int32_t c = 0; c < num_cells; ++c)
+      max_idx = std::max(max_idx, original_cell_index[c]);
+    for (std::size_t e = 0; e < data.size(); ++e)
+      max_idx = std::max(max_idx, cell_entities[2 * e]);
+    MPI_Allreduce(&max_idx, &num_cells_g, 1, MPI_INT64_T, MPI_MAX, comm);
+    num_cells_g += 1;
+  }
+
+  // -- A. Send (cell, local entity, value) to the post office of the
+  // cell
+  std::vector<int> dest0(data.size());
+  for (std::size_t e = 0; e < data.size(); ++e)
+  {
+    dest0[e] = dolfinx::MPI::index_owner(size, cell_entities[2 * e],
+                                         num_cells_g);
+  }
+  std::vector<std::int32_t> perm(data.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [&dest0](auto e0, auto e1)
+                           { return dest0[e0] < dest0[e1]; });
+
+  std::vector<int> dest, num_send;
+  std::vector<std::int64_t> send_buffer;
+  send_buffer.reserve(3 * data.size());
+  for (std::int32_t e : perm)
+  {
+    if (dest.empty() or dest.back() != dest0[e])
+    {
+      dest.push_back(dest0[e]);
+      num_send.push_back(0);
+    }
+    num_send.back() += 3;
+    send_buffer.insert(send_buffer.end(),
+                       {cell_entities[2 * e], cell_entities[2 * e + 1],
+                        static_cast<std::int64_t>(data[e])});
+  }
+
+  // Determine src ranks. Sort ranks so that ownership determination is
+  // deterministic for a given number of ranks.
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, dest);
+  std::ranges::sort(src);
+
+  MPI_Comm comm0;
+  int err = MPI_Dist_graph_create_adjacent(
+      comm, src.size(), src.data(), MPI_UNWEIGHTED, dest.size(), dest.data(),
+      MPI_UNWEIGHTED, MPI_INFO_NULL, false, &comm0);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<int> num_recv(src.size());
+  num_send.reserve(1);
+  num_recv.reserve(1);
+  err = MPI_Neighbor_alltoall(num_send.data(), 1, MPI_INT, num_recv.data(), 1,
+                              MPI_INT, comm0);
+  dolfinx::MPI::check_error(comm, err);
+
+  std::vector<int> send_disp(num_send.size() + 1, 0),
+      recv_disp(num_recv.size() + 1, 0);
+  std::partial_sum(num_send.begin(), num_send.end(),
+                   std::next(send_disp.begin()));
+  std::partial_sum(num_recv.begin(), num_recv.end(),
+                   std::next(recv_disp.begin()));
+
+  std::vector<std::int64_t> recv_buffer(recv_disp.back());
+  err = MPI_Neighbor_alltoallv(send_buffer.data(), num_send.data(),
+                               send_disp.data(), MPI_INT64_T,
+                               recv_buffer.data(), num_recv.data(),
+                               recv_disp.data(), MPI_INT64_T, comm0);
+  dolfinx::MPI::check_error(comm, err);
+  err = MPI_Comm_free(&comm0);
+  dolfinx::MPI::check_error(comm, err);
+
+  // -- B. Tabulate the values of the entities of the cells in the post
+  // office range (unset for entities without a value)
+  constexpr std::int64_t unset = std::numeric_limits<std::int64_t>::min();
+  const std::array<std::int64_t, 2> range
+      = dolfinx::MPI::local_range(rank, num_cells_g, size);
+  std::vector<std::int64_t> table((range[1] - range[0]) * num_cell_entities,
+                                  unset);
+  for (std::size_t i = 0; i < recv_buffer.size(); i += 3)
+  {
+    std::int64_t c = recv_buffer[i] - range[0];
+    std::int64_t local_e = recv_buffer[i + 1];
+    assert(c >= 0 and c < range[1] - range[0]);
+    if (local_e < 0 or local_e >= num_cell_entities)
+      throw std::runtime_error("Invalid local entity index.");
+    table[c * num_cell_entities + local_e] = recv_buffer[i + 2];
+  }
+
+  // -- C. Fetch the values for the entities of owned cells
+  const std::vector<std::int64_t> cell_values
+      = dolfinx::MPI::distribute_from_postoffice(
+          comm, original_cell_index.first(num_cells), table,
+          {num_cells_g, num_cell_entities}, range[0]);
+
+  // -- D. Share the values with processes that have the entities
+  la::Vector<std::int64_t> values(map_e, 1);
+  values.set(unset);
+  std::span<std::int64_t> x = values.mutable_array();
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (int i = 0; i < num_cell_entities; ++i)
+    {
+      if (std::int64_t v = cell_values[c * num_cell_entities + i]; v != unset)
+        x[entity_dim == tdim ? c : c_to_e->links(c)[i]] = v;
+    }
+  }
+  values.scatter_rev([](auto x0, auto x1) { return std::max(x0, x1); });
+  values.scatter_fwd();
+
+  std::vector<std::int32_t> indices, entity_data;
+  for (std::size_t e = 0; e < x.size(); ++e)
+  {
+    if (x[e] != unset)
+    {
+      indices.push_back(e);
+      entity_data.push_back(x[e]);
+    }
+  }
+
+  return {std::move(indices), std::move(entity_data)};
+}
+//-----------------------------------------------------------------------------
 /// @cond
 template std::pair<std::vector<std::int32_t>, std::vector<double>>
 xdmf_utils::distribute_entity_data(
@@ -118,12 +118,54 @@ std::pair<std::vector<std::int32_t>, std::vector<T>> distribute_entity_data(
         entities,
     std::span<const T> data);
 
-/// TODO: Document
+/// @brief Get entities and associated data from input entities
+/// defined by a cell and the local index of the entity in the cell.
+///
+/// Unlike ::distribute_entity_data, entities are identified without
+/// communicating and matching their vertices. The data of an entity is
+/// sent to a 'post office' process for its cell, from which the process
+/// that owns the cell fetches it. The data is then shared with the
+/// processes that have the entity as a ghost.
+///
+/// @param[in] topology Mesh topology. For entities other than cells,
+/// the cell-to-entity connectivity must have been created.
+/// @param[in] original_cell_index Input index of each owned cell, e.g.
+/// Topology::original_cell_index.
+/// @param[in] entity_dim Topological dimension of the entities.
+/// @param[in] cell_entities Input cell index and local index of the
+/// entity in the cell for each entity (`shape=(num_entities, 2)`,
+/// row-major). The entities can be supplied on any rank.
+/// @param[in] data Data associated with each entity in
+/// `cell_entities`.
+/// @return (local indices of entities (sorted), associated data). The
+/// entities include ghost entities.
+///
+/// @note Collective.
+std::pair<std::vector<std::int32_t>, std::vector<std::int32_t>>
+distribute_cell_entity_data(const mesh::Topology& topology,
+                            std::span<const std::int64_t> original_cell_index,
+                            int entity_dim,
+                            std::span<const std::int64_t> cell_entities,
+                            std::span<const std::int32_t> data);
+
+/// @brief Add a DataItem node, and write the data to HDF5 if `h5_id`
+/// is a valid file handle.
+/// @param[in,out] xml_node Node to add the DataItem node to.
+/// @param[in] h5_id HDF5 file handle. If negative, the data is written
+/// to the XML file.
+/// @param[in] h5_path Path of the dataset in the HDF5 file.
+/// @param[in] x Data on this process (row-major storage).
+/// @param[in] offset Global row offset of this process.
+/// @param[in] shape Global shape of the data.
+/// @param[in] number_type XDMF number type. Empty for the default.
+/// @param[in] use_mpi_io True if MPI-IO should be used.
+/// @param[in] options HDF5 chunking and compression options.
 template <typename T>
 void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
                    const std::string& h5_path, std::span<const T> x,
                    std::int64_t offset, const std::vector<std::int64_t>& shape,
-                   const std::string& number_type, bool use_mpi_io)
+                   const std::string& number_type, bool use_mpi_io,
+                   const io::hdf5::DatasetOptions& options = {})
 {
   // Add DataItem node
   assert(xml_node);
@@ -178,7 +220,7 @@ void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
 
     const std::array local_range{offset, offset + local_shape0};
     io::hdf5::write_dataset(h5_id, h5_path, x.data(), local_range, shape,
-                            use_mpi_io, false);
+                            use_mpi_io, options);
 
     // Add partitioning attribute to dataset
     // std::vector<std::size_t> partitions;
@@ -191,12 +233,16 @@ void add_data_item(pugi::xml_node& xml_node, hid_t h5_id,
 
 /// @brief Get data associated with a data set node.
 /// @tparam T Data type to read into.
+/// @param[in] es_id HDF5 event set in which the read of HDF5 data is
+/// queued (see io::hdf5::read_dataset), or `event_set_none` for a
+/// blocking read.
 /// @warning Data will be silently cast to type `T` if requested type
 /// and storage type differ.
 template <typename T>
 std::vector<T> get_dataset(MPI_Comm comm, const pugi::xml_node& dataset_node,
                            hid_t h5_id,
-                           std::array<std::int64_t, 2> range = {0, 0})
+                           std::array<std::int64_t, 2> range = {0, 0},
+                           hid_t es_id = io::hdf5::event_set_none)
 {
   // FIXME: Need to sort out dataset dimensions - can't depend on HDF5
   // shape, and a Topology data item is not required to have a
@@ -300,8 +346,8 @@ std::vector<T> get_dataset(MPI_Comm comm, const pugi::xml_node& dataset_node,
       throw std::runtime_error("Failed to open HDF5 global dataset.");
     else
     {
-      data_vector = io::hdf5::read_dataset<T>(dset_id, range, true);
-      if (herr_t err = H5Dclose(dset_id); err < 0)
+      data_vector = io::hdf5::read_dataset<T>(dset_id, range, true, es_id);
+      if (herr_t err = io::hdf5::impl::close_dataset(dset_id, es_id); err < 0)
         throw std::runtime_error("Failed to close HDF5 global dataset.");
     }
   }
@@ -0,0 +1,179 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "BlockVector.h"
+#include <array>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed matrix with a block (nested) structure, e.g. for
+/// the field coupling operators of a mixed problem.
+///
+/// The matrix is a two-dimensional array of sub-matrices, each of
+/// which is typically a la::MatrixCSR. A block can be empty
+/// (`nullptr`), in which case it is zero. The sub-matrices are shared,
+/// i.e. BlockMatrixCSR::block returns a view that can be assembled into
+/// or used directly, e.g. to build field-split preconditioners.
+///
+/// All blocks in a block row must have the same row index map and row
+/// block size, and all blocks in a block column the same column index
+/// map and column block size. Each block row and each block column must
+/// have at least one non-empty block.
+///
+/// @tparam M Sub-matrix type.
+template <class M>
+class BlockMatrixCSR
+{
+public:
+  /// Scalar type
+  using value_type = typename M::value_type;
+
+  /// @brief Create a block matrix.
+  /// @param[in] blocks Sub-matrices, `blocks[i][j]` is the block in
+  /// block row `i` and block column `j`. Empty blocks are `nullptr`.
+  BlockMatrixCSR(std::vector<std::vector<std::shared_ptr<M>>> blocks)
+      : _blocks(std::move(blocks))
+  {
+    if (_blocks.empty() or _blocks.front().empty())
+      throw std::runtime_error("BlockMatrixCSR requires at least one block.");
+
+    const std::size_t nrows = _blocks.size();
+    const std::size_t ncols = _blocks.front().size();
+    _maps[0].resize(nrows, {nullptr, 0});
+    _maps[1].resize(ncols, {nullptr, 0});
+    for (std::size_t i = 0; i < nrows; ++i)
+    {
+      if (_blocks[i].size() != ncols)
+        throw std::runtime_error("Inconsistent number of block columns.");
+      for (std::size_t j = 0; j < ncols; ++j)
+      {
+        if (!_blocks[i][j])
+          continue;
+
+        std::array<std::pair<std::shared_ptr<const common::IndexMap>, int>, 2>
+            maps = {std::pair(_blocks[i][j]->index_map(0),
+                              _blocks[i][j]->block_size()[0]),
+                    std::pair(_blocks[i][j]->index_map(1),
+                              _blocks[i][j]->block_size()[1])};
+        for (int d = 0; d < 2; ++d)
+        {
+          std::size_t k = d == 0 ? i : j;
+          if (!_maps[d][k].first)
+            _maps[d][k] = maps[d];
+          else if (_maps[d][k] != maps[d])
+          {
+            throw std::runtime_error(
+                "Incompatible index maps in block row or column.");
+          }
+        }
+      }
+    }
+
+    for (int d = 0; d < 2; ++d)
+    {
+      for (auto& [map, bs] : _maps[d])
+      {
+        if (!map)
+          throw std::runtime_error("Empty block row or column.");
+      }
+    }
+  }
+
+  /// @brief Number of block rows (0) and block columns (1).
+  std::array<std::size_t, 2> num_blocks() const
+  {
+    return {_blocks.size(), _blocks.front().size()};
+  }
+
+  /// @brief The sub-matrix in block row `i` and block column `j`.
+  /// @return The sub-matrix, or `nullptr` if the block is zero.
+  std::shared_ptr<M> block(std::size_t i, std::size_t j) const
+  {
+    return _blocks.at(i).at(j);
+  }
+
+  /// @brief Index maps and block sizes of the block rows (0) or block
+  /// columns (1).
+  ///
+  /// A la::BlockVector created from the column maps can be multiplied
+  /// by the matrix, and one created from the row maps holds the result.
+  const std::vector<std::pair<std::shared_ptr<const common::IndexMap>, int>>&
+  index_maps(int dim) const
+  {
+    return _maps.at(dim);
+  }
+
+  /// @brief Compute the product `y += A x`.
+  ///
+  /// The ghost updates of all blocks of `x` are started before the
+  /// products of the diagonal (owned column) parts of the sub-matrices
+  /// are computed, and the products of the ghost column parts are
+  /// computed once all ghost values have been received. This overlaps
+  /// the communication for all blocks with computation.
+  ///
+  /// @note MPI collective
+  /// @param[in,out] x Block vector with the layout of the block
+  /// columns. Its ghost values are updated.
+  /// @param[in,out] y Block vector with the layout of the block rows to
+  /// accumulate the result into. Only owned entries are updated.
+  template <class V>
+  void mult(BlockVector<V>& x, BlockVector<V>& y) const
+  {
+    const std::size_t nrows = _blocks.size();
+    const std::size_t ncols = _blocks.front().size();
+    if (x.num_blocks() != ncols or y.num_blocks() != nrows)
+      throw std::runtime_error("Incompatible block vector.");
+
+    for (std::size_t j = 0; j < ncols; ++j)
+      x.block(j).scatter_fwd_begin();
+
+    for (std::size_t i = 0; i < nrows; ++i)
+    {
+      for (std::size_t j = 0; j < ncols; ++j)
+      {
+        if (_blocks[i][j])
+        {
+          _blocks[i][j]->mult_local(x.block(j).array(),
+                                    y.block(i).mutable_array(), false);
+        }
+      }
+    }
+
+    for (std::size_t j = 0; j < ncols; ++j)
+      x.block(j).scatter_fwd_end();
+
+    for (std::size_t i = 0; i < nrows; ++i)
+    {
+      for (std::size_t j = 0; j < ncols; ++j)
+      {
+        if (_blocks[i][j])
+        {
+          _blocks[i][j]->mult_local(x.block(j).array(),
+                                    y.block(i).mutable_array(), true);
+        }
+      }
+    }
+  }
+
+private:
+  // Sub-matrices
+  std::vector<std::vector<std::shared_ptr<M>>> _blocks;
+
+  // Index maps and block sizes of the block rows (0) and block columns
+  // (1)
+  std::array<
+      std::vector<std::pair<std::shared_ptr<const common::IndexMap>, int>>, 2>
+      _maps;
+};
+} // namespace dolfinx::la
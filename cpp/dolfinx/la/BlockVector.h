@@ -0,0 +1,232 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed vector with a block structure, e.g. for the
+/// fields of a mixed problem.
+///
+/// Each block is a la::Vector with its own index map and block size.
+/// The blocks are stored separately, and each block can be passed to
+/// functions that operate on la::Vector, e.g. assembly of the linear
+/// form for a field or a sub-matrix product.
+///
+/// The block vector also has a concatenated (stacked) index map, see
+/// common::stack_index_maps, with block size one. In the stacked
+/// layout, the owned entries of the blocks on a rank are contiguous and
+/// in block order, and are followed by the ghost entries of each block
+/// in turn. BlockVector::copy_to and BlockVector::copy_from convert
+/// between the block vector and a la::Vector with the stacked layout,
+/// e.g. for solvers that operate on a single vector.
+///
+/// @tparam V Vector type of each block.
+template <class V>
+class BlockVector
+{
+public:
+  /// Scalar type
+  using value_type = typename V::value_type;
+
+  /// @brief Create a block vector.
+  /// @param[in] maps Index map and block size of each block. The index
+  /// maps must have the same communicator.
+  /// @note Collective MPI operation
+  explicit BlockVector(
+      const std::vector<std::pair<std::shared_ptr<const common::IndexMap>,
+                                  int>>& maps)
+  {
+    if (maps.empty())
+      throw std::runtime_error("BlockVector requires at least one block.");
+
+    std::vector<std::pair<std::reference_wrapper<const common::IndexMap>, int>>
+        _maps;
+    for (auto& [map, bs] : maps)
+    {
+      assert(map);
+      _blocks.emplace_back(map, bs);
+      _maps.emplace_back(*map, bs);
+    }
+
+    // Build the stacked index map
+    auto [rank_offset, local_offset, ghosts, owners]
+        = common::stack_index_maps(_maps);
+    std::int32_t local_size = 0;
+    std::vector<std::int64_t> ghosts_stacked;
+    std::vector<int> owners_stacked;
+    _offsets = {0};
+    _ghost_offsets = {0};
+    for (std::size_t i = 0; i < maps.size(); ++i)
+    {
+      auto& [map, bs] = maps[i];
+      local_size += bs * map->size_local();
+      _offsets.push_back(_offsets.back() + bs * map->size_local());
+      _ghost_offsets.push_back(_ghost_offsets.back() + bs * map->num_ghosts());
+      ghosts_stacked.insert(ghosts_stacked.end(), ghosts[i].begin(),
+                            ghosts[i].end());
+      owners_stacked.insert(owners_stacked.end(), owners[i].begin(),
+                            owners[i].end());
+    }
+    assert(std::ranges::equal(local_offset, _offsets));
+    _map = std::make_shared<common::IndexMap>(
+        maps.front().first->comm(), local_size, ghosts_stacked,
+        owners_stacked);
+  }
+
+  /// Number of blocks
+  std::size_t num_blocks() const { return _blocks.size(); }
+
+  /// @brief The `i`th block.
+  V& block(std::size_t i) { return _blocks.at(i); }
+
+  /// @brief The `i`th block (const version).
+  const V& block(std::size_t i) const { return _blocks.at(i); }
+
+  /// @brief Index map of the stacked layout. Its block size is one.
+  std::shared_ptr<const common::IndexMap> index_map() const { return _map; }
+
+  /// @brief Set all entries (including ghosts) of all blocks.
+  /// @param[in] v The value to set all entries to.
+  void set(value_type v)
+  {
+    for (V& b : _blocks)
+      b.set(v);
+  }
+
+  /// @brief Update the ghost entries of all blocks.
+  ///
+  /// The communication for all blocks is started before waiting for
+  /// any block.
+  /// @note Collective MPI operation
+  void scatter_fwd()
+  {
+    for (V& b : _blocks)
+      b.scatter_fwd_begin();
+    for (V& b : _blocks)
+      b.scatter_fwd_end();
+  }
+
+  /// @brief Copy the (owned and ghost) entries of the blocks into a
+  /// vector with the stacked layout.
+  /// @param[out] x Vector with index map BlockVector::index_map.
+  void copy_to(V& x) const
+  {
+    std::span<value_type> _x = x.mutable_array();
+    const std::int32_t num_owned = _offsets.back();
+    for (std::size_t i = 0; i < _blocks.size(); ++i)
+    {
+      std::span<const value_type> b = _blocks[i].array();
+      const std::int32_t n = _offsets[i + 1] - _offsets[i];
+      std::copy_n(b.begin(), n, std::next(_x.begin(), _offsets[i]));
+      std::copy(std::next(b.begin(), n), b.end(),
+                std::next(_x.begin(), num_owned + _ghost_offsets[i]));
+    }
+  }
+
+  /// @brief Copy the (owned and ghost) entries of a vector with the
+  /// stacked layout into the blocks.
+  /// @param[in] x Vector with index map BlockVector::index_map.
+  void copy_from(const V& x)
+  {
+    std::span<const value_type> _x = x.array();
+    const std::int32_t num_owned = _offsets.back();
+    for (std::size_t i = 0; i < _blocks.size(); ++i)
+    {
+      std::span<value_type> b = _blocks[i].mutable_array();
+      const std::int32_t n = _offsets[i + 1] - _offsets[i];
+      std::copy_n(std::next(_x.begin(), _offsets[i]), n, b.begin());
+      std::copy_n(
+          std::next(_x.begin(), num_owned + _ghost_offsets[i]),
+          _ghost_offsets[i + 1] - _ghost_offsets[i], std::next(b.begin(), n));
+    }
+  }
+
+private:
+  // Blocks
+  std::vector<V> _blocks;
+
+  // Stacked index map
+  std::shared_ptr<const common::IndexMap> _map;
+
+  // Offsets of the owned entries of each block in the stacked layout
+  std::vector<std::int32_t> _offsets;
+
+  // Offsets of the ghost entries of each block in the ghost part of the
+  // stacked layout
+  std::vector<std::int32_t> _ghost_offsets;
+};
+
+/// @brief Compute the inner product of two block vectors using a
+/// single global reduction.
+///
+/// The two vectors must have the same block structure and parallel
+/// layout.
+/// @note Collective MPI operation
+/// @param[in] a A block vector.
+/// @param[in] b A block vector.
+/// @return `a^{H} b` (`a^{T} b` if `a` and `b` are real).
+template <class V>
+auto inner_product(const BlockVector<V>& a, const BlockVector<V>& b)
+{
+  using T = typename V::value_type;
+  if (a.num_blocks() != b.num_blocks())
+    throw std::runtime_error("Mismatch in number of blocks.");
+  T local = 0;
+  for (std::size_t i = 0; i < a.num_blocks(); ++i)
+    local += impl::inner_product_local(a.block(i), b.block(i));
+  T result;
+  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_t<T>, MPI_SUM,
+                a.index_map()->comm());
+  return result;
+}
+
+/// @brief Compute the norm of a block vector.
+/// @note Collective MPI operation
+/// @param[in] x A block vector.
+/// @param[in] type Norm type.
+template <class V>
+auto norm(const BlockVector<V>& x, Norm type = Norm::l2)
+{
+  using U = typename dolfinx::scalar_value_type_t<typename V::value_type>;
+  switch (type)
+  {
+  case Norm::l1:
+  {
+    U l1 = 0;
+    for (std::size_t i = 0; i < x.num_blocks(); ++i)
+      l1 += la::norm(x.block(i), Norm::l1);
+    return l1;
+  }
+  case Norm::l2:
+    return U(std::sqrt(std::real(inner_product(x, x))));
+  case Norm::linf:
+  {
+    U linf = 0;
+    for (std::size_t i = 0; i < x.num_blocks(); ++i)
+      linf = std::max(linf, la::norm(x.block(i), Norm::linf));
+    return linf;
+  }
+  default:
+    throw std::runtime_error("Norm type not supported");
+  }
+}
+} // namespace dolfinx::la
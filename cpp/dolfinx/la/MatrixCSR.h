@@ -7,14 +7,28 @@
 #pragma once
 
 #include "SparsityPattern.h"
+#include "Vector.h"
 #include "matrix_csr_impl.h"
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <complex>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/load_metrics.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/memory.h>
+#include <dolfinx/common/Scatterer.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <functional>
+#include <map>
+#include <memory>
 #include <mpi.h>
 #include <numeric>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -30,6 +44,36 @@ enum class BlockMode : int
                /// matrix has a block size of (1, 1).
 };
 
+/// @brief Matrix entries removed by MatrixCSR::zero_columns.
+///
+/// The entries are used to lift a right-hand side for Dirichlet
+/// boundary conditions that are applied to an assembled matrix.
+/// @tparam T Scalar type of the entries.
+template <typename T>
+struct EliminatedEntries
+{
+  /// Local row index of each entry, unrolled by the block size
+  std::vector<std::int32_t> rows;
+
+  /// Local column index of each entry, unrolled by the block size
+  std::vector<std::int32_t> cols;
+
+  /// Value of each entry
+  std::vector<T> values;
+
+  /// @brief Compute `b <- b - alpha * A_bc g`, where `A_bc` is the
+  /// matrix of the removed entries.
+  /// @param[in,out] b Owned entries of the right-hand side.
+  /// @param[in] g Boundary values in the column layout, with up-to-date
+  /// ghost values.
+  /// @param[in] alpha Scaling factor.
+  void lift(std::span<T> b, std::span<const T> g, T alpha = 1) const
+  {
+    for (std::size_t k = 0; k < values.size(); ++k)
+      b[rows[k]] -= alpha * values[k] * g[cols[k]];
+  }
+};
+
 /// @brief Distributed sparse matrix.
 ///
 /// The matrix storage format is compressed sparse row. The matrix is
@@ -64,6 +108,13 @@ public:
   /// Row pointer container type
   using rowptr_container_type = RowPtrContainer;
 
+  /// Scalar type in which values that are added with a different
+  /// scalar type are accumulated (see MatrixCSR::mat_add_values)
+  using accumulate_type = std::conditional_t<
+      std::is_same_v<value_type, std::complex<float>>, std::complex<double>,
+      std::conditional_t<std::is_same_v<value_type, float>, double,
+                         value_type>>;
+
   static_assert(std::is_same_v<value_type, typename container_type::value_type>,
                 "Scalar type and container value type must be the same.");
 
@@ -88,9 +139,13 @@ public:
   ///
   /// @tparam BS0 Row block size of data for insertion
   /// @tparam BS1 Column block size of data for insertion
+  /// @tparam S Scalar type of the data to insert. If different from
+  /// `value_type`, the data is converted to `value_type` on insertion,
+  /// e.g. to assemble double precision element tensors into a matrix
+  /// with single precision storage.
   ///
   /// @return Function for inserting values into `A`
-  template <int BS0 = 1, int BS1 = 1>
+  template <int BS0 = 1, int BS1 = 1, typename S = value_type>
   auto mat_set_values()
   {
     if ((BS0 != _bs[0] and BS0 > 1 and _bs[0] > 1)
@@ -102,9 +157,17 @@ public:
 
     return [&](std::span<const std::int32_t> rows,
                std::span<const std::int32_t> cols,
-               std::span<const value_type> data) -> int
+               std::span<const S> data) -> int
     {
-      this->set<BS0, BS1>(data, rows, cols);
+      if constexpr (std::is_same_v<S, value_type>)
+        this->set<BS0, BS1>(data, rows, cols);
+      else
+      {
+        this->insert<BS0, BS1>(
+            _data, data, rows, cols, [](value_type& y, const S& x)
+            { y = static_cast<value_type>(x); },
+            _index_maps[0]->size_local() + _index_maps[0]->num_ghosts());
+      }
       return 0;
     };
   }
@@ -130,9 +193,17 @@ public:
   ///
   /// @tparam BS0 Row block size of data for insertion
   /// @tparam BS1 Column block size of data for insertion
+  /// @tparam S Scalar type of the data to add. If different from
+  /// `value_type`, the contributions are summed in `accumulate_type`,
+  /// e.g. to assemble double precision element tensors into a matrix
+  /// with single precision storage. The sums are kept in a separate
+  /// buffer, and are rounded and added to the matrix entries by
+  /// MatrixCSR::scatter_rev_begin, or by MatrixCSR::add_accumulated if
+  /// the reverse scatter is not needed. The buffer is kept for
+  /// subsequent assemblies.
   ///
   /// @return Function for inserting values into `A`
-  template <int BS0 = 1, int BS1 = 1>
+  template <int BS0 = 1, int BS1 = 1, typename S = value_type>
   auto mat_add_values()
   {
     if ((BS0 != _bs[0] and BS0 > 1 and _bs[0] > 1)
@@ -142,11 +213,27 @@ public:
           "Cannot insert blocks of different size than matrix block size");
     }
 
+    // The buffer is created here rather than in the returned function,
+    // which may be called concurrently by threaded assemblers
+    if constexpr (!std::is_same_v<S, value_type>)
+    {
+      if (_data_acc.empty())
+        _data_acc.resize(_data.size(), 0);
+    }
+
     return [&](std::span<const std::int32_t> rows,
                std::span<const std::int32_t> cols,
-               std::span<const value_type> data) -> int
+               std::span<const S> data) -> int
     {
-      this->add<BS0, BS1>(data, rows, cols);
+      if constexpr (std::is_same_v<S, value_type>)
+        this->add<BS0, BS1>(data, rows, cols);
+      else
+      {
+        this->insert<BS0, BS1>(_data_acc, data, rows, cols,
+                               [](accumulate_type& y, const S& x)
+                               { y += static_cast<accumulate_type>(x); },
+                               _row_ptr.size());
+      }
       return 0;
     };
   }
@@ -176,14 +263,48 @@ public:
   /// the matrix is set to (1, 1).
   MatrixCSR(const SparsityPattern& p, BlockMode mode = BlockMode::compact);
 
+  /// @brief Create a distributed matrix from compressed sparse row
+  /// data.
+  ///
+  /// This constructor is for operators whose non-zero structure is
+  /// known without a SparsityPattern, e.g. discrete operators whose
+  /// structure follows from the mesh topology. The column indices of
+  /// each row must be sorted and unique, and are local indices of the
+  /// column index map (owned and ghost). Ghost rows are allowed, and are
+  /// sent to the owning rank by scatter_rev().
+  ///
+  /// @note Collective MPI operation
+  /// @param[in] maps Index maps for the rows (0) and columns (1). The
+  /// row index maps must match the communication pattern of any ghost
+  /// rows.
+  /// @param[in] bs Block sizes for the rows (0) and columns (1). Each
+  /// entry refers to a block of `bs[0] * bs[1]` values (row-major).
+  /// @param[in] cols Column indices of the (blocked) entries of each
+  /// row.
+  /// @param[in] row_ptr Offsets into `cols` of each row, for all owned
+  /// and ghost rows of `maps[0]`.
+  /// @param[in] data Values of the entries, `size=cols.size() * bs[0] *
+  /// bs[1]`.
+  MatrixCSR(std::array<std::shared_ptr<const common::IndexMap>, 2> maps,
+            std::array<int, 2> bs, column_container_type cols,
+            rowptr_container_type row_ptr, container_type data);
+
   /// Move constructor
   /// @todo Check handling of MPI_Request
   MatrixCSR(MatrixCSR&& A) = default;
 
   /// @brief Set all non-zero local entries to a value including entries
   /// in ghost rows.
+  ///
+  /// Values accumulated in `accumulate_type` that have not yet been
+  /// added to the entries (see MatrixCSR::mat_add_values) are
+  /// discarded.
   /// @param[in] x The value to set non-zero matrix entries to
-  void set(value_type x) { std::ranges::fill(_data, x); }
+  void set(value_type x)
+  {
+    std::ranges::fill(_data, x);
+    std::ranges::fill(_data_acc, 0);
+  }
 
   /// @brief Set values in the matrix.
   ///
@@ -206,29 +327,9 @@ public:
            std::span<const std::int32_t> cols)
   {
     auto set_fn = [](value_type& y, const value_type& x) { y = x; };
-
-    std::int32_t num_rows
-        = _index_maps[0]->size_local() + _index_maps[0]->num_ghosts();
-    assert(x.size() == rows.size() * cols.size() * BS0 * BS1);
-    if (_bs[0] == BS0 and _bs[1] == BS1)
-    {
-      impl::insert_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols, set_fn,
-                                 num_rows);
-    }
-    else if (_bs[0] == 1 and _bs[1] == 1)
-    {
-      // Set blocked data in a regular CSR matrix (_bs[0]=1, _bs[1]=1)
-      // with correct sparsity
-      impl::insert_blocked_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols,
-                                         set_fn, num_rows);
-    }
-    else
-    {
-      assert(BS0 == 1 and BS1 == 1);
-      // Set non-blocked data in a blocked CSR matrix (BS0=1, BS1=1)
-      impl::insert_nonblocked_csr(_data, _cols, _row_ptr, x, rows, cols, set_fn,
-                                  num_rows, _bs[0], _bs[1]);
-    }
+    insert<BS0, BS1>(_data, x, rows, cols, set_fn,
+                     _index_maps[0]->size_local()
+                         + _index_maps[0]->num_ghosts());
   }
 
   /// @brief Accumulate values in the matrix
@@ -251,25 +352,54 @@ public:
            std::span<const std::int32_t> cols)
   {
     auto add_fn = [](value_type& y, const value_type& x) { y += x; };
+    insert<BS0, BS1>(_data, x, rows, cols, add_fn, _row_ptr.size());
+  }
+
+  /// @brief Compute the positions in values() of a dense block of
+  /// entries.
+  ///
+  /// The position of the entry `k` of a dense block `x` with the
+  /// layout used by add() is returned in `pos[k]`, i.e. `add<BS0,
+  /// BS1>(x, rows, cols)` is equivalent to `values()[pos[k]] += x[k]`
+  /// for all `k`. The positions remain valid for as long as the
+  /// sparsity of the matrix is unchanged, and can be used to insert
+  /// repeatedly into the same entries without searching for the
+  /// column indices.
+  ///
+  /// @tparam BS0 Row block size of data
+  /// @tparam BS1 Column block size of data
+  /// @param[in] rows The row indices of the dense block
+  /// @param[in] cols The column indices of the dense block
+  /// @param[out] pos Positions in values() of the entries of the dense
+  /// block (row-major). Size must be `rows.size() * cols.size() * BS0 *
+  /// BS1`.
+  template <int BS0 = 1, int BS1 = 1>
+  void value_positions(std::span<const std::int32_t> rows,
+                       std::span<const std::int32_t> cols,
+                       std::span<std::int64_t> pos) const
+  {
+    // Insert the position of each entry in the dense block
+    std::vector<std::int64_t> x(pos.size());
+    std::iota(x.begin(), x.end(), 0);
+    auto pos_fn = [&](const value_type& y, std::int64_t k)
+    { pos[k] = std::distance(_data.data(), &y); };
 
     assert(x.size() == rows.size() * cols.size() * BS0 * BS1);
     if (_bs[0] == BS0 and _bs[1] == BS1)
     {
-      impl::insert_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols, add_fn,
+      impl::insert_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols, pos_fn,
                                  _row_ptr.size());
     }
     else if (_bs[0] == 1 and _bs[1] == 1)
     {
-      // Add blocked data to a regular CSR matrix (_bs[0]=1, _bs[1]=1)
       impl::insert_blocked_csr<BS0, BS1>(_data, _cols, _row_ptr, x, rows, cols,
-                                         add_fn, _row_ptr.size());
+                                         pos_fn, _row_ptr.size());
     }
     else
     {
       assert(BS0 == 1 and BS1 == 1);
-      // Add non-blocked data to a blocked CSR matrix (BS0=1, BS1=1)
-      impl::insert_nonblocked_csr(_data, _cols, _row_ptr, x, rows, cols, add_fn,
-                                  _row_ptr.size(), _bs[0], _bs[1]);
+      impl::insert_nonblocked_csr(_data, _cols, _row_ptr, x, rows, cols,
+                                  pos_fn, _row_ptr.size(), _bs[0], _bs[1]);
     }
   }
 
@@ -302,13 +432,31 @@ public:
     scatter_rev_end();
   }
 
+  /// @brief Add the values accumulated in `accumulate_type` (see
+  /// MatrixCSR::mat_add_values) to the matrix entries, and zero the
+  /// accumulated values.
+  ///
+  /// This is called by MatrixCSR::scatter_rev_begin, and needs to be
+  /// called only if values are added without a subsequent reverse
+  /// scatter, e.g. by owner-computes assembly.
+  void add_accumulated()
+  {
+    for (std::size_t i = 0; i < _data_acc.size(); ++i)
+    {
+      _data[i] += static_cast<value_type>(_data_acc[i]);
+      _data_acc[i] = 0;
+    }
+  }
+
   /// @brief Begin transfer of ghost row data to owning ranks, where it
   /// will be accumulated into existing owned rows.
   /// @note Calls to this function must be followed by
   /// MatrixCSR::scatter_rev_end(). Between the two calls matrix values
   /// must not be changed.
-  /// @note This function does not change the matrix data. Data update
-  /// only occurs with `scatter_rev_end()`.
+  /// @note This function does not change the matrix data, except for
+  /// adding values accumulated in `accumulate_type` (see
+  /// MatrixCSR::mat_add_values). The ghost row data update only occurs
+  /// with `scatter_rev_end()`.
   void scatter_rev_begin();
 
   /// @brief End transfer of ghost row data to owning ranks.
@@ -318,10 +466,152 @@ public:
   /// zeroed.
   void scatter_rev_end();
 
+  /// @brief Enable or disable recording of communication statistics
+  /// for the ghost row scatters (MatrixCSR::scatter_rev) of this
+  /// matrix.
+  ///
+  /// Enabling resets the statistics.
+  ///
+  /// @param[in] enable Record statistics if `true`.
+  void enable_scatter_statistics(bool enable)
+  {
+    if (enable)
+      _stats.emplace();
+    else
+      _stats.reset();
+  }
+
+  /// @brief Communication statistics for the ghost row scatters of
+  /// this matrix on the calling process.
+  /// @return Statistics, or `std::nullopt` if recording is not enabled.
+  const std::optional<common::ScatterStatistics>& scatter_statistics() const
+  {
+    return _stats;
+  }
+
   /// @brief Compute the Frobenius norm squared across all processes.
+  ///
+  /// The norm is accumulated in double precision, independent of the
+  /// matrix scalar type.
+  ///
   /// @note MPI Collective
   double squared_norm() const;
 
+  /// @brief Compute the product `y += Ax`.
+  ///
+  /// The vectors `x` and `y` must have parallel layouts that are
+  /// compatible with `A`, i.e. `x` uses the column index map
+  /// (`index_map(1)`) and `y` the row index map (`index_map(0)`), with
+  /// block sizes matching the matrix block size.
+  ///
+  /// The ghost update of `x` is overlapped with the product of the
+  /// diagonal (owned column) block of `A`. Once the ghost values of
+  /// `x` are received, the off-diagonal (ghost column) block is
+  /// applied. Only owned rows of `y` are updated.
+  ///
+  /// The vectors may have a different (typically higher precision)
+  /// scalar type than the matrix, e.g. a matrix with `float` storage
+  /// can be applied to `double` vectors. The matrix entries are then
+  /// converted to the vector scalar type and the product is
+  /// accumulated in the vector scalar type.
+  ///
+  /// `x` and `y` can also be la::MultiVector, in which case the product
+  /// is computed for all vectors with a single pass over the matrix
+  /// entries (SpMM).
+  ///
+  /// @note MPI collective
+  /// @param[in,out] x Vector to apply `A` to. Its ghost values are
+  /// updated.
+  /// @param[in,out] y Vector to accumulate the result into.
+  template <class V0, class V1>
+  void mult(V0& x, V1& y);
+
+  /// @brief Compute `y += A x` for the entries of `A` in either the
+  /// owned or the ghost columns, without a ghost update of `x`.
+  ///
+  /// This is the local computation of MatrixCSR::mult. It allows the
+  /// ghost updates of several vectors to be overlapped with the
+  /// products of several matrices, e.g. for block matrices.
+  ///
+  /// @param[in] x Owned and ghost values of the vector to apply `A`
+  /// to, in the layout of the column index map. Only the owned values
+  /// are read if `ghost_columns` is false.
+  /// @param[in,out] y Owned values of the vector to accumulate the
+  /// result into.
+  /// @param[in] ghost_columns If false, apply the diagonal (owned
+  /// column) block of `A`, otherwise the off-diagonal (ghost column)
+  /// block.
+  /// @param[in] num_vectors Number of vectors stored interleaved in
+  /// `x` and `y` (see la::MultiVector).
+  template <typename S>
+  void mult_local(std::span<const S> x, std::span<S> y, bool ghost_columns,
+                  int num_vectors = 1) const;
+
+  /// @brief Compute the transpose product `y += A^T x`.
+  ///
+  /// `x` uses the row index map (`index_map(0)`) and `y` the column
+  /// index map (`index_map(1)`). The products of the owned rows of `A`
+  /// are accumulated into the owned and ghost entries of `y`, and the
+  /// ghost contributions are then added to their owners. The entries
+  /// of `A` are not conjugated.
+  ///
+  /// If `A` is the prolongation from a coarse to a fine space, this
+  /// applies the restriction operator from the fine to the coarse
+  /// space, e.g. for geometric multigrid.
+  ///
+  /// @note MPI collective
+  /// @param[in] x Vector to apply `A^T` to. Only the owned values are
+  /// read.
+  /// @param[in,out] y Vector to accumulate the result into. Its ghost
+  /// values are overwritten.
+  template <class V0, class V1>
+  void mult_transpose(const V0& x, V1& y) const;
+
+  /// @brief Zero rows of the matrix, e.g. for Dirichlet boundary
+  /// conditions on an assembled matrix.
+  ///
+  /// The cost is proportional to the number of entries in the rows.
+  ///
+  /// @param[in] rows Local row indices, unrolled by the row block size
+  /// (`bs0 * block + component`). Ghost rows are ignored, and the
+  /// matrix should be finalised (MatrixCSR::scatter_rev) before rows
+  /// are zeroed.
+  void zero_rows(std::span<const std::int32_t> rows);
+
+  /// @brief Zero the columns of a set of dofs in the owned rows, and
+  /// return the removed entries.
+  ///
+  /// Together with MatrixCSR::zero_rows and MatrixCSR::set_diagonal
+  /// this applies Dirichlet boundary conditions symmetrically to an
+  /// assembled matrix without re-assembly. The removed entries are
+  /// used to lift the right-hand side (EliminatedEntries::lift).
+  ///
+  /// The entries in owned columns are found from the rows of the dofs,
+  /// so that the cost is proportional to the number of entries in the
+  /// affected rows. Entries in ghost columns are found from the
+  /// off-diagonal blocks of the owned rows.
+  ///
+  /// @pre The row and column index maps have the same distribution, the
+  /// row and column block sizes are equal and the sparsity pattern is
+  /// structurally symmetric, as for a bilinear form with the same test
+  /// and trial space.
+  /// @param[in] dofs Local indices of the dofs in the row index map,
+  /// unrolled by the block size. Must include the ghost dofs, as for
+  /// DirichletBC::dof_indices.
+  /// @return The removed entries, with local column indices in the
+  /// column index map.
+  EliminatedEntries<value_type>
+  zero_columns(std::span<const std::int32_t> dofs);
+
+  /// @brief Set the diagonal entry of rows.
+  /// @pre The row and column block sizes are equal.
+  /// @param[in] rows Local row indices, unrolled by the row block size.
+  /// Ghost rows are ignored.
+  /// @param[in] diagonal Value to set on the diagonal.
+  /// @throws std::runtime_error if a diagonal entry is not in the
+  /// sparsity pattern.
+  void set_diagonal(std::span<const std::int32_t> rows, value_type diagonal);
+
   /// @brief Index maps for the row and column space.
   ///
   /// The row IndexMap contains ghost entries for rows which may be
@@ -366,7 +656,65 @@ public:
   /// @return block sizes for rows and columns
   std::array<int, 2> block_size() const { return _bs; }
 
+  /// @brief Memory (bytes) used by the matrix on this process, by
+  /// member.
+  ///
+  /// The storage of the ghost row communication is included. The index
+  /// maps are not included.
+  ///
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const
+  {
+    using common::container_memory;
+    return {{"values", container_memory(_data)},
+            {"accumulation", container_memory(_data_acc)},
+            {"columns", container_memory(_cols)},
+            {"row pointers", container_memory(_row_ptr)
+                                 + container_memory(_off_diagonal_offset)},
+            {"ghost rows",
+             container_memory(_ghost_value_data)
+                 + container_memory(_ghost_value_data_in)
+                 + container_memory(_unpack_pos)
+                 + container_memory(_val_send_disp)
+                 + container_memory(_val_recv_disp)
+                 + container_memory(_ghost_row_to_rank)}};
+  }
+
 private:
+  // Build the data for the reverse scatter of ghost rows. Requires the
+  // index maps, block sizes and CSR data to be set.
+  void init_scatter();
+
+  // Apply op(A_ij, x_ij) to the entries A_ij of `data` (the matrix
+  // entries or the accumulation buffer) of a dense block x with (BS0,
+  // BS1) data blocks, for any matrix block size
+  template <int BS0, int BS1, typename D, typename S, typename OP>
+  void insert(D& data, std::span<const S> x,
+              std::span<const std::int32_t> rows,
+              std::span<const std::int32_t> cols, OP op, std::int32_t num_rows)
+  {
+    assert(x.size() == rows.size() * cols.size() * BS0 * BS1);
+    if (_bs[0] == BS0 and _bs[1] == BS1)
+    {
+      impl::insert_csr<BS0, BS1>(data, _cols, _row_ptr, x, rows, cols, op,
+                                 num_rows);
+    }
+    else if (_bs[0] == 1 and _bs[1] == 1)
+    {
+      // Insert blocked data in a regular CSR matrix (_bs[0]=1,
+      // _bs[1]=1) with correct sparsity
+      impl::insert_blocked_csr<BS0, BS1>(data, _cols, _row_ptr, x, rows, cols,
+                                         op, num_rows);
+    }
+    else
+    {
+      assert(BS0 == 1 and BS1 == 1);
+      // Insert non-blocked data in a blocked CSR matrix (BS0=1, BS1=1)
+      impl::insert_nonblocked_csr(data, _cols, _row_ptr, x, rows, cols, op,
+                                  num_rows, _bs[0], _bs[1]);
+    }
+  }
+
   // Maps for the distribution of the ows and columns
   std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
 
@@ -381,6 +729,10 @@ private:
   column_container_type _cols;
   rowptr_container_type _row_ptr;
 
+  // Sums of values added with a different scalar type, which are added
+  // to _data by scatter_rev_begin (empty if not used)
+  std::vector<accumulate_type> _data_acc;
+
   // Start of off-diagonal (unowned columns) on each row
   rowptr_container_type _off_diagonal_offset;
 
@@ -406,6 +758,9 @@ private:
   // Temporary stores for data during non-blocking communication
   container_type _ghost_value_data;
   container_type _ghost_value_data_in;
+
+  // Communication statistics (std::nullopt if not recorded)
+  std::optional<common::ScatterStatistics> _stats;
 };
 //-----------------------------------------------------------------------------
 template <class U, class V, class W, class X>
@@ -484,6 +839,50 @@ MatrixCSR<U, V, W, X>::MatrixCSR(const SparsityPattern& p, BlockMode mode)
                            std::plus{});
   }
 
+  init_scatter();
+}
+//-----------------------------------------------------------------------------
+template <class U, class V, class W, class X>
+MatrixCSR<U, V, W, X>::MatrixCSR(
+    std::array<std::shared_ptr<const common::IndexMap>, 2> maps,
+    std::array<int, 2> bs, column_container_type cols,
+    rowptr_container_type row_ptr, container_type data)
+    : _index_maps(maps), _block_mode(BlockMode::compact), _bs(bs),
+      _data(std::move(data)), _cols(std::move(cols)),
+      _row_ptr(std::move(row_ptr)), _comm(MPI_COMM_NULL)
+{
+  assert(_index_maps[0] and _index_maps[1]);
+  if (_row_ptr.size()
+      != std::size_t(_index_maps[0]->size_local()
+                     + _index_maps[0]->num_ghosts() + 1))
+  {
+    throw std::runtime_error("Row offsets do not match the row index map.");
+  }
+  if (_data.size() != _cols.size() * _bs[0] * _bs[1]
+      or _row_ptr.back() != std::int64_t(_cols.size()))
+  {
+    throw std::runtime_error("Inconsistent matrix CSR data.");
+  }
+
+  // Off-diagonal (ghost column) entries follow the owned columns in
+  // each (sorted) row
+  const std::int32_t num_owned_cols = _index_maps[1]->size_local();
+  _off_diagonal_offset.reserve(_row_ptr.size() - 1);
+  for (std::size_t i = 0; i + 1 < _row_ptr.size(); ++i)
+  {
+    auto it0 = std::next(_cols.begin(), _row_ptr[i]);
+    auto it1 = std::next(_cols.begin(), _row_ptr[i + 1]);
+    assert(std::is_sorted(it0, it1));
+    _off_diagonal_offset.push_back(std::distance(
+        _cols.begin(), std::lower_bound(it0, it1, num_owned_cols)));
+  }
+
+  init_scatter();
+}
+//-----------------------------------------------------------------------------
+template <class U, class V, class W, class X>
+void MatrixCSR<U, V, W, X>::init_scatter()
+{
   // Some short-hand
   const std::array local_size
       = {_index_maps[0]->size_local(), _index_maps[1]->size_local()};
@@ -654,6 +1053,8 @@ MatrixCSR<U, V, W, X>::to_dense() const
 template <typename U, typename V, typename W, typename X>
 void MatrixCSR<U, V, W, X>::scatter_rev_begin()
 {
+  add_accumulated();
+
   const std::int32_t local_size0 = _index_maps[0]->size_local();
   const std::int32_t num_ghosts0 = _index_maps[0]->num_ghosts();
   const int bs2 = _bs[0] * _bs[1];
@@ -692,13 +1093,24 @@ void MatrixCSR<U, V, W, X>::scatter_rev_begin()
       val_recv_count.data(), _val_recv_disp.data(),
       dolfinx::MPI::mpi_t<value_type>, _comm.comm(), &_request);
   assert(status == MPI_SUCCESS);
+  if (_stats)
+    _stats->add(val_send_count, sizeof(value_type));
 }
 //-----------------------------------------------------------------------------
 template <typename U, typename V, typename W, typename X>
 void MatrixCSR<U, V, W, X>::scatter_rev_end()
 {
+  auto t0 = std::chrono::steady_clock::now();
   int status = MPI_Wait(&_request, MPI_STATUS_IGNORE);
   assert(status == MPI_SUCCESS);
+  if (_stats or common::load_metrics_enabled())
+  {
+    auto t1 = std::chrono::steady_clock::now();
+    const double t = std::chrono::duration<double>(t1 - t0).count();
+    if (_stats)
+      _stats->wait_time += t;
+    common::add_load_time(common::LoadPhase::scatter, t);
+  }
 
   _ghost_value_data.clear();
   _ghost_value_data.shrink_to_fit();
@@ -733,5 +1145,238 @@ double MatrixCSR<U, V, W, X>::squared_norm() const
   return norm_sq;
 }
 //-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+template <class V0, class V1>
+void MatrixCSR<U, V, W, X>::mult(V0& x, V1& y)
+{
+  using S = typename V1::value_type;
+  static_assert(std::is_same_v<typename V0::value_type, S>);
+  assert(x.bs() == _bs[1]);
+  assert(y.bs() == _bs[0]);
+
+  // Number of vectors of a multi-vector
+  int nv = 1;
+  if constexpr (requires { x.num_vectors(); })
+  {
+    nv = x.num_vectors();
+    if (y.num_vectors() != nv)
+      throw std::runtime_error("Mismatch in number of vectors.");
+  }
+
+  // Start ghost update of x
+  x.scatter_fwd_begin();
+
+  // Diagonal block (owned columns): y[0] += A[0] x[0]. Only the owned
+  // part of x is read while the ghost values are in transit.
+  mult_local(x.array(), y.mutable_array(), false, nv);
+
+  // Complete ghost update of x
+  x.scatter_fwd_end();
+
+  // Off-diagonal block (ghost columns): y[0] += A[1] x[1]
+  mult_local(x.array(), y.mutable_array(), true, nv);
+}
+//-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+template <typename S>
+void MatrixCSR<U, V, W, X>::mult_local(std::span<const S> x, std::span<S> y,
+                                       bool ghost_columns,
+                                       int num_vectors) const
+{
+  const std::int32_t nrows = num_owned_rows();
+  std::span<const std::int64_t> row_begin(_row_ptr.data(), nrows);
+  std::span<const std::int64_t> row_end(_row_ptr.data() + 1, nrows);
+  std::span<const std::int64_t> off_diag(_off_diagonal_offset.data(), nrows);
+  std::span<const std::int32_t> cols(_cols.data(), _cols.size());
+  std::span<const value_type> values(_data.data(), _data.size());
+  std::span<const std::int64_t> begin = ghost_columns ? off_diag : row_begin;
+  std::span<const std::int64_t> end = ghost_columns ? row_end : off_diag;
+  if (num_vectors > 1)
+    impl::spmm(values, begin, end, cols, x, y, _bs[0], _bs[1], num_vectors);
+  else if (_bs[1] == 1)
+    impl::spmv<1>(values, begin, end, cols, x, y, _bs[0], 1);
+  else
+    impl::spmv<-1>(values, begin, end, cols, x, y, _bs[0], _bs[1]);
+}
+//-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+template <class V0, class V1>
+void MatrixCSR<U, V, W, X>::mult_transpose(const V0& x, V1& y) const
+{
+  using S = typename V1::value_type;
+  static_assert(std::is_same_v<typename V0::value_type, S>);
+  assert(x.bs() == _bs[0]);
+  assert(y.bs() == _bs[1]);
+
+  // Ghost entries of y accumulate contributions for other ranks
+  std::span<S> _y = y.mutable_array();
+  std::fill(std::next(_y.begin(), _bs[1] * _index_maps[1]->size_local()),
+            _y.end(), S(0));
+
+  std::span<const S> _x = x.array();
+  const int bs0 = _bs[0];
+  const int bs1 = _bs[1];
+  for (std::int32_t i = 0; i < num_owned_rows(); ++i)
+  {
+    for (std::int64_t k = _row_ptr[i]; k < _row_ptr[i + 1]; ++k)
+    {
+      for (int k0 = 0; k0 < bs0; ++k0)
+      {
+        const S xi = _x[i * bs0 + k0];
+        for (int k1 = 0; k1 < bs1; ++k1)
+        {
+          _y[_cols[k] * bs1 + k1]
+              += static_cast<S>(_data[(k * bs0 + k0) * bs1 + k1]) * xi;
+        }
+      }
+    }
+  }
+
+  y.scatter_rev(std::plus<S>());
+}
+//-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+void MatrixCSR<U, V, W, X>::zero_rows(std::span<const std::int32_t> rows)
+{
+  const int bs0 = _bs[0];
+  const int bs1 = _bs[1];
+  const std::int32_t num_rows = num_owned_rows();
+  for (std::int32_t r : rows)
+  {
+    const std::int32_t i = r / bs0;
+    const int k0 = r % bs0;
+    if (i >= num_rows)
+      continue;
+    for (std::int64_t k = _row_ptr[i]; k < _row_ptr[i + 1]; ++k)
+    {
+      std::fill_n(std::next(_data.begin(), (k * bs0 + k0) * bs1), bs1,
+                  value_type(0));
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+EliminatedEntries<typename MatrixCSR<U, V, W, X>::value_type>
+MatrixCSR<U, V, W, X>::zero_columns(std::span<const std::int32_t> dofs)
+{
+  const int bs0 = _bs[0];
+  const int bs1 = _bs[1];
+  if (bs0 != bs1)
+    throw std::runtime_error("Row and column block sizes must be equal.");
+  const std::int32_t num_rows = num_owned_rows();
+  if (_index_maps[1]->size_local() != num_rows)
+  {
+    throw std::runtime_error(
+        "Row and column index maps must have the same distribution.");
+  }
+
+  // Split the dofs into owned dofs and ghost columns
+  std::vector<std::int32_t> owned, ghosts;
+  {
+    std::vector<std::int64_t> ghost_rows;
+    std::vector<int> ghost_comps;
+    for (std::int32_t d : dofs)
+    {
+      if (d / bs0 < num_rows)
+        owned.push_back(d);
+      else
+      {
+        ghost_rows.push_back(d / bs0);
+        ghost_comps.push_back(d % bs0);
+      }
+    }
+
+    // Ghost rows -> global -> local column index
+    std::vector<std::int32_t> ghost_local(ghost_rows.begin(),
+                                          ghost_rows.end());
+    _index_maps[0]->local_to_global(ghost_local, ghost_rows);
+    _index_maps[1]->global_to_local(ghost_rows, ghost_local);
+    for (std::size_t i = 0; i < ghost_local.size(); ++i)
+    {
+      // Ghost dofs that are not a column of the owned rows do not
+      // couple to them
+      if (ghost_local[i] >= 0)
+        ghosts.push_back(ghost_local[i] * bs1 + ghost_comps[i]);
+    }
+  }
+  std::ranges::sort(owned);
+  owned.erase(std::unique(owned.begin(), owned.end()), owned.end());
+  std::ranges::sort(ghosts);
+  ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+
+  EliminatedEntries<value_type> removed;
+  auto remove = [&](std::int32_t i, std::int64_t k,
+                    const std::vector<std::int32_t>& bc_cols)
+  {
+    for (int k1 = 0; k1 < bs1; ++k1)
+    {
+      const std::int32_t col = _cols[k] * bs1 + k1;
+      if (std::ranges::binary_search(bc_cols, col))
+      {
+        for (int k0 = 0; k0 < bs0; ++k0)
+        {
+          value_type& v = _data[(k * bs0 + k0) * bs1 + k1];
+          removed.rows.push_back(i * bs0 + k0);
+          removed.cols.push_back(col);
+          removed.values.push_back(v);
+          v = 0;
+        }
+      }
+    }
+  };
+
+  // Owned rows with an entry in an owned dof column are, by symmetry,
+  // the owned columns of the rows of the owned dofs
+  std::vector<std::int32_t> rows;
+  for (std::int32_t d : owned)
+  {
+    const std::int32_t i = d / bs0;
+    for (std::int64_t k = _row_ptr[i]; k < _off_diagonal_offset[i]; ++k)
+      rows.push_back(_cols[k]);
+  }
+  std::ranges::sort(rows);
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  for (std::int32_t i : rows)
+    for (std::int64_t k = _row_ptr[i]; k < _off_diagonal_offset[i]; ++k)
+      remove(i, k, owned);
+
+  // Ghost dof columns are in the off-diagonal blocks
+  if (!ghosts.empty())
+  {
+    for (std::int32_t i = 0; i < num_rows; ++i)
+      for (std::int64_t k = _off_diagonal_offset[i]; k < _row_ptr[i + 1]; ++k)
+        remove(i, k, ghosts);
+  }
+
+  return removed;
+}
+//-----------------------------------------------------------------------------
+template <typename U, typename V, typename W, typename X>
+void MatrixCSR<U, V, W, X>::set_diagonal(std::span<const std::int32_t> rows,
+                                         value_type diagonal)
+{
+  const int bs0 = _bs[0];
+  const int bs1 = _bs[1];
+  if (bs0 != bs1)
+    throw std::runtime_error("Row and column block sizes must be equal.");
+  const std::int32_t num_rows = num_owned_rows();
+  for (std::int32_t r : rows)
+  {
+    const std::int32_t i = r / bs0;
+    const int k0 = r % bs0;
+    if (i >= num_rows)
+      continue;
+
+    // Owned rows and columns have the same local index
+    auto it0 = std::next(_cols.begin(), _row_ptr[i]);
+    auto it1 = std::next(_cols.begin(), _off_diagonal_offset[i]);
+    auto it = std::find(it0, it1, i);
+    if (it == it1)
+      throw std::runtime_error("Diagonal entry is not in sparsity pattern.");
+    const std::int64_t k = std::distance(_cols.begin(), it);
+    _data[(k * bs0 + k0) * bs1 + k0] = diagonal;
+  }
+}
+//-----------------------------------------------------------------------------
 
 } // namespace dolfinx::la
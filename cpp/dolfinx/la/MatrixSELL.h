@@ -0,0 +1,308 @@
+// Copyright (C) 2024 Chris N. Richardson and Igor A. Baratta
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dolfinx::la
+{
+namespace impl
+{
+/// @brief Part of a matrix in SELL-C-sigma storage.
+///
+/// Rows are grouped into chunks of `C` rows. The entries of a chunk
+/// are stored column-major, i.e. the `j`th entry of each row in the
+/// chunk are contiguous, and rows that are shorter than the longest row
+/// in the chunk are padded with zeros. Column indices are stored
+/// relative to the smallest column index in the chunk, which allows
+/// compact (e.g. 16-bit) index types.
+///
+/// @tparam T Scalar type
+/// @tparam C Chunk size (number of rows per chunk)
+/// @tparam I Column index type
+template <typename T, int C, typename I>
+struct SellBlock
+{
+  /// Position of the first entry of each chunk, with an extra entry
+  /// for the end of the last chunk
+  std::vector<std::int64_t> chunk_ptr;
+
+  /// Smallest column index in each chunk
+  std::vector<std::int32_t> chunk_base;
+
+  /// Column indices, relative to chunk_base
+  std::vector<I> cols;
+
+  /// Matrix entries
+  std::vector<T> values;
+};
+
+/// @brief Build a SELL-C-sigma block from a range of entries in each
+/// row of a CSR matrix.
+/// @param[in] perm Row permutation. `perm[k]` is the row stored in
+/// position `k`, and its size is a multiple of C. Padding rows are -1.
+/// @param[in] values CSR matrix entries.
+/// @param[in] cols CSR column indices.
+/// @param[in] row_begin First entry of each row to include.
+/// @param[in] row_end One past the last entry of each row to include.
+template <typename I, int C, typename T>
+SellBlock<T, C, I> create_sell_block(std::span<const std::int32_t> perm,
+                                      std::span<const T> values,
+                                      std::span<const std::int32_t> cols,
+                                      std::span<const std::int64_t> row_begin,
+                                      std::span<const std::int64_t> row_end)
+{
+  const std::size_t num_chunks = perm.size() / C;
+  SellBlock<T, C, I> block;
+  block.chunk_ptr.resize(num_chunks + 1, 0);
+  block.chunk_base.resize(num_chunks, 0);
+  for (std::size_t k = 0; k < num_chunks; ++k)
+  {
+    std::int64_t width = 0;
+    std::int32_t cmin = std::numeric_limits<std::int32_t>::max(), cmax = 0;
+    for (int r = 0; r < C; ++r)
+    {
+      if (std::int32_t row = perm[k * C + r]; row >= 0)
+      {
+        width = std::max(width, row_end[row] - row_begin[row]);
+        for (std::int64_t j = row_begin[row]; j < row_end[row]; ++j)
+        {
+          cmin = std::min(cmin, cols[j]);
+          cmax = std::max(cmax, cols[j]);
+        }
+      }
+    }
+
+    if (width > 0)
+    {
+      if (std::int64_t(cmax) - cmin > std::numeric_limits<I>::max())
+      {
+        throw std::runtime_error(
+            "Column index range of chunk exceeds column index type.");
+      }
+      block.chunk_base[k] = cmin;
+    }
+    block.chunk_ptr[k + 1] = block.chunk_ptr[k] + width * C;
+  }
+
+  block.cols.resize(block.chunk_ptr.back(), 0);
+  block.values.resize(block.chunk_ptr.back(), 0);
+  for (std::size_t k = 0; k < num_chunks; ++k)
+  {
+    for (int r = 0; r < C; ++r)
+    {
+      if (std::int32_t row = perm[k * C + r]; row >= 0)
+      {
+        std::int64_t pos = block.chunk_ptr[k] + r;
+        for (std::int64_t j = row_begin[row]; j < row_end[row]; ++j, pos += C)
+        {
+          block.cols[pos] = cols[j] - block.chunk_base[k];
+          block.values[pos] = values[j];
+        }
+      }
+    }
+  }
+
+  return block;
+}
+
+/// @brief Compute `y += A x` for a SELL-C-sigma block.
+/// @param[in] block Matrix block.
+/// @param[in] perm Row permutation.
+/// @param[in] x Input vector.
+/// @param[in,out] y Vector to accumulate the product into.
+template <typename T, int C, typename I, typename S>
+void spmv(const SellBlock<T, C, I>& block, std::span<const std::int32_t> perm,
+          std::span<const S> x, std::span<S> y)
+{
+  std::span<const std::int64_t> chunk_ptr(block.chunk_ptr);
+  std::span<const std::int32_t> chunk_base(block.chunk_base);
+  std::span<const I> cols(block.cols);
+  std::span<const T> values(block.values);
+  for_each_index(
+      chunk_base.size(),
+      [chunk_ptr, chunk_base, cols, values, perm, x, y](std::size_t k)
+      {
+        // The loop over the rows of the chunk has unit stride and no
+        // dependencies, and can be vectorized
+        std::array<S, C> acc;
+        acc.fill(0);
+        const S* xk = x.data() + chunk_base[k];
+        for (std::int64_t j = chunk_ptr[k]; j < chunk_ptr[k + 1]; j += C)
+        {
+          for (int r = 0; r < C; ++r)
+            acc[r] += static_cast<S>(values[j + r]) * xk[cols[j + r]];
+        }
+
+        for (int r = 0; r < C; ++r)
+        {
+          if (std::int32_t row = perm[k * C + r]; row >= 0)
+            y[row] += acc[r];
+        }
+      });
+}
+} // namespace impl
+
+/// @brief Distributed sparse matrix in SELL-C-sigma storage.
+///
+/// SELL-C-sigma (Kreutzer et al., 2014) stores the rows of a sparse
+/// matrix in chunks of `C` rows, with the entries of each chunk stored
+/// column-major. Rows are sorted by length within windows of `sigma`
+/// rows to reduce the zero padding. The format allows the
+/// matrix-vector product to be vectorized across the rows of a chunk,
+/// and does not require a row pointer for each row.
+///
+/// Column indices are stored relative to the smallest column index in
+/// each chunk. With a compact column index type `I`, e.g.
+/// `std::uint16_t`, this reduces the index memory traffic compared to
+/// la::MatrixCSR when the columns of each chunk are close together,
+/// e.g. with a bandwidth-reducing dof ordering.
+///
+/// The matrix is created from an assembled la::MatrixCSR, and is
+/// intended for repeated application with mult(). Only owned rows are
+/// stored.
+///
+/// @tparam T Scalar type
+/// @tparam C Chunk size. Typically the SIMD width.
+/// @tparam I Column index type
+template <typename T, int C = 8, typename I = std::int32_t>
+class MatrixSELL
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Column index type
+  using column_index_type = I;
+
+  /// @brief Create a SELL-C-sigma matrix from a CSR matrix.
+  ///
+  /// @note The values of `A` are copied. Later changes to `A` are not
+  /// reflected.
+  ///
+  /// @param[in] A Matrix with block size one (a blocked matrix must
+  /// be created with la::BlockMode::expanded). Its values are
+  /// converted to `T`.
+  /// @param[in] sigma Sorting window (number of rows). Rows are sorted
+  /// by decreasing length within each window. Must be a multiple of
+  /// `C`, or one for no sorting.
+  template <class Mat>
+  explicit MatrixSELL(const Mat& A, int sigma = C)
+      : _index_maps({A.index_map(0), A.index_map(1)})
+  {
+    if (A.block_size()[0] != 1 or A.block_size()[1] != 1)
+    {
+      throw std::runtime_error(
+          "MatrixSELL requires a matrix with block size 1.");
+    }
+    if (sigma != 1 and sigma % C != 0)
+      throw std::runtime_error("Sorting window must be a multiple of C.");
+
+    const std::int32_t num_rows = A.num_owned_rows();
+    std::span<const std::int64_t> row_ptr(A.row_ptr());
+    std::span<const std::int64_t> row_begin = row_ptr.first(num_rows);
+    std::span<const std::int64_t> row_end = row_ptr.subspan(1, num_rows);
+    std::span<const std::int64_t> off_diag(A.off_diag_offset().data(),
+                                           num_rows);
+
+    // Sort rows by length within windows
+    std::vector<std::int32_t> rows(num_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    if (sigma > 1)
+    {
+      for (std::int32_t w = 0; w < num_rows; w += sigma)
+      {
+        auto it0 = std::next(rows.begin(), w);
+        auto it1 = std::next(rows.begin(), std::min(w + sigma, num_rows));
+        std::stable_sort(it0, it1,
+                         [row_begin, row_end](auto r0, auto r1)
+                         {
+                           return row_end[r0] - row_begin[r0]
+                                  > row_end[r1] - row_begin[r1];
+                         });
+      }
+    }
+    _perm.resize(((num_rows + C - 1) / C) * C, -1);
+    std::ranges::copy(rows, _perm.begin());
+
+    // Convert values to T
+    std::vector<T> values(A.values().begin(), A.values().end());
+    std::span<const std::int32_t> cols(A.cols());
+    _diag = impl::create_sell_block<I, C, T>(_perm, values, cols, row_begin,
+                                             off_diag);
+    _off_diag = impl::create_sell_block<I, C, T>(_perm, values, cols,
+                                                 off_diag, row_end);
+  }
+
+  /// @brief Compute the product `y += Ax`.
+  ///
+  /// See la::MatrixCSR::mult. The ghost update of `x` is overlapped
+  /// with the product of the diagonal block, and only owned rows of
+  /// `y` are updated. The vectors may have a different scalar type
+  /// than the matrix, in which case the product is accumulated in the
+  /// vector scalar type.
+  ///
+  /// @note MPI collective
+  /// @param[in,out] x Vector to apply `A` to. Its ghost values are
+  /// updated.
+  /// @param[in,out] y Vector to accumulate the result into.
+  template <class V0, class V1>
+  void mult(V0& x, V1& y) const
+  {
+    using S = typename V1::value_type;
+    static_assert(std::is_same_v<typename V0::value_type, S>);
+    assert(x.bs() == 1);
+    assert(y.bs() == 1);
+
+    x.scatter_fwd_begin();
+    impl::spmv(_diag, std::span<const std::int32_t>(_perm),
+               std::span<const S>(x.array()), y.mutable_array());
+    x.scatter_fwd_end();
+    impl::spmv(_off_diag, std::span<const std::int32_t>(_perm),
+               std::span<const S>(x.array()), y.mutable_array());
+  }
+
+  /// @brief Index maps for the row and column space.
+  /// @return Row (0) or column (1) index maps
+  std::shared_ptr<const common::IndexMap> index_map(int dim) const
+  {
+    return _index_maps.at(dim);
+  }
+
+  /// Number of local rows excluding ghost rows
+  std::int32_t num_owned_rows() const { return _index_maps[0]->size_local(); }
+
+  /// @brief Number of stored entries, including padding.
+  std::size_t num_stored() const
+  {
+    return _diag.values.size() + _off_diag.values.size();
+  }
+
+private:
+  // Maps for the distribution of the rows and columns
+  std::array<std::shared_ptr<const common::IndexMap>, 2> _index_maps;
+
+  // Row permutation, padded with -1 to a multiple of C
+  std::vector<std::int32_t> _perm;
+
+  // Diagonal (owned columns) and off-diagonal (ghost columns) blocks
+  impl::SellBlock<T, C, I> _diag, _off_diag;
+};
+
+} // namespace dolfinx::la
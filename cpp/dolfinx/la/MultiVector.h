@@ -0,0 +1,238 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include <complex>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Distributed block of vectors with the same parallel layout.
+///
+/// A multi-vector stores `k` vectors that share an index map and block
+/// size, interleaved row-major: entry `i` of vector `v` is
+/// `array()[i * k + v]`. This is the layout for block Krylov methods,
+/// eigensolvers and problems with multiple right-hand sides:
+///
+/// - Ghost updates exchange the entries of all vectors with a single
+///   message per neighbour, using one common::Scatterer with block size
+///   `bs * k`.
+/// - MatrixCSR::mult computes the product of a matrix with all vectors
+///   in one pass over the matrix entries (SpMM), so that each matrix
+///   entry that is loaded from memory is used `k` times.
+/// - la::inner_product_block computes the `k x k` inner products of two
+///   multi-vectors with a single global reduction.
+///
+/// @note The functions for la::Vector (e.g. la::norm, la::axpy) do not
+/// support multi-vectors.
+///
+/// @tparam T Scalar type
+/// @tparam Container data container type
+template <typename T, typename Container = std::vector<T>>
+class MultiVector
+{
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// Container type
+  using container_type = Container;
+
+  /// @brief Create a distributed multi-vector.
+  /// @param[in] map IndexMap for parallel distribution of the data.
+  /// @param[in] bs Block size of each vector.
+  /// @param[in] num_vectors Number of vectors.
+  /// @param[in] scatter_type Type of MPI communication used for ghost
+  /// updates (see la::Vector).
+  MultiVector(std::shared_ptr<const common::IndexMap> map, int bs,
+              int num_vectors,
+              common::Scatterer<>::type scatter_type
+              = common::Scatterer<>::type::neighbor)
+      : _num_vectors(num_vectors), _bs(bs),
+        _x(map, bs * num_vectors, scatter_type)
+  {
+    if (num_vectors < 1)
+      throw std::runtime_error("A multi-vector requires at least one vector.");
+  }
+
+  /// Set all entries (including ghosts)
+  /// @param[in] v The value to set all entries to (on calling rank)
+  void set(value_type v) { _x.set(v); }
+
+  /// Begin scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_begin() { _x.scatter_fwd_begin(); }
+
+  /// End scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_end() { _x.scatter_fwd_end(); }
+
+  /// Scatter local data to ghost positions on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd() { _x.scatter_fwd(); }
+
+  /// Start scatter of ghost data to owner
+  /// @note Collective MPI operation
+  void scatter_rev_begin() { _x.scatter_rev_begin(); }
+
+  /// End scatter of ghost data to owner
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev_end(BinaryOperation op)
+  {
+    _x.scatter_rev_end(op);
+  }
+
+  /// Scatter ghost data to owner
+  /// @param op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev(BinaryOperation op)
+  {
+    _x.scatter_rev(op);
+  }
+
+  /// Get IndexMap
+  std::shared_ptr<const common::IndexMap> index_map() const
+  {
+    return _x.index_map();
+  }
+
+  /// Get block size of each vector
+  constexpr int bs() const { return _bs; }
+
+  /// Get number of vectors
+  constexpr int num_vectors() const { return _num_vectors; }
+
+  /// Get local part (owned and ghost entries) of the interleaved
+  /// vectors (const version)
+  std::span<const value_type> array() const { return _x.array(); }
+
+  /// Get local part (owned and ghost entries) of the interleaved
+  /// vectors
+  std::span<value_type> mutable_array() { return _x.mutable_array(); }
+
+  /// @brief Copy the entries (owned and ghost) of a vector of the
+  /// multi-vector to a vector.
+  /// @param[in] v Index of the vector.
+  /// @param[out] y Vector to copy to. Must have the index map and block
+  /// size of the multi-vector.
+  void copy_to(int v, Vector<T, Container>& y) const
+  {
+    std::span<const T> x = array();
+    std::span<T> _y = y.mutable_array();
+    if (_y.size() * _num_vectors != x.size())
+      throw std::runtime_error("Incompatible vector size.");
+    for (std::size_t i = 0; i < _y.size(); ++i)
+      _y[i] = x[i * _num_vectors + v];
+  }
+
+  /// @brief Copy the entries (owned and ghost) of a vector into a
+  /// vector of the multi-vector.
+  /// @param[in] v Index of the vector.
+  /// @param[in] y Vector to copy from. Must have the index map and
+  /// block size of the multi-vector.
+  void copy_from(int v, const Vector<T, Container>& y)
+  {
+    std::span<T> x = mutable_array();
+    std::span<const T> _y = y.array();
+    if (_y.size() * _num_vectors != x.size())
+      throw std::runtime_error("Incompatible vector size.");
+    for (std::size_t i = 0; i < _y.size(); ++i)
+      x[i * _num_vectors + v] = _y[i];
+  }
+
+private:
+  // Number of vectors
+  int _num_vectors;
+
+  // Block size of each vector
+  int _bs;
+
+  // Interleaved data of all vectors, with block size _bs * _num_vectors
+  Vector<T, Container> _x;
+};
+
+namespace impl
+{
+/// @brief Compute the contribution of the owned entries on the calling
+/// rank to the block inner product `a^{H} b` of two multi-vectors.
+/// @note Not collective. The local contributions must be summed over
+/// all ranks to obtain the inner products.
+/// @param[in] a A multi-vector with `m` vectors.
+/// @param[in] b A multi-vector with `n` vectors and the same parallel
+/// layout as `a`.
+/// @return Row-major `(m, n)` matrix of the local contributions.
+template <class MV>
+std::vector<typename MV::value_type> inner_product_block_local(const MV& a,
+                                                               const MV& b)
+{
+  using T = typename MV::value_type;
+  const std::int32_t local_size = a.bs() * a.index_map()->size_local();
+  if (local_size != b.bs() * b.index_map()->size_local())
+    throw std::runtime_error("Incompatible vector sizes");
+
+  const int m = a.num_vectors();
+  const int n = b.num_vectors();
+  std::span<const T> x_a = a.array();
+  std::span<const T> x_b = b.array();
+  std::vector<T> dots(m * n, 0);
+  for (std::int32_t r = 0; r < local_size; ++r)
+  {
+    const T* ar = x_a.data() + r * m;
+    const T* br = x_b.data() + r * n;
+    for (int i = 0; i < m; ++i)
+    {
+      T ai = ar[i];
+      if constexpr (std::is_same_v<T, std::complex<double>>
+                    or std::is_same_v<T, std::complex<float>>)
+      {
+        ai = std::conj(ai);
+      }
+      for (int j = 0; j < n; ++j)
+        dots[i * n + j] += ai * br[j];
+    }
+  }
+
+  return dots;
+}
+} // namespace impl
+
+/// @brief Compute the block inner product `a^{H} b` of two
+/// multi-vectors using a single global reduction.
+///
+/// @note Collective MPI operation
+/// @param[in] a A multi-vector with `m` vectors.
+/// @param[in] b A multi-vector with `n` vectors and the same parallel
+/// layout as `a`.
+/// @return Row-major `(m, n)` matrix of the inner products `a_i^{H}
+/// b_j`.
+template <class MV>
+std::vector<typename MV::value_type> inner_product_block(const MV& a,
+                                                         const MV& b)
+{
+  using T = typename MV::value_type;
+  std::vector<T> dots = impl::inner_product_block_local(a, b);
+  MPI_Allreduce(MPI_IN_PLACE, dots.data(), dots.size(),
+                dolfinx::MPI::mpi_t<T>, MPI_SUM, a.index_map()->comm());
+  return dots;
+}
+
+} // namespace dolfinx::la
@@ -0,0 +1,235 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Scatterer.h>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Ghost updates of several vectors that share an index map
+/// with a single set of messages.
+///
+/// Coupled problems often keep several fields (e.g. velocity
+/// components and scalars) in separate vectors with the same index
+/// map. Updating the ghosts of each vector sends one message per
+/// neighbour and vector. A scatter group packs the ghost data of all
+/// vectors, with possibly different block sizes, into one buffer and
+/// uses a common::Scatterer with the total block size, so that the
+/// number of messages does not depend on the number of vectors.
+///
+/// The communication can be overlapped with computation with the
+/// `begin`/`end` pairs of functions. The data of the vectors must not
+/// be changed between `begin` and `end`.
+///
+/// The data can be communicated in a lower precision than the scalar
+/// type of the vectors (e.g. `float` for `double` vectors), which
+/// halves the communication volume of bandwidth-bound ghost updates.
+/// The conversion is lossy, so this suits vectors where the ghost
+/// values are only approximately required, e.g. in preconditioners. A
+/// group can contain a single vector.
+///
+/// @tparam V Vector type (e.g. la::Vector).
+/// @tparam U Scalar type used for the communication.
+template <class V, typename U = typename V::value_type>
+class ScatterGroup
+{
+public:
+  /// Scalar type
+  using value_type = typename V::value_type;
+
+  /// Scalar type of the communicated data
+  using buffer_value_type = U;
+
+  /// @brief Create a scatter group.
+  /// @param[in] x Vectors of the group. All vectors must have the same
+  /// index map. The vectors must outlive the group.
+  /// @param[in] type Type of MPI communication, either
+  /// common::Scatterer<>::type::neighbor or
+  /// common::Scatterer<>::type::p2p.
+  explicit ScatterGroup(std::vector<std::reference_wrapper<V>> x,
+                        common::Scatterer<>::type type
+                        = common::Scatterer<>::type::neighbor)
+      : _x(x), _offsets(1, 0), _type(type)
+  {
+    if (_x.empty())
+      throw std::runtime_error("A scatter group requires a vector.");
+    if (type != common::Scatterer<>::type::neighbor
+        and type != common::Scatterer<>::type::p2p)
+    {
+      throw std::runtime_error("Scatter type not supported by group.");
+    }
+
+    _map = _x.front().get().index_map();
+    for (V& xi : _x)
+    {
+      if (xi.index_map() != _map)
+        throw std::runtime_error("Vectors must have the same index map.");
+      _offsets.push_back(_offsets.back() + xi.bs());
+    }
+
+    _scatterer
+        = std::make_shared<common::Scatterer<>>(*_map, _offsets.back());
+    _buffer_local.resize(_scatterer->local_buffer_size());
+    _buffer_remote.resize(_scatterer->remote_buffer_size());
+    _request = _scatterer->create_request_vector(_type);
+  }
+
+  /// @brief Begin scatter of owned data to ghosts of all vectors.
+  /// @note Collective MPI operation
+  void scatter_fwd_begin()
+  {
+    // Pack the owned data of each vector at the offset of the vector
+    // in the block of each index
+    const int bs = _offsets.back();
+    const std::vector<std::int32_t>& idx = _scatterer->local_indices();
+    for (std::size_t k = 0; k < _x.size(); ++k)
+    {
+      std::span<const value_type> x = _x[k].get().array();
+      const int bs_k = _offsets[k + 1] - _offsets[k];
+      for (std::size_t j = 0; j < idx.size(); j += bs)
+      {
+        const std::int32_t node = idx[j] / bs;
+        for (int c = 0; c < bs_k; ++c)
+          _buffer_local[j + _offsets[k] + c] = U(x[node * bs_k + c]);
+      }
+    }
+
+    _scatterer->scatter_fwd_begin(std::span<const U>(_buffer_local),
+                                  std::span<U>(_buffer_remote),
+                                  std::span(_request), _type);
+  }
+
+  /// @brief End scatter of owned data to ghosts of all vectors.
+  /// @note Collective MPI operation
+  void scatter_fwd_end()
+  {
+    _scatterer->scatter_fwd_end(std::span(_request));
+
+    // Ghost indices are unique, so ghost values are copied directly
+    const int bs = _offsets.back();
+    const std::int32_t size_local = _map->size_local();
+    const std::vector<std::int32_t>& idx = _scatterer->remote_indices();
+    for (std::size_t k = 0; k < _x.size(); ++k)
+    {
+      std::span<value_type> x = _x[k].get().mutable_array();
+      const int bs_k = _offsets[k + 1] - _offsets[k];
+      for (std::size_t j = 0; j < idx.size(); j += bs)
+      {
+        const std::int32_t node = size_local + idx[j] / bs;
+        for (int c = 0; c < bs_k; ++c)
+          x[node * bs_k + c] = value_type(_buffer_remote[j + _offsets[k] + c]);
+      }
+    }
+  }
+
+  /// @brief Scatter owned data to ghosts of all vectors.
+  /// @note Collective MPI operation
+  void scatter_fwd()
+  {
+    scatter_fwd_begin();
+    scatter_fwd_end();
+  }
+
+  /// @brief Begin scatter of ghost data to owners of all vectors.
+  /// @note Collective MPI operation
+  void scatter_rev_begin()
+  {
+    const int bs = _offsets.back();
+    const std::int32_t size_local = _map->size_local();
+    const std::vector<std::int32_t>& idx = _scatterer->remote_indices();
+    for (std::size_t k = 0; k < _x.size(); ++k)
+    {
+      std::span<const value_type> x = _x[k].get().array();
+      const int bs_k = _offsets[k + 1] - _offsets[k];
+      for (std::size_t j = 0; j < idx.size(); j += bs)
+      {
+        const std::int32_t node = size_local + idx[j] / bs;
+        for (int c = 0; c < bs_k; ++c)
+          _buffer_remote[j + _offsets[k] + c] = U(x[node * bs_k + c]);
+      }
+    }
+
+    _scatterer->scatter_rev_begin(std::span<const U>(_buffer_remote),
+                                  std::span<U>(_buffer_local),
+                                  std::span(_request), _type);
+  }
+
+  /// @brief End scatter of ghost data to owners of all vectors.
+  /// @param[in] op The operation to combine received values with owned
+  /// values (e.g. add or insert).
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev_end(BinaryOperation op)
+  {
+    _scatterer->scatter_rev_end(std::span(_request));
+
+    // An owned index may be ghosted on more than one rank, so received
+    // values are accumulated sequentially
+    const int bs = _offsets.back();
+    const std::vector<std::int32_t>& idx = _scatterer->local_indices();
+    for (std::size_t k = 0; k < _x.size(); ++k)
+    {
+      std::span<value_type> x = _x[k].get().mutable_array();
+      const int bs_k = _offsets[k + 1] - _offsets[k];
+      for (std::size_t j = 0; j < idx.size(); j += bs)
+      {
+        const std::int32_t node = idx[j] / bs;
+        for (int c = 0; c < bs_k; ++c)
+        {
+          value_type& xi = x[node * bs_k + c];
+          xi = op(xi, value_type(_buffer_local[j + _offsets[k] + c]));
+        }
+      }
+    }
+  }
+
+  /// @brief Scatter ghost data to owners of all vectors.
+  /// @param[in] op The operation to combine received values with owned
+  /// values (e.g. add or insert).
+  /// @note Collective MPI operation
+  template <class BinaryOperation>
+  void scatter_rev(BinaryOperation op)
+  {
+    scatter_rev_begin();
+    scatter_rev_end(op);
+  }
+
+  /// @brief Number of vectors in the group.
+  std::size_t size() const { return _x.size(); }
+
+private:
+  // Vectors of the group
+  std::vector<std::reference_wrapper<V>> _x;
+
+  // Offset of each vector in the block of an index
+  std::vector<int> _offsets;
+
+  // Common index map
+  std::shared_ptr<const common::IndexMap> _map;
+
+  // Scatterer with the total block size of the vectors
+  std::shared_ptr<const common::Scatterer<>> _scatterer;
+
+  // Type of MPI communication
+  common::Scatterer<>::type _type;
+
+  // MPI requests
+  std::vector<MPI_Request> _request;
+
+  // Buffers for ghost scatters
+  std::vector<U> _buffer_local, _buffer_remote;
+};
+} // namespace dolfinx::la
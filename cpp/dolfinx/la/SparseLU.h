@@ -0,0 +1,358 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MultiVector.h"
+#include "Vector.h"
+#include "preconditioners.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::la
+{
+/// @brief Sparse direct solver (LU factorization) for the diagonal
+/// block of a matrix, with a symbolic factorization that is reused for
+/// matrices with the same sparsity pattern.
+///
+/// The symbolic analysis is performed once by the constructor. It
+/// computes a fill-reducing ordering of the symmetrised pattern
+/// (reverse Cuthill-McKee, see graph::reorder_rcm), the sparsity of the
+/// factors from the elimination tree, and the position of each matrix
+/// entry in the factors. SparseLU::factorize computes the numeric
+/// factorization for new values, e.g. in a time-stepping or Newton
+/// loop, at the cost of the floating point operations only. The
+/// triangular solves are level scheduled (see ILU0Preconditioner), and
+/// multiple right-hand sides are solved together.
+///
+/// As for the preconditioners in preconditioners.h, only the diagonal
+/// block (owned rows and columns) of the matrix is factorized, i.e.
+/// this is a direct solver for a matrix on a single process, e.g. on
+/// `MPI_COMM_SELF`, and a subdomain solver for a distributed matrix.
+///
+/// @note No pivoting is performed, which is stable for symmetric
+/// positive-definite and diagonally dominant matrices. The matrix must
+/// have block size one, e.g. a blocked matrix must be created with
+/// la::BlockMode::expanded.
+///
+/// @tparam Mat Matrix type, e.g. la::MatrixCSR.
+template <typename Mat>
+class SparseLU
+{
+public:
+  /// Scalar type
+  using value_type = typename Mat::value_type;
+
+  /// @brief Compute the symbolic and the numeric factorization.
+  /// @param[in] A Square matrix. All diagonal entries must be in the
+  /// sparsity pattern, and the pivots of the factorization must be
+  /// non-zero.
+  explicit SparseLU(const Mat& A) : _lower_levels(0), _upper_levels(0)
+  {
+    if (A.block_size()[0] != 1 or A.block_size()[1] != 1)
+      throw std::runtime_error("Sparse LU requires a matrix with block size 1.");
+
+    auto& row_ptr = A.row_ptr();
+    auto& cols = A.cols();
+    auto& off_diag = A.off_diag_offset();
+    const std::int32_t n = A.num_owned_rows();
+
+    // Symmetrised graph of the diagonal block, without the diagonal
+    std::vector<std::int32_t> offsets(n + 1, 0);
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      for (std::int64_t k = row_ptr[i]; k < off_diag[i]; ++k)
+      {
+        if (std::int32_t j = cols[k]; j != i)
+        {
+          ++offsets[i + 1];
+          ++offsets[j + 1];
+        }
+      }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::int32_t> edges(offsets.back());
+    {
+      std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+      for (std::int32_t i = 0; i < n; ++i)
+      {
+        for (std::int64_t k = row_ptr[i]; k < off_diag[i]; ++k)
+        {
+          if (std::int32_t j = cols[k]; j != i)
+          {
+            edges[pos[i]++] = j;
+            edges[pos[j]++] = i;
+          }
+        }
+      }
+    }
+
+    // Remove duplicate edges (entries in both A_ij and A_ji)
+    {
+      std::vector<std::int32_t> unique_offsets(n + 1, 0);
+      std::int32_t p = 0;
+      for (std::int32_t i = 0; i < n; ++i)
+      {
+        auto it0 = std::next(edges.begin(), offsets[i]);
+        auto it1 = std::next(edges.begin(), offsets[i + 1]);
+        std::sort(it0, it1);
+        auto end = std::unique(it0, it1);
+        p = std::distance(edges.begin(),
+                          std::copy(it0, end, std::next(edges.begin(), p)));
+        unique_offsets[i + 1] = p;
+      }
+      edges.resize(p);
+      offsets = std::move(unique_offsets);
+    }
+    graph::AdjacencyList<std::int32_t> graph(edges, offsets);
+
+    // Fill-reducing ordering, perm[i] is the new index of row i
+    _perm = graph::reorder_rcm(graph);
+
+    // Rows of the strict lower factor in each column (new ordering).
+    // The structure of a column is the union of its structure in A and
+    // of the structures of its children in the elimination tree.
+    std::vector<std::vector<std::int32_t>> lower(n);
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      for (std::int32_t j : graph.links(i))
+      {
+        if (_perm[i] > _perm[j])
+          lower[_perm[j]].push_back(_perm[i]);
+      }
+    }
+    for (std::int32_t j = 0; j < n; ++j)
+    {
+      std::ranges::sort(lower[j]);
+      lower[j].erase(std::unique(lower[j].begin(), lower[j].end()),
+                     lower[j].end());
+      if (!lower[j].empty())
+      {
+        const std::int32_t parent = lower[j].front();
+        lower[parent].insert(lower[parent].end(), std::next(lower[j].begin()),
+                             lower[j].end());
+      }
+    }
+
+    // Pattern of the factors (CSR). Row i has the columns k < i with i
+    // in the structure of column k, the diagonal, and (by symmetry of
+    // the structure) the rows of column i.
+    _row_ptr.resize(n + 1, 0);
+    for (std::int32_t k = 0; k < n; ++k)
+    {
+      _row_ptr[k + 1] += 1 + lower[k].size();
+      for (std::int32_t i : lower[k])
+        ++_row_ptr[i + 1];
+    }
+    std::partial_sum(_row_ptr.begin(), _row_ptr.end(), _row_ptr.begin());
+    _cols.resize(_row_ptr.back());
+    _diag.resize(n);
+    {
+      std::vector<std::int64_t> pos(_row_ptr.begin(), std::prev(_row_ptr.end()));
+      for (std::int32_t k = 0; k < n; ++k)
+      {
+        // Columns k < i are added in increasing order
+        for (std::int32_t i : lower[k])
+          _cols[pos[i]++] = k;
+        _diag[k] = pos[k];
+        _cols[pos[k]++] = k;
+        for (std::int32_t i : lower[k])
+          _cols[pos[k]++] = i;
+      }
+    }
+    _values.resize(_cols.size());
+
+    // Position of the entries of the diagonal block of A in the factors
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      const std::int32_t row = _perm[i];
+      auto it0 = std::next(_cols.begin(), _row_ptr[row]);
+      auto it1 = std::next(_cols.begin(), _row_ptr[row + 1]);
+      for (std::int64_t k = row_ptr[i]; k < off_diag[i]; ++k)
+      {
+        auto it = std::lower_bound(it0, it1, _perm[cols[k]]);
+        assert(it != it1 and *it == _perm[cols[k]]);
+        _a_to_lu.push_back(std::distance(_cols.begin(), it));
+      }
+    }
+
+    // Levels for the lower and upper triangular solves
+    std::span<const std::int64_t> rp(_row_ptr);
+    std::span<const std::int64_t> dp(_diag);
+    std::vector<std::int64_t> diag1(n);
+    std::ranges::transform(_diag, diag1.begin(), [](auto d) { return d + 1; });
+    _lower_levels = impl::level_schedule(rp.first(n), dp, _cols, false);
+    _upper_levels = impl::level_schedule(diag1, rp.last(n), _cols, true);
+
+    factorize(A);
+  }
+
+  /// @brief Compute the numeric factorization of a matrix with the
+  /// sparsity pattern of the matrix used to create the solver.
+  /// @param[in] A Matrix with new values.
+  void factorize(const Mat& A)
+  {
+    auto& row_ptr = A.row_ptr();
+    auto& off_diag = A.off_diag_offset();
+    const std::int32_t n = _diag.size();
+    if (A.num_owned_rows() != n)
+      throw std::runtime_error("Matrix size has changed.");
+    std::size_t nnz = 0;
+    for (std::int32_t i = 0; i < n; ++i)
+      nnz += off_diag[i] - row_ptr[i];
+    if (nnz != _a_to_lu.size())
+      throw std::runtime_error("Matrix sparsity pattern has changed.");
+
+    // Scatter the values of the diagonal block into the factors
+    std::ranges::fill(_values, value_type(0));
+    {
+      std::size_t p = 0;
+      for (std::int32_t i = 0; i < n; ++i)
+        for (std::int64_t k = row_ptr[i]; k < off_diag[i]; ++k)
+          _values[_a_to_lu[p++]] = A.values()[k];
+    }
+
+    // Factorize (IKJ variant, as for ILU(0) on the filled pattern).
+    // 'pos' maps a column to its position in the current row, or -1.
+    std::vector<std::int64_t> pos(n, -1);
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      for (std::int64_t j = _row_ptr[i]; j < _row_ptr[i + 1]; ++j)
+        pos[_cols[j]] = j;
+
+      for (std::int64_t kk = _row_ptr[i]; kk < _diag[i]; ++kk)
+      {
+        const std::int32_t k = _cols[kk];
+        if (_values[_diag[k]] == value_type(0))
+          throw std::runtime_error("Zero pivot in sparse LU factorization.");
+        _values[kk] /= _values[_diag[k]];
+        for (std::int64_t j = _diag[k] + 1; j < _row_ptr[k + 1]; ++j)
+        {
+          assert(pos[_cols[j]] >= 0);
+          _values[pos[_cols[j]]] -= _values[kk] * _values[j];
+        }
+      }
+
+      for (std::int64_t j = _row_ptr[i]; j < _row_ptr[i + 1]; ++j)
+        pos[_cols[j]] = -1;
+    }
+
+    if (std::ranges::any_of(_diag, [this](auto d)
+                            { return _values[d] == value_type(0); }))
+    {
+      throw std::runtime_error("Zero pivot in sparse LU factorization.");
+    }
+  }
+
+  /// @brief Solve `A x = b` for one or more right-hand sides.
+  /// @param[in] b Right-hand sides (owned entries), interleaved
+  /// row-major as in la::MultiVector, i.e. `b[i * num_vectors + v]`.
+  /// @param[out] x Solutions, with the layout of `b`.
+  /// @param[in] num_vectors Number of right-hand sides.
+  void solve(std::span<const value_type> b, std::span<value_type> x,
+             int num_vectors = 1) const
+  {
+    const std::size_t n = _diag.size();
+    const std::size_t nv = num_vectors;
+    assert(b.size() >= n * nv);
+    assert(x.size() >= n * nv);
+
+    // Permute into the ordering of the factors
+    std::vector<value_type> y(n * nv);
+    for (std::size_t i = 0; i < n; ++i)
+      std::copy_n(std::next(b.begin(), i * nv), nv,
+                  std::next(y.begin(), _perm[i] * nv));
+
+    std::span<value_type> _y(y);
+    std::span<const std::int64_t> row_ptr(_row_ptr), diag(_diag);
+    std::span<const std::int32_t> cols(_cols);
+    std::span<const value_type> values(_values);
+
+    // Forward substitution, L y = Pb (L has a unit diagonal)
+    for (std::int32_t l = 0; l < _lower_levels.num_nodes(); ++l)
+    {
+      std::span<const std::int32_t> rows = _lower_levels.links(l);
+      impl::for_each_index(
+          rows.size(),
+          [rows, row_ptr, diag, cols, values, _y, nv](std::size_t k)
+          {
+            const std::int32_t i = rows[k];
+            for (std::int64_t j = row_ptr[i]; j < diag[i]; ++j)
+              for (std::size_t v = 0; v < nv; ++v)
+                _y[i * nv + v] -= values[j] * _y[cols[j] * nv + v];
+          });
+    }
+
+    // Backward substitution, U y = y
+    for (std::int32_t l = 0; l < _upper_levels.num_nodes(); ++l)
+    {
+      std::span<const std::int32_t> rows = _upper_levels.links(l);
+      impl::for_each_index(
+          rows.size(),
+          [rows, row_ptr, diag, cols, values, _y, nv](std::size_t k)
+          {
+            const std::int32_t i = rows[k];
+            for (std::int64_t j = diag[i] + 1; j < row_ptr[i + 1]; ++j)
+              for (std::size_t v = 0; v < nv; ++v)
+                _y[i * nv + v] -= values[j] * _y[cols[j] * nv + v];
+            for (std::size_t v = 0; v < nv; ++v)
+              _y[i * nv + v] /= values[diag[i]];
+          });
+    }
+
+    // Permute back
+    for (std::size_t i = 0; i < n; ++i)
+      std::copy_n(std::next(y.begin(), _perm[i] * nv), nv,
+                  std::next(x.begin(), i * nv));
+  }
+
+  /// @brief Solve `A z = r`.
+  /// @param[in] r Right-hand side.
+  /// @param[in,out] z Solution. Only owned entries are set.
+  void operator()(const Vector<value_type>& r, Vector<value_type>& z) const
+  {
+    solve(r.array(), z.mutable_array());
+  }
+
+  /// @brief Solve `A X = B` for the vectors of a multi-vector.
+  /// @param[in] B Right-hand sides.
+  /// @param[in,out] X Solutions. Only owned entries are set.
+  void operator()(const MultiVector<value_type>& B,
+                  MultiVector<value_type>& X) const
+  {
+    assert(B.num_vectors() == X.num_vectors());
+    solve(B.array(), X.mutable_array(), B.num_vectors());
+  }
+
+  /// @brief Number of entries in the factors `L + U`, including fill-in.
+  std::size_t num_factor_entries() const { return _cols.size(); }
+
+private:
+  // New index of each row (fill-reducing ordering)
+  std::vector<std::int32_t> _perm;
+
+  // Factors (CSR, strict lower part is L and upper part is U), in the
+  // new ordering
+  std::vector<std::int64_t> _row_ptr, _diag;
+  std::vector<std::int32_t> _cols;
+  std::vector<value_type> _values;
+
+  // Position in the factors of each entry of the diagonal block of A,
+  // in the order of the matrix storage
+  std::vector<std::int64_t> _a_to_lu;
+
+  // Rows in each level of the lower and upper triangular solves
+  graph::AdjacencyList<std::int32_t> _lower_levels, _upper_levels;
+};
+
+} // namespace dolfinx::la
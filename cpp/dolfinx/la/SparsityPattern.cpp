@@ -6,138 +6,232 @@
 
 #include "SparsityPattern.h"
 #include <algorithm>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/memory.h>
 #include <map>
+#include <mutex>
+#include <numeric>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
 
+namespace
+{
+/// @brief Apply a function to blocks of the range `[0, n)`, with each
+/// block executed as a task on the process thread pool (see
+/// common::thread_pool).
+/// @param[in] n Size of the range.
+/// @param[in] num_threads Number of blocks.
+/// @param[in] fn Function called with the first and one past the last
+/// index of a block.
+template <typename F>
+void for_each_block(std::int32_t n, int num_threads, F&& fn)
+{
+  if (num_threads < 2)
+  {
+    fn(std::int32_t(0), n);
+    return;
+  }
+
+  common::thread_pool().run(
+      num_threads,
+      [&fn, n, num_threads](int t)
+      {
+        auto [r0, r1] = dolfinx::MPI::local_range(t, n, num_threads);
+        fn(std::int32_t(r0), std::int32_t(r1));
+      });
+}
+
+/// @brief Size of the union of two sorted lists of unique entries.
+std::int32_t union_size(std::span<const std::int32_t> a,
+                        std::span<const std::int32_t> b)
+{
+  std::int32_t n = 0;
+  auto it_a = a.begin();
+  auto it_b = b.begin();
+  while (it_a != a.end() and it_b != b.end())
+  {
+    if (*it_a < *it_b)
+      ++it_a;
+    else if (*it_b < *it_a)
+      ++it_b;
+    else
+    {
+      ++it_a;
+      ++it_b;
+    }
+    ++n;
+  }
+  return n + std::distance(it_a, a.end()) + std::distance(it_b, b.end());
+}
+} // namespace
+
 //-----------------------------------------------------------------------------
 SparsityPattern::SparsityPattern(
     MPI_Comm comm,
     const std::array<std::shared_ptr<const common::IndexMap>, 2>& maps,
     const std::array<int, 2>& bs)
     : _comm(comm), _index_maps(maps), _bs(bs),
-      _row_cache(maps[0]->size_local() + maps[0]->num_ghosts())
+      _row_cache(maps[0]->size_local() + maps[0]->num_ghosts()),
+      _overflow_mutex(std::make_unique<std::mutex>())
 {
   assert(maps[0]);
 }
 //-----------------------------------------------------------------------------
 SparsityPattern::SparsityPattern(
     MPI_Comm comm,
-    const std::vector<std::vector<const SparsityPattern*>>& patterns,
     const std::array<std::vector<std::pair<
                          std::reference_wrapper<const common::IndexMap>, int>>,
-                     2>& maps,
-    const std::array<std::vector<int>, 2>& bs)
-    : _comm(comm), _bs({1, 1})
+                     2>& maps)
+    : _comm(comm), _bs({1, 1}), _overflow_mutex(std::make_unique<std::mutex>())
 {
-  // FIXME: - Add range/bound checks for each block
-  //        - Check for compatible block sizes for each block
-
-  const auto [rank_offset0, local_offset0, ghosts_new0, owners0]
-      = common::stack_index_maps(maps[0]);
-  const auto [rank_offset1, local_offset1, ghosts_new1, owners1]
-      = common::stack_index_maps(maps[1]);
-
-  std::vector<std::int64_t> ghosts0, ghosts1;
-  std::vector<std::int32_t> ghost_offsets0(1, 0);
-  std::vector<std::int32_t> ghost_offsets1(1, 0);
-  for (const std::vector<std::int64_t>& ghosts : ghosts_new0)
+  std::array<std::vector<std::int64_t>, 2> ghosts;
+  std::array<std::vector<int>, 2> owners;
+  std::array<std::int32_t, 2> local_sizes;
+  std::array<std::vector<std::int32_t>, 2> local_offsets, ghost_offsets;
+  for (std::size_t d = 0; d < 2; ++d)
   {
-    ghost_offsets0.push_back(ghost_offsets0.back() + ghosts.size());
-    ghosts0.insert(ghosts0.end(), ghosts.begin(), ghosts.end());
+    auto [rank_offset, local_offset, ghosts_new, owners_new]
+        = common::stack_index_maps(maps[d]);
+    local_sizes[d] = local_offset.back();
+    local_offsets[d] = std::move(local_offset);
+    ghost_offsets[d] = {0};
+    for (std::size_t f = 0; f < ghosts_new.size(); ++f)
+    {
+      ghost_offsets[d].push_back(ghost_offsets[d].back()
+                                 + ghosts_new[f].size());
+      ghosts[d].insert(ghosts[d].end(), ghosts_new[f].begin(),
+                       ghosts_new[f].end());
+      owners[d].insert(owners[d].end(), owners_new[f].begin(),
+                       owners_new[f].end());
+    }
   }
-  for (const std::vector<std::int64_t>& ghosts : ghosts_new1)
+
+  // Create new IndexMaps, computing the destination ranks of both maps
+  // together
   {
-    ghost_offsets1.push_back(ghost_offsets1.back() + ghosts.size());
-    ghosts1.insert(ghosts1.end(), ghosts.begin(), ghosts.end());
+    std::vector<common::IndexMap> index_maps = common::create_index_maps(
+        comm, local_sizes,
+        std::array<std::span<const std::int64_t>, 2>{ghosts[0], ghosts[1]},
+        std::array<std::span<const int>, 2>{owners[0], owners[1]});
+    _index_maps[0]
+        = std::make_shared<common::IndexMap>(std::move(index_maps[0]));
+    _index_maps[1]
+        = std::make_shared<common::IndexMap>(std::move(index_maps[1]));
   }
-
-  std::vector<int> ghost_owners0, ghost_owners1;
-  for (const std::vector<int>& owners : owners0)
-    ghost_owners0.insert(ghost_owners0.end(), owners.begin(), owners.end());
-  for (const std::vector<int>& owners : owners1)
-    ghost_owners1.insert(ghost_owners1.end(), owners.begin(), owners.end());
-
-  // Create new IndexMaps
-  _index_maps[0] = std::make_shared<common::IndexMap>(
-      comm, local_offset0.back(), ghosts0, ghost_owners0);
-  _index_maps[1] = std::make_shared<common::IndexMap>(
-      comm, local_offset1.back(), ghosts1, ghost_owners1);
-
   _row_cache.resize(_index_maps[0]->size_local()
                     + _index_maps[0]->num_ghosts());
-  const std::int32_t num_rows_local_new = _index_maps[0]->size_local();
 
-  // Iterate over block rows
-  for (std::size_t row = 0; row < patterns.size(); ++row)
+  // Local indices of each block: the owned indices of a block follow
+  // the owned indices of the preceding blocks, and likewise for the
+  // ghost indices
+  for (std::size_t d = 0; d < 2; ++d)
   {
-    const common::IndexMap& map_row = maps[0][row].first;
-    const std::int32_t num_rows_local = map_row.size_local();
-    const std::int32_t num_ghost_rows_local = map_row.num_ghosts();
+    for (std::size_t f = 0; f < maps[d].size(); ++f)
+    {
+      const common::IndexMap& map = maps[d][f].first;
+      const int bs = maps[d][f].second;
+      std::vector<std::int32_t>& indices = _block_indices[d].emplace_back(
+          bs * (map.size_local() + map.num_ghosts()));
+      auto ghost_start = std::next(indices.begin(), bs * map.size_local());
+      std::iota(indices.begin(), ghost_start, local_offsets[d][f]);
+      std::iota(ghost_start, indices.end(),
+                local_sizes[d] + ghost_offsets[d][f]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+SparsityPattern::SparsityPattern(
+    MPI_Comm comm,
+    const std::vector<std::vector<const SparsityPattern*>>& patterns,
+    const std::array<std::vector<std::pair<
+                         std::reference_wrapper<const common::IndexMap>, int>>,
+                     2>& maps,
+    const std::array<std::vector<int>, 2>& bs)
+    : SparsityPattern(comm, maps)
+{
+  // FIXME: - Add range/bound checks for each block
+  //        - Check for compatible block sizes for each block
 
-    // Iterate over block columns of current row (block)
-    for (std::size_t col = 0; col < patterns[row].size(); ++col)
+  // Check the sub-patterns
+  for (auto& patterns_row : patterns)
+  {
+    for (const SparsityPattern* p : patterns_row)
     {
-      const common::IndexMap& map_col = maps[1][col].first;
-      const std::int32_t num_cols_local = map_col.size_local();
-      // Get pattern for this block
-      const SparsityPattern* p = patterns[row][col];
-      if (!p)
-        continue;
-
-      if (!_offsets.empty())
+      if (p and !p->_offsets.empty())
       {
         throw std::runtime_error("Sub-sparsity pattern has been finalised. "
                                  "Cannot compute stacked pattern.");
       }
+      else if (p and p->_mode == Mode::count)
+      {
+        throw std::runtime_error("Sub-sparsity pattern storage has not been "
+                                 "allocated. Cannot compute stacked pattern.");
+      }
+    }
+  }
 
-      const int bs_dof0 = bs[0][row];
-      const int bs_dof1 = bs[1][col];
+  // Insert the entries of the sub-patterns.
+  auto insert_blocks = [&]()
+  {
+    std::vector<std::int32_t> cols_new;
 
-      // Iterate over owned rows cache
-      for (std::int32_t i = 0; i < num_rows_local; ++i)
-      {
-        for (std::int32_t c_old : p->_row_cache[i])
-        {
-          const std::int32_t r_new = bs_dof0 * i + local_offset0[row];
-          const std::int32_t c_new = (c_old < num_cols_local)
-                                         ? bs_dof1 * c_old + local_offset1[col]
-                                         : bs_dof1 * (c_old - num_cols_local)
-                                               + local_offset1.back()
-                                               + ghost_offsets1[col];
+    // Iterate over block rows
+    for (std::size_t row = 0; row < patterns.size(); ++row)
+    {
+      const common::IndexMap& map_row = maps[0][row].first;
+      const std::int32_t num_rows = map_row.size_local() + map_row.num_ghosts();
+      std::span<const std::int32_t> rows_new = _block_indices[0][row];
 
-          for (int k0 = 0; k0 < bs_dof0; ++k0)
-          {
-            for (int k1 = 0; k1 < bs_dof1; ++k1)
-              _row_cache[r_new + k0].push_back(c_new + k1);
-          }
-        }
-      }
-      // Iterate over unowned rows cache
-      for (std::int32_t i = 0; i < num_ghost_rows_local; ++i)
+      // Iterate over block columns of current row (block)
+      for (std::size_t col = 0; col < patterns[row].size(); ++col)
       {
-        for (std::int32_t c_old : p->_row_cache[i + num_rows_local])
+        // Get pattern for this block
+        const SparsityPattern* p = patterns[row][col];
+        if (!p)
+          continue;
+
+        const int bs_dof0 = bs[0][row];
+        const int bs_dof1 = bs[1][col];
+        std::span<const std::int32_t> cols_block = _block_indices[1][col];
+
+        // Insert the blocks of the entries of row i of the sub-pattern
+        auto insert_entries = [&](std::int32_t i,
+                                  std::span<const std::int32_t> cols_old)
         {
-          const std::int32_t r_new = bs_dof0 * i + ghost_offsets0[row];
-          const std::int32_t c_new = (c_old < num_cols_local)
-                                         ? bs_dof1 * c_old + local_offset1[col]
-                                         : bs_dof1 * (c_old - num_cols_local)
-                                               + local_offset1.back()
-                                               + ghost_offsets1[col];
-          for (int k0 = 0; k0 < bs_dof0; ++k0)
+          cols_new.resize(bs_dof1 * cols_old.size());
+          for (std::size_t j = 0; j < cols_old.size(); ++j)
           {
             for (int k1 = 0; k1 < bs_dof1; ++k1)
-              _row_cache[num_rows_local_new + r_new + k0].push_back(c_new + k1);
+            {
+              cols_new[bs_dof1 * j + k1]
+                  = cols_block[bs_dof1 * cols_old[j] + k1];
+            }
           }
-        }
+
+          for (int k0 = 0; k0 < bs_dof0; ++k0)
+            insert_row(rows_new[bs_dof0 * i + k0], cols_new);
+        };
+
+        // Iterate over owned and unowned rows
+        for (std::int32_t i = 0; i < num_rows; ++i)
+          insert_entries(i, p->row_entries(i));
+        for (auto [i, c] : p->_overflow)
+          insert_entries(i, std::span(&c, 1));
       }
     }
-  }
+  };
+
+  // Two-pass build (count and then fill) to avoid per-row allocations
+  begin_count();
+  insert_blocks();
+  allocate();
+  insert_blocks();
 }
 //-----------------------------------------------------------------------------
 void SparsityPattern::insert(std::int32_t row, std::int32_t col)
@@ -158,7 +252,7 @@ void SparsityPattern::insert(std::int32_t row, std::int32_t col)
         "Cannot insert rows that do not exist in the IndexMap.");
   }
 
-  _row_cache[row].push_back(col);
+  insert_row(row, std::span(&col, 1));
 }
 //-----------------------------------------------------------------------------
 void SparsityPattern::insert(std::span<const std::int32_t> rows,
@@ -181,7 +275,7 @@ void SparsityPattern::insert(std::span<const std::int32_t> rows,
       throw std::runtime_error(
           "Cannot insert rows that do not exist in the IndexMap.");
     }
-    _row_cache[row].insert(_row_cache[row].end(), cols.begin(), cols.end());
+    insert_row(row, cols);
   }
 }
 //-----------------------------------------------------------------------------
@@ -205,10 +299,93 @@ void SparsityPattern::insert_diagonal(std::span<const std::int32_t> rows)
           "Cannot insert rows that do not exist in the IndexMap.");
     }
 
-    _row_cache[row].push_back(row);
+    insert_row(row, std::span(&row, 1));
   }
 }
 //-----------------------------------------------------------------------------
+void SparsityPattern::begin_count()
+{
+  if (!_offsets.empty())
+    throw std::runtime_error("Sparsity pattern has already been finalised.");
+  if (_mode != Mode::cache
+      or std::ranges::any_of(_row_cache,
+                             [](auto& row) { return !row.empty(); }))
+  {
+    throw std::runtime_error(
+        "Cannot count entries after entries have been inserted.");
+  }
+  std::vector<std::vector<std::int32_t>>().swap(_row_cache);
+
+  assert(_index_maps[0]);
+  _row_ptr.assign(
+      _index_maps[0]->size_local() + _index_maps[0]->num_ghosts() + 1, 0);
+  _mode = Mode::count;
+}
+//-----------------------------------------------------------------------------
+void SparsityPattern::allocate()
+{
+  if (_mode != Mode::count)
+    throw std::runtime_error("Sparsity pattern entries have not been counted.");
+
+  std::partial_sum(_row_ptr.begin(), _row_ptr.end(), _row_ptr.begin());
+  _row_data.resize(_row_ptr.back());
+  _row_sizes.assign(_row_ptr.size() - 1, 0);
+  _mode = Mode::fill;
+}
+//-----------------------------------------------------------------------------
+void SparsityPattern::insert_row(std::int32_t row,
+                                 std::span<const std::int32_t> cols)
+{
+  switch (_mode)
+  {
+  case Mode::cache:
+    _row_cache[row].insert(_row_cache[row].end(), cols.begin(), cols.end());
+    break;
+  case Mode::count:
+    _row_ptr[row + 1] += cols.size();
+    break;
+  case Mode::fill:
+  {
+    // Entries that do not fit in the storage for the row are kept
+    // separately
+    std::int32_t& size = _row_sizes[row];
+    const std::int64_t pos = _row_ptr[row] + size;
+    const std::size_t n = std::min<std::int64_t>(
+        cols.size(), std::max<std::int64_t>(_row_ptr[row + 1] - pos, 0));
+    std::copy_n(cols.begin(), n, std::next(_row_data.begin(), pos));
+    size += n;
+    if (n < cols.size())
+    {
+      std::scoped_lock lock(*_overflow_mutex);
+      for (std::size_t j = n; j < cols.size(); ++j)
+        _overflow.push_back({row, cols[j]});
+    }
+    break;
+  }
+  }
+}
+//-----------------------------------------------------------------------------
+std::span<std::int32_t> SparsityPattern::row_entries(std::int32_t row)
+{
+  if (_mode == Mode::fill)
+    return std::span(_row_data.data() + _row_ptr[row], _row_sizes[row]);
+  else if (_row_cache.empty())
+    return {};
+  else
+    return _row_cache[row];
+}
+//-----------------------------------------------------------------------------
+std::span<const std::int32_t>
+SparsityPattern::row_entries(std::int32_t row) const
+{
+  if (_mode == Mode::fill)
+    return std::span(_row_data.data() + _row_ptr[row], _row_sizes[row]);
+  else if (_row_cache.empty())
+    return {};
+  else
+    return _row_cache[row];
+}
+//-----------------------------------------------------------------------------
 std::shared_ptr<const common::IndexMap>
 SparsityPattern::index_map(int dim) const
 {
@@ -240,12 +417,23 @@ common::IndexMap SparsityPattern::column_index_map() const
                           _col_ghost_owners);
 }
 //-----------------------------------------------------------------------------
+const std::vector<std::vector<std::int32_t>>&
+SparsityPattern::block_indices(int dim) const
+{
+  return _block_indices[dim];
+}
+//-----------------------------------------------------------------------------
 int SparsityPattern::block_size(int dim) const { return _bs[dim]; }
 //-----------------------------------------------------------------------------
-void SparsityPattern::finalize()
+void SparsityPattern::finalize(int num_threads)
 {
   if (!_offsets.empty())
     throw std::runtime_error("Sparsity pattern has already been finalised.");
+  if (_mode == Mode::count)
+  {
+    throw std::runtime_error(
+        "Sparsity pattern storage has not been allocated.");
+  }
 
   common::Timer t0("SparsityPattern::finalize");
 
@@ -265,14 +453,22 @@ void SparsityPattern::finalize()
   _col_ghost_owners.assign(_index_maps[1]->owners().begin(),
                            _index_maps[1]->owners().end());
 
+  // Neighbourhood rank of the owner of a ghost row
+  auto neighbour = [&src0, &owners0](std::size_t ghost)
+  {
+    auto it = std::ranges::lower_bound(src0, owners0[ghost]);
+    assert(it != src0.end() and *it == owners0[ghost]);
+    return std::distance(src0.begin(), it);
+  };
+
   // Compute size of data to send to each process
   std::vector<int> send_sizes(src0.size(), 0);
   for (std::size_t i = 0; i < owners0.size(); ++i)
+    send_sizes[neighbour(i)] += 3 * row_entries(i + local_size0).size();
+  for (auto [row, col] : _overflow)
   {
-    auto it = std::ranges::lower_bound(src0, owners0[i]);
-    assert(it != src0.end() and *it == owners0[i]);
-    const int neighbour_rank = std::distance(src0.begin(), it);
-    send_sizes[neighbour_rank] += 3 * _row_cache[i + local_size0].size();
+    if (row >= local_size0)
+      send_sizes[neighbour(row - local_size0)] += 3;
   }
 
   // Compute send displacements
@@ -285,32 +481,36 @@ void SparsityPattern::finalize()
   std::vector<int> insert_pos(send_disp);
   std::vector<std::int64_t> ghost_data(send_disp.back());
   const int rank = dolfinx::MPI::rank(_comm.comm());
-  for (std::size_t i = 0; i < owners0.size(); ++i)
+  auto pack = [&](std::size_t ghost, std::int32_t col_local)
   {
-    auto it = std::ranges::lower_bound(src0, owners0[i]);
-    assert(it != src0.end() and *it == owners0[i]);
-    const int neighbour_rank = std::distance(src0.begin(), it);
+    // Get index in send buffer
+    const int neighbour_rank = neighbour(ghost);
+    const std::int32_t pos = insert_pos[neighbour_rank];
 
-    for (std::int32_t col_local : _row_cache[i + local_size0])
+    // Pack send data
+    ghost_data[pos] = ghosts0[ghost];
+    if (col_local < local_size1)
     {
-      // Get index in send buffer
-      const std::int32_t pos = insert_pos[neighbour_rank];
-
-      // Pack send data
-      ghost_data[pos] = ghosts0[i];
-      if (col_local < local_size1)
-      {
-        ghost_data[pos + 1] = col_local + local_range1[0];
-        ghost_data[pos + 2] = rank;
-      }
-      else
-      {
-        ghost_data[pos + 1] = _col_ghosts[col_local - local_size1];
-        ghost_data[pos + 2] = _col_ghost_owners[col_local - local_size1];
-      }
-
-      insert_pos[neighbour_rank] += 3;
+      ghost_data[pos + 1] = col_local + local_range1[0];
+      ghost_data[pos + 2] = rank;
+    }
+    else
+    {
+      ghost_data[pos + 1] = _col_ghosts[col_local - local_size1];
+      ghost_data[pos + 2] = _col_ghost_owners[col_local - local_size1];
     }
+
+    insert_pos[neighbour_rank] += 3;
+  };
+  for (std::size_t i = 0; i < owners0.size(); ++i)
+  {
+    for (std::int32_t col_local : row_entries(i + local_size0))
+      pack(i, col_local);
+  }
+  for (auto [row, col] : _overflow)
+  {
+    if (row >= local_size0)
+      pack(row - local_size0, col);
   }
 
   // Exchange data between processes
@@ -347,7 +547,13 @@ void SparsityPattern::finalize()
   for (std::int64_t global_i : _col_ghosts)
     global_to_local.insert({global_i, local_i++});
 
-  // Add data received from the neighborhood
+  // Extra (row, column) entries that are not in the row storage, i.e.
+  // entries that did not fit in the storage of a two-pass build and
+  // entries received from the neighborhood
+  std::vector<std::array<std::int32_t, 2>> extra_entries;
+  extra_entries.reserve(_overflow.size() + ghost_data_in.size() / 3);
+  extra_entries.insert(extra_entries.end(), _overflow.begin(), _overflow.end());
+  std::vector<std::array<std::int32_t, 2>>().swap(_overflow);
   for (std::size_t i = 0; i < ghost_data_in.size(); i += 3)
   {
     const std::int32_t row_local = ghost_data_in[i] - local_range0[0];
@@ -357,7 +563,7 @@ void SparsityPattern::finalize()
     {
       // Convert to local column index
       const std::int32_t J = col - local_range1[0];
-      _row_cache[row_local].push_back(J);
+      extra_entries.push_back({row_local, J});
     }
     else
     {
@@ -371,34 +577,81 @@ void SparsityPattern::finalize()
       }
 
       const std::int32_t col_local = it.first->second;
-      _row_cache[row_local].push_back(col_local);
+      extra_entries.push_back({row_local, col_local});
     }
   }
 
-  // Sort and remove duplicate column indices in each row
-  std::vector<std::int32_t> adj_counts(local_size0 + owners0.size(), 0);
-  _off_diagonal_offsets.resize(local_size0 + owners0.size());
-  for (std::size_t i = 0; i < local_size0 + owners0.size(); ++i)
+  // Column indices of the extra entries of each row
+  const std::int32_t num_rows = local_size0 + owners0.size();
+  std::ranges::sort(extra_entries);
+  extra_entries.erase(std::ranges::unique(extra_entries).begin(),
+                      extra_entries.end());
+  std::vector<std::int32_t> extra_cols(extra_entries.size());
+  std::vector<std::int32_t> extra_offsets(num_rows + 1, 0);
+  for (std::size_t i = 0; i < extra_entries.size(); ++i)
   {
-    std::vector<std::int32_t>& row = _row_cache[i];
-    std::ranges::sort(row);
-    auto it_end = std::ranges::unique(row).begin();
-
-    // Find position of first "off-diagonal" column
-    _off_diagonal_offsets[i] = std::distance(
-        row.begin(), std::lower_bound(row.begin(), it_end, local_size1));
-
-    _edges.insert(_edges.end(), row.begin(), it_end);
-    adj_counts[i] += std::distance(row.begin(), it_end);
+    extra_cols[i] = extra_entries[i][1];
+    ++extra_offsets[extra_entries[i][0] + 1];
   }
-  // Clear cache
-  std::vector<std::vector<std::int32_t>>().swap(_row_cache);
+  std::vector<std::array<std::int32_t, 2>>().swap(extra_entries);
+  std::partial_sum(extra_offsets.begin(), extra_offsets.end(),
+                   extra_offsets.begin());
+  auto extra = [&extra_cols, &extra_offsets](std::int32_t row)
+  {
+    return std::span<const std::int32_t>(
+        extra_cols.data() + extra_offsets[row],
+        extra_offsets[row + 1] - extra_offsets[row]);
+  };
+
+  // Sort and remove duplicate column indices in each row, and count the
+  // entries of each row after merging the extra entries
+  std::vector<std::int32_t> unique_counts(num_rows);
+  std::vector<std::int32_t> adj_counts(num_rows);
+  for_each_block(num_rows, num_threads,
+                 [&](std::int32_t r0, std::int32_t r1)
+                 {
+                   for (std::int32_t i = r0; i < r1; ++i)
+                   {
+                     std::span<std::int32_t> row = row_entries(i);
+                     std::ranges::sort(row);
+                     auto it_end = std::ranges::unique(row).begin();
+                     unique_counts[i] = std::distance(row.begin(), it_end);
+                     adj_counts[i] = union_size(
+                         row.first(unique_counts[i]), extra(i));
+                   }
+                 });
 
   // Compute offsets for adjacency list
-  _offsets.resize(local_size0 + owners0.size() + 1, 0);
+  _offsets.resize(num_rows + 1, 0);
   std::partial_sum(adj_counts.begin(), adj_counts.end(), _offsets.begin() + 1);
+  std::vector<std::int32_t>().swap(adj_counts);
+
+  // Merge the entries of each row into the adjacency list, and find
+  // the position of the first "off-diagonal" column
+  _edges.resize(_offsets.back());
+  _off_diagonal_offsets.resize(num_rows);
+  for_each_block(
+      num_rows, num_threads,
+      [&](std::int32_t r0, std::int32_t r1)
+      {
+        for (std::int32_t i = r0; i < r1; ++i)
+        {
+          auto edges0 = std::next(_edges.begin(), _offsets[i]);
+          auto edges1 = std::ranges::set_union(
+                            row_entries(i).first(unique_counts[i]),
+                            extra(i), edges0)
+                            .out;
+          _off_diagonal_offsets[i] = std::distance(
+              edges0, std::lower_bound(edges0, edges1, local_size1));
+        }
+      });
 
-  _edges.shrink_to_fit();
+  // Clear storage for unassembled entries
+  std::vector<std::vector<std::int32_t>>().swap(_row_cache);
+  std::vector<std::int64_t>().swap(_row_ptr);
+  std::vector<std::int32_t>().swap(_row_sizes);
+  std::vector<std::int32_t>().swap(_row_data);
+  _mode = Mode::cache;
 
   // Column count increased due to received rows from other processes
   spdlog::info("Column ghost size increased from {} to {}",
@@ -443,3 +696,26 @@ std::span<const std::int32_t> SparsityPattern::off_diagonal_offsets() const
 //-----------------------------------------------------------------------------
 MPI_Comm SparsityPattern::comm() const { return _comm.comm(); }
 //-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> SparsityPattern::memory_usage() const
+{
+  std::size_t cache = 0;
+  for (auto& row : _row_cache)
+    cache += common::container_memory(row);
+
+  std::size_t block_indices = 0;
+  for (auto& indices : _block_indices)
+    for (auto& b : indices)
+      block_indices += common::container_memory(b);
+
+  using common::container_memory;
+  return {{"row cache", cache},
+          {"block indices", block_indices},
+          {"unassembled rows",
+           container_memory(_row_ptr) + container_memory(_row_sizes)
+               + container_memory(_row_data) + container_memory(_overflow)},
+          {"column ghosts", container_memory(_col_ghosts)
+                                + container_memory(_col_ghost_owners)},
+          {"graph", container_memory(_edges) + container_memory(_offsets)},
+          {"off-diagonal offsets", container_memory(_off_diagonal_offsets)}};
+}
+//-----------------------------------------------------------------------------
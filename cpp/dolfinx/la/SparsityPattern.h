@@ -6,9 +6,14 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -22,6 +27,16 @@ namespace dolfinx::la
 /// Sparsity pattern data structure that can be used to initialize
 /// sparse matrices. After assembly, column indices are always sorted in
 /// increasing order. Ghost entries are kept after assembly.
+///
+/// By default, inserted entries are cached row-by-row. For large
+/// patterns, a two-pass build avoids the per-row allocations: after
+/// SparsityPattern::begin_count, insertions only count (an upper bound
+/// on) the number of entries in each row. SparsityPattern::allocate
+/// then allocates one array for all entries, and the same insertions
+/// are repeated to fill the array.
+///
+/// Entries may be inserted into different rows from different threads
+/// concurrently, but not into the same row.
 class SparsityPattern
 {
 public:
@@ -35,6 +50,27 @@ public:
       const std::array<std::shared_ptr<const common::IndexMap>, 2>& maps,
       const std::array<int, 2>& bs);
 
+  /// @brief Create an empty sparsity pattern of a block system, with
+  /// the index maps of the blocks stacked in the row and column
+  /// directions.
+  ///
+  /// The owned indices of all blocks are followed by the ghost indices
+  /// of all blocks. The local indices in the pattern of the local
+  /// indices of a block are given by SparsityPattern::block_indices, so
+  /// that the entries of all blocks can be inserted into the pattern
+  /// directly, e.g. by fem::create_sparsity_pattern_block. The pattern
+  /// has block size one.
+  ///
+  /// @param[in] comm Communicator that the pattern is defined on.
+  /// @param[in] maps Pairs of (index map, block size) for each row
+  /// block (maps[0]) and column blocks (maps[1]).
+  SparsityPattern(
+      MPI_Comm comm,
+      const std::array<
+          std::vector<
+              std::pair<std::reference_wrapper<const common::IndexMap>, int>>,
+          2>& maps);
+
   /// Create a new sparsity pattern by concatenating sub-patterns, e.g.
   /// pattern =[ pattern00 ][ pattern 01]
   ///          [ pattern10 ][ pattern 11]
@@ -88,9 +124,26 @@ public:
   /// must exist in the row IndexMap.
   void insert_diagonal(std::span<const std::int32_t> rows);
 
+  /// @brief Begin the counting pass of a two-pass build.
+  ///
+  /// Until SparsityPattern::allocate is called, insertions add to the
+  /// number of entries of a row rather than storing the entries.
+  /// @note Must be called before any entries are inserted.
+  void begin_count();
+
+  /// @brief End the counting pass of a two-pass build and allocate
+  /// storage for the counted entries.
+  ///
+  /// After this call, insertions write into the allocated storage.
+  /// Entries beyond the number counted for a row are stored
+  /// separately, which is slower.
+  void allocate();
+
   /// @brief Finalize sparsity pattern and communicate off-process
   /// entries
-  void finalize();
+  /// @param[in] num_threads Number of threads used to sort and compact
+  /// the rows.
+  void finalize(int num_threads = 1);
 
   /// @brief Index map for given dimension dimension. Returns the index
   /// map for rows and columns that will be set by the current MPI rank.
@@ -114,6 +167,15 @@ public:
   /// SparsityPattern?
   common::IndexMap column_index_map() const;
 
+  /// @brief Local indices in the pattern of the local indices of the
+  /// blocks of a block system.
+  ///
+  /// @param[in] dim Row (0) or column (1) blocks.
+  /// @return For each block, the local index in the pattern of each
+  /// (unblocked) local index, owned and ghost, of the index map of the
+  /// block. Empty if the pattern was not created for a block system.
+  const std::vector<std::vector<std::int32_t>>& block_indices(int dim) const;
+
   /// @brief Return index map block size for dimension dim
   int block_size(int dim) const;
 
@@ -148,7 +210,32 @@ public:
   /// Return MPI communicator
   MPI_Comm comm() const;
 
+  /// @brief Memory (bytes) used by the pattern on this process, by
+  /// member.
+  ///
+  /// Before assembly the storage of the unassembled entries is
+  /// reported, and after assembly the graph. The index maps are not
+  /// included.
+  ///
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const;
+
 private:
+  // Storage of unassembled entries
+  enum class Mode : std::int8_t
+  {
+    cache, // Row-by-row cache
+    count, // Counting pass of a two-pass build
+    fill   // Filling pass of a two-pass build
+  };
+
+  // Insert entries into a row that is in range
+  void insert_row(std::int32_t row, std::span<const std::int32_t> cols);
+
+  // Unassembled entries of a row
+  std::span<std::int32_t> row_entries(std::int32_t row);
+  std::span<const std::int32_t> row_entries(std::int32_t row) const;
+
   // MPI communicator
   dolfinx::MPI::Comm _comm;
 
@@ -158,15 +245,36 @@ private:
   // Block size
   std::array<int, 2> _bs;
 
+  // Local indices of the blocks of a block system in the pattern
+  std::array<std::vector<std::vector<std::int32_t>>, 2> _block_indices;
+
   // Non-zero ghost columns in owned rows
   std::vector<std::int64_t> _col_ghosts;
 
   // Owning process of ghost columns in owned rows
   std::vector<std::int32_t> _col_ghost_owners;
 
+  // Storage mode for unassembled entries
+  Mode _mode = Mode::cache;
+
   // Cache for unassembled entries on owned and unowned (ghost) rows
   std::vector<std::vector<std::int32_t>> _row_cache;
 
+  // Two-pass build storage for unassembled entries on owned and
+  // unowned (ghost) rows. The entries of row i are stored in
+  // _row_data[_row_ptr[i]:_row_ptr[i] + _row_sizes[i]), and
+  // _row_ptr[i + 1] - _row_ptr[i] is the number of counted entries.
+  // During the counting pass, _row_ptr[i + 1] holds the count for row
+  // i.
+  std::vector<std::int64_t> _row_ptr;
+  std::vector<std::int32_t> _row_sizes;
+  std::vector<std::int32_t> _row_data;
+
+  // (row, column) entries that did not fit in _row_data, and mutex
+  // for inserting into _overflow from different threads
+  std::vector<std::array<std::int32_t, 2>> _overflow;
+  std::unique_ptr<std::mutex> _overflow_mutex;
+
   // Sparsity pattern adjacency data (computed once pattern is
   // finalised). _edges holds the edges (connected dofs). The edges for
   // node i are in the range [_offsets[i], _offsets[i + 1]).
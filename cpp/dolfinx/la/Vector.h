@@ -8,15 +8,23 @@
 
 #include "utils.h"
 #include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cmath>
 #include <complex>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/types.h>
+#include <functional>
 #include <limits>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <span>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -27,7 +35,13 @@ namespace dolfinx::la
 ///
 /// @tparam T Scalar type
 /// @tparam Container data container type
-template <typename T, typename Container = std::vector<T>>
+/// @tparam ScatterAllocator Allocator for the ghost scatter indices.
+/// With a container and allocator for (host-accessible) device memory,
+/// e.g. unified or managed memory, the scatter buffers and indices are
+/// device-resident and ghost updates with device kernels (see
+/// scatter_fwd_begin(Pack)) do not copy data between host and device.
+template <typename T, typename Container = std::vector<T>,
+          typename ScatterAllocator = std::allocator<std::int32_t>>
 class Vector
 {
   static_assert(std::is_same_v<typename Container::value_type, T>);
@@ -39,35 +53,74 @@ public:
   /// Container type
   using container_type = Container;
 
+  /// Scatterer type
+  using scatterer_type = common::Scatterer<ScatterAllocator>;
+
   static_assert(std::is_same_v<value_type, typename container_type::value_type>,
                 "Scalar type and container value type must be the same.");
 
-  /// Create a distributed vector
+  /// @brief Create a distributed vector.
+  ///
+  /// @warning With common::Scatterer<>::type::shared, the window is
+  /// freed when the vector is destroyed (or assigned to), which is then
+  /// collective on the processes of a node: a vector that has been
+  /// updated must be destroyed on all processes of the node, in the
+  /// same order as other vectors with a window. Destroying it on only
+  /// some processes, e.g. in a rank-dependent branch or by a reference
+  /// held on one rank only, deadlocks. A copy of the vector creates its
+  /// own window.
+  ///
   /// @param map IndexMap for parallel distribution of the data
   /// @param bs Block size
-  Vector(std::shared_ptr<const common::IndexMap> map, int bs)
-      : _map(map), _scatterer(std::make_shared<common::Scatterer<>>(*_map, bs)),
-        _bs(bs), _buffer_local(_scatterer->local_buffer_size()),
+  /// @param scatter_type Type of MPI communication used for ghost
+  /// updates. With common::Scatterer<>::type::persistent the MPI
+  /// requests are created on the first ghost update and restarted for
+  /// each subsequent update, which reduces the per-update overhead when
+  /// the same vector is updated many times. With
+  /// common::Scatterer<>::type::shared, ghost data is exchanged through
+  /// an MPI shared-memory window between processes on the same node,
+  /// which is created on the first ghost update (see
+  /// common::Scatterer::create_shared_window). The shared type requires
+  /// host memory.
+  /// @param alloc Allocator for the scatter indices
+  Vector(std::shared_ptr<const common::IndexMap> map, int bs,
+         typename scatterer_type::type scatter_type
+         = scatterer_type::type::neighbor,
+         const ScatterAllocator& alloc = ScatterAllocator())
+      : _map(map),
+        _scatterer(std::make_shared<scatterer_type>(*_map, bs, alloc)),
+        _bs(bs), _scatter_type(scatter_type),
+        _buffer_local(_scatterer->local_buffer_size()),
         _buffer_remote(_scatterer->remote_buffer_size()),
         _x(bs * (map->size_local() + map->num_ghosts()))
   {
+    if (_scatter_type != scatterer_type::type::persistent)
+      _request = _scatterer->create_request_vector(_scatter_type);
   }
 
   /// Copy constructor
   Vector(const Vector& x)
       : _map(x._map), _scatterer(x._scatterer), _bs(x._bs),
-        _request(1, MPI_REQUEST_NULL), _buffer_local(x._buffer_local),
-        _buffer_remote(x._buffer_remote), _x(x._x)
+        _scatter_type(x._scatter_type),
+        _request(x._request.size(), MPI_REQUEST_NULL),
+        _buffer_local(x._buffer_local), _buffer_remote(x._buffer_remote),
+        _x(x._x)
   {
+    if (x._stats)
+      _stats.emplace();
   }
 
   /// Move constructor
   Vector(Vector&& x)
       : _map(std::move(x._map)), _scatterer(std::move(x._scatterer)),
-        _bs(std::move(x._bs)),
+        _bs(std::move(x._bs)), _scatter_type(x._scatter_type),
         _request(std::exchange(x._request, {MPI_REQUEST_NULL})),
+        _request_fwd(std::move(x._request_fwd)),
+        _request_rev(std::move(x._request_rev)),
         _buffer_local(std::move(x._buffer_local)),
-        _buffer_remote(std::move(x._buffer_remote)), _x(std::move(x._x))
+        _buffer_remote(std::move(x._buffer_remote)),
+        _window(std::move(x._window)), _x(std::move(x._x)),
+        _stats(std::move(x._stats))
   {
   }
 
@@ -81,42 +134,114 @@ public:
   /// @param[in] v The value to set all entries to (on calling rank)
   void set(value_type v) { std::ranges::fill(_x, v); }
 
-  /// Begin scatter of local data from owner to ghosts on other ranks
+  /// @brief Begin scatter of local data from owner to ghosts on other
+  /// ranks, packing the send buffer with a user kernel.
+  ///
+  /// The kernel is called as `pack(in, idx, out)`, where `in` is the
+  /// owned part of the array, `idx` are the scatterer send indices and
+  /// `out` is the send buffer, and must set `out[i] = in[idx[i]]`. The
+  /// spans point to the memory of the vector container and of the
+  /// scatter index allocator. If these are device-resident, the kernel
+  /// should be a device kernel, and the buffers are passed to MPI
+  /// directly, which requires a GPU-aware MPI implementation (see
+  /// dolfinx::MPI::device_aware). The kernel must complete (e.g.
+  /// synchronise the device stream) before it returns.
+  ///
+  /// @param[in] pack Kernel that packs the send buffer.
   /// @note Collective MPI operation
-  void scatter_fwd_begin()
+  template <typename Pack>
+  void scatter_fwd_begin(Pack pack)
   {
     const std::int32_t local_size = _bs * _map->size_local();
     std::span<const value_type> x_local(_x.data(), local_size);
+    std::span<const std::int32_t> idx(_scatterer->local_indices().data(),
+                                      _scatterer->local_indices().size());
 
-    auto pack = [](auto&& in, auto&& idx, auto&& out)
+    if (_scatter_type == scatterer_type::type::shared)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
-    };
-    pack(x_local, _scatterer->local_indices(), _buffer_local);
+      // Pack into the window, from which processes on the same node
+      // read directly
+      pack(x_local, idx, window().buffer());
+      _scatterer->scatter_fwd_begin(window(),
+                                    std::span<value_type>(_buffer_remote),
+                                    std::span<MPI_Request>(_request));
+      if (_stats)
+        _scatterer->template add_statistics<value_type>(*_stats, true);
+      return;
+    }
+
+    pack(x_local, idx, std::span<value_type>(_buffer_local));
+
+    if (_scatter_type == scatterer_type::type::persistent and !_request_fwd)
+    {
+      _request_fwd.reset(new std::vector<MPI_Request>(
+          _scatterer->create_persistent_requests_fwd(
+              std::span<const value_type>(_buffer_local),
+              std::span<value_type>(_buffer_remote))));
+    }
 
     _scatterer->scatter_fwd_begin(std::span<const value_type>(_buffer_local),
                                   std::span<value_type>(_buffer_remote),
-                                  std::span<MPI_Request>(_request));
+                                  requests_fwd(), _scatter_type);
+    if (_stats)
+      _scatterer->template add_statistics<value_type>(*_stats, true);
   }
 
-  /// End scatter of local data from owner to ghosts on other ranks
+  /// Begin scatter of local data from owner to ghosts on other ranks
   /// @note Collective MPI operation
-  void scatter_fwd_end()
+  void scatter_fwd_begin()
+  {
+    if (std::span runs = _scatterer->local_runs(); !runs.empty())
+    {
+      scatter_fwd_begin([runs](auto in, auto idx, auto out)
+                        { common::impl::pack_runs(in, idx, runs, out); });
+    }
+    else
+      scatter_fwd_begin(pack_host);
+  }
+
+  /// @brief End scatter of local data from owner to ghosts on other
+  /// ranks, unpacking the received data with a user kernel.
+  ///
+  /// The kernel is called as `unpack(in, idx, out)`, where `in` is the
+  /// receive buffer, `idx` are the scatterer receive indices and `out`
+  /// is the ghost part of the array, and must set `out[idx[i]] = in[i]`.
+  /// See scatter_fwd_begin(Pack) for requirements on the kernel.
+  ///
+  /// @param[in] unpack Kernel that unpacks the receive buffer.
+  /// @note Collective MPI operation
+  template <typename Unpack>
+  void scatter_fwd_end(Unpack unpack)
   {
     const std::int32_t local_size = _bs * _map->size_local();
     const std::int32_t num_ghosts = _bs * _map->num_ghosts();
     std::span<value_type> x_remote(_x.data() + local_size, num_ghosts);
-    _scatterer->scatter_fwd_end(std::span<MPI_Request>(_request));
+    wait(
+        [this]()
+        {
+          if (_scatter_type == scatterer_type::type::shared)
+            _scatterer->scatter_fwd_end(window(), std::span(_request));
+          else
+            _scatterer->scatter_fwd_end(requests_fwd());
+        });
+
+    unpack(std::span<const value_type>(_buffer_remote),
+           std::span<const std::int32_t>(_scatterer->remote_indices().data(),
+                                         _scatterer->remote_indices().size()),
+           x_remote);
+  }
 
-    auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
+  /// End scatter of local data from owner to ghosts on other ranks
+  /// @note Collective MPI operation
+  void scatter_fwd_end()
+  {
+    if (std::span runs = _scatterer->remote_runs(); !runs.empty())
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
-    };
-
-    unpack(_buffer_remote, _scatterer->remote_indices(), x_remote,
-           [](auto /*a*/, auto b) { return b; });
+      scatter_fwd_end([runs](auto in, auto idx, auto out)
+                      { common::impl::unpack_runs(in, idx, runs, out); });
+    }
+    else
+      scatter_fwd_end(unpack_host);
   }
 
   /// Scatter local data to ghost positions on other ranks
@@ -127,24 +252,135 @@ public:
     this->scatter_fwd_end();
   }
 
-  /// Start scatter of  ghost data to owner
-  /// @note Collective MPI operation
-  void scatter_rev_begin()
+  /// @brief Scatter the data of a subset of the owned blocks to ghost
+  /// positions on other ranks.
+  ///
+  /// Only the data of marked (e.g. changed) blocks is sent, which
+  /// reduces the communication volume when a small part of the vector
+  /// has changed. For messages to a neighbour with a fraction of marked
+  /// blocks above `threshold`, all data is sent. Ghost values of
+  /// unmarked blocks are not updated. See
+  /// common::Scatterer::scatter_fwd_sparse.
+  ///
+  /// @note Collective MPI operation. The scatter is blocking and does
+  /// not depend on the scatter type of the vector. Requires host
+  /// memory.
+  /// @param[in] marker Marker for each owned block (size
+  /// `index_map()->size_local()`). The data of blocks with a non-zero
+  /// marker is sent.
+  /// @param[in] threshold Fraction of marked blocks in a message above
+  /// which the data of all blocks is sent.
+  void scatter_fwd_sparse(std::span<const std::int8_t> marker,
+                          double threshold = 0.25)
   {
+    assert(marker.size() == std::size_t(_map->size_local()));
     const std::int32_t local_size = _bs * _map->size_local();
     const std::int32_t num_ghosts = _bs * _map->num_ghosts();
+    std::span<const value_type> x_local(_x.data(), local_size);
     std::span<value_type> x_remote(_x.data() + local_size, num_ghosts);
+    std::vector<int> sizes;
+    wait(
+        [&]()
+        {
+          sizes = _scatterer->scatter_fwd_sparse(x_local, x_remote, marker,
+                                                 threshold);
+        });
+    if (_stats)
+      _stats->add(sizes, sizeof(value_type));
+  }
 
-    auto pack = [](auto&& in, auto&& idx, auto&& out)
+  /// @brief Start scatter of ghost data to owner, packing the send
+  /// buffer with a user kernel.
+  ///
+  /// The kernel is called as `pack(in, idx, out)`, where `in` is the
+  /// ghost part of the array, `idx` are the scatterer receive indices
+  /// and `out` is the send buffer, and must set `out[i] = in[idx[i]]`.
+  /// See scatter_fwd_begin(Pack) for requirements on the kernel.
+  ///
+  /// @param[in] pack Kernel that packs the send buffer.
+  /// @note Collective MPI operation
+  template <typename Pack>
+  void scatter_rev_begin(Pack pack)
+  {
+    const std::int32_t local_size = _bs * _map->size_local();
+    const std::int32_t num_ghosts = _bs * _map->num_ghosts();
+    std::span<const value_type> x_remote(_x.data() + local_size, num_ghosts);
+    std::span<const std::int32_t> idx(_scatterer->remote_indices().data(),
+                                      _scatterer->remote_indices().size());
+
+    if (_scatter_type == scatterer_type::type::shared)
     {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[i] = in[idx[i]];
-    };
-    pack(x_remote, _scatterer->remote_indices(), _buffer_remote);
+      pack(x_remote, idx, window().buffer());
+      _scatterer->scatter_rev_begin(window(),
+                                    std::span<value_type>(_buffer_local),
+                                    std::span<MPI_Request>(_request));
+      if (_stats)
+        _scatterer->template add_statistics<value_type>(*_stats, false);
+      return;
+    }
+
+    pack(x_remote, idx, std::span<value_type>(_buffer_remote));
+
+    if (_scatter_type == scatterer_type::type::persistent and !_request_rev)
+    {
+      _request_rev.reset(new std::vector<MPI_Request>(
+          _scatterer->create_persistent_requests_rev(
+              std::span<const value_type>(_buffer_remote),
+              std::span<value_type>(_buffer_local))));
+    }
 
     _scatterer->scatter_rev_begin(std::span<const value_type>(_buffer_remote),
                                   std::span<value_type>(_buffer_local),
-                                  _request);
+                                  requests_rev(), _scatter_type);
+    if (_stats)
+      _scatterer->template add_statistics<value_type>(*_stats, false);
+  }
+
+  /// Start scatter of  ghost data to owner
+  /// @note Collective MPI operation
+  void scatter_rev_begin()
+  {
+    if (std::span runs = _scatterer->remote_runs(); !runs.empty())
+    {
+      scatter_rev_begin([runs](auto in, auto idx, auto out)
+                        { common::impl::pack_runs(in, idx, runs, out); });
+    }
+    else
+      scatter_rev_begin(pack_host);
+  }
+
+  /// @brief End scatter of ghost data to owner, unpacking the received
+  /// data with a user kernel.
+  ///
+  /// The kernel is called as `unpack(in, idx, out, op)`, where `in` is
+  /// the receive buffer, `idx` are the scatterer send indices and `out`
+  /// is the owned part of the array, and must set `out[idx[i]] =
+  /// op(out[idx[i]], in[i])`. An index may appear more than once in
+  /// `idx`, so the updates must not race. See scatter_fwd_begin(Pack)
+  /// for requirements on the kernel.
+  ///
+  /// @param[in] unpack Kernel that unpacks the receive buffer.
+  /// @param[in] op The operation to perform when adding/setting received
+  /// values (add or insert)
+  /// @note Collective MPI operation
+  template <typename Unpack, class BinaryOperation>
+  void scatter_rev_end(Unpack unpack, BinaryOperation op)
+  {
+    const std::int32_t local_size = _bs * _map->size_local();
+    std::span<value_type> x_local(_x.data(), local_size);
+    wait(
+        [this]()
+        {
+          if (_scatter_type == scatterer_type::type::shared)
+            _scatterer->scatter_rev_end(window(), std::span(_request));
+          else
+            _scatterer->scatter_rev_end(requests_rev());
+        });
+
+    unpack(std::span<const value_type>(_buffer_local),
+           std::span<const std::int32_t>(_scatterer->local_indices().data(),
+                                         _scatterer->local_indices().size()),
+           x_local, op);
   }
 
   /// End scatter of ghost data to owner. This process may receive data
@@ -156,16 +392,20 @@ public:
   template <class BinaryOperation>
   void scatter_rev_end(BinaryOperation op)
   {
-    const std::int32_t local_size = _bs * _map->size_local();
-    std::span<value_type> x_local(_x.data(), local_size);
-    _scatterer->scatter_rev_end(_request);
-
-    auto unpack = [](auto&& in, auto&& idx, auto&& out, auto op)
-    {
-      for (std::size_t i = 0; i < idx.size(); ++i)
-        out[idx[i]] = op(out[idx[i]], in[i]);
-    };
-    unpack(_buffer_local, _scatterer->local_indices(), x_local, op);
+    // An owned index may be ghosted on more than one rank, so received
+    // values are accumulated sequentially
+    scatter_rev_end(
+        [runs = _scatterer->local_runs()](auto in, auto idx, auto out, auto op)
+        {
+          if (!runs.empty())
+            common::impl::unpack_runs(in, idx, runs, out, op);
+          else
+          {
+            for (std::size_t i = 0; i < idx.size(); ++i)
+              out[idx[i]] = op(out[idx[i]], in[i]);
+          }
+        },
+        op);
   }
 
   /// Scatter ghost data to owner. This process may receive data from
@@ -195,34 +435,162 @@ public:
   /// Get local part of the vector
   std::span<value_type> mutable_array() { return std::span(_x); }
 
+  /// @brief Enable or disable recording of communication statistics
+  /// for the ghost scatters of this vector.
+  ///
+  /// Enabling resets the statistics. A copy of a vector with recording
+  /// enabled records its own statistics.
+  ///
+  /// @param[in] enable Record statistics if `true`.
+  void enable_scatter_statistics(bool enable)
+  {
+    if (enable)
+      _stats.emplace();
+    else
+      _stats.reset();
+  }
+
+  /// @brief Communication statistics for the ghost scatters of this
+  /// vector on the calling process.
+  /// @return Statistics, or `std::nullopt` if recording is not enabled.
+  const std::optional<common::ScatterStatistics>& scatter_statistics() const
+  {
+    return _stats;
+  }
+
+  /// @brief Memory (bytes) used by the vector on this process, by
+  /// member. The index map and scatterer are not included.
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const
+  {
+    using common::container_memory;
+    return {{"array", container_memory(_x)},
+            {"scatter buffers", container_memory(_buffer_local)
+                                    + container_memory(_buffer_remote)}};
+  }
+
 private:
+  // Host kernel that packs values into a send buffer
+  static constexpr auto pack_host = [](auto in, auto idx, auto out)
+  {
+    impl::for_each_index(idx.size(),
+                         [in, idx, out](auto i) { out[i] = in[idx[i]]; });
+  };
+
+  // Host kernel that unpacks received ghost values. Ghost indices are
+  // unique, so ghost values can be set concurrently.
+  static constexpr auto unpack_host = [](auto in, auto idx, auto out)
+  {
+    impl::for_each_index(idx.size(),
+                         [in, idx, out](auto i) { out[idx[i]] = in[i]; });
+  };
+
+  // Complete a scatter, recording the wait time if statistics or load
+  // metrics (see common::load_metrics_enabled) are enabled
+  template <typename F>
+  void wait(F&& end)
+  {
+    if (!_stats and !common::load_metrics_enabled())
+      end();
+    else
+    {
+      auto t0 = std::chrono::steady_clock::now();
+      end();
+      auto t1 = std::chrono::steady_clock::now();
+      const double t = std::chrono::duration<double>(t1 - t0).count();
+      if (_stats)
+        _stats->wait_time += t;
+      common::add_load_time(common::LoadPhase::scatter, t);
+    }
+  }
+
+  // Frees persistent MPI requests
+  struct RequestDeleter
+  {
+    void operator()(std::vector<MPI_Request>* requests) const
+    {
+      for (MPI_Request& r : *requests)
+      {
+        if (r != MPI_REQUEST_NULL)
+          MPI_Request_free(&r);
+      }
+      delete requests;
+    }
+  };
+
+  // Owning handle to persistent MPI requests
+  using persistent_requests_t
+      = std::unique_ptr<std::vector<MPI_Request>, RequestDeleter>;
+
+  // Shared-memory window for Scatterer::type::shared, created on first
+  // use
+  const common::ScatterWindow<value_type>& window()
+  {
+    if (!_window)
+      _window = _scatterer->template create_shared_window<value_type>();
+    return *_window;
+  }
+
+  // MPI requests for a forward scatter
+  std::span<MPI_Request> requests_fwd()
+  {
+    if (_request_fwd)
+      return *_request_fwd;
+    else
+      return _request;
+  }
+
+  // MPI requests for a reverse scatter
+  std::span<MPI_Request> requests_rev()
+  {
+    if (_request_rev)
+      return *_request_rev;
+    else
+      return _request;
+  }
+
   // Map describing the data layout
   std::shared_ptr<const common::IndexMap> _map;
 
   // Scatter for managing MPI communication
-  std::shared_ptr<const common::Scatterer<>> _scatterer;
+  std::shared_ptr<const scatterer_type> _scatterer;
 
   // Block size
   int _bs;
 
+  // Type of MPI communication used for ghost scatters
+  typename scatterer_type::type _scatter_type;
+
   // MPI request handle
   std::vector<MPI_Request> _request = {MPI_REQUEST_NULL};
 
+  // Persistent MPI requests for forward and reverse scatters. The
+  // requests are bound to _buffer_local and _buffer_remote, and are
+  // created on first use.
+  persistent_requests_t _request_fwd, _request_rev;
+
   // Buffers for ghost scatters
   container_type _buffer_local, _buffer_remote;
 
+  // Shared-memory window for ghost scatters with
+  // Scatterer::type::shared
+  std::unique_ptr<common::ScatterWindow<value_type>> _window;
+
   // Vector data
   container_type _x;
+
+  // Communication statistics (std::nullopt if not recorded)
+  std::optional<common::ScatterStatistics> _stats;
 };
 
-/// Compute the inner product of two vectors. The two vectors must have
-/// the same parallel layout
-/// @note Collective MPI operation
-/// @param a A vector
-/// @param b A vector
-/// @return Returns `a^{H} b` (`a^{T} b` if `a` and `b` are real)
+namespace impl
+{
+/// @brief Compute the contribution of the owned entries on the calling
+/// rank to the inner product `a^{H} b`.
+/// @note Not collective. The local contributions must be summed over
+/// all ranks to obtain the inner product.
 template <class V>
-auto inner_product(const V& a, const V& b)
+typename V::value_type inner_product_local(const V& a, const V& b)
 {
   using T = typename V::value_type;
   const std::int32_t local_size = a.bs() * a.index_map()->size_local();
@@ -231,25 +599,180 @@ auto inner_product(const V& a, const V& b)
   std::span<const T> x_a = a.array().subspan(0, local_size);
   std::span<const T> x_b = b.array().subspan(0, local_size);
 
-  const T local = std::transform_reduce(
-      x_a.begin(), x_a.end(), x_b.begin(), static_cast<T>(0), std::plus{},
-      [](T a, T b) -> T
+  return impl::transform_reduce_index(
+      x_a.size(), static_cast<T>(0), std::plus{},
+      [x_a, x_b](std::size_t i) -> T
       {
         if constexpr (std::is_same<T, std::complex<double>>::value
                       or std::is_same<T, std::complex<float>>::value)
         {
-          return std::conj(a) * b;
+          return std::conj(x_a[i]) * x_b[i];
         }
         else
-          return a * b;
+          return x_a[i] * x_b[i];
       });
+}
+} // namespace impl
 
+/// Compute the inner product of two vectors. The two vectors must have
+/// the same parallel layout
+/// @note Collective MPI operation
+/// @param a A vector
+/// @param b A vector
+/// @return Returns `a^{H} b` (`a^{T} b` if `a` and `b` are real)
+template <class V>
+auto inner_product(const V& a, const V& b)
+{
+  using T = typename V::value_type;
+  const T local = impl::inner_product_local(a, b);
   T result;
   MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_t<T>, MPI_SUM,
                 a.index_map()->comm());
   return result;
 }
 
+/// @brief Compute the inner products of pairs of vectors using a single
+/// global reduction.
+///
+/// Computing several inner products with one `MPI_Allreduce` reduces
+/// the communication latency compared to calling la::inner_product for
+/// each pair, e.g. for the projections in Gram-Schmidt
+/// orthogonalization.
+///
+/// @note Collective MPI operation
+/// @param[in] a First vector of each pair.
+/// @param[in] b Second vector of each pair. Must have the same size as
+/// `a`. All vectors must have the same parallel layout.
+/// @return `a[i]^{H} b[i]` for each pair `i`.
+template <class V>
+std::vector<typename V::value_type>
+inner_products(const std::vector<std::reference_wrapper<const V>>& a,
+               const std::vector<std::reference_wrapper<const V>>& b)
+{
+  using T = typename V::value_type;
+  if (a.size() != b.size())
+    throw std::runtime_error("Mismatch in number of vectors.");
+  if (a.empty())
+    return {};
+
+  std::vector<T> dots(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    dots[i] = impl::inner_product_local(a[i].get(), b[i].get());
+  MPI_Allreduce(MPI_IN_PLACE, dots.data(), dots.size(),
+                dolfinx::MPI::mpi_t<T>, MPI_SUM,
+                a.front().get().index_map()->comm());
+  return dots;
+}
+
+/// @brief Compute `r = alpha x + y` on the owned entries.
+///
+/// `r` may be the same vector as `x` or `y`.
+///
+/// @param[out] r Result vector. Only owned entries are set.
+/// @param[in] alpha Scalar.
+/// @param[in] x A vector.
+/// @param[in] y A vector.
+template <class V>
+void axpy(V& r, typename V::value_type alpha, const V& x, const V& y)
+{
+  using T = typename V::value_type;
+  const std::int32_t local_size = x.bs() * x.index_map()->size_local();
+  std::span<const T> _x = x.array(), _y = y.array();
+  std::span<T> _r = r.mutable_array();
+  impl::for_each_index(local_size, [_r, _x, _y, alpha](std::size_t i)
+                       { _r[i] = alpha * _x[i] + _y[i]; });
+}
+
+/// @brief Compute `r = alpha x + beta y` on the owned entries.
+///
+/// `r` may be the same vector as `x` or `y`, which gives the update
+/// `y <- alpha x + beta y` in a single pass.
+///
+/// @param[out] r Result vector. Only owned entries are set.
+/// @param[in] alpha Scalar.
+/// @param[in] x A vector.
+/// @param[in] beta Scalar.
+/// @param[in] y A vector.
+template <class V>
+void axpby(V& r, typename V::value_type alpha, const V& x,
+           typename V::value_type beta, const V& y)
+{
+  using T = typename V::value_type;
+  const std::int32_t local_size = x.bs() * x.index_map()->size_local();
+  std::span<const T> _x = x.array(), _y = y.array();
+  std::span<T> _r = r.mutable_array();
+  impl::for_each_index(local_size, [_r, _x, _y, alpha, beta](std::size_t i)
+                       { _r[i] = alpha * _x[i] + beta * _y[i]; });
+}
+
+/// @brief Compute `y <- y + sum_k alpha[k] x[k]` on the owned entries.
+///
+/// The vectors `x[k]` are accumulated in a single pass over `y`, e.g.
+/// for the update of the solution in GMRES or of the stages of a
+/// Runge-Kutta method, rather than with one pass per vector.
+///
+/// @param[in,out] y Vector to update. Only owned entries are updated.
+/// @param[in] alpha Scalar for each vector.
+/// @param[in] x Vectors. Must have the same size as `alpha`. All
+/// vectors must have the same parallel layout as `y`.
+template <class V>
+void maxpy(V& y, std::span<const typename V::value_type> alpha,
+           const std::vector<std::reference_wrapper<const V>>& x)
+{
+  using T = typename V::value_type;
+  if (alpha.size() != x.size())
+    throw std::runtime_error("Mismatch in number of vectors.");
+
+  std::vector<std::span<const T>> xs;
+  xs.reserve(x.size());
+  for (const V& xk : x)
+    xs.push_back(xk.array());
+
+  const std::int32_t local_size = y.bs() * y.index_map()->size_local();
+  std::span<T> _y = y.mutable_array();
+  std::span<const std::span<const T>> _xs(xs);
+  impl::for_each_index(local_size,
+                       [_y, _xs, alpha](std::size_t i)
+                       {
+                         T yi = _y[i];
+                         for (std::size_t k = 0; k < _xs.size(); ++k)
+                           yi += alpha[k] * _xs[k][i];
+                         _y[i] = yi;
+                       });
+}
+
+/// @brief Compute `y <- y + alpha x` on the owned entries and return
+/// the squared L2 norm of the updated `y`.
+///
+/// The update and the norm are computed in a single pass over `y`, e.g.
+/// for the residual update in Krylov methods.
+///
+/// @note Collective MPI operation
+/// @param[in,out] y Vector to update. Only owned entries are updated.
+/// @param[in] alpha Scalar.
+/// @param[in] x A vector.
+/// @return `(y, y)` after the update.
+template <class V>
+auto axpy_squared_norm(V& y, typename V::value_type alpha, const V& x)
+{
+  using T = typename V::value_type;
+  using U = typename dolfinx::scalar_value_type_t<T>;
+  const std::int32_t local_size = y.bs() * y.index_map()->size_local();
+  std::span<const T> _x = x.array();
+  std::span<T> _y = y.mutable_array();
+  U local = impl::transform_reduce_index(
+      local_size, U(0), std::plus{},
+      [_y, _x, alpha](std::size_t i) -> U
+      {
+        _y[i] += alpha * _x[i];
+        return std::norm(_y[i]);
+      });
+  U result = 0;
+  MPI_Allreduce(&local, &result, 1, dolfinx::MPI::mpi_t<U>, MPI_SUM,
+                y.index_map()->comm());
+  return result;
+}
+
 /// Compute the squared L2 norm of vector
 /// @note Collective MPI operation
 template <class V>
@@ -275,9 +798,9 @@ auto norm(const V& x, Norm type = Norm::l2)
     std::int32_t size_local = x.bs() * x.index_map()->size_local();
     std::span<const T> data = x.array().subspan(0, size_local);
     using U = typename dolfinx::scalar_value_type_t<T>;
-    U local_l1
-        = std::accumulate(data.begin(), data.end(), U(0),
-                          [](auto norm, auto x) { return norm + std::abs(x); });
+    U local_l1 = impl::transform_reduce_index(
+        data.size(), U(0), std::plus{},
+        [data](std::size_t i) -> U { return std::abs(data[i]); });
     U l1(0);
     MPI_Allreduce(&local_l1, &l1, 1, MPI::mpi_t<U>, MPI_SUM,
                   x.index_map()->comm());
@@ -289,10 +812,11 @@ auto norm(const V& x, Norm type = Norm::l2)
   {
     std::int32_t size_local = x.bs() * x.index_map()->size_local();
     std::span<const T> data = x.array().subspan(0, size_local);
-    auto max_pos = std::ranges::max_element(
-        data, [](T a, T b) { return std::norm(a) < std::norm(b); });
-    auto local_linf = std::abs(*max_pos);
-    decltype(local_linf) linf = 0;
+    using U = typename dolfinx::scalar_value_type_t<T>;
+    U local_linf = impl::transform_reduce_index(
+        data.size(), U(0), [](U a, U b) { return std::max(a, b); },
+        [data](std::size_t i) -> U { return std::abs(data[i]); });
+    U linf = 0;
     MPI_Allreduce(&local_linf, &linf, 1, MPI::mpi_t<decltype(linf)>,
                   MPI_MAX, x.index_map()->comm());
     return linf;
@@ -302,7 +826,15 @@ auto norm(const V& x, Norm type = Norm::l2)
   }
 }
 
-/// Orthonormalize a set of vectors
+/// @brief Orthonormalize a set of vectors.
+///
+/// Classical Gram-Schmidt with re-orthogonalization (CGS2) is used.
+/// The projections of each vector onto the previously orthonormalized
+/// vectors are computed with one fused global reduction per pass (see
+/// la::inner_products), so each vector requires three reductions
+/// (two projection passes and the norm) independent of the number of
+/// vectors.
+///
 /// @param[in,out] basis The set of vectors to orthonormalise. The
 /// vectors must have identical parallel layouts. The vectors are
 /// modified in-place.
@@ -319,15 +851,24 @@ void orthonormalize(std::vector<std::reference_wrapper<V>> basis)
     // Orthogonalize vector i with respect to previously orthonormalized
     // vectors
     V& bi = basis[i].get();
-    for (std::size_t j = 0; j < i; ++j)
+    if (i > 0)
     {
-      const V& bj = basis[j].get();
-
-      // basis_i <- basis_i - dot_ij  basis_j
-      auto dot_ij = inner_product(bi, bj);
-      std::ranges::transform(bj.array(), bi.array(), bi.mutable_array().begin(),
-                             [dot_ij](auto xj, auto xi)
-                             { return xi - dot_ij * xj; });
+      std::vector<std::reference_wrapper<const V>> bj(basis.begin(),
+                                                      std::next(basis.begin(),
+                                                                i));
+      std::vector<std::reference_wrapper<const V>> bii(i, bi);
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        // basis_i <- basis_i - sum_j dot_ij basis_j
+        std::vector<T> dot = inner_products(bj, bii);
+        for (std::size_t j = 0; j < i; ++j)
+        {
+          std::ranges::transform(bj[j].get().array(), bi.array(),
+                                 bi.mutable_array().begin(),
+                                 [dot_ij = dot[j]](auto xj, auto xi)
+                                 { return xi - dot_ij * xj; });
+        }
+      }
     }
 
     // Normalise basis function
@@ -0,0 +1,180 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MappedFile.h>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dolfinx::la
+{
+/// @brief Store of snapshots of distributed vectors in a memory-mapped
+/// file.
+///
+/// Transient adjoint and checkpointing (e.g. revolve) schemes keep the
+/// state of many time steps. This class stores the owned entries of a
+/// fixed number of vectors with the same parallel layout in a scratch
+/// file on each process (see common::MappedFile), e.g. on a local
+/// solid-state disk. The operating system moves the snapshots between
+/// the file and memory on demand, so that the number of snapshots is
+/// not limited by the memory of a node.
+///
+/// A snapshot that will be loaded soon can be read into memory in the
+/// background with VectorHistory::prefetch, and a snapshot that is not
+/// needed for some time can be moved out of memory with
+/// VectorHistory::release.
+///
+/// Each snapshot starts on a page boundary of the file.
+///
+/// @tparam T Scalar type.
+template <typename T>
+class VectorHistory
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  /// Scalar type
+  using value_type = T;
+
+  /// @brief Create a snapshot store.
+  ///
+  /// @param[in] map Index map of the stored vectors.
+  /// @param[in] bs Block size of the stored vectors.
+  /// @param[in] capacity Number of snapshots.
+  /// @param[in] filename Name of the scratch file. The rank of the
+  /// process is appended to the name, so that each process has its own
+  /// file. The file is removed when the store is destroyed.
+  VectorHistory(std::shared_ptr<const common::IndexMap> map, int bs,
+                std::size_t capacity, const std::filesystem::path& filename)
+      : _map(map), _bs(bs), _capacity(capacity),
+        _size(static_cast<std::size_t>(bs) * map->size_local()),
+        _stride(stride(_size)),
+        _file(filename.string() + "."
+                  + std::to_string(dolfinx::MPI::rank(map->comm())),
+              _stride * capacity)
+  {
+  }
+
+  /// @brief Index map of the stored vectors.
+  std::shared_ptr<const common::IndexMap> index_map() const { return _map; }
+
+  /// @brief Block size of the stored vectors.
+  int bs() const { return _bs; }
+
+  /// @brief Number of snapshots.
+  std::size_t capacity() const { return _capacity; }
+
+  /// @brief Store the owned entries of a vector.
+  /// @param[in] i Index of the snapshot.
+  /// @param[in] x Vector to store. It must have the layout of the
+  /// store.
+  template <class V>
+    requires std::is_same_v<typename V::value_type, T>
+  void store(std::size_t i, const V& x)
+  {
+    check(x);
+    std::ranges::copy(x.array().first(_size), snapshot(i).begin());
+  }
+
+  /// @brief Copy a snapshot into the owned entries of a vector.
+  /// @note The ghost entries of `x` are not updated. Call
+  /// Vector::scatter_fwd if they are required.
+  /// @param[in] i Index of the snapshot.
+  /// @param[in,out] x Vector to copy into. It must have the layout of
+  /// the store.
+  template <class V>
+    requires std::is_same_v<typename V::value_type, T>
+  void load(std::size_t i, V& x) const
+  {
+    check(x);
+    std::ranges::copy(snapshot(i), x.mutable_array().begin());
+  }
+
+  /// @brief The owned entries of a snapshot.
+  /// @param[in] i Index of the snapshot.
+  std::span<T> snapshot(std::size_t i)
+  {
+    if (i >= _capacity)
+      throw std::out_of_range("Snapshot index is out of range.");
+    return {reinterpret_cast<T*>(_file.data().data() + i * _stride), _size};
+  }
+
+  /// @brief The owned entries of a snapshot (const version).
+  /// @param[in] i Index of the snapshot.
+  std::span<const T> snapshot(std::size_t i) const
+  {
+    if (i >= _capacity)
+      throw std::out_of_range("Snapshot index is out of range.");
+    return {reinterpret_cast<const T*>(_file.data().data() + i * _stride),
+            _size};
+  }
+
+  /// @brief Start to read a snapshot into memory, without waiting for
+  /// it to be read.
+  ///
+  /// Typically called for the next snapshot of a sequence before the
+  /// current snapshot is used, so that reading the file overlaps with
+  /// computation.
+  ///
+  /// @param[in] i Index of the snapshot.
+  void prefetch(std::size_t i) const
+  {
+    if (i >= _capacity)
+      throw std::out_of_range("Snapshot index is out of range.");
+    _file.prefetch(i * _stride, _size * sizeof(T));
+  }
+
+  /// @brief Write a snapshot to the file and release its memory.
+  ///
+  /// The snapshot is read from the file when it is next accessed.
+  ///
+  /// @param[in] i Index of the snapshot.
+  void release(std::size_t i) const
+  {
+    if (i >= _capacity)
+      throw std::out_of_range("Snapshot index is out of range.");
+    _file.release(i * _stride, _size * sizeof(T));
+  }
+
+private:
+  // Size in bytes of a snapshot, rounded up to a whole number of pages
+  static std::size_t stride(std::size_t size)
+  {
+    const std::size_t page = common::MappedFile::page_size();
+    return (size * sizeof(T) + page - 1) / page * page;
+  }
+
+  // Check that a vector has the layout of the store
+  template <class V>
+  void check(const V& x) const
+  {
+    if (x.bs() * x.index_map()->size_local() != (std::int64_t)_size)
+      throw std::runtime_error("Vector size is incompatible with the store.");
+  }
+
+  std::shared_ptr<const common::IndexMap> _map;
+  int _bs;
+  std::size_t _capacity;
+
+  // Number of owned entries of a vector
+  std::size_t _size;
+
+  // Distance in bytes between the start of snapshots in the file
+  std::size_t _stride;
+
+  common::MappedFile _file;
+};
+} // namespace dolfinx::la
@@ -0,0 +1,781 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/load_metrics.h>
+#include <dolfinx/common/types.h>
+#include <limits>
+#include <mpi.h>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// @file krylov.h
+/// @brief Krylov solvers and polynomial smoothers for la::Vector.
+///
+/// The solvers work with any linear operator `A` that is either a
+/// matrix with a `mult(x, y)` member function that computes `y += A x`
+/// (e.g. la::MatrixCSR), or a callable `A(x, y)` that computes `y = A
+/// x`. A callable is responsible for updating the ghost values of `x`
+/// that it requires. A preconditioner is a callable `P(r, z)` that
+/// computes `z = M^{-1} r` on the owned entries of `z`, see e.g.
+/// la::JacobiPreconditioner.
+///
+/// Global reductions are fused, i.e. all inner products that are
+/// required at the same point of an iteration are computed with a
+/// single `MPI_Allreduce`.
+
+namespace dolfinx::la
+{
+
+/// @brief Convergence information returned by the Krylov solvers.
+template <std::floating_point U>
+struct KrylovInfo
+{
+  /// Number of iterations
+  int iterations = 0;
+
+  /// Norm of the final residual (for GMRES the norm of the
+  /// residual estimate from the Arnoldi process)
+  U residual_norm = 0;
+
+  /// True if the convergence criterion was met
+  bool converged = false;
+};
+
+/// @brief Identity preconditioner, `z = r`.
+struct IdentityPreconditioner
+{
+  /// @brief Apply the preconditioner.
+  /// @param[in] r Input vector or multi-vector.
+  /// @param[in,out] z Output vector. Only owned entries are set.
+  template <class V>
+  void operator()(const V& r, V& z) const
+  {
+    std::size_t n = r.bs() * r.index_map()->size_local();
+    if constexpr (requires { r.num_vectors(); })
+      n *= r.num_vectors();
+    std::copy_n(r.array().begin(), n, z.mutable_array().begin());
+  }
+};
+
+namespace impl
+{
+/// Complex conjugate that preserves real types
+template <typename T>
+T conj(T x)
+{
+  if constexpr (std::is_same_v<T, std::complex<float>>
+                or std::is_same_v<T, std::complex<double>>)
+  {
+    return std::conj(x);
+  }
+  else
+    return x;
+}
+
+/// Number of owned entries of a vector
+template <class V>
+std::size_t local_size(const V& x)
+{
+  return x.bs() * x.index_map()->size_local();
+}
+
+/// @brief Sum values over all ranks using a single reduction.
+template <typename T>
+void allreduce_sum(std::span<T> x, MPI_Comm comm)
+{
+  MPI_Allreduce(MPI_IN_PLACE, x.data(), x.size(), dolfinx::MPI::mpi_t<T>,
+                MPI_SUM, comm);
+}
+
+/// @brief Compute `y <- y + alpha x` on owned entries.
+template <class V>
+void axpy(V& y, typename V::value_type alpha, const V& x)
+{
+  using T = typename V::value_type;
+  std::span<const T> _x = x.array();
+  std::span<T> _y = y.mutable_array();
+  for_each_index(local_size(x), [_x, _y, alpha](std::size_t i)
+                 { _y[i] += alpha * _x[i]; });
+}
+
+/// @brief Compute `y <- x + beta y` on owned entries.
+template <class V>
+void aypx(V& y, typename V::value_type beta, const V& x)
+{
+  using T = typename V::value_type;
+  std::span<const T> _x = x.array();
+  std::span<T> _y = y.mutable_array();
+  for_each_index(local_size(x), [_x, _y, beta](std::size_t i)
+                 { _y[i] = _x[i] + beta * _y[i]; });
+}
+
+/// @brief Compute `y = A x`.
+///
+/// If `A` has a `mult` member function it is used (`y` is zeroed
+/// first), otherwise `A(x, y)` is called.
+template <typename Op, class V>
+void apply(Op& A, V& x, V& y)
+{
+  if constexpr (requires { A.mult(x, y); })
+  {
+    y.set(0);
+    A.mult(x, y);
+  }
+  else
+    A(x, y);
+}
+
+/// @brief Compute the residual `r = b - A x` and return `||r||^2`.
+template <typename Op, class V>
+auto residual(Op& A, const V& b, V& x, V& r)
+{
+  using T = typename V::value_type;
+  apply(A, x, r);
+  std::span<const T> _b = b.array();
+  std::span<T> _r = r.mutable_array();
+  for_each_index(local_size(b),
+                 [_b, _r](std::size_t i) { _r[i] = _b[i] - _r[i]; });
+  return squared_norm(r);
+}
+} // namespace impl
+
+/// @brief Solve `A x = b` using the preconditioned conjugate gradient
+/// (CG) method.
+///
+/// The Chronopoulos-Gear formulation is used, in which the inner
+/// products `(r, M^{-1} r)`, `(A M^{-1} r, M^{-1} r)` and `(r, r)` are
+/// computed with a single global reduction per iteration (standard CG
+/// requires two).
+///
+/// Convergence is declared when `||r|| <= max(rtol ||r_0||, atol)`,
+/// where `r = b - A x` is the unpreconditioned residual.
+///
+/// @note Collective MPI operation
+/// @param[in] A Symmetric positive definite linear operator.
+/// @param[in] b Right-hand side vector.
+/// @param[in,out] x Initial guess on input, solution on output. Only
+/// owned entries are updated.
+/// @param[in] P Symmetric positive definite preconditioner.
+/// @param[in] rtol Relative tolerance.
+/// @param[in] atol Absolute tolerance.
+/// @param[in] max_it Maximum number of iterations.
+/// @return Convergence information.
+template <typename Op, class V, typename Pc = IdentityPreconditioner>
+KrylovInfo<scalar_value_type_t<typename V::value_type>>
+cg(Op&& A, const V& b, V& x, const Pc& P = Pc(), double rtol = 1e-8,
+   double atol = 0, int max_it = 1000)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::solver);
+  using T = typename V::value_type;
+  using U = scalar_value_type_t<T>;
+  MPI_Comm comm = b.index_map()->comm();
+
+  V r(b), u(b), w(b), p(b), s(b);
+  U rnorm0 = std::sqrt(impl::residual(A, b, x, r));
+  const U tol = std::max<U>(rtol * rnorm0, atol);
+  if (rnorm0 <= tol)
+    return {0, rnorm0, true};
+
+  P(r, u);
+  impl::apply(A, u, w);
+  std::array<T, 3> dots{impl::inner_product_local(r, u),
+                        impl::inner_product_local(w, u), T(0)};
+  impl::allreduce_sum(std::span<T>(dots), comm);
+
+  T gamma = dots[0], alpha = dots[0] / dots[1], beta = 0;
+  KrylovInfo<U> info{0, rnorm0, false};
+  while (info.iterations < max_it)
+  {
+    // p <- u + beta p, s <- w + beta s
+    impl::aypx(p, beta, u);
+    impl::aypx(s, beta, w);
+
+    // x <- x + alpha p, r <- r - alpha s
+    impl::axpy(x, alpha, p);
+    impl::axpy(r, -alpha, s);
+    ++info.iterations;
+
+    // u = M^{-1} r, w = A u
+    P(r, u);
+    impl::apply(A, u, w);
+
+    // Fused reduction
+    dots = {impl::inner_product_local(r, u), impl::inner_product_local(w, u),
+            impl::inner_product_local(r, r)};
+    impl::allreduce_sum(std::span<T>(dots), comm);
+
+    info.residual_norm = std::sqrt(std::real(dots[2]));
+    if (info.residual_norm <= tol)
+    {
+      info.converged = true;
+      break;
+    }
+
+    beta = dots[0] / gamma;
+    alpha = dots[0] / (dots[1] - beta * dots[0] / alpha);
+    gamma = dots[0];
+  }
+
+  return info;
+}
+
+/// @brief Solve `A x = b` using the pipelined preconditioned conjugate
+/// gradient method (Ghysels and Vanroose, 2014).
+///
+/// The single global reduction of each iteration is non-blocking
+/// (`MPI_Iallreduce`) and overlaps with the application of the
+/// preconditioner and the operator, which hides the reduction latency
+/// on large numbers of ranks. The method requires more work vectors
+/// and vector updates than la::cg, and the recursively updated
+/// residual may be less accurate, so it is most useful when the
+/// reduction latency dominates.
+///
+/// Convergence is declared when `||r|| <= max(rtol ||r_0||, atol)`,
+/// where `r` is the (recursively updated) unpreconditioned residual.
+///
+/// @note Collective MPI operation
+/// @param[in] A Symmetric positive definite linear operator.
+/// @param[in] b Right-hand side vector.
+/// @param[in,out] x Initial guess on input, solution on output. Only
+/// owned entries are updated.
+/// @param[in] P Symmetric positive definite preconditioner.
+/// @param[in] rtol Relative tolerance.
+/// @param[in] atol Absolute tolerance.
+/// @param[in] max_it Maximum number of iterations.
+/// @return Convergence information.
+template <typename Op, class V, typename Pc = IdentityPreconditioner>
+KrylovInfo<scalar_value_type_t<typename V::value_type>>
+pipelined_cg(Op&& A, const V& b, V& x, const Pc& P = Pc(),
+             double rtol = 1e-8, double atol = 0, int max_it = 1000)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::solver);
+  using T = typename V::value_type;
+  using U = scalar_value_type_t<T>;
+  MPI_Comm comm = b.index_map()->comm();
+
+  V r(b), u(b), w(b), m(b), n(b), p(b), s(b), q(b), z(b);
+  U rnorm0 = std::sqrt(impl::residual(A, b, x, r));
+  const U tol = std::max<U>(rtol * rnorm0, atol);
+  if (rnorm0 <= tol)
+    return {0, rnorm0, true};
+
+  P(r, u);
+  impl::apply(A, u, w);
+
+  T gamma_old = 1, alpha = 0;
+  KrylovInfo<U> info{0, rnorm0, false};
+  for (int i = 0; i <= max_it; ++i)
+  {
+    // Start reduction of (r, u), (w, u) and (r, r)
+    std::array<T, 3> dots{impl::inner_product_local(r, u),
+                          impl::inner_product_local(w, u),
+                          impl::inner_product_local(r, r)};
+    MPI_Request request;
+    MPI_Iallreduce(MPI_IN_PLACE, dots.data(), dots.size(),
+                   dolfinx::MPI::mpi_t<T>, MPI_SUM, comm, &request);
+
+    // Overlap with m = M^{-1} w, n = A m
+    P(w, m);
+    impl::apply(A, m, n);
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    info.residual_norm = std::sqrt(std::real(dots[2]));
+    if (info.residual_norm <= tol)
+    {
+      info.converged = true;
+      break;
+    }
+    if (i == max_it)
+      break;
+
+    T gamma = dots[0], beta = 0;
+    if (i > 0)
+    {
+      beta = gamma / gamma_old;
+      alpha = gamma / (dots[1] - beta * gamma / alpha);
+    }
+    else
+      alpha = gamma / dots[1];
+    gamma_old = gamma;
+
+    impl::aypx(z, beta, n);
+    impl::aypx(q, beta, m);
+    impl::aypx(s, beta, w);
+    impl::aypx(p, beta, u);
+    impl::axpy(x, alpha, p);
+    impl::axpy(r, -alpha, s);
+    impl::axpy(u, -alpha, q);
+    impl::axpy(w, -alpha, z);
+    info.iterations = i + 1;
+  }
+
+  return info;
+}
+
+/// @brief Solve `A x = b` using the restarted, right-preconditioned
+/// generalized minimal residual (GMRES) method.
+///
+/// The Arnoldi process uses classical Gram-Schmidt, with the
+/// projections onto the basis and the norm of the new basis vector
+/// computed with a single fused global reduction per iteration. The
+/// norm of the orthogonalized vector is computed from the Pythagorean
+/// theorem, and a second orthogonalization pass (with one more
+/// reduction) is performed only when cancellation is detected.
+///
+/// Convergence is declared when the residual estimate satisfies `||r||
+/// <= max(rtol ||r_0||, atol)`.
+///
+/// @note Collective MPI operation
+/// @param[in] A Linear operator.
+/// @param[in] b Right-hand side vector.
+/// @param[in,out] x Initial guess on input, solution on output. Only
+/// owned entries are updated.
+/// @param[in] P Preconditioner.
+/// @param[in] restart Number of iterations between restarts.
+/// @param[in] rtol Relative tolerance.
+/// @param[in] atol Absolute tolerance.
+/// @param[in] max_it Maximum number of iterations.
+/// @return Convergence information.
+template <typename Op, class V, typename Pc = IdentityPreconditioner>
+KrylovInfo<scalar_value_type_t<typename V::value_type>>
+gmres(Op&& A, const V& b, V& x, const Pc& P = Pc(), int restart = 30,
+      double rtol = 1e-8, double atol = 0, int max_it = 1000)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::solver);
+  using T = typename V::value_type;
+  using U = scalar_value_type_t<T>;
+  MPI_Comm comm = b.index_map()->comm();
+  if (restart < 1)
+    throw std::runtime_error("GMRES restart must be positive.");
+
+  // Krylov basis, Hessenberg matrix (column-major, (restart + 1) x
+  // restart), Givens rotations and residual vector of the least
+  // squares problem
+  std::vector<V> basis(restart + 1, V(b));
+  V w(b), t(b);
+  std::vector<T> H((restart + 1) * restart), sn(restart), g(restart + 1);
+  std::vector<U> cs(restart);
+  std::vector<T> dots(restart + 2);
+
+  KrylovInfo<U> info;
+  U tol = 0;
+  while (true)
+  {
+    // Residual and first basis vector
+    U beta = std::sqrt(impl::residual(A, b, x, basis[0]));
+    if (info.iterations == 0)
+      tol = std::max<U>(rtol * beta, atol);
+    info.residual_norm = beta;
+    if (beta <= tol)
+    {
+      info.converged = true;
+      break;
+    }
+    if (info.iterations >= max_it)
+      break;
+
+    std::span<T> v0 = basis[0].mutable_array();
+    impl::for_each_index(impl::local_size(b), [v0, beta](std::size_t i)
+                         { v0[i] /= beta; });
+    std::ranges::fill(g, T(0));
+    g[0] = beta;
+
+    // Arnoldi process
+    int k = 0;
+    while (k < restart and info.iterations < max_it)
+    {
+      // w = A M^{-1} v_k
+      P(basis[k], t);
+      impl::apply(A, t, w);
+
+      // Project w onto basis and compute ||w||^2 with one reduction
+      std::span<T> h(H.data() + k * (restart + 1), k + 2);
+      U hnorm2 = 0;
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        std::span<T> c(dots.data(), k + 2);
+        for (int i = 0; i <= k; ++i)
+          c[i] = impl::inner_product_local(basis[i], w);
+        c[k + 1] = impl::inner_product_local(w, w);
+        impl::allreduce_sum(c, comm);
+
+        U wnorm2 = std::real(c[k + 1]);
+        U cnorm2 = 0;
+        for (int i = 0; i <= k; ++i)
+        {
+          impl::axpy(w, -c[i], basis[i]);
+          h[i] += c[i];
+          cnorm2 += std::norm(c[i]);
+        }
+        hnorm2 = std::max<U>(wnorm2 - cnorm2, 0);
+
+        // Re-orthogonalize only if cancellation is severe
+        if (hnorm2 > U(0.5) * wnorm2)
+          break;
+      }
+
+      U hk = std::sqrt(hnorm2);
+      h[k + 1] = hk;
+      if (hk > 0)
+      {
+        std::span<const T> _w = w.array();
+        std::span<T> vk = basis[k + 1].mutable_array();
+        impl::for_each_index(impl::local_size(b), [_w, vk, hk](std::size_t i)
+                             { vk[i] = _w[i] / hk; });
+      }
+
+      // Apply previous Givens rotations to the new column
+      for (int i = 0; i < k; ++i)
+      {
+        T tmp = cs[i] * h[i] + sn[i] * h[i + 1];
+        h[i + 1] = -impl::conj(sn[i]) * h[i] + cs[i] * h[i + 1];
+        h[i] = tmp;
+      }
+
+      // Compute and apply the new rotation
+      U a = std::abs(h[k]);
+      U rho = std::sqrt(a * a + hk * hk);
+      if (a == 0)
+      {
+        cs[k] = 0;
+        sn[k] = 1;
+        h[k] = hk;
+      }
+      else
+      {
+        T phase = h[k] / a;
+        cs[k] = a / rho;
+        sn[k] = phase * hk / rho;
+        h[k] = phase * rho;
+      }
+      h[k + 1] = 0;
+      g[k + 1] = -impl::conj(sn[k]) * g[k];
+      g[k] = cs[k] * g[k];
+
+      ++k;
+      ++info.iterations;
+      info.residual_norm = std::abs(g[k]);
+      if (info.residual_norm <= tol or hk == 0)
+        break;
+    }
+
+    // Solve the upper triangular system H y = g (y is stored in g)
+    for (int i = k - 1; i >= 0; --i)
+    {
+      for (int j = i + 1; j < k; ++j)
+        g[i] -= H[j * (restart + 1) + i] * g[j];
+      g[i] /= H[i * (restart + 1) + i];
+    }
+    std::ranges::fill(H, T(0));
+
+    // x <- x + M^{-1} (V y)
+    w.set(0);
+    for (int i = 0; i < k; ++i)
+      impl::axpy(w, g[i], basis[i]);
+    P(w, t);
+    impl::axpy(x, T(1), t);
+  }
+
+  return info;
+}
+
+namespace impl
+{
+/// @brief Compute the largest eigenvalue of a symmetric tridiagonal
+/// matrix by bisection with Sturm sequences.
+/// @param[in] a Diagonal.
+/// @param[in] b Off-diagonal (size `a.size() - 1`).
+/// @return The largest eigenvalue.
+template <std::floating_point U>
+U tridiagonal_max_eigenvalue(std::span<const U> a, std::span<const U> b)
+{
+  // Gershgorin bounds
+  const std::size_t n = a.size();
+  U lo = a[0], hi = a[0];
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    U r = (i > 0 ? std::abs(b[i - 1]) : 0) + (i + 1 < n ? std::abs(b[i]) : 0);
+    lo = std::min(lo, a[i] - r);
+    hi = std::max(hi, a[i] + r);
+  }
+
+  // Number of eigenvalues less than x
+  auto count = [a, b, n](U x)
+  {
+    std::size_t c = 0;
+    U q = 1;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      q = a[i] - x - (i > 0 ? b[i - 1] * b[i - 1] / q : 0);
+      if (q == 0)
+        q = std::numeric_limits<U>::epsilon() * (std::abs(x) + 1);
+      if (q < 0)
+        ++c;
+    }
+    return c;
+  };
+
+  for (int k = 0; k < 100 and hi - lo > 1e-6 * std::abs(hi); ++k)
+  {
+    U mid = (lo + hi) / 2;
+    if (count(mid) < n)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  return hi;
+}
+} // namespace impl
+
+/// @brief Estimate the largest eigenvalue of `D^{-1} A`, where `D` is
+/// a diagonal matrix, using the Lanczos process.
+///
+/// A few iterations of the conjugate gradient method preconditioned by
+/// `D` are performed, and the largest eigenvalue of the Lanczos
+/// tridiagonal matrix that is built from the CG coefficients is
+/// returned. The estimate converges from below.
+///
+/// @note Collective MPI operation
+/// @param[in] A Symmetric positive definite linear operator.
+/// @param[in] dinv Inverse of the (positive) diagonal `D` on the owned
+/// entries.
+/// @param[in] b Start vector. Only owned entries are used.
+/// @param[in] num_iterations Number of Lanczos (CG) iterations.
+/// @return Estimate of the largest eigenvalue.
+template <typename Op, class V>
+scalar_value_type_t<typename V::value_type>
+estimate_max_eigenvalue(Op&& A,
+                        std::span<const typename V::value_type> dinv,
+                        const V& b, int num_iterations)
+{
+  using T = typename V::value_type;
+  using U = scalar_value_type_t<T>;
+
+  V r(b), z(b), p(b), w(b);
+  auto scale = [&dinv](const V& x, V& y)
+  {
+    std::span<const T> _x = x.array();
+    std::span<T> _y = y.mutable_array();
+    impl::for_each_index(dinv.size(), [_x, _y, dinv](std::size_t i)
+                         { _y[i] = dinv[i] * _x[i]; });
+  };
+
+  scale(r, z);
+  std::ranges::copy(z.array(), p.mutable_array().begin());
+  U rz = std::real(inner_product(r, z));
+
+  // Lanczos tridiagonal matrix
+  std::vector<U> diag, offdiag;
+  U alpha_prev = 1, beta_prev = 0;
+  for (int j = 0; j < num_iterations and rz > 0; ++j)
+  {
+    impl::apply(A, p, w);
+    const U alpha = rz / std::real(inner_product(p, w));
+    impl::axpy(r, T(-alpha), w);
+    scale(r, z);
+    const U rz_new = std::real(inner_product(r, z));
+    const U beta = rz_new / rz;
+
+    diag.push_back(1 / alpha + beta_prev / alpha_prev);
+    if (j + 1 < num_iterations and rz_new > 0)
+      offdiag.push_back(std::sqrt(beta) / alpha);
+
+    impl::aypx(p, T(beta), z);
+    alpha_prev = alpha;
+    beta_prev = beta;
+    rz = rz_new;
+  }
+
+  if (diag.empty())
+    throw std::runtime_error("Eigenvalue estimate requires b != 0.");
+  return impl::tridiagonal_max_eigenvalue<U>(diag, offdiag);
+}
+
+/// @brief Chebyshev polynomial smoother for a symmetric positive
+/// definite operator `A`, preconditioned by its diagonal `D`.
+///
+/// The smoother applies a Chebyshev polynomial in `D^{-1} A` that
+/// damps the error components with eigenvalues of `D^{-1} A` in the
+/// range `[lambda_min, lambda_max]`, where `lambda_max` is an upper
+/// bound of the largest eigenvalue, e.g. from
+/// la::estimate_max_eigenvalue, and typically `lambda_min = lambda_max
+/// / 30`. This suits smoothers for multigrid,
+/// where it only requires operator applications (e.g. a matrix-free
+/// operator or la::MatrixCSR::mult, which overlaps the ghost update
+/// with computation) and the diagonal, e.g. from lumped assembly.
+///
+/// Each iteration applies `A` once and updates the search direction
+/// and the solution in a single fused pass over the vectors. There are
+/// no global reductions.
+///
+/// The smoother can be used as a preconditioner `P(r, z)` in the
+/// Krylov solvers, which computes `z = p(D^{-1} A) D^{-1} r`.
+///
+/// @tparam Op Linear operator type (see krylov.h).
+/// @tparam V Vector type.
+template <typename Op, class V>
+class ChebyshevSmoother
+{
+public:
+  /// Scalar type
+  using value_type = typename V::value_type;
+
+  /// Real scalar type
+  using scalar_type = scalar_value_type_t<value_type>;
+
+  /// @brief Create a Chebyshev smoother.
+  /// @param[in] A Symmetric positive definite linear operator. It must
+  /// outlive the smoother.
+  /// @param[in] diag Diagonal of `A` on the owned entries. All entries
+  /// must be positive.
+  /// @param[in] x Vector with the layout of the operands of `A`.
+  /// @param[in] range Eigenvalue range `[lambda_min, lambda_max]` of
+  /// `D^{-1} A` to damp. `lambda_max` must be an upper bound of the
+  /// largest eigenvalue.
+  /// @param[in] degree Degree of the polynomial.
+  ChebyshevSmoother(Op& A, std::span<const value_type> diag, const V& x,
+                    std::array<scalar_type, 2> range, int degree = 3)
+      : _A(A), _dinv(diag.size()), _range(range), _degree(degree), _d(x),
+        _w(x)
+  {
+    if (degree < 1)
+      throw std::runtime_error("Chebyshev degree must be positive.");
+    if (!(range[0] > 0 and range[0] < range[1]))
+      throw std::runtime_error("Invalid Chebyshev eigenvalue range.");
+    if (diag.size() != impl::local_size(x))
+      throw std::runtime_error("Diagonal size does not match vector.");
+    std::ranges::transform(diag, _dinv.begin(),
+                           [](auto d) { return value_type(1) / d; });
+  }
+
+  /// @brief Create a Chebyshev smoother, estimating the largest
+  /// eigenvalue of `D^{-1} A` with la::estimate_max_eigenvalue.
+  ///
+  /// The estimate is increased by 10% to give an upper bound.
+  ///
+  /// @note Collective MPI operation
+  /// @param[in] A Symmetric positive definite linear operator. It must
+  /// outlive the smoother.
+  /// @param[in] diag Diagonal of `A` on the owned entries. All entries
+  /// must be positive.
+  /// @param[in] x Vector with the layout of the operands of `A`. The
+  /// owned entries are the start vector of the eigenvalue estimate
+  /// and must not be zero.
+  /// @param[in] degree Degree of the polynomial.
+  /// @param[in] ratio Ratio of the largest to the smallest eigenvalue
+  /// of the damped range.
+  /// @param[in] num_iterations Number of Lanczos iterations for the
+  /// eigenvalue estimate.
+  ChebyshevSmoother(Op& A, std::span<const value_type> diag, const V& x,
+                    int degree = 3, scalar_type ratio = 30,
+                    int num_iterations = 10)
+      : ChebyshevSmoother(A, diag, x, {1, 2}, degree)
+  {
+    scalar_type lambda_max = 1.1
+                             * estimate_max_eigenvalue(
+                                 _A, std::span<const value_type>(_dinv), x,
+                                 num_iterations);
+    _range = {lambda_max / ratio, lambda_max};
+  }
+
+  /// @brief Apply the smoother to `A x = b`, i.e. compute `x <- x +
+  /// p(D^{-1} A) D^{-1} (b - A x)`.
+  /// @param[in] b Right-hand side.
+  /// @param[in,out] x Initial guess on input, smoothed solution on
+  /// output. Only owned entries are updated.
+  void smooth(const V& b, V& x) const { apply(b, x, false); }
+
+  /// @brief Apply the smoother as a preconditioner, `z = p(D^{-1} A)
+  /// D^{-1} r`, i.e. smoothing of `A z = r` with a zero initial guess.
+  /// @param[in] r Input vector.
+  /// @param[in,out] z Output vector. Only owned entries are set.
+  void operator()(const V& r, V& z) const { apply(r, z, true); }
+
+  /// @brief Eigenvalue range `[lambda_min, lambda_max]` of `D^{-1} A`
+  /// that is damped by the smoother.
+  std::array<scalar_type, 2> range() const { return _range; }
+
+private:
+  // Chebyshev iteration for A x = b
+  void apply(const V& b, V& x, bool zero_guess) const
+  {
+    using T = value_type;
+    const scalar_type theta = (_range[1] + _range[0]) / 2;
+    const scalar_type delta = (_range[1] - _range[0]) / 2;
+    const scalar_type sigma = theta / delta;
+    std::span<const T> dinv(_dinv);
+    std::span<const T> _b = b.array();
+    std::span<T> _x = x.mutable_array();
+    std::span<T> d = _d.mutable_array();
+
+    // First iteration, d = D^{-1} (b - A x) / theta and x <- x + d
+    if (zero_guess)
+    {
+      impl::for_each_index(dinv.size(),
+                           [dinv, _b, _x, d, theta](std::size_t i)
+                           { _x[i] = d[i] = dinv[i] * _b[i] / theta; });
+    }
+    else
+    {
+      impl::apply(_A, x, _w);
+      std::span<const T> w = _w.array();
+      impl::for_each_index(dinv.size(),
+                           [dinv, _b, _x, d, w, theta](std::size_t i)
+                           {
+                             d[i] = dinv[i] * (_b[i] - w[i]) / theta;
+                             _x[i] += d[i];
+                           });
+    }
+
+    scalar_type rho = 1 / sigma;
+    for (int k = 1; k < _degree; ++k)
+    {
+      impl::apply(_A, x, _w);
+      std::span<const T> w = _w.array();
+      const scalar_type rho_new = 1 / (2 * sigma - rho);
+      const T c0 = rho_new * rho, c1 = 2 * rho_new / delta;
+
+      // Fused update of d and x
+      impl::for_each_index(dinv.size(),
+                           [dinv, _b, _x, d, w, c0, c1](std::size_t i)
+                           {
+                             d[i] = c0 * d[i] + c1 * dinv[i] * (_b[i] - w[i]);
+                             _x[i] += d[i];
+                           });
+      rho = rho_new;
+    }
+  }
+
+  // Linear operator
+  Op& _A;
+
+  // Inverse of the diagonal
+  std::vector<value_type> _dinv;
+
+  // Damped eigenvalue range
+  std::array<scalar_type, 2> _range;
+
+  // Polynomial degree
+  int _degree;
+
+  // Work vectors
+  mutable V _d, _w;
+};
+
+} // namespace dolfinx::la
@@ -0,0 +1,448 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MultiVector.h"
+#include "krylov.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/load_metrics.h>
+#include <limits>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// @file lobpcg.h
+/// @brief Locally optimal block preconditioned conjugate gradient
+/// (LOBPCG) eigensolver for la::MultiVector.
+
+namespace dolfinx::la
+{
+/// @brief Result of la::lobpcg.
+template <std::floating_point T>
+struct LOBPCGInfo
+{
+  /// Eigenvalue approximations (ascending)
+  std::vector<T> eigenvalues;
+
+  /// Residual norm `||A x_j - lambda_j x_j||` of each eigenpair
+  std::vector<T> residual_norms;
+
+  /// Number of iterations
+  int iterations = 0;
+
+  /// True if all eigenpairs met the convergence criterion
+  bool converged = false;
+};
+
+namespace impl
+{
+/// @brief Compute the eigenvalues and eigenvectors of a symmetric
+/// matrix with the cyclic Jacobi method.
+/// @param[in] A Row-major symmetric matrix of shape `(n, n)`.
+/// @param[in] n Number of rows of `A`.
+/// @return Eigenvalues (ascending) and row-major matrix of shape `(n,
+/// n)` with the corresponding eigenvectors as columns.
+template <std::floating_point T>
+std::pair<std::vector<T>, std::vector<T>> symmetric_eigen(std::vector<T> A,
+                                                          int n)
+{
+  std::vector<T> V(n * n, 0);
+  for (int i = 0; i < n; ++i)
+    V[i * n + i] = 1;
+
+  const T norm2 = std::transform_reduce(A.begin(), A.end(), T(0),
+                                        std::plus{}, [](T a) { return a * a; });
+  for (int sweep = 0; sweep < 100; ++sweep)
+  {
+    T off = 0;
+    for (int p = 0; p < n; ++p)
+      for (int q = p + 1; q < n; ++q)
+        off += A[p * n + q] * A[p * n + q];
+    if (off <= std::numeric_limits<T>::epsilon()
+                   * std::numeric_limits<T>::epsilon() * norm2)
+    {
+      break;
+    }
+
+    for (int p = 0; p < n; ++p)
+    {
+      for (int q = p + 1; q < n; ++q)
+      {
+        const T apq = A[p * n + q];
+        if (apq == 0)
+          continue;
+
+        // Rotation that annihilates A(p, q)
+        const T theta = (A[q * n + q] - A[p * n + p]) / (2 * apq);
+        const T t = (theta >= 0 ? 1 : -1)
+                    / (std::abs(theta) + std::sqrt(theta * theta + 1));
+        const T c = 1 / std::sqrt(t * t + 1);
+        const T s = t * c;
+        for (int k = 0; k < n; ++k)
+        {
+          const T akp = A[k * n + p], akq = A[k * n + q];
+          A[k * n + p] = c * akp - s * akq;
+          A[k * n + q] = s * akp + c * akq;
+        }
+        for (int k = 0; k < n; ++k)
+        {
+          const T apk = A[p * n + k], aqk = A[q * n + k];
+          A[p * n + k] = c * apk - s * aqk;
+          A[q * n + k] = s * apk + c * aqk;
+        }
+        for (int k = 0; k < n; ++k)
+        {
+          const T vkp = V[k * n + p], vkq = V[k * n + q];
+          V[k * n + p] = c * vkp - s * vkq;
+          V[k * n + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  // Sort the eigenpairs
+  std::vector<int> perm(n);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::sort(perm, [&A, n](int i, int j)
+                    { return A[i * n + i] < A[j * n + j]; });
+  std::vector<T> lambda(n), Vs(n * n);
+  for (int j = 0; j < n; ++j)
+  {
+    lambda[j] = A[perm[j] * n + perm[j]];
+    for (int i = 0; i < n; ++i)
+      Vs[i * n + j] = V[i * n + perm[j]];
+  }
+
+  return {std::move(lambda), std::move(Vs)};
+}
+
+/// @brief Solve the Rayleigh-Ritz problem `G_A c = lambda G_B c` for
+/// the `k` smallest eigenpairs.
+///
+/// The problem is reduced to a standard eigenproblem on the range of
+/// `G_B`, i.e. the directions of the basis that are numerically
+/// linearly dependent are removed.
+///
+/// @param[in] GA Row-major symmetric matrix of shape `(n, n)`.
+/// @param[in] GB Row-major symmetric positive semi-definite matrix of
+/// shape `(n, n)`.
+/// @param[in] n Number of rows of the matrices.
+/// @param[in] k Number of eigenpairs.
+/// @return Eigenvalues and row-major `(n, k)` matrix of
+/// `G_B`-orthonormal eigenvectors, or empty arrays if the rank of
+/// `G_B` is less than `k`.
+template <std::floating_point T>
+std::pair<std::vector<T>, std::vector<T>>
+rayleigh_ritz(std::span<const T> GA, std::span<const T> GB, int n, int k)
+{
+  // Scale the basis vectors to unit norm, since the residuals become
+  // small as the iteration converges
+  std::vector<T> scale(n);
+  for (int i = 0; i < n; ++i)
+    scale[i] = GB[i * n + i] > 0 ? 1 / std::sqrt(GB[i * n + i]) : 0;
+  std::vector<T> A(n * n), B(n * n);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      A[i * n + j] = GA[i * n + j] * scale[i] * scale[j];
+      B[i * n + j] = GB[i * n + j] * scale[i] * scale[j];
+    }
+  }
+
+  // Orthonormal basis Q = V mu^{-1/2} of the range of B
+  auto [mu, V] = symmetric_eigen<T>(std::move(B), n);
+  const T tol = 1e2 * n * std::numeric_limits<T>::epsilon() * mu.back();
+  std::vector<int> range;
+  for (int j = 0; j < n; ++j)
+  {
+    if (mu[j] > tol)
+      range.push_back(j);
+  }
+  const int m = range.size();
+  if (m < k)
+    return {};
+  std::vector<T> Q(n * m);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < m; ++j)
+      Q[i * m + j] = V[i * n + range[j]] / std::sqrt(mu[range[j]]);
+
+  // M = Q^{T} A Q
+  std::vector<T> AQ(n * m, 0), M(m * m, 0);
+  for (int i = 0; i < n; ++i)
+    for (int l = 0; l < n; ++l)
+      for (int j = 0; j < m; ++j)
+        AQ[i * m + j] += A[i * n + l] * Q[l * m + j];
+  for (int l = 0; l < n; ++l)
+    for (int i = 0; i < m; ++i)
+      for (int j = 0; j < m; ++j)
+        M[i * m + j] += Q[l * m + i] * AQ[l * m + j];
+
+  auto [lambda, Z] = symmetric_eigen<T>(std::move(M), m);
+
+  // C = diag(scale) Q Z for the first k eigenvectors
+  std::vector<T> C(n * k, 0);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int l = 0; l < m; ++l)
+      for (int j = 0; j < k; ++j)
+        C[i * k + j] += Q[i * m + l] * Z[l * m + j];
+    for (int j = 0; j < k; ++j)
+      C[i * k + j] *= scale[i];
+  }
+
+  lambda.resize(k);
+  return {std::move(lambda), std::move(C)};
+}
+
+/// @brief Compute `y = sum_b x_b C_b` on owned entries, where `C_b` is
+/// the `(k, k)` block of rows `b k, ..., (b + 1) k - 1` of the
+/// row-major matrix `C` of shape `(m k, k)`.
+/// @param[in] x Multi-vectors with `k` vectors (`nullptr` entries are
+/// skipped).
+/// @param[in] C Coefficients.
+/// @param[in] b0 Index in `x` of the first block to use.
+/// @param[out] y Multi-vector with `k` vectors.
+template <class MV>
+void combine(std::span<const MV* const> x,
+             std::span<const typename MV::value_type> C, std::size_t b0,
+             MV& y)
+{
+  using T = typename MV::value_type;
+  const int k = y.num_vectors();
+  const std::size_t num_rows = y.bs() * y.index_map()->size_local();
+  std::span<T> _y = y.mutable_array();
+  std::fill_n(_y.begin(), num_rows * k, T(0));
+  for (std::size_t b = b0; b < x.size(); ++b)
+  {
+    if (!x[b])
+      continue;
+    std::span<const T> _x = x[b]->array();
+    std::span<const T> Cb = C.subspan(b * k * k, k * k);
+    for_each_index(num_rows,
+                   [_x, _y, Cb, k](std::size_t r)
+                   {
+                     for (int i = 0; i < k; ++i)
+                     {
+                       const T xi = _x[r * k + i];
+                       for (int j = 0; j < k; ++j)
+                         _y[r * k + j] += xi * Cb[i * k + j];
+                     }
+                   });
+  }
+}
+} // namespace impl
+
+/// @brief Compute the smallest eigenvalues and eigenvectors of a
+/// symmetric operator using the locally optimal block preconditioned
+/// conjugate gradient (LOBPCG) method.
+///
+/// Each iteration performs the Rayleigh-Ritz procedure on the basis
+/// `[X, W, P]` of the current eigenvector approximations `X`, the
+/// preconditioned residuals `W` and the previous search directions
+/// `P`. The Gram matrices of the basis and the residual norms are
+/// computed with a single fused global reduction per iteration, and the
+/// small dense eigenproblem is solved redundantly on each rank. The
+/// basis is orthonormalized through the eigendecomposition of its
+/// Gram matrix, which discards numerically linearly dependent
+/// directions. If too few directions remain, the search directions
+/// `P` are dropped for the iteration.
+///
+/// The eigenpair `j` is converged when `||A x_j - lambda_j x_j|| <=
+/// max(rtol |lambda_j|, atol)`.
+///
+/// @note Collective MPI operation
+/// @param[in] A Symmetric linear operator on multi-vectors, either a
+/// matrix with a `mult(x, y)` member function (e.g. la::MatrixCSR) or
+/// a callable `A(x, y)` that computes `y = A x` (see krylov.h).
+/// @param[in,out] X Initial guess of the eigenvectors on input (the
+/// vectors must be linearly independent), eigenvector approximations
+/// on output. The number of vectors is the number of computed
+/// eigenpairs.
+/// @param[in] P Symmetric positive definite preconditioner, a callable
+/// `P(r, w)` on multi-vectors that sets the owned entries of `w`.
+/// @param[in] rtol Relative tolerance.
+/// @param[in] atol Absolute tolerance.
+/// @param[in] max_it Maximum number of iterations.
+/// @return Eigenvalues and convergence information.
+template <typename Op, class MV, typename Pc = IdentityPreconditioner>
+  requires std::floating_point<typename MV::value_type>
+LOBPCGInfo<typename MV::value_type>
+lobpcg(Op&& A, MV& X, const Pc& P = Pc(), double rtol = 1e-8,
+       double atol = 0, int max_it = 500)
+{
+  common::ScopedLoadTimer timer(common::LoadPhase::solver);
+  using T = typename MV::value_type;
+  MPI_Comm comm = X.index_map()->comm();
+  const int k = X.num_vectors();
+  const std::size_t num_rows = X.bs() * X.index_map()->size_local();
+
+  MV AX(X), R(X), W(X), AW(X), Pd(X), AP(X), Y(X), AY(X);
+  bool has_p = false;
+
+  // Rayleigh-Ritz on [X, W, P] with the Gram matrices computed with a
+  // single reduction. The residual norms are appended to the
+  // reduction. Returns the eigenvalues and coefficients.
+  auto gram = [&](int nb, bool residual)
+  {
+    std::array<const MV*, 3> S = {&X, &W, &Pd}, AS = {&AX, &AW, &AP};
+    std::vector<T> data;
+    for (int bi = 0; bi < nb; ++bi)
+    {
+      for (int bj = bi; bj < nb; ++bj)
+      {
+        for (auto [a, b] : {std::pair(S[bi], AS[bj]), std::pair(S[bi], S[bj])})
+        {
+          std::vector<T> d = impl::inner_product_block_local(*a, *b);
+          data.insert(data.end(), d.begin(), d.end());
+        }
+      }
+    }
+    if (residual)
+    {
+      std::vector<T> d = impl::inner_product_block_local(R, R);
+      for (int j = 0; j < k; ++j)
+        data.push_back(d[j * k + j]);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, data.data(), data.size(),
+                  dolfinx::MPI::mpi_t<T>, MPI_SUM, comm);
+
+    // Assemble the symmetric Gram matrices
+    const int n = nb * k;
+    std::vector<T> GA(n * n), GB(n * n);
+    auto it = data.begin();
+    for (int bi = 0; bi < nb; ++bi)
+    {
+      for (int bj = bi; bj < nb; ++bj)
+      {
+        for (std::vector<T>* G : {&GA, &GB})
+        {
+          for (int i = 0; i < k; ++i)
+          {
+            for (int j = 0; j < k; ++j, ++it)
+            {
+              (*G)[(bi * k + i) * n + bj * k + j] = *it;
+              (*G)[(bj * k + j) * n + bi * k + i] = *it;
+            }
+          }
+        }
+      }
+    }
+
+    std::vector<T> rnorm;
+    for (; it != data.end(); ++it)
+      rnorm.push_back(std::sqrt(std::max(*it, T(0))));
+    return std::tuple(std::move(GA), std::move(GB), std::move(rnorm));
+  };
+
+  // Update P <- S C and AP <- AS C without the X block, and then
+  // X <- X C_X + P and AX <- AX C_X + AP
+  auto update = [&](int nb, std::span<const T> C)
+  {
+    std::array<const MV*, 3> S = {&X, &W, nb > 2 ? &Pd : nullptr};
+    std::array<const MV*, 3> AS = {&AX, &AW, nb > 2 ? &AP : nullptr};
+    std::span<const MV* const> s(S.data(), nb), as(AS.data(), nb);
+    impl::combine(s, C, 1, Y);
+    impl::combine(as, C, 1, AY);
+    std::swap(Pd, Y);
+    std::swap(AP, AY);
+    for (auto [x, p, y] : {std::tuple(&X, &Pd, &Y), std::tuple(&AX, &AP, &AY)})
+    {
+      impl::combine(std::span<const MV* const>(&x, 1), C, 0, *y);
+      std::span<const T> _p = p->array();
+      std::span<T> _y = y->mutable_array();
+      impl::for_each_index(num_rows * k, [_p, _y](std::size_t i)
+                           { _y[i] += _p[i]; });
+    }
+    std::swap(X, Y);
+    std::swap(AX, AY);
+  };
+
+  // Initial Rayleigh-Ritz on X
+  impl::apply(A, X, AX);
+  LOBPCGInfo<T> info;
+  {
+    auto [GA, GB, rnorm] = gram(1, false);
+    auto [lambda, C] = impl::rayleigh_ritz<T>(GA, GB, k, k);
+    if (lambda.empty())
+      throw std::runtime_error("LOBPCG initial vectors are dependent.");
+    info.eigenvalues = std::move(lambda);
+    impl::combine(std::span<const MV* const>(std::array{&X}.data(), 1),
+                  std::span<const T>(C), 0, Y);
+    impl::combine(std::span<const MV* const>(std::array{&AX}.data(), 1),
+                  std::span<const T>(C), 0, AY);
+    std::swap(X, Y);
+    std::swap(AX, AY);
+  }
+
+  while (true)
+  {
+    // Residuals R = A X - X Lambda and preconditioned residuals
+    {
+      std::span<const T> x = X.array(), ax = AX.array();
+      std::span<T> r = R.mutable_array();
+      std::span<const T> lambda(info.eigenvalues);
+      impl::for_each_index(num_rows * k, [x, ax, r, lambda, k](std::size_t i)
+                           { r[i] = ax[i] - lambda[i % k] * x[i]; });
+    }
+    P(R, W);
+    impl::apply(A, W, AW);
+
+    // Fused reduction for the Gram matrices and residual norms
+    const int nb = has_p ? 3 : 2;
+    auto [GA, GB, rnorm] = gram(nb, true);
+    info.residual_norms = rnorm;
+    info.converged = true;
+    for (int j = 0; j < k; ++j)
+    {
+      if (rnorm[j] > std::max<T>(rtol * std::abs(info.eigenvalues[j]), atol))
+        info.converged = false;
+    }
+    if (info.converged or info.iterations == max_it)
+      break;
+
+    auto [lambda, C] = impl::rayleigh_ritz<T>(GA, GB, nb * k, k);
+    int nb_used = nb;
+    if (lambda.empty() and has_p)
+    {
+      // Drop the search directions, i.e. the last block of the Gram
+      // matrices
+      const int n0 = nb * k, n1 = 2 * k;
+      std::vector<T> GA1(n1 * n1), GB1(n1 * n1);
+      for (int i = 0; i < n1; ++i)
+      {
+        std::copy_n(std::next(GA.begin(), i * n0), n1,
+                    std::next(GA1.begin(), i * n1));
+        std::copy_n(std::next(GB.begin(), i * n0), n1,
+                    std::next(GB1.begin(), i * n1));
+      }
+      std::tie(lambda, C) = impl::rayleigh_ritz<T>(GA1, GB1, n1, k);
+      nb_used = 2;
+    }
+    if (lambda.empty())
+      throw std::runtime_error("LOBPCG basis is linearly dependent.");
+
+    info.eigenvalues = std::move(lambda);
+    update(nb_used, C);
+    has_p = true;
+    ++info.iterations;
+  }
+
+  return info;
+}
+
+} // namespace dolfinx::la
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <span>
@@ -16,6 +20,66 @@ namespace dolfinx::la
 {
 namespace impl
 {
+/// @brief Permutation that sorts the column indices of a block of
+/// values that is inserted into a matrix.
+///
+/// The insertion functions visit the columns of the block in sorted
+/// order, so that the search for each column in a (sorted) matrix row
+/// continues from the position of the previous column. Short
+/// permutations are stored on the stack.
+class ColumnOrder
+{
+public:
+  /// @brief Compute the permutation.
+  /// @param[in] xcols Column indices of the block.
+  template <typename Y>
+  explicit ColumnOrder(const Y& xcols) : _size(xcols.size())
+  {
+    if (_size > _local.size())
+      _heap.resize(_size);
+    std::span<std::int32_t> p = data();
+    std::iota(p.begin(), p.end(), 0);
+    if (!std::ranges::is_sorted(xcols))
+      std::ranges::sort(p, {}, [&xcols](auto c) { return xcols[c]; });
+  }
+
+  /// @brief Positions in the block of the columns in sorted order.
+  std::span<const std::int32_t> operator()() const
+  {
+    return std::span(
+        _size > _local.size() ? _heap.data() : _local.data(), _size);
+  }
+
+private:
+  std::span<std::int32_t> data()
+  {
+    return std::span(
+        _size > _local.size() ? _heap.data() : _local.data(), _size);
+  }
+
+  std::size_t _size;
+  std::array<std::int32_t, 64> _local;
+  std::vector<std::int32_t> _heap;
+};
+
+/// @brief Find the first entry that is not less than `value` in a
+/// sorted range.
+///
+/// Short ranges are searched by counting the entries that are less
+/// than `value`, which is branch-free and vectorised by the compiler.
+/// Long ranges are searched by bisection.
+template <typename It, typename T>
+It search_sorted(It first, It last, T value)
+{
+  if (std::distance(first, last) <= 32)
+  {
+    return std::next(first, std::count_if(first, last, [value](auto c)
+                                          { return c < value; }));
+  }
+  else
+    return std::lower_bound(first, last, value);
+}
+
 /// @brief Incorporate data into a CSR matrix
 ///
 /// @tparam BS0 Row block size (of both matrix and data)
@@ -100,6 +164,58 @@ void insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
                            const X& x, const Y& xrows, const Y& xcols, OP op,
                            typename Y::value_type num_rows, int bs0, int bs1);
 
+/// @brief Sparse matrix-vector product `y += A x` for a range of
+/// entries in each row of a local CSR matrix.
+///
+/// The product is computed for the entries `[row_begin[i], row_end[i])`
+/// of each row `i`. This allows the product to be split into a part
+/// that uses only owned columns and a part that uses ghost columns.
+///
+/// The matrix entries are converted to the scalar type of the vectors,
+/// and the product is accumulated in that type.
+///
+/// @tparam BS1 Column block size of the matrix. If -1, the runtime
+/// value `bs1` is used.
+/// @tparam T Scalar type of the matrix entries.
+/// @tparam S Scalar type of the vectors.
+/// @param[in] values Matrix entries. For a blocked matrix each entry
+/// is a row-major block of size `(bs0, bs1)`.
+/// @param[in] row_begin First entry in each row to include.
+/// @param[in] row_end One past the last entry in each row to include.
+/// @param[in] indices Column (block) indices of the matrix entries.
+/// @param[in] x Input vector.
+/// @param[in,out] y Vector to accumulate the product into.
+/// @param[in] bs0 Row block size of the matrix.
+/// @param[in] bs1 Column block size of the matrix.
+template <int BS1, typename T, typename S>
+void spmv(std::span<const T> values, std::span<const std::int64_t> row_begin,
+          std::span<const std::int64_t> row_end,
+          std::span<const std::int32_t> indices, std::span<const S> x,
+          std::span<S> y, int bs0, int bs1);
+
+/// @brief Sparse matrix-multi-vector product `Y += A X` for a range of
+/// entries in each row of a local CSR matrix.
+///
+/// As impl::spmv, but for `nv` vectors that are stored interleaved,
+/// i.e. entry `j` of vector `v` is `x[j * nv + v]`. Each matrix entry
+/// is read once for all vectors.
+///
+/// @param[in] values Matrix entries. For a blocked matrix each entry
+/// is a row-major block of size `(bs0, bs1)`.
+/// @param[in] row_begin First entry in each row to include.
+/// @param[in] row_end One past the last entry in each row to include.
+/// @param[in] indices Column (block) indices of the matrix entries.
+/// @param[in] x Input vectors.
+/// @param[in,out] y Vectors to accumulate the product into.
+/// @param[in] bs0 Row block size of the matrix.
+/// @param[in] bs1 Column block size of the matrix.
+/// @param[in] nv Number of vectors.
+template <typename T, typename S>
+void spmm(std::span<const T> values, std::span<const std::int64_t> row_begin,
+          std::span<const std::int64_t> row_end,
+          std::span<const std::int32_t> indices, std::span<const S> x,
+          std::span<S> y, int bs0, int bs1, int nv);
+
 } // namespace impl
 
 //-----------------------------------------------------------------------------
@@ -111,6 +227,7 @@ void impl::insert_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
 {
   const std::size_t nc = xcols.size();
   assert(x.size() == xrows.size() * xcols.size() * BS0 * BS1);
+  const ColumnOrder order(xcols);
   for (std::size_t r = 0; r < xrows.size(); ++r)
   {
     // Row index and current data row
@@ -122,16 +239,18 @@ void impl::insert_csr(U&& data, const V& cols, const W& row_ptr, const X& x,
     if (row >= num_rows)
       throw std::runtime_error("Local row out of range");
 #endif
-    // Columns indices for row
+    // Columns indices for row. The search for each column (in sorted
+    // order) starts at the previous column, which may be equal.
     auto cit0 = std::next(cols.begin(), row_ptr[row]);
     auto cit1 = std::next(cols.begin(), row_ptr[row + 1]);
-    for (std::size_t c = 0; c < nc; ++c)
+    for (std::int32_t c : order())
     {
       // Find position of column index
-      auto it = std::lower_bound(cit0, cit1, xcols[c]);
+      auto it = search_sorted(cit0, cit1, xcols[c]);
 
       if (it == cit1 or *it != xcols[c])
         throw std::runtime_error("Entry not in sparsity");
+      cit0 = it;
 
       std::size_t d = std::distance(cols.begin(), it);
       int di = d * BS0 * BS1;
@@ -157,6 +276,7 @@ void impl::insert_blocked_csr(U&& data, const V& cols, const W& row_ptr,
 {
   const std::size_t nc = xcols.size();
   assert(x.size() == xrows.size() * xcols.size() * BS0 * BS1);
+  const ColumnOrder order(xcols);
   for (std::size_t r = 0; r < xrows.size(); ++r)
   {
     // Row index and current data row
@@ -174,13 +294,14 @@ void impl::insert_blocked_csr(U&& data, const V& cols, const W& row_ptr,
       // Columns indices for row
       auto cit0 = std::next(cols.begin(), row_ptr[row + i]);
       auto cit1 = std::next(cols.begin(), row_ptr[row + i + 1]);
-      for (std::size_t c = 0; c < nc; ++c)
+      for (std::int32_t c : order())
       {
         // Find position of column index
-        auto it = std::lower_bound(cit0, cit1, xcols[c] * BS1);
+        auto it = search_sorted(cit0, cit1, xcols[c] * BS1);
 
         if (it == cit1 or *it != xcols[c] * BS1)
           throw std::runtime_error("Entry not in sparsity");
+        cit0 = it;
 
         std::size_t d = std::distance(cols.begin(), it);
         assert(d < data.size());
@@ -206,6 +327,7 @@ void impl::insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
   const int nbs = bs0 * bs1;
 
   assert(x.size() == xrows.size() * xcols.size());
+  const ColumnOrder order(xcols);
   for (std::size_t r = 0; r < xrows.size(); ++r)
   {
     // Row index and current data row
@@ -220,14 +342,15 @@ void impl::insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
     // Columns indices for row
     auto cit0 = std::next(cols.begin(), row_ptr[rdiv.quot]);
     auto cit1 = std::next(cols.begin(), row_ptr[rdiv.quot + 1]);
-    for (std::size_t c = 0; c < nc; ++c)
+    for (std::int32_t c : order())
     {
       // Find position of column index
       auto cdiv = std::div(xcols[c], bs1);
-      auto it = std::lower_bound(cit0, cit1, cdiv.quot);
+      auto it = search_sorted(cit0, cit1, cdiv.quot);
 
       if (it == cit1 or *it != cdiv.quot)
         throw std::runtime_error("Entry not in sparsity");
+      cit0 = it;
 
       std::size_t d = std::distance(cols.begin(), it);
       const int di = d * nbs + rdiv.rem * bs1 + cdiv.rem;
@@ -237,4 +360,62 @@ void impl::insert_nonblocked_csr(U&& data, const V& cols, const W& row_ptr,
   }
 }
 //-----------------------------------------------------------------------------
+template <int BS1, typename T, typename S>
+void impl::spmv(std::span<const T> values,
+                std::span<const std::int64_t> row_begin,
+                std::span<const std::int64_t> row_end,
+                std::span<const std::int32_t> indices, std::span<const S> x,
+                std::span<S> y, int bs0, [[maybe_unused]] int bs1)
+{
+  assert(row_begin.size() == row_end.size());
+  const int _bs1 = BS1 > 0 ? BS1 : bs1;
+  for_each_index(
+      row_begin.size(),
+      [values, row_begin, row_end, indices, x, y, bs0, _bs1](std::size_t i)
+      {
+        for (int k0 = 0; k0 < bs0; ++k0)
+        {
+          S vi{0};
+          for (std::int64_t j = row_begin[i]; j < row_end[i]; ++j)
+          {
+            const T* Aj = values.data() + (j * bs0 + k0) * _bs1;
+            const S* xj = x.data() + indices[j] * _bs1;
+            for (int k1 = 0; k1 < _bs1; ++k1)
+              vi += static_cast<S>(Aj[k1]) * xj[k1];
+          }
+          y[i * bs0 + k0] += vi;
+        }
+      });
+}
+//-----------------------------------------------------------------------------
+template <typename T, typename S>
+void impl::spmm(std::span<const T> values,
+                std::span<const std::int64_t> row_begin,
+                std::span<const std::int64_t> row_end,
+                std::span<const std::int32_t> indices, std::span<const S> x,
+                std::span<S> y, int bs0, int bs1, int nv)
+{
+  assert(row_begin.size() == row_end.size());
+  for_each_index(
+      row_begin.size(),
+      [values, row_begin, row_end, indices, x, y, bs0, bs1, nv](std::size_t i)
+      {
+        for (int k0 = 0; k0 < bs0; ++k0)
+        {
+          S* yi = y.data() + (i * bs0 + k0) * nv;
+          for (std::int64_t j = row_begin[i]; j < row_end[i]; ++j)
+          {
+            const T* Aj = values.data() + (j * bs0 + k0) * bs1;
+            for (int k1 = 0; k1 < bs1; ++k1)
+            {
+              const S a = static_cast<S>(Aj[k1]);
+              const S* xj = x.data() + (indices[j] * bs1 + k1) * nv;
+              for (int v = 0; v < nv; ++v)
+                yi[v] += a * xj[v];
+            }
+          }
+        }
+      });
+}
+//-----------------------------------------------------------------------------
 } // namespace dolfinx::la
@@ -0,0 +1,629 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "MatrixCSR.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// @file matrix_product.h
+/// @brief Distributed products and transposes of la::MatrixCSR.
+///
+/// The functions support matrices with a block size of 1. Entries in
+/// ghost rows of the input matrices are ignored, i.e.
+/// MatrixCSR::scatter_rev must be called before the matrices are used.
+
+namespace dolfinx::la
+{
+namespace impl
+{
+/// @brief Create a neighbourhood communicator.
+/// @param[in] comm Communicator.
+/// @param[in] src Ranks that the caller receives data from.
+/// @param[in] dest Ranks that the caller sends data to.
+/// @return Neighbourhood communicator.
+inline dolfinx::MPI::Comm create_neighbor_comm(MPI_Comm comm,
+                                               std::span<const int> src,
+                                               std::span<const int> dest)
+{
+  MPI_Comm c;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 dest.size(), dest.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &c);
+  return dolfinx::MPI::Comm(c, false);
+}
+
+/// @brief Compute the displacements of the data received from each
+/// neighbour, given the displacements of the data sent to each
+/// neighbour.
+/// @param[in] comm Neighbourhood communicator.
+/// @param[in] send_disp Displacements of the data sent to each
+/// destination of `comm`.
+/// @return Displacements of the data received from each source of
+/// `comm`.
+inline std::vector<int> recv_displacements(MPI_Comm comm,
+                                           std::span<const int> send_disp)
+{
+  std::vector<int> send_sizes, recv_sizes;
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  for (std::size_t i = 0; i + 1 < send_disp.size(); ++i)
+    send_sizes.push_back(send_disp[i + 1] - send_disp[i]);
+
+  int indegree(-1), outdegree(-2), weighted(-1);
+  MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
+  recv_sizes.resize(indegree);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                        MPI_INT, comm);
+
+  std::vector<int> recv_disp(indegree + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+  return recv_disp;
+}
+
+/// @brief Send data to the neighbours of a neighbourhood communicator.
+/// @param[in] comm Neighbourhood communicator.
+/// @param[in] send Data to send, ordered by destination.
+/// @param[in] send_disp Displacements in `send` of the data for each
+/// destination.
+/// @param[in] recv_disp Displacements of the data received from each
+/// source (see recv_displacements).
+/// @return Received data, ordered by source.
+template <typename T>
+std::vector<T> neighbor_alltoallv(MPI_Comm comm, std::span<const T> send,
+                                  std::span<const int> send_disp,
+                                  std::span<const int> recv_disp)
+{
+  std::vector<int> send_sizes, recv_sizes;
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  for (std::size_t i = 0; i + 1 < send_disp.size(); ++i)
+    send_sizes.push_back(send_disp[i + 1] - send_disp[i]);
+  for (std::size_t i = 0; i + 1 < recv_disp.size(); ++i)
+    recv_sizes.push_back(recv_disp[i + 1] - recv_disp[i]);
+
+  std::vector<T> recv(recv_disp.back());
+  MPI_Neighbor_alltoallv(send.data(), send_sizes.data(), send_disp.data(),
+                         dolfinx::MPI::mpi_t<T>, recv.data(),
+                         recv_sizes.data(), recv_disp.data(),
+                         dolfinx::MPI::mpi_t<T>, comm);
+  return recv;
+}
+
+/// @brief Position of the owner of each ghost index of a map in the
+/// list of source ranks of the map.
+inline std::vector<int> ghost_owner_positions(const common::IndexMap& map)
+{
+  std::span src = map.src();
+  std::vector<int> pos;
+  pos.reserve(map.owners().size());
+  for (int r : map.owners())
+  {
+    auto it = std::ranges::lower_bound(src, r);
+    assert(it != src.end() and *it == r);
+    pos.push_back(std::distance(src.begin(), it));
+  }
+  return pos;
+}
+} // namespace impl
+
+/// @brief Compute the transpose of a distributed matrix.
+///
+/// The entries of the owned rows of `A` in ghost columns are sent to
+/// the owners of the columns. The row index map of the transpose is
+/// the column index map of `A`, and the owned columns of the transpose
+/// are the owned rows of `A`, so that products such as `transpose(P) *
+/// A * P` can be formed with MatrixProduct.
+///
+/// @note Collective MPI operation
+/// @param[in] A Matrix to transpose. Must have a block size of 1.
+/// @return Transpose of `A`. The transpose has no entries in ghost
+/// rows.
+template <typename T>
+MatrixCSR<T> transpose(const MatrixCSR<T>& A)
+{
+  if (A.block_size() != std::array{1, 1})
+    throw std::runtime_error("Matrix transpose requires a block size of 1.");
+
+  std::shared_ptr<const common::IndexMap> map0 = A.index_map(0);
+  std::shared_ptr<const common::IndexMap> map1 = A.index_map(1);
+  const std::int32_t num_rows = map0->size_local();
+  const std::int32_t num_cols = map1->size_local();
+  const std::int64_t row_offset = map0->local_range()[0];
+  const std::int64_t col_offset = map1->local_range()[0];
+  std::span ghosts1 = map1->ghosts();
+  std::span src1 = map1->src();
+  std::span dest1 = map1->dest();
+  const auto& cols = A.cols();
+  const auto& row_ptr = A.row_ptr();
+  const auto& values = A.values();
+
+  // Entries in ghost columns are sent to the owners of the columns
+  // (src), and entries in owned columns are received from the ranks
+  // that ghost the columns (dest)
+  dolfinx::MPI::Comm comm
+      = impl::create_neighbor_comm(map1->comm(), dest1, src1);
+  std::vector<int> ghost_to_nbr = impl::ghost_owner_positions(*map1);
+
+  std::vector<int> send_disp(src1.size() + 1, 0);
+  for (std::int32_t i = 0; i < num_rows; ++i)
+    for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+      if (cols[p] >= num_cols)
+        ++send_disp[ghost_to_nbr[cols[p] - num_cols] + 1];
+  std::partial_sum(send_disp.begin(), send_disp.end(), send_disp.begin());
+
+  // Pack (global row, global column, value) of each entry
+  std::vector<std::int64_t> send_idx(2 * send_disp.back());
+  std::vector<T> send_values(send_disp.back());
+  {
+    std::vector<int> insert_pos = send_disp;
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+      {
+        if (std::int32_t c = cols[p]; c >= num_cols)
+        {
+          int& pos = insert_pos[ghost_to_nbr[c - num_cols]];
+          send_idx[2 * pos] = row_offset + i;
+          send_idx[2 * pos + 1] = ghosts1[c - num_cols];
+          send_values[pos++] = values[p];
+        }
+      }
+    }
+  }
+
+  std::vector<int> recv_disp = impl::recv_displacements(comm.comm(), send_disp);
+  std::vector<int> send_disp2(send_disp.size()), recv_disp2(recv_disp.size());
+  std::ranges::transform(send_disp, send_disp2.begin(),
+                         [](auto d) { return 2 * d; });
+  std::ranges::transform(recv_disp, recv_disp2.begin(),
+                         [](auto d) { return 2 * d; });
+  std::vector<std::int64_t> recv_idx = impl::neighbor_alltoallv<std::int64_t>(
+      comm.comm(), send_idx, send_disp2, recv_disp2);
+  std::vector<T> recv_values
+      = impl::neighbor_alltoallv<T>(comm.comm(), send_values, send_disp,
+                                    recv_disp);
+
+  // The rows received from another rank are ghost columns of the
+  // transpose, owned by the sending rank
+  std::vector<std::pair<std::int64_t, int>> ghost_owner;
+  for (std::size_t n = 0; n + 1 < recv_disp.size(); ++n)
+    for (int k = recv_disp[n]; k < recv_disp[n + 1]; ++k)
+      ghost_owner.emplace_back(recv_idx[2 * k], dest1[n]);
+  std::ranges::sort(ghost_owner);
+  auto [last, end] = std::ranges::unique(ghost_owner);
+  ghost_owner.erase(last, end);
+
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  std::array<std::vector<int>, 2> src_dest;
+  for (auto [g, r] : ghost_owner)
+  {
+    ghosts.push_back(g);
+    owners.push_back(r);
+  }
+  src_dest[0] = owners;
+  std::ranges::sort(src_dest[0]);
+  auto [last0, end0] = std::ranges::unique(src_dest[0]);
+  src_dest[0].erase(last0, end0);
+  for (std::size_t n = 0; n < src1.size(); ++n)
+    if (send_disp[n + 1] > send_disp[n])
+      src_dest[1].push_back(src1[n]);
+  auto mapT1 = std::make_shared<common::IndexMap>(map0->comm(), num_rows,
+                                                  src_dest, ghosts, owners);
+
+  // Entries (row, column, value) of the transpose, in owned rows
+  const std::int32_t num_rows_t = num_cols + map1->num_ghosts();
+  std::vector<std::int64_t> row_ptr_t(num_rows_t + 1, 0);
+  for (std::int32_t i = 0; i < num_rows; ++i)
+    for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+      if (cols[p] < num_cols)
+        ++row_ptr_t[cols[p] + 1];
+  for (std::size_t k = 0; k < recv_values.size(); ++k)
+    ++row_ptr_t[recv_idx[2 * k + 1] - col_offset + 1];
+  std::partial_sum(row_ptr_t.begin(), row_ptr_t.end(), row_ptr_t.begin());
+
+  std::vector<std::int64_t> cols_global(row_ptr_t.back());
+  std::vector<T> values_t(row_ptr_t.back());
+  {
+    std::vector<std::int64_t> insert_pos(row_ptr_t.begin(),
+                                         std::prev(row_ptr_t.end()));
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+      {
+        if (std::int32_t c = cols[p]; c < num_cols)
+        {
+          std::int64_t pos = insert_pos[c]++;
+          cols_global[pos] = row_offset + i;
+          values_t[pos] = values[p];
+        }
+      }
+    }
+    for (std::size_t k = 0; k < recv_values.size(); ++k)
+    {
+      std::int64_t pos = insert_pos[recv_idx[2 * k + 1] - col_offset]++;
+      cols_global[pos] = recv_idx[2 * k];
+      values_t[pos] = recv_values[k];
+    }
+  }
+
+  // Sort the (local) columns of each row
+  std::vector<std::int32_t> cols_t(cols_global.size());
+  mapT1->global_to_local(cols_global, cols_t);
+  std::vector<std::pair<std::int32_t, T>> row;
+  for (std::int32_t i = 0; i < num_cols; ++i)
+  {
+    row.clear();
+    for (auto p = row_ptr_t[i]; p < row_ptr_t[i + 1]; ++p)
+      row.emplace_back(cols_t[p], values_t[p]);
+    std::ranges::sort(row, {}, [](auto& e) { return e.first; });
+    for (std::size_t j = 0; j < row.size(); ++j)
+    {
+      cols_t[row_ptr_t[i] + j] = row[j].first;
+      values_t[row_ptr_t[i] + j] = row[j].second;
+    }
+  }
+
+  return MatrixCSR<T>({map1, mapT1}, {1, 1}, std::move(cols_t),
+                      std::move(row_ptr_t), std::move(values_t));
+}
+
+/// @brief Distributed sparse matrix-matrix product `C = A B`.
+///
+/// The product is computed in two phases. The constructor computes the
+/// sparsity pattern of `C` (symbolic phase), which requires the rows of
+/// `B` for the ghost columns of `A` to be received from their owners.
+/// MatrixProduct::compute computes the values of `C` (numeric phase),
+/// and sends only the values of these rows. When a product is computed
+/// repeatedly for matrices with the same sparsity patterns, e.g. for a
+/// Galerkin product in a multigrid setup or a time-dependent operator,
+/// the symbolic phase is performed only once.
+///
+/// The row index map of `C` is the row index map of `A`. The owned
+/// columns of `C` are the owned columns of `B`, and the ghost columns
+/// are all columns of `B` that appear in the rows of `B` used on a
+/// rank and are not owned.
+///
+/// @tparam T Scalar type.
+template <typename T>
+class MatrixProduct
+{
+public:
+  /// @brief Compute the sparsity pattern of `A B`.
+  ///
+  /// @note Collective MPI operation
+  /// @param[in] A Matrix. Must have a block size of 1.
+  /// @param[in] B Matrix. Must have a block size of 1, and the owned
+  /// rows of `B` must be the owned columns of `A`.
+  MatrixProduct(const MatrixCSR<T>& A, const MatrixCSR<T>& B)
+      : _num_entries({A.cols().size(), B.cols().size()}),
+        _comm(MPI_COMM_NULL)
+  {
+    if (A.block_size() != std::array{1, 1}
+        or B.block_size() != std::array{1, 1})
+    {
+      throw std::runtime_error("Matrix product requires a block size of 1.");
+    }
+
+    std::shared_ptr<const common::IndexMap> mapA1 = A.index_map(1);
+    std::shared_ptr<const common::IndexMap> mapB0 = B.index_map(0);
+    std::shared_ptr<const common::IndexMap> mapB1 = B.index_map(1);
+    if (mapA1->local_range() != mapB0->local_range())
+    {
+      throw std::runtime_error(
+          "Owned columns of A do not match the owned rows of B.");
+    }
+
+    // Rows of B for the ghost columns of A are requested from the
+    // owners (src), which reply with the rows
+    std::span src = mapA1->src();
+    std::span dest = mapA1->dest();
+    dolfinx::MPI::Comm comm_req
+        = impl::create_neighbor_comm(mapA1->comm(), dest, src);
+    _comm = impl::create_neighbor_comm(mapA1->comm(), src, dest);
+
+    std::span ghosts = mapA1->ghosts();
+    std::vector<int> ghost_to_nbr = impl::ghost_owner_positions(*mapA1);
+    std::vector<int> req_disp(src.size() + 1, 0);
+    for (int n : ghost_to_nbr)
+      ++req_disp[n + 1];
+    std::partial_sum(req_disp.begin(), req_disp.end(), req_disp.begin());
+
+    std::vector<std::int64_t> req_rows(ghosts.size());
+    _ghost_to_remote.resize(ghosts.size());
+    {
+      std::vector<int> insert_pos = req_disp;
+      for (std::size_t i = 0; i < ghosts.size(); ++i)
+      {
+        int pos = insert_pos[ghost_to_nbr[i]]++;
+        req_rows[pos] = ghosts[i];
+        _ghost_to_remote[i] = pos;
+      }
+    }
+
+    std::vector<int> send_row_disp
+        = impl::recv_displacements(comm_req.comm(), req_disp);
+    std::vector<std::int64_t> send_rows = impl::neighbor_alltoallv<
+        std::int64_t>(comm_req.comm(), req_rows, req_disp, send_row_disp);
+
+    // Rows of B to send to each rank (local row indices)
+    const std::int64_t row_offset = mapB0->local_range()[0];
+    _send_rows.reserve(send_rows.size());
+    for (std::int64_t r : send_rows)
+      _send_rows.push_back(r - row_offset);
+
+    // Send the number of entries in each requested row
+    const auto& b_cols = B.cols();
+    const auto& b_row_ptr = B.row_ptr();
+    std::vector<std::int32_t> send_row_sizes;
+    _send_disp.assign(send_row_disp.size(), 0);
+    for (std::size_t n = 0; n + 1 < send_row_disp.size(); ++n)
+    {
+      for (int k = send_row_disp[n]; k < send_row_disp[n + 1]; ++k)
+      {
+        std::int32_t r = _send_rows[k];
+        send_row_sizes.push_back(b_row_ptr[r + 1] - b_row_ptr[r]);
+        _send_disp[n + 1] += send_row_sizes.back();
+      }
+    }
+    std::partial_sum(_send_disp.begin(), _send_disp.end(),
+                     _send_disp.begin());
+    std::vector<std::int32_t> recv_row_sizes
+        = impl::neighbor_alltoallv<std::int32_t>(_comm.comm(), send_row_sizes,
+                                                 send_row_disp, req_disp);
+
+    _remote_row_ptr.resize(recv_row_sizes.size() + 1, 0);
+    std::partial_sum(recv_row_sizes.begin(), recv_row_sizes.end(),
+                     std::next(_remote_row_ptr.begin()));
+    _recv_disp.resize(req_disp.size());
+    std::ranges::transform(req_disp, _recv_disp.begin(),
+                           [this](int d) { return _remote_row_ptr[d]; });
+
+    // Send the global column indices and their owners of the requested
+    // rows
+    const int rank = dolfinx::MPI::rank(mapB1->comm());
+    const std::int32_t num_cols_b = mapB1->size_local();
+    std::span owners_b = mapB1->owners();
+    std::vector<std::int32_t> send_cols_local;
+    std::vector<int> send_owners;
+    for (std::int32_t r : _send_rows)
+    {
+      for (auto p = b_row_ptr[r]; p < b_row_ptr[r + 1]; ++p)
+      {
+        std::int32_t c = b_cols[p];
+        send_cols_local.push_back(c);
+        send_owners.push_back(c < num_cols_b ? rank
+                                             : owners_b[c - num_cols_b]);
+      }
+    }
+    std::vector<std::int64_t> send_cols(send_cols_local.size());
+    mapB1->local_to_global(send_cols_local, send_cols);
+    std::vector<std::int64_t> recv_cols = impl::neighbor_alltoallv<
+        std::int64_t>(_comm.comm(), send_cols, _send_disp, _recv_disp);
+    std::vector<int> recv_owners = impl::neighbor_alltoallv<int>(
+        _comm.comm(), send_owners, _send_disp, _recv_disp);
+
+    // Ghost columns of C are the ghost columns of B and the columns of
+    // the received rows that are not owned
+    const std::array range = mapB1->local_range();
+    std::vector<std::pair<std::int64_t, int>> ghost_owner;
+    for (std::size_t i = 0; i < mapB1->ghosts().size(); ++i)
+      ghost_owner.emplace_back(mapB1->ghosts()[i], owners_b[i]);
+    for (std::size_t k = 0; k < recv_cols.size(); ++k)
+      if (recv_cols[k] < range[0] or recv_cols[k] >= range[1])
+        ghost_owner.emplace_back(recv_cols[k], recv_owners[k]);
+    std::ranges::sort(ghost_owner);
+    auto [last, end] = std::ranges::unique(ghost_owner);
+    ghost_owner.erase(last, end);
+    std::vector<std::int64_t> ghosts_c;
+    std::vector<int> owners_c;
+    for (auto [g, r] : ghost_owner)
+    {
+      ghosts_c.push_back(g);
+      owners_c.push_back(r);
+    }
+    std::shared_ptr<const common::IndexMap> mapC1
+        = std::make_shared<common::IndexMap>(mapB1->comm(), num_cols_b,
+                                             ghosts_c, owners_c);
+
+    // Map the columns of B and of the received rows to columns of C
+    {
+      std::vector<std::int64_t> global(num_cols_b + mapB1->num_ghosts());
+      std::iota(global.begin(), std::next(global.begin(), num_cols_b),
+                range[0]);
+      std::ranges::copy(mapB1->ghosts(),
+                        std::next(global.begin(), num_cols_b));
+      std::vector<std::int32_t> b_to_c(global.size());
+      mapC1->global_to_local(global, b_to_c);
+      _b_cols.reserve(b_cols.size());
+      for (std::int32_t c : b_cols)
+        _b_cols.push_back(b_to_c[c]);
+    }
+    _remote_cols.resize(recv_cols.size());
+    mapC1->global_to_local(recv_cols, _remote_cols);
+    _remote_values.resize(recv_cols.size());
+
+    // The pattern of a row of C is the union of the patterns of the
+    // rows of B for the columns of the row of A
+    std::shared_ptr<const common::IndexMap> mapA0 = A.index_map(0);
+    const std::int32_t num_rows = mapA0->size_local();
+    std::vector<std::int32_t> marker(
+        mapC1->size_local() + mapC1->num_ghosts(), -1);
+    std::vector<std::int32_t> cols;
+    std::vector<std::int64_t> row_ptr(1, 0);
+    row_ptr.reserve(num_rows + mapA0->num_ghosts() + 1);
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      for (auto p = A.row_ptr()[i]; p < A.row_ptr()[i + 1]; ++p)
+      {
+        for (std::int32_t c : b_row(B, A.cols()[p]).first)
+        {
+          if (marker[c] != i)
+          {
+            marker[c] = i;
+            cols.push_back(c);
+          }
+        }
+      }
+      std::sort(std::next(cols.begin(), row_ptr.back()), cols.end());
+      row_ptr.push_back(cols.size());
+    }
+    row_ptr.resize(num_rows + mapA0->num_ghosts() + 1, row_ptr.back());
+
+    std::vector<T> values(cols.size(), 0);
+    _C.emplace(std::array{mapA0, mapC1}, std::array{1, 1}, std::move(cols),
+               std::move(row_ptr), std::move(values));
+  }
+
+  /// @brief Compute the values of `C = A B`.
+  ///
+  /// @note Collective MPI operation
+  /// @param[in] A Matrix with the same sparsity pattern and index maps
+  /// as the matrix `A` used to create the product.
+  /// @param[in] B Matrix with the same sparsity pattern and index maps
+  /// as the matrix `B` used to create the product.
+  void compute(const MatrixCSR<T>& A, const MatrixCSR<T>& B)
+  {
+    if (A.cols().size() != _num_entries[0]
+        or B.cols().size() != _num_entries[1])
+    {
+      throw std::runtime_error(
+          "Sparsity pattern of matrix product operands has changed.");
+    }
+
+    // Receive the values of the rows of B for the ghost columns of A
+    const auto& b_row_ptr = B.row_ptr();
+    const auto& b_values = B.values();
+    std::vector<T> send_values;
+    send_values.reserve(_send_disp.back());
+    for (std::int32_t r : _send_rows)
+    {
+      send_values.insert(send_values.end(),
+                         std::next(b_values.begin(), b_row_ptr[r]),
+                         std::next(b_values.begin(), b_row_ptr[r + 1]));
+    }
+    _remote_values = impl::neighbor_alltoallv<T>(_comm.comm(), send_values,
+                                                  _send_disp, _recv_disp);
+
+    // Accumulate the products in each row of C, finding the position of
+    // a column in the row with a dense marker
+    MatrixCSR<T>& C = *_C;
+    const auto& cols = C.cols();
+    const auto& row_ptr = C.row_ptr();
+    auto& values = C.values();
+    const std::int32_t num_rows = C.index_map(0)->size_local();
+    std::vector<std::int64_t> pos(
+        C.index_map(1)->size_local() + C.index_map(1)->num_ghosts(), -1);
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      for (auto p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+      {
+        pos[cols[p]] = p;
+        values[p] = 0;
+      }
+
+      for (auto p = A.row_ptr()[i]; p < A.row_ptr()[i + 1]; ++p)
+      {
+        const T a = A.values()[p];
+        auto [b_cols, b_values] = b_row(B, A.cols()[p]);
+        for (std::size_t j = 0; j < b_cols.size(); ++j)
+          values[pos[b_cols[j]]] += a * b_values[j];
+      }
+    }
+  }
+
+  /// @brief The product matrix `C`.
+  MatrixCSR<T>& matrix() { return *_C; }
+
+  /// @brief The product matrix `C` (const version).
+  const MatrixCSR<T>& matrix() const { return *_C; }
+
+private:
+  // Columns (of C) and values of the row of B for column k of A
+  std::pair<std::span<const std::int32_t>, std::span<const T>>
+  b_row(const MatrixCSR<T>& B, std::int32_t k) const
+  {
+    const std::int32_t num_owned = B.index_map(0)->size_local();
+    if (k < num_owned)
+    {
+      std::size_t offset = B.row_ptr()[k];
+      std::size_t size = B.row_ptr()[k + 1] - offset;
+      return {std::span(_b_cols).subspan(offset, size),
+              std::span(B.values()).subspan(offset, size)};
+    }
+    else
+    {
+      std::int32_t r = _ghost_to_remote[k - num_owned];
+      std::size_t offset = _remote_row_ptr[r];
+      std::size_t size = _remote_row_ptr[r + 1] - offset;
+      return {std::span(_remote_cols).subspan(offset, size),
+              std::span(_remote_values).subspan(offset, size)};
+    }
+  }
+
+  // Number of entries of A and B
+  std::array<std::size_t, 2> _num_entries;
+
+  // Neighbourhood communicator (owner of a row of B -> rank that
+  // requires it)
+  dolfinx::MPI::Comm _comm;
+
+  // Local rows of B sent to each neighbour, and displacements of the
+  // values of the rows sent to and received from each neighbour
+  std::vector<std::int32_t> _send_rows;
+  std::vector<int> _send_disp, _recv_disp;
+
+  // Position of the row of B for each ghost column of A in the received
+  // rows
+  std::vector<std::int32_t> _ghost_to_remote;
+
+  // Received rows of B: offsets, column indices of C, and values
+  std::vector<std::int64_t> _remote_row_ptr;
+  std::vector<std::int32_t> _remote_cols;
+  std::vector<T> _remote_values;
+
+  // Column of C of each entry of B
+  std::vector<std::int32_t> _b_cols;
+
+  // Product matrix
+  std::optional<MatrixCSR<T>> _C;
+};
+
+/// @brief Compute the distributed sparse matrix-matrix product `C = A
+/// B`.
+///
+/// For repeated products of matrices with the same sparsity patterns,
+/// use MatrixProduct to avoid recomputing the sparsity pattern of `C`.
+///
+/// @note Collective MPI operation
+/// @param[in] A Matrix. Must have a block size of 1.
+/// @param[in] B Matrix. Must have a block size of 1, and the owned rows
+/// of `B` must be the owned columns of `A`.
+/// @return The product `A B`.
+template <typename T>
+MatrixCSR<T> matrix_product(const MatrixCSR<T>& A, const MatrixCSR<T>& B)
+{
+  MatrixProduct<T> product(A, B);
+  product.compute(A, B);
+  return std::move(product.matrix());
+}
+
+} // namespace dolfinx::la
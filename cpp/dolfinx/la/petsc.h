@@ -9,16 +9,22 @@
 
 #ifdef HAS_PETSC
 
+#include "MatrixCSR.h"
 #include "Vector.h"
 #include "utils.h"
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
 #include <functional>
+#include <memory>
 #include <petscksp.h>
 #include <petscmat.h>
 #include <petscoptions.h>
 #include <petscvec.h>
 #include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace dolfinx::common
@@ -127,6 +133,205 @@ Mat create_matrix(MPI_Comm comm, const SparsityPattern& sp,
 /// @return A PETSc nullspace object
 MatNullSpace create_nullspace(MPI_Comm comm, std::span<const Vec> basis);
 
+namespace impl
+{
+/// @brief Attach an object to a PETSc object such that the object is
+/// destroyed when the PETSc object is destroyed.
+/// @param[in] obj The PETSc object.
+/// @param[in] name Name of the attached object.
+/// @param[in] data The object to attach.
+template <typename T>
+void compose(PetscObject obj, const char* name, std::unique_ptr<T> data)
+{
+  PetscContainer c;
+  PetscErrorCode ierr = PetscContainerCreate(PetscObjectComm(obj), &c);
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "PetscContainerCreate");
+  PetscContainerSetPointer(c, data.release());
+#if PETSC_VERSION_LT(3, 23, 0)
+  PetscContainerSetUserDestroy(c,
+                               [](void* ptr) -> PetscErrorCode
+                               {
+                                 delete static_cast<T*>(ptr);
+                                 return 0;
+                               });
+#else
+  PetscContainerSetCtxDestroy(c,
+                              [](void** ptr) -> PetscErrorCode
+                              {
+                                delete static_cast<T*>(*ptr);
+                                return 0;
+                              });
+#endif
+  PetscObjectCompose(obj, name, (PetscObject)c);
+  PetscContainerDestroy(&c);
+}
+} // namespace impl
+
+/// @brief Create a PETSc Mat that shares the entries of a MatrixCSR.
+///
+/// The matrix can then be assembled with the native DOLFINx assemblers
+/// and used with PETSc solvers without copying its entries. Changes to
+/// the entries of `A` are seen by the PETSc Mat. Call
+/// `PetscObjectStateIncrease` on the Mat after changing the entries so
+/// that PETSc (e.g. preconditioners) detects the change.
+///
+/// On one process, the Mat is a `MATSEQAIJ` that uses the entry array
+/// of `A` (and its column indices when these have type `PetscInt`).
+/// MatrixCSR stores the owned and ghost columns of a row contiguously,
+/// which differs from the split diagonal and off-diagonal blocks of
+/// `MATMPIAIJ`, so in parallel the Mat is a `MATSHELL` that applies
+/// MatrixCSR::mult and supports `MatGetDiagonal` (for a square
+/// matrix). This is suitable for matrix-free preconditioners, e.g.
+/// Jacobi or Chebyshev smoothing, but not for preconditioners that need
+/// the matrix entries.
+///
+/// @note `A` must outlive the returned Mat.
+/// @note The caller is responsible for destroying the returned object.
+/// @note Collective.
+///
+/// @param[in] A The matrix to share. Must have block size 1 (e.g.
+/// created with la::BlockMode::expanded) and the ghost row
+/// contributions must have been added with MatrixCSR::scatter_rev.
+/// @return A PETSc Mat that shares the entries of `A`.
+template <class Matrix>
+Mat create_matrix_view(Matrix& A)
+{
+  static_assert(std::is_same_v<typename Matrix::value_type, PetscScalar>,
+                "Matrix scalar type must be PetscScalar.");
+  if (A.block_size() != std::array{1, 1})
+    throw std::runtime_error("Matrix views require a block size of 1.");
+
+  auto map0 = A.index_map(0);
+  auto map1 = A.index_map(1);
+  MPI_Comm comm = map0->comm();
+  const PetscInt m = map0->size_local();
+  const PetscInt n = map1->size_local();
+
+  PetscErrorCode ierr;
+  Mat mat;
+  if (dolfinx::MPI::size(comm) == 1)
+  {
+    // Share the index arrays of A if the index types match PETSc, and
+    // otherwise attach copies to the Mat
+    struct Indices
+    {
+      std::vector<PetscInt> row_ptr, cols;
+    };
+    auto indices = std::make_unique<Indices>();
+    using R = typename Matrix::rowptr_container_type::value_type;
+    using C = typename Matrix::column_container_type::value_type;
+    PetscInt* row_ptr;
+    if constexpr (std::is_same_v<R, PetscInt>)
+      row_ptr = const_cast<PetscInt*>(A.row_ptr().data());
+    else
+    {
+      indices->row_ptr.assign(A.row_ptr().begin(),
+                              std::next(A.row_ptr().begin(), m + 1));
+      row_ptr = indices->row_ptr.data();
+    }
+    PetscInt* cols;
+    if constexpr (std::is_same_v<C, PetscInt>)
+      cols = const_cast<PetscInt*>(A.cols().data());
+    else
+    {
+      indices->cols.assign(A.cols().begin(),
+                           std::next(A.cols().begin(), A.row_ptr()[m]));
+      cols = indices->cols.data();
+    }
+
+    ierr = MatCreateSeqAIJWithArrays(comm, m, n, row_ptr, cols,
+                                     A.values().data(), &mat);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "MatCreateSeqAIJWithArrays");
+    impl::compose((PetscObject)mat, "dolfinx_matrix_view_indices",
+                  std::move(indices));
+  }
+  else
+  {
+    // Work vectors with ghost entries for the product
+    struct Context
+    {
+      Matrix* A;
+      la::Vector<PetscScalar> x, y;
+    };
+    auto ctx = std::make_unique<Context>(
+        &A, la::Vector<PetscScalar>(map1, 1), la::Vector<PetscScalar>(map0, 1));
+
+    ierr = MatCreateShell(comm, m, n, PETSC_DETERMINE, PETSC_DETERMINE,
+                          ctx.get(), &mat);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "MatCreateShell");
+
+    PetscErrorCode (*mult)(Mat, Vec, Vec)
+        = [](Mat mat, Vec x, Vec y) -> PetscErrorCode
+    {
+      Context* ctx;
+      MatShellGetContext(mat, &ctx);
+      const PetscScalar* _x;
+      VecGetArrayRead(x, &_x);
+      std::span<PetscScalar> xw = ctx->x.mutable_array();
+      std::copy_n(_x, ctx->x.index_map()->size_local(), xw.begin());
+      VecRestoreArrayRead(x, &_x);
+
+      try
+      {
+        ctx->y.set(0);
+        ctx->A->mult(ctx->x, ctx->y);
+      }
+      catch (const std::exception& e)
+      {
+        spdlog::error(e.what());
+        SETERRQ(PetscObjectComm((PetscObject)mat), PETSC_ERR_LIB,
+                "MatrixCSR::mult failed");
+      }
+
+      PetscScalar* _y;
+      VecGetArray(y, &_y);
+      std::copy_n(ctx->y.array().begin(), ctx->y.index_map()->size_local(),
+                  _y);
+      VecRestoreArray(y, &_y);
+      return 0;
+    };
+
+    PetscErrorCode (*diagonal)(Mat, Vec)
+        = [](Mat mat, Vec d) -> PetscErrorCode
+    {
+      Context* ctx;
+      MatShellGetContext(mat, &ctx);
+      const Matrix& A0 = *ctx->A;
+      if (A0.index_map(0)->local_range() != A0.index_map(1)->local_range())
+      {
+        SETERRQ(PetscObjectComm((PetscObject)mat), PETSC_ERR_SUP,
+                "Diagonal of a non-square matrix view");
+      }
+
+      // The diagonal entry of a row is in the owned columns
+      auto& row_ptr = A0.row_ptr();
+      auto& off_diag_offset = A0.off_diag_offset();
+      auto& cols = A0.cols();
+      PetscScalar* _d;
+      VecGetArray(d, &_d);
+      for (std::int32_t i = 0; i < A0.index_map(0)->size_local(); ++i)
+      {
+        auto begin = std::next(cols.begin(), row_ptr[i]);
+        auto end = std::next(cols.begin(), off_diag_offset[i]);
+        auto it = std::find(begin, end, i);
+        _d[i] = it == end ? 0 : A0.values()[std::distance(cols.begin(), it)];
+      }
+      VecRestoreArray(d, &_d);
+      return 0;
+    };
+
+    MatShellSetOperation(mat, MATOP_MULT, (void (*)(void))mult);
+    MatShellSetOperation(mat, MATOP_GET_DIAGONAL, (void (*)(void))diagonal);
+    impl::compose((PetscObject)mat, "dolfinx_matrix_view_context",
+                  std::move(ctx));
+  }
+
+  return mat;
+}
+
 /// These class provides static functions that permit users to set and
 /// retrieve PETSc options via the PETSc option/parameter system. The
 /// option must not be prefixed by '-', e.g.
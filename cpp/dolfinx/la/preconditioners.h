@@ -0,0 +1,409 @@
+// Copyright (C) 2024 Chris N. Richardson and Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Vector.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// @file preconditioners.h
+/// @brief Preconditioners that operate directly on la::MatrixCSR.
+///
+/// The preconditioners are local to each rank, i.e. they use only the
+/// diagonal block (owned rows and owned columns) of a distributed
+/// matrix, see la::MatrixCSR::off_diag_offset. A preconditioner `P` is
+/// applied by `P(r, z)`, which computes `z = M^{-1} r` on the owned
+/// entries of `z`. Ghost entries are not used or updated.
+
+namespace dolfinx::la
+{
+namespace impl
+{
+/// @brief Find the position of the diagonal block of each owned row of
+/// a square matrix.
+/// @param[in] A Matrix.
+/// @return Position in `A.cols()` of the diagonal entry of each owned
+/// (block) row.
+template <typename Mat>
+std::vector<std::int64_t> diagonal_positions(const Mat& A)
+{
+  if (A.block_size()[0] != A.block_size()[1])
+    throw std::runtime_error("Matrix blocks must be square.");
+
+  auto& row_ptr = A.row_ptr();
+  auto& cols = A.cols();
+  auto& off_diag = A.off_diag_offset();
+  const std::int32_t num_rows = A.num_owned_rows();
+  std::vector<std::int64_t> diag(num_rows);
+  for (std::int32_t i = 0; i < num_rows; ++i)
+  {
+    auto cit0 = std::next(cols.begin(), row_ptr[i]);
+    auto cit1 = std::next(cols.begin(), off_diag[i]);
+    auto it = std::lower_bound(cit0, cit1, i);
+    if (it == cit1 or *it != i)
+      throw std::runtime_error("Diagonal entry not in sparsity pattern.");
+    diag[i] = std::distance(cols.begin(), it);
+  }
+
+  return diag;
+}
+
+/// @brief Invert a dense square matrix in-place using Gauss-Jordan
+/// elimination with partial pivoting.
+/// @param[in,out] A Matrix (row-major) of shape `(n, n)`. It is
+/// replaced by its inverse.
+/// @param[in] n Number of rows of `A`.
+template <typename T>
+void invert_dense(std::span<T> A, int n)
+{
+  std::vector<int> perm(n);
+  for (int i = 0; i < n; ++i)
+    perm[i] = i;
+
+  for (int k = 0; k < n; ++k)
+  {
+    // Find pivot
+    int p = k;
+    for (int i = k + 1; i < n; ++i)
+      if (std::abs(A[i * n + k]) > std::abs(A[p * n + k]))
+        p = i;
+    if (A[p * n + k] == T(0))
+      throw std::runtime_error("Singular diagonal block.");
+    if (p != k)
+    {
+      std::swap_ranges(std::next(A.begin(), k * n),
+                       std::next(A.begin(), (k + 1) * n),
+                       std::next(A.begin(), p * n));
+      std::swap(perm[k], perm[p]);
+    }
+
+    // Eliminate column k from all other rows
+    const T inv_pivot = T(1) / A[k * n + k];
+    A[k * n + k] = T(1);
+    for (int j = 0; j < n; ++j)
+      A[k * n + j] *= inv_pivot;
+    for (int i = 0; i < n; ++i)
+    {
+      if (i == k)
+        continue;
+      const T f = A[i * n + k];
+      A[i * n + k] = T(0);
+      for (int j = 0; j < n; ++j)
+        A[i * n + j] -= f * A[k * n + j];
+    }
+  }
+
+  // Undo the row permutation by permuting the columns of the inverse
+  std::vector<T> row(n);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+      row[perm[j]] = A[i * n + j];
+    std::ranges::copy(row, std::next(A.begin(), i * n));
+  }
+}
+
+/// @brief Group rows into levels for a triangular solve.
+///
+/// The level of a row is one more than the highest level of the rows
+/// it depends on, such that all rows in a level can be solved
+/// concurrently once the previous levels have been solved.
+///
+/// @param[in] row_begin First entry of each row to consider.
+/// @param[in] row_end One past the last entry of each row to consider.
+/// @param[in] cols Column indices.
+/// @param[in] reverse If true, rows are visited in reverse order
+/// (upper triangular solve).
+/// @return Rows (links) in each level (node).
+inline graph::AdjacencyList<std::int32_t>
+level_schedule(std::span<const std::int64_t> row_begin,
+               std::span<const std::int64_t> row_end,
+               std::span<const std::int32_t> cols, bool reverse)
+{
+  const std::int32_t n = row_begin.size();
+  std::vector<std::int32_t> level(n, 0);
+  std::int32_t num_levels = 0;
+  for (std::int32_t k = 0; k < n; ++k)
+  {
+    const std::int32_t i = reverse ? n - 1 - k : k;
+    std::int32_t l = 0;
+    for (std::int64_t j = row_begin[i]; j < row_end[i]; ++j)
+      l = std::max(l, level[cols[j]] + 1);
+    level[i] = l;
+    num_levels = std::max(num_levels, l + 1);
+  }
+
+  std::vector<std::int32_t> offsets(num_levels + 1, 0);
+  for (std::int32_t l : level)
+    ++offsets[l + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<std::int32_t> rows(n);
+  std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+  for (std::int32_t i = 0; i < n; ++i)
+    rows[pos[level[i]]++] = i;
+
+  return graph::AdjacencyList(std::move(rows), std::move(offsets));
+}
+} // namespace impl
+
+/// @brief Point Jacobi preconditioner, `M = diag(A)`.
+/// @tparam Mat Matrix type, e.g. la::MatrixCSR.
+template <typename Mat>
+class JacobiPreconditioner
+{
+public:
+  /// Scalar type
+  using value_type = typename Mat::value_type;
+
+  /// @brief Create a point Jacobi preconditioner.
+  /// @param[in] A Square matrix. All diagonal entries must be in the
+  /// sparsity pattern and be non-zero.
+  explicit JacobiPreconditioner(const Mat& A)
+  {
+    const int bs = A.block_size()[0];
+    std::vector<std::int64_t> diag = impl::diagonal_positions(A);
+    _dinv.resize(diag.size() * bs);
+    for (std::size_t i = 0; i < diag.size(); ++i)
+    {
+      for (int k = 0; k < bs; ++k)
+      {
+        value_type d = A.values()[(diag[i] * bs + k) * bs + k];
+        if (d == value_type(0))
+          throw std::runtime_error("Zero diagonal entry.");
+        _dinv[i * bs + k] = value_type(1) / d;
+      }
+    }
+  }
+
+  /// @brief Apply the preconditioner, `z = M^{-1} r`.
+  /// @param[in] r Input vector.
+  /// @param[in,out] z Output vector. Only owned entries are set.
+  void operator()(const Vector<value_type>& r, Vector<value_type>& z) const
+  {
+    std::span<const value_type> _r = r.array();
+    std::span<value_type> _z = z.mutable_array();
+    impl::for_each_index(_dinv.size(), [_r, _z, dinv = std::span(_dinv)](
+                                           std::size_t i)
+                         { _z[i] = dinv[i] * _r[i]; });
+  }
+
+private:
+  // Inverse of the diagonal
+  std::vector<value_type> _dinv;
+};
+
+/// @brief Block Jacobi preconditioner, where `M` is the block diagonal
+/// of `A` with the block size of the matrix.
+///
+/// For a matrix with block size one this is the point Jacobi
+/// preconditioner.
+///
+/// @tparam Mat Matrix type, e.g. la::MatrixCSR.
+template <typename Mat>
+class BlockJacobiPreconditioner
+{
+public:
+  /// Scalar type
+  using value_type = typename Mat::value_type;
+
+  /// @brief Create a block Jacobi preconditioner.
+  /// @param[in] A Square matrix with square blocks. All diagonal
+  /// blocks must be in the sparsity pattern and be non-singular.
+  explicit BlockJacobiPreconditioner(const Mat& A) : _bs(A.block_size()[0])
+  {
+    std::vector<std::int64_t> diag = impl::diagonal_positions(A);
+    const int nbs = _bs * _bs;
+    _dinv.resize(diag.size() * nbs);
+    for (std::size_t i = 0; i < diag.size(); ++i)
+    {
+      std::span<value_type> Dinv(_dinv.data() + i * nbs, nbs);
+      std::copy_n(std::next(A.values().begin(), diag[i] * nbs), nbs,
+                  Dinv.begin());
+      impl::invert_dense(Dinv, _bs);
+    }
+  }
+
+  /// @brief Apply the preconditioner, `z = M^{-1} r`.
+  /// @param[in] r Input vector.
+  /// @param[in,out] z Output vector. Only owned entries are set.
+  void operator()(const Vector<value_type>& r, Vector<value_type>& z) const
+  {
+    std::span<const value_type> _r = r.array();
+    std::span<value_type> _z = z.mutable_array();
+    const int bs = _bs;
+    impl::for_each_index(
+        _dinv.size() / (bs * bs),
+        [_r, _z, bs, dinv = std::span(_dinv)](std::size_t i)
+        {
+          const value_type* Dinv = dinv.data() + i * bs * bs;
+          for (int k0 = 0; k0 < bs; ++k0)
+          {
+            value_type zi = 0;
+            for (int k1 = 0; k1 < bs; ++k1)
+              zi += Dinv[k0 * bs + k1] * _r[i * bs + k1];
+            _z[i * bs + k0] = zi;
+          }
+        });
+  }
+
+private:
+  // Block size
+  int _bs;
+
+  // Inverse of the diagonal blocks
+  std::vector<value_type> _dinv;
+};
+
+/// @brief Incomplete LU factorization with zero fill-in (ILU(0)) of
+/// the diagonal block of a matrix.
+///
+/// The factors have the sparsity of the diagonal block. The triangular
+/// solves are level scheduled, i.e. rows are grouped into levels which
+/// only depend on rows in previous levels, and the rows in each level
+/// are solved concurrently (see la::impl::for_each_index).
+///
+/// @note The matrix must have block size one, e.g. a blocked matrix
+/// must be created with la::BlockMode::expanded.
+///
+/// @tparam Mat Matrix type, e.g. la::MatrixCSR.
+template <typename Mat>
+class ILU0Preconditioner
+{
+public:
+  /// Scalar type
+  using value_type = typename Mat::value_type;
+
+  /// @brief Compute the ILU(0) factorization.
+  /// @param[in] A Square matrix. All diagonal entries must be in the
+  /// sparsity pattern, and the pivots of the factorization must be
+  /// non-zero.
+  explicit ILU0Preconditioner(const Mat& A)
+      : _lower_levels(0), _upper_levels(0)
+  {
+    if (A.block_size()[0] != 1 or A.block_size()[1] != 1)
+      throw std::runtime_error("ILU(0) requires a matrix with block size 1.");
+
+    // Copy the diagonal block
+    std::vector<std::int64_t> diag = impl::diagonal_positions(A);
+    auto& row_ptr = A.row_ptr();
+    auto& off_diag = A.off_diag_offset();
+    const std::int32_t n = A.num_owned_rows();
+    _row_ptr.resize(n + 1, 0);
+    _diag.resize(n);
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      _row_ptr[i + 1] = _row_ptr[i] + (off_diag[i] - row_ptr[i]);
+      _diag[i] = _row_ptr[i] + (diag[i] - row_ptr[i]);
+      _cols.insert(_cols.end(), std::next(A.cols().begin(), row_ptr[i]),
+                   std::next(A.cols().begin(), off_diag[i]));
+      _values.insert(_values.end(), std::next(A.values().begin(), row_ptr[i]),
+                     std::next(A.values().begin(), off_diag[i]));
+    }
+
+    // Factorize (IKJ variant). 'pos' maps a column to its position in
+    // the current row, or -1.
+    std::vector<std::int64_t> pos(n, -1);
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      for (std::int64_t j = _row_ptr[i]; j < _row_ptr[i + 1]; ++j)
+        pos[_cols[j]] = j;
+
+      for (std::int64_t kk = _row_ptr[i]; kk < _diag[i]; ++kk)
+      {
+        const std::int32_t k = _cols[kk];
+        if (_values[_diag[k]] == value_type(0))
+          throw std::runtime_error("Zero pivot in ILU(0) factorization.");
+        _values[kk] /= _values[_diag[k]];
+        for (std::int64_t j = _diag[k] + 1; j < _row_ptr[k + 1]; ++j)
+        {
+          if (std::int64_t p = pos[_cols[j]]; p >= 0)
+            _values[p] -= _values[kk] * _values[j];
+        }
+      }
+
+      for (std::int64_t j = _row_ptr[i]; j < _row_ptr[i + 1]; ++j)
+        pos[_cols[j]] = -1;
+    }
+
+    if (std::ranges::any_of(_diag, [this](auto d)
+                            { return _values[d] == value_type(0); }))
+    {
+      throw std::runtime_error("Zero pivot in ILU(0) factorization.");
+    }
+
+    // Levels for the lower and upper triangular solves
+    std::span<const std::int64_t> rp(_row_ptr);
+    std::span<const std::int64_t> dp(_diag);
+    std::vector<std::int64_t> diag1(n);
+    std::ranges::transform(_diag, diag1.begin(), [](auto d) { return d + 1; });
+    _lower_levels = impl::level_schedule(rp.first(n), dp, _cols, false);
+    _upper_levels = impl::level_schedule(diag1, rp.last(n), _cols, true);
+  }
+
+  /// @brief Apply the preconditioner, `z = (LU)^{-1} r`.
+  /// @param[in] r Input vector.
+  /// @param[in,out] z Output vector. Only owned entries are set.
+  void operator()(const Vector<value_type>& r, Vector<value_type>& z) const
+  {
+    std::span<const value_type> _r = r.array();
+    std::span<value_type> _z = z.mutable_array();
+    std::span<const std::int64_t> row_ptr(_row_ptr), diag(_diag);
+    std::span<const std::int32_t> cols(_cols);
+    std::span<const value_type> values(_values);
+
+    // Forward substitution, L y = r (L has a unit diagonal)
+    for (std::int32_t l = 0; l < _lower_levels.num_nodes(); ++l)
+    {
+      std::span<const std::int32_t> rows = _lower_levels.links(l);
+      impl::for_each_index(
+          rows.size(),
+          [rows, row_ptr, diag, cols, values, _r, _z](std::size_t k)
+          {
+            const std::int32_t i = rows[k];
+            value_type yi = _r[i];
+            for (std::int64_t j = row_ptr[i]; j < diag[i]; ++j)
+              yi -= values[j] * _z[cols[j]];
+            _z[i] = yi;
+          });
+    }
+
+    // Backward substitution, U z = y
+    for (std::int32_t l = 0; l < _upper_levels.num_nodes(); ++l)
+    {
+      std::span<const std::int32_t> rows = _upper_levels.links(l);
+      impl::for_each_index(
+          rows.size(),
+          [rows, row_ptr, diag, cols, values, _z](std::size_t k)
+          {
+            const std::int32_t i = rows[k];
+            value_type zi = _z[i];
+            for (std::int64_t j = diag[i] + 1; j < row_ptr[i + 1]; ++j)
+              zi -= values[j] * _z[cols[j]];
+            _z[i] = zi / values[diag[i]];
+          });
+    }
+  }
+
+private:
+  // Factors (CSR, strict lower part is L and upper part is U)
+  std::vector<std::int64_t> _row_ptr, _diag;
+  std::vector<std::int32_t> _cols;
+  std::vector<value_type> _values;
+
+  // Rows in each level of the lower and upper triangular solves
+  graph::AdjacencyList<std::int32_t> _lower_levels, _upper_levels;
+};
+
+} // namespace dolfinx::la
@@ -11,8 +11,10 @@
 #include "utils.h"
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <algorithm>
 #include <petscmat.h>
 #include <slepcversion.h>
+#include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::la;
@@ -55,9 +57,82 @@ SLEPcEigenSolver& SLEPcEigenSolver::operator=(SLEPcEigenSolver&& solver)
 void SLEPcEigenSolver::set_operators(const Mat A, const Mat B)
 {
   assert(_eps);
+
+  // Setting the operators resets the spectral transformation, so skip
+  // if they are unchanged
+  PetscInt num_mat = 0;
+  ST st;
+  EPSGetST(_eps, &st);
+  STGetNumMatrices(st, &num_mat);
+  if (num_mat > 0)
+  {
+    Mat A0 = nullptr, B0 = nullptr;
+    EPSGetOperators(_eps, &A0, &B0);
+    if (A0 == A and B0 == B)
+      return;
+  }
+
   EPSSetOperators(_eps, A, B);
 }
 //-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_reuse_factorization(bool reuse)
+{
+  assert(_eps);
+  ST st;
+  EPSGetST(_eps, &st);
+  KSP ksp;
+  STGetKSP(st, &ksp);
+  KSPSetReusePreconditioner(ksp, reuse ? PETSC_TRUE : PETSC_FALSE);
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_initial_space(std::span<const Vec> x)
+{
+  assert(_eps);
+  std::vector<Vec> _x(x.begin(), x.end());
+  PetscErrorCode ierr = EPSSetInitialSpace(_eps, _x.size(), _x.data());
+  if (ierr != 0)
+    petsc::error(ierr, __FILE__, "EPSSetInitialSpace");
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::set_initial_space_from_solution(std::int64_t n)
+{
+  assert(_eps);
+  std::int64_t num_conv = get_number_converged();
+  if (n >= 0)
+    num_conv = std::min(num_conv, n);
+  if (num_conv == 0)
+    return;
+
+  Mat A, B;
+  EPSGetOperators(_eps, &A, &B);
+  std::vector<Vec> x(num_conv);
+  for (auto& v : x)
+    MatCreateVecs(A, &v, nullptr);
+  get_eigenvectors(x);
+
+  // The initial space keeps a copy of the vectors
+  set_initial_space(x);
+  for (auto& v : x)
+    VecDestroy(&v);
+}
+//-----------------------------------------------------------------------------
+void SLEPcEigenSolver::get_eigenvectors(std::span<Vec> x) const
+{
+  assert(_eps);
+  if (static_cast<std::int64_t>(x.size()) > get_number_converged())
+  {
+    throw std::runtime_error("Requested eigenvectors have not been "
+                             "computed");
+  }
+
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    PetscErrorCode ierr = EPSGetEigenvector(_eps, i, x[i], nullptr);
+    if (ierr != 0)
+      petsc::error(ierr, __FILE__, "EPSGetEigenvector");
+  }
+}
+//-----------------------------------------------------------------------------
 void SLEPcEigenSolver::solve()
 {
   // Get operators
@@ -83,9 +158,13 @@ void SLEPcEigenSolver::solve(std::int64_t n)
   assert(n <= _n);
 #endif
 
-  // Set number of eigenpairs to compute
+  // Set number of eigenpairs to compute. Changing the dimensions
+  // resets the solver, so only set if changed.
   assert(_eps);
-  EPSSetDimensions(_eps, n, PETSC_DECIDE, PETSC_DECIDE);
+  PetscInt nev = 0, ncv = 0, mpd = 0;
+  EPSGetDimensions(_eps, &nev, &ncv, &mpd);
+  if (nev != n)
+    EPSSetDimensions(_eps, n, PETSC_DECIDE, PETSC_DECIDE);
 
   // Set any options from the PETSc database
   EPSSetFromOptions(_eps);
@@ -13,6 +13,7 @@
 #include <petscmat.h>
 #include <petscvec.h>
 #include <slepceps.h>
+#include <span>
 #include <string>
 
 namespace dolfinx::la
@@ -44,10 +45,42 @@ public:
   /// Move assignment
   SLEPcEigenSolver& operator=(SLEPcEigenSolver&& solver);
 
-  /// Set operators (B may be nullptr for regular eigenvalues
-  /// problems)
+  /// @brief Set operators (B may be nullptr for regular eigenvalues
+  /// problems).
+  ///
+  /// If `A` and `B` are the operators that are already set, the solver
+  /// is not reset. The spectral transformation (e.g. the factorization
+  /// of \f$A - \sigma B\f$ for shift-and-invert) is then reused by
+  /// the next solve, unless the matrix values have changed.
   void set_operators(const Mat A, const Mat B);
 
+  /// @brief Reuse the spectral transformation linear solver (e.g. the
+  /// shift-and-invert factorization) in later solves even if the
+  /// values of the operators change.
+  ///
+  /// This is useful in parameter sweeps in which the operators change
+  /// slightly, with the old factorization acting as a preconditioner
+  /// for an iterative spectral transformation solver.
+  ///
+  /// @param[in] reuse If `true`, the preconditioner of the spectral
+  /// transformation KSP is not rebuilt.
+  void set_reuse_factorization(bool reuse);
+
+  /// @brief Set the initial space from which the eigensolver starts
+  /// the iteration.
+  ///
+  /// The initial space is used by the next solve only.
+  ///
+  /// @param[in] x Vectors that span the initial space.
+  void set_initial_space(std::span<const Vec> x);
+
+  /// @brief Use the converged eigenvectors of the last solve as the
+  /// initial space for the next solve (warm start).
+  ///
+  /// @param[in] n Maximum number of eigenvectors to use. If negative,
+  /// all converged eigenvectors are used.
+  void set_initial_space_from_solution(std::int64_t n = -1);
+
   /// Compute all eigenpairs of the matrix A (solve \f$A x = \lambda x\f$)
   void solve();
 
@@ -62,6 +95,14 @@ public:
   void get_eigenpair(PetscScalar& lr, PetscScalar& lc, Vec r, Vec c,
                      int i) const;
 
+  /// @brief Get the first `x.size()` eigenvectors.
+  ///
+  /// For real scalars the real part of each eigenvector is returned.
+  ///
+  /// @param[in,out] x Vectors (compatible with the operators) to copy
+  /// the eigenvectors into.
+  void get_eigenvectors(std::span<Vec> x) const;
+
   /// Get the number of iterations used by the solver
   int get_iteration_number() const;
 
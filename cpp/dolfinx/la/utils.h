@@ -6,10 +6,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <numeric>
 #include <span>
 
+#ifdef HAS_STDPAR
+#include <execution>
+#endif
+
 namespace dolfinx::la
 {
 /// Norm types
@@ -27,4 +36,131 @@ template <class U, class T>
 concept MatSet
     = std::invocable<U, std::span<const std::int32_t>,
                      std::span<const std::int32_t>, std::span<const T>>;
+
+namespace impl
+{
+/// @brief Random access iterator over a range of indices.
+///
+/// Dereferencing returns the index by value. Unlike the iterators of
+/// `std::ranges::iota_view`, which are C++20 random access iterators
+/// but only C++17 input iterators, this iterator has the random access
+/// iterator category. The parallel standard algorithms use the
+/// iterator category to decide whether to partition the range, and
+/// execute sequentially for input iterators.
+class index_iterator
+{
+public:
+  /// Iterator category
+  using iterator_category = std::random_access_iterator_tag;
+  /// Value type
+  using value_type = std::size_t;
+  /// Difference type
+  using difference_type = std::ptrdiff_t;
+  /// Pointer type
+  using pointer = const std::size_t*;
+  /// Reference type (indices are returned by value)
+  using reference = std::size_t;
+
+  /// Create an iterator at index `i`
+  explicit index_iterator(std::size_t i = 0) : _i(i) {}
+
+  /// @cond
+  reference operator*() const { return _i; }
+  reference operator[](difference_type n) const { return _i + n; }
+  index_iterator& operator++()
+  {
+    ++_i;
+    return *this;
+  }
+  index_iterator operator++(int) { return index_iterator(_i++); }
+  index_iterator& operator--()
+  {
+    --_i;
+    return *this;
+  }
+  index_iterator operator--(int) { return index_iterator(_i--); }
+  index_iterator& operator+=(difference_type n)
+  {
+    _i += n;
+    return *this;
+  }
+  index_iterator& operator-=(difference_type n)
+  {
+    _i -= n;
+    return *this;
+  }
+  friend index_iterator operator+(index_iterator it, difference_type n)
+  {
+    return it += n;
+  }
+  friend index_iterator operator+(difference_type n, index_iterator it)
+  {
+    return it += n;
+  }
+  friend index_iterator operator-(index_iterator it, difference_type n)
+  {
+    return it -= n;
+  }
+  friend difference_type operator-(index_iterator a, index_iterator b)
+  {
+    return static_cast<difference_type>(a._i)
+           - static_cast<difference_type>(b._i);
+  }
+  friend bool operator==(index_iterator a, index_iterator b) = default;
+  friend auto operator<=>(index_iterator a, index_iterator b) = default;
+  /// @endcond
+
+private:
+  std::size_t _i;
+};
+
+/// @brief Execute `f(i)` for each index `i` in `[0, n)`.
+///
+/// This function is used for the element-wise kernels of the linear
+/// algebra data structures. When DOLFINx is built with C++ standard
+/// parallelism (`HAS_STDPAR`), `std::execution::par_unseq` is used,
+/// and the work is executed on a GPU when the compiler offloads
+/// standard parallel algorithms, e.g. NVIDIA nvc++ with `-stdpar=gpu`.
+/// Otherwise the work is executed sequentially on the host.
+///
+/// @note The calls `f(i)` may execute concurrently and in any order,
+/// and `f` must therefore not write to locations that are written to
+/// by other calls.
+///
+/// @param[in] n Number of indices.
+/// @param[in] f Function to execute for each index.
+template <typename F>
+void for_each_index(std::size_t n, F f)
+{
+  index_iterator first(0), last(n);
+#ifdef HAS_STDPAR
+  std::for_each(std::execution::par_unseq, first, last, f);
+#else
+  std::for_each(first, last, f);
+#endif
+}
+
+/// @brief Compute `reduce(init, transform(i))` over the indices `i` in
+/// `[0, n)`.
+///
+/// See la::impl::for_each_index for the execution policy.
+///
+/// @param[in] n Number of indices.
+/// @param[in] init Initial value of the reduction.
+/// @param[in] reduce Associative and commutative reduction operation.
+/// @param[in] transform Function that computes the value for index
+/// `i`.
+/// @return The reduced value.
+template <typename T, typename R, typename F>
+T transform_reduce_index(std::size_t n, T init, R reduce, F transform)
+{
+  index_iterator first(0), last(n);
+#ifdef HAS_STDPAR
+  return std::transform_reduce(std::execution::par_unseq, first, last, init,
+                               reduce, transform);
+#else
+  return std::transform_reduce(first, last, init, reduce, transform);
+#endif
+}
+} // namespace impl
 } // namespace dolfinx::la
@@ -7,12 +7,17 @@
 #pragma once
 
 #include "Topology.h"
+#include "cell_types.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
+#include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/ElementDofLayout.h>
@@ -20,18 +25,136 @@
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/partition.h>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <span>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace dolfinx::mesh
 {
 
+/// @brief Jacobian data of the geometry map on each cell of a mesh.
+///
+/// For an affine map the data is constant on a cell and is stored once
+/// per cell. Otherwise it is stored at each of a set of reference points
+/// on each cell. See Geometry::create_jacobians.
+template <std::floating_point T>
+struct GeometryJacobians
+{
+  /// Reference points (`shape=(num_points, tdim)`, row-major)
+  std::vector<T> X;
+
+  /// Number of points per cell (one if the data is cellwise constant)
+  std::size_t num_points = 0;
+
+  /// Geometric dimension
+  std::size_t gdim = 0;
+
+  /// Topological dimension
+  std::size_t tdim = 0;
+
+  /// True if the data is constant on each cell (affine map)
+  bool cellwise = false;
+
+  /// Jacobians (`shape=(num_cells, num_points, gdim, tdim)`)
+  std::vector<T> J;
+
+  /// Inverse (pseudo-inverse) Jacobians (`shape=(num_cells,
+  /// num_points, tdim, gdim)`)
+  std::vector<T> K;
+
+  /// Jacobian (pseudo-)determinants (`shape=(num_cells, num_points)`)
+  std::vector<T> detJ;
+
+  /// @brief Index of the data for a point on a cell.
+  /// @param[in] c Cell index.
+  /// @param[in] p Point index. It is ignored if the data is cellwise
+  /// constant.
+  /// @return Index `i` such that the Jacobian starts at `J[i * gdim *
+  /// tdim]`, its inverse at `K[i * tdim * gdim]` and its determinant
+  /// is `detJ[i]`.
+  std::size_t index(std::int32_t c, std::size_t p) const
+  {
+    return c * num_points + (cellwise ? 0 : p);
+  }
+};
+
+/// @brief View of the coordinates of geometry nodes that are stored
+/// row-major with `stride` components per node (see
+/// Geometry::x_stride).
+///
+/// The components of a node beyond `stride` are zero. Kernels receive
+/// three components per node, which are gathered with
+/// NodeCoordinates::copy.
+template <std::floating_point T>
+struct NodeCoordinates
+{
+  /// @brief Create a view of coordinates with three components per
+  /// node.
+  /// @param[in] x Coordinates, `shape=(num_nodes, 3)`.
+  NodeCoordinates(std::span<const T> x) : x(x) {}
+
+  /// @brief Create a view of coordinates.
+  /// @param[in] x Coordinates, `shape=(num_nodes, stride)`.
+  /// @param[in] stride Number of stored components per node (`0 <
+  /// stride <= 3`).
+  NodeCoordinates(std::span<const T> x, int stride) : x(x), stride(stride)
+  {
+    assert(stride > 0 and stride <= 3);
+  }
+
+  /// @brief Component of the coordinate of a node.
+  /// @param[in] node Index of the node.
+  /// @param[in] j Component (`0 <= j < 3`).
+  /// @return The component, which is zero if `j >= stride`.
+  T operator()(std::int32_t node, int j) const
+  {
+    return j < stride ? x[stride * node + j] : T(0);
+  }
+
+  /// @brief Copy the coordinates of nodes to a buffer with three
+  /// components per node.
+  /// @param[in] nodes Indices of the nodes.
+  /// @param[out] out Buffer of size `3 * nodes.size()`.
+  template <typename U>
+  void copy(const U& nodes, T* out) const
+  {
+    if (stride == 3)
+    {
+      for (std::size_t i = 0; i < nodes.size(); ++i)
+        std::copy_n(std::next(x.begin(), 3 * nodes[i]), 3, out + 3 * i);
+    }
+    else
+    {
+      for (std::size_t i = 0; i < nodes.size(); ++i)
+      {
+        std::copy_n(std::next(x.begin(), stride * nodes[i]), stride,
+                    out + 3 * i);
+        std::fill_n(out + 3 * i + stride, 3 - stride, T(0));
+      }
+    }
+  }
+
+  /// Coordinates, `shape=(num_nodes, stride)`
+  std::span<const T> x;
+
+  /// Number of stored components per node
+  int stride = 3;
+};
+
 /// @brief Geometry stores the geometry imposed on a mesh.
 template <std::floating_point T>
 class Geometry
 {
+  template <typename X, std::size_t d>
+  using mdspan_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      X, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, d>>;
+
 public:
   /// @brief Value type
   using value_type = T;
@@ -165,15 +288,183 @@ public:
   /// @brief Access geometry degrees-of-freedom data (const version).
   ///
   /// @return The flattened row-major geometry data, where the shape is
-  /// `(num_points, 3)`.
+  /// `(num_points, x_stride())`.
   std::span<const value_type> x() const { return _x; }
 
   /// @brief Access geometry degrees-of-freedom data (non-const
   /// version).
   ///
+  /// @note Cached Jacobian data (see Geometry::create_jacobians) is
+  /// discarded, since the returned data may be modified.
+  ///
   /// @return The flattened row-major geometry data, where the shape is
-  /// `(num_points, 3)`.
-  std::span<value_type> x() { return _x; }
+  /// `(num_points, x_stride())`.
+  std::span<value_type> x()
+  {
+    _jacobians.clear();
+    return _x;
+  }
+
+  /// @brief Number of stored coordinate components per point.
+  ///
+  /// The coordinates are padded to three components per point unless
+  /// the storage has been compacted with Geometry::set_x_stride.
+  int x_stride() const { return _x_stride; }
+
+  /// @brief Set the number of stored coordinate components per point.
+  ///
+  /// A stride equal to the geometric dimension avoids storing the zero
+  /// components of 2D (and 1D) geometries, which reduces the memory of
+  /// the coordinates and the data read when gathering cell coordinates.
+  /// The coordinates are re-packed in place.
+  ///
+  /// @note Functions that access the coordinates read them through
+  /// Geometry::coordinates (or Geometry::x_stride). The VTK, VTKHDF and
+  /// ADIOS2 writers require a stride of three and throw otherwise.
+  ///
+  /// @param[in] stride Three or the geometric dimension.
+  void set_x_stride(int stride)
+  {
+    if (stride != 3 and stride != _dim)
+    {
+      throw std::runtime_error(
+          "Coordinate stride must be three or the geometric dimension.");
+    }
+
+    const std::size_t num_points = _x.size() / _x_stride;
+    if (stride < _x_stride)
+    {
+      for (std::size_t i = 0; i < num_points; ++i)
+        for (int j = 0; j < stride; ++j)
+          _x[stride * i + j] = _x[_x_stride * i + j];
+      _x.resize(stride * num_points);
+      _x.shrink_to_fit();
+    }
+    else if (stride > _x_stride)
+    {
+      _x.resize(stride * num_points, 0);
+      for (std::size_t i = num_points; i-- > 0;)
+      {
+        for (int j = stride; j-- > 0;)
+          _x[stride * i + j] = j < _x_stride ? _x[_x_stride * i + j] : 0;
+      }
+    }
+    _x_stride = stride;
+  }
+
+  /// @brief View of the point coordinates with the storage stride.
+  /// @return View of the coordinates, which gathers cell coordinates
+  /// with three components per point.
+  NodeCoordinates<value_type> coordinates() const
+  {
+    return NodeCoordinates<value_type>(_x, _x_stride);
+  }
+
+  /// @brief Compute and cache the Jacobian, its inverse and its
+  /// determinant of the geometry map on all cells.
+  ///
+  /// The cached data can be retrieved using Geometry::jacobians, and is
+  /// shared by the functions that need it, rather than being
+  /// re-computed by each. It is discarded when the non-const version of
+  /// Geometry::x is called. Data for a set of points replaces the data
+  /// previously cached for the same points.
+  ///
+  /// @param[in] X Reference points (`shape=(num_points, tdim)`,
+  /// row-major) at which the data is computed. It is not used if the
+  /// geometry map is affine, in which case the data is computed once
+  /// per cell.
+  /// @param[in] Xshape Shape of `X`.
+  void create_jacobians(std::span<const value_type> X = {},
+                        std::array<std::size_t, 2> Xshape = {0, 0})
+  {
+    const fem::CoordinateElement<value_type>& cmap = this->cmap();
+    const std::size_t tdim = cell_dim(cmap.cell_shape());
+    const std::size_t gdim = _dim;
+
+    auto data = std::make_shared<GeometryJacobians<value_type>>();
+    data->gdim = gdim;
+    data->tdim = tdim;
+    data->cellwise = cmap.is_affine();
+    if (data->cellwise)
+    {
+      data->X.assign(tdim, 0);
+      data->num_points = 1;
+    }
+    else
+    {
+      if (X.empty() or Xshape[1] != tdim or X.size() != Xshape[0] * tdim)
+        throw std::runtime_error("Invalid reference points.");
+      data->X.assign(X.begin(), X.end());
+      data->num_points = Xshape[0];
+    }
+
+    // Tabulate the coordinate element basis derivatives at the points
+    const std::size_t np = data->num_points;
+    const std::array<std::size_t, 4> phi_shape = cmap.tabulate_shape(1, np);
+    std::vector<value_type> phi_b(std::reduce(
+        phi_shape.begin(), phi_shape.end(), 1, std::multiplies{}));
+    mdspan_t<const value_type, 4> phi(phi_b.data(), phi_shape);
+    cmap.tabulate(1, data->X, {np, tdim}, phi_b);
+
+    auto x_dofmap = dofmap();
+    const std::size_t num_cells = x_dofmap.extent(0);
+    const std::size_t num_dofs_g = x_dofmap.extent(1);
+    data->J.assign(num_cells * np * gdim * tdim, 0);
+    data->K.resize(num_cells * np * tdim * gdim);
+    data->detJ.resize(num_cells * np);
+    mdspan_t<value_type, 4> J(data->J.data(), num_cells, np, gdim, tdim);
+    mdspan_t<value_type, 4> K(data->K.data(), num_cells, np, tdim, gdim);
+
+    std::vector<value_type> coord_dofs_b(num_dofs_g * gdim);
+    mdspan_t<value_type, 2> coord_dofs(coord_dofs_b.data(), num_dofs_g,
+                                       gdim);
+    std::vector<value_type> det_scratch(2 * gdim * tdim);
+    for (std::size_t c = 0; c < num_cells; ++c)
+    {
+      for (std::size_t i = 0; i < num_dofs_g; ++i)
+        for (std::size_t j = 0; j < gdim; ++j)
+          coord_dofs(i, j) = _x[_x_stride * x_dofmap(c, i) + j];
+
+      for (std::size_t p = 0; p < np; ++p)
+      {
+        auto dphi = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            phi, std::pair(std::size_t(1), tdim + 1), p,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent, 0);
+        auto Jp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            J, c, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        auto Kp = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
+            K, c, p, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent,
+            MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
+        cmap.compute_jacobian(dphi, coord_dofs, Jp);
+        cmap.compute_jacobian_inverse(Jp, Kp);
+        data->detJ[c * np + p]
+            = cmap.compute_jacobian_determinant(Jp, det_scratch);
+      }
+    }
+
+    std::erase_if(_jacobians, [&data](auto& d)
+                  { return d->cellwise or d->X == data->X; });
+    _jacobians.push_back(data);
+  }
+
+  /// @brief Cached Jacobian data of the geometry map.
+  ///
+  /// @param[in] X Reference points (`shape=(num_points, tdim)`,
+  /// row-major). It is not used if the geometry map is affine.
+  /// @return The data created by Geometry::create_jacobians for the
+  /// points `X` (for any points if the map is affine), or `nullptr` if
+  /// the data has not been created or has been discarded.
+  std::shared_ptr<const GeometryJacobians<value_type>>
+  jacobians(std::span<const value_type> X = {}) const
+  {
+    for (auto& data : _jacobians)
+    {
+      if (data->cellwise or std::ranges::equal(data->X, X))
+        return data;
+    }
+    return nullptr;
+  }
 
   /// @brief The element that describes the geometry map.
   ///
@@ -204,6 +495,46 @@ public:
     return _input_global_indices;
   }
 
+  /// @brief Memory (bytes) used by the geometry on this process, by
+  /// member.
+  ///
+  /// The index map of the geometry dofs and cached Jacobian data are
+  /// included.
+  ///
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const
+  {
+    std::map<std::string, std::size_t> usage
+        = {{"x", common::container_memory(_x)},
+           {"input global indices",
+            common::container_memory(_input_global_indices)}};
+
+    std::size_t& dofmaps = usage["dofmaps"];
+    for (auto& dofmap : _dofmaps)
+      dofmaps += common::container_memory(dofmap);
+
+    std::size_t& map = usage["index map"];
+    if (_index_map)
+    {
+      for (auto [member, bytes] : _index_map->memory_usage())
+        map += bytes;
+    }
+
+    std::size_t& jacobians = usage["jacobians"];
+    for (auto& j : _jacobians)
+    {
+      if (j)
+      {
+        jacobians += common::container_memory(j->X)
+                     + common::container_memory(j->J)
+                     + common::container_memory(j->K)
+                     + common::container_memory(j->detJ);
+      }
+    }
+
+    return usage;
+  }
+
 private:
   // Geometric dimension
   int _dim;
@@ -218,11 +549,18 @@ private:
   std::vector<fem::CoordinateElement<value_type>> _cmaps;
 
   // Coordinates for all points stored as a contiguous array (row-major,
-  // column size = 3)
+  // column size = _x_stride)
   std::vector<value_type> _x;
 
+  // Number of stored components per point
+  int _x_stride = 3;
+
   // Global indices as provided on Geometry creation
   std::vector<std::int64_t> _input_global_indices;
+
+  // Cached Jacobian data
+  std::vector<std::shared_ptr<const GeometryJacobians<value_type>>>
+      _jacobians;
 };
 
 /// @cond
@@ -271,7 +609,7 @@ create_geometry(
         reorder_fn
     = nullptr)
 {
-  spdlog::info("Create Geometry (multiple)");
+  DOLFINX_LOG_INFO("Create Geometry (multiple)");
 
   assert(std::ranges::is_sorted(nodes));
   using T = typename std::remove_reference_t<typename U::value_type>;
@@ -286,7 +624,7 @@ create_geometry(
   for (const auto& el : elements)
     dof_layouts.push_back(el.create_dof_layout());
 
-  spdlog::info("Got {} dof layouts", dof_layouts.size());
+  DOLFINX_LOG_DEBUG("Got {} dof layouts", dof_layouts.size());
 
   //  Build 'geometry' dofmap on the topology
   auto [_dof_index_map, bs, dofmaps]
@@ -310,24 +648,27 @@ create_geometry(
     }
   }
 
-  spdlog::info("Calling compute_local_to_global");
+  DOLFINX_LOG_DEBUG("Calling compute_local_to_global");
   // Compute local-to-global map from local indices in dofmap to the
   // corresponding global indices in cells, and pass to function to
   // compute local (dof) to local (position in coords) map from (i)
   // local-to-global for dofs and (ii) local-to-global for entries in
   // coords
 
-  spdlog::info("xdofs.size = {}", xdofs.size());
+  DOLFINX_LOG_DEBUG("xdofs.size = {}", xdofs.size());
   std::vector<std::int32_t> all_dofmaps;
-  std::stringstream s;
-  for (auto q : dofmaps)
-  {
-    s << q.size() << " ";
+  for (auto& q : dofmaps)
     all_dofmaps.insert(all_dofmaps.end(), q.begin(), q.end());
-  }
-  spdlog::info("dofmap sizes = {}", s.str());
-  spdlog::info("all_dofmaps.size = {}", all_dofmaps.size());
-  spdlog::info("nodes.size = {}", nodes.size());
+  DOLFINX_LOG_DEBUG("dofmap sizes = {}",
+                    [&dofmaps]()
+                    {
+                      std::stringstream s;
+                      for (auto& q : dofmaps)
+                        s << q.size() << " ";
+                      return s.str();
+                    }());
+  DOLFINX_LOG_DEBUG("all_dofmaps.size = {}", all_dofmaps.size());
+  DOLFINX_LOG_DEBUG("nodes.size = {}", nodes.size());
 
   const std::vector<std::int32_t> l2l = graph::build::compute_local_to_local(
       graph::build::compute_local_to_global(xdofs, all_dofmaps), nodes);
@@ -348,7 +689,7 @@ create_geometry(
                 std::next(xg.begin(), 3 * i));
   }
 
-  spdlog::info("Creating geometry with {} dofmaps", dof_layouts.size());
+  DOLFINX_LOG_DEBUG("Creating geometry with {} dofmaps", dof_layouts.size());
 
   return Geometry(dof_index_map, std::move(dofmaps), elements, std::move(xg),
                   dim, std::move(igi));
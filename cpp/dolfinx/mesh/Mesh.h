@@ -9,6 +9,7 @@
 #include "Geometry.h"
 #include <concepts>
 #include <dolfinx/common/MPI.h>
+#include <map>
 #include <string>
 
 namespace dolfinx::mesh
@@ -83,6 +84,20 @@ public:
   /// @return The communicator on which the mesh is distributed
   MPI_Comm comm() const { return _comm.comm(); }
 
+  /// @brief Memory (bytes) used by the topology and geometry of the
+  /// mesh on this process, by member.
+  /// @return Map from member names, prefixed by `topology: ` or
+  /// `geometry: `, to memory.
+  std::map<std::string, std::size_t> memory_usage() const
+  {
+    std::map<std::string, std::size_t> usage;
+    for (auto [member, bytes] : _topology->memory_usage())
+      usage["topology: " + member] = bytes;
+    for (auto [member, bytes] : _geometry.memory_usage())
+      usage["geometry: " + member] = bytes;
+    return usage;
+  }
+
   /// Name
   std::string name = "mesh";
 
@@ -8,18 +8,31 @@
 
 #include "Topology.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/utils.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/io/cells.h>
 #include <memory>
+#include <numeric>
 #include <span>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
 namespace dolfinx::mesh
 {
+namespace impl
+{
+/// @brief Create a process-unique identifier for a set of mesh tags.
+inline std::uint64_t create_tags_id()
+{
+  static std::atomic<std::uint64_t> count = 0;
+  return ++count;
+}
+} // namespace impl
 
 /// @brief MeshTags associate values with mesh topology entities.
 ///
@@ -50,7 +63,7 @@ public:
   MeshTags(std::shared_ptr<const Topology> topology, int dim, U&& indices,
            V&& values)
       : _topology(topology), _dim(dim), _indices(std::forward<U>(indices)),
-        _values(std::forward<V>(values))
+        _values(std::forward<V>(values)), _id(impl::create_tags_id())
   {
     if (_indices.size() != _values.size())
     {
@@ -81,14 +94,24 @@ public:
   MeshTags& operator=(MeshTags&& tags) = default;
 
   /// @brief Find all entities with a given tag value
+  ///
+  /// If the value index has been created (see create_value_index), the
+  /// entities are copied from the index. Otherwise, all tags are
+  /// searched.
   /// @param[in] value The value
   /// @return Indices of tagged entities. The indices are sorted.
   std::vector<std::int32_t> find(const T value) const
   {
+    if (has_value_index())
+    {
+      std::span<const std::int32_t> e = find_indexed(value);
+      return std::vector<std::int32_t>(e.begin(), e.end());
+    }
+
     std::size_t n = std::count(_values.begin(), _values.end(), value);
     std::vector<std::int32_t> indices;
     indices.reserve(n);
-    for (std::int32_t i = 0; i < _values.size(); ++i)
+    for (std::size_t i = 0; i < _values.size(); ++i)
     {
       if (_values[i] == value)
         indices.push_back(_indices[i]);
@@ -96,6 +119,72 @@ public:
     return indices;
   }
 
+  /// @brief Create an index of the tagged entities by value.
+  ///
+  /// The index stores the unique values in ascending order and, for
+  /// each value, the sorted list of entities with the value in a
+  /// compressed (offsets) layout. Look-ups of a value with
+  /// find_indexed cost `O(log n)` for `n` unique values and do not copy
+  /// the entities. Calls after the first call do nothing.
+  void create_value_index()
+  {
+    if (has_value_index())
+      return;
+
+    // Positions of the tags sorted by value. The sort is stable, so the
+    // entities with the same value remain sorted.
+    std::vector<std::int32_t> perm(_values.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::stable_sort(perm, [this](auto p0, auto p1)
+                             { return _values[p0] < _values[p1]; });
+
+    _index_entities.resize(perm.size());
+    for (std::size_t i = 0; i < perm.size(); ++i)
+    {
+      const T v = _values[perm[i]];
+      if (_index_values.empty() or _index_values.back() != v)
+      {
+        _index_values.push_back(v);
+        _index_offsets.push_back(i);
+      }
+      _index_entities[i] = _indices[perm[i]];
+    }
+    _index_offsets.push_back(perm.size());
+  }
+
+  /// @brief Check if the value index has been created (see
+  /// create_value_index).
+  bool has_value_index() const { return !_index_offsets.empty(); }
+
+  /// @brief Find all entities with a given tag value with the value
+  /// index.
+  /// @pre The value index has been created (see create_value_index).
+  /// @param[in] value The value
+  /// @return Indices of tagged entities. The indices are sorted. The
+  /// span is valid while the tags exist.
+  std::span<const std::int32_t> find_indexed(const T value) const
+  {
+    if (!has_value_index())
+      throw std::runtime_error("MeshTags value index has not been created.");
+
+    auto it = std::ranges::lower_bound(_index_values, value);
+    if (it == _index_values.end() or *it != value)
+      return {};
+    std::size_t pos = std::distance(_index_values.begin(), it);
+    return std::span(_index_entities)
+        .subspan(_index_offsets[pos],
+                 _index_offsets[pos + 1] - _index_offsets[pos]);
+  }
+
+  /// @brief Unique tag values in ascending order.
+  /// @pre The value index has been created (see create_value_index).
+  std::span<const T> unique_values() const
+  {
+    if (!has_value_index())
+      throw std::runtime_error("MeshTags value index has not been created.");
+    return _index_values;
+  }
+
   /// Indices of tagged topology entities (local-to-process). The
   /// indices are sorted.
   std::span<const std::int32_t> indices() const { return _indices; }
@@ -109,6 +198,13 @@ public:
   /// Return topology
   std::shared_ptr<const Topology> topology() const { return _topology; }
 
+  /// @brief Process-unique identifier of the tags.
+  ///
+  /// The identifier is shared by copies of the tags, which have the
+  /// same entities and values, and is used to key data computed from
+  /// the tags (see fem::IntegrationDomainCache).
+  std::uint64_t id() const { return _id; }
+
   /// Name
   std::string name = "mesh_tags";
 
@@ -124,6 +220,15 @@ private:
 
   // Values attached to entities
   std::vector<T> _values;
+
+  // Value index: unique values, offsets of the entities of each value
+  // and the entities sorted by value (empty if not created)
+  std::vector<T> _index_values;
+  std::vector<std::size_t> _index_offsets;
+  std::vector<std::int32_t> _index_entities;
+
+  // Identifier of the tags
+  std::uint64_t _id;
 };
 
 /// @brief Create MeshTags from arrays
@@ -0,0 +1,414 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "cell_types.h"
+#include "generation.h"
+#include <algorithm>
+#include <array>
+#include <basix/mdspan.hpp>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <limits>
+#include <memory>
+#include <mpi.h>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace dolfinx::mesh
+{
+/// @brief Implicit representation of a distributed structured mesh of
+/// quadrilateral or hexahedral cells.
+///
+/// The grid is decomposed into one block of cells per process (see
+/// impl::GridBlocks), and the cell-to-vertex connectivity and the
+/// vertex coordinates of the block are computed on the fly from the
+/// `(i, j, k)` grid indices of cells and vertices. Apart from the ghost
+/// vertices of the index map, which lie on the upper sides of the block,
+/// no mesh data is stored.
+///
+/// The cells of a process are numbered lexicographically (`i` fastest)
+/// on the block. The local vertices are the owned vertices of the block,
+/// numbered lexicographically, followed by the ghost vertices, which are
+/// numbered lexicographically over the vertices of the block. The vertex
+/// order of a cell is the DOLFINx reference ordering.
+///
+/// StructuredMesh::dofmap and StructuredMesh::x return mdspans with the
+/// same extents and indexing as Geometry::dofmap and Geometry::x, with
+/// accessors that compute the values. The mdspans refer to the
+/// StructuredMesh, which must outlive them.
+///
+/// @tparam T Floating point type of the vertex coordinates.
+template <std::floating_point T>
+class StructuredMesh
+{
+  // Data handle of the computed mdspans
+  struct handle_t
+  {
+    const StructuredMesh* mesh;
+    std::size_t offset;
+  };
+
+public:
+  /// @brief mdspan accessor that computes the vertices of cells.
+  struct dofmap_accessor
+  {
+    /// @cond
+    using offset_policy = dofmap_accessor;
+    using element_type = const std::int32_t;
+    using reference = std::int32_t;
+    using data_handle_type = handle_t;
+
+    reference access(data_handle_type p, std::size_t i) const
+    {
+      const std::size_t num_vertices = p.mesh->_tdim == 3 ? 8 : 4;
+      const std::size_t pos = p.offset + i;
+      return p.mesh->cell_vertex(pos / num_vertices, pos % num_vertices);
+    }
+
+    data_handle_type offset(data_handle_type p, std::size_t i) const
+    {
+      return {p.mesh, p.offset + i};
+    }
+    /// @endcond
+  };
+
+  /// @brief mdspan accessor that computes the coordinates of vertices.
+  struct x_accessor
+  {
+    /// @cond
+    using offset_policy = x_accessor;
+    using element_type = const T;
+    using reference = T;
+    using data_handle_type = handle_t;
+
+    reference access(data_handle_type p, std::size_t i) const
+    {
+      const std::size_t pos = p.offset + i;
+      const int j = pos % 3;
+      if (j >= p.mesh->_tdim)
+        return 0;
+      std::array<std::int64_t, 3> idx = p.mesh->vertex_index(pos / 3);
+      return p.mesh->_p0[j] + static_cast<T>(idx[j]) * p.mesh->_h[j];
+    }
+
+    data_handle_type offset(data_handle_type p, std::size_t i) const
+    {
+      return {p.mesh, p.offset + i};
+    }
+    /// @endcond
+  };
+
+  /// Computed cell-to-vertex map, shape `(num_cells, num_vertices)`
+  using dofmap_type = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const std::int32_t,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::layout_right, dofmap_accessor>;
+
+  /// Computed vertex coordinates, shape `(num_vertices, 3)`
+  using x_type = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
+      const T, MDSPAN_IMPL_STANDARD_NAMESPACE::dextents<std::size_t, 2>,
+      MDSPAN_IMPL_STANDARD_NAMESPACE::layout_right, x_accessor>;
+
+  /// @brief Create a structured mesh.
+  ///
+  /// @note Collective function
+  /// @param[in] comm MPI communicator to build the mesh on.
+  /// @param[in] p Corners of the grid (`p[i][2]` is not used for 2D
+  /// grids).
+  /// @param[in] n Number of cells in each direction (`n[2]` is not used
+  /// for 2D grids).
+  /// @param[in] celltype Cell shape, quadrilateral or hexahedron.
+  StructuredMesh(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
+                 std::array<std::int64_t, 3> n, CellType celltype)
+      : _comm(comm), _celltype(celltype), _tdim(mesh::cell_dim(celltype)),
+        _grid(create_grid(comm, n, celltype))
+  {
+    for (int i = 0; i < _tdim; ++i)
+    {
+      _p0[i] = p[0][i];
+      _h[i] = (p[1][i] - p[0][i]) / static_cast<T>(n[i]);
+      if (std::abs(_h[i]) < 2.0 * std::numeric_limits<T>::epsilon())
+      {
+        throw std::runtime_error(
+            "Mesh seems to have zero width, height or depth. Check "
+            "dimensions");
+      }
+    }
+
+    // Boxes of the cells, all vertices and owned vertices of the block
+    const int rank = dolfinx::MPI::rank(comm);
+    _block = _grid.block(rank);
+    for (int i = 0; i < 3; ++i)
+    {
+      auto [c0, c1] = _grid.cells(i, _block[i]);
+      auto [v0, v1] = _grid.vertices(i, _block[i]);
+      _c0[i] = c0;
+      _nc[i] = c1 - c0;
+      _nv[i] = _nc[i] + 1;
+      _no[i] = v1 - v0;
+    }
+    if (_tdim == 2)
+      _nc[2] = _nv[2] = 1;
+
+    // Ghost vertices, in local order
+    const std::int32_t num_owned = _no[0] * _no[1] * _no[2];
+    std::vector<std::int64_t> ghosts;
+    std::vector<int> owners;
+    for (std::int64_t k = 0; k < _nv[2]; ++k)
+    {
+      for (std::int64_t j = 0; j < _nv[1]; ++j)
+      {
+        for (std::int64_t i = 0; i < _nv[0]; ++i)
+        {
+          if (owned({i, j, k}))
+            continue;
+          std::array<std::int64_t, 3> idx
+              = {_c0[0] + i, _c0[1] + j, _c0[2] + k};
+          ghosts.push_back(_grid.vertex(idx));
+          owners.push_back(_grid.vertex_owner(idx));
+        }
+      }
+    }
+
+    // The owners of ghosts are the blocks above the block, and the
+    // ranks that ghost owned vertices are the blocks below the block
+    std::vector<int> src = owners;
+    std::ranges::sort(src);
+    src.erase(std::unique(src.begin(), src.end()), src.end());
+    std::vector<int> dest;
+    for (int e = 1; e < (_tdim == 3 ? 8 : 4); ++e)
+    {
+      std::array<int, 3> b = _block;
+      for (int i = 0; i < 3; ++i)
+        b[i] -= (e >> i) & 1;
+      if (b[0] >= 0 and b[1] >= 0 and b[2] >= 0)
+        dest.push_back(b[0] + _grid.d[0] * (b[1] + _grid.d[1] * b[2]));
+    }
+    std::ranges::sort(dest);
+
+    _vertex_map = std::make_shared<common::IndexMap>(
+        comm, num_owned, std::array{src, dest}, ghosts, owners);
+    _cell_map = std::make_shared<common::IndexMap>(
+        comm, static_cast<std::int32_t>(_nc[0] * _nc[1] * _nc[2]));
+  }
+
+  /// Copy constructor
+  StructuredMesh(const StructuredMesh&) = delete;
+
+  /// Move constructor
+  StructuredMesh(StructuredMesh&&) = default;
+
+  /// Destructor
+  ~StructuredMesh() = default;
+
+  /// Copy assignment
+  StructuredMesh& operator=(const StructuredMesh&) = delete;
+
+  /// Move assignment
+  StructuredMesh& operator=(StructuredMesh&&) = default;
+
+  /// Cell shape
+  CellType cell_type() const { return _celltype; }
+
+  /// Topological dimension of the mesh
+  int topology_dim() const { return _tdim; }
+
+  /// MPI communicator of the mesh
+  MPI_Comm comm() const { return _comm.comm(); }
+
+  /// Index map of the cells (no ghosts)
+  std::shared_ptr<const common::IndexMap> cell_index_map() const
+  {
+    return _cell_map;
+  }
+
+  /// Index map of the vertices
+  std::shared_ptr<const common::IndexMap> vertex_index_map() const
+  {
+    return _vertex_map;
+  }
+
+  /// @brief Grid index of a local cell.
+  /// @param[in] c Local index of the cell.
+  /// @return The `(i, j, k)` index of the cell on the grid.
+  std::array<std::int64_t, 3> cell_index(std::int32_t c) const
+  {
+    return {_c0[0] + c % _nc[0], _c0[1] + (c / _nc[0]) % _nc[1],
+            _c0[2] + c / (_nc[0] * _nc[1])};
+  }
+
+  /// @brief Local index of the vertex at a grid point.
+  /// @param[in] idx Grid point, which must be a vertex of a local cell.
+  /// @return The local index of the vertex.
+  std::int32_t vertex(std::array<std::int64_t, 3> idx) const
+  {
+    std::array<std::int64_t, 3> r;
+    for (int i = 0; i < 3; ++i)
+      r[i] = idx[i] - _c0[i];
+    assert(r[0] >= 0 and r[0] < _nv[0]);
+    assert(r[1] >= 0 and r[1] < _nv[1]);
+    assert(r[2] >= 0 and r[2] < _nv[2]);
+
+    const std::int64_t num_owned = num_owned_before(r);
+    if (owned(r))
+      return num_owned;
+    else
+    {
+      const std::int64_t pos = r[0] + _nv[0] * (r[1] + _nv[1] * r[2]);
+      return _no[0] * _no[1] * _no[2] + pos - num_owned;
+    }
+  }
+
+  /// @brief Grid index of a local vertex.
+  /// @param[in] v Local index of the vertex.
+  /// @return The `(i, j, k)` grid point of the vertex.
+  std::array<std::int64_t, 3> vertex_index(std::int32_t v) const
+  {
+    const std::int64_t num_owned = _no[0] * _no[1] * _no[2];
+    if (v < num_owned)
+    {
+      return {_c0[0] + v % _no[0], _c0[1] + (v / _no[0]) % _no[1],
+              _c0[2] + v / (_no[0] * _no[1])};
+    }
+
+    // Ghost vertices are ordered lexicographically over the vertices of
+    // the block, so the ghost is the first vertex of the block that is
+    // preceded by (v - num_owned) ghosts and is not owned. It is found
+    // by bisection.
+    auto point = [this](std::int64_t pos) -> std::array<std::int64_t, 3>
+    {
+      return {pos % _nv[0], (pos / _nv[0]) % _nv[1],
+              pos / (_nv[0] * _nv[1])};
+    };
+    std::int64_t lo = 0, hi = _nv[0] * _nv[1] * _nv[2] - 1;
+    while (lo < hi)
+    {
+      // Number of ghosts up to and including position mid
+      const std::int64_t mid = lo + (hi - lo) / 2;
+      const std::array<std::int64_t, 3> r = point(mid);
+      if (mid + 1 - num_owned_before(r) - owned(r) <= v - num_owned)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    std::array<std::int64_t, 3> r = point(lo);
+    return {_c0[0] + r[0], _c0[1] + r[1], _c0[2] + r[2]};
+  }
+
+  /// @brief Local index of a vertex of a local cell.
+  /// @param[in] c Local index of the cell.
+  /// @param[in] k Local index of the vertex on the cell.
+  /// @return The local index of the vertex.
+  std::int32_t cell_vertex(std::int32_t c, int k) const
+  {
+    std::array<std::int64_t, 3> idx = cell_index(c);
+    return vertex({idx[0] + (k & 1), idx[1] + ((k >> 1) & 1),
+                   idx[2] + (k >> 2)});
+  }
+
+  /// @brief Cell-to-vertex map, computed on the fly.
+  /// @return A 2D array with shape `(num_cells, num_vertices)`, where
+  /// `num_vertices` is the number of vertices of a cell.
+  dofmap_type dofmap() const
+  {
+    return dofmap_type(handle_t{this, 0}, _cell_map->size_local(),
+                       _tdim == 3 ? 8 : 4);
+  }
+
+  /// @brief Vertex coordinates, computed on the fly.
+  /// @return A 2D array with shape `(num_vertices, 3)`, with the local
+  /// (owned and ghost) vertices.
+  x_type x() const
+  {
+    return x_type(handle_t{this, 0},
+                  _vertex_map->size_local() + _vertex_map->num_ghosts(), 3);
+  }
+
+private:
+  // Decomposition of the grid into one block per process
+  static impl::GridBlocks create_grid(MPI_Comm comm,
+                                      std::array<std::int64_t, 3> n,
+                                      CellType celltype)
+  {
+    if (celltype != CellType::quadrilateral
+        and celltype != CellType::hexahedron)
+    {
+      throw std::runtime_error(
+          "Structured meshes support quadrilateral and hexahedral cells.");
+    }
+
+    const int tdim = mesh::cell_dim(celltype);
+    if (tdim == 2)
+      n[2] = 0;
+    std::optional<std::array<int, 3>> dims
+        = impl::grid_block_dims(dolfinx::MPI::size(comm), n, tdim);
+    if (!dims)
+    {
+      throw std::runtime_error(
+          "Structured grid cannot be decomposed into one block per process.");
+    }
+
+    return impl::GridBlocks(n, *dims);
+  }
+
+  // True if the vertex at position r (relative to the first cell of
+  // the block) is owned
+  bool owned(std::array<std::int64_t, 3> r) const
+  {
+    return r[0] < _no[0] and r[1] < _no[1] and r[2] < _no[2];
+  }
+
+  // Number of owned vertices that lexicographically precede the vertex
+  // at position r (relative to the first cell of the block)
+  std::int64_t num_owned_before(std::array<std::int64_t, 3> r) const
+  {
+    std::int64_t num = std::min(r[2], _no[2]) * _no[0] * _no[1];
+    if (r[2] < _no[2])
+    {
+      num += std::min(r[1], _no[1]) * _no[0];
+      if (r[1] < _no[1])
+        num += std::min(r[0], _no[0]);
+    }
+    return num;
+  }
+
+  // Communicator
+  dolfinx::MPI::Comm _comm;
+
+  // Cell shape and topological dimension
+  CellType _celltype;
+  int _tdim;
+
+  // Decomposition of the grid into blocks, and the block of this
+  // process
+  impl::GridBlocks _grid;
+  std::array<int, 3> _block;
+
+  // Lower corner and cell size of the grid
+  std::array<T, 3> _p0 = {0, 0, 0};
+  std::array<T, 3> _h = {0, 0, 0};
+
+  // First cell of the block, and the number of cells, vertices and
+  // owned vertices of the block in each direction
+  std::array<std::int64_t, 3> _c0;
+  std::array<std::int64_t, 3> _nc;
+  std::array<std::int64_t, 3> _nv;
+  std::array<std::int64_t, 3> _no;
+
+  // Index maps of the cells and vertices
+  std::shared_ptr<const common::IndexMap> _cell_map;
+  std::shared_ptr<const common::IndexMap> _vertex_map;
+};
+} // namespace dolfinx::mesh
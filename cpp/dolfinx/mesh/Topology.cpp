@@ -10,20 +10,34 @@
 #include "topologycomputation.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/common/memory.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/partition.h>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <set>
+#include <string>
 
 using namespace dolfinx;
 using namespace dolfinx::mesh;
 
 namespace
 {
+/// Memory (bytes) used by an adjacency list. Constant degree lists do
+/// not store offsets.
+std::size_t memory(const graph::AdjacencyList<std::int32_t>& c)
+{
+  std::size_t m = c.array().capacity() * sizeof(std::int32_t);
+  if (!c.degree())
+    m += c.offsets().capacity() * sizeof(std::int32_t);
+  return m;
+}
+
 /// @brief Determine owner and sharing ranks sharing an index.
 ///
 /// @note Collective
@@ -303,11 +317,8 @@ std::array<std::vector<std::int64_t>, 2> vertex_ownership_groups(
   for (auto c : cells_owned)
     local_vertex_set.insert(local_vertex_set.end(), c.begin(), c.end());
 
-  {
-    dolfinx::radix_sort(local_vertex_set);
-    auto [unique_end, range_end] = std::ranges::unique(local_vertex_set);
-    local_vertex_set.erase(unique_end, range_end);
-  }
+  dolfinx::sort_unique(local_vertex_set);
+
   // Build set of ghost cell vertices (attached to a ghost cell)
   std::vector<std::int64_t> ghost_vertex_set;
   ghost_vertex_set.reserve(
@@ -316,11 +327,8 @@ std::array<std::vector<std::int64_t>, 2> vertex_ownership_groups(
   for (auto c : cells_ghost)
     ghost_vertex_set.insert(ghost_vertex_set.end(), c.begin(), c.end());
 
-  {
-    dolfinx::radix_sort(ghost_vertex_set);
-    auto [unique_end, range_end] = std::ranges::unique(ghost_vertex_set);
-    ghost_vertex_set.erase(unique_end, range_end);
-  }
+  dolfinx::sort_unique(ghost_vertex_set);
+
   // Build difference 1: Vertices attached only to owned cells, and
   // therefore owned by this rank
   std::vector<std::int64_t> owned_vertices;
@@ -736,7 +744,8 @@ Topology::Topology(
                               ? *original_index
                               : std::vector<std::vector<std::int64_t>>()),
       _comm(comm), _entity_types({mesh::CellType::point}),
-      _entity_type_offsets({0, 1}), _interprocess_facets(1)
+      _entity_type_offsets({0, 1}), _interprocess_facets(1),
+      _num_interior_cells(cell_types.size(), 0)
 {
   assert(!cell_types.empty());
   std::int8_t tdim = cell_dim(cell_types.front());
@@ -783,6 +792,8 @@ Topology::Topology(
   _connectivity.resize(conn_size);
   for (auto& c : _connectivity)
     c.resize(conn_size);
+  _connectivity_last_use.resize(conn_size,
+                                std::vector<std::int64_t>(conn_size, -1));
 
   // Set data
   this->set_index_map(0, vertex_map);
@@ -807,6 +818,8 @@ void Topology::set_index_map(int dim,
   // Check there is only one index map in this dimension
   if (_entity_type_offsets[dim + 1] - _entity_type_offsets[dim] != 1)
     throw std::runtime_error("Cannot set IndexMap on mixed topology mesh");
+  if (_index_map[_entity_type_offsets[dim]])
+    _boundary_entities.clear();
   _index_map[_entity_type_offsets[dim]] = map;
 }
 //-----------------------------------------------------------------------------
@@ -815,6 +828,8 @@ void Topology::set_index_map(std::int8_t dim, std::int8_t i,
 {
   assert(dim < (std::int8_t)_entity_type_offsets.size() - 1);
   assert(i < (_entity_type_offsets[dim + 1] - _entity_type_offsets[dim]));
+  if (_index_map[_entity_type_offsets[dim] + i])
+    _boundary_entities.clear();
   _index_map[_entity_type_offsets[dim] + i] = map;
 }
 //-----------------------------------------------------------------------------
@@ -834,8 +849,10 @@ Topology::index_maps(std::int8_t dim) const
   return maps;
 }
 //-----------------------------------------------------------------------------
-std::int32_t Topology::create_entities(int dim)
+std::int32_t Topology::create_entities(int dim, int num_threads)
 {
+  std::scoped_lock lock(*_mutex);
+
   // TODO: is this check sufficient/correct? Does not catch the
   // cell_entity entity case. Should there also be a check for
   // connectivity(this->dim(), dim)?
@@ -847,7 +864,7 @@ std::int32_t Topology::create_entities(int dim)
   {
     // Create local entities
     auto [cell_entity, entity_vertex, index_map, interprocess_entities]
-        = compute_entities(_comm.comm(), *this, dim, index);
+        = compute_entities(_comm.comm(), *this, dim, index, num_threads);
 
     for (std::size_t k = 0; k < cell_entity.size(); ++k)
     {
@@ -874,11 +891,13 @@ std::int32_t Topology::create_entities(int dim)
   return this->index_maps(dim)[0]->size_local();
 }
 //-----------------------------------------------------------------------------
-void Topology::create_connectivity(int d0, int d1)
+void Topology::create_connectivity(int d0, int d1, int num_threads)
 {
+  std::scoped_lock lock(*_mutex);
+
   // Make sure entities exist
-  create_entities(d0);
-  create_entities(d1);
+  create_entities(d0, num_threads);
+  create_entities(d1, num_threads);
 
   // Get the number of different entity types in each dimension
   std::int32_t num_d0 = this->entity_types(d0).size();
@@ -891,31 +910,214 @@ void Topology::create_connectivity(int d0, int d1)
     {
       // Compute connectivity
       const auto [c_d0_d1, c_d1_d0]
-          = compute_connectivity(*this, {d0, i0}, {d1, i1});
+          = compute_connectivity(*this, {d0, i0}, {d1, i1}, num_threads);
 
       // NOTE: that to compute the (d0, d1) connections is it sometimes
       // necessary to compute the (d1, d0) connections. We store the (d1,
       // d0) for possible later use, but there is a memory overhead if they
-      // are not required. It may be better to not automatically store
-      // connectivity that was not requested, but advise in a docstring the
-      // most efficient order in which to call this function if several
-      // connectivities are needed.
+      // are not required. The (d1, d0) connectivity is cached and
+      // can be evicted if a memory budget is set.
 
-      // TODO: Caching policy/strategy.
-      // Concerning the note above: Provide an overload
-      // create_connectivity(std::vector<std::pair<int, int>>)?
-
-      // Attach connectivities
+      // Attach connectivities, and mark as cached (computed
+      // connectivities can be evicted and recomputed)
+      std::size_t e0 = _entity_type_offsets[d0] + i0;
+      std::size_t e1 = _entity_type_offsets[d1] + i1;
       if (c_d0_d1)
+      {
         set_connectivity(c_d0_d1, {d0, i0}, {d1, i1});
+        _connectivity_last_use[e0][e1] = 0;
+      }
       if (c_d1_d0)
+      {
         set_connectivity(c_d1_d0, {d1, i1}, {d0, i0});
+        _connectivity_last_use[e1][e0] = _connectivity_clock++;
+      }
+
+      // Mark requested connectivity as most recently used
+      if (_connectivity_last_use[e0][e1] >= 0)
+        _connectivity_last_use[e0][e1] = _connectivity_clock++;
     }
   }
+
+  apply_connectivity_budget(d0, d1);
 }
 //-----------------------------------------------------------------------------
-void Topology::create_entity_permutations()
+std::size_t Topology::connectivity_memory(int d0, int d1) const
 {
+  assert(d0 < (int)_entity_type_offsets.size() - 1);
+  assert(d1 < (int)_entity_type_offsets.size() - 1);
+  std::size_t bytes = 0;
+  for (int e0 = _entity_type_offsets[d0]; e0 < _entity_type_offsets[d0 + 1];
+       ++e0)
+  {
+    for (int e1 = _entity_type_offsets[d1]; e1 < _entity_type_offsets[d1 + 1];
+         ++e1)
+    {
+      if (auto& c = _connectivity[e0][e1]; c)
+        bytes += memory(*c);
+    }
+  }
+
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::cached_connectivity_memory() const
+{
+  std::size_t bytes = 0;
+  for (std::size_t e0 = 0; e0 < _connectivity.size(); ++e0)
+  {
+    for (std::size_t e1 = 0; e1 < _connectivity[e0].size(); ++e1)
+    {
+      if (auto& c = _connectivity[e0][e1];
+          c and _connectivity_last_use[e0][e1] >= 0)
+      {
+        bytes += memory(*c);
+      }
+    }
+  }
+
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+void Topology::set_connectivity_memory_budget(std::size_t bytes)
+{
+  _connectivity_budget = bytes;
+  apply_connectivity_budget(-1, -1);
+}
+//-----------------------------------------------------------------------------
+std::size_t Topology::connectivity_memory_budget() const
+{
+  return _connectivity_budget;
+}
+//-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> Topology::memory_usage() const
+{
+  std::map<std::string, std::size_t> usage;
+  const int tdim = _entity_type_offsets.size() - 2;
+  for (int d0 = 0; d0 <= tdim; ++d0)
+  {
+    for (int d1 = 0; d1 <= tdim; ++d1)
+    {
+      if (std::size_t bytes = connectivity_memory(d0, d1); bytes > 0)
+      {
+        usage["connectivity (" + std::to_string(d0) + ", "
+              + std::to_string(d1) + ")"]
+            = bytes;
+      }
+    }
+  }
+
+  std::size_t& maps = usage["index maps"];
+  for (auto& map : _index_map)
+  {
+    if (map)
+    {
+      for (auto [member, bytes] : map->memory_usage())
+        maps += bytes;
+    }
+  }
+
+  usage["facet permutations"] = common::container_memory(_facet_permutations);
+  usage["cell permutations"] = common::container_memory(_cell_permutations);
+
+  std::size_t& facets = usage["interprocess facets"];
+  for (auto& f : _interprocess_facets)
+    facets += common::container_memory(f);
+
+  std::size_t& boundary = usage["boundary entities"];
+  for (auto& e : _boundary_entities)
+  {
+    if (e)
+      boundary += common::container_memory(*e);
+  }
+
+  std::size_t& cells = usage["original cell index"];
+  for (auto& c : original_cell_index)
+    cells += common::container_memory(c);
+
+  return usage;
+}
+//-----------------------------------------------------------------------------
+void Topology::evict_connectivity(int d0, int d1)
+{
+  assert(d0 < (int)_entity_type_offsets.size() - 1);
+  assert(d1 < (int)_entity_type_offsets.size() - 1);
+  for (int e0 = _entity_type_offsets[d0]; e0 < _entity_type_offsets[d0 + 1];
+       ++e0)
+  {
+    for (int e1 = _entity_type_offsets[d1]; e1 < _entity_type_offsets[d1 + 1];
+         ++e1)
+    {
+      if (_connectivity[e0][e1] and _connectivity_last_use[e0][e1] < 0)
+      {
+        throw std::runtime_error(
+            "Connectivity (" + std::to_string(d0) + ", " + std::to_string(d1)
+            + ") cannot be recomputed and cannot be evicted.");
+      }
+    }
+  }
+
+  for (int e0 = _entity_type_offsets[d0]; e0 < _entity_type_offsets[d0 + 1];
+       ++e0)
+  {
+    for (int e1 = _entity_type_offsets[d1]; e1 < _entity_type_offsets[d1 + 1];
+         ++e1)
+    {
+      _connectivity[e0][e1] = nullptr;
+      _connectivity_last_use[e0][e1] = -1;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void Topology::apply_connectivity_budget(int d0, int d1)
+{
+  std::size_t bytes = cached_connectivity_memory();
+  if (bytes <= _connectivity_budget)
+    return;
+
+  // List cached connectivities that can be evicted, i.e. are not
+  // protected and are not held elsewhere
+  auto in_dim = [this](int e, int d)
+  {
+    return d >= 0 and e >= _entity_type_offsets[d]
+           and e < _entity_type_offsets[d + 1];
+  };
+  std::vector<std::array<std::int64_t, 3>> candidates;
+  for (std::size_t e0 = 0; e0 < _connectivity.size(); ++e0)
+  {
+    for (std::size_t e1 = 0; e1 < _connectivity[e0].size(); ++e1)
+    {
+      auto& c = _connectivity[e0][e1];
+      if (c and _connectivity_last_use[e0][e1] >= 0 and c.use_count() == 1
+          and !(in_dim(e0, d0) and in_dim(e1, d1)))
+      {
+        candidates.push_back(
+            {_connectivity_last_use[e0][e1], std::int64_t(e0),
+             std::int64_t(e1)});
+      }
+    }
+  }
+
+  // Evict least recently used first
+  std::ranges::sort(candidates);
+  for (auto [t, e0, e1] : candidates)
+  {
+    if (bytes <= _connectivity_budget)
+      break;
+
+    spdlog::info("Evicting cached mesh connectivity between entity types "
+                 "{} and {}.",
+                 e0, e1);
+    bytes -= memory(*_connectivity[e0][e1]);
+    _connectivity[e0][e1] = nullptr;
+    _connectivity_last_use[e0][e1] = -1;
+  }
+}
+//-----------------------------------------------------------------------------
+void Topology::create_entity_permutations(int num_threads)
+{
+  std::scoped_lock lock(*_mutex);
+
   if (!_cell_permutations.empty())
     return;
 
@@ -925,14 +1127,80 @@ void Topology::create_entity_permutations()
   // local version? This call does quite a lot of parallel work
   // Create all mesh entities
   for (int d = 0; d < tdim; ++d)
-    create_entities(d);
+    create_entities(d, num_threads);
 
   auto [facet_permutations, cell_permutations]
-      = compute_entity_permutations(*this);
+      = compute_entity_permutations(*this, num_threads);
   _facet_permutations = std::move(facet_permutations);
   _cell_permutations = std::move(cell_permutations);
 }
 //-----------------------------------------------------------------------------
+void Topology::create_facet_permutations(int num_threads)
+{
+  std::scoped_lock lock(*_mutex);
+
+  if (!_facet_permutations.empty())
+    return;
+
+  // Facets are the only entities, other than vertices, that are
+  // required
+  create_entities(this->dim() - 1, num_threads);
+  _facet_permutations = compute_facet_permutations(*this, num_threads);
+}
+//-----------------------------------------------------------------------------
+void Topology::create_boundary_entities(int dim)
+{
+  std::scoped_lock lock(*_mutex);
+
+  const int tdim = this->dim();
+  if (dim < 0 or dim >= tdim)
+    throw std::runtime_error("Invalid dimension of boundary entities.");
+  if (boundary_entities(dim))
+    return;
+
+  create_entities(tdim - 1);
+  create_connectivity(tdim - 1, tdim);
+  std::vector<std::int32_t> facets = mesh::exterior_facet_indices(*this);
+  if (dim < tdim - 1)
+  {
+    create_entities(dim);
+    create_connectivity(tdim - 1, dim);
+  }
+
+  // Connectivities may have been replaced, which clears the data
+  _boundary_entities.resize(tdim);
+  if (dim == tdim - 1)
+  {
+    _boundary_entities[dim]
+        = std::make_shared<const std::vector<std::int32_t>>(std::move(facets));
+  }
+  else
+  {
+    auto f_to_e = connectivity(tdim - 1, dim);
+    assert(f_to_e);
+    std::vector<std::int32_t> entities;
+    for (std::int32_t f : facets)
+    {
+      auto e = f_to_e->links(f);
+      entities.insert(entities.end(), e.begin(), e.end());
+    }
+    dolfinx::radix_sort(entities);
+    auto [unique_end, range_end] = std::ranges::unique(entities);
+    entities.erase(unique_end, range_end);
+    _boundary_entities[dim]
+        = std::make_shared<const std::vector<std::int32_t>>(
+            std::move(entities));
+  }
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<std::int32_t>>
+Topology::boundary_entities(int dim) const
+{
+  if (dim < 0 or dim >= (int)_boundary_entities.size())
+    return nullptr;
+  return _boundary_entities[dim];
+}
+//-----------------------------------------------------------------------------
 std::shared_ptr<const graph::AdjacencyList<std::int32_t>>
 Topology::connectivity(int d0, int d1) const
 {
@@ -964,7 +1232,11 @@ void Topology::set_connectivity(
   // Just sets the first connectivity between (d0, d1) - compatibility
   assert(d0 < (int)_entity_type_offsets.size() - 1);
   assert(d1 < (int)_entity_type_offsets.size() - 1);
+  if (_connectivity[_entity_type_offsets[d0]][_entity_type_offsets[d1]])
+    _boundary_entities.clear();
   _connectivity[_entity_type_offsets[d0]][_entity_type_offsets[d1]] = c;
+  _connectivity_last_use[_entity_type_offsets[d0]][_entity_type_offsets[d1]]
+      = -1;
 }
 //-----------------------------------------------------------------------------
 void Topology::set_connectivity(
@@ -978,9 +1250,31 @@ void Topology::set_connectivity(
   assert(i0 < (_entity_type_offsets[dim0 + 1] - _entity_type_offsets[dim0]));
   assert(dim1 < (std::int8_t)_entity_type_offsets.size() - 1);
   assert(i1 < (_entity_type_offsets[dim1 + 1] - _entity_type_offsets[dim1]));
+  if (_connectivity[_entity_type_offsets[dim0] + i0]
+                   [_entity_type_offsets[dim1] + i1])
+  {
+    _boundary_entities.clear();
+  }
   _connectivity[_entity_type_offsets[dim0] + i0]
                [_entity_type_offsets[dim1] + i1]
       = c;
+  _connectivity_last_use[_entity_type_offsets[dim0] + i0]
+                        [_entity_type_offsets[dim1] + i1]
+      = -1;
+}
+//-----------------------------------------------------------------------------
+std::pair<std::span<const std::uint8_t>, std::span<const std::uint32_t>>
+Topology::entity_permutations() const
+{
+  return {_facet_permutations, _cell_permutations};
+}
+//-----------------------------------------------------------------------------
+void Topology::set_entity_permutations(
+    std::vector<std::uint8_t> facet_permutations,
+    std::vector<std::uint32_t> cell_permutations)
+{
+  _facet_permutations = std::move(facet_permutations);
+  _cell_permutations = std::move(cell_permutations);
 }
 //-----------------------------------------------------------------------------
 const std::vector<std::uint32_t>& Topology::get_cell_permutation_info() const
@@ -1005,8 +1299,9 @@ const std::vector<std::uint8_t>& Topology::get_facet_permutations() const
       or (_facet_permutations.empty()
           and i_map->size_local() + i_map->num_ghosts() > 0))
   {
-    throw std::runtime_error(
-        "create_entity_permutations must be called before using this data.");
+    throw std::runtime_error("create_entity_permutations or "
+                             "create_facet_permutations must be called "
+                             "before using this data.");
   }
 
   return _facet_permutations;
@@ -1023,6 +1318,27 @@ Topology::interprocess_facets(std::int8_t index) const
   return _interprocess_facets.at(index);
 }
 //-----------------------------------------------------------------------------
+void Topology::set_interprocess_facets(std::int8_t index,
+                                       std::vector<std::int32_t> facets)
+{
+  _interprocess_facets.at(index) = std::move(facets);
+}
+//-----------------------------------------------------------------------------
+std::array<std::int32_t, 4> Topology::cell_ranges(std::int8_t index) const
+{
+  auto map = this->index_maps(this->dim()).at(index);
+  assert(map);
+  const std::int32_t num_owned = map->size_local();
+  return {0, std::min(_num_interior_cells[index], num_owned), num_owned,
+          num_owned + map->num_ghosts()};
+}
+//-----------------------------------------------------------------------------
+void Topology::set_num_interior_cells(std::int8_t index,
+                                      std::int32_t num_cells)
+{
+  _num_interior_cells.at(index) = num_cells;
+}
+//-----------------------------------------------------------------------------
 mesh::CellType Topology::cell_type() const { return _entity_types.back(); }
 //-----------------------------------------------------------------------------
 std::vector<CellType> Topology::entity_types(std::int8_t dim) const
@@ -1135,18 +1451,24 @@ Topology mesh::create_topology(
 
   // Get global indices of ghost cells
   std::vector<std::vector<std::int64_t>> cell_ghost_indices;
-  std::vector<std::shared_ptr<const common::IndexMap>> index_map_c;
   for (std::size_t i = 0; i < cell_type.size(); ++i)
   {
     std::span cell_idx(original_cell_index[i]);
     cell_ghost_indices.push_back(graph::build::compute_ghost_indices(
         comm, cell_idx.first(num_local_cells[i]),
         cell_idx.last(ghost_owners[i].size()), ghost_owners[i]));
+  }
 
-    // Create index maps for each cell type
-    index_map_c.push_back(std::make_shared<common::IndexMap>(
-        comm, num_local_cells[i], cell_ghost_indices[i], ghost_owners[i],
-        static_cast<int>(dolfinx::MPI::tag::consensus_nbx) + i));
+  // Create index maps for each cell type, with the destination ranks
+  // of all cell types computed together
+  std::vector<std::shared_ptr<const common::IndexMap>> index_map_c;
+  {
+    std::vector<std::span<const std::int64_t>> ghosts(
+        cell_ghost_indices.begin(), cell_ghost_indices.end());
+    std::vector<common::IndexMap> maps = common::create_index_maps(
+        comm, num_local_cells, ghosts, ghost_owners);
+    for (common::IndexMap& map : maps)
+      index_map_c.push_back(std::make_shared<common::IndexMap>(std::move(map)));
   }
 
   // Send and receive  ((input vertex index) -> (new global index, owner
@@ -1274,22 +1596,25 @@ Topology mesh::create_topology(
   //
   // Note: This step is required only for meshes with ghost cells and
   // could be skipped when the mesh is not ghosted.
-  std::vector<int> dest;
+  std::vector<int> src, dest;
+  if (dolfinx::MPI::size(comm) > 1)
   {
     // Build list of ranks that own vertices that are ghosted by this
     // rank (out edges)
-    std::vector<int> src = ghost_vertex_owners;
-    dolfinx::radix_sort(src);
-    auto [unique_end, range_end] = std::ranges::unique(src);
-    src.erase(unique_end, range_end);
+    src = ghost_vertex_owners;
+    dolfinx::sort_unique(src);
 
-    dest = dolfinx::MPI::compute_graph_edges_nbx(comm, src);
+    dest = dolfinx::MPI::compute_graph_edges_nbx(
+        comm, src, static_cast<int>(dolfinx::MPI::tag::consensus_nbx) + 1);
+    std::ranges::sort(dest);
   }
 
-  // Create index map for vertices
+  // Create index map for vertices, re-using the computed source and
+  // destination ranks
   auto index_map_v = std::make_shared<common::IndexMap>(
-      comm, owned_vertices.size(), ghost_vertices, ghost_vertex_owners,
-      static_cast<int>(dolfinx::MPI::tag::consensus_nbx) + cell_type.size());
+      comm, owned_vertices.size(),
+      std::array<std::vector<int>, 2>{std::move(src), std::move(dest)},
+      ghost_vertices, ghost_vertex_owners);
 
   // Set cell index map and connectivity
   std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>> cells_c;
@@ -1305,8 +1630,37 @@ Topology mesh::create_topology(
   for (auto& idx : original_cell_index)
     orig_index.emplace_back(idx.begin(), idx.end());
 
-  return Topology(comm, cell_type, index_map_v, index_map_c, cells_c,
-                  orig_index);
+  Topology topology(comm, cell_type, index_map_v, index_map_c, cells_c,
+                    orig_index);
+
+  // Count the owned cells at the start of the cell list that do not
+  // have a vertex that is shared with another process
+  {
+    std::vector<std::int8_t> shared_vertex(
+        index_map_v->size_local() + index_map_v->num_ghosts(), 0);
+    std::fill(std::next(shared_vertex.begin(), index_map_v->size_local()),
+              shared_vertex.end(), 1);
+    if (dolfinx::MPI::size(comm) > 1)
+    {
+      for (std::int32_t v : index_map_v->shared_indices())
+        shared_vertex[v] = 1;
+    }
+
+    for (std::size_t i = 0; i < cell_type.size(); ++i)
+    {
+      const graph::AdjacencyList<std::int32_t>& c = *cells_c[i];
+      std::int32_t num_interior = 0;
+      while (num_interior < num_local_cells[i]
+             and std::ranges::none_of(c.links(num_interior), [&](auto v)
+                                      { return shared_vertex[v]; }))
+      {
+        ++num_interior;
+      }
+      topology.set_num_interior_cells(i, num_interior);
+    }
+  }
+
+  return topology;
 }
 //-----------------------------------------------------------------------------
 Topology
@@ -1423,24 +1777,33 @@ mesh::entities_to_index(const Topology& topology, int dim,
   const int num_vertices_per_entity
       = cell_num_entities(cell_entity_type(topology.cell_type(), dim, 0), 0);
 
-  // Build map from ordered local vertex indices (key) to entity index
-  // (value)
-  std::map<std::vector<std::int32_t>, std::int32_t> entity_key_to_index;
-  std::vector<std::int32_t> key(num_vertices_per_entity);
-  const int num_entities_mesh = map_e->size_local() + map_e->num_ghosts();
-  for (int e = 0; e < num_entities_mesh; ++e)
+  // Sorted vertices (key) of each entity, and the entities in order of
+  // their keys
+  const std::size_t num_entities_mesh
+      = map_e->size_local() + map_e->num_ghosts();
+  std::vector<std::int32_t> keys(num_entities_mesh * num_vertices_per_entity);
+  auto key = [&keys, num_vertices_per_entity](std::int32_t e)
   {
-    auto vertices = e_to_v->links(e);
-    std::ranges::copy(vertices, key.begin());
-    std::ranges::sort(key);
-    auto ins = entity_key_to_index.insert({key, e});
-    if (!ins.second)
+    return std::span<std::int32_t>(keys.data() + e * num_vertices_per_entity,
+                                   num_vertices_per_entity);
+  };
+  for (std::size_t e = 0; e < num_entities_mesh; ++e)
+  {
+    std::ranges::copy(e_to_v->links(e), key(e).begin());
+    std::ranges::sort(key(e));
+  }
+  const std::vector<std::int32_t> perm = dolfinx::sort_by_perm(
+      std::span<const std::int32_t>(keys), num_vertices_per_entity);
+  for (std::size_t i = 1; i < perm.size(); ++i)
+  {
+    if (std::ranges::equal(key(perm[i - 1]), key(perm[i])))
       throw std::runtime_error("Duplicate mesh entity detected.");
   }
 
   assert(entities.size() % num_vertices_per_entity == 0);
 
-  // Iterate over all entities and find index
+  // Iterate over all entities and find index by binary search of the
+  // sorted keys
   std::vector<std::int32_t> indices;
   indices.reserve(entities.size() / num_vertices_per_entity);
   std::vector<std::int32_t> vertices(num_vertices_per_entity);
@@ -1449,11 +1812,10 @@ mesh::entities_to_index(const Topology& topology, int dim,
     auto v = entities.subspan(e, num_vertices_per_entity);
     std::ranges::copy(v, vertices.begin());
     std::ranges::sort(vertices);
-    if (auto it = entity_key_to_index.find(vertices);
-        it != entity_key_to_index.end())
-    {
-      indices.push_back(it->second);
-    }
+    auto it = std::ranges::lower_bound(
+        perm, vertices, std::ranges::lexicographical_compare, key);
+    if (it != perm.end() and std::ranges::equal(key(*it), vertices))
+      indices.push_back(*it);
     else
       indices.push_back(-1);
   }
@@ -7,12 +7,18 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
+#include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace dolfinx::common
@@ -38,9 +44,30 @@ enum class CellType;
 /// where dim is the topological dimension and i is the index of the
 /// entity within that topological dimension.
 ///
-/// @todo Rework memory management and associated API. Currently, there
-/// is no clear caching policy implemented and no way of discarding
-/// cached data.
+/// Connectivities that define the mesh entities, i.e. `(d, 0)` and
+/// `(tdim, d)`, and connectivities set with set_connectivity() are
+/// retained for the life of the topology. Connectivities computed by
+/// create_connectivity() from these are cached and can be evicted,
+/// either explicitly with evict_connectivity() or automatically when
+/// their memory footprint exceeds a budget (see
+/// set_connectivity_memory_budget()). An evicted connectivity is
+/// recomputed by the next call to create_connectivity().
+///
+/// Thread safety: the lazy creation functions (create_entities,
+/// create_connectivity, create_entity_permutations,
+/// create_facet_permutations and create_boundary_entities) may be
+/// called concurrently from several threads, e.g. by assemblers and
+/// interpolation running concurrently on the same mesh. They are
+/// serialised by a lock, and a call that finds the data already
+/// computed returns without computing it. Data returned by the const
+/// accessors may be read concurrently once the function that creates
+/// it has returned. Functions that evict or replace data, e.g.
+/// evict_connectivity, set_connectivity, set_index_map, and eviction to
+/// meet a connectivity memory budget, must not be called concurrently
+/// with readers of the data. The creation functions are collective on
+/// the topology communicator, which therefore requires
+/// `MPI_THREAD_MULTIPLE` if different threads create data for
+/// topologies on the same communicator.
 class Topology
 {
 public:
@@ -193,7 +220,8 @@ public:
   /// `facet_index` of the cell with index `cell_index`.
   /// @return The encoded permutation info
   /// @note An exception is raised if the permutations have not been
-  /// computed
+  /// computed, see create_entity_permutations and
+  /// create_facet_permutations
   const std::vector<std::uint8_t>& get_facet_permutations() const;
 
   /// @brief Cell type
@@ -207,18 +235,115 @@ public:
 
   /// @brief Create entities of given topological dimension.
   /// @param[in] dim Topological dimension
+  /// @param[in] num_threads Number of threads used for the local part
+  /// of the entity computation. See mesh::compute_entities.
   /// @return Number of newly created entities, returns -1 if entities
   /// already existed
-  std::int32_t create_entities(int dim);
+  std::int32_t create_entities(int dim, int num_threads = 1);
 
   /// @brief Create connectivity between given pair of dimensions, `d0
   /// -> d1`.
   /// @param[in] d0 Topological dimension
   /// @param[in] d1 Topological dimension
-  void create_connectivity(int d0, int d1);
+  ///
+  /// If the connectivity has already been computed this function does
+  /// nothing, other than marking the connectivity as recently used. If
+  /// a connectivity memory budget has been set, least recently used
+  /// cached connectivities (excluding `d0 -> d1`) are evicted until the
+  /// budget is met. Connectivities that are held elsewhere, e.g. by a
+  /// caller of connectivity(), are not evicted.
+  ///
+  /// @note When a memory budget has been set, a connectivity computed
+  /// by this function may later be evicted. Call this function before
+  /// connectivity() to ensure that the connectivity is available.
+  ///
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  /// @param[in] num_threads Number of threads used to create missing
+  /// entities and to compute the connectivity
+  void create_connectivity(int d0, int d1, int num_threads = 1);
+
+  /// @brief Memory used by the connectivity `d0 -> d1`.
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  /// @return Memory (bytes) used by the connectivities between all
+  /// entity types of dimension `d0` and `d1`. Zero if the connectivity
+  /// has not been computed.
+  std::size_t connectivity_memory(int d0, int d1) const;
+
+  /// @brief Memory used by cached connectivities, i.e. the
+  /// connectivities that can be evicted.
+  /// @return Memory (bytes)
+  std::size_t cached_connectivity_memory() const;
+
+  /// @brief Set the memory budget for cached connectivities.
+  ///
+  /// Cached connectivities are evicted (least recently used first)
+  /// until their total memory is within the budget. The budget is
+  /// unlimited by default.
+  ///
+  /// @param[in] bytes Memory budget (bytes)
+  void set_connectivity_memory_budget(std::size_t bytes);
+
+  /// @brief Memory budget for cached connectivities.
+  /// @return Memory budget (bytes)
+  std::size_t connectivity_memory_budget() const;
+
+  /// @brief Memory (bytes) used by the topology on this process, by
+  /// member.
+  ///
+  /// Computed connectivities are listed separately for each pair of
+  /// dimensions. The index maps of the entities are included.
+  ///
+  /// @return Map from member names to memory.
+  std::map<std::string, std::size_t> memory_usage() const;
+
+  /// @brief Release the connectivity `d0 -> d1`.
+  ///
+  /// The connectivity is recomputed by the next call to
+  /// create_connectivity(d0, d1). Calling this function for a
+  /// connectivity that has not been computed does nothing.
+  ///
+  /// @param[in] d0 Topological dimension
+  /// @param[in] d1 Topological dimension
+  /// @throws std::runtime_error if the connectivity defines the mesh
+  /// entities, or was set with set_connectivity(), and therefore cannot
+  /// be recomputed.
+  void evict_connectivity(int d0, int d1);
 
   /// @brief Compute entity permutations and reflections.
-  void create_entity_permutations();
+  /// @param[in] num_threads Number of threads used to create the
+  /// entities and to compute the permutations.
+  void create_entity_permutations(int num_threads = 1);
+
+  /// @brief Compute the facet permutations only.
+  ///
+  /// This is the data required by interior facet integrals (see
+  /// get_facet_permutations). Only the facets are created, whereas
+  /// create_entity_permutations creates the entities of all
+  /// dimensions, e.g. the edges of all (owned and ghost) cells of a 3D
+  /// mesh. The cell permutation data is not computed.
+  /// @param[in] num_threads Number of threads used to create the facets
+  /// and to compute the permutations.
+  void create_facet_permutations(int num_threads = 1);
+
+  /// @brief The stored entity permutation data.
+  ///
+  /// Unlike get_facet_permutations and get_cell_permutation_info, no
+  /// exception is raised if the data has not been computed.
+  /// @return The facet permutations and the cell permutation info,
+  /// which are empty if they have not been computed.
+  std::pair<std::span<const std::uint8_t>, std::span<const std::uint32_t>>
+  entity_permutations() const;
+
+  /// @brief Set the entity permutation data, e.g. data that has been
+  /// computed for the same topology and stored.
+  /// @param[in] facet_permutations Facet permutations (see
+  /// get_facet_permutations).
+  /// @param[in] cell_permutations Cell permutation info (see
+  /// get_cell_permutation_info).
+  void set_entity_permutations(std::vector<std::uint8_t> facet_permutations,
+                               std::vector<std::uint32_t> cell_permutations);
 
   /// @brief List of inter-process facets.
   ///
@@ -236,6 +361,63 @@ public:
   /// @param index Index of facet type
   const std::vector<std::int32_t>& interprocess_facets(std::int8_t index) const;
 
+  /// @brief Set the list of inter-process facets for the facet type
+  /// identified by index, e.g. a list that has been computed for the
+  /// same topology and stored.
+  /// @param index Index of facet type
+  /// @param facets Inter-process facets
+  void set_interprocess_facets(std::int8_t index,
+                               std::vector<std::int32_t> facets);
+
+  /// @brief Compute and store the boundary entities of a given
+  /// dimension.
+  ///
+  /// For `dim = tdim - 1` the boundary entities are the owned exterior
+  /// facets (see mesh::exterior_facet_indices). For `dim < tdim - 1`
+  /// they are the (owned and ghost) entities attached to the owned
+  /// exterior facets, e.g. the boundary vertices (`dim = 0`) and edges
+  /// (`dim = 1`). The entities and connectivities that are required
+  /// are created. Calls after the first call do nothing.
+  ///
+  /// The stored data is cleared when an index map or a connectivity
+  /// of the topology is replaced.
+  ///
+  /// @param[in] dim Topological dimension of the entities.
+  void create_boundary_entities(int dim);
+
+  /// @brief Boundary entities of a given dimension (see
+  /// create_boundary_entities).
+  /// @param[in] dim Topological dimension of the entities.
+  /// @return Sorted list of boundary entities, or `nullptr` if the
+  /// boundary entities have not been computed.
+  std::shared_ptr<const std::vector<std::int32_t>>
+  boundary_entities(int dim) const;
+
+  /// @brief Offsets of the ranges of cells, of the cell type in
+  /// `Topology::entity_types` identified by index, that are interior
+  /// to the process, on the process boundary and ghosts.
+  ///
+  /// For the returned offsets `r`, the owned cells in `[r[0], r[1])`
+  /// do not share a vertex, and hence any entity, with another
+  /// process. The cells in `[r[1], r[2])` are the remaining owned
+  /// cells, which may share entities with other processes, and the
+  /// cells in `[r[2], r[3])` are ghost cells. The interior range is the
+  /// longest run of interior cells at the start of the cell list.
+  /// mesh::create_mesh orders the owned cells so that it contains all
+  /// interior cells.
+  ///
+  /// @param index Index of cell type.
+  /// @return Offsets of the cell ranges.
+  std::array<std::int32_t, 4> cell_ranges(std::int8_t index = 0) const;
+
+  /// @brief Set the number of owned cells at the start of the cell
+  /// list that do not share a vertex with another process (see
+  /// Topology::cell_ranges).
+  /// @warning This is experimental and likely to change
+  /// @param index Index of cell type.
+  /// @param num_cells Number of interior cells.
+  void set_num_interior_cells(std::int8_t index, std::int32_t num_cells);
+
   /// Original cell index for each cell type
   std::vector<std::vector<std::int64_t>> original_cell_index;
 
@@ -244,6 +426,11 @@ public:
   MPI_Comm comm() const;
 
 private:
+  // Evict least recently used cached connectivities until the memory
+  // budget is met. Connectivities from entities of dimension d0 to
+  // entities of dimension d1 are not evicted.
+  void apply_connectivity_budget(int d0, int d1);
+
   // MPI communicator
   dolfinx::MPI::Comm _comm;
 
@@ -270,6 +457,17 @@ private:
   std::vector<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>>
       _connectivity;
 
+  // Last use of each connectivity in _connectivity that has been
+  // computed by create_connectivity and can be evicted, in units of
+  // _connectivity_clock. Connectivities that cannot be evicted are -1.
+  std::vector<std::vector<std::int64_t>> _connectivity_last_use;
+
+  // Counter used to order connectivity use
+  std::int64_t _connectivity_clock = 0;
+
+  // Memory budget (bytes) for connectivities that can be evicted
+  std::size_t _connectivity_budget = std::numeric_limits<std::size_t>::max();
+
   // The facet permutations (local facet, cell))
   // [cell0_0, cell0_1, ,cell0_2, cell1_0, cell1_1, ,cell1_2, ...,
   // celln_0, celln_1, ,celln_2,]
@@ -281,6 +479,19 @@ private:
 
   // List of facets that are on the inter-process boundary for each facet type
   std::vector<std::vector<std::int32_t>> _interprocess_facets;
+
+  // Number of owned cells at the start of the cell list that are
+  // interior to the process, for each cell type
+  std::vector<std::int32_t> _num_interior_cells;
+
+  // Boundary entities of each dimension (nullptr if not computed)
+  std::vector<std::shared_ptr<const std::vector<std::int32_t>>>
+      _boundary_entities;
+
+  // Lock for the lazy creation of data. It is recursive since creation
+  // functions call each other, and is shared by copies of the topology.
+  std::shared_ptr<std::recursive_mutex> _mutex
+      = std::make_shared<std::recursive_mutex>();
 };
 
 /// @brief Create a mesh topology.
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <limits>
 #include <mpi.h>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -72,6 +73,14 @@ Mesh<T> build_prism(MPI_Comm comm, MPI_Comm subcomm,
                     std::array<std::array<T, 3>, 2> p,
                     std::array<std::int64_t, 3> n,
                     const CellPartitionFunction& partitioner);
+
+std::optional<std::array<int, 3>>
+grid_block_dims(int size, std::array<std::int64_t, 3> n, int tdim);
+
+template <std::floating_point T>
+Mesh<T> build_grid_blocks(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
+                          std::array<std::int64_t, 3> n, CellType celltype,
+                          DiagonalType diagonal, std::array<int, 3> dims);
 } // namespace impl
 
 /// @brief Create a uniform mesh::Mesh over rectangular prism spanned by
@@ -92,7 +101,11 @@ Mesh<T> build_prism(MPI_Comm comm, MPI_Comm subcomm,
 /// @param[in] n Number of cells in each direction.
 /// @param[in] celltype Cell shape.
 /// @param[in] partitioner Partitioning function for distributing cells
-/// across MPI ranks.
+/// across MPI ranks. If not callable and `subcomm` is (congruent to)
+/// `comm`, each process creates the cells of a block of the grid
+/// directly and the mesh is not partitioned (see
+/// impl::build_grid_blocks). Otherwise the cells are distributed by
+/// the default partitioner.
 /// @return Mesh
 template <std::floating_point T = double>
 Mesh<T> create_box(MPI_Comm comm, MPI_Comm subcomm,
@@ -109,8 +122,23 @@ Mesh<T> create_box(MPI_Comm comm, MPI_Comm subcomm,
       throw std::runtime_error("It must hold p[0] < p[1].");
   }
 
-  if (!partitioner and dolfinx::MPI::size(comm) > 1)
+  if (const int size = dolfinx::MPI::size(comm); !partitioner and size > 1)
+  {
+    int cmp = MPI_UNEQUAL;
+    if (subcomm != MPI_COMM_NULL)
+      MPI_Comm_compare(comm, subcomm, &cmp);
+    auto dims = impl::grid_block_dims(size, n, 3);
+    if ((cmp == MPI_IDENT or cmp == MPI_CONGRUENT) and dims
+        and (celltype == CellType::tetrahedron
+             or celltype == CellType::hexahedron
+             or celltype == CellType::prism))
+    {
+      return impl::build_grid_blocks<T>(comm, p, n, celltype,
+                                        DiagonalType::right, *dims);
+    }
+
     partitioner = create_cell_partitioner();
+  }
 
   switch (celltype)
   {
@@ -162,7 +190,10 @@ Mesh<T> create_box(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
 /// @param[in] n Number of cells in each direction.
 /// @param[in] celltype Cell shape.
 /// @param[in] partitioner Partitioning function for distributing cells
-/// across MPI ranks.
+/// across MPI ranks. If not callable, each process creates the cells
+/// of a block of the grid directly and the mesh is not partitioned
+/// (see impl::build_grid_blocks), except for crossed diagonals, for
+/// which the cells are distributed by the default partitioner.
 /// @param[in] diagonal Direction of diagonals
 /// @return Mesh
 template <std::floating_point T = double>
@@ -180,8 +211,21 @@ Mesh<T> create_rectangle(MPI_Comm comm, std::array<std::array<T, 2>, 2> p,
       throw std::runtime_error("It must hold p[0] < p[1].");
   }
 
-  if (!partitioner and dolfinx::MPI::size(comm) > 1)
+  if (const int size = dolfinx::MPI::size(comm); !partitioner and size > 1)
+  {
+    auto dims = impl::grid_block_dims(size, {n[0], n[1], 0}, 2);
+    if (dims
+        and (celltype == CellType::quadrilateral
+             or (celltype == CellType::triangle
+                 and diagonal != DiagonalType::crossed)))
+    {
+      return impl::build_grid_blocks<T>(
+          comm, {{{p[0][0], p[0][1], 0}, {p[1][0], p[1][1], 0}}},
+          {n[0], n[1], 0}, celltype, diagonal, *dims);
+    }
+
     partitioner = create_cell_partitioner();
+  }
 
   switch (celltype)
   {
@@ -680,5 +724,274 @@ Mesh<T> build_quad(MPI_Comm comm, const std::array<std::array<T, 2>, 2> p,
                        std::vector<T>{}, {0, 2}, partitioner);
   }
 }
+
+/// @brief Decomposition of a structured grid of cells into blocks, one
+/// block for each process.
+///
+/// The process with rank `r` owns the block with index
+/// `(r % d[0], (r / d[0]) % d[1], r / (d[0] * d[1]))`, where `d` is the
+/// number of blocks in each direction. A process owns the vertices of
+/// its cells, except the vertices on the upper sides of its block that
+/// are interior to the grid. The vertices are numbered consecutively by
+/// process, and lexicographically on a process.
+struct GridBlocks
+{
+  /// @param[in] n Number of cells in each direction (`n[2] = 0` for 2D
+  /// grids).
+  /// @param[in] d Number of blocks in each direction.
+  GridBlocks(std::array<std::int64_t, 3> n, std::array<int, 3> d)
+      : n(n), d(d), offsets(d[0] * d[1] * d[2] + 1, 0)
+  {
+    for (std::size_t r = 0; r + 1 < offsets.size(); ++r)
+    {
+      std::array<int, 3> b = block(r);
+      std::int64_t num_vertices = 1;
+      for (int i = 0; i < 3; ++i)
+      {
+        auto [v0, v1] = vertices(i, b[i]);
+        num_vertices *= v1 - v0;
+      }
+      offsets[r + 1] = offsets[r] + num_vertices;
+    }
+  }
+
+  /// Block index of a process
+  std::array<int, 3> block(int rank) const
+  {
+    return {rank % d[0], (rank / d[0]) % d[1], rank / (d[0] * d[1])};
+  }
+
+  /// Range of cells of block `b` in direction `i`
+  std::array<std::int64_t, 2> cells(int i, int b) const
+  {
+    return dolfinx::MPI::local_range(b, n[i], d[i]);
+  }
+
+  /// Range of vertices owned by block `b` in direction `i`
+  std::array<std::int64_t, 2> vertices(int i, int b) const
+  {
+    auto [c0, c1] = cells(i, b);
+    return {c0, b == d[i] - 1 ? n[i] + 1 : c1};
+  }
+
+  /// Block index of the process that owns the vertex at a grid point
+  std::array<int, 3> vertex_block(std::array<std::int64_t, 3> idx) const
+  {
+    std::array<int, 3> b;
+    for (int i = 0; i < 3; ++i)
+    {
+      b[i] = idx[i] >= n[i] ? d[i] - 1
+                            : dolfinx::MPI::index_owner(d[i], idx[i], n[i]);
+    }
+    return b;
+  }
+
+  /// Rank of the process that owns the vertex at a grid point
+  int vertex_owner(std::array<std::int64_t, 3> idx) const
+  {
+    std::array<int, 3> b = vertex_block(idx);
+    return b[0] + d[0] * (b[1] + d[1] * b[2]);
+  }
+
+  /// Global index of the vertex at a grid point
+  std::int64_t vertex(std::array<std::int64_t, 3> idx) const
+  {
+    std::array<int, 3> b = vertex_block(idx);
+    std::int64_t local = 0, stride = 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      auto [v0, v1] = vertices(i, b[i]);
+      local += (idx[i] - v0) * stride;
+      stride *= v1 - v0;
+    }
+    return offsets[b[0] + d[0] * (b[1] + d[1] * b[2])] + local;
+  }
+
+  std::array<std::int64_t, 3> n;
+  std::array<int, 3> d;
+
+  // Global index of the first vertex owned by each process
+  std::vector<std::int64_t> offsets;
+};
+
+/// @brief Number of blocks in each direction for a decomposition of a
+/// structured grid into `size` blocks.
+///
+/// Chooses the factorisation of `size` that minimises the area of the
+/// block interfaces, with at least one cell in each block.
+///
+/// @param[in] size Number of blocks.
+/// @param[in] n Number of cells in each direction.
+/// @param[in] tdim Dimension of the grid.
+/// @return Number of blocks in each direction, or `std::nullopt` if the
+/// grid cannot be decomposed into `size` non-empty blocks.
+inline std::optional<std::array<int, 3>>
+grid_block_dims(int size, std::array<std::int64_t, 3> n, int tdim)
+{
+  std::optional<std::array<int, 3>> dims;
+  std::int64_t min_cost = std::numeric_limits<std::int64_t>::max();
+  for (int d0 = 1; d0 <= size; ++d0)
+  {
+    if (size % d0 != 0 or d0 > n[0])
+      continue;
+    for (int d1 = 1; d1 <= size / d0; ++d1)
+    {
+      const int d2 = size / (d0 * d1);
+      if ((size / d0) % d1 != 0 or d1 > n[1]
+          or (tdim == 3 ? d2 > n[2] : d2 != 1))
+      {
+        continue;
+      }
+
+      // Number of interface facets
+      const std::array<std::int64_t, 3> m
+          = {n[0], n[1], tdim == 3 ? n[2] : 1};
+      const std::int64_t cost = (d0 - 1) * m[1] * m[2]
+                                + (d1 - 1) * m[0] * m[2]
+                                + (d2 - 1) * m[0] * m[1];
+      if (cost < min_cost)
+      {
+        min_cost = cost;
+        dims = {d0, d1, d2};
+      }
+    }
+  }
+
+  return dims;
+}
+
+/// @brief Create a mesh of a structured grid, with each process
+/// creating the cells of its block of the grid (see GridBlocks).
+///
+/// The cells are not partitioned or re-distributed, and the mesh has no
+/// ghost cells. The cell and vertex data of a process is computed
+/// directly from the position of its block.
+///
+/// @param[in] comm MPI communicator to build the mesh on.
+/// @param[in] p Corners of the grid (`p[i][2]` is not used for 2D
+/// grids).
+/// @param[in] n Number of cells in each direction (`n[2] = 0` for 2D
+/// grids).
+/// @param[in] celltype Cell shape.
+/// @param[in] diagonal Direction of diagonals (triangles only).
+/// @param[in] dims Number of blocks in each direction, see
+/// grid_block_dims.
+/// @return Mesh
+template <std::floating_point T>
+Mesh<T> build_grid_blocks(MPI_Comm comm, std::array<std::array<T, 3>, 2> p,
+                          std::array<std::int64_t, 3> n, CellType celltype,
+                          DiagonalType diagonal, std::array<int, 3> dims)
+{
+  common::Timer timer("Build structured mesh (blocks)");
+  const int tdim = mesh::cell_dim(celltype);
+  const GridBlocks grid(n, dims);
+
+  std::array<T, 3> h = {0, 0, 0};
+  for (int i = 0; i < tdim; ++i)
+  {
+    h[i] = (p[1][i] - p[0][i]) / static_cast<T>(n[i]);
+    if (std::abs(h[i]) < 2.0 * std::numeric_limits<T>::epsilon())
+    {
+      throw std::runtime_error(
+          "Mesh seems to have zero width, height or depth. Check dimensions");
+    }
+  }
+
+  // Ranges of the owned vertices and cells
+  const int rank = dolfinx::MPI::rank(comm);
+  const std::array<int, 3> b = grid.block(rank);
+  std::array<std::array<std::int64_t, 2>, 3> vr;
+  std::array<std::array<std::int64_t, 2>, 3> cr;
+  for (int i = 0; i < 3; ++i)
+  {
+    vr[i] = grid.vertices(i, b[i]);
+    cr[i] = grid.cells(i, b[i]);
+  }
+  if (tdim == 2)
+    cr[2] = {0, 1};
+
+  // Coordinates of the owned vertices
+  std::vector<T> x;
+  x.reserve((grid.offsets[rank + 1] - grid.offsets[rank]) * tdim);
+  for (std::int64_t iz = vr[2][0]; iz < vr[2][1]; ++iz)
+  {
+    for (std::int64_t iy = vr[1][0]; iy < vr[1][1]; ++iy)
+    {
+      for (std::int64_t ix = vr[0][0]; ix < vr[0][1]; ++ix)
+      {
+        const std::array<std::int64_t, 3> idx = {ix, iy, iz};
+        for (int i = 0; i < tdim; ++i)
+          x.push_back(p[0][i] + static_cast<T>(idx[i]) * h[i]);
+      }
+    }
+  }
+
+  // Cells of the block, with the vertices of each grid cell ordered
+  // lexicographically
+  const int num_corners = tdim == 3 ? 8 : 4;
+  std::vector<std::int64_t> cells;
+  std::array<std::int64_t, 8> v = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (std::int64_t iz = cr[2][0]; iz < cr[2][1]; ++iz)
+  {
+    for (std::int64_t iy = cr[1][0]; iy < cr[1][1]; ++iy)
+    {
+      for (std::int64_t ix = cr[0][0]; ix < cr[0][1]; ++ix)
+      {
+        for (int k = 0; k < num_corners; ++k)
+        {
+          v[k] = grid.vertex(
+              {ix + (k & 1), iy + ((k >> 1) & 1), iz + (k >> 2)});
+        }
+        const auto [v0, v1, v2, v3, v4, v5, v6, v7] = v;
+
+        switch (celltype)
+        {
+        case CellType::tetrahedron:
+          cells.insert(cells.end(),
+                       {v0, v1, v3, v7, v0, v1, v7, v5, v0, v5, v7, v4,
+                        v0, v3, v2, v7, v0, v6, v4, v7, v0, v2, v6, v7});
+          break;
+        case CellType::hexahedron:
+          cells.insert(cells.end(), {v0, v1, v2, v3, v4, v5, v6, v7});
+          break;
+        case CellType::prism:
+          cells.insert(cells.end(), {v0, v1, v2, v4, v5, v6});
+          cells.insert(cells.end(), {v1, v2, v3, v5, v6, v7});
+          break;
+        case CellType::quadrilateral:
+          cells.insert(cells.end(), {v0, v1, v2, v3});
+          break;
+        case CellType::triangle:
+        {
+          DiagonalType local_diagonal = diagonal;
+          if (diagonal == DiagonalType::right_left)
+          {
+            local_diagonal = (ix + iy) % 2 == 0 ? DiagonalType::left
+                                                : DiagonalType::right;
+          }
+          else if (diagonal == DiagonalType::left_right)
+          {
+            local_diagonal = (ix + iy) % 2 == 0 ? DiagonalType::right
+                                                : DiagonalType::left;
+          }
+
+          if (local_diagonal == DiagonalType::left)
+            cells.insert(cells.end(), {v0, v1, v2, v1, v2, v3});
+          else
+            cells.insert(cells.end(), {v0, v1, v3, v0, v2, v3});
+          break;
+        }
+        default:
+          throw std::runtime_error("Unsupported cell type for grid blocks.");
+        }
+      }
+    }
+  }
+
+  fem::CoordinateElement<T> element(celltype, 1);
+  return create_mesh(comm, comm, cells, element, comm, x,
+                     {x.size() / tdim, static_cast<std::size_t>(tdim)},
+                     nullptr);
+}
 } // namespace impl
 } // namespace dolfinx::mesh
@@ -12,6 +12,7 @@
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
 #include <span>
 #include <utility>
 #include <vector>
@@ -107,7 +108,7 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
     fshape1 = recv_buffer_r[0];
     vrange = {-recv_buffer_r[1], recv_buffer_r[2] + 1};
 
-    spdlog::debug("Max. vertices per facet={}", fshape1);
+    DOLFINX_LOG_DEBUG("Max. vertices per facet={}", fshape1);
   }
   const std::int32_t buffer_shape1 = fshape1 + 1;
 
@@ -348,6 +349,149 @@ graph::AdjacencyList<std::int64_t> compute_nonlocal_dual_graph(
   return graph::AdjacencyList(std::move(data), std::move(offsets));
 }
 //-----------------------------------------------------------------------------
+/// @brief Sort the rows of a row-major array by the first `width`
+/// columns.
+/// @param[in,out] data The array, `shape=(num_rows, stride)`.
+/// @param[in] stride Number of columns.
+/// @param[in] width Number of columns to compare.
+void sort_rows(std::vector<std::int64_t>& data, std::size_t stride,
+               std::size_t width)
+{
+  std::vector<std::int32_t> perm(data.size() / stride);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(
+      perm,
+      [&data, stride, width](auto r0, auto r1)
+      {
+        auto it0 = std::next(data.begin(), r0 * stride);
+        auto it1 = std::next(data.begin(), r1 * stride);
+        return std::lexicographical_compare(it0, std::next(it0, width), it1,
+                                            std::next(it1, width));
+      });
+
+  std::vector<std::int64_t> sorted(data.size());
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    std::copy_n(std::next(data.begin(), perm[i] * stride), stride,
+                std::next(sorted.begin(), i * stride));
+  }
+  data = std::move(sorted);
+}
+//-----------------------------------------------------------------------------
+/// @brief Compare the first `width` values of two rows.
+/// @return -1, 0 or 1 if `r0` is less than, equal to or greater than
+/// `r1`.
+int compare_rows(const std::int64_t* r0, const std::int64_t* r1,
+                 std::size_t width)
+{
+  for (std::size_t i = 0; i < width; ++i)
+  {
+    if (r0[i] != r1[i])
+      return r0[i] < r1[i] ? -1 : 1;
+  }
+  return 0;
+}
+//-----------------------------------------------------------------------------
+/// @brief Merge two row-major arrays with rows sorted by the first
+/// `width` columns.
+std::vector<std::int64_t> merge_rows(std::span<const std::int64_t> a,
+                                     std::span<const std::int64_t> b,
+                                     std::size_t stride, std::size_t width)
+{
+  std::vector<std::int64_t> c;
+  c.reserve(a.size() + b.size());
+  auto ita = a.begin();
+  auto itb = b.begin();
+  while (ita != a.end() or itb != b.end())
+  {
+    auto& it = (itb == b.end()
+                or (ita != a.end()
+                    and compare_rows(&*itb, &*ita, width) >= 0))
+                   ? ita
+                   : itb;
+    c.insert(c.end(), it, std::next(it, stride));
+    std::advance(it, stride);
+  }
+  return c;
+}
+//-----------------------------------------------------------------------------
+/// @brief Send rows of a row-major array to other ranks.
+///
+/// @note Collective function
+///
+/// @param[in] comm MPI communicator
+/// @param[in] data The rows to send, `shape=(num_rows, stride)`.
+/// @param[in] stride Number of columns.
+/// @param[in] dest Destination rank for each row.
+/// @return (0) Received rows and (1) the source rank of each received
+/// row.
+std::pair<std::vector<std::int64_t>, std::vector<int>>
+send_rows(MPI_Comm comm, std::span<const std::int64_t> data,
+          std::size_t stride, std::span<const int> dest)
+{
+  // Sort rows by destination
+  std::vector<std::int32_t> perm(dest.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  std::ranges::stable_sort(perm, [dest](auto r0, auto r1)
+                           { return dest[r0] < dest[r1]; });
+
+  std::vector<int> ranks;
+  std::vector<std::int32_t> send_sizes;
+  std::vector<std::int64_t> send_buffer(data.size());
+  for (std::size_t i = 0; i < perm.size(); ++i)
+  {
+    if (int r = dest[perm[i]]; ranks.empty() or ranks.back() != r)
+    {
+      ranks.push_back(r);
+      send_sizes.push_back(0);
+    }
+    ++send_sizes.back();
+    std::copy_n(std::next(data.begin(), perm[i] * stride), stride,
+                std::next(send_buffer.begin(), i * stride));
+  }
+
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+
+  std::vector<std::int32_t> recv_sizes(src.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T, recv_sizes.data(),
+                        1, MPI_INT32_T, neigh_comm);
+
+  std::vector<std::int32_t> send_disp(send_sizes.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int32_t> recv_disp(recv_sizes.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(stride, MPI_INT64_T, &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<std::int64_t> recv_buffer(stride * recv_disp.back());
+  MPI_Neighbor_alltoallv(send_buffer.data(), send_sizes.data(),
+                         send_disp.data(), compound_type, recv_buffer.data(),
+                         recv_sizes.data(), recv_disp.data(), compound_type,
+                         neigh_comm);
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm);
+
+  std::vector<int> recv_src(recv_disp.back());
+  for (std::size_t i = 0; i < src.size(); ++i)
+  {
+    std::fill(std::next(recv_src.begin(), recv_disp[i]),
+              std::next(recv_src.begin(), recv_disp[i + 1]), src[i]);
+  }
+
+  return {std::move(recv_buffer), std::move(recv_src)};
+}
+//-----------------------------------------------------------------------------
 } // namespace
 //-----------------------------------------------------------------------------
 std::tuple<graph::AdjacencyList<std::int32_t>, std::vector<std::int64_t>,
@@ -536,3 +680,416 @@ mesh::build_dual_graph(MPI_Comm comm, std::span<const CellType> celltypes,
   return graph;
 }
 //-----------------------------------------------------------------------------
+mesh::DualGraph::DualGraph(
+    MPI_Comm comm, std::span<const CellType> celltypes,
+    const std::vector<std::span<const std::int64_t>>& cells)
+    : _comm(comm), _fshape(0), _local_graph(0)
+{
+  // Find the maximum number of vertices of a facet across all
+  // processes
+  std::int32_t fshape = 0;
+  for (CellType type : celltypes)
+  {
+    graph::AdjacencyList<int> cell_facets
+        = mesh::get_entity_vertices(type, mesh::cell_dim(type) - 1);
+    for (std::int32_t i = 0; i < cell_facets.num_nodes(); ++i)
+      fshape = std::max(fshape, cell_facets.num_links(i));
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &fshape, 1, MPI_INT32_T, MPI_MAX, comm);
+  _fshape = fshape;
+
+  // Build the graph as an update of an empty graph
+  update(celltypes, cells, {});
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> mesh::DualGraph::update(
+    std::span<const CellType> celltypes,
+    const std::vector<std::span<const std::int64_t>>& cells,
+    std::span<const std::int32_t> cell_map)
+{
+  spdlog::info("Update mesh dual graph");
+  common::Timer timer("Update mesh dual graph");
+
+  if (cells.size() != celltypes.size())
+  {
+    throw std::runtime_error(
+        "Number of cell types must match number of cell arrays.");
+  }
+
+  if (cell_map.size() != std::size_t(_local_graph.num_nodes()))
+    throw std::runtime_error("Cell map size does not match number of cells.");
+
+  // Shape of facet, boundary facet and post office data, and the number
+  // of columns that hold the facet vertices
+  const std::size_t width = _fshape;
+  const std::size_t shape_f = width + 1;
+  const std::size_t shape_b = width + 3;
+  const std::size_t shape_o = width + 2;
+
+  // Create indexing offset for each cell type
+  std::vector<std::int32_t> cell_offsets = {0};
+  for (std::size_t j = 0; j < cells.size(); ++j)
+  {
+    assert(mesh::cell_dim(celltypes.front()) == mesh::cell_dim(celltypes[j]));
+    int num_cell_vertices = mesh::cell_num_entities(celltypes[j], 0);
+    cell_offsets.push_back(cell_offsets.back()
+                           + cells[j].size() / num_cell_vertices);
+  }
+  const std::int32_t num_cells = cell_offsets.back();
+
+  // Mark new cells
+  std::vector<std::int8_t> is_new(num_cells, true);
+  for (std::int32_t c : cell_map)
+  {
+    if (c >= num_cells)
+      throw std::runtime_error("Cell map index out of range.");
+    else if (c >= 0)
+      is_new[c] = false;
+  }
+
+  // Remove the facets of removed cells and renumber the facets of
+  // unchanged cells. The facets remain sorted.
+  std::vector<std::int64_t> facets;
+  facets.reserve(_facets.size());
+  for (std::size_t i = 0; i < _facets.size(); i += shape_f)
+  {
+    if (std::int32_t c = cell_map[_facets[i + width]]; c >= 0)
+    {
+      facets.insert(facets.end(), std::next(_facets.begin(), i),
+                    std::next(_facets.begin(), i + width));
+      facets.push_back(c);
+    }
+  }
+
+  // Compute the facets of new cells
+  std::vector<std::int64_t> new_facets;
+  for (std::size_t j = 0; j < cells.size(); ++j)
+  {
+    const int tdim = mesh::cell_dim(celltypes[j]);
+    const int num_cell_vertices = mesh::cell_num_entities(celltypes[j], 0);
+    graph::AdjacencyList<int> cell_facets
+        = mesh::get_entity_vertices(celltypes[j], tdim - 1);
+    for (std::int32_t c = cell_offsets[j]; c < cell_offsets[j + 1]; ++c)
+    {
+      if (!is_new[c])
+        continue;
+
+      auto v = cells[j].subspan(num_cell_vertices * (c - cell_offsets[j]),
+                                num_cell_vertices);
+      for (int f = 0; f < cell_facets.num_nodes(); ++f)
+      {
+        auto facet_vertices = cell_facets.links(f);
+        if (facet_vertices.size() > width)
+        {
+          throw std::runtime_error("Number of facet vertices is greater than "
+                                   "when the dual graph was built.");
+        }
+        std::ranges::transform(facet_vertices, std::back_inserter(new_facets),
+                               [v](auto idx) { return v[idx]; });
+        std::sort(std::prev(new_facets.end(), facet_vertices.size()),
+                  new_facets.end());
+        new_facets.insert(new_facets.end(), width - facet_vertices.size(), -1);
+        new_facets.push_back(c);
+      }
+    }
+  }
+  sort_rows(new_facets, shape_f, width);
+  _facets = merge_rows(facets, new_facets, shape_f, width);
+
+  // Iterate over sorted list of facets. Facets shared by more than one
+  // cell lead to a graph edge. Facets that are not shared might be
+  // shared by a cell on another process.
+  std::vector<std::array<std::int32_t, 2>> edges;
+  std::vector<std::int64_t> boundary;
+  for (std::size_t i = 0; i < _facets.size();)
+  {
+    std::size_t i1 = i + shape_f;
+    while (i1 < _facets.size()
+           and compare_rows(&_facets[i], &_facets[i1], width) == 0)
+    {
+      edges.push_back({std::int32_t(_facets[i + width]),
+                       std::int32_t(_facets[i1 + width])});
+      i1 += shape_f;
+    }
+
+    if (i1 == i + shape_f)
+    {
+      boundary.insert(boundary.end(), std::next(_facets.begin(), i),
+                      std::next(_facets.begin(), i + shape_f));
+      boundary.insert(boundary.end(), {-1, -1});
+    }
+
+    i = i1;
+  }
+
+  // Build local graph
+  graph::AdjacencyList<std::int32_t> local_graph(0);
+  {
+    std::vector<std::int32_t> offsets(num_cells + 1, 0);
+    for (auto e : edges)
+    {
+      ++offsets[e[0] + 1];
+      ++offsets[e[1] + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::int32_t> data(offsets.back());
+    std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+    for (auto e : edges)
+    {
+      data[pos[e[0]]++] = e[1];
+      data[pos[e[1]]++] = e[0];
+    }
+    local_graph = graph::AdjacencyList(std::move(data), std::move(offsets));
+  }
+
+  // Compare the boundary facets with the boundary facets before the
+  // update. Facets that have been removed, or whose cell has changed,
+  // are removed from the post offices, and facets that are new, or
+  // whose cell has changed, are added to the post offices. The other
+  // cell attached to a facet that is not sent is unchanged, unless a
+  // post office reports a change.
+  const int num_ranks = dolfinx::MPI::size(_comm.comm());
+  std::vector<std::int64_t> office_data;
+  std::vector<int> office_dest;
+  auto send_to_office = [&](auto row, std::int64_t cell, std::int64_t op)
+  {
+    office_data.push_back(op);
+    office_data.insert(office_data.end(), row, std::next(row, width));
+    office_data.push_back(cell);
+    office_dest.push_back(row[0] % num_ranks);
+  };
+
+  // Other cell attached to each boundary facet before the update
+  std::vector<std::array<std::int64_t, 2>> remote0(boundary.size() / shape_b,
+                                                   {-1, -1});
+  {
+    auto it0 = _boundary.begin();
+    auto it1 = boundary.begin();
+    while (it0 != _boundary.end() or it1 != boundary.end())
+    {
+      int cmp = it0 == _boundary.end()  ? 1
+                : it1 == boundary.end() ? -1
+                                        : compare_rows(&*it0, &*it1, width);
+      if (cmp < 0)
+      {
+        // Facet has been removed
+        send_to_office(it0, it0[width], 0);
+        std::advance(it0, shape_b);
+      }
+      else if (cmp > 0)
+      {
+        // Facet is new
+        send_to_office(it1, it1[width], 1);
+        std::advance(it1, shape_b);
+      }
+      else
+      {
+        std::int64_t c0 = it0[width];
+        if (std::int32_t c = cell_map[c0]; c == it1[width])
+        {
+          remote0[std::distance(boundary.begin(), it1) / shape_b]
+              = {it0[width + 1], it0[width + 2]};
+        }
+
+        if (c0 == it1[width] and cell_map[c0] == c0)
+          std::copy_n(std::next(it0, width + 1), 2, std::next(it1, width + 1));
+        else
+        {
+          send_to_office(it0, c0, 0);
+          send_to_office(it1, it1[width], 1);
+        }
+
+        std::advance(it0, shape_b);
+        std::advance(it1, shape_b);
+      }
+    }
+  }
+
+  // Send added and removed facets to the post offices
+  auto [recv_data, recv_src]
+      = send_rows(_comm.comm(), office_data, shape_o, office_dest);
+
+  // Update post office data, and find facets that have changed
+  std::vector<std::int64_t> removed, added, changed;
+  for (std::size_t i = 0; i < recv_src.size(); ++i)
+  {
+    auto row = std::next(recv_data.begin(), i * shape_o);
+    std::vector<std::int64_t>& d = row[0] == 0 ? removed : added;
+    d.insert(d.end(), std::next(row), std::next(row, width + 1));
+    d.insert(d.end(), {recv_src[i], row[width + 1]});
+    changed.insert(changed.end(), std::next(row), std::next(row, width + 1));
+  }
+  sort_rows(removed, shape_o, shape_o);
+  sort_rows(added, shape_o, shape_o);
+  sort_rows(changed, width, width);
+  {
+    std::vector<std::int64_t> office;
+    office.reserve(_office.size());
+    auto itr = removed.begin();
+    for (auto it = _office.begin(); it != _office.end();
+         std::advance(it, shape_o))
+    {
+      int cmp = -1;
+      while (itr != removed.end()
+             and (cmp = compare_rows(&*itr, &*it, shape_o)) < 0)
+      {
+        std::advance(itr, shape_o);
+      }
+
+      if (itr != removed.end() and cmp == 0)
+        std::advance(itr, shape_o);
+      else
+        office.insert(office.end(), it, std::next(it, shape_o));
+    }
+    _office = merge_rows(office, added, shape_o, shape_o);
+  }
+
+  // Send the other attached cell (or (-1, -1) if there is none) for
+  // each changed facet to each rank that has the facet
+  std::vector<std::int64_t> reply_data;
+  std::vector<int> reply_dest;
+  {
+    auto it = _office.begin();
+    for (auto itc = changed.begin(); itc != changed.end();
+         std::advance(itc, width))
+    {
+      // Skip repeated facets
+      if (itc != changed.begin()
+          and compare_rows(&*itc, &*std::prev(itc, width), width) == 0)
+      {
+        continue;
+      }
+
+      while (it != _office.end() and compare_rows(&*it, &*itc, width) < 0)
+        std::advance(it, shape_o);
+      auto it1 = it;
+      while (it1 != _office.end() and compare_rows(&*it1, &*itc, width) == 0)
+        std::advance(it1, shape_o);
+
+      std::size_t num_matches = std::distance(it, it1) / shape_o;
+      if (num_matches > 2)
+      {
+        throw std::runtime_error(
+            "A facet is connected to more than two cells.");
+      }
+
+      for (auto r = it; r != it1; std::advance(r, shape_o))
+      {
+        reply_data.insert(reply_data.end(), r, std::next(r, width));
+        reply_data.push_back(r[width + 1]);
+        if (num_matches == 2)
+        {
+          auto other = r == it ? std::next(it, shape_o) : it;
+          reply_data.insert(reply_data.end(), {other[width], other[width + 1]});
+        }
+        else
+          reply_data.insert(reply_data.end(), {-1, -1});
+        reply_dest.push_back(r[width]);
+      }
+
+      it = it1;
+    }
+  }
+
+  // Receive the other attached cell of changed boundary facets
+  std::vector<std::int64_t> recv_reply
+      = send_rows(_comm.comm(), reply_data, shape_b, reply_dest).first;
+  sort_rows(recv_reply, shape_b, width);
+  {
+    auto it = boundary.begin();
+    for (auto itr = recv_reply.begin(); itr != recv_reply.end();
+         std::advance(itr, shape_b))
+    {
+      while (compare_rows(&*it, &*itr, width) < 0)
+        std::advance(it, shape_b);
+      assert(compare_rows(&*it, &*itr, width) == 0);
+      assert(it[width] == itr[width]);
+      std::copy_n(std::next(itr, width + 1), 2, std::next(it, width + 1));
+    }
+  }
+
+  // Find cells with changed edges
+  std::vector<std::int32_t> changed_cells;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    if (is_new[c])
+      changed_cells.push_back(c);
+  }
+  for (std::size_t c0 = 0; c0 < cell_map.size(); ++c0)
+  {
+    if (std::int32_t c = cell_map[c0]; c >= 0)
+    {
+      std::vector<std::int32_t> e0;
+      for (std::int32_t e : _local_graph.links(c0))
+        e0.push_back(cell_map[e]);
+      std::vector<std::int32_t> e1(local_graph.links(c).begin(),
+                                   local_graph.links(c).end());
+      std::ranges::sort(e0);
+      std::ranges::sort(e1);
+      if (e0 != e1)
+        changed_cells.push_back(c);
+    }
+  }
+  for (std::size_t i = 0; i < remote0.size(); ++i)
+  {
+    auto row = std::next(boundary.begin(), i * shape_b);
+    if (remote0[i][0] != row[width + 1] or remote0[i][1] != row[width + 2])
+      changed_cells.push_back(row[width]);
+  }
+  std::ranges::sort(changed_cells);
+  auto [unique_end, range_end] = std::ranges::unique(changed_cells);
+  changed_cells.erase(unique_end, range_end);
+
+  _local_graph = std::move(local_graph);
+  _boundary = std::move(boundary);
+
+  // Compute global cell offsets
+  _offsets.resize(num_ranks + 1);
+  _offsets[0] = 0;
+  const std::int64_t num_local = num_cells;
+  MPI_Allgather(&num_local, 1, MPI_INT64_T, _offsets.data() + 1, 1,
+                MPI_INT64_T, _comm.comm());
+  std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+  spdlog::info("Dual graph update (boundary facets sent: {}, changed cells: "
+               "{})",
+               office_dest.size(), changed_cells.size());
+
+  return changed_cells;
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int64_t> mesh::DualGraph::global_graph() const
+{
+  const std::size_t width = _fshape;
+  const std::size_t shape_b = width + 3;
+  const std::int64_t offset = this->offset();
+
+  std::vector<std::int32_t> offsets(_local_graph.num_nodes() + 1, 0);
+  for (std::int32_t c = 0; c < _local_graph.num_nodes(); ++c)
+    offsets[c + 1] = _local_graph.num_links(c);
+  for (std::size_t i = 0; i < _boundary.size(); i += shape_b)
+  {
+    if (_boundary[i + width + 1] >= 0)
+      ++offsets[_boundary[i + width] + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<std::int64_t> data(offsets.back());
+  std::vector<std::int32_t> pos(offsets.begin(), std::prev(offsets.end()));
+  for (std::int32_t c = 0; c < _local_graph.num_nodes(); ++c)
+  {
+    for (std::int32_t e : _local_graph.links(c))
+      data[pos[c]++] = e + offset;
+  }
+  for (std::size_t i = 0; i < _boundary.size(); i += shape_b)
+  {
+    if (std::int64_t r = _boundary[i + width + 1]; r >= 0)
+    {
+      data[pos[_boundary[i + width]]++]
+          = _offsets[r] + _boundary[i + width + 2];
+    }
+  }
+
+  return graph::AdjacencyList(std::move(data), std::move(offsets));
+}
+//-----------------------------------------------------------------------------
@@ -7,17 +7,13 @@
 #pragma once
 
 #include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <mpi.h>
 #include <span>
 #include <tuple>
 #include <vector>
 
-namespace dolfinx::graph
-{
-template <typename T>
-class AdjacencyList;
-}
-
 namespace dolfinx::mesh
 {
 enum class CellType;
@@ -66,4 +62,113 @@ graph::AdjacencyList<std::int64_t>
 build_dual_graph(MPI_Comm comm, std::span<const CellType> celltypes,
                  const std::vector<std::span<const std::int64_t>>& cells);
 
+/// @brief Distributed mesh dual graph (cell-cell connections via
+/// facets) that can be updated when cells are added, removed or
+/// renumbered.
+///
+/// The facets of the cells on this rank are stored, as are the facets
+/// that are shared with another rank and the data held on the 'post
+/// office' ranks that match facets across ranks. An update computes
+/// the facets of new cells only, and sends to the post offices only
+/// the facets on the process boundary that have been added or removed.
+/// The communication volume of an update is therefore proportional to
+/// the number of changed cells on the process boundary, rather than to
+/// the number of facets on the process boundary as in
+/// build_dual_graph(). This is intended for adaptive loops, where a
+/// small fraction of the cells is refined or coarsened between
+/// repartitioning.
+///
+/// The graph is the same as the graph computed by build_dual_graph()
+/// for the same cells, up to the order of the edges of each node.
+class DualGraph
+{
+public:
+  /// @brief Build the dual graph.
+  ///
+  /// @note Collective function
+  ///
+  /// @param[in] comm The MPI communicator
+  /// @param[in] celltypes List of cell types
+  /// @param[in] cells Cells, defined by the cell vertex global indices,
+  /// as flattened arrays for each cell type in `celltypes`. See
+  /// build_dual_graph().
+  DualGraph(MPI_Comm comm, std::span<const CellType> celltypes,
+            const std::vector<std::span<const std::int64_t>>& cells);
+
+  /// @brief Update the dual graph for a modified set of cells.
+  ///
+  /// Cells that are in the image of `cell_map` are unchanged cells
+  /// (with the same vertices as before the update), and all other cells
+  /// are new cells.
+  ///
+  /// @note Collective function
+  ///
+  /// @param[in] celltypes List of cell types. The maximum number of
+  /// vertices of a facet of the cell types must not be greater than
+  /// for the cell types that the graph was built with.
+  /// @param[in] cells Cells after the update, as flattened arrays for
+  /// each cell type in `celltypes`.
+  /// @param[in] cell_map Map from the (local) index of a cell before
+  /// the update to its index in `cells`, or -1 if the cell has been
+  /// removed. The indices are numbered consecutively across cell
+  /// types, see build_local_dual_graph().
+  /// @return Local indices of the cells whose edges have changed,
+  /// including all new cells. The edges are compared as (rank, local
+  /// index) pairs. Sorted.
+  std::vector<std::int32_t>
+  update(std::span<const CellType> celltypes,
+         const std::vector<std::span<const std::int64_t>>& cells,
+         std::span<const std::int32_t> cell_map);
+
+  /// @brief Dual graph of the cells on this rank, with edges to cells
+  /// on other ranks. Edges are global cell indices.
+  graph::AdjacencyList<std::int64_t> global_graph() const;
+
+  /// @brief Dual graph with edges between cells on this rank only.
+  const graph::AdjacencyList<std::int32_t>& local_graph() const
+  {
+    return _local_graph;
+  }
+
+  /// @brief Number of cells on this rank.
+  std::int32_t num_nodes() const { return _local_graph.num_nodes(); }
+
+  /// @brief Global index of the first cell on this rank.
+  std::int64_t offset() const
+  {
+    return _offsets[dolfinx::MPI::rank(_comm.comm())];
+  }
+
+private:
+  // MPI communicator
+  dolfinx::MPI::Comm _comm;
+
+  // Maximum number of vertices of a facet, on all ranks
+  std::size_t _fshape;
+
+  // Facets of the cells on this rank, sorted by the facet vertices.
+  // Each row is [v0, ..., v_(n-1), x, ..., x, cell], where x is a
+  // padding value (-1), shape=(num_facets, _fshape + 1).
+  std::vector<std::int64_t> _facets;
+
+  // Graph edges between cells on this rank
+  graph::AdjacencyList<std::int32_t> _local_graph;
+
+  // Facets with one attached cell on this rank, sorted by the facet
+  // vertices. Each row is [v0, ..., x, cell, rank, remote cell], where
+  // (rank, remote cell) is the other attached cell (local index on
+  // rank), or (-1, -1) if the facet is on the boundary of the mesh,
+  // shape=(num_facets, _fshape + 3).
+  std::vector<std::int64_t> _boundary;
+
+  // Post office data: facets sent to this rank, with the rank and
+  // (local) attached cell of the sender. Each row is [v0, ..., x, rank,
+  // cell], sorted, shape=(num_facets, _fshape + 2).
+  std::vector<std::int64_t> _office;
+
+  // Global index of the first cell on each rank, with the total number
+  // of cells appended
+  std::vector<std::int64_t> _offsets;
+};
+
 } // namespace dolfinx::mesh
@@ -8,11 +8,16 @@
 #include "Topology.h"
 #include "cell_types.h"
 #include <algorithm>
-#include <bitset>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 namespace
 {
@@ -118,226 +123,239 @@ compute_quad_rot_reflect(const std::vector<std::int32_t>& e_vertices,
   return {(post > pre) == (g_post < g_pre), rots};
 }
 //-----------------------------------------------------------------------------
-template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_triangle_quad_face_permutations(const mesh::Topology& topology,
-                                        int cell_index)
+
+/// @brief Compute the face and/or edge permutation bits of each cell.
+///
+/// The faces and edges of a cell are processed in a single pass over
+/// the cells. The global indices of the vertices of a cell are computed
+/// once and shared by all sub-entities of the cell, and the position of
+/// a sub-entity vertex in the cell is found from the local vertex
+/// indices. The bits are packed as described in
+/// mesh::compute_entity_permutations.
+///
+/// @param[in] topology The topology.
+/// @param[in] faces Compute the face bits (3D only).
+/// @param[in] edges Compute the edge bits, after the face bits.
+/// @param[in] num_threads Number of threads. Each thread computes the
+/// bits of a range of cells.
+std::vector<std::uint32_t>
+compute_cell_permutation_bits(const mesh::Topology& topology, bool faces,
+                              bool edges, int num_threads)
 {
-  std::vector<mesh::CellType> cell_types = topology.entity_types(3);
-  mesh::CellType cell_type = cell_types.at(cell_index);
-
-  // Get face types of the cell and mesh
-  std::vector<mesh::CellType> mesh_face_types = topology.entity_types(2);
-  std::vector<mesh::CellType> cell_face_types(
-      mesh::cell_num_entities(cell_type, 2));
-  for (std::size_t i = 0; i < cell_face_types.size(); ++i)
-    cell_face_types[i] = mesh::cell_facet_type(cell_type, i);
-
-  // Connectivity for each face type
-  std::vector<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>> c_to_f;
-  std::vector<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>> f_to_v;
-
-  // Create mapping for each face type to cell-local face index
-  int tdim = topology.dim();
-  std::vector<std::vector<int>> face_type_indices(mesh_face_types.size());
-  for (std::size_t i = 0; i < mesh_face_types.size(); ++i)
+  const int tdim = topology.dim();
+  mesh::CellType cell_type = topology.cell_type();
+  auto c_to_v = topology.connectivity(tdim, 0);
+  assert(c_to_v);
+  auto im = topology.index_map(0);
+  assert(im);
+
+  // Connectivity of the faces of each type, and the cell-local indices
+  // of the faces of the cell with the type
+  struct FaceType
+  {
+    std::pair<std::int8_t, std::int8_t> (*rot_reflect)(
+        const std::vector<std::int32_t>&, const std::vector<std::int64_t>&);
+    std::vector<int> indices;
+    std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c_to_f, f_to_v;
+  };
+  std::vector<FaceType> face_types;
+  int face_bits = 0;
+  if (faces)
   {
-    for (std::size_t j = 0; j < cell_face_types.size(); ++j)
+    assert(tdim == 3);
+    if (topology.entity_types(3).size() > 1)
     {
-      if (mesh_face_types[i] == cell_face_types[j])
-        face_type_indices[i].push_back(j);
+      throw std::runtime_error(
+          "Cannot compute permutations for mixed topology mesh.");
     }
-    c_to_f.push_back(topology.connectivity({tdim, cell_index}, {2, i}));
-    f_to_v.push_back(topology.connectivity({2, i}, {0, 0}));
+    if (!topology.index_map(2))
+      throw std::runtime_error("Faces have not been computed.");
+
+    std::vector<mesh::CellType> mesh_face_types = topology.entity_types(2);
+    for (std::size_t i = 0; i < mesh_face_types.size(); ++i)
+    {
+      FaceType face_type{mesh_face_types[i] == mesh::CellType::triangle
+                             ? compute_triangle_rot_reflect
+                             : compute_quad_rot_reflect,
+                         {},
+                         topology.connectivity({tdim, 0}, {2, i}),
+                         topology.connectivity({2, i}, {0, 0})};
+      for (int j = 0; j < mesh::cell_num_entities(cell_type, 2); ++j)
+      {
+        if (mesh::cell_facet_type(cell_type, j) == mesh_face_types[i])
+          face_type.indices.push_back(j);
+      }
+      if (!face_type.indices.empty())
+        face_types.push_back(std::move(face_type));
+    }
+
+    // Currently, 3 bits are used for each face. If faces with more than
+    // 4 sides are implemented, this will need to be increased.
+    face_bits = 3 * mesh::cell_num_entities(cell_type, 2);
   }
 
-  auto c_to_v = topology.connectivity({tdim, cell_index}, {0, 0});
-  assert(c_to_v);
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> c_to_e, e_to_v;
+  if (edges)
+  {
+    c_to_e = topology.connectivity(tdim, 1);
+    assert(c_to_e);
+    e_to_v = topology.connectivity(1, 0);
+    assert(e_to_v);
+  }
+  [[maybe_unused]] const int used_bits
+      = face_bits + (edges ? mesh::cell_num_entities(cell_type, 1) : 0);
+  assert(used_bits < _BITSETSIZE);
 
   const std::int32_t num_cells = c_to_v->num_nodes();
-  std::vector<std::bitset<BITSETSIZE>> face_perm(num_cells, 0);
-  std::vector<std::int64_t> cell_vertices, vertices;
-  std::vector<std::int32_t> e_vertices;
-  auto im = topology.index_map(0);
-
-  for (std::size_t t = 0; t < face_type_indices.size(); ++t)
+  std::vector<std::uint32_t> cell_bits(num_cells, 0);
+  auto compute_bits = [&](std::int32_t c0, std::int32_t c1)
   {
-    spdlog::info("Computing permutations for face type {}", t);
-    if (!face_type_indices[t].empty())
+    std::vector<std::int64_t> cell_vertices, vertices;
+    std::vector<std::int32_t> e_vertices;
+    for (std::int32_t c = c0; c < c1; ++c)
     {
-      auto compute_refl_rots = (mesh_face_types[t] == mesh::CellType::triangle)
-                                   ? compute_triangle_rot_reflect
-                                   : compute_quad_rot_reflect;
-      for (int c = 0; c < num_cells; ++c)
-      {
-        cell_vertices.resize(c_to_v->links(c).size());
-        im->local_to_global(c_to_v->links(c), cell_vertices);
+      std::span<const std::int32_t> cv = c_to_v->links(c);
+      cell_vertices.resize(cv.size());
+      im->local_to_global(cv, cell_vertices);
+
+      // Position of a vertex in the cell
+      auto position = [cv](std::int32_t v) -> std::int32_t
+      { return std::distance(cv.begin(), std::ranges::find(cv, v)); };
 
-        auto cell_faces = c_to_f[t]->links(c);
+      std::uint32_t bits = 0;
+      for (const FaceType& face_type : face_types)
+      {
+        std::span<const std::int32_t> cell_faces
+            = face_type.c_to_f->links(c);
         for (std::size_t i = 0; i < cell_faces.size(); ++i)
         {
-          // Get the face
-          const int face = cell_faces[i];
-          e_vertices.resize(f_to_v[t]->num_links(face));
-          vertices.resize(f_to_v[t]->num_links(face));
-          im->local_to_global(f_to_v[t]->links(face), vertices);
-
-          // Orient that triangle or quadrilateral so the lowest numbered
+          // Orient the triangle or quadrilateral so the lowest numbered
           // vertex is the origin, and the next vertex anticlockwise from
-          // the lowest has a lower number than the next vertex clockwise.
-          // Find the index of the lowest numbered vertex.
-
-          // Find iterators pointing to cell vertex given a vertex on facet
-          for (std::size_t j = 0; j < vertices.size(); ++j)
+          // the lowest has a lower number than the next vertex
+          // clockwise.
+          std::span<const std::int32_t> fv
+              = face_type.f_to_v->links(cell_faces[i]);
+          e_vertices.resize(fv.size());
+          vertices.resize(fv.size());
+          for (std::size_t j = 0; j < fv.size(); ++j)
           {
-            auto it = std::find(cell_vertices.begin(), cell_vertices.end(),
-                                vertices[j]);
-            // Get the actual local vertex indices
-            e_vertices[j] = std::distance(cell_vertices.begin(), it);
+            e_vertices[j] = position(fv[j]);
+            vertices[j] = cell_vertices[e_vertices[j]];
           }
 
-          // Compute reflections and rotations for this face type
-          auto [refl, rots] = compute_refl_rots(e_vertices, vertices);
-
           // Store bits for this face
-          int fi = face_type_indices[t][i];
-          face_perm[c][3 * fi] = refl;
-          face_perm[c][3 * fi + 1] = rots % 2;
-          face_perm[c][3 * fi + 2] = rots / 2;
+          auto [refl, rots] = face_type.rot_reflect(e_vertices, vertices);
+          const std::uint32_t face_perm
+              = refl | ((rots % 2) << 1) | ((rots / 2) << 2);
+          bits |= face_perm << (3 * face_type.indices[i]);
         }
       }
-    }
-  }
-
-  return face_perm;
-}
-//-----------------------------------------------------------------------------
-template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_edge_reflections(const mesh::Topology& topology)
-{
-  mesh::CellType cell_type = topology.cell_type();
-  const int tdim = topology.dim();
-  const int edges_per_cell = cell_num_entities(cell_type, 1);
-
-  const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
 
-  auto c_to_v = topology.connectivity(tdim, 0);
-  assert(c_to_v);
-  auto c_to_e = topology.connectivity(tdim, 1);
-  assert(c_to_e);
-  auto e_to_v = topology.connectivity(1, 0);
-  assert(e_to_v);
-
-  auto im = topology.index_map(0);
-  assert(im);
-
-  std::vector<std::bitset<BITSETSIZE>> edge_perm(num_cells, 0);
-  std::vector<std::int64_t> cell_vertices, vertices;
-  for (int c = 0; c < c_to_v->num_nodes(); ++c)
-  {
-    cell_vertices.resize(c_to_v->num_links(c));
-    im->local_to_global(c_to_v->links(c), cell_vertices);
-    auto cell_edges = c_to_e->links(c);
-    for (int i = 0; i < edges_per_cell; ++i)
-    {
-      vertices.resize(e_to_v->links(cell_edges[i]).size());
-      im->local_to_global(e_to_v->links(cell_edges[i]), vertices);
-
-      // If the entity is an interval, it should be oriented pointing
-      // from the lowest numbered vertex to the highest numbered vertex.
-
-      // Find iterators pointing to cell vertex given a vertex on facet
-      auto it0
-          = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[0]);
-      auto it1
-          = std::find(cell_vertices.begin(), cell_vertices.end(), vertices[1]);
+      if (edges)
+      {
+        // An interval is oriented from the lowest numbered vertex to the
+        // highest numbered vertex
+        std::span<const std::int32_t> cell_edges = c_to_e->links(c);
+        for (std::size_t i = 0; i < cell_edges.size(); ++i)
+        {
+          std::span<const std::int32_t> ev = e_to_v->links(cell_edges[i]);
+          const std::int32_t p0 = position(ev[0]);
+          const std::int32_t p1 = position(ev[1]);
+          const bool refl
+              = (p1 < p0) == (cell_vertices[p1] > cell_vertices[p0]);
+          bits |= std::uint32_t(refl) << (face_bits + i);
+        }
+      }
 
-      // The number of reflections. Comparing iterators directly instead
-      // of values they point to is sufficient here.
-      edge_perm[c][i] = (it1 < it0) == (vertices[1] > vertices[0]);
+      cell_bits[c] = bits;
     }
-  }
+  };
 
-  return edge_perm;
-}
-//-----------------------------------------------------------------------------
-template <int BITSETSIZE>
-std::vector<std::bitset<BITSETSIZE>>
-compute_face_permutations(const mesh::Topology& topology)
-{
-  if (topology.entity_types(3).size() > 1)
+  if (num_threads > 1)
   {
-    throw std::runtime_error(
-        "Cannot compute permutations for mixed topology mesh.");
+    common::thread_pool().run(
+        num_threads,
+        [&compute_bits, num_cells, num_threads](int t)
+        {
+          auto [c0, c1] = dolfinx::MPI::local_range(t, num_cells, num_threads);
+          compute_bits(c0, c1);
+        });
   }
+  else
+    compute_bits(0, num_cells);
 
-  [[maybe_unused]] const int tdim = topology.dim();
-  assert(tdim > 2);
-  if (!topology.index_map(2))
-    throw std::runtime_error("Faces have not been computed.");
-
-  // Compute face permutations for first cell type in the topology
-  return compute_triangle_quad_face_permutations<BITSETSIZE>(topology, 0);
+  return cell_bits;
 }
 //-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
 std::pair<std::vector<std::uint8_t>, std::vector<std::uint32_t>>
-mesh::compute_entity_permutations(const mesh::Topology& topology)
+mesh::compute_entity_permutations(const mesh::Topology& topology,
+                                  int num_threads)
 {
   common::Timer t_perm("Compute entity permutations");
+  spdlog::info("Compute face and edge permutations");
   const int tdim = topology.dim();
   CellType cell_type = topology.cell_type();
-  const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
   const int facets_per_cell = cell_num_entities(cell_type, tdim - 1);
 
-  std::vector<std::uint32_t> cell_permutation_info(num_cells, 0);
-  std::vector<std::uint8_t> facet_permutations(num_cells * facets_per_cell);
-  std::int32_t used_bits = 0;
-  if (tdim > 2)
-  {
-    spdlog::info("Compute face permutations");
-    const int faces_per_cell = cell_num_entities(cell_type, 2);
-    const auto face_perm = compute_face_permutations<_BITSETSIZE>(topology);
-    for (int c = 0; c < num_cells; ++c)
-      cell_permutation_info[c] = face_perm[c].to_ulong();
+  std::vector<std::uint32_t> cell_permutation_info
+      = compute_cell_permutation_bits(topology, tdim > 2, tdim > 1,
+                                      num_threads);
 
-    // Currently, 3 bits are used for each face. If faces with more than
-    // 4 sides are implemented, this will need to be increased.
-    used_bits += faces_per_cell * 3;
-    assert(tdim == 3);
-    for (int c = 0; c < num_cells; ++c)
+  // The facet data is the face (3D) or edge (2D) data, which are the
+  // first bits of the cell data
+  const int facet_bits = tdim == 3 ? 3 : 1;
+  const std::uint32_t facet_mask = (1u << facet_bits) - 1;
+  std::vector<std::uint8_t> facet_permutations(cell_permutation_info.size()
+                                               * facets_per_cell);
+  if (tdim > 1)
+  {
+    for (std::size_t c = 0; c < cell_permutation_info.size(); ++c)
     {
       for (int i = 0; i < facets_per_cell; ++i)
       {
         facet_permutations[c * facets_per_cell + i]
-            = (cell_permutation_info[c] >> (3 * i)) & 7;
+            = (cell_permutation_info[c] >> (facet_bits * i)) & facet_mask;
       }
     }
   }
 
-  if (tdim > 1)
+  return {std::move(facet_permutations), std::move(cell_permutation_info)};
+}
+//-----------------------------------------------------------------------------
+std::vector<std::uint8_t>
+mesh::compute_facet_permutations(const mesh::Topology& topology,
+                                 int num_threads)
+{
+  common::Timer t_perm("Compute facet permutations");
+  const int tdim = topology.dim();
+  CellType cell_type = topology.cell_type();
+  const int facets_per_cell = cell_num_entities(cell_type, tdim - 1);
+  if (tdim < 2)
+  {
+    const std::int32_t num_cells = topology.connectivity(tdim, 0)->num_nodes();
+    return std::vector<std::uint8_t>(num_cells * facets_per_cell, 0);
+  }
+
+  // Only the facets are required: the faces of a 3D mesh, or the edges
+  // of a 2D mesh
+  spdlog::info("Compute facet permutations");
+  std::vector<std::uint32_t> perm = compute_cell_permutation_bits(
+      topology, tdim == 3, tdim == 2, num_threads);
+  const int facet_bits = tdim == 3 ? 3 : 1;
+  const std::uint32_t facet_mask = (1u << facet_bits) - 1;
+  std::vector<std::uint8_t> facet_permutations(perm.size() * facets_per_cell);
+  for (std::size_t c = 0; c < perm.size(); ++c)
   {
-    spdlog::info("Compute edge permutations");
-    const int edges_per_cell = cell_num_entities(cell_type, 1);
-    const auto edge_perm = compute_edge_reflections<_BITSETSIZE>(topology);
-    for (int c = 0; c < num_cells; ++c)
-      cell_permutation_info[c] |= edge_perm[c].to_ulong() << used_bits;
-
-    used_bits += edges_per_cell;
-    if (tdim == 2)
+    for (int i = 0; i < facets_per_cell; ++i)
     {
-      for (int c = 0; c < num_cells; ++c)
-      {
-        for (int i = 0; i < facets_per_cell; ++i)
-          facet_permutations[c * facets_per_cell + i] = edge_perm[c][i];
-      }
+      facet_permutations[c * facets_per_cell + i]
+          = (perm[c] >> (facet_bits * i)) & facet_mask;
     }
   }
-  assert(used_bits < _BITSETSIZE);
 
-  return {std::move(facet_permutations), std::move(cell_permutation_info)};
+  return facet_permutations;
 }
 //-----------------------------------------------------------------------------
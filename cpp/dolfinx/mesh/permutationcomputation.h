@@ -66,8 +66,30 @@ class Topology;
 ///    This data is used to correct the direction of vector function
 ///    on permuted facets.
 ///
+/// The faces and edges of each cell are processed in a single pass
+/// over the cells, in which the global indices of the cell vertices
+/// are computed once.
+///
+/// @param[in] topology The topology. The entities of all dimensions
+/// must have been created.
+/// @param[in] num_threads Number of threads. Each thread computes the
+/// data of a range of cells.
 /// @return Facet permutation and cells permutations
 std::pair<std::vector<std::uint8_t>, std::vector<std::uint32_t>>
-compute_entity_permutations(const Topology& topology);
+compute_entity_permutations(const Topology& topology, int num_threads = 1);
+
+/// @brief Compute the facet rotation and reflection data only.
+///
+/// The data is the same as the facet data computed by
+/// compute_entity_permutations, but only the facets (and vertices) of
+/// the topology are required, e.g. the edges of a 3D mesh need not be
+/// created.
+///
+/// @param[in] topology The topology. The facets must have been created.
+/// @param[in] num_threads Number of threads. Each thread computes the
+/// data of a range of cells.
+/// @return Facet permutations, see compute_entity_permutations
+std::vector<std::uint8_t> compute_facet_permutations(const Topology& topology,
+                                                     int num_threads = 1);
 
 } // namespace dolfinx::mesh
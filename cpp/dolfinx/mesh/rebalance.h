@@ -0,0 +1,360 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Mesh.h"
+#include "MeshTags.h"
+#include "Topology.h"
+#include "cell_types.h"
+#include "utils.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/common/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
+#include <dolfinx/graph/partition.h>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// @file rebalance.h
+/// @brief Functions for redistributing an existing mesh across
+/// processes, and for migrating data associated with the mesh.
+
+namespace dolfinx::mesh
+{
+/// @brief Redistribute the cells of a mesh across processes.
+///
+/// The owned cells of `mesh` are repartitioned using `partitioner`
+/// and a new mesh is created from the cells and the geometry of
+/// `mesh`, as for create_mesh(). The new mesh has the same cells and
+/// geometry nodes as `mesh`, but the cells and nodes are numbered
+/// differently. The original cell index of a cell in the new mesh
+/// (see Topology::original_cell_index) is the global index of the cell
+/// in `mesh`, and the input global index of a geometry node (see
+/// Geometry::input_global_indices) is the global index of the node in
+/// the geometry of `mesh`.
+///
+/// Data associated with `mesh` can be moved to the new mesh with
+/// migrate_cell_data(), migrate_meshtags() and fem::migrate().
+///
+/// @note Collective
+///
+/// @param[in] mesh Mesh to redistribute. It must have one cell type.
+/// @param[in] partitioner Function that computes the destination
+/// ranks for the owned cells of `mesh`, e.g. create_cell_partitioner().
+/// The ghost mode of the new mesh is determined by the partitioner.
+/// @param[in] reorder_fn Function that re-orders the owned cells on
+/// each process of the new mesh, see create_mesh().
+/// @return (0) The redistributed mesh and (1) the destination ranks
+/// for each owned cell of `mesh`, as computed by the partitioner. The
+/// first destination of a cell is the owning rank.
+template <std::floating_point T>
+std::pair<Mesh<T>, graph::AdjacencyList<std::int32_t>>
+rebalance(const Mesh<T>& mesh, const CellPartitionFunction& partitioner,
+          const CellReorderFunction& reorder_fn = graph::reorder_gps)
+{
+  spdlog::info("Rebalance mesh");
+  if (!partitioner)
+    throw std::runtime_error("A cell partitioner is required to rebalance.");
+
+  const Geometry<T>& geometry = mesh.geometry();
+  auto topology = mesh.topology();
+  assert(topology);
+  const int tdim = topology->dim();
+  const std::int32_t num_cells = topology->index_map(tdim)->size_local();
+
+  // Owned cells, defined by the global indices of the geometry nodes
+  auto x_dofmap = geometry.dofmap();
+  std::vector<std::int64_t> cells(num_cells * x_dofmap.extent(1));
+  geometry.index_map()->local_to_global(
+      std::span(x_dofmap.data_handle(), cells.size()), cells);
+
+  // Coordinates of the owned geometry nodes
+  const std::size_t gdim = geometry.dim();
+  const std::size_t num_nodes = geometry.index_map()->size_local();
+  NodeCoordinates<T> x = geometry.coordinates();
+  std::vector<T> coords(num_nodes * gdim);
+  for (std::size_t i = 0; i < num_nodes; ++i)
+    for (std::size_t j = 0; j < gdim; ++j)
+      coords[gdim * i + j] = x(i, j);
+
+  // Create the mesh, keeping the destination ranks that are computed
+  // by the partitioner
+  graph::AdjacencyList<std::int32_t> dest(0);
+  auto partfn = [&dest, &partitioner](
+                    MPI_Comm comm, int nparts,
+                    const std::vector<CellType>& cell_types,
+                    const std::vector<std::span<const std::int64_t>>& t)
+  {
+    dest = partitioner(comm, nparts, cell_types, t);
+    return dest;
+  };
+  Mesh<T> mesh1 = create_mesh(mesh.comm(), mesh.comm(),
+                              std::span<const std::int64_t>(cells),
+                              geometry.cmap(), mesh.comm(), coords,
+                              {num_nodes, gdim}, partfn, reorder_fn);
+
+  return {std::move(mesh1), std::move(dest)};
+}
+
+/// @brief Redistribute the cells of a mesh across processes using
+/// weighted graph partitioning.
+///
+/// The dual graph of the owned cells of `mesh` is partitioned by
+/// `partfn` with `weights` as the node weights, so that the sum of the
+/// weights of the cells on each process is balanced rather than the
+/// number of cells. See rebalance() for a description of the new mesh.
+///
+/// @note Collective
+///
+/// @param[in] mesh Mesh to redistribute. It must have one cell type.
+/// @param[in] weights Weight of each owned cell of `mesh`, e.g. the
+/// measured assembly cost of the cell.
+/// @param[in] ghost_mode Type of cell ghosting/overlap of the new mesh.
+/// @param[in] partfn Graph partitioning function.
+/// @param[in] reorder_fn Function that re-orders the owned cells on
+/// each process of the new mesh, see create_mesh().
+/// @return (0) The redistributed mesh and (1) the destination ranks
+/// for each owned cell of `mesh`.
+template <std::floating_point T>
+std::pair<Mesh<T>, graph::AdjacencyList<std::int32_t>>
+rebalance(const Mesh<T>& mesh, std::span<const std::int32_t> weights,
+          GhostMode ghost_mode = GhostMode::none,
+          const graph::partition_fn& partfn = &graph::partition_graph,
+          const CellReorderFunction& reorder_fn = graph::reorder_gps)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  auto map = topology->index_map(topology->dim());
+  assert(map);
+  if (static_cast<std::int32_t>(weights.size()) != map->size_local())
+  {
+    throw std::runtime_error(
+        "Number of weights does not match number of cells.");
+  }
+
+  return rebalance(
+      mesh,
+      create_cell_partitioner(
+          ghost_mode, partfn,
+          std::vector<std::int32_t>(weights.begin(), weights.end())),
+      reorder_fn);
+}
+
+/// @brief Move data associated with the cells of a mesh to the cells
+/// of a mesh created by rebalance().
+///
+/// @note Collective
+///
+/// @param[in] topology0 Topology of the mesh that was rebalanced.
+/// @param[in] topology1 Topology of the mesh returned by rebalance().
+/// @param[in] dest Destination ranks for each owned cell of
+/// `topology0`, as returned by rebalance().
+/// @param[in] data0 Data for each owned cell of `topology0`
+/// (`shape=(num_owned_cells, shape1)`). Storage is row-major.
+/// @param[in] shape1 Number of values for each cell.
+/// @return Data for each cell of `topology1`, including ghost cells
+/// (`shape=(num_cells, shape1)`). Storage is row-major.
+template <typename U>
+std::vector<U> migrate_cell_data(const Topology& topology0,
+                                 const Topology& topology1,
+                                 const graph::AdjacencyList<std::int32_t>& dest,
+                                 std::span<const U> data0, std::size_t shape1)
+{
+  const int tdim = topology0.dim();
+  auto map0 = topology0.index_map(tdim);
+  assert(map0);
+  const std::int32_t num_cells0 = map0->size_local();
+  if (dest.num_nodes() != num_cells0)
+    throw std::runtime_error("Destinations do not match number of cells.");
+  if (data0.size() != num_cells0 * shape1)
+    throw std::runtime_error("Cell data size does not match number of cells.");
+
+  // Sort (destination rank, cell) pairs by destination rank
+  std::vector<std::array<std::int32_t, 2>> dest_to_cell;
+  dest_to_cell.reserve(dest.array().size());
+  for (std::int32_t c = 0; c < num_cells0; ++c)
+  {
+    for (std::int32_t r : dest.links(c))
+      dest_to_cell.push_back({r, c});
+  }
+  std::ranges::sort(dest_to_cell);
+
+  // Pack global index and data of each cell to send
+  const std::int64_t offset0 = map0->local_range()[0];
+  std::vector<int> ranks;
+  std::vector<std::int32_t> send_sizes;
+  std::vector<std::int64_t> send_idx;
+  std::vector<U> send_data;
+  send_idx.reserve(dest_to_cell.size());
+  send_data.reserve(dest_to_cell.size() * shape1);
+  for (auto [r, c] : dest_to_cell)
+  {
+    if (ranks.empty() or ranks.back() != r)
+    {
+      ranks.push_back(r);
+      send_sizes.push_back(0);
+    }
+    ++send_sizes.back();
+    send_idx.push_back(c + offset0);
+    send_data.insert(send_data.end(), std::next(data0.begin(), c * shape1),
+                     std::next(data0.begin(), (c + 1) * shape1));
+  }
+
+  MPI_Comm comm = topology0.comm();
+  std::vector<int> src = dolfinx::MPI::compute_graph_edges_nbx(comm, ranks);
+  std::ranges::sort(src);
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, src.size(), src.data(), MPI_UNWEIGHTED,
+                                 ranks.size(), ranks.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neigh_comm);
+
+  std::vector<std::int32_t> recv_sizes(src.size());
+  send_sizes.reserve(1);
+  recv_sizes.reserve(1);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT32_T, recv_sizes.data(),
+                        1, MPI_INT32_T, neigh_comm);
+  std::vector<std::int32_t> send_disp(send_sizes.size() + 1, 0);
+  std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                   std::next(send_disp.begin()));
+  std::vector<std::int32_t> recv_disp(recv_sizes.size() + 1, 0);
+  std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                   std::next(recv_disp.begin()));
+
+  std::vector<std::int64_t> recv_idx(recv_disp.back());
+  MPI_Neighbor_alltoallv(send_idx.data(), send_sizes.data(), send_disp.data(),
+                         MPI_INT64_T, recv_idx.data(), recv_sizes.data(),
+                         recv_disp.data(), MPI_INT64_T, neigh_comm);
+
+  MPI_Datatype compound_type;
+  MPI_Type_contiguous(shape1, dolfinx::MPI::mpi_t<U>, &compound_type);
+  MPI_Type_commit(&compound_type);
+  std::vector<U> recv_data(recv_disp.back() * shape1);
+  MPI_Neighbor_alltoallv(send_data.data(), send_sizes.data(), send_disp.data(),
+                         compound_type, recv_data.data(), recv_sizes.data(),
+                         recv_disp.data(), compound_type, neigh_comm);
+  MPI_Type_free(&compound_type);
+  MPI_Comm_free(&neigh_comm);
+
+  // Place data by the original cell index of the cells of topology1
+  const std::vector<std::int64_t>& idx1 = topology1.original_cell_index.front();
+  std::vector<std::pair<std::int64_t, std::int32_t>> idx1_to_cell(
+      idx1.size());
+  for (std::size_t c = 0; c < idx1.size(); ++c)
+    idx1_to_cell[c] = {idx1[c], c};
+  std::ranges::sort(idx1_to_cell);
+
+  std::vector<U> data1(idx1.size() * shape1);
+  for (std::size_t i = 0; i < recv_idx.size(); ++i)
+  {
+    auto it = std::ranges::lower_bound(
+        idx1_to_cell, std::pair<std::int64_t, std::int32_t>(recv_idx[i], 0));
+    assert(it != idx1_to_cell.end() and it->first == recv_idx[i]);
+    std::copy_n(std::next(recv_data.begin(), i * shape1), shape1,
+                std::next(data1.begin(), it->second * shape1));
+  }
+
+  return data1;
+}
+
+/// @brief Move mesh tags to a mesh created by rebalance().
+///
+/// The tags are moved with the owned cells of the mesh that the tags
+/// are defined on. A tag on an entity that is not attached to an owned
+/// cell on the process that holds the tag is not moved, unless the
+/// entity is tagged on the process that owns an attached cell. Tags on
+/// entities that are shared by processes should therefore be the same
+/// on all processes.
+///
+/// @note Collective
+///
+/// @param[in] tags0 Mesh tags on the mesh that was rebalanced. The
+/// cell-to-entity connectivity of the topology of the tags must have
+/// been computed.
+/// @param[in] mesh1 Mesh returned by rebalance(). The tagged entities
+/// are created if they do not exist.
+/// @param[in] dest Destination ranks for each owned cell of the mesh
+/// that was rebalanced, as returned by rebalance().
+/// @return Mesh tags on `mesh1`.
+template <typename U, std::floating_point T>
+MeshTags<U> migrate_meshtags(const MeshTags<U>& tags0, const Mesh<T>& mesh1,
+                             const graph::AdjacencyList<std::int32_t>& dest)
+{
+  auto topology0 = tags0.topology();
+  assert(topology0);
+  const int tdim = topology0->dim();
+  const int dim = tags0.dim();
+  const std::int32_t num_cells0 = topology0->index_map(tdim)->size_local();
+
+  // Tagged entities of each owned cell. Cells are their own entity.
+  auto c_to_e0 = dim < tdim ? topology0->connectivity(tdim, dim) : nullptr;
+  if (dim < tdim and !c_to_e0)
+    throw std::runtime_error("Cell-to-entity connectivity is missing.");
+  const std::size_t num_cell_entities
+      = dim < tdim ? cell_num_entities(topology0->cell_type(), dim) : 1;
+  std::span<const std::int32_t> indices = tags0.indices();
+  std::span<const U> values = tags0.values();
+  std::vector<U> values0(num_cells0 * num_cell_entities);
+  std::vector<std::int8_t> marker0(values0.size(), false);
+  for (std::int32_t c = 0; c < num_cells0; ++c)
+  {
+    for (std::size_t i = 0; i < num_cell_entities; ++i)
+    {
+      std::int32_t e = dim < tdim ? c_to_e0->links(c)[i] : c;
+      if (auto it = std::ranges::lower_bound(indices, e);
+          it != indices.end() and *it == e)
+      {
+        std::size_t pos = std::distance(indices.begin(), it);
+        values0[c * num_cell_entities + i] = values[pos];
+        marker0[c * num_cell_entities + i] = true;
+      }
+    }
+  }
+
+  auto topology1 = mesh1.topology_mutable();
+  if (dim < tdim)
+  {
+    topology1->create_entities(dim);
+    topology1->create_connectivity(tdim, dim);
+  }
+
+  std::vector<U> values1 = migrate_cell_data<U>(
+      *topology0, *topology1, dest, values0, num_cell_entities);
+  std::vector<std::int8_t> marker1 = migrate_cell_data<std::int8_t>(
+      *topology0, *topology1, dest, marker0, num_cell_entities);
+
+  // Collect tagged entities of the cells, removing duplicates
+  auto c_to_e1 = dim < tdim ? topology1->connectivity(tdim, dim) : nullptr;
+  std::vector<std::int32_t> indices1;
+  std::vector<U> tags1;
+  for (std::size_t j = 0; j < marker1.size(); ++j)
+  {
+    if (marker1[j])
+    {
+      std::int32_t c = j / num_cell_entities;
+      indices1.push_back(
+          dim < tdim ? c_to_e1->links(c)[j % num_cell_entities] : c);
+      tags1.push_back(values1[j]);
+    }
+  }
+  auto [indices_sorted, values_sorted] = common::sort_unique(indices1, tags1);
+
+  return MeshTags<U>(topology1, dim, std::move(indices_sorted),
+                     std::move(values_sorted));
+}
+
+} // namespace dolfinx::mesh
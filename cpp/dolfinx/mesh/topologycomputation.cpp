@@ -8,20 +8,22 @@
 #include "Topology.h"
 #include "cell_types.h"
 #include <algorithm>
-#include <boost/unordered_map.hpp>
+#include <bit>
 #include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/sort.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
+#include <span>
 #include <string>
 #include <tuple>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -446,6 +448,8 @@ get_local_indexing(MPI_Comm comm, const common::IndexMap& vertex_map,
 /// @param[in] shared_vertices TODO
 /// @param[in] cell_type Cell type
 /// @param[in] dim Topological dimension of the entities to be computed
+/// @param[in] num_threads Number of threads used to compute and sort
+/// the entity vertex lists
 /// @return Returns the (cell-entity connectivity, entity-vertex
 /// connectivity, index map for the entity distribution across
 /// processes, shared entities)
@@ -460,7 +464,7 @@ compute_entities_by_key_matching(
                    std::shared_ptr<const common::IndexMap>>>
         cell_lists,
     const common::IndexMap& vertex_index_map, mesh::CellType entity_type,
-    int dim)
+    int dim, int num_threads)
 {
   if (dim == 0)
   {
@@ -494,11 +498,17 @@ compute_entities_by_key_matching(
   std::vector<std::int32_t> entity_list(cell_type_offsets.back()
                                         * num_vertices_per_entity);
 
+  // Copy of entity_list with the vertices of each entity sorted
+  std::vector<std::int32_t> entity_list_sorted(entity_list.size());
+
+  // Global index of each vertex, used to orient entities
+  const std::vector<std::int64_t> global_vertices
+      = vertex_index_map.global_indices();
+
   for (std::size_t k = 0; k < cell_lists.size(); ++k)
   {
     auto cell_type = std::get<0>(cell_lists[k]);
     auto cells = std::get<1>(cell_lists[k]);
-    auto cell_index_map = std::get<2>(cell_lists[k]);
 
     // Get indices of desired entities within cell. Usually this will be all
     // entities, but for prism or pyramid facets, we will just pick out
@@ -509,56 +519,83 @@ compute_entities_by_key_matching(
 
     const std::size_t num_cells = cells->num_nodes();
     int num_entities_per_cell = cell_type_entities[k].size();
-    for (std::size_t c = 0; c < num_cells; ++c)
+    auto compute_entity_vertices = [&](std::size_t c0, std::size_t c1)
     {
-      // Get vertices from each cell
-      auto vertices = cells->links(c);
-
-      for (int i = 0; i < num_entities_per_cell; ++i)
+      std::vector<std::int32_t> entity_vertices;
+      std::vector<std::size_t> perm;
+      for (std::size_t c = c0; c < c1; ++c)
       {
-        const std::int32_t idx = c * num_entities_per_cell + i;
-        auto ev = e_vertices.links(cell_type_entities[k][i]);
-
-        // Get entity vertices. Padded with -1 if fewer than
-        // max_vertices_per_entity
-        // NOTE Entity orientation is determined by vertex ordering. The
-        // orientation of an entity with respect to the cell may differ from its
-        // global mesh orientation. Hence, we reorder the vertices so that
-        // each entity's orientation agrees with their global orientation.
-        // FIXME This might be better below when the entity to vertex
-        // connectivity is computed
-        std::vector<std::int32_t> entity_vertices(ev.size());
-        for (std::size_t j = 0; j < ev.size(); ++j)
-          entity_vertices[j] = vertices[ev[j]];
-
-        // Orient the entities. Simply sort according to global vertex index
-        // for simplices
-        std::vector<std::int64_t> global_vertices(entity_vertices.size());
-        vertex_index_map.local_to_global(entity_vertices, global_vertices);
-
-        std::vector<std::size_t> perm(global_vertices.size());
-        std::iota(perm.begin(), perm.end(), 0);
-        std::ranges::sort(perm,
-                          [&global_vertices](std::size_t i0, std::size_t i1) {
-                            return global_vertices[i0] < global_vertices[i1];
-                          });
-        // For quadrilaterals, the vertex opposite the lowest vertex should
-        // be last
-        if (entity_type == mesh::CellType::quadrilateral)
+        // Get vertices from each cell
+        auto vertices = cells->links(c);
+
+        for (int i = 0; i < num_entities_per_cell; ++i)
         {
-          std::size_t min_vertex_idx = perm[0];
-          std::size_t opposite_vertex_index = 3 - min_vertex_idx;
-          auto it = std::find(perm.begin(), perm.end(), opposite_vertex_index);
-          assert(it != perm.end());
-          std::rotate(it, it + 1, perm.end());
-        }
+          const std::int32_t idx = c * num_entities_per_cell + i;
+          auto ev = e_vertices.links(cell_type_entities[k][i]);
+
+          // Get entity vertices. Padded with -1 if fewer than
+          // max_vertices_per_entity
+          // NOTE Entity orientation is determined by vertex ordering.
+          // The orientation of an entity with respect to the cell may
+          // differ from its global mesh orientation. Hence, we reorder
+          // the vertices so that each entity's orientation agrees with
+          // their global orientation.
+          // FIXME This might be better below when the entity to vertex
+          // connectivity is computed
+          entity_vertices.resize(ev.size());
+          for (std::size_t j = 0; j < ev.size(); ++j)
+            entity_vertices[j] = vertices[ev[j]];
+
+          // Orient the entities. Simply sort according to global vertex
+          // index for simplices
+          perm.resize(entity_vertices.size());
+          std::iota(perm.begin(), perm.end(), 0);
+          std::ranges::sort(perm,
+                            [&](std::size_t i0, std::size_t i1)
+                            {
+                              return global_vertices[entity_vertices[i0]]
+                                     < global_vertices[entity_vertices[i1]];
+                            });
+
+          // For quadrilaterals, the vertex opposite the lowest vertex
+          // should be last
+          if (entity_type == mesh::CellType::quadrilateral)
+          {
+            std::size_t min_vertex_idx = perm[0];
+            std::size_t opposite_vertex_index = 3 - min_vertex_idx;
+            auto it = std::ranges::find(perm, opposite_vertex_index);
+            assert(it != perm.end());
+            std::rotate(it, it + 1, perm.end());
+          }
 
-        for (std::size_t j = 0; j < ev.size(); ++j)
-          entity_list[(cell_type_offsets[k] + idx) * num_vertices_per_entity
-                      + j]
-              = entity_vertices[perm[j]];
+          std::size_t offset
+              = (cell_type_offsets[k] + idx) * num_vertices_per_entity;
+          for (std::size_t j = 0; j < ev.size(); ++j)
+            entity_list[offset + j] = entity_vertices[perm[j]];
+
+          // Sorted copy of the entity vertices, used to identify
+          // entities
+          auto it = std::next(entity_list_sorted.begin(), offset);
+          std::copy_n(std::next(entity_list.begin(), offset),
+                      num_vertices_per_entity, it);
+          std::sort(it, std::next(it, num_vertices_per_entity));
+        }
       }
+    };
+
+    if (num_threads > 1)
+    {
+      common::thread_pool().run(
+          num_threads,
+          [&compute_entity_vertices, num_cells, num_threads](int t)
+          {
+            auto [c0, c1]
+                = dolfinx::MPI::local_range(t, num_cells, num_threads);
+            compute_entity_vertices(c0, c1);
+          });
     }
+    else
+      compute_entity_vertices(0, num_cells);
   }
 
   // Start numbering entities
@@ -566,19 +603,10 @@ compute_entities_by_key_matching(
 
   std::int32_t entity_count = 0;
   {
-    // Copy list and sort vertices of each entity into (reverse) order
-    std::vector<std::int32_t> entity_list_sorted = entity_list;
-    for (std::size_t j = 0; j < entity_index.size(); ++j)
-    {
-      auto it
-          = std::next(entity_list_sorted.begin(), j * num_vertices_per_entity);
-      std::sort(it, std::next(it, num_vertices_per_entity), std::less<>());
-    }
-
     // Sort the list and label uniquely
     const std::vector<std::int32_t> sort_order
-        = dolfinx::sort_by_perm<std::int32_t>(entity_list_sorted,
-                                              num_vertices_per_entity);
+        = dolfinx::sort_by_perm<std::int32_t>(
+            entity_list_sorted, num_vertices_per_entity, num_threads);
 
     std::vector<std::int32_t> entity(num_vertices_per_entity),
         entity0(num_vertices_per_entity);
@@ -673,65 +701,197 @@ compute_entities_by_key_matching(
 /// Compute connectivity from entities of dimension d0 to entities of
 /// dimension d1 using the transpose connectivity (d1 -> d0)
 ///
+/// The transpose is computed by a counting sort. With more than one
+/// thread, each thread counts the connections of a contiguous range of
+/// d1 entities in its own histogram. The histograms are combined into
+/// the offsets and a start position for each (thread, d0 entity) pair,
+/// so that the threads fill the connections without atomics, in the
+/// same order as the serial computation.
+///
 /// @param[in] c_d1_d0 The connectivity from entities of dimension d1 to
 /// entities of dimension d0.
 /// @param[in] num_entities_d0 The number of entities of dimension d0.
+/// @param[in] num_threads Number of threads.
 /// @return The connectivity from entities of dimension d0 to entities
 /// of dimension d1.
 graph::AdjacencyList<std::int32_t>
 compute_from_transpose(const graph::AdjacencyList<std::int32_t>& c_d1_d0,
-                       const int num_entities_d0)
+                       const int num_entities_d0, int num_threads)
 {
-
-  // Compute number of connections for each e0
-  std::vector<std::int32_t> num_connections(num_entities_d0, 0);
-  for (int e1 = 0; e1 < c_d1_d0.num_nodes(); ++e1)
+  const std::int32_t num_entities_d1 = c_d1_d0.num_nodes();
+  num_threads = std::max(1, std::min(num_threads, num_entities_d1));
+  if (num_threads == 1)
   {
-    for (std::int32_t e0 : c_d1_d0.links(e1))
-      num_connections[e0]++;
-  }
+    // Compute number of connections for each e0
+    std::vector<std::int32_t> num_connections(num_entities_d0, 0);
+    for (int e1 = 0; e1 < num_entities_d1; ++e1)
+    {
+      for (std::int32_t e0 : c_d1_d0.links(e1))
+        num_connections[e0]++;
+    }
+
+    // Compute offsets
+    std::vector<std::int32_t> offsets(num_connections.size() + 1, 0);
+    std::partial_sum(num_connections.begin(), num_connections.end(),
+                     std::next(offsets.begin()));
 
-  // Compute offsets
-  std::vector<std::int32_t> offsets(num_connections.size() + 1, 0);
-  std::partial_sum(num_connections.begin(), num_connections.end(),
-                   std::next(offsets.begin()));
+    std::vector<std::int32_t> counter(num_connections.size(), 0);
+    std::vector<std::int32_t> connections(offsets[offsets.size() - 1]);
+    for (int e1 = 0; e1 < num_entities_d1; ++e1)
+      for (std::int32_t e0 : c_d1_d0.links(e1))
+        connections[offsets[e0] + counter[e0]++] = e1;
+
+    return graph::AdjacencyList(std::move(connections), std::move(offsets));
+  }
 
-  std::vector<std::int32_t> counter(num_connections.size(), 0);
-  std::vector<std::int32_t> connections(offsets[offsets.size() - 1]);
-  for (int e1 = 0; e1 < c_d1_d0.num_nodes(); ++e1)
-    for (std::int32_t e0 : c_d1_d0.links(e1))
-      connections[offsets[e0] + counter[e0]++] = e1;
+  // Count the connections of each e0 for the range of e1 of each thread
+  std::vector<std::int32_t> pos(std::size_t(num_threads) * num_entities_d0, 0);
+  common::thread_pool().run(
+      num_threads,
+      [&](int t)
+      {
+        auto [e1_0, e1_1]
+            = dolfinx::MPI::local_range(t, num_entities_d1, num_threads);
+        std::span<std::int32_t> count(
+            pos.data() + std::size_t(t) * num_entities_d0, num_entities_d0);
+        for (std::int32_t e1 = e1_0; e1 < e1_1; ++e1)
+          for (std::int32_t e0 : c_d1_d0.links(e1))
+            count[e0]++;
+      });
+
+  // Replace the counts by the position of each thread within the links
+  // of each e0, and compute the number of connections of each e0
+  std::vector<std::int32_t> offsets(num_entities_d0 + 1, 0);
+  common::thread_pool().run(
+      num_threads,
+      [&](int t)
+      {
+        auto [e0_0, e0_1]
+            = dolfinx::MPI::local_range(t, num_entities_d0, num_threads);
+        for (std::int32_t e0 = e0_0; e0 < e0_1; ++e0)
+        {
+          std::int32_t n = 0;
+          for (int s = 0; s < num_threads; ++s)
+          {
+            std::int32_t& p = pos[std::size_t(s) * num_entities_d0 + e0];
+            n += std::exchange(p, n);
+          }
+          offsets[e0 + 1] = n;
+        }
+      });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Fill the links, each thread from its start positions
+  std::vector<std::int32_t> connections(offsets.back());
+  common::thread_pool().run(
+      num_threads,
+      [&](int t)
+      {
+        auto [e1_0, e1_1]
+            = dolfinx::MPI::local_range(t, num_entities_d1, num_threads);
+        std::span<std::int32_t> p(
+            pos.data() + std::size_t(t) * num_entities_d0, num_entities_d0);
+        for (std::int32_t e1 = e1_0; e1 < e1_1; ++e1)
+          for (std::int32_t e0 : c_d1_d0.links(e1))
+            connections[offsets[e0] + p[e0]++] = e1;
+      });
 
   return graph::AdjacencyList(std::move(connections), std::move(offsets));
 }
 //-----------------------------------------------------------------------------
 
+/// Hash table, with open addressing and linear probing, from the
+/// vertices of an edge to the edge index. The (non-negative) vertex
+/// indices of an edge are packed into a single key, which avoids an
+/// allocation per edge.
+class EdgeTable
+{
+public:
+  /// Create a table for `size` edges
+  explicit EdgeTable(std::size_t size)
+      : _keys(std::bit_ceil(std::max<std::size_t>(2 * size, 2)), empty),
+        _values(_keys.size()), _shift(64 - std::countr_zero(_keys.size()))
+  {
+  }
+
+  /// Insert edge (v0, v1) with index `e`, if it is not in the table
+  void insert(std::int32_t v0, std::int32_t v1, std::int32_t e)
+  {
+    const std::uint64_t k = key(v0, v1);
+    std::size_t i = slot(k);
+    while (_keys[i] != empty and _keys[i] != k)
+      i = (i + 1) & (_keys.size() - 1);
+    if (_keys[i] == empty)
+    {
+      _keys[i] = k;
+      _values[i] = e;
+    }
+  }
+
+  /// Index of edge (v0, v1), or -1 if it is not in the table
+  std::int32_t find(std::int32_t v0, std::int32_t v1) const
+  {
+    const std::uint64_t k = key(v0, v1);
+    for (std::size_t i = slot(k); _keys[i] != empty;
+         i = (i + 1) & (_keys.size() - 1))
+    {
+      if (_keys[i] == k)
+        return _values[i];
+    }
+    return -1;
+  }
+
+private:
+  static constexpr std::uint64_t empty
+      = std::numeric_limits<std::uint64_t>::max();
+
+  // Key of an edge, independent of the order of the vertices
+  static std::uint64_t key(std::int32_t v0, std::int32_t v1)
+  {
+    assert(v0 >= 0 and v1 >= 0);
+    auto [a, b] = std::minmax(v0, v1);
+    return (static_cast<std::uint64_t>(a) << 32)
+           | static_cast<std::uint32_t>(b);
+  }
+
+  // Initial slot of a key (Fibonacci hashing)
+  std::size_t slot(std::uint64_t k) const
+  {
+    return (k * 0x9e3779b97f4a7c15) >> _shift;
+  }
+
+  std::vector<std::uint64_t> _keys;
+  std::vector<std::int32_t> _values;
+  int _shift;
+};
+//-----------------------------------------------------------------------------
+
 /// Compute the d0 -> d1 connectivity, where d0 > d1
+///
+/// The edge table is built serially, and the edges of the d0 entities
+/// are looked up concurrently by `num_threads` threads.
+///
 /// @param[in] c_d0_0 The d0 -> 0 (entity (d0) to vertex) connectivity
 /// @param[in] c_d0_0 The d1 -> 0 (entity (d1) to vertex) connectivity
-/// @param[in] cell_type_d0 The cell type for entities of dimension d0
+/// @param[in] num_threads Number of threads
 /// @return The d0 -> d1 connectivity
 graph::AdjacencyList<std::int32_t>
 compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
-                 const graph::AdjacencyList<std::int32_t>& c_d1_0)
+                 const graph::AdjacencyList<std::int32_t>& c_d1_0,
+                 int num_threads)
 {
-  // Make a map from the sorted edge vertices to the edge index
-  boost::unordered_map<std::array<std::int32_t, 2>, std::int32_t> edge_to_index;
-  edge_to_index.reserve(c_d1_0.num_nodes());
-
-  std::array<std::int32_t, 2> key;
+  // Make a map from the edge vertices to the edge index
+  EdgeTable edge_to_index(c_d1_0.num_nodes());
   for (int e = 0; e < c_d1_0.num_nodes(); ++e)
   {
     std::span<const std::int32_t> v = c_d1_0.links(e);
-    assert(v.size() == key.size());
-    std::partial_sort_copy(v.begin(), v.end(), key.begin(), key.end());
-    edge_to_index.insert({key, e});
+    assert(v.size() == 2);
+    edge_to_index.insert(v[0], v[1], e);
   }
 
   // Number of edges for a tri/quad is the same as number of vertices so
   // AdjacencyList will have same offset pattern
-  std::vector<std::int32_t> connections;
-  connections.reserve(c_d0_0.array().size());
+  std::vector<std::int32_t> connections(c_d0_0.array().size());
   std::vector<std::int32_t> offsets(c_d0_0.offsets());
 
   // Search for edges of facet in map, and recover index
@@ -739,22 +899,37 @@ compute_from_map(const graph::AdjacencyList<std::int32_t>& c_d0_0,
       = get_entity_vertices(mesh::CellType::triangle, 1);
   const graph::AdjacencyList<int> quad_vertices_ref
       = get_entity_vertices(mesh::CellType::quadrilateral, 1);
-  for (int e = 0; e < c_d0_0.num_nodes(); ++e)
+  auto find_edges = [&](std::int32_t e0, std::int32_t e1)
   {
-    auto e0 = c_d0_0.links(e);
-    auto vref = (e0.size() == 3) ? &tri_vertices_ref : &quad_vertices_ref;
-    for (std::size_t i = 0; i < e0.size(); ++i)
+    for (std::int32_t e = e0; e < e1; ++e)
     {
-      auto v = vref->links(i);
-      for (int j = 0; j < 2; ++j)
-        key[j] = e0[v[j]];
-      std::ranges::sort(key);
-      auto it = edge_to_index.find(key);
-      assert(it != edge_to_index.end());
-      connections.push_back(it->second);
+      auto ev = c_d0_0.links(e);
+      auto vref = (ev.size() == 3) ? &tri_vertices_ref : &quad_vertices_ref;
+      for (std::size_t i = 0; i < ev.size(); ++i)
+      {
+        auto v = vref->links(i);
+        std::int32_t edge = edge_to_index.find(ev[v[0]], ev[v[1]]);
+        assert(edge != -1);
+        connections[offsets[e] + i] = edge;
+      }
     }
+  };
+
+  const std::int32_t num_entities = c_d0_0.num_nodes();
+  if (num_threads > 1)
+  {
+    common::thread_pool().run(
+        num_threads,
+        [&find_edges, num_entities, num_threads](int t)
+        {
+          auto [e0, e1]
+              = dolfinx::MPI::local_range(t, num_entities, num_threads);
+          find_edges(e0, e1);
+        });
   }
-  connections.shrink_to_fit();
+  else
+    find_edges(0, num_entities);
+
   return graph::AdjacencyList(std::move(connections), std::move(offsets));
 }
 //-----------------------------------------------------------------------------
@@ -765,7 +940,7 @@ std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
            std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>
 mesh::compute_entities(MPI_Comm comm, const Topology& topology, int dim,
-                       int index)
+                       int index, int num_threads)
 {
   spdlog::info("Computing mesh entities of dimension {}", dim);
   const int tdim = topology.dim();
@@ -805,7 +980,7 @@ mesh::compute_entities(MPI_Comm comm, const Topology& topology, int dim,
   }
 
   auto [d0, d1, im, interprocess_entities] = compute_entities_by_key_matching(
-      comm, cell_lists, *vertex_map, entity_type, dim);
+      comm, cell_lists, *vertex_map, entity_type, dim, num_threads);
 
   return {d0,
           std::make_shared<graph::AdjacencyList<std::int32_t>>(std::move(d1)),
@@ -816,7 +991,8 @@ mesh::compute_entities(MPI_Comm comm, const Topology& topology, int dim,
 std::array<std::shared_ptr<graph::AdjacencyList<std::int32_t>>, 2>
 mesh::compute_connectivity(const Topology& topology,
                            std::pair<std::int8_t, std::int8_t> d0,
-                           std::pair<std::int8_t, std::int8_t> d1)
+                           std::pair<std::int8_t, std::int8_t> d1,
+                           int num_threads)
 {
   spdlog::info("Requesting connectivity ({}, {}) - ({}, {})",
                std::to_string(d0.first), std::to_string(d0.second),
@@ -876,12 +1052,13 @@ mesh::compute_connectivity(const Topology& topology,
       // Only possible case is edge->facet
       assert(d0.first == 1 and d1.first == 2);
       auto c_d1_d0 = std::make_shared<graph::AdjacencyList<std::int32_t>>(
-          compute_from_map(*c_d1_0, *c_d0_0));
+          compute_from_map(*c_d1_0, *c_d0_0, num_threads));
 
       spdlog::info("Computing mesh connectivity {}-{} from transpose.",
                    d0.first, d1.first);
       auto c_d0_d1 = std::make_shared<graph::AdjacencyList<std::int32_t>>(
-          compute_from_transpose(*c_d1_d0, c_d0_0->num_nodes()));
+          compute_from_transpose(*c_d1_d0, c_d0_0->num_nodes(),
+                                 num_threads));
       return {c_d0_d1, c_d1_d0};
     }
     else
@@ -893,7 +1070,7 @@ mesh::compute_connectivity(const Topology& topology,
                    std::to_string(d0.first), std::to_string(d1.first));
       auto c_d0_d1 = std::make_shared<graph::AdjacencyList<std::int32_t>>(
           compute_from_transpose(*topology.connectivity(d1, d0),
-                                 c_d0_0->num_nodes()));
+                                 c_d0_0->num_nodes(), num_threads));
       return {c_d0_d1, nullptr};
     }
   }
@@ -905,7 +1082,7 @@ mesh::compute_connectivity(const Topology& topology,
     // Only possible case is facet->edge
     assert(d0.first == 2 and d1.first == 1);
     auto c_d0_d1 = std::make_shared<graph::AdjacencyList<std::int32_t>>(
-        compute_from_map(*c_d0_0, *c_d1_0));
+        compute_from_map(*c_d0_0, *c_d1_0, num_threads));
     return {c_d0_d1, nullptr};
   }
   else
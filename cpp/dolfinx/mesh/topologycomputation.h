@@ -40,6 +40,9 @@ class Topology;
 /// @param[in] dim The dimension of the entities to create
 /// @param[in] index Index of entity in dimension `dim` as listed in
 /// `Topology::entity_types(dim)`.
+/// @param[in] num_threads Number of threads used to compute and sort
+/// the local entity vertex lists. The determination of entity
+/// ownership across processes is not threaded.
 /// @return Tuple of (cell-entity connectivity, entity-vertex
 /// connectivity, index map, list of interprocess entities).
 /// Interprocess entities lie on the "true" boundary between owned cells
@@ -48,7 +51,8 @@ class Topology;
 std::tuple<std::vector<std::shared_ptr<graph::AdjacencyList<std::int32_t>>>,
            std::shared_ptr<graph::AdjacencyList<std::int32_t>>,
            std::shared_ptr<common::IndexMap>, std::vector<std::int32_t>>
-compute_entities(MPI_Comm comm, const Topology& topology, int dim, int index);
+compute_entities(MPI_Comm comm, const Topology& topology, int dim, int index,
+                 int num_threads = 1);
 
 /// @brief Compute connectivity (d0 -> d1) for given pair of entity
 /// types, given by topological dimension and index, as found in
@@ -56,6 +60,8 @@ compute_entities(MPI_Comm comm, const Topology& topology, int dim, int index);
 /// @param[in] topology The topology
 /// @param[in] d0 The dimension and index of the entities
 /// @param[in] d1 The dimension and index of the incident entities
+/// @param[in] num_threads Number of threads used to compute the
+/// connectivity by transposition or by matching vertices
 /// @returns The connectivities [(d0 -> d1), (d1 -> d0)] if they are
 /// computed. If (d0, d1) already exists then a nullptr is returned. If
 /// (d0, d1) is computed and the computation of (d1, d0) was required as
@@ -64,6 +70,7 @@ compute_entities(MPI_Comm comm, const Topology& topology, int dim, int index);
 std::array<std::shared_ptr<graph::AdjacencyList<std::int32_t>>, 2>
 compute_connectivity(const Topology& topology,
                      std::pair<std::int8_t, std::int8_t> d0,
-                     std::pair<std::int8_t, std::int8_t> d1);
+                     std::pair<std::int8_t, std::int8_t> d1,
+                     int num_threads = 1);
 
 } // namespace dolfinx::mesh
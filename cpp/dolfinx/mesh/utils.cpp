@@ -58,6 +58,9 @@ mesh::extract_topology(CellType cell_type, const fem::ElementDofLayout& layout,
 std::vector<std::int32_t> mesh::exterior_facet_indices(const Topology& topology)
 {
   const int tdim = topology.dim();
+  if (auto facets = topology.boundary_entities(tdim - 1))
+    return *facets;
+
   auto f_to_c = topology.connectivity(tdim - 1, tdim);
   if (!f_to_c)
   {
@@ -83,9 +86,14 @@ std::vector<std::int32_t> mesh::exterior_facet_indices(const Topology& topology)
 //------------------------------------------------------------------------------
 mesh::CellPartitionFunction
 mesh::create_cell_partitioner(mesh::GhostMode ghost_mode,
-                              const graph::partition_fn& partfn)
+                              const graph::partition_fn& partfn,
+                              std::vector<std::int32_t> weights,
+                              bool hierarchical)
 {
-  return [partfn, ghost_mode](
+  graph::partition_fn graph_partfn
+      = hierarchical ? graph::hierarchical::partitioner(partfn) : partfn;
+  return [partfn = std::move(graph_partfn), ghost_mode,
+          weights = std::move(weights)](
              MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
              const std::vector<std::span<const std::int64_t>>& cells)
              -> graph::AdjacencyList<std::int32_t>
@@ -95,12 +103,78 @@ mesh::create_cell_partitioner(mesh::GhostMode ghost_mode,
     // Compute distributed dual graph (for the cells on this process)
     const graph::AdjacencyList dual_graph
         = build_dual_graph(comm, cell_types, cells);
+    if (!weights.empty()
+        and weights.size() != std::size_t(dual_graph.num_nodes()))
+    {
+      throw std::runtime_error(
+          "Number of cell weights does not match number of cells.");
+    }
 
     // Just flag any kind of ghosting for now
     bool ghosting = (ghost_mode != GhostMode::none);
 
     // Compute partition
-    return partfn(comm, nparts, dual_graph, ghosting);
+    return partfn(comm, nparts, dual_graph, ghosting, weights);
+  };
+}
+//-----------------------------------------------------------------------------
+mesh::CellPartitionFunction
+mesh::create_stored_cell_partitioner(mesh::GhostMode ghost_mode,
+                                     std::vector<std::int32_t> dest,
+                                     int num_parts,
+                                     const graph::partition_fn& partfn)
+{
+  return [ghost_mode, dest = std::move(dest), num_parts, partfn](
+             MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
+             const std::vector<std::span<const std::int64_t>>& cells)
+             -> graph::AdjacencyList<std::int32_t>
+  {
+    std::size_t num_cells = 0;
+    for (std::size_t i = 0; i < cell_types.size(); ++i)
+      num_cells += cells[i].size() / num_cell_vertices(cell_types[i]);
+    if (num_cells != dest.size())
+    {
+      throw std::runtime_error(
+          "Number of stored destination ranks does not match number of "
+          "cells.");
+    }
+
+    bool ghosting = (ghost_mode != GhostMode::none);
+    std::vector<std::int32_t> part;
+    if (nparts == num_parts)
+    {
+      spdlog::info("Use stored partition of cells");
+      part = dest;
+    }
+    else if (nparts < num_parts)
+    {
+      spdlog::info("Merge stored partition of cells ({} parts) into {} parts",
+                   num_parts, nparts);
+      part.reserve(dest.size());
+      for (std::int32_t p : dest)
+      {
+        assert(p >= 0 and p < num_parts);
+        part.push_back((std::int64_t(p) * nparts) / num_parts);
+      }
+    }
+    else
+    {
+      spdlog::info("Stored partition of cells has fewer parts ({}) than "
+                   "requested ({}). Repartitioning.",
+                   num_parts, nparts);
+      const graph::AdjacencyList dual_graph
+          = build_dual_graph(comm, cell_types, cells);
+      return partfn(comm, nparts, dual_graph, ghosting, {});
+    }
+
+    if (!ghosting)
+      return graph::regular_adjacency_list(std::move(part), 1);
+    else
+    {
+      const graph::AdjacencyList dual_graph
+          = build_dual_graph(comm, cell_types, cells);
+      return graph::extend_destination_ranks(comm, dual_graph, part);
+    }
   };
 }
 //-----------------------------------------------------------------------------
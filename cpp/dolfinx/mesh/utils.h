@@ -10,11 +10,17 @@
 #include "Topology.h"
 #include "graphbuild.h"
 #include <algorithm>
+#include <array>
 #include <basix/mdspan.hpp>
+#include <cmath>
 #include <concepts>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/common/log.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/ordering.h>
 #include <dolfinx/graph/partition.h>
+#include <dolfinx/graph/partitioners.h>
 #include <functional>
 #include <mpi.h>
 #include <span>
@@ -31,7 +37,14 @@ namespace dolfinx::mesh
 {
 enum class CellType;
 
-/// Enum for different partitioning ghost modes
+/// @brief Enum for different partitioning ghost modes.
+///
+/// With GhostMode::shared_facet, the cells that share a facet with an
+/// owned cell are ghosted, which is the data required by interior facet
+/// integrals. The assemblers only create the facets of the ghost cells
+/// for these integrals (see Topology::create_facet_permutations).
+/// Entities of other dimensions are only created if required, e.g. by
+/// the dofmap of a continuous or edge-based space.
 enum class GhostMode : int
 {
   none,
@@ -119,7 +132,7 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
 
   // Get geometry data
   auto x_dofmap = mesh.geometry().dofmap();
-  std::span<const T> x_nodes = mesh.geometry().x();
+  NodeCoordinates<T> x_nodes = mesh.geometry().coordinates();
 
   // Get all vertex 'node' indices
   mesh.topology_mutable()->create_connectivity(0, tdim);
@@ -144,7 +157,7 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
     auto dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, c, MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
     for (std::size_t j = 0; j < 3; ++j)
-      x_vertices[j * vertices.size() + i] = x_nodes[3 * dofs[local_pos] + j];
+      x_vertices[j * vertices.size() + i] = x_nodes(dofs[local_pos], j);
     vertex_to_pos[v] = i;
   }
 
@@ -159,6 +172,9 @@ compute_vertex_coords_boundary(const mesh::Mesh<T>& mesh, int dim,
 /// An exterior facet (co-dimension 1) is one that is connected globally
 /// to only one cell of co-dimension 0).
 ///
+/// The facets stored by Topology::create_boundary_entities are returned
+/// if they have been computed.
+///
 /// @note Collective
 ///
 /// @param[in] topology Mesh topology.
@@ -186,6 +202,16 @@ using CellPartitionFunction = std::function<graph::AdjacencyList<std::int32_t>(
     MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
     const std::vector<std::span<const std::int64_t>>& cells)>;
 
+/// @brief Signature for functions that compute a re-ordering of the
+/// owned cells on a process for data locality.
+///
+/// The function is called with the local dual graph of the owned cells,
+/// i.e. cells are connected if they share a facet, and returns
+/// `map`, where `map[i]` is the new index of cell `i`. Examples are
+/// graph::reorder_gps and graph::reorder_rcm.
+using CellReorderFunction = std::function<std::vector<std::int32_t>(
+    const graph::AdjacencyList<std::int32_t>& graph)>;
+
 /// @brief Extract topology from cell data, i.e. extract cell vertices.
 /// @param[in] cell_type The cell shape
 /// @param[in] layout The layout of geometry 'degrees-of-freedom' on the
@@ -199,71 +225,220 @@ std::vector<std::int64_t> extract_topology(CellType cell_type,
                                            const fem::ElementDofLayout& layout,
                                            std::span<const std::int64_t> cells);
 
+namespace impl
+{
+/// @brief Execute `fn(i, xdofs)` for each entity `entities[i]`, where
+/// `xdofs` are the geometry dofs of the closure of the entity, in the
+/// order of mesh::entities_to_geometry without permutation.
+///
+/// The geometry dofs of an entity are extracted when the entity is
+/// visited, rather than stored for all entities. Contiguous ranges of
+/// `entities` are executed concurrently by `num_threads` threads, so
+/// `fn` must be safe to call concurrently for different `i`.
+///
+/// @pre The mesh connectivities `dim -> tdim` and `tdim -> dim` must
+/// have been computed if `dim` is not the topological dimension.
+template <std::floating_point T, typename F>
+void for_each_entity_geometry(const Mesh<T>& mesh, int dim,
+                              std::span<const std::int32_t> entities,
+                              int num_threads, F&& fn)
+{
+  auto topology = mesh.topology();
+  assert(topology);
+  if (topology->cell_type() == CellType::prism and dim == 2)
+    throw std::runtime_error("More work needed for prism cells");
+
+  const int tdim = topology->dim();
+  auto xdofs = mesh.geometry().dofmap();
+  const fem::ElementDofLayout layout
+      = mesh.geometry().cmap().create_dof_layout();
+  const std::vector<std::vector<int>>& closure_dofs
+      = layout.entity_closure_dofs_all()[dim];
+
+  std::shared_ptr<const graph::AdjacencyList<std::int32_t>> e_to_c, c_to_e;
+  if (dim != tdim)
+  {
+    e_to_c = topology->connectivity(dim, tdim);
+    if (!e_to_c)
+    {
+      throw std::runtime_error(
+          "Entity-to-cell connectivity has not been computed. Missing dims "
+          + std::to_string(dim) + "->" + std::to_string(tdim));
+    }
+    c_to_e = topology->connectivity(tdim, dim);
+    if (!c_to_e)
+    {
+      throw std::runtime_error(
+          "Cell-to-entity connectivity has not been computed. Missing dims "
+          + std::to_string(tdim) + "->" + std::to_string(dim));
+    }
+  }
+
+  auto visit = [&](std::size_t i0, std::size_t i1)
+  {
+    std::vector<std::int32_t> dofs;
+    for (std::size_t i = i0; i < i1; ++i)
+    {
+      // Get a cell connected to the entity, and the local index of the
+      // entity
+      std::int32_t c = entities[i];
+      std::size_t local_entity = 0;
+      if (dim != tdim)
+      {
+        assert(!e_to_c->links(entities[i]).empty());
+        c = e_to_c->links(entities[i]).front();
+        std::span<const std::int32_t> cell_entities = c_to_e->links(c);
+        auto it = std::ranges::find(cell_entities, entities[i]);
+        assert(it != cell_entities.end());
+        local_entity = std::distance(cell_entities.begin(), it);
+      }
+
+      const std::vector<int>& entity_dofs = closure_dofs[local_entity];
+      dofs.resize(entity_dofs.size());
+      for (std::size_t j = 0; j < entity_dofs.size(); ++j)
+        dofs[j] = xdofs(c, entity_dofs[j]);
+      fn(i, std::span<const std::int32_t>(dofs));
+    }
+  };
+
+  if (num_threads > 1)
+  {
+    common::thread_pool().run(
+        num_threads,
+        [&visit, size = entities.size(), num_threads](int t)
+        {
+          auto [i0, i1] = dolfinx::MPI::local_range(t, size, num_threads);
+          visit(i0, i1);
+        });
+  }
+  else
+    visit(0, entities.size());
+}
+
+/// @brief Coordinates of point `i` in `x`, which has `stride`
+/// components per point (see mesh::Geometry::x_stride).
+template <std::floating_point T>
+std::array<T, 3> point(std::span<const T> x, int stride, std::int32_t i)
+{
+  std::array<T, 3> p = {0, 0, 0};
+  for (int k = 0; k < stride; ++k)
+    p[k] = x[stride * i + k];
+  return p;
+}
+
+/// @brief Greatest distance between any two of the points with indices
+/// `dofs` in `x`.
+///
+/// For a fixed number of points `N` the points are gathered and the
+/// distances are computed with fixed-size loops, which the compiler
+/// unrolls and vectorises.
+template <std::size_t N, std::floating_point T>
+T max_distance(std::span<const T> x, int stride,
+               std::span<const std::int32_t, N> dofs)
+{
+  auto distance2 = [](const std::array<T, 3>& p0, const std::array<T, 3>& p1)
+  {
+    return (p0[0] - p1[0]) * (p0[0] - p1[0]) + (p0[1] - p1[1]) * (p0[1] - p1[1])
+           + (p0[2] - p1[2]) * (p0[2] - p1[2]);
+  };
+
+  T d2 = 0;
+  if constexpr (N == std::dynamic_extent)
+  {
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+    {
+      const std::array<T, 3> p0 = point(x, stride, dofs[i]);
+      for (std::size_t j = i + 1; j < dofs.size(); ++j)
+        d2 = std::max(d2, distance2(p0, point(x, stride, dofs[j])));
+    }
+  }
+  else
+  {
+    std::array<std::array<T, 3>, N> p;
+    for (std::size_t i = 0; i < N; ++i)
+      p[i] = point(x, stride, dofs[i]);
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = i + 1; j < N; ++j)
+        d2 = std::max(d2, distance2(p[i], p[j]));
+  }
+
+  return std::sqrt(d2);
+}
+
+/// @brief Mean of the points with indices `dofs` in `x`.
+template <std::size_t N, std::floating_point T>
+std::array<T, 3> mean(std::span<const T> x, int stride,
+                      std::span<const std::int32_t, N> dofs)
+{
+  std::array<T, 3> p = {0, 0, 0};
+  for (std::size_t i = 0; i < dofs.size(); ++i)
+    for (int k = 0; k < stride; ++k)
+      p[k] += x[stride * dofs[i] + k];
+  for (std::size_t k = 0; k < 3; ++k)
+    p[k] /= dofs.size();
+  return p;
+}
+} // namespace impl
+
 /// @brief Compute greatest distance between any two vertices of the
 /// mesh entities (`h`).
 /// @param[in] mesh Mesh that the entities belong to.
 /// @param[in] entities Indices (local to process) of entities to
 /// compute `h` for.
 /// @param[in] dim Topological dimension of the entities.
+/// @param[in] num_threads Number of threads to compute `h` with.
 /// @returns Greatest distance between any two vertices, `h[i]`
 /// corresponds to the entity `entities[i]`.
 template <std::floating_point T>
 std::vector<T> h(const Mesh<T>& mesh, std::span<const std::int32_t> entities,
-                 int dim)
+                 int dim, int num_threads = 1)
 {
   if (entities.empty())
     return std::vector<T>();
   if (dim == 0)
     return std::vector<T>(entities.size(), 0);
 
-  // Get the geometry dofs for the vertices of each entity
-  const std::vector<std::int32_t> vertex_xdofs
-      = entities_to_geometry(mesh, dim, entities, false);
-  assert(!entities.empty());
-  const std::size_t num_vertices = vertex_xdofs.size() / entities.size();
-
-  // Get the  geometry coordinate
+  // Compute greatest distance between any two geometry nodes of each
+  // entity, with fixed-size kernels for intervals, triangles,
+  // tetrahedra and quadrilaterals with affine geometry
   std::span<const T> x = mesh.geometry().x();
-
-  // Function to compute the length of (p0 - p1)
-  auto delta_norm = [](auto&& p0, auto&& p1)
-  {
-    T norm = 0;
-    for (std::size_t i = 0; i < 3; ++i)
-      norm += (p0[i] - p1[i]) * (p0[i] - p1[i]);
-    return std::sqrt(norm);
-  };
-
-  // Compute greatest distance between any to vertices
-  assert(dim > 0);
-  std::vector<T> h(entities.size(), 0);
-  for (std::size_t e = 0; e < entities.size(); ++e)
-  {
-    // Get geometry 'dof' for each vertex of entity e
-    std::span<const std::int32_t> e_vertices(
-        vertex_xdofs.data() + e * num_vertices, num_vertices);
-
-    // Compute maximum distance between any two vertices
-    for (std::size_t i = 0; i < e_vertices.size(); ++i)
-    {
-      std::span<const T, 3> p0(x.data() + 3 * e_vertices[i], 3);
-      for (std::size_t j = i + 1; j < e_vertices.size(); ++j)
+  const int stride = mesh.geometry().x_stride();
+  std::vector<T> h(entities.size());
+  impl::for_each_entity_geometry(
+      mesh, dim, entities, num_threads,
+      [&h, x, stride](std::size_t i, std::span<const std::int32_t> dofs)
       {
-        std::span<const T, 3> p1(x.data() + 3 * e_vertices[j], 3);
-        h[e] = std::max(h[e], delta_norm(p0, p1));
-      }
-    }
-  }
+        switch (dofs.size())
+        {
+        case 2:
+          h[i] = impl::max_distance(x, stride, dofs.first<2>());
+          break;
+        case 3:
+          h[i] = impl::max_distance(x, stride, dofs.first<3>());
+          break;
+        case 4:
+          h[i] = impl::max_distance(x, stride, dofs.first<4>());
+          break;
+        default:
+          h[i] = impl::max_distance(x, stride, dofs);
+        }
+      });
 
   return h;
 }
 
 /// @brief Compute normal to given cell (viewed as embedded in 3D)
+/// @param[in] mesh Mesh that the entities belong to.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] entities Indices (local to process) of the entities.
+/// @param[in] num_threads Number of threads to compute the normals
+/// with.
 /// @returns The entity normals. The shape is `(entities.size(), 3)` and
 /// the storage is row-major.
 template <std::floating_point T>
 std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
-                            std::span<const std::int32_t> entities)
+                            std::span<const std::int32_t> entities,
+                            int num_threads = 1)
 {
   auto topology = mesh.topology();
   assert(topology);
@@ -277,12 +452,8 @@ std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
   const int gdim = mesh.geometry().dim();
   const CellType type = cell_entity_type(topology->cell_type(), dim, 0);
 
-  // Find geometry nodes for topology entities
   std::span<const T> x = mesh.geometry().x();
-  std::vector<std::int32_t> geometry_entities
-      = entities_to_geometry(mesh, dim, entities, false);
-
-  const std::size_t shape1 = geometry_entities.size() / entities.size();
+  const int stride = mesh.geometry().x_stride();
   std::vector<T> n(entities.size() * 3);
   switch (type)
   {
@@ -290,82 +461,46 @@ std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
   {
     if (gdim > 2)
       throw std::invalid_argument("Interval cell normal undefined in 3D");
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the two vertices as points
-      std::array vertices{geometry_entities[i * shape1],
-                          geometry_entities[i * shape1 + 1]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3)};
-
-      // Define normal by rotating tangent counter-clockwise
-      std::array<T, 3> t;
-      std::ranges::transform(p[1], p[0], t.begin(),
-                             [](auto x, auto y) { return x - y; });
-
-      T norm = std::sqrt(t[0] * t[0] + t[1] * t[1]);
-      std::span<T, 3> ni(n.data() + 3 * i, 3);
-      ni[0] = -t[1] / norm;
-      ni[1] = t[0] / norm;
-      ni[2] = 0.0;
-    }
+    impl::for_each_entity_geometry(
+        mesh, dim, entities, num_threads,
+        [&n, x, stride](std::size_t i, std::span<const std::int32_t> dofs)
+        {
+          // Define normal by rotating tangent counter-clockwise
+          const std::array p0 = impl::point(x, stride, dofs[0]);
+          const std::array p1 = impl::point(x, stride, dofs[1]);
+          std::array<T, 2> t = {p1[0] - p0[0], p1[1] - p0[1]};
+          T norm = std::sqrt(t[0] * t[0] + t[1] * t[1]);
+          n[3 * i + 0] = -t[1] / norm;
+          n[3 * i + 1] = t[0] / norm;
+          n[3 * i + 2] = 0.0;
+        });
     return n;
   }
   case CellType::triangle:
-  {
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the three vertices as points
-      std::array vertices = {geometry_entities[i * shape1 + 0],
-                             geometry_entities[i * shape1 + 1],
-                             geometry_entities[i * shape1 + 2]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[2], 3)};
-
-      // Compute (p1 - p0) and (p2 - p0)
-      std::array<T, 3> dp1, dp2;
-      std::ranges::transform(p[1], p[0], dp1.begin(),
-                             [](auto x, auto y) { return x - y; });
-      std::ranges::transform(p[2], p[0], dp2.begin(),
-                             [](auto x, auto y) { return x - y; });
-
-      // Define cell normal via cross product of first two edges
-      std::array<T, 3> ni = math::cross(dp1, dp2);
-      T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
-      std::ranges::transform(ni, std::next(n.begin(), 3 * i),
-                             [norm](auto x) { return x / norm; });
-    }
-
-    return n;
-  }
   case CellType::quadrilateral:
   {
-    // TODO: check
-    for (std::size_t i = 0; i < entities.size(); ++i)
-    {
-      // Get the three vertices as points
-      std::array vertices = {geometry_entities[i * shape1 + 0],
-                             geometry_entities[i * shape1 + 1],
-                             geometry_entities[i * shape1 + 2]};
-      std::array p = {std::span<const T, 3>(x.data() + 3 * vertices[0], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[1], 3),
-                      std::span<const T, 3>(x.data() + 3 * vertices[2], 3)};
-
-      // Compute (p1 - p0) and (p2 - p0)
-      std::array<T, 3> dp1, dp2;
-      std::ranges::transform(p[1], p[0], dp1.begin(),
-                             [](auto x, auto y) { return x - y; });
-      std::ranges::transform(p[2], p[0], dp2.begin(),
-                             [](auto x, auto y) { return x - y; });
-
-      // Define cell normal via cross product of first two edges
-      std::array<T, 3> ni = math::cross(dp1, dp2);
-      T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
-      std::ranges::transform(ni, std::next(n.begin(), 3 * i),
-                             [norm](auto x) { return x / norm; });
-    }
-
+    // TODO: check for quadrilaterals
+    impl::for_each_entity_geometry(
+        mesh, dim, entities, num_threads,
+        [&n, x, stride](std::size_t i, std::span<const std::int32_t> dofs)
+        {
+          // Compute (p1 - p0) and (p2 - p0)
+          const std::array p0 = impl::point(x, stride, dofs[0]);
+          const std::array p1 = impl::point(x, stride, dofs[1]);
+          const std::array p2 = impl::point(x, stride, dofs[2]);
+          std::array<T, 3> dp1, dp2;
+          for (std::size_t k = 0; k < 3; ++k)
+          {
+            dp1[k] = p1[k] - p0[k];
+            dp2[k] = p2[k] - p0[k];
+          }
+
+          // Define cell normal via cross product of first two edges
+          std::array<T, 3> ni = math::cross(dp1, dp2);
+          T norm = std::sqrt(ni[0] * ni[0] + ni[1] * ni[1] + ni[2] * ni[2]);
+          for (std::size_t k = 0; k < 3; ++k)
+            n[3 * i + k] = ni[k] / norm;
+        });
     return n;
   }
   default:
@@ -375,35 +510,48 @@ std::vector<T> cell_normals(const Mesh<T>& mesh, int dim,
 }
 
 /// @brief Compute the midpoints for mesh entities of a given dimension.
+/// @param[in] mesh Mesh that the entities belong to.
+/// @param[in] dim Topological dimension of the entities.
+/// @param[in] entities Indices (local to process) of the entities.
+/// @param[in] num_threads Number of threads to compute the midpoints
+/// with.
 /// @returns The entity midpoints. The shape is `(entities.size(), 3)`
 /// and the storage is row-major.
 template <std::floating_point T>
 std::vector<T> compute_midpoints(const Mesh<T>& mesh, int dim,
-                                 std::span<const std::int32_t> entities)
+                                 std::span<const std::int32_t> entities,
+                                 int num_threads = 1)
 {
   if (entities.empty())
     return std::vector<T>();
 
   std::span<const T> x = mesh.geometry().x();
-
-  // Build map from entity -> geometry dof
-  const std::vector<std::int32_t> e_to_g
-      = entities_to_geometry(mesh, dim, entities, false);
-  std::size_t shape1 = e_to_g.size() / entities.size();
-
-  std::vector<T> x_mid(entities.size() * 3, 0);
-  for (std::size_t e = 0; e < entities.size(); ++e)
-  {
-    std::span<T, 3> p(x_mid.data() + 3 * e, 3);
-    std::span<const std::int32_t> rows(e_to_g.data() + e * shape1, shape1);
-    for (auto row : rows)
-    {
-      std::span<const T, 3> xg(x.data() + 3 * row, 3);
-      std::ranges::transform(p, xg, p.begin(),
-                             [size = rows.size()](auto x, auto y)
-                             { return x + y / size; });
-    }
-  }
+  const int stride = mesh.geometry().x_stride();
+  std::vector<T> x_mid(entities.size() * 3);
+  impl::for_each_entity_geometry(
+      mesh, dim, entities, num_threads,
+      [&x_mid, x, stride](std::size_t i, std::span<const std::int32_t> dofs)
+      {
+        std::array<T, 3> p;
+        switch (dofs.size())
+        {
+        case 1:
+          p = impl::mean(x, stride, dofs.first<1>());
+          break;
+        case 2:
+          p = impl::mean(x, stride, dofs.first<2>());
+          break;
+        case 3:
+          p = impl::mean(x, stride, dofs.first<3>());
+          break;
+        case 4:
+          p = impl::mean(x, stride, dofs.first<4>());
+          break;
+        default:
+          p = impl::mean(x, stride, dofs);
+        }
+        std::ranges::copy(p, std::next(x_mid.begin(), 3 * i));
+      });
 
   return x_mid;
 }
@@ -442,14 +590,11 @@ compute_vertex_coords(const mesh::Mesh<T>& mesh)
   }
 
   // Pack coordinates of vertices
-  std::span<const T> x_nodes = mesh.geometry().x();
+  NodeCoordinates<T> x_nodes = mesh.geometry().coordinates();
   std::vector<T> x_vertices(3 * vertex_to_node.size(), 0.0);
   for (std::size_t i = 0; i < vertex_to_node.size(); ++i)
-  {
-    const int pos = 3 * vertex_to_node[i];
     for (std::size_t j = 0; j < 3; ++j)
-      x_vertices[j * vertex_to_node.size() + i] = x_nodes[pos + j];
-  }
+      x_vertices[j * vertex_to_node.size() + i] = x_nodes(vertex_to_node[i], j);
 
   return {std::move(x_vertices), {3, vertex_to_node.size()}};
 }
@@ -565,9 +710,10 @@ std::vector<std::int32_t> locate_entities_boundary(const Mesh<T>& mesh, int dim,
   }
 
   // Compute list of boundary facets
-  mesh.topology_mutable()->create_entities(tdim - 1);
-  mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
-  std::vector<std::int32_t> boundary_facets = exterior_facet_indices(*topology);
+  mesh.topology_mutable()->create_boundary_entities(tdim - 1);
+  std::shared_ptr<const std::vector<std::int32_t>> boundary_facets
+      = topology->boundary_entities(tdim - 1);
+  assert(boundary_facets);
 
   using cmdspan3x_t = MDSPAN_IMPL_STANDARD_NAMESPACE::mdspan<
       const T,
@@ -576,7 +722,7 @@ std::vector<std::int32_t> locate_entities_boundary(const Mesh<T>& mesh, int dim,
 
   // Run marker function on the vertex coordinates
   auto [facet_entities, xdata, vertex_to_pos]
-      = impl::compute_vertex_coords_boundary(mesh, dim, boundary_facets);
+      = impl::compute_vertex_coords_boundary(mesh, dim, *boundary_facets);
   cmdspan3x_t x(xdata.data(), 3, xdata.size() / 3);
   std::vector<std::int8_t> marked = marker(x);
   if (marked.size() != x.extent(1))
@@ -731,11 +877,127 @@ entities_to_geometry(const Mesh<T>& mesh, int dim,
 /// Create a function that computes destination rank for mesh cells in
 /// this rank by applying the default graph partitioner to the dual
 /// graph of the mesh
+/// @param[in] ghost_mode Type of cell ghosting/overlap.
+/// @param[in] partfn Graph partitioning function.
+/// @param[in] weights Weight of each cell that the returned function
+/// is called with on this process, e.g. the number of degrees of
+/// freedom or the measured assembly cost of each cell. Cells are
+/// numbered consecutively across cell types. If empty, all cells have
+/// the same weight.
+/// @param[in] hierarchical If true, the dual graph is partitioned first
+/// across the (shared memory) compute nodes and then across the ranks
+/// of each node, using `partfn` on each level (see
+/// graph::hierarchical::partitioner). This reduces the number of cell
+/// facets that are shared between ranks on different nodes.
 /// @return Function that computes the destination ranks for each cell
-CellPartitionFunction create_cell_partitioner(mesh::GhostMode ghost_mode
-                                              = mesh::GhostMode::none,
-                                              const graph::partition_fn& partfn
-                                              = &graph::partition_graph);
+CellPartitionFunction
+create_cell_partitioner(mesh::GhostMode ghost_mode = mesh::GhostMode::none,
+                        const graph::partition_fn& partfn
+                        = &graph::partition_graph,
+                        std::vector<std::int32_t> weights = {},
+                        bool hierarchical = false);
+
+/// @brief Create a function that computes destination ranks for mesh
+/// cells by partitioning a space-filling curve through the cell
+/// midpoints.
+///
+/// The partition is computed from the cell vertex coordinates, and
+/// unlike create_cell_partitioner the distributed dual graph of the
+/// mesh is not built. The partition is faster to compute and uses less
+/// memory than a graph partition, but typically has a larger number of
+/// shared facets. If ghosting is requested the dual graph is built to
+/// determine the ghost cells.
+///
+/// Cells that are received on a process follow the curve within each
+/// sending process. Creating the mesh without a cell re-ordering
+/// function (see ::create_mesh) retains this order for data locality.
+///
+/// @param[in] ghost_mode Type of cell ghosting/overlap.
+/// @param[in] x Geometry data ('node' coordinates) on this process, as
+/// passed to ::create_mesh. The data must be distributed across the
+/// same processes as the cells that are partitioned (`commt` in
+/// ::create_mesh), and it must remain valid until the mesh has been
+/// created.
+/// @param[in] gdim Geometric dimension, i.e. the number of columns of
+/// `x`.
+/// @param[in] curve The space-filling curve.
+/// @return Function that computes the destination ranks for each cell.
+template <std::floating_point T>
+CellPartitionFunction create_sfc_cell_partitioner(
+    GhostMode ghost_mode, std::span<const T> x, int gdim,
+    graph::sfc::curve curve = graph::sfc::curve::hilbert)
+{
+  return [ghost_mode, x, gdim, curve](
+             MPI_Comm comm, int nparts, const std::vector<CellType>& cell_types,
+             const std::vector<std::span<const std::int64_t>>& cells)
+             -> graph::AdjacencyList<std::int32_t>
+  {
+    spdlog::info("Compute space-filling curve partition of cells");
+
+    // Get coordinates of the cell vertices
+    std::vector<std::int64_t> nodes;
+    for (auto c : cells)
+      nodes.insert(nodes.end(), c.begin(), c.end());
+    dolfinx::sort_unique(nodes);
+    std::vector<T> coords
+        = dolfinx::MPI::distribute_data(comm, nodes, comm, x, gdim);
+
+    // Compute cell midpoints
+    std::vector<double> midpoints;
+    for (std::size_t i = 0; i < cells.size(); ++i)
+    {
+      const int nv = num_cell_vertices(cell_types[i]);
+      for (std::size_t c = 0; c < cells[i].size(); c += nv)
+      {
+        std::array<double, 3> xm = {0, 0, 0};
+        for (int v = 0; v < nv; ++v)
+        {
+          auto it = std::ranges::lower_bound(nodes, cells[i][c + v]);
+          std::size_t pos = std::distance(nodes.begin(), it);
+          for (int j = 0; j < gdim; ++j)
+            xm[j] += coords[pos * gdim + j];
+        }
+        for (int j = 0; j < gdim; ++j)
+          midpoints.push_back(xm[j] / nv);
+      }
+    }
+
+    std::vector<std::int32_t> part
+        = graph::sfc::partition(comm, nparts, midpoints, gdim, curve);
+    if (ghost_mode == GhostMode::none)
+      return graph::regular_adjacency_list(std::move(part), 1);
+    else
+    {
+      const graph::AdjacencyList dual_graph
+          = build_dual_graph(comm, cell_types, cells);
+      return graph::extend_destination_ranks(comm, dual_graph, part);
+    }
+  };
+}
+
+/// @brief Create a function that computes destination ranks for mesh
+/// cells from a stored partition, e.g. the partition of a previous run
+/// that was read from file.
+///
+/// If the number of parts that is requested is the number of parts of
+/// the stored partition, the stored destination ranks are used and no
+/// partitioning is performed. If fewer parts are requested, consecutive
+/// stored parts are merged, i.e. a cell in stored part `p` is sent to
+/// rank `p * nparts / num_parts`, which is also fast. Otherwise, the
+/// cells are partitioned with `partfn`. If ghosting is requested the
+/// dual graph is built to determine the ghost cells.
+///
+/// @param[in] ghost_mode Type of cell ghosting/overlap.
+/// @param[in] dest Stored destination rank of each cell that the
+/// returned function is called with on this process. Cells are numbered
+/// consecutively across cell types.
+/// @param[in] num_parts Number of parts of the stored partition.
+/// @param[in] partfn Graph partitioning function that is used if more
+/// parts than `num_parts` are requested.
+/// @return Function that computes the destination ranks for each cell.
+CellPartitionFunction create_stored_cell_partitioner(
+    GhostMode ghost_mode, std::vector<std::int32_t> dest, int num_parts,
+    const graph::partition_fn& partfn = &graph::partition_graph);
 
 /// @brief Compute incident indices
 /// @param[in] topology The topology
@@ -777,6 +1039,15 @@ compute_incident_entities(const Topology& topology,
 /// @param[in] xshape Shape of the `x` data.
 /// @param[in] partitioner Graph partitioner that computes the owning
 /// rank for each cell. If not callable, cells are not redistributed.
+/// @param[in] reorder_fn Function that re-orders the owned cells on
+/// each process for data locality. The geometry and dofmaps that are
+/// later created on the mesh without a re-ordering function number
+/// their nodes by traversing the cells, and so follow this ordering.
+/// The re-ordered owned cells that may share a vertex with another
+/// process are then moved after the other owned cells, preserving
+/// their order, so that the cells are ordered as [interior | process
+/// boundary | ghost] (see Topology::cell_ranges). If not callable, the
+/// cells are not re-ordered.
 /// @return A mesh distributed on the communicator `comm`.
 template <typename U>
 Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
@@ -784,7 +1055,8 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
     const fem::CoordinateElement<
         typename std::remove_reference_t<typename U::value_type>>& element,
     MPI_Comm commg, const U& x, std::array<std::size_t, 2> xshape,
-    const CellPartitionFunction& partitioner)
+    const CellPartitionFunction& partitioner,
+    const CellReorderFunction& reorder_fn = graph::reorder_gps)
 {
   CellType celltype = element.cell_shape();
   const fem::ElementDofLayout doflayout = element.create_dof_layout();
@@ -822,7 +1094,7 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
     std::tie(cells1, src_ranks, original_idx1, ghost_owners)
         = graph::build::distribute(comm, cells, {num_cells, num_cell_nodes},
                                    dest);
-    spdlog::debug("Got {} cells from distribution", cells1.size());
+    DOLFINX_LOG_DEBUG("Got {} cells from distribution", cells1.size());
   }
   else
   {
@@ -835,6 +1107,15 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
     std::iota(original_idx1.begin(), original_idx1.end(), offset);
   }
 
+  // Build list of unique (global) node indices from cells1 and start
+  // the distribution of the coordinate data. The set of nodes does not
+  // depend on the re-ordering of cells below, so the exchange of
+  // coordinates can overlap the creation of the topology.
+  std::vector<std::int64_t> nodes1 = cells1;
+  dolfinx::sort_unique(nodes1);
+  auto coords_request
+      = dolfinx::MPI::distribute_data_begin(comm, nodes1, commg, x, xshape[1]);
+
   // Extract cell 'topology', i.e. extract the vertices for each cell
   // and discard any 'higher-order' nodes
   std::vector<std::int64_t> cells1_v
@@ -857,20 +1138,26 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
         = build_local_dual_graph(
             std::vector{celltype},
             {std::span(cells1_v.data(), num_owned_cells * num_cell_vertices)});
-    const std::vector<int> remap = graph::reorder_gps(graph);
-
-    // Create re-ordered cell lists (leaves ghosts unchanged)
-    std::vector<std::int64_t> _original_idx(original_idx1.size());
-    for (std::size_t i = 0; i < remap.size(); ++i)
-      _original_idx[remap[i]] = original_idx1[i];
-    std::copy_n(std::next(original_idx1.cbegin(), num_owned_cells),
-                ghost_owners.size(),
-                std::next(_original_idx.begin(), num_owned_cells));
-    impl::reorder_list(
-        std::span(cells1_v.data(), remap.size() * num_cell_vertices), remap);
-    impl::reorder_list(std::span(cells1.data(), remap.size() * num_cell_nodes),
-                       remap);
-    original_idx1 = _original_idx;
+    if (reorder_fn)
+    {
+      const std::vector<std::int32_t> remap = reorder_fn(graph);
+      if (static_cast<std::int32_t>(remap.size()) != num_owned_cells)
+        throw std::runtime_error("Cell re-ordering has the wrong size.");
+
+      // Create re-ordered cell lists (leaves ghosts unchanged)
+      std::vector<std::int64_t> _original_idx(original_idx1.size());
+      for (std::size_t i = 0; i < remap.size(); ++i)
+        _original_idx[remap[i]] = original_idx1[i];
+      std::copy_n(std::next(original_idx1.cbegin(), num_owned_cells),
+                  ghost_owners.size(),
+                  std::next(_original_idx.begin(), num_owned_cells));
+      impl::reorder_list(
+          std::span(cells1_v.data(), remap.size() * num_cell_vertices),
+          remap);
+      impl::reorder_list(
+          std::span(cells1.data(), remap.size() * num_cell_nodes), remap);
+      original_idx1 = _original_idx;
+    }
 
     // Boundary vertices are marked as 'unknown'
     boundary_v = unmatched_facets;
@@ -882,6 +1169,47 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
     // topology)
     if (!boundary_v.empty() > 0 and boundary_v[0] == -1)
       boundary_v.erase(boundary_v.begin());
+
+    // Move the owned cells that have a vertex that may be shared with
+    // another process, i.e. a boundary vertex or a vertex of a ghost
+    // cell, after the other owned cells, preserving the order within
+    // each group. This makes the range of interior cells reported by
+    // Topology::cell_ranges contain all interior cells.
+    if (reorder_fn and dolfinx::MPI::size(comm) > 1)
+    {
+      std::vector<std::int64_t> shared_v(
+          std::next(cells1_v.begin(), num_owned_cells * num_cell_vertices),
+          cells1_v.end());
+      shared_v.insert(shared_v.end(), boundary_v.begin(), boundary_v.end());
+      dolfinx::sort_unique(shared_v);
+
+      std::vector<std::int8_t> marker(num_owned_cells, 0);
+      for (std::int32_t c = 0; c < num_owned_cells; ++c)
+      {
+        auto cv = std::span(cells1_v.data() + c * num_cell_vertices,
+                            num_cell_vertices);
+        marker[c] = std::ranges::any_of(
+            cv, [&shared_v](auto v)
+            { return std::ranges::binary_search(shared_v, v); });
+      }
+
+      std::vector<std::int32_t> remap(num_owned_cells);
+      std::int32_t pos = 0;
+      for (int m : {0, 1})
+      {
+        for (std::int32_t c = 0; c < num_owned_cells; ++c)
+          if (marker[c] == m)
+            remap[c] = pos++;
+      }
+
+      impl::reorder_list(
+          std::span(cells1_v.data(), remap.size() * num_cell_vertices),
+          remap);
+      impl::reorder_list(
+          std::span(cells1.data(), remap.size() * num_cell_nodes), remap);
+      impl::reorder_list(std::span(original_idx1.data(), remap.size()),
+                         remap);
+    }
   }
 
   // Create Topology
@@ -896,15 +1224,9 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
   if (element.needs_dof_permutations())
     topology.create_entity_permutations();
 
-  // Build list of unique (global) node indices from cells1 and
-  // distribute coordinate data
-  std::vector<std::int64_t> nodes1 = cells1;
-  dolfinx::radix_sort(nodes1);
-  auto [unique_end, range_end] = std::ranges::unique(nodes1);
-  nodes1.erase(unique_end, range_end);
-
+  // Complete the distribution of the coordinate data
   std::vector coords
-      = dolfinx::MPI::distribute_data(comm, nodes1, commg, x, xshape[1]);
+      = dolfinx::MPI::distribute_data_end(std::move(coords_request));
 
   // Create geometry object
   Geometry geometry
@@ -1021,7 +1343,8 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
       std::tie(cells1[i], src_ranks, original_idx1[i], ghost_owners[i])
           = graph::build::distribute(comm, cells[i],
                                      {num_cells, num_cell_nodes}, dest_i);
-      spdlog::debug("Got {} cells from distribution", cells1[i].size());
+      DOLFINX_LOG_DEBUG("Got {} cells from distribution",
+                        cells1[i].size());
     }
   }
   else
@@ -1091,7 +1414,20 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
       boundary_v.erase(boundary_v.begin());
   }
 
-  spdlog::debug("Got {} boundary vertices", boundary_v.size());
+  DOLFINX_LOG_DEBUG("Got {} boundary vertices", boundary_v.size());
+
+  // Build list of unique (global) node indices from cells1 and start
+  // the distribution of the coordinate data, which overlaps the
+  // creation of the topology
+  std::vector<std::int64_t> nodes1, nodes2;
+  for (std::vector<std::int64_t>& c : cells1)
+    nodes1.insert(nodes1.end(), c.begin(), c.end());
+  for (std::vector<std::int64_t>& c : cells1)
+    nodes2.insert(nodes2.end(), c.begin(), c.end());
+
+  dolfinx::sort_unique(nodes1);
+  auto coords_request
+      = dolfinx::MPI::distribute_data_begin(comm, nodes1, commg, x, xshape[1]);
 
   // Create Topology
 
@@ -1120,20 +1456,9 @@ Mesh<typename std::remove_reference_t<typename U::value_type>> create_mesh(
       topology.create_entity_permutations();
   }
 
-  // Build list of unique (global) node indices from cells1 and
-  // distribute coordinate data
-  std::vector<std::int64_t> nodes1, nodes2;
-  for (std::vector<std::int64_t>& c : cells1)
-    nodes1.insert(nodes1.end(), c.begin(), c.end());
-  for (std::vector<std::int64_t>& c : cells1)
-    nodes2.insert(nodes2.end(), c.begin(), c.end());
-
-  dolfinx::radix_sort(nodes1);
-  auto [unique_end, range_end] = std::ranges::unique(nodes1);
-  nodes1.erase(unique_end, range_end);
-
+  // Complete the distribution of the coordinate data
   std::vector coords
-      = dolfinx::MPI::distribute_data(comm, nodes1, commg, x, xshape[1]);
+      = dolfinx::MPI::distribute_data_end(std::move(coords_request));
 
   // Create geometry object
   Geometry geometry
@@ -1186,12 +1511,25 @@ create_mesh(MPI_Comm comm, std::span<const std::int64_t> cells,
 /// @param[in] dim Topological dimension of the sub-topology.
 /// @param[in] subentity_to_entity Map from sub-topology entity to the
 /// entity in the parent topology.
+/// @param[in] subvertex_map Index map of the sub-topology vertices
+/// (optional).
+/// @param[in] subvertex_to_vertex Map from sub-topology vertex to the
+/// vertex in the parent topology (optional).
 /// @return A sub-geometry and a map from sub-geometry coordinate
 /// degree-of-freedom to the coordinate degree-of-freedom in `geometry`.
+///
+/// @note If the coordinate element has degree 1 and the sub-topology
+/// vertex data is provided, the sub-geometry nodes are numbered as the
+/// sub-topology vertices and the sub-geometry uses `subvertex_map`.
+/// This avoids the communication to create a new index map for the
+/// sub-geometry.
 template <std::floating_point T>
 std::pair<Geometry<T>, std::vector<int32_t>>
 create_subgeometry(const Mesh<T>& mesh, int dim,
-                   std::span<const std::int32_t> subentity_to_entity)
+                   std::span<const std::int32_t> subentity_to_entity,
+                   std::shared_ptr<const common::IndexMap> subvertex_map
+                   = nullptr,
+                   std::span<const std::int32_t> subvertex_to_vertex = {})
 {
   const Geometry<T>& geometry = mesh.geometry();
 
@@ -1202,18 +1540,53 @@ create_subgeometry(const Mesh<T>& mesh, int dim,
   std::vector<std::int32_t> x_indices
       = entities_to_geometry(mesh, dim, subentity_to_entity, true);
 
-  std::vector<std::int32_t> sub_x_dofs = x_indices;
-  std::ranges::sort(sub_x_dofs);
-  auto [unique_end, range_end] = std::ranges::unique(sub_x_dofs);
-  sub_x_dofs.erase(unique_end, range_end);
-
   // Get the sub-geometry dofs owned by this process
   auto x_index_map = geometry.index_map();
   assert(x_index_map);
 
-  std::shared_ptr<common::IndexMap> sub_x_dof_index_map;
+  std::shared_ptr<const common::IndexMap> sub_x_dof_index_map;
   std::vector<std::int32_t> subx_to_x_dofmap;
+  if (subvertex_map and geometry.cmap().degree() == 1)
+  {
+    // Geometry nodes are the vertices. Number the sub-geometry nodes as
+    // the sub-topology vertices, getting the node of a vertex from a
+    // cell that contains it.
+    auto topology = mesh.topology();
+    const int tdim = topology->dim();
+    auto c_to_v = topology->connectivity(tdim, 0);
+    assert(c_to_v);
+    auto e_to_c = dim < tdim ? topology->connectivity(dim, tdim) : nullptr;
+    assert(dim == tdim or e_to_c);
+    auto xdofs = geometry.dofmap();
+
+    auto vertex_map = topology->index_map(0);
+    assert(vertex_map);
+    std::vector<std::int32_t> vertex_to_subvertex(
+        vertex_map->size_local() + vertex_map->num_ghosts(), -1);
+    for (std::size_t i = 0; i < subvertex_to_vertex.size(); ++i)
+      vertex_to_subvertex[subvertex_to_vertex[i]] = i;
+
+    subx_to_x_dofmap.resize(subvertex_to_vertex.size(), -1);
+    for (std::int32_t e : subentity_to_entity)
+    {
+      std::int32_t c = dim < tdim ? e_to_c->links(e).front() : e;
+      std::span<const std::int32_t> vertices = c_to_v->links(c);
+      for (std::size_t i = 0; i < vertices.size(); ++i)
+      {
+        if (std::int32_t sv = vertex_to_subvertex[vertices[i]]; sv >= 0)
+          subx_to_x_dofmap[sv] = xdofs(c, i);
+      }
+    }
+    assert(std::ranges::find(subx_to_x_dofmap, -1) == subx_to_x_dofmap.end());
+    sub_x_dof_index_map = subvertex_map;
+  }
+  else
   {
+    std::vector<std::int32_t> sub_x_dofs = x_indices;
+    std::ranges::sort(sub_x_dofs);
+    auto [unique_end, range_end] = std::ranges::unique(sub_x_dofs);
+    sub_x_dofs.erase(unique_end, range_end);
+
     auto [map, new_to_old] = common::create_sub_index_map(
         *x_index_map, sub_x_dofs, common::IndexMapOrder::any, true);
     sub_x_dof_index_map = std::make_shared<common::IndexMap>(std::move(map));
@@ -1221,14 +1594,9 @@ create_subgeometry(const Mesh<T>& mesh, int dim,
   }
 
   // Create sub-geometry coordinates
-  std::span<const T> x = geometry.x();
   std::int32_t sub_num_x_dofs = subx_to_x_dofmap.size();
   std::vector<T> sub_x(3 * sub_num_x_dofs);
-  for (int i = 0; i < sub_num_x_dofs; ++i)
-  {
-    std::copy_n(std::next(x.begin(), 3 * subx_to_x_dofmap[i]), 3,
-                std::next(sub_x.begin(), 3 * i));
-  }
+  geometry.coordinates().copy(subx_to_x_dofmap, sub_x.data());
 
   // Create geometry to sub-geometry  map
   std::vector<std::int32_t> x_to_subx_dof_map(
@@ -1289,14 +1657,21 @@ create_submesh(const Mesh<T>& mesh, int dim,
   auto [topology, subentity_to_entity, subvertex_to_vertex]
       = mesh::create_subtopology(*mesh.topology(), dim, entities);
 
-  // Create sub-geometry
+  // Create sub-geometry. The entity permutations and the connectivity
+  // between the entities and cells are not needed for a sub-mesh of
+  // cells. For a degree 1 geometry the sub-geometry re-uses the
+  // sub-topology vertex index map.
   const int tdim = mesh.topology()->dim();
-  mesh.topology_mutable()->create_entities(dim);
-  mesh.topology_mutable()->create_connectivity(dim, tdim);
-  mesh.topology_mutable()->create_connectivity(tdim, dim);
-  mesh.topology_mutable()->create_entity_permutations();
-  auto [geometry, subx_to_x_dofmap]
-      = mesh::create_subgeometry(mesh, dim, subentity_to_entity);
+  if (dim < tdim)
+  {
+    mesh.topology_mutable()->create_entities(dim);
+    mesh.topology_mutable()->create_connectivity(dim, tdim);
+    mesh.topology_mutable()->create_connectivity(tdim, dim);
+    mesh.topology_mutable()->create_entity_permutations();
+  }
+  auto [geometry, subx_to_x_dofmap] = mesh::create_subgeometry(
+      mesh, dim, subentity_to_entity, topology.index_map(0),
+      subvertex_to_vertex);
 
   return {Mesh(mesh.comm(), std::make_shared<Topology>(std::move(topology)),
                std::move(geometry)),
@@ -9,6 +9,8 @@
 #include "NewtonSolver.h"
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <algorithm>
+#include <cmath>
 #include <dolfinx/la/petsc.h>
 #include <string>
 
@@ -84,6 +86,8 @@ nls::petsc::NewtonSolver::~NewtonSolver()
     VecDestroy(&_b);
   if (_dx)
     VecDestroy(&_dx);
+  if (_x0)
+    VecDestroy(&_x0);
   if (_matJ)
     MatDestroy(&_matJ);
   if (_matP)
@@ -192,29 +196,137 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
   if (!_dx)
     MatCreateVecs(_matJ, &_dx, nullptr);
 
+  // Krylov solver tolerances, restored after the solve if changed by
+  // the Eisenstat-Walker forcing
+  KSP ksp = _solver.ksp();
+  PetscReal ksp_rtol, ksp_atol, ksp_dtol;
+  PetscInt ksp_maxits;
+  KSPGetTolerances(ksp, &ksp_rtol, &ksp_atol, &ksp_dtol, &ksp_maxits);
+  double eta = ew_rtol_0;
+
+  // Residual norm, used by the Jacobian reuse policy, the
+  // Eisenstat-Walker forcing and the globalization
+  PetscReal fnorm = 0.0;
+  VecNorm(_b, NORM_2, &fnorm);
+
+  // Evaluate the residual at x
+  auto compute_F = [this, x]()
+  {
+    if (_system)
+      _system(x);
+    _fnF(x, _b);
+  };
+
+  if (globalization != "none" and globalization != "backtracking"
+      and globalization != "trust_region")
+  {
+    throw std::runtime_error("Unknown Newton globalization: "
+                             + globalization);
+  }
+  if (globalization != "none" and !_x0)
+    VecDuplicate(x, &_x0);
+  _trust_radius = trust_region_radius;
+
+  // Number of iterations the current Jacobian has been used for, and
+  // whether to compute a new Jacobian
+  int num_reused = 0;
+  bool update_jacobian = true;
+
   // Start iterations
   while (!newton_converged and _iteration < max_it)
   {
-    // Compute Jacobian
+    // Compute Jacobian (and preconditioner matrix)
     assert(_matJ);
-    _fnJ(x, _matJ);
+    if (update_jacobian or reuse_preconditioner_only)
+      _fnJ(x, _matJ);
 
-    if (_fnP)
+    if (_fnP and update_jacobian)
       _fnP(x, _matP);
 
+    if (jacobian_reuse > 1)
+    {
+      KSPSetReusePreconditioner(ksp,
+                                update_jacobian ? PETSC_FALSE : PETSC_TRUE);
+    }
+    num_reused = update_jacobian ? 1 : num_reused + 1;
+
+    if (eisenstat_walker)
+      KSPSetTolerances(ksp, eta, ksp_atol, ksp_dtol, ksp_maxits);
+
     // Perform linear solve and update total number of Krylov iterations
     _krylov_iterations += _solver.solve(_dx, _b);
 
-    // Update solution
-    this->_update_solution(*this, _dx, x);
+    // Update solution and compute F
+    if (globalization == "none")
+    {
+      this->_update_solution(*this, _dx, x);
+      compute_F();
+    }
+    else
+    {
+      // The Newton increment is scaled by lambda, and the update is
+      // applied to the solution from the start of the iteration
+      VecCopy(x, _x0);
+      PetscReal dxnorm = 0.0;
+      VecNorm(_dx, NORM_2, &dxnorm);
+      if (globalization == "trust_region" and _trust_radius <= 0.0)
+        _trust_radius = dxnorm;
+
+      double lambda = 1.0;
+      for (int k = 0;; ++k)
+      {
+        // Limit the step to the trust region
+        if (globalization == "trust_region" and dxnorm > _trust_radius)
+        {
+          VecScale(_dx, _trust_radius / dxnorm);
+          lambda *= _trust_radius / dxnorm;
+          dxnorm = _trust_radius;
+        }
+
+        if (k > 0)
+          VecCopy(_x0, x);
+        this->_update_solution(*this, _dx, x);
+        compute_F();
+        PetscReal fnorm_trial = 0.0;
+        VecNorm(_b, NORM_2, &fnorm_trial);
+
+        // Ratio of the actual to predicted (by the linear model)
+        // reduction of the residual norm
+        const double rho
+            = fnorm > 0.0 ? (fnorm - fnorm_trial) / (lambda * fnorm) : 1.0;
+        if (k >= line_search_max_it)
+          break;
+
+        if (globalization == "backtracking")
+        {
+          if (rho >= 1e-4)
+            break;
+
+          // Minimiser of the quadratic model of ||F||^2 along the
+          // step, safeguarded to [0.1, 0.5] of the current step
+          const double f0 = fnorm * fnorm;
+          const double f1 = fnorm_trial * fnorm_trial;
+          double lambda_new
+              = lambda * lambda * f0 / (f1 - f0 + 2.0 * lambda * f0);
+          lambda_new = std::clamp(lambda_new, 0.1 * lambda, 0.5 * lambda);
+          VecScale(_dx, lambda_new / lambda);
+          lambda = lambda_new;
+        }
+        else
+        {
+          if (rho < 0.25)
+            _trust_radius = 0.25 * dxnorm;
+          else if (rho > 0.75 and dxnorm >= 0.99 * _trust_radius)
+            _trust_radius *= 2.0;
+          if (rho >= 1e-4)
+            break;
+        }
+      }
+    }
 
     // Increment iteration count
     ++_iteration;
 
-    // Compute F
-    if (_system)
-      _system(x);
-    _fnF(x, _b);
     // Initialize _residual0
     if (_iteration == 1)
     {
@@ -223,6 +335,27 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
       _residual0 = _r;
     }
 
+    // Reduction of the residual norm in this iteration
+    const PetscReal fnorm0 = fnorm;
+    VecNorm(_b, NORM_2, &fnorm);
+    const double rate = fnorm0 > 0.0 ? fnorm / fnorm0 : 0.0;
+
+    // Recompute the Jacobian if it has been used for the maximum number
+    // of iterations or if convergence is too slow
+    update_jacobian
+        = num_reused >= jacobian_reuse or rate > jacobian_reuse_rate;
+
+    // Eisenstat-Walker forcing term (choice 2), with the safeguard to
+    // prevent the tolerance from decreasing too quickly
+    if (eisenstat_walker)
+    {
+      const double eta_min = ew_gamma * std::pow(eta, ew_alpha);
+      eta = ew_gamma * std::pow(rate, ew_alpha);
+      if (eta_min > 0.1)
+        eta = std::max(eta, eta_min);
+      eta = std::min(eta, ew_rtol_max);
+    }
+
     // Test for convergence
     if (convergence_criterion == "residual")
       std::tie(_residual, newton_converged) = this->_converged(*this, _b);
@@ -242,6 +375,11 @@ std::pair<int, bool> nls::petsc::NewtonSolver::solve(Vec x)
       throw std::runtime_error("Unknown convergence criterion string.");
   }
 
+  if (jacobian_reuse > 1)
+    KSPSetReusePreconditioner(ksp, PETSC_FALSE);
+  if (eisenstat_walker)
+    KSPSetTolerances(ksp, ksp_rtol, ksp_atol, ksp_dtol, ksp_maxits);
+
   if (newton_converged)
   {
     if (dolfinx::MPI::rank(_comm.comm()) == 0)
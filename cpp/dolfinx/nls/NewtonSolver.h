@@ -12,6 +12,7 @@
 #include <dolfinx/la/petsc.h>
 #include <functional>
 #include <memory>
+#include <numbers>
 #include <petscmat.h>
 #include <petscvec.h>
 #include <utility>
@@ -172,6 +173,72 @@ public:
   /// @brief Relaxation parameter.
   double relaxation_parameter = 1.0;
 
+  /// @brief Globalization of the Newton update.
+  ///
+  /// - `"none"` (default): full Newton step (scaled by
+  ///   `relaxation_parameter`).
+  /// - `"backtracking"`: the step is reduced, using a safeguarded
+  ///   quadratic model of \f$\|F\|^2\f$, until the residual norm is
+  ///   sufficiently reduced.
+  /// - `"trust_region"`: the step length is limited to a trust-region
+  ///   radius that is adapted from the ratio of the actual to the
+  ///   predicted reduction of the residual norm. Steps that do not
+  ///   reduce the residual norm are rejected.
+  ///
+  /// Both options reuse the Jacobian and the linear solve of the
+  /// iteration and only require the residual at trial points. The
+  /// increment passed to the update function (see set_update) is
+  /// scaled by the step length.
+  std::string globalization = "none";
+
+  /// @brief Maximum number of step reductions per Newton iteration for
+  /// the line search and trust-region globalization.
+  int line_search_max_it = 10;
+
+  /// @brief Initial trust-region radius. If not positive, the norm of
+  /// the first Newton increment is used.
+  double trust_region_radius = 0.0;
+
+  /// @brief Maximum number of Newton iterations a Jacobian (and
+  /// preconditioner) is used for before it is recomputed.
+  ///
+  /// The default (`1`) recomputes the Jacobian at every iteration
+  /// (full Newton). Larger values give a modified Newton method.
+  int jacobian_reuse = 1;
+
+  /// @brief Largest ratio of successive residual norms for which the
+  /// Jacobian may be reused.
+  ///
+  /// If an iteration reduces the residual norm by less than this
+  /// factor, the Jacobian is recomputed at the next iteration. Only
+  /// used if `jacobian_reuse > 1`.
+  double jacobian_reuse_rate = 0.5;
+
+  /// @brief If `true`, the Jacobian is computed at every iteration and
+  /// only the preconditioner (and preconditioner matrix) follow the
+  /// reuse policy of `jacobian_reuse` and `jacobian_reuse_rate`.
+  bool reuse_preconditioner_only = false;
+
+  /// @brief Set the relative tolerance of the Krylov solver at each
+  /// iteration using the Eisenstat-Walker forcing terms (choice 2).
+  ///
+  /// The Krylov solver must be iterative for this to have an effect.
+  /// The tolerance of the Krylov solver is restored after the solve.
+  bool eisenstat_walker = false;
+
+  /// @brief Eisenstat-Walker relative tolerance for the first
+  /// iteration.
+  double ew_rtol_0 = 0.3;
+
+  /// @brief Eisenstat-Walker maximum relative tolerance.
+  double ew_rtol_max = 0.9;
+
+  /// @brief Eisenstat-Walker parameter \f$\gamma\f$.
+  double ew_gamma = 1.0;
+
+  /// @brief Eisenstat-Walker parameter \f$\alpha\f$.
+  double ew_alpha = std::numbers::phi;
+
 private:
   // Function for computing the residual vector. The first argument is
   // the latest solution vector x and the second argument is the
@@ -222,6 +289,12 @@ private:
   // Solution vector
   Vec _dx = nullptr;
 
+  // Solution at the start of an iteration, used by the globalization
+  Vec _x0 = nullptr;
+
+  // Current trust-region radius
+  double _trust_radius = 0.0;
+
   // MPI communicator
   dolfinx::MPI::Comm _comm;
 };
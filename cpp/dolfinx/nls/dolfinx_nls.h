@@ -9,6 +9,8 @@ namespace dolfinx::nls
 
 // DOLFINx nonlinear solver
 
+#include <dolfinx/nls/newton.h>
+
 #ifdef HAS_PETSC
 #include <dolfinx/nls/NewtonSolver.h>
 #endif
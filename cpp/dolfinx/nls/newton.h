@@ -0,0 +1,225 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <dolfinx/common/types.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <limits>
+#include <span>
+#include <utility>
+
+/// @file newton.h
+/// @brief Newton solver for la::Vector.
+///
+/// The solver does not depend on PETSc. The residual is a callable
+/// `F(x, r)` that computes `r = F(x)` on the owned entries of `r`. The
+/// ghost values of `x` are updated by the solver before `F` is called.
+/// The linear solver is a callable `solve(x, r, dx)` that solves
+/// `J(x) dx = r` for the Newton increment `dx` (owned entries, initial
+/// guess zero) and returns the number of linear solver iterations. It
+/// can, for example, assemble the Jacobian into a la::MatrixCSR and
+/// call la::cg, apply the Jacobian matrix-free, or use
+/// nls::jfnk_solver, which never forms the Jacobian.
+
+namespace dolfinx::nls
+{
+/// @brief Convergence information returned by nls::newton.
+template <std::floating_point U>
+struct NewtonInfo
+{
+  /// Number of Newton iterations
+  int iterations = 0;
+
+  /// Total number of linear solver iterations
+  int linear_iterations = 0;
+
+  /// Norm of the final residual
+  U residual_norm = 0;
+
+  /// True if the convergence criterion was met
+  bool converged = false;
+};
+
+/// @brief Action of the Jacobian of `F` at `x` approximated by a
+/// finite-difference directional derivative.
+///
+/// The action is `J(x) v ≈ (F(x + h v) - F(x)) / h`, with `h =
+/// sqrt(eps) (1 + ||x||) / ||v||`. It is a linear operator for the
+/// la::krylov.h solvers. Each application requires one evaluation of
+/// `F` and one global reduction (for `||v||`).
+///
+/// @tparam V Vector type.
+/// @tparam Fn Residual function type, called as `F(x, r)`.
+template <class V, typename Fn>
+class JacobianFreeOperator
+{
+  using T = typename V::value_type;
+  using U = scalar_value_type_t<T>;
+
+public:
+  /// @brief Create the operator.
+  /// @param[in] F Residual function.
+  /// @param[in] x Point at which the Jacobian is evaluated. It must
+  /// outlive the operator.
+  /// @param[in] Fx Residual at `x`. It must outlive the operator.
+  JacobianFreeOperator(Fn F, const V& x, const V& Fx)
+      : _F(std::move(F)), _x(x), _Fx(Fx), _xnorm(la::norm(x)), _w(x),
+        _Fw(x)
+  {
+  }
+
+  /// @brief Compute `y = J(x) v`.
+  /// @param[in] v Direction. Only the owned entries are used.
+  /// @param[out] y Directional derivative (owned entries).
+  void operator()(const V& v, V& y)
+  {
+    const U vnorm = la::norm(v);
+    if (vnorm == 0)
+    {
+      y.set(0);
+      return;
+    }
+    const U h
+        = std::sqrt(std::numeric_limits<U>::epsilon()) * (1 + _xnorm) / vnorm;
+
+    // w = x + h v
+    std::span<const T> x = _x.array();
+    std::span<const T> _v = v.array();
+    std::span<T> w = _w.mutable_array();
+    la::impl::for_each_index(la::impl::local_size(v), [&](std::size_t i)
+                             { w[i] = x[i] + h * _v[i]; });
+    _w.scatter_fwd();
+
+    // y = (F(w) - F(x)) / h
+    _F(_w, _Fw);
+    std::span<const T> Fw = _Fw.array();
+    std::span<const T> Fx = _Fx.array();
+    std::span<T> _y = y.mutable_array();
+    la::impl::for_each_index(la::impl::local_size(y), [&](std::size_t i)
+                             { _y[i] = (Fw[i] - Fx[i]) / h; });
+  }
+
+private:
+  Fn _F;
+  const V& _x;
+  const V& _Fx;
+  U _xnorm;
+
+  // Work vectors for x + h v and F(x + h v)
+  V _w, _Fw;
+};
+
+/// @brief Create a Jacobian-free Newton-Krylov (JFNK) linear solver
+/// for nls::newton.
+///
+/// The Newton increment is computed by la::gmres with the Jacobian
+/// action approximated by nls::JacobianFreeOperator, so the Jacobian
+/// is never assembled.
+///
+/// @param[in] F Residual function, called as `F(x, r)`.
+/// @param[in] P Preconditioner for GMRES, e.g. built from an
+/// approximate (lagged or simplified) Jacobian.
+/// @param[in] restart GMRES restart.
+/// @param[in] rtol GMRES relative tolerance.
+/// @param[in] max_it Maximum number of GMRES iterations per Newton
+/// iteration.
+/// @return Linear solver callable `solve(x, r, dx)`.
+template <typename Fn, typename Pc = la::IdentityPreconditioner>
+auto jfnk_solver(Fn F, Pc P = Pc(), int restart = 30, double rtol = 1e-4,
+                 int max_it = 1000)
+{
+  return [F = std::move(F), P = std::move(P), restart, rtol,
+          max_it]<class V>(const V& x, const V& r, V& dx) -> int
+  {
+    JacobianFreeOperator<V, Fn> A(F, x, r);
+    return la::gmres(A, r, dx, P, restart, rtol, 0, max_it).iterations;
+  };
+}
+
+/// @brief Solve `F(x) = 0` using Newton's method with an optional
+/// backtracking line search.
+///
+/// The update is `x <- x - lambda dx`, where `J(x) dx = F(x)`. Without
+/// line search `lambda = 1`. With line search, `lambda` is halved
+/// (at most `max_backtracks` times) until the sufficient decrease
+/// condition `||F(x - lambda dx)|| <= (1 - 1e-4 lambda) ||F(x)||` holds.
+///
+/// Convergence is declared when `||F(x)|| <= max(rtol ||F(x_0)||,
+/// atol)`.
+///
+/// @note Collective MPI operation
+/// @param[in] F Residual function, called as `F(x, r)`.
+/// @param[in] solve Linear solver, called as `solve(x, r, dx)`.
+/// @param[in,out] x Initial guess on input, solution on output.
+/// @param[in] rtol Relative tolerance.
+/// @param[in] atol Absolute tolerance.
+/// @param[in] max_it Maximum number of Newton iterations.
+/// @param[in] max_backtracks Maximum number of line search step
+/// reductions per iteration. If `0`, no line search is performed.
+/// @return Convergence information.
+template <class V, typename Fn, typename Solver>
+NewtonInfo<scalar_value_type_t<typename V::value_type>>
+newton(Fn&& F, Solver&& solve, V& x, double rtol = 1e-9, double atol = 1e-10,
+       int max_it = 50, int max_backtracks = 0)
+{
+  using T = typename V::value_type;
+  using U = scalar_value_type_t<T>;
+
+  V r(x), dx(x), x0(x);
+  x.scatter_fwd();
+  F(x, r);
+  U rnorm = la::norm(r);
+  const U tol = std::max<U>(rtol * rnorm, atol);
+
+  NewtonInfo<U> info{0, 0, rnorm, false};
+  if (rnorm <= tol)
+  {
+    info.converged = true;
+    return info;
+  }
+
+  const std::size_t n = la::impl::local_size(x);
+  while (info.iterations < max_it)
+  {
+    dx.set(0);
+    info.linear_iterations += solve(x, r, dx);
+
+    // Update solution, reducing the step if required
+    std::ranges::copy(x.array(), x0.mutable_array().begin());
+    const U rnorm0 = rnorm;
+    U lambda = 1;
+    for (int k = 0;; ++k)
+    {
+      std::span<const T> _x0 = x0.array();
+      std::span<const T> _dx = dx.array();
+      std::span<T> _x = x.mutable_array();
+      la::impl::for_each_index(n, [&](std::size_t i)
+                               { _x[i] = _x0[i] - lambda * _dx[i]; });
+      x.scatter_fwd();
+      F(x, r);
+      rnorm = la::norm(r);
+      if (k >= max_backtracks or rnorm <= (1 - U(1e-4) * lambda) * rnorm0)
+        break;
+      lambda /= 2;
+    }
+
+    ++info.iterations;
+    info.residual_norm = rnorm;
+    if (rnorm <= tol)
+    {
+      info.converged = true;
+      break;
+    }
+  }
+
+  return info;
+}
+} // namespace dolfinx::nls
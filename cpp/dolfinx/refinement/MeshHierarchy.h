@@ -0,0 +1,118 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "option.h"
+#include "refine.h"
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dolfinx::refinement
+{
+/// @brief A sequence of meshes created by successive refinement of a
+/// coarse mesh, e.g. for geometric multigrid.
+///
+/// Level 0 is the coarse mesh and each following level is a refinement
+/// of the previous level. The refined meshes are not re-distributed,
+/// so the parent of each cell is on the same process, and the parent
+/// cell (and parent facet) of each cell is stored. The parent cells
+/// are used to create the transfer operators between Lagrange spaces
+/// on successive levels, see fem::create_prolongation_matrix. The
+/// parent facets can be used to transfer facet tags, see
+/// refinement::transfer_facet_meshtag.
+///
+/// @tparam T Geometry type of the meshes.
+template <std::floating_point T>
+class MeshHierarchy
+{
+public:
+  /// @brief Create a hierarchy with a single (coarse) level.
+  /// @param[in] mesh The coarse mesh.
+  explicit MeshHierarchy(std::shared_ptr<const mesh::Mesh<T>> mesh)
+      : _meshes({mesh})
+  {
+    assert(mesh);
+    if (mesh::CellType cell_type = mesh->topology()->cell_type();
+        !mesh::is_simplex(cell_type)
+        and cell_type != mesh::CellType::quadrilateral
+        and cell_type != mesh::CellType::hexahedron)
+    {
+      throw std::runtime_error("Refinement not defined for this cell type");
+    }
+  }
+
+  /// @brief Add a level by refining the finest mesh.
+  ///
+  /// @note Collective
+  ///
+  /// @param[in] edges Indices of the edges of the finest mesh to split.
+  /// If not provided, uniform refinement is performed. Must not be
+  /// provided for quadrilateral and hexahedral meshes.
+  void refine(std::optional<std::span<const std::int32_t>> edges
+              = std::nullopt)
+  {
+    const mesh::Mesh<T>& mesh0 = *_meshes.back();
+    mesh0.topology_mutable()->create_entities(1);
+    Option option = mesh0.topology()->dim() > 1 ? Option::parent_cell_and_facet
+                                                : Option::parent_cell;
+    auto [mesh1, parent_cell, parent_facet]
+        = refinement::refine(mesh0, edges, nullptr, option);
+    _meshes.push_back(std::make_shared<mesh::Mesh<T>>(std::move(mesh1)));
+    _parent_cells.push_back(std::move(parent_cell.value()));
+    _parent_facets.push_back(parent_facet.value_or(std::vector<std::int8_t>()));
+  }
+
+  /// @brief Number of levels (meshes) in the hierarchy.
+  std::size_t num_levels() const { return _meshes.size(); }
+
+  /// @brief The mesh on a level.
+  /// @param[in] level Level, with 0 the coarsest.
+  std::shared_ptr<const mesh::Mesh<T>> mesh(std::size_t level) const
+  {
+    return _meshes.at(level);
+  }
+
+  /// @brief Parent cell of each cell on a level.
+  /// @param[in] level Level `> 0`.
+  /// @return Cell index (local) on level `level - 1` of the parent of
+  /// each cell on `level`.
+  std::span<const std::int32_t> parent_cells(std::size_t level) const
+  {
+    if (level == 0)
+      throw std::runtime_error("The coarse level has no parent cells.");
+    return _parent_cells.at(level - 1);
+  }
+
+  /// @brief Parent facet of each facet of each cell on a level.
+  /// @param[in] level Level `> 0`.
+  /// @return Local facet index in the parent cell for each local facet
+  /// of each cell on `level` (or -1 if the facet is not on a facet of
+  /// the parent). Empty for interval meshes.
+  std::span<const std::int8_t> parent_facets(std::size_t level) const
+  {
+    if (level == 0)
+      throw std::runtime_error("The coarse level has no parent facets.");
+    return _parent_facets.at(level - 1);
+  }
+
+private:
+  // Meshes, from coarse to fine
+  std::vector<std::shared_ptr<const mesh::Mesh<T>>> _meshes;
+
+  // Parent cells and parent facets of the cells of _meshes[i + 1]
+  std::vector<std::vector<std::int32_t>> _parent_cells;
+  std::vector<std::vector<std::int8_t>> _parent_facets;
+};
+} // namespace dolfinx::refinement
@@ -2,13 +2,16 @@
 
 /// @brief Mesh refinement algorithms.
 ///
-/// Methods for refining meshes uniformly, or with markers, using edge
-/// bisection.
+/// Methods for refining simplex meshes uniformly, or with markers, using
+/// edge bisection, and for refining quadrilateral and hexahedral meshes
+/// uniformly.
 namespace dolfinx::refinement
 {
 }
 
 // DOLFINx refinement interface
 
+#include <dolfinx/refinement/MeshHierarchy.h>
 #include <dolfinx/refinement/interval.h>
 #include <dolfinx/refinement/refine.h>
+#include <dolfinx/refinement/uniform.h>
@@ -198,11 +198,35 @@ void plaza::impl::enforce_rules(MPI_Comm comm,
   assert(map_e);
   auto map_f = topology.index_map(2);
   assert(map_f);
+  const std::int32_t num_edges = map_e->size_local() + map_e->num_ghosts();
   const std::int32_t num_faces = map_f->size_local() + map_f->num_ghosts();
 
   auto f_to_e = topology.connectivity(2, 1);
   assert(f_to_e);
 
+  // Faces connected to each edge
+  std::vector<std::int32_t> e_to_f_offsets(num_edges + 1, 0);
+  for (std::int32_t e : f_to_e->array())
+    ++e_to_f_offsets[e + 1];
+  std::partial_sum(e_to_f_offsets.begin(), e_to_f_offsets.end(),
+                   e_to_f_offsets.begin());
+  std::vector<std::int32_t> e_to_f(e_to_f_offsets.back());
+  {
+    std::vector<std::int32_t> pos(e_to_f_offsets.begin(),
+                                  std::prev(e_to_f_offsets.end()));
+    for (std::int32_t f = 0; f < num_faces; ++f)
+      for (std::int32_t e : f_to_e->links(f))
+        e_to_f[pos[e]++] = f;
+  }
+
+  // Edges that are shared with other processes
+  std::vector<std::int32_t> edges_shared;
+  for (std::int32_t e = 0; e < num_edges; ++e)
+  {
+    if (!shared_edges.links(e).empty())
+      edges_shared.push_back(e);
+  }
+
   // Get number of neighbors
   int indegree(-1), outdegree(-2), weighted(-1);
   MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
@@ -210,41 +234,77 @@ void plaza::impl::enforce_rules(MPI_Comm comm,
   const int num_neighbors = indegree;
   std::vector<std::vector<std::int32_t>> marked_for_update(num_neighbors);
 
-  std::int32_t update_count = 1;
-  while (update_count > 0)
+  // Marked edges whose faces have not yet been visited
+  std::vector<std::int8_t> queued(marked_edges.begin(), marked_edges.end());
+  std::vector<std::int32_t> queue;
+  for (std::int32_t e = 0; e < num_edges; ++e)
   {
-    update_count = 0;
-    update_logical_edgefunction(comm, marked_for_update, marked_edges, *map_e);
-    for (int i = 0; i < num_neighbors; ++i)
-      marked_for_update[i].clear();
+    if (marked_edges[e])
+      queue.push_back(e);
+  }
 
-    for (int f = 0; f < num_faces; ++f)
+  // Each round propagates the markers on the process until no more
+  // edges are marked, and then sends the newly marked shared edges to
+  // the sharing processes. The reduction that detects termination of
+  // round k overlaps with the work and neighbourhood exchange of round
+  // k + 1, so a global synchronisation is not required in each round.
+  // The marked edges are the same as when the rule is applied in
+  // lock-step rounds.
+  MPI_Request request = MPI_REQUEST_NULL;
+  std::int32_t num_sent = 0;
+  std::int32_t num_sent_global = 0;
+  while (true)
+  {
+    while (!queue.empty())
     {
-      const std::int32_t long_e = long_edge[f];
-      if (marked_edges[long_e])
-        continue;
-
-      bool any_marked = false;
-      for (auto edge : f_to_e->links(f))
-        any_marked = any_marked or marked_edges[edge];
-
-      if (any_marked)
+      const std::int32_t edge = queue.back();
+      queue.pop_back();
+      for (std::int32_t i = e_to_f_offsets[edge];
+           i < e_to_f_offsets[edge + 1]; ++i)
       {
+        const std::int32_t long_e = long_edge[e_to_f[i]];
         if (!marked_edges[long_e])
         {
           marked_edges[long_e] = true;
+          queued[long_e] = true;
+          queue.push_back(long_e);
 
           // Add sharing neighbors to update set
           for (int rank : shared_edges.links(long_e))
             marked_for_update[rank].push_back(long_e);
         }
-        ++update_count;
       }
     }
 
-    const std::int32_t update_count_old = update_count;
-    MPI_Allreduce(&update_count_old, &update_count, 1, MPI_INT32_T, MPI_SUM,
-                  comm);
+    std::int32_t count = 0;
+    for (auto& edges : marked_for_update)
+      count += edges.size();
+    update_logical_edgefunction(comm, marked_for_update, marked_edges, *map_e);
+    for (int i = 0; i < num_neighbors; ++i)
+      marked_for_update[i].clear();
+
+    // Edges marked by other processes start the next round
+    for (std::int32_t e : edges_shared)
+    {
+      if (marked_edges[e] and !queued[e])
+      {
+        queued[e] = true;
+        queue.push_back(e);
+      }
+    }
+
+    // Stop if no process sent markers in the previous round. All
+    // processes then have no new markers to send in this round.
+    if (request != MPI_REQUEST_NULL)
+    {
+      MPI_Wait(&request, MPI_STATUS_IGNORE);
+      if (num_sent_global == 0)
+        break;
+    }
+
+    num_sent = count;
+    MPI_Iallreduce(&num_sent, &num_sent_global, 1, MPI_INT32_T, MPI_SUM, comm,
+                   &request);
   }
 }
 //-----------------------------------------------------------------------------
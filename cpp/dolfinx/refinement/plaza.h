@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include "dolfinx/common/ThreadPool.h"
 #include "dolfinx/graph/AdjacencyList.h"
 #include "dolfinx/mesh/Mesh.h"
 #include "dolfinx/mesh/Topology.h"
@@ -11,6 +12,7 @@
 #include "option.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <optional>
@@ -168,6 +170,7 @@ face_long_edge(const mesh::Mesh<T>& mesh)
     edge_ratio_ok.resize(num_faces);
 
   auto x_dofmap = mesh.geometry().dofmap();
+  mesh::NodeCoordinates<T> x = mesh.geometry().coordinates();
 
   auto c_to_v = mesh.topology()->connectivity(tdim, 0);
   assert(c_to_v);
@@ -200,10 +203,12 @@ face_long_edge(const mesh::Mesh<T>& mesh)
 
     auto x_dofs = MDSPAN_IMPL_STANDARD_NAMESPACE::submdspan(
         x_dofmap, cells.front(), MDSPAN_IMPL_STANDARD_NAMESPACE::full_extent);
-    std::span<const T, 3> x0(mesh.geometry().x().data() + 3 * x_dofs[local0],
-                             3);
-    std::span<const T, 3> x1(mesh.geometry().x().data() + 3 * x_dofs[local1],
-                             3);
+    std::array<T, 3> x0, x1;
+    for (int j = 0; j < 3; ++j)
+    {
+      x0[j] = x(x_dofs[local0], j);
+      x1[j] = x(x_dofs[local1], j);
+    }
 
     // Compute length of edge between vertex x0 and x1
     edge_length[e] = std::sqrt(std::transform_reduce(
@@ -279,6 +284,7 @@ face_long_edge(const mesh::Mesh<T>& mesh)
 /// than sqrt(2)/2
 /// @param[in] option Option to compute additional information relating refined
 /// and original mesh entities
+/// @param[in] num_threads Number of threads used to subdivide the cells
 /// @return (0) The new mesh topology, (1) the new flattened mesh geometry, (3)
 /// Shape of the new geometry_shape, (4) Map from new cells to parent cells
 /// and (5) map from refined facets to parent facets.
@@ -291,7 +297,8 @@ compute_refinement(MPI_Comm neighbor_comm,
                    const graph::AdjacencyList<int>& shared_edges,
                    const mesh::Mesh<T>& mesh,
                    std::span<const std::int32_t> long_edge,
-                   std::span<const std::int8_t> edge_ratio_ok, Option option)
+                   std::span<const std::int8_t> edge_ratio_ok, Option option,
+                   int num_threads = 1)
 {
   int tdim = mesh.topology()->dim();
   int num_cell_edges = tdim * 3 - 3;
@@ -304,17 +311,6 @@ compute_refinement(MPI_Comm neighbor_comm,
   const auto [new_vertex_map, new_vertex_coords, xshape]
       = create_new_vertices(neighbor_comm, shared_edges, mesh, marked_edges);
 
-  std::optional<std::vector<std::int32_t>> parent_cell(std::nullopt);
-  if (compute_parent_cell)
-    parent_cell.emplace();
-
-  std::optional<std::vector<std::int8_t>> parent_facet(std::nullopt);
-  if (compute_facets)
-    parent_facet.emplace();
-
-  std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
-  std::vector<std::int32_t> simplex_set;
-
   auto map_c = mesh.topology()->index_map(tdim);
   assert(map_c);
   auto c_to_v = mesh.topology()->connectivity(tdim, 0);
@@ -333,107 +329,157 @@ compute_refinement(MPI_Comm neighbor_comm,
 
   const std::int32_t num_cells = map_c->size_local();
 
-  // Iterate over all cells, and refine if cell has a marked edge
-  std::vector<std::int64_t> cell_topology;
-  for (int c = 0; c < num_cells; ++c)
+  // Refine the cells [c0, c1) and append the vertices, parent cell and
+  // parent facets of the new cells. The subdivision of a cell depends
+  // only on the marked edges, so blocks of cells can be refined
+  // concurrently.
+  auto refine_cells = [&](std::int32_t c0, std::int32_t c1,
+                          std::vector<std::int64_t>& cell_topology,
+                          std::vector<std::int32_t>& parent_cell,
+                          std::vector<std::int8_t>& parent_facet)
   {
-    // Create vector of indices in the order [vertices][edges], 3+3 in
-    // 2D, 4+6 in 3D
-
-    // Copy vertices
-    auto vertices = c_to_v->links(c);
-    for (std::size_t v = 0; v < vertices.size(); ++v)
-      indices[v] = global_indices[vertices[v]];
-
-    // Get cell-local indices of marked edges
-    auto edges = c_to_e->links(c);
-    bool no_edge_marked = true;
-    for (std::size_t ei = 0; ei < edges.size(); ++ei)
+    std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
+    std::vector<std::int32_t> longest_edge;
+    for (std::int32_t c = c0; c < c1; ++c)
     {
-      if (marked_edges[edges[ei]])
+      // Create vector of indices in the order [vertices][edges], 3+3 in
+      // 2D, 4+6 in 3D
+
+      // Copy vertices
+      auto vertices = c_to_v->links(c);
+      for (std::size_t v = 0; v < vertices.size(); ++v)
+        indices[v] = global_indices[vertices[v]];
+
+      // Get cell-local indices of marked edges
+      auto edges = c_to_e->links(c);
+      bool no_edge_marked = true;
+      for (std::size_t ei = 0; ei < edges.size(); ++ei)
       {
-        no_edge_marked = false;
-        auto it = new_vertex_map.find(edges[ei]);
-        assert(it != new_vertex_map.end());
-        indices[num_cell_vertices + ei] = it->second;
+        if (marked_edges[edges[ei]])
+        {
+          no_edge_marked = false;
+          auto it = new_vertex_map.find(edges[ei]);
+          assert(it != new_vertex_map.end());
+          indices[num_cell_vertices + ei] = it->second;
+        }
+        else
+          indices[num_cell_vertices + ei] = -1;
       }
-      else
-        indices[num_cell_vertices + ei] = -1;
-    }
 
-    if (no_edge_marked)
-    {
-      // Copy over existing cell to new topology
-      for (auto v : vertices)
-        cell_topology.push_back(global_indices[v]);
+      if (no_edge_marked)
+      {
+        // Copy over existing cell to new topology
+        for (auto v : vertices)
+          cell_topology.push_back(global_indices[v]);
 
-      if (compute_parent_cell)
-        parent_cell->push_back(c);
+        if (compute_parent_cell)
+          parent_cell.push_back(c);
 
-      if (compute_facets)
-      {
-        if (tdim == 3)
-          parent_facet->insert(parent_facet->end(), {0, 1, 2, 3});
-        else
-          parent_facet->insert(parent_facet->end(), {0, 1, 2});
+        if (compute_facets)
+        {
+          if (tdim == 3)
+            parent_facet.insert(parent_facet.end(), {0, 1, 2, 3});
+          else
+            parent_facet.insert(parent_facet.end(), {0, 1, 2});
+        }
       }
-    }
-    else
-    {
-      // Need longest edges of each face in cell local indexing. NB in
-      // 2D the face is the cell itself, and there is just one entry.
-      std::vector<std::int32_t> longest_edge;
-      for (auto f : c_to_f->links(c))
-        longest_edge.push_back(long_edge[f]);
-
-      // Convert to cell local index
-      for (std::int32_t& p : longest_edge)
+      else
       {
-        for (std::size_t ej = 0; ej < edges.size(); ++ej)
+        // Need longest edges of each face in cell local indexing. NB in
+        // 2D the face is the cell itself, and there is just one entry.
+        longest_edge.clear();
+        for (auto f : c_to_f->links(c))
+          longest_edge.push_back(long_edge[f]);
+
+        // Convert to cell local index
+        for (std::int32_t& p : longest_edge)
         {
-          if (p == edges[ej])
+          for (std::size_t ej = 0; ej < edges.size(); ++ej)
           {
-            p = ej;
-            break;
+            if (p == edges[ej])
+            {
+              p = ej;
+              break;
+            }
           }
         }
-      }
 
-      const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
-      const auto [simplex_set_b, simplex_set_size]
-          = get_simplices(indices, longest_edge, tdim, uniform);
-      std::span<const std::int32_t> simplex_set(simplex_set_b.data(),
-                                                simplex_set_size);
+        const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
+        const auto [simplex_set_b, simplex_set_size]
+            = get_simplices(indices, longest_edge, tdim, uniform);
+        std::span<const std::int32_t> simplex_set(simplex_set_b.data(),
+                                                  simplex_set_size);
 
-      // Save parent index
-      const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
-      if (compute_parent_cell)
-      {
-        for (std::int32_t i = 0; i < ncells; ++i)
-          parent_cell->push_back(c);
-      }
+        // Save parent index
+        const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
+        if (compute_parent_cell)
+          parent_cell.insert(parent_cell.end(), ncells, c);
 
-      if (compute_facets)
-      {
-        if (tdim == 3)
+        if (compute_facets)
         {
-          auto npf = compute_parent_facets<3>(simplex_set);
-          parent_facet->insert(parent_facet->end(), npf.begin(),
-                               std::next(npf.begin(), simplex_set.size()));
-        }
-        else
-        {
-          auto npf = compute_parent_facets<2>(simplex_set);
-          parent_facet->insert(parent_facet->end(), npf.begin(),
-                               std::next(npf.begin(), simplex_set.size()));
+          if (tdim == 3)
+          {
+            auto npf = compute_parent_facets<3>(simplex_set);
+            parent_facet.insert(parent_facet.end(), npf.begin(),
+                                std::next(npf.begin(), simplex_set.size()));
+          }
+          else
+          {
+            auto npf = compute_parent_facets<2>(simplex_set);
+            parent_facet.insert(parent_facet.end(), npf.begin(),
+                                std::next(npf.begin(), simplex_set.size()));
+          }
         }
-      }
 
-      // Convert from cell local index to mesh index and add to cells
-      for (std::int32_t v : simplex_set)
-        cell_topology.push_back(indices[v]);
+        // Convert from cell local index to mesh index and add to cells
+        for (std::int32_t v : simplex_set)
+          cell_topology.push_back(indices[v]);
+      }
     }
-  }
+  };
+
+  // Refine contiguous blocks of cells on each thread, and concatenate
+  // the blocks in cell order
+  num_threads = std::max(1, std::min(num_threads, num_cells));
+  std::vector<std::vector<std::int64_t>> cell_topology_t(num_threads);
+  std::vector<std::vector<std::int32_t>> parent_cell_t(num_threads);
+  std::vector<std::vector<std::int8_t>> parent_facet_t(num_threads);
+  auto refine_block = [&](int t)
+  {
+    auto [c0, c1] = dolfinx::MPI::local_range(t, num_cells, num_threads);
+    refine_cells(c0, c1, cell_topology_t[t], parent_cell_t[t],
+                 parent_facet_t[t]);
+  };
+  if (num_threads == 1)
+    refine_block(0);
+  else
+    common::thread_pool().run(num_threads, refine_block);
+
+  auto concatenate = [num_threads]<typename X>(std::vector<std::vector<X>>& v)
+  {
+    if (num_threads == 1)
+      return std::move(v.front());
+
+    std::vector<std::size_t> offsets(num_threads + 1, 0);
+    for (int t = 0; t < num_threads; ++t)
+      offsets[t + 1] = offsets[t] + v[t].size();
+    std::vector<X> w(offsets.back());
+    auto copy_block = [&](int t)
+    {
+      std::ranges::copy(v[t], std::next(w.begin(), offsets[t]));
+      std::vector<X>().swap(v[t]);
+    };
+    common::thread_pool().run(num_threads, copy_block);
+    return w;
+  };
+
+  std::vector<std::int64_t> cell_topology = concatenate(cell_topology_t);
+  std::optional<std::vector<std::int32_t>> parent_cell(std::nullopt);
+  if (compute_parent_cell)
+    parent_cell = concatenate(parent_cell_t);
+  std::optional<std::vector<std::int8_t>> parent_facet(std::nullopt);
+  if (compute_facets)
+    parent_facet = concatenate(parent_facet_t);
 
   assert(cell_topology.size() % num_cell_vertices == 0);
   std::vector<std::int32_t> offsets(
@@ -454,6 +500,8 @@ compute_refinement(MPI_Comm neighbor_comm,
 /// refinement
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is unselected, an empty list is returned.
+/// @param[in] num_threads Number of threads used to subdivide the
+/// cells. The new cells are the same for any number of threads.
 /// @return New mesh data: cell topology, vertex coordinates and parent
 /// cell index, and stored parent facet indices (if requested).
 template <std::floating_point T>
@@ -462,7 +510,7 @@ std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
            std::optional<std::vector<std::int8_t>>>
 compute_refinement_data(const mesh::Mesh<T>& mesh,
                         std::optional<std::span<const std::int32_t>> edges,
-                        Option option)
+                        Option option, int num_threads = 1)
 {
   common::Timer t0("PLAZA: refine");
   auto topology = mesh.topology();
@@ -532,7 +580,8 @@ compute_refinement_data(const mesh::Mesh<T>& mesh,
 
   auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
       = impl::compute_refinement(comm, marked_edges, edge_ranks, mesh,
-                                 long_edge, edge_ratio_ok, option);
+                                 long_edge, edge_ratio_ok, option,
+                                 num_threads);
   MPI_Comm_free(&comm);
 
   return {std::move(cell_adj), std::move(new_vertex_coords), xshape,
@@ -13,8 +13,11 @@
 #include "dolfinx/mesh/utils.h"
 #include "interval.h"
 #include "plaza.h"
+#include "uniform.h"
+#include "utils.h"
 #include <algorithm>
 #include <concepts>
+#include <mpi.h>
 #include <optional>
 #include <spdlog/spdlog.h>
 #include <utility>
@@ -27,6 +30,11 @@ namespace dolfinx::refinement
 /// Passing `nullptr` for `partitioner`, refined cells will be on the
 /// same process as the parent cell.
 ///
+/// Simplex meshes are refined by edge bisection. Quadrilateral and
+/// hexahedral meshes can only be refined uniformly (see
+/// uniform::compute_refinement_data), with each cell split into `2^tdim`
+/// cells.
+///
 /// Parent-child relationships can be optionally computed. Parent-child
 /// relationships can be used to create MeshTags on the refined mesh
 /// from MeshTags on the parent mesh.
@@ -40,15 +48,27 @@ namespace dolfinx::refinement
 /// possibility to not re-partition the refined mesh and include ghost
 /// cells in the refined mesh will be added in a future release.
 ///
+/// Passing `nullptr` for `partitioner` with a parent mesh that has no
+/// ghost cells and an affine geometry, the refined topology and
+/// geometry are built directly from the refinement data (see
+/// impl::create_refined_mesh) rather than by mesh::create_mesh. The
+/// refined cells are then not re-ordered, but children of a parent
+/// cell are numbered contiguously and follow the parent cell
+/// ordering.
+///
 /// @param[in] mesh Input mesh to be refined.
 /// @param[in] edges Indices of the edges that should be split in the
 /// refinement. If not provided (`std::nullopt`), uniform refinement is
-/// performed.
+/// performed. Must be `std::nullopt` for quadrilateral and hexahedral
+/// meshes.
 /// @param[in] partitioner Partitioner to be used to distribute the
 /// refined mesh. If not callable, refined cells will be on the same
 /// process as the parent cell.
 /// @param[in] option Control the computation of parent facets, parent
 /// cells. If an option is not selected, an empty list is returned.
+/// @param[in] num_threads Number of threads used to subdivide the cells
+/// of triangle and tetrahedral meshes, see
+/// plaza::compute_refinement_data.
 /// @return New mesh, and optional parent cell indices and parent facet
 /// indices.
 template <std::floating_point T>
@@ -58,24 +78,50 @@ refine(const mesh::Mesh<T>& mesh,
        std::optional<std::span<const std::int32_t>> edges,
        const mesh::CellPartitionFunction& partitioner
        = mesh::create_cell_partitioner(mesh::GhostMode::none),
-       Option option = Option::none)
+       Option option = Option::none, int num_threads = 1)
 {
   auto topology = mesh.topology();
   assert(topology);
-  if (!mesh::is_simplex(topology->cell_type()))
-    throw std::runtime_error("Refinement only defined for simplices");
+  const mesh::CellType cell_type = topology->cell_type();
+  if (cell_type == mesh::CellType::quadrilateral
+      or cell_type == mesh::CellType::hexahedron)
+  {
+    if (edges)
+    {
+      throw std::runtime_error("Refinement with markers only defined for "
+                               "simplices");
+    }
+  }
+  else if (!mesh::is_simplex(cell_type))
+    throw std::runtime_error("Refinement not defined for this cell type");
 
   auto [cell_adj, new_vertex_coords, xshape, parent_cell, parent_facet]
-      = (topology->cell_type() == mesh::CellType::interval)
+      = (cell_type == mesh::CellType::interval)
             ? interval::compute_refinement_data(mesh, edges, option)
-            : plaza::compute_refinement_data(mesh, edges, option);
+        : mesh::is_simplex(cell_type)
+            ? plaza::compute_refinement_data(mesh, edges, option, num_threads)
+            : uniform::compute_refinement_data(mesh, option);
 
-  mesh::Mesh<T> mesh1 = mesh::create_mesh(
-      mesh.comm(), mesh.comm(), cell_adj.array(), mesh.geometry().cmap(),
-      mesh.comm(), new_vertex_coords, xshape, partitioner);
+  // Without re-distribution, the refined mesh can be built directly
+  // from the refinement data if the parent mesh is not ghosted
+  const int D = topology->dim();
+  bool local_update = !partitioner and mesh.geometry().cmap().degree() == 1;
+  if (local_update)
+  {
+    int ghosted = topology->index_map(D)->num_ghosts() > 0;
+    MPI_Allreduce(MPI_IN_PLACE, &ghosted, 1, MPI_INT, MPI_LOR, mesh.comm());
+    local_update = !ghosted;
+  }
+
+  mesh::Mesh<T> mesh1
+      = local_update
+            ? impl::create_refined_mesh<T>(mesh, cell_adj.array(),
+                                           new_vertex_coords, xshape)
+            : mesh::create_mesh(mesh.comm(), mesh.comm(), cell_adj.array(),
+                                mesh.geometry().cmap(), mesh.comm(),
+                                new_vertex_coords, xshape, partitioner);
 
   // Report the number of refined cells
-  const int D = topology->dim();
   const std::int64_t n0 = topology->index_map(D)->size_global();
   const std::int64_t n1 = mesh1.topology()->index_map(D)->size_global();
   spdlog::info(
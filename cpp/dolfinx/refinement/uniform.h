@@ -0,0 +1,323 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "option.h"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <dolfinx/mesh/utils.h>
+#include <mpi.h>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// @brief Uniform refinement of quadrilateral and hexahedral meshes.
+///
+/// Each cell is split into `2^tdim` cells by inserting a vertex at the
+/// midpoint of each edge, face and cell. The new vertices depend only on
+/// the parent entities, so the refined mesh is conforming and no
+/// communication of refinement markers is required.
+namespace dolfinx::refinement::uniform
+{
+namespace impl
+{
+/// @brief Sub-entity of the reference cell that each point of the
+/// `3^tdim` lattice of refined vertices lies on.
+///
+/// Lattice point `(i, j, k)`, with `i, j, k` in `{0, 1, 2}`, has index
+/// `i + 3j + 9k` and is the point `(i/2, j/2, k/2)` on the reference
+/// cell. The reference vertices are in tensor-product order, i.e.
+/// vertex `v` is the point whose coordinate on axis `a` is bit `a` of
+/// `v`.
+///
+/// @param[in] cell_type Cell type (quadrilateral or hexahedron).
+/// @return (dim, local index) of the reference sub-entity whose
+/// midpoint is each lattice point.
+inline std::vector<std::array<int, 2>>
+lattice_entities(mesh::CellType cell_type)
+{
+  const int tdim = mesh::cell_dim(cell_type);
+  const int num_vertices = mesh::num_cell_vertices(cell_type);
+  const int num_points = tdim == 2 ? 9 : 27;
+
+  std::vector<std::array<int, 2>> entities(num_points);
+  for (int p = 0; p < num_points; ++p)
+  {
+    std::array<int, 3> ijk = {p % 3, (p / 3) % 3, p / 9};
+    const int dim = std::count(ijk.begin(), std::next(ijk.begin(), tdim), 1);
+
+    // Reference vertices of the entity
+    std::vector<int> vertices;
+    for (int v = 0; v < num_vertices; ++v)
+    {
+      bool on_entity = true;
+      for (int a = 0; a < tdim; ++a)
+      {
+        if (ijk[a] != 1 and ((v >> a) & 1) != ijk[a] / 2)
+          on_entity = false;
+      }
+      if (on_entity)
+        vertices.push_back(v);
+    }
+
+    if (dim == 0)
+      entities[p] = {0, vertices.front()};
+    else if (dim == tdim)
+      entities[p] = {tdim, 0};
+    else
+    {
+      const graph::AdjacencyList<int> e_to_v
+          = mesh::get_entity_vertices(cell_type, dim);
+      for (int e = 0; e < e_to_v.num_nodes(); ++e)
+      {
+        auto ev = e_to_v.links(e);
+        if (std::ranges::equal(ev, vertices))
+          entities[p] = {dim, e};
+      }
+    }
+  }
+
+  return entities;
+}
+} // namespace impl
+
+/// @brief Uniformly refine a quadrilateral or hexahedral mesh,
+/// returning new mesh data.
+///
+/// The refined vertices owned by a process are the owned vertices of
+/// the parent mesh followed by a vertex at the midpoint of each owned
+/// edge, face (hexahedra) and cell, and the refined cells owned by a
+/// process are the children of its cells. The global index of a new
+/// vertex is computed from the owner of the parent entity, so no
+/// neighbourhood communication is needed. The children of a cell are
+/// numbered in tensor-product order.
+///
+/// @pre The mesh has no ghost cells and a degree 1 geometry.
+///
+/// @note Collective
+///
+/// @param[in] mesh Input mesh to be refined.
+/// @param[in] option Refinement option indicating if parent cells
+/// and/or facets are to be computed.
+/// @return New mesh data: cell topology, vertex coordinates (and its
+/// shape), and optional parent cell indices and parent facet indices.
+template <std::floating_point T>
+std::tuple<graph::AdjacencyList<std::int64_t>, std::vector<T>,
+           std::array<std::size_t, 2>, std::optional<std::vector<std::int32_t>>,
+           std::optional<std::vector<std::int8_t>>>
+compute_refinement_data(const mesh::Mesh<T>& mesh, Option option)
+{
+  common::Timer t0("Refinement: uniform refinement");
+
+  auto topology = mesh.topology();
+  assert(topology);
+  const mesh::CellType cell_type = topology->cell_type();
+  if (cell_type != mesh::CellType::quadrilateral
+      and cell_type != mesh::CellType::hexahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  const int tdim = topology->dim();
+  {
+    int unsupported = topology->index_map(tdim)->num_ghosts() > 0
+                      or mesh.geometry().cmap().degree() != 1;
+    MPI_Allreduce(MPI_IN_PLACE, &unsupported, 1, MPI_INT, MPI_LOR,
+                  mesh.comm());
+    if (unsupported)
+    {
+      throw std::runtime_error("Uniform refinement of quadrilateral and "
+                               "hexahedral meshes requires a mesh without "
+                               "ghost cells and a degree 1 geometry");
+    }
+  }
+
+  for (int d = 1; d < tdim; ++d)
+  {
+    mesh.topology_mutable()->create_entities(d);
+    mesh.topology_mutable()->create_connectivity(tdim, d);
+  }
+
+  // Number of owned entities and the start of the owned range for
+  // each dimension on each process. The owned refined vertices of a
+  // process are numbered by parent entity dimension, then by index.
+  const int size = dolfinx::MPI::size(mesh.comm());
+  const int rank = dolfinx::MPI::rank(mesh.comm());
+  std::vector<std::int64_t> ranges(2 * (tdim + 1) * size);
+  {
+    std::vector<std::int64_t> local(2 * (tdim + 1));
+    for (int d = 0; d <= tdim; ++d)
+    {
+      local[d] = topology->index_map(d)->size_local();
+      local[tdim + 1 + d] = topology->index_map(d)->local_range()[0];
+    }
+    MPI_Allgather(local.data(), local.size(), MPI_INT64_T, ranges.data(),
+                  local.size(), MPI_INT64_T, mesh.comm());
+  }
+
+  // Offset of the new vertices for the entities of each dimension on
+  // each process
+  std::vector<std::int64_t> offsets(size * (tdim + 1));
+  {
+    std::int64_t offset = 0;
+    for (int r = 0; r < size; ++r)
+    {
+      for (int d = 0; d <= tdim; ++d)
+      {
+        offsets[r * (tdim + 1) + d] = offset;
+        offset += ranges[2 * (tdim + 1) * r + d];
+      }
+    }
+  }
+
+  // Global index of the refined vertex on (local) entity e of
+  // dimension d
+  std::vector<std::span<const int>> owners(tdim + 1);
+  std::vector<std::span<const std::int64_t>> ghosts(tdim + 1);
+  for (int d = 0; d <= tdim; ++d)
+  {
+    owners[d] = topology->index_map(d)->owners();
+    ghosts[d] = topology->index_map(d)->ghosts();
+  }
+  auto vertex_index = [&](int d, std::int32_t e) -> std::int64_t
+  {
+    const std::int32_t num_owned = topology->index_map(d)->size_local();
+    if (e < num_owned)
+      return offsets[rank * (tdim + 1) + d] + e;
+    else
+    {
+      const int r = owners[d][e - num_owned];
+      const std::int64_t start = ranges[2 * (tdim + 1) * r + tdim + 1 + d];
+      return offsets[r * (tdim + 1) + d] + ghosts[d][e - num_owned] - start;
+    }
+  };
+
+  // Coordinates of the owned refined vertices, i.e. the midpoints of
+  // the owned entities of each dimension
+  const std::size_t gdim = mesh.geometry().dim();
+  std::array<std::size_t, 2> xshape = {0, gdim};
+  for (int d = 0; d <= tdim; ++d)
+    xshape[0] += topology->index_map(d)->size_local();
+  std::vector<T> new_vertex_coords(xshape[0] * xshape[1]);
+  {
+    auto it = new_vertex_coords.begin();
+    for (int d = 0; d <= tdim; ++d)
+    {
+      std::vector<std::int32_t> entities(topology->index_map(d)->size_local());
+      std::iota(entities.begin(), entities.end(), 0);
+      const std::vector<T> x = mesh::compute_midpoints(mesh, d, entities);
+      for (std::size_t e = 0; e < entities.size(); ++e)
+        it = std::copy_n(std::next(x.begin(), 3 * e), gdim, it);
+    }
+  }
+
+  // Refined cells
+  const std::vector<std::array<int, 2>> lattice
+      = impl::lattice_entities(cell_type);
+  const int num_children = 1 << tdim;
+  const int num_cell_vertices = mesh::num_cell_vertices(cell_type);
+  const std::int32_t num_cells = topology->index_map(tdim)->size_local();
+
+  std::vector<std::shared_ptr<const graph::AdjacencyList<std::int32_t>>>
+      c_to_e(tdim);
+  for (int d = 0; d < tdim; ++d)
+  {
+    c_to_e[d] = topology->connectivity(tdim, d);
+    assert(c_to_e[d]);
+  }
+
+  std::vector<std::int64_t> cell_topology(num_cells * num_children
+                                          * num_cell_vertices);
+  std::vector<std::int64_t> lattice_vertices(lattice.size());
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (std::size_t p = 0; p < lattice.size(); ++p)
+    {
+      auto [d, e] = lattice[p];
+      lattice_vertices[p] = d == tdim ? vertex_index(tdim, c)
+                                      : vertex_index(d, c_to_e[d]->links(c)[e]);
+    }
+
+    // Child (a, b, c) has the lattice points (a, b, c) + v, with v a
+    // vertex of the reference cell
+    for (int child = 0; child < num_children; ++child)
+    {
+      std::int64_t* vertices = cell_topology.data()
+                               + (c * num_children + child) * num_cell_vertices;
+      for (int v = 0; v < num_cell_vertices; ++v)
+      {
+        int p = 0;
+        for (int a = 0, stride = 1; a < tdim; ++a, stride *= 3)
+          p += stride * (((child >> a) & 1) + ((v >> a) & 1));
+        vertices[v] = lattice_vertices[p];
+      }
+    }
+  }
+
+  std::optional<std::vector<std::int32_t>> parent_cell;
+  if (option_parent_cell(option))
+  {
+    parent_cell.emplace(num_cells * num_children);
+    for (std::size_t i = 0; i < parent_cell->size(); ++i)
+      (*parent_cell)[i] = i / num_children;
+  }
+
+  // A child facet is on the parent facet with the same local index if
+  // the child is on the same side of the parent cell as the facet
+  std::optional<std::vector<std::int8_t>> parent_facet;
+  if (option_parent_facet(option))
+  {
+    const graph::AdjacencyList<int> f_to_v
+        = mesh::get_entity_vertices(cell_type, tdim - 1);
+    const int num_facets = f_to_v.num_nodes();
+    std::vector<std::int8_t> child_facets(num_children * num_facets, -1);
+    for (int child = 0; child < num_children; ++child)
+    {
+      for (int f = 0; f < num_facets; ++f)
+      {
+        auto fv = f_to_v.links(f);
+        for (int a = 0; a < tdim; ++a)
+        {
+          const int side = (fv.front() >> a) & 1;
+          if (std::ranges::all_of(fv, [a, side](auto v)
+                                  { return ((v >> a) & 1) == side; })
+              and ((child >> a) & 1) == side)
+          {
+            child_facets[child * num_facets + f] = f;
+          }
+        }
+      }
+    }
+
+    parent_facet.emplace();
+    parent_facet->reserve(num_cells * child_facets.size());
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      parent_facet->insert(parent_facet->end(), child_facets.begin(),
+                           child_facets.end());
+    }
+  }
+
+  return {graph::regular_adjacency_list(std::move(cell_topology),
+                                        num_cell_vertices),
+          std::move(new_vertex_coords), xshape, std::move(parent_cell),
+          std::move(parent_facet)};
+}
+} // namespace dolfinx::refinement::uniform
@@ -8,15 +8,16 @@
 #include <algorithm>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
-#include <dolfinx/common/sort.h>
 #include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/graphbuild.h>
 #include <dolfinx/mesh/topologycomputation.h>
 #include <dolfinx/mesh/utils.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mpi.h>
@@ -150,124 +151,139 @@ refinement::adjust_indices(const common::IndexMap& map, std::int32_t n)
   return global_indices;
 }
 //-----------------------------------------------------------------------------
-std::array<std::vector<std::int32_t>, 2> refinement::transfer_facet_meshtag(
-    const mesh::MeshTags<std::int32_t>& tags0, const mesh::Topology& topology1,
-    std::span<const std::int32_t> cell, std::span<const std::int8_t> facet)
+std::vector<std::array<std::vector<std::int32_t>, 2>>
+refinement::transfer_meshtags(
+    const std::vector<
+        std::reference_wrapper<const mesh::MeshTags<std::int32_t>>>& tags0,
+    const mesh::Topology& topology1, std::span<const std::int32_t> parent_cell,
+    std::span<const std::int8_t> parent_facet)
 {
-  auto topology = tags0.topology();
-  assert(topology);
-  auto values = tags0.values();
-  auto indices = tags0.indices();
+  if (tags0.empty())
+    return {};
 
-  int tdim = topology->dim();
-  if (topology->index_map(tdim)->num_ghosts() > 0)
+  auto topology0 = tags0.front().get().topology();
+  assert(topology0);
+  const int tdim = topology0->dim();
+  if (topology0->index_map(tdim)->num_ghosts() > 0)
     throw std::runtime_error("Ghosted meshes are not supported");
 
-  auto c_to_f = topology->connectivity(tdim, tdim - 1);
-  if (!c_to_f)
-    throw std::runtime_error("Parent mesh is missing cell-facet connectivity.");
+  bool facet_tags = false;
+  for (auto& tags : tags0)
+  {
+    if (tags.get().topology() != topology0)
+    {
+      throw std::runtime_error(
+          "Mesh tags must be defined on the same topology.");
+    }
 
-  // Create map parent->child facets
-  const std::int32_t num_input_facets
-      = topology->index_map(tdim - 1)->size_local()
-        + topology->index_map(tdim - 1)->num_ghosts();
+    if (int dim = tags.get().dim(); dim == tdim - 1)
+      facet_tags = true;
+    else if (dim != tdim)
+      throw std::runtime_error("Only cell and facet tags can be transferred.");
+  }
 
   // Get global index for each refined cell, before reordering in Mesh
   // construction
   const std::vector<std::int64_t>& original_cell_index
       = topology1.original_cell_index[0];
-  assert(original_cell_index.size() == cell.size());
+  assert(original_cell_index.size() == parent_cell.size());
   std::int64_t global_offset = topology1.index_map(tdim)->local_range()[0];
 
-  // Map cells back to original index
+  // Map cells back to original index, and compute the parent of each
+  // refined cell
   std::vector<std::int32_t> local_cell_index(original_cell_index.size());
+  std::vector<std::int32_t> cell_parent(original_cell_index.size());
   for (std::size_t i = 0; i < local_cell_index.size(); ++i)
   {
     assert(original_cell_index[i] >= global_offset);
     assert(original_cell_index[i] - global_offset
            < (int)local_cell_index.size());
     local_cell_index[original_cell_index[i] - global_offset] = i;
+    cell_parent[i] = parent_cell[original_cell_index[i] - global_offset];
   }
 
-  // Count number of child facets for each parent facet
-  std::vector<int> count_child(num_input_facets, 0);
-  for (std::size_t c = 0; c < cell.size(); ++c)
+  // Compute the parent facet of each refined facet (-1 if the facet is
+  // not on a facet of the parent cell)
+  std::vector<std::int32_t> facet_parent;
+  if (facet_tags)
   {
-    auto facets = c_to_f->links(cell[c]);
-    for (int j = 0; j <= tdim; ++j)
+    auto c_to_f = topology0->connectivity(tdim, tdim - 1);
+    if (!c_to_f)
     {
-      if (std::int8_t fidx = facet[c * (tdim + 1) + j]; fidx != -1)
-        ++count_child[facets[fidx]];
+      throw std::runtime_error(
+          "Parent mesh is missing cell-facet connectivity.");
     }
-  }
-
-  auto c_to_f_refined = topology1.connectivity(tdim, tdim - 1);
-  if (!c_to_f_refined)
-  {
-    throw std::runtime_error(
-        "Refined mesh is missing cell-facet connectivity.");
-  }
 
-  // Fill in data for each child facet
-  std::vector<int> offset_child(num_input_facets + 1, 0);
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  std::vector<std::int32_t> child_facet(offset_child.back());
-  for (std::size_t c = 0; c < cell.size(); ++c)
-  {
-    auto facets = c_to_f->links(cell[c]);
-
-    // Use original indexing for child cell
-    auto refined_facets = c_to_f_refined->links(local_cell_index[c]);
+    auto c_to_f_refined = topology1.connectivity(tdim, tdim - 1);
+    if (!c_to_f_refined)
+    {
+      throw std::runtime_error(
+          "Refined mesh is missing cell-facet connectivity.");
+    }
 
-    // Get child facets for each cell
-    for (int j = 0; j <= tdim; ++j)
+    auto facet_map1 = topology1.index_map(tdim - 1);
+    assert(facet_map1);
+    facet_parent.resize(facet_map1->size_local() + facet_map1->num_ghosts(),
+                        -1);
+    const int num_facets
+        = mesh::cell_num_entities(topology0->cell_type(), tdim - 1);
+    assert(parent_facet.size() == parent_cell.size() * num_facets);
+    for (std::size_t c = 0; c < parent_cell.size(); ++c)
     {
-      if (std::int8_t fidx = facet[c * (tdim + 1) + j]; fidx != -1)
+      auto facets = c_to_f->links(parent_cell[c]);
+      auto refined_facets = c_to_f_refined->links(local_cell_index[c]);
+      for (int j = 0; j < num_facets; ++j)
       {
-        int offset = offset_child[facets[fidx]];
-        child_facet[offset] = refined_facets[j];
-        ++offset_child[facets[fidx]];
+        if (std::int8_t fidx = parent_facet[c * num_facets + j]; fidx != -1)
+          facet_parent[refined_facets[j]] = facets[fidx];
       }
     }
   }
 
-  // Rebuild offset
-  offset_child.front() = 0;
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  graph::AdjacencyList<std::int32_t> p_to_c_facet(std::move(child_facet),
-                                                  std::move(offset_child));
-
-  // Copy facet meshtag from parent to child
-  std::vector<std::int32_t> facet_indices, tag_values;
-  for (std::size_t i = 0; i < indices.size(); ++i)
-  {
-    std::int32_t parent_index = indices[i];
-    auto pclinks = p_to_c_facet.links(parent_index);
-
-    // Eliminate duplicates
-    std::ranges::sort(pclinks);
-    auto it_end = std::ranges::unique(pclinks).begin();
-    facet_indices.insert(facet_indices.end(), pclinks.begin(), it_end);
-    tag_values.insert(tag_values.end(), std::distance(pclinks.begin(), it_end),
-                      values[i]);
-  }
-
-  // Sort values into order, based on facet indices
-  std::vector<std::int32_t> sort_order(tag_values.size());
-  std::iota(sort_order.begin(), sort_order.end(), 0);
-  dolfinx::radix_sort(sort_order, [&facet_indices](auto index)
-                      { return facet_indices[index]; });
-  std::vector<std::int32_t> sorted_facet_indices(facet_indices.size());
-  std::vector<std::int32_t> sorted_tag_values(tag_values.size());
-  for (std::size_t i = 0; i < sort_order.size(); ++i)
+  // Transfer each set of tags. Refined entities are visited in order, so
+  // the transferred entities are sorted.
+  std::vector<std::array<std::vector<std::int32_t>, 2>> tags1;
+  tags1.reserve(tags0.size());
+  std::vector<std::int32_t> tag_index;
+  for (auto& t : tags0)
   {
-    sorted_tag_values[i] = tag_values[sort_order[i]];
-    sorted_facet_indices[i] = facet_indices[sort_order[i]];
+    const mesh::MeshTags<std::int32_t>& tags = t.get();
+    std::span<const std::int32_t> parent
+        = tags.dim() == tdim ? cell_parent : facet_parent;
+
+    // Position of the tag of each parent entity (-1 if not tagged)
+    auto map0 = topology0->index_map(tags.dim());
+    assert(map0);
+    tag_index.assign(map0->size_local() + map0->num_ghosts(), -1);
+    std::span<const std::int32_t> indices = tags.indices();
+    for (std::size_t i = 0; i < indices.size(); ++i)
+      tag_index[indices[i]] = i;
+
+    std::span<const std::int32_t> values = tags.values();
+    std::vector<std::int32_t> entities1, values1;
+    for (std::size_t e = 0; e < parent.size(); ++e)
+    {
+      if (std::int32_t p = parent[e]; p != -1 and tag_index[p] != -1)
+      {
+        entities1.push_back(e);
+        values1.push_back(values[tag_index[p]]);
+      }
+    }
+    tags1.push_back({std::move(entities1), std::move(values1)});
   }
 
-  return {std::move(sorted_facet_indices), std::move(sorted_tag_values)};
+  return tags1;
+}
+//-----------------------------------------------------------------------------
+std::array<std::vector<std::int32_t>, 2> refinement::transfer_facet_meshtag(
+    const mesh::MeshTags<std::int32_t>& tags0, const mesh::Topology& topology1,
+    std::span<const std::int32_t> cell, std::span<const std::int8_t> facet)
+{
+  int tdim = tags0.topology()->dim();
+  if (tags0.dim() != tdim - 1)
+    throw std::runtime_error("Input meshtag is not facet-based");
+  return std::move(
+      transfer_meshtags({std::cref(tags0)}, topology1, cell, facet).front());
 }
 //----------------------------------------------------------------------------
 std::array<std::vector<std::int32_t>, 2>
@@ -275,93 +291,9 @@ refinement::transfer_cell_meshtag(const mesh::MeshTags<std::int32_t>& tags0,
                                   const mesh::Topology& topology1,
                                   std::span<const std::int32_t> cell)
 {
-  auto topology0 = tags0.topology();
-  assert(topology0);
-  auto values0 = tags0.values();
-  auto indices0 = tags0.indices();
-
-  const int tdim = topology0->dim();
-  if (tags0.dim() != tdim)
+  if (tags0.dim() != tags0.topology()->dim())
     throw std::runtime_error("Input meshtag is not cell-based");
-
-  if (topology0->index_map(tdim)->num_ghosts() > 0)
-    throw std::runtime_error("Ghosted meshes are not supported");
-
-  // Create map parent->child facets
-  const std::int32_t num_input_cells
-      = topology0->index_map(tdim)->size_local()
-        + topology0->index_map(tdim)->num_ghosts();
-  std::vector<int> count_child(num_input_cells, 0);
-
-  // Get global index for each refined cell, before reordering in Mesh
-  // construction
-  const std::vector<std::int64_t>& original_cell_index
-      = topology1.original_cell_index[0];
-  assert(original_cell_index.size() == cell.size());
-  std::int64_t global_offset = topology1.index_map(tdim)->local_range()[0];
-
-  // Map back to original index
-  std::vector<std::int32_t> local_cell_index(original_cell_index.size());
-  for (std::size_t i = 0; i < local_cell_index.size(); ++i)
-  {
-    assert(original_cell_index[i] >= global_offset);
-    assert(original_cell_index[i] - global_offset
-           < (int)local_cell_index.size());
-    local_cell_index[original_cell_index[i] - global_offset] = i;
-  }
-
-  // Count number of child cells for each parent cell
-  for (std::int32_t c : cell)
-    ++count_child[c];
-
-  std::vector<int> offset_child(num_input_cells + 1, 0);
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  std::vector<std::int32_t> child_cell(offset_child.back());
-
-  // Fill in data for each child cell
-  for (std::size_t c = 0; c < cell.size(); ++c)
-  {
-    std::int32_t pc = cell[c];
-    int offset = offset_child[pc];
-
-    // Use original indexing for child cell
-    const std::int32_t lc = local_cell_index[c];
-    child_cell[offset] = lc;
-    ++offset_child[pc];
-  }
-
-  // Rebuild offset
-  offset_child.front() = 0;
-  std::partial_sum(count_child.begin(), count_child.end(),
-                   std::next(offset_child.begin()));
-  graph::AdjacencyList p_to_c_cell(std::move(child_cell),
-                                   std::move(offset_child));
-
-  // Copy cell meshtag from parent to child
-  std::vector<std::int32_t> cell_indices, tag_values;
-  // std::span<const std::int32_t> in_index = meshtag.indices();
-  // std::span<const std::int32_t> in_value = meshtag.values();
-  for (std::size_t i = 0; i < indices0.size(); ++i)
-  {
-    auto pclinks = p_to_c_cell.links(indices0[i]);
-    cell_indices.insert(cell_indices.end(), pclinks.begin(), pclinks.end());
-    tag_values.insert(tag_values.end(), pclinks.size(), values0[i]);
-  }
-
-  // Sort values into order, based on cell indices
-  std::vector<std::int32_t> sort_order(tag_values.size());
-  std::iota(sort_order.begin(), sort_order.end(), 0);
-  dolfinx::radix_sort(sort_order, [&cell_indices](auto index)
-                      { return cell_indices[index]; });
-  std::vector<std::int32_t> sorted_tag_values(tag_values.size());
-  std::vector<std::int32_t> sorted_cell_indices(cell_indices.size());
-  for (std::size_t i = 0; i < sort_order.size(); ++i)
-  {
-    sorted_tag_values[i] = tag_values[sort_order[i]];
-    sorted_cell_indices[i] = cell_indices[sort_order[i]];
-  }
-
-  return {std::move(sorted_cell_indices), std::move(sorted_tag_values)};
+  return std::move(
+      transfer_meshtags({std::cref(tags0)}, topology1, cell, {}).front());
 }
 //-----------------------------------------------------------------------------
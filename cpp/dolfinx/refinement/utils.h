@@ -6,15 +6,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <concepts>
 #include <cstdint>
+#include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Scatterer.h>
+#include <dolfinx/common/Timer.h>
 #include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
+#include <functional>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <span>
 #include <tuple>
@@ -82,7 +91,7 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
   }
 
   // Copy over existing mesh vertices
-  std::span<const T> x_g = mesh.geometry().x();
+  mesh::NodeCoordinates<T> x_g = mesh.geometry().coordinates();
   const std::size_t gdim = mesh.geometry().dim();
   const std::size_t num_vertices = map_v->size_local();
   const std::size_t num_new_vertices = local_edge_to_new_vertex.size();
@@ -90,11 +99,8 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
   std::array<std::size_t, 2> shape = {num_vertices + num_new_vertices, gdim};
   std::vector<T> new_vertex_coords(shape[0] * shape[1]);
   for (std::size_t v = 0; v < num_vertices; ++v)
-  {
-    std::size_t pos = 3 * vertex_to_x[v];
     for (std::size_t j = 0; j < gdim; ++j)
-      new_vertex_coords[gdim * v + j] = x_g[pos + j];
-  }
+      new_vertex_coords[gdim * v + j] = x_g(vertex_to_x[v], j);
 
   // Compute new vertices
   if (num_new_vertices > 0)
@@ -114,6 +120,131 @@ std::pair<std::vector<T>, std::array<std::size_t, 2>> create_new_geometry(
   return {std::move(new_vertex_coords), shape};
 }
 
+/// @brief Create a refined mesh on the processes of the parent mesh
+/// without re-distributing the cells.
+///
+/// This is an alternative to mesh::create_mesh for refinement without
+/// a partitioner. The refined vertices owned by a process are the
+/// owned vertices of the parent mesh followed by the new vertices on
+/// its owned edges, which is exactly the row blocking of `x`. The
+/// vertex index map, topology and geometry are therefore built
+/// directly from the refined cells and `x`, skipping the dual graph,
+/// cell re-ordering and the distribution of the coordinate data. Only
+/// the coordinates of ghost vertices are communicated. Children of a
+/// parent cell are numbered contiguously, so the refined cells follow
+/// the ordering of the parent cells.
+///
+/// @pre The parent mesh has no ghost cells and an affine geometry
+/// (cells have one geometry node per vertex).
+///
+/// @param[in] mesh Parent mesh.
+/// @param[in] cells Refined cells (global vertex indices, flattened).
+/// @param[in] x Coordinates of the owned vertices of the refined mesh
+/// (row-major). The global index of row `i` is `i` plus the process
+/// offset, i.e. the sum of `x` rows on lower ranks.
+/// @param[in] xshape Shape of `x`.
+/// @return The refined mesh.
+template <std::floating_point T>
+mesh::Mesh<T> create_refined_mesh(const mesh::Mesh<T>& mesh,
+                                  std::span<const std::int64_t> cells,
+                                  std::span<const T> x,
+                                  std::array<std::size_t, 2> xshape)
+{
+  common::Timer t0("Refinement: create refined mesh");
+
+  MPI_Comm comm = mesh.comm();
+  const mesh::CellType cell_type = mesh.topology()->cell_type();
+  const int num_cell_vertices = mesh::num_cell_vertices(cell_type);
+  const std::size_t gdim = xshape[1];
+  assert(cells.size() % num_cell_vertices == 0);
+
+  // Owned vertex range of each process
+  const std::int64_t num_owned = xshape[0];
+  std::int64_t offset = 0;
+  MPI_Exscan(&num_owned, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::vector<std::int64_t> ranges(dolfinx::MPI::size(comm) + 1, 0);
+  {
+    const std::int64_t end = offset + num_owned;
+    MPI_Allgather(&end, 1, MPI_INT64_T, std::next(ranges.data()), 1,
+                  MPI_INT64_T, comm);
+  }
+
+  // Ghost vertices, i.e. vertices of the refined cells that are owned by
+  // another process
+  std::vector<std::int64_t> ghosts;
+  for (std::int64_t v : cells)
+  {
+    if (v < offset or v >= offset + num_owned)
+      ghosts.push_back(v);
+  }
+  std::ranges::sort(ghosts);
+  auto [unique_end, range_end] = std::ranges::unique(ghosts);
+  ghosts.erase(unique_end, range_end);
+  std::vector<int> owners(ghosts.size());
+  std::ranges::transform(
+      ghosts, owners.begin(),
+      [&ranges](auto v)
+      {
+        auto it = std::ranges::upper_bound(ranges, v);
+        return std::distance(ranges.begin(), it) - 1;
+      });
+
+  auto vertex_map = std::make_shared<common::IndexMap>(comm, num_owned,
+                                                       ghosts, owners);
+  auto cell_map = std::make_shared<common::IndexMap>(
+      comm, cells.size() / num_cell_vertices);
+
+  // Cell-to-vertex connectivity with local vertex indices
+  std::vector<std::int32_t> cells_local(cells.size());
+  std::ranges::transform(
+      cells, cells_local.begin(),
+      [&](auto v) -> std::int32_t
+      {
+        if (v >= offset and v < offset + num_owned)
+          return v - offset;
+        else
+          return num_owned
+                 + std::distance(ghosts.begin(),
+                                 std::ranges::lower_bound(ghosts, v));
+      });
+
+  std::vector<std::int64_t> original_cell_index(cell_map->size_local());
+  std::iota(original_cell_index.begin(), original_cell_index.end(),
+            cell_map->local_range()[0]);
+  auto topology = std::make_shared<mesh::Topology>(
+      comm, cell_type, vertex_map, cell_map,
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          graph::regular_adjacency_list(cells_local, num_cell_vertices)),
+      original_cell_index);
+
+  // Geometry nodes are the vertices. Coordinates of ghost vertices are
+  // received from the owners.
+  std::vector<T> x_ghost(gdim * ghosts.size());
+  common::Scatterer<> scatterer(*vertex_map, gdim);
+  scatterer.scatter_fwd(x, std::span<T>(x_ghost));
+  std::vector<T> xg(3 * (num_owned + ghosts.size()), 0);
+  for (std::int64_t i = 0; i < num_owned; ++i)
+  {
+    std::copy_n(std::next(x.begin(), gdim * i), gdim,
+                std::next(xg.begin(), 3 * i));
+  }
+  for (std::size_t i = 0; i < ghosts.size(); ++i)
+  {
+    std::copy_n(std::next(x_ghost.begin(), gdim * i), gdim,
+                std::next(xg.begin(), 3 * (num_owned + i)));
+  }
+
+  std::vector<std::int64_t> igi(num_owned + ghosts.size());
+  std::iota(igi.begin(), std::next(igi.begin(), num_owned), offset);
+  std::ranges::copy(ghosts, std::next(igi.begin(), num_owned));
+
+  mesh::Geometry<T> geometry(vertex_map, std::move(cells_local),
+                             mesh.geometry().cmap(), std::move(xg), gdim,
+                             std::move(igi));
+
+  return mesh::Mesh<T>(comm, topology, std::move(geometry));
+}
+
 } // namespace impl
 
 /// @brief Communicate edge markers between processes that share edges.
@@ -279,6 +410,34 @@ create_new_vertices(MPI_Comm comm,
 std::vector<std::int64_t> adjust_indices(const common::IndexMap& map,
                                          std::int32_t n);
 
+/// @brief Transfer cell and facet MeshTags from a coarse mesh to a
+/// refined mesh.
+///
+/// The parent of each refined cell and facet is computed once and
+/// shared by all sets of tags. Each set of tags is then transferred in
+/// a single pass over the refined entities, so the refined entities are
+/// sorted without a sort.
+///
+/// @warning The refined mesh must not have been redistributed during
+/// refinement.
+///
+/// @warning Mesh/topology `GhostMode` must be mesh::GhostMode::none.
+///
+/// @param[in] tags0 Cell and facet tags on the parent mesh. All tags
+/// must be defined on the same topology.
+/// @param[in] topology1 Refined mesh topology. Cell-facet connectivity
+/// is required if facet tags are transferred.
+/// @param[in] parent_cell Parent cell of each cell in refined mesh.
+/// @param[in] parent_facet Local facets of parent in each cell in
+/// refined mesh. Only used if facet tags are transferred.
+/// @return (0) entities and (1) values on the refined topology for each
+/// set of tags.
+std::vector<std::array<std::vector<std::int32_t>, 2>> transfer_meshtags(
+    const std::vector<
+        std::reference_wrapper<const mesh::MeshTags<std::int32_t>>>& tags0,
+    const mesh::Topology& topology1, std::span<const std::int32_t> parent_cell,
+    std::span<const std::int8_t> parent_facet);
+
 /// @brief Transfer facet MeshTags from coarse mesh to refined mesh.
 ///
 /// @warning The refined mesh must not have been redistributed during
@@ -291,6 +450,7 @@ std::vector<std::int64_t> adjust_indices(const common::IndexMap& map,
 /// @param[in] cell Parent cell of each cell in refined mesh
 /// @param[in] facet Local facets of parent in each cell in refined mesh.
 /// @return (0) entities and (1) values on the refined topology.
+/// @note To transfer several sets of tags, use transfer_meshtags.
 std::array<std::vector<std::int32_t>, 2> transfer_facet_meshtag(
     const mesh::MeshTags<std::int32_t>& tags0, const mesh::Topology& topology1,
     std::span<const std::int32_t> cell, std::span<const std::int8_t> facet);
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the arena scratch memory resource
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/Arena.h>
+#include <memory_resource>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Arena reuses memory after reset", "[common][arena]")
+{
+  common::Arena arena;
+  std::size_t num_allocations = 0;
+  for (int cycle = 0; cycle < 4; ++cycle)
+  {
+    {
+      // Buffers of different sizes and alignments, with growth
+      std::pmr::vector<double> a(1000, 1.0, &arena);
+      std::pmr::vector<std::int8_t> b(3, 0, &arena);
+      std::pmr::vector<std::int64_t> c(&arena);
+      for (int i = 0; i < 5000; ++i)
+        c.push_back(i);
+      CHECK(reinterpret_cast<std::uintptr_t>(c.data()) % alignof(std::int64_t)
+            == 0);
+      CHECK(a.back() == 1.0);
+      CHECK(c.back() == 4999);
+    }
+    arena.reset();
+
+    // After the first cycle no memory is allocated upstream
+    if (cycle == 0)
+      num_allocations = arena.num_upstream_allocations();
+    else
+      CHECK(arena.num_upstream_allocations() == num_allocations);
+  }
+  CHECK(arena.capacity()
+        >= 1000 * sizeof(double) + 5000 * sizeof(std::int64_t));
+}
+
+TEST_CASE("Scratch resource scope", "[common][arena]")
+{
+  CHECK(common::scratch_resource() == std::pmr::get_default_resource());
+  common::Arena a0, a1;
+  {
+    common::ScratchScope s0(a0);
+    CHECK(common::scratch_resource() == &a0);
+    {
+      common::ScratchScope s1(a1);
+      CHECK(common::scratch_resource() == &a1);
+    }
+    CHECK(common::scratch_resource() == &a0);
+  }
+  CHECK(common::scratch_resource() == std::pmr::get_default_resource());
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Distribute data", "[distribute_data]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Rows (2 columns) with values (global index, -global index)
+  const std::int64_t num_rows_local = 10 + rank;
+  std::int64_t offset = 0;
+  MPI_Exscan(&num_rows_local, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::vector<double> x(2 * num_rows_local);
+  for (std::int64_t i = 0; i < num_rows_local; ++i)
+  {
+    x[2 * i] = offset + i;
+    x[2 * i + 1] = -(offset + i);
+  }
+
+  // Request (in reverse order) the rows of the next rank and some rows
+  // of this rank
+  const int next = (rank + 1) % size;
+  std::int64_t offset_next = 10 * next + (next * (next - 1)) / 2;
+  std::vector<std::int64_t> indices;
+  for (std::int64_t i = 10 + next - 1; i >= 0; --i)
+    indices.push_back(offset_next + i);
+  indices.push_back(offset);
+
+  auto check = [&indices](const std::vector<double>& data)
+  {
+    REQUIRE(data.size() == 2 * indices.size());
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+      CHECK(data[2 * i] == indices[i]);
+      CHECK(data[2 * i + 1] == -indices[i]);
+    }
+  };
+
+  check(dolfinx::MPI::distribute_data(comm, indices, comm, x, 2));
+
+  // Other communication can be performed before the distribution is
+  // completed
+  auto request = dolfinx::MPI::distribute_data_begin(comm, indices, comm, x, 2);
+  int sum = 0;
+  MPI_Allreduce(&rank, &sum, 1, MPI_INT, MPI_SUM, comm);
+  CHECK(sum == size * (size - 1) / 2);
+  check(dolfinx::MPI::distribute_data_end(std::move(request)));
+}
+
+TEST_CASE("Neighbourhood all-to-all with 64-bit counts", "[distribute_data]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Send (rank + 1) values to the next rank, in a ring
+  const int next = (rank + 1) % size;
+  const int prev = (rank + size - 1) % size;
+  MPI_Comm neigh_comm;
+  MPI_Dist_graph_create_adjacent(comm, 1, &prev, MPI_UNWEIGHTED, 1, &next,
+                                 MPI_UNWEIGHTED, MPI_INFO_NULL, false,
+                                 &neigh_comm);
+
+  std::vector<std::int64_t> send(rank + 1);
+  std::iota(send.begin(), send.end(), 100 * rank);
+  std::vector<std::int64_t> send_counts = {rank + 1}, send_disp = {0, rank + 1};
+  std::vector<std::int64_t> recv_counts = {prev + 1}, recv_disp = {0, prev + 1};
+  std::vector<std::int64_t> recv(prev + 1);
+  int err = dolfinx::MPI::neighbor_alltoallv(
+      send.data(), send_counts, send_disp, recv.data(), recv_counts, recv_disp,
+      MPI_INT64_T, neigh_comm);
+  CHECK(err == MPI_SUCCESS);
+  for (int i = 0; i <= prev; ++i)
+    CHECK(recv[i] == 100 * prev + i);
+
+  MPI_Comm_free(&neigh_comm);
+}
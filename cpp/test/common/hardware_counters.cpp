@@ -0,0 +1,91 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <dolfinx/common/Table.h>
+#include <dolfinx/common/TimeLogger.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/hardware_counters.h>
+#include <dolfinx/common/timing.h>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Timer hardware counters", "[timer]")
+{
+  common::TimeLogger& logger = common::TimeLogger::instance();
+
+  // Disabled by default
+  {
+    common::Timer t("Test timer without counters");
+    t.stop();
+    CHECK(!t.counters());
+    t.flush();
+  }
+  CHECK(!logger.hardware_counters("Test timer without counters"));
+
+  const bool available = common::enable_hardware_counters(true);
+  volatile double sum = 0;
+  {
+    common::Timer t("Test timer with counters");
+    for (int i = 0; i < 100000; ++i)
+      sum = sum + i;
+    t.stop();
+    CHECK(t.counters().has_value() == available);
+    if (available)
+      CHECK((*t.counters())[1] > 100000);
+    t.flush();
+  }
+  common::enable_hardware_counters(false);
+
+  auto counters = logger.hardware_counters("Test timer with counters");
+  CHECK(counters.has_value() == available);
+
+  // Counters are summed over registered timings
+  logger.register_timing("Test counters", std::chrono::duration<double>(1),
+                         common::HardwareCounters{1, 2, 3, 4, 5});
+  logger.register_timing("Test counters", std::chrono::duration<double>(1),
+                         common::HardwareCounters{1, 2, 3, 4, 5});
+
+  // Tasks without counters have blank counter entries in the table
+  Table table = timing_table();
+  const std::string str = table.str();
+  CHECK(str.find("Test timer without counters") != std::string::npos);
+  CHECK(str.find("instructions") != std::string::npos);
+  CHECK(std::get<double>(table.get("Test counters", "instructions")) == 4);
+  if (available)
+  {
+    auto v = table.get("Test timer with counters", "instructions");
+    CHECK(std::get<double>(v) == static_cast<double>((*counters)[1]));
+  }
+}
+
+TEST_CASE("Concurrent timer registration", "[timer]")
+{
+  common::TimeLogger& logger = common::TimeLogger::instance();
+  const std::string task = "Test concurrent timer";
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back(
+        [&task]()
+        {
+          for (int i = 0; i < 100; ++i)
+          {
+            common::Timer timer(task);
+            timer.stop();
+            timer.flush();
+          }
+        });
+  }
+  for (auto& t : threads)
+    t.join();
+  CHECK(logger.timing(task).first == 400);
+}
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include <algorithm>
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <dolfinx/common/IndexMap.h>
@@ -159,6 +160,117 @@ void test_consensus_exchange()
 
   CHECK(dest_ranks0 == dest_ranks1);
 }
+
+void test_statistics()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 100;
+
+  // Ghosts owned by the next process, with rank 0 having no ghosts
+  const int num_ghosts = mpi_rank == 0 ? 0 : 10;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  std::iota(ghosts.begin(), ghosts.end(),
+            (mpi_rank + 1) % mpi_size * size_local);
+  const std::vector<int> owners(num_ghosts, (mpi_rank + 1) % mpi_size);
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  common::IndexMapStatistics stats = map.statistics();
+  CHECK(stats.ghost_ratio[0] == 0.0);
+  CHECK(stats.ghost_ratio[1] == (mpi_size > 1 ? 0.1 : 0.0));
+  CHECK(std::abs(stats.ghost_ratio[2] - 0.1 * (mpi_size - 1) / mpi_size)
+        < 1e-14);
+
+  // Number of processes with 0 and 1 source/destination ranks
+  const std::vector<std::int32_t> expected
+      = mpi_size > 1 ? std::vector<std::int32_t>{1, mpi_size - 1}
+                     : std::vector<std::int32_t>{1};
+  CHECK(stats.src_histogram == expected);
+  CHECK(stats.dest_histogram == expected);
+}
+
+void test_global_to_local()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 20;
+
+  // Ghost every other index of the next process, in reverse order
+  const int next = (mpi_rank + 1) % mpi_size;
+  std::vector<std::int64_t> ghosts;
+  if (mpi_size > 1)
+  {
+    for (int i = size_local - 2; i >= 0; i -= 2)
+      ghosts.push_back(next * size_local + i);
+  }
+  const std::vector<int> owners(ghosts.size(), next);
+  const common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  // Local index of each global index of this and the next process
+  auto expected = [&](std::int64_t index) -> std::int32_t
+  {
+    if (index / size_local == mpi_rank)
+      return index % size_local;
+    auto it = std::ranges::find(ghosts, index);
+    return it == ghosts.end() ? -1
+                              : size_local + std::distance(ghosts.begin(), it);
+  };
+
+  // Few ghost queries (binary search), then many (sorted merge). The
+  // ghost lookup table is reused by the second call.
+  for (int num_queries : {2, 2 * size_local})
+  {
+    std::vector<std::int64_t> global;
+    for (int i = 0; i < num_queries; ++i)
+      global.push_back(next * size_local + (7 * i) % size_local);
+    global.push_back(mpi_rank * size_local + 3);
+
+    std::vector<std::int32_t> local(global.size());
+    map.global_to_local(global, local);
+    for (std::size_t i = 0; i < global.size(); ++i)
+      CHECK(local[i] == expected(global[i]));
+  }
+}
+
+void test_create_index_maps()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size_local = 10;
+
+  // Map k ghosts one index on each of the next k processes. The last
+  // map has no ghosts.
+  const int num_maps = 4;
+  std::vector<std::vector<std::int64_t>> ghosts(num_maps);
+  std::vector<std::vector<int>> owners(num_maps);
+  for (int k = 0; k < num_maps - 1; ++k)
+  {
+    for (int j = 1; j <= std::min(k + 1, mpi_size - 1); ++j)
+    {
+      const int owner = (mpi_rank + j) % mpi_size;
+      ghosts[k].push_back(owner * size_local + k);
+      owners[k].push_back(owner);
+    }
+  }
+
+  std::vector<std::int32_t> local_sizes(num_maps, size_local);
+  std::vector<std::span<const std::int64_t>> _ghosts(ghosts.begin(),
+                                                      ghosts.end());
+  std::vector<std::span<const int>> _owners(owners.begin(), owners.end());
+  std::vector<common::IndexMap> maps = common::create_index_maps(
+      MPI_COMM_WORLD, local_sizes, _ghosts, _owners);
+  REQUIRE(maps.size() == num_maps);
+  for (int k = 0; k < num_maps; ++k)
+  {
+    common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts[k], owners[k]);
+    CHECK(maps[k].size_global() == map.size_global());
+    CHECK(std::ranges::equal(maps[k].local_range(), map.local_range()));
+    CHECK(std::ranges::equal(maps[k].ghosts(), map.ghosts()));
+    CHECK(std::ranges::equal(maps[k].owners(), map.owners()));
+    CHECK(std::ranges::equal(maps[k].src(), map.src()));
+    CHECK(std::ranges::equal(maps[k].dest(), map.dest()));
+  }
+}
 } // namespace
 
 TEST_CASE("Scatter forward using IndexMap", "[index_map_scatter_fwd]")
@@ -172,6 +284,21 @@ TEST_CASE("Scatter reverse using IndexMap", "[index_map_scatter_rev]")
   CHECK_NOTHROW(test_scatter_rev());
 }
 
+TEST_CASE("IndexMap statistics", "[index_map_statistics]")
+{
+  CHECK_NOTHROW(test_statistics());
+}
+
+TEST_CASE("IndexMap global to local", "[index_map_global_to_local]")
+{
+  CHECK_NOTHROW(test_global_to_local());
+}
+
+TEST_CASE("Create multiple IndexMaps", "[index_map_create]")
+{
+  CHECK_NOTHROW(test_create_index_maps());
+}
+
 TEST_CASE("Communication graph edges via consensus exchange",
           "[consensus_exchange]")
 {
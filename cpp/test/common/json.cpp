@@ -0,0 +1,32 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/Table.h>
+#include <dolfinx/common/json.h>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace dolfinx;
+
+TEST_CASE("JSON formatting", "[json]")
+{
+  CHECK(common::json_quote("a\"b\\c\nd\te") == "\"a\\\"b\\\\c\\nd e\"");
+
+  std::stringstream s;
+  common::json_number(s, 1.5);
+  s << " ";
+  common::json_number(s, std::numeric_limits<double>::quiet_NaN());
+  s << " ";
+  common::json_number(s, -std::numeric_limits<double>::infinity());
+  CHECK(s.str() == "1.5 null null");
+
+  Table table("Table");
+  table.set("a", "x", std::numeric_limits<double>::infinity());
+  table.set("a", "y", 2);
+  CHECK(table.json() == "{\"a\": {\"x\": null, \"y\": 2}}");
+}
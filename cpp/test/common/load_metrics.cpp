@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Table.h>
+#include <dolfinx/common/load_metrics.h>
+#include <mpi.h>
+#include <variant>
+
+using namespace dolfinx;
+
+TEST_CASE("Load metrics", "[load_metrics]")
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  common::reset_load_metrics();
+
+  // Disabled by default
+  common::add_load_time(common::LoadPhase::assembly, 1);
+  common::end_load_step();
+  CHECK(common::load_step_times().empty());
+
+  common::enable_load_metrics(true);
+  common::add_load_time(common::LoadPhase::assembly, rank + 1);
+  common::add_load_time(common::LoadPhase::solver, 2);
+  {
+    // Nested timers of the same phase are counted once
+    common::ScopedLoadTimer t0(common::LoadPhase::kernel);
+    common::ScopedLoadTimer t1(common::LoadPhase::kernel);
+  }
+  common::end_load_step();
+  common::add_load_time(common::LoadPhase::scatter, 3);
+  common::end_load_step();
+  common::enable_load_metrics(false);
+
+  auto times = common::load_step_times();
+  REQUIRE(times.size() == 2);
+  CHECK(times[0][0] == rank + 1);
+  CHECK(times[0][1] >= 0);
+  CHECK(times[0][2] == 0);
+  CHECK(times[0][3] == 2);
+  CHECK((times[1] == common::LoadTimes{0, 0, 3, 0}));
+
+  Table table = common::load_imbalance_table(MPI_COMM_WORLD);
+  if (rank == 0)
+  {
+    const double avg = 0.5 * (size + 1);
+    CHECK(std::get<double>(table.get("step 0", "assembly max")) == size);
+    CHECK(std::get<double>(table.get("step 0", "assembly avg"))
+          == Catch::Approx(avg));
+    CHECK(std::get<double>(table.get("step 0", "assembly max/avg"))
+          == Catch::Approx(size / avg));
+    CHECK(std::get<double>(table.get("step 1", "assembly max/avg")) == 1);
+    CHECK(std::get<double>(table.get("total", "scatter wait max")) == 3);
+  }
+
+  common::reset_load_metrics();
+  CHECK(common::load_step_times().empty());
+}
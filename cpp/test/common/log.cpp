@@ -0,0 +1,43 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/log.h>
+
+TEST_CASE("Log macros", "[log]")
+{
+  const spdlog::level::level_enum level = spdlog::get_level();
+  int count = 0;
+  auto arg = [&count]() { return ++count; };
+
+  // Arguments are not evaluated if the level is disabled at runtime
+  spdlog::set_level(spdlog::level::off);
+  DOLFINX_LOG_DEBUG("Value {}", arg());
+  DOLFINX_LOG_INFO("Value {}", arg());
+  CHECK(count == 0);
+
+  // Arguments are evaluated if the level is enabled and not removed at
+  // compile time
+  spdlog::set_level(spdlog::level::info);
+  DOLFINX_LOG_INFO("Value {}", arg());
+  DOLFINX_LOG_DEBUG("Value {}", arg());
+  CHECK(count == (SPDLOG_LEVEL_INFO >= DOLFINX_LOG_LEVEL ? 1 : 0));
+
+  // Rate-limited messages
+  count = 0;
+  for (int i = 0; i < 10; ++i)
+    DOLFINX_LOG_RATE_LIMITED(spdlog::level::info, 1e3, "Value {}", arg());
+  CHECK(count == (SPDLOG_LEVEL_INFO >= DOLFINX_LOG_LEVEL ? 1 : 0));
+  spdlog::set_level(level);
+
+  dolfinx::impl::LogRateLimiter limiter(1e3);
+  CHECK(limiter.acquire() == 0);
+  CHECK(limiter.acquire() == -1);
+  CHECK(limiter.acquire() == -1);
+  dolfinx::impl::LogRateLimiter limiter0(0);
+  CHECK(limiter0.acquire() == 0);
+  CHECK(limiter0.acquire() == 0);
+}
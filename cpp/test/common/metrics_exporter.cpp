@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/MetricsExporter.h>
+#include <dolfinx/common/Timer.h>
+#include <filesystem>
+#include <fstream>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+
+using namespace dolfinx;
+
+TEST_CASE("Metrics exporter", "[metrics_exporter]")
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const std::filesystem::path filename
+      = std::filesystem::temp_directory_path() / "dolfinx_metrics_test.prom";
+
+  {
+    common::Timer t("Metrics exporter test");
+  }
+
+  {
+    common::MetricsExporter exporter(MPI_COMM_WORLD, filename, 2);
+    exporter.set("test_value", rank + 1);
+
+    // No export before the interval is reached
+    exporter.update();
+    exporter.flush();
+    CHECK(exporter.num_exports() == 0);
+
+    exporter.update();
+    exporter.flush();
+    CHECK(exporter.num_exports() == 1);
+  }
+
+  if (rank == 0)
+  {
+    std::ifstream file(filename);
+    std::stringstream text;
+    text << file.rdbuf();
+    const std::string s = text.str();
+    CHECK(s.find("dolfinx_num_processes " + std::to_string(size))
+          != std::string::npos);
+    CHECK(s.find("dolfinx_test_value{stat=\"min\"} 1\n") != std::string::npos);
+    CHECK(s.find("dolfinx_test_value{stat=\"max\"} " + std::to_string(size)
+                 + "\n")
+          != std::string::npos);
+    CHECK(s.find("dolfinx_timer_calls{task=\"Metrics exporter test\","
+                 "stat=\"max\"} 1\n")
+          != std::string::npos);
+    std::filesystem::remove(filename);
+  }
+}
@@ -101,3 +101,72 @@ TEST_CASE("Test argsort bitset")
                        arr.data() + shape1 * index[i]));
   }
 }
+
+TEST_CASE("Test threaded argsort")
+{
+  auto shape0 = GENERATE(1, 7, 1000, 10001);
+  auto num_threads = GENERATE(1, 2, 3, 8);
+  constexpr int shape1 = 3;
+
+  // Narrow range of values so that many rows are repeated
+  std::vector<std::int32_t> arr(shape0 * shape1);
+  std::uniform_int_distribution<std::int32_t> distribution(0, 10);
+  std::mt19937 engine;
+  auto generator = std::bind(distribution, engine);
+  std::generate(arr.begin(), arr.end(), generator);
+
+  // The threaded sort is stable, so the permutation must be the same
+  // as for the serial sort
+  std::vector<std::int32_t> perm0
+      = dolfinx::sort_by_perm<std::int32_t>(arr, shape1);
+  std::vector<std::int32_t> perm1
+      = dolfinx::sort_by_perm<std::int32_t>(arr, shape1, num_threads);
+  CHECK(perm0 == perm1);
+}
+
+TEST_CASE("Test argsort wide and negative keys")
+{
+  // Rows that fit into 64 bits are packed, and wider rows are sorted
+  // column by column
+  auto range = GENERATE(std::int64_t(10), std::int64_t(1) << 40);
+  auto num_threads = GENERATE(1, 3);
+  constexpr int shape1 = 3;
+  constexpr std::size_t shape0 = 2000;
+
+  std::vector<std::int64_t> arr(shape0 * shape1);
+  std::uniform_int_distribution<std::int64_t> distribution(-range, range);
+  std::mt19937 engine;
+  auto generator = std::bind(distribution, engine);
+  std::generate(arr.begin(), arr.end(), generator);
+
+  std::vector<std::int32_t> perm
+      = dolfinx::sort_by_perm<std::int64_t>(arr, shape1, num_threads);
+  REQUIRE(perm.size() == shape0);
+  for (std::size_t i = 1; i < perm.size(); i++)
+  {
+    auto it0 = std::next(arr.begin(), shape1 * perm[i - 1]);
+    auto it1 = std::next(arr.begin(), shape1 * perm[i]);
+    REQUIRE(!std::lexicographical_compare(it1, std::next(it1, shape1), it0,
+                                          std::next(it0, shape1)));
+
+    // Stable
+    if (std::equal(it0, std::next(it0, shape1), it1))
+      REQUIRE(perm[i - 1] < perm[i]);
+  }
+}
+
+TEST_CASE("Test sort unique")
+{
+  constexpr std::int64_t large = std::int64_t(1) << 40;
+  std::vector<std::int64_t> x{5, 1, 5, 3, large, 1, 0};
+  dolfinx::sort_unique(x);
+  const std::vector<std::int64_t> x_ref{0, 1, 3, 5, large};
+  CHECK(x == x_ref);
+
+  // Projected keys can be wider than the sorted values
+  std::vector<std::int32_t> perm{0, 1, 2, 3};
+  const std::vector<std::int64_t> keys{large, 3, large / 2, 2};
+  dolfinx::radix_sort(perm, [&keys](auto i) { return keys[i]; });
+  const std::vector<std::int32_t> perm_ref{3, 1, 2, 0};
+  CHECK(perm == perm_ref);
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <dolfinx/common/ThreadPool.h>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Thread pool", "[thread_pool]")
+{
+  auto num_threads = GENERATE(1, 2, 4);
+  common::ThreadPool pool(num_threads);
+  CHECK(pool.size() == num_threads);
+
+  // Repeat to check that the workers are re-used
+  for (int k = 0; k < 3; ++k)
+  {
+    std::vector<int> count(17, 0);
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    pool.run(count.size(),
+             [&](int t)
+             {
+               count[t] += 1;
+               std::scoped_lock lock(mutex);
+               ids.insert(std::this_thread::get_id());
+             });
+    CHECK(std::ranges::all_of(count, [](auto c) { return c == 1; }));
+    CHECK(ids.size() <= std::size_t(num_threads));
+  }
+
+  // Nested calls are executed on the calling thread
+  std::atomic<int> sum = 0;
+  pool.run(4, [&](int) { pool.run(3, [&](int t) { sum += t; }); });
+  CHECK(sum == 12);
+
+  // The exception of the lowest failing task is re-thrown
+  try
+  {
+    pool.run(8,
+             [](int t)
+             {
+               if (t >= 3)
+                 throw std::runtime_error(std::to_string(t));
+             });
+    CHECK(false);
+  }
+  catch (const std::runtime_error& e)
+  {
+    CHECK(std::string(e.what()) == "3");
+  }
+}
+
+TEST_CASE("Thread pool background tasks", "[thread_pool]")
+{
+  auto num_threads = GENERATE(1, 2);
+  common::ThreadPool pool(num_threads);
+
+  // Submitted functions are executed in order, off the calling thread
+  std::vector<int> order;
+  std::vector<std::future<void>> futures;
+  std::set<std::thread::id> ids;
+  for (int i = 0; i < 5; ++i)
+  {
+    futures.push_back(pool.submit(
+        [&order, &ids, i]()
+        {
+          order.push_back(i);
+          ids.insert(std::this_thread::get_id());
+        }));
+  }
+  for (std::future<void>& f : futures)
+    f.wait();
+  CHECK(order == std::vector<int>{0, 1, 2, 3, 4});
+  CHECK(ids.size() == 1);
+  CHECK(!ids.contains(std::this_thread::get_id()));
+
+  // Tasks run by a submitted function are executed on its thread, while
+  // the calling thread uses the workers
+  std::atomic<int> sum0 = 0, sum1 = 0;
+  std::future<void> f
+      = pool.submit([&]() { pool.run(4, [&](int t) { sum0 += t; }); });
+  pool.run(4, [&](int t) { sum1 += t; });
+  f.get();
+  CHECK(sum0 == 6);
+  CHECK(sum1 == 6);
+
+  // Exceptions are stored in the future
+  std::future<void> e
+      = pool.submit([]() { throw std::runtime_error("background"); });
+  CHECK_THROWS_AS(e.get(), std::runtime_error);
+}
+
+TEST_CASE("Process thread pool", "[thread_pool]")
+{
+  const int n = common::num_threads();
+  common::set_num_threads(3);
+  CHECK(common::num_threads() == 3);
+  CHECK(common::thread_pool().size() == 3);
+  CHECK_THROWS(common::set_num_threads(0));
+  common::set_num_threads(n);
+}
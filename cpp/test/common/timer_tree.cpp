@@ -0,0 +1,111 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/TimerTree.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+const common::TimerTreeNode* find_child(const common::TimerTreeNode& node,
+                                        const std::string& name)
+{
+  for (auto& c : node.children)
+  {
+    if (c.name == name)
+      return &c;
+  }
+  return nullptr;
+}
+} // namespace
+
+TEST_CASE("Timer tree", "[timer_tree]")
+{
+  common::reset_timer_tree();
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+
+  {
+    common::ScopedTimer t0("outer");
+    for (int i = 0; i < 3; ++i)
+    {
+      common::ScopedTimer t1("inner");
+      if (rank == 0)
+        common::ScopedTimer t2("rank 0");
+    }
+  }
+
+  // Regions timed on worker threads are merged with the root regions
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i)
+    threads.emplace_back([]() { common::ScopedTimer t("thread"); });
+  for (auto& t : threads)
+    t.join();
+
+  common::TimerTreeNode root = common::timer_tree(MPI_COMM_WORLD);
+  REQUIRE(root.children.size() == 2);
+
+  const common::TimerTreeNode* outer = find_child(root, "outer");
+  REQUIRE(outer);
+  CHECK(outer->count == size);
+  CHECK(outer->min <= outer->avg);
+  CHECK(outer->avg <= outer->max);
+
+  REQUIRE(outer->children.size() == 1);
+  const common::TimerTreeNode& inner = outer->children.front();
+  CHECK(inner.name == "inner");
+  CHECK(inner.count == 3 * size);
+  CHECK(inner.max <= outer->max);
+
+  REQUIRE(inner.children.size() == 1);
+  const common::TimerTreeNode& r0 = inner.children.front();
+  CHECK(r0.count == 3);
+  if (size > 1)
+    CHECK(r0.min == 0);
+
+  const common::TimerTreeNode* thread = find_child(root, "thread");
+  REQUIRE(thread);
+  CHECK(thread->count == 2 * size);
+  CHECK(thread->children.empty());
+
+  std::string json = common::timer_tree_json(MPI_COMM_WORLD);
+  CHECK(json.find("\"name\": \"inner\"") != std::string::npos);
+
+  common::reset_timer_tree();
+  CHECK(common::timer_tree(MPI_COMM_WORLD).children.empty());
+}
+
+TEST_CASE("Timer trace", "[timer_tree]")
+{
+  common::reset_timer_tree();
+  common::enable_timer_trace(true);
+  {
+    common::ScopedTimer t0("traced");
+    common::ScopedTimer t1("nested");
+  }
+  common::enable_timer_trace(false);
+  {
+    common::ScopedTimer t("untraced");
+  }
+
+  std::string trace = common::timer_trace_json(MPI_COMM_WORLD);
+  if (dolfinx::MPI::rank(MPI_COMM_WORLD) == 0)
+  {
+    CHECK(trace.starts_with("{\"traceEvents\": [{"));
+    CHECK(trace.find("\"name\": \"nested\"") != std::string::npos);
+    CHECK(trace.find("\"untraced\"") == std::string::npos);
+    CHECK(trace.find("\"ph\": \"X\"") != std::string::npos);
+  }
+  else
+    CHECK(trace.empty());
+
+  common::reset_timer_tree();
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly over the cell types of a mixed-topology mesh
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assembly over cell types", "[assemble_cell_types]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const std::int64_t r = 3 * dolfinx::MPI::rank(comm);
+
+  // Two triangles and one quadrilateral on each process
+  std::vector<std::int64_t> tri{r, r + 1, r + 4, r, r + 3, r + 4};
+  std::vector<std::int64_t> quad{r + 1, r + 4, r + 2, r + 5};
+  std::vector<std::int64_t> tri_index{r, r + 1}, quad_index{r + 2};
+  std::vector<std::int64_t> boundary(6);
+  std::iota(boundary.begin(), boundary.end(), r);
+  auto topology = std::make_shared<mesh::Topology>(mesh::create_topology(
+      comm, {mesh::CellType::triangle, mesh::CellType::quadrilateral},
+      {tri, quad}, {tri_index, quad_index}, {{}, {}}, boundary));
+
+  std::vector<fem::CoordinateElement<double>> cmaps{
+      fem::CoordinateElement<double>(mesh::CellType::triangle, 1),
+      fem::CoordinateElement<double>(mesh::CellType::quadrilateral, 1)};
+  std::vector<std::int64_t> xdofs(tri);
+  xdofs.insert(xdofs.end(), quad.begin(), quad.end());
+  std::vector<double> x{0, 0, 1, 0, 2, 0, 0, 1, 1, 1, 2, 1};
+  for (std::size_t i = 1; i < x.size(); i += 2)
+    x[i] += r / 3;
+  mesh::Mesh<double> mesh(
+      comm, topology,
+      mesh::create_geometry(*topology, cmaps, boundary, xdofs, x, 2));
+
+  // P1 dofmaps for each cell type
+  std::vector<fem::DofMap> _dofmaps = fem::create_dofmaps(
+      comm, {cmaps[0].create_dof_layout(), cmaps[1].create_dof_layout()},
+      *topology, nullptr, nullptr);
+  std::vector<std::shared_ptr<const fem::DofMap>> dofmaps;
+  for (fem::DofMap& dofmap : _dofmaps)
+    dofmaps.push_back(std::make_shared<const fem::DofMap>(std::move(dofmap)));
+
+  // Kernel that sets each entry of the element tensor to one
+  auto ones = [](int n)
+  {
+    return [n](double* A, const double*, const double*, const double*,
+               const int*, const std::uint8_t*)
+    { std::fill_n(A, n, 1.0); };
+  };
+
+  std::vector<std::vector<std::int32_t>> cells(2);
+  for (int i = 0; i < 2; ++i)
+  {
+    cells[i].resize(topology->index_maps(2)[i]->size_local());
+    std::iota(cells[i].begin(), cells[i].end(), 0);
+  }
+  REQUIRE(cells[0].size() == 2);
+  REQUIRE(cells[1].size() == 1);
+
+  SECTION("matrix")
+  {
+    std::vector<fem::CellTypeIntegral<double>> integrals{
+        {1, ones(16), cells[1], {dofmaps[1], dofmaps[1]}},
+        {0, ones(9), cells[0], {dofmaps[0], dofmaps[0]}}};
+    double sum = 0;
+    std::size_t num_entries = 0;
+    auto mat_add = [&](std::span<const std::int32_t> rows,
+                       std::span<const std::int32_t> cols,
+                       std::span<const double> vals)
+    {
+      CHECK(vals.size() == rows.size() * cols.size());
+      num_entries += vals.size();
+      sum = std::accumulate(vals.begin(), vals.end(), sum);
+      return 0;
+    };
+    fem::assemble_matrix_cell_types<double>(
+        mat_add, mesh, std::span<const fem::CellTypeIntegral<double>>(integrals),
+        std::span<const double>());
+    CHECK(num_entries == 2 * 9 + 16);
+    CHECK(sum == 2 * 9 + 16);
+  }
+
+  SECTION("vector")
+  {
+    std::vector<fem::CellTypeIntegral<double>> integrals{
+        {0, ones(3), cells[0], {dofmaps[0], nullptr}},
+        {1, ones(4), cells[1], {dofmaps[1], nullptr}}};
+    auto index_map = dofmaps[0]->index_map;
+    std::vector<double> b(index_map->size_local() + index_map->num_ghosts(),
+                          0);
+    fem::assemble_vector_cell_types<double>(
+        b, mesh, std::span<const fem::CellTypeIntegral<double>>(integrals),
+        std::span<const double>());
+    CHECK(std::accumulate(b.begin(), b.end(), 0.0) == 2 * 3 + 4);
+  }
+}
@@ -0,0 +1,104 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly of the diagonal and row sums of a bilinear
+// form
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assembly of the diagonal and row sums", "[assemble_diagonal]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 5, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  fem::Form<double> a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+
+  // Boundary condition on the facets at x = 0
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, 2,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1.0e-8;
+        return marker;
+      });
+  std::vector bdofs = fem::locate_dofs_topological(
+      *V->mesh()->topology_mutable(), *V->dofmap(), 2, facets);
+  fem::DirichletBC<double> bc(0.0, bdofs, V);
+  const std::vector<std::reference_wrapper<const fem::DirichletBC<double>>>
+      bcs = {bc};
+
+  // Reference: diagonal and row sums of the assembled matrix
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), a, bcs);
+  A.scatter_rev();
+  fem::set_diagonal<double>(A.mat_set_values(), *V, bcs, 3.0);
+
+  auto map = V->dofmap()->index_map;
+  la::Vector<double> d(map, 1), l(map, 1);
+  d.set(0.0);
+  l.set(0.0);
+  fem::assemble_diagonal(d, a, bcs, 3.0);
+  fem::assemble_lumped(l, a, bcs, 3.0);
+
+  const std::vector<std::int64_t>& row_ptr = A.row_ptr();
+  const std::vector<std::int32_t>& cols = A.cols();
+  const std::vector<double>& values = A.values();
+  for (std::int32_t i = 0; i < map->size_local(); ++i)
+  {
+    double diag = 0, sum = 0;
+    for (std::int64_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+    {
+      if (cols[k] == i)
+        diag = values[k];
+      sum += values[k];
+    }
+    CHECK(d.array()[i] == Catch::Approx(diag).margin(1e-12));
+    CHECK(l.array()[i] == Catch::Approx(sum).margin(1e-12));
+  }
+
+  // Threaded assembly
+  la::Vector<double> d1(map, 1);
+  d1.set(0.0);
+  fem::assemble_diagonal(d1, a, bcs, 3.0, 3);
+  for (std::size_t i = 0; i < d.array().size(); ++i)
+    CHECK(d1.array()[i] == Catch::Approx(d.array()[i]).margin(1e-12));
+}
@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly of ensembles of coefficient samples
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Ensemble assembly", "[assemble_ensemble]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa = std::make_shared<fem::Constant<double>>(1.5);
+
+  // Samples of the coefficient f
+  constexpr std::size_t ns = 5;
+  std::vector<std::shared_ptr<const fem::Function<double>>> f;
+  for (std::size_t s = 0; s < ns; ++s)
+  {
+    auto fs = std::make_shared<fem::Function<double>>(V);
+    fs->interpolate(
+        [s](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+        {
+          std::vector<double> fx;
+          for (std::size_t p = 0; p < x.extent(1); ++p)
+            fx.push_back(1 + s * x(0, p) * x(1, p) - x(2, p));
+          return {fx, {fx.size()}};
+        });
+    f.push_back(fs);
+  }
+
+  // Linear form with a cell and an exterior facet integral
+  fem::Form<double> L = fem::create_form<double, double>(
+      *form_poisson_L, {V}, {{"f", f[0]}}, {{"kappa", kappa}}, {}, {});
+  std::vector<std::vector<std::shared_ptr<const fem::Function<double>>>>
+      samples;
+  for (auto& fs : f)
+    samples.push_back({fs});
+
+  auto map = V->dofmap()->index_map;
+  const std::size_t n = map->size_local() + map->num_ghosts();
+  std::vector<double> b(ns * n, 0);
+  fem::assemble_vector_ensemble(std::span<double>(b), L, samples);
+  for (std::size_t s = 0; s < ns; ++s)
+  {
+    fem::Form<double> Ls = fem::create_form<double, double>(
+        *form_poisson_L, {V}, {{"f", f[s]}}, {{"kappa", kappa}}, {}, {});
+    la::Vector<double> bs(map, 1);
+    bs.set(0.0);
+    fem::assemble_vector(bs.mutable_array(), Ls);
+    for (std::size_t i = 0; i < n; ++i)
+      CHECK(b[i * ns + s] == Catch::Approx(bs.array()[i]).margin(1e-12));
+  }
+
+  // Bilinear form, with the matrices sharing the sparsity pattern
+  fem::Form<double> a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), a, {});
+
+  std::vector<double> values(ns * A.values().size(), 0);
+  fem::assemble_matrix_ensemble(
+      std::span<double>(values), A, a,
+      std::vector<std::vector<std::shared_ptr<const fem::Function<double>>>>(
+          ns),
+      {});
+  for (std::size_t s = 0; s < ns; ++s)
+  {
+    for (std::size_t p = 0; p < A.values().size(); ++p)
+      CHECK(values[p * ns + s] == Catch::Approx(A.values()[p]).margin(1e-12));
+  }
+}
@@ -0,0 +1,159 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for fused assembly of several forms and batched assembly
+// of functionals
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/ScalarReduction.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Fused assembly", "[assemble_fused]")
+{
+  std::size_t block_size = GENERATE(1, 64, 10000);
+
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 6},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(1.5);
+  auto f = std::make_shared<fem::Function<double>>(V);
+  f->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> fx;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          fx.push_back(1 + x(0, p) * x(1, p) - x(2, p));
+        return {fx, {fx.size()}};
+      });
+  fem::Form<double> a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+  fem::Form<double> L = fem::create_form<double, double>(
+      *form_poisson_L, {V}, {{"f", f}}, {{"kappa", kappa}}, {}, {});
+  fem::Form<double> M = fem::create_form<double, double>(
+      *form_poisson_M, {}, {{"f", f}}, {{"kappa", kappa}}, {}, {});
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+
+  // Reference: assemble each form separately
+  la::MatrixCSR<double> A0(sp);
+  fem::assemble_matrix(A0.mat_add_values(), a, {});
+  la::Vector<double> b0(V->dofmap()->index_map, 1);
+  b0.set(0.0);
+  fem::assemble_vector(b0.mutable_array(), L);
+  double m0 = fem::assemble_scalar(M);
+
+  // Assemble all forms in one pass
+  la::MatrixCSR<double> A1(sp);
+  la::Vector<double> b1(V->dofmap()->index_map, 1);
+  b1.set(0.0);
+  double m1 = fem::assemble_fused(A1.mat_add_values(), &a, {},
+                                  b1.mutable_array(), &L, &M, block_size);
+
+  CHECK(m1 == Catch::Approx(m0).margin(1e-12));
+  for (std::size_t i = 0; i < b0.array().size(); ++i)
+    CHECK(b1.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+  REQUIRE(A1.values().size() == A0.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+
+  // Only the vector and the functional
+  la::Vector<double> b2(V->dofmap()->index_map, 1);
+  b2.set(0.0);
+  double m2 = fem::assemble_fused<double, double>(
+      [](auto, auto, auto) { return 0; }, nullptr, {}, b2.mutable_array(), &L,
+      &M, block_size);
+  CHECK(m2 == Catch::Approx(m0).margin(1e-12));
+  for (std::size_t i = 0; i < b0.array().size(); ++i)
+    CHECK(b2.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+}
+
+TEST_CASE("Batched functional assembly", "[assemble_fused]")
+{
+  std::size_t block_size = GENERATE(1, 64, 10000);
+
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 5, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto f0 = std::make_shared<fem::Function<double>>(V);
+  f0->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> fx;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          fx.push_back(1 + x(0, p) * x(1, p) - x(2, p));
+        return {fx, {fx.size()}};
+      });
+  auto f1 = std::make_shared<fem::Function<double>>(V);
+  f1->x()->set(2.0);
+
+  // Functionals with the same cells and different data
+  auto kappa0 = std::make_shared<fem::Constant<double>>(1.5);
+  auto kappa1 = std::make_shared<fem::Constant<double>>(-0.5);
+  fem::Form<double> M0 = fem::create_form<double, double>(
+      *form_poisson_M, {}, {{"f", f0}}, {{"kappa", kappa0}}, {}, {});
+  fem::Form<double> M1 = fem::create_form<double, double>(
+      *form_poisson_M, {}, {{"f", f1}}, {{"kappa", kappa1}}, {}, {});
+  fem::Form<double> M2 = fem::create_form<double, double>(
+      *form_poisson_M, {}, {{"f", f1}}, {{"kappa", kappa0}}, {}, {});
+
+  std::vector<double> values = fem::assemble_scalars<double, double>(
+      {std::cref(M0), std::cref(M1), std::cref(M2)}, block_size);
+  REQUIRE(values.size() == 3);
+  CHECK(values[0] == Catch::Approx(fem::assemble_scalar(M0)).margin(1e-12));
+  CHECK(values[1] == Catch::Approx(fem::assemble_scalar(M1)).margin(1e-12));
+  CHECK(values[2] == Catch::Approx(fem::assemble_scalar(M2)).margin(1e-12));
+
+  // Sum across processes with one reduction
+  std::vector<double> ref(values.size());
+  MPI_Allreduce(values.data(), ref.data(), values.size(), MPI_DOUBLE,
+                MPI_SUM, mesh->comm());
+  fem::ScalarReduction<double> sum(mesh->comm(), values);
+  std::span<const double> global = sum.wait();
+  CHECK(sum.test());
+  REQUIRE(global.size() == ref.size());
+  for (std::size_t i = 0; i < ref.size(); ++i)
+    CHECK(global[i] == Catch::Approx(ref[i]).margin(1e-12));
+}
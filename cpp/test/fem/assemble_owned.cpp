@@ -0,0 +1,116 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for owner-computes matrix assembly
+
+#include "poisson.h"
+#include <array>
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Entries of a local row of a matrix, with global column indices
+std::map<std::int64_t, double> row_entries(const la::MatrixCSR<double>& A,
+                                           std::int32_t row)
+{
+  auto col_map = A.index_map(1);
+  std::map<std::int64_t, double> entries;
+  for (std::int64_t k = A.row_ptr()[row]; k < A.row_ptr()[row + 1]; ++k)
+  {
+    std::int32_t c = A.cols()[k];
+    std::array<std::int64_t, 1> global;
+    col_map->local_to_global(std::span(&c, 1), global);
+    entries[global[0]] += A.values()[k];
+  }
+  return entries;
+}
+} // namespace
+
+TEST_CASE("Owner-computes matrix assembly", "[assemble_owned]")
+{
+  // Each process needs all cells attached to its owned vertices
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 5, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::shared_vertex)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  fem::Form<double> a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+
+  // Boundary condition on the facets at x = 0
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, 2,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1.0e-8;
+        return marker;
+      });
+  std::vector bdofs = fem::locate_dofs_topological(
+      *V->mesh()->topology_mutable(), *V->dofmap(), 2, facets);
+  fem::DirichletBC<double> bc(0.0, bdofs, V);
+  const std::vector<std::reference_wrapper<const fem::DirichletBC<double>>>
+      bcs = {bc};
+
+  // Reference: standard assembly with a reverse scatter
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), a, bcs);
+  A.scatter_rev();
+
+  la::SparsityPattern sp_owned = fem::create_sparsity_pattern_owned(a);
+  sp_owned.finalize();
+  la::MatrixCSR<double> B(sp_owned);
+  fem::assemble_matrix_owned(B.mat_add_values(), a, bcs);
+
+  // Ghost rows are not stored
+  auto map = V->dofmap()->index_map;
+  const std::int32_t num_owned = map->size_local();
+  CHECK(B.row_ptr()[num_owned] == B.row_ptr().back());
+
+  for (std::int32_t i = 0; i < num_owned; ++i)
+  {
+    std::map<std::int64_t, double> a_row = row_entries(A, i);
+    std::map<std::int64_t, double> b_row = row_entries(B, i);
+    for (auto [col, value] : a_row)
+      CHECK(b_row[col] == Catch::Approx(value).margin(1e-12));
+    for (auto [col, value] : b_row)
+      CHECK(a_row[col] == Catch::Approx(value).margin(1e-12));
+  }
+}
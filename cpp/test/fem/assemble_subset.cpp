@@ -0,0 +1,115 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly over a subset of cells
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Assembly over a subset of cells", "[assemble_subset]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 5, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto f = std::make_shared<fem::Function<double>>(V);
+  f->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> fx;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          fx.push_back(x(0, p) - 2 * x(1, p) * x(2, p));
+        return {fx, {fx.size()}};
+      });
+  fem::Form<double> a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+  fem::Form<double> L = fem::create_form<double, double>(
+      *form_poisson_L, {V}, {{"f", f}}, {{"kappa", kappa}}, {}, {});
+
+  // Split the cells into two sets
+  auto cell_map = mesh->topology()->index_map(3);
+  std::vector<std::int32_t> cells(cell_map->size_local()
+                                  + cell_map->num_ghosts());
+  std::iota(cells.begin(), cells.end(), 0);
+  std::span<const std::int32_t> cells0
+      = std::span(cells).first(cells.size() / 3);
+  std::span<const std::int32_t> cells1
+      = std::span(cells).subspan(cells.size() / 3);
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+
+  // Reference: assemble over all cells
+  la::MatrixCSR<double> A0(sp);
+  fem::assemble_matrix(A0.mat_add_values(), a, {});
+  la::Vector<double> b0(V->dofmap()->index_map, 1);
+  b0.set(0.0);
+  fem::assemble_vector(b0.mutable_array(), L);
+
+  // Sum of the two subsets
+  la::MatrixCSR<double> A1(sp);
+  fem::assemble_matrix_subset(A1.mat_add_values(), a, cells0, {});
+  fem::assemble_matrix_subset(A1.mat_add_values(), a, cells1, {});
+  la::Vector<double> b1(V->dofmap()->index_map, 1);
+  b1.set(0.0);
+  fem::assemble_vector_subset(b1.mutable_array(), L, cells0);
+  fem::assemble_vector_subset(b1.mutable_array(), L, cells1);
+
+  REQUIRE(A1.values().size() == A0.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+  for (std::size_t i = 0; i < b0.array().size(); ++i)
+    CHECK(b1.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+
+  // Replace the contributions of a subset after a change of the
+  // coefficients
+  fem::assemble_matrix_subset(A1.mat_add_values(), a, cells0, {}, -1.0);
+  fem::assemble_vector_subset(b1.mutable_array(), L, cells0, -1.0);
+  kappa->value = {3.0};
+  fem::assemble_matrix_subset(A1.mat_add_values(), a, cells0, {});
+  fem::assemble_vector_subset(b1.mutable_array(), L, cells0);
+
+  la::MatrixCSR<double> A2(sp);
+  fem::assemble_matrix_subset(A2.mat_add_values(), a, cells0, {});
+  la::Vector<double> b2(V->dofmap()->index_map, 1);
+  b2.set(0.0);
+  fem::assemble_vector_subset(b2.mutable_array(), L, cells0);
+  kappa->value = {2.0};
+  fem::assemble_matrix_subset(A2.mat_add_values(), a, cells1, {});
+  fem::assemble_vector_subset(b2.mutable_array(), L, cells1);
+
+  for (std::size_t i = 0; i < A2.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A2.values()[i]).margin(1e-12));
+  for (std::size_t i = 0; i < b2.array().size(); ++i)
+    CHECK(b1.array()[i] == Catch::Approx(b2.array()[i]).margin(1e-12));
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for vector assembly
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <dolfinx/fem/AsyncAssembly.h>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Overlapped vector assembly", "[assemble_vector]")
+{
+  auto ghost_mode = GENERATE(mesh::GhostMode::none, mesh::GhostMode::shared_facet);
+  auto part = mesh::create_cell_partitioner(ghost_mode);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {6, 5, 4},
+      mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto f = std::make_shared<fem::Function<double>>(V);
+  f->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> fx;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          fx.push_back(std::sin(x(0, p)) + x(1, p) * x(2, p));
+        return {fx, {fx.size()}};
+      });
+  fem::Form<double> L = fem::create_form<double, double>(
+      *form_poisson_L, {V}, {{"f", f}}, {{"kappa", kappa}}, {}, {});
+
+  // Reference: assemble and then scatter
+  la::Vector<double> b0(V->dofmap()->index_map, 1);
+  b0.set(0.0);
+  fem::assemble_vector(b0.mutable_array(), L);
+  b0.scatter_rev(std::plus<double>());
+
+  la::Vector<double> b1(V->dofmap()->index_map, 1);
+  b1.set(0.0);
+  fem::assemble_vector_overlap(b1, L);
+
+  const std::int32_t size_local = V->dofmap()->index_map->size_local();
+  for (std::int32_t i = 0; i < size_local; ++i)
+    CHECK(b1.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+
+  // Asynchronous assembly, with the scatter as a continuation
+  la::Vector<double> b2(V->dofmap()->index_map, 1);
+  b2.set(0.0);
+  {
+    fem::AsyncVectorAssembly<double> assembly
+        = fem::assemble_vector_async(b2, L);
+    assembly.wait();
+  }
+  for (std::int32_t i = 0; i < size_local; ++i)
+    CHECK(b2.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+}
+
+TEST_CASE("Assembly with cell coefficients packed during assembly",
+          "[assemble_vector]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {8, 6, 5},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto f = std::make_shared<fem::Function<double>>(V);
+  f->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> fx;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          fx.push_back(x(0, p) * x(0, p) - x(1, p) + 2 * x(2, p));
+        return {fx, {fx.size()}};
+      });
+  fem::Form<double> L = fem::create_form<double, double>(
+      *form_poisson_L, {V}, {{"f", f}}, {{"kappa", kappa}}, {}, {});
+  const std::vector<double> constants = fem::pack_constants(L);
+
+  // Reference: coefficients packed for all cells before assembly
+  auto coeffs0 = fem::allocate_coefficient_storage(L);
+  fem::pack_coefficients(L, coeffs0);
+  la::Vector<double> b0(V->dofmap()->index_map, 1);
+  b0.set(0.0);
+  fem::assemble_vector(b0.mutable_array(), L, std::span(constants),
+                       fem::make_coefficients_span(coeffs0));
+
+  // Cell integral coefficients packed in blocks during assembly
+  auto coeffs1 = fem::allocate_coefficient_storage(L, true);
+  CHECK(coeffs1.at({fem::IntegralType::cell, -1}).first.empty());
+  fem::pack_coefficients(L, coeffs1);
+  la::Vector<double> b1(V->dofmap()->index_map, 1);
+  b1.set(0.0);
+  fem::assemble_vector(b1.mutable_array(), L, std::span(constants),
+                       fem::make_coefficients_span(coeffs1));
+
+  for (std::size_t i = 0; i < b0.array().size(); ++i)
+    CHECK(b1.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for location of boundary condition dofs
+
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/DirichletBC.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Locate dofs", "[dirichletbc]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {12, 9}, mesh::CellType::triangle));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::triangle, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto e = std::make_shared<fem::FiniteElement<double>>(
+      element, std::vector<std::size_t>{2});
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(mesh, e));
+
+  auto marker = [](auto x)
+  {
+    std::vector<std::int8_t> marked(x.extent(1), false);
+    for (std::size_t p = 0; p < x.extent(1); ++p)
+      marked[p] = std::abs(x(0, p)) < 1.0e-8;
+    return marked;
+  };
+
+  // Threaded and serial topological location give the same dofs
+  std::vector facets = mesh::locate_entities_boundary(*mesh, 1, marker);
+  auto topology = mesh->topology_mutable();
+  topology->create_connectivity(1, 2);
+  topology->create_connectivity(2, 1);
+  std::vector dofs0 = fem::locate_dofs_topological(*topology, *V->dofmap(),
+                                                   1, facets, true, 1);
+  std::vector dofs1 = fem::locate_dofs_topological(*topology, *V->dofmap(),
+                                                   1, facets, true, 3);
+  CHECK(dofs0 == dofs1);
+
+  auto V0 = std::make_shared<fem::FunctionSpace<double>>(V->sub({0}));
+  auto [V0c, map] = V0->collapse();
+  auto sdofs0 = fem::locate_dofs_topological(
+      *topology, {*V0->dofmap(), *V0c.dofmap()}, 1, facets, true, 1);
+  auto sdofs1 = fem::locate_dofs_topological(
+      *topology, {*V0->dofmap(), *V0c.dofmap()}, 1, facets, true, 4);
+  CHECK(sdofs0 == sdofs1);
+
+  // Geometrical location restricted to the cells of the vertices on the
+  // boundary
+  std::vector vertices = mesh::locate_entities(*mesh, 0, marker);
+  topology->create_connectivity(0, 2);
+  std::vector<std::int32_t> cells
+      = mesh::compute_incident_entities(*topology, vertices, 0, 2);
+  std::vector gdofs0 = fem::locate_dofs_geometrical(V0c, marker);
+  std::vector gdofs1 = fem::locate_dofs_geometrical(
+      V0c, marker, std::span<const std::int32_t>(cells));
+  CHECK(gdofs0 == gdofs1);
+}
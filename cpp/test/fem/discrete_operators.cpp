@@ -0,0 +1,151 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for discrete operators
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/discreteoperators.h>
+#include <dolfinx/fem/sparsitybuild.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Check that two operators give the same product on the owned rows
+void check_mult(la::MatrixCSR<double>& A0, la::MatrixCSR<double>& A1)
+{
+  // Vectors with the same owned entries. The ghost entries are updated
+  // by MatrixCSR::mult.
+  auto create_x = [](auto& A)
+  {
+    la::Vector<double> x(A.index_map(1), A.block_size()[1]);
+    const std::int64_t offset
+        = A.index_map(1)->local_range()[0] * A.block_size()[1];
+    std::span<double> _x = x.mutable_array();
+    for (std::int32_t i = 0;
+         i < A.index_map(1)->size_local() * A.block_size()[1]; ++i)
+    {
+      _x[i] = ((offset + 7 * i) % 13) - 6.0;
+    }
+    return x;
+  };
+  la::Vector<double> x0 = create_x(A0);
+  la::Vector<double> x1 = create_x(A1);
+  la::Vector<double> y0(A0.index_map(0), A0.block_size()[0]);
+  la::Vector<double> y1(A1.index_map(0), A1.block_size()[0]);
+  y0.set(0.0);
+  y1.set(0.0);
+  A0.mult(x0, y0);
+  A1.mult(x1, y1);
+
+  const std::int32_t n = A0.index_map(0)->size_local() * A0.block_size()[0];
+  for (std::int32_t i = 0; i < n; ++i)
+    CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-12));
+}
+
+// Create the operator matrix using the insertion interface
+la::MatrixCSR<double> create_matrix(const fem::FunctionSpace<double>& V0,
+                                    const fem::FunctionSpace<double>& V1,
+                                    auto&& build)
+{
+  auto mesh = V0.mesh();
+  la::SparsityPattern sp(
+      mesh->comm(), {V1.dofmap()->index_map, V0.dofmap()->index_map},
+      {V1.dofmap()->index_map_bs(), V0.dofmap()->index_map_bs()});
+  auto map = mesh->topology()->index_map(mesh->topology()->dim());
+  std::vector<std::int32_t> c(map->size_local());
+  std::iota(c.begin(), c.end(), 0);
+  fem::sparsitybuild::cells(sp, {c, c}, {*V1.dofmap(), *V0.dofmap()});
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  build(A);
+  return A;
+}
+} // namespace
+
+TEST_CASE("Discrete operators", "[discrete_operators]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {3, 4, 2},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+
+  auto e_p1 = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto e_p2 = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto e_n1 = basix::create_element<double>(
+      basix::element::family::N1E, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::legendre,
+      basix::element::dpc_variant::unset, false);
+  auto create_space = [&mesh](auto& e)
+  {
+    return fem::create_functionspace<double>(
+        mesh, std::make_shared<fem::FiniteElement<double>>(e));
+  };
+  fem::FunctionSpace<double> P1 = create_space(e_p1);
+  fem::FunctionSpace<double> P2 = create_space(e_p2);
+  fem::FunctionSpace<double> N1 = create_space(e_n1);
+
+  SECTION("gradient")
+  {
+    la::MatrixCSR<double> G0 = create_matrix(
+        P1, N1,
+        [&](auto& A)
+        {
+          fem::discrete_gradient<double>(
+              *mesh->topology_mutable(), {*P1.element(), *P1.dofmap()},
+              {*N1.element(), *N1.dofmap()}, A.mat_set_values());
+        });
+    for (int num_threads : {1, 3})
+    {
+      la::MatrixCSR<double> G1
+          = fem::create_discrete_gradient<double>(P1, N1, num_threads);
+
+      // Two non-zeros of magnitude one per edge
+      auto edge_map = mesh->topology()->index_map(1);
+      CHECK(G1.num_owned_rows() == edge_map->size_local());
+      CHECK(G1.row_ptr()[G1.num_owned_rows()]
+            == 2 * edge_map->size_local());
+      CHECK(G1.squared_norm()
+            == Catch::Approx(2.0 * edge_map->size_global()));
+      check_mult(G0, G1);
+    }
+  }
+
+  SECTION("interpolation")
+  {
+    la::MatrixCSR<double> A0 = create_matrix(
+        P1, P2,
+        [&](auto& A)
+        {
+          fem::interpolation_matrix<double, double>(P1, P2,
+                                                    A.mat_set_values());
+        });
+    for (int num_threads : {1, 3})
+    {
+      la::MatrixCSR<double> A1
+          = fem::create_interpolation_matrix<double>(P1, P2, num_threads);
+      CHECK(A1.num_owned_rows() == P2.dofmap()->index_map->size_local());
+      check_mult(A0, A1);
+    }
+  }
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Precomputed DOF transformations", "[fem][dof_transformations]")
+{
+  auto [family, cell_type] = GENERATE(
+      std::pair(basix::element::family::N1E, mesh::CellType::triangle),
+      std::pair(basix::element::family::N1E, mesh::CellType::tetrahedron),
+      std::pair(basix::element::family::N1E, mesh::CellType::hexahedron),
+      std::pair(basix::element::family::RT, mesh::CellType::tetrahedron));
+
+  auto e = basix::create_element<double>(
+      family, mesh::cell_type_to_basix_type(cell_type), 3,
+      basix::element::lagrange_variant::legendre,
+      basix::element::dpc_variant::legendre, false);
+  fem::FiniteElement<double> element(e);
+  REQUIRE(element.needs_dof_transformations());
+
+  const int tdim = mesh::cell_dim(cell_type);
+  const int num_edges = mesh::cell_num_entities(cell_type, 1);
+  const int num_faces = tdim == 3 ? mesh::cell_num_entities(cell_type, 2) : 0;
+  const int num_rotations = cell_type == mesh::CellType::hexahedron ? 4 : 3;
+
+  std::mt19937 engine(3);
+  std::uniform_real_distribution<double> value(-1, 1);
+  std::uniform_int_distribution<int> bit(0, 1), rotation(0, num_rotations - 1);
+
+  const int dim = e.dim();
+  const int n = 3;
+  for (int sample = 0; sample < 50; ++sample)
+  {
+    // Random, but valid, cell permutation data
+    std::uint32_t cell_info = 0;
+    for (int f = 0; f < num_faces; ++f)
+    {
+      cell_info |= bit(engine) << (3 * f);
+      cell_info |= rotation(engine) << (3 * f + 1);
+    }
+    for (int i = 0; i < num_edges; ++i)
+      cell_info |= bit(engine) << (3 * num_faces + i);
+
+    std::vector<double> data(dim * n);
+    std::ranges::generate(data, [&]() { return value(engine); });
+
+    auto check = [&](auto apply, auto apply_basix)
+    {
+      std::vector<double> u = data, v = data;
+      apply(std::span(u));
+      apply_basix(std::span(v));
+      for (std::size_t i = 0; i < u.size(); ++i)
+        CHECK(u[i] == Catch::Approx(v[i]).margin(1e-12));
+    };
+
+    check([&](auto u) { element.T_apply(u, cell_info, n); },
+          [&](auto u) { e.T_apply(u, n, cell_info); });
+    check([&](auto u) { element.Tt_apply(u, cell_info, n); },
+          [&](auto u) { e.Tt_apply(u, n, cell_info); });
+    check([&](auto u) { element.Tinv_apply(u, cell_info, n); },
+          [&](auto u) { e.Tinv_apply(u, n, cell_info); });
+    check([&](auto u) { element.Tt_inv_apply(u, cell_info, n); },
+          [&](auto u) { e.Tt_inv_apply(u, n, cell_info); });
+    check([&](auto u) { element.T_apply_right(u, cell_info, n); },
+          [&](auto u) { e.T_apply_right(u, n, cell_info); });
+    check([&](auto u) { element.Tt_apply_right(u, cell_info, n); },
+          [&](auto u) { e.Tt_apply_right(u, n, cell_info); });
+    check([&](auto u) { element.Tinv_apply_right(u, cell_info, n); },
+          [&](auto u) { e.Tinv_apply_right(u, n, cell_info); });
+    check([&](auto u) { element.Tt_inv_apply_right(u, cell_info, n); },
+          [&](auto u) { e.Tt_inv_apply_right(u, n, cell_info); });
+  }
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for dofmap construction
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Threaded dofmap construction", "[dofmap]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 5},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::shared_facet)));
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::tetrahedron, 3,
+          basix::element::lagrange_variant::gll_warped,
+          basix::element::dpc_variant::unset, false));
+  fem::ElementDofLayout layout = fem::create_element_dof_layout(*element);
+
+  using reorder_fn_t = std::function<std::vector<int>(
+      const graph::AdjacencyList<std::int32_t>&)>;
+  for (reorder_fn_t reorder_fn :
+       {reorder_fn_t(nullptr), reorder_fn_t(graph::reorder_gps),
+        reorder_fn_t(graph::reorder_rcm)})
+  {
+    fem::DofMap dofmap0 = fem::create_dofmap(
+        mesh->comm(), layout, *mesh->topology_mutable(), nullptr, reorder_fn);
+    for (int num_threads : {2, 3, 4})
+    {
+      fem::DofMap dofmap1
+          = fem::create_dofmap(mesh->comm(), layout, *mesh->topology_mutable(),
+                               nullptr, reorder_fn, num_threads);
+
+      // The threaded construction gives the same numbering
+      CHECK(dofmap1.index_map->size_local()
+            == dofmap0.index_map->size_local());
+      CHECK(dofmap1.index_map->ghosts() == dofmap0.index_map->ghosts());
+      auto map0 = dofmap0.map();
+      auto map1 = dofmap1.map();
+      REQUIRE(map1.extents() == map0.extents());
+      CHECK(std::equal(map1.data_handle(), map1.data_handle() + map1.size(),
+                       map0.data_handle()));
+    }
+  }
+}
+
+TEST_CASE("Discontinuous dofmap", "[dofmap]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {3, 4, 2},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::shared_facet)));
+  auto cell_map = mesh->topology()->index_map(3);
+  for (bool discontinuous : {false, true})
+  {
+    auto element = std::make_shared<fem::FiniteElement<double>>(
+        basix::create_element<double>(
+            basix::element::family::P, basix::cell::type::tetrahedron, 2,
+            basix::element::lagrange_variant::gll_warped,
+            basix::element::dpc_variant::unset, discontinuous));
+    fem::ElementDofLayout layout = fem::create_element_dof_layout(*element);
+    fem::DofMap dofmap
+        = fem::create_dofmap(mesh->comm(), layout, *mesh->topology_mutable(),
+                             nullptr, graph::reorder_gps);
+    CHECK(dofmap.contiguous() == discontinuous);
+    if (!discontinuous)
+      continue;
+
+    // The dofs of each cell are numbered contiguously, and owned and
+    // ghosted with the cell
+    const std::int64_t n = layout.num_dofs();
+    CHECK(dofmap.index_map->size_local() == cell_map->size_local() * n);
+    CHECK(dofmap.index_map->size_global() == cell_map->size_global() * n);
+    CHECK(dofmap.index_map->local_range()[0]
+          == cell_map->local_range()[0] * n);
+    REQUIRE(dofmap.index_map->num_ghosts() == cell_map->num_ghosts() * n);
+    for (std::int32_t i = 0; i < cell_map->num_ghosts(); ++i)
+    {
+      for (std::int64_t j = 0; j < n; ++j)
+      {
+        CHECK(dofmap.index_map->ghosts()[i * n + j]
+              == cell_map->ghosts()[i] * n + j);
+        CHECK(dofmap.index_map->owners()[i * n + j] == cell_map->owners()[i]);
+      }
+    }
+    auto map = dofmap.map();
+    for (std::size_t c = 0; c < map.extent(0); ++c)
+      for (std::size_t i = 0; i < map.extent(1); ++i)
+        CHECK(map(c, i) == static_cast<std::int32_t>(c * n + i));
+  }
+}
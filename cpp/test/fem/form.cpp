@@ -0,0 +1,184 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for fem::Form
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/IntegrationDomainCache.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Form entity maps", "[fem][form]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {8, 6}, mesh::CellType::triangle));
+  auto cell_map = mesh->topology()->index_map(2);
+  const std::int32_t num_cells
+      = cell_map->size_local() + cell_map->num_ghosts();
+
+  // Sub-mesh of the first half of the owned cells
+  std::vector<std::int32_t> cells(cell_map->size_local() / 2);
+  std::iota(cells.begin(), cells.end(), 0);
+  auto [submesh, sub_to_cell, v_map, g_map]
+      = mesh::create_submesh(*mesh, 2, cells);
+  auto msh = std::make_shared<mesh::Mesh<double>>(std::move(submesh));
+
+  // Map from the cells of the mesh to the cells of the sub-mesh
+  std::vector<std::int32_t> emap(num_cells, -1);
+  for (std::size_t c = 0; c < sub_to_cell.size(); ++c)
+    emap[sub_to_cell[c]] = c;
+
+  basix::FiniteElement e = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::triangle, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          msh, std::make_shared<fem::FiniteElement<double>>(e)));
+
+  auto kernel = [](double*, const double*, const double*, const double*,
+                   const int*, const std::uint8_t*) {};
+  std::map<fem::IntegralType, std::vector<fem::integral_data<double>>>
+      integrals;
+  integrals[fem::IntegralType::cell].emplace_back(0, kernel, cells,
+                                                  std::vector<int>{});
+  fem::Form<double> form(
+      {V}, std::move(integrals), {}, {}, false,
+      {{msh, std::span<const std::int32_t>(emap)}}, mesh);
+
+  // The entities in the sub-mesh are computed once, when the form is
+  // created
+  std::span<const std::int32_t> subcells
+      = form.domain(fem::IntegralType::cell, 0, *msh);
+  REQUIRE(subcells.size() == cells.size());
+  for (std::size_t i = 0; i < cells.size(); ++i)
+    CHECK(subcells[i] == emap[cells[i]]);
+  CHECK(form.domain(fem::IntegralType::cell, 0, *msh).data()
+        == subcells.data());
+
+  // The entities of the mesh of the form are not mapped
+  CHECK(form.domain(fem::IntegralType::cell, 0, *mesh).data()
+        == form.domain(fem::IntegralType::cell, 0).data());
+  CHECK_THROWS(form.domain(fem::IntegralType::cell, 1, *msh));
+}
+
+TEST_CASE("Form macro dofmaps", "[fem][form]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {6, 5},
+          mesh::CellType::triangle,
+          mesh::create_cell_partitioner(mesh::GhostMode::shared_facet)));
+  auto topology = mesh->topology_mutable();
+  topology->create_entities(1);
+  topology->create_connectivity(1, 2);
+  topology->create_connectivity(2, 1);
+
+  // Default interior facets are ordered by their first cell
+  std::shared_ptr<const std::vector<std::int32_t>> facets
+      = fem::integration_domain_cache().default_domain(
+          topology, fem::IntegralType::interior_facet);
+  for (std::size_t f = 4; f < facets->size(); f += 4)
+    CHECK((*facets)[f - 4] <= (*facets)[f]);
+
+  basix::FiniteElement e = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::triangle, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, true);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(e)));
+
+  auto kernel = [](double*, const double*, const double*, const double*,
+                   const int*, const std::uint8_t*) {};
+  std::map<fem::IntegralType, std::vector<fem::integral_data<double>>>
+      integrals;
+  integrals[fem::IntegralType::interior_facet].emplace_back(
+      -1, kernel, *facets, std::vector<int>{});
+  fem::Form<double> form({V, V}, std::move(integrals), {}, {}, false, {});
+
+  // The macro-element dofmap of a facet has the dofs of the first cell
+  // followed by the dofs of the second cell
+  for (int arg : {0, 1})
+  {
+    std::span<const std::int32_t> mdofs = form.macro_dofmap(-1, arg);
+    REQUIRE(mdofs.size() == facets->size() / 4 * 2 * 3);
+    for (std::size_t f = 0; f < facets->size() / 4; ++f)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        std::span<const std::int32_t> dofs
+            = V->dofmap()->cell_dofs((*facets)[4 * f + 2 * j]);
+        CHECK(std::ranges::equal(dofs, mdofs.subspan((2 * f + j) * 3, 3)));
+      }
+    }
+  }
+  CHECK(form.macro_dofmap(0, 0).empty());
+}
+
+TEST_CASE("Pack coefficients of another scalar type", "[fem][form]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<float>>(
+      mesh::create_rectangle<float>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                    {4, 3}, mesh::CellType::triangle));
+  basix::FiniteElement e = basix::create_element<float>(
+      basix::element::family::P, basix::cell::type::triangle, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<float>>(
+      fem::create_functionspace<float>(
+          mesh, std::make_shared<fem::FiniteElement<float>>(e)));
+
+  // The single precision coefficient defines the layout, and the data
+  // is read from the double precision Function
+  auto u32 = std::make_shared<fem::Function<float>>(V);
+  auto u64 = std::make_shared<fem::Function<double, float>>(V);
+  std::span<double> x = u64->x()->mutable_array();
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = 1.0 / 3.0 + i;
+
+  auto kernel = [](float*, const float*, const float*, const float*,
+                   const int*, const std::uint8_t*) {};
+  std::vector<std::int32_t> cells(mesh->topology()->index_map(2)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  std::map<fem::IntegralType, std::vector<fem::integral_data<float>>>
+      integrals;
+  integrals[fem::IntegralType::cell].emplace_back(0, kernel, cells,
+                                                  std::vector<int>{0});
+  fem::Form<float> form({}, std::move(integrals), {u32}, {}, false, {}, mesh);
+
+  auto coeffs = fem::allocate_coefficient_storage(form);
+  std::vector<std::shared_ptr<const fem::Function<double, float>>> u
+      = {u64};
+  fem::pack_coefficients(form, u, coeffs);
+  auto& [c, cstride] = coeffs.at({fem::IntegralType::cell, 0});
+  REQUIRE(cstride == 6);
+  REQUIRE(c.size() == cells.size() * cstride);
+  for (std::size_t i = 0; i < cells.size(); ++i)
+  {
+    auto dofs = V->dofmap()->cell_dofs(cells[i]);
+    for (std::size_t j = 0; j < dofs.size(); ++j)
+      CHECK(c[i * cstride + j] == static_cast<float>(x[dofs[j]]));
+  }
+}
@@ -8,6 +8,7 @@
 
 #include <basix/finite-element.h>
 
+#include <dolfinx/fem/DofMapCache.h>
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -29,3 +30,60 @@ TEST_CASE("Create Function Space (mismatch of elements)", "[functionspace]")
   CHECK_THROWS(fem::create_functionspace<double>(
       mesh, std::make_shared<fem::FiniteElement<double>>(element)));
 }
+
+TEST_CASE("Share dofmaps of identical elements", "[functionspace]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      dolfinx::mesh::create_rectangle<double>(MPI_COMM_WORLD,
+                                              {{{0, 0}, {1, 1}}}, {4, 3},
+                                              mesh::CellType::triangle));
+
+  auto create_element = [](int degree)
+  {
+    return std::make_shared<fem::FiniteElement<double>>(
+        basix::create_element<double>(
+            basix::element::family::P, basix::cell::type::triangle, degree,
+            basix::element::lagrange_variant::unset,
+            basix::element::dpc_variant::unset, false));
+  };
+
+  // Spaces with the same element share the dofmap
+  fem::FunctionSpace<double> V0
+      = fem::create_functionspace<double>(mesh, create_element(1));
+  fem::FunctionSpace<double> V1
+      = fem::create_functionspace<double>(mesh, create_element(1));
+  CHECK(V0.dofmap() == V1.dofmap());
+
+  fem::FunctionSpace<double> V2
+      = fem::create_functionspace<double>(mesh, create_element(2));
+  CHECK(V2.dofmap() != V0.dofmap());
+
+  // Collapsed subspaces share the dofmap
+  auto e = create_element(1);
+  auto W = fem::create_functionspace<double>(
+      mesh, std::make_shared<fem::FiniteElement<double>>(
+                std::vector<std::shared_ptr<const fem::FiniteElement<double>>>{
+                    e, e}));
+  auto [W0, dofs0] = W.sub({0}).collapse();
+  auto [W1, dofs1] = W.sub({0}).collapse();
+  CHECK(W0.dofmap() == W1.dofmap());
+  CHECK(dofs0 == dofs1);
+  auto [W2, dofs2] = W.sub({1}).collapse();
+  CHECK(W2.dofmap() != W0.dofmap());
+
+  CHECK(fem::dofmap_cache().size() > 0);
+  fem::dofmap_cache().clear();
+  CHECK(fem::dofmap_cache().size() == 0);
+  fem::FunctionSpace<double> V3
+      = fem::create_functionspace<double>(mesh, create_element(1));
+  CHECK(V3.dofmap() != V0.dofmap());
+
+  // The cache does not keep the dofmaps of destroyed spaces alive
+  std::weak_ptr<const fem::DofMap> dofmap;
+  {
+    fem::FunctionSpace<double> V4
+        = fem::create_functionspace<double>(mesh, create_element(3));
+    dofmap = V4.dofmap();
+  }
+  CHECK(dofmap.expired());
+}
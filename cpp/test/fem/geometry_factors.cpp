@@ -0,0 +1,117 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for assembly with precomputed cell geometry factors
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/GeometryFactors.h>
+#include <dolfinx/fem/sparsitybuild.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Geometry factors", "[geometry_factors]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {7, 5},
+          mesh::CellType::triangle,
+          mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::triangle, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  fem::GeometryFactors<double> g(mesh);
+  REQUIRE(g.stride() == 4);
+  CHECK(!g.update());
+
+  // Sum of cell areas
+  auto area = [&g]()
+  {
+    double a = 0;
+    for (std::size_t c = 0; c < g.cells().size(); ++c)
+      a += 0.5 * std::abs(g.factors(c)[0]);
+    double a_global = 0;
+    MPI_Allreduce(&a, &a_global, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return a_global;
+  };
+  CHECK(area() == Catch::Approx(1.0));
+
+  // P1 stiffness matrix: A_ij = |detJ| / 2 dphi_i^T G dphi_j, with
+  // dphi the reference basis function gradients
+  auto kernel = [](double* A, const double*, const double* g)
+  {
+    constexpr double dphi[3][2] = {{-1, -1}, {1, 0}, {0, 1}};
+    const double w = 0.5 * std::abs(g[0]);
+    for (int i = 0; i < 3; ++i)
+    {
+      const double Gd0 = g[1] * dphi[i][0] + g[2] * dphi[i][1];
+      const double Gd1 = g[2] * dphi[i][0] + g[3] * dphi[i][1];
+      for (int j = 0; j < 3; ++j)
+        A[3 * i + j] += w * (Gd0 * dphi[j][0] + Gd1 * dphi[j][1]);
+    }
+  };
+
+  auto stiffness = [&]()
+  {
+    la::SparsityPattern sp(
+        mesh->comm(), {V->dofmap()->index_map, V->dofmap()->index_map},
+        {1, 1});
+    fem::sparsitybuild::cells(sp, {g.cells(), g.cells()},
+                              {*V->dofmap(), *V->dofmap()});
+    sp.finalize();
+    auto A = std::make_shared<la::MatrixCSR<double>>(sp);
+    fem::assemble_matrix_geometry_factors<double>(
+        A->mat_add_values(), g, *V->dofmap(), *V->dofmap(), kernel,
+        std::span<const double>());
+    A->scatter_rev();
+    return A;
+  };
+
+  // (grad u, grad u) = 1 for u = x on the unit square
+  fem::Function<double> u(V);
+  u.interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          f.push_back(x(0, p));
+        return {f, {f.size()}};
+      });
+  la::Vector<double> y(V->dofmap()->index_map, 1);
+  y.set(0.0);
+  stiffness()->mult(*u.x(), y);
+  CHECK(la::inner_product(*u.x(), y) == Catch::Approx(1.0));
+
+  // Stretch the mesh in the x-direction. The same dof values are then
+  // u = x / 2 on [0, 2] x [0, 1], with (grad u, grad u) = 1 / 2.
+  std::span<double> x = mesh->geometry().x();
+  for (std::size_t i = 0; i < x.size(); i += 3)
+    x[i] *= 2.0;
+  CHECK(g.update());
+  CHECK(!g.update());
+  CHECK(area() == Catch::Approx(2.0));
+
+  y.set(0.0);
+  stiffness()->mult(*u.x(), y);
+  CHECK(la::inner_product(*u.x(), y) == Catch::Approx(0.5));
+}
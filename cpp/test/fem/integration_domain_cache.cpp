@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for fem::IntegrationDomainCache
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/IntegrationDomainCache.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Integration domain cache", "[fem][integration_domain_cache]")
+{
+  fem::IntegrationDomainCache cache;
+  {
+    auto mesh = std::make_shared<mesh::Mesh<double>>(
+        mesh::create_rectangle<double>(
+            MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {6, 5},
+            mesh::CellType::triangle,
+            mesh::create_cell_partitioner(mesh::GhostMode::shared_facet)));
+    auto topology = mesh->topology_mutable();
+    topology->create_entities(1);
+    topology->create_connectivity(1, 2);
+    topology->create_connectivity(2, 1);
+
+    // Default domains are computed once
+    auto cells = cache.default_domain(topology, fem::IntegralType::cell);
+    CHECK(cells->size() == std::size_t(topology->index_map(2)->size_local()));
+    CHECK(cache.default_domain(topology, fem::IntegralType::cell) == cells);
+
+    std::vector<std::int32_t> bfacets = mesh::exterior_facet_indices(*topology);
+    auto ext
+        = cache.default_domain(topology, fem::IntegralType::exterior_facet);
+    CHECK(*ext
+          == fem::compute_integration_domains(
+              fem::IntegralType::exterior_facet, *topology, bfacets));
+    CHECK(cache.default_domain(topology, fem::IntegralType::exterior_facet)
+          == ext);
+    CHECK(cache.size() == 2);
+
+    // Tagged domains are keyed on the tags and the value
+    std::vector<std::int32_t> values(bfacets.size(), 1);
+    for (std::size_t i = 0; i < values.size(); i += 2)
+      values[i] = 2;
+    mesh::MeshTags<std::int32_t> tags(topology, 1, bfacets, values);
+    auto ext1 = cache.domain(tags, fem::IntegralType::exterior_facet, 1);
+    auto ext2 = cache.domain(tags, fem::IntegralType::exterior_facet, 2);
+    CHECK(ext1->size() + ext2->size() == ext->size());
+    CHECK(*ext1
+          == fem::compute_integration_domains(
+              fem::IntegralType::exterior_facet, *topology, tags.find(1)));
+    CHECK(cache.domain(tags, fem::IntegralType::exterior_facet, 1) == ext1);
+
+    // Copies of tags share the entries
+    mesh::MeshTags<std::int32_t> tags_copy = tags;
+    CHECK(cache.domain(tags_copy, fem::IntegralType::exterior_facet, 2)
+          == ext2);
+    CHECK(cache.size() == 4);
+  }
+
+  // Entries of destroyed topologies are removed
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {2, 2}, mesh::CellType::quadrilateral));
+  auto cells = cache.default_domain(mesh->topology(), fem::IntegralType::cell);
+  CHECK(cells->size()
+        == std::size_t(mesh->topology()->index_map(2)->size_local()));
+  CHECK(cache.size() == 1);
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+}
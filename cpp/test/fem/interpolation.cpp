@@ -0,0 +1,269 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for thread-parallel, cached and matrix-based interpolation,
+// and interpolation of Expressions
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <algorithm>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Expression.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/InterpolationOperator.h>
+#include <dolfinx/fem/Interpolator.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh,
+             basix::element::family family, int degree,
+             std::vector<std::size_t> value_shape = {},
+             bool discontinuous = false)
+{
+  mesh::CellType cell_type = mesh->topology()->cell_type();
+  auto element = basix::create_element<double>(
+      family, mesh::cell_type_to_basix_type(cell_type), degree,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, discontinuous);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(
+                    element, value_shape.empty()
+                                 ? std::nullopt
+                                 : std::optional(value_shape))));
+}
+
+/// Check that interpolation with several threads gives the same
+/// coefficients as with a single thread
+template <typename F>
+void check_threads(fem::Function<double>& u, F interpolate)
+{
+  interpolate(u, 1);
+  std::vector<double> u0(u.x()->array().begin(), u.x()->array().end());
+  std::ranges::fill(u.x()->mutable_array(), 0);
+  interpolate(u, 3);
+  std::span<const double> u1 = u.x()->array();
+  REQUIRE(u0.size() == u1.size());
+  for (std::size_t i = 0; i < u0.size(); ++i)
+    CHECK(u1[i] == u0[i]);
+}
+} // namespace
+
+TEST_CASE("Threaded interpolation", "[interpolation]")
+{
+  auto cell_type
+      = GENERATE(mesh::CellType::triangle, mesh::CellType::quadrilateral);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {9, 7}, cell_type));
+
+  // Vector-valued field, quadratic if a = 1 and linear if a = 0
+  auto field = [](double a)
+  {
+    return [a](auto x)
+               -> std::pair<std::vector<double>, std::vector<std::size_t>>
+    {
+      std::vector<double> f(2 * x.extent(1));
+      for (std::size_t p = 0; p < x.extent(1); ++p)
+      {
+        f[p] = a * x(0, p) * x(0, p) + x(1, p);
+        f[x.extent(1) + p] = x(0, p) - 2 * a * x(1, p) * x(1, p);
+      }
+      return {f, {2, x.extent(1)}};
+    };
+  };
+  auto f = field(1);
+
+  // Blocked point evaluation element
+  auto V = create_space(mesh, basix::element::family::P, 2, {2});
+  fem::Function<double> u(V);
+  check_threads(u, [&f](auto& g, int n) { g.interpolate(f, n); });
+
+  // Piola mapped element
+  auto Q = create_space(mesh, basix::element::family::N1E, 2);
+  fem::Function<double> q(Q);
+  check_threads(q, [&f](auto& g, int n) { g.interpolate(f, n); });
+
+  // Same map, and different maps, for the elements of two Functions
+  auto W = create_space(mesh, basix::element::family::P, 1, {2});
+  fem::Function<double> w(W);
+  check_threads(w, [&u](auto& g, int n) { g.interpolate(u, n); });
+  check_threads(q, [&u](auto& g, int n) { g.interpolate(u, n); });
+
+  // A linear field is represented exactly by the P2 and the degree 2
+  // N1curl Functions, so interpolating one into the other is exact
+  u.interpolate(field(0), 3);
+  q.interpolate(field(0), 3);
+  fem::Function<double> v(V);
+  v.interpolate(q, 3);
+  std::span<const double> u_x = u.x()->array();
+  std::span<const double> v_x = v.x()->array();
+  for (std::size_t i = 0; i < u_x.size(); ++i)
+    CHECK(v_x[i] == Catch::Approx(u_x[i]).margin(1e-10));
+}
+
+TEST_CASE("Cached interpolation", "[interpolation]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {6, 5}, mesh::CellType::triangle));
+
+  // Vector-valued field
+  auto f = [](auto x)
+      -> std::pair<std::vector<double>, std::vector<std::size_t>>
+  {
+    std::vector<double> values(2 * x.extent(1));
+    for (std::size_t p = 0; p < x.extent(1); ++p)
+    {
+      values[p] = x(0, p) * x(1, p);
+      values[x.extent(1) + p] = x(0, p) * x(0, p) - x(1, p);
+    }
+    return {values, {2, x.extent(1)}};
+  };
+
+  auto check = [&mesh, &f](std::shared_ptr<fem::FunctionSpace<double>> V)
+  {
+    fem::Interpolator<double> interpolator(V);
+    fem::Function<double> u0(V), u1(V);
+    for (int step = 0; step < 2; ++step)
+    {
+      u0.interpolate(f);
+      interpolator.interpolate(u1, f, 2);
+      std::span<const double> u0_x = u0.x()->array();
+      std::span<const double> u1_x = u1.x()->array();
+      for (std::size_t i = 0; i < u0_x.size(); ++i)
+        CHECK(u1_x[i] == Catch::Approx(u0_x[i]).margin(1e-12));
+
+      // Deform the mesh, and update the cached geometry
+      for (double& x : mesh->geometry().x())
+        x += 0.1 * x * x;
+      interpolator.update_geometry();
+    }
+  };
+
+  // Blocked point evaluation element
+  check(create_space(mesh, basix::element::family::P, 2, {2}));
+
+  // Piola mapped element
+  check(create_space(mesh, basix::element::family::N1E, 2));
+}
+
+TEST_CASE("Interpolation operator", "[interpolation]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {5, 6}, mesh::CellType::quadrilateral));
+
+  // Check that the operator gives the same coefficients as
+  // Function::interpolate
+  auto check = [](auto V0, auto V1)
+  {
+    fem::InterpolationOperator<double> A(V0, V1, 2);
+    fem::Function<double> v(V0), u0(V1), u1(V1);
+    for (double t : {1.0, -0.5})
+    {
+      v.interpolate(
+          [t](auto x)
+              -> std::pair<std::vector<double>, std::vector<std::size_t>>
+          {
+            std::vector<double> f(2 * x.extent(1));
+            for (std::size_t p = 0; p < x.extent(1); ++p)
+            {
+              f[p] = t * x(0, p) * x(1, p);
+              f[x.extent(1) + p] = x(0, p) - t * x(1, p) * x(1, p);
+            }
+            return {f, {2, x.extent(1)}};
+          });
+      u0.interpolate(v);
+      A.apply(u1, v);
+      std::span<const double> u0_x = u0.x()->array();
+      std::span<const double> u1_x = u1.x()->array();
+      for (std::size_t i = 0; i < u0_x.size(); ++i)
+        CHECK(u1_x[i] == Catch::Approx(u0_x[i]).margin(1e-12));
+    }
+  };
+
+  // Same map
+  check(create_space(mesh, basix::element::family::P, 2, {2}),
+        create_space(mesh, basix::element::family::P, 1, {2}));
+
+  // Different maps
+  check(create_space(mesh, basix::element::family::N1E, 2),
+        create_space(mesh, basix::element::family::P, 1, {2}, true));
+}
+
+TEST_CASE("Expression interpolation into quadrature space", "[interpolation]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {6, 5}, mesh::CellType::triangle));
+  const int tdim = mesh->topology()->dim();
+  auto cell_map = mesh->topology()->index_map(tdim);
+  std::vector<std::int32_t> cells(cell_map->size_local()
+                                  + cell_map->num_ghosts());
+  std::iota(cells.begin(), cells.end(), 0);
+
+  // Vector-valued quadrature space
+  std::vector<double> X
+      = {1.0 / 6, 1.0 / 6, 2.0 / 3, 1.0 / 6, 1.0 / 6, 2.0 / 3};
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(
+                    mesh::CellType::triangle, X,
+                    std::array<std::size_t, 2>{3, 2},
+                    std::vector<std::size_t>{2})));
+
+  // Expression that depends on the cell geometry and the point
+  auto c = std::make_shared<fem::Constant<double>>(3.0);
+  auto kernel = [](double* A, const double*, const double* w, const double* x,
+                   const int*, const std::uint8_t*)
+  {
+    for (int p = 0; p < 3; ++p)
+    {
+      A[2 * p] = x[3 * p] + x[3 * p + 1];
+      A[2 * p + 1] = w[0] * (p + 1) * x[3 * ((p + 1) % 3)];
+    }
+  };
+  fem::Expression<double> e({}, {c}, X, {3, 2}, kernel, {2});
+
+  // Values of the Expression in the dofmap order
+  std::vector<double> values(cells.size() * 6);
+  e.eval(*mesh, cells, values, {cells.size(), 6});
+  fem::Function<double> u(V);
+  std::vector<double> u_ref(u.x()->array().size(), 0);
+  for (std::size_t i = 0; i < cells.size(); ++i)
+  {
+    std::span<const std::int32_t> dofs = V->dofmap()->cell_dofs(cells[i]);
+    for (std::size_t j = 0; j < dofs.size(); ++j)
+      for (int k = 0; k < 2; ++k)
+        u_ref[2 * dofs[j] + k] = values[6 * i + 2 * j + k];
+  }
+
+  for (int num_threads : {1, 3})
+  {
+    std::ranges::fill(u.x()->mutable_array(), 0);
+    u.interpolate(e, num_threads);
+    std::span<const double> u_x = u.x()->array();
+    REQUIRE(u_x.size() == u_ref.size());
+    for (std::size_t i = 0; i < u_x.size(); ++i)
+      CHECK(u_x[i] == u_ref[i]);
+  }
+}
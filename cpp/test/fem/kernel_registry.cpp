@@ -0,0 +1,110 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the registry of kernel variants
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/KernelRegistry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Kernel variant registry", "[fem][kernel_registry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {8, 8}, mesh::CellType::triangle));
+  std::vector<std::int32_t> cells(
+      mesh->topology()->index_map(2)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+
+  // Two variants of a functional kernel, one of which does redundant
+  // work
+  int num_fast = 0, num_slow = 0;
+  auto fast = [&num_fast](double* A, const double*, const double*,
+                          const double*, const int*, const std::uint8_t*)
+  {
+    ++num_fast;
+    A[0] += 1;
+  };
+  auto slow = [&num_slow](double* A, const double*, const double*,
+                          const double* x, const int*, const std::uint8_t*)
+  {
+    ++num_slow;
+    volatile double s = 0;
+    for (int i = 0; i < 20000; ++i)
+      s = s + x[i % 9];
+    A[0] += 1;
+  };
+
+  std::map<fem::IntegralType, std::vector<fem::integral_data<double>>>
+      integrals;
+  integrals[fem::IntegralType::cell].emplace_back(-1, slow, cells,
+                                                  std::vector<int>{});
+  fem::Form<double> M({}, std::move(integrals), {}, {}, false, {}, mesh);
+
+  fem::KernelRegistry<double> registry;
+  registry.add(fem::IntegralType::cell, -1, "slow", slow);
+  registry.add(fem::IntegralType::cell, -1, "fast", fast);
+  CHECK_THROWS(registry.add(fem::IntegralType::cell, -1, "fast", fast));
+  CHECK_THROWS(registry.add(fem::IntegralType::cell, -1, "a b", fast));
+  CHECK(registry.variants(fem::IntegralType::cell, -1)
+        == std::vector<std::string>{"slow", "fast"});
+  CHECK(registry.variants(fem::IntegralType::cell, 0).empty());
+  CHECK(!registry.choice("M", fem::IntegralType::cell, -1));
+
+  // The fastest variant becomes the kernel of the form
+  auto chosen = registry.tune(M, "M", 32, 2);
+  REQUIRE(chosen.size() == 1);
+  CHECK(chosen.at({fem::IntegralType::cell, -1}) == "fast");
+  CHECK(registry.choice("M", fem::IntegralType::cell, -1) == "fast");
+  num_fast = 0;
+  double A = 0;
+  M.kernel(fem::IntegralType::cell, -1)(&A, nullptr, nullptr, nullptr,
+                                        nullptr, nullptr);
+  CHECK(num_fast == 1);
+  CHECK(A == 1);
+
+  // A stored choice is used without timing the variants
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  std::filesystem::path file = std::filesystem::temp_directory_path()
+                               / ("kernel_registry_" + std::to_string(rank)
+                                  + ".txt");
+  registry.save(file);
+
+  fem::KernelRegistry<double> registry1;
+  registry1.add(fem::IntegralType::cell, -1, "slow", slow);
+  registry1.add(fem::IntegralType::cell, -1, "fast", fast);
+  registry1.load(file);
+  M.set_kernel(fem::IntegralType::cell, -1, slow);
+  num_fast = 0;
+  num_slow = 0;
+  chosen = registry1.tune(M, "M");
+  CHECK(chosen.at({fem::IntegralType::cell, -1}) == "fast");
+  CHECK(num_fast == 0);
+  CHECK(num_slow == 0);
+  M.kernel(fem::IntegralType::cell, -1)(&A, nullptr, nullptr, nullptr,
+                                        nullptr, nullptr);
+  CHECK(num_fast == 1);
+
+  // Choices for another form key are tuned separately
+  chosen = registry1.tune(M, "M1", 8, 1);
+  CHECK(num_slow > 0);
+  CHECK(registry1.choice("M1", fem::IntegralType::cell, -1));
+
+  std::filesystem::remove(file);
+}
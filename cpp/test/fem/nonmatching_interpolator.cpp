@@ -0,0 +1,102 @@
+// Copyright (C) 2024 Jørgen S. Dokken
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/NonMatchingInterpolator.h>
+#include <dolfinx/fem/interpolate.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <numeric>
+
+using namespace dolfinx;
+
+namespace
+{
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh, int degree,
+             const std::vector<std::size_t>& value_shape)
+{
+  auto element = basix::create_element<double>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh->topology()->cell_type()), degree,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(
+                    element, value_shape.empty()
+                                 ? std::nullopt
+                                 : std::optional(value_shape))));
+}
+} // namespace
+
+TEST_CASE("Non-matching interpolation operator", "[interpolation]")
+{
+  auto value_shape = GENERATE(std::vector<std::size_t>(),
+                              std::vector<std::size_t>{3});
+  const std::size_t value_size = value_shape.empty() ? 1 : 3;
+
+  auto mesh0 = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {4, 3, 3}, mesh::CellType::tetrahedron));
+  auto mesh1 = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {3, 5, 2}, mesh::CellType::hexahedron));
+  auto V0 = create_space(mesh0, 2, value_shape);
+  auto V1 = create_space(mesh1, 2, value_shape);
+
+  const int tdim = mesh0->topology()->dim();
+  auto cell_map = mesh0->topology()->index_map(tdim);
+  std::vector<std::int32_t> cells(cell_map->size_local()
+                                  + cell_map->num_ghosts());
+  std::iota(cells.begin(), cells.end(), 0);
+  geometry::PointOwnershipData<double> data
+      = fem::create_interpolation_data(mesh0->geometry(), *V0->element(),
+                                       *mesh1, std::span(cells), 1e-8);
+
+  fem::NonMatchingInterpolator<double> interpolator(V0, V1, cells, data);
+  CHECK(interpolator.num_nonzeros() > 0);
+
+  fem::Function<double> v(V1), u0(V0), u1(V0);
+  for (double t : {1.0, -2.0})
+  {
+    v.interpolate(
+        [t, value_size](auto x)
+            -> std::pair<std::vector<double>, std::vector<std::size_t>>
+        {
+          std::vector<double> f(value_size * x.extent(1));
+          for (std::size_t i = 0; i < value_size; ++i)
+          {
+            for (std::size_t p = 0; p < x.extent(1); ++p)
+            {
+              f[i * x.extent(1) + p]
+                  = t * x(0, p) * x(1, p) + (i + 1) * x(2, p);
+            }
+          }
+          if (value_size == 1)
+            return {f, {x.extent(1)}};
+          else
+            return {f, {value_size, x.extent(1)}};
+        });
+
+    fem::interpolate(u0, v, cells, data);
+    interpolator.apply(u1, v);
+
+    std::span<const double> x0 = u0.x()->array();
+    std::span<const double> x1 = u1.x()->array();
+    REQUIRE(x0.size() == x1.size());
+    for (std::size_t i = 0; i < x0.size(); ++i)
+      CHECK(x1[i] == Catch::Approx(x0[i]).margin(1e-12));
+  }
+}
@@ -0,0 +1,72 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <cmath>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/PTransfer.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("p-multigrid transfer", "[p_transfer]")
+{
+  auto degrees = GENERATE(std::pair{1, 2}, std::pair{2, 4}, std::pair{1, 3});
+
+  auto mesh
+      = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {7, 5}, mesh::CellType::triangle,
+          mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto create_space = [&mesh](int degree)
+  {
+    auto element = basix::create_element<double>(
+        basix::element::family::P, basix::cell::type::triangle, degree,
+        basix::element::lagrange_variant::gll_warped,
+        basix::element::dpc_variant::unset, false);
+    return std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(
+            mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  };
+  auto V0 = create_space(degrees.first);
+  auto V1 = create_space(degrees.second);
+  fem::PTransfer<double> transfer(V0, V1);
+
+  // Prolongation of a function in V0 is exact
+  auto f = [p = degrees.first](auto x)
+      -> std::pair<std::vector<double>, std::vector<std::size_t>>
+  {
+    std::vector<double> f;
+    for (std::size_t i = 0; i < x.extent(1); ++i)
+      f.push_back(std::pow(x(0, i), p) + 2 * x(1, i));
+    return {f, {f.size()}};
+  };
+  fem::Function<double> u0(V0), u1(V1), v1(V1);
+  u0.interpolate(f);
+  v1.interpolate(f);
+  transfer.prolongation(*u0.x(), *u1.x());
+  for (std::size_t i = 0; i < u1.x()->array().size(); ++i)
+    CHECK(u1.x()->array()[i] == Catch::Approx(v1.x()->array()[i]));
+
+  // Restriction is the transpose of the prolongation: (P x0, x1) = (x0,
+  // P^T x1)
+  la::Vector<double> y0(V0->dofmap()->index_map, 1);
+  la::Vector<double>& x1 = *v1.x();
+  transfer.restriction(x1, y0);
+  CHECK(la::inner_product(*u1.x(), x1)
+        == Catch::Approx(la::inner_product(*u0.x(), y0)));
+}
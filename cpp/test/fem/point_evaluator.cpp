@@ -0,0 +1,101 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/PointEvaluator.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+
+using namespace dolfinx;
+
+TEST_CASE("Point evaluator", "[point_evaluator]")
+{
+  auto cell_type
+      = GENERATE(mesh::CellType::triangle, mesh::CellType::quadrilateral);
+  auto value_shape = GENERATE(std::vector<std::size_t>(),
+                              std::vector<std::size_t>{2});
+  int num_threads = GENERATE(1, 3);
+
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 1}}},
+                                     {5, 4}, cell_type));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, mesh::cell_type_to_basix_type(cell_type), 2,
+      basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(
+                    element, value_shape.empty()
+                                 ? std::nullopt
+                                 : std::optional(value_shape))));
+
+  // Points, including a point outside of the domain
+  std::vector<double> x = {0.1,  0.2,  0, 0.55, 0.45, 0, 0.9, 0.95,
+                           0,    1e-3, 1, 0,    2.0,  0.5, 0, 0.33,
+                           0.71, 0};
+  const std::size_t num_points = x.size() / 3;
+  fem::PointEvaluator<double> evaluator
+      = fem::create_point_evaluator<double, double>(V, x, num_threads);
+  CHECK(evaluator.num_points() == num_points);
+  std::size_t value_size = evaluator.value_size();
+  CHECK(value_size == (value_shape.empty() ? 1 : 2));
+
+  fem::Function<double> u(V);
+  std::vector<double> u0(num_points * value_size), u1(u0.size());
+  for (double t : {1.0, 2.0})
+  {
+    // Quadratic function, which is represented exactly
+    u.interpolate(
+        [t, value_size](auto x)
+            -> std::pair<std::vector<double>, std::vector<std::size_t>>
+        {
+          std::vector<double> f(value_size * x.extent(1));
+          for (std::size_t i = 0; i < value_size; ++i)
+          {
+            for (std::size_t p = 0; p < x.extent(1); ++p)
+            {
+              f[i * x.extent(1) + p]
+                  = t * x(0, p) * x(0, p) + (i + 1) * x(1, p);
+            }
+          }
+          if (value_size == 1)
+            return {f, {x.extent(1)}};
+          else
+            return {f, {value_size, x.extent(1)}};
+        });
+
+    evaluator.eval(u, u1, num_threads);
+    u.eval(x, {num_points, 3}, evaluator.cells(), u0, {num_points, value_size});
+    for (std::size_t p = 0; p < num_points; ++p)
+    {
+      for (std::size_t i = 0; i < value_size; ++i)
+      {
+        CHECK(u1[p * value_size + i]
+              == Catch::Approx(u0[p * value_size + i]).margin(1e-12));
+        if (evaluator.cells()[p] >= 0)
+        {
+          double x0 = x[3 * p], x1 = x[3 * p + 1];
+          CHECK(u1[p * value_size + i]
+                == Catch::Approx(t * x0 * x0 + (i + 1) * x1));
+        }
+        else
+          CHECK(u1[p * value_size + i] == 0.0);
+      }
+    }
+  }
+
+  // The point outside the domain is not located
+  CHECK(evaluator.cells()[4] < 0);
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for static condensation
+
+#include "poisson.h"
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Constant.h>
+#include <dolfinx/fem/Form.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/StaticCondensation.h>
+#include <dolfinx/fem/assembler.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Assemble a bilinear form into a new matrix
+la::MatrixCSR<double> create_matrix(const fem::Form<double>& a)
+{
+  la::SparsityPattern sp = fem::create_sparsity_pattern(a);
+  sp.finalize();
+  la::MatrixCSR<double> A(sp);
+  fem::assemble_matrix(A.mat_add_values(), a, {});
+  A.scatter_rev();
+  return A;
+}
+
+// Assemble a linear form into a new vector
+la::Vector<double> create_vector(const fem::Form<double>& L)
+{
+  auto V = L.function_spaces().at(0);
+  la::Vector<double> b(V->dofmap()->index_map, V->dofmap()->index_map_bs());
+  b.set(0.0);
+  fem::assemble_vector(b.mutable_array(), L);
+  b.scatter_rev(std::plus<>());
+  return b;
+}
+} // namespace
+
+TEST_CASE("Static condensation", "[static_condensation]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {3, 4, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none)));
+  auto element1 = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto element0 = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, true);
+  auto V1 = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element1)));
+  auto V0 = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element0)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto f = std::make_shared<fem::Function<double>>(V1);
+  f->interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> fx;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          fx.push_back(1 + x(0, p) - 2 * x(1, p) * x(2, p));
+        return {fx, {fx.size()}};
+      });
+
+  auto a00 = std::make_shared<fem::Form<double>>(
+      fem::create_form<double, double>(*form_poisson_a00, {V0, V0}, {}, {},
+                                       {}, {}));
+  auto a01 = std::make_shared<fem::Form<double>>(
+      fem::create_form<double, double>(*form_poisson_a01, {V0, V1}, {}, {},
+                                       {}, {}));
+  auto a10 = std::make_shared<fem::Form<double>>(
+      fem::create_form<double, double>(*form_poisson_a10, {V1, V0}, {}, {},
+                                       {}, {}));
+  auto a11 = std::make_shared<fem::Form<double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V1, V1}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+  auto L0 = std::make_shared<fem::Form<double>>(
+      fem::create_form<double, double>(*form_poisson_L0, {V0}, {{"f", f}},
+                                       {}, {}, {}));
+  auto L1 = std::make_shared<fem::Form<double>>(
+      fem::create_form<double, double>(*form_poisson_L1, {V1}, {{"f", f}},
+                                       {}, {}, {}));
+
+  fem::StaticCondensation<double> sc({{{a00, a01}, {a10, a11}}}, {L0, L1});
+
+  // Condensed system
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a11);
+  sp.finalize();
+  la::MatrixCSR<double> S(sp);
+  sc.assemble_matrix(S.mat_add_values());
+  S.scatter_rev();
+  la::Vector<double> g(V1->dofmap()->index_map, 1);
+  g.set(0.0);
+  sc.assemble_vector(g.mutable_array());
+  g.scatter_rev(std::plus<>());
+
+  // Recover u0 from an arbitrary u1
+  la::Vector<double> u1(V1->dofmap()->index_map, 1);
+  {
+    auto x = u1.mutable_array();
+    auto range = V1->dofmap()->index_map->local_range();
+    for (std::int32_t i = 0; i < V1->dofmap()->index_map->size_local(); ++i)
+      x[i] = 0.01 * ((range[0] + i) % 17);
+  }
+  u1.scatter_fwd();
+  la::Vector<double> u0(V0->dofmap()->index_map, 1);
+  u0.set(0.0);
+  sc.back_substitute(u1.array(), u0.mutable_array());
+
+  // Residuals of the full block system
+  la::MatrixCSR<double> A00 = create_matrix(*a00);
+  la::MatrixCSR<double> A01 = create_matrix(*a01);
+  la::MatrixCSR<double> A10 = create_matrix(*a10);
+  la::MatrixCSR<double> A11 = create_matrix(*a11);
+  la::Vector<double> b0 = create_vector(*L0);
+  la::Vector<double> b1 = create_vector(*L1);
+
+  la::Vector<double> r0(V0->dofmap()->index_map, 1);
+  r0.set(0.0);
+  A00.mult(u0, r0);
+  A01.mult(u1, r0);
+  la::Vector<double> r1(V1->dofmap()->index_map, 1);
+  r1.set(0.0);
+  A10.mult(u0, r1);
+  A11.mult(u1, r1);
+  la::Vector<double> rs(V1->dofmap()->index_map, 1);
+  rs.set(0.0);
+  S.mult(u1, rs);
+
+  // The first block row is satisfied by the recovered u0
+  for (std::int32_t i = 0; i < V0->dofmap()->index_map->size_local(); ++i)
+    CHECK(r0.array()[i] == Catch::Approx(b0.array()[i]).margin(1e-12));
+
+  // The second block row residual is the condensed residual
+  for (std::int32_t i = 0; i < V1->dofmap()->index_map->size_local(); ++i)
+  {
+    CHECK(r1.array()[i] - b1.array()[i]
+          == Catch::Approx(rs.array()[i] - g.array()[i]).margin(1e-10));
+  }
+}
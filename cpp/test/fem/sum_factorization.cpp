@@ -0,0 +1,76 @@
+// Copyright (C) 2024 Igor A. Baratta
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/SumFactorizedOperator.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+
+using namespace dolfinx;
+
+TEST_CASE("Sum factorized operator", "[sum_factorization]")
+{
+  auto cell_type
+      = GENERATE(mesh::CellType::quadrilateral, mesh::CellType::hexahedron);
+  int degree = GENERATE(1, 3);
+
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  std::shared_ptr<mesh::Mesh<double>> mesh;
+  if (cell_type == mesh::CellType::quadrilateral)
+  {
+    mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle<double>(
+        MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {6, 5}, cell_type, part));
+  }
+  else
+  {
+    mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+        MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5}, cell_type, part));
+  }
+
+  auto element = basix::create_element<double>(
+      basix::element::family::P, mesh::cell_type_to_basix_type(cell_type),
+      degree, basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  fem::Function<double> u(V);
+  u.interpolate(
+      [](auto x) -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f;
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          f.push_back(x(0, p));
+        return {f, {f.size()}};
+      });
+  la::Vector<double>& x = *u.x();
+  la::Vector<double> y(V->dofmap()->index_map, 1);
+
+  // Mass: (x, x) = 1/3
+  fem::SumFactorizedOperator<double> M(V, 1.0, 0.0);
+  M(x, y);
+  CHECK(la::inner_product(x, y) == Catch::Approx(1.0 / 3.0));
+
+  // Stiffness: (grad x, grad x) = 1
+  fem::SumFactorizedOperator<double> K(V, 0.0, 1.0);
+  K(x, y);
+  CHECK(la::inner_product(x, y) == Catch::Approx(1.0));
+
+  // Stiffness applied to a constant is zero
+  x.set(1.0);
+  K(x, y);
+  CHECK(la::norm(y, la::Norm::linf) == Catch::Approx(0.0).margin(1e-12));
+}
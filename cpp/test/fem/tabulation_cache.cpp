@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the cache of element tabulations
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <dolfinx/fem/TabulationCache.h>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Tabulation cache", "[tabulation_cache]")
+{
+  fem::TabulationCache<double> cache(2);
+
+  // 'Tabulation' that records the number of calls
+  int num_calls = 0;
+  auto tabulate = [&num_calls](const std::vector<double>& X)
+  {
+    return [&num_calls, &X]()
+    {
+      ++num_calls;
+      std::vector<double> values(X.size());
+      for (std::size_t i = 0; i < X.size(); ++i)
+        values[i] = 2 * X[i];
+      return std::pair(values, std::array<std::size_t, 4>{1, X.size(), 1, 1});
+    };
+  };
+
+  std::vector<double> X0{0.0, 0.25, 0.5, 0.75};
+  std::vector<double> X1{0.0, 0.5, 0.5, 1.0};
+  std::vector<double> X2{1.0, 0.5, 0.5, 0.0};
+
+  auto [v0, s0] = cache.get(0, X0, {2, 2}, tabulate(X0));
+  CHECK(*v0 == std::vector<double>{0.0, 0.5, 1.0, 1.5});
+  CHECK(s0 == std::array<std::size_t, 4>{1, 4, 1, 1});
+
+  // Repeated point set
+  auto [v1, s1] = cache.get(0, X0, {2, 2}, tabulate(X0));
+  CHECK(*v1 == *v0);
+  CHECK(num_calls == 1);
+  CHECK(cache.num_hits() == 1);
+
+  // Different derivative order, point set or shape
+  cache.get(1, X0, {2, 2}, tabulate(X0));
+  cache.get(0, X0, {4, 1}, tabulate(X0));
+  CHECK(num_calls == 3);
+  CHECK(cache.size() == 2);
+
+  // The least recently used tabulation is evicted
+  cache.get(0, X0, {4, 1}, tabulate(X0));
+  cache.get(0, X1, {2, 2}, tabulate(X1));
+  cache.get(0, X2, {2, 2}, tabulate(X2));
+  CHECK(num_calls == 5);
+  cache.get(0, X2, {2, 2}, tabulate(X2));
+  CHECK(num_calls == 5);
+  cache.get(0, X0, {4, 1}, tabulate(X0));
+  CHECK(num_calls == 6);
+
+  // Tabulations at one point are not cached
+  std::vector<double> X3{0.5, 0.5};
+  cache.get(0, X3, {1, 2}, tabulate(X3));
+  cache.get(0, X3, {1, 2}, tabulate(X3));
+  CHECK(num_calls == 8);
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+}
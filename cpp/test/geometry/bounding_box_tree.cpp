@@ -0,0 +1,309 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for geometry::BoundingBoxTree
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Check that two trees have the same nodes and bounding boxes
+void check_equal(const geometry::BoundingBoxTree<double>& tree0,
+                 const geometry::BoundingBoxTree<double>& tree1)
+{
+  REQUIRE(tree0.num_bboxes() == tree1.num_bboxes());
+  for (std::int32_t i = 0; i < tree0.num_bboxes(); ++i)
+  {
+    CHECK(tree0.bbox(i) == tree1.bbox(i));
+    CHECK(tree0.get_bbox(i) == tree1.get_bbox(i));
+  }
+}
+} // namespace
+
+TEST_CASE("Threaded bounding box tree construction", "[geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {10, 9, 8}, mesh::CellType::tetrahedron));
+  for (int tdim = 0; tdim <= 3; ++tdim)
+  {
+    geometry::BoundingBoxTree<double> tree0(*mesh, tdim, std::nullopt, 0.1);
+    for (int num_threads : {2, 3, 4})
+    {
+      geometry::BoundingBoxTree<double> tree1(*mesh, tdim, std::nullopt, 0.1,
+                                              num_threads);
+      check_equal(tree0, tree1);
+    }
+  }
+}
+
+TEST_CASE("Refit bounding box tree", "[geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {6, 5, 4}, mesh::CellType::tetrahedron));
+  const int tdim = mesh->topology()->dim();
+  geometry::BoundingBoxTree<double> tree(*mesh, tdim);
+
+  // Scaling the geometry does not change the order of the entities in
+  // the tree, so the refit tree is the same as a new tree
+  for (double& x : mesh->geometry().x())
+    x *= 2;
+  tree.refit(*mesh, 2);
+  check_equal(tree, geometry::BoundingBoxTree<double>(*mesh, tdim));
+
+  // Trees for point clouds can not be refit
+  std::vector<std::pair<std::array<double, 3>, std::int32_t>> points
+      = {{{0, 0, 0}, 0}, {{1, 0, 0}, 1}};
+  geometry::BoundingBoxTree<double> point_tree(points);
+  CHECK_THROWS(point_tree.refit(*mesh));
+}
+
+TEST_CASE("Collisions between trees", "[geometry]")
+{
+  // Two meshes that overlap in [0.5, 1] x [0, 1] x [0, 1]
+  auto mesh0 = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {6, 5, 4}, mesh::CellType::tetrahedron));
+  auto mesh1 = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0.5, 0, 0}, {1.5, 1, 1}}},
+                               {5, 4, 6}, mesh::CellType::hexahedron));
+  const int tdim = mesh0->topology()->dim();
+  geometry::BoundingBoxTree<double> tree0(*mesh0, tdim);
+  geometry::BoundingBoxTree<double> tree1(*mesh1, tdim);
+
+  const std::vector<std::int32_t> collisions
+      = geometry::compute_collisions(tree0, tree1);
+  for (int num_threads : {2, 3, 4})
+  {
+    CHECK(geometry::compute_collisions(tree0, tree1, num_threads)
+          == collisions);
+  }
+
+  // Collisions across ranks. Cells of mesh0 with their midpoint in the
+  // overlap collide with a cell of mesh1 on some rank.
+  const std::vector<std::int32_t> global_collisions
+      = geometry::compute_collisions(mesh0->comm(), tree0, tree1, 2);
+  REQUIRE(global_collisions.size() % 3 == 0);
+  const int size = dolfinx::MPI::size(mesh0->comm());
+  std::vector<std::int8_t> colliding(
+      mesh0->topology()->index_map(tdim)->size_local(), false);
+  for (std::size_t i = 0; i < global_collisions.size(); i += 3)
+  {
+    CHECK(global_collisions[i + 1] >= 0);
+    CHECK(global_collisions[i + 1] < size);
+    if (global_collisions[i] < std::int32_t(colliding.size()))
+      colliding[global_collisions[i]] = true;
+  }
+  std::vector<std::int32_t> cells(colliding.size());
+  std::iota(cells.begin(), cells.end(), 0);
+  const std::vector<double> midpoints
+      = mesh::compute_midpoints(*mesh0, tdim, cells);
+  for (std::size_t c = 0; c < cells.size(); ++c)
+  {
+    if (midpoints[3 * c] > 0.55)
+      CHECK(colliding[c]);
+  }
+
+  if (size == 1)
+  {
+    REQUIRE(global_collisions.size() == 3 * collisions.size() / 2);
+    std::vector<std::array<std::int32_t, 3>> local;
+    for (std::size_t i = 0; i < collisions.size(); i += 2)
+      local.push_back({collisions[i], 0, collisions[i + 1]});
+    std::ranges::sort(local);
+    for (std::size_t i = 0; i < local.size(); ++i)
+    {
+      CHECK(global_collisions[3 * i] == local[i][0]);
+      CHECK(global_collisions[3 * i + 2] == local[i][2]);
+    }
+  }
+}
+
+TEST_CASE("Locate entities with bounding box tree", "[geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {7, 6, 5}, mesh::CellType::hexahedron));
+  geometry::BoundingBoxTree<double> tree(*mesh, 3);
+
+  // Mark the points in a box, or on the x = 0 face of the unit cube
+  auto box = GENERATE(std::array<double, 6>{0.2, 0.1, 0.3, 0.6, 0.5, 0.9},
+                      std::array<double, 6>{0, 0, 0, 0, 1, 1});
+  auto marker = [box](auto x)
+  {
+    constexpr double eps = 1e-10;
+    std::vector<std::int8_t> marked(x.extent(1), true);
+    for (std::size_t p = 0; p < x.extent(1); ++p)
+    {
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        marked[p] = marked[p] and x(i, p) >= box[i] - eps
+                    and x(i, p) <= box[i + 3] + eps;
+      }
+    }
+    return marked;
+  };
+
+  for (int dim = 0; dim <= 3; ++dim)
+  {
+    CHECK(geometry::locate_entities(tree, *mesh, dim, box, marker)
+          == mesh::locate_entities(*mesh, dim, marker));
+    if (dim < 3)
+    {
+      CHECK(geometry::locate_entities_boundary(tree, *mesh, dim, box, marker)
+            == mesh::locate_entities_boundary(*mesh, dim, marker));
+    }
+  }
+}
+
+TEST_CASE("Nearest neighbour and radius search of points", "[geometry]")
+{
+  // Points of a regular grid, with spacing 0.25
+  std::vector<std::pair<std::array<double, 3>, std::int32_t>> points;
+  for (int k = 0; k < 5; ++k)
+    for (int j = 0; j < 5; ++j)
+      for (int i = 0; i < 5; ++i)
+        points.push_back(
+            {{0.25 * i, 0.25 * j, 0.25 * k}, std::int32_t(points.size())});
+  auto distance2 = [&points](std::int32_t p, std::span<const double> x)
+  {
+    double d2 = 0;
+    for (std::size_t j = 0; j < 3; ++j)
+      d2 += (points[p].first[j] - x[j]) * (points[p].first[j] - x[j]);
+    return d2;
+  };
+  geometry::BoundingBoxTree<double> tree(points);
+
+  std::vector<double> x = {0.1, 0.2, 0.3, 0.5, 0.5, 0.5, 1.5, -1.0, 0.2};
+  for (int num_threads : {1, 3})
+  {
+    // Compare to a brute-force search
+    const int k = 7;
+    graph::AdjacencyList<std::int32_t> nearest
+        = geometry::compute_nearest_neighbors<double>(tree, x, k,
+                                                      num_threads);
+    REQUIRE(nearest.num_nodes() == 3);
+    for (std::int32_t i = 0; i < nearest.num_nodes(); ++i)
+    {
+      std::span<const double> xi(x.data() + 3 * i, 3);
+      std::vector<std::pair<double, std::int32_t>> d(points.size());
+      for (std::size_t p = 0; p < points.size(); ++p)
+        d[p] = {distance2(p, xi), p};
+      std::ranges::sort(d);
+
+      auto links = nearest.links(i);
+      REQUIRE(links.size() == std::size_t(k));
+      for (int j = 0; j < k; ++j)
+        CHECK(links[j] == d[j].second);
+    }
+
+    const double r = 0.3;
+    graph::AdjacencyList<std::int32_t> near
+        = geometry::compute_points_in_radius<double>(tree, x, r, num_threads);
+    REQUIRE(near.num_nodes() == 3);
+    for (std::int32_t i = 0; i < near.num_nodes(); ++i)
+    {
+      std::span<const double> xi(x.data() + 3 * i, 3);
+      std::vector<std::int32_t> p_r;
+      for (std::size_t p = 0; p < points.size(); ++p)
+        if (distance2(p, xi) <= r * r)
+          p_r.push_back(p);
+      auto links = near.links(i);
+      CHECK(std::vector(links.begin(), links.end()) == p_r);
+    }
+    CHECK(near.links(1).size() == 7);
+    CHECK(near.links(2).empty());
+  }
+
+  // All points are found if k exceeds the number of points
+  CHECK(geometry::compute_nearest_neighbors<double>(tree, x, 1000)
+            .links(0)
+            .size()
+        == points.size());
+}
+
+TEST_CASE("Colliding cells and reference coordinates", "[geometry]")
+{
+  auto celltype = GENERATE(mesh::CellType::tetrahedron,
+                           mesh::CellType::hexahedron);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {4, 3, 5}, celltype));
+  geometry::BoundingBoxTree<double> tree(*mesh, 3);
+
+  // Points inside and outside of the mesh, and on cell boundaries
+  std::vector<double> points;
+  for (int i = 0; i < 5; ++i)
+    for (int j = 0; j < 6; ++j)
+      for (int k = 0; k < 7; ++k)
+        points.insert(points.end(), {0.26 * i - 0.02, 0.2 * j, 0.19 * k});
+  std::span<const double> p(points);
+
+  graph::AdjacencyList<std::int32_t> candidates
+      = geometry::compute_collisions(tree, p);
+  graph::AdjacencyList<std::int32_t> cells
+      = geometry::compute_colliding_cells(*mesh, candidates, p);
+  auto [cells1, X]
+      = geometry::compute_colliding_cells_pull_back(*mesh, candidates, p);
+  CHECK(cells.array() == cells1.array());
+  CHECK(cells.offsets() == cells1.offsets());
+  REQUIRE(X.size() == 3 * cells.array().size());
+
+  // Compare to the result of the distance computation
+  for (std::int32_t i = 0; i < candidates.num_nodes(); ++i)
+  {
+    std::vector<std::int32_t> c;
+    for (std::int32_t cell : candidates.links(i))
+    {
+      std::vector<double> d2 = geometry::squared_distance(
+          *mesh, 3, std::span(&cell, 1), p.subspan(3 * i, 3));
+      if (d2.front() < 1e-12)
+        c.push_back(cell);
+    }
+    auto links = cells.links(i);
+    CHECK(std::vector(links.begin(), links.end()) == c);
+  }
+
+  // Push forward the reference coordinates
+  const fem::CoordinateElement<double>& cmap = mesh->geometry().cmap();
+  auto x_dofmap = mesh->geometry().dofmap();
+  std::span<const double> x = mesh->geometry().x();
+  std::array<std::size_t, 4> shape = cmap.tabulate_shape(0, 1);
+  std::vector<double> phi(shape[2]);
+  for (std::int32_t i = 0; i < cells.num_nodes(); ++i)
+  {
+    auto links = cells.links(i);
+    for (std::size_t j = 0; j < links.size(); ++j)
+    {
+      std::size_t pos = cells.offsets()[i] + j;
+      cmap.tabulate(0, std::span<const double>(X.data() + 3 * pos, 3), {1, 3},
+                    phi);
+      for (std::size_t k = 0; k < 3; ++k)
+      {
+        double xk = 0;
+        for (std::size_t n = 0; n < phi.size(); ++n)
+          xk += phi[n] * x[3 * x_dofmap(links[j], n) + k];
+        CHECK(std::abs(xk - points[3 * i + k]) < 1e-10);
+      }
+    }
+  }
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for geometry::CellGrid
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/CellGrid.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/generation.h>
+#include <mpi.h>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Check that the links of each node are the same, up to order
+void check_equal(const graph::AdjacencyList<std::int32_t>& c0,
+                 const graph::AdjacencyList<std::int32_t>& c1)
+{
+  REQUIRE(c0.num_nodes() == c1.num_nodes());
+  for (std::int32_t i = 0; i < c0.num_nodes(); ++i)
+  {
+    std::vector<std::int32_t> l0(c0.links(i).begin(), c0.links(i).end());
+    std::vector<std::int32_t> l1(c1.links(i).begin(), c1.links(i).end());
+    std::ranges::sort(l0);
+    std::ranges::sort(l1);
+    CHECK(l0 == l1);
+  }
+}
+} // namespace
+
+TEST_CASE("Cell grid point collisions", "[geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {6, 5, 4}, mesh::CellType::tetrahedron));
+
+  std::mt19937 engine;
+  std::uniform_real_distribution<double> distribution(-0.1, 1.1);
+  std::vector<double> points(3 * 500);
+  for (auto& x : points)
+    x = distribution(engine);
+
+  // Include mesh vertices, which lie on bounding box boundaries
+  std::span<const double> x = mesh->geometry().x();
+  points.insert(points.end(), x.begin(), x.end());
+  std::span<const double> p(points);
+
+  for (int tdim = 0; tdim <= 3; ++tdim)
+  {
+    geometry::BoundingBoxTree<double> tree(*mesh, tdim);
+    geometry::CellGrid<double> grid(*mesh, tdim);
+    check_equal(geometry::compute_collisions(tree, p),
+                geometry::compute_collisions(grid, p));
+  }
+
+  // Candidate cells from the grid give the colliding cells
+  geometry::BoundingBoxTree<double> tree(*mesh, 3);
+  geometry::CellGrid<double> grid(*mesh, 3);
+  check_equal(geometry::compute_colliding_cells(
+                  *mesh, geometry::compute_collisions(tree, p), p),
+              geometry::compute_colliding_cells(
+                  *mesh, geometry::compute_collisions(grid, p), p));
+
+  // Processes that a point might collide with
+  geometry::BoundingBoxTree<double> global_tree
+      = tree.create_global_tree(mesh->comm());
+  geometry::CellGrid<double> global_grid
+      = grid.create_global_grid(mesh->comm());
+  check_equal(geometry::compute_collisions(global_tree, p),
+              geometry::compute_collisions(global_grid, p));
+
+  // Empty grid
+  std::vector<std::int32_t> entities;
+  geometry::CellGrid<double> empty(*mesh, 3,
+                                   std::span<const std::int32_t>(entities));
+  CHECK(empty.num_entities() == 0);
+  CHECK(geometry::compute_collisions(empty, p).array().empty());
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the distance computations in geometry/gjk.h
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/geometry/gjk.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+double norm(std::span<const double> v)
+{
+  return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+} // namespace
+
+TEST_CASE("Point-simplex distance", "[geometry]")
+{
+  std::mt19937 engine;
+  std::uniform_real_distribution<double> distribution(-1, 2);
+  for (std::size_t num_vertices = 1; num_vertices <= 4; ++num_vertices)
+  {
+    const std::size_t num_bodies = 500;
+    std::vector<double> x(3 * num_bodies), s(3 * num_vertices * num_bodies);
+    for (auto& xi : x)
+      xi = distribution(engine);
+    for (auto& si : s)
+      si = distribution(engine);
+
+    std::vector<double> v0 = geometry::compute_distances_gjk<double>(
+        x, 1, s, num_vertices, false);
+    std::vector<double> v1 = geometry::compute_distances_gjk<double>(
+        x, 1, s, num_vertices, true);
+    for (std::size_t i = 0; i < num_bodies; ++i)
+    {
+      std::span<const double> xi(x.data() + 3 * i, 3);
+      std::span<const double> si(s.data() + 3 * num_vertices * i,
+                                 3 * num_vertices);
+      std::array<double, 3> d = geometry::compute_distance_gjk<double>(xi, si);
+      CHECK(norm(std::span(v0).subspan(3 * i, 3)) == Catch::Approx(norm(d)));
+      CHECK(norm(std::span(v1).subspan(3 * i, 3))
+            == Catch::Approx(norm(d)).margin(1e-12));
+    }
+  }
+
+  // Point inside a tetrahedron
+  std::vector<double> tet = {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1};
+  std::vector<double> x = {0.2, 0.2, 0.2};
+  std::array<double, 3> d
+      = geometry::compute_distance_point_simplex<double>(x, tet);
+  CHECK(norm(d) == 0.0);
+
+  // Degenerate (flat) tetrahedron
+  std::vector<double> flat = {0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0};
+  x = {0.5, 0.5, 1.0};
+  d = geometry::compute_distance_point_simplex<double>(x, flat);
+  CHECK(norm(d) == Catch::Approx(1.0));
+}
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for geometry::PointLocator
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/geometry/PointLocator.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <mpi.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Check that ownership data from a walk is the same as the ownership
+// data computed with the bounding box trees
+void check_ownership(const mesh::Mesh<double>& mesh,
+                     const geometry::PointLocator<double>& locator,
+                     std::span<const double> points)
+{
+  geometry::PointOwnershipData<double> ref
+      = geometry::determine_point_ownership<double>(mesh, points, 0);
+  const geometry::PointOwnershipData<double>& data = locator.data();
+  CHECK(data.src_owner == ref.src_owner);
+  CHECK(data.dest_owners == ref.dest_owners);
+  CHECK(data.dest_points == ref.dest_points);
+  CHECK(data.dest_cells == ref.dest_cells);
+
+  // Destination indices are increasing for each source process
+  std::span<const std::int32_t> indices = locator.dest_indices();
+  REQUIRE(indices.size() == data.dest_owners.size());
+  for (std::size_t i = 1; i < indices.size(); ++i)
+  {
+    if (data.dest_owners[i] == data.dest_owners[i - 1])
+      CHECK(indices[i] > indices[i - 1]);
+  }
+}
+} // namespace
+
+TEST_CASE("Walking point locator", "[geometry][point_locator]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {6, 6, 6}, mesh::CellType::tetrahedron));
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Points inside the domain, and some outside
+  std::mt19937 engine(rank);
+  std::uniform_real_distribution<double> distribution(-0.1, 1.1);
+  std::vector<double> points(3 * 200);
+  for (auto& x : points)
+    x = distribution(engine);
+
+  geometry::PointLocator<double> locator(mesh);
+  locator.update(points);
+  check_ownership(*mesh, locator, points);
+  CHECK(locator.num_searched() == 200);
+
+  // Small moves are located by walking, except for points that were
+  // or are outside of the domain
+  std::normal_distribution<double> step(0, 0.02);
+  for (int i = 0; i < 3; ++i)
+  {
+    for (auto& x : points)
+      x += step(engine);
+    locator.update(points);
+    check_ownership(*mesh, locator, points);
+  }
+  std::int64_t num_searched = locator.num_searched();
+  MPI_Allreduce(MPI_IN_PLACE, &num_searched, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  std::int64_t num_points = 200 * dolfinx::MPI::size(MPI_COMM_WORLD);
+  CHECK(num_searched < num_points / 2);
+
+  // Large moves leave the local part of the mesh
+  for (auto& x : points)
+    x = 1 - x;
+  locator.update(points);
+  check_ownership(*mesh, locator, points);
+
+  // Change the number of points
+  points.resize(3 * 50);
+  locator.update(points);
+  check_ownership(*mesh, locator, points);
+  CHECK(locator.num_searched() == 50);
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2024 Jørgen S. Dokken
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for geometry::PointOwnership
+
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/geometry/PointOwnership.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/mesh/generation.h>
+#include <mpi.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Check that cached ownership data is the same as the ownership data
+// computed from scratch
+void check_ownership(const mesh::Mesh<double>& mesh,
+                     const geometry::PointOwnershipData<double>& data,
+                     std::span<const double> points)
+{
+  geometry::PointOwnershipData<double> ref
+      = geometry::determine_point_ownership<double>(mesh, points, 1e-10);
+  CHECK(data.src_owner == ref.src_owner);
+  CHECK(data.dest_owners == ref.dest_owners);
+  CHECK(data.dest_points == ref.dest_points);
+  CHECK(data.dest_cells == ref.dest_cells);
+}
+} // namespace
+
+TEST_CASE("Point ownership update", "[geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {4, 4, 4}, mesh::CellType::tetrahedron));
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Points inside the domain, and some outside
+  std::mt19937 engine(rank);
+  std::uniform_real_distribution<double> distribution(-0.2, 1.2);
+  std::vector<double> points(3 * 100);
+  for (auto& x : points)
+    x = distribution(engine);
+
+  geometry::PointOwnership<double> ownership(mesh, 1e-10);
+  check_ownership(*mesh, ownership.update(points), points);
+  CHECK(ownership.num_updated() == 100);
+
+  // Unchanged points
+  check_ownership(*mesh, ownership.update(points), points);
+  CHECK(ownership.num_updated() == 0);
+
+  // Move some points
+  for (std::size_t i = 0; i < points.size(); i += 3 * 7)
+    points[i] = distribution(engine);
+  check_ownership(*mesh, ownership.update(points), points);
+  CHECK(ownership.num_updated() == 15);
+  check_ownership(*mesh, ownership.data(), points);
+
+  // Change the number of points
+  points.resize(3 * 40);
+  check_ownership(*mesh, ownership.update(points), points);
+  CHECK(ownership.num_updated() == 40);
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for geometry::WideBoundingBoxTree
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/generation.h>
+#include <mpi.h>
+#include <random>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+template <int W>
+void test_collisions(const geometry::BoundingBoxTree<double>& tree,
+                     std::span<const double> points)
+{
+  geometry::WideBoundingBoxTree<double, W> wtree(tree);
+  graph::AdjacencyList<std::int32_t> c0
+      = geometry::compute_collisions(tree, points);
+  graph::AdjacencyList<std::int32_t> c1
+      = geometry::compute_collisions(wtree, points);
+  CHECK(c0.array() == c1.array());
+  CHECK(c0.offsets() == c1.offsets());
+}
+} // namespace
+
+TEST_CASE("Wide bounding box tree point collisions", "[geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {5, 4, 3}, mesh::CellType::tetrahedron));
+
+  std::mt19937 engine;
+  std::uniform_real_distribution<double> distribution(-0.1, 1.1);
+  std::vector<double> points(3 * 500);
+  for (auto& x : points)
+    x = distribution(engine);
+
+  // Include mesh vertices, which lie on bounding box boundaries
+  std::span<const double> x = mesh->geometry().x();
+  points.insert(points.end(), x.begin(), x.end());
+
+  for (int tdim = 0; tdim <= 3; ++tdim)
+  {
+    geometry::BoundingBoxTree<double> tree(*mesh, tdim);
+    test_collisions<2>(tree, points);
+    test_collisions<4>(tree, points);
+    test_collisions<8>(tree, points);
+  }
+
+  // Point cloud tree
+  std::vector<std::pair<std::array<double, 3>, std::int32_t>> cloud;
+  for (std::size_t i = 0; i < x.size() / 3; ++i)
+    cloud.push_back({{x[3 * i], x[3 * i + 1], x[3 * i + 2]}, std::int32_t(i)});
+  geometry::BoundingBoxTree<double> tree(cloud);
+  test_collisions<4>(tree, points);
+
+  // Empty tree
+  std::vector<std::int32_t> entities;
+  geometry::WideBoundingBoxTree<double> wtree(
+      *mesh, 3, std::span<const std::int32_t>(entities));
+  CHECK(wtree.num_nodes() == 0);
+  CHECK(geometry::compute_collisions(wtree, std::span<const double>(points))
+            .array()
+            .empty());
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Constant degree AdjacencyList", "[adjacency_list]")
+{
+  std::vector<std::int32_t> data(12);
+  std::iota(data.begin(), data.end(), 0);
+  const graph::AdjacencyList<std::int32_t> a
+      = graph::regular_adjacency_list(data, 3);
+  REQUIRE(a.degree());
+  CHECK(*a.degree() == 3);
+  CHECK(a.num_nodes() == 4);
+  CHECK(a.num_links(2) == 3);
+  CHECK(a.links(2)[0] == 6);
+  CHECK(a.links(3).back() == 11);
+
+  // Equal to the list with explicit offsets
+  const graph::AdjacencyList<std::int32_t> b(
+      data, std::vector<std::int32_t>{0, 3, 6, 9, 12});
+  CHECK(!b.degree());
+  CHECK(a == b);
+
+  // Offsets are created on request
+  const std::vector<std::int32_t> offsets_ref{0, 3, 6, 9, 12};
+  CHECK(a.offsets() == offsets_ref);
+  CHECK(a.degree());
+
+  // Copies and moves keep the constant degree
+  graph::AdjacencyList<std::int32_t> c(a);
+  CHECK(c.degree());
+  CHECK(c == a);
+  graph::AdjacencyList<std::int32_t> d(std::move(c));
+  CHECK(d.degree());
+  CHECK(d.links(1)[1] == 4);
+
+  // Mutable access to the offsets makes the degree variable
+  d.offsets();
+  CHECK(!d.degree());
+  CHECK(d == a);
+
+  graph::AdjacencyList<std::int32_t> e(5);
+  CHECK(e.degree());
+  CHECK(e.num_nodes() == 5);
+  CHECK(e.links(4)[0] == 4);
+
+  CHECK(graph::regular_adjacency_list(std::vector<int>(), 0).num_nodes() == 0);
+}
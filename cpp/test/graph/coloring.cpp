@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for graph colouring
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/coloring.h>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Create the graph of a structured nx x ny grid with a 9-point
+/// stencil, including self-links
+graph::AdjacencyList<std::int32_t> create_grid_graph(int nx, int ny)
+{
+  std::vector<std::vector<std::int32_t>> edges(nx * ny);
+  for (int j = 0; j < ny; ++j)
+    for (int i = 0; i < nx; ++i)
+      for (int dj = -1; dj <= 1; ++dj)
+        for (int di = -1; di <= 1; ++di)
+          if (i + di >= 0 and i + di < nx and j + dj >= 0 and j + dj < ny)
+            edges[j * nx + i].push_back((j + dj) * nx + i + di);
+
+  return graph::AdjacencyList<std::int32_t>(edges);
+}
+
+/// Check that colours are contiguous from zero
+void check_contiguous(const std::vector<std::int32_t>& colors)
+{
+  std::vector<std::int32_t> c = colors;
+  std::ranges::sort(c);
+  auto [first, last] = std::ranges::unique(c);
+  c.erase(first, last);
+  for (std::size_t i = 0; i < c.size(); ++i)
+    CHECK(c[i] == static_cast<std::int32_t>(i));
+}
+} // namespace
+
+TEST_CASE("Greedy colouring", "[graph][coloring]")
+{
+  auto graph = create_grid_graph(9, 7);
+
+  std::vector<std::int32_t> colors1 = graph::compute_greedy_coloring(graph);
+  check_contiguous(colors1);
+  for (std::int32_t n = 0; n < graph.num_nodes(); ++n)
+    for (std::int32_t m : graph.links(n))
+      CHECK((m == n or colors1[m] != colors1[n]));
+
+  // A 9-point stencil on a grid needs four colours
+  CHECK(*std::ranges::max_element(colors1) == 3);
+
+  std::vector<std::int32_t> colors2 = graph::compute_greedy_coloring(graph, 2);
+  check_contiguous(colors2);
+  for (std::int32_t n = 0; n < graph.num_nodes(); ++n)
+  {
+    for (std::int32_t m : graph.links(n))
+    {
+      for (std::int32_t k : graph.links(m))
+        CHECK((k == n or colors2[k] != colors2[n]));
+    }
+  }
+
+  CHECK_THROWS(graph::compute_greedy_coloring(graph, 3));
+}
+
+TEST_CASE("Distributed Jones-Plassmann colouring", "[graph][coloring]")
+{
+  const int rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int size = dolfinx::MPI::size(MPI_COMM_WORLD);
+
+  // Distribute the rows of an nx x (ny * size) grid with a 9-point
+  // stencil, with the neighbouring rows on other processes as ghosts
+  const int nx = 8, ny = 5;
+  const std::int32_t size_local = nx * ny;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (rank > 0)
+  {
+    for (int i = 0; i < nx; ++i)
+      ghosts.push_back(rank * size_local - nx + i);
+    owners.insert(owners.end(), nx, rank - 1);
+  }
+  if (rank < size - 1)
+  {
+    for (int i = 0; i < nx; ++i)
+      ghosts.push_back((rank + 1) * size_local + i);
+    owners.insert(owners.end(), nx, rank + 1);
+  }
+  common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  // Local index of (i, j), where -1 <= j <= ny is the local row
+  auto local = [&](int i, int j) -> std::int32_t
+  {
+    if (j < 0)
+      return size_local + i;
+    else if (j < ny)
+      return j * nx + i;
+    else
+      return size_local + (rank > 0 ? nx : 0) + i;
+  };
+
+  std::vector<std::vector<std::int32_t>> edges(size_local);
+  const int j0 = rank == 0 ? 0 : -1;
+  const int j1 = rank == size - 1 ? ny - 1 : ny;
+  for (int j = 0; j < ny; ++j)
+    for (int i = 0; i < nx; ++i)
+      for (int dj = -1; dj <= 1; ++dj)
+        for (int di = -1; di <= 1; ++di)
+          if (i + di >= 0 and i + di < nx and j + dj >= j0 and j + dj <= j1)
+            edges[j * nx + i].push_back(local(i + di, j + dj));
+  graph::AdjacencyList<std::int32_t> graph(edges);
+
+  std::vector<std::int32_t> colors
+      = graph::compute_jones_plassmann_coloring(graph, map);
+  REQUIRE(colors.size() == std::size_t(size_local + map.num_ghosts()));
+  CHECK(std::ranges::find(colors, -1) == colors.end());
+
+  // Linked nodes, including ghosts, have different colours
+  for (std::int32_t n = 0; n < graph.num_nodes(); ++n)
+    for (std::int32_t m : graph.links(n))
+      CHECK((m == n or colors[m] != colors[n]));
+
+  // Colours are contiguous across processes
+  std::int32_t max_color = *std::ranges::max_element(colors);
+  MPI_Allreduce(MPI_IN_PLACE, &max_color, 1, MPI_INT32_T, MPI_MAX,
+                MPI_COMM_WORLD);
+  std::vector<std::int32_t> used(max_color + 1, 0);
+  for (std::int32_t c : colors)
+    used[c] = 1;
+  MPI_Allreduce(MPI_IN_PLACE, used.data(), used.size(), MPI_INT32_T, MPI_MAX,
+                MPI_COMM_WORLD);
+  CHECK(std::ranges::find(used, 0) == used.end());
+}
@@ -0,0 +1,130 @@
+// Copyright (C) 2024 Chris Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for graph re-ordering
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <dolfinx/common/ThreadPool.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/ordering.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Create the graph of a structured nx x ny grid, with the nodes
+/// numbered by the permutation `perm`
+graph::AdjacencyList<std::int32_t>
+create_grid_graph(int nx, int ny, const std::vector<std::int32_t>& perm)
+{
+  std::vector<std::vector<std::int32_t>> edges(nx * ny);
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      std::int32_t v = perm[j * nx + i];
+      if (i > 0)
+        edges[v].push_back(perm[j * nx + i - 1]);
+      if (i < nx - 1)
+        edges[v].push_back(perm[j * nx + i + 1]);
+      if (j > 0)
+        edges[v].push_back(perm[(j - 1) * nx + i]);
+      if (j < ny - 1)
+        edges[v].push_back(perm[(j + 1) * nx + i]);
+    }
+  }
+
+  return graph::AdjacencyList<std::int32_t>(edges);
+}
+
+/// Compute the bandwidth of a graph after re-ordering
+std::int32_t bandwidth(const graph::AdjacencyList<std::int32_t>& graph,
+                       const std::vector<std::int32_t>& map)
+{
+  std::int32_t bw = 0;
+  for (std::int32_t v = 0; v < graph.num_nodes(); ++v)
+    for (std::int32_t w : graph.links(v))
+      bw = std::max(bw, std::abs(map[v] - map[w]));
+  return bw;
+}
+
+void test_reorder(auto reorder_fn)
+{
+  // Scramble the node numbering
+  const int nx = 20, ny = 7;
+  std::vector<std::int32_t> perm(nx * ny);
+  std::iota(perm.begin(), perm.end(), 0);
+  for (std::size_t i = 0; i < perm.size(); ++i)
+    std::swap(perm[i], perm[(i * 37) % perm.size()]);
+  auto graph = create_grid_graph(nx, ny, perm);
+
+  std::vector<std::int32_t> map = reorder_fn(graph);
+  REQUIRE(map.size() == perm.size());
+
+  // Check that map is a permutation
+  std::vector<std::int32_t> sorted = map;
+  std::ranges::sort(sorted);
+  for (std::size_t i = 0; i < sorted.size(); ++i)
+    CHECK(sorted[i] == static_cast<std::int32_t>(i));
+
+  // Level-set orderings should recover the minimum bandwidth (the
+  // short side) of the grid, and small overshoot is permitted
+  CHECK(bandwidth(graph, map) <= ny + 1);
+}
+
+void test_reorder_disconnected(auto reorder_fn)
+{
+  // Two disconnected paths and an isolated node
+  std::vector<std::vector<std::int32_t>> edges
+      = {{3}, {4}, {}, {0, 5}, {1, 6}, {3}, {4}};
+  graph::AdjacencyList<std::int32_t> graph(edges);
+  std::vector<std::int32_t> map = reorder_fn(graph);
+  std::vector<std::int32_t> sorted = map;
+  std::ranges::sort(sorted);
+  for (std::size_t i = 0; i < sorted.size(); ++i)
+    CHECK(sorted[i] == static_cast<std::int32_t>(i));
+  CHECK(bandwidth(graph, map) == 1);
+}
+} // namespace
+
+TEST_CASE("Reverse Cuthill-McKee reordering", "[graph][ordering]")
+{
+  test_reorder(graph::reorder_rcm);
+  test_reorder_disconnected(graph::reorder_rcm);
+}
+
+TEST_CASE("Gibbs-Poole-Stockmeyer reordering", "[graph][ordering]")
+{
+  test_reorder(graph::reorder_gps);
+  test_reorder_disconnected(graph::reorder_gps);
+}
+
+TEST_CASE("Gibbs-Poole-Stockmeyer reordering with threads",
+          "[graph][ordering]")
+{
+  // Grid with many candidate endpoints in the final level
+  const int nx = 40, ny = 25;
+  std::vector<std::int32_t> perm(nx * ny);
+  std::iota(perm.begin(), perm.end(), 0);
+  for (std::size_t i = 0; i < perm.size(); ++i)
+    std::swap(perm[i], perm[(i * 53) % perm.size()]);
+  auto graph = create_grid_graph(nx, ny, perm);
+
+  // The re-ordering must not depend on the number of threads
+  const int num_threads = common::num_threads();
+  common::set_num_threads(1);
+  const std::vector<std::int32_t> map0 = graph::reorder_gps(graph);
+  common::set_num_threads(4);
+  const std::vector<std::int32_t> map1 = graph::reorder_gps(graph);
+  common::set_num_threads(num_threads);
+  CHECK(map0 == map1);
+  CHECK(bandwidth(graph, map1) <= ny + 1);
+}
@@ -0,0 +1,340 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for graph and space-filling curve partitioning
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/graph/partition.h>
+#include <dolfinx/graph/partitioners.h>
+#include <functional>
+#include <mpi.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+void test_hilbert_keys()
+{
+  // Points of a 4 x 4 grid
+  std::vector<double> x;
+  for (int j = 0; j < 4; ++j)
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      x.push_back(i);
+      x.push_back(j);
+    }
+  }
+
+  std::vector<std::uint64_t> keys = graph::sfc::compute_keys(
+      x, 2, {0, 0, 0}, {3, 3, 0}, graph::sfc::curve::hilbert);
+
+  // Consecutive points along the Hilbert curve are neighbours
+  std::vector<std::size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::sort(order, std::less<>(), [&keys](auto a) { return keys[a]; });
+  for (std::size_t k = 1; k < order.size(); ++k)
+  {
+    double dx = x[2 * order[k]] - x[2 * order[k - 1]];
+    double dy = x[2 * order[k] + 1] - x[2 * order[k - 1] + 1];
+    CHECK(std::abs(dx) + std::abs(dy) == 1.0);
+  }
+
+  // Morton (Z-order) keys interleave the coordinate bits
+  keys = graph::sfc::compute_keys(x, 2, {0, 0, 0}, {3, 3, 0},
+                                  graph::sfc::curve::morton);
+  CHECK(keys[0] == 0);
+  CHECK(keys[4] < keys[1]);
+  CHECK(keys[1] < keys[5]);
+  CHECK(keys[5] < keys[2]);
+}
+
+void test_partition(graph::sfc::curve curve)
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Points on a helix, distributed unevenly across ranks
+  const int n = 100 + 37 * rank;
+  std::vector<double> x;
+  for (int i = 0; i < n; ++i)
+  {
+    double t = 0.01 * (i * size + rank);
+    x.insert(x.end(), {std::cos(t), std::sin(t), 0.1 * t});
+  }
+
+  const int nparts = 2 * size + 1;
+  std::vector<std::int32_t> part
+      = graph::sfc::partition(comm, nparts, x, 3, curve);
+  REQUIRE(part.size() == static_cast<std::size_t>(n));
+
+  // Check that the parts are balanced
+  std::vector<std::int64_t> counts(nparts, 0);
+  for (std::int32_t p : part)
+  {
+    REQUIRE(p >= 0);
+    REQUIRE(p < nparts);
+    ++counts[p];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, counts.data(), counts.size(), MPI_INT64_T,
+                MPI_SUM, comm);
+  const std::int64_t num_points
+      = std::accumulate(counts.begin(), counts.end(), std::int64_t(0));
+  for (std::int64_t c : counts)
+    CHECK(std::abs(c - num_points / nparts) <= 1);
+}
+
+void test_weighted_partition()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Chain graph, with heavy nodes at the start of the chain
+  const std::int64_t n = 40;
+  const std::int64_t num_nodes = n * size;
+  std::vector<std::int64_t> edges;
+  std::vector<std::int32_t> offsets(1, 0);
+  std::vector<std::int32_t> weights;
+  for (std::int64_t i = 0; i < n; ++i)
+  {
+    std::int64_t node = rank * n + i;
+    if (node > 0)
+      edges.push_back(node - 1);
+    if (node < num_nodes - 1)
+      edges.push_back(node + 1);
+    offsets.push_back(edges.size());
+    weights.push_back(node < num_nodes / 4 ? 8 : 1);
+  }
+  graph::AdjacencyList<std::int64_t> graph(std::move(edges),
+                                           std::move(offsets));
+
+  graph::AdjacencyList<std::int32_t> dest
+      = graph::partition_graph(comm, size, graph, false, weights);
+  REQUIRE(dest.num_nodes() == n);
+
+  // Check that the sum of the weights is balanced across parts
+  std::vector<std::int64_t> part_weights(size, 0);
+  for (std::int32_t i = 0; i < dest.num_nodes(); ++i)
+  {
+    REQUIRE(dest.num_links(i) == 1);
+    std::int32_t p = dest.links(i).front();
+    REQUIRE(p >= 0);
+    REQUIRE(p < size);
+    part_weights[p] += weights[i];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, part_weights.data(), part_weights.size(),
+                MPI_INT64_T, MPI_SUM, comm);
+  const std::int64_t total = std::accumulate(
+      part_weights.begin(), part_weights.end(), std::int64_t(0));
+  for (std::int64_t w : part_weights)
+    CHECK(w <= 1.2 * total / size + 8);
+
+  // Node weights must be given for each node
+  weights.pop_back();
+  CHECK_THROWS(graph::partition_graph(comm, size, graph, false, weights));
+}
+
+void test_hierarchical_partition()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Chain graph
+  const std::int64_t n = 20;
+  const std::int64_t num_nodes = n * size;
+  std::vector<std::int64_t> edges;
+  std::vector<std::int32_t> offsets(1, 0);
+  for (std::int64_t i = 0; i < n; ++i)
+  {
+    std::int64_t node = rank * n + i;
+    if (node > 0)
+      edges.push_back(node - 1);
+    if (node < num_nodes - 1)
+      edges.push_back(node + 1);
+    offsets.push_back(edges.size());
+  }
+  graph::AdjacencyList<std::int64_t> graph(std::move(edges),
+                                           std::move(offsets));
+
+  graph::partition_fn partfn
+      = graph::hierarchical::partitioner(&graph::partition_graph);
+  graph::AdjacencyList<std::int32_t> dest
+      = partfn(comm, size, graph, false, {});
+  REQUIRE(dest.num_nodes() == n);
+
+  // Check that every rank is the destination of some nodes
+  std::vector<std::int32_t> num_dest(size, 0);
+  for (std::int32_t i = 0; i < dest.num_nodes(); ++i)
+  {
+    REQUIRE(dest.num_links(i) == 1);
+    std::int32_t p = dest.links(i).front();
+    REQUIRE(p >= 0);
+    REQUIRE(p < size);
+    ++num_dest[p];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, num_dest.data(), num_dest.size(), MPI_INT32_T,
+                MPI_SUM, comm);
+  for (std::int32_t c : num_dest)
+    CHECK(c > 0);
+
+  // The owners of the partition with ghosting are the same
+  graph::AdjacencyList<std::int32_t> dest_ghosted
+      = partfn(comm, size, graph, true, {});
+  REQUIRE(dest_ghosted.num_nodes() == n);
+  for (std::int32_t i = 0; i < dest.num_nodes(); ++i)
+    CHECK(dest_ghosted.links(i).front() == dest.links(i).front());
+}
+
+void test_distribute_routing()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Nodes with a varying number of edges, sent to scattered owners and
+  // a ghost rank for every third node
+  const std::int64_t n = 50;
+  std::vector<std::int64_t> edges;
+  std::vector<std::int32_t> offsets(1, 0), dest_data, dest_offsets(1, 0);
+  for (std::int64_t i = 0; i < n; ++i)
+  {
+    std::int64_t node = rank * n + i;
+    for (std::int64_t j = 0; j < 1 + node % 3; ++j)
+      edges.push_back(node + j);
+    offsets.push_back(edges.size());
+    int owner = (7 * node + 3) % size;
+    dest_data.push_back(owner);
+    if (node % 3 == 0 and size > 1)
+      dest_data.push_back((owner + 1) % size);
+    dest_offsets.push_back(dest_data.size());
+  }
+  graph::AdjacencyList<std::int64_t> list(edges, offsets);
+  graph::AdjacencyList<std::int32_t> dest(dest_data, dest_offsets);
+
+  // The distributed data does not depend on the routing
+  auto [list0, src0, idx0, ghosts0] = graph::build::distribute(
+      comm, list, dest, graph::build::routing::direct);
+  auto [list1, src1, idx1, ghosts1] = graph::build::distribute(
+      comm, list, dest, graph::build::routing::two_phase);
+  CHECK(std::ranges::equal(list0.array(), list1.array()));
+  CHECK(std::ranges::equal(list0.offsets(), list1.offsets()));
+  CHECK(src0 == src1);
+  CHECK(idx0 == idx1);
+  CHECK(ghosts0 == ghosts1);
+
+  std::vector<std::int64_t> rows(2 * n);
+  for (std::int64_t i = 0; i < n; ++i)
+    rows[2 * i] = rows[2 * i + 1] = rank * n + i;
+  auto [rows0, rsrc0, ridx0, rghosts0] = graph::build::distribute(
+      comm, rows, {std::size_t(n), 2}, dest, graph::build::routing::direct);
+  auto [rows1, rsrc1, ridx1, rghosts1]
+      = graph::build::distribute(comm, rows, {std::size_t(n), 2}, dest,
+                                 graph::build::routing::two_phase);
+  CHECK(rows0 == rows1);
+  CHECK(rsrc0 == rsrc1);
+  CHECK(ridx0 == ridx1);
+  CHECK(rghosts0 == rghosts1);
+}
+
+void test_diffusive_partition()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Chain graph that is distributed unevenly across ranks
+  const std::int64_t n = rank % 2 == 0 ? 100 : 120;
+  std::int64_t offset = 0;
+  MPI_Exscan(&n, &offset, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::int64_t num_nodes = 0;
+  MPI_Allreduce(&n, &num_nodes, 1, MPI_INT64_T, MPI_SUM, comm);
+  std::vector<std::int64_t> edges;
+  std::vector<std::int32_t> offsets(1, 0);
+  for (std::int64_t i = offset; i < offset + n; ++i)
+  {
+    if (i > 0)
+      edges.push_back(i - 1);
+    if (i < num_nodes - 1)
+      edges.push_back(i + 1);
+    offsets.push_back(edges.size());
+  }
+  graph::AdjacencyList<std::int64_t> graph(edges, offsets);
+
+  graph::AdjacencyList<std::int32_t> dest
+      = graph::diffusion::partitioner(1.05)(comm, size, graph, false, {});
+  REQUIRE(dest.num_nodes() == n);
+
+  // Nodes are only moved to a neighbouring rank
+  std::vector<std::int64_t> counts(size, 0);
+  std::int64_t moved = 0;
+  for (std::int32_t i = 0; i < dest.num_nodes(); ++i)
+  {
+    REQUIRE(dest.num_links(i) == 1);
+    int p = dest.links(i).front();
+    CHECK(std::abs(p - rank) <= 1);
+    ++counts[p];
+    moved += p != rank;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, counts.data(), counts.size(), MPI_INT64_T,
+                MPI_SUM, comm);
+  MPI_Allreduce(MPI_IN_PLACE, &moved, 1, MPI_INT64_T, MPI_SUM, comm);
+
+  // Check that the parts are balanced, and that the number of moved
+  // nodes is close to the excess of the overloaded ranks, which is
+  // the least number of nodes that must be moved
+  const double average = static_cast<double>(num_nodes) / size;
+  for (std::int64_t c : counts)
+    CHECK(c <= 1.05 * average + 1);
+  double excess = 0;
+  for (int r = 0; r < size; ++r)
+    excess += std::max(0.0, (r % 2 == 0 ? 100 : 120) - average);
+  CHECK(moved <= 2 * excess + size);
+
+  // No nodes are moved if the partition is within the tolerance
+  graph::AdjacencyList<std::int32_t> dest1
+      = graph::diffusion::partitioner(2.0)(comm, size, graph, true, {});
+  for (std::int32_t i = 0; i < dest1.num_nodes(); ++i)
+    CHECK(dest1.links(i).front() == rank);
+}
+} // namespace
+
+TEST_CASE("Distribute with two-phase routing", "[graph][distribute]")
+{
+  test_distribute_routing();
+}
+
+TEST_CASE("Weighted graph partition", "[graph][partition]")
+{
+  test_weighted_partition();
+}
+
+TEST_CASE("Hierarchical graph partition", "[graph][partition]")
+{
+  test_hierarchical_partition();
+}
+
+TEST_CASE("Diffusive graph repartition", "[graph][partition]")
+{
+  test_diffusive_partition();
+}
+
+TEST_CASE("Space-filling curve keys", "[graph][sfc]") { test_hilbert_keys(); }
+
+TEST_CASE("Space-filling curve partition", "[graph][sfc]")
+{
+  test_partition(graph::sfc::curve::hilbert);
+  test_partition(graph::sfc::curve::morton);
+}
@@ -53,6 +53,117 @@ void test_vtx_reuse_mesh()
 
   writer.write(1);
 }
+
+template <std::floating_point T>
+void test_vtx_async()
+{
+  auto mesh = std::make_shared<mesh::Mesh<T>>(
+      mesh::create_rectangle<T>(MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}},
+                                {12, 8}, mesh::CellType::triangle));
+  basix::FiniteElement e = basix::create_element<T>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<T>>(fem::create_functionspace<T>(
+      mesh, std::make_shared<fem::FiniteElement<T>>(e)));
+  auto u = std::make_shared<fem::Function<T>>(V);
+
+  std::filesystem::path f
+      = "test_vtx_async" + std::to_string(sizeof(T)) + ".bp";
+  io::VTXWriter<T> writer(mesh->comm(), f, {u}, "BP5", io::VTXMeshPolicy::reuse,
+                          io::VTXWritePolicy::async);
+  for (int step = 0; step < 3; ++step)
+  {
+    // Function may be modified as soon as write returns
+    writer.write(step);
+    std::ranges::fill(u->x()->mutable_array(), step + 1);
+  }
+  writer.close();
+
+  // Asynchronous output requires BP5
+  CHECK_THROWS(io::VTXWriter<T>(mesh->comm(), f, {u}, "BP4",
+                                io::VTXMeshPolicy::reuse,
+                                io::VTXWritePolicy::async));
+}
+
+template <std::floating_point T>
+void test_vtx_compression()
+{
+  auto mesh = std::make_shared<mesh::Mesh<T>>(
+      mesh::create_rectangle<T>(MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}},
+                                {12, 8}, mesh::CellType::triangle));
+  basix::FiniteElement e = basix::create_element<T>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<T>>(fem::create_functionspace<T>(
+      mesh, std::make_shared<fem::FiniteElement<T>>(e)));
+  auto u = std::make_shared<fem::Function<T>>(V);
+  u->name = "u";
+  auto v = std::make_shared<fem::Function<std::complex<T>>>(V);
+  v->name = "v";
+
+  std::filesystem::path f
+      = "test_vtx_compression" + std::to_string(sizeof(T)) + ".bp";
+
+  // Compression of a function that is not written
+  CHECK_THROWS(io::VTXWriter<T>(
+      mesh->comm(), f, {u}, "BPFile", io::VTXMeshPolicy::reuse,
+      io::VTXWritePolicy::sync, {{"w", {"blosc"}}}));
+
+#ifdef ADIOS2_HAVE_ZFP
+  io::VTXCompression zfp = io::VTXCompression::lossy("zfp", 1e-6);
+  CHECK(zfp.params.at("accuracy") == "1e-06");
+  io::VTXWriter<T> writer(mesh->comm(), f, {u, v}, "BPFile",
+                          io::VTXMeshPolicy::reuse, io::VTXWritePolicy::sync,
+                          {{"u", zfp}, {"v", zfp}});
+  for (int step = 0; step < 2; ++step)
+  {
+    std::ranges::fill(u->x()->mutable_array(), step + 0.5);
+    writer.write(step);
+  }
+  writer.close();
+#endif
+}
+
+template <std::floating_point T>
+void test_vtx_stream()
+{
+  auto mesh = std::make_shared<mesh::Mesh<T>>(
+      mesh::create_rectangle<T>(MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}},
+                                {12, 8}, mesh::CellType::triangle));
+  basix::FiniteElement e = basix::create_element<T>(
+      basix::element::family::P,
+      mesh::cell_type_to_basix_type(mesh::CellType::triangle), 1,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<T>>(fem::create_functionspace<T>(
+      mesh, std::make_shared<fem::FiniteElement<T>>(e)));
+  auto u = std::make_shared<fem::Function<T>>(V);
+
+  std::filesystem::path f = "test_vtx_stream" + std::to_string(sizeof(T));
+
+  // Streaming requires SST
+  CHECK_THROWS(io::VTXWriter<T>(mesh->comm(), f, {u}, "BP5",
+                                io::VTXMeshPolicy::reuse,
+                                io::VTXWritePolicy::stream));
+
+#ifdef ADIOS2_HAVE_SST
+  // Writing must not wait for a reader to connect, or block when the
+  // queue of steps is full
+  io::VTXWriter<T> writer(mesh->comm(), f, {u}, "SST",
+                          io::VTXMeshPolicy::reuse,
+                          io::VTXWritePolicy::stream);
+  for (int step = 0; step < 2 * io::impl_vtx::stream_queue_limit; ++step)
+  {
+    std::ranges::fill(u->x()->mutable_array(), step);
+    writer.write(step);
+  }
+  writer.close();
+#endif
+}
 } // namespace
 
 TEST_CASE("VTX reuse mesh")
@@ -61,4 +172,22 @@ TEST_CASE("VTX reuse mesh")
   CHECK_NOTHROW(test_vtx_reuse_mesh<double>());
 }
 
+TEST_CASE("VTX asynchronous write")
+{
+  CHECK_NOTHROW(test_vtx_async<float>());
+  CHECK_NOTHROW(test_vtx_async<double>());
+}
+
+TEST_CASE("VTX compression")
+{
+  CHECK_NOTHROW(test_vtx_compression<float>());
+  CHECK_NOTHROW(test_vtx_compression<double>());
+}
+
+TEST_CASE("VTX streaming")
+{
+  CHECK_NOTHROW(test_vtx_stream<float>());
+  CHECK_NOTHROW(test_vtx_stream<double>());
+}
+
 #endif
@@ -0,0 +1,116 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for checkpointing of Functions
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/io/checkpointing.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/rebalance.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <mpi.h>
+#include <tuple>
+
+using namespace dolfinx;
+
+namespace
+{
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh,
+             basix::element::family family, int degree)
+{
+  auto element = basix::create_element<double>(
+      family, mesh::cell_type_to_basix_type(mesh->topology()->cell_type()),
+      degree, basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+}
+
+/// Interpolate the field (x1, x0 + x2, 2 x1) or its first component
+void interpolate(fem::Function<double>& u, std::size_t value_size)
+{
+  u.interpolate(
+      [value_size](auto x)
+          -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f(value_size * x.extent(1));
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+        {
+          f[p] = x(1, p);
+          if (value_size == 3)
+          {
+            f[x.extent(1) + p] = x(0, p) + x(2, p);
+            f[2 * x.extent(1) + p] = 2 * x(1, p);
+          }
+        }
+        return {f, {value_size, x.extent(1)}};
+      });
+}
+} // namespace
+
+TEST_CASE("Checkpoint functions", "[io][checkpointing]")
+{
+  auto [family, degree, value_size]
+      = GENERATE(std::tuple(basix::element::family::P, 2, 1),
+                 std::tuple(basix::element::family::N1E, 2, 3));
+
+  auto mesh0 = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {4, 3, 3}, mesh::CellType::tetrahedron,
+                               mesh::create_cell_partitioner()));
+  auto V0 = create_space(mesh0, family, degree);
+  fem::Function<double> u0(V0);
+  interpolate(u0, value_size);
+
+  std::filesystem::path f = "test_checkpoint.h5";
+  io::checkpointing::write_function(f, u0, "u");
+
+  SECTION("same mesh")
+  {
+    fem::Function<double> u1(V0);
+    io::checkpointing::read_function(f, u1, "u");
+    std::span<const double> x0 = u0.x()->array();
+    std::span<const double> x1 = u1.x()->array();
+    REQUIRE(x1.size() == x0.size());
+    for (std::size_t i = 0; i < x1.size(); ++i)
+      CHECK(x1[i] == x0[i]);
+  }
+
+  SECTION("redistributed mesh")
+  {
+    auto [m1, dest] = mesh::rebalance(
+        *mesh0, mesh::create_cell_partitioner(mesh::GhostMode::shared_facet));
+    auto mesh1 = std::make_shared<mesh::Mesh<double>>(std::move(m1));
+    auto V1 = create_space(mesh1, family, degree);
+    fem::Function<double> u1(V1), u_ref(V1);
+    interpolate(u_ref, value_size);
+
+    io::checkpointing::read_function(f, u1, "u");
+    std::span<const double> x1 = u1.x()->array();
+    std::span<const double> x_ref = u_ref.x()->array();
+    REQUIRE(x1.size() == x_ref.size());
+    for (std::size_t i = 0; i < x1.size(); ++i)
+      CHECK(x1[i] == Catch::Approx(x_ref[i]).margin(1e-12));
+  }
+
+  SECTION("missing checkpoint")
+  {
+    fem::Function<double> u1(V0);
+    CHECK_THROWS(io::checkpointing::read_function(f, u1, "v"));
+  }
+}
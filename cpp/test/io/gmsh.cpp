@@ -0,0 +1,169 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for reading Gmsh MSH files
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/io/gmsh.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <fstream>
+#include <mpi.h>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+template <typename T>
+void write(std::ofstream& f, T v)
+{
+  f.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+/// Write a binary MSH 4.1 file of a unit square with nx x ny squares,
+/// each split into two triangles. Nodes are in two blocks and have
+/// non-contiguous tags. The first `num_tagged` cells are in a surface
+/// with physical group 7, the remaining cells are in a surface with no
+/// physical group, and the bottom boundary is in physical group 5.
+void write_msh(const std::filesystem::path& filename, int nx, int ny,
+               int num_tagged)
+{
+  auto tag = [](std::size_t n) -> std::size_t { return 10 + 3 * n; };
+  const std::size_t num_nodes = (nx + 1) * (ny + 1);
+
+  std::ofstream f(filename, std::ios::binary);
+  f << "$MeshFormat\n4.1 1 8\n";
+  write<int>(f, 1);
+  f << "\n$EndMeshFormat\n";
+
+  f << "$Entities\n";
+  for (std::size_t n : {0, 1, 2, 0})
+    write<std::size_t>(f, n);
+  for (auto [t, p] : {std::pair(1, 5), std::pair(1, 7), std::pair(2, -1)})
+  {
+    write<int>(f, t);
+    for (double b : {0.0, 0.0, 0.0, 1.0, 1.0, 1.0})
+      write<double>(f, b);
+    write<std::size_t>(f, p < 0 ? 0 : 1);
+    if (p >= 0)
+      write<int>(f, p);
+    write<std::size_t>(f, 0);
+  }
+  f << "\n$EndEntities\n";
+
+  f << "$Nodes\n";
+  for (std::size_t n : {std::size_t(2), num_nodes, tag(0), tag(num_nodes - 1)})
+    write<std::size_t>(f, n);
+  const std::size_t split = num_nodes / 2;
+  for (auto [n0, n1] : {std::pair(std::size_t(0), split),
+                        std::pair(split, num_nodes)})
+  {
+    for (int v : {2, 1, 0})
+      write<int>(f, v);
+    write<std::size_t>(f, n1 - n0);
+    for (std::size_t n = n0; n < n1; ++n)
+      write<std::size_t>(f, tag(n));
+    for (std::size_t n = n0; n < n1; ++n)
+    {
+      write<double>(f, double(n % (nx + 1)) / nx);
+      write<double>(f, double(n / (nx + 1)) / ny);
+      write<double>(f, 0.0);
+    }
+  }
+  f << "\n$EndNodes\n";
+
+  std::vector<std::size_t> cells;
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      std::size_t v0 = j * (nx + 1) + i;
+      std::size_t v1 = v0 + 1, v2 = v0 + nx + 1, v3 = v2 + 1;
+      cells.insert(cells.end(), {v0, v1, v3, v0, v3, v2});
+    }
+  }
+  const std::size_t num_cells = cells.size() / 3;
+
+  f << "$Elements\n";
+  for (std::size_t n : {std::size_t(3), num_cells + nx, std::size_t(1),
+                        num_cells + nx})
+  {
+    write<std::size_t>(f, n);
+  }
+  std::size_t e = 1;
+  for (auto [entity, c0, c1] : {std::tuple(1, std::size_t(0),
+                                           std::size_t(num_tagged)),
+                                std::tuple(2, std::size_t(num_tagged),
+                                           num_cells)})
+  {
+    for (int v : {2, entity, 2})
+      write<int>(f, v);
+    write<std::size_t>(f, c1 - c0);
+    for (std::size_t c = c0; c < c1; ++c)
+    {
+      write<std::size_t>(f, e++);
+      for (int v = 0; v < 3; ++v)
+        write<std::size_t>(f, tag(cells[3 * c + v]));
+    }
+  }
+  for (int v : {1, 1, 1})
+    write<int>(f, v);
+  write<std::size_t>(f, nx);
+  for (int i = 0; i < nx; ++i)
+  {
+    write<std::size_t>(f, e++);
+    write<std::size_t>(f, tag(i));
+    write<std::size_t>(f, tag(i + 1));
+  }
+  f << "\n$EndElements\n";
+}
+} // namespace
+
+TEST_CASE("Read Gmsh mesh", "[io][gmsh]")
+{
+  auto mode = GENERATE(mesh::GhostMode::none, mesh::GhostMode::shared_facet);
+
+  const int nx = 6, ny = 5, num_tagged = 23;
+  std::filesystem::path f = "test_read_gmsh.msh";
+  if (dolfinx::MPI::rank(MPI_COMM_WORLD) == 0)
+    write_msh(f, nx, ny, num_tagged);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  auto [mesh, cell_tags, facet_tags]
+      = io::gmsh::read_mesh(MPI_COMM_WORLD, f, 2, mode);
+  auto topology = mesh.topology();
+  CHECK(topology->index_map(2)->size_global() == 2 * nx * ny);
+  CHECK(mesh.geometry().index_map()->size_global() == (nx + 1) * (ny + 1));
+
+  // Count owned tagged cells and facets
+  auto count_owned = [](const mesh::MeshTags<std::int32_t>& tags,
+                        std::int32_t num_owned, std::int32_t value)
+  {
+    std::int64_t n = 0;
+    for (std::size_t i = 0; i < tags.indices().size(); ++i)
+      n += tags.indices()[i] < num_owned and tags.values()[i] == value;
+    MPI_Allreduce(MPI_IN_PLACE, &n, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    return n;
+  };
+  CHECK(count_owned(cell_tags, topology->index_map(2)->size_local(), 7)
+        == num_tagged);
+  CHECK(cell_tags.indices().size() == cell_tags.values().size());
+  CHECK(count_owned(facet_tags, topology->index_map(1)->size_local(), 5)
+        == nx);
+
+  // Tagged facets lie on the bottom boundary
+  std::vector<double> x_mid
+      = mesh::compute_midpoints(mesh, 1, facet_tags.indices());
+  for (std::size_t i = 0; i < facet_tags.indices().size(); ++i)
+    CHECK(x_mid[3 * i + 1] == 0.0);
+}
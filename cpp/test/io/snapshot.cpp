@@ -0,0 +1,106 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for binary mesh snapshots
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/io/snapshot.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/generation.h>
+#include <filesystem>
+#include <memory>
+#include <mpi.h>
+#include <span>
+
+using namespace dolfinx;
+
+namespace
+{
+void check_index_maps(const common::IndexMap& map0,
+                      const common::IndexMap& map1)
+{
+  CHECK(map1.local_range() == map0.local_range());
+  CHECK(map1.size_global() == map0.size_global());
+  CHECK(std::ranges::equal(map1.ghosts(), map0.ghosts()));
+  CHECK(std::ranges::equal(map1.owners(), map0.owners()));
+  CHECK(std::ranges::equal(map1.src(), map0.src()));
+  CHECK(std::ranges::equal(map1.dest(), map0.dest()));
+}
+} // namespace
+
+TEST_CASE("Mesh snapshot", "[io][snapshot]")
+{
+  mesh::Mesh<double> mesh0 = mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 4, 2},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::shared_facet));
+  mesh0.name = "box";
+  auto topology0 = mesh0.topology_mutable();
+  topology0->create_entity_permutations();
+  topology0->create_connectivity(2, 3);
+
+  std::filesystem::path f = "test_mesh_snapshot";
+  io::snapshot::write(f, mesh0);
+  mesh::Mesh<double> mesh1 = io::snapshot::read<double>(MPI_COMM_WORLD, f);
+  CHECK(mesh1.name == "box");
+
+  auto topology1 = mesh1.topology();
+  REQUIRE(topology1->dim() == 3);
+  for (int d0 = 0; d0 <= 3; ++d0)
+  {
+    REQUIRE(topology1->index_map(d0));
+    check_index_maps(*topology0->index_map(d0), *topology1->index_map(d0));
+    for (int d1 = 0; d1 <= 3; ++d1)
+    {
+      auto c0 = topology0->connectivity(d0, d1);
+      auto c1 = topology1->connectivity(d0, d1);
+      REQUIRE(bool(c0) == bool(c1));
+      if (c0)
+        CHECK(*c0 == *c1);
+    }
+  }
+
+  CHECK(topology1->original_cell_index == topology0->original_cell_index);
+  CHECK(topology1->cell_ranges() == topology0->cell_ranges());
+  CHECK(topology1->interprocess_facets() == topology0->interprocess_facets());
+  CHECK(topology1->get_cell_permutation_info()
+        == topology0->get_cell_permutation_info());
+  CHECK(topology1->get_facet_permutations()
+        == topology0->get_facet_permutations());
+
+  const mesh::Geometry<double>& geometry0 = mesh0.geometry();
+  const mesh::Geometry<double>& geometry1 = mesh1.geometry();
+  check_index_maps(*geometry0.index_map(), *geometry1.index_map());
+  CHECK(geometry1.dim() == geometry0.dim());
+  CHECK(geometry1.cmap().degree() == geometry0.cmap().degree());
+  CHECK(std::ranges::equal(geometry1.x(), geometry0.x()));
+  auto dofmap0 = geometry0.dofmap();
+  auto dofmap1 = geometry1.dofmap();
+  CHECK(std::ranges::equal(std::span(dofmap1.data_handle(), dofmap1.size()),
+                           std::span(dofmap0.data_handle(), dofmap0.size())));
+  CHECK(geometry1.input_global_indices() == geometry0.input_global_indices());
+
+  SECTION("compact coordinate storage")
+  {
+    mesh::Mesh<double> mesh2 = mesh::create_rectangle<double>(
+        MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {4, 3},
+        mesh::CellType::triangle);
+    mesh2.geometry().set_x_stride(2);
+    io::snapshot::write(f, mesh2);
+    mesh::Mesh<double> mesh3 = io::snapshot::read<double>(MPI_COMM_WORLD, f);
+    CHECK(mesh3.geometry().x_stride() == 2);
+    CHECK(std::ranges::equal(mesh3.geometry().x(), mesh2.geometry().x()));
+  }
+
+  SECTION("wrong value type")
+  {
+    CHECK_THROWS(io::snapshot::read<float>(MPI_COMM_WORLD, f));
+  }
+}
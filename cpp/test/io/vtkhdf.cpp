@@ -0,0 +1,139 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for VTKHDF output
+
+#include <algorithm>
+#include <basix/finite-element.h>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/io/HDF5Interface.h>
+#include <dolfinx/io/VTKHDFFile.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <optional>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+void test_vtkhdf_write()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {12, 8},
+      mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mesh::GhostMode::shared_facet)));
+
+  auto create_space
+      = [mesh](int degree, std::optional<std::vector<std::size_t>> shape)
+  {
+    basix::FiniteElement e = basix::create_element<double>(
+        basix::element::family::P,
+        mesh::cell_type_to_basix_type(mesh::CellType::triangle), degree,
+        basix::element::lagrange_variant::unset,
+        basix::element::dpc_variant::unset, degree == 0);
+    return std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(
+            mesh, std::make_shared<fem::FiniteElement<double>>(e, shape)));
+  };
+
+  auto V = create_space(2, std::nullopt);
+  auto W = create_space(2, std::vector<std::size_t>{2});
+  auto Q = create_space(0, std::nullopt);
+  fem::Function<double> u(V), w(W), q(Q);
+  u.name = "u";
+  w.name = "w";
+  q.name = "q";
+
+  std::filesystem::path f = "test_vtkhdf_write.vtkhdf";
+  {
+    io::VTKHDFFile file(mesh->comm(), f);
+    for (int step = 0; step < 3; ++step)
+    {
+      std::ranges::fill(u.x()->mutable_array(), step);
+      file.write<double>({u, w, q}, 0.1 * step);
+    }
+
+    // The data arrays must be the same at each time step
+    CHECK_THROWS(file.write<double>({u, w}, 0.3));
+    CHECK_THROWS(file.write(*mesh, 0.3));
+  }
+
+  // The grid is written once and shared by all time steps
+  const int size = dolfinx::MPI::size(mesh->comm());
+  auto map = V->dofmap()->index_map;
+  const std::int64_t num_nodes = map->size_local() + map->num_ghosts();
+  const std::int64_t num_cells = mesh->topology()->index_map(2)->size_local();
+  std::int64_t num_nodes_g = 0, num_cells_g = 0;
+  MPI_Allreduce(&num_nodes, &num_nodes_g, 1, MPI_INT64_T, MPI_SUM,
+                mesh->comm());
+  MPI_Allreduce(&num_cells, &num_cells_g, 1, MPI_INT64_T, MPI_SUM,
+                mesh->comm());
+  CHECK(num_cells_g == mesh->topology()->index_map(2)->size_global());
+
+  hid_t h5 = io::hdf5::open_file(mesh->comm(), f, "r", size > 1);
+  auto shape = [h5](std::string path)
+  { return io::hdf5::get_dataset_shape(h5, "/VTKHDF/" + path); };
+  CHECK(shape("NumberOfPoints") == std::vector<std::int64_t>{size});
+  CHECK(shape("Points") == std::vector<std::int64_t>{num_nodes_g, 3});
+  CHECK(shape("Types") == std::vector<std::int64_t>{num_cells_g});
+  CHECK(shape("Offsets") == std::vector<std::int64_t>{num_cells_g + size});
+  CHECK(shape("Connectivity") == std::vector<std::int64_t>{6 * num_cells_g});
+  CHECK(shape("Steps/Values") == std::vector<std::int64_t>{3});
+  CHECK(shape("Steps/PointOffsets") == std::vector<std::int64_t>{3});
+  CHECK(shape("PointData/u") == std::vector<std::int64_t>{3 * num_nodes_g});
+  CHECK(shape("PointData/w") == std::vector<std::int64_t>{3 * num_nodes_g, 3});
+  CHECK(shape("CellData/q") == std::vector<std::int64_t>{3 * num_cells_g});
+
+  // Offsets of the point data of each time step
+  hid_t dset = io::hdf5::open_dataset(h5, "/VTKHDF/Steps/PointDataOffsets/u");
+  std::vector<std::int64_t> offsets
+      = io::hdf5::read_dataset<std::int64_t>(dset, {-1, -1}, false);
+  H5Dclose(dset);
+  CHECK(offsets
+        == std::vector<std::int64_t>{0, num_nodes_g, 2 * num_nodes_g});
+  io::hdf5::close_file(h5);
+}
+
+void test_vtkhdf_write_mesh()
+{
+  auto mesh = mesh::create_box(MPI_COMM_WORLD,
+                               {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {3, 4, 5},
+                               mesh::CellType::hexahedron);
+  std::filesystem::path f = "test_vtkhdf_write_mesh.vtkhdf";
+  {
+    io::VTKHDFFile file(mesh.comm(), f);
+    file.write(mesh, 0.0);
+    file.write(mesh, 1.0);
+  }
+
+  // The grid of a mesh is written at each time step, since the
+  // geometry may change
+  const int size = dolfinx::MPI::size(mesh.comm());
+  const std::int64_t num_cells_g
+      = mesh.topology()->index_map(3)->size_global();
+  hid_t h5 = io::hdf5::open_file(mesh.comm(), f, "r", size > 1);
+  CHECK(io::hdf5::get_dataset_shape(h5, "/VTKHDF/NumberOfCells")
+        == std::vector<std::int64_t>{2 * size});
+  CHECK(io::hdf5::get_dataset_shape(h5, "/VTKHDF/Types")
+        == std::vector<std::int64_t>{2 * num_cells_g});
+  io::hdf5::close_file(h5);
+}
+} // namespace
+
+TEST_CASE("Write VTKHDF functions", "[io][vtkhdf]") { test_vtkhdf_write(); }
+
+TEST_CASE("Write VTKHDF mesh", "[io][vtkhdf]") { test_vtkhdf_write_mesh(); }
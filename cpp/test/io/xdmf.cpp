@@ -0,0 +1,250 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for XDMF mesh input/output
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <filesystem>
+#include <mpi.h>
+#include <numeric>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+void test_read_partitioned_mesh(mesh::GhostMode mode)
+{
+  auto mesh0 = mesh::create_rectangle<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {15, 11},
+      mesh::CellType::triangle, mesh::create_cell_partitioner(mode));
+
+  std::filesystem::path f = "test_read_partitioned_mesh.xdmf";
+  {
+    io::XDMFFile file(MPI_COMM_WORLD, f, "w");
+    file.write_mesh(mesh0);
+  }
+
+  io::XDMFFile file(MPI_COMM_WORLD, f, "r");
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh1 = file.read_mesh(cmap, mode, "mesh");
+
+  const int tdim = mesh1.topology()->dim();
+  auto map0 = mesh0.topology()->index_map(tdim);
+  auto map1 = mesh1.topology()->index_map(tdim);
+  CHECK(map1->size_global() == map0->size_global());
+  CHECK(mesh1.geometry().index_map()->size_global()
+        == mesh0.geometry().index_map()->size_global());
+
+  // Without ghosting, the cells that were owned by each process when
+  // writing are read back on the same process
+  if (mode == mesh::GhostMode::none)
+    CHECK(map1->size_local() == map0->size_local());
+}
+
+void test_read_mesh_stored_partition_subcomm(mesh::GhostMode mode)
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto mesh0 = mesh::create_rectangle<double>(
+      comm, {{{0.0, 0.0}, {1.0, 1.0}}}, {15, 11}, mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mode));
+
+  std::filesystem::path f = "test_read_mesh_stored_partition_subcomm.xdmf";
+  {
+    io::XDMFFile file(comm, f, "w");
+    file.write_mesh(mesh0);
+  }
+
+  // Number of cells owned by each process when writing
+  const int tdim = mesh0.topology()->dim();
+  auto map0 = mesh0.topology()->index_map(tdim);
+  const int size = dolfinx::MPI::size(comm);
+  std::vector<std::int32_t> num_cells0(size);
+  const std::int32_t num_local0 = map0->size_local();
+  MPI_Allgather(&num_local0, 1, MPI_INT32_T, num_cells0.data(), 1,
+                MPI_INT32_T, comm);
+
+  // Read the mesh on the even ranks
+  const int rank = dolfinx::MPI::rank(comm);
+  MPI_Comm subcomm = MPI_COMM_NULL;
+  MPI_Comm_split(comm, rank % 2 == 0 ? 0 : MPI_UNDEFINED, rank, &subcomm);
+  if (subcomm != MPI_COMM_NULL)
+  {
+    io::XDMFFile file(subcomm, f, "r");
+    fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 1);
+    mesh::Mesh<double> mesh1 = file.read_mesh(cmap, mode, "mesh");
+
+    auto map1 = mesh1.topology()->index_map(tdim);
+    CHECK(map1->size_global() == map0->size_global());
+    CHECK(mesh1.geometry().index_map()->size_global()
+          == mesh0.geometry().index_map()->size_global());
+
+    // The cells of consecutive processes when writing are merged
+    const int subrank = dolfinx::MPI::rank(subcomm);
+    const int subsize = dolfinx::MPI::size(subcomm);
+    std::int32_t num_local1 = 0;
+    for (int p = 0; p < size; ++p)
+    {
+      if (p * subsize / size == subrank)
+        num_local1 += num_cells0[p];
+    }
+    CHECK(map1->size_local() == num_local1);
+
+    MPI_Comm_free(&subcomm);
+  }
+}
+
+void test_compressed_mesh()
+{
+  auto mesh0 = mesh::create_rectangle<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {32, 32},
+      mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+
+  std::filesystem::path f = "test_compressed_mesh.xdmf";
+  {
+    io::XDMFFile file(MPI_COMM_WORLD, f, "w", io::XDMFFile::Encoding::HDF5,
+                      {{"romio_cb_write", "enable"}});
+    file.write_mesh(mesh0, "/Xdmf/Domain",
+                    io::hdf5::DatasetOptions{.chunk_size = 256,
+                                             .compression_level = 4});
+  }
+
+  io::XDMFFile file(MPI_COMM_WORLD, f, "r");
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh1
+      = file.read_mesh(cmap, mesh::GhostMode::none, "mesh");
+
+  const int tdim = mesh1.topology()->dim();
+  CHECK(mesh1.topology()->index_map(tdim)->size_global()
+        == mesh0.topology()->index_map(tdim)->size_global());
+  CHECK(mesh1.geometry().index_map()->size_global()
+        == mesh0.geometry().index_map()->size_global());
+}
+
+void test_write_mesh_once()
+{
+  auto mesh = mesh::create_rectangle<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {8, 8},
+      mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+
+  io::XDMFFile file(MPI_COMM_WORLD, "test_write_mesh_once.xdmf", "w");
+  file.write_mesh(mesh);
+
+  // Writing the unchanged mesh again is a no-op
+  file.write_mesh(mesh);
+
+  // A mesh with the same name that has changed cannot be written
+  for (double& x : mesh.geometry().x())
+    x *= 2;
+  CHECK_THROWS(file.write_mesh(mesh));
+}
+
+void test_read_mesh_chunked(mesh::GhostMode mode)
+{
+  auto mesh0 = mesh::create_rectangle<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {15, 11},
+      mesh::CellType::triangle, mesh::create_cell_partitioner(mode));
+
+  std::filesystem::path f = "test_read_mesh_chunked.xdmf";
+  {
+    io::XDMFFile file(MPI_COMM_WORLD, f, "w");
+    file.write_mesh(mesh0);
+  }
+
+  io::XDMFFile file(MPI_COMM_WORLD, f, "r");
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh1
+      = file.read_mesh(cmap, mode, "mesh", "/Xdmf/Domain", 7);
+
+  const int tdim = mesh1.topology()->dim();
+  auto map1 = mesh1.topology()->index_map(tdim);
+  const std::int64_t num_cells = map1->size_global();
+  CHECK(num_cells == mesh0.topology()->index_map(tdim)->size_global());
+  CHECK(mesh1.geometry().index_map()->size_global()
+        == mesh0.geometry().index_map()->size_global());
+
+  // The original indices of the owned cells are the cell indices in
+  // the file, and each index appears once
+  const std::vector<std::int64_t>& idx
+      = mesh1.topology()->original_cell_index.front();
+  std::int64_t sum = std::accumulate(
+      idx.begin(), std::next(idx.begin(), map1->size_local()),
+      std::int64_t(0));
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  CHECK(sum == num_cells * (num_cells - 1) / 2);
+  CHECK(std::ranges::all_of(idx, [num_cells](auto i)
+                            { return i >= 0 and i < num_cells; }));
+}
+
+void test_async_mesh()
+{
+  auto mesh0 = mesh::create_rectangle<double>(
+      MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {15, 11},
+      mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+
+  // Asynchronous operations are only enabled with the HDF5 async VOL
+  // connector, and the blocking operations are used otherwise
+  std::filesystem::path f = "test_async_mesh.xdmf";
+  {
+    io::XDMFFile file(MPI_COMM_WORLD, f, "w");
+    file.set_async(true);
+    file.write_mesh(mesh0);
+    file.flush();
+  }
+
+  io::XDMFFile file(MPI_COMM_WORLD, f, "r");
+  file.set_async(true);
+  fem::CoordinateElement<double> cmap(mesh::CellType::triangle, 1);
+  mesh::Mesh<double> mesh1
+      = file.read_mesh(cmap, mesh::GhostMode::none, "mesh");
+
+  const int tdim = mesh1.topology()->dim();
+  auto map0 = mesh0.topology()->index_map(tdim);
+  auto map1 = mesh1.topology()->index_map(tdim);
+  CHECK(map1->size_global() == map0->size_global());
+  CHECK(map1->size_local() == map0->size_local());
+  CHECK(mesh1.geometry().index_map()->size_global()
+        == mesh0.geometry().index_map()->size_global());
+}
+} // namespace
+
+TEST_CASE("Read mesh with stored partition", "[io][xdmf]")
+{
+  test_read_partitioned_mesh(mesh::GhostMode::none);
+  test_read_partitioned_mesh(mesh::GhostMode::shared_facet);
+}
+
+TEST_CASE("Read mesh with stored partition on fewer processes", "[io][xdmf]")
+{
+  test_read_mesh_stored_partition_subcomm(mesh::GhostMode::none);
+  test_read_mesh_stored_partition_subcomm(mesh::GhostMode::shared_facet);
+}
+
+TEST_CASE("Read compressed mesh", "[io][xdmf]") { test_compressed_mesh(); }
+
+TEST_CASE("Write unchanged mesh once", "[io][xdmf]") { test_write_mesh_once(); }
+
+TEST_CASE("Read mesh in chunks", "[io][xdmf]")
+{
+  test_read_mesh_chunked(mesh::GhostMode::none);
+  test_read_mesh_chunked(mesh::GhostMode::shared_facet);
+}
+
+TEST_CASE("Write and read mesh asynchronously", "[io][xdmf]")
+{
+  test_async_mesh();
+}
@@ -0,0 +1,186 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the native Krylov solvers
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/la/preconditioners.h>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Create a local tridiagonal matrix with diagonal d, sub-diagonal l
+/// and super-diagonal u
+la::MatrixCSR<double> create_tridiagonal(int n, double d, double l, double u)
+{
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_SELF, n);
+  la::SparsityPattern sp(MPI_COMM_SELF, {map, map}, {1, 1});
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    for (std::int32_t j = std::max(0, i - 1); j < std::min(n, i + 2); ++j)
+    {
+      std::array<std::int32_t, 1> r{i}, c{j};
+      sp.insert(r, c);
+    }
+  }
+  sp.finalize();
+
+  la::MatrixCSR<double> A(sp);
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    std::array<std::int32_t, 1> r{i};
+    std::array<std::int32_t, 3> c{i - 1, i, i + 1};
+    std::array<double, 3> v{l, d, u};
+    for (int k = 0; k < 3; ++k)
+    {
+      if (c[k] >= 0 and c[k] < n)
+        A.set<1, 1>(std::span(v).subspan(k, 1), r, std::span(c).subspan(k, 1));
+    }
+  }
+
+  return A;
+}
+
+/// Set b = A x for x_i = sin(i) and return x
+la::Vector<double> create_problem(la::MatrixCSR<double>& A,
+                                  la::Vector<double>& b)
+{
+  la::Vector<double> x(A.index_map(0), 1);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    x.mutable_array()[i] = std::sin(double(i + 1));
+  b.set(0);
+  A.mult(x, b);
+  return x;
+}
+
+void check_solution(const la::Vector<double>& x, const la::Vector<double>& u)
+{
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    CHECK(x.array()[i] == Catch::Approx(u.array()[i]).margin(1e-6));
+}
+
+void test_cg()
+{
+  la::MatrixCSR<double> A = create_tridiagonal(40, 2.0, -1.0, -1.0);
+  la::Vector<double> b(A.index_map(0), 1);
+  la::Vector<double> u = create_problem(A, b);
+
+  {
+    la::Vector<double> x(A.index_map(0), 1);
+    x.set(0);
+    auto info = la::cg(A, b, x, la::IdentityPreconditioner(), 1e-10);
+    CHECK(info.converged);
+    CHECK(info.iterations <= 40);
+    check_solution(x, u);
+  }
+
+  {
+    la::Vector<double> x(A.index_map(0), 1);
+    x.set(0);
+    auto info = la::pipelined_cg(A, b, x, la::JacobiPreconditioner(A), 1e-10);
+    CHECK(info.converged);
+    check_solution(x, u);
+  }
+
+  {
+    // Matrix-free operator and exact (ILU(0)) preconditioner
+    auto action = [&A](la::Vector<double>& x, la::Vector<double>& y)
+    {
+      y.set(0);
+      A.mult(x, y);
+    };
+    la::Vector<double> x(A.index_map(0), 1);
+    x.set(0);
+    auto info = la::cg(action, b, x, la::ILU0Preconditioner(A), 1e-10);
+    CHECK(info.converged);
+    CHECK(info.iterations <= 2);
+    check_solution(x, u);
+  }
+}
+
+void test_gmres()
+{
+  // Non-symmetric matrix
+  la::MatrixCSR<double> A = create_tridiagonal(40, 3.0, -1.0, -0.5);
+  la::Vector<double> b(A.index_map(0), 1);
+  la::Vector<double> u = create_problem(A, b);
+
+  for (int restart : {5, 50})
+  {
+    la::Vector<double> x(A.index_map(0), 1);
+    x.set(0);
+    auto info = la::gmres(A, b, x, la::BlockJacobiPreconditioner(A), restart,
+                          1e-10);
+    CHECK(info.converged);
+    check_solution(x, u);
+  }
+
+  la::Vector<double> x(A.index_map(0), 1);
+  x.set(0);
+  auto info = la::gmres(A, b, x, la::ILU0Preconditioner(A), 30, 1e-10);
+  CHECK(info.converged);
+  CHECK(info.iterations <= 2);
+  check_solution(x, u);
+}
+
+void test_chebyshev()
+{
+  // The eigenvalues of D^{-1} A are in (0, 2)
+  constexpr int n = 40;
+  la::MatrixCSR<double> A = create_tridiagonal(n, 2.0, -1.0, -1.0);
+  la::Vector<double> b(A.index_map(0), 1);
+  la::Vector<double> u = create_problem(A, b);
+  std::vector<double> diag(n, 2.0);
+  std::vector<double> dinv(n, 0.5);
+
+  double lambda_max
+      = la::estimate_max_eigenvalue(A, std::span<const double>(dinv), b, 10);
+  CHECK(lambda_max <= 2.0 + 1e-8);
+  CHECK(lambda_max > 1.9);
+
+  la::ChebyshevSmoother<la::MatrixCSR<double>, la::Vector<double>> S(
+      A, diag, b, 4);
+  CHECK(S.range()[1] == Catch::Approx(1.1 * lambda_max));
+
+  // Smoothing reduces the residual
+  la::Vector<double> x(A.index_map(0), 1), r(b);
+  x.set(0);
+  double rnorm0 = la::norm(b);
+  for (int k = 0; k < 5; ++k)
+    S.smooth(b, x);
+  r.set(0);
+  A.mult(x, r);
+  for (std::size_t i = 0; i < n; ++i)
+    r.mutable_array()[i] = b.array()[i] - r.array()[i];
+  CHECK(la::norm(r) < 0.5 * rnorm0);
+
+  // Smoother as a preconditioner
+  x.set(0);
+  auto info0 = la::cg(A, b, x, la::IdentityPreconditioner(), 1e-10);
+  x.set(0);
+  auto info = la::cg(A, b, x, S, 1e-10);
+  CHECK(info.converged);
+  CHECK(info.iterations < info0.iterations);
+  check_solution(x, u);
+}
+} // namespace
+
+TEST_CASE("Conjugate gradient", "[krylov]") { test_cg(); }
+
+TEST_CASE("GMRES", "[krylov]") { test_gmres(); }
+
+TEST_CASE("Chebyshev smoother", "[krylov]") { test_chebyshev(); }
@@ -0,0 +1,138 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the native LOBPCG eigensolver
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/MultiVector.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/lobpcg.h>
+#include <memory>
+#include <mpi.h>
+#include <numbers>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Create the distributed matrix of the 1D Laplacian, tridiag(-1, 2,
+/// -1), with n rows on each rank
+la::MatrixCSR<double> create_laplacian(int n)
+{
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const std::int64_t N = std::int64_t(n) * mpi_size;
+  const std::int64_t offset = std::int64_t(n) * mpi_rank;
+
+  // Ghost the neighbouring rows on the adjacent ranks
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_rank > 0)
+  {
+    ghosts.push_back(offset - 1);
+    owners.push_back(mpi_rank - 1);
+  }
+  if (mpi_rank < mpi_size - 1)
+  {
+    ghosts.push_back(offset + n);
+    owners.push_back(mpi_rank + 1);
+  }
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, n, ghosts,
+                                                owners);
+
+  // Local column index of a global index
+  auto local = [&](std::int64_t j) -> std::int32_t
+  {
+    if (j >= offset and j < offset + n)
+      return j - offset;
+    else
+      return j < offset ? n : n + (mpi_rank > 0);
+  };
+
+  la::SparsityPattern sp(MPI_COMM_WORLD, {map, map}, {1, 1});
+  for (std::int64_t i = offset; i < offset + n; ++i)
+  {
+    for (std::int64_t j = std::max<std::int64_t>(0, i - 1);
+         j < std::min(N, i + 2); ++j)
+    {
+      std::array<std::int32_t, 1> r{local(i)}, c{local(j)};
+      sp.insert(r, c);
+    }
+  }
+  sp.finalize();
+
+  la::MatrixCSR<double> A(sp);
+  for (std::int64_t i = offset; i < offset + n; ++i)
+  {
+    for (std::int64_t j = std::max<std::int64_t>(0, i - 1);
+         j < std::min(N, i + 2); ++j)
+    {
+      std::array<std::int32_t, 1> r{local(i)}, c{local(j)};
+      std::array<double, 1> v{i == j ? 2.0 : -1.0};
+      A.set<1, 1>(v, r, c);
+    }
+  }
+
+  return A;
+}
+
+void test_lobpcg()
+{
+  constexpr int n = 25;
+  constexpr int k = 3;
+  la::MatrixCSR<double> A = create_laplacian(n);
+  const std::int64_t N = A.index_map(0)->size_global();
+
+  // Initial guess with linearly independent vectors
+  auto init = [&](la::MultiVector<double>& X)
+  {
+    const std::int64_t offset = A.index_map(0)->local_range()[0];
+    auto x = X.mutable_array();
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < k; ++j)
+        x[i * k + j] = std::cos((j + 1) * 0.37 * (offset + i)) + 0.1 * j;
+  };
+
+  // Jacobi preconditioner on multi-vectors
+  auto jacobi = [](const la::MultiVector<double>& r,
+                   la::MultiVector<double>& w)
+  {
+    const std::size_t size = r.num_vectors() * r.index_map()->size_local();
+    for (std::size_t i = 0; i < size; ++i)
+      w.mutable_array()[i] = 0.5 * r.array()[i];
+  };
+
+  for (bool precondition : {false, true})
+  {
+    la::MultiVector<double> X(A.index_map(1), 1, k);
+    init(X);
+    auto info = precondition ? la::lobpcg(A, X, jacobi, 1e-8)
+                             : la::lobpcg(A, X, la::IdentityPreconditioner(),
+                                          1e-8);
+    CHECK(info.converged);
+    REQUIRE(info.eigenvalues.size() == std::size_t(k));
+    for (int j = 0; j < k; ++j)
+    {
+      const double lambda
+          = 2 - 2 * std::cos((j + 1) * std::numbers::pi / (N + 1));
+      CHECK(info.eigenvalues[j] == Catch::Approx(lambda).epsilon(1e-8));
+    }
+
+    // The eigenvectors are orthonormal
+    std::vector<double> G = la::inner_product_block(X, X);
+    for (int i = 0; i < k; ++i)
+      for (int j = 0; j < k; ++j)
+        CHECK(G[i * k + j] == Catch::Approx(i == j).margin(1e-8));
+  }
+}
+} // namespace
+
+TEST_CASE("LOBPCG", "[lobpcg]") { test_lobpcg(); }
@@ -11,12 +11,18 @@
 #include <basix/mdspan.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <dolfinx.h>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/BlockMatrixCSR.h>
 #include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/MatrixSELL.h>
+#include <dolfinx/la/MultiVector.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/Vector.h>
+#include <dolfinx/la/matrix_product.h>
 #include <mpi.h>
+#include <numeric>
 #include <span>
 
 using namespace dolfinx;
@@ -107,8 +113,9 @@ void spmv(la::MatrixCSR<T>& A, la::Vector<T>& x, la::Vector<T>& y)
 
 /// @brief Create a matrix operator
 /// @param comm The communicator to builf the matrix on
+/// @param num_threads Number of threads to assemble with
 /// @return The assembled matrix
-la::MatrixCSR<double> create_operator(MPI_Comm comm)
+la::MatrixCSR<double> create_operator(MPI_Comm comm, int num_threads = 1)
 {
   auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
   auto mesh = std::make_shared<mesh::Mesh<double>>(
@@ -132,7 +139,7 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
   la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
   sp.finalize();
   la::MatrixCSR<double> A(sp);
-  fem::assemble_matrix(A.mat_add_values(), *a, {});
+  fem::assemble_matrix(A.mat_add_values(), *a, {}, num_threads);
   A.scatter_rev();
 
   return A;
@@ -145,6 +152,293 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
   CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()).epsilon(1e-8));
 }
 
+[[maybe_unused]] void test_matrix_threaded_assembly()
+{
+  la::MatrixCSR A0 = create_operator(MPI_COMM_WORLD);
+  la::MatrixCSR A1 = create_operator(MPI_COMM_WORLD, 4);
+  REQUIRE(A0.values().size() == A1.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+}
+
+[[maybe_unused]] void test_matrix_assembly_plan()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {8, 8, 8},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp);
+  la::MatrixCSR<double> A1(sp);
+  fem::MatrixAssemblyPlan<double> plan
+      = fem::create_matrix_assembly_plan(a, A1, {});
+  CHECK(std::ranges::all_of(A1.values(), [](auto v) { return v == 0.0; }));
+
+  // Re-assemble with the plan after changing a constant
+  for (double k : {2.0, 3.0})
+  {
+    kappa->value = {k};
+    A0.set(0.0);
+    fem::assemble_matrix(A0.mat_add_values(), *a, {});
+    A1.set(0.0);
+    plan.assemble(A1.values());
+    REQUIRE(A0.values().size() == A1.values().size());
+    for (std::size_t i = 0; i < A0.values().size(); ++i)
+      CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+  }
+}
+
+[[maybe_unused]] void test_matrix_mixed_precision()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {8, 8, 8},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  // Assemble double precision element tensors into double and single
+  // precision matrices
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+  la::MatrixCSR<double> A0(sp);
+  la::MatrixCSR<float> A1(sp);
+  fem::assemble_matrix(A0.mat_add_values(), *a, {});
+  fem::assemble_matrix(A1.mat_add_values<1, 1, double>(), *a, {});
+  A0.scatter_rev();
+  A1.scatter_rev();
+  CHECK(A1.squared_norm() == Catch::Approx(A0.squared_norm()).epsilon(1e-6));
+
+  // The contributions are summed in double precision, so without ghost
+  // rows each entry is the rounded double precision entry
+  if (dolfinx::MPI::size(comm) == 1)
+  {
+    for (std::size_t i = 0; i < A0.values().size(); ++i)
+      CHECK(A1.values()[i] == static_cast<float>(A0.values()[i]));
+  }
+
+  // Apply single precision matrix to double precision vectors
+  la::Vector<double> x(A0.index_map(1), 1);
+  std::iota(x.mutable_array().begin(), x.mutable_array().end(), 0);
+  for (auto& xi : x.mutable_array())
+    xi = std::sin(xi);
+  la::Vector<double> y0(A0.index_map(0), 1);
+  la::Vector<double> y1(A0.index_map(0), 1);
+  y0.set(0.0);
+  y1.set(0.0);
+  A0.mult(x, y0);
+  A1.mult(x, y1);
+  const std::int32_t num_owned = A0.num_owned_rows();
+  for (std::int32_t i = 0; i < num_owned; ++i)
+    CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-5));
+}
+
+[[maybe_unused]] void test_matrix_sell()
+{
+  la::MatrixCSR<double> A = create_operator(MPI_COMM_WORLD);
+  la::Vector<double> x(A.index_map(1), 1);
+  std::iota(x.mutable_array().begin(), x.mutable_array().end(), 0);
+  for (auto& xi : x.mutable_array())
+    xi = std::sin(xi);
+  la::Vector<double> y0(A.index_map(0), 1);
+  y0.set(0.0);
+  A.mult(x, y0);
+
+  auto check = [&](const auto& S, double tol)
+  {
+    la::Vector<double> y1(A.index_map(0), 1);
+    y1.set(0.0);
+    S.mult(x, y1);
+    for (std::int32_t i = 0; i < A.num_owned_rows(); ++i)
+      CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(tol));
+  };
+  check(la::MatrixSELL<double>(A), 1e-12);
+  check(la::MatrixSELL<double, 4>(A, 1), 1e-12);
+  check(la::MatrixSELL<float, 8, std::uint16_t>(A, 32), 1e-5);
+}
+
+/// Create a banded matrix with n entries per rank that has the
+/// entries f(i, j) for the global columns j in [i - w0, i + w1] of each
+/// global row i
+template <typename F>
+la::MatrixCSR<double> create_band_matrix(MPI_Comm comm, std::int32_t n,
+                                         std::int64_t w0, std::int64_t w1,
+                                         F f)
+{
+  const int rank = dolfinx::MPI::rank(comm);
+  const std::int64_t N = n * dolfinx::MPI::size(comm);
+  const std::int64_t offset = rank * n;
+  auto band = [&](std::int64_t i)
+  {
+    return std::array{std::max<std::int64_t>(0, i - w0),
+                      std::min(N - 1, i + w1)};
+  };
+
+  std::vector<std::int64_t> ghosts;
+  for (std::int64_t i = offset; i < offset + n; ++i)
+  {
+    auto [j0, j1] = band(i);
+    for (std::int64_t j = j0; j <= j1; ++j)
+      if (j < offset or j >= offset + n)
+        ghosts.push_back(j);
+  }
+  std::ranges::sort(ghosts);
+  auto [last, end] = std::ranges::unique(ghosts);
+  ghosts.erase(last, end);
+  std::vector<int> owners;
+  for (std::int64_t g : ghosts)
+    owners.push_back(g / n);
+
+  auto map0 = std::make_shared<common::IndexMap>(comm, n);
+  auto map1 = std::make_shared<common::IndexMap>(comm, n, ghosts, owners);
+  std::vector<std::int32_t> cols;
+  std::vector<std::int64_t> row_ptr(1, 0);
+  std::vector<double> values;
+  for (std::int64_t i = offset; i < offset + n; ++i)
+  {
+    auto [j0, j1] = band(i);
+    std::vector<std::int64_t> global(j1 - j0 + 1);
+    std::iota(global.begin(), global.end(), j0);
+    std::vector<std::int32_t> local(global.size());
+    map1->global_to_local(global, local);
+    std::vector<std::pair<std::int32_t, double>> row;
+    for (std::size_t k = 0; k < global.size(); ++k)
+      row.emplace_back(local[k], f(i, global[k]));
+    std::ranges::sort(row);
+    for (auto [c, v] : row)
+    {
+      cols.push_back(c);
+      values.push_back(v);
+    }
+    row_ptr.push_back(cols.size());
+  }
+
+  return la::MatrixCSR<double>({map0, map1}, {1, 1}, std::move(cols),
+                               std::move(row_ptr), std::move(values));
+}
+
+/// Check the owned rows of a matrix against a function of the global
+/// row and column index
+template <typename F>
+void check_dense(const la::MatrixCSR<double>& A, F f)
+{
+  const std::vector<double> dense = A.to_dense();
+  const std::int64_t ncols = A.index_map(1)->size_global();
+  const std::int64_t offset = A.index_map(0)->local_range()[0];
+  for (std::int32_t i = 0; i < A.num_owned_rows(); ++i)
+  {
+    for (std::int64_t j = 0; j < ncols; ++j)
+    {
+      CHECK(dense[i * ncols + j]
+            == Catch::Approx(f(offset + i, j)).margin(1e-10));
+    }
+  }
+}
+
+[[maybe_unused]] void test_matrix_product()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  constexpr std::int32_t n = 5;
+  const std::int64_t N = n * dolfinx::MPI::size(comm);
+  auto in_band = [](std::int64_t i, std::int64_t j, std::int64_t w0,
+                    std::int64_t w1) { return j >= i - w0 and j <= i + w1; };
+
+  // A couples each row to rows on the neighbouring ranks
+  auto fa = [&](std::int64_t i, std::int64_t j)
+  { return in_band(i, j, 1, n + 2) ? 1.0 + i + 0.5 * j : 0.0; };
+  auto fb = [&](std::int64_t i, std::int64_t j)
+  { return in_band(i, j, 3, 1) ? 0.25 + i - j : 0.0; };
+  la::MatrixCSR<double> A = create_band_matrix(comm, n, 1, n + 2, fa);
+  la::MatrixCSR<double> B = create_band_matrix(comm, n, 3, 1, fb);
+
+  auto product = [N](auto f, auto g)
+  {
+    return [N, f, g](std::int64_t i, std::int64_t j)
+    {
+      double c = 0;
+      for (std::int64_t k = 0; k < N; ++k)
+        c += f(i, k) * g(k, j);
+      return c;
+    };
+  };
+
+  // Repeated product on the same sparsity pattern
+  la::MatrixProduct<double> C(A, B);
+  C.compute(A, B);
+  CHECK(C.matrix().index_map(1)->size_global() == N);
+  check_dense(C.matrix(), product(fa, fb));
+  std::ranges::for_each(A.values(), [](auto& a) { a *= 2; });
+  C.compute(A, B);
+  check_dense(C.matrix(), product([&](auto i, auto j) { return 2 * fa(i, j); },
+                                  fb));
+
+  // Transpose, and product of the transpose with the matrix
+  la::MatrixCSR<double> Bt = la::transpose(B);
+  auto fbt = [&](std::int64_t i, std::int64_t j) { return fb(j, i); };
+  check_dense(Bt, fbt);
+  check_dense(la::matrix_product(Bt, B), product(fbt, fb));
+}
+
+[[maybe_unused]] void test_matrix_multivector()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto f = [](auto i, auto j) { return 1.0 + std::sin(i + 2.0 * j); };
+  la::MatrixCSR<double> A = create_band_matrix(comm, 7, 2, 9, f);
+
+  // Fill each vector of a multi-vector with different values
+  constexpr int nv = 3;
+  la::MultiVector<double> X(A.index_map(1), 1, nv), Y(A.index_map(0), 1, nv);
+  std::span<double> x = X.mutable_array();
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = std::cos(0.1 * i + A.index_map(1)->local_range()[0]);
+  Y.set(0.0);
+  A.mult(X, Y);
+
+  // Compare with the product of each vector
+  std::vector<double> dots = la::inner_product_block(Y, Y);
+  REQUIRE(dots.size() == nv * nv);
+  la::Vector<double> xv(A.index_map(1), 1), yv(A.index_map(0), 1),
+      zv(A.index_map(0), 1);
+  for (int v = 0; v < nv; ++v)
+  {
+    X.copy_to(v, xv);
+    yv.set(0.0);
+    A.mult(xv, yv);
+    Y.copy_to(v, zv);
+    for (std::int32_t i = 0; i < A.num_owned_rows(); ++i)
+      CHECK(zv.array()[i] == Catch::Approx(yv.array()[i]).margin(1e-12));
+
+    Y.copy_to(0, zv);
+    CHECK(dots[v * nv] == Catch::Approx(la::inner_product(yv, zv)));
+  }
+}
+
 [[maybe_unused]] void test_matrix_apply()
 {
   MPI_Comm comm = MPI_COMM_WORLD;
@@ -199,6 +493,21 @@ la::MatrixCSR<double> create_operator(MPI_Comm comm)
 
   std::ranges::for_each(y.array(),
                         [](auto a) { REQUIRE(std::abs(a) < 1e-13); });
+
+  // Compare the native product with the reference implementation
+  // for a non-constant vector
+  std::iota(x.mutable_array().begin(), x.mutable_array().end(), 0);
+  for (auto& xi : x.mutable_array())
+    xi = std::sin(xi);
+  la::Vector<double> y0(A.index_map(0), 1);
+  la::Vector<double> y1(A.index_map(0), 1);
+  y0.set(0.0);
+  y1.set(0.0);
+  spmv(A, x, y0);
+  A.mult(x, y1);
+  const std::int32_t num_owned = A.num_owned_rows();
+  for (std::int32_t i = 0; i < num_owned; ++i)
+    CHECK(y1.array()[i] == Catch::Approx(y0.array()[i]).margin(1e-12));
 }
 
 void test_matrix()
@@ -251,11 +560,369 @@ void test_matrix()
   CHECK(Adense(4, to_global_col(4)) != Aref(4, to_global_col(4)));
 }
 
+/// Check that a two-pass (count and fill) build gives the same sparsity
+/// pattern as a build that caches the entries of each row
+void test_sparsity_two_pass()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Each rank ghosts the first two indices owned by the next rank
+  const std::int32_t n = 10;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (size > 1)
+  {
+    const int next = (rank + 1) % size;
+    ghosts = {n * next, n * next + 1};
+    owners = {next, next};
+  }
+  auto map = std::make_shared<common::IndexMap>(comm, n, ghosts, owners);
+
+  // Insert 'element' blocks, including ghost rows and columns
+  auto insert = [n, num_ghosts = ghosts.size()](la::SparsityPattern& p)
+  {
+    const std::int32_t num_rows = n + num_ghosts;
+    for (std::int32_t i = 0; i < num_rows; ++i)
+    {
+      std::array<std::int32_t, 3> dofs
+          = {i, (i + 1) % num_rows, (i + 5) % num_rows};
+      p.insert(dofs, dofs);
+    }
+    p.insert(3, 2);
+    std::array<std::int32_t, 2> diag = {0, 7};
+    p.insert_diagonal(diag);
+  };
+
+  la::SparsityPattern p0(comm, {map, map}, {1, 1});
+  insert(p0);
+  const std::int32_t last_row = n + ghosts.size() - 1;
+  p0.insert(4, 8);
+  p0.insert(last_row, 2);
+  p0.finalize();
+
+  // Entries that have not been counted must also be inserted
+  la::SparsityPattern p1(comm, {map, map}, {1, 1});
+  p1.begin_count();
+  insert(p1);
+  p1.allocate();
+  insert(p1);
+  p1.insert(4, 8);
+  p1.insert(last_row, 2);
+  p1.finalize(3);
+
+  auto [edges0, offsets0] = p0.graph();
+  auto [edges1, offsets1] = p1.graph();
+  CHECK(std::ranges::equal(edges0, edges1));
+  CHECK(std::ranges::equal(offsets0, offsets1));
+  CHECK(std::ranges::equal(p0.off_diagonal_offsets(),
+                           p1.off_diagonal_offsets()));
+  CHECK(p0.column_indices() == p1.column_indices());
+}
+
+/// Check that threaded and block sparsity pattern builds give the same
+/// pattern as the serial build
+void test_sparsity_threaded()
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {5, 4, 3},
+      mesh::CellType::tetrahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::shared_facet)));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  fem::Form<double, double> a = fem::create_form<double, double>(
+      *form_poisson_a, {V, V}, {}, {{"kappa", kappa}}, {}, {});
+
+  auto check_equal = [](la::SparsityPattern& p0, la::SparsityPattern& p1)
+  {
+    p0.finalize();
+    p1.finalize(2);
+    auto [edges0, offsets0] = p0.graph();
+    auto [edges1, offsets1] = p1.graph();
+    CHECK(std::ranges::equal(edges0, edges1));
+    CHECK(std::ranges::equal(offsets0, offsets1));
+  };
+
+  la::SparsityPattern p0 = fem::create_sparsity_pattern(a);
+  la::SparsityPattern p1 = fem::create_sparsity_pattern(a, 3);
+  check_equal(p0, p1);
+
+  std::vector<std::vector<std::unique_ptr<la::SparsityPattern>>> patterns
+      = fem::create_sparsity_patterns<double, double>(
+          {{&a, nullptr}, {&a, &a}}, 3);
+  CHECK(!patterns[0][1]);
+  for (auto [i, j] :
+       {std::pair<int, int>(0, 0), std::pair<int, int>(1, 0),
+        std::pair<int, int>(1, 1)})
+  {
+    REQUIRE(patterns[i][j]);
+    la::SparsityPattern p = fem::create_sparsity_pattern(a);
+    check_equal(p, *patterns[i][j]);
+  }
+
+  // The monolithic pattern of a block system is the same as the stacked
+  // patterns of the blocks
+  std::vector<std::vector<const fem::Form<double, double>*>> a_block
+      = {{&a, nullptr}, {&a, &a}};
+  patterns = fem::create_sparsity_patterns(a_block);
+  std::array<std::vector<std::pair<
+                 std::reference_wrapper<const common::IndexMap>, int>>,
+             2>
+      maps;
+  for (std::size_t d = 0; d < 2; ++d)
+    maps[d] = {{*V->dofmap()->index_map, 1}, {*V->dofmap()->index_map, 1}};
+  la::SparsityPattern p0(MPI_COMM_WORLD,
+                         {{patterns[0][0].get(), nullptr},
+                          {patterns[1][0].get(), patterns[1][1].get()}},
+                         maps, {std::vector{1, 1}, std::vector{1, 1}});
+  p0.finalize();
+  for (int num_threads : {1, 3})
+  {
+    la::SparsityPattern p1
+        = fem::create_sparsity_pattern_block(a_block, num_threads);
+    REQUIRE(p1.block_indices(0).size() == 2);
+    CHECK(p1.block_indices(1)[1].size()
+          == V->dofmap()->index_map->size_local()
+                 + V->dofmap()->index_map->num_ghosts());
+    p1.finalize();
+    auto [edges0, offsets0] = p0.graph();
+    auto [edges1, offsets1] = p1.graph();
+    CHECK(std::ranges::equal(edges0, edges1));
+    CHECK(std::ranges::equal(offsets0, offsets1));
+    CHECK(p0.column_indices() == p1.column_indices());
+  }
+}
 } // namespace
 
+[[maybe_unused]] void test_matrix_insert_unsorted()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto zero = [](auto, auto) { return 0.0; };
+
+  // Value of an entry of a matrix
+  auto entry = [](const la::MatrixCSR<double>& A, std::int32_t row,
+                  std::int32_t col)
+  {
+    for (std::int64_t k = A.row_ptr()[row]; k < A.row_ptr()[row + 1]; ++k)
+      if (A.cols()[k] == col)
+        return A.values()[k];
+    return -1.0;
+  };
+
+  // Short rows and unsorted columns with a repeated column
+  {
+    la::MatrixCSR<double> A = create_band_matrix(comm, 7, 3, 3, zero);
+    std::vector<std::int32_t> rows = {2, 4};
+    std::vector<std::int32_t> cols = {5, 1, 3, 1, 4};
+    std::vector<double> x(rows.size() * cols.size());
+    std::iota(x.begin(), x.end(), 1.0);
+    A.add<1, 1>(x, rows, cols);
+    for (std::size_t r = 0; r < rows.size(); ++r)
+    {
+      CHECK(entry(A, rows[r], 5) == x[r * 5 + 0]);
+      CHECK(entry(A, rows[r], 1) == x[r * 5 + 1] + x[r * 5 + 3]);
+      CHECK(entry(A, rows[r], 3) == x[r * 5 + 2]);
+      CHECK(entry(A, rows[r], 4) == x[r * 5 + 4]);
+      CHECK(entry(A, rows[r], 2) == 0.0);
+    }
+  }
+
+  // Long rows and more columns than are sorted on the stack
+  {
+    la::MatrixCSR<double> A = create_band_matrix(comm, 80, 40, 40, zero);
+    std::vector<std::int32_t> rows = {40};
+    std::vector<std::int32_t> cols(80);
+    std::iota(cols.rbegin(), cols.rend(), 0);
+    std::vector<double> x(cols.size());
+    std::iota(x.begin(), x.end(), 1.0);
+    A.add<1, 1>(x, rows, cols);
+    for (std::size_t c = 0; c < cols.size(); ++c)
+      CHECK(entry(A, 40, cols[c]) == x[c]);
+  }
+}
+
+[[maybe_unused]] void test_matrix_memory_usage()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto f = [](auto i, auto j) { return 1.0 + i + j; };
+  la::MatrixCSR<double> A = create_band_matrix(comm, 7, 2, 3, f);
+  la::Vector<double> x(A.index_map(1), 2);
+
+  // Members use at least the memory of their data
+  std::map<std::string, std::size_t> usage_A = A.memory_usage();
+  CHECK(usage_A.at("values") >= A.values().size() * sizeof(double));
+  CHECK(usage_A.at("columns") >= A.cols().size() * sizeof(std::int32_t));
+  std::map<std::string, std::size_t> usage_x = x.memory_usage();
+  CHECK(usage_x.at("array") >= x.array().size() * sizeof(double));
+  CHECK(A.index_map(1)->memory_usage().at("ghosts")
+        >= A.index_map(1)->ghosts().size() * sizeof(std::int64_t));
+
+  // Total memory of the matrix over all processes
+  std::size_t bytes = 0;
+  for (auto [member, b] : usage_A)
+    bytes += b;
+  double total = static_cast<double>(bytes) / (1024.0 * 1024.0);
+  MPI_Allreduce(MPI_IN_PLACE, &total, 1, MPI_DOUBLE, MPI_SUM, comm);
+
+  Table t = common::memory_table(comm, {{"A", usage_A}, {"x", usage_x}});
+  if (dolfinx::MPI::rank(comm) == 0)
+  {
+    auto get = [&t](std::string row, std::string col)
+    { return std::get<double>(t.get(row, col)); };
+    CHECK(get("A", "sum") == Catch::Approx(total));
+    CHECK(get("A", "min") <= get("A", "avg"));
+    CHECK(get("A", "avg") <= get("A", "max"));
+    CHECK(get("x: array", "max") > 0.0);
+  }
+}
+
+[[maybe_unused]] void test_matrix_dirichlet_elimination()
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::none);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box(comm, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {6, 6, 6},
+                       mesh::CellType::tetrahedron, part));
+  auto element = basix::create_element<double>(
+      basix::element::family::P, basix::cell::type::tetrahedron, 2,
+      basix::element::lagrange_variant::unset,
+      basix::element::dpc_variant::unset, false);
+  auto V = std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+
+  auto kappa = std::make_shared<fem::Constant<double>>(2.0);
+  auto a = std::make_shared<fem::Form<double, double>>(
+      fem::create_form<double, double>(*form_poisson_a, {V, V}, {},
+                                       {{"kappa", kappa}}, {}, {}));
+
+  // Boundary condition on the facets at x = 0
+  std::vector facets = mesh::locate_entities_boundary(
+      *mesh, 2,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marker(x.extent(1), false);
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+          marker[p] = std::abs(x(0, p)) < 1.0e-8;
+        return marker;
+      });
+  std::vector bdofs = fem::locate_dofs_topological(
+      *V->mesh()->topology_mutable(), *V->dofmap(), 2, facets);
+  fem::DirichletBC<double> bc(0.0, bdofs, V);
+  const std::vector<std::reference_wrapper<const fem::DirichletBC<double>>>
+      bcs = {bc};
+
+  la::SparsityPattern sp = fem::create_sparsity_pattern(*a);
+  sp.finalize();
+
+  // Reference: assembled with the boundary condition
+  la::MatrixCSR<double> A0(sp);
+  fem::assemble_matrix(A0.mat_add_values(), *a, bcs);
+  A0.scatter_rev();
+  fem::set_diagonal<double>(A0.mat_set_values(), *V, bcs, 1.0);
+
+  // Boundary condition applied to the assembled matrix
+  la::MatrixCSR<double> A1(sp);
+  fem::assemble_matrix(A1.mat_add_values(), *a, {});
+  A1.scatter_rev();
+  la::Vector<double> g(V->dofmap()->index_map, 1), y(g.index_map(), 1);
+  g.set(0.0);
+  for (std::int32_t dof : bdofs)
+    g.mutable_array()[dof] = 1.0;
+  y.set(0.0);
+  A1.mult(g, y);
+
+  A1.zero_rows(bdofs);
+  la::EliminatedEntries<double> removed = A1.zero_columns(bdofs);
+  A1.set_diagonal(bdofs, 1.0);
+  REQUIRE(A0.values().size() == A1.values().size());
+  for (std::size_t i = 0; i < A0.values().size(); ++i)
+    CHECK(A1.values()[i] == Catch::Approx(A0.values()[i]).margin(1e-12));
+
+  // Lifting with the removed entries: b = -A g on the other rows
+  const std::int32_t n = g.index_map()->size_local();
+  la::Vector<double> b(g.index_map(), 1);
+  b.set(0.0);
+  removed.lift(b.mutable_array(), g.array());
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    if (!std::ranges::binary_search(bdofs, i))
+      CHECK(b.array()[i] == Catch::Approx(-y.array()[i]).margin(1e-12));
+  }
+}
+
+[[maybe_unused]] void test_matrix_block()
+{
+  auto A = std::make_shared<la::MatrixCSR<double>>(
+      create_operator(MPI_COMM_WORLD));
+
+  // Upper triangular 2x2 block matrix
+  la::BlockMatrixCSR<la::MatrixCSR<double>> B({{A, A}, {nullptr, A}});
+  la::BlockVector<la::Vector<double>> x(B.index_maps(1));
+  la::BlockVector<la::Vector<double>> y(B.index_maps(0));
+  x.set(0.0);
+  for (std::size_t k = 0; k < 2; ++k)
+  {
+    std::span<double> xk = x.block(k).mutable_array();
+    const std::int32_t n = A->index_map(1)->size_local();
+    for (std::int32_t i = 0; i < n; ++i)
+      xk[i] = std::sin(static_cast<double>(i + 3 * k));
+  }
+  y.set(0.0);
+  B.mult(x, y);
+
+  // Reference: y0 = A x0 + A x1, y1 = A x1
+  la::Vector<double> y0(A->index_map(0), 1), y1(A->index_map(0), 1);
+  y0.set(0.0);
+  y1.set(0.0);
+  A->mult(x.block(0), y0);
+  A->mult(x.block(1), y0);
+  A->mult(x.block(1), y1);
+  const std::int32_t n = A->index_map(0)->size_local();
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    CHECK(y.block(0).array()[i] == Catch::Approx(y0.array()[i]));
+    CHECK(y.block(1).array()[i] == Catch::Approx(y1.array()[i]));
+  }
+
+  // Copy to and from the stacked layout
+  la::Vector<double> s(x.index_map(), 1);
+  x.copy_to(s);
+  CHECK(la::inner_product(s, s) == Catch::Approx(la::inner_product(x, x)));
+  la::BlockVector<la::Vector<double>> z(B.index_maps(1));
+  z.copy_from(s);
+  for (std::size_t k = 0; k < 2; ++k)
+    CHECK(std::ranges::equal(z.block(k).array(), x.block(k).array()));
+  CHECK(la::norm(z, la::Norm::linf)
+        == Catch::Approx(la::norm(s, la::Norm::linf)));
+}
+
+TEST_CASE("Sparsity pattern two-pass build", "[la_sparsity]")
+{
+  CHECK_NOTHROW(test_sparsity_two_pass());
+  CHECK_NOTHROW(test_sparsity_threaded());
+}
+
 TEST_CASE("Linear Algebra CSR Matrix", "[la_matrix]")
 {
   CHECK_NOTHROW(test_matrix());
   CHECK_NOTHROW(test_matrix_apply());
   CHECK_NOTHROW(test_matrix_norm());
+  CHECK_NOTHROW(test_matrix_threaded_assembly());
+  CHECK_NOTHROW(test_matrix_assembly_plan());
+  CHECK_NOTHROW(test_matrix_mixed_precision());
+  CHECK_NOTHROW(test_matrix_sell());
+  CHECK_NOTHROW(test_matrix_product());
+  CHECK_NOTHROW(test_matrix_multivector());
+  CHECK_NOTHROW(test_matrix_insert_unsorted());
+  CHECK_NOTHROW(test_matrix_memory_usage());
+  CHECK_NOTHROW(test_matrix_block());
+  CHECK_NOTHROW(test_matrix_dirichlet_elimination());
 }
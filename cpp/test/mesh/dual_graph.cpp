@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for incremental updates of the mesh dual graph
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <dolfinx/mesh/graphbuild.h>
+#include <mpi.h>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Quadrilateral cells of a structured nx x ny grid, with rows of
+/// cells distributed across ranks
+std::vector<std::int64_t> create_quadrilaterals(MPI_Comm comm, int nx, int ny)
+{
+  auto [j0, j1] = dolfinx::MPI::local_range(dolfinx::MPI::rank(comm), ny,
+                                            dolfinx::MPI::size(comm));
+  std::vector<std::int64_t> cells;
+  for (std::int64_t j = j0; j < j1; ++j)
+  {
+    for (std::int64_t i = 0; i < nx; ++i)
+    {
+      std::int64_t v0 = j * (nx + 1) + i;
+      cells.insert(cells.end(), {v0, v0 + 1, v0 + nx + 1, v0 + nx + 2});
+    }
+  }
+  return cells;
+}
+
+/// Check that two graphs are equal up to the order of the edges of
+/// each node
+void check_graphs(const graph::AdjacencyList<std::int64_t>& g0,
+                  const graph::AdjacencyList<std::int64_t>& g1)
+{
+  REQUIRE(g0.num_nodes() == g1.num_nodes());
+  for (std::int32_t c = 0; c < g0.num_nodes(); ++c)
+  {
+    std::vector<std::int64_t> e0(g0.links(c).begin(), g0.links(c).end());
+    std::vector<std::int64_t> e1(g1.links(c).begin(), g1.links(c).end());
+    std::ranges::sort(e0);
+    std::ranges::sort(e1);
+    CHECK(e0 == e1);
+  }
+}
+} // namespace
+
+TEST_CASE("Dual graph update", "[mesh][dual_graph]")
+{
+  MPI_Comm comm = MPI_COMM_WORLD;
+  std::vector<std::int64_t> quads = create_quadrilaterals(comm, 6, 8);
+  std::vector<mesh::CellType> types = {mesh::CellType::quadrilateral};
+
+  mesh::DualGraph graph(comm, types, {quads});
+  check_graphs(graph.global_graph(),
+               mesh::build_dual_graph(comm, types, {quads}));
+
+  SECTION("split cells")
+  {
+    // Split every third quadrilateral into two triangles, keeping the
+    // remaining quadrilaterals before the triangles
+    const std::int32_t num_quads = quads.size() / 4;
+    std::vector<std::int64_t> quads1, triangles;
+    std::vector<std::int32_t> cell_map(num_quads, -1);
+    for (std::int32_t c = 0; c < num_quads; ++c)
+    {
+      std::span<const std::int64_t, 4> v(quads.data() + 4 * c, 4);
+      if (c % 3 == 0)
+        triangles.insert(triangles.end(), {v[0], v[1], v[3], v[0], v[2], v[3]});
+      else
+      {
+        cell_map[c] = quads1.size() / 4;
+        quads1.insert(quads1.end(), v.begin(), v.end());
+      }
+    }
+
+    std::vector<mesh::CellType> types1
+        = {mesh::CellType::quadrilateral, mesh::CellType::triangle};
+    std::vector<std::int32_t> changed
+        = graph.update(types1, {quads1, triangles}, cell_map);
+    check_graphs(graph.global_graph(),
+                 mesh::build_dual_graph(comm, types1, {quads1, triangles}));
+
+    // All new cells have changed edges
+    const std::int32_t num_cells = graph.num_nodes();
+    for (std::int32_t c = quads1.size() / 4; c < num_cells; ++c)
+      CHECK(std::ranges::binary_search(changed, c));
+    CHECK(changed.size() <= std::size_t(num_cells));
+
+    // Merge the triangles back into quadrilaterals
+    std::vector<std::int32_t> cell_map1(num_cells, -1);
+    for (std::int32_t c = 0; c < num_quads; ++c)
+    {
+      if (cell_map[c] >= 0)
+        cell_map1[cell_map[c]] = c;
+    }
+    graph.update(types, {quads}, cell_map1);
+    check_graphs(graph.global_graph(),
+                 mesh::build_dual_graph(comm, types, {quads}));
+  }
+
+  SECTION("renumber cells")
+  {
+    // Reverse the order of the cells
+    const std::int32_t num_cells = quads.size() / 4;
+    std::vector<std::int64_t> quads1;
+    std::vector<std::int32_t> cell_map(num_cells);
+    for (std::int32_t c = num_cells - 1; c >= 0; --c)
+    {
+      cell_map[c] = num_cells - 1 - c;
+      quads1.insert(quads1.end(), std::next(quads.begin(), 4 * c),
+                    std::next(quads.begin(), 4 * (c + 1)));
+    }
+
+    std::vector<std::int32_t> changed = graph.update(types, {quads1}, cell_map);
+    check_graphs(graph.global_graph(),
+                 mesh::build_dual_graph(comm, types, {quads1}));
+    if (dolfinx::MPI::size(comm) == 1)
+      CHECK(changed.empty());
+  }
+
+  SECTION("unchanged cells")
+  {
+    const std::int32_t num_cells = quads.size() / 4;
+    std::vector<std::int32_t> cell_map(num_cells);
+    std::iota(cell_map.begin(), cell_map.end(), 0);
+    CHECK(graph.update(types, {quads}, cell_map).empty());
+    check_graphs(graph.global_graph(),
+                 mesh::build_dual_graph(comm, types, {quads}));
+  }
+}
@@ -8,10 +8,14 @@
 #include <algorithm>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
+#include <cmath>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/partitioners.h>
+#include <dolfinx/mesh/StructuredMesh.h>
 #include <dolfinx/mesh/generation.h>
 #include <dolfinx/mesh/utils.h>
 #include <iterator>
@@ -427,3 +431,122 @@ TEMPLATE_TEST_CASE("Rectangle triangle mesh (crossed)",
                                        /* e_6 */ {2, 4},
                                        /* e_7 */ {3, 4}});
 }
+
+TEST_CASE("Structured mesh (parallel blocks)", "[mesh][box][rectangle]")
+{
+  auto celltype
+      = GENERATE(mesh::CellType::tetrahedron, mesh::CellType::hexahedron,
+                 mesh::CellType::prism, mesh::CellType::triangle,
+                 mesh::CellType::quadrilateral);
+  const int tdim = mesh::cell_dim(celltype);
+
+  auto create = [&]()
+  {
+    if (tdim == 3)
+    {
+      return mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 2, 3}}},
+                                      {4, 5, 3}, celltype);
+    }
+    else
+    {
+      return mesh::create_rectangle<double>(MPI_COMM_WORLD, {{{0, 0}, {1, 2}}},
+                                            {6, 5}, celltype,
+                                            mesh::DiagonalType::left_right);
+    }
+  };
+  mesh::Mesh<double> mesh = create();
+  auto topology = mesh.topology();
+  const std::int64_t num_cubes = tdim == 3 ? 4 * 5 * 3 : 6 * 5;
+  const std::int64_t num_vertices = tdim == 3 ? 5 * 6 * 4 : 7 * 6;
+  int cells_per_cube = 1;
+  if (celltype == mesh::CellType::tetrahedron)
+    cells_per_cube = 6;
+  else if (celltype == mesh::CellType::prism
+           or celltype == mesh::CellType::triangle)
+  {
+    cells_per_cube = 2;
+  }
+  CHECK(topology->index_map(tdim)->size_global()
+        == cells_per_cube * num_cubes);
+  CHECK(topology->index_map(0)->size_global() == num_vertices);
+  CHECK(topology->index_map(tdim)->num_ghosts() == 0);
+
+  // The number of exterior facets is independent of the decomposition
+  mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
+  std::int64_t num_exterior
+      = mesh::exterior_facet_indices(*mesh.topology()).size();
+  MPI_Allreduce(MPI_IN_PLACE, &num_exterior, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  std::int64_t expected = 0;
+  if (celltype == mesh::CellType::tetrahedron)
+    expected = 2 * 2 * (4 * 5 + 5 * 3 + 4 * 3);
+  else if (celltype == mesh::CellType::hexahedron)
+    expected = 2 * (4 * 5 + 5 * 3 + 4 * 3);
+  else if (celltype == mesh::CellType::prism)
+    expected = 2 * 2 * 4 * 5 + 2 * (5 * 3 + 4 * 3);
+  else
+    expected = 2 * (6 + 5);
+  CHECK(num_exterior == expected);
+}
+
+TEST_CASE("Implicit structured mesh", "[mesh][box][rectangle]")
+{
+  auto celltype = GENERATE(mesh::CellType::hexahedron,
+                           mesh::CellType::quadrilateral);
+  const int tdim = mesh::cell_dim(celltype);
+  const std::array<std::int64_t, 3> n
+      = tdim == 3 ? std::array<std::int64_t, 3>{4, 5, 3}
+                  : std::array<std::int64_t, 3>{6, 5, 0};
+  mesh::StructuredMesh<double> mesh(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 2, 3}}},
+                                    n, celltype);
+
+  const std::int64_t num_cells = tdim == 3 ? 4 * 5 * 3 : 6 * 5;
+  const std::int64_t num_vertices = tdim == 3 ? 5 * 6 * 4 : 7 * 6;
+  auto cell_map = mesh.cell_index_map();
+  auto vertex_map = mesh.vertex_index_map();
+  CHECK(cell_map->size_global() == num_cells);
+  CHECK(vertex_map->size_global() == num_vertices);
+
+  // Coordinates are computed from the grid index of the vertex, and
+  // each grid point is owned by one process
+  auto x = mesh.x();
+  REQUIRE(x.extent(0)
+          == std::size_t(vertex_map->size_local() + vertex_map->num_ghosts()));
+  const std::array<double, 3> h = {1.0 / n[0], 2.0 / n[1], 3.0 / n[2]};
+  std::int64_t key_sum = 0;
+  for (std::size_t v = 0; v < x.extent(0); ++v)
+  {
+    std::array<std::int64_t, 3> idx = mesh.vertex_index(v);
+    CHECK(mesh.vertex(idx) == static_cast<std::int32_t>(v));
+    for (int i = 0; i < tdim; ++i)
+      CHECK(std::abs(x(v, i) - idx[i] * h[i]) < 1e-12);
+    if (tdim == 2)
+      CHECK(x(v, 2) == 0.0);
+    if (static_cast<std::int32_t>(v) < vertex_map->size_local())
+      key_sum += idx[0] + (n[0] + 1) * (idx[1] + (n[1] + 1) * idx[2]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &key_sum, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  CHECK(key_sum == num_vertices * (num_vertices - 1) / 2);
+
+  // The cells cover the domain, with vertices in the reference order
+  auto dofmap = mesh.dofmap();
+  REQUIRE(dofmap.extent(0) == std::size_t(cell_map->size_local()));
+  REQUIRE(dofmap.extent(1) == std::size_t(tdim == 3 ? 8 : 4));
+  double volume = 0;
+  for (std::size_t c = 0; c < dofmap.extent(0); ++c)
+  {
+    std::int32_t v0 = dofmap(c, 0);
+    std::int32_t v1 = dofmap(c, dofmap.extent(1) - 1);
+    double vol = 1;
+    for (int i = 0; i < tdim; ++i)
+    {
+      CHECK(x(dofmap(c, 1 << i), i) > x(v0, i));
+      vol *= x(v1, i) - x(v0, i);
+    }
+    volume += vol;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPI_DOUBLE, MPI_SUM,
+                MPI_COMM_WORLD);
+  CHECK(std::abs(volume - (tdim == 3 ? 6.0 : 2.0)) < 1e-12);
+}
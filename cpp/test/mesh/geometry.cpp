@@ -0,0 +1,205 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for cached geometry Jacobian data and geometric entity
+// quantities
+
+#include <algorithm>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/fem/GeometryFactors.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Cached Jacobians of an affine map", "[mesh][geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0.0, 0.0}, {2.0, 1.0}}}, {6, 5},
+          mesh::CellType::triangle));
+  mesh::Geometry<double>& geometry = mesh->geometry();
+  CHECK(!geometry.jacobians());
+
+  fem::GeometryFactors<double> g0(mesh);
+  geometry.create_jacobians();
+  auto jacobians = geometry.jacobians();
+  REQUIRE(jacobians);
+  CHECK(jacobians->cellwise);
+  CHECK(jacobians->num_points == 1);
+  CHECK(geometry.jacobians(std::vector<double>{0.2, 0.3}) == jacobians);
+
+  // Cell areas
+  const std::int32_t num_cells
+      = mesh->topology()->index_map(2)->size_local();
+  double area = 0;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    area += 0.5 * std::abs(jacobians->detJ[jacobians->index(c, 3)]);
+  MPI_Allreduce(MPI_IN_PLACE, &area, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  CHECK(area == Catch::Approx(2.0));
+
+  // K J = I
+  for (std::size_t i = 0; i < jacobians->detJ.size(); ++i)
+  {
+    const double* J = jacobians->J.data() + 4 * i;
+    const double* K = jacobians->K.data() + 4 * i;
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int k = 0; k < 2; ++k)
+      {
+        CHECK(K[2 * j] * J[k] + K[2 * j + 1] * J[2 + k]
+              == Catch::Approx(j == k ? 1.0 : 0.0).margin(1e-12));
+      }
+    }
+  }
+
+  // Geometry factors computed from the cached data
+  fem::GeometryFactors<double> g1(mesh);
+  REQUIRE(g0.factors().size() == g1.factors().size());
+  for (std::size_t i = 0; i < g0.factors().size(); ++i)
+    CHECK(g1.factors()[i] == Catch::Approx(g0.factors()[i]));
+
+  // Access to the coordinates discards the cached data
+  std::span<double> x = geometry.x();
+  for (std::size_t i = 0; i < x.size(); i += 3)
+    x[i] *= 2.0;
+  CHECK(!geometry.jacobians());
+}
+
+TEST_CASE("Cached Jacobians of a non-affine map", "[mesh][geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0.0, 0.0}, {2.0, 1.0}}}, {4, 5},
+          mesh::CellType::quadrilateral));
+  mesh::Geometry<double>& geometry = mesh->geometry();
+
+  const std::vector<double> X = {0.2, 0.3, 0.7, 0.5, 1.0, 0.0};
+  CHECK_THROWS(geometry.create_jacobians());
+  geometry.create_jacobians(X, {3, 2});
+  auto jacobians = geometry.jacobians(X);
+  REQUIRE(jacobians);
+  CHECK(!jacobians->cellwise);
+  CHECK(jacobians->num_points == 3);
+  CHECK(!geometry.jacobians());
+  CHECK(!geometry.jacobians(std::vector<double>{0.2, 0.3}));
+
+  // The cells are axis-aligned rectangles of size 0.5 x 0.2
+  const std::size_t num_cells = geometry.dofmap().extent(0);
+  REQUIRE(jacobians->detJ.size() == 3 * num_cells);
+  for (std::size_t c = 0; c < num_cells; ++c)
+  {
+    for (std::size_t p = 0; p < 3; ++p)
+    {
+      const std::size_t i = jacobians->index(c, p);
+      CHECK(std::abs(jacobians->detJ[i]) == Catch::Approx(0.1));
+      const double* J = jacobians->J.data() + 4 * i;
+      CHECK(std::abs(J[0] + J[1]) == Catch::Approx(0.5));
+      CHECK(std::abs(J[2] + J[3]) == Catch::Approx(0.2));
+    }
+  }
+}
+
+TEST_CASE("Compact geometry coordinate storage", "[mesh][geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0.0, 0.0}, {2.0, 1.0}}}, {4, 3},
+          mesh::CellType::triangle));
+  mesh::Geometry<double>& geometry = mesh->geometry();
+  CHECK(geometry.x_stride() == 3);
+  const std::vector<double> x0(geometry.x().begin(), geometry.x().end());
+  const std::size_t num_points = x0.size() / 3;
+  geometry.create_jacobians();
+  const std::vector<double> detJ0 = geometry.jacobians()->detJ;
+
+  CHECK_THROWS(geometry.set_x_stride(1));
+  geometry.set_x_stride(2);
+  CHECK(geometry.x_stride() == 2);
+  REQUIRE(geometry.x().size() == 2 * num_points);
+
+  // Cell coordinates are gathered with three components per point
+  auto x_dofmap = geometry.dofmap();
+  mesh::NodeCoordinates<double> x = geometry.coordinates();
+  std::vector<double> cdofs(3 * x_dofmap.extent(1));
+  for (std::size_t c = 0; c < x_dofmap.extent(0); ++c)
+  {
+    x.copy(std::span(&x_dofmap(c, 0), x_dofmap.extent(1)), cdofs.data());
+    for (std::size_t i = 0; i < x_dofmap.extent(1); ++i)
+      for (int j = 0; j < 3; ++j)
+        CHECK(cdofs[3 * i + j] == x0[3 * x_dofmap(c, i) + j]);
+  }
+
+  geometry.create_jacobians();
+  CHECK(geometry.jacobians()->detJ == detJ0);
+
+  geometry.set_x_stride(3);
+  CHECK(std::ranges::equal(geometry.x(), x0));
+}
+
+TEST_CASE("Entity size, normals and midpoints", "[mesh][geometry]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0.0, 0.0}, {2.0, 1.0}}}, {4, 2},
+          mesh::CellType::triangle));
+  auto topology = mesh->topology();
+  const int tdim = topology->dim();
+  topology->create_connectivity(1, tdim);
+  topology->create_connectivity(tdim, 1);
+  std::vector<std::int32_t> cells(topology->index_map(tdim)->size_local());
+  std::iota(cells.begin(), cells.end(), 0);
+  std::vector<std::int32_t> edges(topology->index_map(1)->size_local());
+  std::iota(edges.begin(), edges.end(), 0);
+
+  // Cells are right-angled triangles with legs 0.5
+  const double hc = std::sqrt(0.5);
+  for (double h : mesh::h(*mesh, cells, tdim))
+    CHECK(h == Catch::Approx(hc));
+  for (double h : mesh::h(*mesh, edges, 1))
+    CHECK((h == Catch::Approx(0.5) or h == Catch::Approx(hc)));
+  const std::vector<double> n = mesh::cell_normals(*mesh, tdim, cells);
+  for (std::size_t i = 0; i < cells.size(); ++i)
+    CHECK(std::abs(n[3 * i + 2]) == Catch::Approx(1.0));
+
+  // Midpoints are the mean of the vertices
+  std::span<const double> x = mesh->geometry().x();
+  const std::vector<std::int32_t> xdofs
+      = mesh::entities_to_geometry(*mesh, 1, edges, false);
+  const std::vector<double> xm = mesh::compute_midpoints(*mesh, 1, edges);
+  for (std::size_t e = 0; e < edges.size(); ++e)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      CHECK(xm[3 * e + k]
+            == Catch::Approx((x[3 * xdofs[2 * e] + k]
+                              + x[3 * xdofs[2 * e + 1] + k])
+                             / 2)
+                   .margin(1e-12));
+    }
+  }
+
+  // Threaded computation and compact coordinate storage give the same
+  // result
+  const std::vector<double> h0 = mesh::h(*mesh, edges, 1);
+  CHECK(mesh::h(*mesh, edges, 1, 3) == h0);
+  CHECK(mesh::cell_normals(*mesh, tdim, cells, 3) == n);
+  CHECK(mesh::compute_midpoints(*mesh, 1, edges, 3) == xm);
+
+  mesh->geometry().set_x_stride(2);
+  CHECK(mesh::h(*mesh, edges, 1, 2) == h0);
+  CHECK(mesh::cell_normals(*mesh, tdim, cells) == n);
+  CHECK(mesh::compute_midpoints(*mesh, 1, edges) == xm);
+  mesh->geometry().set_x_stride(3);
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for MeshTags
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/generation.h>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("MeshTags value index", "[mesh][meshtags]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {6, 5}, mesh::CellType::triangle));
+  auto topology = mesh->topology();
+  const std::int32_t num_cells = topology->index_map(2)->size_local();
+
+  // Tag every other cell with one of a few values
+  std::vector<std::int32_t> indices;
+  std::vector<int> values;
+  for (std::int32_t c = 0; c < num_cells; c += 2)
+  {
+    indices.push_back(c);
+    values.push_back((7 * c) % 5 - 1);
+  }
+  mesh::MeshTags<int> tags(topology, 2, indices, values);
+
+  std::vector<std::vector<std::int32_t>> found;
+  for (int v = -2; v < 5; ++v)
+    found.push_back(tags.find(v));
+
+  CHECK(!tags.has_value_index());
+  CHECK_THROWS(tags.find_indexed(0));
+  tags.create_value_index();
+  CHECK(tags.has_value_index());
+  CHECK(std::ranges::is_sorted(tags.unique_values()));
+
+  std::size_t num_tagged = 0;
+  for (int v = -2; v < 5; ++v)
+  {
+    std::span<const std::int32_t> e = tags.find_indexed(v);
+    CHECK(std::vector<std::int32_t>(e.begin(), e.end()) == found[v + 2]);
+    CHECK(tags.find(v) == found[v + 2]);
+    num_tagged += e.size();
+  }
+  CHECK(num_tagged == indices.size());
+}
@@ -15,8 +15,11 @@
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/generation.h>
 #include <dolfinx/mesh/utils.h>
+#include <algorithm>
 #include <numeric>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace dolfinx;
 
@@ -78,9 +81,69 @@ void test_read_named_meshtags()
   CHECK_THROWS(mesh_file.read_meshtags(*mesh, "mesh", "missing"));
   mesh_file.close();
 }
+
+void test_read_facet_meshtags()
+{
+  const std::string mesh_file_name = "facet_tags.xdmf";
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box(
+      MPI_COMM_WORLD, {{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}, {4, 3, 2},
+      mesh::CellType::tetrahedron, part));
+
+  // Tag the exterior facets, with a value that depends on position
+  auto tag = [](const mesh::Mesh<double>& mesh)
+  {
+    auto topology = mesh.topology_mutable();
+    topology->create_entities(2);
+    topology->create_connectivity(2, 3);
+    std::vector<std::int32_t> facets = mesh::exterior_facet_indices(*topology);
+    std::vector<double> x = mesh::compute_midpoints(mesh, 2, facets);
+    std::vector<std::int32_t> values;
+    for (std::size_t i = 0; i < facets.size(); ++i)
+      values.push_back(1 + (x[3 * i] < 1e-10) + 2 * (x[3 * i + 2] > 1 - 1e-10));
+    return std::pair(std::move(facets), std::move(values));
+  };
+
+  auto [facets, values] = tag(*mesh);
+  mesh::MeshTags<std::int32_t> mt(mesh->topology(), 2, facets, values);
+  mt.name = "facets";
+
+  io::XDMFFile file(mesh->comm(), mesh_file_name, "w",
+                    io::XDMFFile::Encoding::HDF5);
+  file.write_mesh(*mesh);
+  file.write_meshtags(mt, mesh->geometry(),
+                      "/Xdmf/Domain/Grid[@Name='mesh']/Geometry");
+  file.close();
+
+  io::XDMFFile mesh_file(MPI_COMM_WORLD, mesh_file_name, "r",
+                         io::XDMFFile::Encoding::HDF5);
+  mesh = std::make_shared<mesh::Mesh<double>>(mesh_file.read_mesh(
+      fem::CoordinateElement<double>(mesh::CellType::tetrahedron, 1),
+      mesh::GhostMode::shared_facet, "mesh"));
+  auto [facets1, values1] = tag(*mesh);
+  mesh::MeshTags<std::int32_t> mt1
+      = mesh_file.read_meshtags(*mesh, "facets", {});
+  mesh_file.close();
+
+  // The tags on owned facets must be those that were written
+  auto map = mesh->topology()->index_map(2);
+  auto it = std::ranges::lower_bound(mt1.indices(), map->size_local());
+  std::vector<std::int32_t> owned(mt1.indices().begin(), it);
+  CHECK(owned == facets1);
+  CHECK(std::equal(values1.begin(), values1.end(), mt1.values().begin()));
+
+  // Tags on ghost facets are received from the owner
+  for (std::size_t i = owned.size(); i < mt1.values().size(); ++i)
+    CHECK((mt1.values()[i] >= 1 and mt1.values()[i] <= 4));
+}
 } // namespace
 
 TEST_CASE("Read meshtag by name", "[read_meshtag_by_name]")
 {
   test_read_named_meshtags();
 }
+
+TEST_CASE("Read facet meshtags", "[read_meshtag_by_name]")
+{
+  test_read_facet_meshtags();
+}
@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for redistributing a mesh and migrating mesh data
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <basix/finite-element.h>
+
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/interpolate.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/rebalance.h>
+#include <dolfinx/mesh/utils.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace dolfinx;
+
+namespace
+{
+std::shared_ptr<fem::FunctionSpace<double>>
+create_space(std::shared_ptr<mesh::Mesh<double>> mesh,
+             basix::element::family family, int degree)
+{
+  auto element = basix::create_element<double>(
+      family, mesh::cell_type_to_basix_type(mesh->topology()->cell_type()),
+      degree, basix::element::lagrange_variant::gll_warped,
+      basix::element::dpc_variant::unset, false);
+  return std::make_shared<fem::FunctionSpace<double>>(
+      fem::create_functionspace<double>(
+          mesh, std::make_shared<fem::FiniteElement<double>>(element)));
+}
+
+/// Interpolate the field (x1, x0 + x2, 2 x1) or its first component
+void interpolate(fem::Function<double>& u, std::size_t value_size)
+{
+  u.interpolate(
+      [value_size](auto x)
+          -> std::pair<std::vector<double>, std::vector<std::size_t>>
+      {
+        std::vector<double> f(value_size * x.extent(1));
+        for (std::size_t p = 0; p < x.extent(1); ++p)
+        {
+          f[p] = x(1, p);
+          if (value_size == 3)
+          {
+            f[x.extent(1) + p] = x(0, p) + x(2, p);
+            f[2 * x.extent(1) + p] = 2 * x(1, p);
+          }
+        }
+        return {f, {value_size, x.extent(1)}};
+      });
+}
+} // namespace
+
+TEST_CASE("Rebalance mesh", "[mesh][rebalance]")
+{
+  auto mesh0 = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {4, 3, 3}, mesh::CellType::tetrahedron,
+                               mesh::create_cell_partitioner()));
+  const int tdim = mesh0->topology()->dim();
+
+  auto [m1, dest] = mesh::rebalance(
+      *mesh0, mesh::create_cell_partitioner(mesh::GhostMode::shared_facet));
+  auto mesh1 = std::make_shared<mesh::Mesh<double>>(std::move(m1));
+
+  auto map0 = mesh0->topology()->index_map(tdim);
+  auto map1 = mesh1->topology()->index_map(tdim);
+  CHECK(map0->size_global() == map1->size_global());
+  CHECK(mesh1->geometry().index_map()->size_global()
+        == mesh0->geometry().index_map()->size_global());
+  CHECK(dest.num_nodes() == map0->size_local());
+
+  SECTION("cell data")
+  {
+    std::vector<std::int64_t> data0(map0->size_local());
+    std::iota(data0.begin(), data0.end(), map0->local_range()[0]);
+    std::vector<std::int64_t> data1
+        = mesh::migrate_cell_data<std::int64_t>(
+            *mesh0->topology(), *mesh1->topology(), dest, data0, 1);
+    CHECK(data1 == mesh1->topology()->original_cell_index.front());
+  }
+
+  SECTION("mesh tags")
+  {
+    auto marker = [](auto x)
+    {
+      std::vector<std::int8_t> marked(x.extent(1));
+      for (std::size_t p = 0; p < x.extent(1); ++p)
+        marked[p] = std::abs(x(0, p)) < 1e-10;
+      return marked;
+    };
+
+    mesh0->topology_mutable()->create_entities(tdim - 1);
+    mesh0->topology_mutable()->create_connectivity(tdim - 1, tdim);
+    std::vector<std::int32_t> facets0
+        = mesh::locate_entities_boundary(*mesh0, tdim - 1, marker);
+    mesh::MeshTags<std::int32_t> tags0(
+        mesh0->topology(), tdim - 1, facets0,
+        std::vector<std::int32_t>(facets0.size(), 3));
+    mesh::MeshTags<std::int32_t> tags1
+        = mesh::migrate_meshtags(tags0, *mesh1, dest);
+
+    mesh1->topology_mutable()->create_connectivity(tdim - 1, tdim);
+    std::vector<std::int32_t> facets1
+        = mesh::locate_entities_boundary(*mesh1, tdim - 1, marker);
+    CHECK(tags1.dim() == tdim - 1);
+    CHECK(std::ranges::equal(tags1.indices(), facets1));
+    CHECK(tags1.find(3) == facets1);
+  }
+
+  SECTION("functions")
+  {
+    auto [family, degree, value_size]
+        = GENERATE(std::tuple(basix::element::family::P, 2, 1),
+                   std::tuple(basix::element::family::N1E, 2, 3));
+
+    auto V0 = create_space(mesh0, family, degree);
+    auto V1 = create_space(mesh1, family, degree);
+    fem::Function<double> u0(V0), u1(V1), u_ref(V1);
+    interpolate(u0, value_size);
+    interpolate(u_ref, value_size);
+
+    fem::migrate(u1, u0, dest);
+    std::span<const double> x1 = u1.x()->array();
+    std::span<const double> x_ref = u_ref.x()->array();
+    REQUIRE(x1.size() == x_ref.size());
+    for (std::size_t i = 0; i < x1.size(); ++i)
+      CHECK(x1[i] == Catch::Approx(x_ref[i]).margin(1e-12));
+  }
+}
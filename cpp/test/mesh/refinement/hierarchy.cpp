@@ -0,0 +1,148 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for mesh hierarchies and inter-level transfer operators
+
+#include <basix/finite-element.h>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <dolfinx/fem/Function.h>
+#include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/discreteoperators.h>
+#include <dolfinx/fem/interpolate.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <dolfinx/refinement/MeshHierarchy.h>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Mesh hierarchy transfer operators", "[refinement,hierarchy]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_rectangle<double>(
+          MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {4, 3},
+          mesh::CellType::triangle,
+          mesh::create_cell_partitioner(mesh::GhostMode::none)));
+
+  // Uniform refinement, then refinement of part of the domain
+  refinement::MeshHierarchy<double> hierarchy(mesh);
+  hierarchy.refine();
+  {
+    auto mesh1 = hierarchy.mesh(1);
+    std::vector<std::int32_t> edges = mesh::locate_entities(
+        *mesh1, 1,
+        [](auto x)
+        {
+          std::vector<std::int8_t> marked;
+          for (std::size_t i = 0; i < x.extent(1); ++i)
+            marked.push_back(x(1, i) < 0.5);
+          return marked;
+        });
+    hierarchy.refine(edges);
+  }
+  REQUIRE(hierarchy.num_levels() == 3);
+
+  auto element = std::make_shared<fem::FiniteElement<double>>(
+      basix::create_element<double>(
+          basix::element::family::P, basix::cell::type::triangle, 2,
+          basix::element::lagrange_variant::unset,
+          basix::element::dpc_variant::unset, false));
+  auto f = [](auto x)
+      -> std::pair<std::vector<double>, std::vector<std::size_t>>
+  {
+    std::vector<double> fx;
+    for (std::size_t p = 0; p < x.extent(1); ++p)
+      fx.push_back(1 + x(0, p) * x(1, p) - 2 * x(1, p) * x(1, p));
+    return {fx, {fx.size()}};
+  };
+
+  for (std::size_t level = 1; level < hierarchy.num_levels(); ++level)
+  {
+    auto V0 = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(hierarchy.mesh(level - 1),
+                                          element));
+    auto V1 = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(hierarchy.mesh(level), element));
+    REQUIRE(hierarchy.parent_cells(level).size()
+            == std::size_t(V1->mesh()->topology()->index_map(2)->size_local()));
+
+    la::MatrixCSR<double> P = fem::create_prolongation_matrix<double>(
+        *V0, *V1, hierarchy.parent_cells(level));
+
+    // Prolongation reproduces a quadratic function exactly
+    fem::Function<double> u0(V0), u1(V1);
+    u0.interpolate(f);
+    u1.interpolate(f);
+    la::Vector<double> y(V1->dofmap()->index_map, 1);
+    y.set(0.0);
+    P.mult(*u0.x(), y);
+    for (std::int32_t i = 0; i < V1->dofmap()->index_map->size_local(); ++i)
+      CHECK(y.array()[i] == Catch::Approx(u1.x()->array()[i]).margin(1e-12));
+
+    // Restriction is the transpose of the prolongation
+    la::Vector<double> r(V0->dofmap()->index_map, 1);
+    r.set(0.0);
+    P.mult_transpose(*u1.x(), r);
+    CHECK(la::inner_product(r, *u0.x())
+          == Catch::Approx(la::inner_product(*u1.x(), y)));
+  }
+}
+
+TEST_CASE("Function transfer between refined meshes", "[refinement,hierarchy]")
+{
+  auto f = [](auto x)
+      -> std::pair<std::vector<double>, std::vector<std::size_t>>
+  {
+    std::vector<double> fx;
+    for (std::size_t p = 0; p < x.extent(1); ++p)
+      fx.push_back(1 + x(0, p) * x(1, p) - 2 * x(1, p) * x(1, p));
+    return {fx, {fx.size()}};
+  };
+
+  for (auto [cell_type, basix_cell] :
+       {std::pair(mesh::CellType::triangle, basix::cell::type::triangle),
+        std::pair(mesh::CellType::quadrilateral,
+                  basix::cell::type::quadrilateral)})
+  {
+    auto mesh = std::make_shared<mesh::Mesh<double>>(
+        mesh::create_rectangle<double>(
+            MPI_COMM_WORLD, {{{0.0, 0.0}, {1.0, 1.0}}}, {4, 3}, cell_type,
+            mesh::create_cell_partitioner(mesh::GhostMode::none)));
+    refinement::MeshHierarchy<double> hierarchy(mesh);
+    hierarchy.refine();
+
+    auto element = std::make_shared<fem::FiniteElement<double>>(
+        basix::create_element<double>(
+            basix::element::family::P, basix_cell, 2,
+            basix::element::lagrange_variant::unset,
+            basix::element::dpc_variant::unset, false));
+    auto V0 = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(hierarchy.mesh(0), element));
+    auto V1 = std::make_shared<fem::FunctionSpace<double>>(
+        fem::create_functionspace<double>(hierarchy.mesh(1), element));
+    std::span<const std::int32_t> parent_cells = hierarchy.parent_cells(1);
+
+    // Transfer in both directions reproduces a quadratic function
+    fem::Function<double> u0(V0), u1(V1), v0(V0), v1(V1);
+    u0.interpolate(f);
+    u1.interpolate(f);
+    fem::prolong(v1, u0, parent_cells, 2);
+    std::span<const double> x0 = u0.x()->array(), x1 = u1.x()->array();
+    for (std::size_t i = 0; i < x1.size(); ++i)
+      CHECK(v1.x()->array()[i] == Catch::Approx(x1[i]).margin(1e-12));
+    fem::inject(v0, u1, parent_cells, 2);
+    for (std::size_t i = 0; i < x0.size(); ++i)
+      CHECK(v0.x()->array()[i] == Catch::Approx(x0[i]).margin(1e-12));
+  }
+}
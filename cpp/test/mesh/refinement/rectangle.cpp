@@ -4,9 +4,13 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <limits>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include <mpi.h>
 
@@ -22,6 +26,7 @@
 #include <dolfinx/mesh/generation.h>
 #include <dolfinx/mesh/utils.h>
 #include <dolfinx/refinement/interval.h>
+#include <dolfinx/refinement/plaza.h>
 #include <dolfinx/refinement/refine.h>
 
 using namespace dolfinx;
@@ -159,3 +164,138 @@ plotter.show()
                                        /* e_14 */ {6, 8},
                                        /* e_15 */ {7, 8}});
 }
+
+TEMPLATE_TEST_CASE("Rectangle refinement without redistribution",
+                   "refinement,rectangle", double)
+{
+  using T = TestType;
+
+  mesh::Mesh<T> mesh = dolfinx::mesh::create_rectangle<T>(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {7, 5}, mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+  mesh.topology()->create_entities(1);
+
+  // Mark edges in part of the domain
+  std::vector<std::int32_t> edges = mesh::locate_entities(
+      mesh, 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marked;
+        for (std::size_t i = 0; i < x.extent(1); ++i)
+          marked.push_back(x(0, i) < 0.4 + 1e-10);
+        return marked;
+      });
+
+  // Refine using the refinement data directly (no partitioner), and
+  // via mesh::create_mesh
+  auto [mesh0, parent_cell0, parent_facet0]
+      = refinement::refine(mesh, std::span<const std::int32_t>(edges), nullptr,
+                           refinement::Option::parent_cell);
+  auto [mesh1, parent_cell1, parent_facet1] = refinement::refine(
+      mesh, std::span<const std::int32_t>(edges),
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+
+  // Refined cells stay on the process of the parent cell
+  auto cell_map0 = mesh0.topology()->index_map(2);
+  REQUIRE(parent_cell0);
+  REQUIRE(parent_cell0->size() == std::size_t(cell_map0->size_local()));
+  CHECK(cell_map0->num_ghosts() == 0);
+
+  auto global_size = [](const mesh::Mesh<T>& mesh, int dim)
+  {
+    mesh.topology()->create_entities(dim);
+    return mesh.topology()->index_map(dim)->size_global();
+  };
+  for (int d = 0; d < 3; ++d)
+    CHECK(global_size(mesh0, d) == global_size(mesh1, d));
+
+  // Compare the total area and the length of the boundary
+  auto measures = [](const mesh::Mesh<T>& mesh)
+  {
+    auto x = mesh.geometry().x();
+    auto dofmap = mesh.geometry().dofmap();
+    auto topology = mesh.topology();
+    std::array<T, 2> m = {0, 0};
+    for (std::int32_t c = 0; c < topology->index_map(2)->size_local(); ++c)
+    {
+      std::array<T, 4> dx;
+      for (std::size_t i = 0; i < 2; ++i)
+        for (std::size_t j = 0; j < 2; ++j)
+          dx[2 * i + j] = x[3 * dofmap(c, i + 1) + j] - x[3 * dofmap(c, 0) + j];
+      m[0] += 0.5 * std::abs(dx[0] * dx[3] - dx[1] * dx[2]);
+    }
+
+    topology->create_connectivity(1, 0);
+    topology->create_connectivity(1, 2);
+    auto f_to_v = topology->connectivity(1, 0);
+    auto map_v = topology->index_map(0);
+    std::vector<std::int32_t> v_to_x(map_v->size_local() + map_v->num_ghosts());
+    auto c_to_v = topology->connectivity(2, 0);
+    for (std::int32_t c = 0; c < c_to_v->num_nodes(); ++c)
+    {
+      auto v = c_to_v->links(c);
+      for (std::size_t i = 0; i < v.size(); ++i)
+        v_to_x[v[i]] = dofmap(c, i);
+    }
+    for (std::int32_t f : mesh::exterior_facet_indices(*topology))
+    {
+      auto v = f_to_v->links(f);
+      T dx = x[3 * v_to_x[v[1]]] - x[3 * v_to_x[v[0]]];
+      T dy = x[3 * v_to_x[v[1]] + 1] - x[3 * v_to_x[v[0]] + 1];
+      m[1] += std::sqrt(dx * dx + dy * dy);
+    }
+
+    std::array<T, 2> m_global;
+    MPI_Allreduce(m.data(), m_global.data(), 2, dolfinx::MPI::mpi_t<T>,
+                  MPI_SUM, mesh.comm());
+    return m_global;
+  };
+
+  auto m0 = measures(mesh0);
+  auto m1 = measures(mesh1);
+  CHECK_THAT(m0[0], WithinAbs(1.0, 1e-12));
+  CHECK_THAT(m0[0], WithinAbs(m1[0], 1e-12));
+  CHECK_THAT(m0[1], WithinAbs(4.0, 1e-12));
+  CHECK_THAT(m0[1], WithinAbs(m1[1], 1e-12));
+}
+
+TEMPLATE_TEST_CASE("Rectangle threaded refinement", "refinement,rectangle",
+                   double)
+{
+  using T = TestType;
+
+  mesh::Mesh<T> mesh = dolfinx::mesh::create_rectangle<T>(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {9, 7}, mesh::CellType::triangle,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+  mesh.topology()->create_entities(1);
+  std::vector<std::int32_t> edges = mesh::locate_entities(
+      mesh, 1,
+      [](auto x)
+      {
+        std::vector<std::int8_t> marked;
+        for (std::size_t i = 0; i < x.extent(1); ++i)
+          marked.push_back(x(1, i) < 0.3 + 1e-10);
+        return marked;
+      });
+
+  // The refinement data does not depend on the number of threads
+  for (auto marked : {std::optional<std::span<const std::int32_t>>(),
+                      std::optional<std::span<const std::int32_t>>(edges)})
+  {
+    auto [cells0, x0, xshape0, parent_cell0, parent_facet0]
+        = refinement::plaza::compute_refinement_data(
+            mesh, marked, refinement::Option::parent_cell_and_facet, 1);
+    auto [cells1, x1, xshape1, parent_cell1, parent_facet1]
+        = refinement::plaza::compute_refinement_data(
+            mesh, marked, refinement::Option::parent_cell_and_facet, 3);
+    CHECK_THAT(cells1.array(), RangeEquals(cells0.array()));
+    CHECK_THAT(cells1.offsets(), RangeEquals(cells0.offsets()));
+    CHECK(x1 == x0);
+    REQUIRE(parent_cell0);
+    REQUIRE(parent_cell1);
+    CHECK(*parent_cell1 == *parent_cell0);
+    REQUIRE(parent_facet0);
+    REQUIRE(parent_facet1);
+    CHECK(*parent_facet1 == *parent_facet0);
+  }
+}
@@ -0,0 +1,170 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <mpi.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/utils.h>
+#include <dolfinx/refinement/refine.h>
+#include <dolfinx/refinement/utils.h>
+
+using namespace dolfinx;
+
+namespace
+{
+// Refine a mesh of the unit square/cube with n[i] cells in direction
+// i, and check the refined mesh and the transfer of exterior facet tags
+template <typename T>
+void check_uniform_refinement(const mesh::Mesh<T>& mesh, std::array<int, 3> n,
+                              const mesh::CellPartitionFunction& partitioner)
+{
+  const int tdim = mesh.topology()->dim();
+  mesh.topology_mutable()->create_entities(tdim - 1);
+  mesh.topology_mutable()->create_connectivity(tdim - 1, tdim);
+  mesh.topology_mutable()->create_connectivity(tdim, tdim - 1);
+
+  auto [mesh1, parent_cell, parent_facet]
+      = refinement::refine(mesh, std::nullopt, partitioner,
+                           refinement::Option::parent_cell_and_facet);
+  auto topology1 = mesh1.topology();
+  const int num_children = 1 << tdim;
+
+  // Number of cells and vertices
+  const std::int64_t num_cells
+      = mesh.topology()->index_map(tdim)->size_global();
+  CHECK(topology1->index_map(tdim)->size_global()
+        == num_children * num_cells);
+  std::int64_t num_vertices = 1;
+  for (int i = 0; i < tdim; ++i)
+    num_vertices *= 2 * n[i] + 1;
+  CHECK(topology1->index_map(0)->size_global() == num_vertices);
+
+  // The refined vertices are on the lattice with spacing h / 2
+  auto x = mesh1.geometry().x();
+  for (std::size_t i = 0; i < x.size() / 3; ++i)
+  {
+    for (int j = 0; j < tdim; ++j)
+    {
+      const T xi = 2 * n[j] * x[3 * i + j];
+      CHECK(std::abs(xi - std::round(xi)) < 1e-10);
+    }
+  }
+
+  if (!partitioner)
+  {
+    REQUIRE(parent_cell);
+    REQUIRE(parent_facet);
+    const std::size_t num_cells_local
+        = topology1->index_map(tdim)->size_local();
+    CHECK(parent_cell->size() == num_cells_local);
+    const std::size_t num_facets
+        = mesh::cell_num_entities(mesh.topology()->cell_type(), tdim - 1);
+    CHECK(parent_facet->size() == num_facets * num_cells_local);
+
+    // Each exterior facet has 2^(tdim - 1) children
+    std::vector<std::int32_t> facets
+        = mesh::exterior_facet_indices(*mesh.topology());
+    mesh::MeshTags<std::int32_t> tags0(
+        mesh.topology(), tdim - 1, facets,
+        std::vector<std::int32_t>(facets.size(), 1));
+    topology1->create_entities(tdim - 1);
+    topology1->create_connectivity(tdim, tdim - 1);
+    auto [facets1, values1] = refinement::transfer_facet_meshtag(
+        tags0, *topology1, *parent_cell, *parent_facet);
+
+    auto count_owned = [](auto& facets, auto& map)
+    {
+      std::int64_t count = std::count_if(
+          facets.begin(), facets.end(),
+          [&map](auto f) { return f < map.size_local(); });
+      MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_INT64_T, MPI_SUM,
+                    map.comm());
+      return count;
+    };
+    CHECK(count_owned(facets1, *topology1->index_map(tdim - 1))
+          == (num_children / 2)
+                 * count_owned(facets, *mesh.topology()->index_map(tdim - 1)));
+
+    // Transfer of several tags in one pass gives the same tags
+    std::vector<std::int32_t> cells(
+        mesh.topology()->index_map(tdim)->size_local());
+    std::iota(cells.begin(), cells.end(), 0);
+    mesh::MeshTags<std::int32_t> cell_tags0(mesh.topology(), tdim, cells,
+                                            cells);
+    auto tags1 = refinement::transfer_meshtags(
+        {std::cref(tags0), std::cref(cell_tags0)}, *topology1, *parent_cell,
+        *parent_facet);
+    REQUIRE(tags1.size() == 2);
+    CHECK(tags1[0][0] == facets1);
+    CHECK(tags1[0][1] == values1);
+    CHECK(tags1[1]
+          == refinement::transfer_cell_meshtag(cell_tags0, *topology1,
+                                               *parent_cell));
+    REQUIRE(tags1[1][0].size() == num_cells_local);
+    const std::int64_t offset = topology1->index_map(tdim)->local_range()[0];
+    for (std::size_t c = 0; c < num_cells_local; ++c)
+    {
+      const std::int64_t c0 = topology1->original_cell_index[0][c] - offset;
+      CHECK(tags1[1][1][c] == (*parent_cell)[c0]);
+    }
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Quadrilateral uniform refinement",
+                   "[refinement][uniform]", double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_rectangle<T>(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {4, 3},
+      mesh::CellType::quadrilateral,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+  check_uniform_refinement(mesh, {4, 3, 0}, nullptr);
+  check_uniform_refinement(
+      mesh, {4, 3, 0}, mesh::create_cell_partitioner(mesh::GhostMode::none));
+}
+
+TEMPLATE_TEST_CASE("Hexahedron uniform refinement", "[refinement][uniform]",
+                   double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_box<T>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 2, 2},
+      mesh::CellType::hexahedron,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+  check_uniform_refinement(mesh, {3, 2, 2}, nullptr);
+  check_uniform_refinement(
+      mesh, {3, 2, 2}, mesh::create_cell_partitioner(mesh::GhostMode::none));
+}
+
+TEMPLATE_TEST_CASE("Quadrilateral refinement with markers",
+                   "[refinement][uniform]", double)
+{
+  using T = TestType;
+  mesh::Mesh<T> mesh = mesh::create_rectangle<T>(
+      MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {2, 2},
+      mesh::CellType::quadrilateral,
+      mesh::create_cell_partitioner(mesh::GhostMode::none));
+  std::vector<std::int32_t> edges;
+  CHECK_THROWS(refinement::refine(mesh, std::span<const std::int32_t>(edges)));
+}
@@ -0,0 +1,316 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for mesh::Topology
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/fem/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Topology.h>
+#include <dolfinx/mesh/generation.h>
+#include <dolfinx/mesh/permutationcomputation.h>
+#include <dolfinx/mesh/topologycomputation.h>
+#include <dolfinx/mesh/utils.h>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dolfinx;
+
+TEST_CASE("Topology connectivity memory budget", "[mesh][topology]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(
+      mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                               {4, 4, 4}, mesh::CellType::tetrahedron));
+  auto topology = mesh->topology_mutable();
+
+  // Cell-vertex connectivity defines the mesh and cannot be evicted
+  CHECK(topology->connectivity_memory(3, 0) > 0);
+  CHECK(topology->cached_connectivity_memory() == 0);
+  CHECK_THROWS_AS(topology->evict_connectivity(3, 0), std::runtime_error);
+
+  // Computing 0 -> 3 is cached
+  topology->create_connectivity(0, 3);
+  const std::size_t bytes03 = topology->connectivity_memory(0, 3);
+  CHECK(bytes03 > 0);
+  CHECK(topology->cached_connectivity_memory() == bytes03);
+  auto c03 = topology->connectivity(0, 3);
+  const std::int32_t num_links = c03->array().size();
+
+  // Evicted connectivity is recomputed on demand
+  c03.reset();
+  topology->evict_connectivity(0, 3);
+  CHECK(!topology->connectivity(0, 3));
+  CHECK(topology->connectivity_memory(0, 3) == 0);
+  topology->create_connectivity(0, 3);
+  REQUIRE(topology->connectivity(0, 3));
+  CHECK((std::int32_t)topology->connectivity(0, 3)->array().size()
+        == num_links);
+
+  // Least recently used connectivities are evicted to meet the budget
+  topology->create_connectivity(2, 3);
+  topology->set_connectivity_memory_budget(
+      topology->connectivity_memory(2, 3));
+  CHECK(!topology->connectivity(0, 3));
+  CHECK(topology->connectivity(2, 3));
+  CHECK(topology->cached_connectivity_memory()
+        <= topology->connectivity_memory_budget());
+
+  // The requested connectivity is kept
+  topology->create_connectivity(0, 3);
+  CHECK(topology->connectivity(0, 3));
+  CHECK(!topology->connectivity(2, 3));
+
+  // Connectivities that are in use are not evicted
+  c03 = topology->connectivity(0, 3);
+  topology->set_connectivity_memory_budget(0);
+  CHECK(topology->connectivity(0, 3));
+  c03.reset();
+  topology->set_connectivity_memory_budget(0);
+  CHECK(!topology->connectivity(0, 3));
+  CHECK(topology->cached_connectivity_memory() == 0);
+
+  // Entity connectivity is never evicted
+  CHECK(topology->connectivity(2, 0));
+  CHECK(topology->connectivity(3, 2));
+}
+
+TEST_CASE("Topology interior and boundary cell ranges", "[mesh][topology]")
+{
+  auto part = mesh::create_cell_partitioner(mesh::GhostMode::shared_facet);
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {6, 6, 6},
+      mesh::CellType::tetrahedron, part));
+  auto topology = mesh->topology_mutable();
+  auto cell_map = topology->index_map(3);
+  auto vertex_map = topology->index_map(0);
+
+  const std::array<std::int32_t, 4> r = topology->cell_ranges();
+  CHECK(r[0] == 0);
+  CHECK(r[1] <= r[2]);
+  CHECK(r[2] == cell_map->size_local());
+  CHECK(r[3] == cell_map->size_local() + cell_map->num_ghosts());
+
+  // Interior cells do not have a vertex that is shared with another
+  // process
+  std::vector<std::int8_t> shared(
+      vertex_map->size_local() + vertex_map->num_ghosts(), 0);
+  std::fill(std::next(shared.begin(), vertex_map->size_local()), shared.end(),
+            1);
+  for (std::int32_t v : vertex_map->shared_indices())
+    shared[v] = 1;
+  auto c_to_v = topology->connectivity(3, 0);
+  for (std::int32_t c = r[0]; c < r[1]; ++c)
+  {
+    CHECK(std::ranges::none_of(c_to_v->links(c),
+                               [&](auto v) { return shared[v]; }));
+  }
+
+  // Integration domains list the entries of interior cells first
+  topology->create_connectivity(2, 3);
+  topology->create_connectivity(3, 2);
+  std::vector<std::int32_t> facets(topology->index_map(2)->size_local());
+  std::iota(facets.begin(), facets.end(), 0);
+  std::vector<std::int32_t> data = fem::compute_integration_domains(
+      fem::IntegralType::interior_facet, *topology, facets);
+  bool boundary = false;
+  for (std::size_t i = 0; i < data.size(); i += 4)
+  {
+    bool interior = data[i] < r[1] and data[i + 2] < r[1];
+    CHECK((interior or !boundary));
+    boundary = boundary or !interior;
+  }
+}
+
+TEST_CASE("Topology facet permutations", "[mesh][topology]")
+{
+  for (auto cell_type :
+       {mesh::CellType::tetrahedron, mesh::CellType::hexahedron})
+  {
+    auto mesh = std::make_shared<mesh::Mesh<double>>(
+        mesh::create_box<double>(MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}},
+                                 {3, 4, 2}, cell_type,
+                                 mesh::create_cell_partitioner(
+                                     mesh::GhostMode::shared_facet)));
+    auto topology = mesh->topology_mutable();
+
+    // Only the facets are created
+    topology->create_facet_permutations();
+    CHECK(topology->index_map(2));
+    CHECK(!topology->index_map(1));
+    CHECK_THROWS_AS(topology->get_cell_permutation_info(),
+                    std::runtime_error);
+    const std::vector<std::uint8_t> perms0
+        = topology->get_facet_permutations();
+
+    // Same facet data as computed with all entity permutations
+    topology->create_entity_permutations();
+    CHECK(topology->index_map(1));
+    CHECK(topology->get_facet_permutations() == perms0);
+  }
+}
+
+TEST_CASE("Topology threaded entity permutations", "[mesh][topology]")
+{
+  for (auto cell_type : {mesh::CellType::triangle, mesh::CellType::tetrahedron,
+                         mesh::CellType::hexahedron, mesh::CellType::prism})
+  {
+    std::shared_ptr<mesh::Mesh<double>> mesh;
+    if (mesh::cell_dim(cell_type) == 2)
+    {
+      mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_rectangle(
+          MPI_COMM_WORLD, {{{0, 0}, {1, 1}}}, {5, 4}, cell_type));
+    }
+    else
+    {
+      mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+          MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 4, 2}, cell_type));
+    }
+    auto topology = mesh->topology_mutable();
+    topology->create_entity_permutations();
+
+    auto [facet_perms, cell_info]
+        = mesh::compute_entity_permutations(*topology, 3);
+    CHECK(facet_perms == topology->get_facet_permutations());
+    CHECK(cell_info == topology->get_cell_permutation_info());
+    CHECK(mesh::compute_facet_permutations(*topology, 3)
+          == topology->get_facet_permutations());
+  }
+}
+
+TEST_CASE("Topology threaded connectivity", "[mesh][topology]")
+{
+  for (auto cell_type :
+       {mesh::CellType::tetrahedron, mesh::CellType::hexahedron})
+  {
+    auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+        MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 4, 2}, cell_type));
+    auto topology = mesh->topology_mutable();
+    topology->create_entities(1);
+    topology->create_entities(2);
+
+    // Transposes (d0 < d1) and vertex matching (facet -> edge)
+    for (auto [d0, d1] : {std::array{0, 3}, std::array{2, 3},
+                          std::array{1, 2}, std::array{2, 1}})
+    {
+      auto [c0, c1] = mesh::compute_connectivity(*topology, {d0, 0}, {d1, 0});
+      auto [c0_t, c1_t]
+          = mesh::compute_connectivity(*topology, {d0, 0}, {d1, 0}, 3);
+      REQUIRE(c0);
+      REQUIRE(c0_t);
+      CHECK(c0_t->array() == c0->array());
+      CHECK(c0_t->offsets() == c0->offsets());
+      CHECK(bool(c1) == bool(c1_t));
+      if (c1)
+        CHECK(c1_t->array() == c1->array());
+    }
+
+    topology->create_connectivity(0, 3, 3);
+    auto c03 = topology->connectivity(0, 3);
+    REQUIRE(c03);
+    CHECK(c03->num_nodes() == topology->index_map(0)->size_local()
+                                  + topology->index_map(0)->num_ghosts());
+  }
+}
+
+TEST_CASE("Topology concurrent lazy creation", "[mesh][topology]")
+{
+  // The creation functions communicate, which is serialised by the
+  // topology lock
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  if (provided < MPI_THREAD_SERIALIZED)
+    SKIP("MPI_THREAD_SERIALIZED is not provided.");
+
+  auto create_mesh = []()
+  {
+    return mesh::create_box<double>(MPI_COMM_SELF, {{{0, 0, 0}, {1, 1, 1}}},
+                                    {3, 4, 2}, mesh::CellType::tetrahedron);
+  };
+  mesh::Mesh<double> mesh0 = create_mesh();
+  mesh0.topology_mutable()->create_entity_permutations();
+  mesh0.topology_mutable()->create_connectivity(2, 3);
+
+  // Create the same data from several threads
+  mesh::Mesh<double> mesh1 = create_mesh();
+  auto topology = mesh1.topology_mutable();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back(
+        [&topology, t]()
+        {
+          if (t % 2 == 0)
+            topology->create_entity_permutations();
+          topology->create_connectivity(2, 3);
+          topology->create_facet_permutations();
+        });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  CHECK(topology->get_cell_permutation_info()
+        == mesh0.topology()->get_cell_permutation_info());
+  CHECK(topology->get_facet_permutations()
+        == mesh0.topology()->get_facet_permutations());
+  REQUIRE(topology->connectivity(2, 3));
+  CHECK(topology->connectivity(2, 3)->array()
+        == mesh0.topology()->connectivity(2, 3)->array());
+}
+
+TEST_CASE("Topology boundary entities", "[mesh][topology]")
+{
+  auto mesh = std::make_shared<mesh::Mesh<double>>(mesh::create_box<double>(
+      MPI_COMM_WORLD, {{{0, 0, 0}, {1, 1, 1}}}, {3, 4, 2},
+      mesh::CellType::tetrahedron));
+  auto topology = mesh->topology_mutable();
+  CHECK(!topology->boundary_entities(2));
+
+  topology->create_boundary_entities(2);
+  std::shared_ptr facets = topology->boundary_entities(2);
+  REQUIRE(facets);
+  CHECK(mesh::exterior_facet_indices(*topology) == *facets);
+
+  // The data is computed once
+  topology->create_boundary_entities(2);
+  CHECK(topology->boundary_entities(2) == facets);
+
+  // Vertices and edges of the exterior facets
+  for (int dim : {0, 1})
+  {
+    topology->create_boundary_entities(dim);
+    std::shared_ptr entities = topology->boundary_entities(dim);
+    REQUIRE(entities);
+    CHECK(std::ranges::is_sorted(*entities));
+    auto f_to_e = topology->connectivity(2, dim);
+    std::vector<std::int32_t> expected;
+    for (std::int32_t f : *facets)
+    {
+      auto e = f_to_e->links(f);
+      expected.insert(expected.end(), e.begin(), e.end());
+    }
+    std::ranges::sort(expected);
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    CHECK(*entities == expected);
+  }
+  CHECK(topology->boundary_entities(2) == facets);
+
+  // Replacing a connectivity clears the data
+  topology->set_connectivity(
+      std::make_shared<graph::AdjacencyList<std::int32_t>>(
+          *topology->connectivity(2, 3)),
+      2, 3);
+  CHECK(!topology->boundary_entities(0));
+  CHECK(!topology->boundary_entities(2));
+}
@@ -0,0 +1,135 @@
+// Copyright (C) 2024 Garth N. Wells
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for the native Newton solver
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/krylov.h>
+#include <dolfinx/nls/newton.h>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Residual F(x) = A x + x^3 - b, with A the tridiagonal matrix with 2
+// on the diagonal and -1 off the diagonal, and b such that the solution
+// is x_i = sin(i)
+struct Problem
+{
+  explicit Problem(int n)
+      : map(std::make_shared<common::IndexMap>(MPI_COMM_SELF, n)), b(map, 1),
+        u(map, 1)
+  {
+    std::span<double> _u = u.mutable_array();
+    for (std::size_t i = 0; i < _u.size(); ++i)
+      _u[i] = std::sin(double(i + 1));
+    b.set(0);
+    la::Vector<double> r(map, 1);
+    (*this)(u, r);
+    std::ranges::copy(r.array(), b.mutable_array().begin());
+  }
+
+  // r = A x + x^3 - b
+  void operator()(const la::Vector<double>& x, la::Vector<double>& r) const
+  {
+    std::span<const double> _x = x.array(), _b = b.array();
+    std::span<double> _r = r.mutable_array();
+    const std::size_t n = _x.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      _r[i] = 2 * _x[i] + _x[i] * _x[i] * _x[i] - _b[i];
+      if (i > 0)
+        _r[i] -= _x[i - 1];
+      if (i + 1 < n)
+        _r[i] -= _x[i + 1];
+    }
+  }
+
+  std::shared_ptr<const common::IndexMap> map;
+  la::Vector<double> b, u;
+};
+
+void check_solution(const la::Vector<double>& x, const la::Vector<double>& u)
+{
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    CHECK(x.array()[i] == Catch::Approx(u.array()[i]).margin(1e-6));
+}
+} // namespace
+
+TEST_CASE("Newton solver", "[newton]")
+{
+  Problem F(40);
+
+  // Exact Jacobian action J(x) v = A v + 3 x^2 v with CG
+  auto solve = [&F](const la::Vector<double>& x, const la::Vector<double>& r,
+                    la::Vector<double>& dx) -> int
+  {
+    auto J = [&x](const la::Vector<double>& v, la::Vector<double>& y)
+    {
+      std::span<const double> _x = x.array(), _v = v.array();
+      std::span<double> _y = y.mutable_array();
+      const std::size_t n = _v.size();
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        _y[i] = (2 + 3 * _x[i] * _x[i]) * _v[i];
+        if (i > 0)
+          _y[i] -= _v[i - 1];
+        if (i + 1 < n)
+          _y[i] -= _v[i + 1];
+      }
+    };
+    return la::cg(J, r, dx, la::IdentityPreconditioner(), 1e-12).iterations;
+  };
+
+  SECTION("Newton")
+  {
+    la::Vector<double> x(F.map, 1);
+    x.set(0);
+    auto info = nls::newton(F, solve, x);
+    CHECK(info.converged);
+    CHECK(info.iterations < 10);
+    CHECK(info.linear_iterations > 0);
+    check_solution(x, F.u);
+  }
+
+  SECTION("Newton with line search")
+  {
+    la::Vector<double> x(F.map, 1);
+    x.set(20);
+    auto info = nls::newton(F, solve, x, 1e-9, 1e-10, 50, 10);
+    CHECK(info.converged);
+    check_solution(x, F.u);
+  }
+
+  SECTION("Jacobian-free Newton-Krylov")
+  {
+    la::Vector<double> x(F.map, 1);
+    x.set(0);
+    auto info = nls::newton(F, nls::jfnk_solver(F, la::IdentityPreconditioner(),
+                                                 40, 1e-8),
+                            x, 1e-9, 1e-10, 50, 5);
+    CHECK(info.converged);
+    CHECK(info.iterations < 20);
+    check_solution(x, F.u);
+  }
+
+  SECTION("Maximum iterations")
+  {
+    la::Vector<double> x(F.map, 1);
+    x.set(0);
+    auto info = nls::newton(F, solve, x, 1e-9, 1e-10, 1);
+    CHECK(!info.converged);
+    CHECK(info.iterations == 1);
+  }
+}
@@ -6,6 +6,7 @@ from ufl import (
     Mesh,
     TestFunction,
     TrialFunction,
+    ds,
     dx,
     grad,
     inner,
@@ -23,3 +24,18 @@ f = Coefficient(V)
 kappa = Constant(mesh)
 
 a = kappa * inner(grad(u), grad(v)) * dx
+L = inner(f, v) * dx + kappa * v * ds
+M = kappa * f * f * dx
+
+# Block system with a cell-local (discontinuous) field for static
+# condensation, with a11 = a
+e0 = element("Lagrange", "tetrahedron", 1, discontinuous=True)
+V0 = FunctionSpace(mesh, e0)
+u0 = TrialFunction(V0)
+v0 = TestFunction(V0)
+
+a00 = inner(u0, v0) * dx
+a01 = inner(u, v0) * dx
+a10 = inner(u0, v) * dx
+L0 = inner(f, v0) * dx
+L1 = inner(f, v) * dx
@@ -0,0 +1,211 @@
+// Copyright (C) 2024 Chris N. Richardson
+//
+// This file is part of DOLFINx (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Unit tests for preconditioners acting on la::MatrixCSR
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/MatrixCSR.h>
+#include <dolfinx/la/MultiVector.h>
+#include <dolfinx/la/SparseLU.h>
+#include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/Vector.h>
+#include <dolfinx/la/preconditioners.h>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+/// Create a local tridiagonal matrix with blocks of size bs, diagonal
+/// blocks D and off-diagonal blocks (scaled identity) c*I
+template <int bs>
+la::MatrixCSR<double> create_tridiagonal(int n, const std::vector<double>& D,
+                                         double c)
+{
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_SELF, n);
+  la::SparsityPattern sp(MPI_COMM_SELF, {map, map}, {bs, bs});
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    for (std::int32_t j = std::max(0, i - 1); j < std::min(n, i + 2); ++j)
+    {
+      std::array<std::int32_t, 1> r{i}, col{j};
+      sp.insert(r, col);
+    }
+  }
+  sp.finalize();
+
+  la::MatrixCSR<double> A(sp);
+  std::vector<double> C(bs * bs, 0);
+  for (int k = 0; k < bs; ++k)
+    C[k * bs + k] = c;
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    std::array<std::int32_t, 1> r{i};
+    A.set<bs, bs>(D, r, r);
+    for (std::int32_t j : {i - 1, i + 1})
+    {
+      if (j >= 0 and j < n)
+      {
+        std::array<std::int32_t, 1> col{j};
+        A.set<bs, bs>(C, r, col);
+      }
+    }
+  }
+
+  return A;
+}
+
+/// Compute y = A x for a local matrix
+void spmv(la::MatrixCSR<double>& A, la::Vector<double>& x,
+          la::Vector<double>& y)
+{
+  y.set(0.0);
+  A.mult(x, y);
+}
+
+void test_jacobi()
+{
+  la::MatrixCSR<double> A = create_tridiagonal<1>(10, {2.0}, -1.0);
+  la::Vector<double> r(A.index_map(0), 1), z(A.index_map(0), 1);
+  for (std::size_t i = 0; i < r.array().size(); ++i)
+    r.mutable_array()[i] = std::sin(double(i));
+
+  la::JacobiPreconditioner P(A);
+  P(r, z);
+  for (std::size_t i = 0; i < r.array().size(); ++i)
+    CHECK(z.array()[i] == Catch::Approx(r.array()[i] / 2.0));
+}
+
+void test_block_jacobi()
+{
+  // Block diagonal matrix, for which block Jacobi is exact
+  la::MatrixCSR<double> A
+      = create_tridiagonal<2>(6, {4.0, 1.0, 2.0, 3.0}, 0.0);
+  la::Vector<double> x(A.index_map(0), 2), b(A.index_map(0), 2),
+      z(A.index_map(0), 2);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    x.mutable_array()[i] = std::cos(double(i));
+  spmv(A, x, b);
+
+  la::BlockJacobiPreconditioner P(A);
+  P(b, z);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    CHECK(z.array()[i] == Catch::Approx(x.array()[i]));
+
+  // Point Jacobi uses only the scalar diagonal
+  la::JacobiPreconditioner J(A);
+  J(b, z);
+  CHECK(z.array()[0] == Catch::Approx(b.array()[0] / 4.0));
+  CHECK(z.array()[1] == Catch::Approx(b.array()[1] / 3.0));
+}
+
+void test_ilu0()
+{
+  // ILU(0) of a tridiagonal matrix has no fill-in and is an exact LU
+  // factorization
+  la::MatrixCSR<double> A = create_tridiagonal<1>(20, {2.0}, -1.0);
+  la::Vector<double> x(A.index_map(0), 1), b(A.index_map(0), 1),
+      z(A.index_map(0), 1);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    x.mutable_array()[i] = std::sin(double(i));
+  spmv(A, x, b);
+
+  la::ILU0Preconditioner P(A);
+  P(b, z);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    CHECK(z.array()[i] == Catch::Approx(x.array()[i]).margin(1e-12));
+
+  // Blocked matrices are not supported
+  la::MatrixCSR<double> A2
+      = create_tridiagonal<2>(4, {4.0, 1.0, 2.0, 3.0}, -1.0);
+  CHECK_THROWS(la::ILU0Preconditioner<la::MatrixCSR<double>>{A2});
+}
+
+void test_sparse_lu()
+{
+  // Convection-diffusion (five-point stencil) on an m x m grid. The
+  // factors have fill-in.
+  constexpr std::int32_t m = 12;
+  constexpr std::int32_t n = m * m;
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_SELF, n);
+  la::SparsityPattern sp(MPI_COMM_SELF, {map, map}, {1, 1});
+  auto neighbours = [](std::int32_t i)
+  {
+    std::vector<std::int32_t> nbs = {i};
+    const std::int32_t r = i / m, c = i % m;
+    if (r > 0)
+      nbs.push_back(i - m);
+    if (r < m - 1)
+      nbs.push_back(i + m);
+    if (c > 0)
+      nbs.push_back(i - 1);
+    if (c < m - 1)
+      nbs.push_back(i + 1);
+    return nbs;
+  };
+  for (std::int32_t i = 0; i < n; ++i)
+  {
+    std::array<std::int32_t, 1> r{i};
+    sp.insert(r, neighbours(i));
+  }
+  sp.finalize();
+
+  la::MatrixCSR<double> A(sp);
+  auto set_values = [&](double c)
+  {
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      std::array<std::int32_t, 1> r{i};
+      for (std::int32_t j : neighbours(i))
+      {
+        std::array<std::int32_t, 1> col{j};
+        std::array<double, 1> v{i == j ? 4.0 + c : (j > i ? -1.0 + c : -1.0)};
+        A.set<1, 1>(v, r, col);
+      }
+    }
+  };
+  set_values(0.0);
+
+  la::Vector<double> x(map, 1), b(map, 1), z(map, 1);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    x.mutable_array()[i] = std::sin(double(i));
+  spmv(A, x, b);
+
+  la::SparseLU lu(A);
+  CHECK(lu.num_factor_entries() > A.cols().size());
+  lu(b, z);
+  for (std::size_t i = 0; i < x.array().size(); ++i)
+    CHECK(z.array()[i] == Catch::Approx(x.array()[i]).margin(1e-12));
+
+  // New values with the same sparsity, and several right-hand sides
+  set_values(0.3);
+  lu.factorize(A);
+  la::MultiVector<double> X(map, 1, 3), B(map, 1, 3), Z(map, 1, 3);
+  for (std::size_t i = 0; i < X.array().size(); ++i)
+    X.mutable_array()[i] = std::cos(double(i));
+  B.set(0.0);
+  A.mult(X, B);
+  lu(B, Z);
+  for (std::size_t i = 0; i < X.array().size(); ++i)
+    CHECK(Z.array()[i] == Catch::Approx(X.array()[i]));
+}
+} // namespace
+
+TEST_CASE("Jacobi preconditioner", "[preconditioner]") { test_jacobi(); }
+
+TEST_CASE("Sparse LU", "[preconditioner]") { test_sparse_lu(); }
+
+TEST_CASE("Block Jacobi preconditioner", "[preconditioner]")
+{
+  test_block_jacobi();
+}
+
+TEST_CASE("ILU(0) preconditioner", "[preconditioner]") { test_ilu0(); }
@@ -7,12 +7,22 @@
 // Unit tests for Distributed la::Vector
 
 #include <algorithm>
+#include <cmath>
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <complex>
+#include <cstdint>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/MPI.h>
+#include <dolfinx/common/NumaAllocator.h>
+#include <dolfinx/la/ScatterGroup.h>
 #include <dolfinx/la/Vector.h>
+#include <dolfinx/la/VectorHistory.h>
+#include <filesystem>
+#include <functional>
+#include <numeric>
 
 using namespace dolfinx;
 
@@ -55,10 +65,595 @@ void test_vector()
   CHECK(la::norm(v, la::Norm::linf) == static_cast<T>(mpi_size - 1));
 }
 
+template <typename T>
+void test_vector_fused()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+  auto index_map
+      = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local);
+
+  la::Vector<T> u(index_map, 1), v(index_map, 1), w(index_map, 1);
+  std::ranges::fill(u.mutable_array(), 1.0);
+  std::ranges::fill(v.mutable_array(), mpi_rank);
+
+  // w = 2u + v
+  la::axpy(w, T(2), u, v);
+  CHECK(std::ranges::all_of(w.array(),
+                            [&](auto x) { return x == T(2 + mpi_rank); }));
+
+  // Inner products with one reduction
+  std::vector<T> dots = la::inner_products<la::Vector<T>>({u, v, u}, {u, v, w});
+  T sum_rank = size_local * mpi_size * (mpi_size - 1) / 2;
+  CHECK(dots.size() == 3);
+  CHECK(dots[0] == la::inner_product(u, u));
+  CHECK(dots[1] == la::inner_product(v, v));
+  CHECK(dots[2] == T(2 * size_local * mpi_size) + sum_rank);
+
+  // w = 3u - 2v, in place
+  la::axpby(w, T(3), u, T(-2), v);
+  CHECK(std::ranges::all_of(w.array(),
+                            [&](auto x) { return x == T(3 - 2 * mpi_rank); }));
+
+  // w <- w + u + 2v - w = u + 2v, in one pass
+  std::vector<T> alpha = {T(1), T(2), T(-1)};
+  la::Vector<T> w0(w);
+  la::maxpy<la::Vector<T>>(w, alpha, {u, v, w0});
+  CHECK(std::ranges::all_of(w.array(),
+                            [&](auto x) { return x == T(1 + 2 * mpi_rank); }));
+
+  // w -= u, and (w, w)
+  auto wnorm = la::axpy_squared_norm(w, T(-1), u);
+  CHECK(std::ranges::all_of(w.array(),
+                            [&](auto x) { return x == T(2 * mpi_rank); }));
+  CHECK(wnorm == Catch::Approx(la::squared_norm(w)));
+
+  // Orthonormalize vectors that are close to linearly dependent
+  std::vector<la::Vector<T>> basis(3, la::Vector<T>(index_map, 1));
+  for (std::size_t i = 0; i < basis.size(); ++i)
+  {
+    std::span<T> x = basis[i].mutable_array();
+    for (std::size_t j = 0; j < x.size(); ++j)
+      x[j] = 1.0 + 1e-4 * std::sin(double((i + 1) * (j + mpi_rank)));
+  }
+  la::orthonormalize(
+      std::vector<std::reference_wrapper<la::Vector<T>>>(basis.begin(),
+                                                          basis.end()));
+  CHECK(la::is_orthonormal(
+      std::vector<std::reference_wrapper<const la::Vector<T>>>(basis.begin(),
+                                                                basis.end()),
+      1e-12));
+}
+
+template <typename T>
+void test_vector_scatter(common::Scatterer<>::type type)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+
+  // Create some ghost entries on next process
+  int num_ghosts = (mpi_size - 1) * 3;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+
+  const std::vector<int> global_ghost_owner(ghosts.size(),
+                                            (mpi_rank + 1) % mpi_size);
+
+  // Create an IndexMap
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, global_ghost_owner);
+
+  la::Vector<T> v(index_map, 2, type);
+  std::span<T> x = v.mutable_array();
+  const T owner = (mpi_rank + 1) % mpi_size;
+
+  // Repeat to check that communication can be restarted
+  for (int k = 0; k < 3; ++k)
+  {
+    std::ranges::fill(x.first(2 * size_local), mpi_rank + k);
+    std::ranges::fill(x.subspan(2 * size_local), -1);
+    v.scatter_fwd();
+    CHECK(std::ranges::all_of(x.subspan(2 * size_local),
+                              [&](auto g) { return g == owner + T(k); }));
+
+    std::ranges::fill(x.first(2 * size_local), 0);
+    std::ranges::fill(x.subspan(2 * size_local), 1);
+    v.scatter_rev(std::plus<T>());
+    CHECK(std::reduce(x.begin(), std::next(x.begin(), 2 * size_local), T(0))
+          == T(2 * num_ghosts));
+  }
+
+  // Copied vector creates its own requests
+  la::Vector<T> w(v);
+  std::ranges::fill(w.mutable_array(), 0);
+  std::ranges::fill(w.mutable_array().first(2 * size_local), mpi_rank);
+  w.scatter_fwd();
+  CHECK(std::ranges::all_of(w.array().subspan(2 * size_local),
+                            [&](auto g) { return g == owner; }));
+}
+
+void test_scatter_runs()
+{
+  std::vector<std::int32_t> idx = {3, 4, 5, 9, 10, 2};
+  CHECK(common::impl::contiguous_runs(idx)
+        == std::vector<std::int32_t>{0, 3, 5, 6});
+  CHECK(common::impl::contiguous_runs({})
+        == std::vector<std::int32_t>{0});
+
+  std::vector<double> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<std::int32_t> runs = common::impl::contiguous_runs(idx);
+  std::vector<double> out(idx.size());
+  common::impl::pack_runs<double>(in, idx, runs, out);
+  CHECK(out == std::vector<double>{3, 4, 5, 9, 10, 2});
+  common::impl::unpack_runs<double>(out, idx, runs, in, std::plus<double>());
+  CHECK(in[4] == 8.0);
+  CHECK(in[2] == 4.0);
+  CHECK(in[0] == 0.0);
+
+  // The ghosts of each rank are consecutive indices owned by the next
+  // rank, and are packed and unpacked as one run
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    const int owner = (mpi_rank + 1) % mpi_size;
+    for (int i = 0; i < 8; ++i)
+    {
+      ghosts.push_back(owner * size_local + 10 + i);
+      owners.push_back(owner);
+    }
+  }
+  common::IndexMap map(MPI_COMM_WORLD, size_local, ghosts, owners);
+  common::Scatterer<> scatterer(map, 2);
+  if (mpi_size > 1)
+  {
+    CHECK(scatterer.remote_runs().size() == 2);
+    CHECK(scatterer.local_runs().size() == 2);
+  }
+
+  la::Vector<double> v(std::make_shared<common::IndexMap>(
+                           MPI_COMM_WORLD, size_local, ghosts, owners),
+                       2);
+  std::span<double> x = v.mutable_array();
+  const std::int64_t offset = 2 * size_local * mpi_rank;
+  for (std::size_t i = 0; i < 2 * size_local; ++i)
+    x[i] = offset + i;
+  std::ranges::fill(x.subspan(2 * size_local), -1);
+  v.scatter_fwd();
+  for (std::size_t i = 0; i < ghosts.size(); ++i)
+  {
+    CHECK(x[2 * (size_local + i)] == 2 * ghosts[i]);
+    CHECK(x[2 * (size_local + i) + 1] == 2 * ghosts[i] + 1);
+  }
+
+  v.scatter_rev(std::plus<double>());
+  for (std::size_t i = 10; i < 18; ++i)
+    CHECK(x[2 * i] == (mpi_size > 1 ? 2 : 1) * (offset + 2 * i));
+}
+
+template <typename T>
+void test_vector_scatter_group(common::Scatterer<>::type type)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 50;
+
+  // Ghost entries on the next two processes
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  for (int r : {1, 2})
+  {
+    if (const int owner = (mpi_rank + r) % mpi_size; owner != mpi_rank)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        ghosts.push_back(owner * size_local + 3 * i + r);
+        owners.push_back(owner);
+      }
+    }
+  }
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  // Vectors with different block sizes, and copies that are updated
+  // separately
+  la::Vector<T> u(map, 1), w(map, 3);
+  for (auto x : {u.mutable_array(), w.mutable_array()})
+    for (std::size_t i = 0; i < x.size(); ++i)
+      x[i] = mpi_rank + 0.5 * i;
+  la::Vector<T> u0(u), w0(w);
+  la::ScatterGroup<la::Vector<T>> group({u, w}, type);
+  CHECK(group.size() == 2);
+
+  group.scatter_fwd();
+  u0.scatter_fwd();
+  w0.scatter_fwd();
+  CHECK(std::ranges::equal(u.array(), u0.array()));
+  CHECK(std::ranges::equal(w.array(), w0.array()));
+
+  group.scatter_rev(std::plus<T>());
+  u0.scatter_rev(std::plus<T>());
+  w0.scatter_rev(std::plus<T>());
+  CHECK(std::ranges::equal(u.array(), u0.array()));
+  CHECK(std::ranges::equal(w.array(), w0.array()));
+}
+
+template <typename T>
+void test_vector_numa_allocator()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+
+  // Arrays below and above the size for first-touch placement
+  for (std::int32_t size_local : {100, 300000})
+  {
+    std::vector<std::int64_t> ghosts;
+    std::vector<int> owners;
+    if (mpi_size > 1)
+    {
+      const int owner = (mpi_rank + 1) % mpi_size;
+      ghosts = {owner * size_local, owner * size_local + 7};
+      owners = {owner, owner};
+    }
+    auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                  ghosts, owners);
+
+    la::Vector<T, common::numa_vector<T>> x(map, 1);
+    CHECK(reinterpret_cast<std::uintptr_t>(x.array().data()) % 64 == 0);
+    CHECK(std::ranges::all_of(x.array(), [](auto v) { return v == T(0); }));
+    x.set(1);
+    std::ranges::fill(x.mutable_array().subspan(size_local), 0);
+    x.scatter_fwd();
+    CHECK(std::ranges::all_of(x.array(), [](auto v) { return v == T(1); }));
+    CHECK(la::inner_product(x, x) == T(map->size_global()));
+  }
+}
+
+template <typename T>
+void test_vector_scatter_statistics()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+
+  // Ghost entries owned by the next process
+  int num_ghosts = (mpi_size - 1) * 3;
+  std::vector<std::int64_t> ghosts(num_ghosts);
+  for (int i = 0; i < num_ghosts; ++i)
+    ghosts[i] = (mpi_rank + 1) % mpi_size * size_local + i;
+  const std::vector<int> owners(ghosts.size(), (mpi_rank + 1) % mpi_size);
+  auto index_map = std::make_shared<common::IndexMap>(
+      MPI_COMM_WORLD, size_local, ghosts, owners);
+
+  la::Vector<T> v(index_map, 2);
+  CHECK(!v.scatter_statistics());
+  v.enable_scatter_statistics(true);
+  v.scatter_fwd();
+  v.scatter_rev(std::plus<T>());
+
+  const common::ScatterStatistics& stats = *v.scatter_statistics();
+  const int num_neighbors = mpi_size > 1 ? 1 : 0;
+  CHECK(stats.num_scatters == 2);
+  CHECK(stats.num_messages == 2 * num_neighbors);
+  CHECK(stats.num_neighbors == num_neighbors);
+  CHECK(stats.num_bytes
+        == static_cast<std::int64_t>(2 * 2 * num_ghosts * sizeof(T)));
+  CHECK(stats.wait_time >= 0);
+
+  // A copy records its own statistics
+  la::Vector<T> w(v);
+  REQUIRE(w.scatter_statistics());
+  CHECK(w.scatter_statistics()->num_scatters == 0);
+
+  v.enable_scatter_statistics(false);
+  CHECK(!v.scatter_statistics());
+}
+
+template <typename T>
+void test_vector_history()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 1000;
+  constexpr int bs = 3;
+
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    ghosts = {((mpi_rank + 1) % mpi_size) * size_local};
+    owners = {(mpi_rank + 1) % mpi_size};
+  }
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  constexpr std::size_t num_snapshots = 5;
+  la::VectorHistory<T> history(
+      map, bs, num_snapshots,
+      std::filesystem::temp_directory_path() / "dolfinx_vector_history");
+  CHECK(history.capacity() == num_snapshots);
+
+  la::Vector<T> v(map, bs);
+  for (std::size_t i = 0; i < num_snapshots; ++i)
+  {
+    auto x = v.mutable_array();
+    for (std::size_t j = 0; j < x.size(); ++j)
+      x[j] = static_cast<T>(i * x.size() + j);
+    history.store(i, v);
+    history.release(i);
+  }
+
+  for (std::size_t i = num_snapshots; i-- > 0;)
+  {
+    if (i > 0)
+      history.prefetch(i - 1);
+    v.set(-1);
+    history.load(i, v);
+    auto x = v.array();
+    for (std::size_t j = 0; j < std::size_t(bs * size_local); ++j)
+      CHECK(x[j] == static_cast<T>(i * x.size() + j));
+    CHECK(history.snapshot(i).size() == std::size_t(bs * size_local));
+  }
+
+  CHECK_THROWS(history.snapshot(num_snapshots));
+  la::Vector<T> w(map, 1);
+  CHECK_THROWS(history.store(0, w));
+}
+
+// Vector with the scatter indices in a custom allocator
+template <typename T>
+using numa_index_vector
+    = la::Vector<T, std::vector<T>, common::NumaAllocator<std::int32_t>>;
+
+template <typename T>
+void test_vector_scatter_kernels(
+    typename numa_index_vector<T>::scatterer_type::type type)
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+  constexpr int bs = 2;
+
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    const int owner = (mpi_rank + 1) % mpi_size;
+    ghosts = {owner * size_local, owner * size_local + 3};
+    owners = {owner, owner};
+  }
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  // Kernels that stand in for device kernels
+  int num_calls = 0;
+  auto pack = [&num_calls](auto in, auto idx, auto out)
+  {
+    ++num_calls;
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[i] = in[idx[i]];
+  };
+  auto unpack = [&num_calls](auto in, auto idx, auto out)
+  {
+    ++num_calls;
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[idx[i]] = in[i];
+  };
+  auto unpack_op = [&num_calls](auto in, auto idx, auto out, auto op)
+  {
+    ++num_calls;
+    for (std::size_t i = 0; i < idx.size(); ++i)
+      out[idx[i]] = op(out[idx[i]], in[i]);
+  };
+
+  numa_index_vector<T> x(map, bs, type), y(map, bs, type);
+  for (auto v : {x.mutable_array(), y.mutable_array()})
+  {
+    for (std::size_t i = 0; i < v.size(); ++i)
+      v[i] = i < bs * size_local ? T(bs * map->local_range()[0] + i) : T(0);
+  }
+
+  x.scatter_fwd_begin(pack);
+  x.scatter_fwd_end(unpack);
+  y.scatter_fwd();
+  CHECK(num_calls == 2);
+  CHECK(std::ranges::equal(x.array(), y.array()));
+
+  x.scatter_rev_begin(pack);
+  x.scatter_rev_end(unpack_op, std::plus<T>());
+  y.scatter_rev(std::plus<T>());
+  CHECK(num_calls == 4);
+  CHECK(std::ranges::equal(x.array(), y.array()));
+}
+
+template <typename T>
+void test_vector_scatter_sparse()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 100;
+  constexpr int bs = 2;
+
+  // Ghost every fourth index of the next rank
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    const int owner = (mpi_rank + 1) % mpi_size;
+    for (int i = 0; i < size_local; i += 4)
+    {
+      ghosts.push_back(owner * size_local + i);
+      owners.push_back(owner);
+    }
+  }
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  la::Vector<T> x(map, bs);
+  x.set(-1);
+  x.scatter_fwd();
+
+  // Change the values of a small subset of the owned blocks
+  std::vector<std::int8_t> marker(size_local, 0);
+  auto x_array = x.mutable_array();
+  for (int i = 0; i < size_local; i += 20)
+  {
+    marker[i] = 1;
+    for (int k = 0; k < bs; ++k)
+      x_array[i * bs + k] = static_cast<T>(i * bs + k);
+  }
+
+  for (double threshold : {0.0, 1.0})
+  {
+    la::Vector<T> y(x);
+    y.enable_scatter_statistics(true);
+    y.scatter_fwd_sparse(marker, threshold);
+
+    // Only ghosts of marked blocks have been updated
+    la::Vector<T> z(x);
+    z.scatter_fwd();
+    auto y_ghosts = y.array().subspan(bs * size_local);
+    auto z_ghosts = z.array().subspan(bs * size_local);
+    for (std::size_t i = 0; i < ghosts.size(); ++i)
+    {
+      for (int k = 0; k < bs; ++k)
+      {
+        if (ghosts[i] % 20 == 0)
+          CHECK(y_ghosts[i * bs + k] == z_ghosts[i * bs + k]);
+        else
+          CHECK(y_ghosts[i * bs + k] == T(-1));
+      }
+    }
+
+    // The sparse scatter sends fewer values than the dense scatter
+    REQUIRE(y.scatter_statistics());
+    const std::int64_t num_bytes = y.scatter_statistics()->num_bytes;
+    if (mpi_size > 1 and threshold > 0)
+      CHECK(num_bytes == std::int64_t(5 * bs * sizeof(T)));
+    else
+      CHECK(num_bytes == std::int64_t(ghosts.size() * bs * sizeof(T)));
+  }
+}
+
+template <typename T, typename U>
+void test_vector_scatter_group_precision()
+{
+  const int mpi_size = dolfinx::MPI::size(MPI_COMM_WORLD);
+  const int mpi_rank = dolfinx::MPI::rank(MPI_COMM_WORLD);
+  constexpr int size_local = 50;
+
+  std::vector<std::int64_t> ghosts;
+  std::vector<int> owners;
+  if (mpi_size > 1)
+  {
+    const int owner = (mpi_rank + 1) % mpi_size;
+    ghosts = {owner * size_local + 1, owner * size_local + 4};
+    owners = {owner, owner};
+  }
+  auto map = std::make_shared<common::IndexMap>(MPI_COMM_WORLD, size_local,
+                                                ghosts, owners);
+
+  // Values that are not representable in the communication type
+  la::Vector<T> x(map, 2);
+  auto x_array = x.mutable_array();
+  for (std::size_t i = 0; i < x_array.size(); ++i)
+    x_array[i] = T(mpi_rank + 0.1 * i);
+  la::Vector<T> x0(x);
+
+  la::ScatterGroup<la::Vector<T>, U> group({x});
+  group.scatter_fwd();
+  x0.scatter_fwd();
+  // Owned values are unchanged, ghost values are rounded
+  const std::size_t size_owned = 2 * size_local;
+  for (std::size_t i = 0; i < x_array.size(); ++i)
+  {
+    if (i < size_owned)
+      CHECK(x.array()[i] == x0.array()[i]);
+    else
+      CHECK(x.array()[i] == T(U(x0.array()[i])));
+  }
+
+  // Reverse scatter of values that are exact in the communication type
+  std::ranges::fill(x.mutable_array(), T(1));
+  group.scatter_rev(std::plus<T>());
+  std::ranges::fill(x0.mutable_array(), T(1));
+  x0.scatter_rev(std::plus<T>());
+  CHECK(std::ranges::equal(x.array(), x0.array()));
+}
+
 } // namespace
 
 TEMPLATE_TEST_CASE("Linear Algebra Vector", "[la_vector]", double,
                    std::complex<double>)
 {
   CHECK_NOTHROW(test_vector<TestType>());
+  CHECK_NOTHROW(test_vector_fused<TestType>());
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector scatter", "[la_vector]", double,
+                   std::complex<double>)
+{
+  using type = common::Scatterer<>::type;
+  auto scatter_type = GENERATE(type::neighbor, type::p2p, type::persistent,
+                               type::shared);
+  CHECK_NOTHROW(test_vector_scatter<TestType>(scatter_type));
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector scatter kernels", "[la_vector]",
+                   double, std::complex<double>)
+{
+  using type = numa_index_vector<TestType>::scatterer_type::type;
+  auto scatter_type = GENERATE(type::neighbor, type::p2p, type::persistent,
+                               type::shared);
+  CHECK_NOTHROW(test_vector_scatter_kernels<TestType>(scatter_type));
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector sparse scatter", "[la_vector]",
+                   double, std::complex<float>)
+{
+  test_vector_scatter_sparse<TestType>();
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector scatter group", "[la_vector]",
+                   double, std::complex<double>)
+{
+  using type = common::Scatterer<>::type;
+  auto scatter_type = GENERATE(type::neighbor, type::p2p);
+  CHECK_NOTHROW(test_vector_scatter_group<TestType>(scatter_type));
+}
+
+TEST_CASE("Scatter index runs", "[la_vector]")
+{
+  CHECK_NOTHROW(test_scatter_runs());
+}
+
+TEST_CASE("Linear Algebra Vector scatter group precision", "[la_vector]")
+{
+  test_vector_scatter_group_precision<double, float>();
+  test_vector_scatter_group_precision<std::complex<double>,
+                                      std::complex<float>>();
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector NUMA allocator", "[la_vector]",
+                   double, std::complex<float>)
+{
+  test_vector_numa_allocator<TestType>();
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector scatter statistics", "[la_vector]",
+                   double, float)
+{
+  test_vector_scatter_statistics<TestType>();
+}
+
+TEMPLATE_TEST_CASE("Linear Algebra Vector history", "[la_vector]", double,
+                   std::complex<float>)
+{
+  test_vector_history<TestType>();
 }
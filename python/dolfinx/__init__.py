@@ -42,6 +42,7 @@ from dolfinx.common import (
     has_petsc4py,
     has_ptscotch,
     has_slepc,
+    has_zlib,
     ufcx_signature,
 )
 from dolfinx.cpp import __version__
@@ -85,5 +86,6 @@ __all__ = [
     "has_petsc4py",
     "has_ptscotch",
     "has_slepc",
+    "has_zlib",
     "ufcx_signature",
 ]
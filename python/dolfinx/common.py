@@ -7,6 +7,7 @@
 
 import datetime
 import functools
+import json
 import typing
 
 from dolfinx import cpp as _cpp
@@ -22,12 +23,16 @@ from dolfinx.cpp.common import (
     has_petsc4py,
     has_ptscotch,
     has_slepc,
+    has_zlib,
     ufcx_signature,
 )
 
 __all__ = [
     "IndexMap",
     "Timer",
+    "enable_hardware_counters",
+    "enable_load_metrics",
+    "end_load_step",
     "git_commit_hash",
     "has_adios2",
     "has_complex_ufcx_kernels",
@@ -38,6 +43,12 @@ __all__ = [
     "has_petsc4py",
     "has_ptscotch",
     "has_slepc",
+    "has_zlib",
+    "load_imbalance",
+    "load_step_times",
+    "num_threads",
+    "reset_load_metrics",
+    "set_num_threads",
     "timed",
     "ufcx_signature",
 ]
@@ -59,6 +70,95 @@ def timing(task: str) -> tuple[int, datetime.timedelta]:
     return _cpp.common.timing(task)
 
 
+def enable_hardware_counters(enable: bool) -> bool:
+    """Enable or disable recording of hardware performance counters by timers.
+
+    When enabled, the change in the hardware counters (cycles,
+    instructions, last-level cache references and misses, and branch
+    misses) of each timed task is added to the timing table. The
+    counters are read using the Linux ``perf_event`` interface.
+
+    Arguments:
+        enable: Record counters if ``True``.
+
+    Returns:
+        ``True`` if the counters are available, otherwise ``False``.
+    """
+    return _cpp.common.enable_hardware_counters(enable)
+
+
+def enable_load_metrics(enable: bool):
+    """Enable or disable recording of load metrics.
+
+    When enabled, the time each process spends in assembly, element
+    kernels, waiting for ghost scatters and in the Krylov/eigenvalue
+    solvers is accumulated for the current step. Use
+    :func:`end_load_step` to close a step and :func:`load_imbalance` to
+    report the imbalance across processes.
+
+    Arguments:
+        enable: Record phase times if ``True``.
+    """
+    _cpp.common.enable_load_metrics(enable)
+
+
+def end_load_step():
+    """Close the current step of the load metrics and start a new one."""
+    _cpp.common.end_load_step()
+
+
+def reset_load_metrics():
+    """Clear the recorded steps of the load metrics."""
+    _cpp.common.reset_load_metrics()
+
+
+def load_step_times() -> list[list[float]]:
+    """Phase times of the completed steps on the calling process.
+
+    The times of a step are for the phases assembly, kernel, scatter
+    wait and solver, and can be used as measured weights for
+    repartitioning.
+    """
+    return [list(t) for t in _cpp.common.load_step_times()]
+
+
+def load_imbalance(comm) -> dict[str, dict[str, float]]:
+    """Maximum and average over processes of the phase times of each step.
+
+    Collective. The result has a member for each step (``"step <i>"``)
+    and ``"total"``, with the maximum (``"<phase> max"``), average
+    (``"<phase> avg"``) and ratio (``"<phase> max/avg"``) of each phase.
+
+    Arguments:
+        comm: MPI communicator.
+
+    Returns:
+        Load imbalance on rank 0, and an empty dictionary on other ranks.
+    """
+    table = _cpp.common.load_imbalance(comm)
+    return json.loads(table) if table else {}
+
+
+def set_num_threads(num_threads: int):
+    """Set the maximum number of threads used on this process.
+
+    Threaded operations, e.g. the computation of mesh entities, execute
+    their tasks on a process thread pool with at most ``num_threads``
+    threads. When running several MPI processes per node, the product
+    of the processes and threads per node should not exceed the number
+    of cores.
+
+    Arguments:
+        num_threads: Number of threads, including the calling thread.
+    """
+    _cpp.common.set_num_threads(num_threads)
+
+
+def num_threads() -> int:
+    """Maximum number of threads used on this process."""
+    return _cpp.common.num_threads()
+
+
 def list_timings(comm, reduction=Reduction.max):
     """Print out a summary of all Timer measurements.
 
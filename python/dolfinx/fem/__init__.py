@@ -13,7 +13,9 @@ from dolfinx.cpp.fem import compute_integration_domains as _compute_integration_
 from dolfinx.cpp.fem import create_interpolation_data as _create_interpolation_data
 from dolfinx.cpp.fem import create_sparsity_pattern as _create_sparsity_pattern
 from dolfinx.cpp.fem import discrete_gradient as _discrete_gradient
+from dolfinx.cpp.fem import inject as _inject
 from dolfinx.cpp.fem import interpolation_matrix as _interpolation_matrix
+from dolfinx.cpp.fem import prolong as _prolong
 from dolfinx.cpp.mesh import Topology
 from dolfinx.fem.assemble import (
     apply_lifting,
@@ -126,6 +128,39 @@ def interpolation_matrix(space0: FunctionSpace, space1: FunctionSpace) -> _Matri
     return _MatrixCSR(_interpolation_matrix(space0._cpp_object, space1._cpp_object))
 
 
+def prolong(u1: Function, u0: Function, parent_cells: npt.NDArray[np.int32], num_threads: int = 1):
+    """Prolong a Function to a refinement of its mesh.
+
+    The interpolation points of each fine cell are evaluated directly in
+    the parent cell, so no point search is required.
+
+    Args:
+        u1: Function on the refined mesh to interpolate into.
+        u0: Function on the coarse mesh.
+        parent_cells: Parent cell (local index in the coarse mesh) of
+            each cell of the refined mesh, as returned by
+            :func:`dolfinx.mesh.refine` with ``parent_cell`` option.
+        num_threads: Number of threads.
+    """
+    _prolong(u1._cpp_object, u0._cpp_object, parent_cells, num_threads)
+
+
+def inject(u0: Function, u1: Function, parent_cells: npt.NDArray[np.int32], num_threads: int = 1):
+    """Restrict a Function on a refinement of a mesh to the mesh by interpolation.
+
+    Each interpolation point of a coarse cell is evaluated in the child
+    cell that contains it, so no point search is required.
+
+    Args:
+        u0: Function on the coarse mesh to interpolate into.
+        u1: Function on the refined mesh.
+        parent_cells: Parent cell (local index in the coarse mesh) of
+            each cell of the refined mesh.
+        num_threads: Number of threads.
+    """
+    _inject(u0._cpp_object, u1._cpp_object, parent_cells, num_threads)
+
+
 def compute_integration_domains(
     integral_type: IntegralType, topology: Topology, entities: np.ndarray
 ):
@@ -192,8 +227,10 @@ __all__ = [
     "form",
     "form_cpp_class",
     "functionspace",
+    "inject",
     "locate_dofs_geometrical",
     "locate_dofs_topological",
+    "prolong",
     "set_bc",
     "transpose_dofmap",
 ]
@@ -38,6 +38,7 @@ def pack_constants(
 
     Args:
         form: A single form or array of forms to pack the constants for.
+        num_threads: Number of threads used to pack each coefficient.
 
     Returns:
         A `constant` array for each form.
@@ -54,7 +55,7 @@ def pack_constants(
     return _pack(form)
 
 
-def pack_coefficients(form: typing.Union[Form, typing.Sequence[Form]]):
+def pack_coefficients(form: typing.Union[Form, typing.Sequence[Form]], num_threads: int = 1):
     """Compute form coefficients.
 
     Pack the `coefficients` that appear in forms. The packed
@@ -67,6 +68,7 @@ def pack_coefficients(form: typing.Union[Form, typing.Sequence[Form]]):
 
     Args:
         form: A single form or array of forms to pack the constants for.
+        num_threads: Number of threads used to pack each coefficient.
 
     Returns:
         Coefficients for each form.
@@ -79,7 +81,7 @@ def pack_coefficients(form: typing.Union[Form, typing.Sequence[Form]]):
         elif isinstance(form, collections.abc.Iterable):
             return list(map(lambda sub_form: _pack(sub_form), form))
         else:
-            return _pack_coefficients(form)
+            return _pack_coefficients(form, num_threads)
 
     return _pack(form)
 
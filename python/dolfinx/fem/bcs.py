@@ -25,6 +25,7 @@ from dolfinx import cpp as _cpp
 def locate_dofs_geometrical(
     V: typing.Union[dolfinx.fem.FunctionSpace, typing.Iterable[dolfinx.fem.FunctionSpace]],
     marker: typing.Callable,
+    cells: typing.Optional[npt.NDArray[np.int32]] = None,
 ) -> np.ndarray:
     """Locate degrees-of-freedom geometrically using a marker function.
 
@@ -35,6 +36,10 @@ def locate_dofs_geometrical(
             shape ``(gdim, num_points)`` and returns an array of
             booleans of length ``num_points``, evaluating to ``True``
             for entities whose degree-of-freedom should be returned.
+        cells: Candidate cells, e.g. from a bounding box collision
+            query. If given, only the degrees-of-freedom of these cells
+            are passed to ``marker``. Supported for a single function
+            space only.
 
     Returns:
         An array of degree-of-freedom indices (local to the process) for
@@ -47,6 +52,9 @@ def locate_dofs_geometrical(
         Returned degree-of-freedom indices are unique and ordered by the
         first column.
     """
+    if cells is not None:
+        _cells = np.asarray(cells, dtype=np.int32)
+        return _cpp.fem.locate_dofs_geometrical(V._cpp_object, marker, _cells)  # type: ignore
     try:
         return _cpp.fem.locate_dofs_geometrical(V._cpp_object, marker)  # type: ignore
     except AttributeError:
@@ -59,6 +67,7 @@ def locate_dofs_topological(
     entity_dim: int,
     entities: npt.NDArray[np.int32],
     remote: bool = True,
+    num_threads: int = 1,
 ) -> np.ndarray:
     """Locate degrees-of-freedom belonging to mesh entities topologically.
 
@@ -71,6 +80,8 @@ def locate_dofs_topological(
             where degrees-of-freedom are located.
         remote: True to return also "remotely located" degree-of-freedom
             indices.
+        num_threads: Number of threads used to collect the
+            degrees-of-freedom of the entities.
 
     Returns:
         An array of degree-of-freedom indices (local to the process) for
@@ -84,10 +95,12 @@ def locate_dofs_topological(
     """
     _entities = np.asarray(entities, dtype=np.int32)
     try:
-        return _cpp.fem.locate_dofs_topological(V._cpp_object, entity_dim, _entities, remote)  # type: ignore
+        return _cpp.fem.locate_dofs_topological(
+            V._cpp_object, entity_dim, _entities, remote, num_threads  # type: ignore
+        )
     except AttributeError:
         _V = [space._cpp_object for space in V]
-        return _cpp.fem.locate_dofs_topological(_V, entity_dim, _entities, remote)
+        return _cpp.fem.locate_dofs_topological(_V, entity_dim, _entities, remote, num_threads)
 
 
 class DirichletBC:
@@ -174,6 +187,18 @@ class DirichletBC:
         """
         return self._cpp_object.dof_indices()
 
+    def cells(self) -> npt.NDArray[np.int32]:
+        """Cells (local indices, including ghosts) that have at least
+        one degree-of-freedom constrained by the boundary condition.
+
+        Note:
+            The returned array is read-only.
+
+        Returns:
+            Sorted array of cell indices.
+        """
+        return self._cpp_object.cells()
+
 
 def dirichletbc(
     value: typing.Union[Function, Constant, np.ndarray],
@@ -147,12 +147,21 @@ def get_integration_domains(
             # Compute integration domains only for each subdomain id in
             # the integrals. If a process has no integral entities,
             # insert an empty array.
+            # The integration entities of int32 tags are shared by all
+            # forms through the integration domain cache.
             for id in subdomain_ids:
-                integration_entities = _cpp.fem.compute_integration_domains(
-                    integral_type,
-                    subdomain._cpp_object.topology,  # type: ignore
-                    subdomain.find(id),  # type: ignore
-                )
+                if isinstance(subdomain._cpp_object, _cpp.mesh.MeshTags_int32):  # type: ignore
+                    integration_entities = _cpp.fem.compute_integration_domains_cached(
+                        integral_type,
+                        subdomain._cpp_object,  # type: ignore
+                        id,
+                    )
+                else:
+                    integration_entities = _cpp.fem.compute_integration_domains(
+                        integral_type,
+                        subdomain._cpp_object.topology,  # type: ignore
+                        subdomain.find(id),  # type: ignore
+                    )
                 domains.append((id, integration_entities))
             return [(s[0], np.array(s[1])) for s in domains]
         except AttributeError:
@@ -197,6 +197,7 @@ class Expression:
         mesh: Mesh,
         entities: np.ndarray,
         values: typing.Optional[np.ndarray] = None,
+        num_threads: int = 1,
     ) -> np.ndarray:
         """Evaluate Expression on entities.
 
@@ -209,6 +210,8 @@ class Expression:
                 storage will be allocated. Otherwise must have shape
                 ``(num_entities, num_points * value_size *
                 num_all_argument_dofs)``
+            num_threads: Number of threads used to pack the coefficients
+                and to evaluate the Expression.
 
         Returns:
             Expression evaluated at points for `entities`.
@@ -240,7 +243,7 @@ class Expression:
                 raise TypeError("Passed array values does not have correct shape.")
             if values.dtype != self.dtype:
                 raise TypeError("Passed array values does not have correct dtype.")
-        self._cpp_object.eval(mesh._cpp_object, _entities, values)
+        self._cpp_object.eval(mesh._cpp_object, _entities, values, num_threads)
         return values
 
     def X(self) -> np.ndarray:
@@ -615,17 +618,14 @@ def functionspace(
 
     # Create DOLFINx objects
     cpp_element = _create_dolfinx_element(mesh.topology.cell_type, ufl_e, dtype)
-    cpp_dofmap = _cpp.fem.create_dofmap(mesh.comm, mesh.topology._cpp_object, cpp_element)
 
     assert np.issubdtype(
         mesh.geometry.x.dtype, cpp_element.dtype
     ), "Mesh and element dtype are not compatible."
 
-    # Initialize the cpp.FunctionSpace
-    try:
-        cppV = _cpp.fem.FunctionSpace_float64(mesh._cpp_object, cpp_element, cpp_dofmap)
-    except TypeError:
-        cppV = _cpp.fem.FunctionSpace_float32(mesh._cpp_object, cpp_element, cpp_dofmap)
+    # Initialize the cpp.FunctionSpace. The dofmap is shared with other
+    # spaces with the same element on the mesh.
+    cppV = _cpp.fem.create_functionspace(mesh._cpp_object, cpp_element)
 
     return FunctionSpace(mesh, ufl_e, cppV)
 
@@ -24,10 +24,14 @@ __all__ = [
     "bb_tree",
     "compute_closest_entity",
     "compute_colliding_cells",
+    "compute_colliding_cells_pull_back",
     "compute_collisions_points",
     "compute_collisions_trees",
     "compute_distance_gjk",
+    "compute_nearest_neighbors",
+    "compute_points_in_radius",
     "create_midpoint_tree",
+    "locate_entities",
     "squared_distance",
 ]
 
@@ -98,12 +102,27 @@ class BoundingBoxTree:
     def create_global_tree(self, comm) -> BoundingBoxTree:
         return BoundingBoxTree(self._cpp_object.create_global_tree(comm))
 
+    def refit(self, mesh: Mesh, num_threads: int = 1):
+        """Update the bounding boxes after the mesh geometry has changed.
+
+        The structure of the tree is not changed. The mesh topology must
+        be the same as when the tree was created.
+
+        Args:
+            mesh: The mesh that the tree was created for.
+            num_threads: Number of threads used to compute the bounding
+                boxes of the mesh entities.
+
+        """
+        self._cpp_object.refit(mesh._cpp_object, num_threads)
+
 
 def bb_tree(
     mesh: Mesh,
     dim: int,
     entities: typing.Optional[npt.NDArray[np.int32]] = None,
     padding: float = 0.0,
+    num_threads: int = 1,
 ) -> BoundingBoxTree:
     """Create a bounding box tree for use in collision detection.
 
@@ -113,6 +132,7 @@ def bb_tree(
         entities: List of entity indices (local to process). If not
             supplied, all owned and ghosted entities are used.
         padding: Padding for each bounding box.
+        num_threads: Number of threads used to build the tree.
 
     Returns:
         Bounding box tree.
@@ -125,11 +145,15 @@ def bb_tree(
     dtype = mesh.geometry.x.dtype
     if np.issubdtype(dtype, np.float32):
         return BoundingBoxTree(
-            _cpp.geometry.BoundingBoxTree_float32(mesh._cpp_object, dim, entities, padding)
+            _cpp.geometry.BoundingBoxTree_float32(
+                mesh._cpp_object, dim, entities, padding, num_threads
+            )
         )
     elif np.issubdtype(dtype, np.float64):
         return BoundingBoxTree(
-            _cpp.geometry.BoundingBoxTree_float64(mesh._cpp_object, dim, entities, padding)
+            _cpp.geometry.BoundingBoxTree_float64(
+                mesh._cpp_object, dim, entities, padding, num_threads
+            )
         )
     else:
         raise NotImplementedError(f"Type {dtype} not supported.")
@@ -152,6 +176,46 @@ def compute_collisions_trees(
     return _cpp.geometry.compute_collisions_trees(tree0._cpp_object, tree1._cpp_object)
 
 
+def locate_entities(
+    tree: BoundingBoxTree,
+    msh: Mesh,
+    dim: int,
+    box: npt.ArrayLike,
+    marker: typing.Callable,
+    boundary: bool = False,
+) -> npt.NDArray[np.int32]:
+    """Compute mesh entities in a box that satisfy a geometric marking
+    function.
+
+    Computes the same entities as :func:`dolfinx.mesh.locate_entities`
+    (or :func:`dolfinx.mesh.locate_entities_boundary` if ``boundary`` is
+    ``True``), but the marker is evaluated only at the vertices of cells
+    that collide with ``box``. A tree can be re-used to efficiently
+    locate many small regions of a mesh.
+
+    Args:
+        tree: Bounding box tree for the cells of ``msh``.
+        msh: Mesh to locate entities on.
+        dim: Topological dimension of the mesh entities to consider.
+        box: Box containing all marked points, with shape ``(2, 3)``
+            (lower and upper corners). The marker must evaluate to
+            ``False`` outside of the box.
+        marker: A function that takes an array of points ``x`` with
+            shape ``(3, num_points)`` and returns an array of
+            booleans of length ``num_points``, evaluating to ``True`` for
+            entities to be located.
+        boundary: If ``True``, only entities attached to an owned
+            boundary facet are located.
+
+    Returns:
+        Sorted indices (local to the process) of marked mesh entities.
+    """
+    box = np.asarray(box, dtype=msh.geometry.x.dtype).reshape(2, 3)
+    return _cpp.geometry.locate_entities(
+        tree._cpp_object, msh._cpp_object, dim, box, marker, boundary
+    )
+
+
 def compute_collisions_points(tree: BoundingBoxTree, x: npt.NDArray[np.floating]) -> AdjacencyList:
     """Compute collisions between points and leaf bounding boxes.
 
@@ -210,6 +274,52 @@ def create_midpoint_tree(mesh: Mesh, dim: int, entities: npt.NDArray[np.int32])
     return BoundingBoxTree(_cpp.geometry.create_midpoint_tree(mesh._cpp_object, dim, entities))
 
 
+def compute_nearest_neighbors(
+    tree: BoundingBoxTree, x: npt.NDArray[np.floating], k: int, num_threads: int = 1
+) -> AdjacencyList:
+    """Compute the ``k`` nearest neighbours of points in a tree of points.
+
+    Points of the tree at the same distance are ordered by their index.
+
+    Args:
+        tree: Bounding box tree of points, e.g. created by
+            :func:`create_midpoint_tree`.
+        x: Points (``shape=(num_points, 3)``).
+        k: Number of neighbours to find for each point.
+        num_threads: Number of threads used for the search.
+
+    Returns:
+        For each point, the indices of the ``min(k, num_tree_points)``
+        nearest tree points, sorted by distance.
+
+    """
+    return AdjacencyList(
+        _cpp.geometry.compute_nearest_neighbors(tree._cpp_object, x, k, num_threads)
+    )
+
+
+def compute_points_in_radius(
+    tree: BoundingBoxTree, x: npt.NDArray[np.floating], radius: float, num_threads: int = 1
+) -> AdjacencyList:
+    """Compute the points of a tree within a distance of points.
+
+    Args:
+        tree: Bounding box tree of points, e.g. created by
+            :func:`create_midpoint_tree`.
+        x: Points (``shape=(num_points, 3)``).
+        radius: Search radius.
+        num_threads: Number of threads used for the search.
+
+    Returns:
+        For each point, the sorted indices of the tree points with
+        distance less than or equal to ``radius`` from the point.
+
+    """
+    return AdjacencyList(
+        _cpp.geometry.compute_points_in_radius(tree._cpp_object, x, radius, num_threads)
+    )
+
+
 def compute_colliding_cells(
     mesh: Mesh, candidates: AdjacencyList, x: npt.NDArray[np.floating]
 ) -> AdjacencyList:
@@ -231,6 +341,30 @@ def compute_colliding_cells(
     )
 
 
+def compute_colliding_cells_pull_back(
+    mesh: Mesh, candidates: AdjacencyList, x: npt.NDArray[np.floating]
+) -> tuple[AdjacencyList, npt.NDArray[np.floating]]:
+    """Find which cells collide with points, and the reference coordinates of the points.
+
+    Args:
+        mesh: The mesh.
+        candidates: Adjacency list of candidate colliding cells for the
+            ith point in ``x``.
+        x: The points to check for collision ``shape=(num_points, 3)``.
+
+    Returns:
+        Adjacency list where the ith node is the list of cells that
+        collide with the ith point, and the reference coordinates of
+        the point in each colliding cell ``shape=(num_collisions, tdim)``,
+        in the order of the cells in the adjacency list.
+
+    """
+    cells, X = _cpp.geometry.compute_colliding_cells_pull_back(
+        mesh._cpp_object, candidates._cpp_object, x
+    )
+    return AdjacencyList(cells), X
+
+
 def squared_distance(
     mesh: Mesh, dim: int, entities: npt.NDArray[np.int32], points: npt.NDArray[np.floating]
 ) -> npt.NDArray[np.floating]:
@@ -13,7 +13,7 @@ import numpy as np
 import numpy.typing as npt
 
 from dolfinx import cpp as _cpp
-from dolfinx.cpp.graph import partitioner
+from dolfinx.cpp.graph import partitioner, partitioner_diffusion
 
 # Import graph partitioners, which may or may not be available
 # (dependent on build configuration)
@@ -22,7 +22,7 @@ try:
 except ImportError:
     pass
 try:
-    from dolfinx.cpp.graph import partitioner_parmetis  # noqa
+    from dolfinx.cpp.graph import partitioner_parmetis, partitioner_parmetis_adaptive  # noqa
 except ImportError:
     pass
 try:
@@ -31,7 +31,7 @@ except ImportError:
     pass
 
 
-__all__ = ["AdjacencyList", "adjacencylist", "partitioner"]
+__all__ = ["AdjacencyList", "adjacencylist", "partitioner", "partitioner_diffusion"]
 
 
 class AdjacencyList:
@@ -7,9 +7,28 @@
 
 from dolfinx import cpp as _cpp
 from dolfinx.io import gmshio
-from dolfinx.io.utils import VTKFile, XDMFFile, distribute_entity_data
+from dolfinx.io.utils import (
+    DatasetOptions,
+    VTKFile,
+    XDMFFile,
+    distribute_entity_data,
+    read_function_checkpoint,
+    read_mesh_snapshot,
+    write_function_checkpoint,
+    write_mesh_snapshot,
+)
 
-__all__ = ["VTKFile", "XDMFFile", "distribute_entity_data", "gmshio"]
+__all__ = [
+    "DatasetOptions",
+    "VTKFile",
+    "XDMFFile",
+    "distribute_entity_data",
+    "gmshio",
+    "read_function_checkpoint",
+    "read_mesh_snapshot",
+    "write_function_checkpoint",
+    "write_mesh_snapshot",
+]
 
 if _cpp.common.has_adios2:
     # VTXWriter requires ADIOS2
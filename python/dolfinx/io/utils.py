@@ -18,12 +18,24 @@ import basix
 import basix.ufl
 import ufl
 from dolfinx import cpp as _cpp
+from dolfinx.cpp.io import DatasetOptions
 from dolfinx.cpp.io import perm_gmsh as cell_perm_gmsh
 from dolfinx.cpp.io import perm_vtk as cell_perm_vtk
 from dolfinx.fem import Function
 from dolfinx.mesh import Geometry, GhostMode, Mesh, MeshTags
 
-__all__ = ["VTKFile", "XDMFFile", "cell_perm_gmsh", "cell_perm_vtk", "distribute_entity_data"]
+__all__ = [
+    "DatasetOptions",
+    "VTKFile",
+    "XDMFFile",
+    "cell_perm_gmsh",
+    "cell_perm_vtk",
+    "distribute_entity_data",
+    "read_function_checkpoint",
+    "read_mesh_snapshot",
+    "write_function_checkpoint",
+    "write_mesh_snapshot",
+]
 
 
 def _extract_cpp_objects(functions: typing.Union[Mesh, Function, tuple[Function], list[Function]]):
@@ -146,9 +158,21 @@ class XDMFFile(_cpp.io.XDMFFile):
     def __exit__(self, exception_type, exception_value, traceback):
         self.close()
 
-    def write_mesh(self, mesh: Mesh, xpath: str = "/Xdmf/Domain") -> None:
-        """Write mesh to file"""
-        super().write_mesh(mesh._cpp_object, xpath)
+    def write_mesh(
+        self,
+        mesh: Mesh,
+        xpath: str = "/Xdmf/Domain",
+        options: typing.Optional[DatasetOptions] = None,
+    ) -> None:
+        """Write mesh to file.
+
+        Args:
+            mesh: Mesh to write to file.
+            xpath: XPath where the mesh Grid will be written.
+            options: HDF5 chunking and compression options.
+        """
+        options = DatasetOptions() if options is None else options
+        super().write_mesh(mesh._cpp_object, xpath, options)
 
     def write_meshtags(
         self,
@@ -161,7 +185,11 @@ class XDMFFile(_cpp.io.XDMFFile):
         super().write_meshtags(tags._cpp_object, x._cpp_object, geometry_xpath, xpath)
 
     def write_function(
-        self, u: Function, t: float = 0.0, mesh_xpath="/Xdmf/Domain/Grid[@GridType='Uniform'][1]"
+        self,
+        u: Function,
+        t: float = 0.0,
+        mesh_xpath="/Xdmf/Domain/Grid[@GridType='Uniform'][1]",
+        options: typing.Optional[DatasetOptions] = None,
     ):
         """Write function to file for a given time.
 
@@ -176,8 +204,10 @@ class XDMFFile(_cpp.io.XDMFFile):
             t: Time associated with Function output.
             mesh_xpath: Path to mesh associated with the Function in the
                 XDMFFile.
+            options: HDF5 chunking and compression options.
         """
-        super().write_function(getattr(u, "_cpp_object", u), t, mesh_xpath)
+        options = DatasetOptions() if options is None else options
+        super().write_function(getattr(u, "_cpp_object", u), t, mesh_xpath, options)
 
     def read_mesh(
         self, ghost_mode=GhostMode.shared_facet, name="mesh", xpath="/Xdmf/Domain"
@@ -255,3 +285,89 @@ def distribute_entity_data(
         entities,
         values,
     )
+
+
+def write_function_checkpoint(
+    filename: typing.Union[str, Path], u: Function, name: str, mode: str = "w"
+) -> None:
+    """Write a Function to a HDF5 checkpoint file.
+
+    The degree-of-freedom values are stored without interpolation and
+    ordered by the original cell index, so the Function can be read
+    back on any number of processes with
+    :func:`read_function_checkpoint`.
+
+    Args:
+        filename: Name of the HDF5 file.
+        u: Function to write.
+        name: Name of the checkpoint in the file.
+        mode: ``"w"`` to create a new file, ``"a"`` to add to an
+            existing file.
+    """
+    _cpp.io.write_function_checkpoint(filename, u._cpp_object, name, mode)
+
+
+def read_function_checkpoint(filename: typing.Union[str, Path], u: Function, name: str) -> None:
+    """Read a Function from a HDF5 checkpoint file.
+
+    Args:
+        filename: Name of the HDF5 file.
+        u: Function to read into. Its mesh must have been created from
+            the same input mesh as the mesh of the written Function,
+            and it must use the same element.
+        name: Name of the checkpoint in the file.
+    """
+    _cpp.io.read_function_checkpoint(filename, u._cpp_object, name)
+
+
+def write_mesh_snapshot(filename: typing.Union[str, Path], mesh: Mesh) -> None:
+    """Write a binary snapshot of a mesh.
+
+    Each process writes the file ``filename.<rank>``, which holds the
+    complete local data of the mesh, including the index maps, the
+    created connectivities and the entity permutations. Entities and
+    permutations that are needed after a restart should be created
+    before the snapshot is written.
+
+    Args:
+        filename: Name of the snapshot.
+        mesh: Mesh to write.
+    """
+    _cpp.io.write_mesh_snapshot(filename, mesh._cpp_object)
+
+
+def read_mesh_snapshot(
+    comm: _MPI.Comm, filename: typing.Union[str, Path], dtype: npt.DTypeLike = np.float64
+) -> Mesh:
+    """Read a mesh from a binary snapshot.
+
+    The snapshot must have been written with :func:`write_mesh_snapshot`
+    on the same number of processes. The mesh is restored without
+    recomputing the topology, index maps or permutations.
+
+    Args:
+        comm: MPI communicator to create the mesh on.
+        filename: Name of the snapshot.
+        dtype: Geometry value type of the written mesh.
+
+    Returns:
+        The mesh.
+    """
+    if np.dtype(dtype) == np.float32:
+        msh = _cpp.io.read_mesh_snapshot_float32(comm, filename)
+    elif np.dtype(dtype) == np.float64:
+        msh = _cpp.io.read_mesh_snapshot_float64(comm, filename)
+    else:
+        raise RuntimeError(f"Unsupported mesh geometry float type: {dtype}")
+
+    domain = ufl.Mesh(
+        basix.ufl.element(
+            "Lagrange",
+            _cpp.mesh.to_string(msh.topology.cell_type),
+            msh.geometry.cmap.degree,
+            basix.LagrangeVariant(msh.geometry.cmap.variant),
+            shape=(msh.geometry.dim,),
+            dtype=dtype,
+        )
+    )
+    return Mesh(msh, domain)
@@ -27,6 +27,7 @@ from dolfinx.cpp.mesh import (
     build_dual_graph,
     cell_dim,
     create_cell_partitioner,
+    create_stored_cell_partitioner,
     to_string,
     to_type,
 )
@@ -52,6 +53,7 @@ __all__ = [
     "create_interval",
     "create_mesh",
     "create_rectangle",
+    "create_stored_cell_partitioner",
     "create_submesh",
     "create_unit_cube",
     "create_unit_interval",
@@ -66,6 +68,7 @@ __all__ = [
     "to_string",
     "to_type",
     "transfer_meshtag",
+    "transfer_meshtags",
 ]
 
 
@@ -117,6 +120,34 @@ class Topology:
         """
         self._cpp_object.create_connectivity(d0, d1)
 
+    def connectivity_memory(self, d0: int, d1: int) -> int:
+        """Memory (bytes) used by the connectivity ``d0 -> d1``.
+
+        Args:
+            d0: Dimension of entities one is mapping from
+            d1: Dimension of entities one is mapping to
+        """
+        return self._cpp_object.connectivity_memory(d0, d1)
+
+    def evict_connectivity(self, d0: int, d1: int):
+        """Release the cached connectivity ``d0 -> d1``. It is recomputed
+        by the next call to :meth:`create_connectivity`.
+
+        Args:
+            d0: Dimension of entities one is mapping from
+            d1: Dimension of entities one is mapping to
+        """
+        self._cpp_object.evict_connectivity(d0, d1)
+
+    @property
+    def connectivity_memory_budget(self) -> int:
+        """Memory budget (bytes) for cached connectivities."""
+        return self._cpp_object.connectivity_memory_budget
+
+    @connectivity_memory_budget.setter
+    def connectivity_memory_budget(self, bytes: int):
+        self._cpp_object.connectivity_memory_budget = bytes
+
     def create_entities(self, dim: int) -> int:
         """Create entities of given topological dimension.
 
@@ -132,6 +163,11 @@ class Topology:
         """Compute entity permutations and reflections."""
         self._cpp_object.create_entity_permutations()
 
+    def create_facet_permutations(self):
+        """Compute facet permutations only, creating the facets but no other
+        entities."""
+        self._cpp_object.create_facet_permutations()
+
     @property
     def dim(self) -> int:
         """Return the topological dimension of the mesh."""
@@ -188,6 +224,21 @@ class Topology:
         """List of inter-process facets, if facet topology has been computed."""
         return self._cpp_object.interprocess_facets()
 
+    def cell_ranges(self, index: int = 0) -> list[int]:
+        """Offsets of the ranges of interior, process boundary and ghost cells.
+
+        Owned cells in ``[r[0], r[1])`` do not share a vertex with another
+        process, owned cells in ``[r[1], r[2])`` may share entities with
+        other processes and cells in ``[r[2], r[3])`` are ghosts.
+
+        Args:
+            index: Index of the cell type.
+
+        Returns:
+            Offsets ``r`` of the cell ranges.
+        """
+        return self._cpp_object.cell_ranges(index)
+
     @property
     def original_cell_index(self) -> npt.NDArray[np.int64]:
         """Get the original cell index"""
@@ -533,11 +584,43 @@ def transfer_meshtag(
         raise RuntimeError("MeshTag transfer is supported on on cells or facets.")
 
 
+def transfer_meshtags(
+    meshtags: list[MeshTags],
+    msh1: Mesh,
+    parent_cell: npt.NDArray[np.int32],
+    parent_facet: typing.Optional[npt.NDArray[np.int8]] = None,
+) -> list[MeshTags]:
+    """Generate mesh tags on a refined mesh from several cell and facet mesh tags on the parent.
+
+    The parent entities of the refined mesh are computed once and
+    shared by all mesh tags.
+
+    Args:
+        meshtags: Cell and facet mesh tags on the coarse, parent mesh.
+        msh1: The refined mesh.
+        parent_cell: Index of the parent cell for each cell in the
+            refined mesh.
+        parent_facet: Index of the local parent facet for each cell
+            in the refined mesh. Only required for transfer of tags on
+            facets.
+
+    Returns:
+        Mesh tags on the refined mesh.
+    """
+    if parent_facet is None:
+        parent_facet = np.empty(0, dtype=np.int8)
+    mts = _cpp.refinement.transfer_meshtags(
+        [mt._cpp_object for mt in meshtags], msh1.topology._cpp_object, parent_cell, parent_facet
+    )
+    return [MeshTags(mt) for mt in mts]
+
+
 def refine(
     msh: Mesh,
     edges: typing.Optional[np.ndarray] = None,
     partitioner: typing.Optional[typing.Callable] = create_cell_partitioner(GhostMode.none),
     option: RefinementOption = RefinementOption.none,
+    num_threads: int = 1,
 ) -> tuple[Mesh, npt.NDArray[np.int32], npt.NDArray[np.int8]]:
     """Refine a mesh.
 
@@ -565,12 +648,14 @@ def refine(
             remain on the same process as the parent cell.
         option: Controls whether parent cells and/or parent facets are
             computed.
+        num_threads: Number of threads used to subdivide the cells of
+            triangle and tetrahedral meshes.
 
     Returns:
        Refined mesh, (optional) parent cells, (optional) parent facets
     """
     mesh1, parent_cell, parent_facet = _cpp.refinement.refine(
-        msh._cpp_object, edges, partitioner, option
+        msh._cpp_object, edges, partitioner, option, num_threads
     )
     # Create new ufl domain as it will carry a reference to the C++ mesh
     # in the ufl_cargo
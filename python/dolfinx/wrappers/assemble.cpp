@@ -17,10 +17,8 @@
 #include <dolfinx/fem/FunctionSpace.h>
 #include <dolfinx/fem/assembler.h>
 #include <dolfinx/fem/discreteoperators.h>
-#include <dolfinx/fem/sparsitybuild.h>
 #include <dolfinx/fem/utils.h>
 #include <dolfinx/la/MatrixCSR.h>
-#include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <functional>
 #include <memory>
@@ -45,115 +43,35 @@ namespace nb = nanobind;
 namespace
 {
 
-template <typename U>
-dolfinx::la::SparsityPattern
-create_sparsity(const dolfinx::fem::FunctionSpace<U>& V0,
-                const dolfinx::fem::FunctionSpace<U>& V1)
-{
-  assert(V0.mesh());
-  auto mesh = V0.mesh();
-  assert(V1.mesh());
-  assert(mesh == V1.mesh());
-  MPI_Comm comm = mesh->comm();
-
-  auto dofmap0 = V0.dofmap();
-  assert(dofmap0);
-  auto dofmap1 = V1.dofmap();
-  assert(dofmap1);
-
-  // Create and build  sparsity pattern
-  assert(dofmap0->index_map);
-  assert(dofmap1->index_map);
-  dolfinx::la::SparsityPattern sp(
-      comm, {dofmap1->index_map, dofmap0->index_map},
-      {dofmap1->index_map_bs(), dofmap0->index_map_bs()});
-
-  int tdim = mesh->topology()->dim();
-  auto map = mesh->topology()->index_map(tdim);
-  assert(map);
-  std::vector<std::int32_t> c(map->size_local(), 0);
-  std::iota(c.begin(), c.end(), 0);
-  dolfinx::fem::sparsitybuild::cells(sp, {c, c}, {*dofmap1, *dofmap0});
-  sp.finalize();
-
-  return sp;
-}
-
 // Declare assembler function that have multiple scalar types
 template <typename T, typename U>
 void declare_discrete_operators(nb::module_& m)
 {
-  m.def("interpolation_matrix",
-        [](const dolfinx::fem::FunctionSpace<U>& V0,
-           const dolfinx::fem::FunctionSpace<U>& V1)
-        {
-          // Create sparsity
-          dolfinx::la::SparsityPattern sp = create_sparsity(V0, V1);
-
-          // Build operator
-          dolfinx::la::MatrixCSR<T> A(sp);
-
-          auto [bs0, bs1] = A.block_size();
-          if (bs0 == 1 and bs1 == 1)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 1>());
-          }
-          else if (bs0 == 2 and bs1 == 1)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<2, 1>());
-          }
-          else if (bs0 == 1 and bs1 == 2)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 2>());
-          }
-          else if (bs0 == 2 and bs1 == 2)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<2, 2>());
-          }
-          else if (bs0 == 3 and bs1 == 1)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<3, 1>());
-          }
-          else if (bs0 == 1 and bs1 == 3)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<1, 3>());
-          }
-          else if (bs0 == 3 and bs1 == 3)
-          {
-            dolfinx::fem::interpolation_matrix<T, U>(
-                V0, V1, A.template mat_set_values<3, 3>());
-          }
-          else
-          {
-            throw std::runtime_error(
-                "Interpolation matrix not supported between block sizes "
-                + std::to_string(bs0) + " and " + std::to_string(bs1));
-          }
-
-          return A;
-        });
+  m.def(
+      "interpolation_matrix",
+      [](const dolfinx::fem::FunctionSpace<U>& V0,
+         const dolfinx::fem::FunctionSpace<U>& V1)
+      { return dolfinx::fem::create_interpolation_matrix<T, U>(V0, V1); },
+      nb::arg("V0"), nb::arg("V1"));
 
   m.def(
       "discrete_gradient",
       [](const dolfinx::fem::FunctionSpace<U>& V0,
          const dolfinx::fem::FunctionSpace<U>& V1)
-      {
-        dolfinx::la::SparsityPattern sp = create_sparsity(V0, V1);
+      { return dolfinx::fem::create_discrete_gradient<T, U>(V0, V1); },
+      nb::arg("V0"), nb::arg("V1"));
 
-        // Build operator
-        dolfinx::la::MatrixCSR<T> A(sp);
-        dolfinx::fem::discrete_gradient<T, U>(
-            *V0.mesh()->topology_mutable(), {*V0.element(), *V0.dofmap()},
-            {*V1.element(), *V1.dofmap()}, A.mat_set_values());
-        return A;
+  m.def(
+      "prolongation_matrix",
+      [](const dolfinx::fem::FunctionSpace<U>& V0,
+         const dolfinx::fem::FunctionSpace<U>& V1,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
+             parent_cells)
+      {
+        return dolfinx::fem::create_prolongation_matrix<T, U>(
+            V0, V1, std::span(parent_cells.data(), parent_cells.size()));
       },
-      nb::arg("V0"), nb::arg("V1"));
+      nb::arg("V0"), nb::arg("V1"), nb::arg("parent_cells"));
 }
 
 // Declare assembler function that have multiple scalar types
@@ -163,14 +81,14 @@ void declare_assembly_functions(nb::module_& m)
   // Coefficient/constant packing
   m.def(
       "pack_coefficients",
-      [](const dolfinx::fem::Form<T, U>& form)
+      [](const dolfinx::fem::Form<T, U>& form, int num_threads)
       {
         using Key_t = typename std::pair<dolfinx::fem::IntegralType, int>;
 
         // Pack coefficients
         std::map<Key_t, std::pair<std::vector<T>, int>> coeffs
             = dolfinx::fem::allocate_coefficient_storage(form);
-        dolfinx::fem::pack_coefficients(form, coeffs);
+        dolfinx::fem::pack_coefficients(form, coeffs, num_threads);
 
         // Move into NumPy data structures
         std::map<Key_t, nb::ndarray<T, nb::numpy>> c;
@@ -192,7 +110,8 @@ void declare_assembly_functions(nb::module_& m)
 
         return c;
       },
-      nb::arg("form"), "Pack coefficients for a Form.");
+      nb::arg("form"), nb::arg("num_threads") = 1,
+      "Pack coefficients for a Form.");
   m.def(
       "pack_constants",
       [](const dolfinx::fem::Form<T, U>& form)
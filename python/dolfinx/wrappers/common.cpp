@@ -9,10 +9,14 @@
 #include "caster_mpi.h"
 #include <complex>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/Scatterer.h>
 #include <dolfinx/common/Table.h>
+#include <dolfinx/common/ThreadPool.h>
 #include <dolfinx/common/Timer.h>
 #include <dolfinx/common/defines.h>
+#include <dolfinx/common/hardware_counters.h>
+#include <dolfinx/common/load_metrics.h>
 #include <dolfinx/common/log.h>
 #include <dolfinx/common/timing.h>
 #include <dolfinx/common/utils.h>
@@ -61,6 +65,7 @@ void common(nb::module_& m)
   m.attr("has_petsc4py") = has_petsc4py();
   m.attr("has_ptscotch") = dolfinx::has_ptscotch();
   m.attr("has_slepc") = dolfinx::has_slepc();
+  m.attr("has_zlib") = dolfinx::has_zlib();
   m.attr("ufcx_signature") = dolfinx::ufcx_signature();
   m.attr("version") = dolfinx::version();
 
@@ -124,6 +129,19 @@ void common(nb::module_& m)
            &dolfinx::common::IndexMap::index_to_dest_ranks)
       .def("imbalance", &dolfinx::common::IndexMap::imbalance,
            "Imbalance of the current IndexMap.")
+      .def(
+          "statistics",
+          [](const dolfinx::common::IndexMap& self)
+          {
+            dolfinx::common::IndexMapStatistics stats = self.statistics();
+            nb::dict d;
+            d["ghost_ratio"] = stats.ghost_ratio;
+            d["src_histogram"] = stats.src_histogram;
+            d["dest_histogram"] = stats.dest_histogram;
+            return d;
+          },
+          "Ghost ratio (min, max, avg) and histograms of the number of "
+          "source and destination ranks across processes.")
       .def_prop_ro(
           "ghosts",
           [](const dolfinx::common::IndexMap& self)
@@ -187,6 +205,35 @@ void common(nb::module_& m)
 
   m.def("timing", &dolfinx::timing);
   m.def("timings", &dolfinx::timings);
+  m.def("enable_hardware_counters", &dolfinx::common::enable_hardware_counters,
+        nb::arg("enable"),
+        "Enable recording of hardware performance counters by timers.");
+  m.def("enable_load_metrics", &dolfinx::common::enable_load_metrics,
+        nb::arg("enable"),
+        "Enable recording of the per-process time in assembly, kernels, "
+        "scatter waits and solvers.");
+  m.def("end_load_step", &dolfinx::common::end_load_step,
+        "Close the current step of the load metrics.");
+  m.def("reset_load_metrics", &dolfinx::common::reset_load_metrics,
+        "Clear the recorded load metrics.");
+  m.def("load_step_times", &dolfinx::common::load_step_times,
+        "Phase times of the completed steps on this process.");
+  m.def(
+      "load_imbalance",
+      [](MPICommWrapper comm)
+      {
+        dolfinx::Table table
+            = dolfinx::common::load_imbalance_table(comm.get());
+        return dolfinx::MPI::rank(comm.get()) == 0 ? table.json()
+                                                   : std::string();
+      },
+      nb::arg("comm"),
+      "Load imbalance table (JSON) on rank 0, empty on other ranks.");
+  m.def("set_num_threads", &dolfinx::common::set_num_threads,
+        nb::arg("num_threads"),
+        "Set the maximum number of threads used on this process.");
+  m.def("num_threads", &dolfinx::common::num_threads,
+        "Maximum number of threads used on this process.");
 
   m.def(
       "list_timings",
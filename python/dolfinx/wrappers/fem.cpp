@@ -20,6 +20,7 @@
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/fem/Function.h>
 #include <dolfinx/fem/FunctionSpace.h>
+#include <dolfinx/fem/IntegrationDomainCache.h>
 #include <dolfinx/fem/dofmapbuilder.h>
 #include <dolfinx/fem/interpolate.h>
 #include <dolfinx/fem/sparsitybuild.h>
@@ -89,6 +90,14 @@ void declare_function_space(nb::module_& m, std::string type)
                return dolfinx_wrappers::as_nbarray(std::move(x),
                                                    {x.size() / 3, 3});
              });
+    m.def(
+        "create_functionspace",
+        [](std::shared_ptr<dolfinx::mesh::Mesh<T>> mesh,
+           std::shared_ptr<const dolfinx::fem::FiniteElement<T>> element)
+        { return dolfinx::fem::create_functionspace<T>(mesh, element); },
+        nb::arg("mesh"), nb::arg("element"),
+        "Create a FunctionSpace. The dofmap is shared with spaces with the "
+        "same element on the same mesh.");
   }
 
   {
@@ -368,6 +377,15 @@ void declare_objects(nb::module_& m, const std::string& type)
                              owned);
           },
           nb::rv_policy::reference_internal)
+      .def(
+          "cells",
+          [](const dolfinx::fem::DirichletBC<T, U>& self)
+          {
+            std::span<const std::int32_t> cells = self.cells();
+            return nb::ndarray<const std::int32_t, nb::numpy>(cells.data(),
+                                                              {cells.size()});
+          },
+          nb::rv_policy::reference_internal)
       .def(
           "set",
           [](const dolfinx::fem::DirichletBC<T, U>& self,
@@ -574,13 +592,14 @@ void declare_objects(nb::module_& m, const std::string& type)
           [](const dolfinx::fem::Expression<T, U>& self,
              const dolfinx::mesh::Mesh<U>& mesh,
              nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells,
-             nb::ndarray<T, nb::ndim<2>, nb::c_contig> values)
+             nb::ndarray<T, nb::ndim<2>, nb::c_contig> values, int num_threads)
           {
             std::span<T> foo(values.data(), values.size());
             self.eval(mesh, std::span(cells.data(), cells.size()), foo,
-                      {values.shape(0), values.shape(1)});
+                      {values.shape(0), values.shape(1)}, num_threads);
           },
-          nb::arg("mesh"), nb::arg("active_cells"), nb::arg("values"))
+          nb::arg("mesh"), nb::arg("active_cells"), nb::arg("values"),
+          nb::arg("num_threads") = 1)
       .def("X",
            [](const dolfinx::fem::Expression<T, U>& self)
            {
@@ -621,6 +640,37 @@ void declare_objects(nb::module_& m, const std::string& type)
       nb::arg("expression"), nb::arg("coefficients"), nb::arg("constants"),
       nb::arg("argument_function_space").none(),
       "Create Expression from a pointer to ufc_form.");
+
+  m.def(
+      "prolong",
+      [](dolfinx::fem::Function<T, U>& u1,
+         const dolfinx::fem::Function<T, U>& u0,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
+             parent_cells,
+         int num_threads)
+      {
+        dolfinx::fem::prolong(
+            u1, u0, std::span(parent_cells.data(), parent_cells.size()),
+            num_threads);
+      },
+      nb::arg("u1"), nb::arg("u0"), nb::arg("parent_cells"),
+      nb::arg("num_threads") = 1,
+      "Prolong a Function to a refinement of its mesh.");
+  m.def(
+      "inject",
+      [](dolfinx::fem::Function<T, U>& u0,
+         const dolfinx::fem::Function<T, U>& u1,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>
+             parent_cells,
+         int num_threads)
+      {
+        dolfinx::fem::inject(
+            u0, u1, std::span(parent_cells.data(), parent_cells.size()),
+            num_threads);
+      },
+      nb::arg("u0"), nb::arg("u1"), nb::arg("parent_cells"),
+      nb::arg("num_threads") = 1,
+      "Restrict a Function on a refinement of a mesh to the mesh.");
 }
 
 template <typename T>
@@ -860,7 +910,7 @@ void declare_form(nb::module_& m, std::string type)
 
   m.def("create_sparsity_pattern",
         &dolfinx::fem ::create_sparsity_pattern<T, U>, nb::arg("a"),
-        "Create a sparsity pattern.");
+        nb::arg("num_threads") = 1, "Create a sparsity pattern.");
 }
 
 template <typename T>
@@ -998,7 +1048,11 @@ void declare_real_functions(nb::module_& m)
       "create_dofmap",
       [](const dolfinx_wrappers::MPICommWrapper comm,
          dolfinx::mesh::Topology& topology,
-         const dolfinx::fem::FiniteElement<T>& element)
+         const dolfinx::fem::FiniteElement<T>& element,
+         std::function<std::vector<int>(
+             const dolfinx::graph::AdjacencyList<std::int32_t>&)>
+             reorder_fn,
+         int num_threads)
       {
         dolfinx::fem::ElementDofLayout layout
             = dolfinx::fem::create_element_dof_layout(element);
@@ -1008,16 +1062,22 @@ void declare_real_functions(nb::module_& m)
         if (element.needs_dof_permutations())
           permute_inv = element.dof_permutation_fn(true, true);
         return dolfinx::fem::create_dofmap(comm.get(), layout, topology,
-                                           permute_inv, nullptr);
+                                           permute_inv, reorder_fn,
+                                           num_threads);
       },
       nb::arg("comm"), nb::arg("topology"), nb::arg("element"),
+      nb::arg("reorder_fn").none() = nb::none(), nb::arg("num_threads") = 1,
       "Create DofMap object from an element.");
   m.def(
       "create_dofmaps",
       [](const dolfinx_wrappers::MPICommWrapper comm,
          dolfinx::mesh::Topology& topology,
          std::vector<std::shared_ptr<const dolfinx::fem::FiniteElement<T>>>
-             elements)
+             elements,
+         std::function<std::vector<int>(
+             const dolfinx::graph::AdjacencyList<std::int32_t>&)>
+             reorder_fn,
+         int num_threads)
       {
         std::vector<dolfinx::fem::ElementDofLayout> layouts;
         int D = topology.dim();
@@ -1029,9 +1089,10 @@ void declare_real_functions(nb::module_& m)
         }
 
         return dolfinx::fem::create_dofmaps(comm.get(), layouts, topology,
-                                            nullptr, nullptr);
+                                            nullptr, reorder_fn, num_threads);
       },
       nb::arg("comm"), nb::arg("topology"), nb::arg("elements"),
+      nb::arg("reorder_fn").none() = nb::none(), nb::arg("num_threads") = 1,
       "Create DofMap objects on a mixed topology mesh from pointers to "
       "FiniteElements.");
 
@@ -1041,7 +1102,7 @@ void declare_real_functions(nb::module_& m)
              std::shared_ptr<const dolfinx::fem::FunctionSpace<T>>>& V,
          int dim,
          nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
-         bool remote)
+         bool remote, int num_threads)
       {
         if (V.size() != 2)
           throw std::runtime_error("Expected two function spaces.");
@@ -1049,26 +1110,28 @@ void declare_real_functions(nb::module_& m)
             = dolfinx::fem::locate_dofs_topological(
                 *V[0].get()->mesh()->topology_mutable(),
                 {*V[0].get()->dofmap(), *V[1].get()->dofmap()}, dim,
-                std::span(entities.data(), entities.size()), remote);
+                std::span(entities.data(), entities.size()), remote,
+                num_threads);
         return std::array<nb::ndarray<std::int32_t, nb::numpy>, 2>(
             {dolfinx_wrappers::as_nbarray(std::move(dofs[0])),
              dolfinx_wrappers::as_nbarray(std::move(dofs[1]))});
       },
       nb::arg("V"), nb::arg("dim"), nb::arg("entities"),
-      nb::arg("remote") = true);
+      nb::arg("remote") = true, nb::arg("num_threads") = 1);
   m.def(
       "locate_dofs_topological",
       [](const dolfinx::fem::FunctionSpace<T>& V, int dim,
          nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> entities,
-         bool remote)
+         bool remote, int num_threads)
       {
         return dolfinx_wrappers::as_nbarray(
             dolfinx::fem::locate_dofs_topological(
                 *V.mesh()->topology_mutable(), *V.dofmap(), dim,
-                std::span(entities.data(), entities.size()), remote));
+                std::span(entities.data(), entities.size()), remote,
+                num_threads));
       },
       nb::arg("V"), nb::arg("dim"), nb::arg("entities"),
-      nb::arg("remote") = true);
+      nb::arg("remote") = true, nb::arg("num_threads") = 1);
   m.def(
       "locate_dofs_geometrical",
       [](const std::vector<
@@ -1116,6 +1179,28 @@ void declare_real_functions(nb::module_& m)
             dolfinx::fem::locate_dofs_geometrical(V, _marker));
       },
       nb::arg("V"), nb::arg("marker"));
+  m.def(
+      "locate_dofs_geometrical",
+      [](const dolfinx::fem::FunctionSpace<T>& V,
+         std::function<nb::ndarray<bool, nb::ndim<1>, nb::c_contig>(
+             nb::ndarray<const T, nb::ndim<2>, nb::numpy>)>
+             marker,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> cells)
+      {
+        auto _marker = [&marker](auto x)
+        {
+          nb::ndarray<const T, nb::ndim<2>, nb::numpy> x_view(
+              x.data_handle(), {x.extent(0), x.extent(1)});
+          auto marked = marker(x_view);
+          return std::vector<std::int8_t>(marked.data(),
+                                          marked.data() + marked.size());
+        };
+
+        return dolfinx_wrappers::as_nbarray(
+            dolfinx::fem::locate_dofs_geometrical(
+                V, _marker, std::span(cells.data(), cells.size())));
+      },
+      nb::arg("V"), nb::arg("marker"), nb::arg("cells"));
 
   m.def(
       "interpolation_coords",
@@ -1204,6 +1289,23 @@ void fem(nb::module_& m)
                 type, topology, std::span(entities.data(), entities.size())));
       },
       nb::arg("integral_type"), nb::arg("topology"), nb::arg("entities"));
+  m.def(
+      "compute_integration_domains_cached",
+      [](dolfinx::fem::IntegralType type,
+         const dolfinx::mesh::MeshTags<std::int32_t>& tags, std::int32_t value)
+      {
+        std::shared_ptr<const std::vector<std::int32_t>> entities
+            = dolfinx::fem::integration_domain_cache().domain(tags, type,
+                                                              value);
+        return dolfinx_wrappers::as_nbarray(std::vector(*entities));
+      },
+      nb::arg("integral_type"), nb::arg("tags"), nb::arg("value"),
+      "Compute the integration entities of the entities with a tag value, "
+      "using the integration domain cache.");
+  m.def(
+      "clear_integration_domain_cache",
+      []() { dolfinx::fem::integration_domain_cache().clear(); },
+      "Remove all entries of the integration domain cache.");
 
   // dolfinx::fem::ElementDofLayout
   nb::class_<dolfinx::fem::ElementDofLayout>(
@@ -12,10 +12,12 @@
 #include <dolfinx/geometry/gjk.h>
 #include <dolfinx/geometry/utils.h>
 #include <dolfinx/mesh/Mesh.h>
+#include <functional>
 #include <memory>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/array.h>
+#include <nanobind/stl/function.h>
 #include <nanobind/stl/optional.h>
 #include <nanobind/stl/tuple.h>
 #include <nanobind/stl/vector.h>
@@ -39,7 +41,7 @@ void declare_bbtree(nb::module_& m, std::string type)
              std::optional<
                  nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig>>
                  entities,
-             double padding)
+             double padding, int num_threads)
           {
             std::optional<std::span<const std::int32_t>> ents
                 = entities ? std::span<const std::int32_t>(
@@ -48,11 +50,11 @@ void declare_bbtree(nb::module_& m, std::string type)
                            : std::optional<std::span<const std::int32_t>>(
                                  std::nullopt);
 
-            new (bbt)
-                dolfinx::geometry::BoundingBoxTree<T>(mesh, dim, ents, padding);
+            new (bbt) dolfinx::geometry::BoundingBoxTree<T>(
+                mesh, dim, ents, padding, num_threads);
           },
           nb::arg("mesh"), nb::arg("dim"), nb::arg("entities").none(),
-          nb::arg("padding") = 0.0)
+          nb::arg("padding") = 0.0, nb::arg("num_threads") = 1)
       .def_prop_ro("num_bboxes",
                    &dolfinx::geometry::BoundingBoxTree<T>::num_bboxes)
       .def(
@@ -66,6 +68,8 @@ void declare_bbtree(nb::module_& m, std::string type)
           },
           nb::arg("i"))
       .def("__repr__", &dolfinx::geometry::BoundingBoxTree<T>::str)
+      .def("refit", &dolfinx::geometry::BoundingBoxTree<T>::refit,
+           nb::arg("mesh"), nb::arg("num_threads") = 1)
       .def(
           "create_global_tree",
           [](const dolfinx::geometry::BoundingBoxTree<T>& self,
@@ -91,6 +95,42 @@ void declare_bbtree(nb::module_& m, std::string type)
             tree, std::span(points.data(), points.size()));
       },
       nb::arg("tree"), nb::arg("points"));
+  m.def(
+      "locate_entities",
+      [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
+         const dolfinx::mesh::Mesh<T>& mesh, int dim,
+         nb::ndarray<const T, nb::shape<2, 3>, nb::c_contig> box,
+         std::function<nb::ndarray<bool, nb::ndim<1>, nb::c_contig>(
+             nb::ndarray<const T, nb::ndim<2>, nb::numpy>)>
+             marker,
+         bool boundary)
+      {
+        auto cpp_marker = [&marker](auto x)
+        {
+          nb::ndarray<const T, nb::ndim<2>, nb::numpy> x_view(
+              x.data_handle(), {x.extent(0), x.extent(1)});
+          auto marked = marker(x_view);
+          return std::vector<std::int8_t>(marked.data(),
+                                          marked.data() + marked.size());
+        };
+
+        std::array<T, 6> b;
+        std::copy_n(box.data(), 6, b.begin());
+        if (boundary)
+        {
+          return dolfinx_wrappers::as_nbarray(
+              dolfinx::geometry::locate_entities_boundary(tree, mesh, dim, b,
+                                                          cpp_marker));
+        }
+        else
+        {
+          return dolfinx_wrappers::as_nbarray(
+              dolfinx::geometry::locate_entities(tree, mesh, dim, b,
+                                                 cpp_marker));
+        }
+      },
+      nb::arg("tree"), nb::arg("mesh"), nb::arg("dim"), nb::arg("box"),
+      nb::arg("marker"), nb::arg("boundary"));
   m.def(
       "compute_collisions_trees",
       [](const dolfinx::geometry::BoundingBoxTree<T>& treeA,
@@ -140,6 +180,29 @@ void declare_bbtree(nb::module_& m, std::string type)
             std::span<const std::int32_t>(entities.data(), entities.size()));
       },
       nb::arg("mesh"), nb::arg("tdim"), nb::arg("entities"));
+  m.def(
+      "compute_nearest_neighbors",
+      [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points, int k,
+         int num_threads)
+      {
+        return dolfinx::geometry::compute_nearest_neighbors<T>(
+            tree, std::span(points.data(), points.size()), k, num_threads);
+      },
+      nb::arg("tree"), nb::arg("points"), nb::arg("k"),
+      nb::arg("num_threads") = 1);
+  m.def(
+      "compute_points_in_radius",
+      [](const dolfinx::geometry::BoundingBoxTree<T>& tree,
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points, T radius,
+         int num_threads)
+      {
+        return dolfinx::geometry::compute_points_in_radius<T>(
+            tree, std::span(points.data(), points.size()), radius,
+            num_threads);
+      },
+      nb::arg("tree"), nb::arg("points"), nb::arg("radius"),
+      nb::arg("num_threads") = 1);
   m.def(
       "compute_colliding_cells",
       [](const dolfinx::mesh::Mesh<T>& mesh,
@@ -160,6 +223,23 @@ void declare_bbtree(nb::module_& m, std::string type)
             mesh, candidate_cells, std::span(points.data(), points.size()));
       },
       nb::arg("mesh"), nb::arg("candidate_cells"), nb::arg("points"));
+  m.def(
+      "compute_colliding_cells_pull_back",
+      [](const dolfinx::mesh::Mesh<T>& mesh,
+         const dolfinx::graph::AdjacencyList<int>& candidate_cells,
+         nb::ndarray<const T, nb::shape<-1, 3>, nb::c_contig> points)
+      {
+        auto [cells, X]
+            = dolfinx::geometry::compute_colliding_cells_pull_back<T>(
+                mesh, candidate_cells,
+                std::span(points.data(), points.size()));
+        const std::size_t tdim = mesh.topology()->dim();
+        const std::size_t num_collisions = cells.array().size();
+        return std::tuple(std::move(cells),
+                          dolfinx_wrappers::as_nbarray(
+                              std::move(X), {num_collisions, tdim}));
+      },
+      nb::arg("mesh"), nb::arg("candidate_cells"), nb::arg("points"));
 
   m.def(
       "compute_distance_gjk",
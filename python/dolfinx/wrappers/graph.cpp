@@ -30,7 +30,7 @@ auto create_partitioner_py(Functor p_cpp)
   return [p_cpp](dolfinx_wrappers::MPICommWrapper comm, int nparts,
                  const dolfinx::graph::AdjacencyList<std::int64_t>& local_graph,
                  bool ghosting)
-  { return p_cpp(comm.get(), nparts, local_graph, ghosting); };
+  { return p_cpp(comm.get(), nparts, local_graph, ghosting, {}); };
 }
 } // namespace
 
@@ -146,6 +146,18 @@ void graph(nb::module_& m)
       nb::arg("imbalance") = 1.02,
       nb::arg("options") = std ::array<int, 3>({1, 0, 5}),
       "ParMETIS graph partitioner");
+  m.def(
+      "partitioner_parmetis_adaptive",
+      [](double itr, double imbalance, std::array<int, 2> options)
+          -> partition_fn
+      {
+        return create_partitioner_py(
+            dolfinx::graph::parmetis::adaptive_partitioner(itr, imbalance,
+                                                           options));
+      },
+      nb::arg("itr") = 1000, nb::arg("imbalance") = 1.02,
+      nb::arg("options") = std ::array<int, 2>({0, 5}),
+      "ParMETIS adaptive graph repartitioner");
 #endif
 #ifdef HAS_KAHIP
   m.def(
@@ -160,6 +172,17 @@ void graph(nb::module_& m)
       nb::arg("suppress_output") = true, "KaHIP graph partitioner");
 #endif
 
+  m.def(
+      "partitioner_diffusion",
+      [](double imbalance, int max_iterations) -> partition_fn
+      {
+        return create_partitioner_py(dolfinx::graph::diffusion::partitioner(
+            imbalance, max_iterations));
+      },
+      nb::arg("imbalance") = 1.02, nb::arg("max_iterations") = 200,
+      "Diffusive graph repartitioner");
+
   m.def("reorder_gps", &dolfinx::graph::reorder_gps, nb::arg("graph"));
+  m.def("reorder_rcm", &dolfinx::graph::reorder_rcm, nb::arg("graph"));
 }
 } // namespace dolfinx_wrappers
@@ -14,6 +14,8 @@
 #include <dolfinx/io/VTKFile.h>
 #include <dolfinx/io/XDMFFile.h>
 #include <dolfinx/io/cells.h>
+#include <dolfinx/io/checkpointing.h>
+#include <dolfinx/io/snapshot.h>
 #include <dolfinx/io/vtk_utils.h>
 #include <dolfinx/io/xdmf_utils.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -49,8 +51,10 @@ void xdmf_real_fn(auto&& m)
   m.def(
       "write_mesh",
       [](dolfinx::io::XDMFFile& self, const dolfinx::mesh::Mesh<T>& mesh,
-         std::string xpath) { self.write_mesh(mesh, xpath); },
-      nb::arg("mesh"), nb::arg("xpath") = "/Xdmf/Domain");
+         std::string xpath, const dolfinx::io::hdf5::DatasetOptions& options)
+      { self.write_mesh(mesh, xpath, options); },
+      nb::arg("mesh"), nb::arg("xpath") = "/Xdmf/Domain",
+      nb::arg("options") = dolfinx::io::hdf5::DatasetOptions());
   m.def(
       "write_meshtags",
       [](dolfinx::io::XDMFFile& self,
@@ -68,10 +72,12 @@ void xdmf_scalar_fn(auto&& m)
   m.def(
       "write_function",
       [](dolfinx::io::XDMFFile& self, const dolfinx::fem::Function<T, U>& u,
-         double t, std::string mesh_xpath)
-      { self.write_function(u, t, mesh_xpath); },
+         double t, std::string mesh_xpath,
+         const dolfinx::io::hdf5::DatasetOptions& options)
+      { self.write_function(u, t, mesh_xpath, options); },
       nb::arg("u"), nb::arg("t"),
-      nb::arg("mesh_xpath") = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]");
+      nb::arg("mesh_xpath") = "/Xdmf/Domain/Grid[@GridType='Uniform'][1]",
+      nb::arg("options") = dolfinx::io::hdf5::DatasetOptions());
 }
 
 template <typename T>
@@ -150,6 +156,33 @@ void declare_vtx_writer(nb::module_& m, std::string type)
 #endif
 }
 
+template <typename T, typename U>
+void declare_checkpointing(nb::module_& m)
+{
+  m.def("write_function_checkpoint",
+        &dolfinx::io::checkpointing::write_function<T, U>,
+        nb::arg("filename"), nb::arg("u"), nb::arg("name"),
+        nb::arg("mode") = "w", "Write a Function to a checkpoint file.");
+  m.def("read_function_checkpoint",
+        &dolfinx::io::checkpointing::read_function<T, U>,
+        nb::arg("filename"), nb::arg("u"), nb::arg("name"),
+        "Read a Function from a checkpoint file.");
+}
+
+template <typename T>
+void declare_snapshot(nb::module_& m, std::string type)
+{
+  m.def("write_mesh_snapshot", &dolfinx::io::snapshot::write<T>,
+        nb::arg("filename"), nb::arg("mesh"),
+        "Write a binary snapshot of a mesh.");
+  m.def(
+      ("read_mesh_snapshot_" + type).c_str(),
+      [](MPICommWrapper comm, const std::filesystem::path& filename)
+      { return dolfinx::io::snapshot::read<T>(comm.get(), filename); },
+      nb::arg("comm"), nb::arg("filename"),
+      "Read a mesh from a binary snapshot.");
+}
+
 template <typename T>
 void declare_data_types(nb::module_& m)
 {
@@ -225,6 +258,23 @@ void io(nb::module_& m)
         nb::arg("num_nodes"),
         "Permutation array to map from Gmsh to DOLFINx node ordering");
 
+  // dolfinx::io::hdf5::DatasetOptions
+  nb::class_<dolfinx::io::hdf5::DatasetOptions>(m, "DatasetOptions")
+      .def(
+          "__init__",
+          [](dolfinx::io::hdf5::DatasetOptions* opts, std::int64_t chunk_size,
+             int compression_level, bool shuffle)
+          {
+            new (opts) dolfinx::io::hdf5::DatasetOptions{
+                chunk_size, compression_level, shuffle};
+          },
+          nb::arg("chunk_size") = 0, nb::arg("compression_level") = 0,
+          nb::arg("shuffle") = true)
+      .def_rw("chunk_size", &dolfinx::io::hdf5::DatasetOptions::chunk_size)
+      .def_rw("compression_level",
+              &dolfinx::io::hdf5::DatasetOptions::compression_level)
+      .def_rw("shuffle", &dolfinx::io::hdf5::DatasetOptions::shuffle);
+
   // dolfinx::io::XDMFFile
   nb::class_<dolfinx::io::XDMFFile> xdmf_file(m, "XDMFFile");
 
@@ -239,13 +289,17 @@ void io(nb::module_& m)
           "__init__",
           [](dolfinx::io::XDMFFile* x, MPICommWrapper comm,
              std::filesystem::path filename, std::string file_mode,
-             dolfinx::io::XDMFFile::Encoding encoding)
+             dolfinx::io::XDMFFile::Encoding encoding,
+             const std::vector<std::pair<std::string, std::string>>&
+                 mpi_io_hints)
           {
             new (x) dolfinx::io::XDMFFile(comm.get(), filename, file_mode,
-                                          encoding);
+                                          encoding, mpi_io_hints);
           },
           nb::arg("comm"), nb::arg("filename"), nb::arg("file_mode"),
-          nb::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5)
+          nb::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5,
+          nb::arg("mpi_io_hints")
+          = std::vector<std::pair<std::string, std::string>>())
       .def("close", &dolfinx::io::XDMFFile::close)
       .def("write_geometry", &dolfinx::io::XDMFFile::write_geometry,
            nb::arg("geometry"), nb::arg("name") = "geometry",
@@ -291,13 +345,33 @@ void io(nb::module_& m)
 
   // dolfinx::io::VTKFile
   nb::class_<dolfinx::io::VTKFile> vtk_file(m, "VTKFile");
+
+  // dolfinx::io::VTKFile::Encoding and Compression enums
+  nb::enum_<dolfinx::io::VTKFile::Encoding>(vtk_file, "Encoding")
+      .value("ascii", dolfinx::io::VTKFile::Encoding::ascii,
+             "Plain text encoding")
+      .value("appended", dolfinx::io::VTKFile::Encoding::appended,
+             "Raw binary appended data");
+  nb::enum_<dolfinx::io::VTKFile::Compression>(vtk_file, "Compression")
+      .value("none", dolfinx::io::VTKFile::Compression::none,
+             "No compression")
+      .value("zlib", dolfinx::io::VTKFile::Compression::zlib,
+             "zlib compression");
+
   vtk_file
       .def(
           "__init__",
           [](dolfinx::io::VTKFile* v, MPICommWrapper comm,
-             std::filesystem::path filename, std::string mode)
-          { new (v) dolfinx::io::VTKFile(comm.get(), filename, mode); },
-          nb::arg("comm"), nb::arg("filename"), nb::arg("mode"))
+             std::filesystem::path filename, std::string mode,
+             dolfinx::io::VTKFile::Encoding encoding,
+             dolfinx::io::VTKFile::Compression compression)
+          {
+            new (v) dolfinx::io::VTKFile(comm.get(), filename, mode, encoding,
+                                         compression);
+          },
+          nb::arg("comm"), nb::arg("filename"), nb::arg("mode"),
+          nb::arg("encoding") = dolfinx::io::VTKFile::Encoding::ascii,
+          nb::arg("compression") = dolfinx::io::VTKFile::Compression::none)
       .def("close", &dolfinx::io::VTKFile::close);
 
   vtk_real_fn<float>(vtk_file);
@@ -316,6 +390,14 @@ void io(nb::module_& m)
   declare_vtx_writer<float>(m, "float32");
   declare_vtx_writer<double>(m, "float64");
 
+  declare_checkpointing<float, float>(m);
+  declare_checkpointing<double, double>(m);
+  declare_checkpointing<std::complex<float>, float>(m);
+  declare_checkpointing<std::complex<double>, double>(m);
+
+  declare_snapshot<float>(m, "float32");
+  declare_snapshot<double>(m, "float64");
+
   declare_data_types<std::int32_t>(m);
   declare_data_types<float>(m);
   declare_data_types<std::complex<float>>(m);
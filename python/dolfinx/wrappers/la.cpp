@@ -255,7 +255,8 @@ void la(nb::module_& m)
       .def("index_map", &dolfinx::la::SparsityPattern::index_map,
            nb::arg("dim"))
       .def("column_index_map", &dolfinx::la::SparsityPattern::column_index_map)
-      .def("finalize", &dolfinx::la::SparsityPattern::finalize)
+      .def("finalize", &dolfinx::la::SparsityPattern::finalize,
+           nb::arg("num_threads") = 1)
       .def_prop_ro("num_nonzeros", &dolfinx::la::SparsityPattern::num_nonzeros)
       .def(
           "insert",
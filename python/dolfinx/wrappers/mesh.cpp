@@ -108,7 +108,9 @@ void declare_meshtags(nb::module_& m, std::string type)
           },
           nb::rv_policy::reference_internal)
       .def("find", [](dolfinx::mesh::MeshTags<T>& self, T value)
-           { return as_nbarray(self.find(value)); });
+           { return as_nbarray(self.find(value)); })
+      .def("create_value_index",
+           &dolfinx::mesh::MeshTags<T>::create_value_index);
 
   m.def("create_meshtags",
         [](std::shared_ptr<const dolfinx::mesh::Topology> topology, int dim,
@@ -558,14 +560,16 @@ void mesh(nb::module_& m)
   m.def(
       "compute_entities",
       [](MPICommWrapper comm, const dolfinx::mesh::Topology& topology, int dim,
-         int index)
+         int index, int num_threads)
       {
         return dolfinx::mesh::compute_entities(comm.get(), topology, dim,
-                                               index);
+                                               index, num_threads);
       },
-      nb::arg("comm"), nb::arg("topology"), nb::arg("dim"), nb::arg("index"));
+      nb::arg("comm"), nb::arg("topology"), nb::arg("dim"), nb::arg("index"),
+      nb::arg("num_threads") = 1);
   m.def("compute_connectivity", &dolfinx::mesh::compute_connectivity,
-        nb::arg("topology"), nb::arg("d0"), nb::arg("d1"));
+        nb::arg("topology"), nb::arg("d0"), nb::arg("d1"),
+        nb::arg("num_threads") = 1);
 
   // dolfinx::mesh::Topology class
   nb::class_<dolfinx::mesh::Topology>(m, "Topology", nb::dynamic_attr(),
@@ -604,11 +608,23 @@ void mesh(nb::module_& m)
                &dolfinx::mesh::Topology::set_index_map),
            nb::arg("dim"), nb::arg("map"))
       .def("create_entities", &dolfinx::mesh::Topology::create_entities,
-           nb::arg("dim"))
+           nb::arg("dim"), nb::arg("num_threads") = 1)
       .def("create_entity_permutations",
-           &dolfinx::mesh::Topology::create_entity_permutations)
+           &dolfinx::mesh::Topology::create_entity_permutations,
+           nb::arg("num_threads") = 1)
+      .def("create_facet_permutations",
+           &dolfinx::mesh::Topology::create_facet_permutations,
+           nb::arg("num_threads") = 1)
       .def("create_connectivity", &dolfinx::mesh::Topology::create_connectivity,
+           nb::arg("d0"), nb::arg("d1"), nb::arg("num_threads") = 1)
+      .def("connectivity_memory", &dolfinx::mesh::Topology::connectivity_memory,
            nb::arg("d0"), nb::arg("d1"))
+      .def("evict_connectivity", &dolfinx::mesh::Topology::evict_connectivity,
+           nb::arg("d0"), nb::arg("d1"))
+      .def_prop_rw("connectivity_memory_budget",
+                   &dolfinx::mesh::Topology::connectivity_memory_budget,
+                   &dolfinx::mesh::Topology::set_connectivity_memory_budget,
+                   "Memory budget (bytes) for cached connectivities")
       .def(
           "get_facet_permutations",
           [](const dolfinx::mesh::Topology& self)
@@ -682,6 +698,8 @@ void mesh(nb::module_& m)
                                                               {facets.size()});
           },
           nb::rv_policy::reference_internal)
+      .def("cell_ranges", &dolfinx::mesh::Topology::cell_ranges,
+           nb::arg("index") = 0)
       .def_prop_ro(
           "comm", [](dolfinx::mesh::Topology& self)
           { return MPICommWrapper(self.comm()); }, nb::keep_alive<0, 1>());
@@ -718,12 +736,14 @@ void mesh(nb::module_& m)
 
   m.def(
       "create_cell_partitioner",
-      [](dolfinx::mesh::GhostMode mode)
+      [](dolfinx::mesh::GhostMode mode, bool hierarchical)
           -> part::impl::PythonCellPartitionFunction
       {
         return part::impl::create_cell_partitioner_py(
-            dolfinx::mesh::create_cell_partitioner(mode));
+            dolfinx::mesh::create_cell_partitioner(
+                mode, &dolfinx::graph::partition_graph, {}, hierarchical));
       },
+      nb::arg("ghost_mode"), nb::arg("hierarchical") = false,
       "Create default cell partitioner.");
   m.def(
       "create_cell_partitioner",
@@ -732,15 +752,32 @@ void mesh(nb::module_& m)
              const dolfinx::graph::AdjacencyList<std::int64_t>& local_graph,
              bool ghosting)>
              part,
-         dolfinx::mesh::GhostMode mode)
+         dolfinx::mesh::GhostMode mode, bool hierarchical)
           -> part::impl::PythonCellPartitionFunction
       {
         return part::impl::create_cell_partitioner_py(
             dolfinx::mesh::create_cell_partitioner(
-                mode, part::impl::create_partitioner_cpp(part)));
+                mode, part::impl::create_partitioner_cpp(part), {},
+                hierarchical));
       },
       nb::arg("part"), nb::arg("ghost_mode") = dolfinx::mesh::GhostMode::none,
+      nb::arg("hierarchical") = false,
       "Create a cell partitioner from a graph partitioning function.");
+  m.def(
+      "create_stored_cell_partitioner",
+      [](dolfinx::mesh::GhostMode mode,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> dest,
+         int num_parts) -> part::impl::PythonCellPartitionFunction
+      {
+        return part::impl::create_cell_partitioner_py(
+            dolfinx::mesh::create_stored_cell_partitioner(
+                mode,
+                std::vector<std::int32_t>(dest.data(),
+                                          dest.data() + dest.size()),
+                num_parts));
+      },
+      nb::arg("ghost_mode"), nb::arg("dest"), nb::arg("num_parts"),
+      "Create a cell partitioner from a stored partition.");
 
   m.def(
       "exterior_facet_indices",
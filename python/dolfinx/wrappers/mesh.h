@@ -8,6 +8,8 @@
 #include <dolfinx/mesh/cell_types.h>
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/vector.h>
+#include <span>
+#include <stdexcept>
 
 namespace nb = nanobind;
 
@@ -19,8 +21,13 @@ auto create_partitioner_cpp(Functor p)
 {
   return [p](MPI_Comm comm, int nparts,
              const dolfinx::graph::AdjacencyList<std::int64_t>& local_graph,
-             bool ghosting)
+             bool ghosting, std::span<const std::int32_t> node_weights)
   {
+    if (!node_weights.empty())
+    {
+      throw std::runtime_error(
+          "Node weights are not supported by Python graph partitioners.");
+    }
     return p(dolfinx_wrappers::MPICommWrapper(comm), nparts, local_graph,
              ghosting);
   };
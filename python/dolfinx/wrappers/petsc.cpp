@@ -434,7 +434,37 @@ void petsc_nls_module(nb::module_& m)
       .def_rw("convergence_criterion",
               &dolfinx::nls::petsc::NewtonSolver::convergence_criterion,
               "Convergence criterion, either 'residual' (default) or "
-              "'incremental'");
+              "'incremental'")
+      .def_rw("globalization",
+              &dolfinx::nls::petsc::NewtonSolver::globalization,
+              "Globalization, either 'none' (default), 'backtracking' or "
+              "'trust_region'")
+      .def_rw("line_search_max_it",
+              &dolfinx::nls::petsc::NewtonSolver::line_search_max_it,
+              "Maximum number of step reductions per iteration")
+      .def_rw("trust_region_radius",
+              &dolfinx::nls::petsc::NewtonSolver::trust_region_radius,
+              "Initial trust-region radius")
+      .def_rw("jacobian_reuse",
+              &dolfinx::nls::petsc::NewtonSolver::jacobian_reuse,
+              "Maximum number of iterations a Jacobian is used for")
+      .def_rw("jacobian_reuse_rate",
+              &dolfinx::nls::petsc::NewtonSolver::jacobian_reuse_rate,
+              "Largest residual reduction ratio for reusing the Jacobian")
+      .def_rw("reuse_preconditioner_only",
+              &dolfinx::nls::petsc::NewtonSolver::reuse_preconditioner_only,
+              "Apply the reuse policy to the preconditioner only")
+      .def_rw("eisenstat_walker",
+              &dolfinx::nls::petsc::NewtonSolver::eisenstat_walker,
+              "Use Eisenstat-Walker Krylov tolerances")
+      .def_rw("ew_rtol_0", &dolfinx::nls::petsc::NewtonSolver::ew_rtol_0,
+              "Eisenstat-Walker initial relative tolerance")
+      .def_rw("ew_rtol_max", &dolfinx::nls::petsc::NewtonSolver::ew_rtol_max,
+              "Eisenstat-Walker maximum relative tolerance")
+      .def_rw("ew_gamma", &dolfinx::nls::petsc::NewtonSolver::ew_gamma,
+              "Eisenstat-Walker parameter gamma")
+      .def_rw("ew_alpha", &dolfinx::nls::petsc::NewtonSolver::ew_alpha,
+              "Eisenstat-Walker parameter alpha");
 }
 
 } // namespace
@@ -42,7 +42,7 @@ void export_refinement(nb::module_& m)
          std::optional<
              dolfinx_wrappers::part::impl::PythonCellPartitionFunction>
              partitioner,
-         dolfinx::refinement::Option option)
+         dolfinx::refinement::Option option, int num_threads)
       {
         std::optional<std::span<const std::int32_t>> cpp_edges(std::nullopt);
         if (edges.has_value())
@@ -57,7 +57,7 @@ void export_refinement(nb::module_& m)
                         partitioner.value())
                   : nullptr;
         auto [mesh1, cell, facet] = dolfinx::refinement::refine(
-            mesh, cpp_edges, cpp_partitioner, option);
+            mesh, cpp_edges, cpp_partitioner, option, num_threads);
 
         std::optional<nb::ndarray<std::int32_t, nb::numpy>> python_cell(
             std::nullopt);
@@ -79,7 +79,7 @@ void export_refinement(nb::module_& m)
                           std::move(python_facet)};
       },
       nb::arg("mesh"), nb::arg("edges").none(), nb::arg("partitioner").none(),
-      nb::arg("option"));
+      nb::arg("option"), nb::arg("num_threads") = 1);
 }
 } // namespace
 
@@ -135,6 +135,34 @@ void refinement(nb::module_& m)
       },
       nb::arg("parent_meshtag"), nb::arg("refined_mesh"),
       nb::arg("parent_cell"));
+  m.def(
+      "transfer_meshtags",
+      [](const std::vector<const dolfinx::mesh::MeshTags<std::int32_t>*>&
+             parent_meshtags,
+         std::shared_ptr<const dolfinx::mesh::Topology> topology1,
+         nb::ndarray<const std::int32_t, nb::ndim<1>, nb::c_contig> parent_cell,
+         nb::ndarray<const std::int8_t, nb::ndim<1>, nb::c_contig> parent_facet)
+      {
+        std::vector<
+            std::reference_wrapper<const dolfinx::mesh::MeshTags<std::int32_t>>>
+            tags0;
+        for (auto tags : parent_meshtags)
+          tags0.push_back(*tags);
+        auto data = dolfinx::refinement::transfer_meshtags(
+            tags0, *topology1,
+            std::span(parent_cell.data(), parent_cell.size()),
+            std::span(parent_facet.data(), parent_facet.size()));
+        std::vector<dolfinx::mesh::MeshTags<std::int32_t>> tags1;
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+          auto& [entities, values] = data[i];
+          tags1.emplace_back(topology1, tags0[i].get().dim(),
+                             std::move(entities), std::move(values));
+        }
+        return tags1;
+      },
+      nb::arg("parent_meshtags"), nb::arg("refined_mesh"),
+      nb::arg("parent_cell"), nb::arg("parent_facet"));
 }
 
 } // namespace dolfinx_wrappers
@@ -947,6 +947,10 @@ class TestPETScAssemblers:
         b0.assemble()
         constants = _cpp.fem.pack_constants(_F._cpp_object)
         coeffs = _cpp.fem.pack_coefficients(_F._cpp_object)
+        coeffs_threaded = _cpp.fem.pack_coefficients(_F._cpp_object, 3)
+        assert coeffs.keys() == coeffs_threaded.keys()
+        for key, coeff in coeffs.items():
+            assert np.array_equal(coeff, coeffs_threaded[key])
         with b0.localForm() as _b0:
             for c in [(None, None), (None, coeffs), (constants, None), (constants, coeffs)]:
                 b = petsc_assemble_vector(_F, c[0], c[1])
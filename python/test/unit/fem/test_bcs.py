@@ -361,3 +361,24 @@ def test_mixed_blocked_constant():
     with pytest.raises(RuntimeError):
         dofs1 = locate_dofs_topological(W.sub(1), tdim - 1, boundary_facets)
         dirichletbc(c1, dofs1, W.sub(1))
+
+
+@pytest.mark.parametrize("shape", [None, (2,)])
+def test_bc_cells(shape):
+    """Test that the cells of a DirichletBC are the cells with a
+    constrained dof"""
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V = functionspace(mesh, ("Lagrange", 2, shape))
+    tdim = mesh.topology.dim
+    mesh.topology.create_connectivity(tdim - 1, tdim)
+    boundary_facets = exterior_facet_indices(mesh.topology)
+    dofs = locate_dofs_topological(V, tdim - 1, boundary_facets[:3])
+    bc = dirichletbc(Function(V), dofs)
+
+    bs = V.dofmap.bs
+    num_dofs = V.dofmap.index_map.size_local + V.dofmap.index_map.num_ghosts
+    marker = np.zeros(bs * num_dofs, dtype=bool)
+    marker[bc.dof_indices()[0]] = True
+    cell_dofs = V.dofmap.list
+    has_bc = marker[bs * cell_dofs[:, :, np.newaxis] + np.arange(bs)]
+    assert np.array_equal(bc.cells(), np.flatnonzero(has_bc.any(axis=(1, 2))))
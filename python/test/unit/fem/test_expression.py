@@ -522,3 +522,23 @@ def test_rank1_blocked():
                     np.testing.assert_allclose(block_values[k::bs], 0.0)
                 else:
                     np.testing.assert_allclose(block_values[k::bs], ref_values[i].flatten())
+
+
+@pytest.mark.parametrize("num_threads", [1, 3])
+def test_expression_eval_threads(num_threads):
+    """Test threaded evaluation of an Expression with a coefficient and a
+    (dof transformed) Argument on an unordered list of cells."""
+    mesh = create_unit_square(MPI.COMM_WORLD, 6, 5)
+    V = functionspace(mesh, ("Lagrange", 2))
+    RT = functionspace(mesh, ("RT", 2))
+    u = Function(V)
+    u.interpolate(lambda x: x[0] ** 2 + x[1])
+    points = functionspace(mesh, ("DG", 1, (2,))).element.interpolation_points()
+    expr = Expression(u * ufl.TrialFunction(RT), points)
+
+    num_cells = mesh.topology.index_map(mesh.topology.dim).size_local
+    cells = np.arange(num_cells - 1, -1, -1, dtype=np.int32)
+    values = expr.eval(mesh, cells, num_threads=num_threads)
+    for i, c in enumerate(cells):
+        values_c = expr.eval(mesh, np.array([c], dtype=np.int32))
+        np.testing.assert_allclose(values[i], values_c[0])
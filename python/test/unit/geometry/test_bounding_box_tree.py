@@ -15,13 +15,18 @@ from dolfinx.geometry import (
     bb_tree,
     compute_closest_entity,
     compute_colliding_cells,
+    compute_colliding_cells_pull_back,
     compute_collisions_points,
     compute_collisions_trees,
     compute_distance_gjk,
+    compute_nearest_neighbors,
+    compute_points_in_radius,
     create_midpoint_tree,
 )
+from dolfinx.geometry import locate_entities as locate_entities_tree
 from dolfinx.mesh import (
     CellType,
+    compute_midpoints,
     create_box,
     create_unit_cube,
     create_unit_interval,
@@ -496,3 +501,63 @@ def test_surface_bbtree_collision(dtype):
 
     collisions = compute_collisions_trees(bbtree1, bbtree2)
     assert len(collisions) == 1
+
+
+@pytest.mark.parametrize("box", [[[0.2, 0.1, 0.3], [0.6, 0.5, 0.9]], [[0, 0, 0], [0, 1, 1]]])
+def test_locate_entities_tree(box):
+    mesh = create_unit_cube(MPI.COMM_WORLD, 6, 5, 4)
+    tree = bb_tree(mesh, mesh.topology.dim)
+    box = np.array(box)
+
+    def marker(x):
+        return np.logical_and(
+            np.all(x >= box[0, :, np.newaxis] - 1e-10, axis=0),
+            np.all(x <= box[1, :, np.newaxis] + 1e-10, axis=0),
+        )
+
+    for dim in range(mesh.topology.dim + 1):
+        entities = locate_entities_tree(tree, mesh, dim, box, marker)
+        assert np.array_equal(entities, locate_entities(mesh, dim, marker))
+        if dim < mesh.topology.dim:
+            entities = locate_entities_tree(tree, mesh, dim, box, marker, boundary=True)
+            assert np.array_equal(entities, locate_entities_boundary(mesh, dim, marker))
+
+
+@pytest.mark.parametrize("num_threads", [1, 3])
+def test_nearest_neighbors(num_threads):
+    mesh = create_unit_square(MPI.COMM_SELF, 7, 5)
+    tdim = mesh.topology.dim
+    cells = np.arange(mesh.topology.index_map(tdim).size_local, dtype=np.int32)
+    tree = create_midpoint_tree(mesh, tdim, cells)
+    midpoints = compute_midpoints(mesh, tdim, cells)
+
+    x = np.array([[0.3, 0.4, 0.0], [1.2, -0.3, 0.0], [0.5, 0.5, 0.0]], dtype=np.float64)
+    d = np.linalg.norm(midpoints[np.newaxis, :, :] - x[:, np.newaxis, :], axis=2)
+
+    k = 5
+    nearest = compute_nearest_neighbors(tree, x, k, num_threads)
+    for i in range(x.shape[0]):
+        assert np.allclose(d[i, nearest.links(i)], np.sort(d[i])[:k])
+
+    radius = 0.25
+    near = compute_points_in_radius(tree, x, radius, num_threads)
+    for i in range(x.shape[0]):
+        assert np.array_equal(near.links(i), np.flatnonzero(d[i] <= radius))
+
+
+def test_compute_colliding_cells_pull_back():
+    mesh = create_unit_cube(MPI.COMM_SELF, 3, 4, 2)
+    tree = bb_tree(mesh, mesh.topology.dim)
+    x = np.array([[0.3, 0.4, 0.2], [0.5, 0.5, 0.5], [1.1, 0.2, 0.3]], dtype=np.float64)
+    candidates = compute_collisions_points(tree, x)
+    cells, X = compute_colliding_cells_pull_back(mesh, candidates, x)
+    assert np.array_equal(cells.array, compute_colliding_cells(mesh, candidates, x).array)
+    assert X.shape == (len(cells.array), 3)
+    assert len(cells.links(2)) == 0
+
+    # Push forward with the affine map of each cell
+    dofmap = mesh.geometry.dofmap
+    for i in range(x.shape[0]):
+        for cell, Xp in zip(cells.links(i), X[cells.offsets[i] : cells.offsets[i + 1]]):
+            v = mesh.geometry.x[dofmap[cell]]
+            assert np.allclose(v[0] + (v[1:] - v[0]).T @ Xp, x[i])
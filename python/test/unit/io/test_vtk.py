@@ -4,6 +4,7 @@
 #
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 
+import re
 from pathlib import Path
 
 from mpi4py import MPI
@@ -14,7 +15,7 @@ from numpy.testing import assert_array_equal
 
 import ufl
 from basix.ufl import element, mixed_element
-from dolfinx import default_real_type
+from dolfinx import default_real_type, has_zlib
 from dolfinx.fem import Function, functionspace
 from dolfinx.io import VTKFile
 from dolfinx.io.utils import cell_perm_vtk  # F401
@@ -254,6 +255,39 @@ def test_save_3d_tensor(tempdir):
         vtk.write_function(u, 0.0)
 
 
+@pytest.mark.parametrize(
+    "compression",
+    [
+        VTKFile.Compression.none,
+        pytest.param(
+            VTKFile.Compression.zlib,
+            marks=pytest.mark.skipif(not has_zlib, reason="Requires zlib"),
+        ),
+    ],
+)
+def test_save_appended(tempdir, compression):
+    mesh = create_unit_square(MPI.COMM_WORLD, 8, 8)
+    u = Function(functionspace(mesh, ("Lagrange", 1, (mesh.geometry.dim,))))
+    u.x.array[:] = 1.0
+    filename = Path(tempdir, "u.pvd")
+    with VTKFile(
+        mesh.comm, filename, "w", encoding=VTKFile.Encoding.appended, compression=compression
+    ) as vtk:
+        vtk.write_mesh(mesh, 0.0)
+        vtk.write_function(u, 1.0)
+
+    # Check the raw point data of the mesh
+    vtu = Path(tempdir, f"u_p{mesh.comm.rank}_000000.vtu").read_bytes()
+    assert b'format="ascii"' not in vtu
+    if compression == VTKFile.Compression.none:
+        head, data = vtu.split(b'<AppendedData encoding="raw">', 1)
+        data = data[data.index(b"_") + 1 :]
+        offset = int(re.search(rb'<Points>\s*<DataArray[^>]*offset="(\d+)"', head).group(1))
+        nbytes = np.frombuffer(data, dtype=np.uint64, count=1, offset=offset)[0]
+        x = np.frombuffer(data, dtype=np.float64, count=nbytes // 8, offset=offset + 8)
+        assert np.allclose(x, mesh.geometry.x.flatten())
+
+
 def test_triangle_perm_vtk():
     higher_order_triangle_perm = {
         10: np.array([0, 1, 2, 5, 6, 8, 7, 3, 4, 9]),
@@ -526,6 +526,11 @@ def test_submesh_full(d, n, codim, marker, ghost_mode, simplex):
     submesh_topology_test(mesh, submesh, entity_map, vertex_map, edim)
     submesh_geometry_test(mesh, submesh, entity_map, geom_map, edim)
 
+    # Affine geometry nodes are numbered as the sub-mesh vertices
+    xmap, vmap = submesh.geometry.index_map(), submesh.topology.index_map(0)
+    assert xmap.size_local == vmap.size_local
+    assert xmap.num_ghosts == vmap.num_ghosts
+
 
 @pytest.mark.parametrize("d", [1, 2, 3])
 @pytest.mark.parametrize("n", [3, 6])
@@ -190,6 +190,111 @@ class TestNLS:
         assert converged
         assert n > 0 and n < 6
 
+    def test_nonlinear_pde_inexact(self):
+        """Test modified Newton and Eisenstat-Walker forcing for a simple
+        nonlinear PDE"""
+        from petsc4py import PETSc
+
+        from dolfinx.nls.petsc import NewtonSolver
+
+        mesh = create_unit_square(MPI.COMM_WORLD, 12, 5)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u = Function(V)
+        v = TestFunction(V)
+        F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(grad(u), grad(v)) * dx - inner(u, v) * dx
+        bc = dirichletbc(
+            PETSc.ScalarType(1.0),
+            locate_dofs_geometrical(V, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[0], 1.0)),
+            V,
+        )
+        problem = NonlinearPDEProblem(F, u, bc)
+
+        num_jacobians = 0
+
+        def J(x, A):
+            nonlocal num_jacobians
+            num_jacobians += 1
+            problem.J(x, A)
+
+        solver = NewtonSolver(MPI.COMM_WORLD, problem)
+        solver.setF(problem.F, problem.vector())
+        solver.setJ(J, problem.matrix())
+        solver.set_form(problem.form)
+        solver.atol = 1.0e-8
+        solver.rtol = 1.0e2 * np.finfo(default_real_type).eps
+        solver.max_it = 50
+
+        # Reference solution with full Newton
+        u.x.array[:] = 0.9
+        n0, converged = solver.solve(u)
+        assert converged
+        u0 = u.x.array.copy()
+
+        # Modified Newton, recomputing the Jacobian at most every third
+        # iteration
+        solver.jacobian_reuse = 3
+        solver.jacobian_reuse_rate = 1.0
+        u.x.array[:] = 0.9
+        num_jacobians = 0
+        n1, converged = solver.solve(u)
+        assert converged
+        assert num_jacobians < n1
+        assert np.allclose(u.x.array, u0, atol=1e-6)
+
+        # Inexact Newton with an iterative Krylov solver
+        solver.jacobian_reuse = 1
+        solver.eisenstat_walker = True
+        ksp = solver.krylov_solver
+        ksp.setType("gmres")
+        ksp.getPC().setType("jacobi")
+        ksp.setTolerances(rtol=1e-12, max_it=1000)
+        u.x.array[:] = 0.9
+        n2, converged = solver.solve(u)
+        assert converged
+        assert np.allclose(u.x.array, u0, atol=1e-6)
+        assert np.isclose(ksp.getTolerances()[0], 1e-12)
+
+    @pytest.mark.parametrize("globalization", ["backtracking", "trust_region"])
+    def test_nonlinear_pde_globalization(self, globalization):
+        """Test Newton solver with globalization for a simple nonlinear
+        PDE"""
+        from petsc4py import PETSc
+
+        from dolfinx.nls.petsc import NewtonSolver
+
+        mesh = create_unit_square(MPI.COMM_WORLD, 12, 5)
+        V = functionspace(mesh, ("Lagrange", 1))
+        u = Function(V)
+        v = TestFunction(V)
+        F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(grad(u), grad(v)) * dx - inner(u, v) * dx
+        bc = dirichletbc(
+            PETSc.ScalarType(1.0),
+            locate_dofs_geometrical(V, lambda x: np.isclose(x[0], 0.0) | np.isclose(x[0], 1.0)),
+            V,
+        )
+        problem = NonlinearPDEProblem(F, u, bc)
+        solver = NewtonSolver(MPI.COMM_WORLD, problem)
+        solver.setF(problem.F, problem.vector())
+        solver.setJ(problem.J, problem.matrix())
+        solver.set_form(problem.form)
+        solver.atol = 1.0e-8
+        solver.rtol = 1.0e2 * np.finfo(default_real_type).eps
+
+        u.x.array[:] = 0.9
+        n, converged = solver.solve(u)
+        assert converged
+        u0 = u.x.array.copy()
+
+        solver.globalization = globalization
+        u.x.array[:] = 0.9
+        n, converged = solver.solve(u)
+        assert converged
+        assert np.allclose(u.x.array, u0, atol=1e-6)
+
+        solver.globalization = "unknown"
+        with pytest.raises(RuntimeError):
+            solver.solve(u)
+
     def test_nonlinear_pde_snes(self):
         """Test Newton solver for a simple nonlinear PDE"""
         from petsc4py import PETSc